@@ -43,6 +43,7 @@ set(INHERITED_CMAKE_ARGS
   -DTILEDB_SERIALIZATION=${TILEDB_SERIALIZATION}
   -DTILEDB_ARROW_TESTS=${TILEDB_ARROW_TESTS}
   -DTILEDB_INSTALL_LIBDIR=${TILEDB_INSTALL_LIBDIR}
+  -DTILEDB_LOG_ACTIVE_LEVEL=${TILEDB_LOG_ACTIVE_LEVEL}
   -DCMAKE_OSX_ARCHITECTURES=${CMAKE_OSX_ARCHITECTURES}
 )
 
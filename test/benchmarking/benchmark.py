@@ -3,7 +3,9 @@
 import argparse
 import glob
 import json
+import math
 import os
+import platform
 import subprocess
 import sys
 import threading
@@ -14,6 +16,13 @@ benchmark_build_dir = os.path.abspath('build')
 
 NUM_TRIALS = 3
 
+# Two-sided 95% critical values of Student's t distribution, by degrees of
+# freedom. Larger degrees of freedom use the normal approximation.
+T_CRITICAL_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
 if os.name == 'posix':
     if sys.platform == 'darwin':
         os_name = 'mac'
@@ -123,17 +132,18 @@ def build_benchmarks(args):
         p.stop()
 
 
-def print_results(results):
+def print_results(results, num_trials):
     "Prints benchmark timing results."
     print('Reporting minimum time of {} runs for each benchmark:'.format(
-        NUM_TRIALS))
+        num_trials))
     print('-' * 93)
     for bench in sorted(results.keys()):
-        print('{:<30s}{:>60d} ms'.format(bench, min(results[bench])))
+        print('{:<30s}{:>60d} ms'.format(bench,
+                                         min(results[bench]['runtime_ms'])))
 
 
 def run_benchmarks(args):
-    """Runs the benchmark programs."""
+    """Runs the benchmark programs, returning the results of each run."""
     if args.benchmarks is None:
         benchmarks = list_benchmarks()
     else:
@@ -155,21 +165,138 @@ def run_benchmarks(args):
 
             subprocess.check_output([exe, 'setup'], cwd=benchmark_build_dir)
 
-            times_ms = []
-            for i in range(0, NUM_TRIALS):
+            runs = {'runtime_ms': [], 'peak_mem_mb': []}
+            for i in range(0, args.trials):
                 sync_fs()
                 drop_fs_caches()
                 output_json = subprocess.check_output([exe, 'run'],
                                                       cwd=benchmark_build_dir)
                 result = json.loads(output_json)
-                times_ms.append(result['ms'])
-            results[b] = times_ms
+                for metric in runs:
+                    runs[metric].append(int(result.get(metric, 0)))
+            results[b] = runs
 
             subprocess.check_output([exe, 'teardown'], cwd=benchmark_build_dir)
     finally:
         p.stop()
 
-    print_results(results)
+    print_results(results, args.trials)
+    return results
+
+
+def environment_fingerprint(args):
+    """
+    Returns a description of the machine and library the benchmarks ran
+    with. Runs are only comparable if their fingerprints match.
+    """
+    cpu = platform.processor()
+    if os_name == 'linux':
+        try:
+            with open('/proc/cpuinfo') as f:
+                for line in f:
+                    if line.startswith('model name'):
+                        cpu = line.split(':', 1)[1].strip()
+                        break
+        except IOError:
+            pass
+    try:
+        revision = subprocess.check_output(
+            ['git', 'rev-parse', 'HEAD'],
+            stderr=subprocess.STDOUT).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        revision = 'unknown'
+    return {
+        'os': platform.platform(),
+        'machine': platform.machine(),
+        'cpu': cpu,
+        'cpu_count': os.cpu_count(),
+        'tiledb': find_tiledb_path(args),
+        'revision': revision,
+    }
+
+
+def mean_and_variance(samples):
+    """Returns the mean and unbiased sample variance of 'samples'."""
+    n = len(samples)
+    mean = float(sum(samples)) / n
+    if n < 2:
+        return mean, 0.0
+    return mean, sum((x - mean) ** 2 for x in samples) / (n - 1)
+
+
+def t_critical_95(dof):
+    """Returns the two-sided 95% critical value for 'dof' degrees of freedom."""
+    dof = max(1, int(math.floor(dof)))
+    if dof <= len(T_CRITICAL_95):
+        return T_CRITICAL_95[dof - 1]
+    return 1.96
+
+
+def difference_interval(baseline, current):
+    """
+    Returns the 95% confidence interval of the difference of the means of
+    'current' and 'baseline' (Welch's method), as a (low, high) tuple.
+    """
+    mean_b, var_b = mean_and_variance(baseline)
+    mean_c, var_c = mean_and_variance(current)
+    se_b = var_b / len(baseline)
+    se_c = var_c / len(current)
+    diff = mean_c - mean_b
+    se = math.sqrt(se_b + se_c)
+    if se == 0:
+        return diff, diff
+    dof_denom = 0.0
+    if len(baseline) > 1:
+        dof_denom += se_b ** 2 / (len(baseline) - 1)
+    if len(current) > 1:
+        dof_denom += se_c ** 2 / (len(current) - 1)
+    dof = (se_b + se_c) ** 2 / dof_denom if dof_denom > 0 else 1
+    margin = t_critical_95(dof) * se
+    return diff - margin, diff + margin
+
+
+def compare_results(baseline, results, threshold):
+    """
+    Compares 'results' against the stored 'baseline', printing a report.
+    A benchmark regressed if, with 95% confidence, its mean runtime grew by
+    more than 'threshold' percent of the baseline mean.
+
+    :return: list of the names of the regressed benchmarks
+    """
+    if baseline['environment'] != results['environment']:
+        print('WARNING: the baseline was recorded in a different environment:')
+        for key in sorted(baseline['environment'].keys()):
+            if baseline['environment'][key] != results['environment'].get(key):
+                print('  {}: {} (now {})'.format(
+                    key, baseline['environment'][key],
+                    results['environment'].get(key)))
+
+    print('Comparing mean runtime against the baseline (95% confidence):')
+    print('-' * 93)
+    regressions = []
+    for bench in sorted(results['results'].keys()):
+        if bench not in baseline['results']:
+            print('{:<30s}{:>63s}'.format(bench, 'no baseline'))
+            continue
+        base = baseline['results'][bench]['runtime_ms']
+        cur = results['results'][bench]['runtime_ms']
+        base_mean = mean_and_variance(base)[0]
+        low, high = difference_interval(base, cur)
+        if base_mean > 0:
+            low_pct = 100.0 * low / base_mean
+            high_pct = 100.0 * high / base_mean
+        else:
+            low_pct = high_pct = 0.0
+        if low_pct > threshold:
+            verdict = 'REGRESSION'
+            regressions.append(bench)
+        elif high_pct < -threshold:
+            verdict = 'improvement'
+        else:
+            verdict = 'unchanged'
+        print('{:<30s}{:>+28.1f}% .. {:>+7.1f}%{:>24s}'.format(
+            bench, low_pct, high_pct, verdict))
+    return regressions
 
 
 def main():
@@ -183,6 +310,22 @@ def main():
     parser.add_argument('-b', '--benchmarks', metavar='NAMES',
                         help='If given, one or more comma-separated names of '
                              'benchmarks to run.')
+    parser.add_argument('-n', '--trials', metavar='N', type=int,
+                        default=NUM_TRIALS,
+                        help='Number of runs of each benchmark.')
+    parser.add_argument('-o', '--output', metavar='FILE',
+                        help='If given, writes the results and the '
+                             'environment fingerprint to this JSON file, '
+                             'e.g. to be used as a baseline.')
+    parser.add_argument('--baseline', metavar='FILE',
+                        help='If given, compares the results against the '
+                             'results stored in this JSON file and exits '
+                             'with a non-zero status on a regression.')
+    parser.add_argument('--threshold', metavar='PERCENT', type=float,
+                        default=5.0,
+                        help='Runtime growth, as a percentage of the '
+                             'baseline, tolerated before reporting a '
+                             'regression.')
     args = parser.parse_args()
 
     if find_tiledb_path(args) is None:
@@ -196,7 +339,23 @@ def main():
         list_benchmarks(show=True)
         sys.exit(0)
 
-    run_benchmarks(args)
+    results = {
+        'environment': environment_fingerprint(args),
+        'results': run_benchmarks(args),
+    }
+
+    if args.output is not None:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare_results(baseline, results, args.threshold)
+        if regressions:
+            print('Error: {} benchmark(s) regressed: {}'.format(
+                len(regressions), ', '.join(regressions)))
+            sys.exit(1)
 
 
 if __name__ == '__main__':
@@ -0,0 +1,207 @@
+/**
+ * @file   bench_array_open.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Benchmark the latency of opening an array with many fragments, e.g. on an
+ * object store. The run phase reports, besides its total runtime, the
+ * latency of each step and the library stats, which include the VFS request
+ * counts per backend. The benchmark is parameterized with environment
+ * variables:
+ *
+ *   TILEDB_BENCH_URI: URI of the array (default "bench_array"), e.g.
+ *     "s3://bucket/bench_array". Since "mem://" arrays do not outlive the
+ *     process, run the benchmark without a task argument for those.
+ *   TILEDB_BENCH_CONFIG: optional path of a config file, e.g. holding the
+ *     S3 endpoint and credentials.
+ *   TILEDB_BENCH_FRAGMENTS: number of fragments written (default 100).
+ *   TILEDB_BENCH_CONSOLIDATE_FRAGMENT_META: if 1, consolidates the fragment
+ *     metadata after writing the fragments (default 0).
+ */
+
+#include <tiledb/tiledb>
+
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "benchmark.h"
+
+using namespace tiledb;
+
+namespace {
+uint64_t env_uint(const char* name, uint64_t default_value) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? default_value : std::strtoull(value, nullptr, 10);
+}
+
+std::string env_str(const char* name, const std::string& default_value) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? default_value : std::string(value);
+}
+
+Config make_config() {
+  const std::string path = env_str("TILEDB_BENCH_CONFIG", "");
+  return path.empty() ? Config() : Config(path);
+}
+}  // namespace
+
+class Benchmark : public BenchmarkBase {
+ public:
+  Benchmark()
+      : array_uri_(env_str("TILEDB_BENCH_URI", "bench_array"))
+      , num_fragments_(env_uint("TILEDB_BENCH_FRAGMENTS", 100))
+      , consolidate_fragment_meta_(
+            env_uint("TILEDB_BENCH_CONSOLIDATE_FRAGMENT_META", 0) != 0)
+      , config_(make_config())
+      , ctx_(config_) {
+  }
+
+ protected:
+  virtual void setup() {
+    ArraySchema schema(ctx_, TILEDB_SPARSE);
+    Domain domain(ctx_);
+    domain.add_dimension(Dimension::create<uint64_t>(
+        ctx_, "d1", {{1, std::numeric_limits<uint32_t>::max()}}, 1000));
+    schema.set_domain(domain);
+    schema.add_attribute(Attribute::create<int32_t>(ctx_, "a"));
+    Array::create(array_uri_, schema);
+
+    // Small fragments, so that the run is dominated by metadata requests.
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    for (uint64_t f = 0; f < num_fragments_; f++) {
+      std::vector<uint64_t> coords(cells_per_fragment_);
+      std::vector<int32_t> data(cells_per_fragment_);
+      for (uint64_t i = 0; i < cells_per_fragment_; i++) {
+        coords[i] = 1 + f * cells_per_fragment_ + i;
+        data[i] = static_cast<int32_t>(i);
+      }
+      Query query(ctx_, array);
+      query.set_layout(TILEDB_UNORDERED)
+          .set_data_buffer("a", data)
+          .set_data_buffer("d1", coords);
+      query.submit();
+    }
+    array.close();
+
+    if (consolidate_fragment_meta_) {
+      Config config = config_;
+      config["sm.consolidation.mode"] = "fragment_meta";
+      Array::consolidate(ctx_, array_uri_, &config);
+    }
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(array_uri_))
+      vfs.remove_dir(array_uri_);
+  }
+
+  virtual void pre_run() {
+    data_.resize(cells_per_fragment_);
+    coords_.resize(cells_per_fragment_);
+
+    Stats::enable();
+    Stats::reset();
+  }
+
+  virtual void run() {
+    auto t0 = std::chrono::steady_clock::now();
+    Array array(ctx_, array_uri_, TILEDB_READ);
+    auto t1 = std::chrono::steady_clock::now();
+    array.reopen();
+    auto t2 = std::chrono::steady_clock::now();
+
+    FragmentInfo fragment_info(ctx_, array_uri_);
+    fragment_info.load();
+    auto t3 = std::chrono::steady_clock::now();
+
+    // The first query reads the cells of the last fragment.
+    const uint64_t first = 1 + (num_fragments_ - 1) * cells_per_fragment_;
+    std::vector<uint64_t> subarray = {first, first + cells_per_fragment_ - 1};
+    Query query(ctx_, array);
+    query.set_subarray(subarray)
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_data_buffer("a", data_)
+        .set_data_buffer("d1", coords_);
+    query.submit();
+    auto t4 = std::chrono::steady_clock::now();
+    array.close();
+
+    open_us_ = elapsed_us(t0, t1);
+    reopen_us_ = elapsed_us(t1, t2);
+    fragment_info_load_us_ = elapsed_us(t2, t3);
+    first_query_us_ = elapsed_us(t3, t4);
+  }
+
+  virtual void run_metrics(
+      uint64_t runtime_ms,
+      std::vector<std::pair<std::string, std::string>>* metrics) {
+    (void)runtime_ms;
+    metrics->emplace_back("open_us", std::to_string(open_us_));
+    metrics->emplace_back("reopen_us", std::to_string(reopen_us_));
+    metrics->emplace_back(
+        "fragment_info_load_us", std::to_string(fragment_info_load_us_));
+    metrics->emplace_back("first_query_us", std::to_string(first_query_us_));
+
+    std::string stats;
+    Stats::raw_dump(&stats);
+    while (!stats.empty() && stats.back() == '\n')
+      stats.pop_back();
+    metrics->emplace_back("stats", stats);
+    Stats::disable();
+  }
+
+ private:
+  const uint64_t cells_per_fragment_ = 10;
+
+  const std::string array_uri_;
+  const uint64_t num_fragments_;
+  const bool consolidate_fragment_meta_;
+
+  Config config_;
+  Context ctx_;
+  std::vector<int32_t> data_;
+  std::vector<uint64_t> coords_;
+  uint64_t open_us_ = 0;
+  uint64_t reopen_us_ = 0;
+  uint64_t fragment_info_load_us_ = 0;
+  uint64_t first_query_us_ = 0;
+
+  static uint64_t elapsed_us(
+      std::chrono::steady_clock::time_point t0,
+      std::chrono::steady_clock::time_point t1) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+        .count();
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
@@ -0,0 +1,246 @@
+/**
+ * @file   bench_sparse_read_matrix.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Benchmark sparse read performance across the sparse readers, fragment
+ * counts, fragment overlap, dimension counts and query condition
+ * selectivity. The benchmark is parameterized with environment variables,
+ * so that a matrix of configurations can be run with the same program:
+ *
+ *   TILEDB_BENCH_READER: "global_order" (default), "unordered_with_dups" or
+ *     "legacy".
+ *   TILEDB_BENCH_FRAGMENTS: number of fragments written (default 100).
+ *   TILEDB_BENCH_CELLS_PER_FRAGMENT: cells per fragment (default 10000).
+ *   TILEDB_BENCH_OVERLAP: percent of each fragment's range overlapping with
+ *     the previous fragment's (default 0).
+ *   TILEDB_BENCH_DIMS: number of integer dimensions, 1 to 3 (default 2).
+ *   TILEDB_BENCH_STRING_DIM: if 1, adds a string dimension (default 0).
+ *   TILEDB_BENCH_SELECTIVITY: percent of cells selected by a query condition
+ *     on the attribute, 100 for no condition (default 100).
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "benchmark.h"
+
+using namespace tiledb;
+
+namespace {
+uint64_t env_uint(const char* name, uint64_t default_value) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? default_value : std::strtoull(value, nullptr, 10);
+}
+
+std::string env_str(const char* name, const std::string& default_value) {
+  const char* value = std::getenv(name);
+  return value == nullptr ? default_value : std::string(value);
+}
+}  // namespace
+
+class Benchmark : public BenchmarkBase {
+ public:
+  Benchmark()
+      : reader_(env_str("TILEDB_BENCH_READER", "global_order"))
+      , num_fragments_(env_uint("TILEDB_BENCH_FRAGMENTS", 100))
+      , cells_per_fragment_(env_uint("TILEDB_BENCH_CELLS_PER_FRAGMENT", 10000))
+      , overlap_(std::min<uint64_t>(env_uint("TILEDB_BENCH_OVERLAP", 0), 100))
+      , num_dims_(std::max<uint64_t>(
+            1, std::min<uint64_t>(env_uint("TILEDB_BENCH_DIMS", 2), 3)))
+      , string_dim_(env_uint("TILEDB_BENCH_STRING_DIM", 0) != 0)
+      , selectivity_(
+            std::min<uint64_t>(env_uint("TILEDB_BENCH_SELECTIVITY", 100), 100))
+      , ctx_(make_config())
+      , cells_read_(0) {
+  }
+
+ protected:
+  virtual void setup() {
+    ArraySchema schema(ctx_, TILEDB_SPARSE);
+    Domain domain(ctx_);
+    const uint64_t max_coord = std::numeric_limits<uint32_t>::max();
+    for (uint64_t d = 0; d < num_dims_; d++) {
+      domain.add_dimension(Dimension::create<uint64_t>(
+          ctx_, "d" + std::to_string(d + 1), {{1, max_coord}}, 10000));
+    }
+    if (string_dim_) {
+      domain.add_dimension(
+          Dimension::create(ctx_, "s", TILEDB_STRING_ASCII, nullptr, nullptr));
+    }
+    schema.set_domain(domain);
+    schema.set_capacity(capacity_);
+    schema.set_allows_dups(reader_ == "unordered_with_dups");
+    FilterList filters(ctx_);
+    filters.add_filter({ctx_, TILEDB_FILTER_LZ4});
+    schema.add_attribute(Attribute::create<int32_t>(ctx_, "a", filters));
+    Array::create(array_uri_, schema);
+
+    // Each fragment covers `cells_per_fragment_` consecutive `d1`
+    // coordinates, starting `overlap_` percent before the end of the
+    // previous fragment's range.
+    const uint64_t stride =
+        std::max<uint64_t>(1, cells_per_fragment_ * (100 - overlap_) / 100);
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    for (uint64_t f = 0; f < num_fragments_; f++) {
+      std::vector<std::vector<uint64_t>> coords(num_dims_);
+      std::string str_coords;
+      std::vector<uint64_t> str_offsets;
+      std::vector<int32_t> data;
+      for (uint64_t i = 0; i < cells_per_fragment_; i++) {
+        const uint64_t d1 = 1 + f * stride + i;
+        coords[0].push_back(d1);
+        for (uint64_t d = 1; d < num_dims_; d++)
+          coords[d].push_back(1 + (d1 * 7919 * d) % 100000);
+        if (string_dim_) {
+          str_offsets.push_back(str_coords.size());
+          str_coords += "key" + std::to_string(d1);
+        }
+        data.push_back(static_cast<int32_t>(d1 % 100));
+      }
+
+      Query query(ctx_, array);
+      query.set_layout(TILEDB_UNORDERED).set_data_buffer("a", data);
+      for (uint64_t d = 0; d < num_dims_; d++)
+        query.set_data_buffer("d" + std::to_string(d + 1), coords[d]);
+      if (string_dim_) {
+        query.set_data_buffer("s", str_coords)
+            .set_offsets_buffer("s", str_offsets);
+      }
+      query.submit();
+    }
+    array.close();
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(array_uri_))
+      vfs.remove_dir(array_uri_);
+  }
+
+  virtual void pre_run() {
+    // Results are read in batches of at most one fragment's worth of cells.
+    data_.resize(cells_per_fragment_);
+    coords_.resize(num_dims_);
+    for (auto& c : coords_)
+      c.resize(cells_per_fragment_);
+    str_coords_.resize(cells_per_fragment_ * 16);
+    str_offsets_.resize(cells_per_fragment_);
+
+    Stats::enable();
+    Stats::reset();
+  }
+
+  virtual void run() {
+    Array array(ctx_, array_uri_, TILEDB_READ);
+    Query query(ctx_, array);
+    query.set_layout(layout()).set_data_buffer("a", data_);
+    for (uint64_t d = 0; d < num_dims_; d++)
+      query.set_data_buffer("d" + std::to_string(d + 1), coords_[d]);
+    if (string_dim_) {
+      query.set_data_buffer("s", str_coords_)
+          .set_offsets_buffer("s", str_offsets_);
+    }
+
+    QueryCondition condition(ctx_);
+    if (selectivity_ < 100) {
+      const int32_t value = static_cast<int32_t>(selectivity_);
+      condition.init("a", &value, sizeof(value), TILEDB_LT);
+      query.set_condition(condition);
+    }
+
+    cells_read_ = 0;
+    do {
+      query.submit();
+      cells_read_ += query.result_buffer_elements()["a"].second;
+    } while (query.query_status() == Query::Status::INCOMPLETE);
+    array.close();
+  }
+
+  virtual void run_metrics(
+      uint64_t runtime_ms,
+      std::vector<std::pair<std::string, std::string>>* metrics) {
+    metrics->emplace_back("cells_read", std::to_string(cells_read_));
+    metrics->emplace_back(
+        "cells_per_sec",
+        std::to_string(
+            runtime_ms == 0 ? 0 : cells_read_ * 1000 / runtime_ms));
+
+    std::string stats;
+    Stats::raw_dump(&stats);
+    while (!stats.empty() && stats.back() == '\n')
+      stats.pop_back();
+    metrics->emplace_back("stats", stats);
+    Stats::disable();
+  }
+
+ private:
+  const std::string array_uri_ = "bench_array";
+  const uint64_t capacity_ = 10000;
+
+  const std::string reader_;
+  const uint64_t num_fragments_;
+  const uint64_t cells_per_fragment_;
+  const uint64_t overlap_;
+  const uint64_t num_dims_;
+  const bool string_dim_;
+  const uint64_t selectivity_;
+
+  Context ctx_;
+  uint64_t cells_read_;
+  std::vector<int32_t> data_;
+  std::vector<std::vector<uint64_t>> coords_;
+  std::string str_coords_;
+  std::vector<uint64_t> str_offsets_;
+
+  /** Returns the config selecting the benchmarked reader. */
+  Config make_config() const {
+    Config config;
+    const std::string impl = reader_ == "legacy" ? "legacy" : "refactored";
+    config["sm.query.sparse_global_order.reader"] = impl;
+    config["sm.query.sparse_unordered_with_dups.reader"] = impl;
+    return config;
+  }
+
+  /** Returns the read layout exercising the benchmarked reader. */
+  tiledb_layout_t layout() const {
+    if (reader_ == "unordered_with_dups")
+      return TILEDB_UNORDERED;
+    if (reader_ == "legacy")
+      return TILEDB_ROW_MAJOR;
+    return TILEDB_GLOBAL_ORDER;
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
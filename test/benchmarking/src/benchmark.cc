@@ -124,19 +124,23 @@ void BenchmarkBase::run_base() {
 
   uint64_t ms =
       std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-  print_task("run", &ms, &mem_samples_mb, baseline_mem_mb);
+  std::vector<std::pair<std::string, std::string>> metrics;
+  run_metrics(ms, &metrics);
+  print_task("run", &ms, &mem_samples_mb, baseline_mem_mb, &metrics);
 }
 
 void BenchmarkBase::print_task(
     const std::string& name,
     const uint64_t* const runtime_ms,
     const std::vector<uint64_t>* const mem_samples_mb,
-    const uint64_t baseline_mem_mb) {
-  std::cout << "{\n";
-  std::cout << "  \"phase\": \"" << name << "\"\n";
+    const uint64_t baseline_mem_mb,
+    const std::vector<std::pair<std::string, std::string>>* const metrics) {
+  std::vector<std::pair<std::string, std::string>> fields;
+  fields.emplace_back("phase", "\"" + name + "\"");
 
   if (runtime_ms) {
-    std::cout << "  \"runtime_ms\": \"" << *runtime_ms << "\"\n";
+    fields.emplace_back(
+        "runtime_ms", "\"" + std::to_string(*runtime_ms) + "\"");
   }
 
   if (mem_samples_mb) {
@@ -164,12 +168,24 @@ void BenchmarkBase::print_task(
     peak_mem_mb = (peak_mem_mb > sample_size) ? peak_mem_mb - sample_size : 0;
     avg_mem_mb = (avg_mem_mb > sample_size) ? avg_mem_mb - sample_size : 0;
 
-    std::cout << "  \"baseline_mem_mb\": \"" << baseline_mem_mb << "\"\n";
-    std::cout << "  \"peak_mem_mb\": \"" << peak_mem_mb << "\"\n";
-    std::cout << "  \"avg_mem_mb\": \"" << static_cast<uint64_t>(avg_mem_mb)
-              << "\"\n";
+    fields.emplace_back(
+        "baseline_mem_mb", "\"" + std::to_string(baseline_mem_mb) + "\"");
+    fields.emplace_back(
+        "peak_mem_mb", "\"" + std::to_string(peak_mem_mb) + "\"");
+    fields.emplace_back(
+        "avg_mem_mb",
+        "\"" + std::to_string(static_cast<uint64_t>(avg_mem_mb)) + "\"");
+  }
+
+  if (metrics) {
+    fields.insert(fields.end(), metrics->begin(), metrics->end());
   }
 
+  std::cout << "{\n";
+  for (size_t i = 0; i < fields.size(); i++) {
+    std::cout << "  \"" << fields[i].first << "\": " << fields[i].second
+              << (i + 1 < fields.size() ? ",\n" : "\n");
+  }
   std::cout << "}\n";
 }
 
@@ -35,6 +35,7 @@
 
 #include <cassert>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -76,6 +77,21 @@ class BenchmarkBase {
   /** Implemented by subclass: the run phase. */
   virtual void run() = 0;
 
+  /**
+   * Optionally implemented by subclass: extra metrics of the run phase,
+   * e.g. throughput or library stats, reported alongside the runtime. Each
+   * value is emitted verbatim and so must be valid JSON.
+   *
+   * @param runtime_ms The runtime of the run phase.
+   * @param metrics Name/value pairs to append to.
+   */
+  virtual void run_metrics(
+      uint64_t runtime_ms,
+      std::vector<std::pair<std::string, std::string>>* metrics) {
+    (void)runtime_ms;
+    (void)metrics;
+  }
+
  private:
   /**
    * Prints metrics for a given task.
@@ -84,7 +100,9 @@ class BenchmarkBase {
       const std::string& name,
       const uint64_t* ms,
       const std::vector<uint64_t>* mem_samples_mb,
-      uint64_t baseline_mem_mb);
+      uint64_t baseline_mem_mb,
+      const std::vector<std::pair<std::string, std::string>>* metrics =
+          nullptr);
 
   /**
    * Samples the current processes's used virtual memory every 50ms
@@ -0,0 +1,211 @@
+/**
+ * @file microbench_filter_pipeline.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ *
+ * Microbenchmarks of `FilterPipeline::run_forward` and `run_reverse` with
+ * each compressor, sweeping the datatype, tile size, chunk size and number
+ * of threads.
+ */
+
+#include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/enums/compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/stats/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace tiledb::common;
+using namespace tiledb::sm;
+
+namespace {
+
+/** The compressors swept, indexed by the first benchmark argument. */
+const std::vector<Compressor> compressors = {Compressor::NO_COMPRESSION,
+                                             Compressor::GZIP,
+                                             Compressor::ZSTD,
+                                             Compressor::LZ4,
+                                             Compressor::RLE,
+                                             Compressor::BZIP2,
+                                             Compressor::DOUBLE_DELTA};
+
+/** The datatypes swept, indexed by the second benchmark argument. */
+const std::vector<Datatype> datatypes = {
+    Datatype::INT32, Datatype::INT64, Datatype::FLOAT64};
+
+/** Throws if `st` is not ok, failing the benchmark. */
+void throw_if_not_ok(const Status& st) {
+  if (!st.ok())
+    throw std::runtime_error(st.to_string());
+}
+
+/**
+ * Fills `tile` with increasing values of `type` with small random steps,
+ * compressible like sorted coordinates or timestamps.
+ */
+template <class T>
+void fill_tile(Tile* const tile, const uint64_t tile_size) {
+  std::vector<T> values(tile_size / sizeof(T));
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int> step(0, 16);
+  T value = 0;
+  for (auto& v : values) {
+    value += static_cast<T>(step(gen));
+    v = value;
+  }
+  throw_if_not_ok(tile->write(values.data(), 0, values.size() * sizeof(T)));
+}
+
+/** Initializes `tile` with `tile_size` bytes of data of `type`. */
+void init_tile(Tile* const tile, const Datatype type, const uint64_t tile_size) {
+  const uint64_t cell_size = datatype_size(type);
+  throw_if_not_ok(tile->init_unfiltered(
+      constants::format_version, type, tile_size, cell_size, 0));
+  switch (type) {
+    case Datatype::INT32:
+      fill_tile<int32_t>(tile, tile_size);
+      break;
+    case Datatype::INT64:
+      fill_tile<int64_t>(tile, tile_size);
+      break;
+    case Datatype::FLOAT64:
+      fill_tile<double>(tile, tile_size);
+      break;
+    default:
+      throw std::invalid_argument("Unsupported datatype");
+  }
+}
+
+/** The pipeline, thread pool and stats of a benchmark. */
+struct PipelineFixture {
+  PipelineFixture(const benchmark::State& state)
+      : compressor_(compressors[state.range(0)])
+      , type_(datatypes[state.range(1)])
+      , tile_size_(state.range(2))
+      , chunk_size_(state.range(3))
+      , stats_("microbench") {
+    throw_if_not_ok(tp_.init(state.range(4)));
+    throw_if_not_ok(pipeline_.add_filter(CompressionFilter(compressor_, -1)));
+    pipeline_.set_max_chunk_size(chunk_size_);
+    Tile::set_max_tile_chunk_size(chunk_size_);
+  }
+
+  ~PipelineFixture() {
+    Tile::set_max_tile_chunk_size(constants::max_tile_chunk_size);
+  }
+
+  /** Labels the benchmark with the compressor and datatype names. */
+  void set_label(benchmark::State& state) const {
+    state.SetLabel(compressor_str(compressor_) + "/" + datatype_str(type_));
+    state.SetBytesProcessed(state.iterations() * tile_size_);
+  }
+
+  const Compressor compressor_;
+  const Datatype type_;
+  const uint64_t tile_size_;
+  const uint32_t chunk_size_;
+  stats::Stats stats_;
+  ThreadPool tp_;
+  FilterPipeline pipeline_;
+};
+
+void BM_FilterPipelineForward(benchmark::State& state) {
+  PipelineFixture fx(state);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Tile tile;
+    init_tile(&tile, fx.type_, fx.tile_size_);
+    state.ResumeTiming();
+
+    throw_if_not_ok(
+        fx.pipeline_.run_forward(&fx.stats_, &tile, nullptr, &fx.tp_));
+    benchmark::DoNotOptimize(tile.filtered_buffer().data());
+  }
+
+  // Report the compression ratio of the last tile.
+  Tile tile;
+  init_tile(&tile, fx.type_, fx.tile_size_);
+  throw_if_not_ok(fx.pipeline_.run_forward(&fx.stats_, &tile, nullptr, &fx.tp_));
+  state.counters["ratio"] =
+      static_cast<double>(fx.tile_size_) / tile.filtered_buffer().size();
+  fx.set_label(state);
+}
+
+void BM_FilterPipelineReverse(benchmark::State& state) {
+  PipelineFixture fx(state);
+  Tile filtered;
+  init_tile(&filtered, fx.type_, fx.tile_size_);
+  throw_if_not_ok(
+      fx.pipeline_.run_forward(&fx.stats_, &filtered, nullptr, &fx.tp_));
+  const Config config;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Tile tile;
+    throw_if_not_ok(tile.init_filtered(
+        constants::format_version, fx.type_, datatype_size(fx.type_), 0));
+    tile.filtered_buffer() = FilteredBuffer(filtered.filtered_buffer());
+    throw_if_not_ok(tile.alloc_data(fx.tile_size_));
+    state.ResumeTiming();
+
+    throw_if_not_ok(
+        fx.pipeline_.run_reverse(&fx.stats_, &tile, &fx.tp_, config));
+    benchmark::DoNotOptimize(tile.data());
+  }
+  fx.set_label(state);
+}
+
+/**
+ * Sweeps the compressors and datatypes, tile sizes of 64KB, 1MB and 16MB,
+ * chunk sizes of 64KB and 1MB, and 1 and 8 threads.
+ */
+void pipeline_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"compressor", "type", "tile_size", "chunk_size", "threads"});
+  b->ArgsProduct(
+      {benchmark::CreateDenseRange(0, compressors.size() - 1, 1),
+       benchmark::CreateDenseRange(0, datatypes.size() - 1, 1),
+       {64 << 10, 1 << 20, 16 << 20},
+       {64 << 10, 1 << 20},
+       {1, 8}});
+  b->Unit(benchmark::kMicrosecond);
+  b->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(BM_FilterPipelineForward)->Apply(pipeline_args);
+BENCHMARK(BM_FilterPipelineReverse)->Apply(pipeline_args);
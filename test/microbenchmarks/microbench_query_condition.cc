@@ -0,0 +1,238 @@
+/**
+ * @file microbench_query_condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ *
+ * Microbenchmarks of the `QueryCondition` kernels applied to a result tile,
+ * sweeping the datatype, operator, tile cell count and selectivity.
+ */
+
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/query_condition_op.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/query/query_condition.h"
+#include "tiledb/sm/query/result_tile.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace tiledb::common;
+using namespace tiledb::sm;
+
+namespace {
+
+/** The operators swept, indexed by the benchmark argument `op`. */
+const std::vector<QueryConditionOp> ops = {
+    QueryConditionOp::LT, QueryConditionOp::EQ, QueryConditionOp::NE};
+
+/** The name of the attribute the condition applies to. */
+const std::string field_name = "a";
+
+/** Throws if `st` is not ok, failing the benchmark. */
+void throw_if_not_ok(const Status& st) {
+  if (!st.ok())
+    throw std::runtime_error(st.to_string());
+}
+
+/** An array schema with one attribute and a result tile of its cells. */
+struct ConditionFixture {
+  ConditionFixture(const Datatype type, const bool var_size, uint64_t cells)
+      : result_tile_(nullptr) {
+    Attribute attr(field_name, type);
+    throw_if_not_ok(
+        attr.set_cell_val_num(var_size ? constants::var_num : 1));
+    throw_if_not_ok(array_schema_.add_attribute(&attr));
+    Domain domain;
+    Dimension dim("d", Datatype::UINT64);
+    uint64_t bounds[2] = {1, std::max<uint64_t>(cells, 2)};
+    throw_if_not_ok(dim.set_domain(Range(bounds, sizeof(bounds))));
+    throw_if_not_ok(domain.add_dimension(&dim));
+    throw_if_not_ok(array_schema_.set_domain(&domain));
+
+    result_tile_ = std::make_unique<ResultTile>(0, 0, &array_schema_);
+    result_tile_->init_attr_tile(field_name);
+  }
+
+  /** Returns the fixed-size or var-size data tile of the attribute. */
+  Tile* tile(const bool var_size) {
+    auto tile_tuple = result_tile_->tile_tuple(field_name);
+    return var_size ? &std::get<1>(*tile_tuple) : &std::get<0>(*tile_tuple);
+  }
+
+  ArraySchema array_schema_;
+  std::unique_ptr<ResultTile> result_tile_;
+};
+
+/**
+ * Benchmarks a condition on a fixed-size attribute of type `T`, whose
+ * values are uniform in [0, 100). `LT` selects `selectivity` percent of
+ * the cells, `EQ` and `NE` compare to `selectivity`.
+ */
+template <class T, Datatype type>
+void BM_QueryConditionFixed(benchmark::State& state) {
+  const auto op = ops[state.range(0)];
+  const uint64_t cells = state.range(1);
+  const T cmp_value = static_cast<T>(state.range(2));
+
+  ConditionFixture fx(type, false, cells);
+  Tile* const tile = fx.tile(false);
+  throw_if_not_ok(tile->init_unfiltered(
+      constants::format_version, type, cells * sizeof(T), sizeof(T), 0));
+  std::vector<T> values(cells);
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int> dist(0, 99);
+  for (auto& v : values)
+    v = static_cast<T>(dist(gen));
+  throw_if_not_ok(tile->write(values.data(), 0, cells * sizeof(T)));
+
+  QueryCondition condition;
+  throw_if_not_ok(condition.init(
+      std::string(field_name), &cmp_value, sizeof(T), op));
+  throw_if_not_ok(condition.check(&fx.array_schema_));
+
+  std::vector<uint8_t> bitmap(cells);
+  uint64_t cell_count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::fill(bitmap.begin(), bitmap.end(), 1);
+    cell_count = cells;
+    state.ResumeTiming();
+
+    throw_if_not_ok(condition.apply_sparse<uint8_t>(
+        &fx.array_schema_, *fx.result_tile_, bitmap, &cell_count));
+    benchmark::DoNotOptimize(bitmap.data());
+  }
+
+  state.SetLabel(
+      datatype_str(type) + "/" + query_condition_op_str(op));
+  state.SetItemsProcessed(state.iterations() * cells);
+  state.counters["selected"] = static_cast<double>(cell_count) / cells;
+}
+
+/**
+ * Benchmarks a condition on a var-size string attribute of 8-character
+ * values. The comparison value is the value at the `selectivity`
+ * percentile of the cells.
+ */
+void BM_QueryConditionString(benchmark::State& state) {
+  const auto op = ops[state.range(0)];
+  const uint64_t cells = state.range(1);
+  const uint64_t cell_size = 8;
+
+  ConditionFixture fx(Datatype::STRING_ASCII, true, cells);
+  std::string values(cells * cell_size, ' ');
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<int> dist('a', 'z');
+  for (auto& c : values)
+    c = static_cast<char>(dist(gen));
+  std::vector<uint64_t> offsets(cells);
+  for (uint64_t i = 0; i < cells; i++)
+    offsets[i] = i * cell_size;
+
+  Tile* const tile = fx.tile(true);
+  throw_if_not_ok(tile->init_unfiltered(
+      constants::format_version,
+      Datatype::STRING_ASCII,
+      values.size(),
+      sizeof(char),
+      0));
+  throw_if_not_ok(tile->write(values.data(), 0, values.size()));
+  Tile* const offsets_tile = fx.tile(false);
+  throw_if_not_ok(offsets_tile->init_unfiltered(
+      constants::format_version,
+      constants::cell_var_offset_type,
+      cells * constants::cell_var_offset_size,
+      constants::cell_var_offset_size,
+      0));
+  throw_if_not_ok(offsets_tile->write(
+      offsets.data(), 0, cells * constants::cell_var_offset_size));
+
+  std::vector<std::string> sorted(cells);
+  for (uint64_t i = 0; i < cells; i++)
+    sorted[i] = values.substr(i * cell_size, cell_size);
+  std::sort(sorted.begin(), sorted.end());
+  const std::string cmp_value =
+      sorted[std::min<uint64_t>(cells * state.range(2) / 100, cells - 1)];
+
+  QueryCondition condition;
+  throw_if_not_ok(condition.init(
+      std::string(field_name), cmp_value.data(), cmp_value.size(), op));
+  throw_if_not_ok(condition.check(&fx.array_schema_));
+
+  std::vector<uint8_t> bitmap(cells);
+  uint64_t cell_count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::fill(bitmap.begin(), bitmap.end(), 1);
+    cell_count = cells;
+    state.ResumeTiming();
+
+    throw_if_not_ok(condition.apply_sparse<uint8_t>(
+        &fx.array_schema_, *fx.result_tile_, bitmap, &cell_count));
+    benchmark::DoNotOptimize(bitmap.data());
+  }
+
+  state.SetLabel("STRING_ASCII/" + query_condition_op_str(op));
+  state.SetItemsProcessed(state.iterations() * cells);
+  state.counters["selected"] = static_cast<double>(cell_count) / cells;
+}
+
+/**
+ * Sweeps the operators, tiles of 4K, 64K and 1M cells, and selectivities
+ * of 1%, 50% and 99%.
+ */
+void condition_args(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"op", "cells", "selectivity"});
+  b->ArgsProduct(
+      {benchmark::CreateDenseRange(0, ops.size() - 1, 1),
+       {4 << 10, 64 << 10, 1 << 20},
+       {1, 50, 99}});
+  b->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE2(BM_QueryConditionFixed, int32_t, Datatype::INT32)
+    ->Apply(condition_args);
+BENCHMARK_TEMPLATE2(BM_QueryConditionFixed, int64_t, Datatype::INT64)
+    ->Apply(condition_args);
+BENCHMARK_TEMPLATE2(BM_QueryConditionFixed, float, Datatype::FLOAT32)
+    ->Apply(condition_args);
+BENCHMARK_TEMPLATE2(BM_QueryConditionFixed, double, Datatype::FLOAT64)
+    ->Apply(condition_args);
+BENCHMARK(BM_QueryConditionString)->Apply(condition_args);
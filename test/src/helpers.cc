@@ -33,6 +33,7 @@
 #include "helpers.h"
 #include "catch.hpp"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/stdx_string.h"
 #include "tiledb/sm/c_api/tiledb_struct_def.h"
 #include "tiledb/sm/cpp_api/tiledb"
 #include "tiledb/sm/enums/encryption_type.h"
@@ -1223,13 +1224,16 @@ int32_t num_fragments(const std::string& array_name) {
   // Get all URIs in the array directory
   auto uris = vfs.ls(array_name);
 
-  // Exclude '__meta' folder and any file with a suffix
+  // Exclude '__meta' folder and any file with a suffix, other than the
+  // packed fragments
   int ret = 0;
   for (const auto& uri : uris) {
     auto name = tiledb::sm::URI(uri).remove_trailing_slash().last_path_part();
+    const bool packed = tiledb::sm::utils::parse::ends_with(
+        name, tiledb::sm::constants::packed_fragment_suffix);
     if (name != tiledb::sm::constants::array_metadata_folder_name &&
         name != tiledb::sm::constants::array_schema_folder_name &&
-        name.find_first_of('.') == std::string::npos)
+        (packed || name.find_first_of('.') == std::string::npos))
       ++ret;
   }
 
@@ -1567,6 +1567,71 @@ TEST_CASE_METHOD(
   remove_array(array_name);
 }
 
+TEST_CASE_METHOD(
+    DenseTilerFx,
+    "DenseTiler: Test get tile, 2D, (row, row), interior tiles",
+    "[DenseTiler][get_tile][2d][row-row][interior]") {
+  // Create array
+  std::string array_name = "dense_tiler";
+  int32_t d_dom_1[] = {1, 20};
+  int32_t d_ext_1 = 4;
+  int32_t d_dom_2[] = {1, 20};
+  int32_t d_ext_2 = 4;
+  create_array(
+      array_name,
+      {{"d1", TILEDB_INT32, d_dom_1, &d_ext_1},
+       {"d2", TILEDB_INT32, d_dom_2, &d_ext_2}},
+      {{"a", TILEDB_INT32, 1, false}},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR);
+
+  // Create subarray (4x5 tiles, with first, interior and last tiles on
+  // both dimensions)
+  open_array(array_name, TILEDB_READ);
+  int32_t sub_0[] = {3, 14};
+  int32_t sub_1[] = {2, 17};
+  tiledb::sm::Subarray subarray(
+      array_->array_,
+      Layout::ROW_MAJOR,
+      &test::g_helper_stats,
+      test::g_helper_logger());
+  add_ranges({sub_0, sub_1}, sizeof(sub_0), &subarray);
+
+  // Create buffers
+  std::unordered_map<std::string, QueryBuffer> buffers;
+  std::vector<int32_t> buff_a(12 * 16);
+  for (size_t i = 0; i < buff_a.size(); ++i)
+    buff_a[i] = (int32_t)i + 1;
+  uint64_t buff_a_size = buff_a.size() * sizeof(int32_t);
+  buffers["a"] = QueryBuffer(&buff_a[0], nullptr, &buff_a_size, nullptr);
+
+  // Create DenseTiler
+  DenseTiler<int32_t> tiler(&buffers, &subarray, &test::g_helper_stats);
+  CHECK(tiler.tile_num() == 20);
+
+  // Test all the tiles
+  for (uint64_t id = 0; id < 20; ++id) {
+    WriterTile tile;
+    CHECK(tiler.get_tile(id, "a", &tile).ok());
+    const int32_t tile_low_1 = (int32_t)(id / 5) * 4 + 1;
+    const int32_t tile_low_2 = (int32_t)(id % 5) * 4 + 1;
+    std::vector<int32_t> c_data(16);
+    for (int32_t i = 0; i < 4; ++i) {
+      for (int32_t j = 0; j < 4; ++j) {
+        const int32_t r = tile_low_1 + i;
+        const int32_t c = tile_low_2 + j;
+        const bool in_sub = r >= 3 && r <= 14 && c >= 2 && c <= 17;
+        c_data[i * 4 + j] = in_sub ? (r - 3) * 16 + (c - 2) + 1 : fill_value;
+      }
+    }
+    CHECK(check_tile<int32_t>(&tile, c_data));
+  }
+
+  // Clean up
+  close_array();
+  remove_array(array_name);
+}
+
 TEST_CASE_METHOD(
     DenseTilerFx,
     "DenseTiler: Test get tile, 2D, (col, col)",
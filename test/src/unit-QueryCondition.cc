@@ -34,12 +34,16 @@
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/enums/query_condition_combination_op.h"
 #include "tiledb/sm/enums/query_condition_op.h"
 #include "tiledb/sm/query/query_condition.h"
 
 #include <catch.hpp>
+#include <algorithm>
 #include <iostream>
 
 using namespace tiledb::sm;
@@ -1242,6 +1246,29 @@ void test_apply_cells_dense(
       ++expected_iter;
     }
   }
+
+  // Apply the query condition on every other cell.
+  std::vector<uint8_t> result_bitmap_stride(cells / 2, 1);
+  REQUIRE(query_condition
+              .apply_dense(
+                  array_schema,
+                  result_tile,
+                  0,
+                  cells / 2,
+                  0,
+                  2,
+                  result_bitmap_stride.data())
+              .ok());
+
+  // Verify the result bitmap contain the expected cells.
+  for (uint64_t c = 0; c < cells / 2; ++c) {
+    const bool expected =
+        std::find(
+            expected_cell_idx_vec.begin(),
+            expected_cell_idx_vec.end(),
+            c * 2) != expected_cell_idx_vec.end();
+    REQUIRE(result_bitmap_stride[c] == expected);
+  }
 }
 
 /**
@@ -2390,6 +2417,321 @@ TEST_CASE(
   free(values);
 }
 
+TEST_CASE(
+    "QueryCondition: Test combinations sparse multiple blocks",
+    "[QueryCondition][combinations][sparse]") {
+  const std::string field_name = "foo";
+  const uint64_t cells = 3000;
+  const Datatype type = Datatype::UINT64;
+
+  // Initialize the array schema.
+  ArraySchema array_schema;
+  Attribute attr(field_name, type);
+  REQUIRE(array_schema.add_attribute(&attr).ok());
+  Domain domain;
+  Dimension dim("dim1", Datatype::UINT32);
+  uint32_t bounds[2] = {1, cells};
+  Range range(bounds, 2 * sizeof(uint32_t));
+  REQUIRE(dim.set_domain(range).ok());
+  REQUIRE(domain.add_dimension(&dim).ok());
+  REQUIRE(array_schema.set_domain(&domain).ok());
+
+  // Initialize the result tile.
+  ResultTile result_tile(0, 0, &array_schema);
+  result_tile.init_attr_tile(field_name);
+  ResultTile::TileTuple* const tile_tuple = result_tile.tile_tuple(field_name);
+  Tile* const tile = &std::get<0>(*tile_tuple);
+
+  // Initialize and populate the data tile.
+  REQUIRE(tile->init_unfiltered(
+                  constants::format_version,
+                  type,
+                  cells * sizeof(uint64_t),
+                  sizeof(uint64_t),
+                  0)
+              .ok());
+  std::vector<uint64_t> values(cells);
+  for (uint64_t i = 0; i < cells; ++i) {
+    values[i] = i;
+  }
+  REQUIRE(tile->write(values.data(), 0, cells * sizeof(uint64_t)).ok());
+
+  // Build a combined query for `> 1500 AND <= 2500`, which filters out all
+  // cells of the first block and spans the block boundaries.
+  uint64_t cmp_value_1 = 1500;
+  QueryCondition query_condition_1;
+  REQUIRE(query_condition_1
+              .init(
+                  std::string(field_name),
+                  &cmp_value_1,
+                  sizeof(uint64_t),
+                  QueryConditionOp::GT)
+              .ok());
+  REQUIRE(query_condition_1.check(&array_schema).ok());
+  uint64_t cmp_value_2 = 2500;
+  QueryCondition query_condition_2;
+  REQUIRE(query_condition_2
+              .init(
+                  std::string(field_name),
+                  &cmp_value_2,
+                  sizeof(uint64_t),
+                  QueryConditionOp::LE)
+              .ok());
+  REQUIRE(query_condition_2.check(&array_schema).ok());
+  QueryCondition query_condition_3;
+  REQUIRE(query_condition_1
+              .combine(
+                  query_condition_2,
+                  QueryConditionCombinationOp::AND,
+                  &query_condition_3)
+              .ok());
+
+  // Apply the query condition.
+  uint64_t cell_count = 0;
+  std::vector<uint8_t> result_bitmap(cells, 1);
+  REQUIRE(query_condition_3
+              .apply_sparse<uint8_t>(
+                  &array_schema, result_tile, result_bitmap, &cell_count)
+              .ok());
+
+  // Check that the bitmap contains cell indexes 1501 to 2500.
+  REQUIRE(cell_count == 1000);
+  for (uint64_t cell_idx = 0; cell_idx < cells; ++cell_idx) {
+    REQUIRE(
+        result_bitmap[cell_idx] ==
+        (cell_idx > 1500 && cell_idx <= 2500 ? 1 : 0));
+  }
+}
+
+TEST_CASE(
+    "QueryCondition: Test set operators sparse",
+    "[QueryCondition][set][sparse]") {
+  const std::string field_name = "foo";
+  const uint64_t cells = 100;
+  const Datatype type = Datatype::UINT64;
+  const QueryConditionOp op =
+      GENERATE(QueryConditionOp::IN, QueryConditionOp::NOT_IN);
+
+  // Initialize the array schema.
+  ArraySchema array_schema;
+  Attribute attr(field_name, type);
+  REQUIRE(array_schema.add_attribute(&attr).ok());
+  Domain domain;
+  Dimension dim("dim1", Datatype::UINT32);
+  uint32_t bounds[2] = {1, cells};
+  Range range(bounds, 2 * sizeof(uint32_t));
+  REQUIRE(dim.set_domain(range).ok());
+  REQUIRE(domain.add_dimension(&dim).ok());
+  REQUIRE(array_schema.set_domain(&domain).ok());
+
+  // Initialize the result tile.
+  ResultTile result_tile(0, 0, &array_schema);
+  result_tile.init_attr_tile(field_name);
+  ResultTile::TileTuple* const tile_tuple = result_tile.tile_tuple(field_name);
+  Tile* const tile = &std::get<0>(*tile_tuple);
+
+  // Initialize and populate the data tile.
+  REQUIRE(tile->init_unfiltered(
+                  constants::format_version,
+                  type,
+                  cells * sizeof(uint64_t),
+                  sizeof(uint64_t),
+                  0)
+              .ok());
+  std::vector<uint64_t> values(cells);
+  for (uint64_t i = 0; i < cells; ++i) {
+    values[i] = i;
+  }
+  REQUIRE(tile->write(values.data(), 0, cells * sizeof(uint64_t)).ok());
+
+  // The set is unsorted, has a duplicate and a value that is not in the tile.
+  std::vector<uint64_t> set = {42, 7, 99, 7, 1000};
+  std::vector<uint64_t> offsets(set.size());
+  for (uint64_t i = 0; i < set.size(); ++i) {
+    offsets[i] = i * sizeof(uint64_t);
+  }
+
+  QueryCondition query_condition;
+  REQUIRE(query_condition
+              .init_set(
+                  std::string(field_name),
+                  set.data(),
+                  set.size() * sizeof(uint64_t),
+                  offsets.data(),
+                  offsets.size(),
+                  op)
+              .ok());
+  REQUIRE(query_condition.check(&array_schema).ok());
+
+  // Apply the query condition.
+  uint64_t cell_count = 0;
+  std::vector<uint8_t> result_bitmap(cells, 1);
+  REQUIRE(query_condition
+              .apply_sparse<uint8_t>(
+                  &array_schema, result_tile, result_bitmap, &cell_count)
+              .ok());
+
+  const bool in = op == QueryConditionOp::IN;
+  REQUIRE(cell_count == (in ? 3 : cells - 3));
+  for (uint64_t cell_idx = 0; cell_idx < cells; ++cell_idx) {
+    const bool member = cell_idx == 7 || cell_idx == 42 || cell_idx == 99;
+    REQUIRE(result_bitmap[cell_idx] == (member == in ? 1 : 0));
+  }
+
+  // The members must have the size of the attribute cells.
+  uint32_t small_value = 42;
+  uint64_t small_offset = 0;
+  QueryCondition query_condition_small;
+  REQUIRE(query_condition_small
+              .init_set(
+                  std::string(field_name),
+                  &small_value,
+                  sizeof(uint32_t),
+                  &small_offset,
+                  1,
+                  op)
+              .ok());
+  REQUIRE(!query_condition_small.check(&array_schema).ok());
+
+  // Set operators can only be initialized with a set.
+  QueryCondition query_condition_value;
+  REQUIRE(!query_condition_value
+               .init(std::string(field_name), set.data(), sizeof(uint64_t), op)
+               .ok());
+
+  // The prefix operator is only supported on strings.
+  QueryCondition query_condition_prefix;
+  REQUIRE(query_condition_prefix
+              .init(
+                  std::string(field_name),
+                  set.data(),
+                  sizeof(uint64_t),
+                  QueryConditionOp::PREFIX)
+              .ok());
+  REQUIRE(!query_condition_prefix.check(&array_schema).ok());
+}
+
+TEST_CASE(
+    "QueryCondition: Test set and prefix operators on strings sparse",
+    "[QueryCondition][set][prefix][sparse]") {
+  const std::string field_name = "foo";
+  const Datatype type = Datatype::STRING_ASCII;
+  const std::vector<std::string> strings = {
+      "apple", "apricot", "banana", "", "ap", "cherry", "a", "banana"};
+  const uint64_t cells = strings.size();
+
+  // Initialize the array schema.
+  ArraySchema array_schema;
+  Attribute attr(field_name, type);
+  REQUIRE(attr.set_cell_val_num(constants::var_num).ok());
+  REQUIRE(array_schema.add_attribute(&attr).ok());
+  Domain domain;
+  Dimension dim("dim1", Datatype::UINT32);
+  uint32_t bounds[2] = {1, static_cast<uint32_t>(cells)};
+  Range range(bounds, 2 * sizeof(uint32_t));
+  REQUIRE(dim.set_domain(range).ok());
+  REQUIRE(domain.add_dimension(&dim).ok());
+  REQUIRE(array_schema.set_domain(&domain).ok());
+
+  // Initialize the result tile.
+  ResultTile result_tile(0, 0, &array_schema);
+  result_tile.init_attr_tile(field_name);
+  ResultTile::TileTuple* const tile_tuple = result_tile.tile_tuple(field_name);
+
+  std::string data;
+  std::vector<uint64_t> offsets;
+  for (const auto& str : strings) {
+    offsets.emplace_back(data.size());
+    data += str;
+  }
+
+  Tile* const tile = &std::get<1>(*tile_tuple);
+  REQUIRE(tile->init_unfiltered(
+                  constants::format_version, type, data.size(), 1, 0)
+              .ok());
+  REQUIRE(tile->write(data.data(), 0, data.size()).ok());
+
+  Tile* const tile_offsets = &std::get<0>(*tile_tuple);
+  REQUIRE(tile_offsets
+              ->init_unfiltered(
+                  constants::format_version,
+                  constants::cell_var_offset_type,
+                  cells * constants::cell_var_offset_size,
+                  constants::cell_var_offset_size,
+                  0)
+              .ok());
+  REQUIRE(tile_offsets->write(offsets.data(), 0, cells * sizeof(uint64_t))
+              .ok());
+
+  std::vector<bool> expected(cells);
+  QueryCondition query_condition;
+  SECTION("- IN") {
+    const std::string set_data = "bananaapple";
+    const std::vector<uint64_t> set_offsets = {0, 6, 11};
+    REQUIRE(query_condition
+                .init_set(
+                    std::string(field_name),
+                    set_data.data(),
+                    set_data.size(),
+                    set_offsets.data(),
+                    set_offsets.size(),
+                    QueryConditionOp::IN)
+                .ok());
+    for (uint64_t i = 0; i < cells; ++i) {
+      expected[i] =
+          strings[i] == "banana" || strings[i] == "apple" || strings[i] == "";
+    }
+  }
+
+  SECTION("- NOT_IN") {
+    const std::string set_data = "cherryap";
+    const std::vector<uint64_t> set_offsets = {0, 6};
+    REQUIRE(query_condition
+                .init_set(
+                    std::string(field_name),
+                    set_data.data(),
+                    set_data.size(),
+                    set_offsets.data(),
+                    set_offsets.size(),
+                    QueryConditionOp::NOT_IN)
+                .ok());
+    for (uint64_t i = 0; i < cells; ++i) {
+      expected[i] = strings[i] != "cherry" && strings[i] != "ap";
+    }
+  }
+
+  SECTION("- PREFIX") {
+    const std::string prefix = "ap";
+    REQUIRE(query_condition
+                .init(
+                    std::string(field_name),
+                    prefix.data(),
+                    prefix.size(),
+                    QueryConditionOp::PREFIX)
+                .ok());
+    for (uint64_t i = 0; i < cells; ++i) {
+      expected[i] = strings[i].compare(0, prefix.size(), prefix) == 0;
+    }
+  }
+
+  REQUIRE(query_condition.check(&array_schema).ok());
+
+  // Apply the query condition.
+  uint64_t cell_count = 0;
+  std::vector<uint8_t> result_bitmap(cells, 1);
+  REQUIRE(query_condition
+              .apply_sparse<uint8_t>(
+                  &array_schema, result_tile, result_bitmap, &cell_count)
+              .ok());
+
+  uint64_t expected_count = 0;
+  for (uint64_t cell_idx = 0; cell_idx < cells; ++cell_idx) {
+    REQUIRE(result_bitmap[cell_idx] == (expected[cell_idx] ? 1 : 0));
+    expected_count += expected[cell_idx];
+  }
+  REQUIRE(cell_count == expected_count);
+}
+
 TEST_CASE(
     "QueryCondition: Test empty/null strings sparse",
     "[QueryCondition][empty_string][null_string][sparse]") {
@@ -2560,4 +2902,106 @@ TEST_CASE(
   }
 
   free(values);
-}
\ No newline at end of file
+}
+TEST_CASE(
+    "QueryCondition: Test run-length encoded attribute",
+    "[QueryCondition][rle]") {
+  const std::string field_name = "foo";
+  const uint64_t cells = 100;
+  const Datatype type = Datatype::UINT32;
+
+  // Initialize the array schema with an RLE compressed attribute.
+  ArraySchema array_schema;
+  Attribute attr(field_name, type);
+  FilterPipeline filters;
+  REQUIRE(filters.add_filter(CompressionFilter(Compressor::RLE, -1)).ok());
+  REQUIRE(attr.set_filter_pipeline(&filters).ok());
+  REQUIRE(array_schema.add_attribute(&attr).ok());
+  Domain domain;
+  Dimension dim("dim1", Datatype::UINT32);
+  uint32_t bounds[2] = {1, static_cast<uint32_t>(cells)};
+  Range range(bounds, 2 * sizeof(uint32_t));
+  REQUIRE(dim.set_domain(range).ok());
+  REQUIRE(domain.add_dimension(&dim).ok());
+  REQUIRE(array_schema.set_domain(&domain).ok());
+
+  // Initialize the result tile with runs of equal values.
+  ResultTile result_tile(0, 0, &array_schema);
+  result_tile.init_attr_tile(field_name);
+  ResultTile::TileTuple* const tile_tuple = result_tile.tile_tuple(field_name);
+  std::vector<uint32_t> values(cells);
+  for (uint64_t i = 0; i < cells; ++i)
+    values[i] = static_cast<uint32_t>(i / 7 % 5);
+
+  Tile* const tile = &std::get<0>(*tile_tuple);
+  REQUIRE(tile->init_unfiltered(
+                  constants::format_version,
+                  type,
+                  cells * sizeof(uint32_t),
+                  sizeof(uint32_t),
+                  0)
+              .ok());
+  REQUIRE(tile->write(values.data(), 0, cells * sizeof(uint32_t)).ok());
+
+  std::vector<bool> expected(cells);
+  QueryCondition query_condition;
+  SECTION("- GE") {
+    const uint32_t cmp_value = 3;
+    REQUIRE(query_condition
+                .init(
+                    std::string(field_name),
+                    &cmp_value,
+                    sizeof(uint32_t),
+                    QueryConditionOp::GE)
+                .ok());
+    for (uint64_t i = 0; i < cells; ++i)
+      expected[i] = values[i] >= cmp_value;
+  }
+
+  SECTION("- IN") {
+    const std::vector<uint32_t> set = {1, 4};
+    const std::vector<uint64_t> set_offsets = {0, sizeof(uint32_t)};
+    REQUIRE(query_condition
+                .init_set(
+                    std::string(field_name),
+                    set.data(),
+                    set.size() * sizeof(uint32_t),
+                    set_offsets.data(),
+                    set_offsets.size(),
+                    QueryConditionOp::IN)
+                .ok());
+    for (uint64_t i = 0; i < cells; ++i)
+      expected[i] = values[i] == 1 || values[i] == 4;
+  }
+
+  REQUIRE(query_condition.check(&array_schema).ok());
+
+  // Apply the query condition on sparse cells.
+  uint64_t cell_count = 0;
+  std::vector<uint8_t> result_bitmap(cells, 1);
+  REQUIRE(query_condition
+              .apply_sparse<uint8_t>(
+                  &array_schema, result_tile, result_bitmap, &cell_count)
+              .ok());
+  uint64_t expected_count = 0;
+  for (uint64_t cell_idx = 0; cell_idx < cells; ++cell_idx) {
+    REQUIRE(result_bitmap[cell_idx] == (expected[cell_idx] ? 1 : 0));
+    expected_count += expected[cell_idx];
+  }
+  REQUIRE(cell_count == expected_count);
+
+  // Apply the query condition on every other dense cell.
+  std::vector<uint8_t> result_buffer(cells / 2, 1);
+  REQUIRE(query_condition
+              .apply_dense(
+                  &array_schema,
+                  &result_tile,
+                  0,
+                  cells / 2,
+                  0,
+                  2,
+                  result_buffer.data())
+              .ok());
+  for (uint64_t c = 0; c < cells / 2; ++c)
+    REQUIRE(result_buffer[c] == (expected[c * 2] ? 1 : 0));
+}
@@ -924,4 +924,167 @@ TEST_CASE_METHOD(
       &subarray, 37, 57, 32, 63, {2, 0, 0}, {3, 3, 3});
 
   close_array(ctx_, array_);
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(
+    SubarrayFx,
+    "Subarray: Test bulk point ranges and radix sort",
+    "[Subarray][point_ranges][sort]") {
+  int64_t domain[] = {-10000, 10000};
+  int64_t tile_extent = 100;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d"},
+      {TILEDB_INT64},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      2);
+
+  open_array(ctx_, array_, TILEDB_READ);
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+
+  // Runs of consecutive points are coalesced, including across chunks
+  // and with the last range already added
+  std::vector<int64_t> points = {-3, -2, 5, 6, 7, 7, 9, 1, 2};
+  Subarray subarray(
+      array_->array_, Layout::UNORDERED, &g_helper_stats, g_helper_logger());
+  int64_t first[] = {-5, -4};
+  subarray.add_range(0, first, &first[1], nullptr);
+  CHECK(subarray.add_point_ranges(0, points.data(), points.size(), &tp).ok());
+  std::vector<std::pair<int64_t, int64_t>> expected = {
+      {-5, -2}, {5, 7}, {7, 7}, {9, 9}, {1, 2}};
+  auto& ranges = subarray.ranges_for_dim(0);
+  REQUIRE(ranges.size() == expected.size());
+  for (size_t r = 0; r < ranges.size(); ++r) {
+    auto bounds = (const int64_t*)ranges[r].data();
+    CHECK(bounds[0] == expected[r].first);
+    CHECK(bounds[1] == expected[r].second);
+  }
+
+  // Out-of-bounds points fall back to the per-point path
+  int64_t oob[] = {20000};
+  CHECK(!subarray.add_point_ranges(0, oob, 1, &tp).ok());
+
+  // Sort enough ranges for the radix sort, with negative bounds and
+  // ranges that only differ in their ends
+  Subarray large(
+      array_->array_,
+      Layout::UNORDERED,
+      &g_helper_stats,
+      g_helper_logger(),
+      false);
+  std::vector<std::pair<int64_t, int64_t>> bounds;
+  for (int64_t i = 0; i < 10000; ++i) {
+    int64_t start = ((i * 7919) % 20001) - 10000;
+    int64_t end = std::min<int64_t>(start + (i % 3), 10000);
+    bounds.emplace_back(start, end);
+    bounds.emplace_back(start, start);
+  }
+  for (auto& b : bounds)
+    CHECK(large.add_range(0, &b.first, &b.second, nullptr).ok());
+  CHECK(large.sort_ranges(&tp).ok());
+  std::sort(bounds.begin(), bounds.end());
+  auto& sorted = large.ranges_for_dim(0);
+  REQUIRE(sorted.size() == bounds.size());
+  for (size_t r = 0; r < sorted.size(); ++r) {
+    auto s = (const int64_t*)sorted[r].data();
+    CHECK(s[0] == bounds[r].first);
+    CHECK(s[1] == bounds[r].second);
+  }
+
+  close_array(ctx_, array_);
+}
+
+TEST_CASE_METHOD(
+    SubarrayFx,
+    "Subarray: Test relevant fragments through the fragment domain index",
+    "[Subarray][relevant_fragments]") {
+  int64_t domain[] = {-10000, 10000};
+  int64_t tile_extent = 100;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d"},
+      {TILEDB_INT64},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      2);
+
+  // Write enough narrow fragments for the index to be used, plus a wide
+  // fragment that overlaps all of them
+  const int64_t frag_num = constants::fragment_domain_index_min_fragment_num;
+  for (int64_t i = 0; i <= frag_num; ++i) {
+    std::vector<int64_t> coords = {i * 100, i * 100 + 50};
+    if (i == frag_num)
+      coords = {-9000, 9000};
+    std::vector<int32_t> a = {1, 2};
+    tiledb::test::QueryBuffers buffers;
+    buffers["d"] = tiledb::test::QueryBuffer(
+        {&coords[0], coords.size() * sizeof(int64_t), nullptr, 0});
+    buffers["a"] = tiledb::test::QueryBuffer(
+        {&a[0], a.size() * sizeof(int32_t), nullptr, 0});
+    write_array(ctx_, array_name_, TILEDB_UNORDERED, buffers);
+  }
+
+  open_array(ctx_, array_, TILEDB_READ);
+  REQUIRE(array_->array_->fragment_domain_index() != nullptr);
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+
+  std::vector<std::pair<int64_t, int64_t>> ranges;
+  SECTION("- Single range") {
+    ranges = {{120, 130}};
+  }
+
+  SECTION("- Ranges between fragments") {
+    ranges = {{-9500, -9400}, {160, 190}, {9500, 9600}};
+  }
+
+  SECTION("- Multiple ranges") {
+    ranges = {{-9500, 0}, {2540, 2560}, {3050, 3100}, {5000, 9999}};
+  }
+
+  Subarray subarray(
+      array_->array_, Layout::UNORDERED, &g_helper_stats, g_helper_logger());
+  for (const auto& r : ranges) {
+    int64_t bounds[] = {r.first, r.second};
+    CHECK(subarray.add_range(0, bounds, &bounds[1], nullptr).ok());
+  }
+
+  Config config;
+  CHECK(subarray
+            .precompute_tile_overlap(
+                0, subarray.range_num() - 1, &config, &tp, true)
+            .ok());
+
+  // Compare against testing every fragment
+  std::vector<unsigned> expected;
+  auto meta = array_->array_->fragment_metadata();
+  for (unsigned f = 0; f < meta.size(); ++f) {
+    auto ned = (const int64_t*)meta[f]->non_empty_domain()[0].data();
+    for (const auto& r : ranges) {
+      if (ned[0] <= r.second && ned[1] >= r.first) {
+        expected.emplace_back(f);
+        break;
+      }
+    }
+  }
+  CHECK(*subarray.relevant_fragments() == expected);
+
+  close_array(ctx_, array_);
+}
@@ -2623,4 +2623,56 @@ TEST_CASE_METHOD(
       memory_budget_var);
 
   close_array(ctx_, array_);
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(
+    SubarrayPartitionerSparseFx,
+    "SubarrayPartitioner (Sparse): 1D, multi-range, cost model",
+    "[SubarrayPartitioner][sparse][1D][MR][cost_model]") {
+  create_default_1d_array(TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR);
+  write_default_1d_array();
+  open_array(ctx_, array_, TILEDB_READ);
+
+  // The two ranges fall in disjoint tiles, so they fit in one partition
+  // unless the cost of the tiles of the second range exceeds the target
+  SubarrayRanges<uint64_t> ranges = {{2, 2, 12, 12}};
+  std::vector<SubarrayRanges<uint64_t>> partitions;
+  Config config;
+  SECTION("Disabled") {
+    partitions = {{{2, 2, 12, 12}}};
+  }
+
+  SECTION("I/O cost") {
+    CHECK(config.set("sm.partitioner.target_cost", "1").ok());
+    partitions = {{{2, 2}}, {{12, 12}}};
+  }
+
+  SECTION("CPU cost") {
+    CHECK(config.set("sm.partitioner.target_cost", "1").ok());
+    CHECK(config.set("sm.partitioner.io_cost_per_byte", "0").ok());
+    CHECK(config.set("sm.partitioner.cpu_cost_per_byte", "1").ok());
+    partitions = {{{2, 2}}, {{12, 12}}};
+  }
+
+  SECTION("Large target") {
+    CHECK(config.set("sm.partitioner.target_cost", "1000000").ok());
+    partitions = {{{2, 2, 12, 12}}};
+  }
+
+  Subarray subarray;
+  create_subarray(array_->array_, ranges, Layout::ROW_MAJOR, &subarray);
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  SubarrayPartitioner subarray_partitioner(
+      &config,
+      subarray,
+      memory_budget_,
+      memory_budget_var_,
+      0,
+      &tp,
+      &g_helper_stats,
+      g_helper_logger());
+  CHECK(subarray_partitioner.set_result_budget(TILEDB_COORDS, 1000).ok());
+  check_partitions(subarray_partitioner, partitions, false);
+
+  close_array(ctx_, array_);
+}
@@ -30,8 +30,12 @@
  * Tests the `Tile` class.
  */
 
+#include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/huge_page_mode.h"
+#include "tiledb/sm/tile/large_buffer_allocator.h"
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_buffer_pool.h"
 
 #include <catch.hpp>
 #include <iostream>
@@ -222,4 +226,123 @@ TEST_CASE("Tile: Test move-assignment", "[Tile][move_assignment]") {
 
   free(buffer);
   free(read_buffer);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tile: Test release data", "[Tile][release_data]") {
+  Tile tile;
+  const uint64_t tile_size = 1024;
+  CHECK(tile.init_unfiltered(0, Datatype::UINT8, tile_size, 1, 0).ok());
+  for (uint64_t i = 0; i < tile_size; ++i)
+    tile.data_as<uint8_t>()[i] = static_cast<uint8_t>(i);
+  void* data = tile.data();
+
+  // Hand the data over to a buffer without copying it.
+  Buffer buff;
+  CHECK(buff.write(&tile_size, sizeof(tile_size)).ok());
+  buff.own_data(tile.release_data(), tile_size);
+  CHECK(tile.data() == nullptr);
+  CHECK(tile.size() == 0);
+  CHECK(buff.data() == data);
+  CHECK(buff.owns_data());
+  CHECK(buff.size() == tile_size);
+  CHECK(buff.offset() == 0);
+  for (uint64_t i = 0; i < tile_size; ++i) {
+    uint8_t value = 0;
+    CHECK(buff.read(&value, sizeof(uint8_t)).ok());
+    CHECK(value == static_cast<uint8_t>(i));
+  }
+}
+
+TEST_CASE("Tile: Test recycling buffers", "[Tile][tile_buffer_pool]") {
+  // Size classes are spaced by a quarter of a power of 2.
+  CHECK(TileBufferPool::size_class(1) == 64);
+  CHECK(TileBufferPool::size_class(64) == 64);
+  CHECK(TileBufferPool::size_class(65) == 80);
+  CHECK(TileBufferPool::size_class(1000) == 1024);
+  CHECK(TileBufferPool::size_class(1025) == 1280);
+
+  TileBufferPool pool(1024 * 1024);
+  Tile tile;
+  CHECK(tile.alloc_data(1000, &pool).ok());
+  CHECK(tile.size() == 1000);
+  void* const data = tile.data();
+  memset(data, 1, 1000);
+
+  // The buffer is returned to the pool and reused for the same size class.
+  tile.recycle_data(&pool);
+  CHECK(tile.size() == 0);
+  CHECK(pool.idle_size() > 0);
+  Tile tile2;
+  CHECK(tile2.alloc_data(1020, &pool).ok());
+  CHECK(tile2.data() == data);
+  CHECK(pool.reuse_num() == 1);
+  CHECK(pool.idle_size() == 0);
+
+  // Buffers not drawn from the pool are not recycled.
+  Tile tile3;
+  CHECK(tile3.alloc_data(1000).ok());
+  tile3.recycle_data(&pool);
+  CHECK(tile3.size() == 1000);
+  CHECK(pool.idle_size() == 0);
+
+  // Idle buffers over the budget are freed.
+  TileBufferPool small_pool(100);
+  Tile tile4;
+  CHECK(tile4.alloc_data(1000, &small_pool).ok());
+  tile4.recycle_data(&small_pool);
+  CHECK(small_pool.idle_size() == 0);
+}
+
+TEST_CASE(
+    "Tile: Test recycling buffers on free", "[Tile][tile_buffer_pool]") {
+  TileBufferPool pool(1024 * 1024, true);
+  void* data = nullptr;
+  {
+    Tile tile;
+    CHECK(tile.alloc_data(1000, &pool).ok());
+    data = tile.data();
+  }
+
+  // The buffer of the destroyed tile is back in the pool.
+  CHECK(pool.idle_size() > 0);
+  Tile tile;
+  CHECK(tile.alloc_data(1000, &pool).ok());
+  CHECK(tile.data() == data);
+  CHECK(pool.reuse_num() == 1);
+
+  // Trimming frees the idle buffers.
+  Tile tile2;
+  CHECK(tile2.alloc_data(5000, &pool).ok());
+  tile2.recycle_data(&pool);
+  CHECK(pool.idle_size() > 0);
+  pool.trim();
+  CHECK(pool.idle_size() == 0);
+}
+
+TEST_CASE(
+    "Tile: Test large buffer allocation", "[Tile][large_buffer_allocator]") {
+  auto huge_page_mode = GENERATE(
+      HugePageMode::NONE, HugePageMode::TRANSPARENT, HugePageMode::EXPLICIT);
+  LargeBufferAllocator allocator(1024 * 1024, huge_page_mode, true);
+  CHECK(!allocator.use_for(1000));
+  CHECK(allocator.use_for(1024 * 1024));
+
+  // Small buffers still come from the heap.
+  Tile small_tile;
+  CHECK(small_tile.alloc_data(1000, nullptr, &allocator).ok());
+  CHECK(small_tile.size() == 1000);
+
+  // Large buffers get their own mapping, freed with the tile.
+  Tile tile;
+  const uint64_t size = 3 * 1024 * 1024 + 1;
+  CHECK(tile.alloc_data(size, nullptr, &allocator).ok());
+  CHECK(tile.size() == size);
+  memset(tile.data(), 1, size);
+  CHECK(static_cast<char*>(tile.data())[size - 1] == 1);
+
+  // Large buffers are not recycled by a pool.
+  TileBufferPool pool(16 * 1024 * 1024);
+  tile.recycle_data(&pool);
+  CHECK(tile.size() == size);
+  CHECK(pool.idle_size() == 0);
+}
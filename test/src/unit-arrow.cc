@@ -437,3 +437,97 @@ TEST_CASE("Arrow IO integration tests", "[arrow]") {
     test_for_column_size(sz);
   }
 }
+
+TEST_CASE("Arrow batch reader", "[arrow][batch-reader]") {
+  std::string uri("test_arrow_batch_reader");
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(uri))
+    vfs.remove_dir(uri);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  auto a = Attribute::create<int32_t>(ctx, "a");
+  a.set_nullable(true);
+  schema.add_attribute(a);
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(uri, schema);
+
+  // Write 5 cells, with a null at cell 3
+  std::vector<int32_t> d_data = {1, 2, 3, 4, 5};
+  std::vector<int32_t> a_data = {10, 20, 0, 40, 50};
+  std::vector<uint8_t> a_validity = {1, 1, 0, 1, 1};
+  std::string s_data = "abbcccddddeeeee";
+  std::vector<uint64_t> s_offsets = {0, 1, 3, 6, 10};
+  {
+    Array array(ctx, uri, TILEDB_WRITE);
+    Query query(ctx, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_data_buffer("d", d_data)
+        .set_data_buffer("a", a_data)
+        .set_validity_buffer("a", a_validity)
+        .set_data_buffer("s", s_data)
+        .set_offsets_buffer("s", s_offsets);
+    query.submit();
+    array.close();
+  }
+
+  Config config;
+  config["sm.var_offsets.bitsize"] = 32;
+  config["sm.var_offsets.mode"] = "elements";
+  config["sm.var_offsets.extra_element"] = "true";
+  Context read_ctx(config);
+  Array array(read_ctx, uri, TILEDB_READ);
+  Query query(read_ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_GLOBAL_ORDER);
+
+  // A small var-sized estimate may require growing the string buffers
+  tiledb::arrow::ArrowBatchReader reader(
+      &read_ctx, &query, {"d", "a", "s"}, 2, 1);
+
+  std::vector<int64_t> lengths;
+  std::vector<int32_t> d_read, a_read;
+  std::string s_read;
+  int64_t null_count = 0;
+  ArrowArray arw_array;
+  ArrowSchema arw_schema;
+  while (reader.read_next(&arw_array, &arw_schema)) {
+    CHECK(std::string(arw_schema.format) == "+s");
+    REQUIRE(arw_array.n_children == 3);
+    REQUIRE(arw_schema.n_children == 3);
+    lengths.push_back(arw_array.length);
+
+    auto d_arr = arw_array.children[0];
+    auto a_arr = arw_array.children[1];
+    auto s_arr = arw_array.children[2];
+    CHECK(arw_schema.children[1]->flags == ARROW_FLAG_NULLABLE);
+    CHECK(a_arr->buffers[0] != nullptr);
+    null_count += a_arr->null_count;
+    for (int64_t i = 0; i < arw_array.length; i++) {
+      d_read.push_back(static_cast<const int32_t*>(d_arr->buffers[1])[i]);
+      auto valid = static_cast<const uint8_t*>(a_arr->buffers[0]);
+      if (valid[i / 8] & (1 << (i % 8)))
+        a_read.push_back(static_cast<const int32_t*>(a_arr->buffers[1])[i]);
+      auto offsets = static_cast<const uint32_t*>(s_arr->buffers[1]);
+      auto chars = static_cast<const char*>(s_arr->buffers[2]);
+      s_read.append(chars + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    arw_array.release(&arw_array);
+    arw_schema.release(&arw_schema);
+  }
+
+  CHECK(lengths.size() >= 3);
+  for (auto length : lengths)
+    CHECK(length <= 2);
+  CHECK(d_read == d_data);
+  CHECK(a_read == std::vector<int32_t>({10, 20, 40, 50}));
+  CHECK(null_count == 1);
+  CHECK(s_read == s_data);
+
+  array.close();
+  if (vfs.is_dir(uri))
+    vfs.remove_dir(uri);
+}
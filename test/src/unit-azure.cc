@@ -33,6 +33,7 @@
 #ifdef HAVE_AZURE
 
 #include "catch.hpp"
+#include "test/src/helpers.h"
 #include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/filesystem/azure.h"
@@ -103,7 +104,7 @@ void AzureFx::init_azure(Config&& config, ConfMap settings) {
   std::for_each(settings.begin(), settings.end(), set_conf);
   REQUIRE(config.set("vfs.azure.use_https", "false").ok());
   REQUIRE(thread_pool_.init(2).ok());
-  REQUIRE(azure_.init(config, &thread_pool_).ok());
+  REQUIRE(azure_.init(&g_helper_stats, config, &thread_pool_).ok());
 
   // Create container
   bool is_container;
@@ -0,0 +1,91 @@
+/**
+ * @file unit-RTree.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `BloomFilter` class.
+ */
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/fragment/bloom_filter.h"
+
+#include <catch.hpp>
+
+using namespace tiledb::sm;
+
+TEST_CASE("BloomFilter: Test empty filter", "[bloom_filter]") {
+  BloomFilter filter;
+  CHECK(filter.empty());
+  CHECK(filter.may_contain(BloomFilter::hash("a", 1)));
+}
+
+TEST_CASE("BloomFilter: Test add and lookup", "[bloom_filter]") {
+  const uint64_t item_num = 10000;
+  BloomFilter filter;
+  filter.init(item_num, 10);
+  CHECK(!filter.empty());
+
+  for (uint64_t i = 0; i < item_num; ++i)
+    filter.add(BloomFilter::hash(&i, sizeof(i)));
+
+  // No false negatives
+  for (uint64_t i = 0; i < item_num; ++i)
+    CHECK(filter.may_contain(BloomFilter::hash(&i, sizeof(i))));
+
+  // About 1% false positives with ten bits per item
+  uint64_t false_positives = 0;
+  for (uint64_t i = item_num; i < 2 * item_num; ++i)
+    false_positives += filter.may_contain(BloomFilter::hash(&i, sizeof(i)));
+  CHECK(false_positives < item_num / 50);
+
+  // Serialization round trip
+  Buffer buff;
+  CHECK(filter.serialize(&buff).ok());
+  ConstBuffer cbuff(&buff);
+  BloomFilter filter_2;
+  CHECK(filter_2.deserialize(&cbuff).ok());
+  CHECK(filter_2.size() == filter.size());
+  for (uint64_t i = 0; i < 2 * item_num; ++i) {
+    auto hash = BloomFilter::hash(&i, sizeof(i));
+    CHECK(filter_2.may_contain(hash) == filter.may_contain(hash));
+  }
+}
+
+TEST_CASE("BloomFilter: Test chained hashes", "[bloom_filter]") {
+  int32_t a = 1, b = 2;
+
+  // The dimension order matters
+  auto h_ab = BloomFilter::hash(&b, sizeof(b), BloomFilter::hash(&a, 4));
+  auto h_ba = BloomFilter::hash(&a, sizeof(a), BloomFilter::hash(&b, 4));
+  CHECK(h_ab != h_ba);
+
+  // So do the boundaries between var-sized coordinates
+  auto h_1 = BloomFilter::hash("b", 1, BloomFilter::hash("a", 1));
+  auto h_2 = BloomFilter::hash("", 0, BloomFilter::hash("ab", 2));
+  CHECK(h_1 != h_2);
+}
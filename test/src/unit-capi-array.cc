@@ -2168,4 +2168,93 @@ TEST_CASE_METHOD(
 
   remove_temp_dir(local_fs.file_prefix() + local_fs.temp_dir());
 #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    ArrayFx,
+    "C API: Test opening array with a subarray hint",
+    "[capi][array][open-subarray]") {
+  SupportedFsLocal local_fs;
+  std::string array_name =
+      local_fs.file_prefix() + local_fs.temp_dir() + "array_open_subarray";
+  create_temp_dir(local_fs.file_prefix() + local_fs.temp_dir());
+
+  create_sparse_vector(array_name);
+
+  // Write one fragment at each end of the domain
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, array_name.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  for (int64_t coord : {int64_t(-1), int64_t(2)}) {
+    int32_t a = static_cast<int32_t>(coord);
+    uint64_t a_size = sizeof(a);
+    uint64_t coord_size = sizeof(coord);
+    tiledb_query_t* query;
+    rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_data_buffer(ctx_, query, "a", &a, &a_size);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_set_data_buffer(
+        ctx_, query, "d1", &coord, &coord_size);
+    CHECK(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+    tiledb_query_free(&query);
+  }
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Only the fragment intersecting the hint is loaded
+  int64_t subarray[] = {-1, 0};
+  rc = tiledb_array_set_open_subarray(ctx_, array, subarray, sizeof(subarray));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  int64_t domain[2];
+  int is_empty;
+  rc = tiledb_array_get_non_empty_domain(ctx_, array, domain, &is_empty);
+  CHECK(rc == TILEDB_OK);
+  CHECK(is_empty == 0);
+  CHECK(domain[0] == -1);
+  CHECK(domain[1] == -1);
+
+  // The hint applies to reopens
+  subarray[0] = 1;
+  subarray[1] = 2;
+  rc = tiledb_array_set_open_subarray(ctx_, array, subarray, sizeof(subarray));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_reopen(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_get_non_empty_domain(ctx_, array, domain, &is_empty);
+  CHECK(rc == TILEDB_OK);
+  CHECK(is_empty == 0);
+  CHECK(domain[0] == 2);
+  CHECK(domain[1] == 2);
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // A hint with a wrong number of ranges is an error
+  rc = tiledb_array_set_open_subarray(ctx_, array, subarray, sizeof(int64_t));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  CHECK(rc == TILEDB_ERR);
+
+  // Clearing the hint loads all the fragments
+  rc = tiledb_array_set_open_subarray(ctx_, array, nullptr, 0);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_get_non_empty_domain(ctx_, array, domain, &is_empty);
+  CHECK(rc == TILEDB_OK);
+  CHECK(domain[0] == -1);
+  CHECK(domain[1] == 2);
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  tiledb_array_free(&array);
+  remove_temp_dir(local_fs.file_prefix() + local_fs.temp_dir());
+}
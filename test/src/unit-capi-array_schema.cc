@@ -904,8 +904,9 @@ void ArraySchemaFx::load_and_check_array_schema(const std::string& path) {
       "- Allows duplicates: " +
       "false\n"
       "- Coordinates filters: 1\n" +
-      "  > ZSTD: COMPRESSION_LEVEL=-1\n" + "- Offsets filters: 1\n" +
-      "  > ZSTD: COMPRESSION_LEVEL=-1\n" + "- Validity filters: 1\n" +
+      "  > ZSTD: COMPRESSION_LEVEL=-1\n" + "- Offsets filters: 2\n" +
+      "  > PositiveDelta: POSITIVE_DELTA_MAX_WINDOW=1024\n" +
+      "  > FrameOfReference\n" + "- Validity filters: 1\n" +
       "  > RLE: COMPRESSION_LEVEL=-1\n\n" + "### Dimension ###\n" +
       "- Name: " + DIM1_NAME + "\n" + "- Type: INT64\n" +
       "- Cell val num: 1\n" + "- Domain: " + DIM1_DOMAIN_STR + "\n" +
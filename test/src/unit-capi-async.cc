@@ -903,3 +903,75 @@ TEST_CASE_METHOD(
   read_sparse_async();
   remove_sparse_array();
 }
+
+TEST_CASE_METHOD(
+    AsyncFx, "C API: Test async admission", "[capi][async][admission]") {
+  // Admit a single async query at a time.
+  tiledb_ctx_free(&ctx_);
+  tiledb_config_t* config;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(
+      tiledb_config_set(config, "sm.async_query.max_concurrent", "1", &error) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_ctx_alloc(config, &ctx_) == TILEDB_OK);
+
+  remove_dense_array();
+  create_dense_array();
+  write_dense_async();
+
+  tiledb_array_t* array;
+  REQUIRE(tiledb_array_alloc(ctx_, DENSE_ARRAY_NAME, &array) == TILEDB_OK);
+  REQUIRE(tiledb_array_open(ctx_, array, TILEDB_READ) == TILEDB_OK);
+
+  // Submit reads under two tags, they all complete.
+  const int query_num = 8;
+  uint64_t subarray[] = {1, 4, 1, 4};
+  std::vector<tiledb_query_t*> queries(query_num);
+  std::vector<std::vector<int>> buffers(query_num, std::vector<int>(16));
+  std::vector<uint64_t> buffer_sizes(query_num, 16 * sizeof(int));
+  std::vector<int> callbacks_made(query_num, 0);
+  for (int i = 0; i < query_num; ++i) {
+    REQUIRE(
+        tiledb_config_set(
+            config,
+            "sm.async_query.tag",
+            i % 2 == 0 ? "a" : "b",
+            &error) == TILEDB_OK);
+    REQUIRE(
+        tiledb_query_alloc(ctx_, array, TILEDB_READ, &queries[i]) ==
+        TILEDB_OK);
+    REQUIRE(tiledb_query_set_config(ctx_, queries[i], config) == TILEDB_OK);
+    REQUIRE(
+        tiledb_query_set_layout(ctx_, queries[i], TILEDB_GLOBAL_ORDER) ==
+        TILEDB_OK);
+    REQUIRE(tiledb_query_set_subarray(ctx_, queries[i], subarray) == TILEDB_OK);
+    REQUIRE(
+        tiledb_query_set_data_buffer(
+            ctx_, queries[i], "a1", buffers[i].data(), &buffer_sizes[i]) ==
+        TILEDB_OK);
+  }
+  for (int i = 0; i < query_num; ++i) {
+    REQUIRE(
+        tiledb_query_submit_async(
+            ctx_, queries[i], callback, &callbacks_made[i]) == TILEDB_OK);
+  }
+
+  std::vector<int> c_buffer_a1(16);
+  for (int i = 0; i < 16; ++i)
+    c_buffer_a1[i] = i;
+  for (int i = 0; i < query_num; ++i) {
+    tiledb_query_status_t status;
+    do {
+      tiledb_query_get_status(ctx_, queries[i], &status);
+    } while (status != TILEDB_COMPLETED && status != TILEDB_FAILED);
+    CHECK(status == TILEDB_COMPLETED);
+    CHECK(buffers[i] == c_buffer_a1);
+    tiledb_query_free(&queries[i]);
+  }
+
+  REQUIRE(tiledb_array_close(ctx_, array) == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_config_free(&config);
+  remove_dense_array();
+}
@@ -32,6 +32,7 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/config/config.h"
 
 #include <tiledb/sm/misc/constants.h>
 #include <cstring>
@@ -225,33 +226,69 @@ void check_save_to_file() {
 #else
   ss << "config.logging_level 0\n";
 #endif
+  ss << "rest.http2 true\n";
   ss << "rest.http_compressor any\n";
+  ss << "rest.pipeline_array_open false\n";
+  ss << "rest.prefetch_incomplete false\n";
+  ss << "rest.request_compression_min_size 1048576\n";
+  ss << "rest.request_compressor none\n";
   ss << "rest.retry_count 25\n";
   ss << "rest.retry_delay_factor 1.25\n";
   ss << "rest.retry_http_codes 503\n";
   ss << "rest.retry_initial_delay_ms 500\n";
   ss << "rest.server_address https://api.tiledb.com\n";
   ss << "rest.server_serialization_format CAPNP\n";
+  ss << "rest.share_connections true\n";
+  ss << "rest.submit_array_state true\n";
+  ss << "sm.array_schema_cache_size 10000000\n";
+  ss << "sm.array_snapshot_cache_size 0\n";
+  ss << "sm.async_query.max_concurrent 0\n";
+  ss << "sm.async_query.tag \n";
   ss << "sm.check_coord_dups true\n";
   ss << "sm.check_coord_oob true\n";
   ss << "sm.check_global_order true\n";
+  ss << "sm.compute_affinity \n";
   ss << "sm.compute_concurrency_level " << std::thread::hardware_concurrency()
      << "\n";
   ss << "sm.consolidation.amplification 1.0\n";
+  ss << "sm.consolidation.array_meta.max_deltas 0\n";
+  ss << "sm.consolidation.auto.fragment_num 0\n";
+  ss << "sm.consolidation.auto.min_interval_ms 1000\n";
   ss << "sm.consolidation.buffer_size 50000000\n";
+  ss << "sm.consolidation.concurrent_budget 0\n";
+  ss << "sm.consolidation.fragment_meta.max_deltas 0\n";
+  ss << "sm.consolidation.max_in_flight_bytes 0\n";
   ss << "sm.consolidation.mode fragments\n";
+  ss << "sm.consolidation.policy size_ratio\n";
+  ss << "sm.consolidation.priority background\n";
   ss << "sm.consolidation.step_max_frags 4294967295\n";
   ss << "sm.consolidation.step_min_frags 4294967295\n";
   ss << "sm.consolidation.step_size_ratio 0.0\n";
   ss << "sm.consolidation.steps 4294967295\n";
+  ss << "sm.consolidation.tier_base_size 1048576\n";
+  ss << "sm.consolidation.tier_fanout 4\n";
+  ss << "sm.consolidation.tile_copy false\n";
   ss << "sm.consolidation.timestamp_end " << std::to_string(UINT64_MAX) << "\n";
   ss << "sm.consolidation.timestamp_start 0\n";
+  ss << "sm.consolidation.total_buffer_size 0\n";
+  ss << "sm.coords_bloom_filter_bits_per_cell 0\n";
   ss << "sm.dedup_coords false\n";
+  ss << "sm.dedup_coords_method sort\n";
   ss << "sm.enable_signal_handlers true\n";
   ss << "sm.encryption_type NO_ENCRYPTION\n";
+  ss << "sm.fragment_listing_shards 1\n";
+  ss << "sm.fragment_metadata_cache_size 0\n";
+  ss << "sm.io_affinity \n";
   ss << "sm.io_concurrency_level " << std::thread::hardware_concurrency()
      << "\n";
+  ss << "sm.listing_cache_ttl_ms 0\n";
   ss << "sm.max_tile_overlap_size 314572800\n";
+  ss << "sm.mem.governor.enabled false\n";
+  ss << "sm.mem.governor.min_ratio 0.25\n";
+  ss << "sm.mem.governor.timeout_ms 10000\n";
+  ss << "sm.mem.large_buffer.huge_pages none\n";
+  ss << "sm.mem.large_buffer.numa_local false\n";
+  ss << "sm.mem.large_buffer.threshold 4194304\n";
   ss << "sm.mem.malloc_trim true\n";
   ss << "sm.mem.reader.sparse_global_order.ratio_array_data 0.1\n";
   ss << "sm.mem.reader.sparse_global_order.ratio_coords 0.5\n";
@@ -262,36 +299,66 @@ void check_save_to_file() {
   ss << "sm.mem.reader.sparse_unordered_with_dups.ratio_query_condition "
         "0.25\n";
   ss << "sm.mem.reader.sparse_unordered_with_dups.ratio_tile_ranges 0.1\n";
+  ss << "sm.mem.tile_buffer_pool_size 0\n";
   ss << "sm.mem.total_budget 10737418240\n";
+  ss << "sm.mem.writer.global_order.budget 0\n";
+  ss << "sm.mem.writer.global_order.max_in_flight_bytes 0\n";
+  ss << "sm.mem.writer.unordered.spill_budget 0\n";
   ss << "sm.memory_budget 5368709120\n";
   ss << "sm.memory_budget_var 10737418240\n";
+  ss << "sm.packed_fragment_max_size 0\n";
+  ss << "sm.partitioner.cpu_cost_per_byte 0.0\n";
+  ss << "sm.partitioner.io_cost_per_byte 1.0\n";
+  ss << "sm.partitioner.target_cost 0\n";
+  ss << "sm.query.dense.elide_fill_tiles true\n";
   ss << "sm.query.dense.reader refactored\n";
+  ss << "sm.query.dense.streaming_write false\n";
+  ss << "sm.query.priority normal\n";
+  ss << "sm.query.shared_scan true\n";
   ss << "sm.query.sparse_global_order.reader legacy\n";
+  ss << "sm.query.sparse_unordered_no_dups.reader legacy\n";
   ss << "sm.query.sparse_unordered_with_dups.reader refactored\n";
+  ss << "sm.query.timeout_ms 0\n";
   ss << "sm.read_range_oob warn\n";
+  ss << "sm.shared_resources false\n";
   ss << "sm.skip_checksum_validation false\n";
   ss << "sm.skip_est_size_partitioning false\n";
+  ss << "sm.thread_pool_stats false\n";
+  ss << "sm.tile_cache_policy lru\n";
+  ss << "sm.tile_cache_shard_num 1\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.tile_cache_unfiltered_size 0\n";
+  ss << "sm.tile_overlap_cache_size 10000000\n";
   ss << "sm.vacuum.mode fragments\n";
   ss << "sm.vacuum.timestamp_end " << std::to_string(UINT64_MAX) << "\n";
   ss << "sm.vacuum.timestamp_start 0\n";
   ss << "sm.var_offsets.bitsize 64\n";
   ss << "sm.var_offsets.extra_element false\n";
   ss << "sm.var_offsets.mode bytes\n";
+  ss << "vfs.adaptive_batch_gap false\n";
   ss << "vfs.azure.block_list_block_size 5242880\n";
   ss << "vfs.azure.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
+  ss << "vfs.azure.read_part_size 0\n";
   ss << "vfs.azure.use_block_list_upload true\n";
   ss << "vfs.azure.use_https true\n";
+  ss << "vfs.disk_cache.max_size 10737418240\n";
+  ss << "vfs.file.direct_io false\n";
+  ss << "vfs.file.group_commit false\n";
+  ss << "vfs.file.io_uring false\n";
   ss << "vfs.file.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
+  ss << "vfs.file.mmap false\n";
+  ss << "vfs.file.overlapped_io false\n";
   ss << "vfs.file.posix_directory_permissions 755\n";
   ss << "vfs.file.posix_file_permissions 644\n";
   ss << "vfs.gcs.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
   ss << "vfs.gcs.multi_part_size 5242880\n";
+  ss << "vfs.gcs.read_part_size 0\n";
   ss << "vfs.gcs.request_timeout_ms 3000\n";
   ss << "vfs.gcs.use_multi_part_upload true\n";
+  ss << "vfs.hdfs.short_circuit_reads false\n";
   ss << "vfs.min_batch_gap 512000\n";
   ss << "vfs.min_batch_size 20971520\n";
   ss << "vfs.min_parallel_size 10485760\n";
@@ -301,6 +368,8 @@ void check_save_to_file() {
   ss << "vfs.s3.connect_max_tries 5\n";
   ss << "vfs.s3.connect_scale_factor 25\n";
   ss << "vfs.s3.connect_timeout_ms 10800\n";
+  ss << "vfs.s3.hedge_max_ratio 0.05\n";
+  ss << "vfs.s3.hedge_percentile 0\n";
   ss << "vfs.s3.logging_level Off\n";
   ss << "vfs.s3.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
@@ -308,6 +377,7 @@ void check_save_to_file() {
   ss << "vfs.s3.object_canned_acl NOT_SET\n";
   ss << "vfs.s3.proxy_port 0\n";
   ss << "vfs.s3.proxy_scheme http\n";
+  ss << "vfs.s3.read_part_size 0\n";
   ss << "vfs.s3.region us-east-1\n";
   ss << "vfs.s3.request_timeout_ms 3000\n";
   ss << "vfs.s3.requester_pays false\n";
@@ -552,22 +622,61 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["rest.http_compressor"] = "any";
   all_param_values["rest.retry_count"] = "25";
   all_param_values["rest.retry_delay_factor"] = "1.25";
+  all_param_values["rest.share_connections"] = "true";
+  all_param_values["rest.http2"] = "true";
+  all_param_values["rest.request_compressor"] = "none";
+  all_param_values["rest.request_compression_min_size"] = "1048576";
+  all_param_values["rest.prefetch_incomplete"] = "false";
+  all_param_values["rest.submit_array_state"] = "true";
+  all_param_values["rest.pipeline_array_open"] = "false";
   all_param_values["rest.retry_initial_delay_ms"] = "500";
   all_param_values["rest.retry_http_codes"] = "503";
   all_param_values["sm.encryption_key"] = "";
   all_param_values["sm.encryption_type"] = "NO_ENCRYPTION";
   all_param_values["sm.dedup_coords"] = "false";
+  all_param_values["sm.dedup_coords_method"] = "sort";
+  all_param_values["sm.coords_bloom_filter_bits_per_cell"] = "0";
+  all_param_values["sm.attribute_index_names"] = "";
+  all_param_values["sm.packed_fragment_max_size"] = "0";
   all_param_values["sm.check_coord_dups"] = "true";
   all_param_values["sm.check_coord_oob"] = "true";
   all_param_values["sm.check_global_order"] = "true";
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.tile_cache_shard_num"] = "1";
+  all_param_values["sm.tile_cache_unfiltered_size"] = "0";
+  all_param_values["sm.tile_cache_policy"] = "lru";
+  all_param_values["sm.tile_cache_shared_memory_name"] = "";
+  all_param_values["sm.listing_cache_ttl_ms"] = "0";
+  all_param_values["sm.fragment_listing_shards"] = "1";
+  all_param_values["sm.fragment_metadata_cache_size"] = "0";
+  all_param_values["sm.array_schema_cache_size"] = "10000000";
+  all_param_values["sm.array_snapshot_cache_size"] = "0";
+  all_param_values["sm.tile_overlap_cache_size"] = "10000000";
+  all_param_values["sm.partitioner.target_cost"] = "0";
+  all_param_values["sm.partitioner.io_cost_per_byte"] = "1.0";
+  all_param_values["sm.partitioner.cpu_cost_per_byte"] = "0.0";
   all_param_values["sm.skip_est_size_partitioning"] = "false";
   all_param_values["sm.memory_budget"] = "5368709120";
   all_param_values["sm.memory_budget_var"] = "10737418240";
   all_param_values["sm.query.dense.reader"] = "refactored";
   all_param_values["sm.query.sparse_global_order.reader"] = "legacy";
   all_param_values["sm.query.sparse_unordered_with_dups.reader"] = "refactored";
+  all_param_values["sm.query.priority"] = "normal";
+  all_param_values["sm.query.shared_scan"] = "true";
+  all_param_values["sm.query.timeout_ms"] = "0";
+  all_param_values["sm.async_query.max_concurrent"] = "0";
+  all_param_values["sm.async_query.tag"] = "";
+  all_param_values["sm.query.sparse_unordered_no_dups.reader"] = "legacy";
+  all_param_values["sm.query.dense.streaming_write"] = "false";
+  all_param_values["sm.query.dense.elide_fill_tiles"] = "true";
   all_param_values["sm.mem.malloc_trim"] = "true";
+  all_param_values["sm.mem.tile_buffer_pool_size"] = "0";
+  all_param_values["sm.mem.large_buffer.huge_pages"] = "none";
+  all_param_values["sm.mem.large_buffer.numa_local"] = "false";
+  all_param_values["sm.mem.large_buffer.threshold"] = "4194304";
+  all_param_values["sm.mem.governor.enabled"] = "false";
+  all_param_values["sm.mem.governor.min_ratio"] = "0.25";
+  all_param_values["sm.mem.governor.timeout_ms"] = "10000";
   all_param_values["sm.mem.total_budget"] = "10737418240";
   all_param_values["sm.mem.reader.sparse_global_order.ratio_coords"] = "0.5";
   all_param_values["sm.mem.reader.sparse_global_order.ratio_query_condition"] =
@@ -585,20 +694,40 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
       ["sm.mem.reader.sparse_unordered_with_dups.ratio_tile_ranges"] = "0.1";
   all_param_values
       ["sm.mem.reader.sparse_unordered_with_dups.ratio_array_data"] = "0.1";
+  all_param_values["sm.mem.writer.global_order.max_in_flight_bytes"] = "0";
+  all_param_values["sm.mem.writer.global_order.budget"] = "0";
+  all_param_values["sm.mem.writer.unordered.spill_budget"] = "0";
+  all_param_values["sm.mem.writer.unordered.spill_path"] = "";
   all_param_values["sm.enable_signal_handlers"] = "true";
   all_param_values["sm.compute_concurrency_level"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["sm.io_concurrency_level"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["sm.compute_affinity"] = "";
+  all_param_values["sm.io_affinity"] = "";
+  all_param_values["sm.shared_resources"] = "false";
+  all_param_values["sm.thread_pool_stats"] = "false";
   all_param_values["sm.skip_checksum_validation"] = "false";
   all_param_values["sm.consolidation.amplification"] = "1.0";
   all_param_values["sm.consolidation.steps"] = "4294967295";
   all_param_values["sm.consolidation.timestamp_start"] = "0";
   all_param_values["sm.consolidation.timestamp_end"] =
       std::to_string(UINT64_MAX);
+  all_param_values["sm.consolidation.priority"] = "background";
   all_param_values["sm.consolidation.step_min_frags"] = "4294967295";
   all_param_values["sm.consolidation.step_max_frags"] = "4294967295";
   all_param_values["sm.consolidation.buffer_size"] = "50000000";
+  all_param_values["sm.consolidation.total_buffer_size"] = "0";
+  all_param_values["sm.consolidation.max_in_flight_bytes"] = "0";
+  all_param_values["sm.consolidation.tile_copy"] = "false";
+  all_param_values["sm.consolidation.concurrent_budget"] = "0";
+  all_param_values["sm.consolidation.policy"] = "size_ratio";
+  all_param_values["sm.consolidation.tier_fanout"] = "4";
+  all_param_values["sm.consolidation.tier_base_size"] = "1048576";
+  all_param_values["sm.consolidation.auto.fragment_num"] = "0";
+  all_param_values["sm.consolidation.auto.min_interval_ms"] = "1000";
+  all_param_values["sm.consolidation.fragment_meta.max_deltas"] = "0";
+  all_param_values["sm.consolidation.array_meta.max_deltas"] = "0";
   all_param_values["sm.consolidation.step_size_ratio"] = "0.0";
   all_param_values["sm.consolidation.mode"] = "fragments";
   all_param_values["sm.read_range_oob"] = "warn";
@@ -611,6 +740,9 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["sm.max_tile_overlap_size"] = "314572800";
 
   all_param_values["vfs.min_batch_gap"] = "512000";
+  all_param_values["vfs.adaptive_batch_gap"] = "false";
+  all_param_values["vfs.disk_cache.path"] = "";
+  all_param_values["vfs.disk_cache.max_size"] = "10737418240";
   all_param_values["vfs.min_batch_size"] = "20971520";
   all_param_values["vfs.min_parallel_size"] = "10485760";
   all_param_values["vfs.read_ahead_size"] = "102400";
@@ -618,6 +750,7 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["vfs.gcs.project_id"] = "";
   all_param_values["vfs.gcs.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["vfs.gcs.read_part_size"] = "0";
   all_param_values["vfs.gcs.multi_part_size"] = "5242880";
   all_param_values["vfs.gcs.use_multi_part_upload"] = "true";
   all_param_values["vfs.gcs.request_timeout_ms"] = "3000";
@@ -628,12 +761,18 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["vfs.azure.block_list_block_size"] = "5242880";
   all_param_values["vfs.azure.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["vfs.azure.read_part_size"] = "0";
   all_param_values["vfs.azure.use_block_list_upload"] = "true";
   all_param_values["vfs.azure.use_https"] = "true";
   all_param_values["vfs.file.posix_file_permissions"] = "644";
   all_param_values["vfs.file.posix_directory_permissions"] = "755";
   all_param_values["vfs.file.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["vfs.file.io_uring"] = "false";
+  all_param_values["vfs.file.overlapped_io"] = "false";
+  all_param_values["vfs.file.direct_io"] = "false";
+  all_param_values["vfs.file.mmap"] = "false";
+  all_param_values["vfs.file.group_commit"] = "false";
   all_param_values["vfs.s3.scheme"] = "https";
   all_param_values["vfs.s3.region"] = "us-east-1";
   all_param_values["vfs.s3.aws_access_key_id"] = "";
@@ -650,6 +789,7 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["vfs.s3.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.s3.multipart_part_size"] = "5242880";
+  all_param_values["vfs.s3.read_part_size"] = "0";
   all_param_values["vfs.s3.ca_file"] = "";
   all_param_values["vfs.s3.ca_path"] = "";
   all_param_values["vfs.s3.connect_timeout_ms"] = "10800";
@@ -659,6 +799,8 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["vfs.s3.sse_kms_key_id"] = "";
   all_param_values["vfs.s3.logging_level"] = "Off";
   all_param_values["vfs.s3.request_timeout_ms"] = "3000";
+  all_param_values["vfs.s3.hedge_percentile"] = "0";
+  all_param_values["vfs.s3.hedge_max_ratio"] = "0.05";
   all_param_values["vfs.s3.requester_pays"] = "false";
   all_param_values["vfs.s3.proxy_host"] = "";
   all_param_values["vfs.s3.proxy_password"] = "";
@@ -668,6 +810,8 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   all_param_values["vfs.s3.verify_ssl"] = "true";
   all_param_values["vfs.hdfs.username"] = "stavros";
   all_param_values["vfs.hdfs.kerb_ticket_cache_path"] = "";
+  all_param_values["vfs.hdfs.short_circuit_reads"] = "false";
+  all_param_values["vfs.hdfs.domain_socket_path"] = "";
   all_param_values["vfs.hdfs.name_node_uri"] = "";
   all_param_values["vfs.s3.bucket_canned_acl"] = "NOT_SET";
   all_param_values["vfs.s3.object_canned_acl"] = "NOT_SET";
@@ -722,6 +866,8 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   vfs_param_values["s3.sse_kms_key_id"] = "";
   vfs_param_values["s3.logging_level"] = "Off";
   vfs_param_values["s3.request_timeout_ms"] = "3000";
+  vfs_param_values["s3.hedge_percentile"] = "0";
+  vfs_param_values["s3.hedge_max_ratio"] = "0.05";
   vfs_param_values["s3.requester_pays"] = "false";
   vfs_param_values["s3.proxy_host"] = "";
   vfs_param_values["s3.proxy_password"] = "";
@@ -780,6 +926,8 @@ TEST_CASE("C API: Test config iter", "[capi][config]") {
   s3_param_values["sse_kms_key_id"] = "";
   s3_param_values["logging_level"] = "Off";
   s3_param_values["request_timeout_ms"] = "3000";
+  s3_param_values["hedge_percentile"] = "0";
+  s3_param_values["hedge_max_ratio"] = "0.05";
   s3_param_values["requester_pays"] = "false";
   s3_param_values["proxy_host"] = "";
   s3_param_values["proxy_password"] = "";
@@ -1109,3 +1257,36 @@ TEST_CASE("C API: Test VFS config inheritance", "[capi][config][vfs-inherit]") {
   tiledb_vfs_free(&vfs);
   tiledb_ctx_free(&ctx);
 }
+
+TEST_CASE("Config: Test snapshot", "[config][snapshot]") {
+  tiledb::sm::Config config;
+  std::shared_ptr<const tiledb::sm::ConfigSnapshot> snapshot;
+  REQUIRE(config.snapshot(&snapshot).ok());
+  CHECK(snapshot->memory_budget == 5368709120);
+  CHECK(snapshot->var_offsets_mode == "bytes");
+  CHECK(snapshot->var_offsets_bitsize == 64);
+
+  // The values are parsed once and shared with the copies.
+  std::shared_ptr<const tiledb::sm::ConfigSnapshot> snapshot2;
+  REQUIRE(config.snapshot(&snapshot2).ok());
+  CHECK(snapshot2 == snapshot);
+  tiledb::sm::Config copy = config;
+  REQUIRE(copy.snapshot(&snapshot2).ok());
+  CHECK(snapshot2 == snapshot);
+
+  // Setting and unsetting a parameter parses the values again.
+  REQUIRE(config.set("sm.var_offsets.bitsize", "32").ok());
+  REQUIRE(config.set("sm.mem.reader.sparse_global_order.ratio_coords", "0.3")
+              .ok());
+  REQUIRE(config.snapshot(&snapshot2).ok());
+  CHECK(snapshot2 != snapshot);
+  CHECK(snapshot2->var_offsets_bitsize == 32);
+  CHECK(snapshot2->sparse_global_order.coords == 0.3);
+  CHECK(snapshot->var_offsets_bitsize == 64);
+  REQUIRE(copy.snapshot(&snapshot2).ok());
+  CHECK(snapshot2 == snapshot);
+
+  REQUIRE(config.unset("sm.var_offsets.bitsize").ok());
+  REQUIRE(config.snapshot(&snapshot2).ok());
+  CHECK(snapshot2->var_offsets_bitsize == 64);
+}
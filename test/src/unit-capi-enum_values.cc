@@ -93,6 +93,8 @@ TEST_CASE("C API: Test enum values", "[capi][enums]") {
   REQUIRE(TILEDB_COL_MAJOR == 1);
   REQUIRE(TILEDB_GLOBAL_ORDER == 2);
   REQUIRE(TILEDB_UNORDERED == 3);
+  REQUIRE(TILEDB_HILBERT == 4);
+  REQUIRE(TILEDB_MORTON == 5);
 
   /** Filter type */
   REQUIRE(TILEDB_FILTER_NONE == 0);
@@ -112,6 +114,7 @@ TEST_CASE("C API: Test enum values", "[capi][enums]") {
   REQUIRE(TILEDB_COMPRESSION_LEVEL == 0);
   REQUIRE(TILEDB_BIT_WIDTH_MAX_WINDOW == 1);
   REQUIRE(TILEDB_POSITIVE_DELTA_MAX_WINDOW == 2);
+  REQUIRE(TILEDB_AUTO_COMPRESSION_SPEED_BIAS == 3);
 
   /** Encryption type */
   REQUIRE(TILEDB_NO_ENCRYPTION == 0);
@@ -123,6 +126,7 @@ TEST_CASE("C API: Test enum values", "[capi][enums]") {
   REQUIRE(TILEDB_INPROGRESS == 2);
   REQUIRE(TILEDB_INCOMPLETE == 3);
   REQUIRE(TILEDB_UNINITIALIZED == 4);
+  REQUIRE(TILEDB_CANCELLED == 5);
 
   /** Walk order */
   REQUIRE(TILEDB_PREORDER == 0);
@@ -339,6 +343,12 @@ TEST_CASE("C API: Test enum string conversion", "[capi][enums]") {
   REQUIRE(
       (tiledb_layout_from_str("unordered", &layout) == TILEDB_OK &&
        layout == TILEDB_UNORDERED));
+  REQUIRE(
+      (tiledb_layout_to_str(TILEDB_MORTON, &c_str) == TILEDB_OK &&
+       std::string(c_str) == "morton"));
+  REQUIRE(
+      (tiledb_layout_from_str("morton", &layout) == TILEDB_OK &&
+       layout == TILEDB_MORTON));
 
   tiledb_filter_type_t filter_type;
   REQUIRE(
@@ -440,6 +450,14 @@ TEST_CASE("C API: Test enum string conversion", "[capi][enums]") {
       (tiledb_filter_option_from_str(
            "POSITIVE_DELTA_MAX_WINDOW", &filter_option) == TILEDB_OK &&
        filter_option == TILEDB_POSITIVE_DELTA_MAX_WINDOW));
+  REQUIRE(
+      (tiledb_filter_option_to_str(
+           TILEDB_AUTO_COMPRESSION_SPEED_BIAS, &c_str) == TILEDB_OK &&
+       std::string(c_str) == "AUTO_COMPRESSION_SPEED_BIAS"));
+  REQUIRE(
+      (tiledb_filter_option_from_str(
+           "AUTO_COMPRESSION_SPEED_BIAS", &filter_option) == TILEDB_OK &&
+       filter_option == TILEDB_AUTO_COMPRESSION_SPEED_BIAS));
 
   tiledb_encryption_type_t encryption_type;
   REQUIRE(
@@ -490,6 +508,12 @@ TEST_CASE("C API: Test enum string conversion", "[capi][enums]") {
       (tiledb_query_status_from_str("UNINITIALIZED", &query_status) ==
            TILEDB_OK &&
        query_status == TILEDB_UNINITIALIZED));
+  REQUIRE(
+      (tiledb_query_status_to_str(TILEDB_CANCELLED, &c_str) == TILEDB_OK &&
+       std::string(c_str) == "CANCELLED"));
+  REQUIRE(
+      (tiledb_query_status_from_str("CANCELLED", &query_status) == TILEDB_OK &&
+       query_status == TILEDB_CANCELLED));
 
   tiledb_walk_order_t walk_order;
   REQUIRE(
@@ -35,10 +35,13 @@
 #include "tiledb/sm/c_api/tiledb.h"
 #include "tiledb/sm/c_api/tiledb_serialization.h"
 #include "tiledb/sm/c_api/tiledb_struct_def.h"
+#include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/enums/serialization_type.h"
 #include "tiledb/sm/query/reader.h"
 #include "tiledb/sm/query/writer_base.h"
 #include "tiledb/sm/serialization/query.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
 
 #ifdef _WIN32
 #include "tiledb/sm/filesystem/win.h"
@@ -48,6 +51,7 @@
 
 #include <any>
 #include <cassert>
+#include <cstring>
 #include <map>
 
 using namespace tiledb;
@@ -605,6 +609,106 @@ TEST_CASE_METHOD(
       std::free(b);
   }
 
+  SECTION("- Read all, attribute data apart from the message") {
+    Array array(ctx, array_uri, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<uint32_t> a1(1000);
+    std::vector<uint32_t> a2(1000);
+    std::vector<uint8_t> a2_nullable(500);
+    std::vector<char> a3_data(1000 * 100);
+    std::vector<uint64_t> a3_offsets(1000);
+    std::vector<int32_t> subarray = {1, 10, 1, 10};
+
+    query.set_subarray(subarray);
+    query.set_data_buffer("a1", a1);
+    query.set_data_buffer("a2", a2);
+    query.set_validity_buffer("a2", a2_nullable);
+    query.set_data_buffer("a3", a3_data);
+    query.set_offsets_buffer("a3", a3_offsets);
+
+    std::vector<uint8_t> serialized;
+    serialize_query(ctx, query, &serialized, true);
+    Array array2(ctx, array_uri, TILEDB_READ);
+    Query query2(ctx, array2);
+    deserialize_query(ctx, serialized, &query2, false);
+    auto to_free = allocate_query_buffers(ctx, array2, &query2);
+    query2.submit();
+    serialize_query(ctx, query2, &serialized, false);
+
+    // Received at an unaligned address, only the message is copied to an
+    // aligned buffer, and the attribute data is read from where it is.
+    std::vector<uint8_t> unaligned(serialized.size() + 1);
+    std::memcpy(&unaligned[1], serialized.data(), serialized.size());
+    uint64_t message_size = 0;
+    REQUIRE(sm::serialization::query_message_size(
+                &unaligned[1],
+                serialized.size(),
+                sm::SerializationType::CAPNP,
+                &message_size)
+                .ok());
+    REQUIRE(message_size < serialized.size());
+    sm::Buffer message;
+    REQUIRE(message.write(&unaligned[1], message_size).ok());
+    message.reset_offset();
+    REQUIRE(sm::serialization::query_deserialize(
+                message,
+                sm::SerializationType::CAPNP,
+                true,
+                nullptr,
+                query.ptr()->query_,
+                ctx.ptr()->ctx_->storage_manager()->compute_tp(),
+                &unaligned[1 + message_size])
+                .ok());
+    REQUIRE(query.query_status() == Query::Status::COMPLETE);
+
+    auto result_el = query.result_buffer_elements_nullable();
+    REQUIRE(std::get<1>(result_el["a1"]) == 100);
+    REQUIRE(std::get<1>(result_el["a3"]) == 5050);
+    REQUIRE(check_result(a1, expected_results["a1"]));
+    REQUIRE(check_result(a2_nullable, expected_results["a2_nullable"]));
+    REQUIRE(check_result(a3_data, expected_results["a3_data"]));
+    REQUIRE(check_result(a3_offsets, expected_results["a3_offsets"]));
+
+    for (void* b : to_free)
+      std::free(b);
+  }
+
+  SECTION("- Read all, without the array state") {
+    Array array(ctx, array_uri, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<uint32_t> a1(1000);
+    std::vector<int32_t> subarray = {1, 10, 1, 10};
+    query.set_subarray(subarray);
+    query.set_data_buffer("a1", a1);
+
+    std::vector<uint8_t> with_state;
+    serialize_query(ctx, query, &with_state, true);
+
+    // The server uses the schema of the array it opened
+    Config config;
+    config["rest.submit_array_state"] = "false";
+    query.set_config(config);
+    std::vector<uint8_t> serialized;
+    serialize_query(ctx, query, &serialized, true);
+    REQUIRE(serialized.size() < with_state.size());
+
+    Array array2(ctx, array_uri, TILEDB_READ);
+    Query query2(ctx, array2);
+    deserialize_query(ctx, serialized, &query2, false);
+    auto to_free = allocate_query_buffers(ctx, array2, &query2);
+    query2.submit();
+    serialize_query(ctx, query2, &serialized, false);
+
+    deserialize_query(ctx, serialized, &query, true);
+    REQUIRE(query.query_status() == Query::Status::COMPLETE);
+    auto result_el = query.result_buffer_elements();
+    REQUIRE(result_el["a1"].second == 100);
+    REQUIRE(check_result(a1, expected_results["a1"]));
+
+    for (void* b : to_free)
+      std::free(b);
+  }
+
   SECTION("- Read all, with condition") {
     Array array(ctx, array_uri, TILEDB_READ);
     Query query(ctx, array);
@@ -916,6 +916,46 @@ TEST_CASE_METHOD(VFSFx, "C API: Test virtual filesystem", "[capi][vfs]") {
   }
 }
 
+TEST_CASE_METHOD(
+    VFSFx, "C API: Test VFS backend request counters", "[capi][vfs]") {
+  tiledb_stats_enable();
+  tiledb_stats_reset();
+
+  const std::string dir = MEMFS_TEMP_DIR + "counters/";
+  const std::string file = dir + "file";
+  REQUIRE(tiledb_vfs_create_dir(ctx_, vfs_, dir.c_str()) == TILEDB_OK);
+
+  const std::string to_write = "0123456789";
+  tiledb_vfs_fh_t* fh;
+  REQUIRE(
+      tiledb_vfs_open(ctx_, vfs_, file.c_str(), TILEDB_VFS_WRITE, &fh) ==
+      TILEDB_OK);
+  REQUIRE(
+      tiledb_vfs_write(ctx_, fh, to_write.c_str(), to_write.size()) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_vfs_close(ctx_, fh) == TILEDB_OK);
+  tiledb_vfs_fh_free(&fh);
+
+  char buffer[4];
+  REQUIRE(
+      tiledb_vfs_open(ctx_, vfs_, file.c_str(), TILEDB_VFS_READ, &fh) ==
+      TILEDB_OK);
+  REQUIRE(tiledb_vfs_read(ctx_, fh, 2, buffer, 4) == TILEDB_OK);
+  REQUIRE(tiledb_vfs_close(ctx_, fh) == TILEDB_OK);
+  tiledb_vfs_fh_free(&fh);
+  REQUIRE(tiledb_vfs_remove_dir(ctx_, vfs_, dir.c_str()) == TILEDB_OK);
+
+  char* stats = nullptr;
+  REQUIRE(tiledb_stats_dump_str(&stats) == TILEDB_OK);
+  const std::string dump(stats);
+  tiledb_stats_free_str(&stats);
+  CHECK(dump.find("VFS.mem.put_num\": 1") != std::string::npos);
+  CHECK(dump.find("VFS.mem.put_byte_num\": 10") != std::string::npos);
+  CHECK(dump.find("VFS.mem.get_num\": 1") != std::string::npos);
+  CHECK(dump.find("VFS.mem.get_byte_num\": 4") != std::string::npos);
+  CHECK(dump.find("VFS.mem.delete_num\": 1") != std::string::npos);
+}
+
 TEST_CASE_METHOD(
     VFSFx,
     "C API: Test virtual filesystem when S3 is not supported",
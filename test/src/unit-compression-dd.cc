@@ -38,6 +38,8 @@
 
 #include <ctime>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 TEST_CASE(
     "Compression-DoubleDelta: Test 1-element case",
@@ -259,3 +261,74 @@ TEST_CASE(
   delete decomp_in_buff;
   delete decomp_out_buff;
 }
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test block format",
+    "[compression][double-delta]") {
+  // Timestamps with a slightly jittered stride, which compress well
+  uint64_t n = 1000;
+  std::vector<int64_t> data(n);
+  for (uint64_t i = 0; i < n; ++i)
+    data[i] = 1600000000000LL + 1000 * (int64_t)i + (int64_t)(i % 7);
+
+  SECTION("- extreme values") {
+    data[10] = std::numeric_limits<int64_t>::max();
+    data[11] = std::numeric_limits<int64_t>::min();
+    data[500] = -1;
+  }
+
+  SECTION("- fewer values than a block") {
+    n = 100;
+    data.resize(n);
+  }
+
+  // Compress with the block format
+  tiledb::sm::ConstBuffer comp_in_buff(data.data(), n * sizeof(int64_t));
+  tiledb::sm::Buffer comp_out_buff;
+  auto st = tiledb::sm::DoubleDelta::compress(
+      tiledb::sm::Datatype::INT64, &comp_in_buff, &comp_out_buff, true);
+  REQUIRE(st.ok());
+  CHECK(((uint8_t*)comp_out_buff.data())[0] == 0xFF);
+  CHECK(comp_out_buff.size() < n * sizeof(int64_t));
+
+  // Decompress
+  tiledb::sm::ConstBuffer decomp_in_buff(
+      comp_out_buff.data(), comp_out_buff.size());
+  std::vector<int64_t> decomp_data(n);
+  tiledb::sm::PreallocatedBuffer prealloc_buf(
+      decomp_data.data(), n * sizeof(int64_t));
+  st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::INT64, &decomp_in_buff, &prealloc_buf);
+  REQUIRE(st.ok());
+  CHECK(decomp_data == data);
+}
+
+TEST_CASE(
+    "Compression-DoubleDelta: Test block format fallback",
+    "[compression][double-delta]") {
+  // Random bytes do not compress, so the uncompressed bit-serial case is
+  // written instead of blocks
+  std::srand(std::time(nullptr));
+  uint64_t n = 1000;
+  std::vector<uint8_t> data(n);
+  for (uint64_t i = 0; i < n; ++i)
+    data[i] = (uint8_t)(std::rand() % 256);
+
+  tiledb::sm::ConstBuffer comp_in_buff(data.data(), n);
+  tiledb::sm::Buffer comp_out_buff;
+  auto st = tiledb::sm::DoubleDelta::compress(
+      tiledb::sm::Datatype::UINT8, &comp_in_buff, &comp_out_buff, true);
+  REQUIRE(st.ok());
+  CHECK(((uint8_t*)comp_out_buff.data())[0] == 8);
+  CHECK(
+      comp_out_buff.size() <= n + tiledb::sm::DoubleDelta::overhead(n));
+
+  tiledb::sm::ConstBuffer decomp_in_buff(
+      comp_out_buff.data(), comp_out_buff.size());
+  std::vector<uint8_t> decomp_data(n);
+  tiledb::sm::PreallocatedBuffer prealloc_buf(decomp_data.data(), n);
+  st = tiledb::sm::DoubleDelta::decompress(
+      tiledb::sm::Datatype::UINT8, &decomp_in_buff, &prealloc_buf);
+  REQUIRE(st.ok());
+  CHECK(decomp_data == data);
+}
@@ -0,0 +1,464 @@
+/**
+ * @file   unit-cppapi-aggregates.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for query aggregates.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <limits>
+#include <map>
+
+using namespace tiledb;
+
+namespace {
+
+/** A cell of the test arrays. */
+struct AggregateCell {
+  int32_t coord;
+  int32_t a;
+  double b;
+  bool b_valid;
+};
+
+/** Expected results computed from the cells. */
+struct AggregateExpected {
+  uint64_t count = 0;
+  int64_t sum_a = 0;
+  int32_t min_a = std::numeric_limits<int32_t>::max();
+  int32_t max_a = std::numeric_limits<int32_t>::lowest();
+  double sum_b = 0;
+  uint64_t null_count_b = 0;
+};
+
+AggregateExpected compute_expected(
+    const std::vector<AggregateCell>& cells,
+    int32_t start,
+    int32_t end,
+    int32_t a_less_than) {
+  AggregateExpected expected;
+  for (const auto& cell : cells) {
+    if (cell.coord < start || cell.coord > end || cell.a >= a_less_than)
+      continue;
+
+    expected.count++;
+    expected.sum_a += cell.a;
+    expected.min_a = std::min(expected.min_a, cell.a);
+    expected.max_a = std::max(expected.max_a, cell.a);
+    if (cell.b_valid) {
+      expected.sum_b += cell.b;
+    } else {
+      expected.null_count_b++;
+    }
+  }
+
+  return expected;
+}
+
+void write_cells(
+    const Context& ctx,
+    const std::string& array_name,
+    tiledb_array_type_t array_type,
+    const std::vector<AggregateCell>& cells) {
+  std::vector<int32_t> d;
+  std::vector<int32_t> a;
+  std::vector<double> b;
+  std::vector<uint8_t> b_validity;
+  for (const auto& cell : cells) {
+    d.emplace_back(cell.coord);
+    a.emplace_back(cell.a);
+    b.emplace_back(cell.b);
+    b_validity.emplace_back(cell.b_valid);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  if (array_type == TILEDB_DENSE) {
+    Subarray subarray(ctx, array);
+    subarray.add_range<int32_t>(0, d.front(), d.back());
+    query.set_layout(TILEDB_ROW_MAJOR).set_subarray(subarray);
+  } else {
+    query.set_layout(TILEDB_UNORDERED).set_data_buffer("d", d);
+  }
+  query.set_data_buffer("a", a)
+      .set_data_buffer("b", b)
+      .set_validity_buffer("b", b_validity);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+void check_aggregates(
+    const Context& ctx,
+    const std::string& array_name,
+    const std::vector<AggregateCell>& cells,
+    int32_t start,
+    int32_t end,
+    bool set_condition) {
+  const int32_t a_less_than =
+      set_condition ? 50 : std::numeric_limits<int32_t>::max();
+  auto expected = compute_expected(cells, start, end, a_less_than);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  Subarray subarray(ctx, array);
+  subarray.add_range<int32_t>(0, start, end);
+  query.set_subarray(subarray);
+  if (set_condition) {
+    QueryCondition qc(ctx);
+    qc.init("a", &a_less_than, sizeof(int32_t), TILEDB_LT);
+    query.set_condition(qc);
+  }
+
+  query.add_aggregate("a", TILEDB_AGGREGATE_COUNT)
+      .add_aggregate("a", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("a", TILEDB_AGGREGATE_MIN)
+      .add_aggregate("a", TILEDB_AGGREGATE_MAX)
+      .add_aggregate("b", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("b", TILEDB_AGGREGATE_NULL_COUNT);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+  uint64_t count = 0;
+  REQUIRE(query.get_aggregate("a", TILEDB_AGGREGATE_COUNT, &count));
+  CHECK(count == expected.count);
+
+  int64_t sum_a = 0;
+  REQUIRE(query.get_aggregate("a", TILEDB_AGGREGATE_SUM, &sum_a));
+  CHECK(sum_a == expected.sum_a);
+
+  int32_t min_a = 0;
+  REQUIRE(query.get_aggregate("a", TILEDB_AGGREGATE_MIN, &min_a));
+  CHECK(min_a == expected.min_a);
+
+  int32_t max_a = 0;
+  REQUIRE(query.get_aggregate("a", TILEDB_AGGREGATE_MAX, &max_a));
+  CHECK(max_a == expected.max_a);
+
+  double sum_b = 0;
+  REQUIRE(query.get_aggregate("b", TILEDB_AGGREGATE_SUM, &sum_b));
+  CHECK(sum_b == Approx(expected.sum_b));
+
+  uint64_t null_count_b = 0;
+  REQUIRE(query.get_aggregate("b", TILEDB_AGGREGATE_NULL_COUNT, &null_count_b));
+  CHECK(null_count_b == expected.null_count_b);
+
+  array.close();
+}
+
+void create_array(
+    const Context& ctx,
+    const std::string& array_name,
+    tiledb_array_type_t array_type) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, array_type);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  auto b = Attribute::create<double>(ctx, "b");
+  b.set_nullable(true);
+  schema.add_attribute(b);
+  if (array_type == TILEDB_SPARSE) {
+    schema.set_capacity(10);
+    schema.set_allows_dups(true);
+  }
+  Array::create(array_name, schema);
+}
+
+/** Returns the cells 'start' to 'end', with 'a' set to 'a_offset + coord'. */
+std::vector<AggregateCell> make_cells(
+    int32_t start, int32_t end, int32_t a_offset) {
+  std::vector<AggregateCell> cells;
+  for (int32_t i = start; i <= end; i++) {
+    cells.push_back({i, a_offset + i, i * 0.5, i % 7 != 0});
+  }
+
+  return cells;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test aggregates, dense", "[cppapi][aggregates][dense]") {
+  const std::string array_name = "cpp_unit_array_aggregates_dense";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx, array_name, TILEDB_DENSE);
+  auto cells = make_cells(1, 100, 0);
+  write_cells(ctx, array_name, TILEDB_DENSE, cells);
+
+  // Overwrite a range that spans two space tiles.
+  auto overwrite = make_cells(5, 14, 1000);
+  write_cells(ctx, array_name, TILEDB_DENSE, overwrite);
+  for (const auto& cell : overwrite)
+    cells[cell.coord - 1] = cell;
+
+  SECTION("- Full domain") {
+    tiledb::Stats::enable();
+    tiledb::Stats::reset();
+    check_aggregates(ctx, array_name, cells, 1, 100, false);
+
+    // Only the two space tiles with the overwrite are read, the others are
+    // answered from the tile metadata.
+    std::string stats;
+    tiledb::Stats::raw_dump(&stats);
+    tiledb::Stats::disable();
+    CHECK(
+        stats.find("\"Context.StorageManager.Query.Reader.aggregate_tiles_"
+                   "from_metadata\": 8") != std::string::npos);
+  }
+
+  SECTION("- Partial tiles") {
+    check_aggregates(ctx, array_name, cells, 3, 95, false);
+  }
+
+  SECTION("- Query condition") {
+    check_aggregates(ctx, array_name, cells, 1, 100, true);
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test aggregates, sparse", "[cppapi][aggregates][sparse]") {
+  const std::string array_name = "cpp_unit_array_aggregates_sparse";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx, array_name, TILEDB_SPARSE);
+  auto cells = make_cells(1, 100, 0);
+  write_cells(ctx, array_name, TILEDB_SPARSE, cells);
+
+  // Duplicates are aggregated.
+  auto duplicates = make_cells(45, 64, -100);
+  write_cells(ctx, array_name, TILEDB_SPARSE, duplicates);
+  cells.insert(cells.end(), duplicates.begin(), duplicates.end());
+
+  SECTION("- Full domain") {
+    check_aggregates(ctx, array_name, cells, 1, 100, false);
+  }
+
+  SECTION("- Partial tiles") {
+    tiledb::Stats::enable();
+    tiledb::Stats::reset();
+    check_aggregates(ctx, array_name, cells, 3, 95, false);
+
+    // The tiles covered by the range are counted without reading their
+    // coordinates, 8 from the first fragment and 2 from the second.
+    std::string stats;
+    tiledb::Stats::raw_dump(&stats);
+    tiledb::Stats::disable();
+    CHECK(
+        stats.find("\"Context.StorageManager.Query.Reader.covered_tile_num\": "
+                   "10") != std::string::npos);
+  }
+
+  SECTION("- Query condition") {
+    check_aggregates(ctx, array_name, cells, 1, 100, true);
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+void check_group_by(
+    const Context& ctx,
+    const std::string& array_name,
+    const std::vector<AggregateCell>& cells,
+    int32_t start,
+    int32_t end,
+    int32_t bucket_width) {
+  // Compute the expected results of each bucket.
+  std::map<int64_t, std::vector<AggregateCell>> bucket_cells;
+  for (const auto& cell : cells)
+    bucket_cells[cell.coord / bucket_width].push_back(cell);
+
+  std::map<int64_t, AggregateExpected> expected;
+  for (const auto& [bucket, c] : bucket_cells) {
+    auto e =
+        compute_expected(c, start, end, std::numeric_limits<int32_t>::max());
+    if (e.count != 0)
+      expected[bucket] = e;
+  }
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  Subarray subarray(ctx, array);
+  subarray.add_range<int32_t>(0, start, end);
+  query.set_subarray(subarray);
+  query.add_aggregate("a", TILEDB_AGGREGATE_COUNT)
+      .add_aggregate("a", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("a", TILEDB_AGGREGATE_MAX)
+      .set_aggregate_group_by("d", bucket_width);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+  REQUIRE(query.aggregate_bucket_num() == expected.size());
+  uint64_t b = 0;
+  for (const auto& [bucket, e] : expected) {
+    int64_t result_bucket = -1;
+    uint64_t count = 0;
+    REQUIRE(query.get_aggregate_bucket(
+        b, "a", TILEDB_AGGREGATE_COUNT, &result_bucket, &count));
+    CHECK(result_bucket == bucket);
+    CHECK(count == e.count);
+
+    int64_t sum_a = 0;
+    REQUIRE(query.get_aggregate_bucket(
+        b, "a", TILEDB_AGGREGATE_SUM, &result_bucket, &sum_a));
+    CHECK(sum_a == e.sum_a);
+
+    int32_t max_a = 0;
+    REQUIRE(query.get_aggregate_bucket(
+        b, "a", TILEDB_AGGREGATE_MAX, &result_bucket, &max_a));
+    CHECK(max_a == e.max_a);
+    b++;
+  }
+
+  uint64_t count = 0;
+  CHECK_THROWS(query.get_aggregate("a", TILEDB_AGGREGATE_COUNT, &count));
+
+  array.close();
+}
+
+TEST_CASE(
+    "C++ API: Test aggregates, group by", "[cppapi][aggregates][group-by]") {
+  const std::string array_name = "cpp_unit_array_aggregates_group_by";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx, array_name, TILEDB_SPARSE);
+  auto cells = make_cells(1, 100, 0);
+  write_cells(ctx, array_name, TILEDB_SPARSE, cells);
+  auto duplicates = make_cells(45, 64, -100);
+  write_cells(ctx, array_name, TILEDB_SPARSE, duplicates);
+  cells.insert(cells.end(), duplicates.begin(), duplicates.end());
+
+  SECTION("- Full domain") {
+    // Half of the tiles of the first fragment lie within a single bucket,
+    // they are answered from the tile metadata.
+    tiledb::Stats::enable();
+    tiledb::Stats::reset();
+    check_group_by(ctx, array_name, cells, 1, 100, 20);
+
+    std::string stats;
+    tiledb::Stats::raw_dump(&stats);
+    tiledb::Stats::disable();
+    CHECK(
+        stats.find("\"Context.StorageManager.Query.Reader.aggregate_tiles_"
+                   "from_metadata\": 0") == std::string::npos);
+  }
+
+  SECTION("- Unaligned buckets") {
+    check_group_by(ctx, array_name, cells, 1, 100, 25);
+  }
+
+  SECTION("- Partial tiles") {
+    check_group_by(ctx, array_name, cells, 3, 95, 7);
+  }
+
+  SECTION("- Errors") {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array, TILEDB_READ);
+    CHECK_THROWS(query.set_aggregate_group_by("a", 10));
+    CHECK_THROWS(query.set_aggregate_group_by("d", 0));
+
+    // A group by without aggregates.
+    query.set_aggregate_group_by("d", 10);
+    std::vector<int32_t> a(200);
+    query.set_data_buffer("a", a);
+    CHECK_THROWS(query.submit());
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test aggregates, errors", "[cppapi][aggregates][errors]") {
+  const std::string array_name = "cpp_unit_array_aggregates_errors";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx, array_name, TILEDB_SPARSE);
+  write_cells(ctx, array_name, TILEDB_SPARSE, make_cells(1, 10, 0));
+
+  Array array(ctx, array_name, TILEDB_READ);
+
+  SECTION("- Unknown field") {
+    Query query(ctx, array, TILEDB_READ);
+    CHECK_THROWS(query.add_aggregate("c", TILEDB_AGGREGATE_COUNT));
+  }
+
+  SECTION("- Sum on a dimension") {
+    Query query(ctx, array, TILEDB_READ);
+    CHECK_THROWS(query.add_aggregate("d", TILEDB_AGGREGATE_SUM));
+  }
+
+  SECTION("- Aggregates and buffers") {
+    Query query(ctx, array, TILEDB_READ);
+    std::vector<int32_t> a(10);
+    query.set_data_buffer("a", a);
+    query.add_aggregate("a", TILEDB_AGGREGATE_COUNT);
+    CHECK_THROWS(query.submit());
+  }
+
+  SECTION("- Result before submit") {
+    Query query(ctx, array, TILEDB_READ);
+    query.add_aggregate("a", TILEDB_AGGREGATE_COUNT);
+    uint64_t count;
+    CHECK_THROWS(query.get_aggregate("a", TILEDB_AGGREGATE_COUNT, &count));
+  }
+
+  SECTION("- Result buffer too small") {
+    Query query(ctx, array, TILEDB_READ);
+    query.add_aggregate("a", TILEDB_AGGREGATE_SUM);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    int32_t sum;
+    CHECK_THROWS(query.get_aggregate("a", TILEDB_AGGREGATE_SUM, &sum));
+  }
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -33,10 +33,13 @@
 #include "catch.hpp"
 #include "helpers.h"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/cpp_api/tiledb_experimental"
 #include "tiledb/sm/filesystem/uri.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <thread>
+
 using namespace tiledb;
 
 struct Point {
@@ -1569,4 +1572,413 @@ TEST_CASE(
 
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
-}
\ No newline at end of file
+}
+TEST_CASE(
+    "C++ API: Unordered writes sorted in global order",
+    "[cppapi][sparse][unordered-sort]") {
+  const std::string array_name = "cpp_unit_array_unordered_sort";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  tiledb_layout_t tile_order = TILEDB_ROW_MAJOR;
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  SECTION("- Row-major tiles, row-major cells") {
+    tile_order = TILEDB_ROW_MAJOR;
+    cell_order = TILEDB_ROW_MAJOR;
+  }
+  SECTION("- Row-major tiles, col-major cells") {
+    tile_order = TILEDB_ROW_MAJOR;
+    cell_order = TILEDB_COL_MAJOR;
+  }
+  SECTION("- Col-major tiles, row-major cells") {
+    tile_order = TILEDB_COL_MAJOR;
+    cell_order = TILEDB_ROW_MAJOR;
+  }
+  SECTION("- Col-major tiles, col-major cells") {
+    tile_order = TILEDB_COL_MAJOR;
+    cell_order = TILEDB_COL_MAJOR;
+  }
+
+  // Create an array with a negative domain and a small integer type.
+  const int8_t d1_tile = 4;
+  const int64_t d2_tile = 3;
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int8_t>(ctx, "d1", {{-20, 20}}, d1_tile))
+      .add_dimension(Dimension::create<int64_t>(ctx, "d2", {{-50, 50}}, d2_tile));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{tile_order, cell_order}});
+  schema.set_capacity(7);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write all the cells of a region of the domain in a shuffled order.
+  std::vector<std::tuple<int8_t, int64_t>> cells;
+  for (int8_t d1 = -9; d1 <= 9; d1++) {
+    for (int64_t d2 = -11; d2 <= 13; d2++) {
+      cells.emplace_back(d1, d2);
+    }
+  }
+  std::vector<int8_t> d1_w;
+  std::vector<int64_t> d2_w;
+  std::vector<int> a_w;
+  for (uint64_t i = 0; i < cells.size(); i++) {
+    const auto& cell = cells[(i * 37) % cells.size()];
+    d1_w.push_back(std::get<0>(cell));
+    d2_w.push_back(std::get<1>(cell));
+    a_w.push_back(std::get<0>(cell) * 100 + std::get<1>(cell));
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d1", d1_w)
+      .set_data_buffer("d2", d2_w)
+      .set_data_buffer("a", a_w);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Compute the expected global order.
+  auto global_order_key = [&](const std::tuple<int8_t, int64_t>& cell) {
+    const int64_t t1 = (std::get<0>(cell) + 20) / d1_tile;
+    const int64_t t2 = (std::get<1>(cell) + 50) / d2_tile;
+    const int64_t c1 = std::get<0>(cell);
+    const int64_t c2 = std::get<1>(cell);
+    return std::make_tuple(
+        tile_order == TILEDB_ROW_MAJOR ? t1 : t2,
+        tile_order == TILEDB_ROW_MAJOR ? t2 : t1,
+        cell_order == TILEDB_ROW_MAJOR ? c1 : c2,
+        cell_order == TILEDB_ROW_MAJOR ? c2 : c1);
+  };
+  std::sort(cells.begin(), cells.end(), [&](const auto& a, const auto& b) {
+    return global_order_key(a) < global_order_key(b);
+  });
+
+  // Read in global order.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int8_t> d1_r(cells.size());
+  std::vector<int64_t> d2_r(cells.size());
+  std::vector<int> a_r(cells.size());
+  query_r.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d1", d1_r)
+      .set_data_buffer("d2", d2_r)
+      .set_data_buffer("a", a_r);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(query_r.result_buffer_elements()["a"].second == cells.size());
+  for (uint64_t i = 0; i < cells.size(); i++) {
+    CHECK(d1_r[i] == std::get<0>(cells[i]));
+    CHECK(d2_r[i] == std::get<1>(cells[i]));
+    CHECK(a_r[i] == d1_r[i] * 100 + d2_r[i]);
+  }
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Unordered writes deduplicated with a hash table",
+    "[cppapi][sparse][unordered-dedup-hash]") {
+  const std::string array_name = "cpp_unit_array_dedup_hash";
+  Config cfg;
+  cfg["sm.dedup_coords"] = "true";
+  cfg["sm.dedup_coords_method"] = "hash";
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with an integer and a string dimension.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d1", {{1, 100}}, 10))
+      .add_dimension(
+          Dimension::create(ctx, "d2", TILEDB_STRING_ASCII, nullptr, nullptr));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(16);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write 85 distinct coordinates repeated in cycles, the first occurrence
+  // of each is the one kept.
+  std::vector<int> d1;
+  std::string d2;
+  std::vector<uint64_t> d2_off;
+  std::vector<int> a;
+  for (int i = 0; i < 200; i++) {
+    d1.push_back(i % 17 + 1);
+    d2_off.push_back(d2.size());
+    d2 += "s" + std::to_string(i % 5);
+    a.push_back(i);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d1", d1)
+      .set_data_buffer("d2", d2)
+      .set_offsets_buffer("d2", d2_off)
+      .set_data_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Read back.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> d1_r(200);
+  std::string d2_r(1000, '\0');
+  std::vector<uint64_t> d2_off_r(200);
+  std::vector<int> a_r(200);
+  query_r.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d1", d1_r)
+      .set_data_buffer("d2", d2_r)
+      .set_offsets_buffer("d2", d2_off_r)
+      .set_data_buffer("a", a_r);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  auto result_num = query_r.result_buffer_elements()["a"].second;
+  REQUIRE(result_num == 85);
+  a_r.resize(result_num);
+  for (uint64_t i = 0; i < result_num; i++)
+    CHECK(d1_r[i] == a_r[i] % 17 + 1);
+  std::sort(a_r.begin(), a_r.end());
+  for (int i = 0; i < 85; i++)
+    CHECK(a_r[i] == i);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Unordered writes spilled to disk and merged on finalize",
+    "[cppapi][sparse][unordered-spill]") {
+  const std::string array_name = "cpp_unit_array_unordered_spill";
+  Config cfg;
+  // A small budget merges the runs in many rounds.
+  cfg["sm.mem.writer.unordered.spill_budget"] = "512";
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 50));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(16);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  // Submit 3 batches of 100 shuffled cells that interleave in global order.
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED);
+  for (int batch = 0; batch < 3; batch++) {
+    std::vector<int> d, a;
+    std::string s;
+    std::vector<uint64_t> s_off;
+    for (int i = 0; i < 100; i++) {
+      const int coord = ((i * 37) % 100) * 3 + batch + 1;
+      d.push_back(coord);
+      a.push_back(coord * 10);
+      s_off.push_back(s.size());
+      s += std::to_string(coord);
+    }
+    query_w.set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .set_data_buffer("s", s)
+        .set_offsets_buffer("s", s_off);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  }
+  query_w.finalize();
+  array_w.close();
+
+  // All the cells are in a single fragment.
+  FragmentInfo fragment_info(ctx, array_name);
+  fragment_info.load();
+  CHECK(fragment_info.fragment_num() == 1);
+
+  // Read back in global order.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> d_r(300), a_r(300);
+  std::string s_r(1000, '\0');
+  std::vector<uint64_t> s_off_r(300);
+  query_r.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d", d_r)
+      .set_data_buffer("a", a_r)
+      .set_data_buffer("s", s_r)
+      .set_offsets_buffer("s", s_off_r);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  auto result_num = query_r.result_buffer_elements()["a"].second;
+  REQUIRE(result_num == 300);
+  auto s_size = query_r.result_buffer_elements()["s"].second;
+  for (uint64_t i = 0; i < result_num; i++) {
+    CHECK(d_r[i] == (int)i + 1);
+    CHECK(a_r[i] == ((int)i + 1) * 10);
+    const auto end = i + 1 < result_num ? s_off_r[i + 1] : s_size;
+    CHECK(
+        s_r.substr(s_off_r[i], end - s_off_r[i]) == std::to_string(i + 1));
+  }
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Open array at a timestamp with the snapshot cache",
+    "[cppapi][open-array-at][snapshot]") {
+  Config config;
+  config["sm.array_snapshot_cache_size"] = "4";
+  Context ctx(config);
+  VFS vfs(ctx);
+  const std::string array_name = "cppapi_open_array_at_snapshot";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 4}}, 4));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  auto write = [&](uint64_t timestamp, int d, int a) {
+    std::vector<int> d_w = {d};
+    std::vector<int> a_w = {a};
+    Array array(ctx, array_name, TILEDB_WRITE);
+    array.close();
+    array.set_open_timestamp_end(timestamp);
+    array.open(TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_data_buffer("d", d_w)
+        .set_data_buffer("a", a_w);
+    query.submit();
+    array.put_metadata("key", TILEDB_INT32, 1, &a);
+    array.close();
+  };
+  auto read = [&](uint64_t timestamp, int* key) {
+    Array array(ctx, array_name, TILEDB_READ);
+    array.close();
+    array.set_open_timestamp_end(timestamp);
+    array.open(TILEDB_READ);
+    std::vector<int> a_r(4);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_GLOBAL_ORDER).set_data_buffer("a", a_r);
+    query.submit();
+    a_r.resize(query.result_buffer_elements()["a"].second);
+    tiledb_datatype_t type;
+    uint32_t num = 0;
+    const void* value = nullptr;
+    array.get_metadata("key", &type, &num, &value);
+    *key = num == 1 ? *static_cast<const int*>(value) : 0;
+    array.close();
+    return a_r;
+  };
+
+  write(10, 1, 1);
+  write(30, 2, 2);
+
+  // The second open is served by the snapshot of the first
+  int key = 0;
+  for (int i = 0; i < 2; ++i) {
+    CHECK(read(20, &key) == std::vector<int>{1});
+    CHECK(key == 1);
+  }
+
+  // A write at an earlier timestamp drops the snapshot
+  write(15, 3, 3);
+  CHECK(read(20, &key) == std::vector<int>{1, 3});
+  CHECK(key == 3);
+  CHECK(read(30, &key) == std::vector<int>{1, 2, 3});
+  CHECK(key == 2);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Open arrays from an array snapshot",
+    "[cppapi][array][snapshot]") {
+  Context ctx;
+  VFS vfs(ctx);
+  const std::string array_name = "cppapi_array_snapshot";
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  auto write = [&](int d, int a) {
+    std::vector<int> d_w = {d};
+    std::vector<int> a_w = {a};
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_data_buffer("d", d_w)
+        .set_data_buffer("a", a_w);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  };
+
+  write(3, 1);
+  write(7, 2);
+
+  // The snapshot outlives the array and ignores later writes.
+  Array array(ctx, array_name, TILEDB_READ);
+  ArraySnapshot snapshot(ctx, array);
+  array.close();
+  write(50, 3);
+
+  const int nthreads = 4;
+  std::vector<std::thread> threads;
+  std::vector<int> errors(nthreads, 0);
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int j = 0; j < 10; j++) {
+        Array thread_array = snapshot.open();
+        if (thread_array.non_empty_domain<int>(0) != std::make_pair(3, 7))
+          errors[t]++;
+
+        std::vector<int> a_r(4);
+        Query query(ctx, thread_array);
+        query.set_layout(TILEDB_GLOBAL_ORDER).set_data_buffer("a", a_r);
+        if (query.submit() != Query::Status::COMPLETE)
+          errors[t]++;
+        a_r.resize(query.result_buffer_elements()["a"].second);
+        if (a_r != std::vector<int>{1, 2})
+          errors[t]++;
+        thread_array.close();
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  CHECK(errors == std::vector<int>(nthreads, 0));
+
+  // A new open sees the latest write.
+  Array array_latest(ctx, array_name, TILEDB_READ);
+  CHECK(array_latest.non_empty_domain<int>(0) == std::make_pair(3, 50));
+  array_latest.close();
+
+  // Arrays with another URI cannot be opened from the snapshot.
+  tiledb_array_t* other;
+  REQUIRE(
+      tiledb_array_alloc(ctx.ptr().get(), "cppapi_other_array", &other) ==
+      TILEDB_OK);
+  CHECK(
+      tiledb_array_open_snapshot(
+          ctx.ptr().get(), other, snapshot.ptr().get()) == TILEDB_ERR);
+  tiledb_array_free(&other);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
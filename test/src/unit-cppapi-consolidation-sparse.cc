@@ -34,6 +34,9 @@
 #include "helpers.h"
 #include "tiledb/sm/cpp_api/tiledb"
 
+#include <chrono>
+#include <thread>
+
 using namespace tiledb;
 
 namespace sparse_consolidate {
@@ -149,4 +152,358 @@ TEST_CASE(
 
   remove_array(array_name);
 }
+TEST_CASE(
+    "C++ API: Test sparse consolidation with pipelined copy",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  create_array(array_name);
+  write_array(array_name, {1, 2}, {1, 2});
+  write_array(array_name, {3, 4}, {3, 4});
+  write_array(array_name, {2}, {5});
+  CHECK(tiledb::test::num_fragments(array_name) == 3);
+
+  // One cell per read, so that every write overlaps the next read.
+  Context ctx;
+  Config config;
+  config["sm.consolidation.buffer_size"] = "4";
+  config["sm.consolidation.max_in_flight_bytes"] = "8";
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  read_array(array_name, {1, 2, 3, 4}, {1, 5, 3, 4});
+
+  remove_array(array_name);
+}
+TEST_CASE(
+    "C++ API: Test sparse consolidation with concurrent steps",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  create_array(array_name);
+  write_array(array_name, {1}, {1});
+  write_array(array_name, {2}, {2});
+  write_array(array_name, {3}, {3});
+  write_array(array_name, {4, 1}, {4, 5});
+  CHECK(tiledb::test::num_fragments(array_name) == 4);
+
+  // Two steps of two fragments each run concurrently, then a last one
+  Context ctx;
+  Config config;
+  config["sm.consolidation.step_min_frags"] = "2";
+  config["sm.consolidation.step_max_frags"] = "2";
+  config["sm.consolidation.concurrent_budget"] = "1000000000";
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  read_array(array_name, {1, 2, 3, 4}, {5, 2, 3, 4});
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse consolidation of packed fragments",
+    "[cppapi][consolidation][sparse][packed]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  create_array(array_name);
+
+  // Each small write is packed in a single object
+  Config config;
+  config["sm.packed_fragment_max_size"] = "1024";
+  Context ctx(config);
+  for (int i = 1; i <= 3; ++i) {
+    std::vector<int> d = {i};
+    std::vector<int> values = {10 * i};
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED);
+    query.set_data_buffer("d", d);
+    query.set_data_buffer("a", values);
+    query.submit();
+    array.close();
+  }
+  write_array(array_name, {4}, {40});
+
+  VFS vfs(ctx);
+  const std::string suffix = ".pack";
+  int packed_num = 0;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (uri.size() > suffix.size() &&
+        uri.compare(uri.size() - suffix.size(), suffix.size(), suffix) == 0) {
+      CHECK(vfs.is_file(uri));
+      ++packed_num;
+    }
+  }
+  CHECK(packed_num == 3);
+  CHECK(tiledb::test::num_fragments(array_name) == 4);
+
+  read_array(array_name, {1, 2, 3, 4}, {10, 20, 30, 40});
+
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  read_array(array_name, {1, 2, 3, 4}, {10, 20, 30, 40});
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse consolidation policies",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  create_array(array_name);
+  write_array(array_name, {1}, {1});
+  write_array(array_name, {2}, {2});
+  write_array(array_name, {3}, {3});
+  CHECK(tiledb::test::num_fragments(array_name) == 3);
+
+  Context ctx;
+  Config config;
+  SECTION("- size-tiered") {
+    // All fragments are in the first tier, which needs 4 to be consolidated
+    config["sm.consolidation.policy"] = "size_tiered";
+    config["sm.consolidation.tier_fanout"] = "4";
+    REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+    CHECK(tiledb::test::num_fragments(array_name) == 3);
+    write_array(array_name, {4, 1}, {4, 5});
+    REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  }
+
+  SECTION("- leveled") {
+    // The newer fragments outweigh half of the oldest one
+    config["sm.consolidation.policy"] = "leveled";
+    config["sm.consolidation.tier_fanout"] = "2";
+    write_array(array_name, {4, 1}, {4, 5});
+    REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  }
+
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  read_array(array_name, {1, 2, 3, 4}, {5, 2, 3, 4});
+
+  REQUIRE_THROWS(config["sm.consolidation.policy"] = "lsm");
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse background consolidation",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+  create_array(array_name);
+
+  Config config;
+  config["sm.consolidation.auto.fragment_num"] = "3";
+  config["sm.consolidation.auto.min_interval_ms"] = "0";
+  Context ctx(config);
+  for (int i = 1; i <= 3; ++i) {
+    std::vector<int> d = {i};
+    std::vector<int> values = {i};
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED);
+    query.set_data_buffer("d", d);
+    query.set_data_buffer("a", values);
+    query.submit();
+    array.close();
+  }
+
+  // Closing the third fragment schedules the consolidation and vacuum
+  for (int i = 0; i < 1000 && tiledb::test::num_fragments(array_name) != 1;
+       ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  read_array(array_name, {1, 2, 3}, {1, 2, 3});
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test incremental fragment metadata consolidation",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+  create_array(array_name);
+
+  Context ctx;
+  VFS vfs(ctx);
+  auto meta_file_num = [&]() {
+    int num = 0;
+    for (const auto& uri : vfs.ls(array_name)) {
+      if (uri.size() >= 5 && uri.substr(uri.size() - 5) == ".meta")
+        ++num;
+    }
+    return num;
+  };
+  auto unconsolidated_num = [&]() {
+    FragmentInfo fragment_info(ctx, array_name);
+    fragment_info.load();
+    return fragment_info.unconsolidated_metadata_num();
+  };
+
+  Config config;
+  config["sm.consolidation.mode"] = "fragment_meta";
+  config["sm.consolidation.fragment_meta.max_deltas"] = "2";
+  config["sm.vacuum.mode"] = "fragment_meta";
+  write_array(array_name, {1}, {1});
+  write_array(array_name, {2}, {2});
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  CHECK(meta_file_num() == 1);
+
+  // A delta is appended, and kept by the vacuum
+  write_array(array_name, {3}, {3});
+  CHECK(unconsolidated_num() == 1);
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(meta_file_num() == 2);
+  CHECK(unconsolidated_num() == 0);
+
+  // Nothing to append
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  CHECK(meta_file_num() == 2);
+
+  write_array(array_name, {4}, {4});
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(meta_file_num() == 3);
+  CHECK(unconsolidated_num() == 0);
+  read_array(array_name, {1, 2, 3, 4}, {1, 2, 3, 4});
+
+  // The third delta merges all the footers instead
+  write_array(array_name, {1}, {5});
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(meta_file_num() == 1);
+  CHECK(unconsolidated_num() == 0);
+  read_array(array_name, {1, 2, 3, 4}, {5, 2, 3, 4});
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse consolidation by copying tiles",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  // Space tiles and data tiles of two cells
+  {
+    Context ctx;
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 8}}, 2));
+    ArraySchema schema(ctx, TILEDB_SPARSE);
+    schema.set_domain(domain);
+    schema.set_capacity(2);
+    schema.add_attribute(Attribute::create<int>(ctx, "a"));
+    Array::create(array_name, schema);
+  }
+
+  bool disjoint = true;
+  SECTION("- disjoint space tiles") {
+    write_array(array_name, {5, 6}, {5, 6});
+    write_array(array_name, {1, 2}, {1, 2});
+    write_array(array_name, {3, 4}, {3, 4});
+  }
+
+  SECTION("- shared space tile") {
+    disjoint = false;
+    write_array(array_name, {1, 2}, {1, 2});
+    write_array(array_name, {2, 3}, {7, 3});
+    write_array(array_name, {5}, {5});
+  }
+  CHECK(tiledb::test::num_fragments(array_name) == 3);
+
+  Context ctx;
+  Config config;
+  config["sm.consolidation.tile_copy"] = "true";
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  if (disjoint)
+    read_array(array_name, {1, 2, 3, 4, 5, 6}, {1, 2, 3, 4, 5, 6});
+  else
+    read_array(array_name, {1, 2, 3, 5}, {1, 7, 3, 5});
+
+  remove_array(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse consolidation with a total buffer size",
+    "[cppapi][consolidation][sparse]") {
+  std::string array_name = "cppapi_consolidation_sparse";
+  remove_array(array_name);
+
+  {
+    Context ctx;
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 8}}, 2));
+    ArraySchema schema(ctx, TILEDB_SPARSE);
+    schema.set_domain(domain);
+    schema.set_capacity(2);
+    schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+    Array::create(array_name, schema);
+  }
+
+  Context ctx;
+  auto write = [&](std::vector<int> d, std::string data) {
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = 0; i < d.size(); ++i)
+      offsets.push_back(i * data.size() / d.size());
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED);
+    query.set_data_buffer("d", d);
+    query.set_data_buffer("s", data);
+    query.set_offsets_buffer("s", offsets);
+    query.submit();
+    array.close();
+  };
+  write({1, 2}, "aaaabbbb");
+  write({3, 4}, "ccccdddd");
+  write({5, 6, 7}, "eeeeffffgggg");
+
+  Config config;
+  config["sm.consolidation.total_buffer_size"] = "64";
+  SECTION("- read and write in turn") {
+  }
+  SECTION("- pipelined") {
+    config["sm.consolidation.max_in_flight_bytes"] = "1024";
+  }
+  REQUIRE_NOTHROW(Array::consolidate(ctx, array_name, &config));
+  REQUIRE_NOTHROW(Array::vacuum(ctx, array_name, &config));
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_GLOBAL_ORDER);
+  query.add_range(0, 1, 8);
+  std::vector<int> d(8);
+  std::string data(64, 0);
+  std::vector<uint64_t> offsets(8);
+  query.set_data_buffer("d", d);
+  query.set_data_buffer("s", data);
+  query.set_offsets_buffer("s", offsets);
+  query.submit();
+  CHECK(query.query_status() == Query::Status::COMPLETE);
+  auto result_num = query.result_buffer_elements()["s"];
+  CHECK(result_num.first == 7);
+  data.resize(result_num.second);
+  CHECK(data == "aaaabbbbccccddddeeeeffffgggg");
+  array.close();
+
+  remove_array(array_name);
+}
 }  // namespace sparse_consolidate
@@ -36,6 +36,7 @@
 #include "tiledb/sm/misc/constants.h"
 
 #include <iostream>
+#include <limits>
 
 using namespace tiledb;
 
@@ -769,3 +770,92 @@ TEST_CASE(
 
   CHECK_NOTHROW(vfs.remove_dir(array_name));
 }
+
+TEST_CASE(
+    "C++ API: Test dense tiles holding only fill values",
+    "[cppapi][fill-values][fill-tiles]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "fill_values_fill_tiles";
+
+  if (vfs.is_dir(array_name))
+    CHECK_NOTHROW(vfs.remove_dir(array_name));
+
+  // Create a 1D array with 10 tiles of 10 cells.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  auto b = Attribute::create<int32_t>(ctx, "b");
+  b.set_nullable(true);
+  schema.add_attribute(b);
+  Array::create(array_name, schema);
+
+  const int32_t fill = std::numeric_limits<int32_t>::min();
+  auto write = [&](const std::vector<int32_t>& a, bool elide) {
+    Config config;
+    config["sm.query.dense.elide_fill_tiles"] = elide ? "true" : "false";
+    Context ctx_write(config);
+    std::vector<int32_t> b_data(a);
+    std::vector<uint8_t> b_validity(a.size());
+    for (size_t i = 0; i < a.size(); i++)
+      b_validity[i] = a[i] != fill;
+    Array array(ctx_write, array_name, TILEDB_WRITE);
+    Query query(ctx_write, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int32_t>({1, 100})
+        .set_data_buffer("a", const_cast<int32_t*>(a.data()), a.size())
+        .set_data_buffer("b", b_data)
+        .set_validity_buffer("b", b_validity);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  };
+
+  // Write data everywhere, then a fragment where only the first two tiles
+  // hold data, with and without eliding the other tiles.
+  std::vector<int32_t> all(100);
+  std::vector<int32_t> sparse(100, fill);
+  for (int32_t i = 0; i < 100; i++) {
+    all[i] = i + 1;
+    if (i < 20)
+      sparse[i] = i + 1;
+  }
+  write(all, true);
+  write(sparse, false);
+  write(sparse, true);
+
+  // The fragment with elided tiles is smaller.
+  FragmentInfo fragment_info(ctx, array_name);
+  fragment_info.load();
+  REQUIRE(fragment_info.fragment_num() == 3);
+  CHECK(fragment_info.fragment_size(2) < fragment_info.fragment_size(1));
+
+  // The fill values of the last fragment hide the older data.
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  std::vector<int32_t> a_read(100);
+  std::vector<int32_t> b_read(100);
+  std::vector<uint8_t> b_validity_read(100);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int32_t>({1, 100})
+      .set_data_buffer("a", a_read)
+      .set_data_buffer("b", b_read)
+      .set_validity_buffer("b", b_validity_read);
+
+  tiledb::Stats::enable();
+  tiledb::Stats::reset();
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  std::string stats;
+  tiledb::Stats::raw_dump(&stats);
+  tiledb::Stats::disable();
+  array.close();
+
+  CHECK(a_read == sparse);
+  CHECK(b_read == sparse);
+  for (int32_t i = 0; i < 100; i++)
+    CHECK(b_validity_read[i] == (i < 20));
+  CHECK(stats.find("read_fill_tile_num\": 16") != std::string::npos);
+
+  CHECK_NOTHROW(vfs.remove_dir(array_name));
+}
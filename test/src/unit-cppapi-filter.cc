@@ -31,6 +31,7 @@
  */
 
 #include "catch.hpp"
+#include "tiledb/sm/c_api/tiledb_serialization.h"
 #include "tiledb/sm/cpp_api/tiledb"
 
 static void check_filters(
@@ -229,3 +230,154 @@ TEST_CASE("C++ API: Filter lists on array", "[cppapi][filter]") {
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: ZStd filter with a trained dictionary", "[cppapi][filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_zstd_dictionary";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Records that share most of their content.
+  auto record = [](int i) {
+    return "{\"sensor\": \"station-" + std::to_string(i % 13) +
+           "\", \"status\": \"" + (i % 3 == 0 ? "ok" : "degraded") +
+           "\", \"reading\": " + std::to_string(i * 7919 % 1000) + "}";
+  };
+  std::vector<std::string> samples;
+  for (int i = 0; i < 500; i++)
+    samples.push_back(record(i));
+
+  // Dictionaries are only supported by ZStd.
+  Filter lz4(ctx, TILEDB_FILTER_LZ4);
+  REQUIRE_THROWS(lz4.train_zstd_dictionary(samples, 4096));
+
+  Filter zstd(ctx, TILEDB_FILTER_ZSTD);
+  REQUIRE(zstd.zstd_dictionary().empty());
+  zstd.train_zstd_dictionary(samples, 4096);
+  auto dictionary = zstd.zstd_dictionary();
+  REQUIRE(!dictionary.empty());
+  REQUIRE(dictionary.size() <= 4096);
+
+  FilterList a_filters(ctx);
+  a_filters.set_max_chunk_size(256);
+  a_filters.add_filter(zstd);
+  auto a = Attribute::create<std::string>(ctx, "a");
+  a.set_filter_list(a_filters);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 99}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(a);
+  Array::create(array_name, schema);
+
+  // Write and read back.
+  std::vector<std::string> a_data;
+  for (int i = 0; i < 100; i++)
+    a_data.push_back(record(i + 1000));
+  auto a_buf = ungroup_var_buffer(a_data);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_data_buffer("a", a_buf.second)
+      .set_offsets_buffer("a", a_buf.first)
+      .set_subarray(std::vector<int>{0, 99})
+      .set_layout(TILEDB_ROW_MAJOR);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  array.open(TILEDB_READ);
+  std::vector<uint64_t> a_read_off(100);
+  std::string a_read_data(a_buf.second.size(), '\0');
+  Query query_r(ctx, array);
+  query_r.set_subarray(std::vector<int>{0, 99})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_data_buffer("a", a_read_data)
+      .set_offsets_buffer("a", a_read_off);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a_read_off == a_buf.first);
+  REQUIRE(
+      a_read_data ==
+      std::string(a_buf.second.begin(), a_buf.second.end()));
+
+  // The dictionary is stored in the array schema.
+  auto schema_r = array.schema();
+  auto filter_r = schema_r.attribute("a").filter_list().filter(0);
+  REQUIRE(filter_r.zstd_dictionary() == dictionary);
+  array.close();
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+#ifdef TILEDB_SERIALIZATION
+TEST_CASE(
+    "C++ API: ZStd filter dictionary serialization",
+    "[cppapi][filter][serialization]") {
+  using namespace tiledb;
+  tiledb_serialization_type_t format = TILEDB_JSON;
+  SECTION("- json") {
+    format = TILEDB_JSON;
+  }
+
+  SECTION("- capnp") {
+    format = TILEDB_CAPNP;
+  }
+
+  Context ctx;
+  std::vector<std::string> samples;
+  for (int i = 0; i < 500; i++)
+    samples.push_back(
+        "{\"sensor\": \"station-" + std::to_string(i % 13) +
+        "\", \"reading\": " + std::to_string(i * 7919 % 1000) + "}");
+  Filter zstd(ctx, TILEDB_FILTER_ZSTD);
+  zstd.set_option(TILEDB_COMPRESSION_LEVEL, int32_t(7));
+  zstd.train_zstd_dictionary(samples, 4096);
+  auto dictionary = zstd.zstd_dictionary();
+  REQUIRE(!dictionary.empty());
+
+  // One attribute with the dictionary and one without.
+  FilterList a_filters(ctx);
+  a_filters.add_filter(zstd);
+  auto a = Attribute::create<std::string>(ctx, "a");
+  a.set_filter_list(a_filters);
+  FilterList b_filters(ctx);
+  b_filters.add_filter(Filter(ctx, TILEDB_FILTER_ZSTD));
+  auto b = Attribute::create<int>(ctx, "b");
+  b.set_filter_list(b_filters);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 99}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(a);
+  schema.add_attribute(b);
+
+  // Round-trip the schema.
+  tiledb_buffer_t* buff;
+  REQUIRE(
+      tiledb_serialize_array_schema(
+          ctx.ptr().get(), schema.ptr().get(), format, 1, &buff) ==
+      TILEDB_OK);
+  tiledb_array_schema_t* schema_r_ptr;
+  REQUIRE(
+      tiledb_deserialize_array_schema(
+          ctx.ptr().get(), buff, format, 0, &schema_r_ptr) == TILEDB_OK);
+  tiledb_buffer_free(&buff);
+  ArraySchema schema_r(ctx, schema_r_ptr);
+
+  auto filter_a = schema_r.attribute("a").filter_list().filter(0);
+  CHECK(filter_a.filter_type() == TILEDB_FILTER_ZSTD);
+  int32_t level;
+  filter_a.get_option(TILEDB_COMPRESSION_LEVEL, &level);
+  CHECK(level == 7);
+  CHECK(filter_a.zstd_dictionary() == dictionary);
+  auto filter_b = schema_r.attribute("b").filter_list().filter(0);
+  CHECK(filter_b.filter_type() == TILEDB_FILTER_ZSTD);
+  CHECK(filter_b.zstd_dictionary().empty());
+}
+#endif
@@ -873,3 +873,80 @@ TEST_CASE(
   // Clean up
   remove_dir(array_name, ctx.ptr().get(), vfs.ptr().get());
 }
+
+TEST_CASE(
+    "C++ API: Test fragment info, refresh",
+    "[cppapi][fragment_info][refresh]") {
+  Context ctx;
+  VFS vfs(ctx);
+
+  // Create array
+  uint64_t domain[] = {1, 10};
+  uint64_t tile_extent = 5;
+  create_array(
+      ctx.ptr().get(),
+      array_name,
+      TILEDB_DENSE,
+      {"d"},
+      {TILEDB_UINT64},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      2);
+
+  // Refreshing fragment info that was not loaded fails
+  FragmentInfo fragment_info(ctx, array_name);
+  CHECK_THROWS(fragment_info.refresh());
+
+  // Write a dense fragment
+  QueryBuffers buffers;
+  uint64_t subarray[] = {1, 6};
+  std::vector<int32_t> a = {1, 2, 3, 4, 5, 6};
+  uint64_t a_size = a.size() * sizeof(int32_t);
+  buffers["a"] = tiledb::test::QueryBuffer({&a[0], a_size, nullptr, 0});
+  write_array(
+      ctx.ptr().get(), array_name, 1, subarray, TILEDB_ROW_MAJOR, buffers);
+
+  fragment_info.load();
+  CHECK(fragment_info.fragment_num() == 1);
+  fragment_info.refresh();
+  CHECK(fragment_info.fragment_num() == 1);
+
+  // Write two more fragments and refresh
+  write_array(
+      ctx.ptr().get(), array_name, 3, subarray, TILEDB_ROW_MAJOR, buffers);
+  write_array(
+      ctx.ptr().get(), array_name, 2, subarray, TILEDB_ROW_MAJOR, buffers);
+  fragment_info.refresh();
+  CHECK(fragment_info.fragment_num() == 3);
+
+  // The refreshed info matches that of a new load
+  FragmentInfo loaded_fragment_info(ctx, array_name);
+  loaded_fragment_info.load();
+  REQUIRE(loaded_fragment_info.fragment_num() == 3);
+  for (uint32_t f = 0; f < 3; ++f) {
+    CHECK(
+        fragment_info.fragment_uri(f) == loaded_fragment_info.fragment_uri(f));
+    CHECK(
+        fragment_info.fragment_size(f) ==
+        loaded_fragment_info.fragment_size(f));
+    CHECK(
+        fragment_info.timestamp_range(f) ==
+        loaded_fragment_info.timestamp_range(f));
+  }
+  CHECK(fragment_info.timestamp_range(1).first == 2);
+
+  // Consolidated fragments are replaced by the new one
+  Array::consolidate(ctx, array_name);
+  fragment_info.refresh();
+  CHECK(fragment_info.fragment_num() == 1);
+  CHECK(fragment_info.to_vacuum_num() == 3);
+
+  // Clean up
+  remove_dir(array_name, ctx.ptr().get(), vfs.ptr().get());
+}
@@ -2308,3 +2308,99 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     CHECK_NOTHROW(vfs.remove_dir(array_name));
 }
+
+TEST_CASE(
+    "C++ API: Test Morton, int32, 2D, write and read",
+    "[cppapi][morton][2d][int32]") {
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "morton_array";
+
+  // Remove array
+  if (vfs.is_dir(array_name))
+    CHECK_NOTHROW(vfs.remove_dir(array_name));
+
+  // Morton not applicable to dense arrays, tiles or queries
+  {
+    Domain domain(ctx);
+    auto d1 = Dimension::create<int32_t>(ctx, "d1", {{0, 100}}, 10);
+    auto d2 = Dimension::create<int32_t>(ctx, "d2", {{0, 200}}, 10);
+    domain.add_dimensions(d1, d2);
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain);
+    schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+    CHECK_THROWS(schema.set_cell_order(TILEDB_MORTON));
+    CHECK_THROWS(schema.set_tile_order(TILEDB_MORTON));
+  }
+
+  // Create array
+  Domain domain(ctx);
+  auto d1 = Dimension::create<int32_t>(ctx, "d1", {{0, 100}});
+  auto d2 = Dimension::create<int32_t>(ctx, "d2", {{0, 200}});
+  domain.add_dimensions(d1, d2);
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.set_cell_order(TILEDB_MORTON);
+  schema.set_capacity(2);
+  CHECK_NOTHROW(schema.check());
+  CHECK(schema.cell_order() == TILEDB_MORTON);
+  Array::create(array_name, schema);
+
+  // One cell per quadrant of the domain. In Morton order, the quadrants
+  // are visited in a Z, while the Hilbert order visits the last two in
+  // reverse.
+  std::vector<int32_t> buff_d1 = {60, 60, 10, 10};
+  std::vector<int32_t> buff_d2 = {150, 10, 150, 10};
+  std::vector<int32_t> buff_a = {4, 3, 2, 1};
+
+  SECTION("- unordered write") {
+    write_2d_array<int32_t, int32_t>(
+        array_name, buff_d1, buff_d2, buff_a, TILEDB_UNORDERED);
+  }
+
+  SECTION("- global order write") {
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w, TILEDB_WRITE);
+    query_w.set_layout(TILEDB_GLOBAL_ORDER);
+    CHECK_THROWS(query_w.set_layout(TILEDB_MORTON));
+
+    // Out of Morton order
+    query_w.set_data_buffer("a", buff_a);
+    query_w.set_data_buffer("d1", buff_d1);
+    query_w.set_data_buffer("d2", buff_d2);
+    CHECK_THROWS(query_w.submit());
+    array_w.close();
+
+    std::reverse(buff_d1.begin(), buff_d1.end());
+    std::reverse(buff_d2.begin(), buff_d2.end());
+    std::reverse(buff_a.begin(), buff_a.end());
+    write_2d_array<int32_t, int32_t>(
+        array_name, buff_d1, buff_d2, buff_a, TILEDB_GLOBAL_ORDER);
+  }
+
+  // Read in global order
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r, TILEDB_READ);
+  std::vector<int32_t> r_buff_a(4);
+  std::vector<int32_t> r_buff_d1(4);
+  std::vector<int32_t> r_buff_d2(4);
+  query_r.set_data_buffer("a", r_buff_a);
+  query_r.set_data_buffer("d1", r_buff_d1);
+  query_r.set_data_buffer("d2", r_buff_d2);
+  query_r.set_layout(TILEDB_GLOBAL_ORDER);
+  CHECK_NOTHROW(query_r.submit());
+  CHECK(query_r.query_status() == Query::Status::COMPLETE);
+  CHECK(query_r.result_buffer_elements()["a"].second == 4);
+  std::vector<int32_t> c_buff_a = {1, 2, 3, 4};
+  std::vector<int32_t> c_buff_d1 = {10, 10, 60, 60};
+  std::vector<int32_t> c_buff_d2 = {10, 150, 10, 150};
+  CHECK(r_buff_a == c_buff_a);
+  CHECK(r_buff_d1 == c_buff_d1);
+  CHECK(r_buff_d2 == c_buff_d2);
+  array_r.close();
+
+  // Remove array
+  if (vfs.is_dir(array_name))
+    CHECK_NOTHROW(vfs.remove_dir(array_name));
+}
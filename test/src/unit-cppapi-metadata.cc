@@ -36,7 +36,10 @@
 #include "tiledb/sm/c_api/tiledb_struct_def.h"
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/metadata/metadata.h"
 #include "tiledb/sm/misc/time.h"
 
 #ifdef _WIN32
@@ -707,3 +710,141 @@ TEST_CASE_METHOD(
   // Close array
   array.close();
 }
+
+TEST_CASE_METHOD(
+    CPPMetadataFx,
+    "C++ Metadata, incremental consolidation",
+    "[cppapi][metadata][consolidation]") {
+  // Create default array
+  create_default_array_1d();
+
+  Context ctx;
+  VFS vfs(ctx);
+  auto meta_file_num = [&]() {
+    int num = 0;
+    for (const auto& uri : vfs.ls(array_name_ + "/__meta")) {
+      if (uri.size() < 4 || uri.substr(uri.size() - 4) != ".vac")
+        ++num;
+    }
+    return num;
+  };
+  auto put = [&](const char* key, int32_t v) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    Array array(ctx, array_name_, TILEDB_WRITE);
+    array.put_metadata(key, TILEDB_INT32, 1, &v);
+    array.close();
+  };
+
+  Config config;
+  config["sm.consolidation.mode"] = "array_meta";
+  config["sm.consolidation.array_meta.max_deltas"] = "2";
+  config["sm.vacuum.mode"] = "array_meta";
+
+  // The first consolidation merges everything
+  put("aaa", 1);
+  put("bb", 2);
+  Array::consolidate(ctx, array_name_, &config);
+  Array::vacuum(ctx, array_name_, &config);
+  CHECK(meta_file_num() == 1);
+
+  // The second one merges only the newer files
+  put("aaa", 3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  Array array(ctx, array_name_, TILEDB_WRITE);
+  array.delete_metadata("bb");
+  array.close();
+  Array::consolidate(ctx, array_name_, &config);
+  Array::vacuum(ctx, array_name_, &config);
+  CHECK(meta_file_num() == 2);
+
+  const void* v_r;
+  tiledb_datatype_t v_type;
+  uint32_t v_num;
+  array.open(TILEDB_READ);
+  array.get_metadata("aaa", &v_type, &v_num, &v_r);
+  CHECK(*((const int32_t*)v_r) == 3);
+  array.get_metadata("bb", &v_type, &v_num, &v_r);
+  CHECK(v_r == nullptr);
+  CHECK(array.metadata_num() == 1);
+  array.close();
+
+  // With the maximum number of consolidated files, everything is merged
+  put("c", 4);
+  Array::consolidate(ctx, array_name_, &config);
+  Array::vacuum(ctx, array_name_, &config);
+  CHECK(meta_file_num() == 1);
+
+  array.open(TILEDB_READ);
+  array.get_metadata("aaa", &v_type, &v_num, &v_r);
+  CHECK(*((const int32_t*)v_r) == 3);
+  array.get_metadata("c", &v_type, &v_num, &v_r);
+  CHECK(*((const int32_t*)v_r) == 4);
+  CHECK(array.metadata_num() == 2);
+  array.close();
+}
+
+TEST_CASE(
+    "C++ Metadata, values read in place",
+    "[cppapi][metadata][deserialize]") {
+  using tiledb::sm::Buffer;
+  using tiledb::sm::Datatype;
+  using tiledb::sm::Metadata;
+
+  // Serialize two metadata files, the second overwriting and deleting keys
+  std::vector<int32_t> big(1000, 7);
+  int32_t v = 1;
+  Metadata older;
+  REQUIRE(older.put("a", Datatype::INT32, 1, &v).ok());
+  REQUIRE(older
+              .put(
+                  "big",
+                  Datatype::INT32,
+                  static_cast<uint32_t>(big.size()),
+                  big.data())
+              .ok());
+  REQUIRE(older.put("gone", Datatype::INT32, 1, &v).ok());
+  v = 2;
+  Metadata newer;
+  REQUIRE(newer.put("a", Datatype::INT32, 1, &v).ok());
+  REQUIRE(newer.del("gone").ok());
+
+  std::vector<tdb_shared_ptr<Buffer>> buffs;
+  for (auto m : {&older, &newer}) {
+    auto buff = tdb::make_shared<Buffer>(HERE());
+    REQUIRE(m->serialize(buff.get()).ok());
+    buffs.push_back(buff);
+  }
+
+  Metadata metadata;
+  REQUIRE(metadata.deserialize(buffs).ok());
+  CHECK(metadata.num() == 2);
+
+  // The values stay valid in copies, after the original goes away
+  auto copy = tdb::make_shared<Metadata>(HERE(), metadata);
+  metadata.clear();
+  buffs.clear();
+
+  Datatype type;
+  uint32_t num;
+  const void* value;
+  REQUIRE(copy->get("a", &type, &num, &value).ok());
+  CHECK(type == Datatype::INT32);
+  CHECK(num == 1);
+  CHECK(*static_cast<const int32_t*>(value) == 2);
+  REQUIRE(copy->get("big", &type, &num, &value).ok());
+  CHECK(num == big.size());
+  CHECK(std::memcmp(value, big.data(), big.size() * sizeof(int32_t)) == 0);
+  REQUIRE(copy->get("gone", &type, &num, &value).ok());
+  CHECK(value == nullptr);
+
+  // Re-serializing keeps the values and the deletion
+  Buffer buff;
+  REQUIRE(copy->serialize(&buff).ok());
+  Metadata reloaded;
+  REQUIRE(reloaded
+              .deserialize({tdb::make_shared<Buffer>(HERE(), std::move(buff))})
+              .ok());
+  CHECK(reloaded.num() == 2);
+  REQUIRE(reloaded.get("big", &type, &num, &value).ok());
+  CHECK(std::memcmp(value, big.data(), big.size() * sizeof(int32_t)) == 0);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file   unit-cppapi-point-lookup.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for batched point lookups.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/cpp_api/tiledb_experimental"
+
+using namespace tiledb;
+
+TEST_CASE(
+    "C++ API: Test batched point lookups",
+    "[cppapi][point-lookup]") {
+  const std::string array_name = "cpp_unit_array_point_lookup";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a 2D sparse array with a cell at (i, 2 * i) for i in [1, 20]
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d1", {{1, 100}}, 10))
+      .add_dimension(Dimension::create<int32_t>(ctx, "d2", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<double>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> d1, d2;
+  std::vector<double> a;
+  for (int32_t i = 1; i <= 20; i++) {
+    d1.emplace_back(i);
+    d2.emplace_back(2 * i);
+    a.emplace_back(i * 0.5);
+  }
+
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d1", d1)
+      .set_data_buffer("d2", d2)
+      .set_data_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  PointLookup<int32_t> lookup(ctx, array);
+  lookup.add_point({7, 14})
+      .add_point({3, 5})
+      .add_point({20, 40})
+      .add_point({3, 6})
+      .add_point({7, 14})
+      .add_point({50, 50})
+      .add_attribute("a");
+  lookup.submit();
+
+  CHECK(lookup.point_num() == 6);
+  CHECK(lookup.found(0));
+  CHECK(lookup.value<double>("a", 0) == 3.5);
+  CHECK(!lookup.found(1));
+  CHECK(lookup.found(2));
+  CHECK(lookup.value<double>("a", 2) == 10.0);
+  CHECK(lookup.found(3));
+  CHECK(lookup.value<double>("a", 3) == 1.5);
+  CHECK(lookup.found(4));
+  CHECK(lookup.value<double>("a", 4) == 3.5);
+  CHECK(!lookup.found(5));
+  CHECK_THROWS(lookup.value<double>("a", 5));
+  CHECK_THROWS(lookup.value<int32_t>("a", 0));
+  CHECK_THROWS(lookup.add_point({1}));
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
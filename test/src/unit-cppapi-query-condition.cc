@@ -0,0 +1,611 @@
+/**
+ * @file   unit-cppapi-query-condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for query conditions.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <algorithm>
+#include <limits>
+
+using namespace tiledb;
+
+namespace {
+
+/**
+ * Creates a 1D array with 10 tiles of 10 cells, where the attribute `a`
+ * holds the coordinate and the nullable attribute `b` holds the coordinate
+ * for coordinates above 50 and null otherwise.
+ */
+void create_and_write_array(
+    const Context& ctx,
+    const std::string& array_name,
+    tiledb_array_type_t array_type) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, array_type);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  auto b = Attribute::create<int32_t>(ctx, "b");
+  b.set_nullable(true);
+  schema.add_attribute(b);
+  if (array_type == TILEDB_SPARSE) {
+    schema.set_capacity(10);
+    schema.set_allows_dups(true);
+  }
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> d(100);
+  std::vector<int32_t> a(100);
+  std::vector<int32_t> b_data(100);
+  std::vector<uint8_t> b_validity(100);
+  for (int32_t i = 0; i < 100; i++) {
+    d[i] = i + 1;
+    a[i] = i + 1;
+    b_data[i] = i + 1;
+    b_validity[i] = i + 1 > 50;
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  if (array_type == TILEDB_DENSE) {
+    Subarray subarray(ctx, array);
+    subarray.add_range<int32_t>(0, 1, 100);
+    query.set_layout(TILEDB_ROW_MAJOR).set_subarray(subarray);
+  } else {
+    query.set_layout(TILEDB_UNORDERED).set_data_buffer("d", d);
+  }
+  query.set_data_buffer("a", a)
+      .set_data_buffer("b", b_data)
+      .set_validity_buffer("b", b_validity);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+/**
+ * Reads `a` with the input condition and returns the values of `a` for the
+ * cells that are not filtered out, along with the raw stats of the read.
+ */
+std::pair<std::vector<int32_t>, std::string> read_with_condition(
+    const Context& ctx,
+    const std::string& array_name,
+    tiledb_array_type_t array_type,
+    tiledb_layout_t layout,
+    const QueryCondition& qc) {
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  std::vector<int32_t> a(100);
+  Subarray subarray(ctx, array);
+  subarray.add_range<int32_t>(0, 1, 100);
+  query.set_layout(layout)
+      .set_subarray(subarray)
+      .set_condition(qc)
+      .set_data_buffer("a", a);
+
+  tiledb::Stats::enable();
+  tiledb::Stats::reset();
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  std::string stats;
+  tiledb::Stats::raw_dump(&stats);
+  tiledb::Stats::disable();
+  array.close();
+
+  // Dense queries return the fill value for filtered cells.
+  a.resize(query.result_buffer_elements()["a"].second);
+  if (array_type == TILEDB_DENSE) {
+    a.erase(
+        std::remove(
+            a.begin(), a.end(), std::numeric_limits<int32_t>::min()),
+        a.end());
+  }
+
+  return {a, stats};
+}
+
+std::vector<int32_t> range(int32_t start, int32_t end) {
+  std::vector<int32_t> values;
+  for (int32_t i = start; i <= end; i++) {
+    values.emplace_back(i);
+  }
+
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test query condition tile skipping",
+    "[cppapi][query-condition][tile-skipping]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  tiledb_array_type_t array_type = TILEDB_DENSE;
+  tiledb_layout_t layout = TILEDB_ROW_MAJOR;
+  Config config;
+  SECTION("- Dense") {
+    array_type = TILEDB_DENSE;
+    layout = TILEDB_ROW_MAJOR;
+  }
+
+  SECTION("- Sparse unordered") {
+    array_type = TILEDB_SPARSE;
+    layout = TILEDB_UNORDERED;
+  }
+
+  SECTION("- Sparse global order") {
+    array_type = TILEDB_SPARSE;
+    layout = TILEDB_GLOBAL_ORDER;
+    config["sm.query.sparse_global_order.reader"] = "refactored";
+  }
+
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_and_write_array(ctx, array_name, array_type);
+
+  // The first 8 tiles have a max value below the condition value.
+  int32_t value = 85;
+  QueryCondition qc(ctx);
+  qc.init("a", &value, sizeof(int32_t), TILEDB_GT);
+  auto&& [a, stats] =
+      read_with_condition(ctx, array_name, array_type, layout, qc);
+  CHECK(a == range(86, 100));
+  CHECK(stats.find("qc_skipped_tile_num\": 8") != std::string::npos);
+
+  // The last 5 tiles have no null values.
+  QueryCondition qc_null(ctx);
+  qc_null.init("b", nullptr, 0, TILEDB_EQ);
+  auto&& [a_null, stats_null] =
+      read_with_condition(ctx, array_name, array_type, layout, qc_null);
+  CHECK(a_null == range(1, 50));
+  CHECK(stats_null.find("qc_skipped_tile_num\": 5") != std::string::npos);
+
+  // No tile can be skipped, the values are spread in all tiles.
+  int32_t ne_value = 42;
+  QueryCondition qc_ne(ctx);
+  qc_ne.init("a", &ne_value, sizeof(int32_t), TILEDB_NE);
+  auto&& [a_ne, stats_ne] =
+      read_with_condition(ctx, array_name, array_type, layout, qc_ne);
+  auto expected = range(1, 100);
+  expected.erase(expected.begin() + 41);
+  CHECK(a_ne == expected);
+  CHECK(stats_ne.find("qc_skipped_tile_num\": 0") != std::string::npos);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition late materialization",
+    "[cppapi][query-condition][late-materialization]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  tiledb_layout_t layout = TILEDB_UNORDERED;
+  Config config;
+  SECTION("- Sparse unordered") {
+    layout = TILEDB_UNORDERED;
+  }
+
+  SECTION("- Sparse global order") {
+    layout = TILEDB_GLOBAL_ORDER;
+    config["sm.query.sparse_global_order.reader"] = "refactored";
+  }
+
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_and_write_array(ctx, array_name, TILEDB_SPARSE);
+
+  // Only the second tile cannot be skipped with the tile metadata, `b` is
+  // only read if any of its cells pass the condition.
+  const int32_t upper_bound = GENERATE(16, 17);
+  int32_t lower_bound = 15;
+  QueryCondition qc_lower(ctx);
+  qc_lower.init("a", &lower_bound, sizeof(int32_t), TILEDB_GT);
+  QueryCondition qc_upper(ctx);
+  qc_upper.init("a", &upper_bound, sizeof(int32_t), TILEDB_LT);
+  QueryCondition qc = qc_lower.combine(qc_upper, TILEDB_AND);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  std::vector<int32_t> a(100);
+  std::vector<int32_t> b(100);
+  std::vector<uint8_t> b_validity(100);
+  query.set_layout(layout)
+      .set_condition(qc)
+      .set_data_buffer("a", a)
+      .set_data_buffer("b", b)
+      .set_validity_buffer("b", b_validity);
+
+  tiledb::Stats::enable();
+  tiledb::Stats::reset();
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  std::string stats;
+  tiledb::Stats::raw_dump(&stats);
+  tiledb::Stats::disable();
+  array.close();
+
+  a.resize(query.result_buffer_elements()["a"].second);
+  if (upper_bound == 16) {
+    CHECK(a.empty());
+    CHECK(stats.find("attr_tile_num\": 1") != std::string::npos);
+  } else {
+    CHECK(a == std::vector<int32_t>{16});
+    CHECK(b[0] == 16);
+    CHECK(stats.find("attr_tile_num\": 2") != std::string::npos);
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition set operators",
+    "[cppapi][query-condition][set]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  tiledb_array_type_t array_type = TILEDB_DENSE;
+  tiledb_layout_t layout = TILEDB_ROW_MAJOR;
+  SECTION("- Dense") {
+    array_type = TILEDB_DENSE;
+    layout = TILEDB_ROW_MAJOR;
+  }
+
+  SECTION("- Sparse unordered") {
+    array_type = TILEDB_SPARSE;
+    layout = TILEDB_UNORDERED;
+  }
+
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_and_write_array(ctx, array_name, array_type);
+
+  // Only the tiles holding a member of the set are processed.
+  QueryCondition qc_in(ctx);
+  qc_in.init_set<int32_t>("a", {77, 3, 42, 1000, 3}, TILEDB_IN);
+  auto&& [a_in, stats_in] =
+      read_with_condition(ctx, array_name, array_type, layout, qc_in);
+  CHECK(a_in == std::vector<int32_t>{3, 42, 77});
+  CHECK(stats_in.find("qc_skipped_tile_num\": 7") != std::string::npos);
+
+  QueryCondition qc_not_in(ctx);
+  qc_not_in.init_set<int32_t>("a", {77, 3, 42}, TILEDB_NOT_IN);
+  auto&& [a_not_in, stats_not_in] =
+      read_with_condition(ctx, array_name, array_type, layout, qc_not_in);
+  auto expected = range(1, 100);
+  expected.erase(expected.begin() + 76);
+  expected.erase(expected.begin() + 41);
+  expected.erase(expected.begin() + 2);
+  CHECK(a_not_in == expected);
+
+  // The members must match the attribute type.
+  QueryCondition qc_mismatch(ctx);
+  qc_mismatch.init_set<int64_t>("a", {3}, TILEDB_IN);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  std::vector<int32_t> a(100);
+  Subarray subarray(ctx, array);
+  subarray.add_range<int32_t>(0, 1, 100);
+  query.set_layout(layout)
+      .set_subarray(subarray)
+      .set_condition(qc_mismatch)
+      .set_data_buffer("a", a);
+  CHECK_THROWS(query.submit());
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition with an attribute value index",
+    "[cppapi][query-condition][attribute-index]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  Config config;
+  config["sm.attribute_index_names"] = "a,missing";
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Every tile holds values spread over the whole range of `a`, so the tile
+  // min/max values cannot skip any tile.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.set_capacity(10);
+  schema.set_allows_dups(true);
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> d(100);
+  std::vector<int32_t> a(100);
+  for (int32_t i = 0; i < 100; i++) {
+    d[i] = i + 1;
+    a[i] = (i % 10) * 10 + i / 10 + 1;
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", d)
+      .set_data_buffer("a", a);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Only the tile holding the value is processed.
+  int32_t value = 37;
+  QueryCondition qc(ctx);
+  qc.init("a", &value, sizeof(int32_t), TILEDB_EQ);
+  auto&& [a_eq, stats_eq] =
+      read_with_condition(ctx, array_name, TILEDB_SPARSE, TILEDB_UNORDERED, qc);
+  CHECK(a_eq == std::vector<int32_t>{37});
+  CHECK(stats_eq.find("qc_skipped_tile_num\": 9") != std::string::npos);
+
+  // Only the tiles holding a member of the set are processed.
+  QueryCondition qc_in(ctx);
+  qc_in.init_set<int32_t>("a", {37, 52}, TILEDB_IN);
+  auto&& [a_in, stats_in] = read_with_condition(
+      ctx, array_name, TILEDB_SPARSE, TILEDB_UNORDERED, qc_in);
+  std::sort(a_in.begin(), a_in.end());
+  CHECK(a_in == std::vector<int32_t>{37, 52});
+  CHECK(stats_in.find("qc_skipped_tile_num\": 8") != std::string::npos);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition result size estimation",
+    "[cppapi][query-condition][est-result-size]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  tiledb_array_type_t array_type = TILEDB_DENSE;
+  SECTION("- Dense") {
+    array_type = TILEDB_DENSE;
+  }
+
+  SECTION("- Sparse") {
+    array_type = TILEDB_SPARSE;
+  }
+
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_and_write_array(ctx, array_name, array_type);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  auto estimate = [&](const QueryCondition* qc, const std::string& name) {
+    Query query(ctx, array, TILEDB_READ);
+    Subarray subarray(ctx, array);
+    subarray.add_range<int32_t>(0, 1, 100);
+    query.set_subarray(subarray);
+    if (qc != nullptr)
+      query.set_condition(*qc);
+    return query.est_result_size_condition(name);
+  };
+
+  // Without a condition, the estimate matches the unconditional one.
+  auto est = estimate(nullptr, "a");
+  CHECK(est[0] == 100 * sizeof(int32_t));
+  CHECK(est[1] == 0);
+  CHECK(est[2] == 0);
+
+  // Only half of tile 9 and all of tile 10 can match.
+  int32_t value = 85;
+  QueryCondition qc(ctx);
+  qc.init("a", &value, sizeof(int32_t), TILEDB_GT);
+  est = estimate(&qc, "a");
+  CHECK(est[0] == 15 * sizeof(int32_t));
+
+  // Tiles with no value in the set are excluded.
+  QueryCondition qc_eq(ctx);
+  qc_eq.init("a", &value, sizeof(int32_t), TILEDB_EQ);
+  est = estimate(&qc_eq, "b");
+  CHECK(est[0] == sizeof(int32_t));
+  CHECK(est[2] == 1);
+
+  // Only the first 5 tiles contain null values.
+  QueryCondition qc_null(ctx);
+  qc_null.init("b", nullptr, 0, TILEDB_EQ);
+  est = estimate(&qc_null, "b");
+  CHECK(est[0] == 50 * sizeof(int32_t));
+  CHECK(est[2] == 50);
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition tile skipping on long strings",
+    "[cppapi][query-condition][tile-skipping][string]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with 10 tiles of 10 cells, where the cells of tile
+  // `t` hold strings starting with 70 times the letter 'a' + t, which are
+  // longer than the min/max prefix stored for a tile.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_capacity(10);
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> d(100);
+  std::string s_data;
+  std::vector<uint64_t> s_offsets(100);
+  for (int32_t i = 0; i < 100; i++) {
+    d[i] = i + 1;
+    s_offsets[i] = s_data.size();
+    s_data += std::string(70, 'a' + i / 10) + std::to_string(i % 10);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", d)
+      .set_data_buffer("s", s_data)
+      .set_offsets_buffer("s", s_offsets);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // The first 7 tiles have a max value below the condition value. The
+  // truncated max of tile 8 is still above it.
+  std::string value(70, 'h');
+  QueryCondition qc(ctx);
+  qc.init("s", value.data(), value.size(), TILEDB_GT);
+
+  Array array_read(ctx, array_name, TILEDB_READ);
+  Query query_read(ctx, array_read, TILEDB_READ);
+  std::vector<int32_t> d_read(100);
+  query_read.set_layout(TILEDB_UNORDERED)
+      .set_condition(qc)
+      .set_data_buffer("d", d_read);
+
+  tiledb::Stats::enable();
+  tiledb::Stats::reset();
+  REQUIRE(query_read.submit() == Query::Status::COMPLETE);
+  std::string stats;
+  tiledb::Stats::raw_dump(&stats);
+  tiledb::Stats::disable();
+  array_read.close();
+
+  d_read.resize(query_read.result_buffer_elements()["d"].second);
+  std::sort(d_read.begin(), d_read.end());
+  CHECK(d_read == range(71, 100));
+  CHECK(stats.find("qc_skipped_tile_num\": 7") != std::string::npos);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition on fixed-size strings",
+    "[cppapi][query-condition][tile-skipping][string]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with 10 tiles of 10 cells, where cell `i` holds
+  // the 4 characters code 'a' + i / 10, 'x' and the two digits of i % 10.
+  auto type = GENERATE(TILEDB_CHAR, TILEDB_STRING_ASCII);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_capacity(10);
+  Attribute attr(ctx, "s", type);
+  attr.set_cell_val_num(4);
+  schema.add_attribute(attr);
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> d(100);
+  std::string s_data;
+  for (int32_t i = 0; i < 100; i++) {
+    d[i] = i + 1;
+    s_data += std::string(1, 'a' + i / 10) + "x0" + std::to_string(i % 10);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", d)
+      .set_data_buffer("s", s_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Reads the coordinates of the cells matching `value` with `op`, and the
+  // number of tiles skipped using their min/max values.
+  auto read = [&](const std::string& value, tiledb_query_condition_op_t op) {
+    QueryCondition qc(ctx);
+    qc.init("s", value.data(), value.size(), op);
+
+    Array array_read(ctx, array_name, TILEDB_READ);
+    Query query_read(ctx, array_read, TILEDB_READ);
+    std::vector<int32_t> d_read(100);
+    query_read.set_layout(TILEDB_UNORDERED)
+        .set_condition(qc)
+        .set_data_buffer("d", d_read);
+
+    tiledb::Stats::enable();
+    tiledb::Stats::reset();
+    REQUIRE(query_read.submit() == Query::Status::COMPLETE);
+    std::string stats;
+    tiledb::Stats::raw_dump(&stats);
+    tiledb::Stats::disable();
+    array_read.close();
+
+    d_read.resize(query_read.result_buffer_elements()["d"].second);
+    std::sort(d_read.begin(), d_read.end());
+    return std::make_pair(d_read, stats);
+  };
+
+  // All the characters of the cells are compared, not only the first one.
+  auto&& [eq, eq_stats] = read("cx05", TILEDB_EQ);
+  CHECK(eq == std::vector<int32_t>{26});
+  CHECK(eq_stats.find("qc_skipped_tile_num\": 9") != std::string::npos);
+
+  // The first 7 tiles have a max value below the condition value.
+  auto&& [ge, ge_stats] = read("h", TILEDB_GE);
+  CHECK(ge == range(71, 100));
+  CHECK(ge_stats.find("qc_skipped_tile_num\": 7") != std::string::npos);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -32,8 +32,12 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/cpp_api/tiledb_experimental"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
+#include <thread>
+
 using namespace tiledb;
 
 TEST_CASE("C++ API: Test get query layout", "[cppapi][query]") {
@@ -291,3 +295,1318 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Global order writes with background tile flushes",
+    "[cppapi][query][global-order][async-flush]") {
+  const std::string array_name = "cpp_unit_array_async_flush";
+  std::string max_in_flight_bytes;
+  SECTION("- Synchronous") {
+    max_in_flight_bytes = "0";
+  }
+  SECTION("- One tile in flight") {
+    max_in_flight_bytes = "8";
+  }
+  SECTION("- Many tiles in flight") {
+    max_in_flight_bytes = "1048576";
+  }
+
+  Config cfg;
+  cfg["sm.mem.writer.global_order.max_in_flight_bytes"] = max_in_flight_bytes;
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with small tiles.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write in several submits, with partial tiles across submits.
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_GLOBAL_ORDER);
+  std::vector<int> expected_d, expected_a;
+  int next = 1;
+  for (int s = 0; s < 10; s++) {
+    std::vector<int> d, a;
+    for (int c = 0; c < 7 + s; c++) {
+      d.push_back(next);
+      a.push_back(next * 10);
+      next++;
+    }
+    expected_d.insert(expected_d.end(), d.begin(), d.end());
+    expected_a.insert(expected_a.end(), a.begin(), a.end());
+    query_w.set_data_buffer("d", d).set_data_buffer("a", a);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  }
+  query_w.finalize();
+  array_w.close();
+
+  // Read back.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> d(expected_d.size()), a(expected_a.size());
+  query_r.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d", d)
+      .set_data_buffer("a", a);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(query_r.result_buffer_elements()["a"].second == expected_a.size());
+  CHECK(d == expected_d);
+  CHECK(a == expected_a);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Global order writes with a memory budget",
+    "[cppapi][query][global-order][budget]") {
+  const std::string array_name = "cpp_unit_array_writer_budget";
+  std::string budget;
+  std::string max_in_flight_bytes = "0";
+  SECTION("- No budget") {
+    budget = "0";
+  }
+  SECTION("- One tile per batch") {
+    budget = "1";
+  }
+  SECTION("- Several tiles per batch") {
+    budget = "256";
+  }
+  SECTION("- Several tiles per batch, in the background") {
+    budget = "256";
+    max_in_flight_bytes = "1048576";
+  }
+
+  Config cfg;
+  cfg["sm.mem.writer.global_order.budget"] = budget;
+  cfg["sm.mem.writer.global_order.max_in_flight_bytes"] = max_in_flight_bytes;
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with small tiles and a var-sized attribute.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  // Write in several submits of many tiles each.
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_GLOBAL_ORDER);
+  std::vector<int> expected_d, expected_a;
+  std::string expected_s;
+  int next = 1;
+  for (int s = 0; s < 3; s++) {
+    std::vector<int> d, a;
+    std::vector<uint64_t> s_offsets;
+    std::string s_data;
+    for (int c = 0; c < 50 + s; c++) {
+      d.push_back(next);
+      a.push_back(next * 10);
+      s_offsets.push_back(s_data.size());
+      s_data += std::string(1 + next % 3, 'a' + next % 26);
+      next++;
+    }
+    expected_d.insert(expected_d.end(), d.begin(), d.end());
+    expected_a.insert(expected_a.end(), a.begin(), a.end());
+    expected_s += s_data;
+    query_w.set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .set_data_buffer("s", s_data)
+        .set_offsets_buffer("s", s_offsets);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  }
+  query_w.finalize();
+  array_w.close();
+
+  // Read back.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> d(expected_d.size()), a(expected_a.size());
+  std::vector<uint64_t> s_offsets(expected_d.size());
+  std::string s_data(expected_s.size(), '\0');
+  query_r.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d", d)
+      .set_data_buffer("a", a)
+      .set_data_buffer("s", s_data)
+      .set_offsets_buffer("s", s_offsets);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(query_r.result_buffer_elements()["a"].second == expected_a.size());
+  CHECK(d == expected_d);
+  CHECK(a == expected_a);
+  CHECK(s_data == expected_s);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Dense global order writes with tile aligned buffers",
+    "[cppapi][query][global-order][dense]") {
+  const std::string array_name = "cpp_unit_array_tile_aligned";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a dense array with a nullable attribute.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 40}}, 4));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  auto attr = Attribute::create<int>(ctx, "a");
+  attr.set_nullable(true);
+  schema.add_attribute(attr);
+  Array::create(array_name, schema);
+
+  // Write whole tiles in the first submit and partial tiles afterwards.
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_GLOBAL_ORDER).set_subarray<int>({1, 40});
+  std::vector<int> expected_a;
+  std::vector<uint8_t> expected_validity;
+  for (auto cell_num : {16, 6, 10, 8}) {
+    std::vector<int> a;
+    std::vector<uint8_t> validity;
+    for (int c = 0; c < cell_num; c++) {
+      const int v = static_cast<int>(expected_a.size()) + 1;
+      a.push_back(v);
+      validity.push_back(v % 3 != 0);
+      expected_a.push_back(v);
+      expected_validity.push_back(v % 3 != 0);
+    }
+    query_w.set_data_buffer("a", a).set_validity_buffer("a", validity);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  }
+  query_w.finalize();
+  array_w.close();
+
+  // Read back.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> a(40);
+  std::vector<uint8_t> validity(40);
+  query_r.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int>({1, 40})
+      .set_data_buffer("a", a)
+      .set_validity_buffer("a", validity);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(a == expected_a);
+  CHECK(validity == expected_validity);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Streaming dense writes in row-major slabs",
+    "[cppapi][query][dense][streaming-write]") {
+  const std::string array_name = "cpp_unit_array_streaming_write";
+  Config cfg;
+  cfg["sm.query.dense.streaming_write"] = "true";
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a dense array with a nullable and a var-sized attribute.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{1, 10}}, 3))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{1, 4}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  auto attr = Attribute::create<int>(ctx, "a");
+  attr.set_nullable(true);
+  schema.add_attribute(attr);
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  // Write rows 2-9 in slabs that do not align with the tiles.
+  const std::vector<int> subarray = {2, 9, 1, 4};
+  std::vector<int> expected_a;
+  std::vector<uint8_t> expected_validity;
+  std::string expected_s;
+  std::vector<uint64_t> expected_s_off;
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_ROW_MAJOR).set_subarray(subarray);
+  for (auto row_num : {1, 3, 4}) {
+    std::vector<int> a;
+    std::vector<uint8_t> validity;
+    std::string s;
+    std::vector<uint64_t> s_off;
+    for (int c = 0; c < row_num * 4; c++) {
+      const int v = static_cast<int>(expected_a.size()) + 1;
+      a.push_back(v);
+      validity.push_back(v % 3 != 0);
+      s_off.push_back(s.size());
+      s += std::string(v % 4, 'a' + v % 26);
+      expected_a.push_back(v);
+      expected_validity.push_back(v % 3 != 0);
+      expected_s_off.push_back(expected_s.size());
+      expected_s += std::string(v % 4, 'a' + v % 26);
+    }
+    query_w.set_data_buffer("a", a)
+        .set_validity_buffer("a", validity)
+        .set_data_buffer("s", s)
+        .set_offsets_buffer("s", s_off);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  }
+  query_w.finalize();
+  array_w.close();
+
+  // Read back.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> a(32);
+  std::vector<uint8_t> validity(32);
+  std::string s(expected_s.size(), '\0');
+  std::vector<uint64_t> s_off(32);
+  query_r.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray(subarray)
+      .set_data_buffer("a", a)
+      .set_validity_buffer("a", validity)
+      .set_data_buffer("s", s)
+      .set_offsets_buffer("s", s_off);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(a == expected_a);
+  CHECK(validity == expected_validity);
+  CHECK(s == expected_s);
+  CHECK(s_off == expected_s_off);
+  array_r.close();
+
+  // Slabs must hold whole rows and the write must cover the subarray.
+  Array array_w2(ctx, array_name, TILEDB_WRITE);
+  Query query_w2(ctx, array_w2);
+  std::vector<int> a2(6, 1);
+  std::vector<uint8_t> validity2(6, 1);
+  std::string s2 = "abcdef";
+  std::vector<uint64_t> s2_off = {0, 1, 2, 3, 4, 5};
+  query_w2.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray(subarray)
+      .set_data_buffer("a", a2)
+      .set_validity_buffer("a", validity2)
+      .set_data_buffer("s", s2)
+      .set_offsets_buffer("s", s2_off);
+  CHECK_THROWS(query_w2.submit());
+  a2.resize(4);
+  validity2.resize(4);
+  s2.resize(4);
+  s2_off.resize(4);
+  query_w2.set_data_buffer("a", a2)
+      .set_validity_buffer("a", validity2)
+      .set_data_buffer("s", s2)
+      .set_offsets_buffer("s", s2_off);
+  REQUIRE(query_w2.submit() == Query::Status::COMPLETE);
+  CHECK_THROWS(query_w2.finalize());
+  array_w2.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Test query plan", "[cppapi][query][plan]") {
+  const std::string array_name = "cpp_unit_array_query_plan";
+  Config cfg;
+  std::string reader = "sparse_unordered_with_dups";
+  SECTION("- Refactored reader") {
+  }
+  SECTION("- Legacy reader") {
+    cfg["sm.query.sparse_unordered_with_dups.reader"] = "legacy";
+    reader = "legacy";
+  }
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.set_allows_dups(true);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write two fragments at both ends of the domain.
+  for (int start : {1, 91}) {
+    std::vector<int> d = {start, start + 1, start + 2};
+    std::vector<int> a = {1, 2, 3};
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+    array_w.close();
+  }
+
+  // Only the first fragment is relevant to the range.
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> a(10);
+  query_r.set_layout(TILEDB_UNORDERED)
+      .add_range(0, 1, 10)
+      .set_data_buffer("a", a);
+  auto plan = query_r.plan();
+  CHECK(plan.find("\"reader\": \"" + reader + "\"") != std::string::npos);
+  CHECK(plan.find("\"fragment_num\": 2") != std::string::npos);
+  CHECK(plan.find("\"relevant_fragment_num\": 1") != std::string::npos);
+  CHECK(plan.find("\"tile_num\": 1") != std::string::npos);
+  CHECK(plan.find("\"a\": {") != std::string::npos);
+  CHECK(plan.find("\"d\": {") == std::string::npos);
+  CHECK(
+      (plan.find("\"partition_num\": 1") != std::string::npos) ==
+      (reader == "legacy"));
+
+  // The plan does not submit the query.
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(query_r.result_buffer_elements()["a"].second == 3);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Dense reads of tiles covered by a single fragment",
+    "[cppapi][query][dense]") {
+  const std::string array_name = "cpp_unit_array_dense_in_place";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a 4x4 dense array with 2x2 tiles and a compressed nullable
+  // attribute.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{1, 4}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{1, 4}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  auto attr = Attribute::create<int>(ctx, "a");
+  attr.set_nullable(true);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+  attr.set_filter_list(filters);
+  schema.add_attribute(attr);
+  Array::create(array_name, schema);
+
+  // Write the whole array, then overwrite the cell (4, 4) so that the last
+  // tile is covered by two fragments.
+  std::vector<int> values(16);
+  std::vector<uint8_t> validity(16);
+  for (int i = 0; i < 16; i++) {
+    values[i] = i + 1;
+    validity[i] = i % 3 != 0;
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int>({1, 4, 1, 4})
+      .set_data_buffer("a", values)
+      .set_validity_buffer("a", validity);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  std::vector<int> value_w = {100};
+  std::vector<uint8_t> validity_w = {1};
+  Array array_w2(ctx, array_name, TILEDB_WRITE);
+  Query query_w2(ctx, array_w2);
+  query_w2.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int>({4, 4, 4, 4})
+      .set_data_buffer("a", value_w)
+      .set_validity_buffer("a", validity_w);
+  REQUIRE(query_w2.submit() == Query::Status::COMPLETE);
+  array_w2.close();
+  values[15] = 100;
+  validity[15] = 1;
+
+  // Returns the expected cells of a subarray, in row-major order.
+  auto expected = [&](int r1, int r2, int c1, int c2) {
+    std::pair<std::vector<int>, std::vector<uint8_t>> ret;
+    for (int r = r1; r <= r2; r++) {
+      for (int c = c1; c <= c2; c++) {
+        ret.first.push_back(values[(r - 1) * 4 + c - 1]);
+        ret.second.push_back(validity[(r - 1) * 4 + c - 1]);
+      }
+    }
+    return ret;
+  };
+
+  std::vector<int> subarray;
+  std::pair<std::vector<int>, std::vector<uint8_t>> c_cells;
+  tiledb_layout_t layout = TILEDB_ROW_MAJOR;
+  SECTION("- Row-major, tiles spanning the subarray columns") {
+    subarray = {1, 4, 3, 4};
+    c_cells = expected(1, 4, 3, 4);
+  }
+
+  SECTION("- Row-major, tiles not spanning the subarray columns") {
+    subarray = {1, 4, 1, 4};
+    c_cells = expected(1, 4, 1, 4);
+  }
+
+  SECTION("- Global order") {
+    layout = TILEDB_GLOBAL_ORDER;
+    subarray = {1, 4, 1, 4};
+    for (auto tile : std::vector<std::pair<int, int>>{
+             {1, 1}, {1, 3}, {3, 1}, {3, 3}}) {
+      auto cells =
+          expected(tile.first, tile.first + 1, tile.second, tile.second + 1);
+      c_cells.first.insert(
+          c_cells.first.end(), cells.first.begin(), cells.first.end());
+      c_cells.second.insert(
+          c_cells.second.end(), cells.second.begin(), cells.second.end());
+    }
+  }
+
+  Array array_r(ctx, array_name, TILEDB_READ);
+  Query query_r(ctx, array_r);
+  std::vector<int> a(c_cells.first.size());
+  std::vector<uint8_t> a_validity(c_cells.first.size());
+  query_r.set_layout(layout)
+      .set_subarray(subarray)
+      .set_data_buffer("a", a)
+      .set_validity_buffer("a", a_validity);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  CHECK(a == c_cells.first);
+  CHECK(a_validity == c_cells.second);
+  array_r.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query progress and report",
+    "[cppapi][query][progress]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with one tile per 4 cells.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 16}}, 4));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write two fragments.
+  for (int f = 0; f < 2; f++) {
+    std::vector<int> coords(8), values(8);
+    for (int i = 0; i < 8; i++) {
+      coords[i] = f * 8 + i + 1;
+      values[i] = coords[i];
+    }
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_data_buffer("d", coords)
+        .set_data_buffer("a", values);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+    array_w.close();
+  }
+
+  tiledb_layout_t layout = TILEDB_UNORDERED;
+  SECTION("- Unordered") {
+    layout = TILEDB_UNORDERED;
+  }
+
+  SECTION("- Global order") {
+    layout = TILEDB_GLOBAL_ORDER;
+  }
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  auto progress = query.progress();
+  CHECK(progress.phase == "not_started");
+  CHECK(progress.tiles_total == 0);
+
+  std::vector<int> coords(16), values(16);
+  query.set_layout(layout)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", values);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(query.result_buffer_elements()["a"].second == 16);
+
+  // At least the 4 coordinate tiles and 4 attribute tiles are read.
+  progress = query.progress();
+  CHECK(progress.phase == "completed");
+  CHECK(progress.tiles_total >= 8);
+  CHECK(progress.tiles_read == progress.tiles_total);
+  CHECK(progress.bytes_total > 0);
+  CHECK(progress.bytes_read == progress.bytes_total);
+
+  auto report = query.report();
+  CHECK(report.find("\"phase\": \"read_tiles\"") != std::string::npos);
+  CHECK(report.find("\"phase\": \"copy_results\"") != std::string::npos);
+  CHECK(report.find("{\"name\": \"a\"") != std::string::npos);
+  CHECK(report.find("{\"name\": \"d\"") != std::string::npos);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Concurrent reads of overlapping subarrays",
+    "[cppapi][query][shared-scan]") {
+  const std::string array_name = "cpp_unit_array_shared_scan";
+  Config cfg;
+  SECTION("- Shared scan") {
+    cfg["sm.query.shared_scan"] = "true";
+  }
+
+  SECTION("- No shared scan") {
+    cfg["sm.query.shared_scan"] = "false";
+  }
+
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with one tile per 16 cells and a compressed
+  // var-sized nullable attribute.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1024}}, 16));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(16);
+  auto attr = Attribute::create<std::string>(ctx, "a");
+  attr.set_nullable(true);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+  attr.set_filter_list(filters);
+  schema.add_attribute(attr);
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(1024);
+  std::string values;
+  std::vector<uint64_t> offsets(1024);
+  std::vector<uint8_t> validity(1024);
+  for (int i = 0; i < 1024; i++) {
+    coords[i] = i + 1;
+    offsets[i] = values.size();
+    values += std::to_string(i + 1);
+    validity[i] = i % 5 != 0;
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", values)
+      .set_offsets_buffer("a", offsets)
+      .set_validity_buffer("a", validity);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Read overlapping subarrays concurrently with the same context, several
+  // times so that reads of the same tiles are in flight together.
+  const int nthreads = 8;
+  std::vector<std::thread> threads;
+  std::vector<int> errors(nthreads, 0);
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int j = 0; j < 10; j++) {
+        const int lo = 1 + 16 * t;
+        const int hi = 1024 - 16 * t;
+        Array array(ctx, array_name, TILEDB_READ);
+        Query query(ctx, array);
+        std::vector<int> d(1024);
+        std::string a(8192, '\0');
+        std::vector<uint64_t> a_offsets(1024);
+        std::vector<uint8_t> a_validity(1024);
+        query.set_layout(TILEDB_ROW_MAJOR)
+            .set_subarray<int>({lo, hi})
+            .set_data_buffer("d", d)
+            .set_data_buffer("a", a)
+            .set_offsets_buffer("a", a_offsets)
+            .set_validity_buffer("a", a_validity);
+        if (query.submit() != Query::Status::COMPLETE) {
+          errors[t]++;
+          continue;
+        }
+
+        auto result_num = query.result_buffer_elements()["a"].first;
+        auto result_size = query.result_buffer_elements()["a"].second;
+        if (result_num != uint64_t(hi - lo + 1)) {
+          errors[t]++;
+          continue;
+        }
+        for (uint64_t i = 0; i < result_num; i++) {
+          const uint64_t end =
+              i + 1 < result_num ? a_offsets[i + 1] : result_size;
+          const int v = lo + int(i);
+          if (d[i] != v ||
+              a.substr(a_offsets[i], end - a_offsets[i]) !=
+                  std::to_string(v) ||
+              a_validity[i] != ((v - 1) % 5 != 0))
+            errors[t]++;
+        }
+        array.close();
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+  CHECK(errors == std::vector<int>(nthreads, 0));
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Random samples of sparse unordered reads",
+    "[cppapi][query][sample]") {
+  const std::string array_name = "cpp_unit_array_sample";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with one tile per 16 cells.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 4096}}, 16));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(16);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(4096);
+  std::vector<int> values(4096);
+  for (int i = 0; i < 4096; i++) {
+    coords[i] = i + 1;
+    values[i] = -(i + 1);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", values);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  auto read_sample = [&](double fraction, uint64_t seed) {
+    Query query(ctx, array);
+    std::vector<int> d(4096);
+    std::vector<int> a(4096);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_subarray<int>({101, 4000})
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .set_sample(fraction, seed);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+    auto result_num = query.result_buffer_elements()["d"].second;
+    d.resize(result_num);
+    for (uint64_t i = 0; i < result_num; i++) {
+      CHECK(d[i] >= 101);
+      CHECK(d[i] <= 4000);
+      CHECK(a[i] == -d[i]);
+    }
+    return d;
+  };
+
+  // The sample is reproducible and depends on the seed.
+  auto sample = read_sample(0.1, 7);
+  CHECK(sample.size() > 250);
+  CHECK(sample.size() < 530);
+  CHECK(read_sample(0.1, 7) == sample);
+  CHECK(read_sample(0.1, 8) != sample);
+
+  // Sampling every cell returns the whole subarray.
+  CHECK(read_sample(1.0, 7).size() == 3900);
+
+  // Only unordered reads are sampled.
+  Query query(ctx, array);
+  std::vector<int> d(4096);
+  query.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d", d)
+      .set_sample(0.5, 7);
+  CHECK_THROWS(query.submit());
+  CHECK_THROWS(query.set_sample(0.0, 7));
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Top K cells of sparse unordered reads",
+    "[cppapi][query][top-k]") {
+  const std::string array_name = "cpp_unit_array_top_k";
+  Config cfg;
+  cfg["sm.compute_concurrency_level"] = "4";
+  Context ctx(cfg);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with one tile per 16 cells, the scores grow with
+  // the coordinates apart from a few large ones.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 4096}}, 16));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(16);
+  schema.add_attribute(Attribute::create<int64_t>(ctx, "score"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(4096);
+  std::vector<int64_t> scores(4096);
+  for (int i = 0; i < 4096; i++) {
+    coords[i] = i + 1;
+    scores[i] = (i + 1) % 500 == 0 ? 100000 + i : i;
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("score", scores);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Expected top K cells in the subarray.
+  const int lo = 101, hi = 4000;
+  const uint64_t k = 12;
+  bool largest = true;
+  SECTION("- Largest") {
+    largest = true;
+  }
+  SECTION("- Smallest") {
+    largest = false;
+  }
+  std::vector<std::pair<int64_t, int>> expected;
+  for (int c = lo; c <= hi; c++)
+    expected.emplace_back(scores[c - 1], c);
+  std::sort(expected.begin(), expected.end());
+  if (largest)
+    std::reverse(expected.begin(), expected.end());
+  expected.resize(k);
+  std::sort(expected.begin(), expected.end(), [](auto& a, auto& b) {
+    return a.second < b.second;
+  });
+
+  tiledb::Stats::enable();
+  tiledb::Stats::reset();
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  std::vector<int> d(4096);
+  std::vector<int64_t> score(4096);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_subarray<int>({lo, hi})
+      .set_data_buffer("d", d)
+      .set_data_buffer("score", score)
+      .set_top_k("score", k, largest);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+  auto result_num = query.result_buffer_elements()["d"].second;
+  REQUIRE(result_num == k);
+  std::vector<std::pair<int64_t, int>> results;
+  for (uint64_t i = 0; i < result_num; i++)
+    results.emplace_back(score[i], d[i]);
+  std::sort(results.begin(), results.end(), [](auto& a, auto& b) {
+    return a.second < b.second;
+  });
+  CHECK(results == expected);
+
+  // Most tiles are skipped using their tile metadata.
+  std::string stats;
+  tiledb::Stats::raw_dump(&stats);
+  tiledb::Stats::disable();
+  const std::string key =
+      "\"Context.StorageManager.Query.Reader.top_k_skipped_tile_num\": ";
+  auto pos = stats.find(key);
+  REQUIRE(pos != std::string::npos);
+  CHECK(std::stoull(stats.substr(pos + key.size())) > 100);
+
+  // Top K is not supported by ordered reads.
+  Query query_ordered(ctx, array);
+  query_ordered.set_layout(TILEDB_GLOBAL_ORDER)
+      .set_data_buffer("d", d)
+      .set_top_k("score", k);
+  CHECK_THROWS(query_ordered.submit());
+  CHECK_THROWS(Query(ctx, array).set_top_k("d", k));
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Streaming the results of a read",
+    "[cppapi][query][streaming]") {
+  const std::string array_name = "cpp_unit_array_streaming";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(1000);
+  std::vector<int> a_w(1000);
+  std::string b_w;
+  std::vector<uint64_t> b_offsets_w(1000);
+  for (int i = 0; i < 1000; i++) {
+    coords[i] = i + 1;
+    a_w[i] = 2 * i;
+    b_offsets_w[i] = b_w.size();
+    b_w += std::to_string(i);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", a_w)
+      .set_data_buffer("b", b_w)
+      .set_offsets_buffer("b", b_offsets_w);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // The buffers hold 64 cells, the results are streamed in batches.
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<int> d(64, -1);
+  std::vector<int> a(64, -1);
+  std::string b(512, 'x');
+  std::vector<uint64_t> b_offsets(64, 0);
+  auto make_query = [&]() {
+    Query query(ctx, array);
+    query.set_layout(TILEDB_GLOBAL_ORDER)
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .set_data_buffer("b", b)
+        .set_offsets_buffer("b", b_offsets);
+    return query;
+  };
+
+  SECTION("- All batches") {
+    Query query = make_query();
+    int next = 1;
+    uint64_t batch_num = 0;
+    submit_streaming(ctx, query, [&](const QueryBatch& batch) {
+      auto [d_data, d_num] = batch.data<int>("d");
+      auto [a_data, a_num] = batch.data<int>("a");
+      auto [b_data, b_size] = batch.data<char>("b");
+      auto [offsets, offsets_num] = batch.offsets("b");
+      REQUIRE(d_num == a_num);
+      REQUIRE(d_num == offsets_num);
+      for (uint64_t c = 0; c < d_num; c++) {
+        CHECK(d_data[c] == next);
+        CHECK(a_data[c] == 2 * (next - 1));
+        uint64_t end = c + 1 < offsets_num ? offsets[c + 1] : b_size;
+        CHECK(
+            std::string(b_data + offsets[c], end - offsets[c]) ==
+            std::to_string(next - 1));
+        next++;
+      }
+      batch_num++;
+      return true;
+    });
+    CHECK(next == 1001);
+    CHECK(batch_num > 1);
+    CHECK(query.query_status() == Query::Status::COMPLETE);
+
+    // The user buffers are not written to.
+    CHECK(d == std::vector<int>(64, -1));
+    CHECK(a == std::vector<int>(64, -1));
+  }
+
+  SECTION("- Stop after the first batch") {
+    Query query = make_query();
+    uint64_t batch_num = 0;
+    CHECK_THROWS(submit_streaming(ctx, query, [&](const QueryBatch&) {
+      batch_num++;
+      return false;
+    }));
+    CHECK(batch_num == 1);
+  }
+
+  SECTION("- Exception in the callback") {
+    Query query = make_query();
+    CHECK_THROWS_AS(
+        submit_streaming(
+            ctx,
+            query,
+            [&](const QueryBatch&) -> bool {
+              throw std::logic_error("stop");
+            }),
+        std::logic_error);
+  }
+
+  SECTION("- No batch in flight") {
+    Query query = make_query();
+    auto callback = [](const QueryBatch&) { return true; };
+    CHECK_THROWS(submit_streaming(ctx, query, callback, 0));
+  }
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Managed result buffers", "[cppapi][query][managed-buffers]") {
+  const std::string array_name = "cpp_unit_array_managed_buffers";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(1000);
+  std::vector<int> a_w(1000);
+  std::string b_w;
+  std::vector<uint64_t> b_offsets_w(1000);
+  for (int i = 0; i < 1000; i++) {
+    coords[i] = i + 1;
+    a_w[i] = 2 * i;
+    b_offsets_w[i] = b_w.size();
+    b_w += std::to_string(i);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", a_w)
+      .set_data_buffer("b", b_w)
+      .set_offsets_buffer("b", b_offsets_w);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+
+  SECTION("- Write queries are rejected") {
+    Query query(ctx, array_w);
+    CHECK_THROWS(set_managed_buffer(ctx, query, "a"));
+  }
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+
+  SECTION("- Single submission") {
+    Query query(ctx, array);
+    query.set_layout(TILEDB_GLOBAL_ORDER);
+    set_managed_buffer(ctx, query, "d");
+    set_managed_buffer(ctx, query, "a");
+    set_managed_buffer(ctx, query, "b");
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+    const uint64_t chunk_num = managed_chunk_num(ctx, query);
+    CHECK(chunk_num >= 1);
+    int next = 1;
+    for (uint64_t i = 0; i < chunk_num; i++) {
+      ManagedChunk chunk(ctx, query, i);
+      auto [d_data, d_num] = chunk.data<int>("d");
+      auto [a_data, a_num] = chunk.data<int>("a");
+      auto [b_data, b_size] = chunk.data<char>("b");
+      auto [offsets, offsets_num] = chunk.offsets("b");
+      REQUIRE(d_num == a_num);
+      REQUIRE(d_num == offsets_num);
+      for (uint64_t c = 0; c < d_num; c++) {
+        CHECK(d_data[c] == next);
+        CHECK(a_data[c] == 2 * (next - 1));
+        uint64_t end = c + 1 < offsets_num ? offsets[c + 1] : b_size;
+        CHECK(
+            std::string(b_data + offsets[c], end - offsets[c]) ==
+            std::to_string(next - 1));
+        next++;
+      }
+    }
+    CHECK(next == 1001);
+    CHECK_THROWS(ManagedChunk(ctx, query, chunk_num).data<int>("a"));
+  }
+
+  SECTION("- Mixed with user buffers") {
+    std::vector<int> a(64);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_GLOBAL_ORDER).set_data_buffer("a", a);
+    set_managed_buffer(ctx, query, "d");
+    CHECK_THROWS(query.submit());
+  }
+
+  SECTION("- Invalid field") {
+    Query query(ctx, array);
+    CHECK_THROWS(set_managed_buffer(ctx, query, "foo"));
+    CHECK_THROWS(managed_chunk_num(ctx, query));
+  }
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Executing a prepared query over many subarrays",
+    "[cppapi][query][prepare]") {
+  const std::string array_name = "cpp_unit_array_prepare";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords(1000);
+  std::vector<int> a_w(1000);
+  for (int i = 0; i < 1000; i++) {
+    coords[i] = i + 1;
+    a_w[i] = 2 * (i + 1);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", coords)
+      .set_data_buffer("a", a_w);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<int> d(100);
+  std::vector<int> a(100);
+  auto run = [&](Query& query, int lo, int hi) {
+    Subarray subarray(ctx, array);
+    subarray.add_range(0, lo, hi);
+    query.set_subarray(subarray)
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto num = query.result_buffer_elements()["d"].second;
+    REQUIRE(num == uint64_t(hi - lo + 1));
+    std::vector<int> cells(d.begin(), d.begin() + num);
+    std::sort(cells.begin(), cells.end());
+    for (uint64_t c = 0; c < num; c++) {
+      CHECK(cells[c] == lo + int(c));
+      CHECK(a[c] == 2 * d[c]);
+    }
+  };
+
+  SECTION("- Rebind the subarray") {
+    auto layout = GENERATE(TILEDB_UNORDERED, TILEDB_GLOBAL_ORDER);
+    tiledb::Stats::enable();
+    tiledb::Stats::reset();
+
+    Query query(ctx, array);
+    Subarray subarray(ctx, array);
+    subarray.add_range(0, 1, 10);
+    query.set_layout(layout)
+        .set_subarray(subarray)
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .prepare();
+    for (int lo = 1; lo <= 901; lo += 75)
+      run(query, lo, lo + 99);
+
+    // The reader is created by `prepare`, then rebound to each subarray.
+    std::string stats;
+    tiledb::Stats::raw_dump(&stats);
+    tiledb::Stats::disable();
+    CHECK(
+        stats.find("\"Context.StorageManager.Query.rebind_num\": 13") !=
+        std::string::npos);
+  }
+
+  SECTION("- Not prepared") {
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED);
+    run(query, 1, 100);
+    run(query, 501, 600);
+  }
+
+  SECTION("- Errors") {
+    Query query(ctx, array);
+    Subarray subarray(ctx, array);
+    subarray.add_range(0, 1, 10);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_subarray(subarray)
+        .set_data_buffer("d", d)
+        .set_data_buffer("a", a)
+        .prepare();
+    CHECK_THROWS(query.prepare());
+
+    Array array_w2(ctx, array_name, TILEDB_WRITE);
+    Query query_w2(ctx, array_w2);
+    query_w2.set_layout(TILEDB_UNORDERED);
+    CHECK_THROWS(query_w2.prepare());
+    array_w2.close();
+  }
+
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Writing a dense fragment in parts",
+    "[cppapi][query][fragment-parts]") {
+  const std::string array_name = "cpp_unit_array_fragment_parts";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "r", {{1, 8}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "c", {{1, 6}}, 3));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  auto value = [](int r, int c) { return 10 * r + c; };
+  auto str = [](int r, int c) { return std::string((r + c) % 3 + 1, 'a' + r); };
+
+  // Writes the rows [r0, r1] as a part of the fragment
+  auto write_part = [&](const std::string& uri, uint32_t part, int r0, int r1) {
+    std::vector<int> a;
+    std::string s;
+    std::vector<uint64_t> offsets;
+    for (int r = r0; r <= r1; r++) {
+      for (int c = 1; c <= 6; c++) {
+        a.push_back(value(r, c));
+        offsets.push_back(s.size());
+        s += str(r, c);
+      }
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({r0, r1, 1, 6})
+        .set_data_buffer("a", a)
+        .set_data_buffer("s", s)
+        .set_offsets_buffer("s", offsets);
+    set_fragment_part(ctx, query, uri, part);
+    query.submit();
+    array.close();
+  };
+
+  auto fragment_num = [&]() {
+    FragmentInfo fragment_info(ctx, array_name);
+    fragment_info.load();
+    return fragment_info.fragment_num();
+  };
+
+  SECTION("- Concurrent writers") {
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    auto uri = new_fragment_parts_uri(ctx, array_w);
+
+    // The parts are numbered independently of their position
+    std::vector<std::thread> writers;
+    writers.emplace_back([&]() { write_part(uri, 2, 1, 2); });
+    writers.emplace_back([&]() { write_part(uri, 0, 3, 6); });
+    writers.emplace_back([&]() { write_part(uri, 1, 7, 8); });
+    for (auto& writer : writers)
+      writer.join();
+
+    // The fragment is only visible once committed
+    CHECK(fragment_num() == 0);
+    commit_fragment_parts(ctx, array_w, uri);
+    array_w.close();
+    CHECK(fragment_num() == 1);
+
+    Array array(ctx, array_name, TILEDB_READ);
+    std::vector<int> a(48);
+    std::string s(48 * 3, '\0');
+    std::vector<uint64_t> offsets(48);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, 8, 1, 6})
+        .set_data_buffer("a", a)
+        .set_data_buffer("s", s)
+        .set_offsets_buffer("s", offsets);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result = query.result_buffer_elements();
+    REQUIRE(result["a"].second == 48);
+    REQUIRE(result["s"].first == 48);
+    for (int r = 1; r <= 8; r++) {
+      for (int c = 1; c <= 6; c++) {
+        auto i = (r - 1) * 6 + (c - 1);
+        CHECK(a[i] == value(r, c));
+        auto end = i + 1 < 48 ? offsets[i + 1] : result["s"].second;
+        CHECK(s.substr(offsets[i], end - offsets[i]) == str(r, c));
+      }
+    }
+    array.close();
+  }
+
+  SECTION("- Errors") {
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    auto uri = new_fragment_parts_uri(ctx, array_w);
+
+    // No parts were written
+    CHECK_THROWS(commit_fragment_parts(ctx, array_w, uri));
+
+    // A part is written once
+    write_part(uri, 0, 1, 3);
+    CHECK_THROWS(write_part(uri, 0, 1, 3));
+
+    // The first part does not end on a tile boundary
+    write_part(uri, 1, 4, 8);
+    CHECK_THROWS(commit_fragment_parts(ctx, array_w, uri));
+    CHECK(fragment_num() == 0);
+
+    // Only dense writes are written in parts
+    Array array_r(ctx, array_name, TILEDB_READ);
+    Query query_r(ctx, array_r);
+    CHECK_THROWS(set_fragment_part(ctx, query_r, uri, 2));
+    array_r.close();
+    array_w.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
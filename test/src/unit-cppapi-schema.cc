@@ -31,6 +31,7 @@
  */
 
 #include "catch.hpp"
+#include "tiledb/sm/c_api/tiledb_serialization.h"
 #include "tiledb/sm/cpp_api/tiledb"
 #include "tiledb/sm/cpp_api/tiledb_experimental"
 #include "tiledb/sm/misc/constants.h"
@@ -660,4 +661,160 @@ TEST_CASE(
   if (vfs.is_dir(array_uri)) {
     vfs.remove_dir(array_uri);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE(
+    "C++ API: Schema with attribute groups", "[cppapi][schema][attr-group]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_uri = "cpp_unit_array_attr_group";
+  if (vfs.is_dir(array_uri))
+    vfs.remove_dir(array_uri);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int>(ctx, "a1"))
+      .add_attribute(Attribute::create<float>(ctx, "a2"))
+      .add_attribute(Attribute::create<int64_t>(ctx, "a3"))
+      .add_attribute(Attribute::create<std::string>(ctx, "v"));
+
+  // Invalid groups
+  CHECK_THROWS(schema.add_attribute_group({"a1"}));
+  CHECK_THROWS(schema.add_attribute_group({"a1", "foo"}));
+  CHECK_THROWS(schema.add_attribute_group({"a1", "v"}));
+  CHECK_THROWS(schema.add_attribute_group({"a1", "a1"}));
+  CHECK(schema.attribute_group_num() == 0);
+
+  schema.add_attribute_group({"a2", "a1"});
+  CHECK(schema.attribute_group_num() == 1);
+  CHECK_THROWS(schema.add_attribute_group({"a1", "a3"}));
+  Array::create(array_uri, schema);
+
+  // Write cells over several data tiles
+  std::vector<int> d, a1;
+  std::vector<float> a2;
+  std::vector<int64_t> a3;
+  std::string v;
+  std::vector<uint64_t> v_offsets;
+  for (int i = 1; i <= 10; i++) {
+    d.push_back(i * 3);
+    a1.push_back(i);
+    a2.push_back(i / 2.0f);
+    a3.push_back(i * 100);
+    v_offsets.push_back(v.size());
+    v += std::string(i, 'x');
+  }
+  Array array_w(ctx, array_uri, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_data_buffer("d", d)
+      .set_data_buffer("a1", a1)
+      .set_data_buffer("a2", a2)
+      .set_data_buffer("a3", a3)
+      .set_data_buffer("v", v)
+      .set_offsets_buffer("v", v_offsets);
+  query_w.submit();
+  array_w.close();
+
+  // The grouped attributes share one file
+  FragmentInfo fragment_info(ctx, array_uri);
+  fragment_info.load();
+  REQUIRE(fragment_info.fragment_num() == 1);
+  auto fragment_uri = fragment_info.fragment_uri(0);
+  CHECK(vfs.is_file(fragment_uri + "/g0.tdb"));
+  CHECK(!vfs.is_file(fragment_uri + "/a0.tdb"));
+  CHECK(!vfs.is_file(fragment_uri + "/a1.tdb"));
+  CHECK(vfs.is_file(fragment_uri + "/a2.tdb"));
+
+  Array array(ctx, array_uri, TILEDB_READ);
+  CHECK(array.schema().attribute_group_num() == 1);
+
+  SECTION("Read one grouped attribute") {
+    std::vector<float> a2_r(10);
+    Query query(ctx, array, TILEDB_READ);
+    query.set_layout(TILEDB_GLOBAL_ORDER).set_data_buffer("a2", a2_r);
+    query.submit();
+    CHECK(query.result_buffer_elements()["a2"].second == 10);
+    CHECK_THAT(a2_r, Catch::Matchers::Equals(a2));
+  }
+
+  SECTION("Read all attributes") {
+    std::vector<int> d_r(10), a1_r(10);
+    std::vector<float> a2_r(10);
+    std::vector<int64_t> a3_r(10);
+    std::string v_r(v.size(), 0);
+    std::vector<uint64_t> v_offsets_r(10);
+    Query query(ctx, array, TILEDB_READ);
+    query.set_layout(TILEDB_GLOBAL_ORDER)
+        .set_data_buffer("d", d_r)
+        .set_data_buffer("a1", a1_r)
+        .set_data_buffer("a2", a2_r)
+        .set_data_buffer("a3", a3_r)
+        .set_data_buffer("v", v_r)
+        .set_offsets_buffer("v", v_offsets_r);
+    query.submit();
+    CHECK(query.result_buffer_elements()["a1"].second == 10);
+    CHECK_THAT(d_r, Catch::Matchers::Equals(d));
+    CHECK_THAT(a1_r, Catch::Matchers::Equals(a1));
+    CHECK_THAT(a2_r, Catch::Matchers::Equals(a2));
+    CHECK_THAT(a3_r, Catch::Matchers::Equals(a3));
+    CHECK(v_r == v);
+  }
+
+  array.close();
+  if (vfs.is_dir(array_uri))
+    vfs.remove_dir(array_uri);
+}
+
+#ifdef TILEDB_SERIALIZATION
+TEST_CASE(
+    "C++ API: Schema with attribute groups serialization",
+    "[cppapi][schema][attr-group][serialization]") {
+  using namespace tiledb;
+  tiledb_serialization_type_t format = TILEDB_JSON;
+  SECTION("- json") {
+    format = TILEDB_JSON;
+  }
+
+  SECTION("- capnp") {
+    format = TILEDB_CAPNP;
+  }
+
+  Context ctx;
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int>(ctx, "a1"))
+      .add_attribute(Attribute::create<float>(ctx, "a2"));
+
+  // Without groups, the schema round-trips.
+  tiledb_buffer_t* buff;
+  REQUIRE(
+      tiledb_serialize_array_schema(
+          ctx.ptr().get(), schema.ptr().get(), format, 1, &buff) ==
+      TILEDB_OK);
+  tiledb_array_schema_t* schema_r_ptr;
+  REQUIRE(
+      tiledb_deserialize_array_schema(
+          ctx.ptr().get(), buff, format, 0, &schema_r_ptr) == TILEDB_OK);
+  tiledb_buffer_free(&buff);
+  ArraySchema schema_r(ctx, schema_r_ptr);
+  CHECK(schema_r.attribute_num() == 2);
+  CHECK(schema_r.attribute_group_num() == 0);
+
+  // Remote arrays do not support attribute groups.
+  schema.add_attribute_group({"a1", "a2"});
+  CHECK(
+      tiledb_serialize_array_schema(
+          ctx.ptr().get(), schema.ptr().get(), format, 1, &buff) ==
+      TILEDB_ERR);
+  CHECK(
+      tiledb_serialize_array_schema(
+          ctx.ptr().get(), schema.ptr().get(), format, 0, &buff) ==
+      TILEDB_ERR);
+}
+#endif
@@ -1063,4 +1063,79 @@ TEST_CASE(
 
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
-}
\ No newline at end of file
+}
+TEST_CASE(
+    "C++ API: Test subarray label ranges", "[cppapi][dense][subarray][label]") {
+  const std::string array_name = "cpp_unit_array";
+  const std::string label_name = array_name + "/__labels/t";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a dense array, and the label array of its dimension, where the
+  // label of index `i` is `i / 2.0`.
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "t", {{0, 999}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  ArraySchema label_schema(ctx, TILEDB_DENSE);
+  label_schema.set_domain(domain).add_attribute(
+      Attribute::create<double>(ctx, "label"));
+  Array::create(label_name, label_schema);
+
+  std::vector<int32_t> a(1000);
+  std::vector<double> labels(1000);
+  for (int32_t i = 0; i < 1000; i++) {
+    a[i] = i;
+    labels[i] = i / 2.0;
+  }
+
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_ROW_MAJOR).set_data_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array label_w(ctx, label_name, TILEDB_WRITE);
+  Query label_query_w(ctx, label_w, TILEDB_WRITE);
+  label_query_w.set_layout(TILEDB_ROW_MAJOR).set_data_buffer("label", labels);
+  REQUIRE(label_query_w.submit() == Query::Status::COMPLETE);
+  label_w.close();
+
+  // The labels within [100.2, 200] are those of the indices [201, 400].
+  Array array(ctx, array_name, TILEDB_READ);
+  Subarray subarray(ctx, array);
+  subarray.add_label_range<double>(0, 100.2, 200.0);
+  auto range = subarray.range<int32_t>(0, 0);
+  CHECK(range[0] == 201);
+  CHECK(range[1] == 400);
+
+  std::vector<int32_t> a_read(200);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray(subarray)
+      .set_data_buffer("a", a_read);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(a_read.front() == 201);
+  CHECK(a_read.back() == 400);
+
+  // The bounds of the labels are included.
+  Subarray bounds(ctx, array);
+  bounds.add_label_range<double>(0, 0.0, 499.5);
+  range = bounds.range<int32_t>(0, 0);
+  CHECK(range[0] == 0);
+  CHECK(range[1] == 999);
+
+  // No label is within the range.
+  Subarray empty(ctx, array);
+  CHECK_THROWS(empty.add_label_range<double>(0, 500.0, 600.0));
+  CHECK_THROWS(empty.add_label_range<double>(0, 10.2, 10.3));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
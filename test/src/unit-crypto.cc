@@ -207,6 +207,68 @@ TEST_CASE("Crypto: Test AES-256-GCM", "[crypto][aes]") {
     }
   }
 
+  SECTION("- Alternating keys") {
+    unsigned nelts = 123;
+    Buffer input;
+    REQUIRE(input.realloc(123 * sizeof(unsigned)).ok());
+    for (unsigned i = 0; i < nelts; i++)
+      REQUIRE(input.write(&i, sizeof(unsigned)).ok());
+    ConstBuffer input_cb(&input);
+
+    // Set up two keys
+    char key_bytes[] = "0123456789abcdeF0123456789abcdeF";
+    char key2_bytes[] = "F0123456789abcdeF0123456789abcde";
+    ConstBuffer key(key_bytes, sizeof(key_bytes) - 1);  // -1 to ignore NUL
+    ConstBuffer key2(key2_bytes, sizeof(key2_bytes) - 1);
+
+    // Encrypt with each key in turn, on the same thread.
+    Buffer encrypted, encrypted2;
+    char tag_array[16], iv_array[12], tag2_array[16], iv2_array[12];
+    PreallocatedBuffer output_iv(&iv_array[0], sizeof(iv_array));
+    PreallocatedBuffer output_tag(&tag_array[0], sizeof(tag_array));
+    PreallocatedBuffer output_iv2(&iv2_array[0], sizeof(iv2_array));
+    PreallocatedBuffer output_tag2(&tag2_array[0], sizeof(tag2_array));
+    CHECK(Crypto::encrypt_aes256gcm(
+              &key, nullptr, &input_cb, &encrypted, &output_iv, &output_tag)
+              .ok());
+    CHECK(Crypto::encrypt_aes256gcm(
+              &key2, nullptr, &input_cb, &encrypted2, &output_iv2, &output_tag2)
+              .ok());
+
+    // Check decryption with the other key fails.
+    Buffer decrypted;
+    ConstBuffer iv(output_iv.data(), output_iv.size());
+    ConstBuffer tag(output_tag.data(), output_tag.size());
+    ConstBuffer encrypted_cb(&encrypted);
+    CHECK(
+        !Crypto::decrypt_aes256gcm(&key2, &iv, &tag, &encrypted_cb, &decrypted)
+             .ok());
+
+    // Check decryption with the right keys, in both orders.
+    ConstBuffer iv2(output_iv2.data(), output_iv2.size());
+    ConstBuffer tag2(output_tag2.data(), output_tag2.size());
+    ConstBuffer encrypted2_cb(&encrypted2);
+    for (int pass = 0; pass < 2; pass++) {
+      decrypted.reset_offset();
+      decrypted.reset_size();
+      CHECK(
+          Crypto::decrypt_aes256gcm(&key, &iv, &tag, &encrypted_cb, &decrypted)
+              .ok());
+      CHECK(decrypted.size() == input.size());
+      for (unsigned i = 0; i < nelts; i++)
+        REQUIRE(decrypted.value<unsigned>(i * sizeof(unsigned)) == i);
+
+      decrypted.reset_offset();
+      decrypted.reset_size();
+      CHECK(Crypto::decrypt_aes256gcm(
+                &key2, &iv2, &tag2, &encrypted2_cb, &decrypted)
+                .ok());
+      CHECK(decrypted.size() == input.size());
+      for (unsigned i = 0; i < nelts; i++)
+        REQUIRE(decrypted.value<unsigned>(i * sizeof(unsigned)) == i);
+    }
+  }
+
   SECTION("- NIST test vectors") {
     // From:
     // https://csrc.nist.gov/Projects/Cryptographic-Algorithm-Validation-Program/CAVP-TESTING-BLOCK-CIPHER-MODES#GCMVS
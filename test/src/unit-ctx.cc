@@ -94,4 +94,36 @@ TEST_CASE("C++ API: Test context tags", "[cppapi][ctx-tags]") {
   REQUIRE_NOTHROW(ctx.set_tag("tag1", "value3"));
   REQUIRE(sm->tags().size() == 4);
   REQUIRE(sm->tags().at("tag1") == "value3");
-}
\ No newline at end of file
+}
+TEST_CASE("C++ API: Test shared resources", "[cppapi][ctx-shared]") {
+  tiledb::Config config;
+  config["sm.compute_concurrency_level"] = "3";
+  config["sm.io_concurrency_level"] = "3";
+
+  // Without the option, every context has its own thread pools.
+  {
+    tiledb::Context ctx1(config);
+    tiledb::Context ctx2(config);
+    auto sm_ctx1 = ctx1.ptr().get()->ctx_;
+    auto sm_ctx2 = ctx2.ptr().get()->ctx_;
+    CHECK(sm_ctx1->compute_tp() != sm_ctx2->compute_tp());
+    CHECK(sm_ctx1->io_tp() != sm_ctx2->io_tp());
+  }
+
+  // With it, the contexts with the same configuration share them.
+  config["sm.shared_resources"] = "true";
+  tiledb::Context ctx1(config);
+  tiledb::Context ctx2(config);
+  auto sm_ctx1 = ctx1.ptr().get()->ctx_;
+  auto sm_ctx2 = ctx2.ptr().get()->ctx_;
+  CHECK(sm_ctx1->compute_tp() == sm_ctx2->compute_tp());
+  CHECK(sm_ctx1->io_tp() == sm_ctx2->io_tp());
+  CHECK(sm_ctx1->compute_tp() != sm_ctx1->io_tp());
+  CHECK(sm_ctx1->stats() != sm_ctx2->stats());
+
+  config["sm.compute_concurrency_level"] = "2";
+  tiledb::Context ctx3(config);
+  auto sm_ctx3 = ctx3.ptr().get()->ctx_;
+  CHECK(sm_ctx1->compute_tp() != sm_ctx3->compute_tp());
+  CHECK(sm_ctx1->io_tp() == sm_ctx3->io_tp());
+}
@@ -0,0 +1,126 @@
+/**
+ * @file   unit-disk-cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `DiskCache` class.
+ */
+
+#include <catch.hpp>
+#include "tiledb/sm/filesystem/disk_cache.h"
+#include "tiledb/sm/filesystem/uri.h"
+
+#ifndef _WIN32
+#include "tiledb/sm/filesystem/posix.h"
+#endif
+
+#include <cstring>
+#include <vector>
+
+using namespace tiledb::sm;
+
+#ifndef _WIN32
+
+TEST_CASE("DiskCache: Test cacheable URIs", "[disk-cache]") {
+  CHECK(DiskCache::cacheable(
+      URI("s3://bucket/array/__1_1_0123456789abcdef/a0.tdb")));
+  CHECK(DiskCache::cacheable(URI("s3://bucket/array/__meta/__1_1_0123")));
+  CHECK(DiskCache::cacheable(
+      URI("s3://bucket/array/__schema/__1_1_0123456789abcdef")));
+  CHECK(!DiskCache::cacheable(URI("s3://bucket/array/__array_schema.tdb")));
+  CHECK(!DiskCache::cacheable(URI("s3://bucket/array/__lock.tdb")));
+}
+
+TEST_CASE("DiskCache: Test read and write", "[disk-cache]") {
+  Posix posix;
+  const std::string dir = Posix::current_dir() + "/disk_cache_unit_test";
+  if (posix.is_dir(dir))
+    REQUIRE(posix.remove_dir(dir).ok());
+
+  const uint64_t nbytes = 1000;
+  std::vector<char> data(nbytes), read(nbytes);
+  for (uint64_t i = 0; i < nbytes; i++)
+    data[i] = static_cast<char>(i);
+  URI uri("s3://bucket/array/__1_1_0123456789abcdef/a0.tdb");
+  bool hit = true;
+
+  SECTION("- Hits and misses") {
+    DiskCache cache;
+    REQUIRE(!cache.enabled());
+    REQUIRE(cache.init(dir + "/nested", 1 << 20).ok());
+    REQUIRE(cache.enabled());
+
+    REQUIRE(cache.read(uri, 0, read.data(), nbytes, &hit).ok());
+    CHECK(!hit);
+    REQUIRE(cache.write(uri, 0, data.data(), nbytes).ok());
+    REQUIRE(cache.read(uri, 0, read.data(), nbytes, &hit).ok());
+    CHECK(hit);
+    CHECK(read == data);
+
+    // Other ranges and other objects are misses.
+    REQUIRE(cache.read(uri, 1, read.data(), nbytes, &hit).ok());
+    CHECK(!hit);
+    REQUIRE(cache.read(uri, 0, read.data(), nbytes - 1, &hit).ok());
+    CHECK(!hit);
+    URI other("s3://bucket/array/__1_1_0123456789abcdef/a1.tdb");
+    REQUIRE(cache.read(other, 0, read.data(), nbytes, &hit).ok());
+    CHECK(!hit);
+
+    // The entries persist for another cache on the same directory.
+    DiskCache cache2;
+    REQUIRE(cache2.init(dir + "/nested", 1 << 20).ok());
+    std::memset(read.data(), 0, nbytes);
+    REQUIRE(cache2.read(uri, 0, read.data(), nbytes, &hit).ok());
+    CHECK(hit);
+    CHECK(read == data);
+  }
+
+  SECTION("- Eviction") {
+    // Room for two entries only.
+    DiskCache cache;
+    REQUIRE(cache.init(dir, 2 * (nbytes + 100)).ok());
+    for (uint64_t i = 0; i < 3; i++)
+      REQUIRE(cache.write(uri, i * nbytes, data.data(), nbytes).ok());
+
+    uint64_t hits = 0;
+    for (uint64_t i = 0; i < 3; i++) {
+      REQUIRE(cache.read(uri, i * nbytes, read.data(), nbytes, &hit).ok());
+      hits += hit;
+    }
+    CHECK(hits == 2);
+
+    // Larger than the cache.
+    std::vector<char> big(4 * nbytes);
+    REQUIRE(cache.write(uri, 0, big.data(), big.size()).ok());
+    REQUIRE(cache.read(uri, 0, big.data(), big.size(), &hit).ok());
+    CHECK(!hit);
+  }
+
+  REQUIRE(posix.remove_dir(dir).ok());
+}
+
+#endif
@@ -396,6 +396,37 @@ TEST_CASE("FilterBuffer: Test view reclaim", "[filter][filter-buffer]") {
   CHECK(storage.num_in_use() == 0);
 }
 
+TEST_CASE(
+    "FilterBuffer: Test reclaim of destroyed buffers",
+    "[filter][filter-buffer]") {
+  FilterStorage storage;
+  storage.set_max_retained_size(64);
+
+  {
+    FilterBuffer fbuf(&storage), fbuf2(&storage);
+    CHECK(fbuf.prepend_buffer(sizeof(uint64_t)).ok());
+    CHECK(fbuf2.prepend_buffer(128).ok());
+    CHECK(storage.num_in_use() == 2);
+    CHECK(storage.allocated_size() == sizeof(uint64_t) + 128);
+
+    // Nothing to reclaim while the filter buffers reference the buffers.
+    storage.reclaim_unused();
+    CHECK(storage.num_available() == 0);
+    CHECK(storage.num_in_use() == 2);
+  }
+
+  // The small buffer is kept for reuse, the large one is freed.
+  storage.reclaim_unused();
+  CHECK(storage.num_available() == 1);
+  CHECK(storage.num_in_use() == 0);
+  CHECK(storage.allocated_size() == sizeof(uint64_t));
+
+  FilterBuffer fbuf(&storage);
+  CHECK(fbuf.prepend_buffer(sizeof(uint64_t)).ok());
+  CHECK(storage.num_available() == 0);
+  CHECK(storage.num_in_use() == 1);
+}
+
 TEST_CASE("FilterBuffer: Test fixed allocation", "[filter][filter-buffer]") {
   FilterStorage storage;
   FilterBuffer fbuf(&storage);
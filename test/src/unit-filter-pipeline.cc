@@ -36,25 +36,36 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/compressors/gzip_compressor.h"
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/crypto/encryption_key.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/enums/filter_option.h"
 #include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/auto_compression_filter.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
+#include "tiledb/sm/filter/bitmap_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
 #include "tiledb/sm/filter/checksum_md5_filter.h"
 #include "tiledb/sm/filter/checksum_sha256_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
+#include "tiledb/sm/filter/filter_create.h"
+#include "tiledb/sm/filter/float_xor_filter.h"
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/filter/positive_delta_filter.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <atomic>
 #include <catch.hpp>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <random>
 
@@ -2499,6 +2510,7 @@ TEST_CASE("Filter: Test random pipeline", "[filter][random]") {
       []() { return new PseudoChecksumFilter(); },
       []() { return new ChecksumMD5Filter(); },
       []() { return new ChecksumSHA256Filter(); },
+      []() { return new ChecksumCRC32CFilter(); },
       [&encryption_key]() {
         return new EncryptionAES256GCMFilter(encryption_key);
       },
@@ -3810,6 +3822,324 @@ TEST_CASE("Filter: Test byteshuffle var", "[filter][byteshuffle][var]") {
   Tile::set_max_tile_chunk_size(constants::max_tile_chunk_size);
 }
 
+TEST_CASE("Filter: Test dictionary", "[filter][dictionary]") {
+  tiledb::sm::Config config;
+
+  const uint64_t nelts = 1000;
+  const uint64_t tile_size = nelts * sizeof(uint64_t);
+  const uint64_t cell_size = sizeof(uint64_t);
+  const uint32_t dim_num = 0;
+
+  // Set up test data, with few distinct values or with all distinct values.
+  uint64_t distinct = 0;
+  SECTION("- Few distinct values") {
+    distinct = 5;
+  }
+  SECTION("- One distinct value") {
+    distinct = 1;
+  }
+  SECTION("- All distinct values") {
+    distinct = nelts;
+  }
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      tile_size,
+      cell_size,
+      dim_num);
+  for (uint64_t i = 0; i < nelts; i++) {
+    uint64_t val = (i * 7) % distinct;
+    CHECK(tile.write(&val, i * sizeof(uint64_t), sizeof(uint64_t)).ok());
+  }
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(DictionaryFilter()).ok());
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  if (distinct == nelts)
+    CHECK(tile.filtered_buffer().size() > tile_size);
+  else
+    CHECK(tile.filtered_buffer().size() < tile_size / 8);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  for (uint64_t i = 0; i < nelts; i++) {
+    uint64_t elt = 0;
+    CHECK(tile.read(&elt, i * sizeof(uint64_t), sizeof(uint64_t)).ok());
+    CHECK(elt == (i * 7) % distinct);
+  }
+}
+
+TEST_CASE("Filter: Test dictionary var", "[filter][dictionary][var]") {
+  tiledb::sm::Config config;
+  const uint32_t dim_num = 0;
+
+  // Set up test data: strings from a small set, including empty strings.
+  const std::vector<std::string> words{"US", "", "FR", "GREECE", "JP", "DE"};
+  const uint64_t cell_num = 2000;
+  std::string data;
+  std::vector<uint64_t> offsets(cell_num);
+  for (uint64_t i = 0; i < cell_num; i++) {
+    offsets[i] = data.size();
+    data += words[(i * i) % words.size()];
+  }
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::STRING_ASCII,
+      data.size(),
+      datatype_size(Datatype::STRING_ASCII),
+      dim_num);
+  CHECK(tile.write(data.data(), 0, data.size()).ok());
+
+  Tile offsets_tile;
+  offsets_tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      cell_num * constants::cell_var_offset_size,
+      constants::cell_var_offset_size,
+      dim_num);
+  CHECK(offsets_tile
+            .write(
+                offsets.data(), 0, cell_num * constants::cell_var_offset_size)
+            .ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(DictionaryFilter()).ok());
+
+  SECTION("- Single stage") {
+    Tile::set_max_tile_chunk_size(1000);
+  }
+
+  SECTION("- With compression") {
+    Tile::set_max_tile_chunk_size(1000);
+    CHECK(pipeline.add_filter(CompressionFilter(tiledb::sm::Compressor::LZ4, 1))
+              .ok());
+  }
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, &offsets_tile, &tp)
+            .ok());
+  CHECK(tile.size() == 0);
+  CHECK(tile.filtered_buffer().size() < data.size() / 2);
+
+  CHECK(tile.alloc_data(data.size()).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  std::string decoded(data.size(), '\0');
+  CHECK(tile.read(&decoded[0], 0, data.size()).ok());
+  CHECK(decoded == data);
+
+  Tile::set_max_tile_chunk_size(constants::max_tile_chunk_size);
+}
+
+TEST_CASE(
+    "Filter: Test frame of reference",
+    "[filter][frame-of-reference]") {
+  tiledb::sm::Config config;
+
+  // Use a count that does not fill the last block.
+  const uint64_t nelts = 1000;
+  const uint64_t tile_size = nelts * sizeof(int64_t);
+  const uint64_t cell_size = sizeof(int64_t);
+  const uint32_t dim_num = 0;
+
+  std::vector<int64_t> data(nelts);
+  SECTION("- Constant values") {
+    std::fill(data.begin(), data.end(), -123456789);
+  }
+  SECTION("- Small range of negative values") {
+    for (uint64_t i = 0; i < nelts; i++)
+      data[i] = -1000000 + (int64_t)((i * 37) % 100);
+  }
+  SECTION("- Small range with outliers") {
+    for (uint64_t i = 0; i < nelts; i++)
+      data[i] = i % 50 == 0 ? std::numeric_limits<int64_t>::max() - (int64_t)i :
+                              (int64_t)(i % 16);
+  }
+  SECTION("- Full range") {
+    for (uint64_t i = 0; i < nelts; i++)
+      data[i] = i % 2 == 0 ? std::numeric_limits<int64_t>::lowest() :
+                             std::numeric_limits<int64_t>::max();
+  }
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::INT64,
+      tile_size,
+      cell_size,
+      dim_num);
+  CHECK(tile.write(data.data(), 0, tile_size).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(FrameOfReferenceFilter()).ok());
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  if (data[0] == data[1])
+    CHECK(tile.filtered_buffer().size() < tile_size / 10);
+  else if (data[1] == -1000000 + 37)
+    CHECK(tile.filtered_buffer().size() < tile_size / 4);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  for (uint64_t i = 0; i < nelts; i++) {
+    int64_t elt = 0;
+    CHECK(tile.read(&elt, i * sizeof(int64_t), sizeof(int64_t)).ok());
+    CHECK(elt == data[i]);
+  }
+}
+
+TEST_CASE(
+    "Filter: Test frame of reference on offsets",
+    "[filter][frame-of-reference]") {
+  tiledb::sm::Config config;
+
+  const uint64_t nelts = 1024;
+  const uint64_t tile_size = nelts * constants::cell_var_offset_size;
+  const uint32_t dim_num = 0;
+
+  // Offsets of cells of 0 to 9 bytes.
+  std::vector<uint64_t> offsets(nelts);
+  for (uint64_t i = 1; i < nelts; i++)
+    offsets[i] = offsets[i - 1] + (i * 7) % 10;
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      tile_size,
+      constants::cell_var_offset_size,
+      dim_num);
+  CHECK(tile.write(offsets.data(), 0, tile_size).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(FrameOfReferenceFilter()).ok());
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  CHECK(tile.filtered_buffer().size() < tile_size / 4);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  for (uint64_t i = 0; i < nelts; i++) {
+    uint64_t elt = 0;
+    CHECK(tile.read(&elt, i * sizeof(uint64_t), sizeof(uint64_t)).ok());
+    CHECK(elt == offsets[i]);
+  }
+}
+
+template <typename T>
+void check_float_xor(Datatype type) {
+  tiledb::sm::Config config;
+
+  const uint64_t nelts = 1000;
+  const uint64_t tile_size = nelts * sizeof(T);
+  const uint32_t dim_num = 0;
+
+  // A slowly varying series with repeated values, and a few special values.
+  std::vector<T> data(nelts);
+  for (uint64_t i = 0; i < nelts; i++)
+    data[i] = (T)(20 + (i / 10 % 16) * 0.25);
+  data[10] = std::numeric_limits<T>::infinity();
+  data[11] = -std::numeric_limits<T>::infinity();
+  data[12] = std::numeric_limits<T>::quiet_NaN();
+  data[13] = -0.0;
+  data[14] = std::numeric_limits<T>::denorm_min();
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version, type, tile_size, sizeof(T), dim_num);
+  CHECK(tile.write(data.data(), 0, tile_size).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(FloatXorFilter()).ok());
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  CHECK(tile.filtered_buffer().size() < tile_size / 4);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  std::vector<T> decoded(nelts);
+  CHECK(tile.read(decoded.data(), 0, tile_size).ok());
+  CHECK(std::memcmp(decoded.data(), data.data(), tile_size) == 0);
+}
+
+TEST_CASE("Filter: Test float XOR", "[filter][float-xor]") {
+  SECTION("- float32") {
+    check_float_xor<float>(Datatype::FLOAT32);
+  }
+  SECTION("- float64") {
+    check_float_xor<double>(Datatype::FLOAT64);
+  }
+}
+
+TEST_CASE("Filter: Test bitmap", "[filter][bitmap]") {
+  tiledb::sm::Config config;
+
+  // A validity byte map with a size that is not a multiple of 8.
+  const uint64_t nelts = 1001;
+  std::vector<uint8_t> data(nelts);
+  for (uint64_t i = 0; i < nelts; i++)
+    data[i] = (i % 3 == 0 || i % 7 == 0) ? 1 : 0;
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      constants::cell_validity_type,
+      nelts,
+      constants::cell_validity_size,
+      0);
+  CHECK(tile.write(data.data(), 0, nelts).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(BitmapFilter()).ok());
+
+  SECTION("- byte map") {
+    CHECK(
+        pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+    CHECK(tile.size() == 0);
+    CHECK(tile.filtered_buffer().size() < nelts / 4);
+  }
+
+  SECTION("- not a byte map") {
+    data[500] = 2;
+    CHECK(tile.write(data.data(), 0, nelts).ok());
+    CHECK(
+        pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+    CHECK(tile.size() == 0);
+    CHECK(tile.filtered_buffer().size() > nelts);
+  }
+
+  CHECK(tile.alloc_data(nelts).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  std::vector<uint8_t> decoded(nelts);
+  CHECK(tile.read(decoded.data(), 0, nelts).ok());
+  CHECK(decoded == data);
+}
+
 TEST_CASE("Filter: Test encryption", "[filter][encryption]") {
   tiledb::sm::Config config;
 
@@ -3887,3 +4217,233 @@ TEST_CASE("Filter: Test encryption", "[filter][encryption]") {
     }
   }
 }
+
+TEST_CASE("Filter: Test auto compression", "[filter][auto-compression]") {
+  tiledb::sm::Config config;
+
+  const uint64_t nelts = 100000;
+  const uint64_t tile_size = nelts * sizeof(uint64_t);
+  const uint32_t dim_num = 0;
+
+  std::vector<uint64_t> data(nelts);
+  bool compressible = true;
+  SECTION("- Increasing sequence") {
+    for (uint64_t i = 0; i < nelts; i++)
+      data[i] = 1000 + i * 3;
+  }
+
+  SECTION("- Random values") {
+    std::mt19937_64 gen(0xdeadbeef);
+    for (uint64_t i = 0; i < nelts; i++)
+      data[i] = gen();
+    compressible = false;
+  }
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      tile_size,
+      sizeof(uint64_t),
+      dim_num);
+  CHECK(tile.write(data.data(), 0, tile_size).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(AutoCompressionFilter()).ok());
+
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  if (compressible)
+    CHECK(tile.filtered_buffer().size() < tile_size / 10);
+  else
+    CHECK(tile.filtered_buffer().size() < tile_size + 1024);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(tile.filtered_buffer().size() == 0);
+  std::vector<uint64_t> decoded(nelts);
+  CHECK(tile.read(decoded.data(), 0, tile_size).ok());
+  CHECK(decoded == data);
+}
+
+TEST_CASE(
+    "Filter: Test auto compression speed bias option",
+    "[filter][auto-compression]") {
+  AutoCompressionFilter filter;
+  uint32_t speed_bias = 0;
+  CHECK(filter
+            .get_option(FilterOption::AUTO_COMPRESSION_SPEED_BIAS, &speed_bias)
+            .ok());
+  CHECK(speed_bias == AutoCompressionFilter::DEFAULT_SPEED_BIAS);
+
+  speed_bias = 80;
+  CHECK(filter
+            .set_option(FilterOption::AUTO_COMPRESSION_SPEED_BIAS, &speed_bias)
+            .ok());
+  CHECK(filter.speed_bias() == 80);
+
+  speed_bias = 101;
+  CHECK(
+      !filter.set_option(FilterOption::AUTO_COMPRESSION_SPEED_BIAS, &speed_bias)
+           .ok());
+  CHECK(filter.speed_bias() == 80);
+}
+
+/**
+ * A GZip accelerator backend that completes every other part of a batch
+ * with the CPU compressor, leaving the others to the fallback.
+ */
+class TestGZipAccelerator : public CodecAccelerator {
+ public:
+  bool claims(tiledb::sm::Compressor compressor, int) const override {
+    return compressor == tiledb::sm::Compressor::GZIP;
+  }
+
+  std::future<void> compress(
+      const Codec& codec, std::vector<Job>& jobs) override {
+    batches_++;
+    return std::async(std::launch::async, [&codec, &jobs]() {
+      for (size_t i = 0; i < jobs.size(); i += 2) {
+        ConstBuffer input(jobs[i].input_, jobs[i].input_size_);
+        Buffer output;
+        if (GZip::compress(codec.level_, &input, &output).ok() &&
+            output.size() <= jobs[i].output_size_) {
+          std::memcpy(jobs[i].output_, output.data(), output.size());
+          jobs[i].output_size_ = output.size();
+          jobs[i].done_ = true;
+        }
+      }
+    });
+  }
+
+  std::future<void> decompress(const Codec&, std::vector<Job>& jobs) override {
+    batches_++;
+    return std::async(std::launch::async, [&jobs]() {
+      for (size_t i = 0; i < jobs.size(); i += 2) {
+        ConstBuffer input(jobs[i].input_, jobs[i].input_size_);
+        PreallocatedBuffer output(jobs[i].output_, jobs[i].output_size_);
+        jobs[i].done_ = GZip::decompress(&input, &output).ok();
+      }
+    });
+  }
+
+  std::atomic<uint64_t> batches_ = 0;
+};
+
+TEST_CASE("Filter: Test accelerated compression", "[filter][accelerator]") {
+  tiledb::sm::Config config;
+
+  const uint64_t nelts = 100000;
+  const uint64_t tile_size = nelts * sizeof(uint64_t);
+  const uint32_t dim_num = 0;
+
+  std::vector<uint64_t> data(nelts);
+  for (uint64_t i = 0; i < nelts; i++)
+    data[i] = i % 1000;
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      tile_size,
+      sizeof(uint64_t),
+      dim_num);
+  CHECK(tile.write(data.data(), 0, tile_size).ok());
+
+  // The backend is attached to the compression filters made afterwards.
+  auto accelerator = std::make_shared<TestGZipAccelerator>();
+  FilterCreate::register_accelerator(accelerator);
+  tdb_unique_ptr<tiledb::sm::Filter> gzip(
+      FilterCreate::make(FilterType::FILTER_GZIP));
+  tdb_unique_ptr<tiledb::sm::Filter> zstd(
+      FilterCreate::make(FilterType::FILTER_ZSTD));
+  FilterCreate::unregister_accelerator(accelerator.get());
+  CHECK(static_cast<CompressionFilter*>(gzip.get())->offloads());
+  CHECK(!static_cast<CompressionFilter*>(zstd.get())->offloads());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  SECTION("- Compression only") {
+    CHECK(pipeline.add_filter(*gzip).ok());
+  }
+
+  SECTION("- After other filters") {
+    CHECK(pipeline.add_filter(ByteshuffleFilter()).ok());
+    CHECK(pipeline.add_filter(*gzip).ok());
+  }
+
+  // All the chunks are compressed and decompressed in one batch each.
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+  CHECK(tile.filtered_buffer().size() < tile_size / 10);
+  CHECK(accelerator->batches_ == 1);
+
+  CHECK(tile.alloc_data(tile_size).ok());
+  CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  CHECK(accelerator->batches_ == 2);
+  std::vector<uint64_t> decoded(nelts);
+  CHECK(tile.read(decoded.data(), 0, tile_size).ok());
+  CHECK(decoded == data);
+}
+
+TEST_CASE("Filter: Test checksum CRC32C", "[filter][checksum-crc32c]") {
+  // Known answers of the CRC32C (Castagnoli) checksum.
+  const std::string check = "123456789";
+  CHECK(ChecksumCRC32CFilter::crc32c(0, check.data(), check.size()) ==
+        0xE3069283);
+  CHECK(ChecksumCRC32CFilter::crc32c(0, nullptr, 0) == 0);
+  const std::vector<uint8_t> zeros(32, 0);
+  CHECK(ChecksumCRC32CFilter::crc32c(0, zeros.data(), zeros.size()) ==
+        0x8A9136AA);
+
+  // The checksum can be extended.
+  const uint32_t crc = ChecksumCRC32CFilter::crc32c(0, check.data(), 4);
+  CHECK(
+      ChecksumCRC32CFilter::crc32c(crc, check.data() + 4, check.size() - 4) ==
+      0xE3069283);
+
+  tiledb::sm::Config config;
+  const uint64_t nelts = 1000;
+  const uint64_t tile_size = nelts * sizeof(uint64_t);
+  const uint32_t dim_num = 0;
+
+  Tile tile;
+  tile.init_unfiltered(
+      constants::format_version,
+      Datatype::UINT64,
+      tile_size,
+      sizeof(uint64_t),
+      dim_num);
+  for (uint64_t i = 0; i < nelts; i++)
+    CHECK(tile.write(&i, i * sizeof(uint64_t), sizeof(uint64_t)).ok());
+
+  FilterPipeline pipeline;
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+  CHECK(pipeline.run_forward(&test::g_helper_stats, &tile, nullptr, &tp).ok());
+  CHECK(tile.size() == 0);
+
+  SECTION("- Valid data") {
+    CHECK(tile.alloc_data(tile_size).ok());
+    CHECK(pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+    CHECK(tile.filtered_buffer().size() == 0);
+    for (uint64_t i = 0; i < nelts; i++) {
+      uint64_t elt = 0;
+      CHECK(tile.read(&elt, i * sizeof(uint64_t), sizeof(uint64_t)).ok());
+      CHECK(elt == i);
+    }
+  }
+
+  SECTION("- Corrupted data") {
+    // Flip a bit in the last byte of the filtered tile, which is data.
+    auto& filtered = tile.filtered_buffer();
+    filtered.data()[filtered.size() - 1] ^= 1;
+    CHECK(tile.alloc_data(tile_size).ok());
+    CHECK(
+        !pipeline.run_reverse(&test::g_helper_stats, &tile, &tp, config).ok());
+  }
+}
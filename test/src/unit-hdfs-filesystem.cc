@@ -37,8 +37,10 @@
 #include "tiledb/sm/filesystem/hdfs_filesystem.h"
 #include "tiledb/sm/filesystem/uri.h"
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 using namespace tiledb::common;
 using namespace tiledb::sm;
@@ -127,6 +129,33 @@ TEST_CASE("Test HDFS filesystem", "[hdfs]") {
   CHECK(st.ok());
   CHECK(nbytes == buffer_size);
 
+  // Concurrent reads of the file, which each use their own handle
+  URI file_uri("hdfs:///tiledb_test/tiledb_test_file");
+  std::atomic<int> failed(0);
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < 8; t++) {
+    threads.emplace_back([&, t]() {
+      char buffer[26];
+      for (uint64_t r = 0; r < 10; r++) {
+        uint64_t offset = (t * 10 + r) * 1000 + t;
+        if (!hdfs.read(file_uri, offset, buffer, 26).ok() ||
+            buffer[0] != static_cast<char>('a' + offset % 26))
+          ++failed;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  CHECK(failed == 0);
+
+  // Reads after an append see the appended data
+  st = hdfs.write(file_uri, write_buffer, 26);
+  CHECK(st.ok());
+  st = hdfs.read(file_uri, buffer_size, read_buffer, 26);
+  CHECK(st.ok());
+  CHECK(read_buffer[25] == 'z');
+  CHECK(!hdfs.read(file_uri, buffer_size + 1, read_buffer, 26).ok());
+
   st = hdfs.remove_file(URI("hdfs:///tiledb_test/i_dont_exist"));
   CHECK(!st.ok());
 
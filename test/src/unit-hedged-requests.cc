@@ -0,0 +1,77 @@
+/**
+ * @file unit-hedged-requests.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `HedgePolicy` and `HedgeTimer` classes.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "tiledb/sm/misc/hedged_requests.h"
+
+#include <catch.hpp>
+
+using namespace tiledb::sm;
+
+TEST_CASE("HedgePolicy: threshold and cap", "[hedged-requests]") {
+  HedgePolicy policy;
+  CHECK(!policy.enabled());
+
+  policy.init(90, 0.1);
+  REQUIRE(policy.enabled());
+
+  // No hedging until a full window of latencies was observed
+  CHECK(policy.delay_us() == 0);
+  for (uint64_t i = 1; i <= 256; i++)
+    policy.record(i);
+  CHECK(policy.delay_us() == 231);
+
+  // At most 10% of the 256 requests are hedged
+  uint64_t acquired = 0;
+  while (policy.acquire())
+    acquired++;
+  CHECK(acquired == 25);
+
+  policy.init(0, 0.1);
+  CHECK(!policy.enabled());
+}
+
+TEST_CASE("HedgeTimer: run and cancel", "[hedged-requests]") {
+  HedgeTimer timer;
+  std::atomic<int> fired{0};
+
+  timer.schedule(1000, [&fired]() { fired += 1; });
+  auto cancelled = timer.schedule(10000000, [&fired]() { fired += 10; });
+  timer.cancel(cancelled);
+
+  for (int i = 0; i < 1000 && fired == 0; i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CHECK(fired == 1);
+}
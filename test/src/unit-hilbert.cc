@@ -32,6 +32,7 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/misc/hilbert.h"
+#include "tiledb/sm/misc/morton.h"
 
 using namespace tiledb::sm;
 
@@ -89,4 +90,76 @@ TEST_CASE("Hilbert: Test default bits, getter", "[hilbert][bits][getter]") {
   Hilbert h(3);
   CHECK(h.bits() == 21);
   CHECK(h.dim_num() == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Hilbert: Test batch conversion", "[hilbert][batch]") {
+  for (int dim_num = 1; dim_num < Hilbert::HC_MAX_DIM; ++dim_num) {
+    Hilbert h(dim_num);
+    const uint64_t cell_num = 100;
+    const uint64_t max_val = ((uint64_t)1 << h.bits()) - 1;
+
+    // Coordinates stored dimension by dimension.
+    std::vector<uint64_t> coords(dim_num * cell_num);
+    for (uint64_t i = 0; i < coords.size(); ++i)
+      coords[i] = (i * 0x9E3779B97F4A7C15ull) & max_val;
+    std::vector<uint64_t> expected(cell_num);
+    for (uint64_t c = 0; c < cell_num; ++c) {
+      std::vector<uint64_t> cell(dim_num);
+      for (int d = 0; d < dim_num; ++d)
+        cell[d] = coords[d * cell_num + c];
+      expected[c] = h.coords_to_hilbert(&cell[0]);
+    }
+
+    std::vector<uint64_t> values(cell_num);
+    h.coords_to_hilbert(cell_num, &coords[0], &values[0]);
+    CHECK(values == expected);
+  }
+}
+
+TEST_CASE("Morton: Test 2D", "[morton][2D]") {
+  Morton m(2, 2);
+  CHECK(m.bits() == 2);
+  CHECK(m.dim_num() == 2);
+
+  std::vector<uint64_t> coords = {0, 0};
+  CHECK(m.coords_to_morton(&coords[0]) == 0);
+
+  coords = {0, 1};
+  CHECK(m.coords_to_morton(&coords[0]) == 1);
+
+  coords = {1, 0};
+  CHECK(m.coords_to_morton(&coords[0]) == 2);
+
+  coords = {1, 2};
+  CHECK(m.coords_to_morton(&coords[0]) == 6);
+
+  coords = {3, 3};
+  CHECK(m.coords_to_morton(&coords[0]) == 15);
+
+  std::vector<uint64_t> back(2);
+  m.morton_to_coords(9, &back[0]);
+  CHECK(back == std::vector<uint64_t>{2, 1});
+}
+
+TEST_CASE("Morton: Test batch conversion", "[morton][batch]") {
+  for (int dim_num = 1; dim_num < Morton::MC_MAX_DIM; ++dim_num) {
+    Morton m(dim_num);
+    const uint64_t cell_num = 100;
+    const uint64_t max_val = ((uint64_t)1 << m.bits()) - 1;
+
+    std::vector<uint64_t> coords(dim_num * cell_num);
+    for (uint64_t i = 0; i < coords.size(); ++i)
+      coords[i] = (i * 0x9E3779B97F4A7C15ull) & max_val;
+
+    std::vector<uint64_t> values(cell_num);
+    m.coords_to_morton(cell_num, &coords[0], &values[0]);
+    for (uint64_t c = 0; c < cell_num; ++c) {
+      std::vector<uint64_t> cell(dim_num), back(dim_num);
+      for (int d = 0; d < dim_num; ++d)
+        cell[d] = coords[d * cell_num + c];
+      CHECK(values[c] == m.coords_to_morton(&cell[0]));
+      m.morton_to_coords(values[c], &back[0]);
+      CHECK(back == cell);
+    }
+  }
+}
@@ -32,9 +32,28 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/cache/array_schema_lru_cache.h"
 #include "tiledb/sm/cache/buffer_lru_cache.h"
+#include "tiledb/sm/cache/fragment_metadata_lru_cache.h"
+#include "tiledb/sm/cache/sharded_buffer_lru_cache.h"
+#include "tiledb/sm/cache/shared_memory_tile_cache.h"
+#include "tiledb/sm/cache/tile_overlap_lru_cache.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/tile/filtered_buffer.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 using namespace tiledb::common;
 using namespace tiledb::sm;
 
@@ -240,4 +259,331 @@ TEST_CASE("BufferLRUCache of 0 capacity", "[lru_cache]") {
   CHECK(it == it_end);
 
   delete lru_cache;
-}
\ No newline at end of file
+}
+
+TEST_CASE(
+    "Unit-test class FragmentMetadataLRUCache",
+    "[lru_cache][fragment_metadata]") {
+  // Room for two fragment metadata
+  FragmentMetadataLRUCache lru_cache(2 * sizeof(FragmentMetadata));
+
+  // Keys differ across encryption keys
+  URI uri("file:///array/__fragments/__1_1_0123456789abcdef_11");
+  EncryptionKey no_key;
+  EncryptionKey key;
+  const char key_bytes[] = "0123456789abcdeF0123456789abcdeF";
+  CHECK(key.set_key(EncryptionType::AES_256_GCM, key_bytes, 32).ok());
+  auto k0 = FragmentMetadataLRUCache::key(uri, no_key);
+  auto k1 = FragmentMetadataLRUCache::key(uri, key);
+  CHECK(k0 != k1);
+  CHECK(
+      FragmentMetadataLRUCache::key(URI(uri.to_string() + "/"), no_key) == k0);
+
+  // Get non-existent item
+  CHECK(lru_cache.get(k0) == nullptr);
+
+  // Insert and share an item
+  auto m0 = tdb::make_shared<FragmentMetadata>(HERE());
+  CHECK(lru_cache.insert(k0, m0).ok());
+  CHECK(lru_cache.get(k0) == m0);
+  CHECK(lru_cache.get(k1) == nullptr);
+
+  // Inserting an existing key keeps the shared item
+  auto m0_dup = tdb::make_shared<FragmentMetadata>(HERE());
+  CHECK(lru_cache.insert(k0, m0_dup).ok());
+  CHECK(lru_cache.get(k0) == m0);
+
+  // Evict the least recently used item
+  auto m1 = tdb::make_shared<FragmentMetadata>(HERE());
+  auto m2 = tdb::make_shared<FragmentMetadata>(HERE());
+  CHECK(lru_cache.insert("m1", m1).ok());
+  CHECK(lru_cache.get(k0) == m0);
+  CHECK(lru_cache.insert("m2", m2).ok());
+  CHECK(lru_cache.get("m1") == nullptr);
+  CHECK(lru_cache.get(k0) == m0);
+  CHECK(lru_cache.get("m2") == m2);
+
+  // Evicted items stay alive for their users
+  lru_cache.clear();
+  CHECK(lru_cache.get(k0) == nullptr);
+  CHECK(m0.use_count() == 1);
+
+  // Test invalidate
+  bool success;
+  CHECK(lru_cache.insert(k1, m1).ok());
+  CHECK(lru_cache.invalidate(k1, &success).ok());
+  CHECK(success);
+  CHECK(lru_cache.get(k1) == nullptr);
+}
+
+TEST_CASE(
+    "Unit-test class ArraySchemaLRUCache", "[lru_cache][array_schema]") {
+  ArraySchemaLRUCache lru_cache(100);
+
+  Domain domain;
+  Dimension dim("d", Datatype::UINT8);
+  uint8_t bounds[2] = {1, 10};
+  Range range(bounds, 2 * sizeof(uint8_t));
+  REQUIRE(dim.set_domain(range).ok());
+  REQUIRE(domain.add_dimension(&dim).ok());
+  ArraySchema schema;
+  REQUIRE(schema.set_domain(&domain).ok());
+  URI uri("file:///array/__schema/__1_1_0123456789abcdef");
+  schema.set_uri(uri);
+
+  EncryptionKey no_key;
+  auto k = ArraySchemaLRUCache::key(uri, no_key);
+
+  // Read non-existent item
+  bool success;
+  ArraySchema* copy = nullptr;
+  CHECK(lru_cache.read(k, &copy, &success).ok());
+  CHECK(!success);
+  CHECK(copy == nullptr);
+
+  // Insert an object larger than the cache
+  CHECK(lru_cache.insert(k, &schema, 101).ok());
+  CHECK(lru_cache.read(k, &copy, &success).ok());
+  CHECK(!success);
+
+  // Each read returns a new copy
+  CHECK(lru_cache.insert(k, &schema, 50).ok());
+  CHECK(lru_cache.read(k, &copy, &success).ok());
+  REQUIRE(success);
+  ArraySchema* copy2 = nullptr;
+  CHECK(lru_cache.read(k, &copy2, &success).ok());
+  REQUIRE(success);
+  CHECK(copy != copy2);
+  CHECK(copy->uri() == uri);
+  CHECK(copy->name() == schema.name());
+  CHECK(copy->dim_num() == 1);
+  tdb_delete(copy);
+  tdb_delete(copy2);
+
+  // Evict the least recently used item
+  CHECK(lru_cache.insert("other", &schema, 60).ok());
+  CHECK(lru_cache.read(k, &copy, &success).ok());
+  CHECK(!success);
+
+  // Test clear
+  lru_cache.clear();
+  CHECK(lru_cache.read("other", &copy, &success).ok());
+  CHECK(!success);
+}
+
+TEST_CASE(
+    "Unit-test class TileOverlapLRUCache", "[lru_cache][tile_overlap]") {
+  SubarrayTileOverlap tile_overlap(2, 0, 1);
+  tile_overlap.at(0, 0)->tile_ranges_.emplace_back(0, 3);
+  tile_overlap.at(1, 1)->tiles_.emplace_back(5, 0.5);
+  std::vector<unsigned> relevant_fragments = {0, 1};
+  const uint64_t size = tile_overlap.byte_size() + 2 * sizeof(unsigned);
+
+  // Each object is accounted for with its key
+  TileOverlapLRUCache lru_cache(2 * (size + 2));
+
+  // Read non-existent item
+  bool success;
+  SubarrayTileOverlap read_overlap;
+  std::vector<unsigned> read_fragments;
+  CHECK(lru_cache.read("k1", &read_overlap, &read_fragments, &success).ok());
+  CHECK(!success);
+
+  // Read an inserted item
+  CHECK(lru_cache.insert("k1", tile_overlap, relevant_fragments).ok());
+  CHECK(lru_cache.read("k1", &read_overlap, &read_fragments, &success).ok());
+  REQUIRE(success);
+  CHECK(read_fragments == relevant_fragments);
+  CHECK(read_overlap.range_idx_start() == 0);
+  CHECK(read_overlap.range_idx_end() == 1);
+  CHECK(read_overlap.byte_size() == tile_overlap.byte_size());
+  CHECK(read_overlap.at(0, 0)->tile_ranges_.size() == 1);
+  CHECK(read_overlap.at(1, 1)->tiles_.size() == 1);
+
+  // Updating the range of a copy does not affect the cached object
+  read_overlap.update_range(1, 1);
+  CHECK(lru_cache.read("k1", &read_overlap, &read_fragments, &success).ok());
+  REQUIRE(success);
+  CHECK(read_overlap.range_idx_start() == 0);
+
+  // Evict the least recently used item
+  CHECK(lru_cache.insert("k2", tile_overlap, relevant_fragments).ok());
+  CHECK(lru_cache.read("k1", &read_overlap, &read_fragments, &success).ok());
+  CHECK(success);
+  CHECK(lru_cache.insert("k3", tile_overlap, relevant_fragments).ok());
+  CHECK(lru_cache.read("k2", &read_overlap, &read_fragments, &success).ok());
+  CHECK(!success);
+  CHECK(lru_cache.read("k1", &read_overlap, &read_fragments, &success).ok());
+  CHECK(success);
+}
+
+TEST_CASE("Unit-test class ShardedBufferLRUCache", "[lru_cache]") {
+  const uint64_t shard_num = 4;
+  ShardedBufferLRUCache cache(shard_num * 16 * sizeof(int), shard_num);
+  CHECK(cache.shard_num() == shard_num);
+
+  // Insert items under different keys
+  for (int k = 0; k < 8; ++k) {
+    FilteredBuffer v(sizeof(int) * 2);
+    reinterpret_cast<int*>(v.data())[0] = k;
+    reinterpret_cast<int*>(v.data())[1] = k + 100;
+    CHECK(cache.insert("key" + std::to_string(k), std::move(v)).ok());
+  }
+
+  // Each shard fits all the items, so none of them is evicted
+  int data[2];
+  bool success;
+  for (int k = 0; k < 8; ++k) {
+    CHECK(cache.read("key" + std::to_string(k), data, 0, sizeof(data), &success)
+              .ok());
+    CHECK(success);
+    CHECK(data[0] == k);
+    CHECK(data[1] == k + 100);
+  }
+
+  // Read a part of an item
+  CHECK(cache.read("key3", data, sizeof(int), sizeof(int), &success).ok());
+  CHECK(success);
+  CHECK(data[0] == 103);
+
+  // Non-existent key
+  CHECK(cache.read("key8", data, 0, sizeof(int), &success).ok());
+  CHECK(!success);
+
+  // Clear
+  cache.clear();
+  CHECK(cache.read("key0", data, 0, sizeof(int), &success).ok());
+  CHECK(!success);
+
+  // Zero shards are treated as one
+  ShardedBufferLRUCache single(CACHE_SIZE, 0);
+  CHECK(single.shard_num() == 1);
+}
+
+TEST_CASE("BufferLRUCache scan resistance", "[lru_cache]") {
+  auto policy = GENERATE(CachePolicy::LRU, CachePolicy::SLRU);
+  BufferLRUCache cache(CACHE_SIZE, policy);
+
+  // Insert a hot item and read it again
+  FilteredBuffer hot(sizeof(int) * 3);
+  CHECK(cache.insert("hot", std::move(hot)).ok());
+  int data[3];
+  bool success;
+  CHECK(cache.read("hot", data, 0, sizeof(data), &success).ok());
+  CHECK(success);
+
+  // Scan items read only once
+  uint64_t total_evicted_num = 0;
+  for (int k = 0; k < 10; ++k) {
+    FilteredBuffer v(sizeof(int) * 3);
+    uint64_t evicted_num;
+    bool admitted;
+    CHECK(cache
+              .insert(
+                  "scan" + std::to_string(k),
+                  std::move(v),
+                  true,
+                  &evicted_num,
+                  &admitted)
+              .ok());
+    CHECK(admitted);
+    total_evicted_num += evicted_num;
+  }
+  CHECK(total_evicted_num == 8);
+
+  // Only the segmented LRU keeps the hot item
+  CHECK(cache.read("hot", data, 0, sizeof(data), &success).ok());
+  CHECK(success == (policy == CachePolicy::SLRU));
+}
+
+TEST_CASE("BufferLRUCache TinyLFU admission", "[lru_cache]") {
+  BufferLRUCache cache(CACHE_SIZE, CachePolicy::TINYLFU);
+  int data[3];
+  bool success;
+  uint64_t evicted_num;
+  bool admitted;
+
+  // Read a hot item several times
+  for (int i = 0; i < 5; ++i) {
+    CHECK(cache.read("hot", data, 0, sizeof(data), &success).ok());
+    if (!success) {
+      FilteredBuffer hot(sizeof(int) * 3);
+      CHECK(cache.insert("hot", std::move(hot), true, &evicted_num, &admitted)
+                .ok());
+      CHECK(admitted);
+    }
+  }
+
+  // Items read once are not admitted when they would evict others
+  uint64_t rejected_num = 0;
+  for (int k = 0; k < 10; ++k) {
+    const std::string key = "scan" + std::to_string(k);
+    CHECK(cache.read(key, data, 0, sizeof(data), &success).ok());
+    CHECK(!success);
+    FilteredBuffer v(sizeof(int) * 3);
+    CHECK(cache.insert(key, std::move(v), true, &evicted_num, &admitted).ok());
+    rejected_num += !admitted;
+  }
+  CHECK(rejected_num == 8);
+
+  CHECK(cache.read("hot", data, 0, sizeof(data), &success).ok());
+  CHECK(success);
+}
+
+#ifndef _WIN32
+TEST_CASE("Unit-test class SharedMemoryTileCache", "[lru_cache]") {
+  const std::string name = "tiledb_unit_shared_memory_tile_cache";
+  shm_unlink(("/" + name).c_str());
+
+  // Two caches attached to the same segment, as from two processes
+  SharedMemoryTileCache writer, reader;
+  REQUIRE(writer.init(name, 1024 * 1024).ok());
+  REQUIRE(reader.init(name, 0).ok());
+  CHECK(reader.size() == writer.size());
+
+  std::vector<int> v(100);
+  for (int i = 0; i < 100; ++i)
+    v[i] = i;
+  CHECK(writer.insert("v", v.data(), v.size() * sizeof(int)).ok());
+
+  std::vector<int> data(100);
+  bool success;
+  CHECK(reader.read("v", data.data(), data.size() * sizeof(int), &success)
+            .ok());
+  CHECK(success);
+  CHECK(data == v);
+
+  // Wrong size or key
+  CHECK(reader.read("v", data.data(), sizeof(int), &success).ok());
+  CHECK(!success);
+  CHECK(reader.read("w", data.data(), data.size() * sizeof(int), &success)
+            .ok());
+  CHECK(!success);
+
+  // Old records are overwritten when the segment wraps around
+  std::vector<int> large(64 * 1024);
+  for (int k = 0; k < 8; ++k) {
+    std::fill(large.begin(), large.end(), k);
+    CHECK(writer
+              .insert(
+                  "large" + std::to_string(k),
+                  large.data(),
+                  large.size() * sizeof(int))
+              .ok());
+  }
+  CHECK(reader.read("v", data.data(), data.size() * sizeof(int), &success)
+            .ok());
+  CHECK(!success);
+  CHECK(reader
+            .read(
+                "large7",
+                large.data(),
+                large.size() * sizeof(int),
+                &success)
+            .ok());
+  CHECK(success);
+  CHECK(large[0] == 7);
+
+  shm_unlink(("/" + name).c_str());
+}
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file   unit-parallel-functions.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Tests the parallel functions.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <catch.hpp>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+
+using namespace tiledb::common;
+using namespace tiledb::sm;
+
+TEST_CASE(
+    "parallel_for: Test every index is visited once", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  for (uint64_t n : {0, 1, 7, 1000, 100000}) {
+    std::vector<std::atomic<int>> visits(n);
+    ParallelForStats stats;
+    auto st = parallel_for(
+        &tp,
+        0,
+        n,
+        [&](uint64_t i) {
+          ++visits[i];
+          return Status::Ok();
+        },
+        &stats);
+    REQUIRE(st.ok());
+    for (uint64_t i = 0; i < n; ++i)
+      CHECK(visits[i] == 1);
+    CHECK(stats.chunk_num <= n);
+    CHECK(stats.imbalance_ns <= stats.elapsed_ns);
+  }
+}
+
+TEST_CASE("parallel_for: Test cheap loops use large chunks", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  std::vector<uint64_t> values(100, 1);
+  ParallelForStats stats;
+  auto st = parallel_for(
+      &tp,
+      0,
+      values.size(),
+      [&](uint64_t i) {
+        values[i] *= 2;
+        return Status::Ok();
+      },
+      &stats);
+  REQUIRE(st.ok());
+  CHECK(stats.chunk_num < values.size());
+  for (auto v : values)
+    CHECK(v == 2);
+}
+
+TEST_CASE("parallel_for: Test skewed loops are shared", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  // The first iterations are far more expensive than the others.
+  std::atomic<uint64_t> sum(0);
+  ParallelForStats stats;
+  auto st = parallel_for(
+      &tp,
+      0,
+      1000,
+      [&](uint64_t i) {
+        if (i < 8)
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        sum += i;
+        return Status::Ok();
+      },
+      &stats);
+  REQUIRE(st.ok());
+  CHECK(sum == 999 * 1000 / 2);
+  CHECK(stats.task_num > 0);
+  CHECK(stats.task_num <= 3);
+  CHECK(stats.chunk_num > 8);
+}
+
+TEST_CASE("parallel_for: Test error status", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  std::atomic<uint64_t> count(0);
+  auto st = parallel_for(&tp, 0, 10000, [&](uint64_t i) {
+    ++count;
+    if (i == 5000)
+      return Status_Error("Failed");
+    return Status::Ok();
+  });
+  CHECK(!st.ok());
+  CHECK(count == 10000);
+}
+
+TEST_CASE(
+    "parallel_for_2d: Test every pair is visited once", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  const uint64_t rows = 37, cols = 11;
+  std::vector<std::atomic<int>> visits(rows * cols);
+  ParallelForStats stats;
+  auto st = parallel_for_2d(
+      &tp,
+      2,
+      2 + rows,
+      5,
+      5 + cols,
+      [&](uint64_t i, uint64_t j) {
+        ++visits[(i - 2) * cols + (j - 5)];
+        return Status::Ok();
+      },
+      &stats);
+  REQUIRE(st.ok());
+  for (auto& v : visits)
+    CHECK(v == 1);
+  CHECK(stats.chunk_num > 0);
+
+  st = parallel_for_2d(&tp, 0, 4, 0, 4, [&](uint64_t i, uint64_t j) {
+    if (i == 3 && j == 1)
+      return Status_Error("Failed");
+    return Status::Ok();
+  });
+  CHECK(!st.ok());
+}
+
+TEST_CASE("parallel_for: Test cancellation", "[parallel_for]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  // The loop stops at the next chunk once its token is cancelled.
+  auto token = tiledb::common::make_shared<CancellationToken>(HERE());
+  ThreadPool::ScopedCancellation scoped_cancellation(token);
+  std::atomic<uint64_t> count(0);
+  const uint64_t n = 100000;
+  auto st = parallel_for(&tp, 0, n, [&](uint64_t) {
+    if (++count == 100)
+      token->cancel();
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+    return Status::Ok();
+  });
+  CHECK(!st.ok());
+  CHECK(count < n);
+}
+
+TEST_CASE("parallel_sort: Test sort", "[parallel_sort]") {
+  ThreadPool tp;
+  REQUIRE(tp.init(4).ok());
+
+  std::mt19937_64 rng(7);
+  for (uint64_t n : {0, 1, 100, 100000, 1000000}) {
+    for (uint64_t distinct : {uint64_t(1), uint64_t(10), n + 1}) {
+      std::vector<uint64_t> values(n);
+      for (auto& v : values)
+        v = rng() % distinct;
+      auto expected = values;
+      std::sort(expected.begin(), expected.end());
+
+      auto quick_sorted = values;
+      parallel_quick_sort(&tp, quick_sorted.begin(), quick_sorted.end());
+      CHECK(quick_sorted == expected);
+
+      parallel_sort(&tp, values.begin(), values.end());
+      CHECK(values == expected);
+
+      // Sorted and reverse sorted inputs.
+      parallel_sort(&tp, values.begin(), values.end());
+      CHECK(values == expected);
+      std::reverse(values.begin(), values.end());
+      parallel_sort(&tp, values.begin(), values.end());
+      CHECK(values == expected);
+    }
+  }
+
+  // Custom comparator and non trivial values.
+  std::vector<std::string> strings(50000);
+  for (auto& s : strings)
+    s = std::to_string(rng() % 1000);
+  auto expected = strings;
+  auto cmp = [](const std::string& a, const std::string& b) {
+    return a.size() < b.size() || (a.size() == b.size() && a > b);
+  };
+  std::sort(expected.begin(), expected.end(), cmp);
+  parallel_sort(&tp, strings.begin(), strings.end(), cmp);
+  CHECK(strings == expected);
+}
@@ -36,6 +36,7 @@
 #include "tiledb/sm/rtree/rtree.h"
 
 #include <catch.hpp>
+#include <algorithm>
 #include <iostream>
 
 using namespace tiledb::sm;
@@ -1169,3 +1170,183 @@ TEST_CASE(
   CHECK(overlap.tiles_[1].second == 1.0 / 3);
   */
 }
+
+TEST_CASE("RTree: Test inline and heap-allocated ranges", "[rtree][range]") {
+  // A fixed-sized range that fits in the inline buffer
+  int64_t r_fixed[] = {1, 10};
+  Range fixed;
+  fixed.set_range(r_fixed, sizeof(r_fixed));
+  CHECK(fixed.size() == sizeof(r_fixed));
+  CHECK(fixed.unary() == false);
+  CHECK(((const int64_t*)fixed.start())[0] == 1);
+  CHECK(((const int64_t*)fixed.end())[0] == 10);
+
+  Range fixed_copy(fixed);
+  CHECK(fixed_copy == fixed);
+  std::vector<Range> ranges(1, fixed);
+  ranges.resize(64);
+  CHECK(ranges[0] == fixed);
+  CHECK(((const int64_t*)ranges[0].start())[0] == 1);
+
+  // A string range that does not fit in the inline buffer
+  std::string start = "aaaaaaaaaaaaaaaa";
+  std::string end = "zzzzzzzzzzzzzzzz";
+  Range var;
+  var.set_range_var(start.data(), start.size(), end.data(), end.size());
+  CHECK(var.size() == start.size() + end.size());
+  CHECK(var.start_str() == start);
+  CHECK(var.end_str() == end);
+
+  Range var_copy = var;
+  CHECK(var_copy == var);
+  CHECK(!(var_copy == fixed));
+
+  // Shrinking a heap-allocated range back to the inline buffer
+  var.set_range_inline(r_fixed, sizeof(r_fixed));
+  CHECK(var == fixed);
+  var.clear();
+  CHECK(var.empty());
+
+  // An inline range survives moves, and its copies store their bytes on the
+  // heap so that pointers to them survive moving the copies
+  Range inline_range;
+  inline_range.set_range_inline(r_fixed, sizeof(r_fixed));
+  CHECK(inline_range == fixed);
+  std::vector<Range> inline_ranges;
+  inline_ranges.emplace_back(std::move(inline_range));
+  inline_ranges.resize(64);
+  CHECK(inline_ranges[0] == fixed);
+
+  std::vector<Range> copies(1, inline_ranges[0]);
+  auto copy_start = (const int64_t*)copies[0].start();
+  auto copy_end = (const int64_t*)copies[0].end();
+  copies.resize(64);
+  CHECK(copy_start == copies[0].start());
+  CHECK(copy_end == copies[0].end());
+  CHECK(copy_start[0] == 1);
+  CHECK(copy_end[0] == 10);
+}
+
+TEST_CASE(
+    "RTree: Test packed traversal against exhaustive leaf checks",
+    "[rtree][2d][packed]") {
+  // Build a 2D tree with mixed dimension types and partial nodes
+  int32_t dom_1[] = {1, 1000};
+  int32_t extent_1 = 10;
+  double dom_2[] = {0.0, 100.0};
+  double extent_2 = 1.0;
+  std::vector<int32_t> r1;
+  std::vector<double> r2;
+  for (int32_t i = 0; i < 50; ++i) {
+    r1.push_back(1 + 7 * i);
+    r1.push_back(1 + 7 * i + 9);
+    r2.push_back((i % 10) * 9.5);
+    r2.push_back((i % 10) * 9.5 + 4.0);
+  }
+  std::vector<NDRange> mbrs = create_mbrs<int32_t, double>(r1, r2);
+  Domain dom = create_domain(
+      {"d1", "d2"},
+      {Datatype::INT32, Datatype::FLOAT64},
+      {dom_1, dom_2},
+      {&extent_1, &extent_2});
+  RTree rtree(&dom, 4);
+  rtree.set_leaves(mbrs);
+  rtree.build_tree();
+  CHECK(rtree.height() == 4);
+
+  int32_t q1[] = {40, 260};
+  double q2[] = {12.0, 60.0};
+  NDRange range(2);
+  range[0].set_range(q1, sizeof(q1));
+  range[1].set_range(q2, sizeof(q2));
+
+  // The overlapping tiles, in order, must match the exhaustive check
+  auto overlap = rtree.get_tile_overlap(range);
+  std::vector<uint64_t> expected, found;
+  for (uint64_t m = 0; m < mbrs.size(); ++m) {
+    if (dom.overlap_ratio(range, mbrs[m]) != 0.0)
+      expected.push_back(m);
+  }
+  size_t t = 0, r = 0;
+  while (t < overlap.tiles_.size() || r < overlap.tile_ranges_.size()) {
+    bool take_tile =
+        r == overlap.tile_ranges_.size() ||
+        (t < overlap.tiles_.size() &&
+         overlap.tiles_[t].first < overlap.tile_ranges_[r].first);
+    if (take_tile) {
+      CHECK(overlap.tiles_[t].second ==
+            dom.overlap_ratio(range, mbrs[overlap.tiles_[t].first]));
+      found.push_back(overlap.tiles_[t++].first);
+    } else {
+      for (auto m = overlap.tile_ranges_[r].first;
+           m <= overlap.tile_ranges_[r].second;
+           ++m)
+        found.push_back(m);
+      ++r;
+    }
+  }
+  CHECK(found == expected);
+
+  // Same for the per-dimension tile bitmaps
+  for (unsigned d = 0; d < 2; ++d) {
+    std::vector<uint8_t> bitmap(mbrs.size(), 0);
+    rtree.compute_tile_bitmap(range[d], d, &bitmap);
+    for (uint64_t m = 0; m < mbrs.size(); ++m) {
+      auto dim = dom.dimension(d);
+      CHECK(bitmap[m] == (uint8_t)dim->overlap(range[d], mbrs[m][d]));
+    }
+  }
+}
+
+TEST_CASE(
+    "RTree: Test batched tile overlap of multiple ranges",
+    "[rtree][1d][batch]") {
+  int32_t dim_dom[] = {1, 1000};
+  int32_t dim_extent = 10;
+  std::vector<NDRange> mbrs = create_mbrs<int32_t, 1>(
+      {1, 3, 5, 10, 20, 22, 30, 35, 36, 38, 40, 49, 50, 51, 65, 69});
+  Domain dom1 =
+      create_domain({"d"}, {Datatype::INT32}, {dim_dom}, {&dim_extent});
+  RTree rtree(&dom1, 3);
+  rtree.set_leaves(mbrs);
+  rtree.build_tree();
+
+  std::vector<std::vector<int32_t>> r = {
+      {0, 0}, {1, 69}, {10, 20}, {30, 69}, {1, 32}, {37, 50}};
+  std::vector<NDRange> ranges(r.size(), NDRange(1));
+  for (size_t i = 0; i < r.size(); ++i)
+    ranges[i][0].set_range(r[i].data(), 2 * sizeof(int32_t));
+
+  // Expands an overlap into (tile, ratio) pairs in tile order
+  auto expand = [](const TileOverlap& overlap) {
+    std::vector<std::pair<uint64_t, double>> ret = overlap.tiles_;
+    for (const auto& tr : overlap.tile_ranges_) {
+      for (auto t = tr.first; t <= tr.second; ++t)
+        ret.emplace_back(t, 1.0);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+  };
+
+  // A single leaf interval gives the same results as one range at a time
+  std::vector<TileOverlap> overlaps;
+  rtree.get_tile_overlap(ranges, 0, mbrs.size() - 1, &overlaps);
+  REQUIRE(overlaps.size() == ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    auto overlap = rtree.get_tile_overlap(ranges[i]);
+    CHECK(overlaps[i].tiles_ == overlap.tiles_);
+    CHECK(overlaps[i].tile_ranges_ == overlap.tile_ranges_);
+  }
+
+  // Splitting the leaves into intervals gives the same tiles
+  std::vector<TileOverlap> first, second;
+  rtree.get_tile_overlap(ranges, 0, 4, &first);
+  rtree.get_tile_overlap(ranges, 5, 100, &second);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    auto expected = expand(overlaps[i]);
+    auto found = expand(first[i]);
+    auto found_second = expand(second[i]);
+    found.insert(found.end(), found_second.begin(), found_second.end());
+    CHECK(found == expected);
+  }
+}
@@ -315,7 +315,7 @@ TEST_CASE_METHOD(
   uint64_t data_size = sizeof(data);
   write_1d_fragment(coords, &coords_size, data, &data_size);
 
-  // We should have one tile range (size 16) which will be bigger than budget
+  // We should have one block of tile ranges which will be bigger than budget
   // (10).
   total_budget_ = "1000";
   ratio_tile_ranges_ = "0.01";
@@ -758,4 +758,322 @@ TEST_CASE_METHOD(
   int data_c[] = {1, 2, 3, 4, 5, 6};
   CHECK(!std::memcmp(coords_c, coords_r, coords_r_size));
   CHECK(!std::memcmp(data_c, data_r, data_r_size));
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    CSparseGlobalOrderFx,
+    "Sparse global order reader: merge interleaved fragments",
+    "[sparse-global-order][merge]") {
+  // Create an array with big tiles so that runs of various lengths are
+  // merged from the same tile.
+  reset_config();
+  int domain[] = {1, 200};
+  int tile_extent = 200;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d"},
+      {TILEDB_INT32},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      100,
+      false);
+
+  // The first fragment has the odd values up to 99 then all values from 101
+  // to 150, the second fragment has the even values up to 100.
+  std::vector<int> coords_1;
+  for (int i = 1; i < 100; i += 2) {
+    coords_1.emplace_back(i);
+  }
+  for (int i = 101; i <= 150; i++) {
+    coords_1.emplace_back(i);
+  }
+  std::vector<int> coords_2;
+  for (int i = 2; i <= 100; i += 2) {
+    coords_2.emplace_back(i);
+  }
+
+  std::vector<int> data_1(coords_1);
+  std::vector<int> data_2(coords_2);
+  uint64_t coords_size = coords_1.size() * sizeof(int);
+  uint64_t data_size = data_1.size() * sizeof(int);
+  write_1d_fragment(coords_1.data(), &coords_size, data_1.data(), &data_size);
+  coords_size = coords_2.size() * sizeof(int);
+  data_size = data_2.size() * sizeof(int);
+  write_1d_fragment(coords_2.data(), &coords_size, data_2.data(), &data_size);
+
+  // Read.
+  std::vector<int> coords_r(200);
+  std::vector<int> data_r(200);
+  uint64_t coords_r_size = coords_r.size() * sizeof(int);
+  uint64_t data_r_size = data_r.size() * sizeof(int);
+  auto rc = read(
+      false,
+      false,
+      coords_r.data(),
+      &coords_r_size,
+      data_r.data(),
+      &data_r_size);
+  CHECK(rc == TILEDB_OK);
+
+  // All cells should be read in global order.
+  CHECK(150 * sizeof(int) == coords_r_size);
+  CHECK(150 * sizeof(int) == data_r_size);
+  for (int i = 0; i < 150; i++) {
+    CHECK(coords_r[i] == i + 1);
+    CHECK(data_r[i] == i + 1);
+  }
+}
+
+TEST_CASE_METHOD(
+    CSparseGlobalOrderFx,
+    "Sparse global order reader: 2D int64, col-major tile and cell orders",
+    "[sparse-global-order][col-major]") {
+  reset_config();
+  int64_t domain[] = {1, 4};
+  int64_t tile_extent = 2;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d1", "d2"},
+      {TILEDB_INT64, TILEDB_INT64},
+      {domain, domain},
+      {&tile_extent, &tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_COL_MAJOR,
+      TILEDB_COL_MAJOR,
+      4,
+      false);
+
+  // Write the cells in row-major order, alternating between two fragments.
+  for (int f = 0; f < 2; f++) {
+    std::vector<int64_t> d1, d2;
+    std::vector<int> data;
+    for (int64_t i = 1; i <= 4; i++) {
+      for (int64_t j = 1; j <= 4; j++) {
+        if ((i + j) % 2 == f) {
+          d1.emplace_back(i);
+          d2.emplace_back(j);
+          data.emplace_back(int(i * 10 + j));
+        }
+      }
+    }
+    uint64_t coords_size = d1.size() * sizeof(int64_t);
+    uint64_t data_size = data.size() * sizeof(int);
+
+    tiledb_array_t* array;
+    auto rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_query_t* query;
+    rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_layout(ctx_, query, TILEDB_UNORDERED);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_data_buffer(
+        ctx_, query, "a", data.data(), &data_size);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_data_buffer(
+        ctx_, query, "d1", d1.data(), &coords_size);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_set_data_buffer(
+        ctx_, query, "d2", d2.data(), &coords_size);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_query_submit(ctx_, query);
+    REQUIRE(rc == TILEDB_OK);
+    rc = tiledb_array_close(ctx_, array);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_array_free(&array);
+    tiledb_query_free(&query);
+  }
+
+  // Read.
+  std::vector<int64_t> d1_r(16), d2_r(16);
+  std::vector<int> data_r(16);
+  uint64_t coords_r_size = d1_r.size() * sizeof(int64_t);
+  uint64_t coords_2_r_size = coords_r_size;
+  uint64_t data_r_size = data_r.size() * sizeof(int);
+  tiledb_array_t* array;
+  auto rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_data_buffer(
+      ctx_, query, "a", data_r.data(), &data_r_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_data_buffer(
+      ctx_, query, "d1", d1_r.data(), &coords_r_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_data_buffer(
+      ctx_, query, "d2", d2_r.data(), &coords_2_r_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+
+  // Tiles and the cells within them are ordered on `d2` first.
+  CHECK(16 * sizeof(int) == data_r_size);
+  int c = 0;
+  for (int64_t tj = 0; tj < 2; tj++) {
+    for (int64_t ti = 0; ti < 2; ti++) {
+      for (int64_t j = 1; j <= 2; j++) {
+        for (int64_t i = 1; i <= 2; i++, c++) {
+          CHECK(d1_r[c] == ti * 2 + i);
+          CHECK(d2_r[c] == tj * 2 + j);
+          CHECK(data_r[c] == int(d1_r[c] * 10 + d2_r[c]));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE_METHOD(
+    CSparseGlobalOrderFx,
+    "Sparse global order reader: parallel merge of interleaved fragments",
+    "[sparse-global-order][parallel-merge]") {
+  reset_config();
+  int domain[] = {1, 40000};
+  int tile_extent = 1000;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d"},
+      {TILEDB_INT32},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      100,
+      false);
+
+  // Write four fragments with interleaved cells, so that the merge has to
+  // switch fragments at every cell.
+  const int num_frags = 4;
+  const int num_cells = 10000;
+  for (int f = 0; f < num_frags; f++) {
+    std::vector<int> coords(num_cells);
+    std::vector<int> data(num_cells);
+    for (int i = 0; i < num_cells; i++) {
+      coords[i] = i * num_frags + f + 1;
+      data[i] = coords[i];
+    }
+    uint64_t coords_size = coords.size() * sizeof(int);
+    uint64_t data_size = data.size() * sizeof(int);
+    write_1d_fragment(coords.data(), &coords_size, data.data(), &data_size);
+  }
+
+  // Overwrite every seventh cell with a last fragment.
+  std::vector<int> coords_o;
+  std::vector<int> data_o;
+  for (int c = 7; c <= num_frags * num_cells; c += 7) {
+    coords_o.emplace_back(c);
+    data_o.emplace_back(-c);
+  }
+  uint64_t coords_o_size = coords_o.size() * sizeof(int);
+  uint64_t data_o_size = data_o.size() * sizeof(int);
+  write_1d_fragment(
+      coords_o.data(), &coords_o_size, data_o.data(), &data_o_size);
+
+  uint64_t buffer_cells = 0;
+  SECTION("- Complete read") {
+    buffer_cells = num_frags * num_cells;
+  }
+  SECTION("- Incomplete reads") {
+    buffer_cells = 1000;
+  }
+
+  // Read until the query completes.
+  tiledb_array_t* array = nullptr;
+  tiledb_query_t* query = nullptr;
+  std::vector<int> coords_r(buffer_cells);
+  std::vector<int> data_r(buffer_cells);
+  uint64_t coords_r_size = coords_r.size() * sizeof(int);
+  uint64_t data_r_size = data_r.size() * sizeof(int);
+  auto rc = read(
+      false,
+      false,
+      coords_r.data(),
+      &coords_r_size,
+      data_r.data(),
+      &data_r_size,
+      &query,
+      &array);
+  CHECK(rc == TILEDB_OK);
+
+  std::vector<int> coords_all;
+  std::vector<int> data_all;
+  tiledb_query_status_t status;
+  while (true) {
+    coords_all.insert(
+        coords_all.end(),
+        coords_r.begin(),
+        coords_r.begin() + coords_r_size / sizeof(int));
+    data_all.insert(
+        data_all.end(),
+        data_r.begin(),
+        data_r.begin() + data_r_size / sizeof(int));
+
+    rc = tiledb_query_get_status(ctx_, query, &status);
+    CHECK(rc == TILEDB_OK);
+    if (status != TILEDB_INCOMPLETE)
+      break;
+
+    // The buffers should be full for incomplete reads.
+    CHECK(coords_r_size == coords_r.size() * sizeof(int));
+
+    coords_r_size = coords_r.size() * sizeof(int);
+    data_r_size = data_r.size() * sizeof(int);
+    rc = tiledb_query_submit(ctx_, query);
+    CHECK(rc == TILEDB_OK);
+  }
+  CHECK(status == TILEDB_COMPLETED);
+
+  // Check the merge was partitioned.
+  auto stats = ((SparseGlobalOrderReader*)query->query_->strategy())->stats();
+  REQUIRE(stats != nullptr);
+  auto counters = stats->counters();
+  REQUIRE(counters != nullptr);
+  CHECK(
+      counters->find(
+          "Context.StorageManager.Query.Reader.merge_partition_num") !=
+      counters->end());
+
+  // Clean up.
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+
+  // All cells should come in order, once, with the last written data.
+  REQUIRE(coords_all.size() == uint64_t(num_frags * num_cells));
+  REQUIRE(data_all.size() == coords_all.size());
+  for (int c = 1; c <= num_frags * num_cells; c++) {
+    CHECK(coords_all[c - 1] == c);
+    CHECK(data_all[c - 1] == (c % 7 == 0 ? -c : c));
+  }
+}
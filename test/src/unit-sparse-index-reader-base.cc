@@ -88,6 +88,7 @@ TEST_CASE(
   // Check the function with an empty bitmap.
   CHECK(tile.result_num_between_pos(2, 10) == 8);
   CHECK(tile.pos_with_given_result_sum(2, 8) == 9);
+  CHECK(tile.bitmap_run_end(2, 10) == 10);
 
   // Check the functions with a bitmap.
   tile.bitmap_.resize(100, 1);
@@ -99,8 +100,65 @@ TEST_CASE(
   CHECK(tile.result_num_between_pos(2, 10) == 7);
   CHECK(tile.pos_with_given_result_sum(2, 8) == 10);
 
+  // Check the functions across the words of the packed bitmap.
+  tile.bitmap_result_num_ = 97;
+  tile.bitmap_[63] = 0;
+  tile.bitmap_[64] = 0;
+  CHECK(tile.result_num_between_pos(2, 100) == 95);
+  CHECK(tile.result_num_between_pos(60, 70) == 8);
+  CHECK(tile.pos_with_given_result_sum(2, 62) == 66);
+  CHECK(tile.pos_with_given_result_sum(2, 95) == 99);
+  CHECK(tile.pos_with_given_result_sum(2, 96) == 99);
+
+  // Check that the bitmap combines with per cell results.
+  std::vector<uint8_t> cell_results(100, 1);
+  cell_results[0] = 0;
+  cell_results[99] = 0;
+  tile.bitmap_.and_with(cell_results);
+  CHECK(tile.result_num_between_pos(0, 100) == 95);
+  CHECK(tile.bitmap_[0] == 0);
+  CHECK(tile.bitmap_[1] == 1);
+  CHECK(tile.bitmap_[99] == 0);
+
+  // Check the runs of equal cells, which span words of the packed bitmap.
+  CHECK(tile.bitmap_run_end(0, 100) == 1);
+  CHECK(tile.bitmap_run_end(1, 100) == 6);
+  CHECK(tile.bitmap_run_end(6, 100) == 7);
+  CHECK(tile.bitmap_run_end(7, 100) == 63);
+  CHECK(tile.bitmap_run_end(63, 100) == 65);
+  CHECK(tile.bitmap_run_end(65, 100) == 99);
+  CHECK(tile.bitmap_run_end(65, 80) == 80);
+  CHECK(tile.bitmap_run_end(99, 100) == 100);
+
   rc = tiledb_array_schema_check(ctx, array_schema);
   REQUIRE(rc == TILEDB_OK);
 
   tiledb_ctx_free(&ctx);
-}
\ No newline at end of file
+}
+TEST_CASE(
+    "ResultTile: string coordinate prefixes order like the strings",
+    "[resulttile][string_prefix]") {
+  std::vector<std::string> strs = {"",
+                                   "a",
+                                   std::string("a\0", 2),
+                                   "ab",
+                                   "abcdefgh",
+                                   "abcdefghi",
+                                   "abcdefgi",
+                                   "b",
+                                   "\x7f",
+                                   "\x80",
+                                   "\xff\xff"};
+  for (const auto& a : strs) {
+    for (const auto& b : strs) {
+      auto pa = ResultTile::string_prefix(a);
+      auto pb = ResultTile::string_prefix(b);
+      if (pa < pb)
+        CHECK(std::string_view(a) < std::string_view(b));
+      if (pa > pb)
+        CHECK(std::string_view(a) > std::string_view(b));
+      if (a == b)
+        CHECK(pa == pb);
+    }
+  }
+}
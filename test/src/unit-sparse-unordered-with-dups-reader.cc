@@ -43,6 +43,9 @@
 #include "tiledb/sm/filesystem/posix.h"
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <catch.hpp>
 
 using namespace tiledb::sm;
@@ -65,7 +68,7 @@ struct CSparseUnorderedWithDupsFx {
   std::string ratio_coords_;
   std::string ratio_query_condition_;
 
-  void create_default_array_1d();
+  void create_default_array_1d(bool allows_dups = true);
   void create_default_array_1d_string();
   void write_1d_fragment(
       int* coords, uint64_t* coords_size, int* data, uint64_t* data_size);
@@ -142,6 +145,14 @@ void CSparseUnorderedWithDupsFx::update_config() {
           &error) == TILEDB_OK);
   REQUIRE(error == nullptr);
 
+  REQUIRE(
+      tiledb_config_set(
+          config,
+          "sm.query.sparse_unordered_no_dups.reader",
+          "refactored",
+          &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+
   REQUIRE(
       tiledb_config_set(
           config, "sm.mem.total_budget", total_budget_.c_str(), &error) ==
@@ -186,7 +197,7 @@ void CSparseUnorderedWithDupsFx::update_config() {
   tiledb_config_free(&config);
 }
 
-void CSparseUnorderedWithDupsFx::create_default_array_1d() {
+void CSparseUnorderedWithDupsFx::create_default_array_1d(bool allows_dups) {
   int domain[] = {1, 20};
   int tile_extent = 2;
   create_array(
@@ -204,7 +215,7 @@ void CSparseUnorderedWithDupsFx::create_default_array_1d() {
       TILEDB_ROW_MAJOR,
       TILEDB_ROW_MAJOR,
       2,
-      true);  // allows dups.
+      allows_dups);
 }
 
 void CSparseUnorderedWithDupsFx::create_default_array_1d_string() {
@@ -618,7 +629,7 @@ TEST_CASE_METHOD(
   uint64_t data_size = sizeof(data);
   write_1d_fragment(coords, &coords_size, data, &data_size);
 
-  // We should have one tile range (size 16) which will be bigger than budget
+  // We should have one block of tile ranges which will be bigger than budget
   // (10).
   total_budget_ = "1000";
   ratio_tile_ranges_ = "0.01";
@@ -1472,4 +1483,232 @@ TEST_CASE_METHOD(
       data_offsets_r,
       &data_offsets_r_size);
   CHECK(rc == TILEDB_OK);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(
+    CSparseUnorderedWithDupsFx,
+    "Sparse unordered with dups reader: overwrites without duplicates",
+    "[sparse-unordered-with-dups][no-dups]") {
+  bool set_subarray = false;
+  bool set_qc = false;
+  SECTION("- No subarray") {
+    set_subarray = false;
+  }
+
+  SECTION("- Subarray") {
+    set_subarray = true;
+  }
+
+  SECTION("- Query condition") {
+    set_qc = true;
+  }
+
+  // Create default array.
+  reset_config();
+  create_default_array_1d(false);
+
+  // Write a fragment and overwrite some of its cells in two more recent
+  // fragments.
+  int coords[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  uint64_t coords_size = sizeof(coords);
+  int data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  uint64_t data_size = sizeof(data);
+  write_1d_fragment(coords, &coords_size, data, &data_size);
+
+  int coords_2[] = {2, 5, 9};
+  uint64_t coords_2_size = sizeof(coords_2);
+  int data_2[] = {20, 50, 90};
+  uint64_t data_2_size = sizeof(data_2);
+  write_1d_fragment(coords_2, &coords_2_size, data_2, &data_2_size);
+
+  int coords_3[] = {5};
+  uint64_t coords_3_size = sizeof(coords_3);
+  int data_3[] = {500};
+  uint64_t data_3_size = sizeof(data_3);
+  write_1d_fragment(coords_3, &coords_3_size, data_3, &data_3_size);
+
+  // Read.
+  int coords_r[10];
+  int data_r[10];
+  uint64_t coords_r_size = sizeof(coords_r);
+  uint64_t data_r_size = sizeof(data_r);
+  auto rc = read(
+      set_subarray, set_qc, coords_r, &coords_r_size, data_r, &data_r_size);
+  CHECK(rc == TILEDB_OK);
+
+  // Sort the results by coordinates.
+  const uint64_t cell_num = coords_r_size / sizeof(int);
+  REQUIRE(data_r_size / sizeof(int) == cell_num);
+  std::vector<std::pair<int, int>> results;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    results.emplace_back(coords_r[c], data_r[c]);
+  }
+  std::sort(results.begin(), results.end());
+
+  // The overwritten cells are filtered out even if the most recent value
+  // does not pass the query condition.
+  std::vector<std::pair<int, int>> expected;
+  if (set_qc) {
+    expected = {{1, 1}, {3, 3}, {4, 4}, {6, 6}, {7, 7}, {8, 8}, {10, 10}};
+  } else {
+    expected = {
+        {1, 1},
+        {2, 20},
+        {3, 3},
+        {4, 4},
+        {5, 500},
+        {6, 6},
+        {7, 7},
+        {8, 8},
+        {9, 90},
+        {10, 10}};
+  }
+  CHECK(results == expected);
+}
+
+TEST_CASE_METHOD(
+    CSparseUnorderedWithDupsFx,
+    "Sparse unordered with dups reader: full tiles with query continuation",
+    "[sparse-unordered-with-dups][full-tiles][continuation]") {
+  bool use_subarray = false;
+  SECTION("- No subarray") {
+    use_subarray = false;
+  }
+  SECTION("- Subarray") {
+    use_subarray = true;
+  }
+
+  // Create default array.
+  reset_config();
+  create_default_array_1d();
+
+  // Write a fragment with five tiles.
+  int coords[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  uint64_t coords_size = sizeof(coords);
+  int data[] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100};
+  uint64_t data_size = sizeof(data);
+  write_1d_fragment(coords, &coords_size, data, &data_size);
+
+  tiledb_array_t* array = nullptr;
+  tiledb_query_t* query = nullptr;
+
+  // Read with room for two tiles and a half, so that the third tile is split
+  // between the two submissions.
+  int coords_r[5];
+  int data_r[5];
+  uint64_t coords_r_size = sizeof(coords_r);
+  uint64_t data_r_size = sizeof(data_r);
+  auto rc = read(
+      use_subarray,
+      false,
+      coords_r,
+      &coords_r_size,
+      data_r,
+      &data_r_size,
+      &query,
+      &array);
+  CHECK(rc == TILEDB_OK);
+
+  tiledb_query_status_t status;
+  tiledb_query_get_status(ctx_, query, &status);
+  CHECK(status == TILEDB_INCOMPLETE);
+
+  CHECK(sizeof(coords_r) == coords_r_size);
+  CHECK(sizeof(data_r) == data_r_size);
+  int coords_c_1[] = {1, 2, 3, 4, 5};
+  int data_c_1[] = {10, 20, 30, 40, 50};
+  CHECK(!std::memcmp(coords_c_1, coords_r, coords_r_size));
+  CHECK(!std::memcmp(data_c_1, data_r, data_r_size));
+
+  // Read again.
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  tiledb_query_get_status(ctx_, query, &status);
+  CHECK(status == TILEDB_COMPLETED);
+
+  CHECK(sizeof(coords_r) == coords_r_size);
+  CHECK(sizeof(data_r) == data_r_size);
+  int coords_c_2[] = {6, 7, 8, 9, 10};
+  int data_c_2[] = {60, 70, 80, 90, 100};
+  CHECK(!std::memcmp(coords_c_2, coords_r, coords_r_size));
+  CHECK(!std::memcmp(data_c_2, data_r, data_r_size));
+
+  // Clean up.
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+}
+
+TEST_CASE_METHOD(
+    CSparseUnorderedWithDupsFx,
+    "Sparse unordered with dups reader: memory usage stats",
+    "[sparse-unordered-with-dups][memory-usage]") {
+  // Create default array.
+  reset_config();
+  create_default_array_1d();
+
+  // Write a fragment.
+  int coords[] = {1, 2, 3, 4, 5};
+  uint64_t coords_size = sizeof(coords);
+  int data[] = {1, 2, 3, 4, 5};
+  uint64_t data_size = sizeof(data);
+  write_1d_fragment(coords, &coords_size, data, &data_size);
+
+  tiledb_array_t* array = nullptr;
+  tiledb_query_t* query = nullptr;
+
+  // Read.
+  int coords_r[5];
+  int data_r[5];
+  uint64_t coords_r_size = sizeof(coords_r);
+  uint64_t data_r_size = sizeof(data_r);
+  auto rc = read(
+      true,
+      false,
+      coords_r,
+      &coords_r_size,
+      data_r,
+      &data_r_size,
+      &query,
+      &array);
+  CHECK(rc == TILEDB_OK);
+
+  // The peaks are recorded, and the tiles are released once completed.
+  uint64_t current = 0, peak = 0;
+  rc = tiledb_query_get_memory_usage(
+      ctx_, query, "coord_tiles", &current, &peak);
+  CHECK(rc == TILEDB_OK);
+  CHECK(current == 0);
+  CHECK(peak > 0);
+  rc = tiledb_query_get_memory_usage(ctx_, query, "bitmaps", &current, &peak);
+  CHECK(rc == TILEDB_OK);
+  CHECK(peak > 0);
+  rc = tiledb_query_get_memory_usage(
+      ctx_, query, "attribute_tiles", &current, &peak);
+  CHECK(rc == TILEDB_OK);
+  CHECK(current == 0);
+  CHECK(peak > 0);
+  uint64_t total_peak = 0;
+  rc = tiledb_query_get_memory_usage(
+      ctx_, query, "total", &current, &total_peak);
+  CHECK(rc == TILEDB_OK);
+  CHECK(total_peak >= peak);
+
+  // The usage is reported in the query stats.
+  char* stats_json = nullptr;
+  rc = tiledb_query_get_stats(ctx_, query, &stats_json);
+  CHECK(rc == TILEDB_OK);
+  CHECK(
+      std::string(stats_json).find(
+          "Context.StorageManager.Query.Reader.memory.total.peak") !=
+      std::string::npos);
+  free(stats_json);
+
+  // Clean up.
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+}
@@ -49,3 +49,21 @@ TEST_CASE("Status: Test to_string", "[status]") {
   Status err = Status_Error("err msg");
   CHECK_THAT(err.to_string(), Catch::Equals("Error: err msg"));
 }
+
+TEST_CASE("Status: Test code", "[status]") {
+  CHECK(Status::Ok().code() == StatusCode::Ok);
+  CHECK(Status_TileError("err msg").code() == StatusCode::Tile);
+}
+
+TEST_CASE("Status: Test move", "[status]") {
+  Status err = Status_Error("err msg");
+  Status moved = std::move(err);
+  CHECK(!moved.ok());
+  CHECK_THAT(moved.to_string(), Catch::Equals("Error: err msg"));
+
+  Status st = Status::Ok();
+  st = std::move(moved);
+  CHECK_THAT(st.to_string(), Catch::Equals("Error: err msg"));
+  st = Status::Ok();
+  CHECK(st.ok());
+}
@@ -32,8 +32,14 @@
 
 #include <atomic>
 #include <catch.hpp>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 #include "tiledb/common/thread_pool.h"
+#include "tiledb/common/thread_pool/task_graph.h"
+#include "tiledb/common/tracer.h"
 #include "tiledb/sm/misc/cancelable_tasks.h"
 
 using namespace tiledb::common;
@@ -372,3 +378,348 @@ TEST_CASE("ThreadPool: Test recursion, two pools", "[threadpool]") {
       cv.wait(ul);
   }
 }
+
+TEST_CASE("ThreadPool: Test work stealing", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(8).ok());
+
+  // All the tasks are scheduled from a single worker, the other workers
+  // can only run them by stealing from its queue.
+  std::mutex thread_ids_mutex;
+  std::unordered_set<std::thread::id> thread_ids;
+  std::atomic<int> result(0);
+  const size_t num_tasks = 200;
+  auto task = pool.execute([&]() {
+    std::vector<ThreadPool::Task> inner_tasks;
+    for (size_t i = 0; i < num_tasks; ++i) {
+      inner_tasks.emplace_back(pool.execute([&]() {
+        {
+          std::lock_guard<std::mutex> lg(thread_ids_mutex);
+          thread_ids.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ++result;
+        return Status::Ok();
+      }));
+    }
+
+    return pool.wait_all(inner_tasks);
+  });
+
+  std::vector<ThreadPool::Task> tasks;
+  tasks.emplace_back(std::move(task));
+  REQUIRE(pool.wait_all(tasks).ok());
+  REQUIRE(result == num_tasks);
+  CHECK(thread_ids.size() > 1);
+}
+
+TEST_CASE("ThreadPool: Test priorities", "[threadpool]") {
+  ThreadPool::Priority priority;
+  REQUIRE(ThreadPool::priority_enum("normal", &priority).ok());
+  CHECK(priority == ThreadPool::Priority::NORMAL);
+  REQUIRE(ThreadPool::priority_enum("background", &priority).ok());
+  CHECK(priority == ThreadPool::Priority::BACKGROUND);
+  CHECK(!ThreadPool::priority_enum("urgent", &priority).ok());
+
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+  CHECK(ThreadPool::current_priority() == ThreadPool::Priority::NORMAL);
+
+  // Background tasks and their descendants run in the background lane, on
+  // at most half of the workers at a time.
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  std::atomic<int> inherited(0);
+  const int num_tasks = 50;
+  std::vector<ThreadPool::Task> tasks;
+  {
+    ThreadPool::ScopedPriority scoped_priority(
+        ThreadPool::Priority::BACKGROUND);
+    CHECK(ThreadPool::current_priority() == ThreadPool::Priority::BACKGROUND);
+    for (int i = 0; i < num_tasks; ++i) {
+      tasks.emplace_back(pool.execute([&]() {
+        int now = ++running;
+        int prev = max_running;
+        while (now > prev && !max_running.compare_exchange_weak(prev, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        --running;
+
+        std::vector<ThreadPool::Task> inner_tasks;
+        inner_tasks.emplace_back(pool.execute([&]() {
+          if (ThreadPool::current_priority() ==
+              ThreadPool::Priority::BACKGROUND)
+            ++inherited;
+          return Status::Ok();
+        }));
+        return pool.wait_all(inner_tasks);
+      }));
+    }
+  }
+  CHECK(ThreadPool::current_priority() == ThreadPool::Priority::NORMAL);
+
+  // Normal tasks are not held back by the background limit.
+  std::atomic<int> result(0);
+  for (int i = 0; i < num_tasks; ++i) {
+    tasks.emplace_back(pool.execute([&]() {
+      if (ThreadPool::current_priority() == ThreadPool::Priority::NORMAL)
+        ++result;
+      return Status::Ok();
+    }));
+  }
+
+  REQUIRE(pool.wait_all(tasks).ok());
+  CHECK(result == num_tasks);
+  CHECK(inherited == num_tasks);
+  CHECK(max_running <= 2);
+}
+
+TEST_CASE("ThreadPool: Test cancellation", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+  CHECK(ThreadPool::check_cancellation().ok());
+
+  auto token = tiledb::common::make_shared<CancellationToken>(HERE());
+  std::atomic<int> result(0);
+  std::vector<ThreadPool::Task> tasks;
+  {
+    ThreadPool::ScopedCancellation scoped_cancellation(token);
+    CHECK(ThreadPool::check_cancellation().ok());
+
+    // Nested tasks inherit the token.
+    tasks.emplace_back(pool.execute([&]() {
+      std::vector<ThreadPool::Task> inner_tasks;
+      inner_tasks.emplace_back(pool.execute([&]() {
+        token->cancel();
+        return ThreadPool::check_cancellation();
+      }));
+      if (pool.wait_all(inner_tasks).ok())
+        return Status::Ok();
+      return ThreadPool::check_cancellation();
+    }));
+    CHECK(!pool.wait_all(tasks).ok());
+    CHECK(!ThreadPool::check_cancellation().ok());
+
+    // Tasks of a cancelled token are not run.
+    tasks.clear();
+    for (int i = 0; i < 10; ++i) {
+      tasks.emplace_back(pool.execute([&]() {
+        ++result;
+        return Status::Ok();
+      }));
+    }
+    for (auto& st : pool.wait_all_status(tasks))
+      CHECK(!st.ok());
+  }
+  CHECK(result == 0);
+  CHECK(ThreadPool::check_cancellation().ok());
+
+  // Tasks past the deadline are not run.
+  token = tiledb::common::make_shared<CancellationToken>(HERE());
+  token->set_timeout(1);
+  CHECK(!token->cancel_requested());
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  CHECK(token->deadline_exceeded());
+  tasks.clear();
+  {
+    ThreadPool::ScopedCancellation scoped_cancellation(token);
+    tasks.emplace_back(pool.execute([&]() {
+      ++result;
+      return Status::Ok();
+    }));
+  }
+  CHECK(!pool.wait_all(tasks).ok());
+  CHECK(result == 0);
+
+  token->set_timeout(0);
+  CHECK(!token->cancelled());
+}
+
+TEST_CASE("ThreadPool: Test task graph", "[threadpool]") {
+  ThreadPool io_tp, compute_tp;
+  REQUIRE(io_tp.init(2).ok());
+  REQUIRE(compute_tp.init(4).ok());
+
+  // A chain of stages per batch, alternating between the two pools. Every
+  // stage records the order it ran in, the checks happen afterwards.
+  const uint64_t batch_num = 20, stage_num = 4;
+  std::atomic<uint64_t> clock(0);
+  std::vector<std::atomic<uint64_t>> order(batch_num * stage_num);
+  TaskGraph graph;
+  for (uint64_t b = 0; b < batch_num; ++b) {
+    std::vector<TaskGraph::NodeId> deps;
+    for (uint64_t s = 0; s < stage_num; ++s) {
+      auto& slot = order[b * stage_num + s];
+      auto node = graph.add_node(
+          s % 2 == 0 ? &io_tp : &compute_tp,
+          [&clock, &slot]() {
+            slot = ++clock;
+            return Status::Ok();
+          },
+          deps);
+      deps = {node};
+    }
+  }
+  REQUIRE(graph.run().ok());
+  CHECK(clock == batch_num * stage_num);
+  for (uint64_t b = 0; b < batch_num; ++b) {
+    for (uint64_t s = 1; s < stage_num; ++s)
+      CHECK(order[b * stage_num + s - 1] < order[b * stage_num + s]);
+  }
+  CHECK(!graph.run().ok());
+
+  // A node depending on several ones runs after all of them.
+  TaskGraph join;
+  std::atomic<uint64_t> done(0);
+  std::vector<TaskGraph::NodeId> deps;
+  for (int i = 0; i < 10; ++i) {
+    deps.emplace_back(join.add_node(&compute_tp, [&done]() {
+      ++done;
+      return Status::Ok();
+    }));
+  }
+  std::atomic<uint64_t> seen(0);
+  join.add_node(
+      &io_tp,
+      [&done, &seen]() {
+        seen = done.load();
+        return Status::Ok();
+      },
+      deps);
+  REQUIRE(join.run().ok());
+  CHECK(seen == 10);
+
+  // After a failure, the nodes depending on it are skipped and the error is
+  // returned.
+  TaskGraph failing;
+  std::atomic<uint64_t> result(0);
+  auto a = failing.add_node(&io_tp, []() { return Status_Error("failed"); });
+  auto b = failing.add_node(
+      &compute_tp,
+      [&result]() {
+        ++result;
+        return Status::Ok();
+      },
+      {a});
+  failing.add_node(
+      &io_tp,
+      [&result]() {
+        ++result;
+        return Status::Ok();
+      },
+      {b});
+  CHECK(!failing.run().ok());
+  CHECK(result == 0);
+}
+
+TEST_CASE("ThreadPool: Test affinity", "[threadpool]") {
+  std::vector<ThreadPool::CpuSet> affinity;
+  REQUIRE(ThreadPool::parse_affinity("", &affinity).ok());
+  CHECK(affinity.empty());
+
+  REQUIRE(ThreadPool::parse_affinity("0-2,5", &affinity).ok());
+  CHECK(affinity == std::vector<ThreadPool::CpuSet>{{0}, {1}, {2}, {5}});
+
+  // Every CPU belongs to a single node.
+  REQUIRE(ThreadPool::parse_affinity("numa", &affinity).ok());
+  REQUIRE(!affinity.empty());
+  std::unordered_set<uint64_t> cpus;
+  for (const auto& node : affinity) {
+    CHECK(!node.empty());
+    for (const auto cpu : node)
+      CHECK(cpus.insert(cpu).second);
+  }
+
+  CHECK(!ThreadPool::parse_affinity("2-1", &affinity).ok());
+  CHECK(!ThreadPool::parse_affinity("0,,1", &affinity).ok());
+  CHECK(!ThreadPool::parse_affinity("a", &affinity).ok());
+  CHECK(!ThreadPool::parse_affinity("1-", &affinity).ok());
+
+  // Workers pinned to the CPUs of the NUMA nodes still execute tasks.
+  REQUIRE(ThreadPool::parse_affinity("numa", &affinity).ok());
+  ThreadPool pool;
+  REQUIRE(pool.init(4, affinity).ok());
+  std::atomic<int> result(0);
+  std::vector<ThreadPool::Task> results;
+  for (int i = 0; i < 100; i++) {
+    results.push_back(pool.execute([&result]() {
+      result++;
+      return Status::Ok();
+    }));
+  }
+  CHECK(pool.wait_all(results).ok());
+  CHECK(result == 100);
+}
+
+TEST_CASE("ThreadPool: Test counters", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+
+  // The counters are disabled by default.
+  std::vector<ThreadPool::Task> results;
+  for (int i = 0; i < 10; i++)
+    results.push_back(pool.execute([]() { return Status::Ok(); }));
+  CHECK(pool.wait_all(results).ok());
+  auto counters = pool.take_counters();
+  CHECK(counters.task_submitted_num == 0);
+  CHECK(counters.task_executed_num == 0);
+
+  pool.set_counters_enabled(true);
+  results.clear();
+  for (int i = 0; i < 100; i++) {
+    results.push_back(pool.execute([]() {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      return Status::Ok();
+    }));
+  }
+  CHECK(pool.wait_all(results).ok());
+  counters = pool.take_counters();
+  CHECK(counters.task_submitted_num == 100);
+  CHECK(counters.task_executed_num == 100);
+  CHECK(counters.queue_depth_max >= 1);
+  uint64_t waits = 0;
+  for (const auto bucket : counters.task_wait_histogram)
+    waits += bucket;
+  CHECK(waits == 100);
+  CHECK(counters.worker_busy_ns.size() == 3);
+  CHECK(counters.worker_idle_ns.size() == 3);
+
+  // The counters restart from zero.
+  counters = pool.take_counters();
+  CHECK(counters.task_submitted_num == 0);
+  CHECK(counters.task_executed_num == 0);
+  CHECK(counters.queue_depth_max == 0);
+}
+
+TEST_CASE("ThreadPool: Test tracing", "[threadpool]") {
+  ThreadPool pool;
+  REQUIRE(pool.init(4).ok());
+
+  tracer.reset();
+  tracer.set_enabled(true);
+  {
+    // The tasks inherit the trace id of the thread that schedules them.
+    Tracer::ScopedTraceId trace_id(42);
+    std::vector<ThreadPool::Task> results;
+    for (int i = 0; i < 10; i++)
+      results.push_back(pool.execute([]() {
+        CHECK(Tracer::current_trace_id() == 42);
+        return Status::Ok();
+      }));
+    CHECK(pool.wait_all(results).ok());
+  }
+  tracer.set_enabled(false);
+  CHECK(Tracer::current_trace_id() == 0);
+
+  const std::string trace = tracer.dump();
+  size_t span_num = 0;
+  for (size_t pos = trace.find("\"ThreadPool.task\""); pos != std::string::npos;
+       pos = trace.find("\"ThreadPool.task\"", pos + 1))
+    ++span_num;
+  CHECK(span_num == 10);
+  CHECK(trace.find("\"query\": 42") != std::string::npos);
+  CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+
+  tracer.reset();
+  CHECK(tracer.dump().find("ThreadPool.task") == std::string::npos);
+}
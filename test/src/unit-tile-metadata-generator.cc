@@ -303,6 +303,74 @@ TEMPLATE_LIST_TEST_CASE(
   }
 }
 
+typedef tuple<int8_t, uint16_t, int32_t, uint32_t, int64_t, float>
+    FixedTypesUnderTestBlocks;
+TEMPLATE_LIST_TEST_CASE(
+    "TileMetadataGenerator: fixed data type tile spanning blocks",
+    "[tile-metadata-generator][fixed-data][blocks]",
+    FixedTypesUnderTestBlocks) {
+  typedef TestType T;
+  auto type = tiledb::impl::type_to_tiledb<T>();
+  bool nullable = GENERATE(true, false);
+
+  // Initialize tiles with a number of cells that is not a multiple of the
+  // block size, with the extreme values in the last partial block.
+  uint64_t num_cells = 5000;
+  Tile tile;
+  tile.init_unfiltered(
+      0, (Datatype)type.tiledb_type, num_cells * sizeof(T), sizeof(T), 0, true);
+  auto tile_buff = (T*)tile.data();
+  Tile tile_nullable;
+  tile_nullable.init_unfiltered(0, Datatype::UINT8, num_cells, 1, 0, true);
+  auto nullable_buff = (uint8_t*)tile_nullable.data();
+
+  T correct_min = std::numeric_limits<T>::max();
+  T correct_max = std::numeric_limits<T>::lowest();
+  int64_t correct_sum_int = 0;
+  double correct_sum_double = 0;
+  uint64_t correct_null_count = 0;
+  for (uint64_t i = 0; i < num_cells; i++) {
+    T val = static_cast<T>(i % 100);
+    if (i == num_cells - 4)
+      val = std::numeric_limits<T>::max();
+    if (i == num_cells - 3)
+      val = std::numeric_limits<T>::lowest();
+    const bool valid = !nullable || i % 7 != 0;
+    tile_buff[i] = val;
+    nullable_buff[i] = valid;
+
+    if (valid) {
+      correct_min = std::min(correct_min, val);
+      correct_max = std::max(correct_max, val);
+      if constexpr (std::is_integral_v<T>) {
+        correct_sum_int += (int64_t)val;
+      } else {
+        correct_sum_double += (double)val;
+      }
+    }
+    correct_null_count += !valid;
+  }
+
+  // Call the tile metadata generator.
+  TileMetadataGenerator md_generator(
+      static_cast<Datatype>(type.tiledb_type), false, false, sizeof(T), 1);
+  md_generator.process_tile(
+      &tile, nullptr, nullable ? &tile_nullable : nullptr);
+
+  // Compare the metadata to what's expected.
+  auto&& [min, min_size, max, max_size, sum, nc] = md_generator.metadata();
+  CHECK(*(T*)min == correct_min);
+  CHECK(*(T*)max == correct_max);
+  CHECK(min_size == sizeof(T));
+  CHECK(max_size == sizeof(T));
+  if constexpr (std::is_integral_v<T>) {
+    CHECK(*(int64_t*)sum->data() == correct_sum_int);
+  } else {
+    CHECK(*(double*)sum->data() == correct_sum_double);
+  }
+  CHECK(nc == correct_null_count);
+}
+
 TEST_CASE(
     "TileMetadataGenerator: var data tiles",
     "[tile-metadata-generator][var-data]") {
@@ -408,18 +476,24 @@ TEST_CASE(
     CHECK(min_size == 0);
     CHECK(max_size == 0);
   } else {
+    // Long strings only keep a prefix, with the last byte of the max
+    // incremented.
+    const uint64_t prefix_size = constants::tile_min_max_var_prefix_size;
+    std::string correct_min_value = strings[correct_min].substr(0, prefix_size);
+    std::string correct_max_value = strings[correct_max];
+    if (correct_max_value.size() > prefix_size) {
+      correct_max_value.resize(prefix_size);
+      correct_max_value.back()++;
+    }
+
+    CHECK(min_size == correct_min_value.size());
+    CHECK(max_size == correct_max_value.size());
     CHECK(
-        0 == strncmp(
-                 (const char*)min,
-                 strings[correct_min].c_str(),
-                 strings[correct_min].size()));
+        std::string((const char*)min, min_size) ==
+        correct_min_value.substr(0, min_size));
     CHECK(
-        0 == strncmp(
-                 (const char*)max,
-                 strings[correct_max].c_str(),
-                 strings[correct_max].size()));
-    CHECK(min_size == strings[correct_min].size());
-    CHECK(max_size == strings[correct_max].size());
+        std::string((const char*)max, max_size) ==
+        correct_max_value.substr(0, max_size));
   }
 
   CHECK(*(int64_t*)sum->data() == 0);
@@ -469,4 +543,58 @@ TEST_CASE(
 
   CHECK(*(int64_t*)sum->data() == 0);
   CHECK(nc == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE(
+    "TileMetadataGenerator: var data tiles truncated min/max",
+    "[tile-metadata-generator][var-data][truncated]") {
+  const uint64_t prefix_size = constants::tile_min_max_var_prefix_size;
+
+  // The max prefix ends with 0xFF bytes, which are dropped before the last
+  // byte is incremented.
+  std::string max_value = std::string(prefix_size - 2, 'b') + "\xff\xff" +
+                          std::string(10, 'c');
+  std::string expected_max = std::string(prefix_size - 3, 'b') + "c";
+  std::string min_value(prefix_size + 10, 'a');
+
+  // A max prefix with only 0xFF bytes is kept in full.
+  bool all_ff = GENERATE(true, false);
+  if (all_ff) {
+    max_value = std::string(prefix_size + 1, '\xff');
+    expected_max = max_value;
+  }
+
+  // Initialize offsets tile.
+  Tile offsets_tile;
+  offsets_tile.init_unfiltered(
+      0, Datatype::UINT64, 2 * sizeof(uint64_t), sizeof(uint64_t), 0, true);
+  auto offsets_tile_buff = (uint64_t*)offsets_tile.data();
+  offsets_tile_buff[0] = 0;
+  offsets_tile_buff[1] = max_value.size();
+
+  // Initialize var tile.
+  Tile var_tile;
+  var_tile.init_unfiltered(
+      0,
+      Datatype::CHAR,
+      max_value.size() + min_value.size(),
+      constants::var_num,
+      0,
+      true);
+  auto var_tile_buff = (char*)var_tile.data();
+  memcpy(var_tile_buff, max_value.data(), max_value.size());
+  memcpy(&var_tile_buff[max_value.size()], min_value.data(), min_value.size());
+
+  // Call the tile metadata generator.
+  TileMetadataGenerator md_generator(
+      Datatype::STRING_ASCII, false, true, TILEDB_VAR_NUM, 1);
+  md_generator.process_tile(&offsets_tile, &var_tile, nullptr);
+
+  // Compare the metadata to what's expected.
+  auto&& [min, min_size, max, max_size, sum, nc] = md_generator.metadata();
+  CHECK(
+      std::string((const char*)min, min_size) ==
+      min_value.substr(0, prefix_size));
+  CHECK(std::string((const char*)max, max_size) == expected_max);
+  CHECK(nc == 0);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file   unit-tile-ranges.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests class TileRanges.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/tile_ranges.h"
+
+#include <random>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Consumes all the tile ids of `tile_ranges`. */
+std::vector<uint64_t> consume(TileRanges* tile_ranges) {
+  std::vector<uint64_t> ids;
+  while (!tile_ranges->empty()) {
+    ids.emplace_back(tile_ranges->front());
+    tile_ranges->pop_front();
+  }
+  return ids;
+}
+
+}  // namespace
+
+TEST_CASE("TileRanges: Test runs", "[tile-ranges]") {
+  TileRanges tile_ranges;
+  CHECK(tile_ranges.empty());
+  CHECK(tile_ranges.memory_usage() == 0);
+
+  // Ranges across a block boundary, including adjacent ones.
+  tile_ranges.add_range(3, 5);
+  tile_ranges.add_range(6, 6);
+  tile_ranges.add_range(10, 10);
+  tile_ranges.add_range(
+      TileRanges::BLOCK_SIZE - 2, TileRanges::BLOCK_SIZE + 1);
+  tile_ranges.add_range(5 * TileRanges::BLOCK_SIZE, 5 * TileRanges::BLOCK_SIZE);
+  tile_ranges.shrink_to_fit();
+  CHECK(!tile_ranges.empty());
+  CHECK(tile_ranges.front() == 3);
+  CHECK(tile_ranges.back() == 5 * TileRanges::BLOCK_SIZE);
+  CHECK(tile_ranges.memory_usage() > 0);
+
+  const std::vector<uint64_t> expected = {3,
+                                          4,
+                                          5,
+                                          6,
+                                          10,
+                                          TileRanges::BLOCK_SIZE - 2,
+                                          TileRanges::BLOCK_SIZE - 1,
+                                          TileRanges::BLOCK_SIZE,
+                                          TileRanges::BLOCK_SIZE + 1,
+                                          5 * TileRanges::BLOCK_SIZE};
+  CHECK(consume(&tile_ranges) == expected);
+  CHECK(tile_ranges.memory_usage() == 0);
+}
+
+TEST_CASE("TileRanges: Test bitmap blocks", "[tile-ranges]") {
+  // Many short ranges switch the blocks to bitmaps, which bound the memory
+  // used to one bit per tile.
+  const uint64_t tile_num = 3 * TileRanges::BLOCK_SIZE + 100;
+  std::mt19937_64 gen(0xdeadbeef);
+  std::vector<uint64_t> expected;
+  TileRanges tile_ranges;
+  uint64_t start = 1;
+  uint64_t range_num = 0;
+  while (start < tile_num) {
+    const uint64_t end = std::min(tile_num - 1, start + gen() % 3);
+    tile_ranges.add_range(start, end);
+    for (uint64_t t = start; t <= end; t++)
+      expected.emplace_back(t);
+    start = end + 2 + gen() % 2;
+    range_num++;
+  }
+
+  tile_ranges.shrink_to_fit();
+  CHECK(tile_ranges.memory_usage() < tile_num / 4);
+  CHECK(
+      tile_ranges.memory_usage() <
+      range_num * sizeof(std::pair<uint64_t, uint64_t>) / 16);
+  CHECK(tile_ranges.back() == expected.back());
+
+  // Consuming releases the blocks one at a time.
+  uint64_t memory_usage = tile_ranges.memory_usage();
+  uint64_t releases = 0;
+  std::vector<uint64_t> ids;
+  while (!tile_ranges.empty()) {
+    ids.emplace_back(tile_ranges.front());
+    tile_ranges.pop_front();
+    if (tile_ranges.memory_usage() < memory_usage)
+      releases++;
+    memory_usage = tile_ranges.memory_usage();
+  }
+  CHECK(ids == expected);
+  CHECK(releases == 4);
+  CHECK(memory_usage == 0);
+}
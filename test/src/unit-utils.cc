@@ -31,6 +31,8 @@
  */
 
 #include <catch.hpp>
+#include <thread>
+#include "tiledb/common/logger_public.h"
 #include "tiledb/sm/misc/math.h"
 #include "tiledb/sm/misc/utils.h"
 
@@ -77,4 +79,28 @@ TEST_CASE("Utils: Test right_p2_m1", "[utils][right_p2_m1]") {
   CHECK(math::right_p2_m1(16) == 31);
   CHECK(math::right_p2_m1(UINT64_MAX) == UINT64_MAX);
   CHECK(math::right_p2_m1(UINT64_MAX - 1) == UINT64_MAX);
-}
\ No newline at end of file
+}
+TEST_CASE("Utils: Test LogRateLimiter", "[utils][log_rate_limiter]") {
+  uint64_t suppressed = 100;
+
+  // The first statement goes through, the next ones within the period don't.
+  tiledb::common::LogRateLimiter limiter(50);
+  CHECK(limiter.allow(&suppressed));
+  CHECK(suppressed == 0);
+  CHECK(!limiter.allow(&suppressed));
+  CHECK(!limiter.allow(&suppressed));
+  CHECK(!limiter.allow(&suppressed));
+
+  // After the period, the held back statements are reported.
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  CHECK(limiter.allow(&suppressed));
+  CHECK(suppressed == 3);
+  CHECK(!limiter.allow(&suppressed));
+
+  // A zero period lets everything through.
+  tiledb::common::LogRateLimiter no_limit(0);
+  for (int i = 0; i < 10; ++i) {
+    CHECK(no_limit.allow(&suppressed));
+    CHECK(suppressed == 0);
+  }
+}
@@ -55,6 +55,16 @@ TEST_CASE("UUID: Test generate", "[uuid]") {
 
     REQUIRE(uuid::generate_uuid(&uuid2, false).ok());
     REQUIRE(uuid2.length() == 32);
+
+    // Version 4, variant 1.
+    for (const auto& uuid : {uuid0, uuid1}) {
+      CHECK(uuid[8] == '-');
+      CHECK(uuid[13] == '-');
+      CHECK(uuid[14] == '4');
+      CHECK(uuid[18] == '-');
+      CHECK(std::string("89ab").find(uuid[19]) != std::string::npos);
+      CHECK(uuid[23] == '-');
+    }
   }
 
   SECTION("- Threaded") {
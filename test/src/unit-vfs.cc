@@ -32,7 +32,10 @@
 
 #include <atomic>
 #include <catch.hpp>
+#include <cstring>
+#include <thread>
 #include "test/src/helpers.h"
+#include "tiledb/sm/filesystem/mem_filesystem.h"
 #include "tiledb/sm/filesystem/vfs.h"
 
 using namespace tiledb::common;
@@ -171,6 +174,209 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     REQUIRE(vfs->terminate().ok());
   }
 
+  SECTION("- Region callbacks") {
+    // Every region is handed over once its data is in place.
+    Config vfs_config;
+    vfs_config.set("vfs.min_batch_size", "0");
+    vfs_config.set("vfs.min_batch_gap", "0");
+    REQUIRE(
+        vfs->init(&g_helper_stats, &compute_tp, &io_tp, nullptr, &vfs_config)
+            .ok());
+    for (unsigned i = 0; i < nelts; i += 10) {
+      std::memset(
+          tile[i].filtered_buffer().data(), 0, nelts * sizeof(uint32_t));
+      batches.emplace_back(i * sizeof(uint32_t), &tile[i], sizeof(uint32_t));
+    }
+    std::atomic<uint64_t> num_read(0);
+    std::atomic<bool> in_place(true);
+    auto on_region_read = [&](Tile* t) {
+      const uint64_t i = t - tile;
+      if (t->filtered_buffer().data_as<uint32_t>()[0] != i)
+        in_place = false;
+      num_read++;
+      return Status::Ok();
+    };
+    REQUIRE(vfs->read_all(
+                   testfile, batches, &io_tp, &tasks, true, on_region_read)
+                .ok());
+    REQUIRE(io_tp.wait_all(tasks).ok());
+    tasks.clear();
+    CHECK(num_read == batches.size());
+    CHECK(in_place);
+    REQUIRE(vfs->terminate().ok());
+  }
+
+  SECTION("- io_uring and overlapped I/O") {
+    // Read every other element as its own batch, plus a batch of several
+    // regions, with a single submission when io_uring is available, or as
+    // overlapped reads on Windows.
+    Config default_config, vfs_config;
+    vfs_config.set("vfs.min_batch_size", "0");
+    vfs_config.set("vfs.min_batch_gap", "0");
+    vfs_config.set("vfs.file.io_uring", "true");
+    vfs_config.set("vfs.file.overlapped_io", "true");
+    REQUIRE(vfs->init(
+                   &g_helper_stats,
+                   &compute_tp,
+                   &io_tp,
+                   &default_config,
+                   &vfs_config)
+                .ok());
+
+    batches.clear();
+    for (unsigned i = 0; i < nelts / 2; i++) {
+      std::memset(
+          tile[i].filtered_buffer().data(), 0, nelts * sizeof(uint32_t));
+      batches.emplace_back(
+          2 * i * sizeof(uint32_t), &tile[i], sizeof(uint32_t));
+    }
+    REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(io_tp.wait_all(tasks).ok());
+    tasks.clear();
+    for (unsigned i = 0; i < nelts / 2; i++) {
+      REQUIRE(tile[i].filtered_buffer().data_as<uint32_t>()[0] == 2 * i);
+    }
+
+    // Adjacent regions are batched together and copied back.
+    batches.clear();
+    for (unsigned i = 0; i < nelts; i++) {
+      std::memset(
+          tile[i].filtered_buffer().data(), 0, nelts * sizeof(uint32_t));
+      batches.emplace_back(i * sizeof(uint32_t), &tile[i], sizeof(uint32_t));
+    }
+    REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(io_tp.wait_all(tasks).ok());
+    tasks.clear();
+    for (unsigned i = 0; i < nelts; i++) {
+      REQUIRE(tile[i].filtered_buffer().data_as<uint32_t>()[0] == i);
+    }
+
+    // Reading past the end of the file fails.
+    batches.clear();
+    batches.emplace_back(
+        (nelts - 1) * sizeof(uint32_t), &tile[0], 2 * sizeof(uint32_t));
+    REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(!io_tp.wait_all(tasks).ok());
+    tasks.clear();
+    REQUIRE(vfs->terminate().ok());
+  }
+
+  SECTION("- Direct I/O") {
+    // Unaligned regions are read from block boundaries, bypassing the page
+    // cache where the file system supports it.
+    Config default_config, vfs_config;
+    vfs_config.set("vfs.min_batch_size", "0");
+    vfs_config.set("vfs.min_batch_gap", "0");
+    vfs_config.set("vfs.file.direct_io", "true");
+    REQUIRE(vfs->init(
+                   &g_helper_stats,
+                   &compute_tp,
+                   &io_tp,
+                   &default_config,
+                   &vfs_config)
+                .ok());
+
+    batches.clear();
+    for (unsigned i = 0; i < nelts / 2; i++) {
+      std::memset(
+          tile[i].filtered_buffer().data(), 0, nelts * sizeof(uint32_t));
+      batches.emplace_back(
+          (2 * i + 1) * sizeof(uint32_t), &tile[i], sizeof(uint32_t));
+    }
+    REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(io_tp.wait_all(tasks).ok());
+    tasks.clear();
+    for (unsigned i = 0; i < nelts / 2; i++) {
+      REQUIRE(tile[i].filtered_buffer().data_as<uint32_t>()[0] == 2 * i + 1);
+    }
+
+    // Direct reads into unaligned buffers.
+    uint32_t data_read[nelts];
+    REQUIRE(vfs->read(
+                   testfile,
+                   sizeof(uint32_t),
+                   &data_read[1],
+                   (nelts - 1) * sizeof(uint32_t))
+                .ok());
+    for (unsigned i = 1; i < nelts; i++) {
+      REQUIRE(data_read[i] == i);
+    }
+    REQUIRE(vfs->terminate().ok());
+  }
+
+  SECTION("- Memory mapping") {
+    // Regions are served as views of a mapping of the file, without tasks.
+    Config default_config, vfs_config;
+    vfs_config.set("vfs.file.mmap", "true");
+    REQUIRE(vfs->init(
+                   &g_helper_stats,
+                   &compute_tp,
+                   &io_tp,
+                   &default_config,
+                   &vfs_config)
+                .ok());
+
+    batches.clear();
+    for (unsigned i = 0; i < nelts; i++) {
+      tile[i].filtered_buffer().clear();
+      batches.emplace_back(i * sizeof(uint32_t), &tile[i], sizeof(uint32_t));
+    }
+    REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(tasks.empty());
+    for (unsigned i = 0; i < nelts; i++) {
+      REQUIRE(tile[i].filtered_buffer().size() == sizeof(uint32_t));
+      REQUIRE(tile[i].filtered_buffer().data_as<uint32_t>()[0] == i);
+    }
+
+    // The views keep the mapping alive after it is dropped.
+    vfs->unmap_files(testfile);
+    for (unsigned i = 0; i < nelts; i++) {
+      REQUIRE(tile[i].filtered_buffer().data_as<uint32_t>()[0] == i);
+    }
+
+    // Reading past the end of the file fails.
+    batches.clear();
+    batches.emplace_back(
+        (nelts - 1) * sizeof(uint32_t), &tile[0], 2 * sizeof(uint32_t));
+    REQUIRE(!vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+    REQUIRE(vfs->terminate().ok());
+  }
+
+  SECTION("- Adaptive batch gap") {
+    // Reads of varying sizes feed the cost estimates, after which the gap
+    // is derived from them. The results are the same either way.
+    Config default_config, vfs_config;
+    vfs_config.set("vfs.min_batch_size", "0");
+    vfs_config.set("vfs.adaptive_batch_gap", "true");
+    REQUIRE(vfs->init(
+                   &g_helper_stats,
+                   &compute_tp,
+                   &io_tp,
+                   &default_config,
+                   &vfs_config)
+                .ok());
+
+    for (unsigned n = 1; n <= 20; n++) {
+      batches.clear();
+      for (unsigned i = 0; i < nelts / n; i++) {
+        std::memset(
+            tile[i].filtered_buffer().data(), 0, nelts * sizeof(uint32_t));
+        batches.emplace_back(
+            i * n * sizeof(uint32_t), &tile[i], n * sizeof(uint32_t));
+      }
+      REQUIRE(vfs->read_all(testfile, batches, &io_tp, &tasks).ok());
+      REQUIRE(io_tp.wait_all(tasks).ok());
+      tasks.clear();
+      for (unsigned i = 0; i < nelts / n; i++) {
+        for (unsigned j = 0; j < n; j++) {
+          REQUIRE(
+              tile[i].filtered_buffer().data_as<uint32_t>()[j] == i * n + j);
+        }
+      }
+    }
+    REQUIRE(vfs->terminate().ok());
+  }
+
   SECTION("- Reduce min batch size but not min batch gap") {
     // Set a smaller min batch size
     Config default_config, vfs_config;
@@ -346,6 +552,70 @@ TEST_CASE("VFS: Test long posix paths", "[vfs]") {
   REQUIRE(vfs->terminate().ok());
 }
 
+TEST_CASE("VFS: Test posix group commit", "[vfs]") {
+  ThreadPool compute_tp;
+  ThreadPool io_tp;
+  REQUIRE(compute_tp.init(4).ok());
+  REQUIRE(io_tp.init(4).ok());
+
+  Config vfs_config;
+  REQUIRE(vfs_config.set("vfs.file.group_commit", "true").ok());
+  std::unique_ptr<VFS> vfs(new VFS);
+  REQUIRE(
+      vfs->init(&g_helper_stats, &compute_tp, &io_tp, nullptr, &vfs_config)
+          .ok());
+
+  URI base("file://" + Posix::current_dir() + "/tiledb_test_group_commit/");
+  bool exists = false;
+  REQUIRE(vfs->is_dir(base, &exists).ok());
+  if (exists)
+    REQUIRE(vfs->remove_dir(base).ok());
+  REQUIRE(vfs->create_dir(base).ok());
+
+  // Close a few files in each of several groups, one of which is removed
+  // with its syncs still pending
+  const int group_num = 4;
+  std::vector<URI> dirs;
+  const std::string data = "group commit";
+  for (int i = 0; i < group_num + 1; ++i) {
+    URI dir = base.join_path("frag" + std::to_string(i));
+    REQUIRE(vfs->create_dir(dir).ok());
+    REQUIRE(vfs->begin_group_commit(dir).ok());
+    for (int j = 0; j < 3; ++j) {
+      URI file = dir.join_path("file" + std::to_string(j));
+      REQUIRE(vfs->write(file, data.data(), data.size()).ok());
+      REQUIRE(vfs->close_file(file).ok());
+    }
+    dirs.push_back(dir);
+  }
+  REQUIRE(vfs->remove_dir(dirs.back()).ok());
+  dirs.pop_back();
+
+  // Commit the groups concurrently
+  std::vector<std::thread> threads;
+  std::atomic<int> failed(0);
+  for (const auto& dir : dirs)
+    threads.emplace_back([&, dir]() {
+      if (!vfs->commit_group(dir).ok())
+        ++failed;
+    });
+  for (auto& t : threads)
+    t.join();
+  CHECK(failed == 0);
+
+  // The files are intact, and syncs are no longer deferred after a commit
+  for (const auto& dir : dirs) {
+    uint64_t size = 0;
+    REQUIRE(vfs->file_size(dir.join_path("file0"), &size).ok());
+    CHECK(size == data.size());
+    REQUIRE(vfs->sync(dir.join_path("file1")).ok());
+    REQUIRE(vfs->commit_group(dir).ok());
+  }
+
+  REQUIRE(vfs->remove_dir(base).ok());
+  REQUIRE(vfs->terminate().ok());
+}
+
 #endif
 
 TEST_CASE("VFS: URI semantics", "[vfs][uri]") {
@@ -498,3 +768,122 @@ TEST_CASE("VFS: URI semantics", "[vfs][uri]") {
     vfs.terminate();
   }
 }
+
+TEST_CASE("VFS: Test batched removal", "[vfs]") {
+  ThreadPool compute_tp;
+  ThreadPool io_tp;
+  REQUIRE(compute_tp.init(4).ok());
+  REQUIRE(io_tp.init(4).ok());
+
+  std::unique_ptr<VFS> vfs(new VFS);
+  REQUIRE(
+      vfs->init(&g_helper_stats, &compute_tp, &io_tp, nullptr, nullptr).ok());
+
+  URI base("mem://tiledb_test_remove/");
+  REQUIRE(vfs->create_dir(base).ok());
+
+  // Create directories with a few files each, and files next to them
+  std::vector<URI> dirs, files;
+  for (int i = 0; i < 10; ++i) {
+    URI dir = base.join_path("dir" + std::to_string(i));
+    REQUIRE(vfs->create_dir(dir).ok());
+    for (int j = 0; j < 3; ++j)
+      REQUIRE(vfs->touch(dir.join_path("file" + std::to_string(j))).ok());
+    dirs.push_back(dir);
+    files.push_back(base.join_path("file" + std::to_string(i)));
+    REQUIRE(vfs->touch(files.back()).ok());
+  }
+
+  REQUIRE(vfs->remove_dirs(dirs).ok());
+  REQUIRE(vfs->remove_files(files).ok());
+  REQUIRE(vfs->remove_files({}).ok());
+
+  std::vector<URI> children;
+  REQUIRE(vfs->ls(base, &children).ok());
+  CHECK(children.empty());
+
+  REQUIRE(vfs->remove_dir(base).ok());
+  REQUIRE(vfs->terminate().ok());
+}
+
+TEST_CASE("VFS: Test memfs views", "[vfs][memfs]") {
+  MemFilesystem memfs;
+  REQUIRE(memfs.create_dir("/dir").ok());
+
+  // Write two appends, viewing the first one in between
+  std::vector<char> first(100), second(1000);
+  for (size_t i = 0; i < first.size(); i++)
+    first[i] = static_cast<char>(i);
+  for (size_t i = 0; i < second.size(); i++)
+    second[i] = static_cast<char>(i * 7);
+  REQUIRE(memfs.write("/dir/file", first.data(), first.size()).ok());
+  char* data;
+  std::shared_ptr<void> owner;
+  REQUIRE(memfs.view("/dir/file", 10, 50, &data, &owner).ok());
+  REQUIRE(memfs.write("/dir/file", second.data(), second.size()).ok());
+  CHECK(std::memcmp(data, first.data() + 10, 50) == 0);
+
+  // Ranges within an append are viewed in place, across appends copied
+  char* data2;
+  std::shared_ptr<void> owner2;
+  REQUIRE(memfs.view("/dir/file", 0, 10, &data2, &owner2).ok());
+  CHECK(data2 == data - 10);
+  REQUIRE(memfs.view("/dir/file", 90, 20, &data2, &owner2).ok());
+  CHECK(std::memcmp(data2, first.data() + 90, 10) == 0);
+  CHECK(std::memcmp(data2 + 10, second.data(), 10) == 0);
+  CHECK(!memfs.view("/dir/file", 1000, 101, &data2, &owner2).ok());
+  CHECK(!memfs.view("/dir", 0, 1, &data2, &owner2).ok());
+
+  // Reads across appends
+  std::vector<char> all(first.size() + second.size());
+  REQUIRE(memfs.read("/dir/file", 0, all.data(), all.size()).ok());
+  CHECK(std::memcmp(all.data(), first.data(), first.size()) == 0);
+  CHECK(
+      std::memcmp(all.data() + first.size(), second.data(), second.size()) ==
+      0);
+
+  // Views outlive the file
+  REQUIRE(memfs.remove("/dir/file", false).ok());
+  CHECK(!memfs.is_file("/dir/file"));
+  CHECK(std::memcmp(data, first.data() + 10, 50) == 0);
+  REQUIRE(memfs.remove("/dir", true).ok());
+}
+
+TEST_CASE("VFS: Test memfs concurrent access", "[vfs][memfs]") {
+  MemFilesystem memfs;
+  REQUIRE(memfs.create_dir("/dir").ok());
+  const int thread_num = 8;
+  const int file_num = 50;
+  std::atomic<int> errors(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      const std::string dir = "/dir/t" + std::to_string(t);
+      if (!memfs.create_dir(dir).ok())
+        ++errors;
+      for (int f = 0; f < file_num; f++) {
+        const std::string file = dir + "/f" + std::to_string(f);
+        const int value = t * file_num + f;
+        int read_value = -1;
+        uint64_t size = 0;
+        if (!memfs.write(file, &value, sizeof(value)).ok() ||
+            !memfs.file_size(file, &size).ok() || size != sizeof(value) ||
+            !memfs.read(file, 0, &read_value, sizeof(value)).ok() ||
+            read_value != value)
+          ++errors;
+        std::vector<std::string> paths;
+        if (!memfs.ls("/dir", &paths).ok())
+          ++errors;
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  CHECK(errors == 0);
+
+  std::vector<std::string> paths;
+  REQUIRE(memfs.ls("/dir", &paths).ok());
+  CHECK(paths.size() == thread_num);
+  REQUIRE(memfs.ls("/dir/t0", &paths).ok());
+  CHECK(paths.size() == file_num);
+}
@@ -32,12 +32,92 @@
 #include "governor.h"
 #include "tiledb/common/heap_profiler.h"
 
+#include <algorithm>
+
 namespace tiledb::common {
 
 void Governor::memory_panic() {
   heap_profiler.dump_and_terminate();
 }
 
+Governor::Governor(const uint64_t budget)
+    : budget_(budget)
+    , reserved_(0) {
+}
+
+void Governor::add_reclaimer(UsageFn usage, ShedFn shed) {
+  std::lock_guard<std::mutex> lg(mtx_);
+  reclaimers_.push_back({std::move(usage), std::move(shed)});
+}
+
+uint64_t Governor::reserve(
+    const uint64_t size,
+    const uint64_t min_size,
+    const std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> ul(mtx_);
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true) {
+    const uint64_t avail = available(size);
+    if (avail > 0 && avail >= min_size) {
+      const uint64_t granted = std::min(size, avail);
+      reserved_ += granted;
+      return granted;
+    }
+
+    if (std::chrono::steady_clock::now() >= deadline)
+      return 0;
+    cv_.wait_until(ul, deadline);
+  }
+}
+
+bool Governor::try_reserve(const uint64_t size) {
+  std::lock_guard<std::mutex> lg(mtx_);
+  if (available(size) < size)
+    return false;
+
+  reserved_ += size;
+  return true;
+}
+
+void Governor::release(const uint64_t size) {
+  {
+    std::lock_guard<std::mutex> lg(mtx_);
+    reserved_ -= std::min(size, reserved_);
+  }
+  cv_.notify_all();
+}
+
+uint64_t Governor::budget() const {
+  return budget_;
+}
+
+uint64_t Governor::reserved() {
+  std::lock_guard<std::mutex> lg(mtx_);
+  return reserved_;
+}
+
+uint64_t Governor::available(const uint64_t size) {
+  auto in_use = [this]() {
+    uint64_t used = reserved_;
+    for (auto& reclaimer : reclaimers_)
+      used += reclaimer.usage_();
+    return used;
+  };
+
+  uint64_t used = in_use();
+  if (used + size > budget_ && !reclaimers_.empty()) {
+    // Shed the reclaimers first, in registration order.
+    for (auto& reclaimer : reclaimers_) {
+      if (used + size <= budget_)
+        break;
+      reclaimer.shed_(used + size - budget_);
+      used = in_use();
+    }
+  }
+
+  return used >= budget_ ? 0 : budget_ - used;
+}
+
 }  // namespace tiledb::common
 
 /*
@@ -32,6 +32,13 @@
 #ifndef TILEDB_COMMON_GOVERNOR_H
 #define TILEDB_COMMON_GOVERNOR_H
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 namespace tiledb::common {
 
 /**
@@ -40,17 +47,123 @@ namespace tiledb::common {
  * 1. Execution resources. The governor may revoke permission to execute, which
  *    allows orderly shutdown of threads. This allows for recovery from
  *    otherwise-unrecoverable conditions such as memory exhaustion.
- * 2. Memory resources.
+ * 2. Memory resources. An instance of the governor brokers a memory budget
+ *    shared by all the queries of a context. Queries reserve memory before
+ *    using it and release it when done. When the budget is exhausted, the
+ *    registered reclaimers, e.g. caches, are asked to shed memory first;
+ *    queries then receive less than they asked for, or wait for memory to
+ *    be released.
  *
- * Currently the governor is a stub with minimal functionality. It only has the
- * ability to receive a signal about memory exhaustion.
+ * The memory broker is thread-safe.
  */
 class Governor {
  public:
+  /**
+   * Returns the memory a reclaimer holds and may shed. Called with the lock
+   * of the governor held, so it must not call back into the governor.
+   */
+  typedef std::function<uint64_t()> UsageFn;
+
+  /**
+   * Asks a reclaimer to shed at least the given number of bytes, if it can.
+   * Called with the lock of the governor held, so it must not call back into
+   * the governor.
+   */
+  typedef std::function<void(uint64_t)> ShedFn;
+
+  /**
+   * Constructor.
+   *
+   * @param budget The memory budget brokered by the governor.
+   */
+  explicit Governor(uint64_t budget);
+
+  /** Destructor. */
+  ~Governor() = default;
+
+  Governor(const Governor&) = delete;
+  Governor& operator=(const Governor&) = delete;
+
   /**
    * Signal to the governor that the system is out of memory.
    */
   static void memory_panic();
+
+  /**
+   * Registers a holder of memory that can be shed when the budget is
+   * exhausted. Its usage counts against the budget.
+   *
+   * @param usage Returns the memory held by the reclaimer.
+   * @param shed Sheds memory.
+   */
+  void add_reclaimer(UsageFn usage, ShedFn shed);
+
+  /**
+   * Reserves memory, shedding the reclaimers if needed. Grants `size` bytes
+   * if available, or else as much as is available if that is at least
+   * `min_size`. Otherwise, waits for memory to be released for up to
+   * `timeout`.
+   *
+   * @param size The memory size requested.
+   * @param min_size The smallest memory size acceptable.
+   * @param timeout How long to wait for `min_size` bytes to be available.
+   * @return The memory size granted, or 0 if not even `min_size` bytes could
+   *     be reserved.
+   */
+  uint64_t reserve(
+      uint64_t size, uint64_t min_size, std::chrono::milliseconds timeout);
+
+  /**
+   * Reserves exactly `size` bytes without waiting.
+   *
+   * @param size The memory size.
+   * @return `true` if the memory was reserved.
+   */
+  bool try_reserve(uint64_t size);
+
+  /**
+   * Releases memory previously reserved.
+   *
+   * @param size The memory size.
+   */
+  void release(uint64_t size);
+
+  /** Returns the memory budget. */
+  uint64_t budget() const;
+
+  /** Returns the memory currently reserved. */
+  uint64_t reserved();
+
+ private:
+  /** A holder of memory that can be shed. */
+  struct Reclaimer {
+    /** Returns the memory held. */
+    UsageFn usage_;
+
+    /** Sheds memory. */
+    ShedFn shed_;
+  };
+
+  /** The memory budget. */
+  const uint64_t budget_;
+
+  /** The memory currently reserved. */
+  uint64_t reserved_;
+
+  /** The registered reclaimers. */
+  std::vector<Reclaimer> reclaimers_;
+
+  /** Protects `reserved_` and `reclaimers_`. */
+  std::mutex mtx_;
+
+  /** Signaled when memory is released. */
+  std::condition_variable cv_;
+
+  /**
+   * Returns the memory available, shedding the reclaimers first if less
+   * than `size` bytes are. Must be called with `mtx_` held.
+   */
+  uint64_t available(uint64_t size);
 };
 
 }  // namespace tiledb::common
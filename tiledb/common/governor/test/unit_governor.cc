@@ -0,0 +1,84 @@
+/**
+ * @file tiledb/common/governor/test/unit_governor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the memory broker of class Governor.
+ */
+
+#include <catch.hpp>
+#include <thread>
+
+#include "../governor.h"
+
+using namespace tiledb::common;
+using namespace std::chrono_literals;
+
+TEST_CASE("Governor: reserve and release", "[governor]") {
+  Governor governor(1000);
+  CHECK(governor.budget() == 1000);
+
+  // A reservation is granted in full when the memory is available.
+  CHECK(governor.reserve(600, 100, 0ms) == 600);
+  CHECK(governor.reserved() == 600);
+
+  // A reservation shrinks to the memory available, down to its minimum.
+  CHECK(governor.reserve(600, 100, 0ms) == 400);
+  CHECK(governor.reserve(600, 100, 0ms) == 0);
+  CHECK(!governor.try_reserve(1));
+
+  governor.release(400);
+  CHECK(governor.try_reserve(400));
+  governor.release(1000);
+  CHECK(governor.reserved() == 0);
+}
+
+TEST_CASE("Governor: wait for release", "[governor]") {
+  Governor governor(1000);
+  CHECK(governor.reserve(1000, 1000, 0ms) == 1000);
+
+  std::thread releaser([&governor]() {
+    std::this_thread::sleep_for(10ms);
+    governor.release(500);
+  });
+  CHECK(governor.reserve(800, 400, 10s) == 500);
+  releaser.join();
+}
+
+TEST_CASE("Governor: reclaimers shed first", "[governor]") {
+  Governor governor(1000);
+  uint64_t cached = 700;
+  governor.add_reclaimer(
+      [&cached]() { return cached; },
+      [&cached](uint64_t nbytes) { cached -= std::min(cached, nbytes); });
+
+  // The reclaimer usage counts against the budget and is shed on demand.
+  CHECK(governor.reserve(200, 200, 0ms) == 200);
+  CHECK(cached == 700);
+  CHECK(governor.reserve(500, 500, 0ms) == 500);
+  CHECK(cached == 300);
+}
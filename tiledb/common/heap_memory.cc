@@ -44,7 +44,10 @@ std::recursive_mutex __tdb_heap_mem_lock;
 
 void* tiledb_malloc(const size_t size, const std::string& label) {
   if (!heap_profiler.enabled()) {
-    return std::malloc(size);
+    void* const p = std::malloc(size);
+    if (p && heap_profiler.sample(size))
+      heap_profiler.record_sampled_alloc(p, size, label);
+    return p;
   }
 
   std::unique_lock<std::recursive_mutex> ul(__tdb_heap_mem_lock);
@@ -62,7 +65,10 @@ void* tiledb_malloc(const size_t size, const std::string& label) {
 void* tiledb_calloc(
     const size_t num, const size_t size, const std::string& label) {
   if (!heap_profiler.enabled()) {
-    return std::calloc(num, size);
+    void* const p = std::calloc(num, size);
+    if (p && heap_profiler.sample(num * size))
+      heap_profiler.record_sampled_alloc(p, num * size, label);
+    return p;
   }
 
   std::unique_lock<std::recursive_mutex> ul(__tdb_heap_mem_lock);
@@ -80,7 +86,14 @@ void* tiledb_calloc(
 void* tiledb_realloc(
     void* const p, const size_t size, const std::string& label) {
   if (!heap_profiler.enabled()) {
-    return std::realloc(p, size);
+    // The old allocation must be forgotten before it is released, another
+    // thread could otherwise be handed its address first.
+    if (p && heap_profiler.sampling())
+      heap_profiler.record_sampled_dealloc(p);
+    void* const p_realloc = std::realloc(p, size);
+    if (p_realloc && heap_profiler.sample(size))
+      heap_profiler.record_sampled_alloc(p_realloc, size, label);
+    return p_realloc;
   }
 
   std::unique_lock<std::recursive_mutex> ul(__tdb_heap_mem_lock);
@@ -98,6 +111,8 @@ void* tiledb_realloc(
 
 void tiledb_free(void* const p) {
   if (!heap_profiler.enabled()) {
+    if (heap_profiler.sampling())
+      heap_profiler.record_sampled_dealloc(p);
     free(p);
     return;
   }
@@ -29,7 +29,9 @@
  *
  * Defines TileDB-variants of dynamic (heap) memory allocation routines. When
  * the global `heap_profiler` is enabled, these routines will record memory
- * stats. Should allocation fail, stats will print and exit the program.
+ * stats. Should allocation fail, stats will print and exit the program. When
+ * the profiler samples, a fraction of the allocations are recorded without
+ * taking `__tdb_heap_mem_lock`.
  */
 
 #ifndef TILEDB_HEAP_MEMORY_H
@@ -63,7 +65,10 @@ void tiledb_free(void* p);
 template <typename T, typename... Args>
 T* tiledb_new(const std::string& label, Args&&... args) {
   if (!heap_profiler.enabled()) {
-    return new T(std::forward<Args>(args)...);
+    T* const p = new T(std::forward<Args>(args)...);
+    if (heap_profiler.sample(sizeof(T)))
+      heap_profiler.record_sampled_alloc(p, sizeof(T), label);
+    return p;
   }
 
   std::unique_lock<std::recursive_mutex> ul(__tdb_heap_mem_lock);
@@ -82,6 +87,8 @@ T* tiledb_new(const std::string& label, Args&&... args) {
 template <typename T>
 void tiledb_delete(T* const p) {
   if (!heap_profiler.enabled()) {
+    if (heap_profiler.sampling())
+      heap_profiler.record_sampled_dealloc(p);
     delete p;
     return;
   }
@@ -96,7 +103,10 @@ void tiledb_delete(T* const p) {
 template <typename T>
 T* tiledb_new_array(const std::size_t size, const std::string& label) {
   if (!heap_profiler.enabled()) {
-    return new T[size];
+    T* const p = new T[size];
+    if (heap_profiler.sample(sizeof(T) * size))
+      heap_profiler.record_sampled_alloc(p, sizeof(T) * size, label);
+    return p;
   }
 
   std::unique_lock<std::recursive_mutex> ul(__tdb_heap_mem_lock);
@@ -115,6 +125,8 @@ T* tiledb_new_array(const std::size_t size, const std::string& label) {
 template <typename T>
 void tiledb_delete_array(T* const p) {
   if (!heap_profiler.enabled()) {
+    if (heap_profiler.sampling())
+      heap_profiler.record_sampled_dealloc(p);
     delete[] p;
     return;
   }
@@ -30,8 +30,17 @@
  * This file contains the implementation of the HeapProfiler class.
  */
 
+#include <cmath>
 #include <fstream>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <random>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <execinfo.h>
+#define TILEDB_HEAP_PROFILER_BACKTRACE
+#endif
 
 #include "tiledb/common/heap_profiler.h"
 
@@ -53,12 +62,19 @@ void failed_cpp_alloc_cb() {
 HeapProfiler::HeapProfiler()
     : dump_interval_ms_(0)
     , dump_interval_bytes_(0)
+    , dump_threshold_bytes_(0)
     , reserved_memory_(nullptr)
     , num_allocs_(0)
     , num_deallocs_(0)
     , num_alloc_bytes_(0)
     , num_dealloc_bytes_(0)
-    , last_interval_dump_alloc_bytes_(0) {
+    , last_interval_dump_alloc_bytes_(0)
+    , sample_interval_bytes_(0)
+    , budget_bytes_(0)
+    , budget_dumped_(false)
+    , sampled_inuse_estimate_(0) {
+  for (auto& count : sampled_addr_filter_)
+    count.store(0, std::memory_order_relaxed);
 }
 
 HeapProfiler::~HeapProfiler() {
@@ -104,6 +120,92 @@ void HeapProfiler::enable(
   std::set_new_handler(failed_cpp_alloc_cb);
 }
 
+void HeapProfiler::enable_sampling(
+    const std::string& file_name_prefix,
+    const uint64_t sample_interval_bytes,
+    const uint64_t budget_bytes) {
+  std::unique_lock<std::mutex> ul(mutex_);
+
+  if (enabled() || sampling() || sample_interval_bytes == 0)
+    return;
+
+  budget_bytes_ = budget_bytes;
+  budget_file_name_prefix_ =
+      file_name_prefix.empty() ? "tiledb_heap" : file_name_prefix;
+
+  // Publish the interval last, the allocation paths start sampling
+  // as soon as it is non-zero.
+  sample_interval_bytes_.store(sample_interval_bytes);
+}
+
+void HeapProfiler::record_sampled_alloc(
+    void* const p, const size_t size, const std::string& label) {
+  SampledSite site;
+  site.first = label;
+#ifdef TILEDB_HEAP_PROFILER_BACKTRACE
+  // Capture the stack outside of the lock, skipping this frame.
+  void* frames[max_stack_depth_ + 1];
+  const int depth = backtrace(frames, max_stack_depth_ + 1);
+  if (depth > 1)
+    site.second.assign(frames + 1, frames + depth);
+#endif
+
+  std::unique_lock<std::mutex> ul(mutex_);
+
+  try {
+    const uint64_t addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+    if (sampled_allocs_.count(addr) > 0)
+      return;
+
+    SampledSiteStats* const stats = &sampled_sites_[std::move(site)];
+    ++stats->inuse_num_;
+    stats->inuse_bytes_ += size;
+    ++stats->alloc_num_;
+    stats->alloc_bytes_ += size;
+
+    sampled_allocs_[addr] = std::make_pair(size, stats);
+    sampled_addr_filter_entry(addr).fetch_add(1, std::memory_order_relaxed);
+
+    sampled_inuse_estimate_ += scale_sampled_bytes(1, size);
+    try_budget_dump();
+  } catch (const std::bad_alloc&) {
+    // Drop the sample, the allocation itself succeeded.
+  }
+}
+
+void HeapProfiler::record_sampled_dealloc(const void* const p) {
+  const uint64_t addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+
+  // Almost no deallocation was sampled, skip the lock for those. This
+  // is not racy as long as this is called before `p` is released: only
+  // the allocation of `p` may have incremented its filter entry for `p`.
+  if (sampled_addr_filter_entry(addr).load(std::memory_order_relaxed) == 0)
+    return;
+
+  std::unique_lock<std::mutex> ul(mutex_);
+
+  auto iter = sampled_allocs_.find(addr);
+  if (iter == sampled_allocs_.end())
+    return;
+
+  const size_t size = iter->second.first;
+  SampledSiteStats* const stats = iter->second.second;
+  --stats->inuse_num_;
+  stats->inuse_bytes_ -= size;
+
+  sampled_allocs_.erase(iter);
+  sampled_addr_filter_entry(addr).fetch_sub(1, std::memory_order_relaxed);
+
+  sampled_inuse_estimate_ -= scale_sampled_bytes(1, size);
+  if (budget_dumped_ && sampled_inuse_estimate_ < 0.9 * budget_bytes_)
+    budget_dumped_ = false;
+}
+
+bool HeapProfiler::dump_pprof(const std::string& file_name) {
+  std::unique_lock<std::mutex> ul(mutex_);
+  return dump_pprof_internal(file_name);
+}
+
 void HeapProfiler::record_alloc(
     void* const p, const size_t size, const std::string& label) {
   std::unique_lock<std::mutex> ul(mutex_);
@@ -208,6 +310,114 @@ void HeapProfiler::try_interval_dump() {
   }
 }
 
+bool HeapProfiler::sample_countdown(
+    const size_t size, const uint64_t interval) {
+  // The bytes left until the next sample are drawn from an exponential
+  // distribution, so that every allocated byte is equally likely to be
+  // sampled and periodic allocation patterns do not bias the samples.
+  thread_local std::minstd_rand rng(static_cast<std::minstd_rand::result_type>(
+      std::hash<std::thread::id>()(std::this_thread::get_id())));
+  thread_local int64_t bytes_until_sample = -1;
+
+  auto draw = [&]() {
+    const double u = (rng() - rng.min() + 1.0) / (rng.max() - rng.min() + 2.0);
+    return static_cast<int64_t>(-std::log(u) * interval) + 1;
+  };
+
+  if (bytes_until_sample < 0)
+    bytes_until_sample = draw();
+
+  bytes_until_sample -= static_cast<int64_t>(size);
+  if (bytes_until_sample > 0)
+    return false;
+
+  bytes_until_sample = draw();
+  return true;
+}
+
+std::atomic<uint32_t>& HeapProfiler::sampled_addr_filter_entry(
+    const uint64_t addr) {
+  // Allocations are at least 8-byte aligned, drop the low bits and mix
+  // the rest so that neighbouring allocations spread over the filter.
+  const uint64_t hash = (addr >> 3) * 0x9E3779B97F4A7C15ull;
+  return sampled_addr_filter_[hash >> 50];
+}
+
+double HeapProfiler::scale_sampled_bytes(
+    const uint64_t num, const uint64_t bytes) const {
+  // An allocation of `s` bytes is sampled with probability
+  // `1 - exp(-s / interval)`.
+  if (num == 0)
+    return 0;
+  const double interval =
+      static_cast<double>(sample_interval_bytes_.load());
+  const double avg_size = static_cast<double>(bytes) / num;
+  const double probability = 1 - std::exp(-avg_size / interval);
+  return probability > 0 ? bytes / probability : 0;
+}
+
+void HeapProfiler::try_budget_dump() {
+  if (budget_bytes_ == 0 || budget_dumped_ ||
+      sampled_inuse_estimate_ < budget_bytes_)
+    return;
+
+  budget_dumped_ = true;
+
+  const uint64_t epoch_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  const std::string file_name = budget_file_name_prefix_ + "__" +
+                                std::to_string(epoch_ms) + ".heap";
+  if (dump_pprof_internal(file_name))
+    std::cerr << "TileDB: HeapProfiler budget of " << budget_bytes_
+              << " bytes exceeded, wrote " << file_name << std::endl;
+}
+
+bool HeapProfiler::dump_pprof_internal(const std::string& file_name) {
+  std::ofstream file_stream(file_name, std::ofstream::out);
+  if (!file_stream) {
+    std::cerr << "TileDB:: failed to open dump file " << file_name
+              << std::endl;
+    return false;
+  }
+
+  SampledSiteStats total;
+  for (const auto& kv : sampled_sites_) {
+    total.inuse_num_ += kv.second.inuse_num_;
+    total.inuse_bytes_ += kv.second.inuse_bytes_;
+    total.alloc_num_ += kv.second.alloc_num_;
+    total.alloc_bytes_ += kv.second.alloc_bytes_;
+  }
+
+  // The legacy heap profile format. `pprof` scales the sampled counts
+  // back up with the interval given in the header.
+  file_stream << "heap profile: " << total.inuse_num_ << ": "
+              << total.inuse_bytes_ << " [" << total.alloc_num_ << ": "
+              << total.alloc_bytes_ << "] @ heap_v2/"
+              << sample_interval_bytes_.load() << "\n";
+
+  for (const auto& kv : sampled_sites_) {
+    const SampledSiteStats& stats = kv.second;
+    file_stream << std::dec << std::setw(6) << stats.inuse_num_ << ": "
+                << std::setw(8) << stats.inuse_bytes_ << " ["
+                << std::setw(6) << stats.alloc_num_ << ": " << std::setw(8)
+                << stats.alloc_bytes_ << "] @";
+    for (void* const frame : kv.first.second)
+      file_stream << " 0x" << std::hex
+                  << reinterpret_cast<uintptr_t>(frame);
+    file_stream << std::dec << "\n";
+  }
+
+  // `pprof` symbolizes the addresses with the mapped libraries.
+  file_stream << "\nMAPPED_LIBRARIES:\n";
+  std::ifstream maps("/proc/self/maps");
+  if (maps)
+    file_stream << maps.rdbuf();
+
+  return static_cast<bool>(file_stream);
+}
+
 std::string HeapProfiler::create_dump_file(
     const std::string& file_name_prefix) {
   const uint64_t epoch_ms =
@@ -328,6 +538,27 @@ void HeapProfiler::dump_internal() {
                   << " " << bytes << std::endl;
   }
 
+  // Report the estimated outstanding bytes per label when sampling.
+  if (sampling()) {
+    std::map<std::string, SampledSiteStats> label_to_sampled;
+    for (const auto& kv : sampled_sites_) {
+      SampledSiteStats& stats = label_to_sampled[kv.first.first];
+      stats.inuse_num_ += kv.second.inuse_num_;
+      stats.inuse_bytes_ += kv.second.inuse_bytes_;
+    }
+
+    *out_stream << "  sampled_inuse_estimate_ "
+                << static_cast<uint64_t>(sampled_inuse_estimate_)
+                << std::endl;
+    for (const auto& kv : label_to_sampled) {
+      const uint64_t bytes = static_cast<uint64_t>(scale_sampled_bytes(
+          kv.second.inuse_num_, kv.second.inuse_bytes_));
+      if (dump_threshold_bytes_ == 0 || bytes >= dump_threshold_bytes_)
+        *out_stream << "  ~[" << kv.first << "]"
+                    << " " << bytes << std::endl;
+    }
+  }
+
   if (!file_name_.empty())
     file_stream.close();
 }
@@ -33,12 +33,16 @@
 #ifndef TILEDB_HEAP_PROFILER_H
 #define TILEDB_HEAP_PROFILER_H
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "tiledb/common/macros.h"
 
@@ -80,6 +84,22 @@ class HeapProfiler {
     return reserved_memory_ != nullptr;
   }
 
+  /** Returns true if the heap profiler samples allocations. */
+  inline bool sampling() const {
+    return sample_interval_bytes_.load(std::memory_order_relaxed) != 0;
+  }
+
+  /**
+   * Returns true if an allocation of `size` bytes must be recorded with
+   * `record_sampled_alloc`. This is false for all allocations unless
+   * sampling is enabled.
+   */
+  inline bool sample(size_t size) {
+    const uint64_t interval =
+        sample_interval_bytes_.load(std::memory_order_relaxed);
+    return interval != 0 && sample_countdown(size, interval);
+  }
+
   /**
    * Initialize and start the profiler.
    *
@@ -103,6 +123,56 @@ class HeapProfiler {
       uint64_t dump_interval_bytes,
       uint64_t dump_threshold_bytes);
 
+  /**
+   * Initialize and start the profiler in sampling mode. Unlike `enable`,
+   * which records every allocation, this records on average one
+   * allocation per `sample_interval_bytes` allocated bytes, along with the
+   * stack trace of the allocation where supported, so that it can run in
+   * production. The sampled allocations are dumped with `dump_pprof` in
+   * the legacy heap profile format read by `pprof`, which scales the
+   * samples back up. `dump` reports the estimated bytes per label.
+   *
+   * @param file_name_prefix The prefix of the files written when the
+   *   memory budget is exceeded, e.g. "tiledb_heap" writes to
+   *   "tiledb_heap__1611170501.heap". If empty, "tiledb_heap" is used.
+   * @param sample_interval_bytes The average number of bytes allocated
+   *   between two samples. Must be non-zero.
+   * @param budget_bytes If non-zero, a profile is dumped when the estimated
+   *   allocated bytes exceed this budget, and again once they drop back
+   *   under 90% of it and exceed it anew.
+   */
+  void enable_sampling(
+      const std::string& file_name_prefix,
+      uint64_t sample_interval_bytes,
+      uint64_t budget_bytes);
+
+  /**
+   * Records a successful allocation selected by `sample`.
+   *
+   * @param p The pointer to the allocated memory.
+   * @param size The allocation byte size of `p`.
+   * @param label The label of the allocation site.
+   */
+  void record_sampled_alloc(void* p, size_t size, const std::string& label);
+
+  /**
+   * Records a deallocation when sampling. This must be called before the
+   * memory is released, and is cheap for allocations that were not
+   * sampled.
+   *
+   * @param p The pointer to the memory to deallocate.
+   */
+  void record_sampled_dealloc(const void* p);
+
+  /**
+   * Dumps the sampled allocations in the legacy heap profile format of
+   * `pprof`, i.e. `pprof <binary> <file_name>`.
+   *
+   * @param file_name The file to write.
+   * @return `false` if the file could not be written.
+   */
+  bool dump_pprof(const std::string& file_name);
+
   /**
    * Records a successful allocation.
    *
@@ -213,6 +283,58 @@ class HeapProfiler {
    */
   uint64_t last_interval_dump_alloc_bytes_;
 
+  /** The maximum number of stack frames recorded per sampled allocation. */
+  static const int max_stack_depth_ = 32;
+
+  /** The number of entries of `sampled_addr_filter_`. */
+  static const size_t sampled_addr_filter_size_ = 1 << 14;
+
+  /** The sampled allocations of a site, in sampled (unscaled) units. */
+  struct SampledSiteStats {
+    uint64_t inuse_num_ = 0;
+    uint64_t inuse_bytes_ = 0;
+    uint64_t alloc_num_ = 0;
+    uint64_t alloc_bytes_ = 0;
+  };
+
+  /** An allocation site: the label and the stack trace of an allocation. */
+  typedef std::pair<std::string, std::vector<void*>> SampledSite;
+
+  /**
+   * When non-zero, the profiler samples allocations every this many
+   * bytes on average.
+   */
+  std::atomic<uint64_t> sample_interval_bytes_;
+
+  /** When non-zero, a profile is dumped when exceeding this budget. */
+  uint64_t budget_bytes_;
+
+  /** The prefix of the files written when exceeding `budget_bytes_`. */
+  std::string budget_file_name_prefix_;
+
+  /** True if a profile was dumped since the budget was last exceeded. */
+  bool budget_dumped_;
+
+  /** The estimated bytes allocated, scaled up from the samples. */
+  double sampled_inuse_estimate_;
+
+  /** The sampled allocations per allocation site. */
+  std::map<SampledSite, SampledSiteStats> sampled_sites_;
+
+  /**
+   * Maps the address of a sampled allocation to its size and the stats of
+   * its site.
+   */
+  std::unordered_map<uint64_t, std::pair<size_t, SampledSiteStats*>>
+      sampled_allocs_;
+
+  /**
+   * Counts the sampled allocations per address hash, so that deallocating
+   * memory that was not sampled, i.e. almost always, takes no lock.
+   */
+  std::array<std::atomic<uint32_t>, sampled_addr_filter_size_>
+      sampled_addr_filter_;
+
   /* ****************************** */
   /*       PRIVATE FUNCTIONS        */
   /* ****************************** */
@@ -220,6 +342,27 @@ class HeapProfiler {
   /** Initializes and starts `periodic_dump_thread_`. */
   void start_periodic_dump();
 
+  /**
+   * Counts `size` bytes down from the bytes left until the next sample of
+   * the calling thread, returning true when they run out.
+   */
+  static bool sample_countdown(size_t size, uint64_t interval);
+
+  /** Returns the entry of `sampled_addr_filter_` of an address. */
+  std::atomic<uint32_t>& sampled_addr_filter_entry(uint64_t addr);
+
+  /**
+   * Returns the estimated bytes allocated for `bytes` sampled bytes in
+   * `num` allocations, undoing the sampling bias towards large allocations.
+   */
+  double scale_sampled_bytes(uint64_t num, uint64_t bytes) const;
+
+  /** Dumps a profile if the estimated bytes exceed `budget_bytes_`. */
+  void try_budget_dump();
+
+  /** Dumps the sampled allocations without locking on `mutex_`. */
+  bool dump_pprof_internal(const std::string& file_name);
+
   /** Performs an interval dump if necessary. */
   void try_interval_dump();
 
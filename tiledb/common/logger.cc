@@ -182,6 +182,24 @@ void Logger::fatal(const std::stringstream& msg) {
   exit(1);
 }
 
+bool Logger::should_log(Logger::Level lvl) const {
+  switch (lvl) {
+    case Logger::Level::FATAL:
+      return logger_->should_log(spdlog::level::critical);
+    case Logger::Level::ERR:
+      return logger_->should_log(spdlog::level::err);
+    case Logger::Level::WARN:
+      return logger_->should_log(spdlog::level::warn);
+    case Logger::Level::INFO:
+      return logger_->should_log(spdlog::level::info);
+    case Logger::Level::DBG:
+      return logger_->should_log(spdlog::level::debug);
+    case Logger::Level::TRACE:
+      return logger_->should_log(spdlog::level::trace);
+  }
+  return false;
+}
+
 void Logger::set_level(Logger::Level lvl) {
   switch (lvl) {
     case Logger::Level::FATAL:
@@ -327,6 +327,14 @@ class Logger {
     logger_->critical(fmt, arg1, args...);
   }
 
+  /**
+   * Returns true if a statement of the input level would be logged, so that
+   * callers can skip building messages that would be dropped.
+   *
+   * @param lvl The level of the statement.
+   */
+  bool should_log(Logger::Level lvl) const;
+
   /**
    * Set the logger level.
    *
@@ -446,4 +454,69 @@ inline Status logger_format_from_string(
 // Also include the public-permissible logger functions here.
 #include "tiledb/common/logger_public.h"
 
+/*
+ * Log statement macros for hot paths. Statements below
+ * `TILEDB_LOG_ACTIVE_LEVEL` compile to nothing, and the others evaluate
+ * and format their arguments only if the logger would emit them.
+ *
+ * Example: TILEDB_LOG_DEBUG(*logger_, "Loaded tile {0}", t);
+ */
+#define TILEDB_LOG_AT_LEVEL_(active, lvl, method, logger, ...) \
+  do {                                                         \
+    if constexpr (active) {                                    \
+      auto& tiledb_log_logger_ = (logger);                     \
+      if (tiledb_log_logger_.should_log(lvl))                  \
+        tiledb_log_logger_.method(__VA_ARGS__);                \
+    }                                                          \
+  } while (0)
+
+#define TILEDB_LOG_TRACE(logger, ...)                    \
+  TILEDB_LOG_AT_LEVEL_(                                  \
+      TILEDB_LOG_ACTIVE_LEVEL <= TILEDB_LOG_LEVEL_TRACE, \
+      tiledb::common::Logger::Level::TRACE,              \
+      trace,                                             \
+      logger,                                            \
+      __VA_ARGS__)
+
+#define TILEDB_LOG_DEBUG(logger, ...)                    \
+  TILEDB_LOG_AT_LEVEL_(                                  \
+      TILEDB_LOG_ACTIVE_LEVEL <= TILEDB_LOG_LEVEL_DEBUG, \
+      tiledb::common::Logger::Level::DBG,                \
+      debug,                                             \
+      logger,                                            \
+      __VA_ARGS__)
+
+#define TILEDB_LOG_INFO(logger, ...)                    \
+  TILEDB_LOG_AT_LEVEL_(                                 \
+      TILEDB_LOG_ACTIVE_LEVEL <= TILEDB_LOG_LEVEL_INFO, \
+      tiledb::common::Logger::Level::INFO,              \
+      info,                                             \
+      logger,                                           \
+      __VA_ARGS__)
+
+/*
+ * Logs a warning at most once every `period_ms` milliseconds per call site,
+ * reporting how many warnings were held back in between. `msg` is only
+ * evaluated when the warning is let through.
+ *
+ * Example: TILEDB_LOG_WARN_RATE_LIMITED(global_logger(), 1000, "Retrying");
+ */
+#define TILEDB_LOG_WARN_RATE_LIMITED(logger, period_ms, msg)              \
+  do {                                                                    \
+    static tiledb::common::LogRateLimiter tiledb_log_limiter_(period_ms); \
+    uint64_t tiledb_log_suppressed_ = 0;                                  \
+    auto& tiledb_log_logger_ = (logger);                                  \
+    if (tiledb_log_logger_.should_log(                                    \
+            tiledb::common::Logger::Level::WARN) &&                       \
+        tiledb_log_limiter_.allow(&tiledb_log_suppressed_)) {             \
+      if (tiledb_log_suppressed_ == 0)                                    \
+        tiledb_log_logger_.warn(msg);                                     \
+      else                                                                \
+        tiledb_log_logger_.warn(                                          \
+            "{0} ({1} similar warnings suppressed)",                      \
+            std::string(msg),                                             \
+            tiledb_log_suppressed_);                                      \
+    }                                                                     \
+  } while (0)
+
 #endif  // TILEDB_LOGGER_H
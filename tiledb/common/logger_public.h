@@ -36,13 +36,89 @@
 #ifndef TILEDB_LOGGER_PUBLIC_H
 #define TILEDB_LOGGER_PUBLIC_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include "tiledb/common/status.h"
 
+/*
+ * Log levels known at compile time. Log statements issued through the
+ * `TILEDB_LOG_*` macros of `logger.h` below `TILEDB_LOG_ACTIVE_LEVEL` are
+ * removed from the build, arguments included. The level is set with the
+ * CMake option `TILEDB_LOG_ACTIVE_LEVEL`; by default release builds drop
+ * trace statements and debug builds keep everything.
+ */
+#define TILEDB_LOG_LEVEL_TRACE 0
+#define TILEDB_LOG_LEVEL_DEBUG 1
+#define TILEDB_LOG_LEVEL_INFO 2
+#define TILEDB_LOG_LEVEL_WARN 3
+#define TILEDB_LOG_LEVEL_ERROR 4
+
+#ifndef TILEDB_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define TILEDB_LOG_ACTIVE_LEVEL TILEDB_LOG_LEVEL_DEBUG
+#else
+#define TILEDB_LOG_ACTIVE_LEVEL TILEDB_LOG_LEVEL_TRACE
+#endif
+#endif
+
 namespace tiledb {
 namespace common {
 
 class Logger;
 
+/**
+ * Lets through at most one log statement per period, counting the
+ * statements it holds back. Used for warnings that repeat under fault
+ * conditions, such as request retries, so that logging does not slow
+ * recovery down. Thread-safe.
+ */
+class LogRateLimiter {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param period_ms The minimum number of milliseconds between two
+   *     statements that are let through.
+   */
+  explicit LogRateLimiter(uint64_t period_ms)
+      : period_ms_(static_cast<int64_t>(period_ms))
+      , next_ms_(0)
+      , suppressed_(0) {
+  }
+
+  /**
+   * Returns true if a statement may be logged now.
+   *
+   * @param suppressed Set, if true is returned, to the number of statements
+   *     held back since the last one that was let through.
+   */
+  bool allow(uint64_t* suppressed) {
+    const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+    int64_t next = next_ms_.load(std::memory_order_relaxed);
+    if (now < next || !next_ms_.compare_exchange_strong(
+                          next, now + period_ms_, std::memory_order_relaxed)) {
+      suppressed_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    *suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  /** The minimum number of milliseconds between two statements. */
+  const int64_t period_ms_;
+
+  /** The steady clock time in ms before which statements are held back. */
+  std::atomic<int64_t> next_ms_;
+
+  /** The number of statements held back since the last one let through. */
+  std::atomic<uint64_t> suppressed_;
+};
+
 /** Logs a trace. */
 void LOG_TRACE(const std::string& msg);
 
@@ -43,15 +43,15 @@
 namespace tiledb {
 namespace common {
 void tdb_malloc_trim() {
-  std::stringstream ss;
 #if defined(__linux__) && defined(__GLIBC__)
   int ret = malloc_trim(0);
-  ss << "malloc_trim ";
-  if (ret == 0)
-    ss << "did not unmap memory";
-  else
-    ss << "did unmap memory";
-  LOG_TRACE(ss.str());
+#if TILEDB_LOG_ACTIVE_LEVEL <= TILEDB_LOG_LEVEL_TRACE
+  LOG_TRACE(
+      ret == 0 ? "malloc_trim did not unmap memory" :
+                 "malloc_trim did unmap memory");
+#else
+  (void)ret;
+#endif
 #endif
 }
 }  // namespace common
@@ -34,6 +34,8 @@
 #ifndef TILEDB_MEMORY_TRACKER_H
 #define TILEDB_MEMORY_TRACKER_H
 
+#include <algorithm>
+
 #include "tiledb/common/status.h"
 
 namespace tiledb {
@@ -44,6 +46,7 @@ class MemoryTracker {
   /** Constructor. */
   MemoryTracker() {
     memory_usage_ = 0;
+    memory_high_water_mark_ = 0;
     memory_budget_ = std::numeric_limits<uint32_t>::max();
   };
 
@@ -63,6 +66,8 @@ class MemoryTracker {
     std::lock_guard<std::mutex> lg(mutex_);
     if (memory_usage_ + size <= memory_budget_) {
       memory_usage_ += size;
+      memory_high_water_mark_ =
+          std::max(memory_high_water_mark_, memory_usage_);
       return true;
     }
 
@@ -97,6 +102,14 @@ class MemoryTracker {
     return memory_usage_;
   }
 
+  /**
+   * Get the highest memory usage since the tracker was created.
+   */
+  uint64_t get_memory_high_water_mark() {
+    std::lock_guard<std::mutex> lg(mutex_);
+    return memory_high_water_mark_;
+  }
+
   /**
    * Get available room based on budget
    * @return available amount left in budget
@@ -122,6 +135,9 @@ class MemoryTracker {
   /** Memory usage for tracked structures. */
   uint64_t memory_usage_;
 
+  /** Highest memory usage for tracked structures. */
+  uint64_t memory_high_water_mark_;
+
   /** Memory budget. */
   uint64_t memory_budget_;
 };
@@ -55,6 +55,7 @@
 #include <cstring>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 using std::tuple, std::optional, std::nullopt;
 
@@ -104,8 +105,11 @@ class Status {
   /*     CONSTRUCTORS & DESTRUCTORS    */
   /* ********************************* */
 
-  /** Constructor with success status (empty state). */
-  Status()
+  /**
+   * Constructor with success status (empty state). A success status is a
+   * null pointer, so creating, copying and destroying it never allocates.
+   */
+  Status() noexcept
       : state_(nullptr) {
   }
 
@@ -129,19 +133,43 @@ class Status {
   /** Copy the specified status. */
   Status(const Status& s);
 
+  /**
+   * Move the specified status. Errors returned through several frames are
+   * moved rather than copied, so the message is allocated only once.
+   */
+  Status(Status&& s) noexcept
+      : state_(s.state_) {
+    s.state_ = nullptr;
+  }
+
   /** Assign status. */
   void operator=(const Status& s);
 
+  /** Move-assign status. */
+  void operator=(Status&& s) noexcept {
+    if (this != &s) {
+      tdb_delete_array(state_);
+      state_ = s.state_;
+      s.state_ = nullptr;
+    }
+  }
+
   /**  Return a success status **/
-  static Status Ok() {
+  static Status Ok() noexcept {
     return Status();
   }
 
   /** Returns true iff the status indicates success **/
-  bool ok() const {
+  bool ok() const noexcept {
     return (state_ == nullptr);
   }
 
+  /** Returns the code of the status, `StatusCode::Ok` on success. */
+  StatusCode code() const noexcept {
+    return (state_ == nullptr) ? StatusCode::Ok :
+                                 static_cast<StatusCode>(state_[4]);
+  }
+
   /**
    * Return a std::string representation of this status object suitable for
    * printing.  Return "Ok" for success.
@@ -193,12 +221,12 @@ inline void Status::operator=(const Status& s) {
   }
 }
 
-inline Status Status_Error(const std::string& msg) {
+inline Status Status_Error(std::string_view msg) {
   return {StatusCode::Error, msg};
 };
 
 /** Return a StorageManager error class Status with a given message **/
-inline Status Status_StorageManagerError(const std::string& msg) {
+inline Status Status_StorageManagerError(std::string_view msg) {
   return Status(StatusCode::StorageManager, msg);
 }
 /**  Return a success status **/
@@ -206,204 +234,203 @@ inline Status Status_Ok() {
   return Status();
 }
 /** Return a FragmentMetadata error class Status with a given message **/
-inline Status Status_FragmentMetadataError(const std::string& msg) {
+inline Status Status_FragmentMetadataError(std::string_view msg) {
   return Status(StatusCode::FragmentMetadata, msg);
 }
 /** Return a ArraySchema error class Status with a given message **/
-inline Status Status_ArraySchemaError(const std::string& msg) {
+inline Status Status_ArraySchemaError(std::string_view msg) {
   return Status(StatusCode::ArraySchema, msg);
 }
 /** Return a ArraySchemaEvolution error class Status with a given message **/
-inline Status Status_ArraySchemaEvolutionError(const std::string& msg) {
+inline Status Status_ArraySchemaEvolutionError(std::string_view msg) {
   return Status(StatusCode::ArraySchemaEvolution, msg);
 }
 /** Return a Metadata error class Status with a given message **/
-inline Status Status_MetadataError(const std::string& msg) {
+inline Status Status_MetadataError(std::string_view msg) {
   return Status(StatusCode::Metadata, msg);
 }
 /** Return a IO error class Status with a given message **/
-inline Status Status_IOError(const std::string& msg) {
+inline Status Status_IOError(std::string_view msg) {
   return Status(StatusCode::IO, msg);
 }
 /** Return a GZip error class Status with a given message **/
-inline Status Status_GZipError(const std::string& msg) {
+inline Status Status_GZipError(std::string_view msg) {
   return Status(StatusCode::GZip, msg);
 }
 /** Return a ChecksumError error class Status with a given message **/
-inline Status Status_ChecksumError(const std::string& msg) {
+inline Status Status_ChecksumError(std::string_view msg) {
   return Status(StatusCode::ChecksumError, msg);
 }
 /** Return a Compression error class Status with a given message **/
-inline Status Status_CompressionError(const std::string& msg) {
+inline Status Status_CompressionError(std::string_view msg) {
   return Status(StatusCode::Compression, msg);
 }
 /** Return a Tile error class Status with a given message **/
-inline Status Status_TileError(const std::string& msg) {
+inline Status Status_TileError(std::string_view msg) {
   return Status(StatusCode::Tile, msg);
 }
 /** Return a TileIO error class Status with a given message **/
-inline Status Status_TileIOError(const std::string& msg) {
+inline Status Status_TileIOError(std::string_view msg) {
   return Status(StatusCode::TileIO, msg);
 }
 /** Return a Buffer error class Status with a given message **/
-inline Status Status_BufferError(const std::string& msg) {
+inline Status Status_BufferError(std::string_view msg) {
   return Status(StatusCode::Buffer, msg);
 }
 /** Return a Query error class Status with a given message **/
-inline Status Status_QueryError(const std::string& msg) {
+inline Status Status_QueryError(std::string_view msg) {
   return Status(StatusCode::Query, msg);
 }
 /** Return a ValidityVector error class Status with a given message **/
-inline Status Status_ValidityVectorError(const std::string& msg) {
+inline Status Status_ValidityVectorError(std::string_view msg) {
   return Status(StatusCode::ValidityVector, msg);
 }
 /** Return a Status_VFSError error class Status with a given message **/
-inline Status Status_VFSError(const std::string& msg) {
+inline Status Status_VFSError(std::string_view msg) {
   return Status(StatusCode::VFS, msg);
 }
 /** Return a Dimension error class Status with a given message **/
-inline Status Status_DimensionError(const std::string& msg) {
+inline Status Status_DimensionError(std::string_view msg) {
   return Status(StatusCode::Dimension, msg);
 }
 /** Return a Domain error class Status with a given message **/
-inline Status Status_DomainError(const std::string& msg) {
+inline Status Status_DomainError(std::string_view msg) {
   return Status(StatusCode::Domain, msg);
 }
 /** Return a Consolidator error class Status with a given message **/
-inline Status Status_ConsolidatorError(const std::string& msg) {
+inline Status Status_ConsolidatorError(std::string_view msg) {
   return Status(StatusCode::Consolidator, msg);
 }
 /** Return a LRUCache error class Status with a given message **/
-inline Status Status_LRUCacheError(const std::string& msg) {
+inline Status Status_LRUCacheError(std::string_view msg) {
   return Status(StatusCode::LRUCache, msg);
 }
 /** Return a Config error class Status with a given message **/
-inline Status Status_ConfigError(const std::string& msg) {
+inline Status Status_ConfigError(std::string_view msg) {
   return Status(StatusCode::Config, msg);
 }
 /** Return a Utils error class Status with a given message **/
-inline Status Status_UtilsError(const std::string& msg) {
+inline Status Status_UtilsError(std::string_view msg) {
   return Status(StatusCode::Utils, msg);
 }
 /** Return a FS_S3 error class Status with a given message **/
-inline Status Status_S3Error(const std::string& msg) {
+inline Status Status_S3Error(std::string_view msg) {
   return Status(StatusCode::FS_S3, msg);
 }
 /** Return a FS_AZURE error class Status with a given message **/
-inline Status Status_AzureError(const std::string& msg) {
+inline Status Status_AzureError(std::string_view msg) {
   return Status(StatusCode::FS_AZURE, msg);
 }
 /** Return a FS_GCS error class Status with a given message **/
-inline Status Status_GCSError(const std::string& msg) {
+inline Status Status_GCSError(std::string_view msg) {
   return Status(StatusCode::FS_GCS, msg);
 }
 /** Return a FS_HDFS error class Status with a given message **/
-inline Status Status_HDFSError(const std::string& msg) {
+inline Status Status_HDFSError(std::string_view msg) {
   return Status(StatusCode::FS_HDFS, msg);
 }
 /** Return a FS_MEM error class Status with a given message **/
-inline Status Status_MemFSError(const std::string& msg) {
+inline Status Status_MemFSError(std::string_view msg) {
   return Status(StatusCode::FS_MEM, msg);
 }
 /** Return a Attribute error class Status with a given message **/
-inline Status Status_AttributeError(const std::string& msg) {
+inline Status Status_AttributeError(std::string_view msg) {
   return Status(StatusCode::Attribute, msg);
 }
 /** Return a Status_SparseGlobalOrderReaderError error class Status with a
  * given message **/
-inline Status Status_SparseGlobalOrderReaderError(const std::string& msg) {
+inline Status Status_SparseGlobalOrderReaderError(std::string_view msg) {
   return Status(StatusCode::SparseGlobalOrderReaderError, msg);
 }
 /** Return a Status_SparseUnorderedWithDupsReaderError error class Status with
  * a given message **/
-inline Status Status_SparseUnorderedWithDupsReaderError(
-    const std::string& msg) {
+inline Status Status_SparseUnorderedWithDupsReaderError(std::string_view msg) {
   return Status(StatusCode::SparseUnorderedWithDupsReaderError, msg);
 }
 /** Return a Status_DenseReaderError error class Status with a given message
  * **/
-inline Status Status_DenseReaderError(const std::string& msg) {
+inline Status Status_DenseReaderError(std::string_view msg) {
   return Status(StatusCode::DenseReaderError, msg);
 }
 /** Return a Reader error class Status with a given message **/
-inline Status Status_ReaderError(const std::string& msg) {
+inline Status Status_ReaderError(std::string_view msg) {
   return Status(StatusCode::Reader, msg);
 }
 /** Return a Writer error class Status with a given message **/
-inline Status Status_WriterError(const std::string& msg) {
+inline Status Status_WriterError(std::string_view msg) {
   return Status(StatusCode::Writer, msg);
 }
 /** Return a PreallocatedBuffer error class Status with a given message
  * **/
-inline Status Status_PreallocatedBufferError(const std::string& msg) {
+inline Status Status_PreallocatedBufferError(std::string_view msg) {
   return Status(StatusCode::PreallocatedBuffer, msg);
 }
 /** Return a Status_FilterError error class Status with a given message **/
-inline Status Status_FilterError(const std::string& msg) {
+inline Status Status_FilterError(std::string_view msg) {
   return Status(StatusCode::Filter, msg);
 }
 /** Return a Encryption error class Status with a given message **/
-inline Status Status_EncryptionError(const std::string& msg) {
+inline Status Status_EncryptionError(std::string_view msg) {
   return Status(StatusCode::Encryption, msg);
 }
 /** Return an Array error class Status with a given message **/
-inline Status Status_ArrayError(const std::string& msg) {
+inline Status Status_ArrayError(std::string_view msg) {
   return Status(StatusCode::Array, msg);
 }
 /** Return a VFSFileHandle error class Status with a given message **/
-inline Status Status_VFSFileHandleError(const std::string& msg) {
+inline Status Status_VFSFileHandleError(std::string_view msg) {
   return Status(StatusCode::VFSFileHandleError, msg);
 }
 /** Return a Status_ContextError error class Status with a given message **/
-inline Status Status_ContextError(const std::string& msg) {
+inline Status Status_ContextError(std::string_view msg) {
   return Status(StatusCode::ContextError, msg);
 }
 /** Return a Status_SubarrayError error class Status with a given message **/
-inline Status Status_SubarrayError(const std::string& msg) {
+inline Status Status_SubarrayError(std::string_view msg) {
   return Status(StatusCode::SubarrayError, msg);
 }
 /** Return a Status_SubarrayPartitionerError error class Status with a given
  * message
  * **/
-inline Status Status_SubarrayPartitionerError(const std::string& msg) {
+inline Status Status_SubarrayPartitionerError(std::string_view msg) {
   return Status(StatusCode::SubarrayPartitionerError, msg);
 }
 /** Return a Status_RTreeError error class Status with a given message **/
-inline Status Status_RTreeError(const std::string& msg) {
+inline Status Status_RTreeError(std::string_view msg) {
   return Status(StatusCode::RTreeError, msg);
 }
 /** Return a Status_CellSlabIterError error class Status with a given message
  * **/
-inline Status Status_CellSlabIterError(const std::string& msg) {
+inline Status Status_CellSlabIterError(std::string_view msg) {
   return Status(StatusCode::CellSlabIterError, msg);
 }
 /** Return a Status_RestError error class Status with a given message **/
-inline Status Status_RestError(const std::string& msg) {
+inline Status Status_RestError(std::string_view msg) {
   return Status(StatusCode::RestError, msg);
 }
 /** Return a Status_SerializationError error class Status with a given message
  * **/
-inline Status Status_SerializationError(const std::string& msg) {
+inline Status Status_SerializationError(std::string_view msg) {
   return Status(StatusCode::SerializationError, msg);
 }
 /** Return a Status_ThreadPoolError error class Status with a given message
  * **/
-inline Status Status_ThreadPoolError(const std::string& msg) {
+inline Status Status_ThreadPoolError(std::string_view msg) {
   return Status(StatusCode::ThreadPoolError, msg);
 }
 /** Return a Status_FragmentInfoError error class Status with a given message
  * **/
-inline Status Status_FragmentInfoError(const std::string& msg) {
+inline Status Status_FragmentInfoError(std::string_view msg) {
   return Status(StatusCode::FragmentInfoError, msg);
 }
 /** Return a Status_DenseTilerError error class Status with a given message
  * **/
-inline Status Status_DenseTilerError(const std::string& msg) {
+inline Status Status_DenseTilerError(std::string_view msg) {
   return Status(StatusCode::DenseTilerError, msg);
 }
 /** Return a Status_QueryConditionError error class Status with a given
  * message **/
-inline Status Status_QueryConditionError(const std::string& msg) {
+inline Status Status_QueryConditionError(std::string_view msg) {
   return Status(StatusCode::QueryConditionError, msg);
 }
 }  // namespace common
@@ -0,0 +1,132 @@
+/**
+ * @file   cancellation_token.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file defines the CancellationToken class.
+ */
+
+#ifndef TILEDB_CANCELLATION_TOKEN_H
+#define TILEDB_CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+
+#include "tiledb/common/macros.h"
+#include "tiledb/common/status.h"
+
+namespace tiledb {
+namespace common {
+
+/**
+ * Requests the cancellation of an operation, either explicitly or once its
+ * deadline has passed. The operation checks the token cooperatively, at a
+ * granularity coarse enough for the cost of the check to be negligible.
+ */
+class CancellationToken {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  CancellationToken()
+      : cancelled_(false)
+      , deadline_ns_(0) {
+  }
+
+  DISABLE_COPY_AND_COPY_ASSIGN(CancellationToken);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(CancellationToken);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Requests the cancellation of the operation. */
+  void cancel() {
+    cancelled_ = true;
+  }
+
+  /**
+   * Sets the deadline of the operation to `timeout_ms` milliseconds from
+   * now, or removes it if `timeout_ms` is 0.
+   */
+  void set_timeout(uint64_t timeout_ms) {
+    deadline_ns_ = timeout_ms == 0 ? 0 : now_ns() + timeout_ms * 1000000;
+  }
+
+  /** Returns `true` if the cancellation was requested with `cancel`. */
+  bool cancel_requested() const {
+    return cancelled_;
+  }
+
+  /** Returns `true` if the deadline of the operation has passed. */
+  bool deadline_exceeded() const {
+    const uint64_t deadline_ns = deadline_ns_;
+    return deadline_ns != 0 && now_ns() >= deadline_ns;
+  }
+
+  /** Returns `true` if the operation should stop. */
+  bool cancelled() const {
+    return cancel_requested() || deadline_exceeded();
+  }
+
+  /** Returns an error status if the operation should stop. */
+  Status check() const {
+    if (cancel_requested())
+      return Status_Error("Operation cancelled");
+    if (deadline_exceeded())
+      return Status_Error("Operation deadline exceeded");
+    return Status::Ok();
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Set when the cancellation is requested. */
+  std::atomic<bool> cancelled_;
+
+  /** The deadline on the steady clock in nanoseconds, 0 if none. */
+  std::atomic<uint64_t> deadline_ns_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the current time on the steady clock in nanoseconds. */
+  static uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+};
+
+}  // namespace common
+}  // namespace tiledb
+
+#endif  // TILEDB_CANCELLATION_TOKEN_H
@@ -0,0 +1,157 @@
+/**
+ * @file   task_graph.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the TaskGraph class.
+ */
+
+#include <cassert>
+
+#include "tiledb/common/thread_pool/task_graph.h"
+
+namespace tiledb {
+namespace common {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TaskGraph::TaskGraph()
+    : started_(false) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+TaskGraph::NodeId TaskGraph::add_node(
+    ThreadPool* const tp,
+    std::function<Status()>&& fn,
+    const std::vector<NodeId>& deps) {
+  assert(!started_);
+  const NodeId id = nodes_.size();
+  for (const auto dep : deps) {
+    assert(dep < id);
+    nodes_[dep].successors_.emplace_back(id);
+  }
+  nodes_.push_back({tp, std::move(fn), {}, deps.size()});
+  return id;
+}
+
+Status TaskGraph::run() {
+  if (started_)
+    return Status_ThreadPoolError("Cannot run task graph; it already ran");
+  started_ = true;
+
+  // Collect the roots before scheduling any of them, as the nodes they
+  // release may reach a pending count of zero while we iterate.
+  std::vector<NodeId> roots;
+  for (NodeId id = 0; id < nodes_.size(); ++id) {
+    if (nodes_[id].pending_ == 0)
+      roots.emplace_back(id);
+  }
+  for (const auto id : roots)
+    schedule(id);
+
+  // Wait on the scheduled nodes in order. The list grows while we wait, but
+  // a node appends its successors before it completes, so the list is
+  // complete once we reach its end.
+  for (uint64_t i = 0;; ++i) {
+    ThreadPool* tp;
+    std::vector<ThreadPool::Task> tasks(1);
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (i == scheduled_.size())
+        break;
+      tp = scheduled_[i].tp_;
+      tasks[0] = std::move(scheduled_[i].task_);
+    }
+
+    // A node whose cancellation token is cancelled is not executed, so it
+    // does not record its status nor release its successors.
+    auto st = tp->wait_all(tasks);
+    if (!st.ok()) {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (status_.ok())
+        status_ = st;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  return status_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void TaskGraph::schedule(const NodeId id) {
+  ThreadPool* const tp = nodes_[id].tp_;
+  std::function<Status()> fn = [this, id]() {
+    bool failed;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      failed = !status_.ok();
+    }
+
+    // Skip the node if another one failed, but still complete it so that
+    // its successors are released.
+    auto st = failed ? Status::Ok() : nodes_[id].fn_();
+    complete(id, st);
+    return st;
+  };
+
+  auto task = tp->execute(std::move(fn));
+  if (!task.valid()) {
+    complete(id, Status_ThreadPoolError("Cannot schedule task graph node"));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  scheduled_.push_back({tp, std::move(task)});
+}
+
+void TaskGraph::complete(const NodeId id, const Status& st) {
+  std::vector<NodeId> ready;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!st.ok() && status_.ok())
+      status_ = st;
+    for (const auto successor : nodes_[id].successors_) {
+      if (--nodes_[successor].pending_ == 0)
+        ready.emplace_back(successor);
+    }
+  }
+
+  // Schedule outside of the lock, as the pool may execute the nodes inline.
+  for (const auto successor : ready)
+    schedule(successor);
+}
+
+}  // namespace common
+}  // namespace tiledb
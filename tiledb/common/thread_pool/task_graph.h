@@ -0,0 +1,166 @@
+/**
+ * @file   task_graph.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file declares the TaskGraph class.
+ */
+
+
+#ifndef TILEDB_TASK_GRAPH_H
+#define TILEDB_TASK_GRAPH_H
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "tiledb/common/macros.h"
+#include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool/thread_pool.h"
+
+namespace tiledb {
+namespace common {
+
+/**
+ * A graph of tasks with dependencies between them. Every node is executed on
+ * its own thread pool as soon as all the nodes it depends on have completed,
+ * which lets the stages of independent units of work (e.g. the I/O of a tile
+ * batch and the decompression of the previous one) overlap across pools.
+ *
+ * Once a node fails, the nodes that have not started yet are skipped and the
+ * first error is returned by `run()`.
+ */
+class TaskGraph {
+ public:
+  /** Identifies a node of the graph. */
+  typedef uint64_t NodeId;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  TaskGraph();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(TaskGraph);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(TaskGraph);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Adds a node to the graph. Nodes can only depend on nodes that were added
+   * before them, so the graph is acyclic by construction.
+   *
+   * @param tp The thread pool to execute the node on.
+   * @param fn The function of the node.
+   * @param deps The nodes that must complete before this one starts.
+   * @return The id of the new node.
+   */
+  NodeId add_node(
+      ThreadPool* tp,
+      std::function<Status()>&& fn,
+      const std::vector<NodeId>& deps = {});
+
+  /**
+   * Executes the graph and waits for all of its nodes to complete. A graph
+   * can only be run once.
+   *
+   * @return Status::Ok if all nodes succeeded, otherwise the first error.
+   */
+  Status run();
+
+ private:
+  /* ********************************* */
+  /*          PRIVATE DATATYPES        */
+  /* ********************************* */
+
+  /** A node of the graph. */
+  struct Node {
+    /** The thread pool to execute the node on. */
+    ThreadPool* tp_;
+
+    /** The function of the node. */
+    std::function<Status()> fn_;
+
+    /** The nodes depending on this one. */
+    std::vector<NodeId> successors_;
+
+    /** The number of dependencies that have not completed yet. */
+    uint64_t pending_;
+  };
+
+  /** A scheduled node, along with the pool to wait on it. */
+  struct ScheduledTask {
+    /** The thread pool the node executes on. */
+    ThreadPool* tp_;
+
+    /** The task of the node. */
+    ThreadPool::Task task_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The nodes of the graph, indexed by id. */
+  std::vector<Node> nodes_;
+
+  /**
+   * The tasks of the scheduled nodes. A node schedules its ready successors
+   * before completing, so waiting on this list in order until its end waits
+   * on every node of the graph.
+   */
+  std::vector<ScheduledTask> scheduled_;
+
+  /** The first error returned by a node. */
+  Status status_;
+
+  /** Protects `nodes_` pending counts, `scheduled_` and `status_`. */
+  std::mutex mtx_;
+
+  /** True once `run()` has been called. */
+  bool started_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Schedules the given node on its thread pool. */
+  void schedule(NodeId id);
+
+  /**
+   * Records the status of a completed node and schedules the successors it
+   * was the last dependency of.
+   */
+  void complete(NodeId id, const Status& st);
+};
+
+}  // namespace common
+}  // namespace tiledb
+
+#endif  // TILEDB_TASK_GRAPH_H
@@ -30,72 +30,157 @@
  * This file defines the ThreadPool class.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <fstream>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include "tiledb/common/logger.h"
 #include "tiledb/common/thread_pool.h"
+#include "tiledb/common/tracer.h"
 
 namespace tiledb {
 namespace common {
 
+namespace {
+
+/**
+ * Parses a list of CPUs and CPU ranges in the format of the Linux cpusets,
+ * e.g. `0-3,8,10-11`.
+ */
+Status parse_cpu_list(const std::string& str, ThreadPool::CpuSet* cpus) {
+  cpus->clear();
+  size_t pos = 0;
+  while (pos < str.size()) {
+    auto end = str.find(',', pos);
+    if (end == std::string::npos)
+      end = str.size();
+    const auto range = str.substr(pos, end - pos);
+    pos = end + 1;
+
+    const auto dash = range.find('-');
+    uint64_t first, last;
+    try {
+      size_t idx = 0;
+      first = std::stoull(range.substr(0, dash), &idx);
+      if (idx != (dash == std::string::npos ? range.size() : dash))
+        throw std::invalid_argument(range);
+      last = first;
+      if (dash != std::string::npos) {
+        last = std::stoull(range.substr(dash + 1), &idx);
+        if (idx != range.size() - dash - 1)
+          throw std::invalid_argument(range);
+      }
+    } catch (const std::exception&) {
+      return Status_ThreadPoolError("Invalid CPU list " + str);
+    }
+    // Bound the CPU ids so that a mistyped range cannot blow up the list.
+    if (first > last || last > 4095)
+      return Status_ThreadPoolError("Invalid CPU range " + range);
+    for (uint64_t cpu = first; cpu <= last; ++cpu)
+      cpus->emplace_back(cpu);
+  }
+
+  if (cpus->empty())
+    return Status_ThreadPoolError("Invalid CPU list " + str);
+
+  return Status::Ok();
+}
+
+}  // namespace
+
 // Define the static ThreadPool member variables.
-std::unordered_map<std::thread::id, ThreadPool*> ThreadPool::tp_index_;
-std::mutex ThreadPool::tp_index_lock_;
-std::unordered_map<std::thread::id, tdb_shared_ptr<ThreadPool::PackagedTask>>
-    ThreadPool::task_index_;
-std::mutex ThreadPool::task_index_lock_;
+thread_local ThreadPool* ThreadPool::current_tp_ = nullptr;
+thread_local uint64_t ThreadPool::current_worker_ = 0;
+thread_local tdb_shared_ptr<ThreadPool::PackagedTask> ThreadPool::current_task_;
+thread_local ThreadPool::Priority ThreadPool::current_priority_ =
+    ThreadPool::Priority::NORMAL;
+thread_local tdb_shared_ptr<CancellationToken> ThreadPool::current_token_;
 
 ThreadPool::ThreadPool()
     : concurrency_level_(0)
-    , task_stack_clock_(0)
+    , task_num_(0)
+    , background_task_num_(0)
+    , background_running_(0)
+    , background_limit_(1)
+    , next_queue_(0)
+    , task_clock_(0)
     , idle_threads_(0)
-    , should_terminate_(false) {
+    , should_terminate_(false)
+    , counters_enabled_(false)
+    , task_submitted_num_(0)
+    , task_executed_num_(0)
+    , queue_depth_max_(0) {
+  for (auto& bucket : task_wait_histogram_)
+    bucket = 0;
 }
 
 ThreadPool::~ThreadPool() {
   terminate();
 }
 
-Status ThreadPool::init(const uint64_t concurrency_level) {
+Status ThreadPool::init(
+    const uint64_t concurrency_level, const std::vector<CpuSet>& affinity) {
   if (concurrency_level == 0) {
     return Status_ThreadPoolError(
         "Unable to initialize a thread pool with a concurrency level of 0.");
   }
 
-  Status st = Status::Ok();
-
   // We allocate one less thread than `concurrency_level` because
   // the `wait_all*()` routines may service tasks concurrently with
   // the worker threads.
   const uint64_t num_threads = concurrency_level - 1;
-  for (uint64_t i = 0; i < num_threads; i++) {
-    try {
-      threads_.emplace_back([this]() { worker(*this); });
-    } catch (const std::exception& e) {
-      st = Status_ThreadPoolError(
-          "Error initializing thread pool of concurrency level " +
-          std::to_string(concurrency_level) + "; " + e.what());
-      LOG_STATUS(st);
-      break;
-    }
-  }
 
-  if (!st.ok()) {
-    // Join any created threads on error.
-    terminate();
-    return st;
-  }
+  // Create the queues before the threads start looking at them.
+  queues_.reserve(num_threads);
+  for (uint64_t i = 0; i < num_threads; i++)
+    queues_.emplace_back(new WorkerQueue());
+
+  // Leave at least half of the workers to the normal tasks.
+  background_limit_ = std::max<uint64_t>(1, num_threads / 2);
+
+  // The worker threads are started with the first task.
+  affinity_ = affinity;
 
   // Save the concurrency level.
   concurrency_level_ = concurrency_level;
 
-  // Add indexes from this ThreadPool instance from all of its thread ids.
-  add_tp_index();
+  return Status::Ok();
+}
+
+Status ThreadPool::start_workers() {
+  std::call_once(workers_started_, [this]() {
+    Status st = Status::Ok();
+    for (uint64_t i = 0; i < queues_.size(); i++) {
+      try {
+        threads_.emplace_back([this, i]() { worker(*this, i); });
+        if (!affinity_.empty()) {
+          st = pin_thread(threads_.back(), affinity_[i % affinity_.size()]);
+          if (!st.ok())
+            break;
+        }
+      } catch (const std::exception& e) {
+        st = Status_ThreadPoolError(
+            "Error initializing thread pool of concurrency level " +
+            std::to_string(concurrency_level_) + "; " + e.what());
+        LOG_STATUS(st);
+        break;
+      }
+    }
 
-  // Add task indexes for each thread in this thread pool.
-  add_task_index();
+    // Join any created threads on error.
+    if (!st.ok())
+      terminate();
+    workers_st_ = st;
+  });
 
-  return st;
+  return workers_st_;
 }
 
 ThreadPool::Task ThreadPool::execute(std::function<Status()>&& function) {
@@ -111,81 +196,78 @@ ThreadPool::Task ThreadPool::execute(std::function<Status()>&& function) {
     return invalid_future;
   }
 
-  std::unique_lock<std::mutex> ul(task_stack_mutex_);
-
   if (should_terminate_) {
     Task invalid_future;
     LOG_ERROR("Cannot execute task; thread pool has terminated.");
     return invalid_future;
   }
 
-  // Locate the currently executing task, which may be null.
-  const std::thread::id tid = std::this_thread::get_id();
-  tdb_shared_ptr<PackagedTask> parent_task = lookup_task(tid);
+  if (concurrency_level_ > 1 && !start_workers().ok()) {
+    Task invalid_future;
+    LOG_ERROR("Cannot execute task; thread pool workers failed to start.");
+    return invalid_future;
+  }
 
-  // Create the packaged task.
+  // Create the packaged task, its parent is the currently executing task,
+  // which may be null. Its priority and cancellation token are the ones of
+  // the calling thread, which are those of the executing task if any.
   auto task = tiledb::common::make_shared<PackagedTask>(
-      HERE(), std::move(function), std::move(parent_task));
+      HERE(),
+      std::move(function),
+      tdb_shared_ptr<PackagedTask>(current_task_),
+      current_priority_,
+      current_token_);
 
   // Fetch the future from the packaged task.
   ThreadPool::Task future = task->get_future();
 
+  // Spans recorded by the task are attributed to the query of the caller
+  task->set_trace_id(Tracer::current_trace_id());
+
+  if (counters_enabled_) {
+    ++task_submitted_num_;
+    task->set_submitted_ns(now_ns());
+  }
+
   // When we have a concurrency level > 1, we will have at least
   // one thread available to pick up the task. For a concurrency
   // level == 1, we have no worker threads available. When no
   // worker threads are available, execute the task on this
   // thread.
   if (concurrency_level_ == 1) {
-    ul.unlock();
     exec_packaged_task(task);
-  } else {
-    // Lookup the thread pool that this thread belongs to. If it
-    // does not belong to a thread pool, `lookup_tp` will return
-    // `nullptr`.
-    ThreadPool* const tp = lookup_tp(tid);
-
+  } else if (current_tp_ == this && idle_threads_ == 0) {
     // As both an optimization and a means of breaking deadlock,
-    // execute the task if this thread belongs to `this`. Otherwise,
-    // queue it for a worker thread.
-    if (tp == this && idle_threads_ == 0) {
-      ul.unlock();
-      exec_packaged_task(task);
-    } else {
-      // Add `task` to the stack of pending tasks.
-      task_stack_.emplace_back(std::move(task));
-      task_stack_cv_.notify_one();
-
-      // Increment the logical clock to indicate that the
-      // `task_stack_` has been modified.
-      ++task_stack_clock_;
-
-      // The `ul` protects `task_stack_`, `task_stack_clock_`, and
-      // `idle_threads_`. Save a copy of `idle_threads_` before releasing
-      // the lock.
-      const uint64_t idle_threads_cp = idle_threads_;
-      ul.unlock();
-
-      // If all threads are busy, signal a thread in `this` that is
-      // blocked waiting on another task. This wakes up one of those
-      // threads to service the `task` that we just added to `task_stack_`.
-      // There is a race here on `idle_threads_` because we just released
-      // the lock. If a thread became idle and picks up `task`, we have
-      // spuriously unlocked a thread in the `wait` path. It will find
-      // that the `task_stack_` is empty and re-enter its wait.
-      if (idle_threads_cp == 0) {
-        blocked_tasks_mutex_.lock();
-        if (!blocked_tasks_.empty()) {
-          // Signal the first blocked task to wake up and check the task
-          // stack for a task to execute.
-          tdb_shared_ptr<TaskState> blocked_task = *blocked_tasks_.begin();
-          {
-            std::lock_guard<std::mutex> lg(blocked_task->return_st_mutex_);
-            blocked_task->check_task_stack_ = true;
-          }
-          blocked_task->cv_.notify_all();
-          blocked_tasks_.erase(blocked_task);
+    // execute the task if this thread belongs to `this` and all the
+    // other workers are busy.
+    exec_packaged_task(task);
+  } else {
+    // Push the task on the queue of this worker, or spread the tasks of
+    // other threads over the queues.
+    const uint64_t idx = current_tp_ == this ?
+                             current_worker_ :
+                             next_queue_++ % queues_.size();
+    push_task(idx, std::move(task));
+
+    // If all threads are busy, signal a thread in `this` that is
+    // blocked waiting on another task. This wakes up one of those
+    // threads to service the `task` that we just added. There is a race
+    // here on `idle_threads_`. If a thread became idle and picks up
+    // `task`, we have spuriously unlocked a thread in the `wait` path.
+    // It will find that the queues are empty and re-enter its wait.
+    if (idle_threads_ == 0) {
+      std::lock_guard<std::mutex> lg(blocked_tasks_mutex_);
+      if (!blocked_tasks_.empty()) {
+        // Signal the first blocked task to wake up and check the queues
+        // for a task to execute.
+        tdb_shared_ptr<TaskState> blocked_task = *blocked_tasks_.begin();
+        {
+          std::lock_guard<std::mutex> lg_state(
+              blocked_task->return_st_mutex_);
+          blocked_task->check_task_stack_ = true;
         }
-        blocked_tasks_mutex_.unlock();
+        blocked_task->cv_.notify_all();
+        blocked_tasks_.erase(blocked_task);
       }
     }
   }
@@ -194,10 +276,104 @@ ThreadPool::Task ThreadPool::execute(std::function<Status()>&& function) {
   return future;
 }
 
+void ThreadPool::set_counters_enabled(const bool enabled) {
+  counters_enabled_ = enabled;
+}
+
+ThreadPool::Counters ThreadPool::take_counters() {
+  Counters counters;
+  counters.task_submitted_num = task_submitted_num_.exchange(0);
+  counters.task_executed_num = task_executed_num_.exchange(0);
+  counters.queue_depth_max = queue_depth_max_.exchange(0);
+  for (uint64_t i = 0; i < WAIT_BUCKET_NUM; ++i)
+    counters.task_wait_histogram[i] = task_wait_histogram_[i].exchange(0);
+  for (auto& queue : queues_) {
+    counters.worker_busy_ns.emplace_back(queue->busy_ns_.exchange(0));
+    counters.worker_idle_ns.emplace_back(queue->idle_ns_.exchange(0));
+  }
+
+  return counters;
+}
+
 uint64_t ThreadPool::concurrency_level() const {
   return concurrency_level_;
 }
 
+ThreadPool::Priority ThreadPool::current_priority() {
+  return current_priority_;
+}
+
+Status ThreadPool::priority_enum(const std::string& str, Priority* priority) {
+  if (str == "normal")
+    *priority = Priority::NORMAL;
+  else if (str == "background")
+    *priority = Priority::BACKGROUND;
+  else
+    return Status_ThreadPoolError("Invalid thread pool priority " + str);
+
+  return Status::Ok();
+}
+
+Status ThreadPool::parse_affinity(
+    const std::string& str, std::vector<CpuSet>* affinity) {
+  affinity->clear();
+  if (str.empty())
+    return Status::Ok();
+
+  if (str != "numa") {
+    CpuSet cpus;
+    RETURN_NOT_OK(parse_cpu_list(str, &cpus));
+    for (const auto cpu : cpus)
+      affinity->push_back({cpu});
+    return Status::Ok();
+  }
+
+#ifdef __linux__
+  // The NUMA node ids may be sparse, so list them rather than counting.
+  DIR* dir = opendir("/sys/devices/system/node");
+  if (dir != nullptr) {
+    std::vector<uint64_t> nodes;
+    while (auto entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+          name.find_first_not_of("0123456789", 4) == std::string::npos)
+        nodes.emplace_back(std::stoull(name.substr(4)));
+    }
+    closedir(dir);
+    std::sort(nodes.begin(), nodes.end());
+
+    for (const auto node : nodes) {
+      std::ifstream file(
+          "/sys/devices/system/node/node" + std::to_string(node) +
+          "/cpulist");
+      std::string cpu_list;
+      CpuSet cpus;
+      // Memory-only nodes have an empty CPU list.
+      if (std::getline(file, cpu_list) && !cpu_list.empty() &&
+          parse_cpu_list(cpu_list, &cpus).ok())
+        affinity->emplace_back(std::move(cpus));
+    }
+  }
+#endif
+
+  // Without NUMA information, treat the machine as a single node.
+  if (affinity->empty()) {
+    CpuSet cpus(std::max(1u, std::thread::hardware_concurrency()));
+    for (uint64_t i = 0; i < cpus.size(); ++i)
+      cpus[i] = i;
+    affinity->emplace_back(std::move(cpus));
+  }
+
+  return Status::Ok();
+}
+
+Status ThreadPool::check_cancellation() {
+  if (current_token_ == nullptr)
+    return Status::Ok();
+
+  return current_token_->check();
+}
+
 Status ThreadPool::wait_all(std::vector<Task>& tasks) {
   auto statuses = wait_all_status(tasks);
   for (auto& st : statuses) {
@@ -226,31 +402,28 @@ std::vector<Status> ThreadPool::wait_all_status(std::vector<Task>& tasks) {
 }
 
 Status ThreadPool::wait_or_work(Task&& task) {
-  // Records the last read value from `task_stack_clock_`.
-  uint64_t last_task_stack_clock = 0;
+  // Records the last read value from `task_clock_`.
+  uint64_t last_task_clock = 0;
+
+  // True if the queues must be searched regardless of `task_clock_`.
+  bool rescan = true;
 
   do {
     if (task.done())
       break;
 
-    // Lock the `task_stack_` to receive the next task to work on.
-    task_stack_mutex_.lock();
-
-    // Determine if `task_stack_` has been modified since our
-    // last loop. This is always true for the first iteration
-    // in this loop. Note that `task_stack_clock_` may overflow,
-    // producing a false-positive. In that scenario, we will
-    // perform one spurious loop but will not affect the
-    // correctness of this routine.
-    const bool task_stack_modified = last_task_stack_clock == 0 ||
-                                     last_task_stack_clock != task_stack_clock_;
-
-    // If there are no pending tasks or the stack of pending tasks has
-    // not changed since our last inspection, we will wait for `task`
-    // to complete.
-    if (task_stack_.empty() || !task_stack_modified) {
-      task_stack_mutex_.unlock();
-
+    // Determine if tasks have been added to `queues_` since our last
+    // loop. This is always true for the first iteration in this loop and
+    // after executing a task. Note that `task_clock_` may overflow,
+    // producing a false-positive. In that scenario, we will perform one
+    // spurious loop but will not affect the correctness of this routine.
+    const uint64_t task_clock = task_clock_;
+    const bool queues_modified = rescan || last_task_clock != task_clock;
+    rescan = false;
+
+    // If there are no pending tasks or the pending tasks have not changed
+    // since our last inspection, we will wait for `task` to complete.
+    if (task_num_ == 0 || !queues_modified) {
       // Add `task` to `blocked_tasks_` so that the `execute()` path can
       // signal it when a new pending task is available.
       blocked_tasks_mutex_.lock();
@@ -258,8 +431,10 @@ Status ThreadPool::wait_or_work(Task&& task) {
       blocked_tasks_mutex_.unlock();
 
       // Block until the task is signaled. It will be signaled when it
-      // has completed or when there is new work to execute on `task_stack_`.
-      task.wait();
+      // has completed or when there is new work to execute. Skip the wait
+      // if a task was added while registering.
+      if (task_clock_ == task_clock)
+        task.wait();
 
       // Remove `task` from `blocked_tasks_`.
       blocked_tasks_mutex_.lock();
@@ -273,75 +448,28 @@ Status ThreadPool::wait_or_work(Task&& task) {
       }
 
       // The task did not complete. This task has been signaled because a new
-      // pending task was added to `task_stack_`. Reset the `check_task_stack_`
-      // flag.
+      // pending task was added. Reset the `check_task_stack_` flag.
       {
         std::lock_guard<std::mutex> lg(task.task_state_->return_st_mutex_);
         task.task_state_->check_task_stack_ = false;
       }
-
-      // Lock the `task_stack_` again before checking for the next pending task.
-      task_stack_mutex_.lock();
     }
 
-    // We may have released and re-aquired the `task_stack_mutex_`. We must
-    // check if it is still non-empty.
-    if (!task_stack_.empty()) {
-      // Pull the next task off of the task stack. We specifically use a LIFO
-      // ordering to prevent overflowing the call stack. We will skip tasks
-      // that are not descendents of the task we are currently executing in.
-      const std::thread::id tid = std::this_thread::get_id();
-      tdb_shared_ptr<PackagedTask> current_task = lookup_task(tid);
-      tdb_shared_ptr<PackagedTask> descendent_task = nullptr;
-      if (current_task == nullptr) {
-        // We are not executing in the context of a threadpool task, we do
-        // not have any restriction on which task we can execute. Select
-        // the next one.
-        descendent_task = task_stack_.back();
-        task_stack_.pop_back();
-      } else {
-        // Find the next pending task that is a descendent of `current_task`.
-        for (auto riter = task_stack_.rbegin(); riter != task_stack_.rend();
-             ++riter) {
-          // Determine if the task pointed to by `riter` is a descendent
-          // of `current_task`.
-          const PackagedTask* tmp_task = riter->get();
-          while (tmp_task != nullptr) {
-            const PackagedTask* const tmp_task_parent = tmp_task->get_parent();
-            if (tmp_task_parent == current_task.get()) {
-              descendent_task = *riter;
-              break;
-            }
-            tmp_task = tmp_task_parent;
-          }
-
-          // If we found a descendent task, erase it from the task stack
-          // and break.
-          if (descendent_task != nullptr) {
-            task_stack_.erase(std::next(riter).base());
-            break;
-          }
-        }
-      }
-
-      // Save the current state of `task_stack_clock_`. We may mutate it below.
-      last_task_stack_clock = task_stack_clock_;
-
-      // If `descendent_task` is non-null, we must have removed it from
-      // the `task_stack_`. In this scenario, increment the logical clock
-      // to indicate that the `task_stack_` has been modified.
-      if (descendent_task != nullptr)
-        ++task_stack_clock_;
-
-      // We're done mutating `task_stack_` and `task_stack_clock_`.
-      task_stack_mutex_.unlock();
-
-      // Execute the descendent task if we found one.
-      if (descendent_task != nullptr)
-        exec_packaged_task(descendent_task);
-    } else {
-      // The task stack is now empty, retry.
-      task_stack_mutex_.unlock();
+    // Save the current state of `task_clock_`.
+    last_task_clock = task_clock_;
+
+    // Pull the next pending task. We specifically use a LIFO ordering to
+    // prevent overflowing the call stack. We will skip tasks that are not
+    // descendents of the task we are currently executing in. If we are not
+    // executing in the context of a threadpool task, we do not have any
+    // restriction on which task we can execute.
+    tdb_shared_ptr<PackagedTask> descendent_task =
+        pop_descendent_task(current_task_.get());
+
+    // Execute the descendent task if we found one. Otherwise, retry.
+    if (descendent_task != nullptr) {
+      exec_packaged_task(descendent_task);
+      rescan = true;
     }
   } while (true);
 
@@ -352,114 +480,262 @@ Status ThreadPool::wait_or_work(Task&& task) {
 
 void ThreadPool::terminate() {
   {
-    std::unique_lock<std::mutex> ul(task_stack_mutex_);
+    std::unique_lock<std::mutex> ul(idle_mutex_);
     should_terminate_ = true;
-    task_stack_cv_.notify_all();
+    idle_cv_.notify_all();
   }
 
-  remove_tp_index();
-
   for (auto& t : threads_) {
     t.join();
   }
 
-  remove_task_index();
-
   threads_.clear();
+  queues_.clear();
 }
 
-void ThreadPool::worker(ThreadPool& pool) {
-  while (true) {
-    tdb_shared_ptr<PackagedTask> task = nullptr;
-
-    {
-      // Wait until there's work to do.
-      std::unique_lock<std::mutex> ul(pool.task_stack_mutex_);
-      ++pool.idle_threads_;
-      pool.task_stack_cv_.wait(ul, [&pool]() {
-        return pool.should_terminate_ || !pool.task_stack_.empty();
-      });
-
-      if (!pool.task_stack_.empty()) {
-        task = std::move(pool.task_stack_.back());
-        pool.task_stack_.pop_back();
-        --pool.idle_threads_;
-      } else {
-        // The task stack was empty, ensure `task` is invalid.
-        task = nullptr;
+Status ThreadPool::pin_thread(std::thread& thread, const CpuSet& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE)
+      return Status_ThreadPoolError(
+          "Cannot pin thread to CPU " + std::to_string(cpu));
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  if (pthread_setaffinity_np(
+          thread.native_handle(), sizeof(cpu_set), &cpu_set) != 0)
+    return Status_ThreadPoolError(
+        "Cannot pin thread to CPUs; none of them is available");
+#else
+  // Thread affinity is only supported on Linux, the threads stay unpinned
+  // elsewhere.
+  (void)thread;
+  (void)cpus;
+#endif
+
+  return Status::Ok();
+}
+
+void ThreadPool::worker(ThreadPool& pool, const uint64_t idx) {
+  current_tp_ = &pool;
+  current_worker_ = idx;
+
+  uint64_t task_count = 0;
+  while (!pool.should_terminate_) {
+    const bool prefer_background =
+        ++task_count % ThreadPool::background_interval == 0;
+    tdb_shared_ptr<PackagedTask> task =
+        pool.pop_task(idx, prefer_background);
+    if (task != nullptr) {
+      const uint64_t start = pool.counters_enabled_ ? now_ns() : 0;
+      pool.exec_packaged_task(task);
+      if (start != 0)
+        pool.queues_[idx]->busy_ns_ += now_ns() - start;
+
+      // Let another worker pick up a background task if this one was
+      // holding back the pending ones.
+      if (task->priority() == Priority::BACKGROUND) {
+        --pool.background_running_;
+        if (pool.background_task_num_ > 0 && pool.idle_threads_ > 0) {
+          { std::lock_guard<std::mutex> lg(pool.idle_mutex_); }
+          pool.idle_cv_.notify_one();
+        }
       }
+      continue;
     }
 
-    if (task != nullptr)
-      exec_packaged_task(task);
-
-    if (pool.should_terminate_)
-      break;
+    // Wait until there's work to do that this worker is allowed to run.
+    const uint64_t start = pool.counters_enabled_ ? now_ns() : 0;
+    std::unique_lock<std::mutex> ul(pool.idle_mutex_);
+    ++pool.idle_threads_;
+    pool.idle_cv_.wait(ul, [&pool]() {
+      const uint64_t background_task_num = pool.background_task_num_;
+      return pool.should_terminate_ ||
+             pool.task_num_ > background_task_num ||
+             (background_task_num > 0 &&
+              pool.background_running_ < pool.background_limit_);
+    });
+    --pool.idle_threads_;
+    if (start != 0)
+      pool.queues_[idx]->idle_ns_ += now_ns() - start;
   }
-}
 
-void ThreadPool::add_tp_index() {
-  std::lock_guard<std::mutex> lock(tp_index_lock_);
-  for (const auto& thread : threads_)
-    tp_index_[thread.get_id()] = this;
+  current_tp_ = nullptr;
 }
 
-void ThreadPool::remove_tp_index() {
-  std::lock_guard<std::mutex> lock(tp_index_lock_);
-  for (const auto& thread : threads_)
-    tp_index_.erase(thread.get_id());
+void ThreadPool::push_task(
+    const uint64_t idx, tdb_shared_ptr<PackagedTask>&& task) {
+  auto& queue = *queues_[idx];
+  {
+    const auto priority = task->priority();
+    std::lock_guard<std::mutex> lg(queue.mutex_);
+    queue.tasks_[static_cast<uint8_t>(priority)].emplace_back(std::move(task));
+    if (priority == Priority::BACKGROUND)
+      ++background_task_num_;
+    const uint64_t depth = ++task_num_;
+    if (counters_enabled_) {
+      uint64_t depth_max = queue_depth_max_;
+      while (depth > depth_max &&
+             !queue_depth_max_.compare_exchange_weak(depth_max, depth)) {
+      }
+    }
+  }
+
+  // Increment the logical clock to indicate that the queues have been
+  // modified.
+  ++task_clock_;
+
+  // Wake up an idle worker. Taking `idle_mutex_` ensures that a worker
+  // that saw no pending task is already waiting on `idle_cv_`.
+  if (idle_threads_ > 0) {
+    { std::lock_guard<std::mutex> lg(idle_mutex_); }
+    idle_cv_.notify_one();
+  }
 }
 
-ThreadPool* ThreadPool::lookup_tp(const std::thread::id tid) {
-  std::lock_guard<std::mutex> lock(tp_index_lock_);
-  if (tp_index_.count(tid) == 1)
-    return tp_index_[tid];
+tdb_shared_ptr<ThreadPool::PackagedTask> ThreadPool::pop_task(
+    const uint64_t idx, const bool prefer_background) {
+  if (task_num_ == 0)
+    return nullptr;
+
+  const Priority priorities[] = {
+      prefer_background ? Priority::BACKGROUND : Priority::NORMAL,
+      prefer_background ? Priority::NORMAL : Priority::BACKGROUND};
+  for (const auto priority : priorities) {
+    if (priority == Priority::NORMAL) {
+      auto task = pop_task(idx, priority);
+      if (task != nullptr)
+        return task;
+      continue;
+    }
+
+    // Reserve a background slot before looking for a background task.
+    uint64_t running = background_running_;
+    do {
+      if (running >= background_limit_)
+        break;
+    } while (
+        !background_running_.compare_exchange_weak(running, running + 1));
+    if (running >= background_limit_)
+      continue;
+
+    auto task = pop_task(idx, priority);
+    if (task != nullptr)
+      return task;
+    --background_running_;
+  }
+
   return nullptr;
 }
 
-void ThreadPool::add_task_index() {
-  std::lock_guard<std::mutex> lock(task_index_lock_);
-  for (const auto& thread : threads_)
-    task_index_[thread.get_id()] = nullptr;
-}
+tdb_shared_ptr<ThreadPool::PackagedTask> ThreadPool::pop_task(
+    const uint64_t idx, const Priority priority) {
+  const uint64_t queue_num = queues_.size();
+  const auto lane = static_cast<uint8_t>(priority);
+  for (uint64_t i = 0; i < queue_num; i++) {
+    auto& queue = *queues_[(idx + i) % queue_num];
+    std::lock_guard<std::mutex> lg(queue.mutex_);
+    auto& tasks = queue.tasks_[lane];
+    if (tasks.empty())
+      continue;
+
+    // Pop the newest task of our own queue, steal the oldest task of
+    // the others.
+    tdb_shared_ptr<PackagedTask> task;
+    if (i == 0) {
+      task = std::move(tasks.back());
+      tasks.pop_back();
+    } else {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    if (priority == Priority::BACKGROUND)
+      --background_task_num_;
+    --task_num_;
+    return task;
+  }
 
-void ThreadPool::remove_task_index() {
-  std::lock_guard<std::mutex> lock(task_index_lock_);
-  for (const auto& thread : threads_)
-    task_index_.erase(thread.get_id());
+  return nullptr;
 }
 
-tdb_shared_ptr<ThreadPool::PackagedTask> ThreadPool::lookup_task(
-    const std::thread::id tid) {
-  std::lock_guard<std::mutex> lock(task_index_lock_);
-  if (task_index_.count(tid) == 1)
-    return task_index_[tid];
+tdb_shared_ptr<ThreadPool::PackagedTask> ThreadPool::pop_descendent_task(
+    const PackagedTask* const ancestor) {
+  if (task_num_ == 0)
+    return nullptr;
+
+  const uint64_t queue_num = queues_.size();
+  const uint64_t first = current_tp_ == this ? current_worker_ : 0;
+  for (uint8_t lane = 0; lane < PRIORITY_NUM; lane++) {
+    for (uint64_t i = 0; i < queue_num; i++) {
+      auto& queue = *queues_[(first + i) % queue_num];
+      std::lock_guard<std::mutex> lg(queue.mutex_);
+      auto& tasks = queue.tasks_[lane];
+      for (auto riter = tasks.rbegin(); riter != tasks.rend(); ++riter) {
+        // Determine if the task pointed to by `riter` is a descendent
+        // of `ancestor`.
+        bool is_descendent = ancestor == nullptr;
+        const PackagedTask* tmp_task = riter->get();
+        while (!is_descendent && tmp_task != nullptr) {
+          const PackagedTask* const tmp_task_parent = tmp_task->get_parent();
+          is_descendent = tmp_task_parent == ancestor;
+          tmp_task = tmp_task_parent;
+        }
+
+        // If we found a descendent task, erase it from the queue.
+        if (is_descendent) {
+          tdb_shared_ptr<PackagedTask> task = std::move(*riter);
+          tasks.erase(std::next(riter).base());
+          if (task->priority() == Priority::BACKGROUND)
+            --background_task_num_;
+          --task_num_;
+          return task;
+        }
+      }
+    }
+  }
+
   return nullptr;
 }
 
 void ThreadPool::exec_packaged_task(tdb_shared_ptr<PackagedTask> const task) {
-  const std::thread::id tid = std::this_thread::get_id();
-
-  // Before we execute `task`, we must update `task_index_` to map
-  // this thread-id to the executing task. Note that we only lock
-  // `task_index_` to protect the container itself. The elements
-  // on the map are only ever accessed by the thread that the
-  // element is keyed on, making it implicitly safe.
-  tdb_shared_ptr<PackagedTask> tmp_task = nullptr;
-  std::unique_lock<std::mutex> ul(task_index_lock_);
-  if (task_index_.count(tid) == 1)
-    tmp_task = task_index_[tid];
-  task_index_[tid] = task;
-  ul.unlock();
+  // Before we execute `task`, we must update `current_task_` to the
+  // executing task, and the priority and cancellation token of the tasks it
+  // schedules. They are thread-local, so they need no locking.
+  tdb_shared_ptr<PackagedTask> tmp_task = std::move(current_task_);
+  current_task_ = task;
+  ScopedPriority priority(task->priority());
+  ScopedCancellation cancellation(task->token());
+
+  if (counters_enabled_ && task->submitted_ns() != 0) {
+    // Count the wait of the task in the bucket of its power of two in
+    // microseconds.
+    const uint64_t wait_us = (now_ns() - task->submitted_ns()) / 1000;
+    uint64_t bucket = 0;
+    while (bucket < WAIT_BUCKET_NUM - 1 && (wait_us >> bucket) != 0)
+      ++bucket;
+    ++task_wait_histogram_[bucket];
+    ++task_executed_num_;
+  }
 
   // Execute `task`.
+  Tracer::ScopedTraceId trace_id(task->trace_id());
+  const uint64_t trace_start_ns = tracer.enabled() ? Tracer::now_ns() : 0;
   (*task)();
+  if (trace_start_ns != 0)
+    tracer.record(
+        "ThreadPool.task", "thread_pool", trace_start_ns, Tracer::now_ns());
 
-  // Restore `task_index_` to the task that it was previously
+  // Restore `current_task_` to the task that it was previously
   // executing, which may be null.
-  ul.lock();
-  task_index_[tid] = tmp_task;
-  ul.unlock();
+  current_task_ = std::move(tmp_task);
+}
+
+uint64_t ThreadPool::now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
 
 }  // namespace common
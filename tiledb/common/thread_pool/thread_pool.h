@@ -33,23 +33,44 @@
 #ifndef TILEDB_THREAD_POOL_H
 #define TILEDB_THREAD_POOL_H
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <stack>
+#include <string>
 #include <thread>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "tiledb/common/macros.h"
 #include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool/cancellation_token.h"
 
 namespace tiledb {
 namespace common {
 
 /**
  * A recusive-safe thread pool.
+ *
+ * Every worker thread owns a deque of pending tasks. Tasks scheduled from a
+ * worker thread are pushed on its own deque, and tasks scheduled from other
+ * threads are spread over the deques round-robin. A worker pops the newest
+ * task of its own deque and, when it is empty, steals the oldest task of
+ * another deque, so that nested parallelism does not serialize on a single
+ * queue lock.
+ *
+ * Tasks have a priority, inherited from the task that scheduled them or
+ * set on the scheduling thread with `ScopedPriority`. Workers run the
+ * pending normal tasks before the background ones, except for one task in
+ * every `background_interval` so that background work is not starved, and
+ * at most half of the workers run background tasks at any time.
+ *
+ * Tasks also inherit the cancellation token of the scheduling thread, set
+ * with `ScopedCancellation`. A task whose token is cancelled by the time it
+ * is dequeued is not run and completes with the cancellation status.
  */
 class ThreadPool {
  private:
@@ -68,6 +89,99 @@ class ThreadPool {
   /*          PUBLIC DATATYPES         */
   /* ********************************* */
 
+  /** The priority of a task. */
+  enum class Priority : uint8_t {
+    /** Latency sensitive work, such as queries. */
+    NORMAL = 0,
+    /** Maintenance work, such as consolidation. */
+    BACKGROUND = 1,
+  };
+
+  /** The number of priorities. */
+  static constexpr uint64_t PRIORITY_NUM = 2;
+
+  /**
+   * Sets the priority of the tasks scheduled by the calling thread for the
+   * lifetime of this instance, then restores the previous priority.
+   */
+  class ScopedPriority {
+   public:
+    /** Constructor. */
+    explicit ScopedPriority(Priority priority)
+        : previous_(current_priority_) {
+      current_priority_ = priority;
+    }
+
+    /** Destructor. */
+    ~ScopedPriority() {
+      current_priority_ = previous_;
+    }
+
+    DISABLE_COPY_AND_COPY_ASSIGN(ScopedPriority);
+    DISABLE_MOVE_AND_MOVE_ASSIGN(ScopedPriority);
+
+   private:
+    /** The priority to restore. */
+    Priority previous_;
+  };
+
+  /**
+   * Sets the cancellation token of the calling thread and of the tasks it
+   * schedules for the lifetime of this instance, then restores the previous
+   * token.
+   */
+  class ScopedCancellation {
+   public:
+    /** Constructor. */
+    explicit ScopedCancellation(tdb_shared_ptr<CancellationToken> token)
+        : previous_(std::move(current_token_)) {
+      current_token_ = std::move(token);
+    }
+
+    /** Destructor. */
+    ~ScopedCancellation() {
+      current_token_ = std::move(previous_);
+    }
+
+    DISABLE_COPY_AND_COPY_ASSIGN(ScopedCancellation);
+    DISABLE_MOVE_AND_MOVE_ASSIGN(ScopedCancellation);
+
+   private:
+    /** The token to restore. */
+    tdb_shared_ptr<CancellationToken> previous_;
+  };
+
+  /** The CPUs a worker thread may run on. */
+  typedef std::vector<uint64_t> CpuSet;
+
+  /**
+   * The number of buckets of the histogram of the time tasks wait between
+   * their submission and their start. Bucket `i` counts the waits shorter
+   * than `2^i` microseconds, the last one the longer waits.
+   */
+  static constexpr uint64_t WAIT_BUCKET_NUM = 21;
+
+  /** Counters of the activity of a thread pool, see `take_counters`. */
+  struct Counters {
+    /** The number of tasks submitted. */
+    uint64_t task_submitted_num = 0;
+
+    /** The number of tasks executed. */
+    uint64_t task_executed_num = 0;
+
+    /** The maximum number of pending tasks. */
+    uint64_t queue_depth_max = 0;
+
+    /** The histogram of the waits of the tasks before they started. */
+    std::array<uint64_t, WAIT_BUCKET_NUM> task_wait_histogram{};
+
+    /** The time each worker thread spent executing tasks, in nanoseconds. */
+    std::vector<uint64_t> worker_busy_ns;
+
+    /** The time each worker thread spent idle, in nanoseconds. */
+    std::vector<uint64_t> worker_idle_ns;
+  };
+
   class Task {
    public:
     /** Constructor. */
@@ -145,12 +259,18 @@ class ThreadPool {
   /* ********************************* */
 
   /**
-   * Initialize the thread pool.
+   * Initialize the thread pool. The worker threads are started when the
+   * first task is executed, so that pools which are never used cost no
+   * threads.
    *
    * @param concurrency_level Maximum level of concurrency.
+   * @param affinity The CPU sets to pin the worker threads to, round-robin.
+   *     The workers are not pinned if it is empty.
    * @return Status
    */
-  Status init(uint64_t concurrency_level = 1);
+  Status init(
+      uint64_t concurrency_level = 1,
+      const std::vector<CpuSet>& affinity = {});
 
   /**
    * Schedule a new task to be executed. If the returned `Task` object
@@ -166,6 +286,49 @@ class ThreadPool {
   /** Return the maximum level of concurrency. */
   uint64_t concurrency_level() const;
 
+  /**
+   * Enables or disables the activity counters. They are disabled by default,
+   * as they read the clock around every task.
+   */
+  void set_counters_enabled(bool enabled);
+
+  /**
+   * Returns the activity counters accumulated since the previous call, and
+   * resets them.
+   */
+  Counters take_counters();
+
+  /** Returns the priority of the tasks scheduled by the calling thread. */
+  static Priority current_priority();
+
+  /**
+   * Parses a priority from its string representation, `normal` or
+   * `background`.
+   *
+   * @param str The string representation.
+   * @param priority The parsed priority.
+   * @return Status
+   */
+  static Status priority_enum(const std::string& str, Priority* priority);
+
+  /**
+   * Parses a worker thread affinity. The empty string leaves the workers
+   * unpinned, `numa` returns the CPU set of every NUMA node and a list of
+   * CPUs and CPU ranges, e.g. `0-3,8`, returns a CPU set per listed CPU.
+   *
+   * @param str The string representation.
+   * @param affinity The parsed CPU sets.
+   * @return Status
+   */
+  static Status parse_affinity(
+      const std::string& str, std::vector<CpuSet>* affinity);
+
+  /**
+   * Returns an error status if the cancellation token of the calling thread
+   * is cancelled, `Status::Ok()` if it is not or if there is no token.
+   */
+  static Status check_cancellation();
+
   /**
    * Wait on all the given tasks to complete. This is safe to call recusively
    * and may execute pending tasks on the calling thread while waiting.
@@ -228,15 +391,26 @@ class ThreadPool {
 
     /** Value constructor. */
     template <class Fn_T>
-    explicit PackagedTask(Fn_T&& fn, tdb_shared_ptr<PackagedTask>&& parent) {
+    explicit PackagedTask(
+        Fn_T&& fn,
+        tdb_shared_ptr<PackagedTask>&& parent,
+        Priority priority,
+        tdb_shared_ptr<CancellationToken> token) {
       fn_ = std::move(fn);
       task_state_ = make_shared<TaskState>(HERE());
       parent_ = std::move(parent);
+      priority_ = priority;
+      token_ = std::move(token);
     }
 
-    /** Function-call operator. */
+    /**
+     * Function-call operator. The function is not run if the cancellation
+     * token of the task is cancelled.
+     */
     void operator()() {
-      const Status r = fn_();
+      Status r = token_ == nullptr ? Status::Ok() : token_->check();
+      if (r.ok())
+        r = fn_();
       {
         std::lock_guard<std::mutex> lg(task_state_->return_st_mutex_);
         task_state_->return_st_set_ = true;
@@ -246,6 +420,7 @@ class ThreadPool {
 
       fn_ = std::function<Status()>();
       task_state_ = nullptr;
+      token_ = nullptr;
     }
 
     /** Returns the future associated with this task. */
@@ -257,6 +432,36 @@ class ThreadPool {
       return parent_.get();
     }
 
+    /** Returns the priority of this task. */
+    Priority priority() const {
+      return priority_;
+    }
+
+    /** Returns the cancellation token of this task, which may be null. */
+    const tdb_shared_ptr<CancellationToken>& token() const {
+      return token_;
+    }
+
+    /** Returns the time the task was submitted at, 0 if not recorded. */
+    uint64_t submitted_ns() const {
+      return submitted_ns_;
+    }
+
+    /** Sets the time the task was submitted at. */
+    void set_submitted_ns(uint64_t submitted_ns) {
+      submitted_ns_ = submitted_ns;
+    }
+
+    /** Returns the trace id of the thread that scheduled the task. */
+    uint64_t trace_id() const {
+      return trace_id_;
+    }
+
+    /** Sets the trace id of the thread that scheduled the task. */
+    void set_trace_id(uint64_t trace_id) {
+      trace_id_ = trace_id;
+    }
+
    private:
     DISABLE_COPY_AND_COPY_ASSIGN(PackagedTask);
     DISABLE_MOVE_AND_MOVE_ASSIGN(PackagedTask);
@@ -269,6 +474,36 @@ class ThreadPool {
 
     /** The parent task that executed this task. */
     tdb_shared_ptr<PackagedTask> parent_;
+
+    /** The priority of this task. */
+    Priority priority_;
+
+    /** The cancellation token of this task, which may be null. */
+    tdb_shared_ptr<CancellationToken> token_;
+
+    /** The time the task was submitted at, 0 if not recorded. */
+    uint64_t submitted_ns_ = 0;
+
+    /** The trace id of the thread that scheduled the task. */
+    uint64_t trace_id_ = 0;
+  };
+
+  /** The pending tasks of a worker thread. */
+  struct WorkerQueue {
+    /** Protects `tasks_`. */
+    std::mutex mutex_;
+
+    /**
+     * Pending tasks for each priority. The owner pushes and pops at the
+     * back, other threads steal from the front.
+     */
+    std::deque<tdb_shared_ptr<PackagedTask>> tasks_[PRIORITY_NUM];
+
+    /** The time the worker spent executing tasks, in nanoseconds. */
+    std::atomic<uint64_t> busy_ns_{0};
+
+    /** The time the worker spent idle, in nanoseconds. */
+    std::atomic<uint64_t> idle_ns_{0};
   };
 
   /* ********************************* */
@@ -281,34 +516,75 @@ class ThreadPool {
    */
   uint64_t concurrency_level_;
 
-  /** Protects `task_stack_`, `idle_threads_`, and `task_stack_clock_`. */
-  std::mutex task_stack_mutex_;
+  /** The pending tasks of each worker thread. */
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
 
-  /** Notifies work threads to check `task_stack_` for work. */
-  std::condition_variable task_stack_cv_;
+  /** The number of pending tasks over all `queues_`. */
+  std::atomic<uint64_t> task_num_;
 
-  /** Pending tasks in LIFO ordering. */
-  std::vector<tdb_shared_ptr<PackagedTask>> task_stack_;
+  /** The number of pending background tasks over all `queues_`. */
+  std::atomic<uint64_t> background_task_num_;
 
-  /*
-   * A logical, monotonically increasing clock that is incremented
-   * when a task is either added or removed from `task_stack_`. This
-   * is used by threads to determine if `task_stack_` has been modified
-   * between two points in time.
+  /** The number of workers running a background task. */
+  std::atomic<uint64_t> background_running_;
+
+  /** The maximum number of workers running a background task. */
+  uint64_t background_limit_;
+
+  /**
+   * A worker runs a pending background task before the pending normal
+   * tasks once in this many tasks.
    */
-  uint64_t task_stack_clock_;
+  static constexpr uint64_t background_interval = 8;
+
+  /** The next queue to push tasks scheduled by non-worker threads on. */
+  std::atomic<uint64_t> next_queue_;
 
   /**
-   * The number of threads waiting for the `task_stack_` to
-   * become non-empty.
+   * A logical, monotonically increasing clock that is incremented
+   * when a task is added to `queues_`. This is used by threads to
+   * determine if tasks were added between two points in time.
    */
-  uint64_t idle_threads_;
+  std::atomic<uint64_t> task_clock_;
+
+  /** Protects the sleep of idle worker threads on `idle_cv_`. */
+  std::mutex idle_mutex_;
+
+  /** Notifies idle worker threads to check `queues_` for work. */
+  std::condition_variable idle_cv_;
+
+  /** The number of worker threads sleeping on `idle_cv_`. */
+  std::atomic<uint64_t> idle_threads_;
 
   /** The worker threads. */
   std::vector<std::thread> threads_;
 
+  /** The CPU sets to pin the worker threads to, round-robin. */
+  std::vector<CpuSet> affinity_;
+
+  /** Ensures the worker threads are started once. */
+  std::once_flag workers_started_;
+
+  /** The status of starting the worker threads. */
+  Status workers_st_;
+
   /** When true, all pending tasks will remain unscheduled. */
-  bool should_terminate_;
+  std::atomic<bool> should_terminate_;
+
+  /** True if the activity counters are enabled. */
+  std::atomic<bool> counters_enabled_;
+
+  /** The number of tasks submitted since the last `take_counters`. */
+  std::atomic<uint64_t> task_submitted_num_;
+
+  /** The number of tasks executed since the last `take_counters`. */
+  std::atomic<uint64_t> task_executed_num_;
+
+  /** The maximum of `task_num_` since the last `take_counters`. */
+  std::atomic<uint64_t> queue_depth_max_;
+
+  /** The histogram of the task waits since the last `take_counters`. */
+  std::atomic<uint64_t> task_wait_histogram_[WAIT_BUCKET_NUM];
 
   /** All tasks that threads in this instance are waiting on. */
   struct BlockedTasksHasher {
@@ -322,57 +598,80 @@ class ThreadPool {
   /** Protects `blocked_tasks_`. */
   std::mutex blocked_tasks_mutex_;
 
-  /** Indexes thread ids to the ThreadPool instance they belong to. */
-  static std::unordered_map<std::thread::id, ThreadPool*> tp_index_;
+  /** The thread pool the calling thread is a worker of, if any. */
+  static thread_local ThreadPool* current_tp_;
 
-  /** Protects 'tp_index_'. */
-  static std::mutex tp_index_lock_;
+  /** The index of the calling thread among the workers of `current_tp_`. */
+  static thread_local uint64_t current_worker_;
 
-  /** Indexes thread ids to the task it is currently executing. */
-  static std::unordered_map<std::thread::id, tdb_shared_ptr<PackagedTask>>
-      task_index_;
+  /** The task the calling thread is executing, if any. */
+  static thread_local tdb_shared_ptr<PackagedTask> current_task_;
 
-  /** Protects 'task_index_'. */
-  static std::mutex task_index_lock_;
+  /** The priority of the tasks scheduled by the calling thread. */
+  static thread_local Priority current_priority_;
+
+  /**
+   * The cancellation token of the calling thread and of the tasks it
+   * schedules, which may be null.
+   */
+  static thread_local tdb_shared_ptr<CancellationToken> current_token_;
 
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
   /**
-   * Waits for `task`, but will execute other tasks from `task_stack_`
+   * Waits for `task`, but will execute other tasks from `queues_`
    * while waiting. While this may be an performance optimization
    * to perform work on this thread rather than waiting, the primary
    * motiviation is to prevent deadlock when tasks are enqueued recursively.
    */
   Status wait_or_work(Task&& task);
 
+  /** Starts the worker threads on the first call. */
+  Status start_workers();
+
   /** Terminate the threads in the thread pool. */
   void terminate();
 
-  /** The worker thread routine. */
-  static void worker(ThreadPool& pool);
+  /** Pins `thread` to the CPUs of `cpus`. */
+  static Status pin_thread(std::thread& thread, const CpuSet& cpus);
 
-  // Add indexes from each thread to this instance.
-  void add_tp_index();
+  /** The worker thread routine of the worker with index `idx`. */
+  static void worker(ThreadPool& pool, uint64_t idx);
 
-  // Remove indexes from each thread to this instance.
-  void remove_tp_index();
+  /** Pushes `task` on the queue of worker `idx` and wakes up a worker. */
+  void push_task(uint64_t idx, tdb_shared_ptr<PackagedTask>&& task);
 
-  // Lookup the thread pool instance that contains `tid`.
-  static ThreadPool* lookup_tp(std::thread::id tid);
+  /**
+   * Pops the newest task of the queue of worker `idx`, or steals the
+   * oldest task of another queue. Normal tasks are preferred unless
+   * `prefer_background` is true, and background tasks are only returned
+   * while fewer than `background_limit_` workers run one. Returns
+   * `nullptr` if there is no such task.
+   */
+  tdb_shared_ptr<PackagedTask> pop_task(uint64_t idx, bool prefer_background);
 
-  // Add indexes for each thread on the `task_index_`.
-  void add_task_index();
+  /**
+   * Pops the newest task with priority `priority` of the queue of worker
+   * `idx`, or steals the oldest one of another queue.
+   */
+  tdb_shared_ptr<PackagedTask> pop_task(uint64_t idx, Priority priority);
 
-  // Remove indexes for each thread on the `task_index_`.
-  void remove_task_index();
+  /**
+   * Removes and returns the newest pending task that is a descendent of
+   * `ancestor`, or any newest pending task if `ancestor` is `nullptr`.
+   * The queue of the calling worker, if any, is searched first. Returns
+   * `nullptr` if there is no such task.
+   */
+  tdb_shared_ptr<PackagedTask> pop_descendent_task(
+      const PackagedTask* ancestor);
 
-  // Lookup the task executing on `tid`.
-  static tdb_shared_ptr<PackagedTask> lookup_task(std::thread::id tid);
+  // Wrapper to update `current_task_` and execute `task`.
+  void exec_packaged_task(tdb_shared_ptr<PackagedTask> task);
 
-  // Wrapper to update `task_index_` and execute `task`.
-  static void exec_packaged_task(tdb_shared_ptr<PackagedTask> task);
+  /** Returns the time of a steady clock, in nanoseconds. */
+  static uint64_t now_ns();
 };
 
 }  // namespace common
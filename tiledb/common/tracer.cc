@@ -0,0 +1,179 @@
+/**
+ * @file   tracer.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Tracer.
+ */
+
+#include "tiledb/common/tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace tiledb {
+namespace common {
+
+Tracer tracer;
+
+thread_local uint64_t Tracer::current_trace_id_ = 0;
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Tracer::Tracer()
+    : enabled_(false)
+    , span_num_(0)
+    , dropped_span_num_(0)
+    , next_trace_id_(1) {
+}
+
+Tracer::ScopedTraceId::ScopedTraceId(const uint64_t trace_id)
+    : prev_trace_id_(current_trace_id_) {
+  current_trace_id_ = trace_id;
+}
+
+Tracer::ScopedTraceId::~ScopedTraceId() {
+  current_trace_id_ = prev_trace_id_;
+}
+
+/* ****************************** */
+/*              API               */
+/* ****************************** */
+
+void Tracer::set_enabled(const bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::reset() {
+  std::lock_guard<std::mutex> lg(mtx_);
+  for (const auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> lg_buffer(buffer->mtx_);
+    buffer->spans_.clear();
+  }
+  span_num_ = 0;
+  dropped_span_num_ = 0;
+}
+
+void Tracer::record(
+    const std::string& name,
+    const char* const category,
+    const uint64_t start_ns,
+    const uint64_t end_ns) {
+  if (span_num_.fetch_add(1, std::memory_order_relaxed) >= MAX_SPAN_NUM) {
+    span_num_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_span_num_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  ThreadBuffer* const buffer = thread_buffer();
+  std::lock_guard<std::mutex> lg(buffer->mtx_);
+  buffer->spans_.push_back(
+      {name,
+       category,
+       start_ns,
+       end_ns > start_ns ? end_ns - start_ns : 0,
+       current_trace_id_});
+}
+
+std::string Tracer::dump() const {
+  std::lock_guard<std::mutex> lg(mtx_);
+
+  // Report the times relative to the first span
+  uint64_t first_ns = UINT64_MAX;
+  for (const auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> lg_buffer(buffer->mtx_);
+    for (const auto& span : buffer->spans_)
+      first_ns = std::min(first_ns, span.start_ns_);
+  }
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_span_num\": "
+     << dropped_span_num_.load() << "}, \"traceEvents\": [";
+  bool first = true;
+  for (const auto& buffer : buffers_) {
+    std::lock_guard<std::mutex> lg_buffer(buffer->mtx_);
+    for (const auto& span : buffer->spans_) {
+      ss << (first ? "\n" : ",\n");
+      first = false;
+
+      // The span names are stat names, escape them anyway
+      ss << "{\"name\": \"";
+      for (const char c : span.name_) {
+        if (c == '"' || c == '\\')
+          ss << '\\';
+        ss << c;
+      }
+      ss << "\", \"cat\": \"" << span.category_
+         << "\", \"ph\": \"X\", \"ts\": "
+         << (span.start_ns_ - first_ns) / 1000.0
+         << ", \"dur\": " << span.duration_ns_ / 1000.0
+         << ", \"pid\": 1, \"tid\": " << buffer->tid_
+         << ", \"args\": {\"query\": " << span.trace_id_ << "}}";
+    }
+  }
+  ss << "\n]}\n";
+
+  return ss.str();
+}
+
+uint64_t Tracer::next_trace_id() {
+  return next_trace_id_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::current_trace_id() {
+  return current_trace_id_;
+}
+
+uint64_t Tracer::now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/* ****************************** */
+/*       PRIVATE FUNCTIONS        */
+/* ****************************** */
+
+Tracer::ThreadBuffer* Tracer::thread_buffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (buffer == nullptr) {
+    buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lg(mtx_);
+    buffer->tid_ = buffers_.size() + 1;
+    buffers_.push_back(buffer);
+  }
+
+  return buffer.get();
+}
+
+}  // namespace common
+}  // namespace tiledb
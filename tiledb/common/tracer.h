@@ -0,0 +1,218 @@
+/**
+ * @file   tracer.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class Tracer.
+ */
+
+#ifndef TILEDB_TRACER_H
+#define TILEDB_TRACER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tiledb/common/macros.h"
+
+namespace tiledb {
+namespace common {
+
+/**
+ * Records spans, the begin and end times of named scopes, with the thread
+ * they ran on and the id of the query they ran for. The recorded spans are
+ * dumped in the Chrome trace event format, which `chrome://tracing` and
+ * Perfetto display as a timeline of the threads.
+ *
+ * The `Stats` timers and the thread pool tasks are recorded as spans while
+ * the tracer is enabled. Each thread appends to its own buffer, so
+ * recording a span takes no shared lock.
+ */
+class Tracer {
+ public:
+  /* ****************************** */
+  /*   CONSTRUCTORS & DESTRUCTORS   */
+  /* ****************************** */
+
+  /** Constructor. */
+  Tracer();
+
+  /** Destructor. */
+  ~Tracer() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(Tracer);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(Tracer);
+
+  /* ****************************** */
+  /*              API               */
+  /* ****************************** */
+
+  /**
+   * Sets the trace id of the calling thread for the lifetime of the
+   * object, restoring the previous one on destruction.
+   */
+  class ScopedTraceId {
+   public:
+    /** Constructor. */
+    explicit ScopedTraceId(uint64_t trace_id);
+
+    /** Destructor. */
+    ~ScopedTraceId();
+
+    DISABLE_COPY_AND_COPY_ASSIGN(ScopedTraceId);
+    DISABLE_MOVE_AND_MOVE_ASSIGN(ScopedTraceId);
+
+   private:
+    /** The trace id to restore. */
+    uint64_t prev_trace_id_;
+  };
+
+  /** Returns true if spans are being recorded. */
+  inline bool enabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /** Enables or disables the recording of spans. */
+  void set_enabled(bool enabled);
+
+  /** Discards the recorded spans. */
+  void reset();
+
+  /**
+   * Records a span of the calling thread, with its current trace id.
+   * Nothing is recorded once `MAX_SPAN_NUM` spans are buffered.
+   *
+   * @param name The span name.
+   * @param category The span category, a string literal.
+   * @param start_ns The start time, from `now_ns`.
+   * @param end_ns The end time, from `now_ns`.
+   */
+  void record(
+      const std::string& name,
+      const char* category,
+      uint64_t start_ns,
+      uint64_t end_ns);
+
+  /** Dumps the recorded spans as a Chrome trace event JSON. */
+  std::string dump() const;
+
+  /** Returns a new trace id, for a query. */
+  uint64_t next_trace_id();
+
+  /** Returns the trace id of the calling thread, 0 if none. */
+  static uint64_t current_trace_id();
+
+  /** Returns the current time in the clock of the spans, in nanoseconds. */
+  static uint64_t now_ns();
+
+  /** The maximum number of buffered spans. */
+  static const uint64_t MAX_SPAN_NUM = 1 << 22;
+
+ private:
+  /* ****************************** */
+  /*       PRIVATE DATATYPES        */
+  /* ****************************** */
+
+  /** A recorded span. */
+  struct Span {
+    /** The span name. */
+    std::string name_;
+
+    /** The span category. */
+    const char* category_;
+
+    /** The start time, in nanoseconds. */
+    uint64_t start_ns_;
+
+    /** The duration, in nanoseconds. */
+    uint64_t duration_ns_;
+
+    /** The trace id of the thread when the span ended. */
+    uint64_t trace_id_;
+  };
+
+  /** The spans recorded by a thread. */
+  struct ThreadBuffer {
+    /** Protects `spans_` from a concurrent dump. */
+    std::mutex mtx_;
+
+    /** The thread id in the trace. */
+    uint64_t tid_;
+
+    /** The recorded spans. */
+    std::vector<Span> spans_;
+  };
+
+  /* ****************************** */
+  /*       PRIVATE ATTRIBUTES       */
+  /* ****************************** */
+
+  /** True if spans are being recorded. */
+  std::atomic<bool> enabled_;
+
+  /** Protects `buffers_`. */
+  mutable std::mutex mtx_;
+
+  /**
+   * The buffers of the threads that recorded spans. They outlive their
+   * threads, so that the spans of the terminated threads are dumped.
+   */
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+  /** The number of buffered spans. */
+  std::atomic<uint64_t> span_num_;
+
+  /** The number of spans not recorded past `MAX_SPAN_NUM`. */
+  std::atomic<uint64_t> dropped_span_num_;
+
+  /** The next trace id returned by `next_trace_id`. */
+  std::atomic<uint64_t> next_trace_id_;
+
+  /** The trace id of the calling thread. */
+  static thread_local uint64_t current_trace_id_;
+
+  /* ****************************** */
+  /*       PRIVATE FUNCTIONS        */
+  /* ****************************** */
+
+  /** Returns the buffer of the calling thread, creating it on first use. */
+  ThreadBuffer* thread_buffer();
+};
+
+/* ********************************* */
+/*               GLOBAL              */
+/* ********************************* */
+
+/** The singleton instance recording all spans. */
+extern Tracer tracer;
+
+}  // namespace common
+}  // namespace tiledb
+
+#endif  // TILEDB_TRACER_H
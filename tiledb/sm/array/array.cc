@@ -39,11 +39,14 @@
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/cache/array_snapshot_lru_cache.h"
+#include "tiledb/sm/cache/tile_overlap_lru_cache.h"
 #include "tiledb/sm/crypto/crypto.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/enums/serialization_type.h"
+#include "tiledb/sm/fragment/fragment_domain_index.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/global_state/unit_test_config.h"
 #include "tiledb/sm/misc/time.h"
@@ -90,6 +93,7 @@ Array::Array(const Array& rhs)
     , timestamp_start_(rhs.timestamp_start_)
     , timestamp_end_(rhs.timestamp_end_)
     , timestamp_end_opened_at_(rhs.timestamp_end_opened_at_)
+    , open_subarray_(rhs.open_subarray_)
     , storage_manager_(rhs.storage_manager_)
     , config_(rhs.config_)
     , last_max_buffer_sizes_(rhs.last_max_buffer_sizes_)
@@ -97,7 +101,10 @@ Array::Array(const Array& rhs)
     , metadata_(rhs.metadata_)
     , metadata_loaded_(rhs.metadata_loaded_)
     , non_empty_domain_computed_(rhs.non_empty_domain_computed_)
-    , non_empty_domain_(rhs.non_empty_domain_) {
+    , non_empty_domain_(rhs.non_empty_domain_)
+    , tile_overlap_cache_(rhs.tile_overlap_cache_)
+    , fragment_domain_index_(rhs.fragment_domain_index_)
+    , snapshot_(rhs.snapshot_) {
 }
 
 /* ********************************* */
@@ -126,6 +133,10 @@ const URI& Array::array_uri() const {
   return array_uri_;
 }
 
+StorageManager* Array::storage_manager() const {
+  return storage_manager_;
+}
+
 const URI& Array::array_uri_serialized() const {
   return array_uri_serialized_;
 }
@@ -192,6 +203,7 @@ Status Array::load_fragments(
   RETURN_NOT_OK(st);
 
   fragment_metadata_ = std::move(fragment_metadata.value());
+  RETURN_NOT_OK(reset_tile_overlap_cache());
 
   return Status::Ok();
 }
@@ -291,8 +303,18 @@ Status Array::open(
     if (rest_client == nullptr)
       return LOG_STATUS(Status_ArrayError(
           "Cannot open array; remote array with no REST client."));
-    RETURN_NOT_OK(rest_client->get_array_schema_from_rest(
-        array_uri_, &array_schema_latest_));
+    if (query_type == QueryType::READ) {
+      RETURN_NOT_OK(rest_client->open_array_from_rest(
+          this,
+          timestamp_start_,
+          timestamp_end_opened_at_,
+          &array_schema_latest_,
+          &non_empty_domain_computed_,
+          &metadata_loaded_));
+    } else {
+      RETURN_NOT_OK(rest_client->get_array_schema_from_rest(
+          array_uri_, &array_schema_latest_));
+    }
   } else if (query_type == QueryType::READ) {
     auto&& [st, array_schema, array_schemas, fragment_metadata] =
         storage_manager_->array_open_for_reads(this);
@@ -301,6 +323,7 @@ Status Array::open(
     array_schema_latest_ = array_schema.value();
     array_schemas_all_ = array_schemas.value();
     fragment_metadata_ = fragment_metadata.value();
+    RETURN_NOT_OK(reset_tile_overlap_cache());
   } else {
     auto&& [st, array_schema, array_schemas] =
         storage_manager_->array_open_for_writes(this);
@@ -318,6 +341,73 @@ Status Array::open(
   return Status::Ok();
 }
 
+Status Array::open(const tdb_shared_ptr<ArraySnapshot>& snapshot) {
+  if (is_open_)
+    return LOG_STATUS(
+        Status_ArrayError("Cannot open array; Array already open"));
+  if (snapshot == nullptr || snapshot->encryption_key_ == nullptr)
+    return LOG_STATUS(Status_ArrayError(
+        "Cannot open array; The snapshot was not created from an array"));
+  if (snapshot->array_uri_ != array_uri_)
+    return LOG_STATUS(Status_ArrayError(
+        "Cannot open array; The snapshot is of array '" +
+        snapshot->array_uri_.to_string() + "'"));
+
+  snapshot_ = snapshot;
+  encryption_key_ = snapshot->encryption_key_;
+  timestamp_start_ = snapshot->timestamp_start_;
+  timestamp_end_ = snapshot->timestamp_end_;
+  timestamp_end_opened_at_ = snapshot->timestamp_end_;
+  array_schema_latest_ = snapshot->array_schema_latest_.get();
+  array_schemas_all_ = snapshot->array_schemas_all_;
+  fragment_metadata_ = snapshot->fragment_metadata_;
+  non_empty_domain_ = snapshot->non_empty_domain_;
+  non_empty_domain_computed_ = true;
+  tile_overlap_cache_ = snapshot->tile_overlap_cache_;
+  fragment_domain_index_ = snapshot->fragment_domain_index_;
+  metadata_.clear();
+  metadata_loaded_ = false;
+  RETURN_NOT_OK(storage_manager_->array_open_for_reads_from_snapshot(this));
+
+  query_type_ = QueryType::READ;
+  is_open_ = true;
+
+  return Status::Ok();
+}
+
+Status Array::snapshot(tdb_shared_ptr<ArraySnapshot>* snapshot) {
+  if (!is_open_ || query_type_ != QueryType::READ)
+    return LOG_STATUS(Status_ArrayError(
+        "Cannot create snapshot; Array is not open for reads"));
+  if (remote_)
+    return LOG_STATUS(Status_ArrayError(
+        "Cannot create snapshot; Remote arrays are not supported"));
+
+  // Compute what the arrays opened from the snapshot would compute lazily.
+  auto&& [st, non_empty] = non_empty_domain();
+  RETURN_NOT_OK(st);
+  fragment_domain_index();
+
+  auto ret = tdb::make_shared<ArraySnapshot>(HERE());
+  ret->array_uri_ = array_uri_;
+  ret->timestamp_start_ = timestamp_start_;
+  ret->timestamp_end_ = timestamp_end_opened_at_;
+  ret->encryption_key_ = encryption_key_;
+  ret->array_schema_latest_ = tdb_shared_ptr<ArraySchema>(
+      tdb_new(ArraySchema, array_schema_latest_));
+  ret->array_schemas_all_ = array_schemas_all_;
+  ret->fragment_metadata_ = fragment_metadata_;
+  ret->non_empty_domain_ = non_empty.value();
+  ret->tile_overlap_cache_ = tile_overlap_cache_;
+  {
+    std::lock_guard<std::mutex> lock(fragment_domain_index_mtx_);
+    ret->fragment_domain_index_ = fragment_domain_index_;
+  }
+  *snapshot = ret;
+
+  return Status::Ok();
+}
+
 Status Array::close() {
   // Check if array is open
   if (!is_open_) {
@@ -331,6 +421,8 @@ Status Array::close() {
   clear_last_max_buffer_sizes();
   fragment_metadata_.clear();
   array_schemas_all_.clear();
+  tile_overlap_cache_.reset();
+  fragment_domain_index_.reset();
 
   if (remote_) {
     // Update array metadata for write queries if metadata was written by the
@@ -352,6 +444,7 @@ Status Array::close() {
     array_schema_latest_ = nullptr;
   } else {
     array_schema_latest_ = nullptr;
+    snapshot_.reset();
     if (query_type_ == QueryType::READ) {
       RETURN_NOT_OK(storage_manager_->array_close_for_reads(this));
     } else {
@@ -569,6 +662,7 @@ Status Array::reopen(uint64_t timestamp_start, uint64_t timestamp_end) {
   array_schema_latest_ = array_schema.value();
   array_schemas_all_ = array_schemas.value();
   fragment_metadata_ = fragment_metadata.value();
+  RETURN_NOT_OK(reset_tile_overlap_cache());
 
   return Status::Ok();
 }
@@ -591,6 +685,22 @@ uint64_t Array::timestamp_end() const {
   return timestamp_end_;
 }
 
+Status Array::set_open_subarray(
+    const void* subarray, const uint64_t subarray_size) {
+  if (subarray == nullptr) {
+    open_subarray_.clear();
+    return Status::Ok();
+  }
+
+  auto subarray_bytes = static_cast<const uint8_t*>(subarray);
+  open_subarray_.assign(subarray_bytes, subarray_bytes + subarray_size);
+  return Status::Ok();
+}
+
+const std::vector<uint8_t>& Array::open_subarray() const {
+  return open_subarray_;
+}
+
 uint64_t Array::timestamp_end_opened_at() const {
   return timestamp_end_opened_at_;
 }
@@ -798,6 +908,23 @@ MemoryTracker* Array::memory_tracker() {
   return &memory_tracker_;
 }
 
+TileOverlapLRUCache* Array::tile_overlap_cache() const {
+  return tile_overlap_cache_.get();
+}
+
+const FragmentDomainIndex* Array::fragment_domain_index() const {
+  if (fragment_metadata_.size() <
+      constants::fragment_domain_index_min_fragment_num)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(fragment_domain_index_mtx_);
+  if (fragment_domain_index_ == nullptr)
+    fragment_domain_index_ = tdb::make_shared<FragmentDomainIndex>(
+        HERE(), array_schema_latest_->domain(), fragment_metadata_);
+
+  return fragment_domain_index_.get();
+}
+
 /* ********************************* */
 /*          PRIVATE METHODS          */
 /* ********************************* */
@@ -808,6 +935,22 @@ void Array::clear_last_max_buffer_sizes() {
   last_max_buffer_sizes_subarray_.shrink_to_fit();
 }
 
+Status Array::reset_tile_overlap_cache() {
+  tile_overlap_cache_.reset();
+  fragment_domain_index_.reset();
+
+  bool found = false;
+  uint64_t cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.tile_overlap_cache_size", &cache_size, &found));
+  assert(found);
+  if (cache_size > 0)
+    tile_overlap_cache_ =
+        tdb::make_shared<TileOverlapLRUCache>(HERE(), cache_size);
+
+  return Status::Ok();
+}
+
 Status Array::compute_max_buffer_sizes(const void* subarray) {
   // Applicable only to domains where all dimensions have the same type
   if (!array_schema_latest_->domain()->all_dims_same_type())
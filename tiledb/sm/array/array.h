@@ -34,6 +34,7 @@
 #define TILEDB_ARRAY_H
 
 #include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -49,9 +50,12 @@ namespace tiledb {
 namespace sm {
 
 class ArraySchema;
+struct ArraySnapshot;
 class SchemaEvolution;
+class FragmentDomainIndex;
 class FragmentMetadata;
 class StorageManager;
+class TileOverlapLRUCache;
 enum class QueryType : uint8_t;
 
 /**
@@ -101,6 +105,9 @@ class Array {
   /** Returns the array URI. */
   const URI& array_uri() const;
 
+  /** Returns the storage manager the array was created with. */
+  StorageManager* storage_manager() const;
+
   /** Returns the serialized array URI, this is for backwards compatibility with
    * serialization in pre TileDB 2.4 */
   const URI& array_uri_serialized() const;
@@ -169,6 +176,28 @@ class Array {
       const void* encryption_key,
       uint32_t key_length);
 
+  /**
+   * Opens the array for reading from a snapshot created by `snapshot`,
+   * sharing its schemas, fragment metadata and non-empty domain instead of
+   * loading them. This involves no I/O and no lock shared with the other
+   * arrays opened from the snapshot.
+   *
+   * @param snapshot The snapshot, of an array with the same URI.
+   * @return Status
+   */
+  Status open(const tdb_shared_ptr<ArraySnapshot>& snapshot);
+
+  /**
+   * Creates an immutable snapshot of the array opened for reads, freezing
+   * its schemas, fragment metadata and non-empty domain. The snapshot
+   * outlives the array, and any number of arrays can be opened from it
+   * concurrently with `open(snapshot)`.
+   *
+   * @param snapshot The created snapshot.
+   * @return Status
+   */
+  Status snapshot(tdb_shared_ptr<ArraySnapshot>* snapshot);
+
   /** Closes the array and frees all memory. */
   Status close();
 
@@ -254,6 +283,22 @@ class Array {
   /** Directly set the timestamp end value. */
   Status set_timestamp_end(uint64_t timestamp_end);
 
+  /**
+   * Sets a subarray hint for opening (and reopening) the array for reads.
+   * Only the fragments whose non-empty domain intersects the subarray are
+   * then loaded, as if the array had no other fragments.
+   *
+   * @param subarray The subarray, as a [low, high] pair for each dimension,
+   *     in the coordinate type of the dimension. All the dimensions must be
+   *     fixed-sized. If `nullptr`, all the fragments are loaded.
+   * @param subarray_size The size of `subarray` in bytes.
+   * @return Status
+   */
+  Status set_open_subarray(const void* subarray, uint64_t subarray_size);
+
+  /** Returns the subarray hint to open the array with; empty if unset. */
+  const std::vector<uint8_t>& open_subarray() const;
+
   /** Directly set the array config. */
   Status set_config(Config config);
 
@@ -363,6 +408,20 @@ class Array {
   /** Returns the memory tracker. */
   MemoryTracker* memory_tracker();
 
+  /**
+   * Returns the tile overlap cache of the opened array, or `nullptr` if
+   * the cache is disabled.
+   */
+  TileOverlapLRUCache* tile_overlap_cache() const;
+
+  /**
+   * Returns the index over the non-empty domains of the fragments of the
+   * opened array, building it on first use. Returns `nullptr` if the array
+   * has fewer than `constants::fragment_domain_index_min_fragment_num`
+   * fragments, for which testing every fragment is cheaper.
+   */
+  const FragmentDomainIndex* fragment_domain_index() const;
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -430,6 +489,12 @@ class Array {
    */
   uint64_t timestamp_end_opened_at_;
 
+  /**
+   * The subarray hint to open the array with. Only the fragments
+   * intersecting it are loaded. Empty if all fragments are loaded.
+   */
+  std::vector<uint8_t> open_subarray_;
+
   /** TileDB storage manager. */
   StorageManager* storage_manager_;
 
@@ -464,6 +529,29 @@ class Array {
   /** Memory tracker for the array. */
   MemoryTracker memory_tracker_;
 
+  /**
+   * The cache of the tile overlap computed by the queries on the array. It
+   * is only valid for the fragments the array is opened with, so it is
+   * recreated every time the fragments are loaded. It is shared with the
+   * copies of the array, as they have the same fragments.
+   */
+  tdb_shared_ptr<TileOverlapLRUCache> tile_overlap_cache_;
+
+  /**
+   * The index over the fragment non-empty domains, built lazily for the
+   * fragments the array is opened with and shared with the array copies.
+   */
+  mutable tdb_shared_ptr<FragmentDomainIndex> fragment_domain_index_;
+
+  /** Protects the lazy construction of `fragment_domain_index_`. */
+  mutable std::mutex fragment_domain_index_mtx_;
+
+  /**
+   * The snapshot the array was opened from, which owns its latest schema,
+   * or `nullptr` if the array was not opened from a snapshot.
+   */
+  tdb_shared_ptr<ArraySnapshot> snapshot_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -471,6 +559,14 @@ class Array {
   /** Clears the cached max buffer sizes and subarray. */
   void clear_last_max_buffer_sizes();
 
+  /**
+   * Creates an empty tile overlap cache sized by
+   * `sm.tile_overlap_cache_size`, dropping the previous one. Also drops
+   * the fragment domain index, which is rebuilt for the new fragments on
+   * first use.
+   */
+  Status reset_tile_overlap_cache();
+
   /**
    * Computes the maximum buffer sizes for all attributes given a subarray,
    * which are cached locally in the instance.
@@ -44,7 +44,10 @@
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
+#include "tiledb/sm/filter/positive_delta_filter.h"
 #include "tiledb/sm/misc/hilbert.h"
+#include "tiledb/sm/misc/morton.h"
 #include "tiledb/sm/misc/time.h"
 #include "tiledb/sm/misc/utils.h"  // get_timestamp_range
 
@@ -81,11 +84,11 @@ ArraySchema::ArraySchema(ArrayType array_type)
   timestamp_range_ = std::make_pair(timestamp, timestamp);
 
   // Set up default filter pipelines for coords, offsets, and validity values.
+  // The offsets are stored as the bit-packed lengths of the cells.
   coords_filters_.add_filter(CompressionFilter(
       constants::coords_compression, constants::coords_compression_level));
-  cell_var_offsets_filters_.add_filter(CompressionFilter(
-      constants::cell_var_offsets_compression,
-      constants::cell_var_offsets_compression_level));
+  cell_var_offsets_filters_.add_filter(PositiveDeltaFilter());
+  cell_var_offsets_filters_.add_filter(FrameOfReferenceFilter());
   cell_validity_filters_.add_filter(CompressionFilter(
       constants::cell_validity_compression,
       constants::cell_validity_compression_level));
@@ -112,6 +115,8 @@ ArraySchema::ArraySchema(const ArraySchema* array_schema) {
   attribute_map_.clear();
   for (auto attr : array_schema->attributes_)
     add_attribute(attr, false);
+  attribute_groups_ = array_schema->attribute_groups_;
+  attribute_group_map_ = array_schema->attribute_group_map_;
 
   // This has to be the last thing set because add_attribute sets the name
   // TODO: This behavior needs to be changed
@@ -157,6 +162,21 @@ const std::vector<Attribute*>& ArraySchema::attributes() const {
   return attributes_;
 }
 
+const std::vector<std::vector<std::string>>& ArraySchema::attribute_groups()
+    const {
+  return attribute_groups_;
+}
+
+std::optional<unsigned> ArraySchema::attribute_group(
+    const std::string& name) const {
+  if (attribute_group_map_.empty())
+    return std::nullopt;
+  auto it = attribute_group_map_.find(name);
+  if (it == attribute_group_map_.end())
+    return std::nullopt;
+  return it->second;
+}
+
 uint64_t ArraySchema::capacity() const {
   return capacity_;
 }
@@ -234,6 +254,12 @@ Status ArraySchema::check() const {
         "order exceeded"));
   }
 
+  if (cell_order_ == Layout::MORTON && dim_num > Morton::MC_MAX_DIM) {
+    return LOG_STATUS(Status_ArraySchemaError(
+        "Array schema check failed; Maximum dimensions supported by Morton "
+        "order exceeded"));
+  }
+
   if (array_type_ == ArrayType::DENSE) {
     auto type = domain_->dimension(0)->type();
     if (datatype_is_real(type)) {
@@ -247,6 +273,12 @@ Status ArraySchema::check() const {
     }
   }
 
+  if (!attribute_groups_.empty() && array_type_ == ArrayType::DENSE) {
+    return LOG_STATUS(Status_ArraySchemaError(
+        "Array schema check failed; Attribute groups are only supported in "
+        "sparse arrays"));
+  }
+
   RETURN_NOT_OK(check_double_delta_compressor());
 
   if (!check_attribute_dimension_names())
@@ -359,6 +391,13 @@ void ArraySchema::dump(FILE* out) const {
     fprintf(out, "\n");
     attr->dump(out);
   }
+
+  for (const auto& group : attribute_groups_) {
+    fprintf(out, "\n### Attribute group ###\n- Attributes:");
+    for (const auto& name : group)
+      fprintf(out, " %s", name.c_str());
+    fprintf(out, "\n");
+  }
 }
 
 Status ArraySchema::has_attribute(
@@ -409,6 +448,13 @@ bool ArraySchema::is_nullable(const std::string& name) const {
 //   attribute #1
 //   attribute #2
 //   ...
+// attribute_group_num (uint32_t)
+//   group #1
+//     attribute_num (uint32_t)
+//     attribute #1 name length (uint32_t)
+//     attribute #1 name (string)
+//     ...
+//   ...
 Status ArraySchema::serialize(Buffer* buff) const {
   // Write version, which is always the current version. Despite
   // the in-memory `version_`, we will serialize every array schema
@@ -450,6 +496,19 @@ Status ArraySchema::serialize(Buffer* buff) const {
   for (auto& attr : attributes_)
     RETURN_NOT_OK(attr->serialize(buff, version));
 
+  // Write attribute groups
+  auto group_num = (uint32_t)attribute_groups_.size();
+  RETURN_NOT_OK(buff->write(&group_num, sizeof(uint32_t)));
+  for (const auto& group : attribute_groups_) {
+    auto group_attribute_num = (uint32_t)group.size();
+    RETURN_NOT_OK(buff->write(&group_attribute_num, sizeof(uint32_t)));
+    for (const auto& name : group) {
+      auto name_size = (uint32_t)name.size();
+      RETURN_NOT_OK(buff->write(&name_size, sizeof(uint32_t)));
+      RETURN_NOT_OK(buff->write(name.data(), name_size));
+    }
+  }
+
   return Status::Ok();
 }
 
@@ -515,6 +574,36 @@ Status ArraySchema::add_attribute(const Attribute* attr, bool check_special) {
   return Status::Ok();
 }
 
+Status ArraySchema::add_attribute_group(
+    const std::vector<std::string>& names) {
+  if (names.size() < 2)
+    return LOG_STATUS(Status_ArraySchemaError(
+        "Cannot add attribute group; A group needs at least two attributes"));
+
+  const auto group_idx = (unsigned)attribute_groups_.size();
+  std::unordered_map<std::string, unsigned> group_map;
+  for (const auto& name : names) {
+    auto attr = attribute(name);
+    if (attr == nullptr)
+      return LOG_STATUS(Status_ArraySchemaError(
+          "Cannot add attribute group; Attribute '" + name +
+          "' does not exist"));
+    if (attr->var_size() || attr->nullable())
+      return LOG_STATUS(Status_ArraySchemaError(
+          "Cannot add attribute group; Attribute '" + name +
+          "' is var-sized or nullable"));
+    if (attribute_group_map_.count(name) > 0 || group_map.count(name) > 0)
+      return LOG_STATUS(Status_ArraySchemaError(
+          "Cannot add attribute group; Attribute '" + name +
+          "' is already in a group"));
+    group_map[name] = group_idx;
+  }
+
+  attribute_groups_.push_back(names);
+  attribute_group_map_.insert(group_map.begin(), group_map.end());
+  return Status::Ok();
+}
+
 Status ArraySchema::drop_attribute(const std::string& attr_name) {
   std::lock_guard<std::mutex> lock(mtx_);
   if (attr_name.empty()) {
@@ -522,6 +611,11 @@ Status ArraySchema::drop_attribute(const std::string& attr_name) {
         Status_ArraySchemaError("Cannot remove an empty name attribute"));
   }
 
+  if (attribute_group_map_.count(attr_name) > 0) {
+    return LOG_STATUS(Status_ArraySchemaError(
+        "Cannot remove an attribute that is in an attribute group"));
+  }
+
   if (attribute_map_.find(attr_name) == attribute_map_.end()) {
     // Not exists.
     return LOG_STATUS(
@@ -597,6 +691,25 @@ Status ArraySchema::deserialize(ConstBuffer* buff) {
     attribute_map_[attr_ptr->name()] = attr_ptr;
   }
 
+  // Load attribute groups
+  if (version_ >= 13) {
+    uint32_t group_num;
+    RETURN_NOT_OK(buff->read(&group_num, sizeof(uint32_t)));
+    for (uint32_t g = 0; g < group_num; ++g) {
+      uint32_t group_attribute_num;
+      RETURN_NOT_OK(buff->read(&group_attribute_num, sizeof(uint32_t)));
+      std::vector<std::string> group(group_attribute_num);
+      for (auto& name : group) {
+        uint32_t name_size;
+        RETURN_NOT_OK(buff->read(&name_size, sizeof(uint32_t)));
+        name.resize(name_size);
+        RETURN_NOT_OK(buff->read(&name[0], name_size));
+        attribute_group_map_[name] = g;
+      }
+      attribute_groups_.emplace_back(std::move(group));
+    }
+  }
+
   // Create dimension map
   auto dim_num = domain()->dim_num();
   for (unsigned d = 0; d < dim_num; ++d) {
@@ -664,6 +777,11 @@ Status ArraySchema::set_cell_order(Layout cell_order) {
         Status_ArraySchemaError("Cannot set cell order; Hilbert order is only "
                                 "applicable to sparse arrays"));
 
+  if (dense() && cell_order == Layout::MORTON)
+    return LOG_STATUS(
+        Status_ArraySchemaError("Cannot set cell order; Morton order is only "
+                                "applicable to sparse arrays"));
+
   cell_order_ = cell_order;
 
   return Status::Ok();
@@ -700,7 +818,7 @@ Status ArraySchema::set_domain(Domain* domain) {
     }
   }
 
-  if (cell_order_ != Layout::HILBERT) {
+  if (!layout_is_curve(cell_order_)) {
     RETURN_NOT_OK(domain->set_null_tile_extents_to_range());
   }
 
@@ -724,6 +842,10 @@ Status ArraySchema::set_tile_order(Layout tile_order) {
     return LOG_STATUS(Status_ArraySchemaError(
         "Cannot set tile order; Hilbert order is not applicable to tiles"));
 
+  if (tile_order == Layout::MORTON)
+    return LOG_STATUS(Status_ArraySchemaError(
+        "Cannot set tile order; Morton order is not applicable to tiles"));
+
   tile_order_ = tile_order;
   return Status::Ok();
 }
@@ -856,6 +978,8 @@ void ArraySchema::clear() {
   for (auto& attr : attributes_)
     tdb_delete(attr);
   attributes_.clear();
+  attribute_groups_.clear();
+  attribute_group_map_.clear();
 
   tdb_delete(domain_);
   domain_ = nullptr;
@@ -34,6 +34,7 @@
 #ifndef TILEDB_ARRAY_SCHEMA_H
 #define TILEDB_ARRAY_SCHEMA_H
 
+#include <optional>
 #include <unordered_map>
 
 #include "tiledb/common/status.h"
@@ -116,6 +117,18 @@ class ArraySchema {
   /** Returns the attributes. */
   const std::vector<Attribute*>& attributes() const;
 
+  /**
+   * Returns the attribute groups, each listing the names of its attributes
+   * in the order their tiles are interleaved in the group file.
+   */
+  const std::vector<std::vector<std::string>>& attribute_groups() const;
+
+  /**
+   * Returns the index of the group of the input attribute, or `nullopt` if
+   * the attribute is not grouped.
+   */
+  std::optional<unsigned> attribute_group(const std::string& name) const;
+
   /** Returns the capacity. */
   uint64_t capacity() const;
 
@@ -241,6 +254,18 @@ class ArraySchema {
    */
   Status add_attribute(const Attribute* attr, bool check_special = true);
 
+  /**
+   * Adds an attribute group. The tiles of the attributes of a group are
+   * stored interleaved in a single file per fragment, so that reading
+   * several of them takes a single request. The attributes must already
+   * be in the schema, have a fixed size, not be nullable and not be in
+   * another group.
+   *
+   * @param names The names of the attributes of the group.
+   * @return Status
+   */
+  Status add_attribute_group(const std::vector<std::string>& names);
+
   /**
    * Drops an attribute.
    *
@@ -366,6 +391,13 @@ class ArraySchema {
 
   /** The array attributes. */
   std::vector<Attribute*> attributes_;
+
+  /** The attribute groups, as the names of their attributes. */
+  std::vector<std::vector<std::string>> attribute_groups_;
+
+  /** It maps each grouped attribute name to the index of its group. */
+  std::unordered_map<std::string, unsigned> attribute_group_map_;
+
   /**
    * The tile capacity for the case of sparse fragments.
    */
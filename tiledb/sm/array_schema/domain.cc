@@ -235,14 +235,8 @@ int Domain::cell_order_cmp(
     unsigned dim_idx, const ResultCoords& a, const ResultCoords& b) const {
   // Handle variable-sized dimensions
   if (dimensions_[dim_idx]->var_size()) {
-    auto s_a = a.coord_string(dim_idx);
-    auto s_b = b.coord_string(dim_idx);
-
-    if (s_a == s_b)
-      return 0;
-    if (s_a < s_b)
-      return -1;
-    return 1;
+    return ResultTile::compare_coord_strings(
+        *a.tile_, a.pos_, *b.tile_, b.pos_, dim_idx);
   }
 
   assert(cell_order_cmp_func_2_[dim_idx] != nullptr);
@@ -538,8 +532,8 @@ Status Domain::init(Layout cell_order, Layout tile_order) {
   // Compute the tile/cell order cmp functions
   set_tile_cell_order_cmp_funcs();
 
-  // Set tile_extent to empty if cell order is HILBERT
-  if (cell_order_ == Layout::HILBERT) {
+  // Set tile_extent to empty if cell order is HILBERT or MORTON
+  if (layout_is_curve(cell_order_)) {
     ByteVecValue be;
     for (auto& d : dimensions_) {
       RETURN_NOT_OK(d->set_tile_extent(be));
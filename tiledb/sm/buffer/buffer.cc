@@ -218,6 +218,14 @@ void Buffer::disown_data() {
   owns_data_ = false;
 }
 
+void Buffer::own_data(void* data, const uint64_t size) {
+  clear();
+  data_ = data;
+  size_ = size;
+  alloced_size_ = size;
+  owns_data_ = true;
+}
+
 uint64_t Buffer::free_space() const {
   assert(alloced_size_ >= size_);
   return alloced_size_ - size_;
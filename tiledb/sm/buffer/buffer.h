@@ -198,6 +198,15 @@ class Buffer : public BufferBase {
    */
   void disown_data();
 
+  /**
+   * Clears the buffer and takes the ownership of the input data, which must
+   * have been allocated with `tdb_malloc`.
+   *
+   * @param data The data to own.
+   * @param size The size of the data in bytes.
+   */
+  void own_data(void* data, uint64_t size);
+
   /** Returns the number of byte of free space in the buffer. */
   uint64_t free_space() const;
 
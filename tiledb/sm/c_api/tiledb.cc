@@ -34,6 +34,7 @@
 #include "tiledb/sm/c_api/tiledb.h"
 #include "tiledb/common/heap_profiler.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/tracer.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/c_api/tiledb_experimental.h"
@@ -58,6 +59,7 @@
 #include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/filter/filter_create.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/fragment/fragment_parts.h"
 #include "tiledb/sm/misc/time.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/query/query_condition.h"
@@ -372,6 +374,17 @@ inline int32_t sanity_check(tiledb_ctx_t* ctx, const tiledb_array_t* array) {
   return TILEDB_OK;
 }
 
+inline int32_t sanity_check(
+    tiledb_ctx_t* ctx, const tiledb_array_snapshot_t* snapshot) {
+  if (snapshot == nullptr || snapshot->snapshot_ == nullptr) {
+    auto st = Status_Error("Invalid TileDB array snapshot object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+  return TILEDB_OK;
+}
+
 inline int32_t sanity_check(
     tiledb_ctx_t* ctx, const tiledb_subarray_t* subarray) {
   if (subarray == nullptr || subarray->subarray_ == nullptr ||
@@ -1426,6 +1439,96 @@ int32_t tiledb_filter_get_option(
   return TILEDB_OK;
 }
 
+/**
+ * Returns the compression filter of the given filter, or saves an error and
+ * returns nullptr if it is not a compression filter.
+ */
+inline tiledb::sm::CompressionFilter* compression_filter(
+    tiledb_ctx_t* ctx, tiledb_filter_t* filter) {
+  auto compression_filter =
+      dynamic_cast<tiledb::sm::CompressionFilter*>(filter->filter_);
+  if (compression_filter == nullptr) {
+    auto st = Status_FilterError("Filter is not a compression filter");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+  }
+  return compression_filter;
+}
+
+int32_t tiledb_filter_train_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** samples,
+    const uint64_t* sample_sizes,
+    uint32_t num_samples,
+    uint64_t max_dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  std::vector<tiledb::sm::ConstBuffer> sample_buffers;
+  sample_buffers.reserve(num_samples);
+  for (uint32_t i = 0; i < num_samples; i++)
+    sample_buffers.emplace_back(samples[i], sample_sizes[i]);
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          compression->train_zstd_dictionary(
+              sample_buffers, max_dictionary_size)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_set_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* dictionary,
+    uint64_t size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  auto data = static_cast<const uint8_t*>(dictionary);
+  std::vector<uint8_t> dictionary_bytes(data, data + size);
+  if (SAVE_ERROR_CATCH(
+          ctx, compression->set_zstd_dictionary(dictionary_bytes)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_get_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** dictionary,
+    uint64_t* size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  const auto& dictionary_bytes = compression->zstd_dictionary();
+  *dictionary = dictionary_bytes.empty() ? nullptr : dictionary_bytes.data();
+  *size = dictionary_bytes.size();
+
+  // Success
+  return TILEDB_OK;
+}
+
 /* ********************************* */
 /*            FILTER LIST            */
 /* ********************************* */
@@ -2218,6 +2321,39 @@ int32_t tiledb_array_schema_add_attribute(
   return TILEDB_OK;
 }
 
+int32_t tiledb_array_schema_add_attribute_group(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const char** attr_names,
+    uint32_t attr_num) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array_schema) == TILEDB_ERR)
+    return TILEDB_ERR;
+  if (attr_names == nullptr && attr_num > 0) {
+    auto st = Status_Error("Cannot add attribute group; Invalid names");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+  std::vector<std::string> names(attr_names, attr_names + attr_num);
+  if (SAVE_ERROR_CATCH(
+          ctx, array_schema->array_schema_->add_attribute_group(names)))
+    return TILEDB_ERR;
+  return TILEDB_OK;
+}
+
+int32_t tiledb_array_schema_get_attribute_group_num(
+    tiledb_ctx_t* ctx,
+    const tiledb_array_schema_t* array_schema,
+    uint32_t* group_num) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array_schema) == TILEDB_ERR)
+    return TILEDB_ERR;
+  *group_num =
+      (uint32_t)array_schema->array_schema_->attribute_groups().size();
+  return TILEDB_OK;
+}
+
 int32_t tiledb_array_schema_set_allows_dups(
     tiledb_ctx_t* ctx, tiledb_array_schema_t* array_schema, int allows_dups) {
   if (sanity_check(ctx) == TILEDB_ERR ||
@@ -3034,6 +3170,68 @@ int32_t tiledb_query_get_stats(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_get_memory_usage(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* category,
+    uint64_t* current,
+    uint64_t* peak) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (category == nullptr || current == nullptr || peak == nullptr)
+    return TILEDB_ERR;
+
+  query->query_->stats()->memory_usage(category, current, peak);
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_progress(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char** phase,
+    uint64_t* tiles_read,
+    uint64_t* tiles_total,
+    uint64_t* bytes_read,
+    uint64_t* bytes_total) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (phase == nullptr || tiles_read == nullptr || tiles_total == nullptr ||
+      bytes_read == nullptr || bytes_total == nullptr)
+    return TILEDB_ERR;
+
+  const auto& progress = query->query_->progress();
+  *phase = tiledb::sm::QueryProgress::phase_str(progress.phase()).c_str();
+  *tiles_read = progress.tiles_read();
+  *tiles_total = progress.tiles_total();
+  *bytes_read = progress.bytes_read();
+  *bytes_total = progress.bytes_total();
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_report(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** report_json) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (report_json == nullptr)
+    return TILEDB_ERR;
+
+  const std::string str = query->query_->progress().report();
+
+  *report_json = static_cast<char*>(std::malloc(str.size() + 1));
+  if (*report_json == nullptr)
+    return TILEDB_ERR;
+
+  std::memcpy(*report_json, str.data(), str.size());
+  (*report_json)[str.size()] = '\0';
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_set_config(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_config_t* config) {
   // Sanity check
@@ -3443,6 +3641,162 @@ int32_t tiledb_query_set_condition(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_add_aggregate(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const char* const field_name,
+    const tiledb_query_aggregate_op_t op) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Add aggregate
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->add_aggregate(
+              field_name, static_cast<tiledb::sm::QueryAggregateOp>(op))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_aggregate(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const char* const field_name,
+    const tiledb_query_aggregate_op_t op,
+    void* const value,
+    uint64_t* const value_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Get aggregate
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_aggregate(
+              field_name,
+              static_cast<tiledb::sm::QueryAggregateOp>(op),
+              value,
+              value_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_aggregate_group_by(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const char* const dim_name,
+    const uint64_t bucket_width) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set group by
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->set_aggregate_group_by(dim_name, bucket_width)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_aggregate_bucket_num(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    uint64_t* const bucket_num) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Get bucket number
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->get_aggregate_bucket_num(bucket_num)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_aggregate_bucket(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const uint64_t bucket_idx,
+    const char* const field_name,
+    const tiledb_query_aggregate_op_t op,
+    int64_t* const bucket,
+    void* const value,
+    uint64_t* const value_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Get bucket aggregate
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_aggregate_bucket(
+              bucket_idx,
+              field_name,
+              static_cast<tiledb::sm::QueryAggregateOp>(op),
+              bucket,
+              value,
+              value_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_sample(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const double fraction,
+    const uint64_t seed) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set sample
+  if (SAVE_ERROR_CATCH(ctx, query->query_->set_sample(fraction, seed)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_top_k(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_t* const query,
+    const char* const attribute_name,
+    const uint64_t k,
+    const int32_t largest) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Set top K
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->set_top_k(attribute_name, k, largest != 0)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_prepare(tiledb_ctx_t* ctx, tiledb_query_t* query) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(ctx, query->query_->prepare()))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_finalize(tiledb_ctx_t* ctx, tiledb_query_t* query) {
   // Trivial case
   if (query == nullptr)
@@ -3493,6 +3847,43 @@ int32_t tiledb_query_submit_async(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_cancel(tiledb_ctx_t* ctx, tiledb_query_t* query) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  query->query_->request_cancellation();
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_partial_results_callback(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(const char*, uint64_t, uint64_t, uint64_t, void*),
+    void* callback_data) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (callback == nullptr) {
+    query->query_->set_partial_results_callback(nullptr);
+    return TILEDB_OK;
+  }
+
+  query->query_->set_partial_results_callback(
+      [callback, callback_data](
+          const std::string& name,
+          uint64_t offsets_size,
+          uint64_t data_size,
+          uint64_t validity_size) {
+        callback(
+            name.c_str(), offsets_size, data_size, validity_size, callback_data);
+      });
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_has_results(
     tiledb_ctx_t* ctx, tiledb_query_t* query, int32_t* has_results) {
   // Sanity check
@@ -3835,6 +4226,47 @@ int32_t tiledb_query_get_est_result_size_var_nullable(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_get_est_result_size_condition(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_t* query,
+    const char* name,
+    uint64_t* size_fixed,
+    uint64_t* size_var,
+    uint64_t* size_validity) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_est_result_size_condition(
+              name, size_fixed, size_var, size_validity)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_plan(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** plan_json) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (plan_json == nullptr)
+    return TILEDB_ERR;
+
+  std::string str;
+  if (SAVE_ERROR_CATCH(ctx, query->query_->explain(&str)))
+    return TILEDB_ERR;
+
+  *plan_json = static_cast<char*>(std::malloc(str.size() + 1));
+  if (*plan_json == nullptr)
+    return TILEDB_OOM;
+
+  std::memcpy(*plan_json, str.data(), str.size());
+  (*plan_json)[str.size()] = '\0';
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_get_fragment_num(
     tiledb_ctx_t* ctx, const tiledb_query_t* query, uint32_t* num) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
@@ -4021,6 +4453,23 @@ int32_t tiledb_subarray_add_range(
   return TILEDB_OK;
 }
 
+int32_t tiledb_subarray_add_label_range(
+    tiledb_ctx_t* ctx,
+    tiledb_subarray_t* subarray,
+    uint32_t dim_idx,
+    const void* start,
+    const void* end) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, subarray) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, subarray->subarray_->add_label_range(dim_idx, start, end)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_subarray_add_point_ranges(
     tiledb_ctx_t* ctx,
     tiledb_subarray_t* subarray,
@@ -4032,7 +4481,12 @@ int32_t tiledb_subarray_add_point_ranges(
     return TILEDB_ERR;
 
   if (SAVE_ERROR_CATCH(
-          ctx, subarray->subarray_->add_point_ranges(dim_idx, start, count)))
+          ctx,
+          subarray->subarray_->add_point_ranges(
+              dim_idx,
+              start,
+              count,
+              ctx->ctx_->storage_manager()->compute_tp())))
     return TILEDB_ERR;
 
   return TILEDB_OK;
@@ -4326,6 +4780,38 @@ int32_t tiledb_query_condition_init(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_condition_init_set(
+    tiledb_ctx_t* const ctx,
+    tiledb_query_condition_t* const cond,
+    const char* const attribute_name,
+    const void* const values,
+    const uint64_t values_size,
+    const uint64_t* const offsets,
+    const uint64_t offsets_size,
+    const tiledb_query_condition_op_t op) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, cond) == TILEDB_ERR) {
+    return TILEDB_ERR;
+  }
+
+  // Initialize the QueryCondition object
+  auto st = cond->query_condition_->init_set(
+      std::string(attribute_name),
+      values,
+      values_size,
+      offsets,
+      offsets_size / sizeof(uint64_t),
+      static_cast<tiledb::sm::QueryConditionOp>(op));
+  if (!st.ok()) {
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_condition_combine(
     tiledb_ctx_t* const ctx,
     const tiledb_query_condition_t* const left_cond,
@@ -4449,6 +4935,21 @@ int32_t tiledb_array_set_open_timestamp_end(
   return TILEDB_OK;
 }
 
+int32_t tiledb_array_set_open_subarray(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    const void* subarray,
+    uint64_t subarray_size) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, array->array_->set_open_subarray(subarray, subarray_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_array_get_open_timestamp_start(
     tiledb_ctx_t* ctx, tiledb_array_t* array, uint64_t* timestamp_start) {
   if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
@@ -5307,6 +5808,61 @@ int32_t tiledb_array_upgrade_version(
   return TILEDB_OK;
 }
 
+/* ****************************** */
+/*          ARRAY SNAPSHOT        */
+/* ****************************** */
+
+int32_t tiledb_array_snapshot_alloc(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    tiledb_array_snapshot_t** snapshot) {
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, array) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Create snapshot struct
+  *snapshot = new (std::nothrow) tiledb_array_snapshot_t;
+  if (*snapshot == nullptr) {
+    auto st = Status_Error("Failed to allocate TileDB array snapshot object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create the snapshot
+  if (SAVE_ERROR_CATCH(
+          ctx, array->array_->snapshot(&(*snapshot)->snapshot_))) {
+    delete *snapshot;
+    *snapshot = nullptr;
+    return TILEDB_ERR;
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
+void tiledb_array_snapshot_free(tiledb_array_snapshot_t** snapshot) {
+  if (snapshot != nullptr && *snapshot != nullptr) {
+    delete *snapshot;
+    *snapshot = nullptr;
+  }
+}
+
+int32_t tiledb_array_open_snapshot(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    tiledb_array_snapshot_t* snapshot) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array) == TILEDB_ERR ||
+      sanity_check(ctx, snapshot) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Open array
+  if (SAVE_ERROR_CATCH(ctx, array->array_->open(snapshot->snapshot_)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*         OBJECT MANAGEMENT      */
 /* ****************************** */
@@ -5959,6 +6515,7 @@ int32_t tiledb_stats_disable() {
 
 int32_t tiledb_stats_reset() {
   tiledb::sm::stats::all_stats.reset();
+  tiledb::common::tracer.reset();
   return TILEDB_OK;
 }
 
@@ -6014,6 +6571,40 @@ int32_t tiledb_stats_free_str(char** out) {
   return TILEDB_OK;
 }
 
+int32_t tiledb_stats_trace_enable() {
+  tiledb::common::tracer.set_enabled(true);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_disable() {
+  tiledb::common::tracer.set_enabled(false);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_dump(FILE* out) {
+  if (out == nullptr)
+    out = stdout;
+
+  fprintf(out, "%s", tiledb::common::tracer.dump().c_str());
+  return TILEDB_OK;
+}
+
+int32_t tiledb_stats_trace_dump_str(char** out) {
+  if (out == nullptr)
+    return TILEDB_ERR;
+
+  const std::string str = tiledb::common::tracer.dump();
+
+  *out = static_cast<char*>(std::malloc(str.size() + 1));
+  if (*out == nullptr)
+    return TILEDB_ERR;
+
+  std::memcpy(*out, str.data(), str.size());
+  (*out)[str.size()] = '\0';
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*          Heap Profiler         */
 /* ****************************** */
@@ -6031,6 +6622,30 @@ int32_t tiledb_heap_profiler_enable(
   return TILEDB_OK;
 }
 
+int32_t tiledb_heap_profiler_enable_sampling(
+    const char* const file_name_prefix,
+    const uint64_t sample_interval_bytes,
+    const uint64_t budget_bytes) {
+  if (sample_interval_bytes == 0 ||
+      tiledb::common::heap_profiler.enabled())
+    return TILEDB_ERR;
+
+  tiledb::common::heap_profiler.enable_sampling(
+      file_name_prefix ? std::string(file_name_prefix) : "",
+      sample_interval_bytes,
+      budget_bytes);
+  return TILEDB_OK;
+}
+
+int32_t tiledb_heap_profiler_dump_pprof(const char* const file_name) {
+  if (file_name == nullptr || !tiledb::common::heap_profiler.sampling())
+    return TILEDB_ERR;
+
+  if (!tiledb::common::heap_profiler.dump_pprof(file_name))
+    return TILEDB_ERR;
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*          Serialization         */
 /* ****************************** */
@@ -6788,6 +7403,18 @@ int32_t tiledb_fragment_info_load_with_key(
   return TILEDB_OK;
 }
 
+int32_t tiledb_fragment_info_refresh(
+    tiledb_ctx_t* ctx, tiledb_fragment_info_t* fragment_info) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, fragment_info) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(ctx, fragment_info->fragment_info_->refresh()))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_fragment_info_get_fragment_num(
     tiledb_ctx_t* ctx,
     tiledb_fragment_info_t* fragment_info,
@@ -7327,5 +7954,197 @@ TILEDB_EXPORT int32_t tiledb_query_get_status_details(
           query->query_->status_incomplete_reason();
   status->incomplete_reason = incomplete_reason;
 
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_submit_streaming(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    int32_t (*callback)(tiledb_query_t*, void*),
+    void* callback_data,
+    uint64_t max_inflight_batches) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (callback == nullptr) {
+    auto st = Status_Error("Cannot stream query; Invalid callback function");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  // Stream the results
+  auto batch_callback = [query, callback, callback_data]() {
+    if (callback(query, callback_data) != TILEDB_OK)
+      return Status_QueryError(
+          "Cannot stream query; The callback stopped the stream");
+    return Status::Ok();
+  };
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->submit_streaming(
+              batch_callback, max_inflight_batches)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_stream_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* name,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Get the buffer of the batch being consumed
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_stream_buffer(
+              name,
+              data,
+              data_size,
+              offsets,
+              offsets_size,
+              validity,
+              validity_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_managed_buffer(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, const char* name) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(ctx, query->query_->set_managed_buffer(name)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_managed_buffer_chunk_num(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, uint64_t* chunk_num) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->get_managed_buffer_chunk_num(chunk_num)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_managed_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* name,
+    uint64_t chunk,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_managed_buffer(
+              name,
+              chunk,
+              data,
+              data_size,
+              offsets,
+              offsets_size,
+              validity,
+              validity_size)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_array_new_fragment_parts_uri(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    char* uri_out,
+    uint32_t* uri_length) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array) == TILEDB_ERR || uri_out == nullptr ||
+      uri_length == nullptr)
+    return TILEDB_ERR;
+
+  tiledb::sm::URI uri;
+  tiledb::sm::FragmentParts parts(
+      array->array_, array->array_->storage_manager());
+  if (SAVE_ERROR_CATCH(ctx, parts.new_fragment_uri(&uri))) {
+    *uri_length = 0;
+    return TILEDB_ERR;
+  }
+
+  const auto& uri_str = uri.to_string();
+  if (uri_str.length() + 1 > *uri_length) {
+    *uri_length = 0;
+    auto st = Status_Error(
+        "Cannot get fragment parts URI; The URI buffer is too small");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+  *uri_length = static_cast<uint32_t>(uri_str.length());
+  uri_str.copy(uri_out, uri_str.length());
+  uri_out[uri_str.length()] = '\0';
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_fragment_part(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* fragment_uri,
+    uint32_t part) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR || fragment_uri == nullptr)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->set_fragment_part(
+              tiledb::sm::URI(fragment_uri), part)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_array_commit_fragment_parts(
+    tiledb_ctx_t* ctx, tiledb_array_t* array, const char* fragment_uri) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, array) == TILEDB_ERR || fragment_uri == nullptr)
+    return TILEDB_ERR;
+
+  tiledb::sm::FragmentParts parts(
+      array->array_, array->array_->storage_manager());
+  if (SAVE_ERROR_CATCH(ctx, parts.commit(tiledb::sm::URI(fragment_uri))))
+    return TILEDB_ERR;
+
   return TILEDB_OK;
 }
\ No newline at end of file
@@ -105,6 +105,14 @@ typedef enum {
 #undef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
 } tiledb_query_condition_combination_op_t;
 
+/** Query aggregate operator. */
+typedef enum {
+/** Helper macro for defining query aggregate operator enums. */
+#define TILEDB_QUERY_AGGREGATE_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_QUERY_AGGREGATE_OP_ENUM
+} tiledb_query_aggregate_op_t;
+
 /** Filesystem type. */
 typedef enum {
 /** Helper macro for defining filesystem enums. */
@@ -964,6 +972,35 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    fragment writes. Note that ties during deduplication are broken
  *    arbitrarily. <br>
  *    **Default**: false
+ * - `sm.dedup_coords_method` <br>
+ *    Applicable only if `sm.dedup_coords` is `true`. With "sort", unordered
+ *    writes find duplicates by comparing neighbors after sorting all cells in
+ *    global order. With "hash", duplicates are removed before sorting in a
+ *    single pass with a hash table partitioned across threads, which shortens
+ *    the sort when there are many duplicates. "sort" or "hash". <br>
+ *    **Default**: sort
+ * - `sm.coords_bloom_filter_bits_per_cell` <br>
+ *    The number of bits per cell of the Bloom filter over the coordinates that
+ *    sparse writes store with each fragment. Reads whose ranges are single
+ *    points skip the fragments the filter rules out. Ten bits give about 1%
+ *    false positives. Not applicable to arrays with real-typed dimensions. If
+ *    0, no filter is written. <br>
+ *    **Default**: 0
+ * - `sm.attribute_index_names` <br>
+ *    A comma-separated list of attributes whose values sparse writes index per
+ *    fragment, with a Bloom filter over the values of each tile. Reads with
+ *    equality or set membership query conditions on an indexed attribute skip
+ *    the tiles that cannot contain the values. Attributes missing from the
+ *    array schema and real-typed attributes are ignored. <br>
+ *    **Default**: ""
+ * - `sm.packed_fragment_max_size` <br>
+ *    Unordered writes to sparse arrays whose buffers total at most this many
+ *    bytes write a packed fragment, a single object holding all the fragment
+ *    files, instead of a fragment directory with one file per attribute plus
+ *    the metadata and ok files. This saves PUT requests for small writes on
+ *    object stores. Reads and consolidation handle packed fragments like other
+ *    fragments. 0 disables packed fragments. <br>
+ *    **Default**: 0
  * - `sm.check_coord_dups` <br>
  *    This is applicable only if `sm.dedup_coords` is `false`.
  *    If `true`, an error will be thrown if there are cells with duplicate
@@ -986,6 +1023,93 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.tile_cache_size` <br>
  *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.tile_cache_shard_num` <br>
+ *    The number of independently locked shards the tile cache is split into,
+ *    each holding an equal part of `sm.tile_cache_size`. More shards reduce the
+ *    lock contention between concurrent queries. <br>
+ *    **Default**: 1
+ * - `sm.tile_cache_unfiltered_size` <br>
+ *    The size in bytes of a separate cache of unfiltered tiles, sharded like
+ *    the tile cache. Tiles found there are neither read nor unfiltered again.
+ *    The cache is disabled when set to 0. <br>
+ *    **Default**: 0
+ * - `sm.tile_cache_policy` <br>
+ *    The admission and eviction policy of the tile caches. `lru` evicts the
+ *    least recently used tile. `slru` is a segmented LRU, where tiles read only
+ *    once are evicted before tiles read repeatedly, so that large scans do not
+ *    flush frequently read tiles. `tinylfu` is a segmented LRU that also admits
+ *    a new tile only if it is estimated to be read more often than the tile it
+ *    would evict. <br>
+ *    **Default**: lru
+ * - `sm.tile_cache_shared_memory_name` <br>
+ *    If set, the tile cache is stored in the shared memory segment with this
+ *    name, shared by all the processes of the host using the same name, instead
+ *    of in the memory of each process. The segment is created with
+ *    `sm.tile_cache_size` bytes by the first process attaching to it and is not
+ *    removed when the processes exit. `sm.tile_cache_shard_num` and
+ *    `sm.tile_cache_policy` do not apply to it. Only supported on POSIX
+ *    systems. <br>
+ *    **Default**: ""
+ * - `sm.listing_cache_ttl_ms` <br>
+ *    The time in milliseconds for which the listings of the fragments and array
+ *    schemas of an array are cached and reused by subsequent array opens. `0`
+ *    disables the listing cache. Fragments written, consolidated or vacuumed
+ *    through the same context are always listed again. <br>
+ *    **Default**: 0
+ * - `sm.fragment_listing_shards` <br>
+ *    The number of concurrent listings the fragments of an array on S3 are
+ *    listed with, by splitting their timestamp range since the creation of the
+ *    array. `1` lists them with a single paginated listing. <br>
+ *    **Default**: 1
+ * - `sm.fragment_metadata_cache_size` <br>
+ *    The fragment metadata cache size in bytes, shared by all the arrays opened
+ *    in the context. Reopening an array then loads only the metadata of its new
+ *    fragments. The size of a cached fragment metadata is approximated by the
+ *    size of its footer. Any `uint64_t` value is acceptable; 0 disables the
+ *    cache. <br>
+ *    **Default**: 0
+ * - `sm.array_schema_cache_size` <br>
+ *    The array schema cache size in bytes, shared by all the arrays opened in
+ *    the context. Opening an array then copies the schemas it already loaded
+ *    instead of reading and deserializing them again. The size of a cached
+ *    schema is approximated by its serialized size. Any `uint64_t` value is
+ *    acceptable; 0 disables the cache. <br>
+ *    **Default**: 10000000
+ * - `sm.array_snapshot_cache_size` <br>
+ *    The maximum number of array snapshots shared by all the arrays opened for
+ *    reads in the context. A snapshot holds the schemas, the fragment metadata
+ *    and the array metadata of an array opened at an explicit `timestamp_end`
+ *    (and `timestamp_start`), so that opening the array again at the same
+ *    timestamps involves no listing or loading. The snapshots of an array are
+ *    dropped when the context writes, consolidates, vacuums or removes it;
+ *    changes made by other processes are not seen. Any `uint64_t` value is
+ *    acceptable; 0 disables the cache. <br>
+ *    **Default**: 0
+ * - `sm.tile_overlap_cache_size` <br>
+ *    The tile overlap cache size in bytes of each open array. Queries on the
+ *    same open array whose subarrays have the same ranges and layout then reuse
+ *    the tile overlap computed by an earlier query instead of traversing the
+ *    fragment R-trees again. The cache is dropped when the array is closed or
+ *    reopened. Any `uint64_t` value is acceptable; 0 disables the cache. <br>
+ *    **Default**: 10000000
+ * - `sm.partitioner.target_cost` <br>
+ *    If non-zero, the subarray partitioner stops growing a partition of
+ *    multiple ranges once the estimated cost of the unique tiles it touches
+ *    exceeds this value. The cost of a tile is
+ *    `sm.partitioner.io_cost_per_byte` times its persisted (compressed) size
+ *    plus `sm.partitioner.cpu_cost_per_byte` times its in-memory size, so the
+ *    unit of the target is up to the caller (e.g. seconds or bytes). <br>
+ *    **Default**: 0
+ * - `sm.partitioner.io_cost_per_byte` <br>
+ *    The cost the subarray partitioner charges per persisted (compressed) tile
+ *    byte fetched from storage. Only used when `sm.partitioner.target_cost` is
+ *    non-zero. <br>
+ *    **Default**: 1.0
+ * - `sm.partitioner.cpu_cost_per_byte` <br>
+ *    The cost the subarray partitioner charges per in-memory (unfiltered) tile
+ *    byte that has to be decoded. Only used when `sm.partitioner.target_cost`
+ *    is non-zero. <br>
+ *    **Default**: 0.0
  * - `sm.enable_signal_handlers` <br>
  *    Determines whether or not TileDB will install signal handlers. <br>
  *    **Default**: true
@@ -995,6 +1119,30 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.io_concurrency_level` <br>
  *    Upper-bound on number of threads to allocate for IO-bound tasks. <br>
  *    **Default*: # cores
+ * - `sm.compute_affinity` <br>
+ *    The CPU affinity of the compute thread pool workers. Empty leaves them
+ *    unpinned, `numa` pins them round-robin to the NUMA nodes, and a cpuset
+ *    string such as `0-3,8` pins every worker to one of the listed CPUs,
+ *    round-robin. <br>
+ *    **Default**: ""
+ * - `sm.io_affinity` <br>
+ *    The CPU affinity of the io thread pool workers, in the same format as
+ *    `sm.compute_affinity`. Pinning the compute and io workers to CPUs not used
+ *    by the application isolates library threads from application threads. <br>
+ *    **Default**: ""
+ * - `sm.shared_resources` <br>
+ *    If `true`, the context shares its compute and io thread pools with the
+ *    other contexts that enable this and configure the same concurrency levels
+ *    and affinities. Their VFS also share the S3 clients of identical
+ *    `vfs.s3.*` configurations. The stats of queries and VFS operations stay
+ *    per context. <br>
+ *    **Default**: false
+ * - `sm.thread_pool_stats` <br>
+ *    Whether the compute and io thread pools record their activity in the
+ *    context stats: the number of tasks submitted and executed, the maximum
+ *    queue depth, a histogram of the wait of the tasks before they start and
+ *    the busy and idle time of every worker. <br>
+ *    **Default**: false
  * - `sm.vacuum.mode` <br>
  *    The vacuuming mode, one of `fragments` (remove consolidated fragments),
  *    `fragment_meta` (remove only consolidated fragment metadata), or
@@ -1030,6 +1178,92 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The size (in bytes) of the attribute buffers used during
  *    consolidation. <br>
  *    **Default**: 50,000,000
+ * - `sm.consolidation.total_buffer_size` <br>
+ *    When above 0, the total size (in bytes) of the buffers of a fragment
+ *    consolidation step, replacing `sm.consolidation.buffer_size`. It is split
+ *    across the attribute and dimension buffers in proportion to their average
+ *    cell sizes in the fragments being consolidated, each buffer holding at
+ *    least one of their largest tiles. It is reserved from
+ *    `sm.mem.total_budget` when the memory governor is enabled, and halved
+ *    between the two sets of buffers when
+ *    `sm.consolidation.max_in_flight_bytes` is above 0. <br>
+ *    **Default**: 0
+ * - `sm.consolidation.max_in_flight_bytes` <br>
+ *    When above 0, fragment consolidation streams the cells through two sets of
+ *    buffers of `sm.consolidation.buffer_size` bytes, reading the next cells
+ *    into one set while the cells of the other are written. The consolidated
+ *    tiles are then filtered and written in the background, with at most this
+ *    many bytes of tiles in flight. 0 reads and writes the cells in turn. <br>
+ *    **Default**: 0
+ * - `sm.consolidation.tile_copy` <br>
+ *    Whether sparse fragments are consolidated by copying their filtered tiles,
+ *    without unfiltering them, when their non-empty domains cover disjoint
+ *    space tiles that are ordered in the tile order, they have the latest array
+ *    schema and all but the last one end with a full tile. Only the tile
+ *    offsets, MBRs and tile metadata of the new fragment are computed. Not
+ *    applicable with Hilbert cell order, with var-sized dimensions, or when
+ *    `sm.coords_bloom_filter_bits_per_cell` or `sm.attribute_index_names` are
+ *    set. <br>
+ *    **Default**: false
+ * - `sm.consolidation.concurrent_budget` <br>
+ *    The total bytes of buffers that the consolidation steps of sparse
+ *    fragments may use concurrently. When above 0, the steps on disjoint sets
+ *    of fragments are planned up front and as many of them run concurrently as
+ *    their buffers fit in this budget, at least one; the new fragments are then
+ *    committed in timestamp order. 0 runs the steps one at a time. <br>
+ *    **Default**: 0
+ * - `sm.consolidation.policy` <br>
+ *    The policy that selects the fragments of each consolidation step of
+ *    `fragments` mode. `size_ratio` selects the smallest set of adjacent
+ *    fragments that satisfies `sm.consolidation.step_min_frags`,
+ *    `sm.consolidation.step_max_frags`, `sm.consolidation.step_size_ratio` and
+ *    `sm.consolidation.amplification`. `size_tiered` groups the fragments in
+ *    tiers of sizes growing by `sm.consolidation.tier_fanout` from
+ *    `sm.consolidation.tier_base_size`, and consolidates the oldest run of
+ *    `sm.consolidation.tier_fanout` adjacent fragments of the same tier.
+ *    `leveled` consolidates a fragment with all the newer ones once their total
+ *    size reaches its size divided by `sm.consolidation.tier_fanout`, so that
+ *    every fragment is at least `sm.consolidation.tier_fanout` times larger
+ *    than the newer ones. The bytes rewritten are reported in the
+ *    `consolidate_rewritten_bytes` statistic. <br>
+ *    **Default**: size_ratio
+ * - `sm.consolidation.tier_fanout` <br>
+ *    The size ratio of consecutive tiers or levels of the `size_tiered` and
+ *    `leveled` consolidation policies, at least 2. <br>
+ *    **Default**: 4
+ * - `sm.consolidation.tier_base_size` <br>
+ *    The size in bytes under which fragments belong to the first tier of the
+ *    `size_tiered` consolidation policy. <br>
+ *    **Default**: 1048576
+ * - `sm.consolidation.auto.fragment_num` <br>
+ *    If greater than 0, closing a local array opened for writes schedules a
+ *    consolidation and vacuum of its fragments in the background once it has at
+ *    least this many fragments. These run at the `background` thread pool
+ *    priority with the consolidation and vacuum parameters of the context, one
+ *    at a time per array. The peak number of scheduled runs not yet started
+ *    is reported in the `auto_consolidation_backlog` statistic. <br>
+ *    **Default**: 0
+ * - `sm.consolidation.auto.min_interval_ms` <br>
+ *    The minimum time in milliseconds between the starts of two background
+ *    consolidations of the same array scheduled by
+ *    `sm.consolidation.auto.fragment_num`. <br>
+ *    **Default**: 1000
+ * - `sm.consolidation.fragment_meta.max_deltas` <br>
+ *    The maximum number of deltas appended to a consolidated fragment metadata
+ *    file in `fragment_meta` mode. A delta holds the footers of the fragments
+ *    missing from the latest consolidated fragment metadata and its deltas
+ *    only. Once there are this many deltas, the next consolidation merges the
+ *    footers of all the fragments into a new file. The latest file and its
+ *    deltas are read at once when the array is opened. 0 rewrites all the
+ *    footers every time. <br>
+ *    **Default**: 0
+ * - `sm.consolidation.array_meta.max_deltas` <br>
+ *    The maximum number of consolidated array metadata files in `array_meta`
+ *    mode. While there are fewer, a consolidation merges only the array
+ *    metadata written after the latest consolidated file into a new one, and
+ *    the vacuum deletes only the merged files. Otherwise all the array metadata
+ *    is merged into a single file. 0 always merges all the array metadata. <br>
+ *    **Default**: 0
  * - `sm.consolidation.steps` <br>
  *    The number of consolidation steps to be performed when executing
  *    the consolidation algorithm.<br>
@@ -1056,6 +1290,12 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    `sm.consolidation.timestamp_start` and this value (inclusive). <br>
  *    Only for `fragments` and `array_meta` consolidation mode. <br>
  *    **Default**: UINT64_MAX
+ * - `sm.consolidation.priority` <br>
+ *    The thread pool priority of the tasks of consolidation and vacuuming,
+ *    either `normal` or `background`. Background tasks run after the pending
+ *    normal tasks, and occupy at most half of the worker threads, so that they
+ *    do not delay concurrent queries. <br>
+ *    **Default**: background
  * - `sm.memory_budget` <br>
  *    The memory budget for tiles of fixed-sized attributes (or offsets for
  *    var-sized attributes) to be fetched during reads.<br>
@@ -1087,10 +1327,99 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    Which reader to use for sparse unordered with dups queries.
  *    "refactored" or "legacy".<br>
  *    **Default**: refactored
+ * - `sm.query.priority` <br>
+ *    The thread pool priority of the tasks of queries, either `normal` or
+ *    `background`. See `sm.consolidation.priority`. <br>
+ *    **Default**: normal
+ * - `sm.query.shared_scan` <br>
+ *    If `true`, concurrent read queries of a context needing the same tile
+ *    while it is being read share the read instead of each reading the tile.
+ *    Tiles read through memory mappings are not shared. <br>
+ *    **Default**: true
+ * - `sm.query.timeout_ms` <br>
+ *    The maximum time in milliseconds each submission of a query may run, 0 for
+ *    no limit. A query past its deadline stops at the next tile and its status
+ *    becomes `TILEDB_CANCELLED`. <br>
+ *    **Default**: 0
+ * - `sm.async_query.max_concurrent` <br>
+ *    The maximum number of async queries of a context processed concurrently, 0
+ *    for no limit. The other async queries wait for admission, queued per
+ *    `sm.async_query.tag` and admitted round-robin across tags. <br>
+ *    **Default**: 0
+ * - `sm.async_query.tag` <br>
+ *    The client tag an async query is queued under for admission, set on the
+ *    query config. Queries of different tags are admitted round-robin, so a
+ *    burst of submissions under one tag does not starve the others. <br>
+ *    **Default**: ""
+ * - `sm.query.sparse_unordered_no_dups.reader` <br>
+ *    Which reader to use for sparse unordered queries on arrays that do not
+ *    allow duplicates. "refactored" or "legacy". The refactored reader
+ *    resolves overwrites tile by tile within the memory budget, but does
+ *    not return cells once per overlapping range like the legacy reader.
+ *    <br>
+ *    **Default**: legacy
+ * - `sm.query.dense.streaming_write` <br>
+ *    If `true`, dense writes in row-major or col-major layout accept the
+ *    subarray as a sequence of slabs over successive submits. Each submit
+ *    appends whole slices along the slowest dimension of the layout, and space
+ *    tiles are filtered and written as soon as they are complete. The layout
+ *    must match the tile order and the write must be finalized. <br>
+ *    **Default**: false
+ * - `sm.query.dense.elide_fill_tiles` <br>
+ *    If `true`, dense writes do not store the tiles of fixed-sized attributes
+ *    in which all the cells hold the fill value of the attribute (and its fill
+ *    validity, for nullable attributes). Such tiles are recorded with an empty
+ *    size in the fragment metadata, and reads produce the fill values without
+ *    any I/O or unfiltering. <br>
+ *    **Default**: true
  * - `sm.mem.malloc_trim` <br>
  *    Should malloc_trim be called on context and query destruction? This might
  * reduce residual memory usage. <br>
  *    **Default**: true
+ * - `sm.mem.tile_buffer_pool_size` <br>
+ *    The maximum size, in bytes, of the idle tile buffers kept by a context for
+ *    reuse across queries. Tile buffers are allocated in size classes and
+ *    returned to the pool when freed. The idle buffers are released when
+ *    `sm.mem.malloc_trim` is called on query and context destruction, so
+ *    setting `sm.mem.malloc_trim` to false keeps them across queries. A value
+ *    of 0 disables the pool. <br>
+ *    **Default**: 0
+ * - `sm.mem.large_buffer.huge_pages` <br>
+ *    How tile buffers of at least `sm.mem.large_buffer.threshold` bytes are
+ *    backed by huge pages, to reduce TLB misses. With `none`, regular pages are
+ *    used. With `transparent`, transparent huge pages are requested for them.
+ *    With `explicit`, huge pages reserved by the system are used, falling back
+ *    to transparent huge pages if none are available. Only supported on Linux.
+ *    <br>
+ *    **Default**: none
+ * - `sm.mem.large_buffer.numa_local` <br>
+ *    If true, tile buffers of at least `sm.mem.large_buffer.threshold` bytes
+ *    are bound to the NUMA node of the thread that first writes them, which is
+ *    the compute thread unfiltering them, even if the process interleaves its
+ *    memory. Only supported on Linux. <br>
+ *    **Default**: false
+ * - `sm.mem.large_buffer.threshold` <br>
+ *    The smallest tile buffer size, in bytes, to which
+ *    `sm.mem.large_buffer.huge_pages` and `sm.mem.large_buffer.numa_local`
+ *    apply. Such buffers get their own memory mapping. <br>
+ *    **Default**: 4194304
+ * - `sm.mem.governor.enabled` <br>
+ *    If true, `sm.mem.total_budget` of the context bounds the memory of all its
+ *    concurrent sparse reads together. Each read reserves its own
+ *    `sm.mem.total_budget` from the context, the tile caches shedding their
+ *    tiles first. If not enough memory is available, the read runs with a
+ *    smaller budget, i.e. smaller batches, or waits for other reads to release
+ *    memory. <br>
+ *    **Default**: false
+ * - `sm.mem.governor.min_ratio` <br>
+ *    With `sm.mem.governor.enabled`, the smallest fraction of its budget a read
+ *    accepts to run with. Below that, the read waits for memory to be released.
+ *    <br>
+ *    **Default**: 0.25
+ * - `sm.mem.governor.timeout_ms` <br>
+ *    With `sm.mem.governor.enabled`, how long a read waits for memory to be
+ *    released, in milliseconds, before failing. <br>
+ *    **Default**: 10000
  * - `sm.mem.total_budget` <br>
  *    Memory budget for readers and writers. <br>
  *    **Default**: 10GB
@@ -1126,6 +1455,31 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    Ratio of the budget allocated for array data in the sparse unordered
  *    with duplicates reader. <br>
  *    **Default**: 0.1
+ * - `sm.mem.writer.global_order.max_in_flight_bytes` <br>
+ *    Maximum number of bytes of full tiles that the global order writer filters
+ *    and writes in the background while the next buffers are submitted. 0
+ *    filters and writes the tiles synchronously in each submit. <br>
+ *    **Default**: 0
+ * - `sm.mem.writer.global_order.budget` <br>
+ *    Memory budget in bytes for the tiles the global order writer filters and
+ *    writes at once. Above 0, the full tiles of a submit are filtered and
+ *    written in batches that hold at most the budget divided by the number of
+ *    attributes and dimensions of tiles per attribute or dimension, and the
+ *    filtered buffers of a batch are freed once it is written. 0 filters all
+ *    the full tiles of a submit at once. <br>
+ *    **Default**: 0
+ * - `sm.mem.writer.unordered.spill_budget` <br>
+ *    Memory budget in bytes for merging the sorted runs that unordered writes
+ *    spill to disk. Above 0, each submit of an unordered write sorts its cells
+ *    and spills them as a run to `sm.mem.writer.unordered.spill_path`, and
+ *    finalizing the query merges all the runs into a single fragment in global
+ *    order. 0 writes a fragment per submit. <br>
+ *    **Default**: 0
+ * - `sm.mem.writer.unordered.spill_path` <br>
+ *    Directory (or URI) where unordered writes spill their sorted runs when
+ *    `sm.mem.writer.unordered.spill_budget` is above 0. An empty value uses the
+ *    temporary directory of the system. <br>
+ *    **Default**: ""
  *    The maximum byte size to read-ahead from the backend. <br>
  *    **Default**: 102400
  * -  `vfs.read_ahead_cache_size` <br>
@@ -1142,6 +1496,24 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.min_batch_gap` <br>
  *    The minimum number of bytes between two VFS read batches.<br>
  *    **Default**: 500KB
+ * - `vfs.adaptive_batch_gap` <br>
+ *    If `true`, the VFS keeps a moving estimate of the request latency and
+ *    bandwidth of each backend from its batched reads, and merges read regions
+ *    separated by at most latency x bandwidth bytes, instead of
+ *    `vfs.min_batch_gap`. `vfs.min_batch_gap` is used until enough reads were
+ *    observed. <br>
+ *    **Default**: false
+ * - `vfs.disk_cache.path` <br>
+ *    A local directory caching the reads of immutable objects (e.g. fragment
+ *    data) from `s3://`, `gcs://` and `azure://` URIs across processes and
+ *    restarts. The directory can be shared by concurrent processes. If empty,
+ *    the disk cache is disabled. <br>
+ *    **Default**: ""
+ * - `vfs.disk_cache.max_size` <br>
+ *    The maximum total size (in bytes) of the disk cache in
+ *    `vfs.disk_cache.path`. The least recently read entries are evicted beyond
+ *    it. <br>
+ *    **Default**: 10GB
  * - `vfs.file.posix_file_permissions` <br>
  *    Permissions to use for posix file system with file creation.<br>
  *    **Default**: 644
@@ -1152,6 +1524,37 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The maximum number of parallel operations on objects with `file:///`
  *    URIs. <br>
  *    **Default**: `sm.io_concurrency_level`
+ * - `vfs.file.io_uring` <br>
+ *    If `true`, batched reads and parallel writes of objects with `file:///`
+ *    URIs are submitted to the Linux io_uring interface at once, instead of
+ *    being issued as blocking calls from the VFS thread pool. Falls back to
+ *    blocking calls where io_uring is unavailable. <br>
+ *    **Default**: false
+ * - `vfs.file.overlapped_io` <br>
+ *    If `true`, on Windows, batched reads and parallel writes of objects with
+ *    `file:///` URIs are issued at once as overlapped I/O and reaped from an
+ *    I/O completion port, instead of being issued as blocking calls from the
+ *    VFS thread pool. <br>
+ *    **Default**: false
+ * - `vfs.file.direct_io` <br>
+ *    If `true`, reads of objects with `file:///` URIs bypass the operating
+ *    system page cache (`O_DIRECT`), reading block-aligned ranges. Falls back
+ *    to regular reads where direct I/O is unsupported. <br>
+ *    **Default**: false
+ * - `vfs.file.mmap` <br>
+ *    If `true`, tiles of objects with `file:///` URIs are read by mapping each
+ *    file into memory once, until the array is closed, and viewing the tile
+ *    bytes in the mapping instead of copying them into allocated buffers. Best
+ *    suited to read-mostly arrays on local disks or tmpfs. <br>
+ *    **Default**: false
+ * - `vfs.file.group_commit` <br>
+ *    If `true`, the files a writer stores in a fragment with a `file:///` URI
+ *    are not synced one by one when they are closed. Instead, all the files of
+ *    the fragment, together with those of any other fragment being committed at
+ *    the same time, are synced in parallel right before the fragment commit
+ *    file is written. Fragments are exactly as durable once committed, with far
+ *    fewer sync calls. <br>
+ *    **Default**: false
  * - `vfs.azure.storage_account_name` <br>
  *    Set the Azure Storage Account name. <br>
  *    **Default**: ""
@@ -1175,6 +1578,11 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.azure.max_parallel_ops` <br>
  *    The maximum number of Azure backend parallel operations. <br>
  *    **Default**: `sm.io_concurrency_level`
+ * - `vfs.azure.read_part_size` <br>
+ *    The minimum size (in bytes) of each of the concurrent ranged downloads a
+ *    large Azure read is split into, up to `vfs.azure.max_parallel_ops` of
+ *    them. If 0, `vfs.min_parallel_size` is used. <br>
+ *    **Default**: 0
  * - `vfs.azure.use_block_list_upload` <br>
  *    Determines if the Azure backend can use chunked block uploads. <br>
  *    **Default**: "true"
@@ -1193,6 +1601,11 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.gcs.max_parallel_ops` <br>
  *    The maximum number of GCS backend parallel operations. <br>
  *    **Default**: `sm.io_concurrency_level`
+ * - `vfs.gcs.read_part_size` <br>
+ *    The minimum size (in bytes) of each of the concurrent ranged downloads a
+ *    large GCS read is split into, up to `vfs.gcs.max_parallel_ops` of them. If
+ *    0, `vfs.min_parallel_size` is used. <br>
+ *    **Default**: 0
  * - `vfs.gcs.use_multi_part_upload` <br>
  *    Determines if the GCS backend can use chunked part uploads. <br>
  *    **Default**: "true"
@@ -1254,6 +1667,11 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    vfs.s3.max_parallel_ops` bytes will be buffered before issuing multipart
  *    uploads in parallel. <br>
  *    **Default**: 5MB
+ * - `vfs.s3.read_part_size` <br>
+ *    The minimum size (in bytes) of each of the concurrent byte-range GETs a
+ *    large S3 read is split into, up to `vfs.s3.max_parallel_ops` of them. If
+ *    0, `vfs.min_parallel_size` is used. <br>
+ *    **Default**: 0
  * - `vfs.s3.ca_file` <br>
  *    Path to SSL/TLS certificate file to be used by cURL for for S3 HTTPS
  *    encryption. Follows cURL conventions:
@@ -1282,6 +1700,16 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.s3.request_timeout_ms` <br>
  *    The request timeout in ms. Any `long` value is acceptable. <br>
  *    **Default**: 3000
+ * - `vfs.s3.hedge_percentile` <br>
+ *    If in (0, 100), an S3 GET that is slower than this percentile of the
+ *    recently observed GET latencies is hedged: a duplicate request is issued,
+ *    the first response is used and the other request is cancelled. `0`
+ *    disables hedging. <br>
+ *    **Default**: 0
+ * - `vfs.s3.hedge_max_ratio` <br>
+ *    The maximum ratio of hedged S3 GETs to all S3 GETs, which caps the extra
+ *    load of `vfs.s3.hedge_percentile`. <br>
+ *    **Default**: 0.05
  * - `vfs.s3.requester_pays` <br>
  *    The requester pays for the S3 access charges. <br>
  *    **Default**: false
@@ -1338,6 +1766,16 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.hdfs.kerb_ticket_cache_path` <br>
  *    HDFS kerb ticket cache path. <br>
  *    **Default**: ""
+ * - `vfs.hdfs.short_circuit_reads` <br>
+ *    If `true`, the HDFS client reads blocks stored on the local datanode
+ *    directly from disk (`dfs.client.read.shortcircuit`), instead of streaming
+ *    them through the datanode. <br>
+ *    **Default**: false
+ * - `vfs.hdfs.domain_socket_path` <br>
+ *    The UNIX domain socket shared with the local datanode for short-circuit
+ *    reads (`dfs.domain.socket.path`). If empty, the value of the Hadoop
+ *    configuration files is used. <br>
+ *    **Default**: ""
  * - `config.env_var_prefix` <br>
  *    Prefix of environmental variables for reading configuration
  *    parameters. <br>
@@ -1392,6 +1830,45 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The delay factor to exponentially wait until further retries of a failed
  *    REST request <br>
  *    **Default**: 1.25
+ * - `rest.share_connections` <br>
+ *    If true, the requests of a context share a pool of connections, TLS
+ *    sessions and DNS entries, so that consecutive and concurrent requests to
+ *    the REST server reuse kept-alive connections instead of performing new TLS
+ *    handshakes. <br>
+ *    **Default**: true
+ * - `rest.http2` <br>
+ *    If true, HTTP/2 is negotiated with the REST server over TLS, falling back
+ *    to HTTP/1.1 if the server or libcurl does not support it. <br>
+ *    **Default**: true
+ * - `rest.request_compressor` <br>
+ *    The content encoding of the serialized queries posted to the REST server,
+ *    either `none` or `zstd`. Large payloads are compressed in parallel as
+ *    independent zstd frames, which decode as one stream. Responses are
+ *    compressed as negotiated with `rest.http_compressor`, whose `any` default
+ *    includes zstd when libcurl supports it. <br>
+ *    **Default**: none
+ * - `rest.request_compression_min_size` <br>
+ *    The minimum size in bytes of a serialized query to be compressed with
+ *    `rest.request_compressor`. <br>
+ *    **Default**: 1048576
+ * - `rest.prefetch_incomplete` <br>
+ *    If true and `rest.resubmit_incomplete` is false, an incomplete read on a
+ *    remote array speculatively submits its next partition in the background
+ *    while the user consumes the current results. The next submission of the
+ *    query uses the prefetched response if it is unchanged. <br>
+ *    **Default**: false
+ * - `rest.submit_array_state` <br>
+ *    If true, queries submitted to the REST server include the state of their
+ *    open array, i.e. its array schemas, non-empty domain and metadata. If
+ *    false, only the array URI and timestamps are sent and the server uses the
+ *    state of the array it opens itself, which saves sending hundreds of KB for
+ *    wide schemas on every small query. <br>
+ *    **Default**: true
+ * - `rest.pipeline_array_open` <br>
+ *    If true, opening a remote array for reads also fetches its non-empty
+ *    domain and metadata, concurrently with its array schema, instead of one
+ *    round trip each when they are first used. <br>
+ *    **Default**: false
  *
  * **Example:**
  *
@@ -1952,6 +2429,90 @@ TILEDB_EXPORT int32_t tiledb_filter_get_option(
     tiledb_filter_option_t option,
     void* value);
 
+/**
+ * Trains a dictionary for a ZStd filter on sample data, such as tiles of an
+ * existing array. The dictionary is stored with the filter in the array
+ * schema, and improves the compression of small tiles that resemble the
+ * samples.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t* filter;
+ * tiledb_filter_alloc(ctx, TILEDB_FILTER_ZSTD, &filter);
+ * const void* samples[] = {tile0, tile1, tile2};
+ * uint64_t sample_sizes[] = {tile0_size, tile1_size, tile2_size};
+ * tiledb_filter_train_zstd_dictionary(
+ *     ctx, filter, samples, sample_sizes, 3, 16 * 1024);
+ * tiledb_filter_free(&filter);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target ZStd filter.
+ * @param samples The samples to train on.
+ * @param sample_sizes The size in bytes of each sample.
+ * @param num_samples The number of samples.
+ * @param max_dictionary_size The maximum size in bytes of the dictionary.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_train_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** samples,
+    const uint64_t* sample_sizes,
+    uint32_t num_samples,
+    uint64_t max_dictionary_size);
+
+/**
+ * Sets the dictionary of a ZStd filter, for instance one obtained from
+ * another filter with `tiledb_filter_get_zstd_dictionary`. An empty
+ * dictionary removes the dictionary.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t* filter;
+ * tiledb_filter_alloc(ctx, TILEDB_FILTER_ZSTD, &filter);
+ * tiledb_filter_set_zstd_dictionary(ctx, filter, dictionary, size);
+ * tiledb_filter_free(&filter);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target ZStd filter.
+ * @param dictionary The dictionary.
+ * @param size The size in bytes of the dictionary.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_set_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* dictionary,
+    uint64_t size);
+
+/**
+ * Gets the dictionary of a ZStd filter. The size is 0 if the filter has no
+ * dictionary. The dictionary is owned by the filter.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * const void* dictionary;
+ * uint64_t size;
+ * tiledb_filter_get_zstd_dictionary(ctx, filter, &dictionary, &size);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target filter.
+ * @param dictionary Set to the dictionary.
+ * @param size Set to the size in bytes of the dictionary.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_get_zstd_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** dictionary,
+    uint64_t* size);
+
 /* ********************************* */
 /*            FILTER LIST            */
 /* ********************************* */
@@ -2978,6 +3539,53 @@ TILEDB_EXPORT int32_t tiledb_array_schema_add_attribute(
     tiledb_array_schema_t* array_schema,
     tiledb_attribute_t* attr);
 
+/**
+ * Adds an attribute group to a sparse array schema. The tiles of the
+ * attributes of a group are stored interleaved in a single file per
+ * fragment, which saves requests and objects on object stores when reading
+ * several of them. The attributes must have been added to the schema, must
+ * be fixed-sized and not nullable, and can be in one group only. Attribute
+ * groups are not supported on remote arrays.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * const char* names[] = {"a1", "a2", "a3"};
+ * tiledb_array_schema_add_attribute_group(ctx, array_schema, names, 3);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_schema The array schema.
+ * @param attr_names The names of the attributes of the group.
+ * @param attr_num The number of attributes of the group.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_schema_add_attribute_group(
+    tiledb_ctx_t* ctx,
+    tiledb_array_schema_t* array_schema,
+    const char** attr_names,
+    uint32_t attr_num);
+
+/**
+ * Retrieves the number of attribute groups of an array schema.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint32_t group_num;
+ * tiledb_array_schema_get_attribute_group_num(ctx, array_schema, &group_num);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array_schema The array schema.
+ * @param group_num The number of attribute groups to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_schema_get_attribute_group_num(
+    tiledb_ctx_t* ctx,
+    const tiledb_array_schema_t* array_schema,
+    uint32_t* group_num);
+
 /**
  * Sets whether the array can allow coordinate duplicates or not.
  * Applicable only to sparse arrays (it errors out if set to `1` for dense
@@ -3589,6 +4197,95 @@ TILEDB_EXPORT int32_t tiledb_query_alloc(
 TILEDB_EXPORT int32_t tiledb_query_get_stats(
     tiledb_ctx_t* ctx, tiledb_query_t* query, char** stats_json);
 
+/**
+ * Retrieves the current and peak memory usage of a query for a memory
+ * category. The categories are `coord_tiles`, `bitmaps`,
+ * `query_condition_tiles`, `attribute_tiles`, `tile_overlap`, `array_data`
+ * and their sum `total`, as well as `tile_cache` for the tile caches of the
+ * context. The usage is also reported in the stats of the query, and is
+ * only recorded while stats are enabled, by the sparse readers.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t current, peak;
+ * tiledb_query_get_memory_usage(ctx, query, "total", &current, &peak);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object.
+ * @param category The memory category.
+ * @param current The current memory usage, in bytes.
+ * @param peak The peak memory usage, in bytes.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_memory_usage(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* category,
+    uint64_t* current,
+    uint64_t* peak);
+
+/**
+ * Retrieves the progress of a read query, accumulated over its submissions.
+ * This may be called from another thread while the query is submitted, e.g.
+ * to cancel a query that progresses too slowly. The phase is one of
+ * `not_started`, `load_metadata`, `read_tiles`, `unfilter_tiles`,
+ * `process_tiles`, `copy_results` and `completed`. The totals grow as the
+ * query schedules more tiles for reading.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * const char* phase;
+ * uint64_t tiles_read, tiles_total, bytes_read, bytes_total;
+ * tiledb_query_get_progress(
+ *     ctx, query, &phase, &tiles_read, &tiles_total, &bytes_read,
+ *     &bytes_total);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object.
+ * @param phase Set to the current phase. The string is static and must not
+ *     be freed.
+ * @param tiles_read The number of tiles read.
+ * @param tiles_total The number of tiles scheduled for reading.
+ * @param bytes_read The number of bytes read.
+ * @param bytes_total The number of bytes scheduled for reading.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_progress(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char** phase,
+    uint64_t* tiles_read,
+    uint64_t* tiles_total,
+    uint64_t* bytes_read,
+    uint64_t* bytes_total);
+
+/**
+ * Retrieves a report of how a read query ran, as JSON: the time and bytes
+ * of every phase, and the tiles and bytes read per fragment and per
+ * attribute or dimension. Unlike the stats, the report is recorded whether
+ * or not stats are enabled.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char* report_json;
+ * tiledb_query_get_report(ctx, query, &report_json);
+ * // Make sure to free the retrieved `report_json`
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object.
+ * @param report_json The output json. The caller takes ownership
+ *   of the c-string.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_report(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** report_json);
+
 /**
  * Set the query config
  *
@@ -4285,6 +4982,245 @@ TILEDB_EXPORT int32_t tiledb_query_set_condition(
     tiledb_query_t* query,
     const tiledb_query_condition_t* cond);
 
+/**
+ * Adds an aggregate to compute in a read query. A query with aggregates
+ * returns no cells and must not have any buffer set. Tiles fully covered by
+ * the query are answered from the tile metadata stored in the fragments,
+ * without reading them.
+ *
+ * `TILEDB_AGGREGATE_COUNT` can be computed on any attribute or dimension.
+ * `TILEDB_AGGREGATE_SUM`, `TILEDB_AGGREGATE_MIN` and `TILEDB_AGGREGATE_MAX`
+ * require a fixed-sized numeric attribute with one value per cell.
+ * Null cells are ignored by all operators but `TILEDB_AGGREGATE_COUNT`.
+ *
+ * For dense arrays, only the cells written by a fragment are aggregated. For
+ * sparse arrays that do not allow duplicates, the array must have a single
+ * fragment.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_add_aggregate(ctx, query, "a", TILEDB_AGGREGATE_SUM);
+ * tiledb_query_submit(ctx, query);
+ * int64_t sum;
+ * uint64_t sum_size = sizeof(sum);
+ * tiledb_query_get_aggregate(
+ *     ctx, query, "a", TILEDB_AGGREGATE_SUM, &sum, &sum_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param field_name The attribute/dimension to aggregate.
+ * @param op The aggregate operator.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_add_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* field_name,
+    tiledb_query_aggregate_op_t op);
+
+/**
+ * Retrieves the result of an aggregate once the query is completed.
+ *
+ * The result is a `uint64_t` for `TILEDB_AGGREGATE_COUNT` and
+ * `TILEDB_AGGREGATE_NULL_COUNT`. For `TILEDB_AGGREGATE_SUM` it is an
+ * `int64_t` for signed integers, a `uint64_t` for unsigned integers and a
+ * `double` for floating point attributes, saturated on overflow. For
+ * `TILEDB_AGGREGATE_MIN` and `TILEDB_AGGREGATE_MAX` it has the type of the
+ * attribute.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t count;
+ * uint64_t count_size = sizeof(count);
+ * tiledb_query_get_aggregate(
+ *     ctx, query, "a", TILEDB_AGGREGATE_COUNT, &count, &count_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param field_name The aggregated attribute/dimension.
+ * @param op The aggregate operator.
+ * @param value The buffer to copy the result into.
+ * @param value_size On input, the size of `value` in bytes. On output, the
+ *     size of the result, which is 0 if no non-null cell was aggregated for
+ *     `TILEDB_AGGREGATE_SUM`, `TILEDB_AGGREGATE_MIN` and
+ *     `TILEDB_AGGREGATE_MAX`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* field_name,
+    tiledb_query_aggregate_op_t op,
+    void* value,
+    uint64_t* value_size);
+
+/**
+ * Groups the aggregates of a read query on a sparse array by buckets of
+ * the values of an integer or datetime dimension. A cell with coordinate
+ * `x` falls in bucket `floor(x / bucket_width)`, and the aggregates are
+ * computed once per non-empty bucket. The results are retrieved with
+ * `tiledb_query_get_aggregate_bucket_num` and
+ * `tiledb_query_get_aggregate_bucket`.
+ *
+ * **Example:**
+ *
+ * Hourly sums of a timestamp dimension in seconds:
+ *
+ * @code{.c}
+ * tiledb_query_add_aggregate(ctx, query, "a", TILEDB_AGGREGATE_SUM);
+ * tiledb_query_set_aggregate_group_by(ctx, query, "ts", 3600);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param dim_name The dimension to group by.
+ * @param bucket_width The width of the buckets, in dimension units.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_aggregate_group_by(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* dim_name,
+    uint64_t bucket_width);
+
+/**
+ * Retrieves the number of non-empty buckets of a completed query whose
+ * aggregates are grouped by a dimension.
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param bucket_num Set to the number of buckets.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_aggregate_bucket_num(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, uint64_t* bucket_num);
+
+/**
+ * Retrieves the result of an aggregate for a bucket of a completed query
+ * whose aggregates are grouped by a dimension. The buckets are sorted in
+ * increasing order, the result has the type described in
+ * `tiledb_query_get_aggregate`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int64_t bucket;
+ * int64_t sum;
+ * uint64_t sum_size = sizeof(sum);
+ * tiledb_query_get_aggregate_bucket(
+ *     ctx, query, 0, "a", TILEDB_AGGREGATE_SUM, &bucket, &sum, &sum_size);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param bucket_idx The index of the bucket.
+ * @param field_name The aggregated attribute/dimension.
+ * @param op The aggregate operator.
+ * @param bucket Set to the bucket, `floor(x / bucket_width)` for the cells
+ *     `x` of the bucket.
+ * @param value The buffer to copy the result into.
+ * @param value_size On input, the size of `value` in bytes. On output, the
+ *     size of the result.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_aggregate_bucket(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    uint64_t bucket_idx,
+    const char* field_name,
+    tiledb_query_aggregate_op_t op,
+    int64_t* bucket,
+    void* value,
+    uint64_t* value_size);
+
+/**
+ * Makes a read query return a random sample of the cells it would return
+ * otherwise. Each cell is kept with probability `fraction`, and the tiles
+ * in which no cell is kept are not read. The sample only depends on `seed`
+ * and the positions of the cells in the fragments, so the same query on
+ * the same opened array returns the same cells. Sampling is supported by
+ * `TILEDB_UNORDERED` reads of sparse arrays, and can be combined with
+ * aggregates.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_sample(ctx, query, 0.01, 42);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param fraction The fraction of the cells to sample, in (0, 1].
+ * @param seed The seed of the sample.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_sample(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, double fraction, uint64_t seed);
+
+/**
+ * Makes a read query return only the `k` cells with the largest (or
+ * smallest) values of a fixed size attribute with one numeric value per
+ * cell. Null values are never returned, and cells with equal values are
+ * ranked by their position in the fragments. The query first scans the
+ * tiles for the top K cells, skipping the tiles whose min/max tile metadata
+ * shows they cannot hold one, then reads and copies the selected cells.
+ * The cells are not returned in the order of the attribute.
+ *
+ * Top K is supported by `TILEDB_UNORDERED` reads of sparse arrays, and
+ * cannot be combined with aggregates.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_top_k(ctx, query, "score", 100, 1);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param attribute_name The attribute to order on.
+ * @param k The number of cells to return.
+ * @param largest 1 to return the largest values, 0 for the smallest.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_top_k(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute_name,
+    uint64_t k,
+    int32_t largest);
+
+/**
+ * Prepares a read query to be executed repeatedly, e.g. to run the same
+ * lookup over many subarrays. The query is validated and its reader is
+ * created once. Setting a new subarray on the query after it completed
+ * keeps the reader, with its memory budget, loaded tile offsets and tile
+ * buffers, so the next submission only rebinds the subarray and the
+ * buffers.
+ *
+ * The buffers and the initial subarray must be set before preparing the
+ * query. Remote arrays are not supported.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_prepare(ctx, query);
+ * tiledb_query_submit(ctx, query);
+ * // Set the next ranges and reset the buffer sizes
+ * tiledb_query_set_subarray(ctx, query, subarray);
+ * tiledb_query_submit(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t
+tiledb_query_prepare(tiledb_ctx_t* ctx, tiledb_query_t* query);
+
 /**
  * Flushes all internal state of a query object and finalizes the query.
  * This is applicable only to global layout writes. It has no effect for
@@ -4395,6 +5331,62 @@ TILEDB_EXPORT int32_t tiledb_query_submit_async(
     void (*callback)(void*),
     void* callback_data);
 
+/**
+ * Cancels a TileDB query. This may be called from another thread while the
+ * query is in progress. The query then stops at the next tile, the pending
+ * submission fails and the query status becomes `TILEDB_CANCELLED`. A
+ * cancelled query cannot be submitted again. See also `sm.query.timeout_ms`
+ * to cancel queries past a deadline.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_cancel(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query to be cancelled.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t
+tiledb_query_cancel(tiledb_ctx_t* ctx, tiledb_query_t* query);
+
+/**
+ * Sets a function called while a read query on a remote array is submitted,
+ * every time a chunk of the server response has been copied into the user
+ * buffers. The function is called for every buffer set on the query, with
+ * the number of bytes of its offsets, data and validity buffers filled so
+ * far in the current submission. Those bytes are final, so they can be
+ * consumed before the submission completes. Queries on local arrays never
+ * call the function.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * void on_results(
+ *     const char* name,
+ *     uint64_t offsets_size,
+ *     uint64_t data_size,
+ *     uint64_t validity_size,
+ *     void* data) {
+ *   // Process the new results of buffer `name`
+ * }
+ *
+ * tiledb_query_set_partial_results_callback(ctx, query, on_results, NULL);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param callback The function to be called, or `NULL` to unset it.
+ * @param callback_data The data to be passed to the callback function.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_partial_results_callback(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    void (*callback)(const char*, uint64_t, uint64_t, uint64_t, void*),
+    void* callback_data);
+
 /**
  * Checks if the query has returned any results. Applicable only to
  * read queries; it sets `has_results` to `0 in the case of writes.
@@ -4955,6 +5947,65 @@ TILEDB_EXPORT int32_t tiledb_query_get_est_result_size_var_nullable(
     uint64_t* size_val,
     uint64_t* size_validity);
 
+/**
+ * Retrieves the estimated result size for an attribute or dimension,
+ * accounting for the query condition set on the query. Tiles that cannot
+ * contain a matching cell according to their min/max and null count
+ * metadata are excluded, and the remaining tiles are scaled by the fraction
+ * of their value range that satisfies the condition. Without a query
+ * condition the sizes match the other estimate functions.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t size_fixed, size_var, size_validity;
+ * tiledb_query_get_est_result_size_condition(
+ *     ctx, query, "a", &size_fixed, &size_var, &size_validity);
+ * @endcode
+ *
+ * @param ctx The TileDB context
+ * @param query The query.
+ * @param name The attribute/dimension name.
+ * @param size_fixed The size of the fixed-sized values, or of the offsets
+ *     of a var-sized attribute/dimension (in bytes) to be retrieved.
+ * @param size_var The size of the var-sized values (in bytes) to be
+ *     retrieved. Zero for fixed-sized attributes/dimensions.
+ * @param size_validity The size of the validity values (in bytes) to be
+ *     retrieved. Zero for non-nullable attributes/dimensions.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_est_result_size_condition(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_t* query,
+    const char* name,
+    uint64_t* size_fixed,
+    uint64_t* size_var,
+    uint64_t* size_validity);
+
+/**
+ * Retrieves the plan of a read query as a JSON object, without reading
+ * any tile. It reports the reader the query would be processed with, the
+ * relevant fragments and overlapping tiles, the estimated result, in-memory
+ * and persisted sizes per attribute/dimension, the estimated memory and,
+ * for the legacy reader, the number of partitions for the set buffers.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char* plan_json;
+ * tiledb_query_get_plan(ctx, query, &plan_json);
+ * // Make sure to free the retrieved `plan_json`
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The query object.
+ * @param plan_json The output json. The caller takes ownership
+ *   of the c-string.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_plan(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, char** plan_json);
+
 /**
  * Retrieves the number of written fragments. Applicable only to WRITE
  * queries.
@@ -5121,6 +6172,52 @@ TILEDB_EXPORT int32_t tiledb_query_condition_init(
     uint64_t condition_value_size,
     tiledb_query_condition_op_t op);
 
+/**
+ * Initializes a TileDB query condition object with a set of values, for the
+ * `TILEDB_IN` and `TILEDB_NOT_IN` operators. The values are provided in the
+ * same layout as var-sized attribute buffers, i.e. the members are stored
+ * back to back in `values` and `offsets` holds the starting byte offset of
+ * each member.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* query_condition;
+ * tiledb_query_condition_alloc(ctx, &query_condition);
+ *
+ * uint32_t values[] = {1, 5, 7};
+ * uint64_t offsets[] = {0, 4, 8};
+ * tiledb_query_condition_init_set(
+ *   ctx,
+ *   query_condition,
+ *   "longitude",
+ *   values,
+ *   sizeof(values),
+ *   offsets,
+ *   sizeof(offsets),
+ *   TILEDB_IN);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cond The allocated query condition object.
+ * @param attribute_name The attribute name.
+ * @param values The members of the set, stored back to back.
+ * @param values_size The byte size of `values`.
+ * @param offsets The starting byte offset of each member in `values`.
+ * @param offsets_size The byte size of `offsets`.
+ * @param op The set operator, `TILEDB_IN` or `TILEDB_NOT_IN`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_init_set(
+    tiledb_ctx_t* ctx,
+    tiledb_query_condition_t* cond,
+    const char* attribute_name,
+    const void* values,
+    uint64_t values_size,
+    const uint64_t* offsets,
+    uint64_t offsets_size,
+    tiledb_query_condition_op_t op);
+
 /**
  * Combines two query condition objects into a newly allocated
  * condition. Does not mutate or free the input condition objects.
@@ -5353,6 +6450,41 @@ TILEDB_EXPORT int32_t tiledb_subarray_add_range_by_name(
     const void* end,
     const void* stride);
 
+/**
+ * Adds a 1D range of labels along a subarray dimension index, which is in the
+ * form (start, end). The labels of a dimension are stored in a dense array at
+ * `<array_uri>/__labels/<dim_name>`, with one dimension of the type of the
+ * labeled dimension and one fixed-sized numeric attribute holding labels that
+ * are non-decreasing along the dimension. The range of the dimension indices
+ * whose labels are within (start, end) is found with a binary search on the
+ * label array and added to the subarray. The datatype of the range components
+ * must be the same as the type of the labels.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint32_t dim_idx = 0;
+ * double start = 1.5;
+ * double end = 2.5;
+ * tiledb_subarray_add_label_range(ctx, subarray, dim_idx, &start, &end);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param subarray The subarray to add the range to.
+ * @param dim_idx The index of the labeled dimension.
+ * @param start The start label.
+ * @param end The end label.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ *
+ * @note It is an error if no label is within the range.
+ */
+TILEDB_EXPORT int32_t tiledb_subarray_add_label_range(
+    tiledb_ctx_t* ctx,
+    tiledb_subarray_t* subarray,
+    uint32_t dim_idx,
+    const void* start,
+    const void* end);
+
 /**
  * Adds a 1D variable-sized range along a subarray dimension index, which is in
  * the form (start, end). Applicable only to variable-sized dimensions.
@@ -5710,6 +6842,38 @@ TILEDB_EXPORT int32_t tiledb_array_set_open_timestamp_start(
 TILEDB_EXPORT int32_t tiledb_array_set_open_timestamp_end(
     tiledb_ctx_t* ctx, tiledb_array_t* array, uint64_t timestamp_end);
 
+/**
+ * Sets a subarray hint to use when opening (and reopening) the array for
+ * reads. Only the fragments whose non-empty domain intersects the subarray
+ * are loaded, and the array behaves as if it had no other fragments. This
+ * makes opening arrays with many fragments cheaper when only a part of
+ * their domain is queried. The hint is ignored for remote arrays and when
+ * opening for writes.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_t* array;
+ * tiledb_array_alloc(ctx, "s3://tiledb_bucket/my_array", &array);
+ * int64_t subarray[] = {1, 10, 1, 10};
+ * tiledb_array_set_open_subarray(ctx, array, subarray, sizeof(subarray));
+ * tiledb_array_open(ctx, array, TILEDB_READ);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array to set the subarray hint on.
+ * @param subarray The subarray in the format `(dim1_low, dim1_high, ...)`,
+ *     with each range in the coordinate type of its dimension. All the
+ *     dimensions must be fixed-sized. `NULL` clears the hint.
+ * @param subarray_size The size of `subarray` in bytes.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_set_open_subarray(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    const void* subarray,
+    uint64_t subarray_size);
+
 /**
  * Gets the starting timestamp used when opening (and reopening) the array.
  * This is an inclusive bound.
@@ -7538,6 +8702,44 @@ TILEDB_EXPORT int32_t tiledb_stats_raw_dump_str(char** out);
  */
 TILEDB_EXPORT int32_t tiledb_stats_free_str(char** out);
 
+/**
+ * Enable the recording of tracing spans. While enabled, every internal
+ * statistics timer and every thread pool task is recorded as a span with
+ * its thread and the query it ran for.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_enable(void);
+
+/**
+ * Disable the recording of tracing spans. The recorded spans are kept
+ * until `tiledb_stats_reset` is called.
+ *
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_disable(void);
+
+/**
+ * Dump the recorded tracing spans to some output (e.g., file or stdout),
+ * in the Chrome trace event JSON format that `chrome://tracing` and
+ * Perfetto load.
+ *
+ * @param out The output.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_dump(FILE* out);
+
+/**
+ * Dump the recorded tracing spans to an output string, in the Chrome
+ * trace event JSON format. The caller is responsible for freeing the
+ * resulting string with `tiledb_stats_free_str`.
+ *
+ * @param out Will be set to point to an allocated string containing the
+ *     spans.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_stats_trace_dump_str(char** out);
+
 /* ****************************** */
 /*          Heap Profiler         */
 /* ****************************** */
@@ -7566,6 +8768,46 @@ TILEDB_EXPORT int32_t tiledb_heap_profiler_enable(
     uint64_t dump_interval_bytes,
     uint64_t dump_threshold_bytes);
 
+/**
+ * Enable heap profiling in sampling mode. Instead of recording every
+ * allocation, on average one allocation per `sample_interval_bytes`
+ * allocated bytes is recorded along with its stack trace, which keeps
+ * the overhead low enough for production use. This cannot be combined
+ * with `tiledb_heap_profiler_enable`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_heap_profiler_enable_sampling("tiledb_heap", 512 * 1024, 0);
+ * // ...
+ * tiledb_heap_profiler_dump_pprof("tiledb.heap");
+ * @endcode
+ *
+ * @param file_name_prefix The prefix of the profiles written when the
+ *   budget is exceeded. For example, value "tiledb_heap" will write to
+ *   "tiledb_heap__1611170501.heap". Defaults to "tiledb_heap" if empty
+ *   or null.
+ * @param sample_interval_bytes The average number of allocated bytes
+ *   between two samples. Must be non-zero.
+ * @param budget_bytes If non-zero, a profile is written when the
+ *   estimated allocated bytes exceed this amount.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_heap_profiler_enable_sampling(
+    const char* file_name_prefix,
+    uint64_t sample_interval_bytes,
+    uint64_t budget_bytes);
+
+/**
+ * Writes the allocations sampled since
+ * `tiledb_heap_profiler_enable_sampling` in the heap profile format read
+ * by `pprof`, e.g. `pprof --text <binary> <file_name>`.
+ *
+ * @param file_name The file to write.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_heap_profiler_dump_pprof(const char* file_name);
+
 /* ****************************** */
 /*          FRAGMENT INFO         */
 /* ****************************** */
@@ -7669,6 +8911,28 @@ TILEDB_DEPRECATED_EXPORT int32_t tiledb_fragment_info_load_with_key(
     const void* encryption_key,
     uint32_t key_length);
 
+/**
+ * Refreshes loaded fragment info with the fragments written and removed
+ * since it was loaded. Only the metadata of the new fragments is loaded,
+ * which makes it much cheaper than loading again for arrays with many
+ * fragments. If the timestamp range was not set, its end moves to the
+ * current time. The fragment indices may change.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_fragment_info_load(ctx, fragment_info);
+ * // ... fragments are written ...
+ * tiledb_fragment_info_refresh(ctx, fragment_info);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param fragment_info The fragment info object.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_fragment_info_refresh(
+    tiledb_ctx_t* ctx, tiledb_fragment_info_t* fragment_info);
+
 /**
  * Gets the number of fragments.
  *
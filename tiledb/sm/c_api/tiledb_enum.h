@@ -164,6 +164,8 @@
     TILEDB_LAYOUT_ENUM(UNORDERED) = 3,
     /** Hilbert layout */
     TILEDB_LAYOUT_ENUM(HILBERT) = 4,
+    /** Morton (Z-order) layout */
+    TILEDB_LAYOUT_ENUM(MORTON) = 5,
 #endif
 
 #ifdef TILEDB_FILTER_TYPE_ENUM
@@ -194,6 +196,18 @@
     TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_MD5) = 12,
     /** SHA256 checksum filter. */
     TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_SHA256) = 13,
+    /** Dictionary encoding filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_DICTIONARY) = 14,
+    /** Frame-of-reference and bit-packing filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_FRAME_OF_REFERENCE) = 15,
+    /** Floating-point XOR filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_FLOAT_XOR) = 16,
+    /** Compression filter that picks a compressor per chunk. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_AUTO_COMPRESSION) = 17,
+    /** CRC32C checksum filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_CRC32C) = 18,
+    /** Byte map to bitmap packing filter, for validity tiles. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_BITMAP) = 19,
 #endif
 
 #ifdef TILEDB_FILTER_OPTION_ENUM
@@ -203,6 +217,11 @@
     TILEDB_FILTER_OPTION_ENUM(BIT_WIDTH_MAX_WINDOW) = 1,
     /** Max window length for positive-delta encoding. Type: `uint32_t`. */
     TILEDB_FILTER_OPTION_ENUM(POSITIVE_DELTA_MAX_WINDOW) = 2,
+    /**
+     * Weight of decompression speed over ratio for automatic compression,
+     * from 0 to 100. Type: `uint32_t`.
+     */
+    TILEDB_FILTER_OPTION_ENUM(AUTO_COMPRESSION_SPEED_BIAS) = 3,
 #endif
 
 #ifdef TILEDB_ENCRYPTION_TYPE_ENUM
@@ -223,6 +242,8 @@
     TILEDB_QUERY_STATUS_ENUM(INCOMPLETE) = 3,
     /** Query not initialized.  */
     TILEDB_QUERY_STATUS_ENUM(UNINITIALIZED) = 4,
+    /** Query cancelled or past its deadline */
+    TILEDB_QUERY_STATUS_ENUM(CANCELLED) = 5,
 #endif
 
 #ifdef TILEDB_QUERY_STATUS_DETAILS_ENUM
@@ -246,6 +267,12 @@
     TILEDB_QUERY_CONDITION_OP_ENUM(EQ) = 4,
     /** Not-equal operator */
     TILEDB_QUERY_CONDITION_OP_ENUM(NE) = 5,
+    /** Set membership operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(IN) = 6,
+    /** Set non-membership operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(NOT_IN) = 7,
+    /** String prefix operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(PREFIX) = 8,
 #endif
 
 #ifdef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
@@ -257,6 +284,19 @@
     TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(NOT) = 2,
 #endif
 
+#ifdef TILEDB_QUERY_AGGREGATE_OP_ENUM
+    /** Number of cells */
+    TILEDB_QUERY_AGGREGATE_OP_ENUM(AGGREGATE_COUNT) = 0,
+    /** Sum of the non-null cell values */
+    TILEDB_QUERY_AGGREGATE_OP_ENUM(AGGREGATE_SUM) = 1,
+    /** Minimum of the non-null cell values */
+    TILEDB_QUERY_AGGREGATE_OP_ENUM(AGGREGATE_MIN) = 2,
+    /** Maximum of the non-null cell values */
+    TILEDB_QUERY_AGGREGATE_OP_ENUM(AGGREGATE_MAX) = 3,
+    /** Number of null cells */
+    TILEDB_QUERY_AGGREGATE_OP_ENUM(AGGREGATE_NULL_COUNT) = 4,
+#endif
+
 #ifdef TILEDB_SERIALIZATION_TYPE_ENUM
     /** Serialize to json */
     TILEDB_SERIALIZATION_TYPE_ENUM(JSON),
@@ -203,6 +203,74 @@ TILEDB_EXPORT int32_t tiledb_array_evolve(
 TILEDB_EXPORT int32_t tiledb_array_upgrade_version(
     tiledb_ctx_t* ctx, const char* array_uri, tiledb_config_t* config);
 
+/* ********************************* */
+/*           ARRAY SNAPSHOT          */
+/* ********************************* */
+
+/** An immutable snapshot of an array opened for reads. */
+typedef struct tiledb_array_snapshot_t tiledb_array_snapshot_t;
+
+/**
+ * Creates an immutable snapshot of an array opened for reads, freezing its
+ * schemas, fragment metadata and non-empty domain. The snapshot outlives
+ * the array, and any number of threads can open arrays from it
+ * concurrently with `tiledb_array_open_snapshot`, which involves no I/O.
+ * Remote arrays are not supported.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_snapshot_t* snapshot;
+ * tiledb_array_snapshot_alloc(ctx, array, &snapshot);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array opened for reads.
+ * @param snapshot The snapshot to be created.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_snapshot_alloc(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    tiledb_array_snapshot_t** snapshot);
+
+/**
+ * Frees a snapshot. The arrays opened from it remain valid.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_snapshot_free(&snapshot);
+ * @endcode
+ *
+ * @param snapshot The snapshot to be freed.
+ */
+TILEDB_EXPORT void tiledb_array_snapshot_free(
+    tiledb_array_snapshot_t** snapshot);
+
+/**
+ * Opens an array for reads from a snapshot, sharing the schemas, fragment
+ * metadata and non-empty domain of the snapshot instead of loading them.
+ * The array must have been allocated with the URI of the snapshot.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_t* array;
+ * tiledb_array_alloc(ctx, "hdfs:///tiledb_arrays/my_array", &array);
+ * tiledb_array_open_snapshot(ctx, array, snapshot);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array to open.
+ * @param snapshot The snapshot to open the array from.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_open_snapshot(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    tiledb_array_snapshot_t* snapshot);
+
 /* ********************************* */
 /*               QUERY               */
 /* ********************************* */
@@ -295,6 +363,245 @@ TILEDB_EXPORT int32_t tiledb_query_get_status_details(
     tiledb_query_t* query,
     tiledb_query_status_details_t* status);
 
+/* ********************************* */
+/*           QUERY STREAMING         */
+/* ********************************* */
+
+/**
+ * Submits a read query until it completes, streaming the results to a
+ * callback instead of returning incomplete submissions. The results are
+ * copied into batches of buffers owned by the library, sized like the
+ * buffers set on the query, and the query is resubmitted into the next
+ * batch while the callback consumes the previous ones. At most
+ * `max_inflight_batches` batches are being filled or consumed at any time.
+ *
+ * The callback is called on a single library thread, once per batch and in
+ * the order of the results, and retrieves them with
+ * `tiledb_query_get_stream_buffer`. It returns `TILEDB_OK` to continue or
+ * `TILEDB_ERR` to stop the stream, in which case this function returns
+ * `TILEDB_ERR`. The buffers set on the query are never written to. Remote
+ * arrays are not supported.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int32_t on_batch(tiledb_query_t* query, void* data) {
+ *   tiledb_ctx_t* ctx = (tiledb_ctx_t*)data;
+ *   const void *a, *offsets;
+ *   const uint8_t* validity;
+ *   uint64_t a_size, offsets_size, validity_size;
+ *   tiledb_query_get_stream_buffer(ctx, query, "a", &a, &a_size,
+ *       &offsets, &offsets_size, &validity, &validity_size);
+ *   // Process the batch
+ *   return TILEDB_OK;
+ * }
+ *
+ * tiledb_query_submit_streaming(ctx, query, on_batch, ctx, 2);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The read query, with its buffers set and not yet submitted.
+ * @param callback The function called with each batch.
+ * @param callback_data The data passed to the callback.
+ * @param max_inflight_batches The maximum number of batches in flight.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_submit_streaming(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    int32_t (*callback)(tiledb_query_t*, void*),
+    void* callback_data,
+    uint64_t max_inflight_batches);
+
+/**
+ * Retrieves the results of a buffer in the batch passed to the callback of
+ * `tiledb_query_submit_streaming`. It can only be called from the callback,
+ * and the pointers are valid until the callback returns. The sizes are in
+ * bytes.
+ *
+ * @param ctx The TileDB context.
+ * @param query The query passed to the callback.
+ * @param name The attribute/dimension name.
+ * @param data Set to the data, or the var-sized data of a var-sized field.
+ * @param data_size Set to the size of `data`.
+ * @param offsets Set to the offsets of a var-sized field, else `NULL`.
+ * @param offsets_size Set to the size of `offsets`.
+ * @param validity Set to the validity of a nullable field, else `NULL`.
+ * @param validity_size Set to the size of `validity`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_stream_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* name,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size);
+
+/* ********************************* */
+/*       MANAGED RESULT BUFFERS      */
+/* ********************************* */
+
+/**
+ * Lets the library allocate the result buffers of an attribute/dimension of
+ * a read query. On submission, the library sizes the buffers after the
+ * estimated result size and resubmits the query into new chunks of twice
+ * the size while the buffers are full, so that most queries complete in a
+ * single `tiledb_query_submit`. The chunks are bounded by the memory budget
+ * (`sm.memory_budget` and `sm.memory_budget_var`), in which case the query
+ * is left incomplete and the next submission releases the chunks.
+ *
+ * The buffers of all the fields of the query must be managed. The results
+ * are retrieved without copies with `tiledb_query_get_managed_buffer`.
+ * Async and streaming submissions and remote arrays are not supported.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_managed_buffer(ctx, query, "a");
+ * tiledb_query_submit(ctx, query);
+ * uint64_t chunk_num;
+ * tiledb_query_get_managed_buffer_chunk_num(ctx, query, &chunk_num);
+ * for (uint64_t c = 0; c < chunk_num; c++) {
+ *   const void *a, *offsets;
+ *   const uint8_t* validity;
+ *   uint64_t a_size, offsets_size, validity_size;
+ *   tiledb_query_get_managed_buffer(ctx, query, "a", c, &a, &a_size,
+ *       &offsets, &offsets_size, &validity, &validity_size);
+ *   // Process the chunk
+ * }
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The read query, not yet submitted.
+ * @param name The attribute/dimension name.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_managed_buffer(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, const char* name);
+
+/**
+ * Retrieves the number of chunks of the managed buffers holding the results
+ * of the last submission. Chunk `i` holds the results of the `i`-th internal
+ * submission for every field.
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param chunk_num Set to the number of chunks.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_managed_buffer_chunk_num(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, uint64_t* chunk_num);
+
+/**
+ * Retrieves the results of a managed buffer in a chunk. The pointers are
+ * owned by the query and valid until it is resubmitted or freed. The sizes
+ * are in bytes, and the offsets of a var-sized field are relative to the
+ * var-sized data of the same chunk.
+ *
+ * @param ctx The TileDB context.
+ * @param query The query.
+ * @param name The attribute/dimension name.
+ * @param chunk The chunk index.
+ * @param data Set to the data, or the var-sized data of a var-sized field.
+ * @param data_size Set to the size of `data`.
+ * @param offsets Set to the offsets of a var-sized field, else `NULL`.
+ * @param offsets_size Set to the size of `offsets`.
+ * @param validity Set to the validity of a nullable field, else `NULL`.
+ * @param validity_size Set to the size of `validity`.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_managed_buffer(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* name,
+    uint64_t chunk,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size);
+
+/* ********************************* */
+/*           FRAGMENT PARTS          */
+/* ********************************* */
+
+/**
+ * Generates the URI of a new dense fragment to be written in parts by
+ * several writers, possibly in different processes. Each writer opens the
+ * array for writes and writes the tiles of a slab of the fragment with
+ * `tiledb_query_set_fragment_part`, then
+ * `tiledb_array_commit_fragment_parts` makes the fragment visible.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * char uri[TILEDB_MAX_PATH];
+ * uint32_t length = TILEDB_MAX_PATH;
+ * tiledb_array_new_fragment_parts_uri(ctx, array, uri, &length);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array, opened for writes.
+ * @param uri_out The buffer where the null-terminated URI is stored.
+ * @param uri_length The length of the URI buffer. On return, this is set to
+ *     the length of the URI, or 0 on error.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_new_fragment_parts_uri(
+    tiledb_ctx_t* ctx,
+    tiledb_array_t* array,
+    char* uri_out,
+    uint32_t* uri_length);
+
+/**
+ * Makes a dense write query write a part of a fragment written in parts.
+ * The part holds the tiles of the query subarray, which must be a slab
+ * along the slowest varying dimension of the tile order, starting and
+ * ending on tile boundaries where it meets the other parts. The query
+ * layout cannot be `TILEDB_UNORDERED`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_fragment_part(ctx, query, uri, 0);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The dense write query, not yet submitted.
+ * @param fragment_uri The URI of the fragment written in parts.
+ * @param part The number of the part, unique within the fragment.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_fragment_part(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* fragment_uri,
+    uint32_t part);
+
+/**
+ * Commits a fragment written in parts, once all its parts are written.
+ * The metadata of the parts is merged into that of the fragment, without
+ * rewriting the tiles, and the fragment becomes visible.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_array_commit_fragment_parts(ctx, array, uri);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param array The array, opened for writes.
+ * @param fragment_uri The URI of the fragment written in parts.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_array_commit_fragment_parts(
+    tiledb_ctx_t* ctx, tiledb_array_t* array, const char* fragment_uri);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,7 @@
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/array_schema_evolution.h"
 #include "tiledb/sm/buffer/buffer_list.h"
+#include "tiledb/sm/cache/array_snapshot_lru_cache.h"
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/config/config_iter.h"
 #include "tiledb/sm/filesystem/vfs_file_handle.h"
@@ -54,6 +55,10 @@ struct tiledb_array_t {
   tiledb::sm::Array* array_ = nullptr;
 };
 
+struct tiledb_array_snapshot_t {
+  tdb_shared_ptr<tiledb::sm::ArraySnapshot> snapshot_;
+};
+
 struct tiledb_subarray_t {
   tiledb::sm::Subarray* subarray_ = nullptr;
 };
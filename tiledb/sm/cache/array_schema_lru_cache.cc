@@ -0,0 +1,106 @@
+/**
+ * @file   array_schema_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ArraySchemaLRUCache.
+ */
+
+#include "tiledb/sm/cache/array_schema_lru_cache.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/filesystem/uri.h"
+
+#include <cassert>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+ArraySchemaLRUCache::ArraySchemaLRUCache(const uint64_t max_size)
+    : LRUCache(max_size) {
+}
+
+std::string ArraySchemaLRUCache::key(
+    const URI& schema_uri, const EncryptionKey& encryption_key) {
+  auto enc_key = encryption_key.key();
+  std::string key = schema_uri.to_string();
+  key += '\0';
+  key += encryption_type_str(encryption_key.encryption_type());
+  key += '\0';
+  key.append(static_cast<const char*>(enc_key.data()), enc_key.size());
+  return key;
+}
+
+Status ArraySchemaLRUCache::insert(
+    const std::string& key,
+    const ArraySchema* const array_schema,
+    const uint64_t size) {
+  auto object = tdb_shared_ptr<ArraySchema>(tdb_new(ArraySchema, array_schema));
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<ArraySchema>>::insert(
+      key, std::move(object), size, false);
+}
+
+Status ArraySchemaLRUCache::read(
+    const std::string& key,
+    ArraySchema** const array_schema,
+    bool* const success) {
+  assert(success);
+  *success = false;
+
+  tdb_shared_ptr<ArraySchema> cached_schema;
+  {
+    std::lock_guard<std::mutex> lg(lru_mtx_);
+
+    // Check if the cache contains the item at `key`.
+    if (!has_item(key))
+      return Status::Ok();
+
+    // Touch the item to make it the most recently used item.
+    cached_schema = *get_item(key);
+    touch_item(key);
+  }
+
+  // Copy the schema outside of the lock.
+  *array_schema = tdb_new(ArraySchema, cached_schema.get());
+
+  *success = true;
+  return Status::Ok();
+}
+
+void ArraySchemaLRUCache::clear() {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<ArraySchema>>::clear();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,134 @@
+/**
+ * @file   array_schema_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ArraySchemaLRUCache.
+ */
+
+#ifndef TILEDB_ARRAY_SCHEMA_LRU_CACHE_H
+#define TILEDB_ARRAY_SCHEMA_LRU_CACHE_H
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <mutex>
+#include <string>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class EncryptionKey;
+class URI;
+
+/**
+ * Provides a least-recently used cache for deserialized `ArraySchema`
+ * objects, mapped by the schema URI and the encryption key the schema was
+ * read with. Schema files are never rewritten, so a cached schema is valid
+ * for as long as its array exists. The maximum capacity of the cache is
+ * defined as a total byte size among all objects, where the size of an
+ * object is approximated by its serialized size.
+ *
+ * The cache hands out copies of the cached schemas, which the callers own.
+ *
+ * This class is thread-safe.
+ */
+class ArraySchemaLRUCache
+    : public LRUCache<std::string, tdb_shared_ptr<ArraySchema>> {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param size The maximum cache byte size.
+   */
+  ArraySchemaLRUCache(uint64_t max_size);
+
+  /** Destructor. */
+  virtual ~ArraySchemaLRUCache() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the cache key of a schema read with the given encryption key.
+   *
+   * @param schema_uri The schema URI.
+   * @param encryption_key The encryption key.
+   * @return The cache key.
+   */
+  static std::string key(
+      const URI& schema_uri, const EncryptionKey& encryption_key);
+
+  /**
+   * Inserts a copy of a deserialized array schema into the cache.
+   *
+   * @param key The key that describes the inserted object.
+   * @param array_schema The array schema to copy.
+   * @param size The serialized size of the array schema.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key, const ArraySchema* array_schema, uint64_t size);
+
+  /**
+   * Copies the array schema labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param array_schema Set to a new copy of the cached array schema, owned
+   *     by the caller.
+   * @param success `true` if the schema was copied from the cache and
+   *     `false` otherwise.
+   * @return Status
+   */
+  Status read(
+      const std::string& key, ArraySchema** array_schema, bool* success);
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  // Protects LRUCache routines.
+  mutable std::mutex lru_mtx_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_ARRAY_SCHEMA_LRU_CACHE_H
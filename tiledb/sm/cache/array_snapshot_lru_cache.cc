@@ -0,0 +1,113 @@
+/**
+ * @file   array_snapshot_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ArraySnapshotLRUCache.
+ */
+
+#include "tiledb/sm/cache/array_snapshot_lru_cache.h"
+#include "tiledb/common/stdx_string.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/metadata/metadata.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+ArraySnapshotLRUCache::ArraySnapshotLRUCache(const uint64_t max_num)
+    : LRUCache(max_num) {
+}
+
+std::string ArraySnapshotLRUCache::key(
+    const URI& array_uri,
+    uint64_t timestamp_start,
+    uint64_t timestamp_end,
+    const EncryptionKey& encryption_key) {
+  auto enc_key = encryption_key.key();
+  std::string key = array_uri.remove_trailing_slash().to_string();
+  key += '\0';
+  key += std::to_string(timestamp_start) + '_' + std::to_string(timestamp_end);
+  key += '\0';
+  key += encryption_type_str(encryption_key.encryption_type());
+  key += '\0';
+  key.append(static_cast<const char*>(enc_key.data()), enc_key.size());
+  return key;
+}
+
+Status ArraySnapshotLRUCache::insert(
+    const std::string& key, const tdb_shared_ptr<ArraySnapshot>& snapshot) {
+  auto object = snapshot;
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<ArraySnapshot>>::insert(
+      key, std::move(object), 1);
+}
+
+tdb_shared_ptr<ArraySnapshot> ArraySnapshotLRUCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+
+  // Check if the cache contains the item at `key`.
+  if (!has_item(key))
+    return nullptr;
+
+  // Touch the item to make it the most recently used item.
+  auto snapshot = *get_item(key);
+  touch_item(key);
+
+  return snapshot;
+}
+
+void ArraySnapshotLRUCache::invalidate(const URI& uri) {
+  const std::string prefix = uri.remove_trailing_slash().to_string();
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  std::vector<std::string> keys;
+  for (auto it = item_iter_begin(); it != item_iter_end(); ++it) {
+    if (stdx::string::starts_with(it->key_, prefix))
+      keys.push_back(it->key_);
+  }
+  for (const auto& key : keys) {
+    bool success = false;
+    LRUCache<std::string, tdb_shared_ptr<ArraySnapshot>>::invalidate(
+        key, &success);
+  }
+}
+
+void ArraySnapshotLRUCache::clear() {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<ArraySnapshot>>::clear();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,196 @@
+/**
+ * @file   array_snapshot_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ArraySnapshotLRUCache.
+ */
+
+#ifndef TILEDB_ARRAY_SNAPSHOT_LRU_CACHE_H
+#define TILEDB_ARRAY_SNAPSHOT_LRU_CACHE_H
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/misc/types.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class EncryptionKey;
+class FragmentDomainIndex;
+class FragmentMetadata;
+class Metadata;
+class TileOverlapLRUCache;
+
+/**
+ * The state of an array opened for reads at fixed timestamps: its schemas,
+ * the metadata of the fragments in the timestamp range and, once loaded,
+ * the array metadata.
+ *
+ * The snapshots created by `Array::snapshot` also freeze the array URI,
+ * timestamps, encryption key and non-empty domain, along with the indexes
+ * built over the fragments, so that any number of arrays can be opened from
+ * them concurrently with no I/O. Such snapshots are immutable.
+ */
+struct ArraySnapshot {
+  /** The array URI. */
+  URI array_uri_;
+
+  /** The start of the timestamp range. */
+  uint64_t timestamp_start_ = 0;
+
+  /** The end of the timestamp range, resolved at the first open. */
+  uint64_t timestamp_end_ = 0;
+
+  /** The encryption key of the array. */
+  tdb_shared_ptr<EncryptionKey> encryption_key_;
+
+  /** The non-empty domain of the array. */
+  NDRange non_empty_domain_;
+
+  /** The tile overlap cache, or `nullptr` if the cache is disabled. */
+  tdb_shared_ptr<TileOverlapLRUCache> tile_overlap_cache_;
+
+  /**
+   * The index over the fragment non-empty domains, or `nullptr` for arrays
+   * with few fragments.
+   */
+  tdb_shared_ptr<FragmentDomainIndex> fragment_domain_index_;
+
+  /** The latest array schema, copied into the arrays opening the snapshot. */
+  tdb_shared_ptr<ArraySchema> array_schema_latest_;
+
+  /** All the array schemas, keyed by name. */
+  std::unordered_map<std::string, tdb_shared_ptr<ArraySchema>>
+      array_schemas_all_;
+
+  /** The metadata of the fragments in the timestamp range. */
+  std::vector<tdb_shared_ptr<FragmentMetadata>> fragment_metadata_;
+
+  /** The array metadata, `nullptr` until it is first loaded. */
+  tdb_shared_ptr<Metadata> metadata_;
+
+  /** Protects `metadata_`. */
+  std::mutex mtx_;
+};
+
+/**
+ * Provides a least-recently used cache of `ArraySnapshot` objects, shared
+ * by all the arrays opened with the same storage manager. The snapshots are
+ * mapped by the array URI, the timestamp range and the encryption key, and
+ * the maximum capacity of the cache is a number of snapshots.
+ *
+ * This class is thread-safe.
+ */
+class ArraySnapshotLRUCache
+    : public LRUCache<std::string, tdb_shared_ptr<ArraySnapshot>> {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_num The maximum number of cached snapshots.
+   */
+  ArraySnapshotLRUCache(uint64_t max_num);
+
+  /** Destructor. */
+  virtual ~ArraySnapshotLRUCache() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the cache key of an array opened at the given timestamps with
+   * the given encryption key.
+   *
+   * @param array_uri The array URI.
+   * @param timestamp_start The start of the timestamp range.
+   * @param timestamp_end The end of the timestamp range.
+   * @param encryption_key The encryption key.
+   * @return The cache key.
+   */
+  static std::string key(
+      const URI& array_uri,
+      uint64_t timestamp_start,
+      uint64_t timestamp_end,
+      const EncryptionKey& encryption_key);
+
+  /**
+   * Inserts a snapshot into the cache.
+   *
+   * @param key The key that describes the inserted snapshot.
+   * @param snapshot The snapshot.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key, const tdb_shared_ptr<ArraySnapshot>& snapshot);
+
+  /**
+   * Retrieves the snapshot labeled by `key`.
+   *
+   * @param key The label of the snapshot to be retrieved.
+   * @return The cached snapshot, or `nullptr` if it is not cached.
+   */
+  tdb_shared_ptr<ArraySnapshot> get(const std::string& key);
+
+  /**
+   * Evicts the snapshots of the arrays under the given URI.
+   *
+   * @param uri The URI of the changed array or group.
+   */
+  void invalidate(const URI& uri);
+
+  /** Clears the cache, deleting all cached snapshots. */
+  void clear();
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  // Protects LRUCache routines.
+  mutable std::mutex lru_mtx_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_ARRAY_SNAPSHOT_LRU_CACHE_H
@@ -43,17 +43,22 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
-BufferLRUCache::BufferLRUCache(const uint64_t max_size)
-    : LRUCache(max_size) {
+BufferLRUCache::BufferLRUCache(
+    const uint64_t max_size, const CachePolicy policy)
+    : LRUCache(max_size, policy) {
 }
 
 Status BufferLRUCache::insert(
-    const std::string& key, FilteredBuffer&& buffer, const bool overwrite) {
+    const std::string& key,
+    FilteredBuffer&& buffer,
+    const bool overwrite,
+    uint64_t* const evicted_num,
+    bool* const admitted) {
   const uint64_t alloced_size = buffer.size();
 
   std::lock_guard<std::mutex> lg(lru_mtx_);
   return LRUCache<std::string, FilteredBuffer>::insert(
-      key, std::move(buffer), alloced_size, overwrite);
+      key, std::move(buffer), alloced_size, overwrite, evicted_num, admitted);
 }
 
 Status BufferLRUCache::read(
@@ -62,11 +67,23 @@ Status BufferLRUCache::read(
     const uint64_t offset,
     const uint64_t nbytes,
     bool* const success) {
+  return read(key, buffer.data(), offset, nbytes, success);
+}
+
+Status BufferLRUCache::read(
+    const std::string& key,
+    void* const data,
+    const uint64_t offset,
+    const uint64_t nbytes,
+    bool* const success) {
   assert(success);
   *success = false;
 
   std::lock_guard<std::mutex> lg(lru_mtx_);
 
+  // Count the access for the admission policy, hit or miss.
+  record_access(key);
+
   // Check if the cache contains the item at `key`.
   if (!has_item(key))
     return Status::Ok();
@@ -80,8 +97,8 @@ Status BufferLRUCache::read(
         Status_LRUCacheError("Failed to read item; Byte range out of bounds"));
   }
 
-  // Copy the requested range into the output `buffer`.
-  memcpy(buffer.data(), cached_buffer->data() + offset, nbytes);
+  // Copy the requested range into the output `data`.
+  memcpy(data, cached_buffer->data() + offset, nbytes);
 
   // Touch the item to make it the most recently used item.
   touch_item(key);
@@ -95,6 +112,16 @@ void BufferLRUCache::clear() {
   return LRUCache<std::string, FilteredBuffer>::clear();
 }
 
+uint64_t BufferLRUCache::size() {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, FilteredBuffer>::size();
+}
+
+uint64_t BufferLRUCache::shed(const uint64_t nbytes) {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, FilteredBuffer>::shed(nbytes);
+}
+
 Status BufferLRUCache::invalidate(const std::string& key, bool* success) {
   std::lock_guard<std::mutex> lg(lru_mtx_);
   return LRUCache<std::string, FilteredBuffer>::invalidate(key, success);
@@ -66,8 +66,9 @@ class BufferLRUCache : public LRUCache<std::string, FilteredBuffer> {
    * Constructor.
    *
    * @param size The maximum cache byte size.
+   * @param policy The admission and eviction policy.
    */
-  BufferLRUCache(uint64_t max_size);
+  BufferLRUCache(uint64_t max_size, CachePolicy policy = CachePolicy::LRU);
 
   /** Destructor. */
   virtual ~BufferLRUCache() = default;
@@ -84,10 +85,18 @@ class BufferLRUCache : public LRUCache<std::string, FilteredBuffer> {
    * @param buffer The buffer to store.
    * @param overwrite If `true`, if the object exists in the cache it will be
    *     overwritten. Otherwise, the new object will be deleted.
+   * @param evicted_num If not `nullptr`, set to the number of objects
+   *     evicted to make room for `buffer`.
+   * @param admitted If not `nullptr`, set to `false` if the buffer was not
+   *     inserted because of its size or the admission policy.
    * @return Status
    */
   Status insert(
-      const std::string& key, FilteredBuffer&& buffer, bool overwrite = true);
+      const std::string& key,
+      FilteredBuffer&& buffer,
+      bool overwrite = true,
+      uint64_t* evicted_num = nullptr,
+      bool* admitted = nullptr);
 
   /**
    * Reads a portion of the object labeled by `key`.
@@ -107,9 +116,39 @@ class BufferLRUCache : public LRUCache<std::string, FilteredBuffer> {
       uint64_t nbytes,
       bool* success);
 
+  /**
+   * Reads a portion of the object labeled by `key` into raw memory.
+   *
+   * @param key The label of the object to be read.
+   * @param data The memory that will store the data to be read.
+   * @param offset The offset where the read will start.
+   * @param nbytes The number of bytes to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(
+      const std::string& key,
+      void* data,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success);
+
   /** Clears the cache, deleting all cached items. */
   void clear();
 
+  /** Returns the byte size of the cached buffers. */
+  uint64_t size();
+
+  /**
+   * Evicts buffers until at least `nbytes` bytes are freed, or the cache is
+   * empty.
+   *
+   * @param nbytes The number of bytes to free.
+   * @return The number of bytes freed.
+   */
+  uint64_t shed(uint64_t nbytes);
+
   /**
    * Invalidates and evicts the object in the cache with the given key.
    *
@@ -0,0 +1,101 @@
+/**
+ * @file   fragment_metadata_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FragmentMetadataLRUCache.
+ */
+
+#include "tiledb/sm/cache/fragment_metadata_lru_cache.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+
+#include <algorithm>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+FragmentMetadataLRUCache::FragmentMetadataLRUCache(const uint64_t max_size)
+    : LRUCache(max_size) {
+}
+
+std::string FragmentMetadataLRUCache::key(
+    const URI& fragment_uri, const EncryptionKey& encryption_key) {
+  auto enc_key = encryption_key.key();
+  std::string key = fragment_uri.remove_trailing_slash().to_string();
+  key += '\0';
+  key += encryption_type_str(encryption_key.encryption_type());
+  key += '\0';
+  key.append(static_cast<const char*>(enc_key.data()), enc_key.size());
+  return key;
+}
+
+Status FragmentMetadataLRUCache::insert(
+    const std::string& key, const tdb_shared_ptr<FragmentMetadata>& metadata) {
+  const uint64_t size =
+      std::max<uint64_t>(metadata->footer_size(), sizeof(FragmentMetadata));
+  auto object = metadata;
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<FragmentMetadata>>::insert(
+      key, std::move(object), size, false);
+}
+
+tdb_shared_ptr<FragmentMetadata> FragmentMetadataLRUCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+
+  // Check if the cache contains the item at `key`.
+  if (!has_item(key))
+    return nullptr;
+
+  // Touch the item to make it the most recently used item.
+  auto metadata = *get_item(key);
+  touch_item(key);
+
+  return metadata;
+}
+
+void FragmentMetadataLRUCache::clear() {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<FragmentMetadata>>::clear();
+}
+
+Status FragmentMetadataLRUCache::invalidate(
+    const std::string& key, bool* success) {
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<FragmentMetadata>>::invalidate(
+      key, success);
+}
+
+}  // namespace sm
+}  // namespace tiledb
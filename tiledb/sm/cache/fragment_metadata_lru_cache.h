@@ -0,0 +1,142 @@
+/**
+ * @file   fragment_metadata_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FragmentMetadataLRUCache.
+ */
+
+#ifndef TILEDB_FRAGMENT_METADATA_LRU_CACHE_H
+#define TILEDB_FRAGMENT_METADATA_LRU_CACHE_H
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <mutex>
+#include <string>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class EncryptionKey;
+class FragmentMetadata;
+class URI;
+
+/**
+ * Provides a least-recently used cache for loaded `FragmentMetadata`
+ * objects, shared by all the arrays opened with the same storage manager.
+ * The objects are mapped by the fragment URI and the encryption key the
+ * fragment was loaded with. The maximum capacity of the cache is defined
+ * as a total byte size among all objects, where the size of an object is
+ * approximated by the size of its footer.
+ *
+ * The cached objects are shared, so the sections of the metadata that are
+ * loaded lazily (e.g. R-trees and tile offsets) are loaded once for all the
+ * arrays using them.
+ *
+ * This class is thread-safe.
+ */
+class FragmentMetadataLRUCache
+    : public LRUCache<std::string, tdb_shared_ptr<FragmentMetadata>> {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param size The maximum cache byte size.
+   */
+  FragmentMetadataLRUCache(uint64_t max_size);
+
+  /** Destructor. */
+  virtual ~FragmentMetadataLRUCache() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the cache key of a fragment loaded with the given encryption
+   * key.
+   *
+   * @param fragment_uri The fragment URI.
+   * @param encryption_key The encryption key.
+   * @return The cache key.
+   */
+  static std::string key(
+      const URI& fragment_uri, const EncryptionKey& encryption_key);
+
+  /**
+   * Inserts a loaded fragment metadata into the cache. The metadata must
+   * keep the array schema it references alive for as long as it exists.
+   *
+   * @param key The key that describes the inserted object.
+   * @param metadata The fragment metadata.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key, const tdb_shared_ptr<FragmentMetadata>& metadata);
+
+  /**
+   * Retrieves the fragment metadata labeled by `key`.
+   *
+   * @param key The label of the object to be retrieved.
+   * @return The cached fragment metadata, or `nullptr` if it is not cached.
+   */
+  tdb_shared_ptr<FragmentMetadata> get(const std::string& key);
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+  /**
+   * Invalidates and evicts the object in the cache with the given key.
+   *
+   * @param key The key that describes the object to be invalidated.
+   * @param success Set to `true` if the object was removed successfully; if
+   *    the object did not exist in the cache, set to `false`.
+   * @return Status
+   */
+  Status invalidate(const std::string& key, bool* success);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  // Protects LRUCache routines.
+  mutable std::mutex lru_mtx_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAGMENT_METADATA_LRU_CACHE_H
@@ -0,0 +1,151 @@
+/**
+ * @file   frequency_sketch.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FrequencySketch.
+ */
+
+#ifndef TILEDB_FREQUENCY_SKETCH_H
+#define TILEDB_FREQUENCY_SKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A count-min sketch estimating how often hashed keys were accessed, with
+ * small saturating counters. All counters are halved periodically so that
+ * the estimates favor recent accesses.
+ *
+ * This class is not thread-safe.
+ */
+class FrequencySketch {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param width The number of counters per row, rounded up to a power of 2.
+   */
+  explicit FrequencySketch(uint64_t width)
+      : mask_(0)
+      , additions_(0) {
+    uint64_t w = 1;
+    while (w < width)
+      w <<= 1;
+    mask_ = w - 1;
+    counters_.resize(DEPTH * w, 0);
+    sample_size_ = 10 * w;
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Records an access to the key with hash `hash`. */
+  void increment(uint64_t hash) {
+    bool added = false;
+    for (uint64_t i = 0; i < DEPTH; i++) {
+      auto& counter = counters_[i * (mask_ + 1) + index(hash, i)];
+      if (counter < MAX_COUNT) {
+        counter++;
+        added = true;
+      }
+    }
+
+    if (added && ++additions_ == sample_size_)
+      reset();
+  }
+
+  /** Returns the estimated number of accesses to the key with hash `hash`. */
+  uint8_t frequency(uint64_t hash) const {
+    uint8_t result = MAX_COUNT;
+    for (uint64_t i = 0; i < DEPTH; i++) {
+      const auto counter = counters_[i * (mask_ + 1) + index(hash, i)];
+      if (counter < result)
+        result = counter;
+    }
+
+    return result;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of rows of counters. */
+  static constexpr uint64_t DEPTH = 4;
+
+  /** The value at which counters saturate. */
+  static constexpr uint8_t MAX_COUNT = 15;
+
+  /** The counters, `DEPTH` rows one after the other. */
+  std::vector<uint8_t> counters_;
+
+  /** The mask giving a counter index within a row. */
+  uint64_t mask_;
+
+  /** The number of additions after which all counters are halved. */
+  uint64_t sample_size_;
+
+  /** The number of additions since the last halving. */
+  uint64_t additions_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the counter index of `hash` in row `row`. */
+  uint64_t index(uint64_t hash, uint64_t row) const {
+    static constexpr uint64_t seeds[DEPTH] = {0x9E3779B97F4A7C15ULL,
+                                              0xC2B2AE3D27D4EB4FULL,
+                                              0x165667B19E3779F9ULL,
+                                              0xD6E8FEB86659FD93ULL};
+    uint64_t h = (hash + seeds[row]) * seeds[(row + 1) % DEPTH];
+    h ^= h >> 32;
+    return h & mask_;
+  }
+
+  /** Halves all the counters. */
+  void reset() {
+    for (auto& counter : counters_)
+      counter >>= 1;
+    additions_ /= 2;
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FREQUENCY_SKETCH_H
@@ -0,0 +1,99 @@
+/**
+ * @file   inflight_tile_reads.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class InflightTileReads.
+ */
+
+#include "tiledb/sm/cache/inflight_tile_reads.h"
+#include "tiledb/sm/filesystem/uri.h"
+
+#include <cstring>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+std::pair<tdb_shared_ptr<InflightTileReads::Read>, bool>
+InflightTileReads::join(const URI& uri, const uint64_t offset) {
+  std::string key = uri.to_string();
+  key.append(reinterpret_cast<const char*>(&offset), sizeof(offset));
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = reads_.find(key);
+  if (it != reads_.end()) {
+    ++it->second->follower_num_;
+    return {it->second, false};
+  }
+
+  auto read = tdb::make_shared<Read>(HERE());
+  read->key_ = key;
+  reads_.emplace(std::move(key), read);
+  return {read, true};
+}
+
+void InflightTileReads::complete(
+    const tdb_shared_ptr<Read>& read, const void* data, const uint64_t nbytes) {
+  // No follower can join once the read is out of the map.
+  uint64_t follower_num = 0;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = reads_.find(read->key_);
+    if (it != reads_.end() && it->second == read)
+      reads_.erase(it);
+    follower_num = read->follower_num_;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(read->mtx_);
+    if (read->done_)
+      return;
+    if (data != nullptr && follower_num > 0) {
+      auto src = static_cast<const uint8_t*>(data);
+      read->data_.assign(src, src + nbytes);
+    }
+    read->ok_ = data != nullptr;
+    read->done_ = true;
+  }
+  read->cv_.notify_all();
+}
+
+bool InflightTileReads::wait(
+    const tdb_shared_ptr<Read>& read, void* buffer, uint64_t nbytes) {
+  std::unique_lock<std::mutex> lock(read->mtx_);
+  read->cv_.wait(lock, [&read]() { return read->done_; });
+  if (!read->ok_ || read->data_.size() != nbytes)
+    return false;
+
+  std::memcpy(buffer, read->data_.data(), nbytes);
+  return true;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,166 @@
+/**
+ * @file   inflight_tile_reads.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class InflightTileReads.
+ */
+
+#ifndef TILEDB_INFLIGHT_TILE_READS_H
+#define TILEDB_INFLIGHT_TILE_READS_H
+
+#include "tiledb/common/common.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class URI;
+
+/**
+ * Tracks the tile reads in flight for the queries of a storage manager, so
+ * that concurrent queries over overlapping subarrays read each tile once.
+ * The first query to read a tile leads the read, and the queries needing
+ * the same tile while it is in flight follow it, receiving a copy of the
+ * filtered tile once the read of the leader completes.
+ *
+ * Followers only ever wait for the I/O of leaders, which never waits for
+ * other queries, so queries cannot wait on each other in a cycle.
+ *
+ * This class is thread-safe.
+ */
+class InflightTileReads {
+ public:
+  /** A tile read in flight. */
+  class Read {
+   public:
+    friend class InflightTileReads;
+
+   private:
+    /** The key of the tile, formed by its file and offset. */
+    std::string key_;
+
+    /** Protects the state below. */
+    std::mutex mtx_;
+
+    /** Signaled when the read completes. */
+    std::condition_variable cv_;
+
+    /** `true` once the read completed. */
+    bool done_ = false;
+
+    /** `true` if the read completed successfully. */
+    bool ok_ = false;
+
+    /**
+     * The number of followers. This is protected by the mutex of the
+     * `InflightTileReads` instance, which also protects the map followers
+     * join the read through.
+     */
+    uint64_t follower_num_ = 0;
+
+    /** The filtered tile, copied here only if the read has followers. */
+    std::vector<uint8_t> data_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  InflightTileReads() = default;
+
+  /** Destructor. */
+  ~InflightTileReads() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(InflightTileReads);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(InflightTileReads);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Joins the read of a tile, leading it if no other read of the tile is in
+   * flight and following it otherwise. A leader must call `complete` once
+   * its read finishes, successfully or not, and a follower must call
+   * `wait`.
+   *
+   * @param uri The URI of the file of the tile.
+   * @param offset The offset of the tile in the file.
+   * @return The read, and `true` if the caller leads it.
+   */
+  std::pair<tdb_shared_ptr<Read>, bool> join(const URI& uri, uint64_t offset);
+
+  /**
+   * Completes a read led by the caller, handing the filtered tile over to
+   * its followers. Completing a read again has no effect.
+   *
+   * @param read The read returned by `join`.
+   * @param data The filtered tile, or `nullptr` if the read failed.
+   * @param nbytes The size of the filtered tile.
+   */
+  void complete(
+      const tdb_shared_ptr<Read>& read, const void* data, uint64_t nbytes);
+
+  /**
+   * Waits for a read followed by the caller to complete and copies the
+   * filtered tile into `buffer`.
+   *
+   * @param read The read returned by `join`.
+   * @param buffer The buffer to copy the filtered tile into.
+   * @param nbytes The size of the filtered tile.
+   * @return `true` if the tile was copied, `false` if the leader failed to
+   *     read it, in which case the follower reads it itself.
+   */
+  static bool wait(
+      const tdb_shared_ptr<Read>& read, void* buffer, uint64_t nbytes);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Protects `reads_` and the follower numbers of the reads. */
+  std::mutex mtx_;
+
+  /** The reads in flight, keyed by their tile. */
+  std::unordered_map<std::string, tdb_shared_ptr<Read>> reads_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_INFLIGHT_TILE_READS_H
@@ -35,8 +35,12 @@
 
 #include "tiledb/common/macros.h"
 #include "tiledb/common/status.h"
+#include "tiledb/sm/cache/frequency_sketch.h"
+#include "tiledb/sm/enums/cache_policy.h"
 
+#include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -50,6 +54,10 @@ namespace sm {
  * key to a value. The LRU takes ownership of the objects
  * stored in the cache.
  *
+ * With the segmented policies (see `CachePolicy`), the cached items are
+ * split in a probationary and a protected list, each ordered from least to
+ * most recently used.
+ *
  * This class is not thread-safe.
  *
  * @tparam K the type of the key.
@@ -75,7 +83,8 @@ class LRUCache {
     LRUCacheItem(const K& key, V&& object, const uint64_t size)
         : key_(key)
         , object_(std::move(object))
-        , size_(size) {
+        , size_(size)
+        , protected_(false) {
     }
 
     DISABLE_MOVE(LRUCacheItem);
@@ -89,6 +98,7 @@ class LRUCache {
       key_ = other.key_;
       object_ = std::move(other.object_);
       size_ = other.size_;
+      protected_ = other.protected_;
       return *this;
     }
 
@@ -106,6 +116,9 @@ class LRUCache {
 
     /** The logical object size. */
     uint64_t size_;
+
+    /** Whether the item is in the protected list. */
+    bool protected_;
   };
 
  protected:
@@ -117,10 +130,17 @@ class LRUCache {
    * Constructor.
    *
    * @param size The maximum logical cache size.
+   * @param policy The admission and eviction policy.
    */
-  explicit LRUCache(const uint64_t max_size)
+  explicit LRUCache(
+      const uint64_t max_size, const CachePolicy policy = CachePolicy::LRU)
       : max_size_(max_size)
-      , size_(0) {
+      , size_(0)
+      , policy_(policy)
+      , protected_max_size_(max_size / 5 * 4)
+      , protected_size_(0) {
+    if (policy_ == CachePolicy::TINYLFU)
+      sketch_ = std::make_unique<FrequencySketch>(SKETCH_WIDTH);
   }
 
   /** Destructor. */
@@ -133,6 +153,29 @@ class LRUCache {
   /** Clears the cache, deleting all cached items. */
   void clear() {
     item_ll_.clear();
+    protected_ll_.clear();
+    item_map_.clear();
+    size_ = 0;
+    protected_size_ = 0;
+  }
+
+  /** Returns the logical size of the cached objects. */
+  uint64_t size() const {
+    return size_;
+  }
+
+  /**
+   * Evicts objects until at least `nbytes` of their logical size is freed,
+   * or the cache is empty.
+   *
+   * @param nbytes The size to free.
+   * @return The size freed.
+   */
+  uint64_t shed(const uint64_t nbytes) {
+    const uint64_t old_size = size_;
+    while (size_ > 0 && old_size - size_ < nbytes)
+      evict();
+    return old_size - size_;
   }
 
   /**
@@ -144,10 +187,24 @@ class LRUCache {
    * @param size The logical size of the object.
    * @param overwrite If `true`, if the object exists in the cache it will be
    *     overwritten. Otherwise, the new object will be deleted.
+   * @param evicted_num If not `nullptr`, set to the number of objects
+   *     evicted to make room for `object`.
+   * @param admitted If not `nullptr`, set to `false` if the object was not
+   *     inserted because of its size or the admission policy.
    * @return Status
    */
   Status insert(
-      const K& key, V&& object, uint64_t size, bool overwrite = true) {
+      const K& key,
+      V&& object,
+      uint64_t size,
+      bool overwrite = true,
+      uint64_t* evicted_num = nullptr,
+      bool* admitted = nullptr) {
+    if (evicted_num != nullptr)
+      *evicted_num = 0;
+    if (admitted != nullptr)
+      *admitted = false;
+
     // Do nothing if the object size is bigger than the cache maximum size
     if (size > max_size_)
       return Status::Ok();
@@ -156,10 +213,25 @@ class LRUCache {
     if (exists && !overwrite)
       return Status::Ok();
 
+    // With TinyLFU, a new object that would evict objects is admitted only
+    // if it is estimated to be more frequently used than the first victim.
+    if (!exists && sketch_ != nullptr && size_ + size > max_size_) {
+      const auto& victim = next_victim();
+      if (sketch_->frequency(hash_(key)) <=
+          sketch_->frequency(hash_(victim.key_)))
+        return Status::Ok();
+    }
+
+    if (admitted != nullptr)
+      *admitted = true;
+
     // Evict objects until there is room for `object`. Note that this
     // invalidates the state in `exists`.
-    while (size_ + size > max_size_)
+    while (size_ + size > max_size_) {
       evict();
+      if (evicted_num != nullptr)
+        ++(*evicted_num);
+    }
 
     // If an object associated with `key` still exists in the cache, replace it.
     // Otherwise, add a new entry in the cache.
@@ -174,13 +246,16 @@ class LRUCache {
 
       // Subtract the old size from `size_`.
       size_ -= item.size_;
+      if (item.protected_)
+        protected_size_ = protected_size_ - item.size_ + size;
 
       // Replace the object size in the cache item.
       item.size_ = size;
 
-      // Move cache item node to the end of the list
-      if (std::next(node) != item_ll_.end()) {
-        item_ll_.splice(item_ll_.end(), item_ll_, node, std::next(node));
+      // Move cache item node to the end of its list
+      auto& ll = item.protected_ ? protected_ll_ : item_ll_;
+      if (std::next(node) != ll.end()) {
+        ll.splice(ll.end(), ll, node, std::next(node));
       }
     } else {
       // Create new node in linked list
@@ -220,15 +295,47 @@ class LRUCache {
 
   /**
    * Touches the item associated with `key` to make it the most
-   * recently used item. The caller must be certain that an item
-   * exists for `key`.
+   * recently used item. With the segmented policies, an item in the
+   * probationary list moves to the protected list, and the least recently
+   * used protected items move back to the probationary list while the
+   * protected list is over its size. The caller must be certain that an
+   * item exists for `key`.
    *
    * @param key The item key.
    */
   void touch_item(const K& key) {
     auto& item = item_map_.at(key);
-    if (std::next(item) != item_ll_.end())
-      item_ll_.splice(item_ll_.end(), item_ll_, item, std::next(item));
+    if (policy_ == CachePolicy::LRU || item->protected_) {
+      auto& ll = item->protected_ ? protected_ll_ : item_ll_;
+      if (std::next(item) != ll.end())
+        ll.splice(ll.end(), ll, item, std::next(item));
+      return;
+    }
+
+    // Promote the item to the protected list.
+    protected_ll_.splice(protected_ll_.end(), item_ll_, item);
+    item->protected_ = true;
+    protected_size_ += item->size_;
+
+    // Demote the least recently used protected items.
+    while (protected_size_ > protected_max_size_ && protected_ll_.size() > 1) {
+      auto node = protected_ll_.begin();
+      node->protected_ = false;
+      protected_size_ -= node->size_;
+      item_ll_.splice(item_ll_.end(), protected_ll_, node);
+    }
+  }
+
+  /**
+   * Records an access to `key` in the frequency sketch of the TinyLFU
+   * policy, whether or not it is cached. This is a no-op for the other
+   * policies.
+   *
+   * @param key The item key.
+   */
+  void record_access(const K& key) {
+    if (sketch_ != nullptr)
+      sketch_->increment(hash_(key));
   }
 
   /**
@@ -249,9 +356,15 @@ class LRUCache {
       return Status::Ok();
     }
 
-    // Move item to the head of the list and evict it.
+    // Move item to the head of the probationary list and evict it.
     auto& node = item_it->second;
-    item_ll_.splice(item_ll_.begin(), item_ll_, node);
+    if (node->protected_) {
+      node->protected_ = false;
+      protected_size_ -= node->size_;
+      item_ll_.splice(item_ll_.begin(), protected_ll_, node);
+    } else {
+      item_ll_.splice(item_ll_.begin(), item_ll_, node);
+    }
     evict();
     *success = true;
 
@@ -261,7 +374,8 @@ class LRUCache {
   /**
    * Returns a constant iterator at the beginning of the linked list of
    * cached items, where items closest to the head (beginning) are going
-   * to be evicted from the cache sooner.
+   * to be evicted from the cache sooner. With the segmented policies, this
+   * is the probationary list.
    */
   typename std::list<LRUCacheItem>::const_iterator item_iter_begin() const {
     return item_ll_.cbegin();
@@ -290,10 +404,17 @@ class LRUCache {
 
   /**
    * Doubly-connected linked list of cache items. The head of the list is the
-   * next item to be evicted.
+   * next item to be evicted. With the segmented policies, this is the
+   * probationary list.
    */
   std::list<LRUCacheItem> item_ll_;
 
+  /**
+   * The protected list of the segmented policies, evicted from only when
+   * the probationary list is empty.
+   */
+  std::list<LRUCacheItem> protected_ll_;
+
   /** Maps a key label to an iterator (list node of) of `item_ll_`. */
   std::unordered_map<K, typename std::list<LRUCacheItem>::iterator> item_map_;
 
@@ -303,18 +424,45 @@ class LRUCache {
   /** The current cache size. */
   uint64_t size_;
 
+  /** The admission and eviction policy. */
+  const CachePolicy policy_;
+
+  /** The maximum size of the protected list. */
+  const uint64_t protected_max_size_;
+
+  /** The current size of the protected list. */
+  uint64_t protected_size_;
+
+  /** The number of counters per row of the TinyLFU frequency sketch. */
+  static constexpr uint64_t SKETCH_WIDTH = 16384;
+
+  /** The access frequency sketch of the TinyLFU policy. */
+  std::unique_ptr<FrequencySketch> sketch_;
+
+  /** The key hash function. */
+  std::hash<K> hash_;
+
   /* ********************************* */
   /*         PRIVATE ROUTINES          */
   /* ********************************* */
 
+  /** Returns the next object to be evicted. */
+  const LRUCacheItem& next_victim() const {
+    assert(!item_ll_.empty() || !protected_ll_.empty());
+    return item_ll_.empty() ? protected_ll_.front() : item_ll_.front();
+  }
+
   /** Evicts the next object. */
   void evict() {
-    assert(!item_ll_.empty());
+    assert(!item_ll_.empty() || !protected_ll_.empty());
 
-    auto& item = item_ll_.front();
+    auto& ll = item_ll_.empty() ? protected_ll_ : item_ll_;
+    auto& item = ll.front();
     item_map_.erase(item.key_);
     size_ -= item.size_;
-    item_ll_.pop_front();
+    if (item.protected_)
+      protected_size_ -= item.size_;
+    ll.pop_front();
   }
 };
 
@@ -0,0 +1,108 @@
+/**
+ * @file   sharded_buffer_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ShardedBufferLRUCache.
+ */
+
+#include "tiledb/sm/cache/sharded_buffer_lru_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+ShardedBufferLRUCache::ShardedBufferLRUCache(
+    const uint64_t max_size,
+    const uint64_t shard_num,
+    const CachePolicy policy) {
+  const uint64_t num = std::max<uint64_t>(shard_num, 1);
+  shards_.reserve(num);
+  for (uint64_t i = 0; i < num; i++) {
+    shards_.emplace_back(tdb_unique_ptr<BufferLRUCache>(
+        tdb_new(BufferLRUCache, max_size / num, policy)));
+  }
+}
+
+Status ShardedBufferLRUCache::insert(
+    const std::string& key,
+    FilteredBuffer&& buffer,
+    const bool overwrite,
+    uint64_t* const evicted_num,
+    bool* const admitted) {
+  return shard(key).insert(
+      key, std::move(buffer), overwrite, evicted_num, admitted);
+}
+
+Status ShardedBufferLRUCache::read(
+    const std::string& key,
+    void* const data,
+    const uint64_t offset,
+    const uint64_t nbytes,
+    bool* const success) {
+  return shard(key).read(key, data, offset, nbytes, success);
+}
+
+void ShardedBufferLRUCache::clear() {
+  for (auto& shard : shards_)
+    shard->clear();
+}
+
+uint64_t ShardedBufferLRUCache::size() {
+  uint64_t size = 0;
+  for (auto& shard : shards_)
+    size += shard->size();
+  return size;
+}
+
+uint64_t ShardedBufferLRUCache::shed(const uint64_t nbytes) {
+  uint64_t freed = 0;
+  for (auto& shard : shards_) {
+    if (freed >= nbytes)
+      break;
+    freed += shard->shed(nbytes - freed);
+  }
+  return freed;
+}
+
+uint64_t ShardedBufferLRUCache::shard_num() const {
+  return shards_.size();
+}
+
+BufferLRUCache& ShardedBufferLRUCache::shard(const std::string& key) {
+  if (shards_.size() == 1)
+    return *shards_[0];
+
+  return *shards_[std::hash<std::string>()(key) % shards_.size()];
+}
+
+}  // namespace sm
+}  // namespace tiledb
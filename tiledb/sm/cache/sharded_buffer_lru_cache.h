@@ -0,0 +1,161 @@
+/**
+ * @file   sharded_buffer_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ShardedBufferLRUCache.
+ */
+
+#ifndef TILEDB_SHARDED_BUFFER_LRU_CACHE_H
+#define TILEDB_SHARDED_BUFFER_LRU_CACHE_H
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/cache/buffer_lru_cache.h"
+
+#include <string>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Provides a least-recently used cache for `FilteredBuffer` objects mapped
+ * by a `std::string` key, split into shards that are locked independently.
+ * A key always maps to the same shard, chosen by its hash, and each shard is
+ * a `BufferLRUCache` holding an equal part of the maximum capacity. Objects
+ * are thus evicted per shard, not globally.
+ *
+ * This class is thread-safe.
+ */
+class ShardedBufferLRUCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum cache byte size, over all shards.
+   * @param shard_num The number of shards, at least 1.
+   * @param policy The admission and eviction policy of each shard.
+   */
+  ShardedBufferLRUCache(
+      uint64_t max_size,
+      uint64_t shard_num,
+      CachePolicy policy = CachePolicy::LRU);
+
+  /** Destructor. */
+  ~ShardedBufferLRUCache() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(ShardedBufferLRUCache);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(ShardedBufferLRUCache);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Inserts an object with a given key into the cache. Note that the cache
+   * *owns* the object after insertion.
+   *
+   * @param key The key that describes the inserted object.
+   * @param buffer The buffer to store.
+   * @param overwrite If `true`, if the object exists in the cache it will be
+   *     overwritten. Otherwise, the new object will be deleted.
+   * @param evicted_num If not `nullptr`, set to the number of objects
+   *     evicted to make room for `buffer`.
+   * @param admitted If not `nullptr`, set to `false` if the buffer was not
+   *     inserted because of its size or the admission policy.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key,
+      FilteredBuffer&& buffer,
+      bool overwrite = true,
+      uint64_t* evicted_num = nullptr,
+      bool* admitted = nullptr);
+
+  /**
+   * Reads a portion of the object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param data The memory that will store the data to be read.
+   * @param offset The offset where the read will start.
+   * @param nbytes The number of bytes to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(
+      const std::string& key,
+      void* data,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success);
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+  /** Returns the byte size of the cached buffers, over all shards. */
+  uint64_t size();
+
+  /**
+   * Evicts buffers until at least `nbytes` bytes are freed, or the cache is
+   * empty. The shards are shed in turn.
+   *
+   * @param nbytes The number of bytes to free.
+   * @return The number of bytes freed.
+   */
+  uint64_t shed(uint64_t nbytes);
+
+  /** Returns the number of shards. */
+  uint64_t shard_num() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The shards. */
+  std::vector<tdb_unique_ptr<BufferLRUCache>> shards_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the shard holding `key`. */
+  BufferLRUCache& shard(const std::string& key);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARDED_BUFFER_LRU_CACHE_H
@@ -0,0 +1,384 @@
+/**
+ * @file   shared_memory_tile_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class SharedMemoryTileCache.
+ */
+
+#include "tiledb/sm/cache/shared_memory_tile_cache.h"
+#include "tiledb/common/logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Identifies an initialized segment of this layout. */
+constexpr uint64_t SEGMENT_MAGIC = 0x544442534D544331ULL;
+
+/** The smallest supported segment size. */
+constexpr uint64_t MIN_SEGMENT_SIZE = 1024 * 1024;
+
+/** The segment bytes per index bucket. */
+constexpr uint64_t BYTES_PER_BUCKET = 4096;
+
+/** The number of buckets probed for a key. */
+constexpr uint64_t PROBE_NUM = 4;
+
+static_assert(
+    std::atomic<uint64_t>::is_always_lock_free,
+    "The shared memory tile cache requires lock-free 64-bit atomics");
+
+/** The header at the start of the segment. */
+struct SegmentHeader {
+  /** Set to `SEGMENT_MAGIC` once the rest of the header is initialized. */
+  std::atomic<uint64_t> magic;
+
+  /** The number of index buckets. */
+  uint64_t bucket_num;
+
+  /** The offset of the ring buffer in the segment. */
+  uint64_t ring_offset;
+
+  /** The size of the ring buffer. */
+  uint64_t ring_size;
+
+  /** The absolute position of the next record in the ring buffer. */
+  std::atomic<uint64_t> cursor;
+};
+
+/** An index bucket. */
+struct Bucket {
+  /** The key hash of the record. */
+  std::atomic<uint64_t> hash;
+
+  /** The absolute position of the record plus one, 0 if empty. */
+  std::atomic<uint64_t> pos;
+};
+
+/** The header of a record in the ring buffer, followed by key and data. */
+struct RecordHeader {
+  /** The key hash. */
+  uint64_t hash;
+
+  /** The key size. */
+  uint64_t key_size;
+
+  /** The data size. */
+  uint64_t data_size;
+
+  /** The checksum of the data. */
+  uint64_t checksum;
+};
+
+/** Returns a checksum of `nbytes` bytes. */
+uint64_t checksum(const void* data, uint64_t nbytes) {
+  const auto bytes = static_cast<const uint8_t*>(data);
+  uint64_t h = 0xCBF29CE484222325ULL ^ nbytes;
+  uint64_t i = 0;
+  for (; i + sizeof(uint64_t) <= nbytes; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(uint64_t));
+    h = (h ^ word) * 0x100000001B3ULL;
+    h ^= h >> 29;
+  }
+  for (; i < nbytes; i++)
+    h = (h ^ bytes[i]) * 0x100000001B3ULL;
+
+  return h;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+SharedMemoryTileCache::SharedMemoryTileCache()
+    : segment_(nullptr)
+    , size_(0) {
+}
+
+SharedMemoryTileCache::~SharedMemoryTileCache() {
+#ifndef _WIN32
+  if (segment_ != nullptr)
+    munmap(segment_, size_);
+#endif
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status SharedMemoryTileCache::init(const std::string& name, uint64_t size) {
+#ifdef _WIN32
+  (void)name;
+  (void)size;
+  return LOG_STATUS(Status_LRUCacheError(
+      "Cannot initialize shared memory tile cache; Not supported on Windows"));
+#else
+  assert(segment_ == nullptr);
+  const std::string shm_name =
+      name.empty() || name[0] != '/' ? "/" + name : name;
+
+  // Create the segment, or open it if another process created it.
+  bool created = true;
+  int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1 && errno == EEXIST) {
+    created = false;
+    fd = shm_open(shm_name.c_str(), O_RDWR, 0600);
+  }
+  if (fd == -1)
+    return LOG_STATUS(Status_LRUCacheError(
+        "Cannot initialize shared memory tile cache; Cannot open segment " +
+        shm_name + ": " + std::strerror(errno)));
+
+  if (created) {
+    if (size < MIN_SEGMENT_SIZE)
+      size = MIN_SEGMENT_SIZE;
+    if (ftruncate(fd, size) != 0) {
+      const int err = errno;
+      close(fd);
+      shm_unlink(shm_name.c_str());
+      return LOG_STATUS(Status_LRUCacheError(
+          "Cannot initialize shared memory tile cache; Cannot size segment " +
+          shm_name + ": " + std::strerror(err)));
+    }
+  } else {
+    // Wait for the creator to size the segment.
+    struct stat st;
+    st.st_size = 0;
+    for (int i = 0; i < 1000; i++) {
+      if (fstat(fd, &st) != 0 || st.st_size != 0)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (st.st_size < static_cast<off_t>(MIN_SEGMENT_SIZE)) {
+      close(fd);
+      return LOG_STATUS(Status_LRUCacheError(
+          "Cannot initialize shared memory tile cache; Invalid segment " +
+          shm_name));
+    }
+    size = st.st_size;
+  }
+
+  void* segment =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (segment == MAP_FAILED)
+    return LOG_STATUS(Status_LRUCacheError(
+        "Cannot initialize shared memory tile cache; Cannot map segment " +
+        shm_name + ": " + std::strerror(errno)));
+
+  auto header = static_cast<SegmentHeader*>(segment);
+  if (created) {
+    // The segment is zero-filled, so all buckets are empty.
+    header->bucket_num = std::max<uint64_t>(size / BYTES_PER_BUCKET, 1024);
+    const uint64_t index_end =
+        sizeof(SegmentHeader) + header->bucket_num * sizeof(Bucket);
+    header->ring_offset = (index_end + 63) / 64 * 64;
+    header->ring_size = size - header->ring_offset;
+    header->cursor.store(0, std::memory_order_relaxed);
+    header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+  } else {
+    // Wait for the creator to initialize the header.
+    for (int i = 0; i < 1000; i++) {
+      if (header->magic.load(std::memory_order_acquire) == SEGMENT_MAGIC)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (header->magic.load(std::memory_order_acquire) != SEGMENT_MAGIC ||
+        header->ring_offset >= size) {
+      munmap(segment, size);
+      return LOG_STATUS(Status_LRUCacheError(
+          "Cannot initialize shared memory tile cache; Invalid segment " +
+          shm_name));
+    }
+  }
+
+  segment_ = segment;
+  size_ = size;
+
+  return Status::Ok();
+#endif
+}
+
+Status SharedMemoryTileCache::insert(
+    const std::string& key, const void* data, uint64_t nbytes) {
+  if (segment_ == nullptr)
+    return Status::Ok();
+
+  auto header = static_cast<SegmentHeader*>(segment_);
+  const uint64_t record_size =
+      (sizeof(RecordHeader) + key.size() + nbytes + 7) / 8 * 8;
+  if (record_size > header->ring_size / 2)
+    return Status::Ok();
+
+  // Reserve and write the record.
+  RecordHeader record;
+  record.hash = std::hash<std::string>()(key);
+  record.key_size = key.size();
+  record.data_size = nbytes;
+  record.checksum = checksum(data, nbytes);
+  const uint64_t pos =
+      header->cursor.fetch_add(record_size, std::memory_order_acq_rel);
+  copy_to_ring(pos, &record, sizeof(RecordHeader));
+  copy_to_ring(pos + sizeof(RecordHeader), key.data(), key.size());
+  copy_to_ring(pos + sizeof(RecordHeader) + key.size(), data, nbytes);
+
+  // Publish the record in the bucket of the same key, else an empty or
+  // overwritten bucket, else the bucket of the oldest record.
+  auto buckets = reinterpret_cast<Bucket*>(
+      static_cast<char*>(segment_) + sizeof(SegmentHeader));
+  Bucket* target = nullptr;
+  uint64_t oldest_pos = UINT64_MAX;
+  for (uint64_t i = 0; i < PROBE_NUM; i++) {
+    auto& bucket = buckets[(record.hash + i) % header->bucket_num];
+    const uint64_t bucket_pos = bucket.pos.load(std::memory_order_acquire);
+    if (bucket_pos == 0 || overwritten(bucket_pos - 1) ||
+        bucket.hash.load(std::memory_order_relaxed) == record.hash) {
+      target = &bucket;
+      break;
+    }
+    if (bucket_pos < oldest_pos) {
+      oldest_pos = bucket_pos;
+      target = &bucket;
+    }
+  }
+
+  target->pos.store(0, std::memory_order_release);
+  target->hash.store(record.hash, std::memory_order_relaxed);
+  target->pos.store(pos + 1, std::memory_order_release);
+
+  return Status::Ok();
+}
+
+Status SharedMemoryTileCache::read(
+    const std::string& key,
+    void* data,
+    uint64_t nbytes,
+    bool* success) const {
+  assert(success);
+  *success = false;
+  if (segment_ == nullptr)
+    return Status::Ok();
+
+  auto header = static_cast<SegmentHeader*>(segment_);
+  auto buckets = reinterpret_cast<Bucket*>(
+      static_cast<char*>(segment_) + sizeof(SegmentHeader));
+  const uint64_t hash = std::hash<std::string>()(key);
+  std::string record_key;
+  for (uint64_t i = 0; i < PROBE_NUM; i++) {
+    auto& bucket = buckets[(hash + i) % header->bucket_num];
+    if (bucket.hash.load(std::memory_order_relaxed) != hash)
+      continue;
+    const uint64_t bucket_pos = bucket.pos.load(std::memory_order_acquire);
+    if (bucket_pos == 0 || overwritten(bucket_pos - 1))
+      continue;
+
+    // Check the record header and key.
+    const uint64_t pos = bucket_pos - 1;
+    RecordHeader record;
+    copy_from_ring(pos, &record, sizeof(RecordHeader));
+    if (record.hash != hash || record.key_size != key.size() ||
+        record.data_size != nbytes)
+      continue;
+    record_key.resize(record.key_size);
+    copy_from_ring(pos + sizeof(RecordHeader), &record_key[0], key.size());
+    if (record_key != key)
+      continue;
+
+    // Copy the data, then check that it was not overwritten meanwhile.
+    copy_from_ring(pos + sizeof(RecordHeader) + key.size(), data, nbytes);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (overwritten(pos) || checksum(data, nbytes) != record.checksum)
+      continue;
+
+    *success = true;
+    return Status::Ok();
+  }
+
+  return Status::Ok();
+}
+
+uint64_t SharedMemoryTileCache::size() const {
+  return size_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void SharedMemoryTileCache::copy_to_ring(
+    uint64_t pos, const void* src, uint64_t nbytes) const {
+  auto header = static_cast<SegmentHeader*>(segment_);
+  auto ring = static_cast<char*>(segment_) + header->ring_offset;
+  const uint64_t offset = pos % header->ring_size;
+  const uint64_t first = std::min(nbytes, header->ring_size - offset);
+  std::memcpy(ring + offset, src, first);
+  if (first < nbytes)
+    std::memcpy(ring, static_cast<const char*>(src) + first, nbytes - first);
+}
+
+void SharedMemoryTileCache::copy_from_ring(
+    uint64_t pos, void* dst, uint64_t nbytes) const {
+  auto header = static_cast<SegmentHeader*>(segment_);
+  auto ring = static_cast<const char*>(segment_) + header->ring_offset;
+  const uint64_t offset = pos % header->ring_size;
+  const uint64_t first = std::min(nbytes, header->ring_size - offset);
+  std::memcpy(dst, ring + offset, first);
+  if (first < nbytes)
+    std::memcpy(static_cast<char*>(dst) + first, ring, nbytes - first);
+}
+
+bool SharedMemoryTileCache::overwritten(uint64_t pos) const {
+  auto header = static_cast<SegmentHeader*>(segment_);
+  return header->cursor.load(std::memory_order_acquire) >
+         pos + header->ring_size;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,152 @@
+/**
+ * @file   shared_memory_tile_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class SharedMemoryTileCache.
+ */
+
+#ifndef TILEDB_SHARED_MEMORY_TILE_CACHE_H
+#define TILEDB_SHARED_MEMORY_TILE_CACHE_H
+
+#include "tiledb/common/macros.h"
+#include "tiledb/common/status.h"
+
+#include <string>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A tile cache stored in a named shared memory segment, so that all the
+ * processes of a host attaching to the same segment share it.
+ *
+ * The segment holds a hash index followed by a ring buffer of records, each
+ * holding a key and its data. Writers reserve space in the ring buffer with
+ * an atomic increment of its cursor, so the oldest records are overwritten
+ * first, then publish the record in the index with an atomic store. Readers
+ * take no lock: a record is only returned if the cursor shows that it was
+ * not overwritten while it was copied and if its checksum matches.
+ *
+ * Keys must identify immutable data, e.g. a fragment file and an offset in
+ * it, since an inserted record is never updated in place.
+ *
+ * The segment is not removed when the processes detach from it. It is only
+ * supported on POSIX systems.
+ *
+ * This class is thread-safe and process-safe.
+ */
+class SharedMemoryTileCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  SharedMemoryTileCache();
+
+  /** Destructor. Detaches from the segment. */
+  ~SharedMemoryTileCache();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(SharedMemoryTileCache);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(SharedMemoryTileCache);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Attaches to the shared memory segment `name`, creating it with `size`
+   * bytes if it does not exist. An existing segment keeps its size.
+   *
+   * @param name The segment name.
+   * @param size The segment size in bytes, if it is created.
+   * @return Status
+   */
+  Status init(const std::string& name, uint64_t size);
+
+  /**
+   * Inserts the data of an object with a given key. Objects larger than half
+   * of the ring buffer are not inserted.
+   *
+   * @param key The key that describes the inserted object.
+   * @param data The object data.
+   * @param nbytes The object size.
+   * @return Status
+   */
+  Status insert(const std::string& key, const void* data, uint64_t nbytes);
+
+  /**
+   * Reads the object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param data The memory that will store the object.
+   * @param nbytes The object size.
+   * @param success `true` if an object of `nbytes` bytes was read from the
+   *     cache and `false` otherwise.
+   * @return Status
+   */
+  Status read(
+      const std::string& key, void* data, uint64_t nbytes, bool* success) const;
+
+  /** Returns the size of the attached segment, 0 if not attached. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The mapped segment, `nullptr` if not attached. */
+  void* segment_;
+
+  /** The segment size. */
+  uint64_t size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Copies `nbytes` bytes to the ring buffer at absolute position `pos`. */
+  void copy_to_ring(uint64_t pos, const void* src, uint64_t nbytes) const;
+
+  /** Copies `nbytes` bytes from the ring buffer at absolute position `pos`. */
+  void copy_from_ring(uint64_t pos, void* dst, uint64_t nbytes) const;
+
+  /**
+   * Returns `true` if the ring buffer region starting at absolute position
+   * `pos` may have been overwritten.
+   */
+  bool overwritten(uint64_t pos) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARED_MEMORY_TILE_CACHE_H
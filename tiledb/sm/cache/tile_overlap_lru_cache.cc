@@ -0,0 +1,92 @@
+/**
+ * @file   tile_overlap_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileOverlapLRUCache.
+ */
+
+#include "tiledb/sm/cache/tile_overlap_lru_cache.h"
+
+#include <cassert>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+TileOverlapLRUCache::TileOverlapLRUCache(const uint64_t max_size)
+    : LRUCache(max_size) {
+}
+
+Status TileOverlapLRUCache::insert(
+    const std::string& key,
+    const SubarrayTileOverlap& tile_overlap,
+    const std::vector<unsigned>& relevant_fragments) {
+  auto object = tdb::make_shared<CachedTileOverlap>(HERE());
+  object->tile_overlap_ = tile_overlap;
+  object->relevant_fragments_ = relevant_fragments;
+  const uint64_t size = tile_overlap.byte_size() +
+                        relevant_fragments.size() * sizeof(unsigned) +
+                        key.size();
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+  return LRUCache<std::string, tdb_shared_ptr<CachedTileOverlap>>::insert(
+      key, std::move(object), size, false);
+}
+
+Status TileOverlapLRUCache::read(
+    const std::string& key,
+    SubarrayTileOverlap* const tile_overlap,
+    std::vector<unsigned>* const relevant_fragments,
+    bool* const success) {
+  assert(success);
+  *success = false;
+
+  tdb_shared_ptr<CachedTileOverlap> cached;
+  {
+    std::lock_guard<std::mutex> lg(lru_mtx_);
+
+    // Check if the cache contains the item at `key`.
+    if (!has_item(key))
+      return Status::Ok();
+
+    // Touch the item to make it the most recently used item.
+    cached = *get_item(key);
+    touch_item(key);
+  }
+
+  // The copy shares the `TileOverlap` instances with the cached object.
+  *tile_overlap = cached->tile_overlap_;
+  *relevant_fragments = cached->relevant_fragments_;
+
+  *success = true;
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
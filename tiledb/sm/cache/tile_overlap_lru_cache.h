@@ -0,0 +1,138 @@
+/**
+ * @file   tile_overlap_lru_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileOverlapLRUCache.
+ */
+
+#ifndef TILEDB_TILE_OVERLAP_LRU_CACHE_H
+#define TILEDB_TILE_OVERLAP_LRU_CACHE_H
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/subarray/subarray_tile_overlap.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * The result of `Subarray::precompute_tile_overlap`, as stored in the
+ * `TileOverlapLRUCache`.
+ */
+struct CachedTileOverlap {
+  /** The tile overlap of the subarray ranges with the fragments. */
+  SubarrayTileOverlap tile_overlap_;
+
+  /** The fragments relevant to the subarray ranges. */
+  std::vector<unsigned> relevant_fragments_;
+};
+
+/**
+ * Provides a least-recently used cache for the tile overlap computed for
+ * the ranges of a subarray, mapped by a key that describes the ranges (see
+ * `Subarray::tile_overlap_cache_key`). A cache is owned by an open array,
+ * which fixes the fragment set, and is dropped when the array is closed or
+ * reopened. The maximum capacity of the cache is defined as a total byte
+ * size among all objects, where the size of an object is the byte size of
+ * its tile overlap, relevant fragments and key.
+ *
+ * Cached tile overlaps are immutable. Readers receive copies that share
+ * the underlying `TileOverlap` instances.
+ *
+ * This class is thread-safe.
+ */
+class TileOverlapLRUCache
+    : public LRUCache<std::string, tdb_shared_ptr<CachedTileOverlap>> {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param size The maximum cache byte size.
+   */
+  TileOverlapLRUCache(uint64_t max_size);
+
+  /** Destructor. */
+  virtual ~TileOverlapLRUCache() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Inserts a tile overlap into the cache.
+   *
+   * @param key The key that describes the subarray ranges.
+   * @param tile_overlap The tile overlap of the ranges.
+   * @param relevant_fragments The fragments relevant to the ranges.
+   * @return Status
+   */
+  Status insert(
+      const std::string& key,
+      const SubarrayTileOverlap& tile_overlap,
+      const std::vector<unsigned>& relevant_fragments);
+
+  /**
+   * Retrieves the tile overlap labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param tile_overlap Set to a copy of the cached tile overlap.
+   * @param relevant_fragments Set to the cached relevant fragments.
+   * @param success `true` if the object was found in the cache and `false`
+   *     otherwise.
+   * @return Status
+   */
+  Status read(
+      const std::string& key,
+      SubarrayTileOverlap* tile_overlap,
+      std::vector<unsigned>* relevant_fragments,
+      bool* success);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  // Protects LRUCache routines.
+  mutable std::mutex lru_mtx_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_OVERLAP_LRU_CACHE_H
@@ -35,6 +35,10 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/enums/datatype.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 /* ****************************** */
 /*             MACROS             */
 /* ****************************** */
@@ -48,33 +52,48 @@ namespace sm {
 
 const uint64_t DoubleDelta::OVERHEAD = 17;
 
+const uint8_t DoubleDelta::BLOCK_MARKER = 0xFF;
+
+const uint64_t DoubleDelta::BLOCK_SIZE = 128;
+
 /* ****************************** */
 /*               API              */
 /* ****************************** */
 
 Status DoubleDelta::compress(
-    Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer) {
+    Datatype type,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer,
+    bool blocked) {
   switch (type) {
     case Datatype::BLOB:
-      return DoubleDelta::compress<std::byte>(input_buffer, output_buffer);
+      return DoubleDelta::compress<std::byte>(
+          input_buffer, output_buffer, blocked);
     case Datatype::INT8:
-      return DoubleDelta::compress<int8_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<int8_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::UINT8:
-      return DoubleDelta::compress<uint8_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<uint8_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::INT16:
-      return DoubleDelta::compress<int16_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<int16_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::UINT16:
-      return DoubleDelta::compress<uint16_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<uint16_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::INT32:
-      return DoubleDelta::compress<int>(input_buffer, output_buffer);
+      return DoubleDelta::compress<int>(input_buffer, output_buffer, blocked);
     case Datatype::UINT32:
-      return DoubleDelta::compress<uint32_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<uint32_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::INT64:
-      return DoubleDelta::compress<int64_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<int64_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::UINT64:
-      return DoubleDelta::compress<uint64_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<uint64_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::CHAR:
-      return DoubleDelta::compress<char>(input_buffer, output_buffer);
+      return DoubleDelta::compress<char>(input_buffer, output_buffer, blocked);
     case Datatype::DATETIME_YEAR:
     case Datatype::DATETIME_MONTH:
     case Datatype::DATETIME_WEEK:
@@ -97,7 +116,8 @@ Status DoubleDelta::compress(
     case Datatype::TIME_PS:
     case Datatype::TIME_FS:
     case Datatype::TIME_AS:
-      return DoubleDelta::compress<int64_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<int64_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::STRING_ASCII:
     case Datatype::STRING_UTF8:
     case Datatype::STRING_UTF16:
@@ -105,7 +125,8 @@ Status DoubleDelta::compress(
     case Datatype::STRING_UCS2:
     case Datatype::STRING_UCS4:
     case Datatype::ANY:
-      return DoubleDelta::compress<uint8_t>(input_buffer, output_buffer);
+      return DoubleDelta::compress<uint8_t>(
+          input_buffer, output_buffer, blocked);
     case Datatype::FLOAT32:
     case Datatype::FLOAT64:
       return LOG_STATUS(Status_CompressionError(
@@ -197,7 +218,11 @@ uint64_t DoubleDelta::overhead(uint64_t nbytes) {
 /* ****************************** */
 
 template <class T>
-Status DoubleDelta::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
+Status DoubleDelta::compress(
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked) {
+  if (blocked)
+    return compress_blocks<T>(input_buffer, output_buffer);
+
   // Calculate number of values and handle trivial case
   uint64_t value_size = sizeof(T);
   uint64_t num = input_buffer->size() / value_size;
@@ -249,6 +274,94 @@ Status DoubleDelta::compress(ConstBuffer* input_buffer, Buffer* output_buffer) {
   return Status::Ok();
 }
 
+template <class T>
+Status DoubleDelta::compress_blocks(
+    ConstBuffer* input_buffer, Buffer* output_buffer) {
+  uint64_t value_size = sizeof(T);
+  uint64_t num = input_buffer->size() / value_size;
+  assert(num > 0 && (input_buffer->size() % value_size == 0));
+  auto in = (const T*)input_buffer->data();
+
+  // Compute the bit width of every block and the total encoded size. The
+  // double deltas are computed with wrapping arithmetic, so unlike the
+  // bit-serial format no value is ever out of bounds.
+  uint64_t dd_num = num > 2 ? num - 2 : 0;
+  std::vector<uint8_t> widths((dd_num + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  uint64_t size = sizeof(uint8_t) + sizeof(uint64_t) +
+                  std::min<uint64_t>(num, 2) * value_size;
+  uint64_t zigzag[BLOCK_SIZE];
+  for (uint64_t b = 0; b < widths.size(); ++b) {
+    uint64_t first = 2 + b * BLOCK_SIZE;
+    uint64_t n = std::min(BLOCK_SIZE, num - first);
+    uint64_t bits = 0;
+    for (uint64_t j = 0; j < n; ++j)
+      bits |= zigzag_double_delta(in, first + j);
+    widths[b] = bit_width(bits);
+    size += sizeof(uint8_t) + (n * widths[b] + 63) / 64 * sizeof(uint64_t);
+  }
+
+  // Fall back to the uncompressed case of the bit-serial format, which
+  // every reader understands, if the blocks do not save any space.
+  if (size >= sizeof(uint8_t) + sizeof(uint64_t) + input_buffer->size()) {
+    auto bitsize_c = static_cast<uint8_t>(value_size * 8);
+    RETURN_NOT_OK(output_buffer->write(&bitsize_c, sizeof(uint8_t)));
+    RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
+    RETURN_NOT_OK(output_buffer->write(in, input_buffer->size()));
+    return Status::Ok();
+  }
+
+  // Write the marker, the number of values and the first two values
+  RETURN_NOT_OK(output_buffer->write(&BLOCK_MARKER, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_buffer->write(&num, sizeof(uint64_t)));
+  RETURN_NOT_OK(
+      output_buffer->write(in, std::min<uint64_t>(num, 2) * value_size));
+
+  // Pack every block of zigzag encoded double deltas with its own width
+  uint64_t words[BLOCK_SIZE];
+  for (uint64_t b = 0; b < widths.size(); ++b) {
+    uint64_t first = 2 + b * BLOCK_SIZE;
+    uint64_t n = std::min(BLOCK_SIZE, num - first);
+    unsigned width = widths[b];
+    for (uint64_t j = 0; j < n; ++j)
+      zigzag[j] = zigzag_double_delta(in, first + j);
+
+    uint64_t num_words = (n * width + 63) / 64;
+    std::memset(words, 0, num_words * sizeof(uint64_t));
+    for (uint64_t j = 0, bit = 0; j < n; ++j, bit += width) {
+      if (width == 0)
+        break;
+      uint64_t word = bit / 64, shift = bit % 64;
+      words[word] |= zigzag[j] << shift;
+      if (shift + width > 64)
+        words[word + 1] |= zigzag[j] >> (64 - shift);
+    }
+
+    RETURN_NOT_OK(output_buffer->write(&widths[b], sizeof(uint8_t)));
+    RETURN_NOT_OK(
+        output_buffer->write(words, num_words * sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+uint64_t DoubleDelta::zigzag_double_delta(const T* in, uint64_t i) {
+  auto cur_delta = uint64_t(int64_t(in[i])) - uint64_t(int64_t(in[i - 1]));
+  auto prev_delta =
+      uint64_t(int64_t(in[i - 1])) - uint64_t(int64_t(in[i - 2]));
+  auto dd = cur_delta - prev_delta;
+  return (dd << 1) ^ uint64_t(int64_t(dd) >> 63);
+}
+
+uint8_t DoubleDelta::bit_width(uint64_t value) {
+  uint8_t width = 0;
+  while (value) {
+    ++width;
+    value >>= 1;
+  }
+  return width;
+}
+
 template <class T>
 Status DoubleDelta::compute_bitsize(
     T* in, uint64_t num, unsigned int* bitsize) {
@@ -295,6 +408,10 @@ Status DoubleDelta::decompress(
   auto bitsize = static_cast<unsigned int>(bitsize_c);
   auto out = (T*)output_buffer->cur_data();
 
+  // Block format
+  if (bitsize_c == BLOCK_MARKER)
+    return decompress_blocks<T>(num, input_buffer, output_buffer);
+
   // Trivial case - no compression
   if (bitsize >= sizeof(T) * 8 - 1) {
     RETURN_NOT_OK(output_buffer->write(
@@ -332,6 +449,68 @@ Status DoubleDelta::decompress(
   return Status::Ok();
 }
 
+template <class T>
+Status DoubleDelta::decompress_blocks(
+    uint64_t num,
+    ConstBuffer* input_buffer,
+    PreallocatedBuffer* output_buffer) {
+  uint64_t value_size = sizeof(T);
+  if (num * value_size > output_buffer->free_space())
+    return LOG_STATUS(Status_CompressionError(
+        "Cannot decompress tile with DoubleDelta; Output buffer too small"));
+
+  // Read the first two values
+  T first_values[2];
+  auto num_first = std::min<uint64_t>(num, 2);
+  RETURN_NOT_OK(input_buffer->read(first_values, num_first * value_size));
+  RETURN_NOT_OK(output_buffer->write(first_values, num_first * value_size));
+  if (num <= 2)
+    return Status::Ok();
+
+  // Decode one block at a time. Unpacking a block is a fixed-width loop with
+  // no dependencies between values, and the two prefix sums that follow
+  // (double deltas to deltas, deltas to values) run over data in cache.
+  auto value = uint64_t(int64_t(first_values[1]));
+  uint64_t delta = value - uint64_t(int64_t(first_values[0]));
+  uint64_t words[BLOCK_SIZE + 1];
+  uint64_t dd[BLOCK_SIZE];
+  T values[BLOCK_SIZE];
+  for (uint64_t first = 2; first < num; first += BLOCK_SIZE) {
+    uint64_t n = std::min(BLOCK_SIZE, num - first);
+    uint8_t width;
+    RETURN_NOT_OK(input_buffer->read(&width, sizeof(uint8_t)));
+    if (width > 64)
+      return LOG_STATUS(Status_CompressionError(
+          "Cannot decompress tile with DoubleDelta; Invalid block bit width"));
+
+    uint64_t num_words = (n * width + 63) / 64;
+    RETURN_NOT_OK(input_buffer->read(words, num_words * sizeof(uint64_t)));
+    words[num_words] = 0;
+
+    // Unpack the zigzag encoded double deltas
+    uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    for (uint64_t j = 0; j < n; ++j) {
+      uint64_t bit = j * width, word = bit / 64, shift = bit % 64;
+      uint64_t v = words[word] >> shift;
+      if (shift != 0)
+        v |= words[word + 1] << (64 - shift);
+      v &= mask;
+      dd[j] = (v >> 1) ^ (~(v & 1) + 1);
+    }
+
+    // Reconstruct the values
+    for (uint64_t j = 0; j < n; ++j) {
+      delta += dd[j];
+      value += delta;
+      values[j] = (T)int64_t(value);
+    }
+
+    RETURN_NOT_OK(output_buffer->write(values, n * value_size));
+  }
+
+  return Status::Ok();
+}
+
 Status DoubleDelta::read_double_delta(
     ConstBuffer* buff,
     int64_t* double_delta,
@@ -431,23 +610,23 @@ Status DoubleDelta::write_double_delta(
 // Explicit template instantiations
 
 template Status DoubleDelta::compress<char>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<int8_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<uint8_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<int16_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<uint16_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<int>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<uint32_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<int64_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 template Status DoubleDelta::compress<uint64_t>(
-    ConstBuffer* input_buffer, Buffer* output_buffer);
+    ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
 
 template Status DoubleDelta::decompress<char>(
     ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer);
@@ -87,9 +87,29 @@ class DoubleDelta {
    *  overhead of 1 (bitsize) + 8 (n) + 8 (last, potentially almost empty chunk)
    *  bytes.
    *
+   * If *blocked* is `true`, the double deltas are instead written in the
+   * block format:
+   *
+   * 0xFF | n | in_0 | in_1 | block_0 | block_1 | ...
+   *
+   * where every block holds up to 128 double deltas as:
+   *
+   * width | zz(dd_i) ...
+   *
+   *  - *width* (uint8_t) is the number of bits of the largest zz(dd_i) in
+   *    the block.
+   *  - **zz(dd_i)** is the zigzag encoding of dd_i, computed with wrapping
+   *    64-bit arithmetic, packed LSB-first into *width* bits and padded to
+   *    whole 64-bit words.
+   *
+   * The block format decodes without per-bit branches. If it would not be
+   * smaller than the input, the uncompressed case above is written instead.
+   *
    * @param type The type of the input values.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the compressed data.
+   * @param blocked Whether to use the block format. Only readers of format
+   *     version 12 or later can decompress it.
    * @return Status
    *
    * @note The function will fail with an error in two cases: (i) the output
@@ -102,10 +122,14 @@ class DoubleDelta {
    *     extreme.
    */
   static Status compress(
-      Datatype type, ConstBuffer* input_buffer, Buffer* output_buffer);
+      Datatype type,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer,
+      bool blocked = false);
 
   /**
-   * Decompression function.
+   * Decompression function. Both the bit-serial and the block format are
+   * supported.
    *
    * @param type The type of the original decompressed values.
    * @param input_buffer Input buffer to read from.
@@ -121,13 +145,42 @@ class DoubleDelta {
   static uint64_t overhead(uint64_t nbytes);
 
  private:
+  /** The first byte of the block format, which is never a valid bitsize. */
+  static const uint8_t BLOCK_MARKER;
+
+  /** The number of double deltas in a block of the block format. */
+  static const uint64_t BLOCK_SIZE;
+
   /* ****************************** */
   /*         PRIVATE METHODS        */
   /* ****************************** */
 
   /** Templated version of *compress* on the type of buffer values. */
   template <class T>
-  static Status compress(ConstBuffer* input_buffer, Buffer* output_buffer);
+  static Status compress(
+      ConstBuffer* input_buffer, Buffer* output_buffer, bool blocked);
+
+  /**
+   * Compresses the input in the block format.
+   *
+   * @tparam The datatype of the values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  template <class T>
+  static Status compress_blocks(
+      ConstBuffer* input_buffer, Buffer* output_buffer);
+
+  /**
+   * Returns the zigzag encoded double delta of the i-th value (i >= 2),
+   * computed with wrapping 64-bit arithmetic.
+   */
+  template <class T>
+  static uint64_t zigzag_double_delta(const T* in, uint64_t i);
+
+  /** Returns the number of bits needed to represent the input value. */
+  static uint8_t bit_width(uint64_t value);
 
   /**
    * Calculates the bitsize all the double deltas will have. Note that
@@ -154,6 +207,22 @@ class DoubleDelta {
   static Status decompress(
       ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer);
 
+  /**
+   * Decompresses the blocks of the block format, after the marker and the
+   * number of values have been read.
+   *
+   * @tparam The datatype of the values.
+   * @param num The number of values.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  template <class T>
+  static Status decompress_blocks(
+      uint64_t num,
+      ConstBuffer* input_buffer,
+      PreallocatedBuffer* output_buffer);
+
   /**
    * Reads/reconstructs a double delta value from a compressed buffer.
    *
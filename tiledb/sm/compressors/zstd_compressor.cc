@@ -35,6 +35,9 @@
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/buffer/buffer.h"
 
+#include <zdict.h>
+
+#include <cstring>
 #include <iostream>
 
 using namespace tiledb::common;
@@ -47,6 +50,16 @@ Status ZStd::compress(
     shared_ptr<BlockingResourcePool<ZSTD_Compress_Context>> compress_ctx_pool,
     ConstBuffer* input_buffer,
     Buffer* output_buffer) {
+  return compress(
+      level, compress_ctx_pool, nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::compress(
+    int level,
+    shared_ptr<BlockingResourcePool<ZSTD_Compress_Context>> compress_ctx_pool,
+    const ZSTD_CDict* dictionary,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status_CompressionError(
@@ -61,13 +74,22 @@ Status ZStd::compress(
   auto& context = context_guard.get();
 
   // Compress
-  uint64_t zstd_ret = ZSTD_compressCCtx(
-      context.ptr(),
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size(),
-      level < level_limit_ ? ZStd::default_level() : level);
+  uint64_t zstd_ret =
+      dictionary == nullptr ?
+          ZSTD_compressCCtx(
+              context.ptr(),
+              output_buffer->cur_data(),
+              output_buffer->free_space(),
+              input_buffer->data(),
+              input_buffer->size(),
+              level < level_limit_ ? ZStd::default_level() : level) :
+          ZSTD_compress_usingCDict(
+              context.ptr(),
+              output_buffer->cur_data(),
+              output_buffer->free_space(),
+              input_buffer->data(),
+              input_buffer->size(),
+              dictionary);
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -88,6 +110,16 @@ Status ZStd::decompress(
         decompress_ctx_pool,
     ConstBuffer* input_buffer,
     PreallocatedBuffer* output_buffer) {
+  return decompress(
+      decompress_ctx_pool, nullptr, input_buffer, output_buffer);
+}
+
+Status ZStd::decompress(
+    shared_ptr<BlockingResourcePool<ZSTD_Decompress_Context>>
+        decompress_ctx_pool,
+    const ZSTD_DDict* dictionary,
+    ConstBuffer* input_buffer,
+    PreallocatedBuffer* output_buffer) {
   // Sanity check
   if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
     return LOG_STATUS(Status_CompressionError(
@@ -102,12 +134,20 @@ Status ZStd::decompress(
   auto& context = context_guard.get();
 
   // Decompress
-  uint64_t zstd_ret = ZSTD_decompressDCtx(
-      context.ptr(),
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size());
+  uint64_t zstd_ret =
+      dictionary == nullptr ? ZSTD_decompressDCtx(
+                                  context.ptr(),
+                                  output_buffer->cur_data(),
+                                  output_buffer->free_space(),
+                                  input_buffer->data(),
+                                  input_buffer->size()) :
+                              ZSTD_decompress_usingDDict(
+                                  context.ptr(),
+                                  output_buffer->cur_data(),
+                                  output_buffer->free_space(),
+                                  input_buffer->data(),
+                                  input_buffer->size(),
+                                  dictionary);
 
   // Check error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -122,6 +162,64 @@ Status ZStd::decompress(
   return Status::Ok();
 }
 
+Status ZStd::train_dictionary(
+    const std::vector<ConstBuffer>& samples,
+    uint64_t max_size,
+    std::vector<uint8_t>* dictionary) {
+  if (samples.empty() || max_size == 0)
+    return LOG_STATUS(Status_CompressionError(
+        "Failed training ZStd dictionary; no samples or empty dictionary"));
+
+  // The samples must be contiguous.
+  std::vector<size_t> sample_sizes;
+  sample_sizes.reserve(samples.size());
+  uint64_t total_size = 0;
+  for (const auto& sample : samples) {
+    sample_sizes.push_back(sample.size());
+    total_size += sample.size();
+  }
+  std::vector<uint8_t> sample_data(total_size);
+  uint64_t offset = 0;
+  for (const auto& sample : samples) {
+    if (sample.size() > 0)
+      std::memcpy(&sample_data[offset], sample.data(), sample.size());
+    offset += sample.size();
+  }
+
+  dictionary->resize(max_size);
+  size_t zstd_ret = ZDICT_trainFromBuffer(
+      dictionary->data(),
+      dictionary->size(),
+      sample_data.data(),
+      sample_sizes.data(),
+      static_cast<unsigned>(sample_sizes.size()));
+  if (ZDICT_isError(zstd_ret) != 0) {
+    dictionary->clear();
+    const char* msg = ZDICT_getErrorName(zstd_ret);
+    return LOG_STATUS(Status_CompressionError(
+        std::string("ZStd dictionary training failed: ") + msg));
+  }
+  dictionary->resize(zstd_ret);
+
+  return Status::Ok();
+}
+
+ZStd::CompressionDictionary ZStd::create_compression_dictionary(
+    const std::vector<uint8_t>& dictionary, int level) {
+  return CompressionDictionary(
+      ZSTD_createCDict(
+          dictionary.data(),
+          dictionary.size(),
+          level < level_limit_ ? ZStd::default_level() : level),
+      ZSTD_freeCDict);
+}
+
+ZStd::DecompressionDictionary ZStd::create_decompression_dictionary(
+    const std::vector<uint8_t>& dictionary) {
+  return DecompressionDictionary(
+      ZSTD_createDDict(dictionary.data(), dictionary.size()), ZSTD_freeDDict);
+}
+
 uint64_t ZStd::overhead(uint64_t nbytes) {
   return ZSTD_compressBound(nbytes) - nbytes;
 }
@@ -40,6 +40,8 @@
 
 #include <zstd.h>
 
+#include <vector>
+
 using namespace tiledb::common;
 
 namespace tiledb {
@@ -84,6 +86,14 @@ class ZStd {
     std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx_;
   };
 
+  /** A digested dictionary for compression. */
+  typedef std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>
+      CompressionDictionary;
+
+  /** A digested dictionary for decompression. */
+  typedef std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>
+      DecompressionDictionary;
+
   /**
    * Compression function.
    *
@@ -99,6 +109,24 @@ class ZStd {
       ConstBuffer* input_buffer,
       Buffer* output_buffer);
 
+  /**
+   * Compression function with a dictionary.
+   *
+   * @param level Compression level.
+   * @param compress_ctx_pool Resource pool to manage compression context reuse
+   * @param dictionary Digested dictionary to compress with, or `nullptr` to
+   *     compress without a dictionary. Its level overrides `level`.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      int level,
+      shared_ptr<BlockingResourcePool<ZSTD_Compress_Context>> compress_ctx_pool,
+      const ZSTD_CDict* dictionary,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /**
    * Overloaded compression function with default compression level.
    *
@@ -123,6 +151,58 @@ class ZStd {
       ConstBuffer* input_buffer,
       PreallocatedBuffer* output_buffer);
 
+  /**
+   * Decompression function with a dictionary.
+   *
+   * @param decompress_ctx_pool Resource pool to manage decompression context
+   * reuse
+   * @param dictionary Digested dictionary the input was compressed with, or
+   *     `nullptr` if it was compressed without a dictionary.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      shared_ptr<BlockingResourcePool<ZSTD_Decompress_Context>>
+          decompress_ctx_pool,
+      const ZSTD_DDict* dictionary,
+      ConstBuffer* input_buffer,
+      PreallocatedBuffer* output_buffer);
+
+  /**
+   * Trains a dictionary on the given samples. Dictionaries help the
+   * compression of small inputs that are similar to the samples, which
+   * otherwise start with an empty context.
+   *
+   * @param samples The samples to train on, typically tiles or chunks.
+   * @param max_size Maximum size in bytes of the dictionary.
+   * @param dictionary Set to the trained dictionary.
+   * @return Status
+   */
+  static Status train_dictionary(
+      const std::vector<ConstBuffer>& samples,
+      uint64_t max_size,
+      std::vector<uint8_t>* dictionary);
+
+  /**
+   * Digests a dictionary for compression at the given level.
+   *
+   * @param dictionary The dictionary.
+   * @param level Compression level.
+   * @return The digested dictionary, `nullptr` on error.
+   */
+  static CompressionDictionary create_compression_dictionary(
+      const std::vector<uint8_t>& dictionary, int level);
+
+  /**
+   * Digests a dictionary for decompression.
+   *
+   * @param dictionary The dictionary.
+   * @return The digested dictionary, `nullptr` on error.
+   */
+  static DecompressionDictionary create_decompression_dictionary(
+      const std::vector<uint8_t>& dictionary);
+
   /** Returns the default compression level. */
   static int default_level() {
     return default_level_;
@@ -32,6 +32,9 @@
 
 #include "config.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/enums/cache_policy.h"
+#include "tiledb/sm/enums/huge_page_mode.h"
 #include "tiledb/sm/enums/serialization_type.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/parse_argument.h"
@@ -64,14 +67,38 @@ const std::string Config::REST_RETRY_HTTP_CODES = "503";
 const std::string Config::REST_RETRY_COUNT = "25";
 const std::string Config::REST_RETRY_INITIAL_DELAY_MS = "500";
 const std::string Config::REST_RETRY_DELAY_FACTOR = "1.25";
+const std::string Config::REST_SHARE_CONNECTIONS = "true";
+const std::string Config::REST_HTTP2 = "true";
+const std::string Config::REST_REQUEST_COMPRESSOR = "none";
+const std::string Config::REST_REQUEST_COMPRESSION_MIN_SIZE = "1048576";
+const std::string Config::REST_PREFETCH_INCOMPLETE = "false";
+const std::string Config::REST_SUBMIT_ARRAY_STATE = "true";
+const std::string Config::REST_PIPELINE_ARRAY_OPEN = "false";
 const std::string Config::SM_ENCRYPTION_KEY = "";
 const std::string Config::SM_ENCRYPTION_TYPE = "NO_ENCRYPTION";
 const std::string Config::SM_DEDUP_COORDS = "false";
+const std::string Config::SM_DEDUP_COORDS_METHOD = "sort";
+const std::string Config::SM_COORDS_BLOOM_FILTER_BITS_PER_CELL = "0";
+const std::string Config::SM_ATTRIBUTE_INDEX_NAMES = "";
+const std::string Config::SM_PACKED_FRAGMENT_MAX_SIZE = "0";
 const std::string Config::SM_CHECK_COORD_DUPS = "true";
 const std::string Config::SM_CHECK_COORD_OOB = "true";
 const std::string Config::SM_READ_RANGE_OOB = "warn";
 const std::string Config::SM_CHECK_GLOBAL_ORDER = "true";
 const std::string Config::SM_TILE_CACHE_SIZE = "10000000";
+const std::string Config::SM_TILE_CACHE_SHARD_NUM = "1";
+const std::string Config::SM_TILE_CACHE_UNFILTERED_SIZE = "0";
+const std::string Config::SM_TILE_CACHE_POLICY = "lru";
+const std::string Config::SM_TILE_CACHE_SHARED_MEMORY_NAME = "";
+const std::string Config::SM_LISTING_CACHE_TTL_MS = "0";
+const std::string Config::SM_FRAGMENT_LISTING_SHARDS = "1";
+const std::string Config::SM_FRAGMENT_METADATA_CACHE_SIZE = "0";
+const std::string Config::SM_ARRAY_SCHEMA_CACHE_SIZE = "10000000";
+const std::string Config::SM_ARRAY_SNAPSHOT_CACHE_SIZE = "0";
+const std::string Config::SM_TILE_OVERLAP_CACHE_SIZE = "10000000";
+const std::string Config::SM_PARTITIONER_TARGET_COST = "0";
+const std::string Config::SM_PARTITIONER_IO_COST_PER_BYTE = "1.0";
+const std::string Config::SM_PARTITIONER_CPU_COST_PER_BYTE = "0.0";
 const std::string Config::SM_SKIP_EST_SIZE_PARTITIONING = "false";
 const std::string Config::SM_MEMORY_BUDGET = "5368709120";       // 5GB
 const std::string Config::SM_MEMORY_BUDGET_VAR = "10737418240";  // 10GB;
@@ -79,7 +106,22 @@ const std::string Config::SM_QUERY_DENSE_READER = "refactored";
 const std::string Config::SM_QUERY_SPARSE_GLOBAL_ORDER_READER = "legacy";
 const std::string Config::SM_QUERY_SPARSE_UNORDERED_WITH_DUPS_READER =
     "refactored";
+const std::string Config::SM_QUERY_PRIORITY = "normal";
+const std::string Config::SM_QUERY_SHARED_SCAN = "true";
+const std::string Config::SM_QUERY_TIMEOUT_MS = "0";
+const std::string Config::SM_ASYNC_QUERY_MAX_CONCURRENT = "0";
+const std::string Config::SM_ASYNC_QUERY_TAG = "";
+const std::string Config::SM_QUERY_SPARSE_UNORDERED_NO_DUPS_READER = "legacy";
+const std::string Config::SM_QUERY_DENSE_STREAMING_WRITE = "false";
+const std::string Config::SM_QUERY_DENSE_ELIDE_FILL_TILES = "true";
 const std::string Config::SM_MEM_MALLOC_TRIM = "true";
+const std::string Config::SM_MEM_TILE_BUFFER_POOL_SIZE = "0";
+const std::string Config::SM_MEM_LARGE_BUFFER_HUGE_PAGES = "none";
+const std::string Config::SM_MEM_LARGE_BUFFER_NUMA_LOCAL = "false";
+const std::string Config::SM_MEM_LARGE_BUFFER_THRESHOLD = "4194304";
+const std::string Config::SM_MEM_GOVERNOR_ENABLED = "false";
+const std::string Config::SM_MEM_GOVERNOR_MIN_RATIO = "0.25";
+const std::string Config::SM_MEM_GOVERNOR_TIMEOUT_MS = "10000";
 const std::string Config::SM_MEM_TOTAL_BUDGET = "10737418240";  // 10GB;
 const std::string Config::SM_MEM_SPARSE_GLOBAL_ORDER_RATIO_COORDS = "0.5";
 const std::string Config::SM_MEM_SPARSE_GLOBAL_ORDER_RATIO_QUERY_CONDITION =
@@ -94,14 +136,33 @@ const std::string Config::SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_TILE_RANGES =
     "0.1";
 const std::string Config::SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_ARRAY_DATA =
     "0.1";
+const std::string Config::SM_MEM_GLOBAL_ORDER_WRITER_MAX_IN_FLIGHT_BYTES = "0";
+const std::string Config::SM_MEM_GLOBAL_ORDER_WRITER_BUDGET = "0";
+const std::string Config::SM_MEM_WRITER_UNORDERED_SPILL_BUDGET = "0";
+const std::string Config::SM_MEM_WRITER_UNORDERED_SPILL_PATH = "";
 const std::string Config::SM_ENABLE_SIGNAL_HANDLERS = "true";
 const std::string Config::SM_COMPUTE_CONCURRENCY_LEVEL =
     utils::parse::to_str(std::thread::hardware_concurrency());
 const std::string Config::SM_IO_CONCURRENCY_LEVEL =
     utils::parse::to_str(std::thread::hardware_concurrency());
+const std::string Config::SM_COMPUTE_AFFINITY = "";
+const std::string Config::SM_IO_AFFINITY = "";
+const std::string Config::SM_SHARED_RESOURCES = "false";
+const std::string Config::SM_THREAD_POOL_STATS = "false";
 const std::string Config::SM_SKIP_CHECKSUM_VALIDATION = "false";
 const std::string Config::SM_CONSOLIDATION_AMPLIFICATION = "1.0";
 const std::string Config::SM_CONSOLIDATION_BUFFER_SIZE = "50000000";
+const std::string Config::SM_CONSOLIDATION_TOTAL_BUFFER_SIZE = "0";
+const std::string Config::SM_CONSOLIDATION_MAX_IN_FLIGHT_BYTES = "0";
+const std::string Config::SM_CONSOLIDATION_TILE_COPY = "false";
+const std::string Config::SM_CONSOLIDATION_CONCURRENT_BUDGET = "0";
+const std::string Config::SM_CONSOLIDATION_POLICY = "size_ratio";
+const std::string Config::SM_CONSOLIDATION_TIER_FANOUT = "4";
+const std::string Config::SM_CONSOLIDATION_TIER_BASE_SIZE = "1048576";
+const std::string Config::SM_CONSOLIDATION_AUTO_FRAGMENT_NUM = "0";
+const std::string Config::SM_CONSOLIDATION_AUTO_MIN_INTERVAL_MS = "1000";
+const std::string Config::SM_CONSOLIDATION_FRAGMENT_META_MAX_DELTAS = "0";
+const std::string Config::SM_CONSOLIDATION_ARRAY_META_MAX_DELTAS = "0";
 const std::string Config::SM_CONSOLIDATION_STEPS = "4294967295";
 const std::string Config::SM_CONSOLIDATION_STEP_MIN_FRAGS = "4294967295";
 const std::string Config::SM_CONSOLIDATION_STEP_MAX_FRAGS = "4294967295";
@@ -110,6 +171,7 @@ const std::string Config::SM_CONSOLIDATION_MODE = "fragments";
 const std::string Config::SM_CONSOLIDATION_TIMESTAMP_START = "0";
 const std::string Config::SM_CONSOLIDATION_TIMESTAMP_END =
     std::to_string(UINT64_MAX);
+const std::string Config::SM_CONSOLIDATION_PRIORITY = "background";
 const std::string Config::SM_VACUUM_MODE = "fragments";
 const std::string Config::SM_VACUUM_TIMESTAMP_START = "0";
 const std::string Config::SM_VACUUM_TIMESTAMP_END = std::to_string(UINT64_MAX);
@@ -119,11 +181,19 @@ const std::string Config::SM_OFFSETS_FORMAT_MODE = "bytes";
 const std::string Config::SM_MAX_TILE_OVERLAP_SIZE = "314572800";  // 300MiB
 const std::string Config::VFS_MIN_PARALLEL_SIZE = "10485760";
 const std::string Config::VFS_MIN_BATCH_GAP = "512000";
+const std::string Config::VFS_ADAPTIVE_BATCH_GAP = "false";
+const std::string Config::VFS_DISK_CACHE_PATH = "";
+const std::string Config::VFS_DISK_CACHE_MAX_SIZE = "10737418240";
 const std::string Config::VFS_MIN_BATCH_SIZE = "20971520";
 const std::string Config::VFS_FILE_POSIX_FILE_PERMISSIONS = "644";
 const std::string Config::VFS_FILE_POSIX_DIRECTORY_PERMISSIONS = "755";
 const std::string Config::VFS_FILE_MAX_PARALLEL_OPS =
     Config::SM_IO_CONCURRENCY_LEVEL;
+const std::string Config::VFS_FILE_IO_URING = "false";
+const std::string Config::VFS_FILE_OVERLAPPED_IO = "false";
+const std::string Config::VFS_FILE_DIRECT_IO = "false";
+const std::string Config::VFS_FILE_MMAP = "false";
+const std::string Config::VFS_FILE_GROUP_COMMIT = "false";
 const std::string Config::VFS_READ_AHEAD_SIZE = "102400";          // 100KiB
 const std::string Config::VFS_READ_AHEAD_CACHE_SIZE = "10485760";  // 10MiB;
 const std::string Config::VFS_AZURE_STORAGE_ACCOUNT_NAME = "";
@@ -133,11 +203,13 @@ const std::string Config::VFS_AZURE_BLOB_ENDPOINT = "";
 const std::string Config::VFS_AZURE_USE_HTTPS = "true";
 const std::string Config::VFS_AZURE_MAX_PARALLEL_OPS =
     Config::SM_IO_CONCURRENCY_LEVEL;
+const std::string Config::VFS_AZURE_READ_PART_SIZE = "0";
 const std::string Config::VFS_AZURE_BLOCK_LIST_BLOCK_SIZE = "5242880";
 const std::string Config::VFS_AZURE_USE_BLOCK_LIST_UPLOAD = "true";
 const std::string Config::VFS_GCS_PROJECT_ID = "";
 const std::string Config::VFS_GCS_MAX_PARALLEL_OPS =
     Config::SM_IO_CONCURRENCY_LEVEL;
+const std::string Config::VFS_GCS_READ_PART_SIZE = "0";
 const std::string Config::VFS_GCS_MULTI_PART_SIZE = "5242880";
 const std::string Config::VFS_GCS_USE_MULTI_PART_UPLOAD = "true";
 const std::string Config::VFS_GCS_REQUEST_TIMEOUT_MS = "3000";
@@ -157,6 +229,7 @@ const std::string Config::VFS_S3_USE_MULTIPART_UPLOAD = "true";
 const std::string Config::VFS_S3_MAX_PARALLEL_OPS =
     Config::SM_IO_CONCURRENCY_LEVEL;
 const std::string Config::VFS_S3_MULTIPART_PART_SIZE = "5242880";
+const std::string Config::VFS_S3_READ_PART_SIZE = "0";
 const std::string Config::VFS_S3_CA_FILE = "";
 const std::string Config::VFS_S3_CA_PATH = "";
 const std::string Config::VFS_S3_CONNECT_TIMEOUT_MS = "10800";
@@ -165,6 +238,8 @@ const std::string Config::VFS_S3_CONNECT_SCALE_FACTOR = "25";
 const std::string Config::VFS_S3_SSE = "";
 const std::string Config::VFS_S3_SSE_KMS_KEY_ID = "";
 const std::string Config::VFS_S3_REQUEST_TIMEOUT_MS = "3000";
+const std::string Config::VFS_S3_HEDGE_PERCENTILE = "0";
+const std::string Config::VFS_S3_HEDGE_MAX_RATIO = "0.05";
 const std::string Config::VFS_S3_REQUESTER_PAYS = "false";
 const std::string Config::VFS_S3_PROXY_SCHEME = "http";
 const std::string Config::VFS_S3_PROXY_HOST = "";
@@ -176,6 +251,8 @@ const std::string Config::VFS_S3_VERIFY_SSL = "true";
 const std::string Config::VFS_S3_BUCKET_CANNED_ACL = "NOT_SET";
 const std::string Config::VFS_S3_OBJECT_CANNED_ACL = "NOT_SET";
 const std::string Config::VFS_HDFS_KERB_TICKET_CACHE_PATH = "";
+const std::string Config::VFS_HDFS_SHORT_CIRCUIT_READS = "false";
+const std::string Config::VFS_HDFS_DOMAIN_SOCKET_PATH = "";
 const std::string Config::VFS_HDFS_NAME_NODE_URI = "";
 const std::string Config::VFS_HDFS_USERNAME = "";
 /* ****************************** */
@@ -216,17 +293,48 @@ Config::Config() {
   param_values_["rest.retry_count"] = REST_RETRY_COUNT;
   param_values_["rest.retry_initial_delay_ms"] = REST_RETRY_INITIAL_DELAY_MS;
   param_values_["rest.retry_delay_factor"] = REST_RETRY_DELAY_FACTOR;
+  param_values_["rest.share_connections"] = REST_SHARE_CONNECTIONS;
+  param_values_["rest.http2"] = REST_HTTP2;
+  param_values_["rest.request_compressor"] = REST_REQUEST_COMPRESSOR;
+  param_values_["rest.request_compression_min_size"] =
+      REST_REQUEST_COMPRESSION_MIN_SIZE;
+  param_values_["rest.prefetch_incomplete"] = REST_PREFETCH_INCOMPLETE;
+  param_values_["rest.submit_array_state"] = REST_SUBMIT_ARRAY_STATE;
+  param_values_["rest.pipeline_array_open"] = REST_PIPELINE_ARRAY_OPEN;
   param_values_["config.env_var_prefix"] = CONFIG_ENVIRONMENT_VARIABLE_PREFIX;
   param_values_["config.logging_level"] = CONFIG_LOGGING_LEVEL;
   param_values_["config.logging_format"] = CONFIG_LOGGING_DEFAULT_FORMAT;
   param_values_["sm.encryption_key"] = SM_ENCRYPTION_KEY;
   param_values_["sm.encryption_type"] = SM_ENCRYPTION_TYPE;
   param_values_["sm.dedup_coords"] = SM_DEDUP_COORDS;
+  param_values_["sm.dedup_coords_method"] = SM_DEDUP_COORDS_METHOD;
+  param_values_["sm.coords_bloom_filter_bits_per_cell"] =
+      SM_COORDS_BLOOM_FILTER_BITS_PER_CELL;
+  param_values_["sm.attribute_index_names"] = SM_ATTRIBUTE_INDEX_NAMES;
+  param_values_["sm.packed_fragment_max_size"] = SM_PACKED_FRAGMENT_MAX_SIZE;
   param_values_["sm.check_coord_dups"] = SM_CHECK_COORD_DUPS;
   param_values_["sm.check_coord_oob"] = SM_CHECK_COORD_OOB;
   param_values_["sm.read_range_oob"] = SM_READ_RANGE_OOB;
   param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  param_values_["sm.tile_cache_shard_num"] = SM_TILE_CACHE_SHARD_NUM;
+  param_values_["sm.tile_cache_unfiltered_size"] =
+      SM_TILE_CACHE_UNFILTERED_SIZE;
+  param_values_["sm.tile_cache_policy"] = SM_TILE_CACHE_POLICY;
+  param_values_["sm.tile_cache_shared_memory_name"] =
+      SM_TILE_CACHE_SHARED_MEMORY_NAME;
+  param_values_["sm.listing_cache_ttl_ms"] = SM_LISTING_CACHE_TTL_MS;
+  param_values_["sm.fragment_listing_shards"] = SM_FRAGMENT_LISTING_SHARDS;
+  param_values_["sm.fragment_metadata_cache_size"] =
+      SM_FRAGMENT_METADATA_CACHE_SIZE;
+  param_values_["sm.array_schema_cache_size"] = SM_ARRAY_SCHEMA_CACHE_SIZE;
+  param_values_["sm.array_snapshot_cache_size"] = SM_ARRAY_SNAPSHOT_CACHE_SIZE;
+  param_values_["sm.tile_overlap_cache_size"] = SM_TILE_OVERLAP_CACHE_SIZE;
+  param_values_["sm.partitioner.target_cost"] = SM_PARTITIONER_TARGET_COST;
+  param_values_["sm.partitioner.io_cost_per_byte"] =
+      SM_PARTITIONER_IO_COST_PER_BYTE;
+  param_values_["sm.partitioner.cpu_cost_per_byte"] =
+      SM_PARTITIONER_CPU_COST_PER_BYTE;
   param_values_["sm.skip_est_size_partitioning"] =
       SM_SKIP_EST_SIZE_PARTITIONING;
   param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
@@ -236,7 +344,29 @@ Config::Config() {
       SM_QUERY_SPARSE_GLOBAL_ORDER_READER;
   param_values_["sm.query.sparse_unordered_with_dups.reader"] =
       SM_QUERY_SPARSE_UNORDERED_WITH_DUPS_READER;
+  param_values_["sm.query.priority"] = SM_QUERY_PRIORITY;
+  param_values_["sm.query.shared_scan"] = SM_QUERY_SHARED_SCAN;
+  param_values_["sm.query.timeout_ms"] = SM_QUERY_TIMEOUT_MS;
+  param_values_["sm.async_query.max_concurrent"] =
+      SM_ASYNC_QUERY_MAX_CONCURRENT;
+  param_values_["sm.async_query.tag"] = SM_ASYNC_QUERY_TAG;
+  param_values_["sm.query.sparse_unordered_no_dups.reader"] =
+      SM_QUERY_SPARSE_UNORDERED_NO_DUPS_READER;
+  param_values_["sm.query.dense.streaming_write"] =
+      SM_QUERY_DENSE_STREAMING_WRITE;
+  param_values_["sm.query.dense.elide_fill_tiles"] =
+      SM_QUERY_DENSE_ELIDE_FILL_TILES;
   param_values_["sm.mem.malloc_trim"] = SM_MEM_MALLOC_TRIM;
+  param_values_["sm.mem.tile_buffer_pool_size"] = SM_MEM_TILE_BUFFER_POOL_SIZE;
+  param_values_["sm.mem.large_buffer.huge_pages"] =
+      SM_MEM_LARGE_BUFFER_HUGE_PAGES;
+  param_values_["sm.mem.large_buffer.numa_local"] =
+      SM_MEM_LARGE_BUFFER_NUMA_LOCAL;
+  param_values_["sm.mem.large_buffer.threshold"] =
+      SM_MEM_LARGE_BUFFER_THRESHOLD;
+  param_values_["sm.mem.governor.enabled"] = SM_MEM_GOVERNOR_ENABLED;
+  param_values_["sm.mem.governor.min_ratio"] = SM_MEM_GOVERNOR_MIN_RATIO;
+  param_values_["sm.mem.governor.timeout_ms"] = SM_MEM_GOVERNOR_TIMEOUT_MS;
   param_values_["sm.mem.total_budget"] = SM_MEM_TOTAL_BUDGET;
   param_values_["sm.mem.reader.sparse_global_order.ratio_coords"] =
       SM_MEM_SPARSE_GLOBAL_ORDER_RATIO_COORDS;
@@ -255,13 +385,44 @@ Config::Config() {
       SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_TILE_RANGES;
   param_values_["sm.mem.reader.sparse_unordered_with_dups.ratio_array_data"] =
       SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_ARRAY_DATA;
+  param_values_["sm.mem.writer.global_order.max_in_flight_bytes"] =
+      SM_MEM_GLOBAL_ORDER_WRITER_MAX_IN_FLIGHT_BYTES;
+  param_values_["sm.mem.writer.global_order.budget"] =
+      SM_MEM_GLOBAL_ORDER_WRITER_BUDGET;
+  param_values_["sm.mem.writer.unordered.spill_budget"] =
+      SM_MEM_WRITER_UNORDERED_SPILL_BUDGET;
+  param_values_["sm.mem.writer.unordered.spill_path"] =
+      SM_MEM_WRITER_UNORDERED_SPILL_PATH;
   param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   param_values_["sm.compute_concurrency_level"] = SM_COMPUTE_CONCURRENCY_LEVEL;
   param_values_["sm.io_concurrency_level"] = SM_IO_CONCURRENCY_LEVEL;
+  param_values_["sm.compute_affinity"] = SM_COMPUTE_AFFINITY;
+  param_values_["sm.io_affinity"] = SM_IO_AFFINITY;
+  param_values_["sm.shared_resources"] = SM_SHARED_RESOURCES;
+  param_values_["sm.thread_pool_stats"] = SM_THREAD_POOL_STATS;
   param_values_["sm.skip_checksum_validation"] = SM_SKIP_CHECKSUM_VALIDATION;
   param_values_["sm.consolidation.amplification"] =
       SM_CONSOLIDATION_AMPLIFICATION;
   param_values_["sm.consolidation.buffer_size"] = SM_CONSOLIDATION_BUFFER_SIZE;
+  param_values_["sm.consolidation.total_buffer_size"] =
+      SM_CONSOLIDATION_TOTAL_BUFFER_SIZE;
+  param_values_["sm.consolidation.max_in_flight_bytes"] =
+      SM_CONSOLIDATION_MAX_IN_FLIGHT_BYTES;
+  param_values_["sm.consolidation.tile_copy"] = SM_CONSOLIDATION_TILE_COPY;
+  param_values_["sm.consolidation.concurrent_budget"] =
+      SM_CONSOLIDATION_CONCURRENT_BUDGET;
+  param_values_["sm.consolidation.policy"] = SM_CONSOLIDATION_POLICY;
+  param_values_["sm.consolidation.tier_fanout"] = SM_CONSOLIDATION_TIER_FANOUT;
+  param_values_["sm.consolidation.tier_base_size"] =
+      SM_CONSOLIDATION_TIER_BASE_SIZE;
+  param_values_["sm.consolidation.auto.fragment_num"] =
+      SM_CONSOLIDATION_AUTO_FRAGMENT_NUM;
+  param_values_["sm.consolidation.auto.min_interval_ms"] =
+      SM_CONSOLIDATION_AUTO_MIN_INTERVAL_MS;
+  param_values_["sm.consolidation.fragment_meta.max_deltas"] =
+      SM_CONSOLIDATION_FRAGMENT_META_MAX_DELTAS;
+  param_values_["sm.consolidation.array_meta.max_deltas"] =
+      SM_CONSOLIDATION_ARRAY_META_MAX_DELTAS;
   param_values_["sm.consolidation.step_min_frags"] =
       SM_CONSOLIDATION_STEP_MIN_FRAGS;
   param_values_["sm.consolidation.step_max_frags"] =
@@ -274,6 +435,7 @@ Config::Config() {
       SM_CONSOLIDATION_TIMESTAMP_START;
   param_values_["sm.consolidation.timestamp_end"] =
       SM_CONSOLIDATION_TIMESTAMP_END;
+  param_values_["sm.consolidation.priority"] = SM_CONSOLIDATION_PRIORITY;
   param_values_["sm.vacuum.mode"] = SM_VACUUM_MODE;
   param_values_["sm.vacuum.timestamp_start"] = SM_VACUUM_TIMESTAMP_START;
   param_values_["sm.vacuum.timestamp_end"] = SM_VACUUM_TIMESTAMP_END;
@@ -283,6 +445,9 @@ Config::Config() {
   param_values_["sm.max_tile_overlap_size"] = SM_MAX_TILE_OVERLAP_SIZE;
   param_values_["vfs.min_parallel_size"] = VFS_MIN_PARALLEL_SIZE;
   param_values_["vfs.min_batch_gap"] = VFS_MIN_BATCH_GAP;
+  param_values_["vfs.adaptive_batch_gap"] = VFS_ADAPTIVE_BATCH_GAP;
+  param_values_["vfs.disk_cache.path"] = VFS_DISK_CACHE_PATH;
+  param_values_["vfs.disk_cache.max_size"] = VFS_DISK_CACHE_MAX_SIZE;
   param_values_["vfs.min_batch_size"] = VFS_MIN_BATCH_SIZE;
   param_values_["vfs.read_ahead_size"] = VFS_READ_AHEAD_SIZE;
   param_values_["vfs.read_ahead_cache_size"] = VFS_READ_AHEAD_CACHE_SIZE;
@@ -291,6 +456,11 @@ Config::Config() {
   param_values_["vfs.file.posix_directory_permissions"] =
       VFS_FILE_POSIX_DIRECTORY_PERMISSIONS;
   param_values_["vfs.file.max_parallel_ops"] = VFS_FILE_MAX_PARALLEL_OPS;
+  param_values_["vfs.file.io_uring"] = VFS_FILE_IO_URING;
+  param_values_["vfs.file.overlapped_io"] = VFS_FILE_OVERLAPPED_IO;
+  param_values_["vfs.file.direct_io"] = VFS_FILE_DIRECT_IO;
+  param_values_["vfs.file.mmap"] = VFS_FILE_MMAP;
+  param_values_["vfs.file.group_commit"] = VFS_FILE_GROUP_COMMIT;
   param_values_["vfs.azure.storage_account_name"] =
       VFS_AZURE_STORAGE_ACCOUNT_NAME;
   param_values_["vfs.azure.storage_account_key"] =
@@ -299,12 +469,14 @@ Config::Config() {
   param_values_["vfs.azure.blob_endpoint"] = VFS_AZURE_BLOB_ENDPOINT;
   param_values_["vfs.azure.use_https"] = VFS_AZURE_USE_HTTPS;
   param_values_["vfs.azure.max_parallel_ops"] = VFS_AZURE_MAX_PARALLEL_OPS;
+  param_values_["vfs.azure.read_part_size"] = VFS_AZURE_READ_PART_SIZE;
   param_values_["vfs.azure.block_list_block_size"] =
       VFS_AZURE_BLOCK_LIST_BLOCK_SIZE;
   param_values_["vfs.azure.use_block_list_upload"] =
       VFS_AZURE_USE_BLOCK_LIST_UPLOAD;
   param_values_["vfs.gcs.project_id"] = VFS_GCS_PROJECT_ID;
   param_values_["vfs.gcs.max_parallel_ops"] = VFS_GCS_MAX_PARALLEL_OPS;
+  param_values_["vfs.gcs.read_part_size"] = VFS_GCS_READ_PART_SIZE;
   param_values_["vfs.gcs.multi_part_size"] = VFS_GCS_MULTI_PART_SIZE;
   param_values_["vfs.gcs.use_multi_part_upload"] =
       VFS_GCS_USE_MULTI_PART_UPLOAD;
@@ -325,6 +497,7 @@ Config::Config() {
   param_values_["vfs.s3.use_multipart_upload"] = VFS_S3_USE_MULTIPART_UPLOAD;
   param_values_["vfs.s3.max_parallel_ops"] = VFS_S3_MAX_PARALLEL_OPS;
   param_values_["vfs.s3.multipart_part_size"] = VFS_S3_MULTIPART_PART_SIZE;
+  param_values_["vfs.s3.read_part_size"] = VFS_S3_READ_PART_SIZE;
   param_values_["vfs.s3.ca_file"] = VFS_S3_CA_FILE;
   param_values_["vfs.s3.ca_path"] = VFS_S3_CA_PATH;
   param_values_["vfs.s3.connect_timeout_ms"] = VFS_S3_CONNECT_TIMEOUT_MS;
@@ -333,6 +506,8 @@ Config::Config() {
   param_values_["vfs.s3.sse"] = VFS_S3_SSE;
   param_values_["vfs.s3.sse_kms_key_id"] = VFS_S3_SSE_KMS_KEY_ID;
   param_values_["vfs.s3.request_timeout_ms"] = VFS_S3_REQUEST_TIMEOUT_MS;
+  param_values_["vfs.s3.hedge_percentile"] = VFS_S3_HEDGE_PERCENTILE;
+  param_values_["vfs.s3.hedge_max_ratio"] = VFS_S3_HEDGE_MAX_RATIO;
   param_values_["vfs.s3.requester_pays"] = VFS_S3_REQUESTER_PAYS;
   param_values_["vfs.s3.proxy_scheme"] = VFS_S3_PROXY_SCHEME;
   param_values_["vfs.s3.proxy_host"] = VFS_S3_PROXY_HOST;
@@ -347,10 +522,25 @@ Config::Config() {
   param_values_["vfs.hdfs.username"] = VFS_HDFS_USERNAME;
   param_values_["vfs.hdfs.kerb_ticket_cache_path"] =
       VFS_HDFS_KERB_TICKET_CACHE_PATH;
+  param_values_["vfs.hdfs.short_circuit_reads"] = VFS_HDFS_SHORT_CIRCUIT_READS;
+  param_values_["vfs.hdfs.domain_socket_path"] = VFS_HDFS_DOMAIN_SOCKET_PATH;
+}
+
+Config::Config(const Config& config)
+    : param_values_(config.param_values_)
+    , set_params_(config.set_params_)
+    , snapshot_(std::atomic_load(&config.snapshot_)) {
 }
 
 Config::~Config() = default;
 
+Config& Config::operator=(const Config& config) {
+  param_values_ = config.param_values_;
+  set_params_ = config.set_params_;
+  std::atomic_store(&snapshot_, std::atomic_load(&config.snapshot_));
+  return *this;
+}
+
 /* ****************************** */
 /*                API             */
 /* ****************************** */
@@ -429,6 +619,7 @@ Status Config::save_to_file(const std::string& filename) {
 
 Status Config::set(const std::string& param, const std::string& value) {
   RETURN_NOT_OK(sanity_check(param, value));
+  std::atomic_store(&snapshot_, std::shared_ptr<const ConfigSnapshot>());
   param_values_[param] = value;
   set_params_.insert(param);
 
@@ -485,11 +676,70 @@ const std::map<std::string, std::string>& Config::param_values() const {
   return param_values_;
 }
 
+Status Config::snapshot(
+    std::shared_ptr<const ConfigSnapshot>* snapshot) const {
+  *snapshot = std::atomic_load(&snapshot_);
+  if (*snapshot != nullptr)
+    return Status::Ok();
+
+  // Parse the values. Concurrent callers may both get here, in which case
+  // the last snapshot is kept, as they are identical.
+  bool found = false;
+  auto s = std::make_shared<ConfigSnapshot>();
+  RETURN_NOT_OK(get<uint64_t>("sm.memory_budget", &s->memory_budget, &found));
+  RETURN_NOT_OK(
+      get<uint64_t>("sm.memory_budget_var", &s->memory_budget_var, &found));
+  s->var_offsets_mode = get("sm.var_offsets.mode", &found);
+  RETURN_NOT_OK(get<bool>(
+      "sm.var_offsets.extra_element", &s->var_offsets_extra_element, &found));
+  RETURN_NOT_OK(get<uint32_t>(
+      "sm.var_offsets.bitsize", &s->var_offsets_bitsize, &found));
+  RETURN_NOT_OK(
+      get<bool>("sm.check_coord_dups", &s->check_coord_dups, &found));
+  RETURN_NOT_OK(get<bool>("sm.check_coord_oob", &s->check_coord_oob, &found));
+  RETURN_NOT_OK(
+      get<bool>("sm.check_global_order", &s->check_global_order, &found));
+  RETURN_NOT_OK(get<bool>("sm.dedup_coords", &s->dedup_coords, &found));
+  RETURN_NOT_OK(get<uint64_t>(
+      "sm.coords_bloom_filter_bits_per_cell",
+      &s->coords_bloom_filter_bits_per_cell,
+      &found));
+  RETURN_NOT_OK(get<bool>(
+      "sm.query.dense.elide_fill_tiles", &s->dense_elide_fill_tiles, &found));
+  RETURN_NOT_OK(
+      get<uint64_t>("sm.mem.total_budget", &s->mem_total_budget, &found));
+  auto get_ratios = [this, &found](
+                        const std::string& reader,
+                        ConfigSnapshot::SparseReaderRatios* ratios) {
+    const std::string prefix = "sm.mem.reader." + reader + ".ratio_";
+    RETURN_NOT_OK(
+        get<double>(prefix + "array_data", &ratios->array_data, &found));
+    RETURN_NOT_OK(get<double>(prefix + "coords", &ratios->coords, &found));
+    RETURN_NOT_OK(get<double>(
+        prefix + "query_condition", &ratios->query_condition, &found));
+    return get<double>(prefix + "tile_ranges", &ratios->tile_ranges, &found);
+  };
+  RETURN_NOT_OK(get_ratios("sparse_global_order", &s->sparse_global_order));
+  RETURN_NOT_OK(get_ratios(
+      "sparse_unordered_with_dups", &s->sparse_unordered_with_dups));
+  RETURN_NOT_OK(get<double>(
+      "sm.mem.governor.min_ratio", &s->mem_governor_min_ratio, &found));
+  RETURN_NOT_OK(get<uint64_t>(
+      "sm.mem.governor.timeout_ms", &s->mem_governor_timeout_ms, &found));
+
+  std::atomic_store(&snapshot_, std::shared_ptr<const ConfigSnapshot>(s));
+  *snapshot = s;
+
+  return Status::Ok();
+}
+
 const std::set<std::string>& Config::set_params() const {
   return set_params_;
 }
 
 Status Config::unset(const std::string& param) {
+  std::atomic_store(&snapshot_, std::shared_ptr<const ConfigSnapshot>());
+
   // Set back to default
   if (param == "rest.server_address") {
     param_values_["rest.server_address"] = REST_SERVER_DEFAULT_ADDRESS;
@@ -506,6 +756,21 @@ Status Config::unset(const std::string& param) {
     param_values_["rest.retry_initial_delay_ms"] = REST_RETRY_INITIAL_DELAY_MS;
   } else if (param == "rest.retry_delay_factor") {
     param_values_["rest.retry_delay_factor"] = REST_RETRY_DELAY_FACTOR;
+  } else if (param == "rest.share_connections") {
+    param_values_["rest.share_connections"] = REST_SHARE_CONNECTIONS;
+  } else if (param == "rest.http2") {
+    param_values_["rest.http2"] = REST_HTTP2;
+  } else if (param == "rest.request_compressor") {
+    param_values_["rest.request_compressor"] = REST_REQUEST_COMPRESSOR;
+  } else if (param == "rest.request_compression_min_size") {
+    param_values_["rest.request_compression_min_size"] =
+        REST_REQUEST_COMPRESSION_MIN_SIZE;
+  } else if (param == "rest.prefetch_incomplete") {
+    param_values_["rest.prefetch_incomplete"] = REST_PREFETCH_INCOMPLETE;
+  } else if (param == "rest.submit_array_state") {
+    param_values_["rest.submit_array_state"] = REST_SUBMIT_ARRAY_STATE;
+  } else if (param == "rest.pipeline_array_open") {
+    param_values_["rest.pipeline_array_open"] = REST_PIPELINE_ARRAY_OPEN;
   } else if (param == "config.env_var_prefix") {
     param_values_["config.env_var_prefix"] = CONFIG_ENVIRONMENT_VARIABLE_PREFIX;
   } else if (param == "config.logging_level") {
@@ -518,6 +783,15 @@ Status Config::unset(const std::string& param) {
     param_values_["sm.encryption_type"] = SM_ENCRYPTION_TYPE;
   } else if (param == "sm.dedup_coords") {
     param_values_["sm.dedup_coords"] = SM_DEDUP_COORDS;
+  } else if (param == "sm.dedup_coords_method") {
+    param_values_["sm.dedup_coords_method"] = SM_DEDUP_COORDS_METHOD;
+  } else if (param == "sm.coords_bloom_filter_bits_per_cell") {
+    param_values_["sm.coords_bloom_filter_bits_per_cell"] =
+        SM_COORDS_BLOOM_FILTER_BITS_PER_CELL;
+  } else if (param == "sm.attribute_index_names") {
+    param_values_["sm.attribute_index_names"] = SM_ATTRIBUTE_INDEX_NAMES;
+  } else if (param == "sm.packed_fragment_max_size") {
+    param_values_["sm.packed_fragment_max_size"] = SM_PACKED_FRAGMENT_MAX_SIZE;
   } else if (param == "sm.check_coord_dups") {
     param_values_["sm.check_coord_dups"] = SM_CHECK_COORD_DUPS;
   } else if (param == "sm.check_coord_oob") {
@@ -528,6 +802,38 @@ Status Config::unset(const std::string& param) {
     param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   } else if (param == "sm.tile_cache_size") {
     param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  } else if (param == "sm.tile_cache_shard_num") {
+    param_values_["sm.tile_cache_shard_num"] = SM_TILE_CACHE_SHARD_NUM;
+  } else if (param == "sm.tile_cache_unfiltered_size") {
+    param_values_["sm.tile_cache_unfiltered_size"] =
+        SM_TILE_CACHE_UNFILTERED_SIZE;
+  } else if (param == "sm.tile_cache_policy") {
+    param_values_["sm.tile_cache_policy"] = SM_TILE_CACHE_POLICY;
+  } else if (param == "sm.tile_cache_shared_memory_name") {
+    param_values_["sm.tile_cache_shared_memory_name"] =
+        SM_TILE_CACHE_SHARED_MEMORY_NAME;
+  } else if (param == "sm.listing_cache_ttl_ms") {
+    param_values_["sm.listing_cache_ttl_ms"] = SM_LISTING_CACHE_TTL_MS;
+  } else if (param == "sm.fragment_listing_shards") {
+    param_values_["sm.fragment_listing_shards"] = SM_FRAGMENT_LISTING_SHARDS;
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    param_values_["sm.fragment_metadata_cache_size"] =
+        SM_FRAGMENT_METADATA_CACHE_SIZE;
+  } else if (param == "sm.array_schema_cache_size") {
+    param_values_["sm.array_schema_cache_size"] = SM_ARRAY_SCHEMA_CACHE_SIZE;
+  } else if (param == "sm.array_snapshot_cache_size") {
+    param_values_["sm.array_snapshot_cache_size"] =
+        SM_ARRAY_SNAPSHOT_CACHE_SIZE;
+  } else if (param == "sm.tile_overlap_cache_size") {
+    param_values_["sm.tile_overlap_cache_size"] = SM_TILE_OVERLAP_CACHE_SIZE;
+  } else if (param == "sm.partitioner.target_cost") {
+    param_values_["sm.partitioner.target_cost"] = SM_PARTITIONER_TARGET_COST;
+  } else if (param == "sm.partitioner.io_cost_per_byte") {
+    param_values_["sm.partitioner.io_cost_per_byte"] =
+        SM_PARTITIONER_IO_COST_PER_BYTE;
+  } else if (param == "sm.partitioner.cpu_cost_per_byte") {
+    param_values_["sm.partitioner.cpu_cost_per_byte"] =
+        SM_PARTITIONER_CPU_COST_PER_BYTE;
   } else if (param == "sm.memory_budget") {
     param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
   } else if (param == "sm.memory_budget_var") {
@@ -540,8 +846,46 @@ Status Config::unset(const std::string& param) {
   } else if (param == "sm.query.sparse_unordered_with_dups.reader") {
     param_values_["sm.query.sparse_unordered_with_dups.reader"] =
         SM_QUERY_SPARSE_UNORDERED_WITH_DUPS_READER;
+  } else if (param == "sm.query.priority") {
+    param_values_["sm.query.priority"] = SM_QUERY_PRIORITY;
+  } else if (param == "sm.query.shared_scan") {
+    param_values_["sm.query.shared_scan"] = SM_QUERY_SHARED_SCAN;
+  } else if (param == "sm.query.timeout_ms") {
+    param_values_["sm.query.timeout_ms"] = SM_QUERY_TIMEOUT_MS;
+  } else if (param == "sm.async_query.max_concurrent") {
+    param_values_["sm.async_query.max_concurrent"] =
+        SM_ASYNC_QUERY_MAX_CONCURRENT;
+  } else if (param == "sm.async_query.tag") {
+    param_values_["sm.async_query.tag"] = SM_ASYNC_QUERY_TAG;
+  } else if (param == "sm.query.sparse_unordered_no_dups.reader") {
+    param_values_["sm.query.sparse_unordered_no_dups.reader"] =
+        SM_QUERY_SPARSE_UNORDERED_NO_DUPS_READER;
+  } else if (param == "sm.query.dense.streaming_write") {
+    param_values_["sm.query.dense.streaming_write"] =
+        SM_QUERY_DENSE_STREAMING_WRITE;
+  } else if (param == "sm.query.dense.elide_fill_tiles") {
+    param_values_["sm.query.dense.elide_fill_tiles"] =
+        SM_QUERY_DENSE_ELIDE_FILL_TILES;
   } else if (param == "sm.mem.malloc_trim") {
     param_values_["sm.mem.malloc_trim"] = SM_MEM_MALLOC_TRIM;
+  } else if (param == "sm.mem.tile_buffer_pool_size") {
+    param_values_["sm.mem.tile_buffer_pool_size"] =
+        SM_MEM_TILE_BUFFER_POOL_SIZE;
+  } else if (param == "sm.mem.large_buffer.huge_pages") {
+    param_values_["sm.mem.large_buffer.huge_pages"] =
+        SM_MEM_LARGE_BUFFER_HUGE_PAGES;
+  } else if (param == "sm.mem.large_buffer.numa_local") {
+    param_values_["sm.mem.large_buffer.numa_local"] =
+        SM_MEM_LARGE_BUFFER_NUMA_LOCAL;
+  } else if (param == "sm.mem.large_buffer.threshold") {
+    param_values_["sm.mem.large_buffer.threshold"] =
+        SM_MEM_LARGE_BUFFER_THRESHOLD;
+  } else if (param == "sm.mem.governor.enabled") {
+    param_values_["sm.mem.governor.enabled"] = SM_MEM_GOVERNOR_ENABLED;
+  } else if (param == "sm.mem.governor.min_ratio") {
+    param_values_["sm.mem.governor.min_ratio"] = SM_MEM_GOVERNOR_MIN_RATIO;
+  } else if (param == "sm.mem.governor.timeout_ms") {
+    param_values_["sm.mem.governor.timeout_ms"] = SM_MEM_GOVERNOR_TIMEOUT_MS;
   } else if (param == "sm.mem.total_budget") {
     param_values_["sm.mem.total_budget"] = SM_MEM_TOTAL_BUDGET;
   } else if (param == "sm.mem.reader.sparse_global_order.ratio_coords") {
@@ -575,6 +919,18 @@ Status Config::unset(const std::string& param) {
       param == "sm.mem.reader.sparse_unordered_with_dups.ratio_array_data") {
     param_values_["sm.mem.reader.sparse_unordered_with_dups.ratio_array_data"] =
         SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_ARRAY_DATA;
+  } else if (param == "sm.mem.writer.global_order.max_in_flight_bytes") {
+    param_values_["sm.mem.writer.global_order.max_in_flight_bytes"] =
+        SM_MEM_GLOBAL_ORDER_WRITER_MAX_IN_FLIGHT_BYTES;
+  } else if (param == "sm.mem.writer.global_order.budget") {
+    param_values_["sm.mem.writer.global_order.budget"] =
+        SM_MEM_GLOBAL_ORDER_WRITER_BUDGET;
+  } else if (param == "sm.mem.writer.unordered.spill_budget") {
+    param_values_["sm.mem.writer.unordered.spill_budget"] =
+        SM_MEM_WRITER_UNORDERED_SPILL_BUDGET;
+  } else if (param == "sm.mem.writer.unordered.spill_path") {
+    param_values_["sm.mem.writer.unordered.spill_path"] =
+        SM_MEM_WRITER_UNORDERED_SPILL_PATH;
   } else if (param == "sm.enable_signal_handlers") {
     param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   } else if (param == "sm.compute_concurrency_level") {
@@ -582,12 +938,51 @@ Status Config::unset(const std::string& param) {
         SM_COMPUTE_CONCURRENCY_LEVEL;
   } else if (param == "sm.io_concurrency_level") {
     param_values_["sm.io_concurrency_level"] = SM_IO_CONCURRENCY_LEVEL;
+  } else if (param == "sm.compute_affinity") {
+    param_values_["sm.compute_affinity"] = SM_COMPUTE_AFFINITY;
+  } else if (param == "sm.io_affinity") {
+    param_values_["sm.io_affinity"] = SM_IO_AFFINITY;
+  } else if (param == "sm.shared_resources") {
+    param_values_["sm.shared_resources"] = SM_SHARED_RESOURCES;
+  } else if (param == "sm.thread_pool_stats") {
+    param_values_["sm.thread_pool_stats"] = SM_THREAD_POOL_STATS;
   } else if (param == "sm.consolidation.amplification") {
     param_values_["sm.consolidation.amplification"] =
         SM_CONSOLIDATION_AMPLIFICATION;
   } else if (param == "sm.consolidation.buffer_size") {
     param_values_["sm.consolidation.buffer_size"] =
         SM_CONSOLIDATION_BUFFER_SIZE;
+  } else if (param == "sm.consolidation.total_buffer_size") {
+    param_values_["sm.consolidation.total_buffer_size"] =
+        SM_CONSOLIDATION_TOTAL_BUFFER_SIZE;
+  } else if (param == "sm.consolidation.max_in_flight_bytes") {
+    param_values_["sm.consolidation.max_in_flight_bytes"] =
+        SM_CONSOLIDATION_MAX_IN_FLIGHT_BYTES;
+  } else if (param == "sm.consolidation.tile_copy") {
+    param_values_["sm.consolidation.tile_copy"] = SM_CONSOLIDATION_TILE_COPY;
+  } else if (param == "sm.consolidation.concurrent_budget") {
+    param_values_["sm.consolidation.concurrent_budget"] =
+        SM_CONSOLIDATION_CONCURRENT_BUDGET;
+  } else if (param == "sm.consolidation.policy") {
+    param_values_["sm.consolidation.policy"] = SM_CONSOLIDATION_POLICY;
+  } else if (param == "sm.consolidation.tier_fanout") {
+    param_values_["sm.consolidation.tier_fanout"] =
+        SM_CONSOLIDATION_TIER_FANOUT;
+  } else if (param == "sm.consolidation.tier_base_size") {
+    param_values_["sm.consolidation.tier_base_size"] =
+        SM_CONSOLIDATION_TIER_BASE_SIZE;
+  } else if (param == "sm.consolidation.auto.fragment_num") {
+    param_values_["sm.consolidation.auto.fragment_num"] =
+        SM_CONSOLIDATION_AUTO_FRAGMENT_NUM;
+  } else if (param == "sm.consolidation.auto.min_interval_ms") {
+    param_values_["sm.consolidation.auto.min_interval_ms"] =
+        SM_CONSOLIDATION_AUTO_MIN_INTERVAL_MS;
+  } else if (param == "sm.consolidation.fragment_meta.max_deltas") {
+    param_values_["sm.consolidation.fragment_meta.max_deltas"] =
+        SM_CONSOLIDATION_FRAGMENT_META_MAX_DELTAS;
+  } else if (param == "sm.consolidation.array_meta.max_deltas") {
+    param_values_["sm.consolidation.array_meta.max_deltas"] =
+        SM_CONSOLIDATION_ARRAY_META_MAX_DELTAS;
   } else if (param == "sm.consolidation.steps") {
     param_values_["sm.consolidation.steps"] = SM_CONSOLIDATION_STEPS;
   } else if (param == "sm.consolidation.step_min_frags") {
@@ -607,6 +1002,8 @@ Status Config::unset(const std::string& param) {
   } else if (param == "sm.consolidation.timestamp_end") {
     param_values_["sm.consolidation.timestamp_end"] =
         SM_CONSOLIDATION_TIMESTAMP_END;
+  } else if (param == "sm.consolidation.priority") {
+    param_values_["sm.consolidation.priority"] = SM_CONSOLIDATION_PRIORITY;
   } else if (param == "sm.vacuum.mode") {
     param_values_["sm.vacuum.mode"] = SM_VACUUM_MODE;
   } else if (param == "sm.vacuum.timestamp_start") {
@@ -625,6 +1022,12 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.min_parallel_size"] = VFS_MIN_PARALLEL_SIZE;
   } else if (param == "vfs.min_batch_gap") {
     param_values_["vfs.min_batch_gap"] = VFS_MIN_BATCH_GAP;
+  } else if (param == "vfs.adaptive_batch_gap") {
+    param_values_["vfs.adaptive_batch_gap"] = VFS_ADAPTIVE_BATCH_GAP;
+  } else if (param == "vfs.disk_cache.path") {
+    param_values_["vfs.disk_cache.path"] = VFS_DISK_CACHE_PATH;
+  } else if (param == "vfs.disk_cache.max_size") {
+    param_values_["vfs.disk_cache.max_size"] = VFS_DISK_CACHE_MAX_SIZE;
   } else if (param == "vfs.min_batch_size") {
     param_values_["vfs.min_batch_size"] = VFS_MIN_BATCH_SIZE;
   } else if (param == "vfs.read_ahead_size") {
@@ -639,6 +1042,16 @@ Status Config::unset(const std::string& param) {
         VFS_FILE_POSIX_DIRECTORY_PERMISSIONS;
   } else if (param == "vfs.file.max_parallel_ops") {
     param_values_["vfs.file.max_parallel_ops"] = VFS_FILE_MAX_PARALLEL_OPS;
+  } else if (param == "vfs.file.io_uring") {
+    param_values_["vfs.file.io_uring"] = VFS_FILE_IO_URING;
+  } else if (param == "vfs.file.overlapped_io") {
+    param_values_["vfs.file.overlapped_io"] = VFS_FILE_OVERLAPPED_IO;
+  } else if (param == "vfs.file.direct_io") {
+    param_values_["vfs.file.direct_io"] = VFS_FILE_DIRECT_IO;
+  } else if (param == "vfs.file.mmap") {
+    param_values_["vfs.file.mmap"] = VFS_FILE_MMAP;
+  } else if (param == "vfs.file.group_commit") {
+    param_values_["vfs.file.group_commit"] = VFS_FILE_GROUP_COMMIT;
   } else if (param == "vfs.azure.storage_account_name") {
     param_values_["vfs.azure.storage_account_name"] =
         VFS_AZURE_STORAGE_ACCOUNT_NAME;
@@ -653,6 +1066,8 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.azure.use_https"] = VFS_AZURE_USE_HTTPS;
   } else if (param == "vfs.azure.max_parallel_ops") {
     param_values_["vfs.azure.max_parallel_ops"] = VFS_AZURE_MAX_PARALLEL_OPS;
+  } else if (param == "vfs.azure.read_part_size") {
+    param_values_["vfs.azure.read_part_size"] = VFS_AZURE_READ_PART_SIZE;
   } else if (param == "vfs.azure.block_list_block_size") {
     param_values_["vfs.azure.block_list_block_size"] =
         VFS_AZURE_BLOCK_LIST_BLOCK_SIZE;
@@ -663,6 +1078,8 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.gcs.project_id"] = VFS_GCS_PROJECT_ID;
   } else if (param == "vfs.gcs.max_parallel_ops") {
     param_values_["vfs.gcs.max_parallel_ops"] = VFS_GCS_MAX_PARALLEL_OPS;
+  } else if (param == "vfs.gcs.read_part_size") {
+    param_values_["vfs.gcs.read_part_size"] = VFS_GCS_READ_PART_SIZE;
   } else if (param == "vfs.gcs.multi_part_size") {
     param_values_["vfs.gcs.multi_part_size"] = VFS_GCS_MULTI_PART_SIZE;
   } else if (param == "vfs.gcs.use_multi_part_upload") {
@@ -704,6 +1121,8 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.s3.max_parallel_ops"] = VFS_S3_MAX_PARALLEL_OPS;
   } else if (param == "vfs.s3.multipart_part_size") {
     param_values_["vfs.s3.multipart_part_size"] = VFS_S3_MULTIPART_PART_SIZE;
+  } else if (param == "vfs.s3.read_part_size") {
+    param_values_["vfs.s3.read_part_size"] = VFS_S3_READ_PART_SIZE;
   } else if (param == "vfs.s3.ca_file") {
     param_values_["vfs.s3.ca_file"] = VFS_S3_CA_FILE;
   } else if (param == "vfs.s3.ca_path") {
@@ -720,6 +1139,10 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.s3.sse_kms_key_id"] = VFS_S3_SSE_KMS_KEY_ID;
   } else if (param == "vfs.s3.request_timeout_ms") {
     param_values_["vfs.s3.request_timeout_ms"] = VFS_S3_REQUEST_TIMEOUT_MS;
+  } else if (param == "vfs.s3.hedge_percentile") {
+    param_values_["vfs.s3.hedge_percentile"] = VFS_S3_HEDGE_PERCENTILE;
+  } else if (param == "vfs.s3.hedge_max_ratio") {
+    param_values_["vfs.s3.hedge_max_ratio"] = VFS_S3_HEDGE_MAX_RATIO;
   } else if (param == "vfs.s3.requester_pays") {
     param_values_["vfs.s3.requester_pays"] = VFS_S3_REQUESTER_PAYS;
   } else if (param == "vfs.s3.proxy_scheme") {
@@ -745,6 +1168,11 @@ Status Config::unset(const std::string& param) {
   } else if (param == "vfs.hdfs.kerb_ticket_cache_path") {
     param_values_["vfs.hdfs.kerb_ticket_cache_path"] =
         VFS_HDFS_KERB_TICKET_CACHE_PATH;
+  } else if (param == "vfs.hdfs.short_circuit_reads") {
+    param_values_["vfs.hdfs.short_circuit_reads"] =
+        VFS_HDFS_SHORT_CIRCUIT_READS;
+  } else if (param == "vfs.hdfs.domain_socket_path") {
+    param_values_["vfs.hdfs.domain_socket_path"] = VFS_HDFS_DOMAIN_SOCKET_PATH;
   } else {
     param_values_.erase(param);
   }
@@ -792,6 +1220,28 @@ Status Config::sanity_check(
   if (param == "rest.server_serialization_format") {
     SerializationType serialization_type;
     RETURN_NOT_OK(serialization_type_enum(value, &serialization_type));
+  } else if (param == "vfs.hdfs.short_circuit_reads") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.shared_resources") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.packed_fragment_max_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "rest.request_compression_min_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "rest.prefetch_incomplete") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "rest.submit_array_state") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "rest.pipeline_array_open") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "rest.share_connections") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "rest.http2") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "rest.request_compressor") {
+    if (value != "none" && value != "zstd")
+      return LOG_STATUS(Status_ConfigError(
+          "Invalid REST request compressor parameter value"));
   } else if (param == "config.logging_level") {
     RETURN_NOT_OK(utils::parse::convert(value, &v32));
   } else if (param == "config.logging_format") {
@@ -800,6 +1250,12 @@ Status Config::sanity_check(
           Status_ConfigError("Invalid logging format parameter value"));
   } else if (param == "sm.dedup_coords") {
     RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.dedup_coords_method") {
+    if (value != "sort" && value != "hash")
+      return LOG_STATUS(Status_ConfigError(
+          "Invalid dedup coords method parameter value"));
+  } else if (param == "sm.coords_bloom_filter_bits_per_cell") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.check_coord_dups") {
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.check_coord_oob") {
@@ -808,6 +1264,49 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.mem.tile_buffer_pool_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.mem.large_buffer.huge_pages") {
+    HugePageMode huge_page_mode;
+    RETURN_NOT_OK(huge_page_mode_enum(value, &huge_page_mode));
+  } else if (param == "sm.query.timeout_ms") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.async_query.max_concurrent") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (
+      param == "sm.query.priority" || param == "sm.consolidation.priority") {
+    ThreadPool::Priority priority;
+    RETURN_NOT_OK(ThreadPool::priority_enum(value, &priority));
+  } else if (param == "sm.thread_pool_stats") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.compute_affinity" || param == "sm.io_affinity") {
+    std::vector<ThreadPool::CpuSet> affinity;
+    RETURN_NOT_OK(ThreadPool::parse_affinity(value, &affinity));
+  } else if (param == "sm.mem.large_buffer.numa_local") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.mem.large_buffer.threshold") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.mem.governor.enabled") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.mem.governor.min_ratio") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vf));
+  } else if (param == "sm.mem.governor.timeout_ms") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.tile_cache_policy") {
+    CachePolicy cache_policy;
+    RETURN_NOT_OK(cache_policy_enum(value, &cache_policy));
+  } else if (param == "sm.listing_cache_ttl_ms") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.fragment_listing_shards") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.array_schema_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.array_snapshot_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.tile_overlap_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget_var") {
@@ -822,6 +1321,34 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &vf));
   } else if (param == "sm.consolidation.buffer_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.total_buffer_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.max_in_flight_bytes") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.tile_copy") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.consolidation.concurrent_budget") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.policy") {
+    if (value != "size_ratio" && value != "size_tiered" && value != "leveled")
+      return LOG_STATUS(
+          Status_ConfigError("Invalid consolidation policy parameter value"));
+  } else if (param == "sm.consolidation.tier_fanout") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
+    if (v32 < 2)
+      return LOG_STATUS(Status_ConfigError(
+          "Invalid consolidation tier fanout parameter value; must be at "
+          "least 2"));
+  } else if (param == "sm.consolidation.tier_base_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.auto.fragment_num") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.auto.min_interval_ms") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.consolidation.fragment_meta.max_deltas") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
+  } else if (param == "sm.consolidation.array_meta.max_deltas") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
   } else if (param == "sm.consolidation.steps") {
     RETURN_NOT_OK(utils::parse::convert(value, &v32));
   } else if (param == "sm.consolidation.step_min_frags") {
@@ -842,6 +1369,10 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.min_batch_gap") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "vfs.adaptive_batch_gap") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.disk_cache.max_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.min_batch_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.read_ahead_size") {
@@ -854,6 +1385,22 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &v32));
   } else if (param == "vfs.file.max_parallel_ops") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "vfs.file.io_uring") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.file.overlapped_io") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.file.direct_io") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.file.mmap") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.file.group_commit") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "vfs.s3.read_part_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "vfs.azure.read_part_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "vfs.gcs.read_part_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.s3.scheme") {
     if (value != "http" && value != "https")
       return LOG_STATUS(
@@ -876,6 +1423,10 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &vint64));
   } else if (param == "vfs.s3.request_timeout_ms") {
     RETURN_NOT_OK(utils::parse::convert(value, &vint64));
+  } else if (param == "vfs.s3.hedge_percentile") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vf));
+  } else if (param == "vfs.s3.hedge_max_ratio") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vf));
   } else if (param == "vfs.s3.requester_pays") {
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "vfs.s3.proxy_port") {
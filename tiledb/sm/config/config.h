@@ -34,8 +34,10 @@
 #define TILEDB_CONFIG_H
 
 #include "tiledb/common/status.h"
+#include "tiledb/sm/config/config_snapshot.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -77,6 +79,30 @@ class Config {
   /** The default exponential delay factor for retrying a http request. */
   static const std::string REST_RETRY_DELAY_FACTOR;
 
+  /** If true, REST requests reuse the connections of a shared pool. */
+  static const std::string REST_SHARE_CONNECTIONS;
+
+  /** If true, HTTP/2 is negotiated with the REST server. */
+  static const std::string REST_HTTP2;
+
+  /** The content encoding of the queries posted to the REST server. */
+  static const std::string REST_REQUEST_COMPRESSOR;
+
+  /** The minimum size of the queries compressed for the REST server. */
+  static const std::string REST_REQUEST_COMPRESSION_MIN_SIZE;
+
+  /** If true, incomplete remote reads prefetch their next partition. */
+  static const std::string REST_PREFETCH_INCOMPLETE;
+
+  /** If true, REST query submissions include the state of their array. */
+  static const std::string REST_SUBMIT_ARRAY_STATE;
+
+  /**
+   * If true, remote array opens fetch the non-empty domain and metadata
+   * concurrently with the array schema.
+   */
+  static const std::string REST_PIPELINE_ARRAY_OPEN;
+
   /** The prefix to use for checking for parameter environmental variables. */
   static const std::string CONFIG_ENVIRONMENT_VARIABLE_PREFIX;
 
@@ -103,6 +129,21 @@ class Config {
   /** If `true`, this will deduplicate coordinates upon sparse writes. */
   static const std::string SM_DEDUP_COORDS;
 
+  /** The method used to find duplicate coordinates in unordered writes. */
+  static const std::string SM_DEDUP_COORDS_METHOD;
+
+  /** The number of Bloom filter bits per cell written to sparse fragments. */
+  static const std::string SM_COORDS_BLOOM_FILTER_BITS_PER_CELL;
+
+  /** The attributes indexed by value in sparse fragments. */
+  static const std::string SM_ATTRIBUTE_INDEX_NAMES;
+
+  /**
+   * The maximum size in bytes of the buffers of an unordered write that writes
+   * a packed fragment.
+   */
+  static const std::string SM_PACKED_FRAGMENT_MAX_SIZE;
+
   /**
    * If `true`, this will check for coordinate duplicates upon sparse
    * writes.
@@ -131,6 +172,48 @@ class Config {
   /** The tile cache size. */
   static const std::string SM_TILE_CACHE_SIZE;
 
+  /** The number of shards of the tile cache. */
+  static const std::string SM_TILE_CACHE_SHARD_NUM;
+
+  /** The unfiltered tile cache size in bytes. */
+  static const std::string SM_TILE_CACHE_UNFILTERED_SIZE;
+
+  /** The admission and eviction policy of the tile caches. */
+  static const std::string SM_TILE_CACHE_POLICY;
+
+  /** The name of the shared memory segment of the tile cache. */
+  static const std::string SM_TILE_CACHE_SHARED_MEMORY_NAME;
+
+  /** The time to live of cached array directory listings, in milliseconds. */
+  static const std::string SM_LISTING_CACHE_TTL_MS;
+
+  /** The number of concurrent listings of the fragments of an array. */
+  static const std::string SM_FRAGMENT_LISTING_SHARDS;
+
+  /** The fragment metadata cache size in bytes. 0 disables the cache. */
+  static const std::string SM_FRAGMENT_METADATA_CACHE_SIZE;
+
+  /** The array schema cache size in bytes. 0 disables the cache. */
+  static const std::string SM_ARRAY_SCHEMA_CACHE_SIZE;
+
+  /**
+   * The maximum number of cached snapshots of arrays opened for reads at
+   * explicit timestamps.
+   */
+  static const std::string SM_ARRAY_SNAPSHOT_CACHE_SIZE;
+
+  /** The tile overlap cache size of each open array. */
+  static const std::string SM_TILE_OVERLAP_CACHE_SIZE;
+
+  /** Partition cost target of the subarray partitioner (0 disables it). */
+  static const std::string SM_PARTITIONER_TARGET_COST;
+
+  /** Partitioner cost of fetching one persisted tile byte. */
+  static const std::string SM_PARTITIONER_IO_COST_PER_BYTE;
+
+  /** Partitioner cost of unfiltering one in-memory tile byte. */
+  static const std::string SM_PARTITIONER_CPU_COST_PER_BYTE;
+
   /** If `true`, bypass partitioning on estimated result sizes. */
   static const std::string SM_SKIP_EST_SIZE_PARTITIONING;
 
@@ -155,9 +238,61 @@ class Config {
   /** Which reader to use for sparse unordered with dups queries. */
   static const std::string SM_QUERY_SPARSE_UNORDERED_WITH_DUPS_READER;
 
+  /** The thread pool priority of queries. */
+  static const std::string SM_QUERY_PRIORITY;
+
+  /** If `true`, concurrent read queries share the reads of the same tiles. */
+  static const std::string SM_QUERY_SHARED_SCAN;
+
+  /** The maximum time in milliseconds a query submission may run. */
+  static const std::string SM_QUERY_TIMEOUT_MS;
+
+  /** The default maximum number of async queries in flight. */
+  static const std::string SM_ASYNC_QUERY_MAX_CONCURRENT;
+
+  /** The default client tag of async queries. */
+  static const std::string SM_ASYNC_QUERY_TAG;
+
+  /** Which reader to use for sparse unordered queries without dups. */
+  static const std::string SM_QUERY_SPARSE_UNORDERED_NO_DUPS_READER;
+
+  /**
+   * Whether dense ordered writes stream row-major or col-major slabs across
+   * submits.
+   */
+  static const std::string SM_QUERY_DENSE_STREAMING_WRITE;
+
+  /**
+   * If `true`, dense writes do not store the tiles holding only fill values.
+   */
+  static const std::string SM_QUERY_DENSE_ELIDE_FILL_TILES;
+
   /** Should malloc_trim be called on query/ctx destructors. */
   static const std::string SM_MEM_MALLOC_TRIM;
 
+  /** The maximum size of the idle tile buffers kept for reuse by a context. */
+  static const std::string SM_MEM_TILE_BUFFER_POOL_SIZE;
+
+  /** How large tile buffers are backed by huge pages. */
+  static const std::string SM_MEM_LARGE_BUFFER_HUGE_PAGES;
+
+  /** Whether large tile buffers are bound to the local NUMA node. */
+  static const std::string SM_MEM_LARGE_BUFFER_NUMA_LOCAL;
+
+  /** The smallest tile buffer size considered large. */
+  static const std::string SM_MEM_LARGE_BUFFER_THRESHOLD;
+
+  /**
+   * Whether the total budget bounds all the concurrent queries of a context.
+   */
+  static const std::string SM_MEM_GOVERNOR_ENABLED;
+
+  /** The smallest fraction of its budget a read runs with. */
+  static const std::string SM_MEM_GOVERNOR_MIN_RATIO;
+
+  /** How long a read waits for memory, in milliseconds. */
+  static const std::string SM_MEM_GOVERNOR_TIMEOUT_MS;
+
   /** Maximum memory budget for readers and writers. */
   static const std::string SM_MEM_TOTAL_BUDGET;
 
@@ -197,6 +332,26 @@ class Config {
    */
   static const std::string SM_MEM_SPARSE_UNORDERED_WITH_DUPS_RATIO_ARRAY_DATA;
 
+  /**
+   * Maximum bytes of tiles filtered and written in the background by the global
+   * order writer.
+   */
+  static const std::string SM_MEM_GLOBAL_ORDER_WRITER_MAX_IN_FLIGHT_BYTES;
+
+  /**
+   * Memory budget in bytes for filtering and writing the full tiles of a global
+   * order write.
+   */
+  static const std::string SM_MEM_GLOBAL_ORDER_WRITER_BUDGET;
+
+  /**
+   * Memory budget of the unordered writer merge of the runs spilled to disk.
+   */
+  static const std::string SM_MEM_WRITER_UNORDERED_SPILL_BUDGET;
+
+  /** Scratch directory of the runs spilled by unordered writes. */
+  static const std::string SM_MEM_WRITER_UNORDERED_SPILL_PATH;
+
   /** Whether or not the signal handlers are installed. */
   static const std::string SM_ENABLE_SIGNAL_HANDLERS;
 
@@ -206,6 +361,21 @@ class Config {
   /** The maximum concurrency level for io-bound operations. */
   static const std::string SM_IO_CONCURRENCY_LEVEL;
 
+  /** The default CPU affinity of the compute thread pool workers. */
+  static const std::string SM_COMPUTE_AFFINITY;
+
+  /** The default CPU affinity of the io thread pool workers. */
+  static const std::string SM_IO_AFFINITY;
+
+  /**
+   * Whether contexts share thread pools and S3 clients with compatible
+   * configurations.
+   */
+  static const std::string SM_SHARED_RESOURCES;
+
+  /** The default for recording the thread pool activity in the stats. */
+  static const std::string SM_THREAD_POOL_STATS;
+
   /** If `true`, checksum validation will be skipped on reads. */
   static const std::string SM_SKIP_CHECKSUM_VALIDATION;
 
@@ -223,6 +393,74 @@ class Config {
   /** The buffer size for each attribute used in consolidation. */
   static const std::string SM_CONSOLIDATION_BUFFER_SIZE;
 
+  /**
+   * The total buffer size of a fragment consolidation step, split across the
+   * buffers by their average cell sizes. 0 uses `sm.consolidation.buffer_size`
+   * for every buffer.
+   */
+  static const std::string SM_CONSOLIDATION_TOTAL_BUFFER_SIZE;
+
+  /**
+   * The maximum bytes of consolidated tiles filtered and written in the
+   * background while the next cells are read. 0 reads and writes the cells in
+   * turn.
+   */
+  static const std::string SM_CONSOLIDATION_MAX_IN_FLIGHT_BYTES;
+
+  /**
+   * Whether sparse fragments with disjoint space tiles are consolidated by
+   * copying their filtered tiles.
+   */
+  static const std::string SM_CONSOLIDATION_TILE_COPY;
+
+  /**
+   * The total bytes of buffers of the sparse consolidation steps running
+   * concurrently. 0 runs the steps one at a time.
+   */
+  static const std::string SM_CONSOLIDATION_CONCURRENT_BUDGET;
+
+  /**
+   * The policy that selects the fragments of each consolidation step:
+   * `size_ratio`, `size_tiered` or `leveled`.
+   */
+  static const std::string SM_CONSOLIDATION_POLICY;
+
+  /**
+   * The size ratio of consecutive tiers or levels of the consolidation
+   * policies.
+   */
+  static const std::string SM_CONSOLIDATION_TIER_FANOUT;
+
+  /**
+   * The size of the fragments of the first tier of the size-tiered
+   * consolidation policy.
+   */
+  static const std::string SM_CONSOLIDATION_TIER_BASE_SIZE;
+
+  /**
+   * The number of fragments from which closing an array for writes schedules a
+   * background consolidation of its fragments. 0 disables it.
+   */
+  static const std::string SM_CONSOLIDATION_AUTO_FRAGMENT_NUM;
+
+  /**
+   * The minimum time in milliseconds between two background consolidations of
+   * the same array.
+   */
+  static const std::string SM_CONSOLIDATION_AUTO_MIN_INTERVAL_MS;
+
+  /**
+   * The maximum number of deltas appended to a consolidated fragment metadata
+   * file before it is rewritten.
+   */
+  static const std::string SM_CONSOLIDATION_FRAGMENT_META_MAX_DELTAS;
+
+  /**
+   * The maximum number of consolidated array metadata files before all of them
+   * are merged.
+   */
+  static const std::string SM_CONSOLIDATION_ARRAY_META_MAX_DELTAS;
+
   /** Number of steps in the consolidation algorithm. */
   static const std::string SM_CONSOLIDATION_STEPS;
 
@@ -258,6 +496,9 @@ class Config {
    *  */
   static const std::string SM_CONSOLIDATION_TIMESTAMP_END;
 
+  /** The thread pool priority of consolidation and vacuuming. */
+  static const std::string SM_CONSOLIDATION_PRIORITY;
+
   /**
    * The vacuum mode. It can be one of:
    *     - "fragments": only the fragments will be vacuumed
@@ -309,6 +550,15 @@ class Config {
    */
   static const std::string VFS_MIN_BATCH_GAP;
 
+  /** Whether to derive the read batch gap from observed request costs. */
+  static const std::string VFS_ADAPTIVE_BATCH_GAP;
+
+  /** The directory of the local disk cache of object store reads. */
+  static const std::string VFS_DISK_CACHE_PATH;
+
+  /** The maximum size of the local disk cache of object store reads. */
+  static const std::string VFS_DISK_CACHE_MAX_SIZE;
+
   /** The default minimum number of bytes in a batched VFS read operation. */
   static const std::string VFS_MIN_BATCH_SIZE;
 
@@ -321,6 +571,27 @@ class Config {
   /** The default maximum number of parallel file:/// operations. */
   static const std::string VFS_FILE_MAX_PARALLEL_OPS;
 
+  /** Whether to use io_uring for batched local file I/O. */
+  static const std::string VFS_FILE_IO_URING;
+
+  /**
+   * Whether batched reads and parallel writes of local files are issued as
+   * overlapped I/O on Windows.
+   */
+  static const std::string VFS_FILE_OVERLAPPED_IO;
+
+  /** Whether to bypass the page cache when reading local files. */
+  static const std::string VFS_FILE_DIRECT_IO;
+
+  /** Whether to read tiles of local files through memory mappings. */
+  static const std::string VFS_FILE_MMAP;
+
+  /**
+   * Whether the files of fragments with `file:///` URIs are synced together
+   * right before the fragment is committed.
+   */
+  static const std::string VFS_FILE_GROUP_COMMIT;
+
   /** The maximum size (in bytes) to read-ahead in the VFS. */
   static const std::string VFS_READ_AHEAD_SIZE;
 
@@ -345,6 +616,11 @@ class Config {
   /** Azure max parallel ops. */
   static const std::string VFS_AZURE_MAX_PARALLEL_OPS;
 
+  /**
+   * The minimum part size of the parallel ranged downloads of an Azure read.
+   */
+  static const std::string VFS_AZURE_READ_PART_SIZE;
+
   /** Azure block list block size. */
   static const std::string VFS_AZURE_BLOCK_LIST_BLOCK_SIZE;
 
@@ -357,6 +633,9 @@ class Config {
   /** GCS max parallel ops. */
   static const std::string VFS_GCS_MAX_PARALLEL_OPS;
 
+  /** The minimum part size of the parallel ranged downloads of a GCS read. */
+  static const std::string VFS_GCS_READ_PART_SIZE;
+
   /** GCS multi part size. */
   static const std::string VFS_GCS_MULTI_PART_SIZE;
 
@@ -411,6 +690,9 @@ class Config {
   /** Size of parts used in the S3 multi-part uploads. */
   static const std::string VFS_S3_MULTIPART_PART_SIZE;
 
+  /** The minimum part size of the parallel ranged GETs of an S3 read. */
+  static const std::string VFS_S3_READ_PART_SIZE;
+
   /** Certificate file path. */
   static const std::string VFS_S3_CA_FILE;
 
@@ -435,6 +717,14 @@ class Config {
   /** Request timeout in milliseconds. */
   static const std::string VFS_S3_REQUEST_TIMEOUT_MS;
 
+  /**
+   * The latency percentile after which S3 GETs are hedged; 0 disables hedging.
+   */
+  static const std::string VFS_S3_HEDGE_PERCENTILE;
+
+  /** The maximum ratio of hedged S3 GETs to all S3 GETs. */
+  static const std::string VFS_S3_HEDGE_MAX_RATIO;
+
   /** Requester pays for the S3 access charges. */
   static const std::string VFS_S3_REQUESTER_PAYS;
 
@@ -462,6 +752,12 @@ class Config {
   /** HDFS default kerb ticket cache path. */
   static const std::string VFS_HDFS_KERB_TICKET_CACHE_PATH;
 
+  /** Whether HDFS blocks on the local datanode are read directly from disk. */
+  static const std::string VFS_HDFS_SHORT_CIRCUIT_READS;
+
+  /** The domain socket of the local datanode for HDFS short-circuit reads. */
+  static const std::string VFS_HDFS_DOMAIN_SOCKET_PATH;
+
   /** HDFS default name node uri. */
   static const std::string VFS_HDFS_NAME_NODE_URI;
 
@@ -485,9 +781,15 @@ class Config {
   /** Constructor. */
   Config();
 
+  /** Copy constructor. */
+  Config(const Config& config);
+
   /** Destructor. */
   ~Config();
 
+  /** Copy-assignment operator. */
+  Config& operator=(const Config& config);
+
   /* ********************************* */
   /*                API                */
   /* ********************************* */
@@ -528,6 +830,17 @@ class Config {
   /** Returns the param -> value map. */
   const std::map<std::string, std::string>& param_values() const;
 
+  /**
+   * Retrieves the parsed values of the parameters used to initialize
+   * queries. They are parsed on the first call after the config changes
+   * and shared by the later calls, and by the copies of the config. The
+   * environment variables are read when the values are parsed.
+   *
+   * @param snapshot Set to the parsed values.
+   * @return Status
+   */
+  Status snapshot(std::shared_ptr<const ConfigSnapshot>* snapshot) const;
+
   /** Gets the set parameters. */
   const std::set<std::string>& set_params() const;
 
@@ -553,6 +866,13 @@ class Config {
   /** Stores the parameters set by the user. */
   std::set<std::string> set_params_;
 
+  /**
+   * The parsed values of the parameters, or `nullptr` if they changed since
+   * they were last parsed. Accessed with the atomic shared pointer functions,
+   * as it is set by the const `snapshot()`.
+   */
+  mutable std::shared_ptr<const ConfigSnapshot> snapshot_;
+
   /* ********************************* */
   /*          PRIVATE CONSTANTS        */
   /* ********************************* */
@@ -0,0 +1,116 @@
+/**
+ * @file   config_snapshot.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines struct ConfigSnapshot.
+ */
+
+#ifndef TILEDB_CONFIG_SNAPSHOT_H
+#define TILEDB_CONFIG_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * The parsed values of the config parameters read when queries are
+ * initialized. It is built by `Config::snapshot()` once per set of values,
+ * so that the readers and writers use the fields directly instead of
+ * looking up and parsing strings for every query.
+ */
+struct ConfigSnapshot {
+  /** The memory budget ratios of a sparse reader. */
+  struct SparseReaderRatios {
+    /** Ratio of the budget for the array data. */
+    double array_data = 0;
+
+    /** Ratio of the budget for the coordinates. */
+    double coords = 0;
+
+    /** Ratio of the budget for the query condition. */
+    double query_condition = 0;
+
+    /** Ratio of the budget for the tile ranges. */
+    double tile_ranges = 0;
+  };
+
+  /** `sm.memory_budget` */
+  uint64_t memory_budget = 0;
+
+  /** `sm.memory_budget_var` */
+  uint64_t memory_budget_var = 0;
+
+  /** `sm.var_offsets.mode` */
+  std::string var_offsets_mode;
+
+  /** `sm.var_offsets.extra_element` */
+  bool var_offsets_extra_element = false;
+
+  /** `sm.var_offsets.bitsize` */
+  uint32_t var_offsets_bitsize = 64;
+
+  /** `sm.check_coord_dups` */
+  bool check_coord_dups = false;
+
+  /** `sm.check_coord_oob` */
+  bool check_coord_oob = false;
+
+  /** `sm.check_global_order` */
+  bool check_global_order = false;
+
+  /** `sm.dedup_coords` */
+  bool dedup_coords = false;
+
+  /** `sm.coords_bloom_filter_bits_per_cell` */
+  uint64_t coords_bloom_filter_bits_per_cell = 0;
+
+  /** `sm.query.dense.elide_fill_tiles` */
+  bool dense_elide_fill_tiles = false;
+
+  /** `sm.mem.total_budget` */
+  uint64_t mem_total_budget = 0;
+
+  /** `sm.mem.reader.sparse_global_order.ratio_*` */
+  SparseReaderRatios sparse_global_order;
+
+  /** `sm.mem.reader.sparse_unordered_with_dups.ratio_*` */
+  SparseReaderRatios sparse_unordered_with_dups;
+
+  /** `sm.mem.governor.min_ratio` */
+  double mem_governor_min_ratio = 0;
+
+  /** `sm.mem.governor.timeout_ms` */
+  uint64_t mem_governor_timeout_ms = 0;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CONFIG_SNAPSHOT_H
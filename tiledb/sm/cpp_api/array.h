@@ -669,6 +669,32 @@ class Array {
         ctx.ptr().get(), array_.get(), timestamp_end));
   }
 
+  /**
+   * Sets a subarray hint when opening (and reopening) this array for reads.
+   * Only the fragments intersecting the subarray are then loaded.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Array array(ctx, "s3://bucket-name/array-name");
+   * array.close();
+   * array.set_open_subarray<int32_t>({1, 10, 1, 10});
+   * array.open(TILEDB_READ);
+   * @endcode
+   *
+   * @tparam T The dimension datatype.
+   * @param subarray The subarray as `{dim1_low, dim1_high, ...}`.
+   */
+  template <typename T>
+  void set_open_subarray(const std::vector<T>& subarray) const {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_array_set_open_subarray(
+        ctx.ptr().get(),
+        array_.get(),
+        subarray.data(),
+        subarray.size() * sizeof(T)));
+  }
+
   /** Retrieves the inclusive starting timestamp. */
   uint64_t open_timestamp_start() const {
     auto& ctx = ctx_.get();
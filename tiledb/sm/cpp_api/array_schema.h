@@ -541,6 +541,44 @@ class ArraySchema : public Schema {
     return *this;
   }
 
+  /**
+   * Adds an attribute group to a sparse array. The tiles of the attributes
+   * of a group are stored interleaved in a single file per fragment.
+   * Attribute groups are not supported on remote arrays.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * schema.add_attribute(Attribute::create<int32_t>(ctx, "a1"))
+   *     .add_attribute(Attribute::create<float>(ctx, "a2"))
+   *     .add_attribute_group({"a1", "a2"});
+   * @endcode
+   *
+   * @param names The names of the attributes of the group, which must be
+   *     fixed-sized and not nullable.
+   * @return Reference to this `ArraySchema` instance.
+   */
+  ArraySchema& add_attribute_group(const std::vector<std::string>& names) {
+    auto& ctx = ctx_.get();
+    std::vector<const char*> c_names;
+    for (const auto& name : names)
+      c_names.push_back(name.c_str());
+    ctx.handle_error(tiledb_array_schema_add_attribute_group(
+        ctx.ptr().get(),
+        schema_.get(),
+        c_names.data(),
+        (uint32_t)c_names.size()));
+    return *this;
+  }
+
+  /** Returns the number of attribute groups in the schema. */
+  uint32_t attribute_group_num() const {
+    auto& ctx = ctx_.get();
+    uint32_t num;
+    ctx.handle_error(tiledb_array_schema_get_attribute_group_num(
+        ctx.ptr().get(), schema_.get(), &num));
+    return num;
+  }
+
   /** Returns a shared pointer to the C TileDB domain object. */
   std::shared_ptr<tiledb_array_schema_t> ptr() const {
     return schema_;
@@ -667,6 +705,8 @@ class ArraySchema : public Schema {
         return "UNORDERED";
       case TILEDB_HILBERT:
         return "HILBERT";
+      case TILEDB_MORTON:
+        return "MORTON";
     }
     return "";
   }
@@ -0,0 +1,146 @@
+/**
+ * @file   array_snapshot.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the experimental C++ API for array snapshots.
+ */
+
+#ifndef TILEDB_CPP_API_ARRAY_SNAPSHOT_H
+#define TILEDB_CPP_API_ARRAY_SNAPSHOT_H
+
+#include "array.h"
+#include "context.h"
+#include "deleter.h"
+#include "tiledb.h"
+#include "tiledb_experimental.h"
+
+#include <memory>
+#include <string>
+
+namespace tiledb {
+
+/**
+ * An immutable snapshot of an array opened for reads, freezing its schemas,
+ * fragment metadata and non-empty domain. Any number of threads can open
+ * arrays from the snapshot concurrently, which involves no I/O, instead of
+ * each opening and loading the array.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Array array(ctx, "my_array", TILEDB_READ);
+ * tiledb::ArraySnapshot snapshot(ctx, array);
+ * array.close();
+ *
+ * // In each thread
+ * tiledb::Array thread_array = snapshot.open();
+ * tiledb::Query query(ctx, thread_array);
+ * @endcode
+ */
+class ArraySnapshot {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor. Creates a snapshot of an array opened for reads. The
+   * snapshot outlives the array.
+   *
+   * @param ctx TileDB context.
+   * @param array The array opened for reads.
+   */
+  ArraySnapshot(const Context& ctx, const Array& array)
+      : ctx_(ctx)
+      , uri_(array.uri()) {
+    tiledb_array_snapshot_t* snapshot;
+    ctx.handle_error(tiledb_array_snapshot_alloc(
+        ctx.ptr().get(), array.ptr().get(), &snapshot));
+    snapshot_ = std::shared_ptr<tiledb_array_snapshot_t>(snapshot, deleter_);
+  }
+
+  ArraySnapshot(const ArraySnapshot&) = default;
+  ArraySnapshot(ArraySnapshot&&) = default;
+  ArraySnapshot& operator=(const ArraySnapshot&) = default;
+  ArraySnapshot& operator=(ArraySnapshot&&) = default;
+  ~ArraySnapshot() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Opens an array for reads from the snapshot.
+   *
+   * @return The opened array.
+   */
+  Array open() const {
+    auto& ctx = ctx_.get();
+    tiledb_array_t* array;
+    ctx.handle_error(
+        tiledb_array_alloc(ctx.ptr().get(), uri_.c_str(), &array));
+    int32_t rc = tiledb_array_open_snapshot(
+        ctx.ptr().get(), array, snapshot_.get());
+    if (rc != TILEDB_OK) {
+      tiledb_array_free(&array);
+      ctx.handle_error(rc);
+    }
+    return Array(ctx, array);
+  }
+
+  /** Returns the URI of the array of the snapshot. */
+  const std::string& uri() const {
+    return uri_;
+  }
+
+  /** Returns a shared pointer to the C TileDB array snapshot object. */
+  std::shared_ptr<tiledb_array_snapshot_t> ptr() const {
+    return snapshot_;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** The URI of the array of the snapshot. */
+  std::string uri_;
+
+  /** An auxiliary deleter. */
+  impl::Deleter deleter_;
+
+  /** The pointer to the C TileDB array snapshot object. */
+  std::shared_ptr<tiledb_array_snapshot_t> snapshot_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_ARRAY_SNAPSHOT_H
@@ -82,8 +82,12 @@ struct ArrowArray {
 /* ************************************************************************ */
 /* Begin TileDB Arrow IO internal implementation */
 
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 /* ****************************** */
 /*      Error context helper      */
@@ -135,6 +139,9 @@ struct BufferInfo {
   uint64_t offsets_num;      // number of offsets
   void* offsets;             // offsets pointer
   size_t offsets_elem_size;  // bytes per offset element
+  bool is_nullable;          // has a validity bytemap
+  uint64_t validity_num;     // number of validity elements
+  uint8_t* validity;         // validity bytemap pointer
 };
 
 /* ****************************** */
@@ -428,7 +435,7 @@ struct CPPArrowSchema {
     schema_->private_data = this;
 
     if (n_children_ > 0) {
-      schema_->children = static_cast<ArrowSchema**>(children.data());
+      schema_->children = static_cast<ArrowSchema**>(children_.data());
     }
 
     if (dictionary) {
@@ -445,6 +452,9 @@ struct CPPArrowSchema {
   ~CPPArrowSchema() {
     if (schema_ != nullptr)
       std::free(schema_);
+    // child structs are allocated by the producer; they were released above
+    for (auto child : children_)
+      std::free(child);
   };
 
   /*
@@ -541,6 +551,46 @@ struct CPPArrowArray {
     array_->buffers = const_cast<const void**>(buffers_.data());
   }
 
+  /*
+   * Packs a TileDB validity bytemap into an Arrow validity bitmap
+   * owned by this object, and installs it as the first buffer.
+   *
+   * Arrow requires least-significant-bit ordering, with a set bit
+   * denoting a valid (non-null) value. Returns the number of nulls.
+   */
+  int64_t set_validity(const uint8_t* bytemap, uint64_t num) {
+    assert(!buffers_.empty());
+    validity_bitmap_.assign((num + 7) / 8, 0);
+    int64_t null_num = 0;
+    for (uint64_t i = 0; i < num; i++) {
+      if (bytemap[i] != 0)
+        validity_bitmap_[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+      else
+        null_num++;
+    }
+    buffers_[0] = validity_bitmap_.data();
+    array_->null_count = null_num;
+    return null_num;
+  }
+
+  /*
+   * Sets the child arrays of this (struct) array. The child structs must
+   * be allocated with std::malloc; they are freed with this object.
+   */
+  void set_children(std::vector<ArrowArray*> children) {
+    children_ = children;
+    array_->n_children = static_cast<int64_t>(children_.size());
+    array_->children = children_.empty() ? nullptr : children_.data();
+  }
+
+  /*
+   * Keeps `owner` alive until the array is released, for buffers that are
+   * not owned by the caller of the export.
+   */
+  void set_owner(std::shared_ptr<void> owner) {
+    owner_ = owner;
+  }
+
   /*
    * CPPArrowArray destructor
    *
@@ -552,6 +602,8 @@ struct CPPArrowArray {
       // did not export
       std::free(array_);
     }
+    for (auto child : children_)
+      std::free(child);
   }
 
   void export_ptr(ArrowArray* out_array) {
@@ -574,6 +626,9 @@ struct CPPArrowArray {
  private:
   ArrowArray* array_;
   std::vector<void*> buffers_;
+  std::vector<uint8_t> validity_bitmap_;
+  std::vector<ArrowArray*> children_;
+  std::shared_ptr<void> owner_;
 };
 
 /* ****************************** */
@@ -648,7 +703,11 @@ class ArrowExporter {
  public:
   ArrowExporter(Context* const ctx, Query* const query);
 
-  void export_(const std::string& name, ArrowArray* array, ArrowSchema* schema);
+  void export_(
+      const std::string& name,
+      ArrowArray* array,
+      ArrowSchema* schema,
+      std::shared_ptr<void> owner = nullptr);
 
   BufferInfo buffer_info(const std::string& name);
 
@@ -683,6 +742,22 @@ BufferInfo ArrowExporter::buffer_info(const std::string& name) {
 
   bool is_var = typeinfo.cell_val_num == TILEDB_VAR_NUM;
 
+  // Arrow expects `n + 1` offsets for `n` values; the data and offsets
+  // buffers are exported without copying, so the core must produce them.
+  if (is_var && ctx_->config().get("sm.var_offsets.extra_element") != "true") {
+    throw tiledb::TileDBError(
+        "[TileDB-Arrow] Exporting var-sized field '" + name +
+        "' requires 'sm.var_offsets.extra_element=true'");
+  }
+
+  auto schema = query_->array().schema();
+  bool is_nullable =
+      schema.has_attribute(name) && schema.attribute(name).nullable();
+  uint8_t* validity = nullptr;
+  uint64_t validity_nelem = 0;
+  if (is_nullable)
+    query_->get_validity_buffer(name, &validity, &validity_nelem);
+
   // NOTE: result sizes are in bytes
   if (is_var) {
     query_->get_data_buffer(name, &data, &data_nelem, &elem_size);
@@ -722,22 +797,28 @@ BufferInfo ArrowExporter::buffer_info(const std::string& name) {
   retval.offsets_num = (is_var ? offsets_nelem : 1);
   retval.offsets = offsets;
   retval.offsets_elem_size = offsets_elem_nbytes;
+  retval.is_nullable = is_nullable;
+  retval.validity_num = validity_nelem;
+  retval.validity = validity;
 
   return retval;
 }
 
 int64_t flags_for_buffer(BufferInfo binfo) {
-  /*  TODO, use these defs from arrow_cdefs.h -- currently not applicable.
+  /*  TODO, use these defs from arrow_cdefs.h -- currently only
+      ARROW_FLAG_NULLABLE is applicable.
       #define ARROW_FLAG_DICTIONARY_ORDERED 1
       #define ARROW_FLAG_NULLABLE 2
       #define ARROW_FLAG_MAP_KEYS_SORTED 4
   */
-  (void)binfo;
-  return 0;
+  return binfo.is_nullable ? 2 : 0;
 }
 
 void ArrowExporter::export_(
-    const std::string& name, ArrowArray* array, ArrowSchema* schema) {
+    const std::string& name,
+    ArrowArray* array,
+    ArrowSchema* schema,
+    std::shared_ptr<void> owner) {
   auto bufferinfo = this->buffer_info(name);
 
   if (schema == nullptr || array == nullptr) {
@@ -758,11 +839,8 @@ void ArrowExporter::export_(
   if (bufferinfo.is_var) {
     buffers = {nullptr, bufferinfo.offsets, bufferinfo.data};
   } else {
-    cpp_schema = new CPPArrowSchema(
-        name, arrow_fmt.fmt_, std::nullopt, arrow_flags, {}, {});
     buffers = {nullptr, bufferinfo.data};
   }
-  cpp_schema->export_ptr(schema);
 
   size_t elem_num = 0;
   if (bufferinfo.is_var) {
@@ -771,6 +849,13 @@ void ArrowExporter::export_(
   } else {
     elem_num = bufferinfo.data_num;
   }
+  if (bufferinfo.is_nullable && bufferinfo.validity_num < elem_num) {
+    delete cpp_schema;
+    throw tiledb::TileDBError(
+        "[TileDB-Arrow] Validity buffer of field '" + name +
+        "' is smaller than its result");
+  }
+  cpp_schema->export_ptr(schema);
 
   auto cpp_arrow_array = new CPPArrowArray(
       elem_num,  // elem_num
@@ -778,7 +863,265 @@ void ArrowExporter::export_(
       0,         // offset
       {},        // children
       buffers);
+  // The validity bitmap is the only buffer not shared with the query; it
+  // is released together with the exported array.
+  if (bufferinfo.is_nullable && elem_num > 0)
+    cpp_arrow_array->set_validity(bufferinfo.validity, elem_num);
+  if (owner != nullptr)
+    cpp_arrow_array->set_owner(owner);
+  cpp_arrow_array->export_ptr(array);
+}
+
+/* ****************************** */
+/*       Arrow Batch Reader       */
+/* ****************************** */
+
+// Query buffers of one record batch. Exported batches share the ownership
+// of their buffers, so a set is only reused once its batch was released.
+struct ArrowBatchBuffers {
+  struct Field {
+    std::vector<uint64_t> data;
+    std::vector<uint64_t> offsets;
+    uint64_t offsets_size = 0;
+    std::vector<uint8_t> validity;
+  };
+
+  std::unordered_map<std::string, Field> fields;
+};
+
+class ArrowBatchReaderImpl {
+ public:
+  ArrowBatchReaderImpl(
+      Context* const ctx,
+      Query* const query,
+      const std::vector<std::string>& names,
+      uint64_t batch_size,
+      uint64_t var_cell_bytes);
+  ~ArrowBatchReaderImpl();
+
+  bool read_next(ArrowArray* array, ArrowSchema* schema);
+
+ private:
+  Context* const ctx_;
+  Query* const query_;
+  ArraySchema schema_;
+  std::vector<std::string> names_;
+  uint64_t batch_size_;
+  uint64_t var_cell_bytes_;
+  uint64_t offsets_elem_size_;
+
+  // All buffer sets allocated so far, either free, being read into, or
+  // referenced by batches that were not released yet.
+  std::vector<std::shared_ptr<ArrowBatchBuffers>> buffer_sets_;
+
+  // The buffer set of the read running in the background.
+  std::shared_ptr<ArrowBatchBuffers> pending_buffers_;
+  std::future<void> pending_;
+
+  std::shared_ptr<ArrowBatchBuffers> free_buffers();
+  void set_buffers(ArrowBatchBuffers* buffers);
+  uint64_t rows_read(ArrowBatchBuffers* buffers);
+  void read(ArrowBatchBuffers* buffers);
+  void start_read();
+};
+
+ArrowBatchReaderImpl::ArrowBatchReaderImpl(
+    Context* const ctx,
+    Query* const query,
+    const std::vector<std::string>& names,
+    uint64_t batch_size,
+    uint64_t var_cell_bytes)
+    : ctx_(ctx)
+    , query_(query)
+    , schema_(query->array().schema())
+    , names_(names)
+    , batch_size_(batch_size)
+    , var_cell_bytes_(std::max<uint64_t>(var_cell_bytes, 1)) {
+  if (query_->query_type() != TILEDB_READ)
+    throw tiledb::TileDBError(
+        "[TileDB-Arrow] ArrowBatchReader requires a read query");
+  if (names_.empty() || batch_size_ == 0)
+    throw tiledb::TileDBError(
+        "[TileDB-Arrow] ArrowBatchReader requires at least one field and a "
+        "non-zero batch size");
+  offsets_elem_size_ =
+      ctx_->config().get("sm.var_offsets.bitsize") == "32" ? 4 : 8;
+
+  start_read();
+}
+
+ArrowBatchReaderImpl::~ArrowBatchReaderImpl() {
+  if (pending_.valid())
+    pending_.wait();
+}
+
+std::shared_ptr<ArrowBatchBuffers> ArrowBatchReaderImpl::free_buffers() {
+  for (auto& buffers : buffer_sets_) {
+    if (buffers.use_count() == 1)
+      return buffers;
+  }
+
+  auto buffers = std::make_shared<ArrowBatchBuffers>();
+  for (const auto& name : names_) {
+    auto typeinfo = tiledb_dt_info(schema_, name);
+    auto& field = buffers->fields[name];
+    uint64_t data_nbytes = 0;
+    if (typeinfo.cell_val_num == TILEDB_VAR_NUM) {
+      data_nbytes = batch_size_ * var_cell_bytes_;
+      field.offsets.resize(batch_size_ + 1);
+    } else {
+      data_nbytes = batch_size_ * typeinfo.cell_val_num * typeinfo.elem_size;
+    }
+    field.data.resize((data_nbytes + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    if (schema_.has_attribute(name) && schema_.attribute(name).nullable())
+      field.validity.resize(batch_size_);
+  }
+  buffer_sets_.push_back(buffers);
+
+  return buffers;
+}
+
+void ArrowBatchReaderImpl::set_buffers(ArrowBatchBuffers* buffers) {
+  for (auto& it : buffers->fields) {
+    const auto& name = it.first;
+    auto& field = it.second;
+    auto typeinfo = tiledb_dt_info(schema_, name);
+
+    query_->set_data_buffer(
+        name,
+        static_cast<void*>(field.data.data()),
+        field.data.size() * sizeof(uint64_t) / typeinfo.elem_size);
+    if (!field.offsets.empty()) {
+      // The C++ API assumes 64-bit offsets, so the byte size is set
+      // directly to hold exactly `batch_size + 1` offsets of either width.
+      field.offsets_size = (batch_size_ + 1) * offsets_elem_size_;
+      ctx_->handle_error(tiledb_query_set_offsets_buffer(
+          ctx_->ptr().get(),
+          query_->ptr().get(),
+          name.c_str(),
+          field.offsets.data(),
+          &field.offsets_size));
+    }
+    if (!field.validity.empty())
+      query_->set_validity_buffer(
+          name, field.validity.data(), field.validity.size());
+  }
+}
+
+uint64_t ArrowBatchReaderImpl::rows_read(ArrowBatchBuffers* buffers) {
+  const auto& name = names_.front();
+  const auto& field = buffers->fields.at(name);
+  if (!field.offsets.empty()) {
+    // account for the extra offset
+    uint64_t offsets_num = field.offsets_size / offsets_elem_size_;
+    return offsets_num > 1 ? offsets_num - 1 : 0;
+  }
+
+  auto elements = query_->result_buffer_elements();
+  return elements[name].second / tiledb_dt_info(schema_, name).cell_val_num;
+}
+
+void ArrowBatchReaderImpl::read(ArrowBatchBuffers* buffers) {
+  set_buffers(buffers);
+  query_->submit();
+
+  // The query returns no results when a var-sized cell does not fit in
+  // the buffers; grow them until at least one row is read.
+  while (query_->query_status() == Query::Status::INCOMPLETE &&
+         rows_read(buffers) == 0) {
+    bool grown = false;
+    for (auto& it : buffers->fields) {
+      if (!it.second.offsets.empty()) {
+        it.second.data.resize(it.second.data.size() * 2);
+        grown = true;
+      }
+    }
+    if (!grown)
+      throw tiledb::TileDBError(
+          "[TileDB-Arrow] ArrowBatchReader: query is incomplete but returned "
+          "no results");
+    var_cell_bytes_ *= 2;
+
+    set_buffers(buffers);
+    query_->submit();
+  }
+}
+
+void ArrowBatchReaderImpl::start_read() {
+  pending_buffers_ = free_buffers();
+  auto buffers = pending_buffers_.get();
+  pending_ = std::async(
+      std::launch::async, [this, buffers]() { this->read(buffers); });
+}
+
+bool ArrowBatchReaderImpl::read_next(ArrowArray* array, ArrowSchema* schema) {
+  if (schema == nullptr || array == nullptr) {
+    throw tiledb::TileDBError(
+        "ArrowBatchReader: received invalid pointer to output array or "
+        "schema.");
+  }
+
+  // All batches were returned
+  if (!pending_.valid())
+    return false;
+
+  // Rethrows the errors of the background read
+  pending_.get();
+  auto buffers = std::move(pending_buffers_);
+  uint64_t rows = rows_read(buffers.get());
+  bool incomplete = query_->query_status() == Query::Status::INCOMPLETE;
+  if (rows == 0)
+    return false;
+
+  // Export the fields while the query still points to this buffer set
+  std::vector<ArrowArray*> child_arrays;
+  std::vector<ArrowSchema*> child_schemas;
+  try {
+    ArrowExporter exporter(ctx_, query_);
+    for (const auto& name : names_) {
+      child_arrays.push_back(
+          static_cast<ArrowArray*>(std::malloc(sizeof(ArrowArray))));
+      child_schemas.push_back(
+          static_cast<ArrowSchema*>(std::malloc(sizeof(ArrowSchema))));
+      if (child_arrays.back() == nullptr || child_schemas.back() == nullptr)
+        throw tiledb::TileDBError("Failed to allocate Arrow struct");
+      child_arrays.back()->release = nullptr;
+      child_schemas.back()->release = nullptr;
+      exporter.export_(
+          name, child_arrays.back(), child_schemas.back(), buffers);
+    }
+  } catch (...) {
+    for (auto child : child_arrays) {
+      if (child != nullptr && child->release != nullptr)
+        child->release(child);
+      std::free(child);
+    }
+    for (auto child : child_schemas) {
+      if (child != nullptr && child->release != nullptr)
+        child->release(child);
+      std::free(child);
+    }
+    throw;
+  }
+
+  auto cpp_schema =
+      new CPPArrowSchema("", "+s", std::nullopt, 0, child_schemas, nullptr);
+  cpp_schema->export_ptr(schema);
+
+  auto cpp_arrow_array = new CPPArrowArray(
+      static_cast<int64_t>(rows),  // elem_num
+      0,                           // null_num
+      0,                           // offset
+      {},                          // children
+      {nullptr});
+  cpp_arrow_array->set_children(child_arrays);
   cpp_arrow_array->export_ptr(array);
+
+  // Read the next batch in the background while this one is consumed
+  if (incomplete)
+    start_read();
+
+  return true;
 }
 
 /* End TileDB Arrow IO internal implementation */
@@ -821,6 +1164,27 @@ ArrowAdapter::~ArrowAdapter() {
     delete exporter_;
 }
 
+ArrowBatchReader::ArrowBatchReader(
+    Context* const ctx,
+    Query* const query,
+    const std::vector<std::string>& names,
+    uint64_t batch_size,
+    uint64_t var_cell_bytes)
+    : impl_(nullptr) {
+  impl_ = new ArrowBatchReaderImpl(
+      ctx, query, names, batch_size, var_cell_bytes);
+}
+
+ArrowBatchReader::~ArrowBatchReader() {
+  if (impl_)
+    delete impl_;
+}
+
+bool ArrowBatchReader::read_next(void* arrow_array, void* arrow_schema) {
+  return impl_->read_next(
+      (ArrowArray*)arrow_array, (ArrowSchema*)arrow_schema);
+}
+
 void query_get_buffer_arrow_array(
     Context* const ctx,
     Query* const query,
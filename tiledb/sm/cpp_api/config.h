@@ -270,6 +270,35 @@ class Config {
    *    sparse fragment writes. Note that ties during deduplication are broken
    *    arbitrarily. <br>
    *    **Default**: false
+   * - `sm.dedup_coords_method` <br>
+   *    Applicable only if `sm.dedup_coords` is `true`. With "sort", unordered
+   *    writes find duplicates by comparing neighbors after sorting all cells in
+   *    global order. With "hash", duplicates are removed before sorting in a
+   *    single pass with a hash table partitioned across threads, which shortens
+   *    the sort when there are many duplicates. "sort" or "hash". <br>
+   *    **Default**: sort
+   * - `sm.coords_bloom_filter_bits_per_cell` <br>
+   *    The number of bits per cell of the Bloom filter over the coordinates
+   *    that sparse writes store with each fragment. Reads whose ranges are
+   *    single points skip the fragments the filter rules out. Ten bits give
+   *    about 1% false positives. Not applicable to arrays with real-typed
+   *    dimensions. If 0, no filter is written. <br>
+   *    **Default**: 0
+   * - `sm.attribute_index_names` <br>
+   *    A comma-separated list of attributes whose values sparse writes index
+   *    per fragment, with a Bloom filter over the values of each tile. Reads
+   *    with equality or set membership query conditions on an indexed attribute
+   *    skip the tiles that cannot contain the values. Attributes missing from
+   *    the array schema and real-typed attributes are ignored. <br>
+   *    **Default**: ""
+   * - `sm.packed_fragment_max_size` <br>
+   *    Unordered writes to sparse arrays whose buffers total at most this many
+   *    bytes write a packed fragment, a single object holding all the fragment
+   *    files, instead of a fragment directory with one file per attribute plus
+   *    the metadata and ok files. This saves PUT requests for small writes on
+   *    object stores. Reads and consolidation handle packed fragments like
+   *    other fragments. 0 disables packed fragments. <br>
+   *    **Default**: 0
    * - `sm.check_coord_dups` <br>
    *    This is applicable only if `sm.dedup_coords` is `false`.
    *    If `true`, an error will be thrown if there are cells with duplicate
@@ -292,10 +321,94 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.tile_cache_shard_num` <br>
+   *    The number of independently locked shards the tile cache is split into,
+   *    each holding an equal part of `sm.tile_cache_size`. More shards reduce
+   *    the lock contention between concurrent queries. <br>
+   *    **Default**: 1
+   * - `sm.tile_cache_unfiltered_size` <br>
+   *    The size in bytes of a separate cache of unfiltered tiles, sharded like
+   *    the tile cache. Tiles found there are neither read nor unfiltered again.
+   *    The cache is disabled when set to 0. <br>
+   *    **Default**: 0
+   * - `sm.tile_cache_policy` <br>
+   *    The admission and eviction policy of the tile caches. `lru` evicts the
+   *    least recently used tile. `slru` is a segmented LRU, where tiles read
+   *    only once are evicted before tiles read repeatedly, so that large scans
+   *    do not flush frequently read tiles. `tinylfu` is a segmented LRU that
+   *    also admits a new tile only if it is estimated to be read more often
+   *    than the tile it would evict. <br>
+   *    **Default**: lru
+   * - `sm.tile_cache_shared_memory_name` <br>
+   *    If set, the tile cache is stored in the shared memory segment with this
+   *    name, shared by all the processes of the host using the same name,
+   *    instead of in the memory of each process. The segment is created with
+   *    `sm.tile_cache_size` bytes by the first process attaching to it and is
+   *    not removed when the processes exit. `sm.tile_cache_shard_num` and
+   *    `sm.tile_cache_policy` do not apply to it. Only supported on POSIX
+   *    systems. <br>
+   *    **Default**: ""
+   * - `sm.listing_cache_ttl_ms` <br>
+   *    The time in milliseconds for which the listings of the fragments and
+   *    array schemas of an array are cached and reused by subsequent array
+   *    opens. `0` disables the listing cache. Fragments written, consolidated
+   *    or vacuumed through the same context are always listed again. <br>
+   *    **Default**: 0
+   * - `sm.fragment_listing_shards` <br>
+   *    The number of concurrent listings the fragments of an array on S3 are
+   *    listed with, by splitting their timestamp range since the creation of
+   *    the array. `1` lists them with a single paginated listing. <br>
+   *    **Default**: 1
+   * - `sm.fragment_metadata_cache_size` <br>
+   *    The fragment metadata cache size in bytes, shared by all the arrays
+   *    opened in the context. Reopening an array then loads only the metadata
+   *    of its new fragments. The size of a cached fragment metadata is
+   *    approximated by the size of its footer. Any `uint64_t` value is
+   *    acceptable; 0 disables the cache. <br>
+   *    **Default**: 0
    * - `sm.array_schema_cache_size` <br>
-   *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
-   *    <br>
-   *    **Default**: 10,000,000
+   *    The array schema cache size in bytes, shared by all the arrays opened in
+   *    the context. Opening an array then copies the schemas it already loaded
+   *    instead of reading and deserializing them again. The size of a cached
+   *    schema is approximated by its serialized size. Any `uint64_t` value is
+   *    acceptable; 0 disables the cache. <br>
+   *    **Default**: 10000000
+   * - `sm.array_snapshot_cache_size` <br>
+   *    The maximum number of array snapshots shared by all the arrays opened
+   *    for reads in the context. A snapshot holds the schemas, the fragment
+   *    metadata and the array metadata of an array opened at an explicit
+   *    `timestamp_end` (and `timestamp_start`), so that opening the array again
+   *    at the same timestamps involves no listing or loading. The snapshots of
+   *    an array are dropped when the context writes, consolidates, vacuums or
+   *    removes it; changes made by other processes are not seen. Any `uint64_t`
+   *    value is acceptable; 0 disables the cache. <br>
+   *    **Default**: 0
+   * - `sm.tile_overlap_cache_size` <br>
+   *    The tile overlap cache size in bytes of each open array. Queries on the
+   *    same open array whose subarrays have the same ranges and layout then
+   *    reuse the tile overlap computed by an earlier query instead of
+   *    traversing the fragment R-trees again. The cache is dropped when the
+   *    array is closed or reopened. Any `uint64_t` value is acceptable; 0
+   *    disables the cache. <br>
+   *    **Default**: 10000000
+   * - `sm.partitioner.target_cost` <br>
+   *    If non-zero, the subarray partitioner stops growing a partition of
+   *    multiple ranges once the estimated cost of the unique tiles it touches
+   *    exceeds this value. The cost of a tile is
+   *    `sm.partitioner.io_cost_per_byte` times its persisted (compressed) size
+   *    plus `sm.partitioner.cpu_cost_per_byte` times its in-memory size, so the
+   *    unit of the target is up to the caller (e.g. seconds or bytes). <br>
+   *    **Default**: 0
+   * - `sm.partitioner.io_cost_per_byte` <br>
+   *    The cost the subarray partitioner charges per persisted (compressed)
+   *    tile byte fetched from storage. Only used when
+   *    `sm.partitioner.target_cost` is non-zero. <br>
+   *    **Default**: 1.0
+   * - `sm.partitioner.cpu_cost_per_byte` <br>
+   *    The cost the subarray partitioner charges per in-memory (unfiltered)
+   *    tile byte that has to be decoded. Only used when
+   *    `sm.partitioner.target_cost` is non-zero. <br>
+   *    **Default**: 0.0
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
@@ -306,6 +419,31 @@ class Config {
    * - `sm.io_concurrency_level` <br>
    *    Upper-bound on number of threads to allocate for IO-bound tasks. <br>
    *    **Default*: # cores
+   * - `sm.compute_affinity` <br>
+   *    The CPU affinity of the compute thread pool workers. Empty leaves them
+   *    unpinned, `numa` pins them round-robin to the NUMA nodes, and a cpuset
+   *    string such as `0-3,8` pins every worker to one of the listed CPUs,
+   *    round-robin. <br>
+   *    **Default**: ""
+   * - `sm.io_affinity` <br>
+   *    The CPU affinity of the io thread pool workers, in the same format as
+   *    `sm.compute_affinity`. Pinning the compute and io workers to CPUs not
+   *    used by the application isolates library threads from application
+   *    threads. <br>
+   *    **Default**: ""
+   * - `sm.shared_resources` <br>
+   *    If `true`, the context shares its compute and io thread pools with the
+   *    other contexts that enable this and configure the same concurrency
+   *    levels and affinities. Their VFS also share the S3 clients of identical
+   *    `vfs.s3.*` configurations. The stats of queries and VFS operations stay
+   *    per context. <br>
+   *    **Default**: false
+   * - `sm.thread_pool_stats` <br>
+   *    Whether the compute and io thread pools record their activity in the
+   *    context stats: the number of tasks submitted and executed, the maximum
+   *    queue depth, a histogram of the wait of the tasks before they start and
+   *    the busy and idle time of every worker. <br>
+   *    **Default**: false
    * - `sm.vacuum.mode` <br>
    *    The vacuuming mode, one of `fragments` (remove consolidated fragments),
    *    `fragment_meta` (remove only consolidated fragment metadata), or
@@ -341,6 +479,94 @@ class Config {
    *    The size (in bytes) of the attribute buffers used during
    *    consolidation. <br>
    *    **Default**: 50,000,000
+   * - `sm.consolidation.total_buffer_size` <br>
+   *    When above 0, the total size (in bytes) of the buffers of a fragment
+   *    consolidation step, replacing `sm.consolidation.buffer_size`. It is
+   *    split across the attribute and dimension buffers in proportion to their
+   *    average cell sizes in the fragments being consolidated, each buffer
+   *    holding at least one of their largest tiles. It is reserved from
+   *    `sm.mem.total_budget` when the memory governor is enabled, and halved
+   *    between the two sets of buffers when
+   *    `sm.consolidation.max_in_flight_bytes` is above 0. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.max_in_flight_bytes` <br>
+   *    When above 0, fragment consolidation streams the cells through two sets
+   *    of buffers of `sm.consolidation.buffer_size` bytes, reading the next
+   *    cells into one set while the cells of the other are written. The
+   *    consolidated tiles are then filtered and written in the background, with
+   *    at most this many bytes of tiles in flight. 0 reads and writes the cells
+   *    in turn. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.tile_copy` <br>
+   *    Whether sparse fragments are consolidated by copying their filtered
+   *    tiles, without unfiltering them, when their non-empty domains cover
+   *    disjoint space tiles that are ordered in the tile order, they have the
+   *    latest array schema and all but the last one end with a full tile. Only
+   *    the tile offsets, MBRs and tile metadata of the new fragment are
+   *    computed. Not applicable with Hilbert cell order, with var-sized
+   *    dimensions, or when `sm.coords_bloom_filter_bits_per_cell` or
+   *    `sm.attribute_index_names` are set. <br>
+   *    **Default**: false
+   * - `sm.consolidation.concurrent_budget` <br>
+   *    The total bytes of buffers that the consolidation steps of sparse
+   *    fragments may use concurrently. When above 0, the steps on disjoint sets
+   *    of fragments are planned up front and as many of them run concurrently
+   *    as their buffers fit in this budget, at least one; the new fragments are
+   *    then committed in timestamp order. 0 runs the steps one at a time. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.policy` <br>
+   *    The policy that selects the fragments of each consolidation step of
+   *    `fragments` mode. `size_ratio` selects the smallest set of adjacent
+   *    fragments that satisfies `sm.consolidation.step_min_frags`,
+   *    `sm.consolidation.step_max_frags`, `sm.consolidation.step_size_ratio`
+   *    and `sm.consolidation.amplification`. `size_tiered` groups the fragments
+   *    in tiers of sizes growing by `sm.consolidation.tier_fanout` from
+   *    `sm.consolidation.tier_base_size`, and consolidates the oldest run of
+   *    `sm.consolidation.tier_fanout` adjacent fragments of the same tier.
+   *    `leveled` consolidates a fragment with all the newer ones once their
+   *    total size reaches its size divided by `sm.consolidation.tier_fanout`,
+   *    so that every fragment is at least `sm.consolidation.tier_fanout` times
+   *    larger than the newer ones. The bytes rewritten are reported in the
+   *    `consolidate_rewritten_bytes` statistic. <br>
+   *    **Default**: size_ratio
+   * - `sm.consolidation.tier_fanout` <br>
+   *    The size ratio of consecutive tiers or levels of the `size_tiered` and
+   *    `leveled` consolidation policies, at least 2. <br>
+   *    **Default**: 4
+   * - `sm.consolidation.tier_base_size` <br>
+   *    The size in bytes under which fragments belong to the first tier of the
+   *    `size_tiered` consolidation policy. <br>
+   *    **Default**: 1048576
+   * - `sm.consolidation.auto.fragment_num` <br>
+   *    If greater than 0, closing a local array opened for writes schedules a
+   *    consolidation and vacuum of its fragments in the background once it has
+   *    at least this many fragments. These run at the `background` thread pool
+   *    priority with the consolidation and vacuum parameters of the context,
+   *    one at a time per array. The peak number of scheduled runs not yet
+   *    started is reported in the `auto_consolidation_backlog` statistic. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.auto.min_interval_ms` <br>
+   *    The minimum time in milliseconds between the starts of two background
+   *    consolidations of the same array scheduled by
+   *    `sm.consolidation.auto.fragment_num`. <br>
+   *    **Default**: 1000
+   * - `sm.consolidation.fragment_meta.max_deltas` <br>
+   *    The maximum number of deltas appended to a consolidated fragment
+   *    metadata file in `fragment_meta` mode. A delta holds the footers of the
+   *    fragments missing from the latest consolidated fragment metadata and its
+   *    deltas only. Once there are this many deltas, the next consolidation
+   *    merges the footers of all the fragments into a new file. The latest file
+   *    and its deltas are read at once when the array is opened. 0 rewrites all
+   *    the footers every time. <br>
+   *    **Default**: 0
+   * - `sm.consolidation.array_meta.max_deltas` <br>
+   *    The maximum number of consolidated array metadata files in `array_meta`
+   *    mode. While there are fewer, a consolidation merges only the array
+   *    metadata written after the latest consolidated file into a new one, and
+   *    the vacuum deletes only the merged files. Otherwise all the array
+   *    metadata is merged into a single file. 0 always merges all the array
+   *    metadata. <br>
+   *    **Default**: 0
    * - `sm.consolidation.steps` <br>
    *    The number of consolidation steps to be performed when executing
    *    the consolidation algorithm.<br>
@@ -367,6 +593,12 @@ class Config {
    *    `sm.consolidation.timestamp_start` and this value (inclusive). <br>
    *    Only for `fragments` and `array_meta` consolidation mode. <br>
    *    **Default**: UINT64_MAX
+   * - `sm.consolidation.priority` <br>
+   *    The thread pool priority of the tasks of consolidation and vacuuming,
+   *    either `normal` or `background`. Background tasks run after the pending
+   *    normal tasks, and occupy at most half of the worker threads, so that
+   *    they do not delay concurrent queries. <br>
+   *    **Default**: background
    * - `sm.memory_budget` <br>
    *    The memory budget for tiles of fixed-sized attributes (or offsets for
    *    var-sized attributes) to be fetched during reads.<br>
@@ -398,10 +630,99 @@ class Config {
    *    Which reader to use for sparse unordered with dups queries.
    *    "refactored" or "legacy".<br>
    *    **Default**: refactored
+   * - `sm.query.priority` <br>
+   *    The thread pool priority of the tasks of queries, either `normal` or
+   *    `background`. See `sm.consolidation.priority`. <br>
+   *    **Default**: normal
+   * - `sm.query.shared_scan` <br>
+   *    If `true`, concurrent read queries of a context needing the same tile
+   *    while it is being read share the read instead of each reading the tile.
+   *    Tiles read through memory mappings are not shared. <br>
+   *    **Default**: true
+   * - `sm.query.timeout_ms` <br>
+   *    The maximum time in milliseconds each submission of a query may run, 0
+   *    for no limit. A query past its deadline stops at the next tile and its
+   *    status becomes `TILEDB_CANCELLED`. <br>
+   *    **Default**: 0
+   * - `sm.async_query.max_concurrent` <br>
+   *    The maximum number of async queries of a context processed concurrently,
+   *    0 for no limit. The other async queries wait for admission, queued per
+   *    `sm.async_query.tag` and admitted round-robin across tags. <br>
+   *    **Default**: 0
+   * - `sm.async_query.tag` <br>
+   *    The client tag an async query is queued under for admission, set on the
+   *    query config. Queries of different tags are admitted round-robin, so a
+   *    burst of submissions under one tag does not starve the others. <br>
+   *    **Default**: ""
+   * - `sm.query.sparse_unordered_no_dups.reader` <br>
+   *    Which reader to use for sparse unordered queries on arrays that do not
+   *    allow duplicates. "refactored" or "legacy". The refactored reader
+   *    resolves overwrites tile by tile within the memory budget, but does
+   *    not return cells once per overlapping range like the legacy reader.
+   *    <br>
+   *    **Default**: legacy
+   * - `sm.query.dense.streaming_write` <br>
+   *    If `true`, dense writes in row-major or col-major layout accept the
+   *    subarray as a sequence of slabs over successive submits. Each submit
+   *    appends whole slices along the slowest dimension of the layout, and
+   *    space tiles are filtered and written as soon as they are complete. The
+   *    layout must match the tile order and the write must be finalized. <br>
+   *    **Default**: false
+   * - `sm.query.dense.elide_fill_tiles` <br>
+   *    If `true`, dense writes do not store the tiles of fixed-sized attributes
+   *    in which all the cells hold the fill value of the attribute (and its
+   *    fill validity, for nullable attributes). Such tiles are recorded with an
+   *    empty size in the fragment metadata, and reads produce the fill values
+   *    without any I/O or unfiltering. <br>
+   *    **Default**: true
    * - `sm.mem.malloc_trim` <br>
    *    Should malloc_trim be called on context and query destruction? This
    *    might reduce residual memory usage. <br>
    *    **Default**: true
+   * - `sm.mem.tile_buffer_pool_size` <br>
+   *    The maximum size, in bytes, of the idle tile buffers kept by a context
+   *    for reuse across queries. Tile buffers are allocated in size classes and
+   *    returned to the pool when freed. The idle buffers are released when
+   *    `sm.mem.malloc_trim` is called on query and context destruction, so
+   *    setting `sm.mem.malloc_trim` to false keeps them across queries. A
+   *    value of 0 disables the pool. <br>
+   *    **Default**: 0
+   * - `sm.mem.large_buffer.huge_pages` <br>
+   *    How tile buffers of at least `sm.mem.large_buffer.threshold` bytes are
+   *    backed by huge pages, to reduce TLB misses. With `none`, regular pages
+   *    are used. With `transparent`, transparent huge pages are requested for
+   *    them. With `explicit`, huge pages reserved by the system are used,
+   *    falling back to transparent huge pages if none are available. Only
+   *    supported on Linux. <br>
+   *    **Default**: none
+   * - `sm.mem.large_buffer.numa_local` <br>
+   *    If true, tile buffers of at least `sm.mem.large_buffer.threshold` bytes
+   *    are bound to the NUMA node of the thread that first writes them, which
+   *    is the compute thread unfiltering them, even if the process interleaves
+   *    its memory. Only supported on Linux. <br>
+   *    **Default**: false
+   * - `sm.mem.large_buffer.threshold` <br>
+   *    The smallest tile buffer size, in bytes, to which
+   *    `sm.mem.large_buffer.huge_pages` and `sm.mem.large_buffer.numa_local`
+   *    apply. Such buffers get their own memory mapping. <br>
+   *    **Default**: 4194304
+   * - `sm.mem.governor.enabled` <br>
+   *    If true, `sm.mem.total_budget` of the context bounds the memory of all
+   *    its concurrent sparse reads together. Each read reserves its own
+   *    `sm.mem.total_budget` from the context, the tile caches shedding their
+   *    tiles first. If not enough memory is available, the read runs with a
+   *    smaller budget, i.e. smaller batches, or waits for other reads to
+   *    release memory. <br>
+   *    **Default**: false
+   * - `sm.mem.governor.min_ratio` <br>
+   *    With `sm.mem.governor.enabled`, the smallest fraction of its budget a
+   *    read accepts to run with. Below that, the read waits for memory to be
+   *    released. <br>
+   *    **Default**: 0.25
+   * - `sm.mem.governor.timeout_ms` <br>
+   *    With `sm.mem.governor.enabled`, how long a read waits for memory to be
+   *    released, in milliseconds, before failing. <br>
+   *    **Default**: 10000
    * - `sm.mem.total_budget` <br>
    *    Memory budget for readers and writers. <br>
    *    **Default**: 10GB
@@ -437,6 +758,32 @@ class Config {
    *    Ratio of the budget allocated for array data in the sparse unordered
    *    with duplicates reader. <br>
    *    **Default**: 0.1
+   * - `sm.mem.writer.global_order.max_in_flight_bytes` <br>
+   *    Maximum number of bytes of full tiles that the global order writer
+   *    filters and writes in the background while the next buffers are
+   *    submitted. 0 filters and writes the tiles synchronously in each submit.
+   *    <br>
+   *    **Default**: 0
+   * - `sm.mem.writer.global_order.budget` <br>
+   *    Memory budget in bytes for the tiles the global order writer filters and
+   *    writes at once. Above 0, the full tiles of a submit are filtered and
+   *    written in batches that hold at most the budget divided by the number of
+   *    attributes and dimensions of tiles per attribute or dimension, and the
+   *    filtered buffers of a batch are freed once it is written. 0 filters all
+   *    the full tiles of a submit at once. <br>
+   *    **Default**: 0
+   * - `sm.mem.writer.unordered.spill_budget` <br>
+   *    Memory budget in bytes for merging the sorted runs that unordered writes
+   *    spill to disk. Above 0, each submit of an unordered write sorts its
+   *    cells and spills them as a run to `sm.mem.writer.unordered.spill_path`,
+   *    and finalizing the query merges all the runs into a single fragment in
+   *    global order. 0 writes a fragment per submit. <br>
+   *    **Default**: 0
+   * - `sm.mem.writer.unordered.spill_path` <br>
+   *    Directory (or URI) where unordered writes spill their sorted runs when
+   *    `sm.mem.writer.unordered.spill_budget` is above 0. An empty value uses
+   *    the temporary directory of the system. <br>
+   *    **Default**: ""
    *    The maximum byte size to read-ahead from the backend. <br>
    *    **Default**: 102400
    * -  `vfs.read_ahead_cache_size` <br>
@@ -454,6 +801,24 @@ class Config {
    * - `vfs.min_batch_gap` <br>
    *    The minimum number of bytes between two VFS read batches.<br>
    *    **Default**: 500KB
+   * - `vfs.adaptive_batch_gap` <br>
+   *    If `true`, the VFS keeps a moving estimate of the request latency and
+   *    bandwidth of each backend from its batched reads, and merges read
+   *    regions separated by at most latency x bandwidth bytes, instead of
+   *    `vfs.min_batch_gap`. `vfs.min_batch_gap` is used until enough reads were
+   *    observed. <br>
+   *    **Default**: false
+   * - `vfs.disk_cache.path` <br>
+   *    A local directory caching the reads of immutable objects (e.g. fragment
+   *    data) from `s3://`, `gcs://` and `azure://` URIs across processes and
+   *    restarts. The directory can be shared by concurrent processes. If empty,
+   *    the disk cache is disabled. <br>
+   *    **Default**: ""
+   * - `vfs.disk_cache.max_size` <br>
+   *    The maximum total size (in bytes) of the disk cache in
+   *    `vfs.disk_cache.path`. The least recently read entries are evicted
+   *    beyond it. <br>
+   *    **Default**: 10GB
    * - `vfs.file.posix_file_permissions` <br>
    *    permissions to use for posix file system with file or dir creation.<br>
    *    **Default**: 644
@@ -464,6 +829,37 @@ class Config {
    *    The maximum number of parallel operations on objects with `file:///`
    *    URIs. <br>
    *    **Default**: `sm.io_concurrency_level`
+   * - `vfs.file.io_uring` <br>
+   *    If `true`, batched reads and parallel writes of objects with `file:///`
+   *    URIs are submitted to the Linux io_uring interface at once, instead of
+   *    being issued as blocking calls from the VFS thread pool. Falls back to
+   *    blocking calls where io_uring is unavailable. <br>
+   *    **Default**: false
+   * - `vfs.file.overlapped_io` <br>
+   *    If `true`, on Windows, batched reads and parallel writes of objects with
+   *    `file:///` URIs are issued at once as overlapped I/O and reaped from an
+   *    I/O completion port, instead of being issued as blocking calls from the
+   *    VFS thread pool. <br>
+   *    **Default**: false
+   * - `vfs.file.direct_io` <br>
+   *    If `true`, reads of objects with `file:///` URIs bypass the operating
+   *    system page cache (`O_DIRECT`), reading block-aligned ranges. Falls back
+   *    to regular reads where direct I/O is unsupported. <br>
+   *    **Default**: false
+   * - `vfs.file.mmap` <br>
+   *    If `true`, tiles of objects with `file:///` URIs are read by mapping
+   *    each file into memory once, until the array is closed, and viewing the
+   *    tile bytes in the mapping instead of copying them into allocated
+   *    buffers. Best suited to read-mostly arrays on local disks or tmpfs. <br>
+   *    **Default**: false
+   * - `vfs.file.group_commit` <br>
+   *    If `true`, the files a writer stores in a fragment with a `file:///` URI
+   *    are not synced one by one when they are closed. Instead, all the files
+   *    of the fragment, together with those of any other fragment being
+   *    committed at the same time, are synced in parallel right before the
+   *    fragment commit file is written. Fragments are exactly as durable once
+   *    committed, with far fewer sync calls. <br>
+   *    **Default**: false
    * - `vfs.azure.storage_account_name` <br>
    *    Set the Azure Storage Account name. <br>
    *    **Default**: ""
@@ -487,6 +883,11 @@ class Config {
    * - `vfs.azure.max_parallel_ops` <br>
    *    The maximum number of Azure backend parallel operations. <br>
    *    **Default**: `sm.io_concurrency_level`
+   * - `vfs.azure.read_part_size` <br>
+   *    The minimum size (in bytes) of each of the concurrent ranged downloads a
+   *    large Azure read is split into, up to `vfs.azure.max_parallel_ops` of
+   *    them. If 0, `vfs.min_parallel_size` is used. <br>
+   *    **Default**: 0
    * - `vfs.azure.use_block_list_upload` <br>
    *    Determines if the Azure backend can use chunked block uploads. <br>
    *    **Default**: "true"
@@ -505,6 +906,11 @@ class Config {
    * - `vfs.gcs.max_parallel_ops` <br>
    *    The maximum number of GCS backend parallel operations. <br>
    *    **Default**: `sm.io_concurrency_level`
+   * - `vfs.gcs.read_part_size` <br>
+   *    The minimum size (in bytes) of each of the concurrent ranged downloads a
+   *    large GCS read is split into, up to `vfs.gcs.max_parallel_ops` of them.
+   *    If 0, `vfs.min_parallel_size` is used. <br>
+   *    **Default**: 0
    * - `vfs.gcs.use_multi_part_upload` <br>
    *    Determines if the GCS backend can use chunked part uploads. <br>
    *    **Default**: "true"
@@ -566,6 +972,11 @@ class Config {
    *    vfs.s3.max_parallel_ops` bytes will be buffered before issuing multipart
    *    uploads in parallel. <br>
    *    **Default**: 5MB
+   * - `vfs.s3.read_part_size` <br>
+   *    The minimum size (in bytes) of each of the concurrent byte-range GETs a
+   *    large S3 read is split into, up to `vfs.s3.max_parallel_ops` of them. If
+   *    0, `vfs.min_parallel_size` is used. <br>
+   *    **Default**: 0
    * - `vfs.s3.ca_file` <br>
    *    Path to SSL/TLS certificate file to be used by cURL for for S3 HTTPS
    *    encryption. Follows cURL conventions:
@@ -594,6 +1005,16 @@ class Config {
    * - `vfs.s3.request_timeout_ms` <br>
    *    The request timeout in ms. Any `long` value is acceptable. <br>
    *    **Default**: 3000
+   * - `vfs.s3.hedge_percentile` <br>
+   *    If in (0, 100), an S3 GET that is slower than this percentile of the
+   *    recently observed GET latencies is hedged: a duplicate request is
+   *    issued, the first response is used and the other request is cancelled.
+   *    `0` disables hedging. <br>
+   *    **Default**: 0
+   * - `vfs.s3.hedge_max_ratio` <br>
+   *    The maximum ratio of hedged S3 GETs to all S3 GETs, which caps the extra
+   *    load of `vfs.s3.hedge_percentile`. <br>
+   *    **Default**: 0.05
    * - `vfs.s3.requester_pays` <br>
    *    The requester pays for the S3 access charges. <br>
    *    **Default**: false
@@ -650,6 +1071,16 @@ class Config {
    * - `vfs.hdfs.kerb_ticket_cache_path` <br>
    *    HDFS kerb ticket cache path. <br>
    *    **Default**: ""
+   * - `vfs.hdfs.short_circuit_reads` <br>
+   *    If `true`, the HDFS client reads blocks stored on the local datanode
+   *    directly from disk (`dfs.client.read.shortcircuit`), instead of
+   *    streaming them through the datanode. <br>
+   *    **Default**: false
+   * - `vfs.hdfs.domain_socket_path` <br>
+   *    The UNIX domain socket shared with the local datanode for short-circuit
+   *    reads (`dfs.domain.socket.path`). If empty, the value of the Hadoop
+   *    configuration files is used. <br>
+   *    **Default**: ""
    * - `config.env_var_prefix` <br>
    *    Prefix of environmental variables for reading configuration
    *    parameters. <br>
@@ -705,6 +1136,45 @@ class Config {
    *    The delay factor to exponentially wait until further retries of a
    *    failed REST request <br>
    *    **Default**: 1.25
+   * - `rest.share_connections` <br>
+   *    If true, the requests of a context share a pool of connections, TLS
+   *    sessions and DNS entries, so that consecutive and concurrent requests to
+   *    the REST server reuse kept-alive connections instead of performing new
+   *    TLS handshakes. <br>
+   *    **Default**: true
+   * - `rest.http2` <br>
+   *    If true, HTTP/2 is negotiated with the REST server over TLS, falling
+   *    back to HTTP/1.1 if the server or libcurl does not support it. <br>
+   *    **Default**: true
+   * - `rest.request_compressor` <br>
+   *    The content encoding of the serialized queries posted to the REST
+   *    server, either `none` or `zstd`. Large payloads are compressed in
+   *    parallel as independent zstd frames, which decode as one stream.
+   *    Responses are compressed as negotiated with `rest.http_compressor`,
+   *    whose `any` default includes zstd when libcurl supports it. <br>
+   *    **Default**: none
+   * - `rest.request_compression_min_size` <br>
+   *    The minimum size in bytes of a serialized query to be compressed with
+   *    `rest.request_compressor`. <br>
+   *    **Default**: 1048576
+   * - `rest.prefetch_incomplete` <br>
+   *    If true and `rest.resubmit_incomplete` is false, an incomplete read on a
+   *    remote array speculatively submits its next partition in the background
+   *    while the user consumes the current results. The next submission of the
+   *    query uses the prefetched response if it is unchanged. <br>
+   *    **Default**: false
+   * - `rest.submit_array_state` <br>
+   *    If true, queries submitted to the REST server include the state of their
+   *    open array, i.e. its array schemas, non-empty domain and metadata. If
+   *    false, only the array URI and timestamps are sent and the server uses
+   *    the state of the array it opens itself, which saves sending hundreds of
+   *    KB for wide schemas on every small query. <br>
+   *    **Default**: true
+   * - `rest.pipeline_array_open` <br>
+   *    If true, opening a remote array for reads also fetches its non-empty
+   *    domain and metadata, concurrently with its array schema, instead of one
+   *    round trip each when they are first used. <br>
+   *    **Default**: false
    */
   Config& set(const std::string& param, const std::string& value) {
     tiledb_error_t* err;
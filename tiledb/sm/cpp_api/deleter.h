@@ -95,6 +95,10 @@ class Deleter {
     tiledb_array_schema_evolution_free(&p);
   }
 
+  void operator()(tiledb_array_snapshot_t* p) const {
+    tiledb_array_snapshot_free(&p);
+  }
+
   void operator()(tiledb_attribute_t* p) const {
     tiledb_attribute_free(&p);
   }
@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace tiledb {
 
@@ -233,6 +234,69 @@ class Filter {
         ctx.ptr().get(), filter_.get(), option, value));
   }
 
+  /**
+   * Trains a dictionary for a ZStd filter on sample data, such as tiles of an
+   * existing array. The dictionary is stored with the filter in the array
+   * schema.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Filter f(ctx, TILEDB_FILTER_ZSTD);
+   * std::vector<std::string> samples = ...;
+   * f.train_zstd_dictionary(samples, 16 * 1024);
+   * @endcode
+   *
+   * @param samples The samples to train on.
+   * @param max_dictionary_size The maximum size in bytes of the dictionary.
+   * @return Reference to this Filter
+   * @throws TileDBError if the dictionary cannot be trained.
+   */
+  Filter& train_zstd_dictionary(
+      const std::vector<std::string>& samples, uint64_t max_dictionary_size) {
+    auto& ctx = ctx_.get();
+    std::vector<const void*> sample_data;
+    std::vector<uint64_t> sample_sizes;
+    for (const auto& sample : samples) {
+      sample_data.push_back(sample.data());
+      sample_sizes.push_back(sample.size());
+    }
+    ctx.handle_error(tiledb_filter_train_zstd_dictionary(
+        ctx.ptr().get(),
+        filter_.get(),
+        sample_data.data(),
+        sample_sizes.data(),
+        static_cast<uint32_t>(samples.size()),
+        max_dictionary_size));
+    return *this;
+  }
+
+  /**
+   * Sets the dictionary of a ZStd filter. An empty dictionary removes the
+   * dictionary.
+   *
+   * @param dictionary The dictionary.
+   * @return Reference to this Filter
+   * @throws TileDBError if the dictionary cannot be set.
+   */
+  Filter& set_zstd_dictionary(const std::string& dictionary) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_filter_set_zstd_dictionary(
+        ctx.ptr().get(), filter_.get(), dictionary.data(), dictionary.size()));
+    return *this;
+  }
+
+  /** Returns the dictionary of a ZStd filter, empty if there is none. */
+  std::string zstd_dictionary() const {
+    auto& ctx = ctx_.get();
+    const void* dictionary;
+    uint64_t size;
+    ctx.handle_error(tiledb_filter_get_zstd_dictionary(
+        ctx.ptr().get(), filter_.get(), &dictionary, &size));
+    return size == 0 ? std::string() :
+                       std::string(static_cast<const char*>(dictionary), size);
+  }
+
   /** Gets the filter type of this filter. */
   tiledb_filter_type_t filter_type() const {
     auto& ctx = ctx_.get();
@@ -275,6 +339,18 @@ class Filter {
         return "CHECKSUM_MD5";
       case TILEDB_FILTER_CHECKSUM_SHA256:
         return "CHECKSUM_SHA256";
+      case TILEDB_FILTER_DICTIONARY:
+        return "DICTIONARY";
+      case TILEDB_FILTER_FRAME_OF_REFERENCE:
+        return "FRAME_OF_REFERENCE";
+      case TILEDB_FILTER_FLOAT_XOR:
+        return "FLOAT_XOR";
+      case TILEDB_FILTER_AUTO_COMPRESSION:
+        return "AUTO_COMPRESSION";
+      case TILEDB_FILTER_CHECKSUM_CRC32C:
+        return "CHECKSUM_CRC32C";
+      case TILEDB_FILTER_BITMAP:
+        return "BITMAP";
     }
     return "";
   }
@@ -310,6 +386,7 @@ class Filter {
         break;
       case TILEDB_BIT_WIDTH_MAX_WINDOW:
       case TILEDB_POSITIVE_DELTA_MAX_WINDOW:
+      case TILEDB_AUTO_COMPRESSION_SPEED_BIAS:
         if (!std::is_same<uint32_t, T>::value)
           throw std::invalid_argument("Option value must be uint32_t.");
         break;
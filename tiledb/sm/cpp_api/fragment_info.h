@@ -96,6 +96,16 @@ class FragmentInfo {
         (uint32_t)encryption_key.size()));
   }
 
+  /**
+   * Refreshes the fragment info with the fragments written and removed
+   * since it was loaded, loading only the metadata of the new fragments.
+   */
+  void refresh() const {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(
+        tiledb_fragment_info_refresh(ctx.ptr().get(), fragment_info_.get()));
+  }
+
   /** Returns the URI of the fragment with the given index. */
   std::string fragment_uri(uint32_t fid) const {
     auto& ctx = ctx_.get();
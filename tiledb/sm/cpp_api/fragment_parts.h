@@ -0,0 +1,118 @@
+/**
+ * @file   fragment_parts.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the experimental C++ API for writing a dense fragment
+ * in parts.
+ */
+
+#ifndef TILEDB_CPP_API_FRAGMENT_PARTS_H
+#define TILEDB_CPP_API_FRAGMENT_PARTS_H
+
+#include "array.h"
+#include "context.h"
+#include "query.h"
+#include "tiledb.h"
+#include "tiledb_experimental.h"
+
+#include <string>
+#include <vector>
+
+namespace tiledb {
+
+/**
+ * Generates the URI of a new dense fragment to be written in parts by
+ * several writers, possibly in different processes, which each write a
+ * slab of the fragment with `set_fragment_part`. Once all the parts are
+ * written, `commit_fragment_parts` makes the fragment visible.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Array array(ctx, "my_array", TILEDB_WRITE);
+ * auto uri = tiledb::new_fragment_parts_uri(ctx, array);
+ * // Each writer, with its own array opened for writes:
+ * tiledb::Query query(ctx, array, TILEDB_WRITE);
+ * query.set_layout(TILEDB_ROW_MAJOR).set_subarray(slab);
+ * query.set_data_buffer("a", a);
+ * tiledb::set_fragment_part(ctx, query, uri, part);
+ * query.submit();
+ * // Once all the parts are written:
+ * tiledb::commit_fragment_parts(ctx, array, uri);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param array The array, opened for writes.
+ * @return The URI of the fragment.
+ */
+inline std::string new_fragment_parts_uri(
+    const Context& ctx, const Array& array) {
+  std::vector<char> uri(TILEDB_MAX_PATH);
+  auto length = static_cast<uint32_t>(uri.size());
+  ctx.handle_error(tiledb_array_new_fragment_parts_uri(
+      ctx.ptr().get(), array.ptr().get(), uri.data(), &length));
+  return std::string(uri.data(), length);
+}
+
+/**
+ * Makes a dense write query write a part of a fragment written in parts.
+ * The query subarray must be a slab along the slowest varying dimension of
+ * the tile order, starting and ending on tile boundaries where it meets
+ * the other parts.
+ *
+ * @param ctx TileDB context.
+ * @param query The dense write query, not yet submitted.
+ * @param fragment_uri The URI of the fragment written in parts.
+ * @param part The number of the part, unique within the fragment.
+ */
+inline void set_fragment_part(
+    const Context& ctx,
+    Query& query,
+    const std::string& fragment_uri,
+    uint32_t part) {
+  ctx.handle_error(tiledb_query_set_fragment_part(
+      ctx.ptr().get(), query.ptr().get(), fragment_uri.c_str(), part));
+}
+
+/**
+ * Commits a fragment written in parts, once all its parts are written,
+ * merging the metadata of the parts without rewriting their tiles.
+ *
+ * @param ctx TileDB context.
+ * @param array The array, opened for writes.
+ * @param fragment_uri The URI of the fragment written in parts.
+ */
+inline void commit_fragment_parts(
+    const Context& ctx, const Array& array, const std::string& fragment_uri) {
+  ctx.handle_error(tiledb_array_commit_fragment_parts(
+      ctx.ptr().get(), array.ptr().get(), fragment_uri.c_str()));
+}
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_FRAGMENT_PARTS_H
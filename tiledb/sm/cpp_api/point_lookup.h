@@ -0,0 +1,318 @@
+/**
+ * @file   point_lookup.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the experimental C++ API for batched point lookups.
+ */
+
+#ifndef TILEDB_CPP_API_POINT_LOOKUP_H
+#define TILEDB_CPP_API_POINT_LOOKUP_H
+
+#include "array.h"
+#include "context.h"
+#include "query.h"
+#include "subarray.h"
+#include "tiledb.h"
+#include "tiledb_experimental.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+
+/**
+ * Looks up a batch of single cells of a sparse array with a single read
+ * query, instead of one query per cell.
+ *
+ * The distinct coordinates of the points are sorted and added per
+ * dimension as point ranges in bulk, so that the tile overlap of all the
+ * points is computed in one pass over the R-tree of each fragment and all
+ * the touched tiles are read and unfiltered in one batch. The cells read
+ * are then matched back to the input points, in their input order.
+ *
+ * For arrays with more than one dimension, the ranges select the cross
+ * product of the point coordinates, so cells that are not among the input
+ * points may be read and discarded. Arrays with duplicates return the first
+ * matching cell of each point.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Array array(ctx, "my_array", TILEDB_READ);
+ * tiledb::PointLookup<int32_t> lookup(ctx, array);
+ * lookup.add_point({1, 2}).add_point({4, 3}).add_attribute("a");
+ * lookup.submit();
+ * if (lookup.found(1))
+ *   std::cout << lookup.value<float>("a", 1) << "\n";
+ * @endcode
+ *
+ * @tparam T The type of all the array dimensions.
+ */
+template <typename T>
+class PointLookup {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param ctx TileDB context.
+   * @param array The sparse array to look up, opened for reads.
+   */
+  PointLookup(const Context& ctx, const Array& array)
+      : ctx_(ctx)
+      , array_(array)
+      , schema_(array.schema()) {
+    if (schema_.array_type() != TILEDB_SPARSE)
+      throw TileDBError(
+          "[TileDB::C++API] Error: Point lookups apply only to sparse arrays");
+
+    auto domain = schema_.domain();
+    for (const auto& dim : domain.dimensions()) {
+      impl::type_check<T>(dim.type());
+      dim_names_.emplace_back(dim.name());
+    }
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Adds a point to look up.
+   *
+   * @param coords The coordinates of the point, one per dimension.
+   * @return Reference to this `PointLookup`.
+   */
+  PointLookup& add_point(const std::vector<T>& coords) {
+    if (coords.size() != dim_names_.size())
+      throw TileDBError(
+          "[TileDB::C++API] Error: Cannot add point; The number of "
+          "coordinates must match the number of dimensions");
+
+    points_.insert(points_.end(), coords.begin(), coords.end());
+    return *this;
+  }
+
+  /**
+   * Adds a fixed-sized attribute to retrieve for the found points.
+   *
+   * @param name The attribute name.
+   * @return Reference to this `PointLookup`.
+   */
+  PointLookup& add_attribute(const std::string& name) {
+    auto attr = schema_.attribute(name);
+    if (attr.variable_sized())
+      throw TileDBError(
+          "[TileDB::C++API] Error: Cannot add attribute; Point lookups "
+          "support only fixed-sized attributes");
+
+    attr_names_.emplace_back(name);
+    attr_cell_sizes_.emplace_back(attr.cell_size());
+    attr_values_.emplace_back();
+    return *this;
+  }
+
+  /** Returns the number of points added. */
+  uint64_t point_num() const {
+    return points_.size() / dim_names_.size();
+  }
+
+  /**
+   * Looks up all the points added, with one read query. The query is
+   * resubmitted until complete if the results do not fit in buffers sized
+   * for one cell per point.
+   */
+  void submit() {
+    const uint64_t point_num = this->point_num();
+    const uint64_t dim_num = dim_names_.size();
+    found_.assign(point_num, false);
+    result_idx_.assign(point_num, 0);
+    for (auto& values : attr_values_)
+      values.clear();
+    if (point_num == 0)
+      return;
+
+    // Add the distinct, sorted coordinates of each dimension in bulk
+    auto& ctx = ctx_.get();
+    Subarray subarray(ctx, array_.get());
+    for (uint32_t d = 0; d < dim_num; ++d) {
+      std::vector<T> coords(point_num);
+      for (uint64_t p = 0; p < point_num; ++p)
+        coords[p] = points_[p * dim_num + d];
+      std::sort(coords.begin(), coords.end());
+      coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+      ctx.handle_error(tiledb_subarray_add_point_ranges(
+          ctx.ptr().get(),
+          subarray.ptr().get(),
+          d,
+          coords.data(),
+          coords.size()));
+    }
+
+    // Index the points by their coordinates
+    std::map<std::vector<T>, std::vector<uint64_t>> point_map;
+    for (uint64_t p = 0; p < point_num; ++p) {
+      std::vector<T> key(
+          points_.begin() + p * dim_num, points_.begin() + (p + 1) * dim_num);
+      point_map[std::move(key)].emplace_back(p);
+    }
+
+    Query query(ctx, array_.get(), TILEDB_READ);
+    query.set_layout(TILEDB_UNORDERED).set_subarray(subarray);
+    std::vector<std::vector<T>> coord_buffers(
+        dim_num, std::vector<T>(point_num));
+    std::vector<std::vector<uint8_t>> attr_buffers(attr_names_.size());
+    for (size_t a = 0; a < attr_names_.size(); ++a)
+      attr_buffers[a].resize(point_num * attr_cell_sizes_[a]);
+
+    uint64_t found_num = 0;
+    do {
+      for (uint32_t d = 0; d < dim_num; ++d)
+        query.set_data_buffer(dim_names_[d], coord_buffers[d]);
+      for (size_t a = 0; a < attr_names_.size(); ++a) {
+        auto type = schema_.attribute(attr_names_[a]).type();
+        query.set_data_buffer(
+            attr_names_[a],
+            (void*)attr_buffers[a].data(),
+            attr_buffers[a].size() / tiledb_datatype_size(type));
+      }
+      query.submit();
+
+      // Match the cells read to the points they were looked up for
+      const uint64_t cell_num =
+          query.result_buffer_elements()[dim_names_[0]].second;
+      std::vector<T> key(dim_num);
+      for (uint64_t c = 0; c < cell_num; ++c) {
+        for (uint32_t d = 0; d < dim_num; ++d)
+          key[d] = coord_buffers[d][c];
+        auto it = point_map.find(key);
+        if (it == point_map.end() || found_[it->second[0]])
+          continue;
+
+        for (size_t a = 0; a < attr_names_.size(); ++a) {
+          const uint8_t* value = &attr_buffers[a][c * attr_cell_sizes_[a]];
+          attr_values_[a].insert(
+              attr_values_[a].end(), value, value + attr_cell_sizes_[a]);
+        }
+        for (auto p : it->second) {
+          found_[p] = true;
+          result_idx_[p] = found_num;
+        }
+        ++found_num;
+      }
+    } while (query.query_status() == Query::Status::INCOMPLETE);
+  }
+
+  /**
+   * Returns whether the point with the input index was found in the array.
+   *
+   * @param point_idx The index of the point, in the order it was added.
+   */
+  bool found(uint64_t point_idx) const {
+    return point_idx < found_.size() && found_[point_idx];
+  }
+
+  /**
+   * Returns the value of a fixed-sized attribute for a found point.
+   *
+   * @tparam V The attribute value type.
+   * @param name The attribute name, as passed to `add_attribute`.
+   * @param point_idx The index of the point, in the order it was added.
+   * @return The attribute value of the point.
+   */
+  template <typename V>
+  V value(const std::string& name, uint64_t point_idx) const {
+    if (!found(point_idx))
+      throw TileDBError(
+          "[TileDB::C++API] Error: Cannot get value; Point was not found");
+
+    auto it = std::find(attr_names_.begin(), attr_names_.end(), name);
+    if (it == attr_names_.end())
+      throw TileDBError(
+          "[TileDB::C++API] Error: Cannot get value; Attribute '" + name +
+          "' was not added to the lookup");
+
+    const size_t a = it - attr_names_.begin();
+    if (sizeof(V) != attr_cell_sizes_[a])
+      throw TileDBError(
+          "[TileDB::C++API] Error: Cannot get value; Type size does not "
+          "match the attribute cell size");
+
+    V value;
+    std::memcpy(
+        &value,
+        &attr_values_[a][result_idx_[point_idx] * attr_cell_sizes_[a]],
+        sizeof(V));
+    return value;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** The array to look up. */
+  std::reference_wrapper<const Array> array_;
+
+  /** The array schema. */
+  ArraySchema schema_;
+
+  /** The dimension names. */
+  std::vector<std::string> dim_names_;
+
+  /** The coordinates of the points, one point after the other. */
+  std::vector<T> points_;
+
+  /** The names of the attributes to retrieve. */
+  std::vector<std::string> attr_names_;
+
+  /** The cell sizes of the attributes to retrieve. */
+  std::vector<uint64_t> attr_cell_sizes_;
+
+  /** The attribute values of the found points, per attribute. */
+  std::vector<std::vector<uint8_t>> attr_values_;
+
+  /** Whether each point was found. */
+  std::vector<bool> found_;
+
+  /** The index of the values of each found point in `attr_values_`. */
+  std::vector<uint64_t> result_idx_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_POINT_LOOKUP_H
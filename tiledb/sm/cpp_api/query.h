@@ -98,7 +98,9 @@ class Query {
     /** Query completed (but not all data has been read) */
     INCOMPLETE,
     /** Query not initialized.  */
-    UNINITIALIZED
+    UNINITIALIZED,
+    /** Query cancelled or past its deadline. */
+    CANCELLED
   };
 
   /* ********************************* */
@@ -246,6 +248,171 @@ class Query {
     return *this;
   }
 
+  /**
+   * Adds an aggregate to compute in a read query. A query with aggregates
+   * returns no cells and must not have any buffer set.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.add_aggregate("a", TILEDB_AGGREGATE_SUM);
+   * query.submit();
+   * int64_t sum;
+   * query.get_aggregate("a", TILEDB_AGGREGATE_SUM, &sum);
+   * @endcode
+   *
+   * @param name The attribute/dimension to aggregate.
+   * @param op The aggregate operator.
+   * @return Reference to this Query
+   */
+  Query& add_aggregate(
+      const std::string& name, tiledb_query_aggregate_op_t op) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_add_aggregate(
+        ctx.ptr().get(), query_.get(), name.c_str(), op));
+    return *this;
+  }
+
+  /**
+   * Retrieves the result of an aggregate once the query is completed. See
+   * `tiledb_query_get_aggregate` for the type of the result.
+   *
+   * @param name The aggregated attribute/dimension.
+   * @param op The aggregate operator.
+   * @param value Set to the result.
+   * @return `false` if there is no result, i.e. no non-null cell was
+   *     aggregated by a SUM, MIN or MAX aggregate.
+   */
+  template <typename T>
+  bool get_aggregate(
+      const std::string& name, tiledb_query_aggregate_op_t op, T* value) {
+    auto& ctx = ctx_.get();
+    uint64_t value_size = sizeof(T);
+    ctx.handle_error(tiledb_query_get_aggregate(
+        ctx.ptr().get(), query_.get(), name.c_str(), op, value, &value_size));
+    return value_size != 0;
+  }
+
+  /**
+   * Groups the aggregates of a read of a sparse array by buckets of the
+   * values of an integer or datetime dimension: a cell with coordinate `x`
+   * falls in bucket `floor(x / bucket_width)`.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.add_aggregate("a", TILEDB_AGGREGATE_SUM)
+   *     .set_aggregate_group_by("ts", 3600);
+   * query.submit();
+   * for (uint64_t b = 0; b < query.aggregate_bucket_num(); b++) {
+   *   int64_t hour, sum;
+   *   query.get_aggregate_bucket(b, "a", TILEDB_AGGREGATE_SUM, &hour, &sum);
+   * }
+   * @endcode
+   *
+   * @param dim_name The dimension to group by.
+   * @param bucket_width The width of the buckets, in dimension units.
+   * @return Reference to this Query
+   */
+  Query& set_aggregate_group_by(
+      const std::string& dim_name, uint64_t bucket_width) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_aggregate_group_by(
+        ctx.ptr().get(), query_.get(), dim_name.c_str(), bucket_width));
+    return *this;
+  }
+
+  /**
+   * Returns the number of non-empty buckets of a completed query whose
+   * aggregates are grouped by a dimension.
+   */
+  uint64_t aggregate_bucket_num() {
+    auto& ctx = ctx_.get();
+    uint64_t bucket_num = 0;
+    ctx.handle_error(tiledb_query_get_aggregate_bucket_num(
+        ctx.ptr().get(), query_.get(), &bucket_num));
+    return bucket_num;
+  }
+
+  /**
+   * Retrieves the result of an aggregate for a bucket of a completed query
+   * whose aggregates are grouped by a dimension. The buckets are sorted in
+   * increasing order.
+   *
+   * @param bucket_idx The index of the bucket.
+   * @param name The aggregated attribute/dimension.
+   * @param op The aggregate operator.
+   * @param bucket Set to the bucket.
+   * @param value Set to the result.
+   * @return `false` if there is no result.
+   */
+  template <typename T>
+  bool get_aggregate_bucket(
+      uint64_t bucket_idx,
+      const std::string& name,
+      tiledb_query_aggregate_op_t op,
+      int64_t* bucket,
+      T* value) {
+    auto& ctx = ctx_.get();
+    uint64_t value_size = sizeof(T);
+    ctx.handle_error(tiledb_query_get_aggregate_bucket(
+        ctx.ptr().get(),
+        query_.get(),
+        bucket_idx,
+        name.c_str(),
+        op,
+        bucket,
+        value,
+        &value_size));
+    return value_size != 0;
+  }
+
+  /**
+   * Makes an unordered read of a sparse array return a random sample of
+   * the cells, each kept with probability `fraction`. The same seed on the
+   * same opened array returns the same cells.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.set_layout(TILEDB_UNORDERED).set_sample(0.01, 42);
+   * @endcode
+   *
+   * @param fraction The fraction of the cells to sample, in (0, 1].
+   * @param seed The seed of the sample.
+   * @return Reference to this Query
+   */
+  Query& set_sample(double fraction, uint64_t seed) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(
+        tiledb_query_set_sample(ctx.ptr().get(), query_.get(), fraction, seed));
+    return *this;
+  }
+
+  /**
+   * Makes an unordered read of a sparse array return only the `k` cells
+   * with the largest (or smallest) values of an attribute. The cells are
+   * not returned in the order of the attribute.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.set_layout(TILEDB_UNORDERED).set_top_k("score", 100);
+   * @endcode
+   *
+   * @param name The attribute to order on.
+   * @param k The number of cells to return.
+   * @param largest True to return the largest values, false for the
+   *     smallest.
+   * @return Reference to this Query
+   */
+  Query& set_top_k(const std::string& name, uint64_t k, bool largest = true) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_top_k(
+        ctx.ptr().get(), query_.get(), name.c_str(), k, largest));
+    return *this;
+  }
+
   /** Returns the array of the query. */
   const Array& array() {
     return array_;
@@ -272,6 +439,29 @@ class Query {
     return (bool)ret;
   }
 
+  /**
+   * Prepares a read query to be executed repeatedly. The query is
+   * validated and its reader is created once. Setting a new subarray after
+   * the query completed keeps the reader, and the next submission only
+   * rebinds the subarray and the buffers.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * query.set_subarray(subarray).set_data_buffer("a", data).prepare();
+   * query.submit();
+   * // Set the next ranges and reset the buffers
+   * query.set_subarray(next_subarray).set_data_buffer("a", data);
+   * query.submit();
+   * @endcode
+   *
+   * @return Reference to this Query
+   */
+  Query& prepare() {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_prepare(ctx.ptr().get(), query_.get()));
+    return *this;
+  }
+
   /**
    * Submits the query. Call will block until query is complete.
    *
@@ -337,6 +527,53 @@ class Query {
     submit_async([]() {});
   }
 
+  /**
+   * Cancels the query. This may be called from another thread while the
+   * query is in progress. The query then stops at the next tile and its
+   * status becomes `Status::CANCELLED`. A cancelled query cannot be
+   * submitted again.
+   */
+  void cancel() {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_cancel(ctx.ptr().get(), query_.get()));
+  }
+
+  /**
+   * Sets a function called while a read query on a remote array is
+   * submitted, every time a chunk of the server response has been copied
+   * into the user buffers. It receives the name of every buffer set on the
+   * query and the number of bytes of its offsets, data and validity buffers
+   * filled so far in the current submission. Those bytes are final, so they
+   * can be consumed before the submission completes. Queries on local
+   * arrays never call the function.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * query.set_partial_results_callback(
+   *     [](const std::string& name, uint64_t offsets_size,
+   *        uint64_t data_size, uint64_t validity_size) {
+   *       // Process the new results of buffer `name`
+   *     });
+   * @endcode
+   *
+   * @param callback The function to be called.
+   * @return Reference to this Query
+   */
+  Query& set_partial_results_callback(
+      std::function<void(const std::string&, uint64_t, uint64_t, uint64_t)>
+          callback) {
+    auto& ctx = ctx_.get();
+    partial_results_callback_ = std::make_shared<
+        std::function<void(const std::string&, uint64_t, uint64_t, uint64_t)>>(
+        std::move(callback));
+    ctx.handle_error(tiledb_query_set_partial_results_callback(
+        ctx.ptr().get(),
+        query_.get(),
+        partial_results_trampoline,
+        partial_results_callback_.get()));
+    return *this;
+  }
+
   /**
    * Flushes all internal state of a query object and finalizes the query.
    * This is applicable only to global layout writes. It has no effect for
@@ -976,6 +1213,63 @@ class Query {
     return {size_off, size_val, size_validity};
   }
 
+  /**
+   * Retrieves the estimated result size for an attribute or dimension,
+   * accounting for the query condition set on the query through the tile
+   * min/max and null count metadata.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * std::array<uint64_t, 3> est_size =
+   *     query.est_result_size_condition("attr1");
+   * @endcode
+   *
+   * @param name The attribute/dimension name.
+   * @return An array with the estimated size of the fixed-sized values (or
+   *    the offsets of a var-sized field), of the var-sized values and of
+   *    the validity values, in bytes.
+   */
+  std::array<uint64_t, 3> est_result_size_condition(
+      const std::string& name) const {
+    auto& ctx = ctx_.get();
+    uint64_t size_fixed = 0;
+    uint64_t size_var = 0;
+    uint64_t size_validity = 0;
+    ctx.handle_error(tiledb_query_get_est_result_size_condition(
+        ctx.ptr().get(),
+        query_.get(),
+        name.c_str(),
+        &size_fixed,
+        &size_var,
+        &size_validity));
+    return {size_fixed, size_var, size_validity};
+  }
+
+  /**
+   * Returns a JSON-formatted plan of a read query, computed without
+   * reading any tile. See `tiledb_query_get_plan`.
+   *
+   * **Example:**
+   * @code{.cpp}
+   * tiledb::Query query(...);
+   * query.set_layout(TILEDB_UNORDERED).add_range(0, 1, 100);
+   * std::cout << query.plan();
+   * @endcode
+   */
+  std::string plan() {
+    auto& ctx = ctx_.get();
+    char* c_str;
+    ctx.handle_error(
+        tiledb_query_get_plan(ctx.ptr().get(), query_.get(), &c_str));
+
+    // Copy `c_str` into `str`.
+    std::string str(c_str);
+    free(c_str);
+
+    return str;
+  }
+
   /**
    * Returns the number of written fragments. Applicable only to WRITE queries.
    */
@@ -2273,6 +2567,70 @@ class Query {
     return str;
   }
 
+  /**
+   * Returns the current and peak memory usage of the query for a memory
+   * category, in bytes. See `tiledb_query_get_memory_usage` for the
+   * categories.
+   */
+  std::pair<uint64_t, uint64_t> memory_usage(const std::string& category) {
+    auto ctx = ctx_.get();
+    uint64_t current = 0, peak = 0;
+    ctx.handle_error(tiledb_query_get_memory_usage(
+        ctx.ptr().get(), query_.get(), category.c_str(), &current, &peak));
+    return {current, peak};
+  }
+
+  /** The progress of a read query. See `tiledb_query_get_progress`. */
+  struct Progress {
+    /** The current phase. */
+    std::string phase;
+    /** The number of tiles read. */
+    uint64_t tiles_read;
+    /** The number of tiles scheduled for reading. */
+    uint64_t tiles_total;
+    /** The number of bytes read. */
+    uint64_t bytes_read;
+    /** The number of bytes scheduled for reading. */
+    uint64_t bytes_total;
+  };
+
+  /**
+   * Returns the progress of the query. This may be called from another
+   * thread while the query is submitted.
+   */
+  Progress progress() const {
+    auto& ctx = ctx_.get();
+    const char* phase = nullptr;
+    Progress progress;
+    ctx.handle_error(tiledb_query_get_progress(
+        ctx.ptr().get(),
+        query_.get(),
+        &phase,
+        &progress.tiles_read,
+        &progress.tiles_total,
+        &progress.bytes_read,
+        &progress.bytes_total));
+    progress.phase = phase;
+    return progress;
+  }
+
+  /**
+   * Returns a JSON-formatted report of the time and bytes of every phase of
+   * the query, and of the tiles and bytes read per fragment and per field.
+   */
+  std::string report() const {
+    auto& ctx = ctx_.get();
+    char* c_str;
+    ctx.handle_error(
+        tiledb_query_get_report(ctx.ptr().get(), query_.get(), &c_str));
+
+    // Copy `c_str` into `str`.
+    std::string str(c_str);
+    free(c_str);
+
+    return str;
+  }
+
   /** Update the subarray data within the query from the subarray parameter.
    *
    * @param subarray The output subarray to receive this query's subarray data.
@@ -2304,6 +2662,8 @@ class Query {
         return Status::FAILED;
       case TILEDB_UNINITIALIZED:
         return Status::UNINITIALIZED;
+      case TILEDB_CANCELLED:
+        return Status::CANCELLED;
     }
     assert(false);
     return Status::UNINITIALIZED;
@@ -2363,6 +2723,11 @@ class Query {
   /** Pointer to the TileDB C query object. */
   std::shared_ptr<tiledb_query_t> query_;
 
+  /** The function set with `set_partial_results_callback`. */
+  std::shared_ptr<
+      std::function<void(const std::string&, uint64_t, uint64_t, uint64_t)>>
+      partial_results_callback_;
+
   /** The schema of the array the query targets at. */
   ArraySchema schema_;
 
@@ -2370,6 +2735,18 @@ class Query {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /** Forwards the partial results of the C API to a `std::function`. */
+  static void partial_results_trampoline(
+      const char* name,
+      uint64_t offsets_size,
+      uint64_t data_size,
+      uint64_t validity_size,
+      void* callback) {
+    (*static_cast<std::function<void(
+         const std::string&, uint64_t, uint64_t, uint64_t)>*>(callback))(
+        name, offsets_size, data_size, validity_size);
+  }
+
   /**
    * Sets a buffer for a fixed-sized attribute.
    *
@@ -2585,6 +2962,9 @@ inline std::ostream& operator<<(std::ostream& os, const Query::Status& stat) {
     case tiledb::Query::Status::UNINITIALIZED:
       os << "UNINITIALIZED";
       break;
+    case tiledb::Query::Status::CANCELLED:
+      os << "CANCELLED";
+      break;
   }
   return os;
 }
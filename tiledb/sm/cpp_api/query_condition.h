@@ -38,6 +38,7 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace tiledb {
 
@@ -168,6 +169,85 @@ class QueryCondition {
         op));
   }
 
+  /**
+   * Initializes a TileDB query condition object with a set of fixed size
+   * values, for the `TILEDB_IN` and `TILEDB_NOT_IN` operators.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition qc(ctx);
+   * qc.init_set<int>("a1", {1, 5, 7}, TILEDB_IN);
+   * query.set_condition(qc);
+   * @endcode
+   *
+   * @tparam T The attribute datatype.
+   * @param attribute_name The name of the attribute to compare against.
+   * @param values The members of the set.
+   * @param op The set operation between each cell value and `values`.
+   */
+  template <typename T>
+  void init_set(
+      const std::string& attribute_name,
+      const std::vector<T>& values,
+      tiledb_query_condition_op_t op) {
+    std::vector<uint64_t> offsets(values.size());
+    for (uint64_t i = 0; i < offsets.size(); i++) {
+      offsets[i] = i * sizeof(T);
+    }
+
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_condition_init_set(
+        ctx.ptr().get(),
+        query_condition_.get(),
+        attribute_name.c_str(),
+        values.data(),
+        values.size() * sizeof(T),
+        offsets.data(),
+        offsets.size() * sizeof(uint64_t),
+        op));
+  }
+
+  /**
+   * Initializes a TileDB query condition object with a set of strings, for
+   * the `TILEDB_IN` and `TILEDB_NOT_IN` operators.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition qc(ctx);
+   * qc.init_set("a1", {"abc", "def"}, TILEDB_NOT_IN);
+   * query.set_condition(qc);
+   * @endcode
+   *
+   * @param attribute_name The name of the attribute to compare against.
+   * @param values The members of the set.
+   * @param op The set operation between each cell value and `values`.
+   */
+  void init_set(
+      const std::string& attribute_name,
+      const std::vector<std::string>& values,
+      tiledb_query_condition_op_t op) {
+    std::string data;
+    std::vector<uint64_t> offsets;
+    offsets.reserve(values.size());
+    for (const auto& value : values) {
+      offsets.emplace_back(data.size());
+      data += value;
+    }
+
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_condition_init_set(
+        ctx.ptr().get(),
+        query_condition_.get(),
+        attribute_name.c_str(),
+        data.data(),
+        data.size(),
+        offsets.data(),
+        offsets.size() * sizeof(uint64_t),
+        op));
+  }
+
   /** Returns a shared pointer to the C TileDB query condition object. */
   std::shared_ptr<tiledb_query_condition_t> ptr() const {
     return query_condition_;
@@ -0,0 +1,190 @@
+/**
+ * @file   query_managed_buffers.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the experimental C++ API for managed result buffers.
+ */
+
+#ifndef TILEDB_CPP_API_QUERY_MANAGED_BUFFERS_H
+#define TILEDB_CPP_API_QUERY_MANAGED_BUFFERS_H
+
+#include "context.h"
+#include "query.h"
+#include "tiledb.h"
+#include "tiledb_experimental.h"
+
+#include <string>
+#include <utility>
+
+namespace tiledb {
+
+/**
+ * A chunk of the results of a query with managed buffers. The buffers are
+ * owned by the query and valid until it is resubmitted or destroyed.
+ */
+class ManagedChunk {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param ctx TileDB context.
+   * @param query The submitted query.
+   * @param chunk The chunk index.
+   */
+  ManagedChunk(const Context& ctx, Query& query, uint64_t chunk)
+      : ctx_(ctx)
+      , query_(query)
+      , chunk_(chunk) {
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the data of a buffer, or the var-sized data of a var-sized
+   * field, and its number of elements of type `T`.
+   */
+  template <typename T>
+  std::pair<const T*, uint64_t> data(const std::string& name) const {
+    auto buffer = get(name);
+    return {static_cast<const T*>(buffer.data), buffer.data_size / sizeof(T)};
+  }
+
+  /**
+   * Returns the offsets of a var-sized field and their number, for the
+   * default 64-bit offsets. They are relative to the data of this chunk.
+   */
+  std::pair<const uint64_t*, uint64_t> offsets(const std::string& name) const {
+    auto buffer = get(name);
+    return {
+        static_cast<const uint64_t*>(buffer.offsets),
+        buffer.offsets_size / sizeof(uint64_t)};
+  }
+
+  /** Returns the validity of a nullable field and its number of cells. */
+  std::pair<const uint8_t*, uint64_t> validity(const std::string& name) const {
+    auto buffer = get(name);
+    return {buffer.validity, buffer.validity_size};
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** The query. */
+  std::reference_wrapper<Query> query_;
+
+  /** The chunk index. */
+  uint64_t chunk_;
+
+  /** The results of a buffer. */
+  struct Buffer {
+    const void* data;
+    uint64_t data_size;
+    const void* offsets;
+    uint64_t offsets_size;
+    const uint8_t* validity;
+    uint64_t validity_size;
+  };
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Retrieves the results of a buffer. */
+  Buffer get(const std::string& name) const {
+    auto& ctx = ctx_.get();
+    Buffer buffer;
+    ctx.handle_error(tiledb_query_get_managed_buffer(
+        ctx.ptr().get(),
+        query_.get().ptr().get(),
+        name.c_str(),
+        chunk_,
+        &buffer.data,
+        &buffer.data_size,
+        &buffer.offsets,
+        &buffer.offsets_size,
+        &buffer.validity,
+        &buffer.validity_size));
+    return buffer;
+  }
+};
+
+/**
+ * Lets the library allocate the result buffers of an attribute/dimension of
+ * a read query, growing them in chunks so that most submissions complete
+ * without an incomplete round trip. The chunks are bounded by the memory
+ * budget, in which case the query is left incomplete. The buffers of all
+ * the fields of the query must be managed.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Query query(ctx, array, TILEDB_READ);
+ * query.set_layout(TILEDB_UNORDERED);
+ * tiledb::set_managed_buffer(ctx, query, "a");
+ * query.submit();
+ * for (uint64_t c = 0; c < tiledb::managed_chunk_num(ctx, query); c++) {
+ *   auto [values, num] = tiledb::ManagedChunk(ctx, query, c).data<int>("a");
+ *   // Process the chunk
+ * }
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param query The read query, not yet submitted.
+ * @param name The attribute/dimension name.
+ */
+inline void set_managed_buffer(
+    const Context& ctx, Query& query, const std::string& name) {
+  ctx.handle_error(tiledb_query_set_managed_buffer(
+      ctx.ptr().get(), query.ptr().get(), name.c_str()));
+}
+
+/**
+ * Returns the number of chunks of the managed buffers holding the results
+ * of the last submission.
+ */
+inline uint64_t managed_chunk_num(const Context& ctx, Query& query) {
+  uint64_t chunk_num = 0;
+  ctx.handle_error(tiledb_query_get_managed_buffer_chunk_num(
+      ctx.ptr().get(), query.ptr().get(), &chunk_num));
+  return chunk_num;
+}
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_QUERY_MANAGED_BUFFERS_H
@@ -0,0 +1,209 @@
+/**
+ * @file   query_stream.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the experimental C++ API for streaming query results.
+ */
+
+#ifndef TILEDB_CPP_API_QUERY_STREAM_H
+#define TILEDB_CPP_API_QUERY_STREAM_H
+
+#include "context.h"
+#include "query.h"
+#include "tiledb.h"
+#include "tiledb_experimental.h"
+
+#include <exception>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace tiledb {
+
+/**
+ * A batch of results passed to the callback of `submit_streaming`. The
+ * buffers are owned by the library and only valid while the callback runs.
+ */
+class QueryBatch {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param ctx TileDB context.
+   * @param query The C query passed to the streaming callback.
+   */
+  QueryBatch(const Context& ctx, tiledb_query_t* query)
+      : ctx_(ctx)
+      , query_(query) {
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the data of a buffer, or the var-sized data of a var-sized
+   * field, and its number of elements of type `T`.
+   */
+  template <typename T>
+  std::pair<const T*, uint64_t> data(const std::string& name) const {
+    auto buffer = get(name);
+    return {static_cast<const T*>(buffer.data), buffer.data_size / sizeof(T)};
+  }
+
+  /**
+   * Returns the offsets of a var-sized field and their number, for the
+   * default 64-bit offsets.
+   */
+  std::pair<const uint64_t*, uint64_t> offsets(const std::string& name) const {
+    auto buffer = get(name);
+    return {
+        static_cast<const uint64_t*>(buffer.offsets),
+        buffer.offsets_size / sizeof(uint64_t)};
+  }
+
+  /** Returns the validity of a nullable field and its number of cells. */
+  std::pair<const uint8_t*, uint64_t> validity(const std::string& name) const {
+    auto buffer = get(name);
+    return {buffer.validity, buffer.validity_size};
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** The C query passed to the streaming callback. */
+  tiledb_query_t* query_;
+
+  /** The results of a buffer. */
+  struct Buffer {
+    const void* data;
+    uint64_t data_size;
+    const void* offsets;
+    uint64_t offsets_size;
+    const uint8_t* validity;
+    uint64_t validity_size;
+  };
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Retrieves the results of a buffer. */
+  Buffer get(const std::string& name) const {
+    auto& ctx = ctx_.get();
+    Buffer buffer;
+    ctx.handle_error(tiledb_query_get_stream_buffer(
+        ctx.ptr().get(),
+        query_,
+        name.c_str(),
+        &buffer.data,
+        &buffer.data_size,
+        &buffer.offsets,
+        &buffer.offsets_size,
+        &buffer.validity,
+        &buffer.validity_size));
+    return buffer;
+  }
+};
+
+/**
+ * Submits a read query until it completes, streaming the results to
+ * `callback` instead of returning incomplete submissions. The results are
+ * copied into batches of library-owned buffers sized like the buffers set
+ * on the query, which are never written to, and the query is resubmitted
+ * into the next batch while the callback consumes the previous ones.
+ *
+ * The callback runs on a single library thread, once per batch and in the
+ * order of the results. It returns `false` to stop the stream. An
+ * exception thrown by the callback stops the stream and is rethrown.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * std::vector<int32_t> a(1024);
+ * tiledb::Query query(ctx, array, TILEDB_READ);
+ * query.set_layout(TILEDB_UNORDERED).set_data_buffer("a", a);
+ * tiledb::submit_streaming(ctx, query, [](const tiledb::QueryBatch& batch) {
+ *   auto [values, num] = batch.data<int32_t>("a");
+ *   // Process the batch
+ *   return true;
+ * });
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param query The read query, with its buffers set and not yet submitted.
+ * @param callback The function called with each batch.
+ * @param max_inflight_batches The maximum number of batches being filled or
+ *     consumed at any time.
+ */
+inline void submit_streaming(
+    const Context& ctx,
+    Query& query,
+    const std::function<bool(const QueryBatch&)>& callback,
+    uint64_t max_inflight_batches = 2) {
+  struct CallbackData {
+    const Context& ctx;
+    const std::function<bool(const QueryBatch&)>& callback;
+    std::exception_ptr exception;
+  } data{ctx, callback, nullptr};
+
+  auto trampoline = [](tiledb_query_t* query, void* data) -> int32_t {
+    auto callback_data = static_cast<CallbackData*>(data);
+    try {
+      return callback_data->callback(QueryBatch(callback_data->ctx, query)) ?
+                 TILEDB_OK :
+                 TILEDB_ERR;
+    } catch (...) {
+      callback_data->exception = std::current_exception();
+      return TILEDB_ERR;
+    }
+  };
+
+  auto rc = tiledb_query_submit_streaming(
+      ctx.ptr().get(),
+      query.ptr().get(),
+      trampoline,
+      &data,
+      max_inflight_batches);
+  if (data.exception != nullptr)
+    std::rethrow_exception(data.exception);
+  ctx.handle_error(rc);
+}
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_QUERY_STREAM_H
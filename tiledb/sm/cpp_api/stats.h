@@ -50,6 +50,11 @@ namespace tiledb {
  * // Dump to a string instead.
  * std::string str;
  * tiledb::Stats::dump(&str);
+ *
+ * // Record a timeline of the query, to load in chrome://tracing.
+ * tiledb::Stats::trace_enable();
+ * query.submit();
+ * tiledb::Stats::trace_dump(&str);
  * @endcode
  */
 class Stats {
@@ -112,6 +117,38 @@ class Stats {
     check_error(tiledb_stats_free_str(&c_str), "error freeing stats string");
   }
 
+  /** Enables the recording of tracing spans. */
+  static void trace_enable() {
+    check_error(tiledb_stats_trace_enable(), "error enabling tracing");
+  }
+
+  /** Disables the recording of tracing spans. */
+  static void trace_disable() {
+    check_error(tiledb_stats_trace_disable(), "error disabling tracing");
+  }
+
+  /**
+   * Dump the recorded tracing spans to some output (e.g., file or stdout)
+   * as a Chrome trace event JSON.
+   *
+   * @param out The output.
+   */
+  static void trace_dump(FILE* out = nullptr) {
+    check_error(tiledb_stats_trace_dump(out), "error dumping trace");
+  }
+
+  /**
+   * Dump the recorded tracing spans to a string.
+   *
+   * @param out The output.
+   */
+  static void trace_dump(std::string* out) {
+    char* c_str = nullptr;
+    check_error(tiledb_stats_trace_dump_str(&c_str), "error dumping trace");
+    *out = std::string(c_str);
+    check_error(tiledb_stats_free_str(&c_str), "error freeing trace string");
+  }
+
  private:
   /**
    * Checks the return code for TILEDB_OK and throws an exception if not.
@@ -174,6 +174,35 @@ class Subarray {
     return *this;
   }
 
+  /**
+   * Adds a 1D range of labels along a subarray dimension index, in the form
+   * (start, end). The range of the dimension indices whose labels are within
+   * (start, end) is looked up in the label array of the dimension, stored at
+   * `<array_uri>/__labels/<dim_name>`, and added to the subarray. The
+   * datatype of the range must be the same as the label datatype.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * // Select the rows whose timestamp labels are within [t0, t1].
+   * subarray.add_label_range<double>(0, t0, t1);
+   * @endcode
+   *
+   * @tparam T The label datatype
+   * @param dim_idx The index of the labeled dimension.
+   * @param start The start label.
+   * @param end The end label.
+   * @return Reference to this Subarray
+   */
+  template <class T>
+  Subarray& add_label_range(uint32_t dim_idx, T start, T end) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_subarray_add_label_range(
+        ctx.ptr().get(), subarray_.get(), dim_idx, &start, &end));
+
+    return *this;
+  }
+
   /**
    * Adds a 1D range along a subarray dimension name, specified by its name, in
    * the form (start, end, stride). The datatype of the range must be the same
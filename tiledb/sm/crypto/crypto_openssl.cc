@@ -34,20 +34,116 @@
 
 #include "tiledb/sm/crypto/crypto_openssl.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/macros.h"
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/crypto/crypto.h"
 
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/md5.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 
+#include <cstring>
+
 using namespace tiledb::common;
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * The AES-256-GCM cipher context of a thread. Allocating a context and
+ * expanding the key cost more than encrypting a tile chunk, so each thread
+ * keeps its context along with the key it was set up with, and only resets
+ * the IV while the key and direction stay the same.
+ */
+class ThreadCipherContext {
+ public:
+  /** Constructor. */
+  ThreadCipherContext()
+      : ctx_(EVP_CIPHER_CTX_new())
+      , mode_(Mode::NONE) {
+  }
+
+  /** Destructor. */
+  ~ThreadCipherContext() {
+    if (ctx_ != nullptr)
+      EVP_CIPHER_CTX_free(ctx_);
+    OPENSSL_cleanse(key_, sizeof(key_));
+  }
+
+  DISABLE_COPY_AND_COPY_ASSIGN(ThreadCipherContext);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(ThreadCipherContext);
+
+  /** Returns `true` if the context could be allocated. */
+  bool allocated() const {
+    return ctx_ != nullptr;
+  }
+
+  /**
+   * Sets up the context to encrypt or decrypt with the given key and IV.
+   * Returns nullptr on error.
+   */
+  EVP_CIPHER_CTX* init(
+      bool encrypt, const void* key, const unsigned char* iv) {
+    const Mode mode = encrypt ? Mode::ENCRYPT : Mode::DECRYPT;
+    const bool reuse =
+        mode_ == mode && std::memcmp(key_, key, sizeof(key_)) == 0;
+
+    // A reused context only needs the new IV.
+    const EVP_CIPHER* cipher = nullptr;
+    const unsigned char* key_buf = nullptr;
+    if (!reuse) {
+      EVP_CIPHER_CTX_init(ctx_);
+      cipher = EVP_aes_256_gcm();
+      key_buf = (const unsigned char*)key;
+    }
+
+    const int rc =
+        encrypt ? EVP_EncryptInit_ex(ctx_, cipher, nullptr, key_buf, iv) :
+                  EVP_DecryptInit_ex(ctx_, cipher, nullptr, key_buf, iv);
+    if (rc == 0) {
+      invalidate();
+      return nullptr;
+    }
+
+    if (!reuse) {
+      std::memcpy(key_, key, sizeof(key_));
+      mode_ = mode;
+    }
+    return ctx_;
+  }
+
+  /** Forgets the key, so that the next use sets the context up again. */
+  void invalidate() {
+    mode_ = Mode::NONE;
+  }
+
+ private:
+  /** The directions a context can be set up for. */
+  enum class Mode { NONE, ENCRYPT, DECRYPT };
+
+  /** The OpenSSL context. */
+  EVP_CIPHER_CTX* ctx_;
+
+  /** The direction the context is set up for. */
+  Mode mode_;
+
+  /** The key the context is set up with, if `mode_` is not NONE. */
+  unsigned char key_[Crypto::AES256GCM_KEY_BYTES];
+};
+
+/** Returns the cipher context of the calling thread. */
+ThreadCipherContext& thread_cipher_context() {
+  thread_local ThreadCipherContext cipher;
+  return cipher;
+}
+
+}  // namespace
+
 Status OpenSSL::get_random_bytes(unsigned num_bytes, Buffer* output) {
   if (output->free_space() < num_bytes)
     RETURN_NOT_OK(output->realloc(output->alloced_size() + num_bytes));
@@ -97,24 +193,17 @@ Status OpenSSL::encrypt_aes256gcm(
   // Copy IV to output arg.
   std::memcpy(output_iv->cur_data(), iv_buf, iv_len);
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-  if (ctx == nullptr)
+  auto& cipher = thread_cipher_context();
+  if (!cipher.allocated())
     return LOG_STATUS(Status_EncryptionError(
         "OpenSSL error; cannot encrypt: context allocation failed."));
 
   // Initialize the cipher. We use the default parameter lengths for the IV and
   // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_EncryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          iv_buf) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+  EVP_CIPHER_CTX* ctx = cipher.init(true, key->data(), iv_buf);
+  if (ctx == nullptr)
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Encrypt the input.
   int output_len;
@@ -124,7 +213,7 @@ Status OpenSSL::encrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error encrypting data."));
   }
@@ -134,7 +223,7 @@ Status OpenSSL::encrypt_aes256gcm(
   // Finalize encryption.
   if (EVP_EncryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error finalizing encryption."));
   }
@@ -147,14 +236,11 @@ Status OpenSSL::encrypt_aes256gcm(
           EVP_CTRL_GCM_GET_TAG,
           Crypto::AES256GCM_TAG_BYTES,
           (char*)output_tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error getting tag."));
   }
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
@@ -179,24 +265,18 @@ Status OpenSSL::decrypt_aes256gcm(
         "OpenSSL error; cannot decrypt: output buffer too small."));
   }
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-  if (ctx == nullptr)
+  auto& cipher = thread_cipher_context();
+  if (!cipher.allocated())
     return LOG_STATUS(Status_EncryptionError(
         "OpenSSL error; cannot decrypt: context allocation failed."));
 
   // Initialize the cipher. We use the default parameter lengths for the IV and
   // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_DecryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          (unsigned char*)iv->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+  EVP_CIPHER_CTX* ctx =
+      cipher.init(false, key->data(), (const unsigned char*)iv->data());
+  if (ctx == nullptr)
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Decrypt the input.
   int output_len;
@@ -206,7 +286,7 @@ Status OpenSSL::decrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error decrypting data."));
   }
@@ -220,7 +300,7 @@ Status OpenSSL::decrypt_aes256gcm(
           EVP_CTRL_GCM_SET_TAG,
           Crypto::AES256GCM_TAG_BYTES,
           (char*)tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error setting tag."));
   }
@@ -228,7 +308,7 @@ Status OpenSSL::decrypt_aes256gcm(
   // Finalize decryption.
   if (EVP_DecryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher.invalidate();
     return LOG_STATUS(
         Status_EncryptionError("OpenSSL error; error finalizing decryption."));
   }
@@ -236,9 +316,6 @@ Status OpenSSL::decrypt_aes256gcm(
     output->advance_size((uint64_t)output_len);
   output->advance_offset((uint64_t)output_len);
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
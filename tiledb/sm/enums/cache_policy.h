@@ -0,0 +1,94 @@
+/**
+ * @file   cache_policy.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the CachePolicy enum.
+ */
+
+#ifndef TILEDB_CACHE_POLICY_H
+#define TILEDB_CACHE_POLICY_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/misc/constants.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/** The admission and eviction policy of an LRU cache. */
+enum class CachePolicy : uint8_t {
+  /** Evicts the least recently used object. */
+  LRU = 0,
+  /**
+   * Segmented LRU. New objects enter a probationary segment and move to a
+   * protected segment when hit again. Objects are evicted from the
+   * probationary segment first, so objects read only once cannot evict the
+   * ones read repeatedly.
+   */
+  SLRU = 1,
+  /**
+   * Segmented LRU where a new object is admitted only if it is estimated to
+   * be read more frequently than the object it would evict.
+   */
+  TINYLFU = 2
+};
+
+/** Returns the string representation of the input cache policy. */
+inline const std::string& cache_policy_str(CachePolicy cache_policy) {
+  switch (cache_policy) {
+    case CachePolicy::LRU:
+      return constants::cache_policy_lru_str;
+    case CachePolicy::SLRU:
+      return constants::cache_policy_slru_str;
+    case CachePolicy::TINYLFU:
+      return constants::cache_policy_tinylfu_str;
+    default:
+      return constants::empty_str;
+  }
+}
+
+/** Returns the cache policy given a string representation. */
+inline Status cache_policy_enum(
+    const std::string& cache_policy_str, CachePolicy* cache_policy) {
+  if (cache_policy_str == constants::cache_policy_lru_str)
+    *cache_policy = CachePolicy::LRU;
+  else if (cache_policy_str == constants::cache_policy_slru_str)
+    *cache_policy = CachePolicy::SLRU;
+  else if (cache_policy_str == constants::cache_policy_tinylfu_str)
+    *cache_policy = CachePolicy::TINYLFU;
+  else
+    return Status_Error("Invalid CachePolicy " + cache_policy_str);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CACHE_POLICY_H
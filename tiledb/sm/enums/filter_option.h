@@ -57,6 +57,8 @@ inline const std::string& filter_option_str(FilterOption filter_option_) {
       return constants::filter_option_bit_width_max_window_str;
     case FilterOption::POSITIVE_DELTA_MAX_WINDOW:
       return constants::filter_option_positive_delta_max_window_str;
+    case FilterOption::AUTO_COMPRESSION_SPEED_BIAS:
+      return constants::filter_option_auto_compression_speed_bias_str;
     default:
       return constants::empty_str;
   }
@@ -74,6 +76,10 @@ inline Status filter_option_enum(
       filter_option_str ==
       constants::filter_option_positive_delta_max_window_str)
     *filter_option_ = FilterOption::POSITIVE_DELTA_MAX_WINDOW;
+  else if (
+      filter_option_str ==
+      constants::filter_option_auto_compression_speed_bias_str)
+    *filter_option_ = FilterOption::AUTO_COMPRESSION_SPEED_BIAS;
   else
     return Status_Error("Invalid FilterOption " + filter_option_str);
 
@@ -85,6 +85,18 @@ inline const std::string& filter_type_str(FilterType filter_type) {
       return constants::filter_checksum_md5_str;
     case FilterType::FILTER_CHECKSUM_SHA256:
       return constants::filter_checksum_sha256_str;
+    case FilterType::FILTER_DICTIONARY:
+      return constants::filter_dictionary_str;
+    case FilterType::FILTER_FRAME_OF_REFERENCE:
+      return constants::filter_frame_of_reference_str;
+    case FilterType::FILTER_FLOAT_XOR:
+      return constants::filter_float_xor_str;
+    case FilterType::FILTER_AUTO_COMPRESSION:
+      return constants::filter_auto_compression_str;
+    case FilterType::FILTER_CHECKSUM_CRC32C:
+      return constants::filter_checksum_crc32c_str;
+    case FilterType::FILTER_BITMAP:
+      return constants::filter_bitmap_str;
     default:
       return constants::empty_str;
   }
@@ -119,6 +131,18 @@ inline Status filter_type_enum(
     *filter_type = FilterType::FILTER_CHECKSUM_MD5;
   else if (filter_type_str == constants::filter_checksum_sha256_str)
     *filter_type = FilterType::FILTER_CHECKSUM_SHA256;
+  else if (filter_type_str == constants::filter_dictionary_str)
+    *filter_type = FilterType::FILTER_DICTIONARY;
+  else if (filter_type_str == constants::filter_frame_of_reference_str)
+    *filter_type = FilterType::FILTER_FRAME_OF_REFERENCE;
+  else if (filter_type_str == constants::filter_float_xor_str)
+    *filter_type = FilterType::FILTER_FLOAT_XOR;
+  else if (filter_type_str == constants::filter_auto_compression_str)
+    *filter_type = FilterType::FILTER_AUTO_COMPRESSION;
+  else if (filter_type_str == constants::filter_checksum_crc32c_str)
+    *filter_type = FilterType::FILTER_CHECKSUM_CRC32C;
+  else if (filter_type_str == constants::filter_bitmap_str)
+    *filter_type = FilterType::FILTER_BITMAP;
   else {
     return Status_Error("Invalid FilterType " + filter_type_str);
   }
@@ -0,0 +1,89 @@
+/**
+ * @file   huge_page_mode.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the HugePageMode enum.
+ */
+
+#ifndef TILEDB_HUGE_PAGE_MODE_H
+#define TILEDB_HUGE_PAGE_MODE_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/misc/constants.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/** How large buffers are backed by huge pages. */
+enum class HugePageMode : uint8_t {
+  /** Regular pages. */
+  NONE = 0,
+  /** Transparent huge pages, requested with `madvise`. */
+  TRANSPARENT = 1,
+  /**
+   * Huge pages reserved by the system (`MAP_HUGETLB`), falling back to
+   * transparent huge pages if none are available.
+   */
+  EXPLICIT = 2
+};
+
+/** Returns the string representation of the input huge page mode. */
+inline const std::string& huge_page_mode_str(HugePageMode huge_page_mode) {
+  switch (huge_page_mode) {
+    case HugePageMode::NONE:
+      return constants::huge_page_mode_none_str;
+    case HugePageMode::TRANSPARENT:
+      return constants::huge_page_mode_transparent_str;
+    case HugePageMode::EXPLICIT:
+      return constants::huge_page_mode_explicit_str;
+    default:
+      return constants::empty_str;
+  }
+}
+
+/** Returns the huge page mode given a string representation. */
+inline Status huge_page_mode_enum(
+    const std::string& huge_page_mode_str, HugePageMode* huge_page_mode) {
+  if (huge_page_mode_str == constants::huge_page_mode_none_str)
+    *huge_page_mode = HugePageMode::NONE;
+  else if (huge_page_mode_str == constants::huge_page_mode_transparent_str)
+    *huge_page_mode = HugePageMode::TRANSPARENT;
+  else if (huge_page_mode_str == constants::huge_page_mode_explicit_str)
+    *huge_page_mode = HugePageMode::EXPLICIT;
+  else
+    return Status_Error("Invalid HugePageMode " + huge_page_mode_str);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_HUGE_PAGE_MODE_H
@@ -64,11 +64,21 @@ inline const std::string& layout_str(Layout layout) {
       return constants::unordered_str;
     case Layout::HILBERT:
       return constants::hilbert_str;
+    case Layout::MORTON:
+      return constants::morton_str;
     default:
       return constants::empty_str;
   }
 }
 
+/**
+ * Returns true if the layout orders cells on the values of a space-filling
+ * curve, i.e. it is the Hilbert or Morton layout.
+ */
+inline bool layout_is_curve(Layout layout) {
+  return layout == Layout::HILBERT || layout == Layout::MORTON;
+}
+
 /** Returns the layout enum given a string representation. */
 inline Status layout_enum(const std::string& layout_str, Layout* layout) {
   if (layout_str == constants::col_major_str)
@@ -81,6 +91,8 @@ inline Status layout_enum(const std::string& layout_str, Layout* layout) {
     *layout = Layout::UNORDERED;
   else if (layout_str == constants::hilbert_str)
     *layout = Layout::HILBERT;
+  else if (layout_str == constants::morton_str)
+    *layout = Layout::MORTON;
   else {
     return Status_Error("Invalid Layout " + layout_str);
   }
@@ -67,6 +67,12 @@ inline const std::string& query_condition_op_str(
       return constants::query_condition_op_eq_str;
     case QueryConditionOp::NE:
       return constants::query_condition_op_ne_str;
+    case QueryConditionOp::IN:
+      return constants::query_condition_op_in_str;
+    case QueryConditionOp::NOT_IN:
+      return constants::query_condition_op_not_in_str;
+    case QueryConditionOp::PREFIX:
+      return constants::query_condition_op_prefix_str;
     default:
       return constants::empty_str;
   }
@@ -88,6 +94,12 @@ inline Status query_condition_op_enum(
     *query_condition_op = QueryConditionOp::EQ;
   else if (query_condition_op_str == constants::query_condition_op_ne_str)
     *query_condition_op = QueryConditionOp::NE;
+  else if (query_condition_op_str == constants::query_condition_op_in_str)
+    *query_condition_op = QueryConditionOp::IN;
+  else if (query_condition_op_str == constants::query_condition_op_not_in_str)
+    *query_condition_op = QueryConditionOp::NOT_IN;
+  else if (query_condition_op_str == constants::query_condition_op_prefix_str)
+    *query_condition_op = QueryConditionOp::PREFIX;
   else {
     return Status_Error("Invalid QueryConditionOp " + query_condition_op_str);
   }
@@ -43,6 +43,7 @@
 #include "tiledb/sm/filesystem/azure.h"
 #include "tiledb/sm/global_state/global_state.h"
 #include "tiledb/sm/misc/math.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 
 // blob_client.h needs to be included after logger_public.h to avoid
@@ -60,7 +61,8 @@ namespace sm {
 /* ********************************* */
 
 Azure::Azure()
-    : write_cache_max_size_(0)
+    : stats_(nullptr)
+    , write_cache_max_size_(0)
     , max_parallel_ops_(1)
     , block_list_block_size_(0)
     , use_block_list_upload_(false) {
@@ -73,12 +75,17 @@ Azure::~Azure() {
 /*                 API               */
 /* ********************************* */
 
-Status Azure::init(const Config& config, ThreadPool* const thread_pool) {
+Status Azure::init(
+    stats::Stats* const parent_stats,
+    const Config& config,
+    ThreadPool* const thread_pool) {
   if (thread_pool == nullptr) {
     return LOG_STATUS(
         Status_AzureError("Can't initialize with null thread pool."));
   }
 
+  stats_ = parent_stats->create_child("Azure");
+
   thread_pool_ = thread_pool;
 
   bool found;
@@ -146,9 +153,20 @@ Status Azure::init(const Config& config, ThreadPool* const thread_pool) {
     // clang-format on
   }
 
-  auto account = tdb::make_shared<azure::storage_lite::storage_account>(
+  account_ = tdb::make_shared<azure::storage_lite::storage_account>(
       HERE(), account_name, credential, use_https, blob_endpoint);
 
+  // The blob client is constructed on the first use of Azure.
+  return Status::Ok();
+}
+
+Status Azure::init_client() const {
+  std::lock_guard<std::mutex> lck(client_init_mtx_);
+  if (client_ != nullptr)
+    return Status::Ok();
+
+  auto timer_se = stats_->start_timer("init_client");
+
   // Construct the Azure SDK blob client with a concurrency level
   // equal to 'thread_pool_->concurrency_level'. Internally, the client
   // will allocate an equal number of libcurl sessions with
@@ -162,10 +180,10 @@ Status Azure::init(const Config& config, ThreadPool* const thread_pool) {
   const std::string cert_file =
       global_state::GlobalState::GetGlobalState().cert_file();
   client_ = tdb::make_shared<azure::storage_lite::blob_client>(
-      HERE(), account, thread_pool_->concurrency_level(), cert_file);
+      HERE(), account_, thread_pool_->concurrency_level(), cert_file);
 #else
   client_ = tdb::make_shared<azure::storage_lite::blob_client>(
-      HERE(), account, thread_pool_->concurrency_level());
+      HERE(), account_, thread_pool_->concurrency_level());
 #endif
 
   // The Azure SDK does not provide a way to configure the retry
@@ -173,13 +191,13 @@ Status Azure::init(const Config& config, ThreadPool* const thread_pool) {
   // re-assigns the context with our own retry policy.
   *client_->context() = azure::storage_lite::executor_context(
       tdb::make_shared<azure::storage_lite::tinyxml2_parser>(HERE()),
-      tdb::make_shared<AzureRetryPolicy>(HERE()));
+      tdb::make_shared<AzureRetryPolicy>(HERE(), stats_));
 
   return Status::Ok();
 }
 
 Status Azure::create_container(const URI& uri) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   if (!uri.is_azure()) {
     return LOG_STATUS(Status_AzureError(
@@ -226,7 +244,7 @@ Status Azure::wait_for_container_to_propagate(
 
 Status Azure::wait_for_container_to_be_deleted(
     const std::string& container_name) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   unsigned attempts = 0;
   while (attempts++ < constants::azure_max_attempts) {
@@ -245,13 +263,13 @@ Status Azure::wait_for_container_to_be_deleted(
 }
 
 Status Azure::empty_container(const URI& container) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   return remove_dir(container);
 }
 
 Status Azure::flush_blob(const URI& uri) {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   if (!use_block_list_upload_) {
     return flush_blob_direct(uri);
@@ -412,7 +430,7 @@ Status Azure::flush_blob_direct(const URI& uri) {
 }
 
 Status Azure::is_empty_container(const URI& uri, bool* is_empty) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(is_empty);
 
   if (!uri.is_azure()) {
@@ -463,7 +481,7 @@ Status Azure::is_container(const URI& uri, bool* const is_container) const {
 
 Status Azure::is_container(
     const std::string& container_name, bool* const is_container) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(is_container);
 
   std::future<azure::storage_lite::storage_outcome<
@@ -488,7 +506,7 @@ Status Azure::is_container(
 }
 
 Status Azure::is_dir(const URI& uri, bool* const exists) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(exists);
 
   std::vector<std::string> paths;
@@ -511,7 +529,7 @@ Status Azure::is_blob(
     const std::string& container_name,
     const std::string& blob_path,
     bool* const is_blob) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(is_blob);
 
   std::future<
@@ -564,7 +582,7 @@ Status Azure::ls(
     std::vector<std::string>* paths,
     const std::string& delimiter,
     const int max_paths) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(paths);
 
   const URI uri_dir = uri.add_trailing_slash();
@@ -617,14 +635,14 @@ Status Azure::ls(
 }
 
 Status Azure::move_object(const URI& old_uri, const URI& new_uri) {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   RETURN_NOT_OK(copy_blob(old_uri, new_uri));
   RETURN_NOT_OK(remove_blob(old_uri));
   return Status::Ok();
 }
 
 Status Azure::copy_blob(const URI& old_uri, const URI& new_uri) {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   if (!old_uri.is_azure()) {
     return LOG_STATUS(Status_AzureError(
@@ -663,7 +681,7 @@ Status Azure::copy_blob(const URI& old_uri, const URI& new_uri) {
 
 Status Azure::wait_for_blob_to_propagate(
     const std::string& container_name, const std::string& blob_path) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   unsigned attempts = 0;
   while (attempts++ < constants::azure_max_attempts) {
@@ -683,7 +701,7 @@ Status Azure::wait_for_blob_to_propagate(
 
 Status Azure::wait_for_blob_to_be_deleted(
     const std::string& container_name, const std::string& blob_path) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   unsigned attempts = 0;
   while (attempts++ < constants::azure_max_attempts) {
@@ -702,7 +720,7 @@ Status Azure::wait_for_blob_to_be_deleted(
 }
 
 Status Azure::move_dir(const URI& old_uri, const URI& new_uri) {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   std::vector<std::string> paths;
   RETURN_NOT_OK(ls(old_uri, &paths, ""));
@@ -715,7 +733,7 @@ Status Azure::move_dir(const URI& old_uri, const URI& new_uri) {
 }
 
 Status Azure::blob_size(const URI& uri, uint64_t* const nbytes) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
   assert(nbytes);
 
   if (!uri.is_azure()) {
@@ -767,7 +785,7 @@ Status Azure::read(
     const uint64_t length,
     const uint64_t read_ahead_length,
     uint64_t* const length_returned) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   if (!uri.is_azure()) {
     return LOG_STATUS(Status_AzureError(
@@ -778,10 +796,17 @@ Status Azure::read(
   std::string blob_path;
   RETURN_NOT_OK(parse_azure_uri(uri, &container_name, &blob_path));
 
-  std::stringstream ss;
+  // Download directly into the buffer rather than through a copy.
+  ZeroCopyOutputStreamBuffer zc_stream_buffer(
+      static_cast<char*>(buffer), length + read_ahead_length);
+  std::ostream zc_ostream(&zc_stream_buffer);
   std::future<azure::storage_lite::storage_outcome<void>> result =
       client_->download_blob_to_stream(
-          container_name, blob_path, offset, length + read_ahead_length, ss);
+          container_name,
+          blob_path,
+          offset,
+          length + read_ahead_length,
+          zc_ostream);
   if (!result.valid()) {
     return LOG_STATUS(Status_AzureError(
         std::string("Read blob failed on: " + uri.to_string())));
@@ -793,8 +818,7 @@ Status Azure::read(
         std::string("Read blob failed on: " + uri.to_string())));
   }
 
-  ss.read(static_cast<char*>(buffer), length + read_ahead_length);
-  *length_returned = ss.gcount();
+  *length_returned = zc_stream_buffer.size();
 
   if (*length_returned < length) {
     return LOG_STATUS(Status_AzureError(
@@ -805,7 +829,7 @@ Status Azure::read(
 }
 
 Status Azure::remove_container(const URI& uri) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   // Empty container
   RETURN_NOT_OK(empty_container(uri));
@@ -830,7 +854,7 @@ Status Azure::remove_container(const URI& uri) const {
 }
 
 Status Azure::remove_blob(const URI& uri) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   std::string container_name;
   std::string blob_path;
@@ -854,19 +878,23 @@ Status Azure::remove_blob(const URI& uri) const {
 }
 
 Status Azure::remove_dir(const URI& uri) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
+  // The storage client has no batch delete, so the blobs are deleted in
+  // parallel on the VFS thread pool
   std::vector<std::string> paths;
   RETURN_NOT_OK(ls(uri, &paths, ""));
-  for (const auto& path : paths) {
-    RETURN_NOT_OK(remove_blob(URI(path)));
-  }
+  auto status = parallel_for(thread_pool_, 0, paths.size(), [&](uint64_t i) {
+    RETURN_NOT_OK(remove_blob(URI(paths[i])));
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
 
   return Status::Ok();
 }
 
 Status Azure::touch(const URI& uri) const {
-  assert(client_);
+  RETURN_NOT_OK(init_client());
 
   if (!uri.is_azure()) {
     return LOG_STATUS(Status_AzureError(
@@ -909,6 +937,8 @@ Status Azure::touch(const URI& uri) const {
 
 Status Azure::write(
     const URI& uri, const void* const buffer, const uint64_t length) {
+  RETURN_NOT_OK(init_client());
+
   if (!uri.is_azure()) {
     return LOG_STATUS(Status_AzureError(
         std::string("URI is not an Azure URI: " + uri.to_string())));
@@ -39,6 +39,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/stats/stats.h"
 #include "uri.h"
 
 #if !defined(NOMINMAX)
@@ -84,11 +85,13 @@ class Azure {
   /**
    * Initializes and connects an Azure client.
    *
+   * @param parent_stats The parent stats to inherit from.
    * @param config Configuration parameters.
    * @param thread_pool The parent VFS thread pool.
    * @return Status
    */
-  Status init(const Config& config, ThreadPool* thread_pool);
+  Status init(
+      stats::Stats* parent_stats, const Config& config, ThreadPool* thread_pool);
 
   /**
    * Creates a container.
@@ -303,6 +306,11 @@ class Azure {
 
   class AzureRetryPolicy final : public azure::storage_lite::retry_policy_base {
    public:
+    /** Constructor. */
+    explicit AzureRetryPolicy(stats::Stats* const azure_stats)
+        : azure_stats_(azure_stats) {
+    }
+
     /**
      * The SDK invokes this routine before each request to Azure. This returns
      * a pair: a bool to indicate if we should make a request and a time
@@ -319,6 +327,10 @@ class Azure {
         return azure::storage_lite::retry_info(true, std::chrono::seconds(0));
       }
 
+      // Count the responses asking the client to back off.
+      if (http_code == 429 || http_code == 503)
+        azure_stats_->add_counter("vfs_azure_throttled_num", 1);
+
       // Determine if we should retry on the returned http code in the response.
       if (!should_retry(http_code)) {
         return azure::storage_lite::retry_info(false, std::chrono::seconds(0));
@@ -327,6 +339,7 @@ class Azure {
       // Wait one second before all retry attempts.
       static const int32_t max_retries = constants::azure_max_attempts;
       if (context.numbers() < max_retries) {
+        azure_stats_->add_counter("vfs_azure_retry_num", 1);
         return azure::storage_lite::retry_info(
             true,
             std::chrono::seconds(constants::azure_attempt_sleep_ms / 1000));
@@ -337,6 +350,9 @@ class Azure {
     }
 
    private:
+    /** The Azure `stats_`. */
+    stats::Stats* azure_stats_;
+
     /**
      * Returns true if we should attempt a retry after receiving 'http_code'
      * in the last response.
@@ -421,6 +437,22 @@ class Azure {
     }
   };
 
+  /**
+   * A zero-copy output stream buffer used to download directly into
+   * a single buffer through the stream-only SDK interface.
+   */
+  class ZeroCopyOutputStreamBuffer : public std::streambuf {
+   public:
+    ZeroCopyOutputStreamBuffer(char* const buffer, std::size_t size) {
+      setp(buffer, buffer + size);
+    }
+
+    /** Returns the number of bytes written into the buffer. */
+    std::size_t size() const {
+      return static_cast<std::size_t>(pptr() - pbase());
+    }
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -428,8 +460,20 @@ class Azure {
   /** The VFS thread pool. */
   ThreadPool* thread_pool_;
 
-  /** The Azure blob storage client. */
-  tdb_shared_ptr<azure::storage_lite::blob_client> client_;
+  /** The class stats. */
+  stats::Stats* stats_;
+
+  /** The storage account the client connects to. */
+  tdb_shared_ptr<azure::storage_lite::storage_account> account_;
+
+  /**
+   * The Azure blob storage client, constructed on first use. This is mutable
+   * so that nominally const functions can call init_client().
+   */
+  mutable tdb_shared_ptr<azure::storage_lite::blob_client> client_;
+
+  /** Protects the construction of `client_`. */
+  mutable std::mutex client_init_mtx_;
 
   /** Maps a blob URI to an write cache buffer. */
   std::unordered_map<std::string, Buffer> write_cache_map_;
@@ -460,6 +504,15 @@ class Azure {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Constructs the client, if it has not already been constructed. The
+   * client allocates a curl session per thread of the thread pool, so this
+   * is deferred from init() until Azure is actually used.
+   *
+   * @return Status
+   */
+  Status init_client() const;
+
   /**
    * Thread-safe fetch of the write cache buffer in `write_cache_map_`.
    * If a buffer does not exist for `uri`, it will be created.
@@ -0,0 +1,354 @@
+/**
+ * @file   disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DiskCache.
+ */
+
+#include "tiledb/sm/filesystem/disk_cache.h"
+#include "tiledb/common/logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The name prefix of entries being written. */
+const std::string tmp_prefix = ".tmp_";
+
+/** Temporary entries older than this (in seconds) were abandoned. */
+const time_t tmp_max_age = 3600;
+
+/** Returns the 64-bit FNV-1a hash of a string. */
+uint64_t fnv1a(const std::string& str) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : str) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+#ifndef _WIN32
+/** Reads exactly `nbytes` at `offset`; returns `false` otherwise. */
+bool pread_all(int fd, void* buffer, uint64_t nbytes, uint64_t offset) {
+  auto bytes = static_cast<char*>(buffer);
+  uint64_t nread = 0;
+  while (nread < nbytes) {
+    ssize_t n = ::pread(fd, bytes + nread, nbytes - nread, offset + nread);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    nread += n;
+  }
+  return true;
+}
+
+/** Writes all `nbytes`; returns `false` otherwise. */
+bool write_all(int fd, const void* buffer, uint64_t nbytes) {
+  auto bytes = static_cast<const char*>(buffer);
+  uint64_t written = 0;
+  while (written < nbytes) {
+    ssize_t n = ::write(fd, bytes + written, nbytes - written);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    written += n;
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+DiskCache::DiskCache()
+    : max_size_(0)
+    , size_(0)
+    , tmp_counter_(0) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status DiskCache::init(const std::string& dir, uint64_t max_size) {
+#ifdef _WIN32
+  (void)dir;
+  (void)max_size;
+  return LOG_STATUS(Status_VFSError(
+      "Cannot initialize disk cache; Not supported on Windows"));
+#else
+  if (dir.empty())
+    return LOG_STATUS(
+        Status_VFSError("Cannot initialize disk cache; Empty directory"));
+
+  // Create the directory and its missing parents.
+  std::string path = dir;
+  while (path.size() > 1 && path.back() == '/')
+    path.pop_back();
+  for (size_t pos = 0; pos != std::string::npos;) {
+    pos = path.find('/', pos + 1);
+    std::string prefix = path.substr(0, pos);
+    if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) {
+      return LOG_STATUS(Status_VFSError(
+          "Cannot initialize disk cache; Cannot create directory '" + prefix +
+          "': " + strerror(errno)));
+    }
+  }
+
+  dir_ = path;
+  max_size_ = max_size;
+  uint64_t size = 0;
+  RETURN_NOT_OK(scan(&size));
+  size_ = size;
+  return Status::Ok();
+#endif
+}
+
+bool DiskCache::enabled() const {
+  return !dir_.empty();
+}
+
+bool DiskCache::cacheable(const URI& uri) {
+  // Files named `__<timestamp>...` or inside such directories (fragments,
+  // array metadata, array schemas) are written once and never modified.
+  auto timestamped = [](const std::string& name) {
+    return name.size() > 2 && name[0] == '_' && name[1] == '_' &&
+           name[2] >= '0' && name[2] <= '9';
+  };
+  if (timestamped(uri.last_path_part()))
+    return true;
+  return timestamped(uri.parent().last_path_part());
+}
+
+Status DiskCache::read(
+    const URI& uri,
+    uint64_t offset,
+    void* buffer,
+    uint64_t nbytes,
+    bool* hit) const {
+  *hit = false;
+#ifdef _WIN32
+  (void)uri;
+  (void)offset;
+  (void)buffer;
+  (void)nbytes;
+  return Status::Ok();
+#else
+  const std::string uri_str = uri.to_string();
+  const std::string path = entry_path(uri_str, offset, nbytes);
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return Status::Ok();
+
+  // Check that the entry is complete and belongs to this URI.
+  const uint64_t header_size = sizeof(uint64_t) + uri_str.size();
+  struct stat st;
+  uint64_t uri_size = 0;
+  std::string entry_uri(uri_str.size(), '\0');
+  bool valid = fstat(fd, &st) == 0 &&
+               static_cast<uint64_t>(st.st_size) == header_size + nbytes &&
+               pread_all(fd, &uri_size, sizeof(uint64_t), 0) &&
+               uri_size == uri_str.size() &&
+               pread_all(fd, &entry_uri[0], uri_size, sizeof(uint64_t)) &&
+               entry_uri == uri_str &&
+               pread_all(fd, buffer, nbytes, header_size);
+
+  // Mark the entry as recently read.
+  if (valid)
+    futimens(fd, nullptr);
+  ::close(fd);
+
+  *hit = valid;
+  return Status::Ok();
+#endif
+}
+
+Status DiskCache::write(
+    const URI& uri, uint64_t offset, const void* buffer, uint64_t nbytes) {
+#ifdef _WIN32
+  (void)uri;
+  (void)offset;
+  (void)buffer;
+  (void)nbytes;
+  return Status::Ok();
+#else
+  if (nbytes > max_size_)
+    return Status::Ok();
+
+  // Write a temporary entry and publish it atomically, so that readers in
+  // any process never see a partial entry.
+  const std::string uri_str = uri.to_string();
+  const std::string tmp_path = dir_ + "/" + tmp_prefix +
+                               std::to_string(getpid()) + "_" +
+                               std::to_string(tmp_counter_++);
+  int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    return LOG_STATUS(Status_VFSError(
+        "Cannot write to disk cache; " + std::string(strerror(errno))));
+  }
+  const uint64_t uri_size = uri_str.size();
+  bool ok = write_all(fd, &uri_size, sizeof(uint64_t)) &&
+            write_all(fd, uri_str.data(), uri_size) &&
+            write_all(fd, buffer, nbytes);
+  ok = (::close(fd) == 0) && ok;
+  const std::string path = entry_path(uri_str, offset, nbytes);
+  if (!ok || ::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::string msg = strerror(errno);
+    ::unlink(tmp_path.c_str());
+    return LOG_STATUS(Status_VFSError("Cannot write to disk cache; " + msg));
+  }
+
+  size_ += sizeof(uint64_t) + uri_size + nbytes;
+  if (size_ > max_size_)
+    RETURN_NOT_OK(evict());
+
+  return Status::Ok();
+#endif
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+std::string DiskCache::entry_path(
+    const std::string& uri, uint64_t offset, uint64_t nbytes) const {
+  char hash[17];
+  snprintf(
+      hash,
+      sizeof(hash),
+      "%016llx",
+      static_cast<unsigned long long>(fnv1a(uri)));
+  return dir_ + "/" + hash + "_" + std::to_string(offset) + "_" +
+         std::to_string(nbytes);
+}
+
+Status DiskCache::evict() {
+#ifdef _WIN32
+  return Status::Ok();
+#else
+  std::lock_guard<std::mutex> lock(evict_mtx_);
+
+  // Another thread may have evicted in the meantime.
+  if (size_ <= max_size_)
+    return Status::Ok();
+
+  // Collect the entries, also dropping abandoned temporary ones.
+  DIR* dir = opendir(dir_.c_str());
+  if (dir == nullptr) {
+    return LOG_STATUS(Status_VFSError(
+        "Cannot evict from disk cache; " + std::string(strerror(errno))));
+  }
+  const time_t now = time(nullptr);
+  std::vector<std::tuple<struct timespec, uint64_t, std::string>> entries;
+  uint64_t total = 0;
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name == "." || name == "..")
+      continue;
+    std::string path = dir_ + "/" + name;
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+      continue;
+    if (name.compare(0, tmp_prefix.size(), tmp_prefix) == 0) {
+      if (now - st.st_mtime > tmp_max_age)
+        ::unlink(path.c_str());
+      continue;
+    }
+    entries.emplace_back(st.st_mtim, st.st_size, path);
+    total += st.st_size;
+  }
+  closedir(dir);
+
+  // Remove the least recently read entries first.
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    const auto& ta = std::get<0>(a);
+    const auto& tb = std::get<0>(b);
+    return ta.tv_sec < tb.tv_sec ||
+           (ta.tv_sec == tb.tv_sec && ta.tv_nsec < tb.tv_nsec);
+  });
+  for (const auto& entry : entries) {
+    if (total <= max_size_)
+      break;
+    // Another process may have removed the entry already.
+    ::unlink(std::get<2>(entry).c_str());
+    total -= std::get<1>(entry);
+  }
+
+  size_ = total;
+  return Status::Ok();
+#endif
+}
+
+Status DiskCache::scan(uint64_t* size) const {
+  *size = 0;
+#ifndef _WIN32
+  DIR* dir = opendir(dir_.c_str());
+  if (dir == nullptr) {
+    return LOG_STATUS(Status_VFSError(
+        "Cannot scan disk cache; " + std::string(strerror(errno))));
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.compare(0, tmp_prefix.size(), tmp_prefix) == 0)
+      continue;
+    struct stat st;
+    std::string path = dir_ + "/" + name;
+    if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+      *size += st.st_size;
+  }
+  closedir(dir);
+#endif
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
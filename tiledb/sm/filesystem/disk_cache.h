@@ -0,0 +1,168 @@
+/**
+ * @file   disk_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class DiskCache, a persistent local disk cache of
+ * object store reads.
+ */
+
+#ifndef TILEDB_DISK_CACHE_H
+#define TILEDB_DISK_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filesystem/uri.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A read-through cache of object store reads in a local directory, which
+ * persists across processes and can be shared by concurrent ones.
+ *
+ * Every cached read is a file of the directory keyed by the URI and the
+ * byte range it covers. Only files that are never modified once written,
+ * i.e. those in or named after timestamped directories such as fragments,
+ * are cached, so entries never need to be invalidated. Entries are
+ * published with an atomic rename, and the least recently read ones are
+ * evicted when the directory outgrows its size bound.
+ */
+class DiskCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  DiskCache();
+
+  /** Destructor. */
+  ~DiskCache() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the cache, creating its directory if needed.
+   *
+   * @param dir The local directory of the cache.
+   * @param max_size The maximum total size of the cached entries in bytes.
+   * @return Status
+   */
+  Status init(const std::string& dir, uint64_t max_size);
+
+  /** Returns `true` if the cache was initialized. */
+  bool enabled() const;
+
+  /** Returns `true` if the contents of the given object never change. */
+  static bool cacheable(const URI& uri);
+
+  /**
+   * Reads a range of an object from the cache.
+   *
+   * @param uri The URI of the object.
+   * @param offset The offset of the range.
+   * @param buffer The buffer to read into.
+   * @param nbytes The size of the range.
+   * @param hit Set to `true` if the range was cached and read.
+   * @return Status
+   */
+  Status read(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      bool* hit) const;
+
+  /**
+   * Adds a range of an object to the cache, evicting the least recently
+   * read entries if the cache grows over its size bound.
+   *
+   * @param uri The URI of the object.
+   * @param offset The offset of the range.
+   * @param buffer The contents of the range.
+   * @param nbytes The size of the range.
+   * @return Status
+   */
+  Status write(
+      const URI& uri, uint64_t offset, const void* buffer, uint64_t nbytes);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The directory of the cache. Empty if the cache is disabled. */
+  std::string dir_;
+
+  /** The maximum total size of the cached entries. */
+  uint64_t max_size_;
+
+  /** An estimate of the total size of the cached entries. */
+  std::atomic<uint64_t> size_;
+
+  /** A counter making temporary entry names unique within the process. */
+  std::atomic<uint64_t> tmp_counter_;
+
+  /** Serializes evictions within the process. */
+  std::mutex evict_mtx_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the path of the entry of a range of an object. */
+  std::string entry_path(
+      const std::string& uri, uint64_t offset, uint64_t nbytes) const;
+
+  /**
+   * Evicts the least recently read entries until the total size of the
+   * directory, which may be shared with other processes, fits the bound.
+   */
+  Status evict();
+
+  /**
+   * Sums up the sizes of the entries of the directory.
+   *
+   * @param size Set to the total size.
+   * @return Status
+   */
+  Status scan(uint64_t* size) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DISK_CACHE_H
@@ -45,6 +45,7 @@
 #include "tiledb/sm/filesystem/gcs.h"
 #include "tiledb/sm/global_state/global_state.h"
 #include "tiledb/sm/misc/math.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 
 using namespace tiledb::common;
@@ -347,11 +348,15 @@ Status GCS::remove_dir(const URI& uri) const {
         std::string("URI is not a GCS URI: " + uri.to_string())));
   }
 
+  // The storage client has no batch delete, so the objects are deleted in
+  // parallel on the VFS thread pool
   std::vector<std::string> paths;
   RETURN_NOT_OK(ls(uri, &paths, ""));
-  for (const auto& path : paths) {
-    RETURN_NOT_OK(remove_object(URI(path)));
-  }
+  auto status = parallel_for(thread_pool_, 0, paths.size(), [&](uint64_t i) {
+    RETURN_NOT_OK(remove_object(URI(paths[i])));
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
 
   return Status::Ok();
 }
@@ -780,16 +785,10 @@ Status GCS::write_parts(
         std::string("URI is not an GCS URI: " + uri.to_string())));
   }
 
-  // Ensure that each thread is responsible for exactly multi_part_part_size_
-  // bytes (except if this is the last part, in which case the final
-  // thread should write less). Cap the number of parallel operations at the
-  // configured max number. Length must be evenly divisible by
-  // multi_part_part_size_ unless this is the last part.
-  uint64_t num_ops = last_part ?
-                         utils::math::ceil(length, multi_part_part_size_) :
-                         (length / multi_part_part_size_);
-  num_ops = std::min(std::max(num_ops, uint64_t(1)), max_parallel_ops_);
-
+  // Each part is exactly multi_part_part_size_ bytes, except if this is
+  // the last part, in which case the final part may be shorter. Length
+  // must be evenly divisible by multi_part_part_size_ unless this is the
+  // last part.
   if (!last_part && length % multi_part_part_size_ != 0) {
     return LOG_STATUS(
         Status_S3Error("Length not evenly divisible by part size"));
@@ -850,57 +849,52 @@ Status GCS::write_parts(
     unique_rl.unlock();
   }
 
-  if (num_ops == 1) {
+  // Upload the parts in the background so that they overlap with the
+  // writes that follow, and wait only for the oldest ones to keep at most
+  // `max_parallel_ops_` parts in flight per object. The part data is
+  // copied, so the caller may reuse `buffer` on return. An earlier failed
+  // part fails this write, and the parts are cleaned up on flush.
+  const uint64_t max_in_flight = std::max(max_parallel_ops_, uint64_t(1));
+  const char* const bytes = static_cast<const char*>(buffer);
+  for (uint64_t begin = 0; begin < length; begin += multi_part_part_size_) {
+    RETURN_NOT_OK(wait_for_parts(state, max_in_flight - 1));
+
+    const uint64_t part_len = std::min(multi_part_part_size_, length - begin);
+    std::string data(bytes + begin, static_cast<size_t>(part_len));
     const std::string object_part_path = state->next_part_path();
 
-    const Status st =
-        upload_part(bucket_name, object_part_path, buffer, length);
-    state->update_st(st);
-    state_lck.unlock();
-    return st;
-  } else {
-    std::vector<ThreadPool::Task> tasks;
-    tasks.reserve(num_ops);
-    for (uint64_t i = 0; i < num_ops; i++) {
-      const uint64_t begin = i * multi_part_part_size_;
-      const uint64_t end =
-          std::min((i + 1) * multi_part_part_size_ - 1, length - 1);
-      const char* const thread_buffer =
-          reinterpret_cast<const char*>(buffer) + begin;
-      const uint64_t thread_buffer_len = end - begin + 1;
-      const std::string object_part_path = state->next_part_path();
-
-      std::function<Status()> upload_part_fn = std::bind(
-          &GCS::upload_part,
-          this,
-          bucket_name,
-          object_part_path,
-          thread_buffer,
-          thread_buffer_len);
-      ThreadPool::Task task = thread_pool_->execute(std::move(upload_part_fn));
-      tasks.emplace_back(std::move(task));
-    }
+    std::function<Status()> upload_part_fn =
+        [this, bucket_name, object_part_path, data = std::move(data)]()
+            mutable {
+              return upload_part(
+                  bucket_name, object_part_path, std::move(data));
+            };
+    state->tasks_.emplace_back(
+        thread_pool_->execute(std::move(upload_part_fn)));
+  }
 
-    const Status st = thread_pool_->wait_all(tasks);
-    state->update_st(st);
-    state_lck.unlock();
-    return st;
+  return state->st();
+}
+
+Status GCS::wait_for_parts(
+    MultiPartUploadState* const state, const uint64_t max_in_flight) {
+  while (state->tasks_.size() > max_in_flight) {
+    std::vector<ThreadPool::Task> oldest;
+    oldest.emplace_back(std::move(state->tasks_.front()));
+    state->tasks_.pop_front();
+    state->update_st(thread_pool_->wait_all(oldest));
   }
 
-  return Status::Ok();
+  return state->st();
 }
 
 Status GCS::upload_part(
     const std::string& bucket_name,
     const std::string& object_part_path,
-    const void* const buffer,
-    const uint64_t length) {
-  std::string write_buffer(
-      static_cast<const char*>(buffer), static_cast<size_t>(length));
-
+    std::string&& data) {
   google::cloud::StatusOr<google::cloud::storage::ObjectMetadata>
-      object_metadata = client_->InsertObject(
-          bucket_name, object_part_path, std::move(write_buffer));
+      object_metadata =
+          client_->InsertObject(bucket_name, object_part_path, std::move(data));
 
   if (!object_metadata.ok()) {
     const google::cloud::Status status = object_metadata.status();
@@ -944,6 +938,9 @@ Status GCS::flush_object(const URI& uri) {
   std::unique_lock<std::mutex> state_lck(state->mtx_);
   unique_rl.unlock();
 
+  // Wait for the parts still being uploaded.
+  Status st = wait_for_parts(state, 0);
+
   const std::vector<std::string> part_paths = state->get_part_paths();
 
   std::string bucket_name;
@@ -952,9 +949,10 @@ Status GCS::flush_object(const URI& uri) {
 
   // Wait for the last written part to propogate to ensure all parts
   // are available for composition into a single object.
-  std::string last_part_path = part_paths.back();
-  const Status st = wait_for_object_to_propagate(bucket_name, last_part_path);
-  state->update_st(st);
+  if (st.ok() && !part_paths.empty()) {
+    st = wait_for_object_to_propagate(bucket_name, part_paths.back());
+    state->update_st(st);
+  }
   state_lck.unlock();
 
   if (!st.ok()) {
@@ -965,7 +963,7 @@ Status GCS::flush_object(const URI& uri) {
     // transactions.
     finish_multi_part_upload(uri);
 
-    return Status::Ok();
+    return st;
   }
 
   // Build a list of objects to compose.
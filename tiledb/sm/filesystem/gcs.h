@@ -36,6 +36,8 @@
 #ifdef HAVE_GCS
 
 #include <google/cloud/storage/client.h>
+#include <deque>
+#include <unordered_map>
 
 #include "tiledb/common/rwlock.h"
 #include "tiledb/common/status.h"
@@ -305,6 +307,7 @@ class GCS {
       this->next_part_id_ = other.next_part_id_;
       this->part_paths_ = std::move(other.part_paths_);
       this->st_ = other.st_;
+      this->tasks_ = std::move(other.tasks_);
     }
 
     // Copy initialization
@@ -349,6 +352,12 @@ class GCS {
       }
     }
 
+    /**
+     * The part uploads still in flight, oldest first. These are not
+     * copied with the state.
+     */
+    std::deque<ThreadPool::Task> tasks_;
+
     /** Mutex for thread safety */
     mutable std::mutex mtx_;
 
@@ -591,15 +600,24 @@ class GCS {
    *
    * @param bucket_name The object's bucket name.
    * @param object_part_path The object's part path.
-   * @param length The length of `buffer`.
-   * @param part_id A unique integer identifier for this part.
+   * @param data The part data.
    * @return Status
    */
   Status upload_part(
       const std::string& bucket_name,
       const std::string& object_part_path,
-      const void* const buffer,
-      const uint64_t length);
+      std::string&& data);
+
+  /**
+   * Waits for the oldest part uploads of `state` until at most
+   * `max_in_flight` of them remain in flight, recording any failure in
+   * the state. The caller must hold the state mutex.
+   *
+   * @param state The multipart upload state.
+   * @param max_in_flight The number of uploads allowed to remain.
+   * @return The aggregate status of the state.
+   */
+  Status wait_for_parts(MultiPartUploadState* state, uint64_t max_in_flight);
 
   /**
    * Performs a best-effort to delete all objects in 'part_paths'.
@@ -122,6 +122,8 @@ class LibHDFS {
   std::function<hdfsFS(hdfsBuilder*)> hdfsBuilderConnect;
   std::function<hdfsBuilder*()> hdfsNewBuilder;
   std::function<void(hdfsBuilder*, const char*)> hdfsBuilderSetNameNode;
+  std::function<int(hdfsBuilder*, const char*, const char*)>
+      hdfsBuilderConfSetStr;
   std::function<int(const char*, char**)> hdfsConfGetStr;
   std::function<void(hdfsBuilder*, const char* kerbTicketCachePath)>
       hdfsBuilderSetKerbTicketCachePath;
@@ -155,6 +157,7 @@ class LibHDFS {
       BIND_HDFS_FUNC(hdfsBuilderConnect);
       BIND_HDFS_FUNC(hdfsNewBuilder);
       BIND_HDFS_FUNC(hdfsBuilderSetNameNode);
+      BIND_HDFS_FUNC(hdfsBuilderConfSetStr);
       BIND_HDFS_FUNC(hdfsConfGetStr);
       BIND_HDFS_FUNC(hdfsBuilderSetKerbTicketCachePath);
       BIND_HDFS_FUNC(hdfsBuilderSetUserName);
@@ -215,58 +218,74 @@ HDFS::HDFS()
 Status HDFS::init(const Config& config) {
   // Get config
   bool found = false;
-  std::string name_node_uri = config.get("vfs.hdfs.name_node_uri", &found);
+  name_node_uri_ = config.get("vfs.hdfs.name_node_uri", &found);
   assert(found);
-  std::string username = config.get("vfs.hdfs.username", &found);
+  username_ = config.get("vfs.hdfs.username", &found);
   assert(found);
-  std::string kerb_ticket_cache_path =
+  kerb_ticket_cache_path_ =
       config.get("vfs.hdfs.kerb_ticket_cache_path", &found);
   assert(found);
+  RETURN_NOT_OK(config.get<bool>(
+      "vfs.hdfs.short_circuit_reads", &short_circuit_reads_, &found));
+  assert(found);
+  domain_socket_path_ = config.get("vfs.hdfs.domain_socket_path", &found);
+  assert(found);
+
+  // The namenode is connected to on the first use of HDFS.
+  return Status::Ok();
+}
+
+Status HDFS::disconnect() {
+  RETURN_NOT_OK(libhdfs_->status());
+  std::lock_guard<std::mutex> lck(connect_mtx_);
+  if (hdfs_ == nullptr)
+    return Status::Ok();
+  close_read_handles(hdfs_, "");
+  if (libhdfs_->hdfsDisconnect(hdfs_) != 0) {
+    return LOG_STATUS(Status_HDFSError("Failed to disconnect hdfs"));
+  }
+  hdfs_ = nullptr;
+  return Status::Ok();
+}
 
-  // if libhdfs does not exist, just return and fail lazily on connection
-  if (!libhdfs_->status().ok()) {
+// We only connect once to a single fs, on its first use
+Status HDFS::connect(hdfsFS* fs) {
+  RETURN_NOT_OK(libhdfs_->status());
+  std::lock_guard<std::mutex> lck(connect_mtx_);
+  if (hdfs_ != nullptr) {
+    *fs = hdfs_;
     return Status::Ok();
   }
+
   struct hdfsBuilder* builder = libhdfs_->hdfsNewBuilder();
   if (builder == nullptr) {
     return LOG_STATUS(Status_HDFSError(
         "Failed to connect to hdfs, could not create connection builder"));
   }
   libhdfs_->hdfsBuilderSetForceNewInstance(builder);
-  if (name_node_uri.empty())
-    name_node_uri = "default";
+  const std::string name_node_uri =
+      name_node_uri_.empty() ? "default" : name_node_uri_;
   libhdfs_->hdfsBuilderSetNameNode(builder, name_node_uri.c_str());
-  if (!username.empty())
-    libhdfs_->hdfsBuilderSetUserName(builder, username.c_str());
-  if (!kerb_ticket_cache_path.empty()) {
+  if (!username_.empty())
+    libhdfs_->hdfsBuilderSetUserName(builder, username_.c_str());
+  if (!kerb_ticket_cache_path_.empty()) {
     libhdfs_->hdfsBuilderSetKerbTicketCachePath(
-        builder, kerb_ticket_cache_path.c_str());
+        builder, kerb_ticket_cache_path_.c_str());
+  }
+  if (short_circuit_reads_) {
+    libhdfs_->hdfsBuilderConfSetStr(
+        builder, "dfs.client.read.shortcircuit", "true");
+    if (!domain_socket_path_.empty()) {
+      libhdfs_->hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", domain_socket_path_.c_str());
+    }
   }
-  // TODO: Set config strings
   hdfs_ = libhdfs_->hdfsBuilderConnect(builder);
   if (hdfs_ == nullptr) {
     // TODO: errno for better options
     return LOG_STATUS(Status_HDFSError(
         std::string("Failed to connect to HDFS namenode: ") + name_node_uri));
   }
-  return Status::Ok();
-}
-
-Status HDFS::disconnect() {
-  RETURN_NOT_OK(libhdfs_->status());
-  if (libhdfs_->hdfsDisconnect(hdfs_) != 0) {
-    return LOG_STATUS(Status_HDFSError("Failed to disconnect hdfs"));
-  }
-  hdfs_ = nullptr;
-  return Status::Ok();
-}
-
-// Stub definition, we only try to connect once to a single fs at a time
-Status HDFS::connect(hdfsFS* fs) {
-  RETURN_NOT_OK(libhdfs_->status());
-  if (hdfs_ == nullptr) {
-    return LOG_STATUS(Status_HDFSError("Not connected to HDFS namenode"));
-  }
   *fs = hdfs_;
   return Status::Ok();
 }
@@ -314,6 +333,7 @@ Status HDFS::create_dir(const URI& uri) {
 Status HDFS::remove_dir(const URI& uri) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
+  close_read_handles(fs, uri.to_path());
   int rc = libhdfs_->hdfsDelete(fs, uri.to_path().c_str(), 1);
   if (rc < 0) {
     return LOG_STATUS(
@@ -330,6 +350,7 @@ Status HDFS::move_path(const URI& old_uri, const URI& new_uri) {
         "Cannot move path " + old_uri.to_string() + " to " +
         new_uri.to_string() + "; path exists."));
   }
+  close_read_handles(fs, old_uri.to_path());
   int ret = libhdfs_->hdfsRename(
       fs, old_uri.to_path().c_str(), new_uri.to_path().c_str());
   if (ret < 0) {
@@ -389,6 +410,7 @@ Status HDFS::touch(const URI& uri) {
 Status HDFS::remove_file(const URI& uri) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
+  close_read_handles(fs, uri.to_path());
   int ret = libhdfs_->hdfsDelete(fs, uri.to_path().c_str(), 0);
   if (ret < 0) {
     return LOG_STATUS(
@@ -400,52 +422,106 @@ Status HDFS::remove_file(const URI& uri) {
 Status HDFS::read(const URI& uri, off_t offset, void* buffer, uint64_t length) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
-  hdfsFile readFile =
-      libhdfs_->hdfsOpenFile(fs, uri.to_path().c_str(), O_RDONLY, length, 0, 0);
-  if (!readFile) {
-    return LOG_STATUS(Status_HDFSError(
-        std::string("Cannot read file ") + uri.to_string() +
-        ": file open error"));
-  }
   if (offset > std::numeric_limits<tOffset>::max()) {
     return LOG_STATUS(Status_HDFSError(
         std::string("Cannot read from from '") + uri.to_string() +
         "'; offset > typemax(tOffset)"));
   }
+  const std::string path = uri.to_path();
+  hdfsFile readFile = nullptr;
+  uint64_t epoch = 0;
+  RETURN_NOT_OK(acquire_read_handle(fs, path, &readFile, &epoch));
+
+  // Positional reads leave the offset of the handle alone, so that the
+  // handle can be reused by any later read of the file
   tOffset off = static_cast<tOffset>(offset);
-  int ret = libhdfs_->hdfsSeek(fs, readFile, off);
-  if (ret < 0) {
-    return LOG_STATUS(Status_HDFSError(
-        std::string("Cannot seek to offset ") + uri.to_string()));
-  }
   uint64_t bytes_to_read = length;
   char* buffptr = static_cast<char*>(buffer);
-  do {
+  while (bytes_to_read > 0) {
     tSize nbytes = (bytes_to_read <= INT_MAX) ? bytes_to_read : INT_MAX;
-    tSize bytes_read =
-        libhdfs_->hdfsRead(fs, readFile, static_cast<void*>(buffptr), nbytes);
-    if (bytes_read < 0) {
+    tSize bytes_read = libhdfs_->hdfsPread(
+        fs, readFile, off, static_cast<void*>(buffptr), nbytes);
+    if (bytes_read <= 0) {
+      libhdfs_->hdfsCloseFile(fs, readFile);
       return LOG_STATUS(Status_HDFSError(
           "Cannot read from file " + uri.to_string() + "; File reading error"));
     }
     bytes_to_read -= bytes_read;
     buffptr += bytes_read;
-  } while (bytes_to_read > 0);
+    off += bytes_read;
+  }
 
-  // Close file
-  if (libhdfs_->hdfsCloseFile(fs, readFile)) {
+  release_read_handle(fs, path, readFile, epoch);
+  return Status::Ok();
+}
+
+Status HDFS::acquire_read_handle(
+    hdfsFS fs, const std::string& path, hdfsFile* file, uint64_t* epoch) {
+  {
+    std::lock_guard<std::mutex> lck(read_handles_mtx_);
+    *epoch = read_handles_epoch_;
+    auto it = read_handles_.find(path);
+    if (it != read_handles_.end()) {
+      *file = it->second.back();
+      it->second.pop_back();
+      if (it->second.empty())
+        read_handles_.erase(it);
+      --idle_read_handle_num_;
+      return Status::Ok();
+    }
+  }
+
+  *file = libhdfs_->hdfsOpenFile(fs, path.c_str(), O_RDONLY, 0, 0, 0);
+  if (!*file) {
     return LOG_STATUS(Status_HDFSError(
-        std::string("Cannot read from file ") + uri.to_string() +
-        "; File closing error"));
+        std::string("Cannot read file ") + path + ": file open error"));
   }
   return Status::Ok();
 }
 
+void HDFS::release_read_handle(
+    hdfsFS fs, const std::string& path, hdfsFile file, uint64_t epoch) {
+  {
+    std::lock_guard<std::mutex> lck(read_handles_mtx_);
+    if (epoch == read_handles_epoch_ &&
+        idle_read_handle_num_ < constants::hdfs_max_idle_read_handles) {
+      read_handles_[path].push_back(file);
+      ++idle_read_handle_num_;
+      return;
+    }
+  }
+  libhdfs_->hdfsCloseFile(fs, file);
+}
+
+void HDFS::close_read_handles(hdfsFS fs, const std::string& path) {
+  std::vector<hdfsFile> files;
+  {
+    std::lock_guard<std::mutex> lck(read_handles_mtx_);
+    ++read_handles_epoch_;
+    const std::string dir =
+        utils::parse::ends_with(path, "/") ? path : path + "/";
+    for (auto it = read_handles_.begin(); it != read_handles_.end();) {
+      if (path.empty() || it->first == path ||
+          utils::parse::starts_with(it->first, dir)) {
+        files.insert(files.end(), it->second.begin(), it->second.end());
+        idle_read_handle_num_ -= it->second.size();
+        it = read_handles_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto file : files)
+    libhdfs_->hdfsCloseFile(fs, file);
+}
+
 Status HDFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   hdfsFS fs = nullptr;
   RETURN_NOT_OK(connect(&fs));
   bool file_exists = false;
   RETURN_NOT_OK(is_file(uri, &file_exists));
+  if (file_exists)
+    close_read_handles(fs, uri.to_path());
   int flags = file_exists ? O_WRONLY | O_APPEND : O_WRONLY;
   hdfsFile write_file = libhdfs_->hdfsOpenFile(
       fs, uri.to_path().c_str(), flags, constants::max_write_bytes, 0, 0);
@@ -36,7 +36,9 @@
 #ifdef HAVE_HDFS
 
 #include <sys/types.h>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "tiledb/common/status.h"
@@ -63,9 +65,9 @@ class HDFS {
   /**
    * Initializes the HDFS VFS backend
    *
-   * If libhdfs is not found, returns immediately.
-   * If libhdfs is found, attempts to connect to the
-   * default HDFS namenode defined in the Config::HDFSParams object.
+   * Only the connection parameters are read here. The namenode defined in
+   * the Config::HDFSParams object is connected to on the first use of HDFS,
+   * so that contexts which never touch HDFS do not pay for it.
    *
    * @param config HDFS configuration parameter object
    * @return Status
@@ -141,7 +143,9 @@ class HDFS {
   Status remove_dir(const URI& uri);
 
   /**
-   *  Reads data from a file into a buffer.
+   *  Reads data from a file into a buffer, with positional reads. The file
+   *  handle is kept open for the next reads of the file, and concurrent
+   *  reads of a file each use their own handle.
    *
    * @param uri The URI of the file to be read.
    * @param offset The offset in the file from which the read will start.
@@ -196,10 +200,68 @@ class HDFS {
   hdfsFS hdfs_;
   LibHDFS* libhdfs_;
 
-  /** Connect to hdfsFS and return handle, stub for future cached dynamic
-   * connections **/
+  /** The namenode to connect to, "default" if empty. */
+  std::string name_node_uri_;
+
+  /** The user to connect as, if not empty. */
+  std::string username_;
+
+  /** The Kerberos ticket cache path, if not empty. */
+  std::string kerb_ticket_cache_path_;
+
+  /** Whether blocks on the local datanode are read directly from disk. */
+  bool short_circuit_reads_ = false;
+
+  /** The domain socket of the local datanode, from Hadoop's config if empty. */
+  std::string domain_socket_path_;
+
+  /** Protects the connection of `hdfs_`. */
+  std::mutex connect_mtx_;
+
+  /** Protects the read handles. */
+  std::mutex read_handles_mtx_;
+
+  /** The idle handles opened for reading, per file path. */
+  std::unordered_map<std::string, std::vector<hdfsFile>> read_handles_;
+
+  /** The number of handles in `read_handles_`. */
+  uint64_t idle_read_handle_num_ = 0;
+
+  /**
+   * Incremented whenever handles are invalidated, so that handles in use
+   * at the time are closed instead of being returned to `read_handles_`.
+   */
+  uint64_t read_handles_epoch_ = 0;
+
+  /** Connect to hdfsFS on first use and return handle, stub for future cached
+   * dynamic connections **/
   Status connect(hdfsFS* fs);
 
+  /**
+   * Takes an idle handle of a file opened for reading, or opens a new one.
+   *
+   * @param fs Connected hdfsFS filesystem handle.
+   * @param path The path of the file.
+   * @param file Set to the handle.
+   * @param epoch Set to the epoch to pass back to `release_read_handle`.
+   * @return Status
+   */
+  Status acquire_read_handle(
+      hdfsFS fs, const std::string& path, hdfsFile* file, uint64_t* epoch);
+
+  /**
+   * Returns a handle taken by `acquire_read_handle` to the idle handles, or
+   * closes it if the handles were invalidated since or too many are idle.
+   */
+  void release_read_handle(
+      hdfsFS fs, const std::string& path, hdfsFile file, uint64_t epoch);
+
+  /**
+   * Closes the idle read handles of a file, or of all the files under a
+   * directory, as the file is about to change.
+   */
+  void close_read_handles(hdfsFS fs, const std::string& path);
+
   HDFS(HDFS const& l);             // disable copy ctor
   HDFS& operator=(HDFS const& l);  // disable assignment
 };
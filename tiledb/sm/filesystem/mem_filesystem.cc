@@ -31,7 +31,9 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <unordered_set>
 
@@ -98,12 +100,22 @@ class MemFilesystem::FSNode {
   /** Outputs the contents of a buffer to this node */
   virtual Status append(const void* data, const uint64_t nbytes) = 0;
 
+  /** Returns a view of the contents of the node, see `MemFilesystem::view` */
+  virtual Status view(
+      const uint64_t offset,
+      const uint64_t nbytes,
+      char** data,
+      std::shared_ptr<void>* owner) const = 0;
+
   /* ********************************* */
   /*         PUBLIC ATTRIBUTES         */
   /* ********************************* */
 
-  /** Protects `children_`. */
-  mutable std::mutex mutex_;
+  /**
+   * Protects `children_` and the file contents. Readers take it in shared
+   * mode, so that lookups and reads do not exclude each other.
+   */
+  mutable std::shared_mutex mutex_;
 
   /** A hashtable of all the next-level subnodes of this node*/
   std::unordered_map<std::string, tdb_unique_ptr<FSNode>> children_;
@@ -118,7 +130,6 @@ class MemFilesystem::File : public MemFilesystem::FSNode {
   /** Default constructor. */
   File()
       : FSNode()
-      , data_(nullptr)
       , size_(0) {
   }
 
@@ -129,11 +140,7 @@ class MemFilesystem::File : public MemFilesystem::FSNode {
   DISABLE_MOVE(File);
 
   /** Destructor. */
-  ~File() {
-    if (data_) {
-      tdb_free(data_);
-    }
-  }
+  ~File() = default;
 
   /* ********************************* */
   /*             OPERATORS             */
@@ -192,8 +199,19 @@ class MemFilesystem::File : public MemFilesystem::FSNode {
     if (offset + nbytes > size_)
       return LOG_STATUS(
           Status_MemFSError("Cannot read from file; Read exceeds file size"));
+    if (nbytes == 0)
+      return Status::Ok();
+
+    auto out = static_cast<char*>(buffer);
+    uint64_t pos = offset;
+    const uint64_t end = offset + nbytes;
+    for (auto chunk = find_chunk(offset); pos < end; ++chunk) {
+      const uint64_t n = std::min(end, chunk->start_ + chunk->size_) - pos;
+      memcpy(out, chunk->data_.get() + (pos - chunk->start_), n);
+      out += n;
+      pos += n;
+    }
 
-    memcpy(buffer, (char*)data_ + offset, nbytes);
     return Status::Ok();
   }
 
@@ -207,41 +225,122 @@ class MemFilesystem::File : public MemFilesystem::FSNode {
           std::string("Wrong input buffer or size when writing to file")));
     }
 
-    if (data_ == nullptr) {
-      data_ = tdb_malloc(nbytes);
-      if (data_ == nullptr) {
+    // The data of an append goes to a single chunk, so that it can be
+    // viewed in place. The bytes already written are never moved, which
+    // keeps the views of the file valid.
+    if (chunks_.empty() ||
+        chunks_.back().capacity_ - chunks_.back().size_ < nbytes) {
+      Chunk chunk;
+      chunk.start_ = size_;
+      chunk.capacity_ = std::max(nbytes, std::min(size_, max_spare_bytes));
+      chunk.data_ = std::shared_ptr<char>(
+          static_cast<char*>(tdb_malloc(chunk.capacity_)),
+          [](char* p) { tdb_free(p); });
+      if (chunk.data_ == nullptr) {
         return LOG_STATUS(Status_MemFSError(
             std::string("Out of memory, cannot write to file")));
       }
-      memcpy(data_, data, nbytes);
-      size_ = nbytes;
-    } else {
-      void* new_data;
-      new_data = tdb_realloc(data_, size_ + nbytes);
-
-      if (new_data == nullptr) {
-        return LOG_STATUS(
-            Status_MemFSError("Out of memory, cannot append new data to file"));
-      }
+      chunks_.emplace_back(std::move(chunk));
+    }
+
+    auto& last = chunks_.back();
+    memcpy(last.data_.get() + last.size_, data, nbytes);
+    last.size_ += nbytes;
+    size_ += nbytes;
+
+    return Status::Ok();
+  }
+
+  /**
+   * Views nbytes of this file starting at offset. Ranges written by a
+   * single append are viewed in place, the others are copied.
+   */
+  Status view(
+      const uint64_t offset,
+      const uint64_t nbytes,
+      char** const data,
+      std::shared_ptr<void>* const owner) const override {
+    assert(!mutex_.try_lock());
 
-      memcpy((char*)new_data + size_, data, nbytes);
-      data_ = new_data;
-      size_ += nbytes;
+    if (offset + nbytes > size_)
+      return LOG_STATUS(
+          Status_MemFSError("Cannot view file; View exceeds file size"));
+    if (nbytes == 0) {
+      *data = nullptr;
+      owner->reset();
+      return Status::Ok();
     }
 
+    auto chunk = find_chunk(offset);
+    if (offset + nbytes <= chunk->start_ + chunk->size_) {
+      *data = chunk->data_.get() + (offset - chunk->start_);
+      *owner = chunk->data_;
+      return Status::Ok();
+    }
+
+    std::shared_ptr<char> copy(
+        static_cast<char*>(tdb_malloc(nbytes)), [](char* p) { tdb_free(p); });
+    if (copy == nullptr) {
+      return LOG_STATUS(
+          Status_MemFSError(std::string("Out of memory, cannot view file")));
+    }
+    RETURN_NOT_OK(read(offset, copy.get(), nbytes));
+    *data = copy.get();
+    *owner = std::move(copy);
     return Status::Ok();
   }
 
  private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES          */
+  /* ********************************* */
+
+  /** A contiguous part of the file data. */
+  struct Chunk {
+    /** The data, shared with the views of the chunk. */
+    std::shared_ptr<char> data_;
+
+    /** The offset of the chunk in the file. */
+    uint64_t start_ = 0;
+
+    /** The number of bytes written to the chunk. */
+    uint64_t size_ = 0;
+
+    /** The number of bytes allocated for the chunk. */
+    uint64_t capacity_ = 0;
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
-  /** the data stored in this file */
-  void* data_;
+  /**
+   * The maximum room reserved for future appends when allocating a chunk.
+   * Up to it, chunks grow geometrically so that small appends do not
+   * allocate every time.
+   */
+  static constexpr uint64_t max_spare_bytes = 1 << 20;
+
+  /** The data stored in this file, sorted on offset. */
+  std::vector<Chunk> chunks_;
 
   /** the size in bytes of the data in this file */
   uint64_t size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS           */
+  /* ********************************* */
+
+  /** Returns the chunk holding the byte at `offset`, which must exist. */
+  std::vector<Chunk>::const_iterator find_chunk(const uint64_t offset) const {
+    auto it = std::upper_bound(
+        chunks_.begin(),
+        chunks_.end(),
+        offset,
+        [](uint64_t o, const Chunk& chunk) { return o < chunk.start_; });
+    assert(it != chunks_.begin());
+    return --it;
+  }
 };
 
 class MemFilesystem::Directory : public MemFilesystem::FSNode {
@@ -335,6 +434,21 @@ class MemFilesystem::Directory : public MemFilesystem::FSNode {
     return LOG_STATUS(Status_MemFSError(
         std::string("Cannot append contents, the path is a directory")));
   }
+
+  Status view(
+      const uint64_t offset,
+      const uint64_t nbytes,
+      char** const data,
+      std::shared_ptr<void>* const owner) const override {
+    assert(!mutex_.try_lock());
+
+    (void)offset;
+    (void)nbytes;
+    (void)data;
+    (void)owner;
+    return LOG_STATUS(Status_MemFSError(
+        std::string("Cannot view contents, the path is a directory")));
+  }
 };
 
 MemFilesystem::MemFilesystem()
@@ -354,7 +468,7 @@ Status MemFilesystem::file_size(
   assert(size);
 
   FSNode* cur;
-  std::unique_lock<std::mutex> cur_lock;
+  std::shared_lock<std::shared_mutex> cur_lock;
   RETURN_NOT_OK(lookup_node(path, &cur, &cur_lock));
 
   if (cur == nullptr) {
@@ -367,7 +481,7 @@ Status MemFilesystem::file_size(
 
 bool MemFilesystem::is_dir(const std::string& path) const {
   FSNode* cur;
-  std::unique_lock<std::mutex> cur_lock;
+  std::shared_lock<std::shared_mutex> cur_lock;
   if (!lookup_node(path, &cur, &cur_lock).ok() || cur == nullptr) {
     return false;
   }
@@ -377,7 +491,7 @@ bool MemFilesystem::is_dir(const std::string& path) const {
 
 bool MemFilesystem::is_file(const std::string& path) const {
   FSNode* cur;
-  std::unique_lock<std::mutex> cur_lock;
+  std::shared_lock<std::shared_mutex> cur_lock;
   if (!lookup_node(path, &cur, &cur_lock).ok() || cur == nullptr) {
     return false;
   }
@@ -391,25 +505,18 @@ Status MemFilesystem::ls(
 
   std::vector<std::string> tokens = tokenize(path);
 
-  FSNode* cur = root_.get();
-  std::unique_lock<std::mutex> cur_lock(cur->mutex_);
+  FSNode* cur;
+  std::shared_lock<std::shared_mutex> cur_lock;
+  RETURN_NOT_OK(lookup_node(tokens, &cur, &cur_lock));
+  if (cur == nullptr) {
+    return LOG_STATUS(Status_MemFSError(
+        std::string("Unable to list on non-existent path ") + path));
+  }
+
   std::string dir;
-  for (auto& token : tokens) {
-    assert(cur_lock.owns_lock());
-    assert(cur_lock.mutex() == &cur->mutex_);
+  for (const auto& token : tokens)
     dir = dir + token + "/";
 
-    if (cur->children_.count(token) != 1) {
-      return LOG_STATUS(Status_MemFSError(
-          std::string("Unable to list on non-existent path ") + path));
-    }
-
-    cur = cur->children_[token].get();
-    cur_lock = std::unique_lock<std::mutex>(cur->mutex_);
-  }
-
-  assert(cur_lock.owns_lock());
-  assert(cur_lock.mutex() == &cur->mutex_);
   RETURN_NOT_OK(cur->ls(dir, paths));
 
   return Status::Ok();
@@ -430,12 +537,13 @@ Status MemFilesystem::move(
 
   // Lookup the `old_path` parent.
   FSNode* old_node_parent;
-  std::unique_lock<std::mutex> old_node_parent_lock;
+  std::unique_lock<std::shared_mutex> old_node_parent_lock;
   RETURN_NOT_OK(
       lookup_node(old_path_tokens, &old_node_parent, &old_node_parent_lock));
 
   // Detach `old_path` from the directory tree.
-  if (old_node_parent->children_.count(old_path_last_token) == 0) {
+  if (old_node_parent == nullptr ||
+      old_node_parent->children_.count(old_path_last_token) == 0) {
     return LOG_STATUS(Status_MemFSError(
         std::string("Move failed, file not found: " + old_path)));
   }
@@ -460,9 +568,13 @@ Status MemFilesystem::move(
 
   // Lookup the `new_path` parent.
   FSNode* new_node_parent;
-  std::unique_lock<std::mutex> new_node_parent_lock;
+  std::unique_lock<std::shared_mutex> new_node_parent_lock;
   RETURN_NOT_OK(
       lookup_node(new_path_tokens, &new_node_parent, &new_node_parent_lock));
+  if (new_node_parent == nullptr) {
+    return LOG_STATUS(Status_MemFSError(
+        std::string("Move failed, parent directory not found: " + new_path)));
+  }
 
   // Add `old_path` to the directory tree.
   new_node_parent->children_[new_path_last_token] = std::move(old_node_ptr);
@@ -476,7 +588,7 @@ Status MemFilesystem::read(
     void* const buffer,
     const uint64_t nbytes) const {
   FSNode* node;
-  std::unique_lock<std::mutex> node_lock;
+  std::shared_lock<std::shared_mutex> node_lock;
   RETURN_NOT_OK(lookup_node(path, &node, &node_lock));
 
   if (node == nullptr) {
@@ -487,47 +599,56 @@ Status MemFilesystem::read(
   return node->read(offset, buffer, nbytes);
 }
 
-Status MemFilesystem::remove(const std::string& path, const bool is_dir) const {
-  std::vector<std::string> tokens = tokenize(path);
-
-  FSNode* cur = root_.get();
-  std::unique_lock<std::mutex> cur_lock(cur->mutex_);
-  FSNode* parent = nullptr;
-  std::unique_lock<std::mutex> parent_lock;
-  for (const auto& token : tokens) {
-    assert(cur_lock.owns_lock());
-    assert(cur_lock.mutex() == &cur->mutex_);
-
-    assert(!parent || parent_lock.owns_lock());
-    assert(!parent || parent_lock.mutex() == &parent->mutex_);
-
-    if (!cur->has_child(token)) {
-      return LOG_STATUS(Status_MemFSError(
-          std::string("File not found, remove failed for : " + path)));
-    }
+Status MemFilesystem::view(
+    const std::string& path,
+    const uint64_t offset,
+    const uint64_t nbytes,
+    char** const data,
+    std::shared_ptr<void>* const owner) const {
+  assert(data);
+  assert(owner);
 
-    parent = cur;
-    std::swap(parent_lock, cur_lock);
+  FSNode* node;
+  std::shared_lock<std::shared_mutex> node_lock;
+  RETURN_NOT_OK(lookup_node(path, &node, &node_lock));
 
-    cur = cur->children_[token].get();
-    cur_lock = std::unique_lock<std::mutex>(cur->mutex_);
+  if (node == nullptr) {
+    return LOG_STATUS(Status_MemFSError(
+        std::string("File not found, view failed for : " + path)));
   }
 
-  if (cur == root_.get()) {
+  return node->view(offset, nbytes, data, owner);
+}
+
+Status MemFilesystem::remove(const std::string& path, const bool is_dir) const {
+  std::vector<std::string> tokens = tokenize(path);
+  if (tokens.empty()) {
     return LOG_STATUS(
         Status_MemFSError(std::string("Cannot remove the root directory")));
   }
 
+  // Lock the parent exclusively, to detach the node from it.
+  const std::string last_token = tokens.back();
+  tokens.pop_back();
+  FSNode* parent;
+  std::unique_lock<std::shared_mutex> parent_lock;
+  RETURN_NOT_OK(lookup_node(tokens, &parent, &parent_lock));
+  if (parent == nullptr || !parent->has_child(last_token)) {
+    return LOG_STATUS(Status_MemFSError(
+        std::string("File not found, remove failed for : " + path)));
+  }
+
+  // Locking the node waits for the readers and writers still using it,
+  // no new ones can reach it while the parent is locked.
+  FSNode* cur = parent->children_[last_token].get();
+  std::unique_lock<std::shared_mutex> cur_lock(cur->mutex_);
   if (cur->is_dir() != is_dir) {
     return LOG_STATUS(
         Status_MemFSError(std::string("Remove failed, wrong file type")));
   }
-
   cur_lock.unlock();
 
-  if (parent) {
-    parent->children_.erase(tokens.back());
-  }
+  parent->children_.erase(last_token);
 
   return Status::Ok();
 }
@@ -541,7 +662,7 @@ Status MemFilesystem::create_dir_internal(
   std::vector<std::string> tokens = tokenize(path);
 
   FSNode* cur = root_.get();
-  std::unique_lock<std::mutex> cur_lock(cur->mutex_);
+  std::unique_lock<std::shared_mutex> cur_lock(cur->mutex_);
 
   for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
     const std::string& token = *iter;
@@ -562,7 +683,7 @@ Status MemFilesystem::create_dir_internal(
     // Only take the lock for `cur` if it is not the newly-created
     // directory.
     if (std::next(iter) != tokens.end()) {
-      cur_lock = std::unique_lock<std::mutex>(cur->mutex_);
+      cur_lock = std::unique_lock<std::shared_mutex>(cur->mutex_);
     }
   }
 
@@ -580,30 +701,23 @@ Status MemFilesystem::create_dir_internal(
 Status MemFilesystem::touch_internal(
     const std::string& path, FSNode** const node) const {
   std::vector<std::string> tokens = tokenize(path);
-
-  FSNode* cur = root_.get();
-  std::unique_lock<std::mutex> cur_lock(cur->mutex_);
-  for (unsigned long i = 0; i < tokens.size() - 1; ++i) {
-    const std::string& token = tokens[i];
-
-    assert(cur_lock.owns_lock());
-    assert(cur_lock.mutex() == &cur->mutex_);
-
-    if (!cur->has_child(token)) {
-      return LOG_STATUS(Status_MemFSError(std::string(
-          "Failed to create file, the parent directory doesn't exist.")));
-    }
-
-    cur = cur->children_[token].get();
-    cur_lock = std::unique_lock<std::mutex>(cur->mutex_);
+  if (tokens.empty()) {
+    return LOG_STATUS(Status_MemFSError(
+        std::string("Failed to create file, the path is the root.")));
   }
 
-  if (!cur->is_dir()) {
+  // Lock the parent exclusively, to attach the file to it.
+  const std::string filename = tokens.back();
+  tokens.pop_back();
+  FSNode* cur;
+  std::unique_lock<std::shared_mutex> cur_lock;
+  RETURN_NOT_OK(lookup_node(tokens, &cur, &cur_lock));
+
+  if (cur == nullptr || !cur->is_dir()) {
     return LOG_STATUS(Status_MemFSError(std::string(
         "Failed to create file, the parent directory doesn't exist.")));
   }
 
-  const std::string& filename = tokens[tokens.size() - 1];
   cur->children_[filename] = tdb_unique_ptr<FSNode>(tdb_new(File));
 
   // Save the output argument, `node`, if requested.
@@ -619,13 +733,13 @@ Status MemFilesystem::write(
   assert(data);
 
   FSNode* node;
-  std::unique_lock<std::mutex> node_lock;
+  std::unique_lock<std::shared_mutex> node_lock;
   RETURN_NOT_OK(lookup_node(path, &node, &node_lock));
 
   // If the file doesn't exist, create it.
   if (node == nullptr) {
     RETURN_NOT_OK(touch_internal(path, &node));
-    node_lock = std::unique_lock<std::mutex>(node->mutex_);
+    node_lock = std::unique_lock<std::shared_mutex>(node->mutex_);
   }
 
   return node->append(data, nbytes);
@@ -645,10 +759,10 @@ std::vector<std::string> MemFilesystem::tokenize(
   return tokens;
 }
 
+template <class Lock>
 Status MemFilesystem::lookup_node(
-    const std::string& path,
-    MemFilesystem::FSNode** node,
-    std::unique_lock<std::mutex>* node_lock) const {
+    const std::string& path, MemFilesystem::FSNode** node, Lock* node_lock)
+    const {
   assert(node);
   assert(node_lock);
   assert(!node_lock->owns_lock());
@@ -657,35 +771,34 @@ Status MemFilesystem::lookup_node(
   return lookup_node(tokens, node, node_lock);
 }
 
+template <class Lock>
 Status MemFilesystem::lookup_node(
     const std::vector<std::string>& tokens,
     MemFilesystem::FSNode** node,
-    std::unique_lock<std::mutex>* node_lock) const {
+    Lock* node_lock) const {
   assert(node);
   assert(node_lock);
   assert(!node_lock->owns_lock());
 
+  // Walk down the tree holding shared locks hand over hand, so that
+  // concurrent lookups do not contend on the top-level directories. Only
+  // the node itself is locked as requested.
   FSNode* cur = root_.get();
-  std::unique_lock<std::mutex> cur_lock(cur->mutex_);
+  std::shared_lock<std::shared_mutex> parent_lock;
   for (const auto& token : tokens) {
-    assert(cur_lock.owns_lock());
-    assert(cur_lock.mutex() == &cur->mutex_);
-
-    if (cur->has_child(token)) {
-      cur = cur->children_[token].get();
-    } else {
+    std::shared_lock<std::shared_mutex> cur_lock(cur->mutex_);
+    auto it = cur->children_.find(token);
+    if (it == cur->children_.end()) {
       *node = nullptr;
       return Status::Ok();
     }
 
-    cur_lock = std::unique_lock<std::mutex>(cur->mutex_);
+    cur = it->second.get();
+    parent_lock = std::move(cur_lock);
   }
 
-  assert(cur_lock.owns_lock());
-  assert(cur_lock.mutex() == &cur->mutex_);
-
+  *node_lock = Lock(cur->mutex_);
   *node = cur;
-  std::swap(*node_lock, cur_lock);
 
   return Status::Ok();
 }
@@ -33,6 +33,7 @@
 #ifndef TILEDB_MEMORY_FILESYSTEM_H
 #define TILEDB_MEMORY_FILESYSTEM_H
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -145,6 +146,25 @@ class MemFilesystem {
       void* buffer,
       const uint64_t nbytes) const;
 
+  /**
+   * Views a range of a file without copying it, if the range was written by
+   * a single `write`, and through a copy otherwise. The view stays valid
+   * while `owner` is alive, even if the file is appended to or removed.
+   *
+   * @param path The full name of the file
+   * @param offset The offset in the file at which the view starts
+   * @param nbytes The number of bytes to view
+   * @param data Set to the viewed bytes
+   * @param owner Set to an owner of the viewed bytes
+   * @return Status.
+   */
+  Status view(
+      const std::string& path,
+      const uint64_t offset,
+      const uint64_t nbytes,
+      char** data,
+      std::shared_ptr<void>* owner) const;
+
   /**
    * Removes a given path and its contents.
    *
@@ -204,29 +224,33 @@ class MemFilesystem {
   /**
    * Finds the node in the filesystem tree that corresponds to a path
    *
+   * @tparam Lock `std::shared_lock` or `std::unique_lock` on a
+   *     `std::shared_mutex`, to lock the node in shared or exclusive mode.
    * @param path The full name of the file/directory to be looked up
    * @param node The output node, nullptr if not found.
    * @param node_lock Mutates to a lock on `node->mutex_`, if found.
    * @return Status
    */
+  template <class Lock>
   Status lookup_node(
-      const std::string& path,
-      FSNode** node,
-      std::unique_lock<std::mutex>* node_lock) const;
+      const std::string& path, FSNode** node, Lock* node_lock) const;
 
   /**
    * Finds the node in the filesystem tree that corresponds to a vector
    * of tokens.
    *
+   * @tparam Lock `std::shared_lock` or `std::unique_lock` on a
+   *     `std::shared_mutex`, to lock the node in shared or exclusive mode.
    * @param tokens The path tokens.
    * @param node The output node, nullptr if not found.
    * @param node_lock Mutates to a lock on `node->mutex_`, if found.
    * @return Status
    */
+  template <class Lock>
   Status lookup_node(
       const std::vector<std::string>& tokens,
       FSNode** node,
-      std::unique_lock<std::mutex>* node_lock) const;
+      Lock* node_lock) const;
 
   /**
    * Splits a path into file/directory names
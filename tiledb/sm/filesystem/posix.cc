@@ -36,13 +36,16 @@
 #include "tiledb/common/logger.h"
 #include "tiledb/common/stdx_string.h"
 #include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/filesystem/uring.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/math.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 
 #include <dirent.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -84,6 +87,61 @@ uint64_t Posix::read_all(
   return nread;
 }
 
+Status Posix::read_all_direct(
+    int fd, void* buffer, uint64_t nbytes, uint64_t offset) {
+  const uint64_t align = constants::direct_io_alignment;
+  auto bytes = reinterpret_cast<char*>(buffer);
+
+  // Read the aligned prefix straight into the buffer.
+  uint64_t direct_nbytes = 0;
+  if (offset % align == 0 && reinterpret_cast<uintptr_t>(buffer) % align == 0)
+    direct_nbytes = nbytes / align * align;
+  if (direct_nbytes > 0 &&
+      read_all(fd, buffer, direct_nbytes, offset) != direct_nbytes)
+    return Status_IOError("Direct read error");
+  if (direct_nbytes == nbytes)
+    return Status::Ok();
+
+  // Read the rest block by block through an aligned scratch buffer. The
+  // last block may extend past the end of the file, in which case the
+  // kernel returns fewer bytes.
+  uint64_t begin = (offset + direct_nbytes) / align * align;
+  uint64_t end = utils::math::ceil(offset + nbytes, align) * align;
+  uint64_t scratch_size =
+      std::min(end - begin, constants::direct_io_max_scratch_size);
+  void* scratch = nullptr;
+  if (posix_memalign(&scratch, align, scratch_size) != 0)
+    return Status_IOError("Cannot allocate aligned buffer for direct read");
+  std::unique_ptr<void, decltype(&free)> scratch_ptr(scratch, &free);
+  auto scratch_bytes = reinterpret_cast<char*>(scratch);
+
+  uint64_t pos = offset + direct_nbytes;
+  while (begin < end) {
+    uint64_t count = std::min(end - begin, scratch_size);
+    uint64_t nread = 0;
+    while (nread < count) {
+      ssize_t actual_read =
+          ::pread(fd, scratch_bytes + nread, count - nread, begin + nread);
+      if (actual_read == -1)
+        return Status_IOError(
+            std::string("POSIX pread error: ") + strerror(errno));
+      if (actual_read == 0)
+        break;
+      nread += actual_read;
+    }
+
+    uint64_t copy_end = std::min(begin + count, offset + nbytes);
+    if (begin + nread < copy_end)
+      return Status_IOError("Unexpected end of file");
+    std::memcpy(bytes + (pos - offset), scratch_bytes + (pos - begin),
+                copy_end - pos);
+    pos = copy_end;
+    begin += count;
+  }
+
+  return Status::Ok();
+}
+
 uint64_t Posix::pwrite_all(
     int fd, uint64_t file_offset, const void* buffer, uint64_t nbytes) {
   auto bytes = reinterpret_cast<const char*>(buffer);
@@ -225,6 +283,16 @@ int Posix::unlink_cb(
 }
 
 Status Posix::remove_dir(const std::string& path) const {
+  {
+    // The syncs deferred under a removed directory are moot
+    std::lock_guard<std::mutex> lock(group_commit_mtx_);
+    const std::string dir = path.back() == '/' ? path : path + "/";
+    group_commit_dirs_.erase(dir);
+    pending_syncs_.erase(
+        pending_syncs_.lower_bound(dir),
+        pending_syncs_.lower_bound(dir.substr(0, dir.size() - 1) + "0"));
+  }
+
   int rc = nftw(path.c_str(), unlink_cb, 64, FTW_DEPTH | FTW_PHYS);
   if (rc)
     return LOG_STATUS(Status_IOError(
@@ -256,6 +324,53 @@ Status Posix::file_size(const std::string& path, uint64_t* size) const {
   return Status::Ok();
 }
 
+Status Posix::begin_group_commit(const std::string& path) {
+  bool group_commit = false;
+  RETURN_NOT_OK(get_group_commit(&group_commit));
+  if (!group_commit)
+    return Status::Ok();
+
+  std::lock_guard<std::mutex> lock(group_commit_mtx_);
+  group_commit_dirs_.insert(path.back() == '/' ? path : path + "/");
+  return Status::Ok();
+}
+
+Status Posix::commit_group(const std::string& path) {
+  std::unique_lock<std::mutex> lock(group_commit_mtx_);
+  group_commit_dirs_.erase(path.back() == '/' ? path : path + "/");
+
+  // Wait until all the syncs deferred so far are carried out. The first
+  // caller to find no flush in progress syncs everything pending, which
+  // covers the files of the callers arriving while it does so.
+  const uint64_t target = deferred_sync_num_;
+  while (flushed_sync_num_ < target) {
+    if (group_commit_flushing_) {
+      group_commit_cv_.wait(lock);
+      continue;
+    }
+
+    group_commit_flushing_ = true;
+    const uint64_t batch_end = deferred_sync_num_;
+    std::vector<std::string> batch(
+        pending_syncs_.begin(), pending_syncs_.end());
+    pending_syncs_.clear();
+    lock.unlock();
+
+    auto st = sync_files(batch);
+
+    lock.lock();
+    group_commit_flushing_ = false;
+    if (st.ok())
+      flushed_sync_num_ = batch_end;
+    else
+      pending_syncs_.insert(batch.begin(), batch.end());
+    group_commit_cv_.notify_all();
+    RETURN_NOT_OK(st);
+  }
+
+  return Status::Ok();
+}
+
 Status Posix::init(const Config& config, ThreadPool* vfs_thread_pool) {
   if (vfs_thread_pool == nullptr) {
     return LOG_STATUS(
@@ -431,6 +546,28 @@ Status Posix::read(
         std::string("Cannot read from file ' ") + path.c_str() +
         "'; nbytes > SSIZE_MAX"));
   }
+
+#ifdef O_DIRECT
+  // Bypass the page cache if requested and supported by the file system.
+  bool direct_io = false;
+  RETURN_NOT_OK(get_direct_io(&direct_io));
+  if (direct_io) {
+    int direct_fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+    if (direct_fd != -1) {
+      close(fd);
+      Status st = read_all_direct(direct_fd, buffer, nbytes, offset);
+      if (close(direct_fd) && st.ok())
+        st = Status_IOError(strerror(errno));
+      if (!st.ok()) {
+        return LOG_STATUS(Status_IOError(
+            std::string("Cannot read from file '") + path.c_str() + "'; " +
+            st.message()));
+      }
+      return Status::Ok();
+    }
+  }
+#endif
+
   uint64_t bytes_read = read_all(fd, buffer, nbytes, offset);
   if (bytes_read != nbytes) {
     return LOG_STATUS(Status_IOError(
@@ -445,7 +582,104 @@ Status Posix::read(
   return Status::Ok();
 }
 
+Status Posix::map_file(
+    const std::string& path,
+    std::shared_ptr<char>* data,
+    uint64_t* size) const {
+  RETURN_NOT_OK(file_size(path, size));
+  data->reset();
+  if (*size == 0)
+    return Status::Ok();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return LOG_STATUS(Status_IOError(
+        std::string("Cannot map file; ") + strerror(errno)));
+  }
+  const uint64_t length = *size;
+  void* addr =
+      mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  int mmap_errno = errno;
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return LOG_STATUS(Status_IOError(
+        std::string("Cannot map file '") + path + "'; " +
+        strerror(mmap_errno)));
+  }
+
+  data->reset(static_cast<char*>(addr), [length](char* p) {
+    munmap(p, length);
+  });
+  return Status::Ok();
+}
+
+Status Posix::read_regions(
+    const std::string& path,
+    const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const {
+  bool io_uring = false;
+  RETURN_NOT_OK(get_io_uring(&io_uring));
+  if (!io_uring) {
+    for (const auto& region : regions)
+      RETURN_NOT_OK(read(
+          path, std::get<0>(region), std::get<1>(region), std::get<2>(region)));
+    return Status::Ok();
+  }
+
+  // Checks
+  uint64_t file_size;
+  RETURN_NOT_OK(this->file_size(path, &file_size));
+  for (const auto& region : regions) {
+    if (std::get<0>(region) + std::get<2>(region) > file_size)
+      return LOG_STATUS(
+          Status_IOError("Cannot read from file; Read exceeds file size"));
+  }
+
+  // Open file
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return LOG_STATUS(Status_IOError(
+        std::string("Cannot read from file; ") + strerror(errno)));
+  }
+
+  // Submit all the regions at once
+  std::vector<Uring::Op> ops;
+  ops.reserve(regions.size());
+  for (const auto& region : regions)
+    ops.push_back({fd,
+                   false,
+                   std::get<0>(region),
+                   std::get<1>(region),
+                   std::get<2>(region)});
+  Uring ring;
+  Status st = ring.init(static_cast<uint32_t>(std::min<uint64_t>(
+      std::max<uint64_t>(ops.size(), 1), constants::io_uring_queue_depth)));
+  if (st.ok())
+    st = ring.submit_and_wait(ops);
+  if (!st.ok()) {
+    close(fd);
+    return LOG_STATUS(Status_IOError(
+        std::string("Cannot read from file '") + path + "'; " +
+        st.message()));
+  }
+
+  // Close file
+  if (close(fd)) {
+    return LOG_STATUS(Status_IOError(
+        std::string("Cannot read from file; ") + strerror(errno)));
+  }
+  return Status::Ok();
+}
+
 Status Posix::sync(const std::string& path) {
+  {
+    std::lock_guard<std::mutex> lock(group_commit_mtx_);
+    if (group_commit_deferred(path)) {
+      pending_syncs_.insert(path);
+      ++deferred_sync_num_;
+      return Status::Ok();
+    }
+  }
+
   uint32_t permissions = 0;
 
   // Open file
@@ -483,6 +717,50 @@ Status Posix::sync(const std::string& path) {
   return Status::Ok();
 }
 
+bool Posix::group_commit_deferred(const std::string& path) const {
+  // Find the last directory that sorts before the path, i.e. the only one
+  // that may be a prefix of it, since the registered directories are not
+  // nested
+  auto it = group_commit_dirs_.upper_bound(path);
+  if (it == group_commit_dirs_.begin())
+    return false;
+  --it;
+  return path.size() > it->size() && path.compare(0, it->size(), *it) == 0;
+}
+
+Status Posix::sync_files(const std::vector<std::string>& paths) const {
+  return parallel_for(vfs_thread_pool_, 0, paths.size(), [&](uint64_t i) {
+    const auto& path = paths[i];
+    int fd = open(path.c_str(), O_WRONLY);
+    if (fd == -1) {
+      if (errno == ENOENT)
+        return Status::Ok();
+      return LOG_STATUS(Status_IOError(
+          std::string("Cannot open file '") + path + "' for syncing; " +
+          strerror(errno)));
+    }
+
+#ifdef __linux__
+    const int rc = fdatasync(fd);
+#else
+    const int rc = fsync(fd);
+#endif
+    if (rc != 0) {
+      const int err = errno;
+      close(fd);
+      return LOG_STATUS(Status_IOError(
+          std::string("Cannot sync file '") + path + "'; " + strerror(err)));
+    }
+
+    if (close(fd) != 0) {
+      return LOG_STATUS(Status_IOError(
+          std::string("Cannot close synced file '") + path + "'; " +
+          strerror(errno)));
+    }
+    return Status::Ok();
+  });
+}
+
 Status Posix::write(
     const std::string& path, const void* buffer, uint64_t buffer_size) {
   // Get config params
@@ -498,6 +776,8 @@ Status Posix::write(
 
   uint32_t permissions = 0;
   RETURN_NOT_OK(get_posix_file_permissions(&permissions));
+  bool use_io_uring = false;
+  RETURN_NOT_OK(get_io_uring(&use_io_uring));
 
   // Get file offset (equal to file size)
   Status st;
@@ -530,6 +810,30 @@ Status Posix::write(
       errmsg << "Cannot write to file '" << path << "'; " << st.message();
       return LOG_STATUS(Status_IOError(errmsg.str()));
     }
+  } else if (use_io_uring) {
+    // Submit all the parts to the kernel at once.
+    std::vector<Uring::Op> ops;
+    uint64_t op_nbytes = utils::math::ceil(buffer_size, num_ops);
+    for (uint64_t begin = 0; begin < buffer_size; begin += op_nbytes) {
+      auto op_buffer = const_cast<char*>(
+          reinterpret_cast<const char*>(buffer) + begin);
+      ops.push_back({fd,
+                     true,
+                     file_offset + begin,
+                     op_buffer,
+                     std::min(op_nbytes, buffer_size - begin)});
+    }
+    Uring ring;
+    st = ring.init(static_cast<uint32_t>(std::min<uint64_t>(
+        ops.size(), constants::io_uring_queue_depth)));
+    if (st.ok())
+      st = ring.submit_and_wait(ops);
+    if (!st.ok()) {
+      close(fd);
+      std::stringstream errmsg;
+      errmsg << "Cannot write to file '" << path << "'; " << st.message();
+      return LOG_STATUS(Status_IOError(errmsg.str()));
+    }
   } else {
     std::vector<ThreadPool::Task> results;
     uint64_t thread_write_nbytes = utils::math::ceil(buffer_size, num_ops);
@@ -618,6 +922,38 @@ Status Posix::get_posix_directory_permissions(uint32_t* permissions) const {
   return Status::Ok();
 }
 
+Status Posix::get_io_uring(bool* io_uring) const {
+  // Get config params
+  bool found = false;
+  RETURN_NOT_OK(
+      config_.get().get<bool>("vfs.file.io_uring", io_uring, &found));
+  assert(found);
+
+  *io_uring = *io_uring && Uring::supported();
+
+  return Status::Ok();
+}
+
+Status Posix::get_group_commit(bool* group_commit) const {
+  // Get config params
+  bool found = false;
+  RETURN_NOT_OK(config_.get().get<bool>(
+      "vfs.file.group_commit", group_commit, &found));
+  assert(found);
+
+  return Status::Ok();
+}
+
+Status Posix::get_direct_io(bool* direct_io) const {
+  // Get config params
+  bool found = false;
+  RETURN_NOT_OK(
+      config_.get().get<bool>("vfs.file.direct_io", direct_io, &found));
+  assert(found);
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
 
@@ -38,8 +38,13 @@
 #include <ftw.h>
 #include <sys/types.h>
 
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "tiledb/common/status.h"
@@ -120,6 +125,27 @@ class Posix {
    */
   Status file_size(const std::string& path, uint64_t* size) const;
 
+  /**
+   * Starts deferring the syncs of the files under the input directory, if
+   * `vfs.file.group_commit` is set. A writer calls this once it has created
+   * a fragment directory, and `commit_group` before committing the fragment.
+   *
+   * @param path The directory whose file syncs are deferred.
+   * @return Status
+   */
+  Status begin_group_commit(const std::string& path);
+
+  /**
+   * Syncs all the files whose syncs were deferred so far, under the input
+   * directory or any other, and stops deferring the syncs under the input
+   * directory. Concurrent calls are batched: one caller syncs the files of
+   * all the pending groups in parallel, while the others wait for it.
+   *
+   * @param path The directory passed to `begin_group_commit`.
+   * @return Status
+   */
+  Status commit_group(const std::string& path);
+
   /**
    * Initialize this instance with the given config.
    *
@@ -198,7 +224,36 @@ class Posix {
       uint64_t nbytes) const;
 
   /**
-   * Syncs a file or directory.
+   * Maps a whole file into memory. The mapping is private, so any write
+   * through it is copy-on-write and never reaches the file.
+   *
+   * @param path The name of the file.
+   * @param data Set to the start of the mapping, which is unmapped once the
+   *     last copy of the pointer is released. Empty for an empty file.
+   * @param size Set to the size of the mapping, i.e., the file size.
+   * @return Status
+   */
+  Status map_file(
+      const std::string& path,
+      std::shared_ptr<char>* data,
+      uint64_t* size) const;
+
+  /**
+   * Reads multiple regions of a file into buffers. If `vfs.file.io_uring` is
+   * set and io_uring is available, all the regions are submitted to the
+   * kernel at once. Otherwise they are read one after the other.
+   *
+   * @param path The name of the file.
+   * @param regions The regions to read, as (file offset, buffer, size) tuples.
+   * @return Status
+   */
+  Status read_regions(
+      const std::string& path,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const;
+
+  /**
+   * Syncs a file or directory. The sync of a file under a directory passed
+   * to `begin_group_commit` is deferred to `commit_group`.
    *
    * @param path The name of the file.
    * @return Status
@@ -229,6 +284,27 @@ class Posix {
   /** Thread pool from parent VFS instance. */
   ThreadPool* vfs_thread_pool_;
 
+  /** Protects the group commit state below. */
+  mutable std::mutex group_commit_mtx_;
+
+  /** Signaled when a group commit flush finishes. */
+  std::condition_variable group_commit_cv_;
+
+  /** The directories whose file syncs are deferred, with a trailing '/'. */
+  mutable std::set<std::string> group_commit_dirs_;
+
+  /** The files whose syncs are deferred. */
+  mutable std::set<std::string> pending_syncs_;
+
+  /** Number of syncs deferred so far. */
+  uint64_t deferred_sync_num_ = 0;
+
+  /** Number of deferred syncs carried out so far, in deferral order. */
+  uint64_t flushed_sync_num_ = 0;
+
+  /** True while a caller of `commit_group` is syncing a batch of files. */
+  bool group_commit_flushing_ = false;
+
   static void adjacent_slashes_dedup(std::string* path);
 
   static bool both_slashes(char a, char b);
@@ -249,6 +325,29 @@ class Posix {
    */
   static void purge_dots_from_path(std::string* path);
 
+  /**
+   * Returns true if the input file is under a directory passed to
+   * `begin_group_commit`. Must be called with `group_commit_mtx_` held.
+   */
+  bool group_commit_deferred(const std::string& path) const;
+
+  /**
+   * Syncs the data of the input files in parallel. Files that no longer
+   * exist, e.g. because their fragment was removed, are skipped.
+   *
+   * @param paths The files to sync.
+   * @return Status
+   */
+  Status sync_files(const std::vector<std::string>& paths) const;
+
+  /**
+   * Parse config to get whether the file syncs of fragments are deferred to
+   * the fragment commit.
+   * @param group_commit set to `true` if syncs are deferred
+   * @return Status
+   */
+  Status get_group_commit(bool* group_commit) const;
+
   /**
    * Reads all nbytes from the given file descriptor, retrying as necessary.
    *
@@ -261,6 +360,21 @@ class Posix {
   static uint64_t read_all(
       int fd, void* buffer, uint64_t nbytes, uint64_t offset);
 
+  /**
+   * Reads all nbytes from a file descriptor opened with `O_DIRECT`. The
+   * largest block-aligned prefix is read directly into the buffer if both
+   * the buffer and the offset are block-aligned; everything else goes
+   * through an aligned scratch buffer.
+   *
+   * @param fd Open file descriptor to read from
+   * @param buffer Buffer to hold read data
+   * @param nbytes Number of bytes to read
+   * @param offset Offset in file to start reading from.
+   * @return Status
+   */
+  static Status read_all_direct(
+      int fd, void* buffer, uint64_t nbytes, uint64_t offset);
+
   static int unlink_cb(
       const char* fpath,
       const struct stat* sb,
@@ -306,6 +420,21 @@ class Posix {
    * @return Status
    */
   Status get_posix_directory_permissions(uint32_t* permissions) const;
+
+  /**
+   * Parse config to get whether to use io_uring, which also requires
+   * io_uring to be available.
+   * @param io_uring set to `true` if io_uring should be used
+   * @return Status
+   */
+  Status get_io_uring(bool* io_uring) const;
+
+  /**
+   * Parse config to get whether to bypass the page cache on reads.
+   * @param direct_io set to `true` if reads should use `O_DIRECT`
+   * @return Status
+   */
+  Status get_direct_io(bool* direct_io) const;
 };
 
 }  // namespace sm
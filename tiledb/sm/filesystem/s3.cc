@@ -41,14 +41,20 @@
 #include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <boost/interprocess/streams/bufferstream.hpp>
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <tuple>
 
 #include "tiledb/common/logger.h"
+#include "tiledb/common/stdx_string.h"
 #include "tiledb/common/unique_rwlock.h"
 #include "tiledb/sm/global_state/global_state.h"
 #include "tiledb/sm/global_state/unit_test_config.h"
 #include "tiledb/sm/misc/math.h"
+#include "tiledb/sm/misc/shared_registry.h"
 #include "tiledb/sm/misc/utils.h"
 
 #ifdef _WIN32
@@ -184,6 +190,9 @@ S3::S3()
     , state_(State::UNINITIALIZED)
     , credentials_provider_(nullptr)
     , file_buffer_size_(0)
+    , skip_init_(false)
+    , logging_initialized_(false)
+    , share_client_(false)
     , max_parallel_ops_(1)
     , multipart_part_size_(0)
     , vfs_thread_pool_(nullptr)
@@ -238,19 +247,12 @@ Status S3::init(
   // unexpectedly.
   options_.httpOptions.installSigPipeHandler = true;
 
-  bool skip_init;
-  RETURN_NOT_OK(config.get<bool>("vfs.s3.skip_init", &skip_init, &found));
+  // The library is initialized with the client, on the first use of S3.
+  RETURN_NOT_OK(config.get<bool>("vfs.s3.skip_init", &skip_init_, &found));
+  assert(found);
+  RETURN_NOT_OK(
+      config.get<bool>("sm.shared_resources", &share_client_, &found));
   assert(found);
-
-  // Initialize the library once per process.
-  if (!skip_init)
-    std::call_once(aws_lib_initialized, [this]() { Aws::InitAPI(options_); });
-
-  if (options_.loggingOptions.logLevel != Aws::Utils::Logging::LogLevel::Off) {
-    Aws::Utils::Logging::InitializeAWSLogging(
-        Aws::MakeShared<Aws::Utils::Logging::DefaultLogSystem>(
-            "TileDB", Aws::Utils::Logging::LogLevel::Trace, "tiledb_s3_"));
-  }
 
   vfs_thread_pool_ = thread_pool;
   RETURN_NOT_OK(config.get<uint64_t>(
@@ -277,6 +279,16 @@ Status S3::init(
   if (request_payer)
     request_payer_ = Aws::S3::Model::RequestPayer::requester;
 
+  float hedge_percentile = 0.0f;
+  RETURN_NOT_OK(config.get<float>(
+      "vfs.s3.hedge_percentile", &hedge_percentile, &found));
+  assert(found);
+  float hedge_max_ratio = 0.0f;
+  RETURN_NOT_OK(
+      config.get<float>("vfs.s3.hedge_max_ratio", &hedge_max_ratio, &found));
+  assert(found);
+  hedge_policy_.init(hedge_percentile, hedge_max_ratio);
+
   auto object_acl_str = config.get("vfs.s3.object_canned_acl", &found);
   assert(found);
   if (found) {
@@ -442,8 +454,9 @@ Status S3::disconnect() {
 
   unique_rl.unlock();
 
-  if (options_.loggingOptions.logLevel != Aws::Utils::Logging::LogLevel::Off) {
+  if (logging_initialized_) {
     Aws::Utils::Logging::ShutdownAWSLogging();
+    logging_initialized_ = false;
   }
 
   if (s3_tp_executor_) {
@@ -676,6 +689,25 @@ Status S3::ls(
     std::vector<std::string>* paths,
     const std::string& delimiter,
     int max_paths) const {
+  return ls_impl(prefix, paths, "", "", delimiter, max_paths);
+}
+
+Status S3::ls_range(
+    const URI& prefix,
+    std::vector<std::string>* paths,
+    const std::string& start_after,
+    const std::string& end_at,
+    const std::string& delimiter) const {
+  return ls_impl(prefix, paths, start_after, end_at, delimiter, -1);
+}
+
+Status S3::ls_impl(
+    const URI& prefix,
+    std::vector<std::string>* paths,
+    const std::string& start_after,
+    const std::string& end_at,
+    const std::string& delimiter,
+    int max_paths) const {
   RETURN_NOT_OK(init_client());
 
   const auto prefix_dir = prefix.add_trailing_slash();
@@ -695,6 +727,19 @@ Status S3::ls(
   list_objects_request.SetDelimiter(delimiter.c_str());
   if (request_payer_ != Aws::S3::Model::RequestPayer::NOT_SET)
     list_objects_request.SetRequestPayer(request_payer_);
+  if (!start_after.empty())
+    list_objects_request.SetMarker((aws_prefix + start_after).c_str());
+
+  // Keys and common prefixes past `end_at` end the listing.
+  const std::string last_key = end_at.empty() ? "" : aws_prefix + end_at;
+  bool past_end = false;
+  auto in_range = [&](const std::string& key) {
+    if (!last_key.empty() && key > last_key) {
+      past_end = true;
+      return false;
+    }
+    return true;
+  };
 
   bool is_done = false;
   while (!is_done) {
@@ -712,18 +757,20 @@ Status S3::ls(
 
     for (const auto& object : list_objects_outcome.GetResult().GetContents()) {
       std::string file(object.GetKey().c_str());
-      paths->push_back("s3://" + aws_auth + add_front_slash(file));
+      if (in_range(file))
+        paths->push_back("s3://" + aws_auth + add_front_slash(file));
     }
 
     for (const auto& object :
          list_objects_outcome.GetResult().GetCommonPrefixes()) {
       std::string file(object.GetPrefix().c_str());
-      paths->push_back(
-          "s3://" + aws_auth + add_front_slash(remove_trailing_slash(file)));
+      if (in_range(file))
+        paths->push_back(
+            "s3://" + aws_auth + add_front_slash(remove_trailing_slash(file)));
     }
 
     is_done =
-        !list_objects_outcome.GetResult().GetIsTruncated() ||
+        past_end || !list_objects_outcome.GetResult().GetIsTruncated() ||
         (max_paths != -1 && paths->size() >= static_cast<size_t>(max_paths));
     if (!is_done) {
       // The documentation states that "GetNextMarker" will be non-empty only
@@ -844,6 +891,133 @@ Status S3::read(
         std::string("URI is not an S3 URI: " + uri.to_string())));
   }
 
+  if (!hedge_policy_.enabled())
+    return read_impl(
+        uri,
+        offset,
+        buffer,
+        length,
+        read_ahead_length,
+        length_returned,
+        nullptr);
+
+  const uint64_t delay_us = hedge_policy_.delay_us();
+  const auto start = std::chrono::steady_clock::now();
+  Status st;
+  if (delay_us == 0) {
+    st = read_impl(
+        uri,
+        offset,
+        buffer,
+        length,
+        read_ahead_length,
+        length_returned,
+        nullptr);
+  } else {
+    st = read_hedged(
+        uri,
+        offset,
+        buffer,
+        length,
+        read_ahead_length,
+        length_returned,
+        delay_us);
+  }
+  if (st.ok())
+    hedge_policy_.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count());
+
+  return st;
+}
+
+Status S3::read_hedged(
+    const URI& uri,
+    const off_t offset,
+    void* const buffer,
+    const uint64_t length,
+    const uint64_t read_ahead_length,
+    uint64_t* const length_returned,
+    const uint64_t delay_us) const {
+  // Shared with the hedge, which writes into its own buffer so that the
+  // losing GET never touches `buffer` after this function returns.
+  struct HedgeState {
+    std::mutex mtx_;
+    bool primary_done_ = false;
+    std::vector<ThreadPool::Task> tasks_;
+    std::atomic<bool> cancel_primary_{false};
+    std::atomic<bool> cancel_hedge_{false};
+    Status hedge_st_;
+    uint64_t hedge_length_ = 0;
+    std::vector<char> hedge_buffer_;
+  };
+  auto state = tdb::make_shared<HedgeState>(HERE());
+
+  const uint64_t timer_id = hedge_timer_.schedule(delay_us, [=]() {
+    std::unique_lock<std::mutex> lck(state->mtx_);
+    if (state->primary_done_ || !hedge_policy_.acquire())
+      return;
+
+    stats_->add_counter("vfs_s3_hedged_reads_num", 1);
+    state->tasks_.emplace_back(vfs_thread_pool_->execute([=]() {
+      state->hedge_buffer_.resize(length + read_ahead_length);
+      uint64_t hedge_length = 0;
+      const Status st = read_impl(
+          uri,
+          offset,
+          state->hedge_buffer_.data(),
+          length,
+          read_ahead_length,
+          &hedge_length,
+          &state->cancel_hedge_);
+      state->hedge_st_ = st;
+      state->hedge_length_ = hedge_length;
+      if (st.ok())
+        state->cancel_primary_ = true;
+      return Status::Ok();
+    }));
+  });
+
+  const Status st = read_impl(
+      uri,
+      offset,
+      buffer,
+      length,
+      read_ahead_length,
+      length_returned,
+      &state->cancel_primary_);
+
+  // After this, the hedge is either issued or never will be
+  hedge_timer_.cancel(timer_id);
+  {
+    std::unique_lock<std::mutex> lck(state->mtx_);
+    state->primary_done_ = true;
+  }
+  if (state->tasks_.empty())
+    return st;
+
+  if (st.ok())
+    state->cancel_hedge_ = true;
+  RETURN_NOT_OK(vfs_thread_pool_->wait_all(state->tasks_));
+  if (st.ok() || !state->hedge_st_.ok())
+    return st;
+
+  // The hedge won and cancelled the primary GET
+  stats_->add_counter("vfs_s3_hedged_reads_won_num", 1);
+  std::memcpy(buffer, state->hedge_buffer_.data(), state->hedge_length_);
+  *length_returned = state->hedge_length_;
+
+  return Status::Ok();
+}
+
+Status S3::read_impl(
+    const URI& uri,
+    const off_t offset,
+    void* const buffer,
+    const uint64_t length,
+    const uint64_t read_ahead_length,
+    uint64_t* const length_returned,
+    const std::atomic<bool>* const cancel) const {
   Aws::Http::URI aws_uri = uri.c_str();
   Aws::S3::Model::GetObjectRequest get_object_request;
   get_object_request.WithBucket(aws_uri.GetAuthority())
@@ -862,6 +1036,9 @@ Status S3::read(
 
   if (request_payer_ != Aws::S3::Model::RequestPayer::NOT_SET)
     get_object_request.SetRequestPayer(request_payer_);
+  if (cancel != nullptr)
+    get_object_request.SetContinueRequestHandler(
+        [cancel](const Aws::Http::HttpRequest*) { return !cancel->load(); });
 
   auto get_object_outcome = client_->GetObject(get_object_request);
   if (!get_object_outcome.IsSuccess()) {
@@ -908,17 +1085,93 @@ Status S3::remove_object(const URI& uri) const {
   return Status::Ok();
 }
 
-Status S3::remove_dir(const URI& uri) const {
+Status S3::remove_objects(const std::vector<URI>& uris) const {
   RETURN_NOT_OK(init_client());
 
-  std::vector<std::string> paths;
-  auto uri_dir = uri.add_trailing_slash();
-  RETURN_NOT_OK(ls(uri_dir, &paths, ""));
-  for (const auto& p : paths)
-    RETURN_NOT_OK(remove_object(URI(p)));
+  // Split the keys of every bucket in batches
+  std::map<Aws::String, std::vector<Aws::String>> bucket_keys;
+  for (const auto& uri : uris) {
+    if (!uri.is_s3()) {
+      return LOG_STATUS(Status_S3Error(
+          std::string("URI is not an S3 URI: " + uri.to_string())));
+    }
+    Aws::Http::URI aws_uri = uri.to_string().c_str();
+    bucket_keys[aws_uri.GetAuthority()].emplace_back(aws_uri.GetPath());
+  }
+  std::vector<std::tuple<Aws::String, const std::vector<Aws::String>*, size_t>>
+      batches;
+  for (const auto& bucket : bucket_keys) {
+    for (size_t i = 0; i < bucket.second.size();
+         i += constants::s3_max_delete_keys)
+      batches.emplace_back(bucket.first, &bucket.second, i);
+  }
+
+  auto status =
+      parallel_for(vfs_thread_pool_, 0, batches.size(), [&](uint64_t b) {
+        const auto& [bucket, keys, start] = batches[b];
+        auto end = std::min<size_t>(
+            keys->size(), start + constants::s3_max_delete_keys);
+        Aws::S3::Model::Delete del;
+        for (size_t i = start; i < end; ++i)
+          del.AddObjects(
+              Aws::S3::Model::ObjectIdentifier().WithKey((*keys)[i]));
+        del.SetQuiet(true);
+
+        Aws::S3::Model::DeleteObjectsRequest delete_objects_request;
+        delete_objects_request.SetBucket(bucket);
+        delete_objects_request.SetDelete(del);
+        if (request_payer_ != Aws::S3::Model::RequestPayer::NOT_SET)
+          delete_objects_request.SetRequestPayer(request_payer_);
+
+        auto delete_objects_outcome =
+            client_->DeleteObjects(delete_objects_request);
+        if (!delete_objects_outcome.IsSuccess()) {
+          return LOG_STATUS(Status_S3Error(
+              std::string("Failed to delete S3 objects of bucket '") +
+              bucket.c_str() + outcome_error_message(delete_objects_outcome)));
+        }
+
+        // In quiet mode only the keys that failed are returned
+        const auto& errors = delete_objects_outcome.GetResult().GetErrors();
+        if (!errors.empty()) {
+          return LOG_STATUS(Status_S3Error(
+              std::string("Failed to delete S3 object '") +
+              errors[0].GetKey().c_str() + "' of bucket '" + bucket.c_str() +
+              "'; " + errors[0].GetMessage().c_str()));
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
   return Status::Ok();
 }
 
+Status S3::remove_dir(const URI& uri) const {
+  return remove_dirs({uri});
+}
+
+Status S3::remove_dirs(const std::vector<URI>& prefixes) const {
+  RETURN_NOT_OK(init_client());
+
+  // List the objects of all the prefixes
+  std::vector<std::vector<std::string>> paths(prefixes.size());
+  auto status =
+      parallel_for(vfs_thread_pool_, 0, prefixes.size(), [&](uint64_t i) {
+        RETURN_NOT_OK(ls(prefixes[i].add_trailing_slash(), &paths[i], ""));
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  std::vector<URI> uris;
+  for (const auto& prefix_paths : paths) {
+    for (const auto& p : prefix_paths)
+      uris.emplace_back(p);
+  }
+
+  return remove_objects(uris);
+}
+
 Status S3::touch(const URI& uri) const {
   RETURN_NOT_OK(init_client());
 
@@ -1047,6 +1300,57 @@ Status S3::init_client() const {
     return Status::Ok();
   }
 
+  auto timer_se = stats_->start_timer("init_client");
+
+  // Initialize the library once per process. This is deferred from init()
+  // so that contexts which never touch S3 do not pay for it.
+  if (!skip_init_)
+    std::call_once(aws_lib_initialized, [this]() { Aws::InitAPI(options_); });
+
+  if (!logging_initialized_ &&
+      options_.loggingOptions.logLevel != Aws::Utils::Logging::LogLevel::Off) {
+    Aws::Utils::Logging::InitializeAWSLogging(
+        Aws::MakeShared<Aws::Utils::Logging::DefaultLogSystem>(
+            "TileDB", Aws::Utils::Logging::LogLevel::Trace, "tiledb_s3_"));
+    logging_initialized_ = true;
+  }
+
+  if (!share_client_)
+    return create_client();
+
+  // Share the client of the S3 instances with the same configuration and
+  // thread pool. Its retries are counted in the stats of the instance that
+  // created it, while the requests are counted by each instance.
+  static SharedRegistry<SharedClient> shared_clients;
+  std::string key = std::to_string((uintptr_t)vfs_thread_pool_);
+  for (const auto& kv : config_.param_values()) {
+    if (utils::parse::starts_with(kv.first, "vfs.s3."))
+      key += "," + kv.first + "=" + kv.second;
+  }
+  RETURN_NOT_OK(shared_clients.get(
+      key,
+      [this](tdb_shared_ptr<SharedClient>* created) {
+        RETURN_NOT_OK(create_client());
+        *created = tdb::make_shared<SharedClient>(HERE());
+        (*created)->client_config_ = std::move(client_config_);
+        (*created)->executor_ = std::move(s3_tp_executor_);
+        (*created)->credentials_provider_ = credentials_provider_;
+        (*created)->client_ = client_;
+        return Status::Ok();
+      },
+      &shared_client_));
+  client_ = shared_client_->client_;
+  credentials_provider_ = shared_client_->credentials_provider_;
+
+  return Status::Ok();
+}
+
+S3::SharedClient::~SharedClient() {
+  if (executor_)
+    executor_->Stop();
+}
+
+Status S3::create_client() const {
   bool found;
   auto s3_endpoint_override = config_.get("vfs.s3.endpoint_override", &found);
   assert(found);
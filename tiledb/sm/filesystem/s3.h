@@ -34,6 +34,7 @@
 #define TILEDB_S3_H
 
 #ifdef HAVE_S3
+#include "tiledb/common/logger_public.h"
 #include "tiledb/common/rwlock.h"
 #include "tiledb/common/status.h"
 #include "tiledb/common/thread_pool.h"
@@ -41,6 +42,7 @@
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/filesystem/s3_thread_pool_executor.h"
 #include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/hedged_requests.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/stats/stats.h"
 #include "uri.h"
@@ -65,6 +67,7 @@
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetBucketLocationRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -73,8 +76,10 @@
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/UploadPartRequest.h>
 #include <sys/types.h>
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace tiledb::common;
@@ -216,6 +221,27 @@ class S3 {
       const std::string& delimiter = "/",
       int max_paths = -1) const;
 
+  /**
+   * Lists the objects that start with `prefix` like `ls`, restricted to the
+   * names (relative to `prefix`) that sort after `start_after` and not after
+   * `end_at`. The listing starts at `start_after` and stops past `end_at`, so
+   * that ranges sharing their bounds partition the listing and a large
+   * prefix can be listed concurrently.
+   *
+   * @param prefix The prefix URI.
+   * @param paths Pointer of a vector of URIs to store the retrieved paths.
+   * @param start_after The name to list after. Empty lists from the start.
+   * @param end_at The last name to list. Empty lists to the end.
+   * @param delimiter The delimiter that will
+   * @return Status
+   */
+  Status ls_range(
+      const URI& prefix,
+      std::vector<std::string>* paths,
+      const std::string& start_after,
+      const std::string& end_at,
+      const std::string& delimiter = "/") const;
+
   /**
    * Renames an object.
    *
@@ -299,6 +325,16 @@ class S3 {
    */
   Status remove_object(const URI& uri) const;
 
+  /**
+   * Deletes the objects with the given URIs with DeleteObjects requests of
+   * up to `constants::s3_max_delete_keys` keys each, issued in parallel on
+   * the VFS thread pool.
+   *
+   * @param uris The URIs of the objects to be deleted.
+   * @return Status
+   */
+  Status remove_objects(const std::vector<URI>& uris) const;
+
   /**
    * Deletes all objects with prefix `prefix/` (if the ending `/` does not
    * exist in `prefix`, it is added by the function.
@@ -325,6 +361,16 @@ class S3 {
    */
   Status remove_dir(const URI& prefix) const;
 
+  /**
+   * Deletes all the objects with the given prefixes, like `remove_dir`,
+   * listing the prefixes in parallel and batching the deletes of all of
+   * them with `remove_objects`.
+   *
+   * @param prefixes The prefixes of the objects to be deleted.
+   * @return Status
+   */
+  Status remove_dirs(const std::vector<URI>& prefixes) const;
+
   /**
    * Creates an empty object.
    *
@@ -366,7 +412,8 @@ class S3 {
         const uint64_t scale_factor)
         : s3_stats_(s3_stats)
         , max_retries_(max_retries)
-        , scale_factor_(scale_factor) {
+        , scale_factor_(scale_factor)
+        , throttle_log_limiter_(1000) {
     }
 
     /*
@@ -376,9 +423,28 @@ class S3 {
     bool ShouldRetry(
         const Aws::Client::AWSError<Aws::Client::CoreErrors>& error,
         long attempted_retries) const override {
+      // Count the responses asking the client to back off, whether or not
+      // the request is retried.
+      const auto type = error.GetErrorType();
+      const auto code = error.GetResponseCode();
+      if (type == Aws::Client::CoreErrors::SLOW_DOWN ||
+          type == Aws::Client::CoreErrors::THROTTLING ||
+          code == Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS ||
+          code == Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE) {
+        s3_stats_->add_counter("vfs_s3_throttled_num", 1);
+
+        // Throttling comes in bursts, warn at most once a second.
+        uint64_t suppressed = 0;
+        if (throttle_log_limiter_.allow(&suppressed))
+          LOG_WARN(
+              "S3 request throttled with http response code " +
+              std::to_string(static_cast<int>(code)) + " (" +
+              std::to_string(suppressed) + " similar warnings suppressed)");
+      }
+
       // Unconditionally retry on 'SLOW_DOWN' errors. The request
       // will eventually succeed.
-      if (error.GetErrorType() == Aws::Client::CoreErrors::SLOW_DOWN) {
+      if (type == Aws::Client::CoreErrors::SLOW_DOWN) {
         // With an average retry interval of 1.5 seconds, 100 retries
         // would be a 2.5 minute hang, which is unreasonably long. Error
         // out in this scenario, as we probably have encountered a
@@ -388,6 +454,7 @@ class S3 {
         }
 
         s3_stats_->add_counter("vfs_s3_slow_down_retries", 1);
+        s3_stats_->add_counter("vfs_s3_retry_num", 1);
 
         return true;
       }
@@ -395,7 +462,11 @@ class S3 {
       if (static_cast<uint64_t>(attempted_retries) >= max_retries_)
         return false;
 
-      return error.ShouldRetry();
+      if (!error.ShouldRetry())
+        return false;
+
+      s3_stats_->add_counter("vfs_s3_retry_num", 1);
+      return true;
     }
 
     /**
@@ -429,6 +500,9 @@ class S3 {
 
     /** The scale of each exponential backoff delay. */
     uint64_t scale_factor_;
+
+    /** Rate-limits the throttling warnings. */
+    mutable LogRateLimiter throttle_log_limiter_;
   };
 
   /**
@@ -538,6 +612,27 @@ class S3 {
     mutable std::mutex mtx;
   };
 
+  /**
+   * A client shared by the S3 instances of the contexts created with
+   * `sm.shared_resources`, together with what it depends on.
+   */
+  struct SharedClient {
+    /** Destructor. Stops the executor of the client. */
+    ~SharedClient();
+
+    /** Configuration object used to initialize the client. */
+    tdb_unique_ptr<Aws::Client::ClientConfiguration> client_config_;
+
+    /** The executor used by `client_`. */
+    std::shared_ptr<S3ThreadPoolExecutor> executor_;
+
+    /** The AWS credential provider. */
+    tdb_shared_ptr<Aws::Auth::AWSCredentialsProvider> credentials_provider_;
+
+    /** The client. */
+    tdb_shared_ptr<Aws::S3::S3Client> client_;
+  };
+
   /**
    * Used to stream results from the GetObject request into
    * a pre-allocated buffer.
@@ -602,6 +697,24 @@ class S3 {
   /** AWS options. */
   Aws::SDKOptions options_;
 
+  /** If `true`, the AWS SDK is initialized by the application. */
+  bool skip_init_;
+
+  /**
+   * Whether the AWS logging was initialized with the client. This is mutable
+   * so that nominally const functions can call init_client().
+   */
+  mutable bool logging_initialized_;
+
+  /**
+   * If `true`, the client is shared with the S3 instances with the same
+   * configuration, as set by `sm.shared_resources`.
+   */
+  bool share_client_;
+
+  /** The shared client, if `share_client_` is set. */
+  mutable tdb_shared_ptr<SharedClient> shared_client_;
+
   /** Maps a file name to its multipart upload state. */
   std::unordered_map<std::string, MultiPartUploadState>
       multipart_upload_states_;
@@ -651,6 +764,12 @@ class S3 {
   /** If !NOT_SET assign to bucket requests supporting SetACL() */
   Aws::S3::Model::BucketCannedACL bucket_canned_acl_;
 
+  /** Decides when GETs are hedged, see `vfs.s3.hedge_percentile`. */
+  mutable HedgePolicy hedge_policy_;
+
+  /** Issues the hedges of slow GETs. */
+  mutable HedgeTimer hedge_timer_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -662,6 +781,63 @@ class S3 {
    */
   Status init_client() const;
 
+  /**
+   * Creates the client and what it depends on from `config_`. Called by
+   * init_client().
+   *
+   * @return Status
+   */
+  Status create_client() const;
+
+  /**
+   * Reads data from an object into a buffer with a single GET. See `read`.
+   *
+   * @param cancel If not null, the GET is aborted once it is set.
+   */
+  Status read_impl(
+      const URI& uri,
+      off_t offset,
+      void* buffer,
+      uint64_t length,
+      uint64_t read_ahead_length,
+      uint64_t* length_returned,
+      const std::atomic<bool>* cancel) const;
+
+  /**
+   * Reads data from an object into a buffer, issuing a duplicate GET if the
+   * first one is slower than the delay of `hedge_policy_`. The first
+   * successful response is used and the other GET is cancelled. See `read`.
+   *
+   * @param delay_us The delay in microseconds after which the GET is hedged.
+   */
+  Status read_hedged(
+      const URI& uri,
+      off_t offset,
+      void* buffer,
+      uint64_t length,
+      uint64_t read_ahead_length,
+      uint64_t* length_returned,
+      uint64_t delay_us) const;
+
+  /**
+   * Lists the objects that start with `prefix`. See `ls` and `ls_range`.
+   *
+   * @param prefix The prefix URI.
+   * @param paths Pointer of a vector of URIs to store the retrieved paths.
+   * @param start_after The name to list after. Empty lists from the start.
+   * @param end_at The last name to list. Empty lists to the end.
+   * @param delimiter The delimiter that will
+   * @param max_paths The maximum number of paths to be retrieved, or `-1`.
+   * @return Status
+   */
+  Status ls_impl(
+      const URI& prefix,
+      std::vector<std::string>* paths,
+      const std::string& start_after,
+      const std::string& end_at,
+      const std::string& delimiter,
+      int max_paths) const;
+
   /**
    * Copies an object.
    *
@@ -0,0 +1,340 @@
+/**
+ * @file   uring.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class Uring.
+ */
+
+#include "tiledb/sm/filesystem/uring.h"
+#include "tiledb/common/logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <string>
+
+#ifdef TILEDB_HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if !defined(__NR_io_uring_setup) || !defined(__NR_io_uring_enter)
+#undef TILEDB_HAVE_IO_URING
+#endif
+#endif
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The maximum number of bytes transferred by a single ring entry. */
+const uint64_t max_entry_bytes = uint64_t(1) << 30;
+
+#ifdef TILEDB_HAVE_IO_URING
+int sys_io_uring_setup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sys_io_uring_enter(
+    int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+  return static_cast<int>(syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+#endif
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Uring::Uring()
+    : ring_fd_(-1)
+    , sq_ring_(nullptr)
+    , sq_ring_size_(0)
+    , cq_ring_(nullptr)
+    , cq_ring_size_(0)
+    , sqes_(nullptr)
+    , sqes_size_(0)
+    , sq_entries_(0)
+    , sq_tail_(nullptr)
+    , sq_mask_(nullptr)
+    , sq_array_(nullptr)
+    , cq_head_(nullptr)
+    , cq_tail_(nullptr)
+    , cq_mask_(nullptr)
+    , cqes_(nullptr) {
+}
+
+Uring::~Uring() {
+  teardown();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+bool Uring::supported() {
+#ifdef TILEDB_HAVE_IO_URING
+  static const bool supported = []() {
+    Uring ring;
+    return ring.init(1).ok();
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+Status Uring::init(uint32_t entries) {
+#ifdef TILEDB_HAVE_IO_URING
+  teardown();
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int fd = sys_io_uring_setup(entries, &params);
+  if (fd < 0)
+    return Status_IOError(
+        std::string("Cannot set up io_uring; ") + strerror(errno));
+  ring_fd_ = fd;
+  sq_entries_ = params.sq_entries;
+
+  // Map the rings. Newer kernels map both rings with a single mapping.
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+  void* ptr = mmap(
+      nullptr,
+      sq_ring_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      fd,
+      IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED) {
+    teardown();
+    return Status_IOError(
+        std::string("Cannot map io_uring submission ring; ") +
+        strerror(errno));
+  }
+  sq_ring_ = ptr;
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    ptr = mmap(
+        nullptr,
+        cq_ring_size_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        fd,
+        IORING_OFF_CQ_RING);
+    if (ptr == MAP_FAILED) {
+      teardown();
+      return Status_IOError(
+          std::string("Cannot map io_uring completion ring; ") +
+          strerror(errno));
+    }
+    cq_ring_ = ptr;
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  ptr = mmap(
+      nullptr,
+      sqes_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      fd,
+      IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) {
+    teardown();
+    return Status_IOError(
+        std::string("Cannot map io_uring submission entries; ") +
+        strerror(errno));
+  }
+  sqes_ = ptr;
+
+  auto sq = static_cast<char*>(sq_ring_);
+  sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  auto cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+
+  return Status::Ok();
+#else
+  (void)entries;
+  return Status_IOError("Cannot set up io_uring; Not supported");
+#endif
+}
+
+Status Uring::submit_and_wait(const std::vector<Op>& ops) {
+#ifdef TILEDB_HAVE_IO_URING
+  if (ring_fd_ == -1)
+    return LOG_STATUS(
+        Status_IOError("Cannot submit to io_uring; Ring is not set up"));
+
+  // Split the operations into pieces a single entry can transfer.
+  std::deque<Op> pending;
+  for (const auto& op : ops) {
+    auto buffer = static_cast<char*>(op.buffer);
+    for (uint64_t done = 0; done < op.nbytes; done += max_entry_bytes) {
+      uint64_t nbytes = std::min(max_entry_bytes, op.nbytes - done);
+      pending.push_back({op.fd, op.write, op.offset + done, buffer + done,
+                         nbytes});
+    }
+  }
+
+  // Every in-flight entry owns a slot, which holds its operation and the
+  // iovec the kernel reads the buffer from.
+  std::vector<Op> slots(sq_entries_);
+  std::vector<iovec> iovecs(sq_entries_);
+  std::vector<uint32_t> free_slots(sq_entries_);
+  for (uint32_t i = 0; i < sq_entries_; ++i)
+    free_slots[i] = sq_entries_ - 1 - i;
+
+  auto sqes = static_cast<io_uring_sqe*>(sqes_);
+  auto cqes = static_cast<io_uring_cqe*>(cqes_);
+  uint32_t in_flight = 0, unsubmitted = 0;
+  Status st = Status::Ok();
+  while (in_flight > 0 || (st.ok() && !pending.empty())) {
+    // Queue as many pending operations as there are free slots, unless an
+    // operation has failed, in which case only the in-flight ones are
+    // drained.
+    uint32_t tail = *sq_tail_;
+    while (st.ok() && !pending.empty() && !free_slots.empty()) {
+      uint32_t slot = free_slots.back();
+      free_slots.pop_back();
+      slots[slot] = pending.front();
+      pending.pop_front();
+      iovecs[slot].iov_base = slots[slot].buffer;
+      iovecs[slot].iov_len = slots[slot].nbytes;
+
+      uint32_t index = tail & *sq_mask_;
+      io_uring_sqe* sqe = &sqes[index];
+      std::memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = slots[slot].write ? IORING_OP_WRITEV : IORING_OP_READV;
+      sqe->fd = slots[slot].fd;
+      sqe->off = slots[slot].offset;
+      sqe->addr = reinterpret_cast<uint64_t>(&iovecs[slot]);
+      sqe->len = 1;
+      sqe->user_data = slot;
+      sq_array_[index] = index;
+      ++tail;
+      ++in_flight;
+      ++unsubmitted;
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    // Submit the new entries and wait for at least one completion.
+    int ret = sys_io_uring_enter(
+        ring_fd_, unsubmitted, 1, IORING_ENTER_GETEVENTS);
+    if (ret < 0) {
+      if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        return LOG_STATUS(Status_IOError(
+            std::string("Cannot submit to io_uring; ") + strerror(errno)));
+    } else {
+      unsubmitted -= std::min(unsubmitted, static_cast<uint32_t>(ret));
+    }
+
+    // Reap the completions. Short transfers are queued again for the rest
+    // of their bytes.
+    uint32_t head = *cq_head_;
+    uint32_t cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != cq_tail; ++head) {
+      const io_uring_cqe& cqe = cqes[head & *cq_mask_];
+      auto slot = static_cast<uint32_t>(cqe.user_data);
+      Op& op = slots[slot];
+      int res = cqe.res;
+      if (res == -EINTR || res == -EAGAIN) {
+        pending.push_front(op);
+      } else if (res < 0) {
+        if (st.ok())
+          st = Status_IOError(
+              std::string(op.write ? "Cannot write" : "Cannot read") +
+              " with io_uring; " + strerror(-res));
+      } else if (res == 0) {
+        if (st.ok())
+          st = Status_IOError(std::string(
+              op.write ? "Cannot write with io_uring; No bytes written" :
+                         "Cannot read with io_uring; Unexpected end of file"));
+      } else if (static_cast<uint64_t>(res) < op.nbytes) {
+        op.offset += res;
+        op.buffer = static_cast<char*>(op.buffer) + res;
+        op.nbytes -= res;
+        pending.push_front(op);
+      }
+      free_slots.push_back(slot);
+      --in_flight;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+  return st.ok() ? st : LOG_STATUS(st);
+#else
+  (void)ops;
+  return LOG_STATUS(Status_IOError("Cannot submit to io_uring; Not supported"));
+#endif
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void Uring::teardown() {
+#ifdef TILEDB_HAVE_IO_URING
+  if (sqes_ != nullptr)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr)
+    munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ != -1)
+    close(ring_fd_);
+#endif
+  ring_fd_ = -1;
+  sq_ring_ = cq_ring_ = sqes_ = cqes_ = nullptr;
+  sq_ring_size_ = cq_ring_size_ = sqes_size_ = 0;
+  sq_entries_ = 0;
+  sq_tail_ = sq_mask_ = sq_array_ = nullptr;
+  cq_head_ = cq_tail_ = cq_mask_ = nullptr;
+}
+
+}  // namespace sm
+}  // namespace tiledb
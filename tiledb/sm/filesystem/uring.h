@@ -0,0 +1,171 @@
+/**
+ * @file   uring.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class Uring, which submits batches of positional reads
+ * and writes to the Linux io_uring interface.
+ */
+
+#ifndef TILEDB_URING_H
+#define TILEDB_URING_H
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define TILEDB_HAVE_IO_URING
+#endif
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Submits batches of positional reads and writes to an io_uring instance.
+ * All the operations of a batch are queued in the submission ring at once,
+ * up to the ring size, and completions are reaped as they arrive, so the
+ * device sees the whole batch without one thread per operation. Short
+ * transfers are resubmitted for their remainder.
+ *
+ * The ring is set up with raw system calls, so no liburing is required.
+ */
+class Uring {
+ public:
+  /** A positional read or write of a contiguous file region. */
+  struct Op {
+    /** The file descriptor to read from or write to. */
+    int fd;
+
+    /** Whether this is a write. */
+    bool write;
+
+    /** The offset in the file. */
+    uint64_t offset;
+
+    /** The buffer to read into or write from. */
+    void* buffer;
+
+    /** The number of bytes to transfer. */
+    uint64_t nbytes;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. The ring is set up by `init`. */
+  Uring();
+
+  /** Destructor. Tears down the ring. */
+  ~Uring();
+
+  Uring(const Uring&) = delete;
+  Uring& operator=(const Uring&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns `true` if io_uring is usable in this process. This is `false` on
+   * non-Linux platforms, on kernels without io_uring, and where the system
+   * call is blocked, e.g. by a seccomp policy.
+   */
+  static bool supported();
+
+  /**
+   * Sets up the ring.
+   *
+   * @param entries The number of submission queue entries.
+   * @return Status
+   */
+  Status init(uint32_t entries);
+
+  /**
+   * Submits all the input operations and waits until they have completed.
+   *
+   * @param ops The operations to submit.
+   * @return Status
+   */
+  Status submit_and_wait(const std::vector<Op>& ops);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The ring file descriptor, or -1 if the ring is not set up. */
+  int ring_fd_;
+
+  /** The mapped submission ring. */
+  void* sq_ring_;
+
+  /** The size of the mapped submission ring. */
+  uint64_t sq_ring_size_;
+
+  /** The mapped completion ring, which may alias the submission ring. */
+  void* cq_ring_;
+
+  /** The size of the mapped completion ring. */
+  uint64_t cq_ring_size_;
+
+  /** The mapped submission queue entries. */
+  void* sqes_;
+
+  /** The size of the mapped submission queue entries. */
+  uint64_t sqes_size_;
+
+  /** The number of submission queue entries. */
+  uint32_t sq_entries_;
+
+  /** Pointers into the submission ring. */
+  uint32_t *sq_tail_, *sq_mask_, *sq_array_;
+
+  /** Pointers into the completion ring. */
+  uint32_t *cq_head_, *cq_tail_, *cq_mask_;
+
+  /** The completion queue entries. */
+  void* cqes_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Unmaps the rings and closes the ring file descriptor. */
+  void teardown();
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_URING_H
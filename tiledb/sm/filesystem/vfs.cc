@@ -43,6 +43,8 @@
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <list>
 #include <sstream>
@@ -59,8 +61,13 @@ namespace sm {
 
 VFS::VFS()
     : stats_(nullptr)
+    , read_byte_num_(nullptr)
+    , read_ops_num_(nullptr)
+    , read_request_timer_(nullptr)
+    , write_request_timer_(nullptr)
     , init_(false)
     , read_ahead_size_(0)
+    , read_ahead_max_window_(0)
     , compute_tp_(nullptr)
     , io_tp_(nullptr) {
 #ifdef HAVE_AZURE
@@ -416,6 +423,9 @@ Status VFS::remove_dir(const URI& uri) const {
         Status_VFSError("Cannot remove directory; VFS not "
                         "initialized"));
 
+  if (auto counters = backend_counters(uri))
+    counters->delete_num_->add(1);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win_.remove_dir(uri.to_path());
@@ -455,11 +465,62 @@ Status VFS::remove_dir(const URI& uri) const {
   }
 }
 
+Status VFS::remove_dirs(const std::vector<URI>& uris) const {
+  if (!init_)
+    return LOG_STATUS(
+        Status_VFSError("Cannot remove directories; VFS not initialized"));
+
+#ifdef HAVE_S3
+  if (!uris.empty() &&
+      std::all_of(uris.begin(), uris.end(), [](const URI& uri) {
+        return uri.is_s3();
+      })) {
+    backend_counters(uris.front())->delete_num_->add(uris.size());
+    return s3_.remove_dirs(uris);
+  }
+#endif
+
+  auto status = parallel_for(io_tp_, 0, uris.size(), [&](size_t i) {
+    RETURN_NOT_OK(remove_dir(uris[i]));
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
+Status VFS::remove_files(const std::vector<URI>& uris) const {
+  if (!init_)
+    return LOG_STATUS(
+        Status_VFSError("Cannot remove files; VFS not initialized"));
+
+#ifdef HAVE_S3
+  if (!uris.empty() &&
+      std::all_of(uris.begin(), uris.end(), [](const URI& uri) {
+        return uri.is_s3();
+      })) {
+    backend_counters(uris.front())->delete_num_->add(uris.size());
+    return s3_.remove_objects(uris);
+  }
+#endif
+
+  auto status = parallel_for(io_tp_, 0, uris.size(), [&](size_t i) {
+    RETURN_NOT_OK(remove_file(uris[i]));
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
 Status VFS::remove_file(const URI& uri) const {
   if (!init_)
     return LOG_STATUS(
         Status_VFSError("Cannot remove file; VFS not initialized"));
 
+  if (auto counters = backend_counters(uri))
+    counters->delete_num_->add(1);
+
   if (uri.is_file()) {
 #ifdef _WIN32
     return win_.remove_file(uri.to_path());
@@ -739,6 +800,22 @@ Status VFS::init(
     const Config* const ctx_config,
     const Config* const vfs_config) {
   stats_ = parent_stats->create_child("VFS");
+  read_byte_num_ = stats_->register_counter("read_byte_num");
+  read_ops_num_ = stats_->register_counter("read_ops_num");
+  read_request_timer_ = stats_->register_timer("read_request");
+  write_request_timer_ = stats_->register_timer("write_request");
+  for (size_t i = 0; i < backend_names_.size(); i++) {
+    const std::string prefix = std::string(backend_names_[i]) + ".";
+    auto& counters = backend_counters_[i];
+    counters.get_num_ = stats_->register_counter(prefix + "get_num");
+    counters.get_byte_num_ = stats_->register_counter(prefix + "get_byte_num");
+    counters.put_num_ = stats_->register_counter(prefix + "put_num");
+    counters.put_byte_num_ = stats_->register_counter(prefix + "put_byte_num");
+    counters.list_num_ = stats_->register_counter(prefix + "list_num");
+    counters.delete_num_ = stats_->register_counter(prefix + "delete_num");
+    counters.batch_gap_byte_num_ =
+        stats_->register_counter(prefix + "batch_gap_byte_num");
+  }
 
   assert(compute_tp);
   assert(io_tp);
@@ -765,6 +842,26 @@ Status VFS::init(
       config_.get<uint64_t>("vfs.read_ahead_size", &read_ahead_size_, &found));
   assert(found);
 
+  // The read-ahead window of sequential streams grows up to a multiple of
+  // the read-ahead size, as long as buffers still fit the cache.
+  read_ahead_max_window_ = std::max(
+      read_ahead_size_,
+      std::min(
+          read_ahead_size_ * constants::read_ahead_max_window_multiplier,
+          read_ahead_cache_size / 2));
+
+  // Set up the local disk cache of object store reads.
+  const std::string disk_cache_path =
+      config_.get("vfs.disk_cache.path", &found);
+  assert(found);
+  if (!disk_cache_path.empty()) {
+    uint64_t disk_cache_max_size = 0;
+    RETURN_NOT_OK(config_.get<uint64_t>(
+        "vfs.disk_cache.max_size", &disk_cache_max_size, &found));
+    assert(found);
+    RETURN_NOT_OK(disk_cache_.init(disk_cache_path, disk_cache_max_size));
+  }
+
 #ifdef HAVE_HDFS
   hdfs_ = tdb_unique_ptr<hdfs::HDFS>(tdb_new(hdfs::HDFS));
   RETURN_NOT_OK(hdfs_->init(config_));
@@ -775,7 +872,7 @@ Status VFS::init(
 #endif
 
 #ifdef HAVE_AZURE
-  RETURN_NOT_OK(azure_.init(config_, io_tp_));
+  RETURN_NOT_OK(azure_.init(stats_, config_, io_tp_));
 #endif
 
 #ifdef HAVE_GCS
@@ -803,6 +900,19 @@ Status VFS::init(
 }
 
 Status VFS::terminate() {
+  // Wait for the asynchronous read-aheads.
+  {
+    std::vector<ThreadPool::Task> tasks;
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    for (auto& stream : read_ahead_streams_) {
+      if (stream.second.prefetch_task_.valid())
+        tasks.push_back(std::move(stream.second.prefetch_task_));
+    }
+    read_ahead_streams_.clear();
+    if (!tasks.empty())
+      io_tp_->wait_all(tasks);
+  }
+
 #ifdef HAVE_S3
   return s3_.disconnect();
 #endif
@@ -814,6 +924,9 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot list; VFS not initialized"));
 
+  if (auto counters = backend_counters(parent))
+    counters->list_num_->add(1);
+
   std::vector<std::string> paths;
   if (parent.is_file()) {
 #ifdef _WIN32
@@ -863,6 +976,42 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
   return Status::Ok();
 }
 
+Status VFS::ls_sharded(
+    const URI& parent,
+    const std::vector<std::string>& split_names,
+    std::vector<URI>* uris) const {
+  if (!init_)
+    return LOG_STATUS(Status_VFSError("Cannot list; VFS not initialized"));
+
+  if (split_names.empty() || !parent.is_s3())
+    return ls(parent, uris);
+
+  if (auto counters = backend_counters(parent))
+    counters->list_num_->add(split_names.size() + 1);
+
+#ifdef HAVE_S3
+  // List the ranges between consecutive split names concurrently.
+  std::vector<std::vector<std::string>> shard_paths(split_names.size() + 1);
+  auto status = parallel_for(io_tp_, 0, shard_paths.size(), [&](uint64_t i) {
+    const std::string start_after = i == 0 ? "" : split_names[i - 1];
+    const std::string end_at = i == split_names.size() ? "" : split_names[i];
+    return s3_.ls_range(parent, &shard_paths[i], start_after, end_at);
+  });
+  RETURN_NOT_OK(status);
+
+  std::vector<std::string> paths;
+  for (auto& shard : shard_paths)
+    paths.insert(paths.end(), shard.begin(), shard.end());
+  parallel_sort(compute_tp_, paths.begin(), paths.end());
+  for (auto& path : paths) {
+    uris->emplace_back(path);
+  }
+  return Status::Ok();
+#else
+  return LOG_STATUS(Status_VFSError("TileDB was built without S3 support"));
+#endif
+}
+
 Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot move file; VFS not initialized"));
@@ -1205,7 +1354,7 @@ Status VFS::read(
     void* const buffer,
     const uint64_t nbytes,
     bool use_read_ahead) {
-  stats_->add_counter("read_byte_num", nbytes);
+  read_byte_num_->add(nbytes);
 
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot read; VFS not initialized"));
@@ -1216,6 +1365,18 @@ Status VFS::read(
   RETURN_NOT_OK(config_.get<uint64_t>(
       "vfs.min_parallel_size", &min_parallel_size, &found));
   assert(found);
+  if (uri.is_s3() || uri.is_azure() || uri.is_gcs()) {
+    // Large object store reads are split into concurrent ranged downloads
+    // of this size.
+    const std::string param = uri.is_s3()    ? "vfs.s3.read_part_size" :
+                              uri.is_azure() ? "vfs.azure.read_part_size" :
+                                               "vfs.gcs.read_part_size";
+    uint64_t read_part_size = 0;
+    RETURN_NOT_OK(config_.get<uint64_t>(param, &read_part_size, &found));
+    assert(found);
+    if (read_part_size > 0)
+      min_parallel_size = read_part_size;
+  }
   uint64_t max_ops = 0;
   RETURN_NOT_OK(max_parallel_ops(uri, &max_ops));
 
@@ -1226,7 +1387,7 @@ Status VFS::read(
       std::min(std::max(nbytes / min_parallel_size, uint64_t(1)), max_ops);
 
   if (num_ops == 1) {
-    return read_impl(uri, offset, buffer, nbytes, use_read_ahead);
+    return read_cached(uri, offset, buffer, nbytes, use_read_ahead);
   } else {
     // we don't want read-ahead when performing random access reads
     use_read_ahead = false;
@@ -1247,7 +1408,7 @@ Status VFS::read(
            thread_buffer,
            thread_nbytes,
            use_read_ahead]() {
-            return read_impl(
+            return read_cached(
                 uri,
                 thread_offset,
                 thread_buffer,
@@ -1267,13 +1428,45 @@ Status VFS::read(
   }
 }
 
+Status VFS::read_cached(
+    const URI& uri,
+    const uint64_t offset,
+    void* const buffer,
+    const uint64_t nbytes,
+    const bool use_read_ahead) {
+  if (!disk_cache_.enabled() ||
+      !(uri.is_s3() || uri.is_azure() || uri.is_gcs()) ||
+      !DiskCache::cacheable(uri))
+    return read_impl(uri, offset, buffer, nbytes, use_read_ahead);
+
+  bool hit = false;
+  RETURN_NOT_OK(disk_cache_.read(uri, offset, buffer, nbytes, &hit));
+  if (hit) {
+    stats_->add_counter("disk_cache_hit_byte_num", nbytes);
+    return Status::Ok();
+  }
+
+  RETURN_NOT_OK(read_impl(uri, offset, buffer, nbytes, use_read_ahead));
+  stats_->add_counter("disk_cache_miss_byte_num", nbytes);
+
+  // The cache is best-effort; failing to populate it does not fail reads.
+  disk_cache_.write(uri, offset, buffer, nbytes);
+
+  return Status::Ok();
+}
+
 Status VFS::read_impl(
     const URI& uri,
     const uint64_t offset,
     void* const buffer,
     const uint64_t nbytes,
     const bool use_read_ahead) {
-  stats_->add_counter("read_ops_num", 1);
+  read_ops_num_->add(1);
+  auto timer_se = stats_->start_timer(read_request_timer_);
+  if (auto counters = backend_counters(uri)) {
+    counters->get_num_->add(1);
+    counters->get_byte_num_->add(nbytes);
+  }
 
   // We only check to use the read-ahead cache for cloud-storage
   // backends. No-op the `use_read_ahead` to prevent the unused
@@ -1381,25 +1574,64 @@ Status VFS::read_ahead_impl(
   if (nbytes >= read_ahead_size_)
     return read_fn(uri, offset, buffer, nbytes, 0, &nbytes_read);
 
+  // Detect sequential access: reads starting at, or shortly after, the end
+  // of the previous read of the file.
+  bool sequential = false;
+  uint64_t window = read_ahead_size_;
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    if (read_ahead_streams_.size() >= constants::read_ahead_max_streams) {
+      // Forget idle streams.
+      for (auto it = read_ahead_streams_.begin();
+           it != read_ahead_streams_.end();) {
+        if (it->second.prefetch_task_.valid())
+          ++it;
+        else
+          it = read_ahead_streams_.erase(it);
+      }
+    }
+    auto& stream = read_ahead_streams_[uri.to_string()];
+    if (stream.window_ > 0 && offset >= stream.last_end_ &&
+        offset - stream.last_end_ < read_ahead_size_) {
+      stream.sequential_reads_++;
+    } else {
+      stream.sequential_reads_ = 0;
+      stream.window_ = read_ahead_size_;
+    }
+    stream.last_end_ = offset + nbytes;
+    sequential = stream.sequential_reads_ > 0;
+    window = stream.window_;
+  }
+
   // Avoid a read if the requested buffer can be read from the
-  // read cache. Note that we intentionally do not use a read
-  // cache for local files because we rely on the operating
-  // system's file system to cache readahead data in memory.
-  // Additionally, we do not perform readahead with HDFS.
+  // read cache, or from a completed asynchronous read-ahead. Note that
+  // we intentionally do not use a read cache for local files because we
+  // rely on the operating system's file system to cache readahead data in
+  // memory. Additionally, we do not perform readahead with HDFS.
   bool success;
   RETURN_NOT_OK(read_ahead_cache_->read(uri, offset, buffer, nbytes, &success));
-  if (success)
+  if (!success) {
+    RETURN_NOT_OK(take_read_ahead(uri, offset, nbytes, &success));
+    if (success)
+      RETURN_NOT_OK(
+          read_ahead_cache_->read(uri, offset, buffer, nbytes, &success));
+  }
+  if (success) {
+    stats_->add_counter("read_ahead_hit_num", 1);
+    if (sequential)
+      start_read_ahead(read_fn, uri);
     return Status::Ok();
+  }
 
   // We will read directly into the read-ahead buffer and then copy
   // the subrange of this buffer back to the user to satisfy the
   // read request.
   Buffer ra_buffer;
-  RETURN_NOT_OK(ra_buffer.realloc(read_ahead_size_));
+  RETURN_NOT_OK(ra_buffer.realloc(window));
 
   // Calculate the exact number of bytes to populate `ra_buffer`
-  // with `read_ahead_size_` bytes.
-  const uint64_t ra_nbytes = read_ahead_size_ - nbytes;
+  // with `window` bytes.
+  const uint64_t ra_nbytes = window - nbytes;
 
   // Read into `ra_buffer`.
   RETURN_NOT_OK(
@@ -1413,46 +1645,214 @@ Status VFS::read_ahead_impl(
   ra_buffer.set_size(nbytes_read);
   RETURN_NOT_OK(read_ahead_cache_->insert(uri, offset, std::move(ra_buffer)));
 
+  // A short read reveals the end of the file.
+  if (nbytes_read < window) {
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    read_ahead_streams_[uri.to_string()].file_end_ = offset + nbytes_read;
+  }
+
+  // Keep a sequential reader ahead of the cached buffer.
+  if (sequential)
+    start_read_ahead(read_fn, uri);
+
   return Status::Ok();
 }
 
+Status VFS::take_read_ahead(
+    const URI& uri, uint64_t offset, uint64_t nbytes, bool* success) {
+  *success = false;
+
+  ThreadPool::Task task;
+  std::shared_ptr<Buffer> prefetch_buffer;
+  uint64_t prefetch_offset = 0;
+  uint64_t prefetch_window = 0;
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    auto it = read_ahead_streams_.find(uri.to_string());
+    if (it == read_ahead_streams_.end() ||
+        !it->second.prefetch_task_.valid() ||
+        offset < it->second.prefetch_offset_)
+      return Status::Ok();
+    task = std::move(it->second.prefetch_task_);
+    prefetch_buffer = std::move(it->second.prefetch_buffer_);
+    prefetch_offset = it->second.prefetch_offset_;
+    prefetch_window = it->second.prefetch_window_;
+  }
+
+  // Wait for the read-ahead. It never fails; a failed read-ahead is empty.
+  std::vector<ThreadPool::Task> tasks;
+  tasks.push_back(std::move(task));
+  RETURN_NOT_OK(io_tp_->wait_all(tasks));
+  if (prefetch_buffer->size() < prefetch_window) {
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    read_ahead_streams_[uri.to_string()].file_end_ =
+        prefetch_offset + prefetch_buffer->size();
+  }
+  if (offset + nbytes > prefetch_offset + prefetch_buffer->size())
+    return Status::Ok();
+
+  RETURN_NOT_OK(read_ahead_cache_->insert(
+      uri, prefetch_offset, std::move(*prefetch_buffer)));
+  *success = true;
+  return Status::Ok();
+}
+
+void VFS::start_read_ahead(
+    const std::function<Status(
+        const URI&, off_t, void*, uint64_t, uint64_t, uint64_t*)>& read_fn,
+    const URI& uri) {
+  uint64_t offset = 0;
+  if (!read_ahead_cache_->cached_end(uri, &offset))
+    return;
+
+  ThreadPool::Task stale_task;
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_streams_mtx_);
+    auto& stream = read_ahead_streams_[uri.to_string()];
+    if (offset >= stream.file_end_)
+      return;
+    if (stream.prefetch_task_.valid()) {
+      // Already reading ahead from there.
+      if (stream.prefetch_offset_ == offset)
+        return;
+      // Replace a read-ahead the stream moved away from.
+      stale_task = std::move(stream.prefetch_task_);
+    }
+
+    const uint64_t window = stream.window_;
+    stream.window_ = std::min(2 * stream.window_, read_ahead_max_window_);
+
+    auto prefetch_buffer = std::make_shared<Buffer>();
+    stream.prefetch_offset_ = offset;
+    stream.prefetch_window_ = window;
+    stream.prefetch_buffer_ = prefetch_buffer;
+    stream.prefetch_task_ = io_tp_->execute(
+        [this, read_fn, uri, offset, window, prefetch_buffer]() {
+          // The end of the file is unknown, so this is a read-ahead of
+          // `window` bytes past a zero-byte read.
+          uint64_t nbytes_read = 0;
+          if (!prefetch_buffer->realloc(window).ok() ||
+              !read_fn(uri, offset, prefetch_buffer->data(), 0, window,
+                       &nbytes_read)
+                   .ok())
+            nbytes_read = 0;
+          prefetch_buffer->set_size(std::min(nbytes_read, window));
+          stats_->add_counter("read_ahead_async_byte_num", nbytes_read);
+          return Status::Ok();
+        });
+  }
+
+  if (stale_task.valid()) {
+    std::vector<ThreadPool::Task> tasks;
+    tasks.push_back(std::move(stale_task));
+    io_tp_->wait_all(tasks);
+  }
+}
+
 Status VFS::read_all(
     const URI& uri,
     const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions,
     ThreadPool* thread_pool,
     std::vector<ThreadPool::Task>* tasks,
-    const bool use_read_ahead) {
+    const bool use_read_ahead,
+    const std::function<Status(Tile*)>& on_region_read) {
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot read all; VFS not initialized"));
 
   if (regions.empty())
     return Status::Ok();
 
+  // View the regions in a memory mapping of the file.
+  bool mmap = false;
+  RETURN_NOT_OK(use_mmap(uri, &mmap));
+  if (mmap) {
+    RETURN_NOT_OK(read_all_mapped(uri, regions));
+    if (on_region_read) {
+      for (const auto& region : regions)
+        RETURN_NOT_OK(on_region_read(std::get<1>(region)));
+    }
+    return Status::Ok();
+  }
+
   // Convert the individual regions into batched regions.
   std::vector<BatchedRead> batches;
-  RETURN_NOT_OK(compute_read_batches(regions, &batches));
+  RETURN_NOT_OK(compute_read_batches(uri, regions, &batches));
+
+  // Submit all the batches of a local file to the kernel at once.
+  if (uri.is_file()) {
+    bool found;
+    bool at_once = false;
+#ifdef _WIN32
+    RETURN_NOT_OK(
+        config_.get<bool>("vfs.file.overlapped_io", &at_once, &found));
+#else
+    RETURN_NOT_OK(config_.get<bool>("vfs.file.io_uring", &at_once, &found));
+#endif
+    assert(found);
+    if (at_once) {
+      auto task = thread_pool->execute([this, uri, batches, on_region_read]() {
+        RETURN_NOT_OK(read_batches_at_once(uri, batches));
+        if (on_region_read) {
+          for (const auto& batch : batches) {
+            for (const auto& region : batch.regions)
+              RETURN_NOT_OK(on_region_read(std::get<1>(region)));
+          }
+        }
+        return Status::Ok();
+      });
+      tasks->push_back(std::move(task));
+      return Status::Ok();
+    }
+  }
+
+  // With direct I/O, read each batch from the preceding block boundary into
+  // a block-aligned location of its buffer, so that the read bypasses the
+  // page cache without going through a scratch buffer.
+  uint64_t align = 1;
+#ifndef _WIN32
+  if (uri.is_file()) {
+    bool found;
+    bool direct_io = false;
+    RETURN_NOT_OK(config_.get<bool>("vfs.file.direct_io", &direct_io, &found));
+    assert(found);
+    if (direct_io)
+      align = constants::direct_io_alignment;
+  }
+#endif
 
   // Read all the batches and copy to the original destinations.
   for (const auto& batch : batches) {
     URI uri_copy = uri;
     BatchedRead batch_copy = batch;
-    auto task =
-        thread_pool->execute([this, uri_copy, batch_copy, use_read_ahead]() {
+    auto task = thread_pool->execute(
+        [this, uri_copy, batch_copy, use_read_ahead, align, on_region_read]() {
+          uint64_t read_offset = batch_copy.offset / align * align;
+          uint64_t read_nbytes =
+              batch_copy.nbytes + (batch_copy.offset - read_offset);
           Buffer buffer;
-          RETURN_NOT_OK(buffer.realloc(batch_copy.nbytes));
+          RETURN_NOT_OK(buffer.realloc(read_nbytes + align - 1));
+          auto addr = reinterpret_cast<uintptr_t>(buffer.data());
+          auto read_buffer = static_cast<char*>(buffer.data()) +
+                             (align - addr % align) % align;
+          auto start = std::chrono::steady_clock::now();
           RETURN_NOT_OK(read(
-              uri_copy,
-              batch_copy.offset,
-              buffer.data(),
-              batch_copy.nbytes,
-              use_read_ahead));
+              uri_copy, read_offset, read_buffer, read_nbytes, use_read_ahead));
+          std::chrono::duration<double> elapsed =
+              std::chrono::steady_clock::now() - start;
+          add_read_sample(uri_copy, read_nbytes, elapsed.count());
           // Parallel copy back into the individual destinations.
           for (uint64_t i = 0; i < batch_copy.regions.size(); i++) {
             const auto& region = batch_copy.regions[i];
             uint64_t offset = std::get<0>(region);
             void* dest = std::get<1>(region)->filtered_buffer().data();
             uint64_t nbytes = std::get<2>(region);
-            std::memcpy(dest, buffer.data(offset - batch_copy.offset), nbytes);
+            std::memcpy(dest, read_buffer + (offset - read_offset), nbytes);
+          }
+
+          // Hand the regions over as soon as the batch is in.
+          if (on_region_read) {
+            for (const auto& region : batch_copy.regions)
+              RETURN_NOT_OK(on_region_read(std::get<1>(region)));
           }
 
           return Status::Ok();
@@ -1464,7 +1864,136 @@ Status VFS::read_all(
   return Status::Ok();
 }
 
+Status VFS::use_mmap(const URI& uri, bool* mmap) const {
+  // In-memory files are always viewed in place.
+  *mmap = uri.is_memfs();
+  if (*mmap)
+    return Status::Ok();
+#ifndef _WIN32
+  if (uri.is_file()) {
+    bool found;
+    RETURN_NOT_OK(config_.get<bool>("vfs.file.mmap", mmap, &found));
+    assert(found);
+  }
+#else
+  (void)uri;
+#endif
+  return Status::Ok();
+}
+
+void VFS::unmap_files(const URI& prefix) {
+  const std::string path = prefix.to_path();
+  std::lock_guard<std::mutex> lock(mapped_files_mtx_);
+  for (auto it = mapped_files_.begin(); it != mapped_files_.end();) {
+    if (it->first.compare(0, path.size(), path) == 0)
+      it = mapped_files_.erase(it);
+    else
+      ++it;
+  }
+}
+
+Status VFS::read_all_mapped(
+    const URI& uri,
+    const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions) {
+  if (uri.is_memfs()) {
+    const std::string path = uri.to_path();
+    uint64_t nbytes = 0;
+    for (const auto& region : regions) {
+      char* data;
+      std::shared_ptr<void> owner;
+      RETURN_NOT_OK(memfs_.view(
+          path, std::get<0>(region), std::get<2>(region), &data, &owner));
+      std::get<1>(region)->filtered_buffer().set_view(
+          data, std::get<2>(region), owner);
+      nbytes += std::get<2>(region);
+    }
+    stats_->add_counter("read_mapped_byte_num", nbytes);
+    return Status::Ok();
+  }
+
+#ifdef _WIN32
+  (void)uri;
+  (void)regions;
+  return LOG_STATUS(
+      Status_VFSError("Cannot read all; memory mapping is not supported"));
+#else
+  // Map the file once, on first use.
+  const std::string path = uri.to_path();
+  std::shared_ptr<char> data;
+  uint64_t size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mapped_files_mtx_);
+    auto it = mapped_files_.find(path);
+    if (it == mapped_files_.end()) {
+      RETURN_NOT_OK(posix_.map_file(path, &data, &size));
+      it = mapped_files_.emplace(path, std::make_pair(data, size)).first;
+    }
+    data = it->second.first;
+    size = it->second.second;
+  }
+
+  uint64_t nbytes = 0;
+  for (const auto& region : regions) {
+    uint64_t offset = std::get<0>(region);
+    uint64_t region_nbytes = std::get<2>(region);
+    if (offset + region_nbytes > size)
+      return LOG_STATUS(
+          Status_VFSError("Cannot read all; Read exceeds file size"));
+    std::get<1>(region)->filtered_buffer().set_view(
+        data.get() + offset, region_nbytes, data);
+    nbytes += region_nbytes;
+  }
+  stats_->add_counter("read_mapped_byte_num", nbytes);
+
+  return Status::Ok();
+#endif
+}
+
+Status VFS::read_batches_at_once(
+    const URI& uri, const std::vector<BatchedRead>& batches) {
+  // Batches of a single region are read in place, the rest into buffers.
+  std::vector<Buffer> buffers(batches.size());
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> reads;
+  reads.reserve(batches.size());
+  uint64_t nbytes = 0;
+  for (uint64_t i = 0; i < batches.size(); i++) {
+    const auto& batch = batches[i];
+    void* dest;
+    if (batch.regions.size() == 1) {
+      dest = std::get<1>(batch.regions[0])->filtered_buffer().data();
+    } else {
+      RETURN_NOT_OK(buffers[i].realloc(batch.nbytes));
+      dest = buffers[i].data();
+    }
+    reads.emplace_back(batch.offset, dest, batch.nbytes);
+    nbytes += batch.nbytes;
+  }
+
+  read_byte_num_->add(nbytes);
+#ifdef _WIN32
+  RETURN_NOT_OK(win_.read_regions(uri.to_path(), reads));
+#else
+  RETURN_NOT_OK(posix_.read_regions(uri.to_path(), reads));
+#endif
+
+  // Copy back into the individual destinations.
+  for (uint64_t i = 0; i < batches.size(); i++) {
+    const auto& batch = batches[i];
+    if (batch.regions.size() == 1)
+      continue;
+    for (const auto& region : batch.regions) {
+      uint64_t offset = std::get<0>(region);
+      void* dest = std::get<1>(region)->filtered_buffer().data();
+      std::memcpy(
+          dest, buffers[i].data(offset - batch.offset), std::get<2>(region));
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status VFS::compute_read_batches(
+    const URI& uri,
     const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions,
     std::vector<BatchedRead>* batches) const {
   // Get config params
@@ -1477,6 +2006,15 @@ Status VFS::compute_read_batches(
   RETURN_NOT_OK(
       config_.get<uint64_t>("vfs.min_batch_gap", &min_batch_gap, &found));
   assert(found);
+  bool adaptive = false;
+  RETURN_NOT_OK(
+      config_.get<bool>("vfs.adaptive_batch_gap", &adaptive, &found));
+  assert(found);
+  uint64_t gap = 0;
+  if (adaptive && adaptive_batch_gap(uri, &gap)) {
+    min_batch_gap = gap;
+    stats_->set_max_counter("read_adaptive_batch_gap", gap);
+  }
 
   // Ensure the regions are sorted on offset.
   std::vector<std::tuple<uint64_t, Tile*, uint64_t>> sorted_regions(
@@ -1493,6 +2031,7 @@ Status VFS::compute_read_batches(
   // Start the first batch containing only the first region.
   BatchedRead curr_batch(sorted_regions.front());
   uint64_t curr_batch_useful_bytes = curr_batch.nbytes;
+  uint64_t gap_bytes = 0;
   for (uint64_t i = 1; i < sorted_regions.size(); i++) {
     const auto& region = sorted_regions[i];
     uint64_t offset = std::get<0>(region);
@@ -1506,6 +2045,8 @@ Status VFS::compute_read_batches(
       curr_batch_useful_bytes += nbytes;
     } else {
       // Push the old batch and start a new one.
+      gap_bytes += curr_batch.nbytes -
+                   std::min(curr_batch.nbytes, curr_batch_useful_bytes);
       batches->push_back(curr_batch);
       curr_batch.offset = offset;
       curr_batch.nbytes = nbytes;
@@ -1516,11 +2057,96 @@ Status VFS::compute_read_batches(
   }
 
   // Push the last batch
+  gap_bytes += curr_batch.nbytes -
+               std::min(curr_batch.nbytes, curr_batch_useful_bytes);
   batches->push_back(curr_batch);
 
+  // Regions may overlap, so the useful bytes are an upper bound and the gap
+  // bytes a lower bound.
+  if (auto counters = backend_counters(uri))
+    counters->batch_gap_byte_num_->add(gap_bytes);
+
   return Status::Ok();
 }
 
+bool VFS::adaptive_batch_gap(const URI& uri, uint64_t* gap) const {
+  double latency = 0, bandwidth = 0;
+  {
+    std::lock_guard<std::mutex> lock(read_cost_models_mtx_);
+    auto it = read_cost_models_.find(uri_scheme(uri));
+    if (it == read_cost_models_.end() ||
+        !it->second.estimate(
+            constants::adaptive_batch_gap_min_samples, &latency, &bandwidth))
+      return false;
+  }
+
+  stats_->set_max_counter(
+      "read_latency_estimate_us", static_cast<uint64_t>(latency * 1e6));
+  stats_->set_max_counter(
+      "read_bandwidth_estimate_bytes_per_sec",
+      static_cast<uint64_t>(bandwidth));
+  *gap = static_cast<uint64_t>(std::min(
+      latency * bandwidth, double(constants::adaptive_batch_gap_max)));
+  return true;
+}
+
+void VFS::add_read_sample(const URI& uri, uint64_t nbytes, double seconds) {
+  std::lock_guard<std::mutex> lock(read_cost_models_mtx_);
+  auto it = read_cost_models_.find(uri_scheme(uri));
+  if (it == read_cost_models_.end()) {
+    it = read_cost_models_.emplace(uri_scheme(uri), ReadCostModel()).first;
+    it->second.set_alpha(constants::adaptive_batch_gap_smoothing);
+  }
+  it->second.add_sample(nbytes, seconds);
+}
+
+std::string VFS::uri_scheme(const URI& uri) {
+  const std::string& str = uri.to_string();
+  return str.substr(0, str.find("://"));
+}
+
+const VFS::BackendCounters* VFS::backend_counters(const URI& uri) const {
+  size_t i = 0;
+  if (uri.is_file())
+    i = 0;
+  else if (uri.is_hdfs())
+    i = 1;
+  else if (uri.is_s3())
+    i = 2;
+  else if (uri.is_azure())
+    i = 3;
+  else if (uri.is_gcs())
+    i = 4;
+  else if (uri.is_memfs())
+    i = 5;
+  else
+    return nullptr;
+
+  return &backend_counters_[i];
+}
+
+std::vector<std::pair<std::string, uint64_t>> VFS::request_counts() const {
+  std::vector<std::pair<std::string, uint64_t>> ret;
+  for (size_t i = 0; i < backend_names_.size(); i++) {
+    const auto& counters = backend_counters_[i];
+    const std::pair<const char*, stats::Stats::Counter*> all[] = {
+        {"get_num", counters.get_num_},
+        {"get_byte_num", counters.get_byte_num_},
+        {"put_num", counters.put_num_},
+        {"put_byte_num", counters.put_byte_num_},
+        {"list_num", counters.list_num_},
+        {"delete_num", counters.delete_num_},
+        {"batch_gap_byte_num", counters.batch_gap_byte_num_}};
+    for (const auto& [name, counter] : all) {
+      if (counter != nullptr && counter->value() > 0)
+        ret.emplace_back(
+            std::string(backend_names_[i]) + "." + name, counter->value());
+    }
+  }
+
+  return ret;
+}
+
 bool VFS::supports_fs(Filesystem fs) const {
   return (supported_fs_.find(fs) != supported_fs_.end());
 }
@@ -1539,6 +2165,30 @@ bool VFS::supports_uri_scheme(const URI& uri) const {
   }
 }
 
+Status VFS::begin_group_commit(const URI& uri) {
+  if (!init_)
+    return LOG_STATUS(
+        Status_VFSError("Cannot begin group commit; VFS not initialized"));
+
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix_.begin_group_commit(uri.to_path());
+#endif
+  return Status::Ok();
+}
+
+Status VFS::commit_group(const URI& uri) {
+  if (!init_)
+    return LOG_STATUS(
+        Status_VFSError("Cannot commit group; VFS not initialized"));
+
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix_.commit_group(uri.to_path());
+#endif
+  return Status::Ok();
+}
+
 Status VFS::sync(const URI& uri) {
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot sync; VFS not initialized"));
@@ -1692,9 +2342,14 @@ Status VFS::close_file(const URI& uri) {
 Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   stats_->add_counter("write_byte_num", buffer_size);
   stats_->add_counter("write_ops_num", 1);
+  auto timer_se = stats_->start_timer(write_request_timer_);
 
   if (!init_)
     return LOG_STATUS(Status_VFSError("Cannot write; VFS not initialized"));
+  if (auto counters = backend_counters(uri)) {
+    counters->put_num_->add(1);
+    counters->put_byte_num_->add(buffer_size);
+  }
 
   if (uri.is_file()) {
 #ifdef _WIN32
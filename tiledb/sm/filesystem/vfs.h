@@ -33,10 +33,16 @@
 #ifndef TILEDB_VFS_H
 #define TILEDB_VFS_H
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <limits>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "tiledb/common/common.h"
@@ -45,6 +51,7 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/cache/lru_cache.h"
 #include "tiledb/sm/config/config.h"
+#include "tiledb/sm/filesystem/disk_cache.h"
 #include "tiledb/sm/filesystem/mem_filesystem.h"
 #include "tiledb/sm/misc/cancelable_tasks.h"
 #include "tiledb/sm/stats/stats.h"
@@ -190,6 +197,16 @@ class VFS {
    */
   Status remove_dir(const URI& uri) const;
 
+  /**
+   * Removes the given directories (recursive), in parallel on the io thread
+   * pool. On S3 the objects of all the directories are deleted with batched
+   * DeleteObjects requests.
+   *
+   * @param uris The uris of the directories to be removed
+   * @return Status
+   */
+  Status remove_dirs(const std::vector<URI>& uris) const;
+
   /**
    * Deletes a file.
    *
@@ -198,6 +215,15 @@ class VFS {
    */
   Status remove_file(const URI& uri) const;
 
+  /**
+   * Deletes the given files, in parallel on the io thread pool. On S3 they
+   * are deleted with batched DeleteObjects requests.
+   *
+   * @param uris The URIs of the files.
+   * @return Status
+   */
+  Status remove_files(const std::vector<URI>& uris) const;
+
   /**
    * Retrieves the size of a file.
    *
@@ -278,6 +304,23 @@ class VFS {
    */
   Status ls(const URI& parent, std::vector<URI>* uris) const;
 
+  /**
+   * Retrieves all the URIs that have the first input as parent, like `ls`.
+   * On object stores that list in pages, the names are split at the given
+   * sorted `split_names` into ranges listed concurrently. Other backends
+   * ignore the split names.
+   *
+   * @param parent The target directory to list.
+   * @param split_names The sorted names (relative to `parent`) ending each
+   *     range but the last.
+   * @param uris The URIs that are contained in the parent.
+   * @return Status
+   */
+  Status ls_sharded(
+      const URI& parent,
+      const std::vector<std::string>& split_names,
+      std::vector<URI>* uris) const;
+
   /**
    * Renames a file.
    *
@@ -340,6 +383,10 @@ class VFS {
    * @param thread_pool Thread pool to execute async read tasks to.
    * @param tasks Vector to which new async read tasks are pushed.
    * @param use_read_ahead Whether to use the read-ahead cache.
+   * @param on_region_read If set, invoked with the destination tile of each
+   *    region as soon as the region is read, from the task that read it. A
+   *    failure fails that task. This lets callers start processing tiles
+   *    before the slowest region of the file arrives.
    * @return Status
    */
   Status read_all(
@@ -347,7 +394,27 @@ class VFS {
       const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions,
       ThreadPool* thread_pool,
       std::vector<ThreadPool::Task>* tasks,
-      bool use_read_ahead = true);
+      bool use_read_ahead = true,
+      const std::function<Status(Tile*)>& on_region_read = nullptr);
+
+  /**
+   * Checks whether `read_all` serves the regions of the given file as views
+   * of a memory mapping of the file (`vfs.file.mmap`) or of an in-memory
+   * file, in which case the destination tiles need not be allocated.
+   *
+   * @param uri The URI of the file.
+   * @param mmap Set to `true` if the file is read through a mapping.
+   * @return Status
+   */
+  Status use_mmap(const URI& uri, bool* mmap) const;
+
+  /**
+   * Drops the memory mappings of all the files under the given URI. Tiles
+   * still viewing a mapping keep it alive until they are released.
+   *
+   * @param prefix The URI prefix of the files to unmap.
+   */
+  void unmap_files(const URI& prefix);
 
   /** Checks if a given filesystem is supported. */
   bool supports_fs(Filesystem fs) const;
@@ -355,6 +422,26 @@ class VFS {
   /** Checks if the backend required to access the given URI is supported. */
   bool supports_uri_scheme(const URI& uri) const;
 
+  /**
+   * Starts deferring the syncs of the files closed under the input fragment
+   * directory to `commit_group`, if `vfs.file.group_commit` is set. This is
+   * a noop for all backends but the local filesystem.
+   *
+   * @param uri The URI of the fragment directory.
+   * @return Status
+   */
+  Status begin_group_commit(const URI& uri);
+
+  /**
+   * Syncs the files whose syncs were deferred by `begin_group_commit`,
+   * batching them with those of the fragments committed concurrently. This
+   * must be called before the fragment is committed.
+   *
+   * @param uri The URI of the fragment directory.
+   * @return Status
+   */
+  Status commit_group(const URI& uri);
+
   /**
    * Syncs (flushes) a file. Note that for S3 this is a noop.
    *
@@ -402,6 +489,12 @@ class VFS {
    */
   Status write(const URI& uri, const void* buffer, uint64_t buffer_size);
 
+  /**
+   * Returns the non-zero request counters of the storage backends, as
+   * (`<backend>.<counter>`, value) pairs.
+   */
+  std::vector<std::pair<std::string, uint64_t>> request_counts() const;
+
  private:
   /* ********************************* */
   /*        PRIVATE DATATYPES          */
@@ -431,6 +524,122 @@ class VFS {
     std::vector<std::tuple<uint64_t, Tile*, uint64_t>> regions;
   };
 
+  /**
+   * The request counters of a storage backend, registered in `stats_` as
+   * `<backend>.<counter>`.
+   */
+  struct BackendCounters {
+    /** The number of read requests. */
+    stats::Stats::Counter* get_num_ = nullptr;
+
+    /** The number of bytes requested by the reads. */
+    stats::Stats::Counter* get_byte_num_ = nullptr;
+
+    /** The number of write requests. */
+    stats::Stats::Counter* put_num_ = nullptr;
+
+    /** The number of bytes written. */
+    stats::Stats::Counter* put_byte_num_ = nullptr;
+
+    /** The number of list requests. */
+    stats::Stats::Counter* list_num_ = nullptr;
+
+    /** The number of file and directory removals. */
+    stats::Stats::Counter* delete_num_ = nullptr;
+
+    /** The number of gap bytes read by coalesced batches but not needed. */
+    stats::Stats::Counter* batch_gap_byte_num_ = nullptr;
+  };
+
+  /** The names of the backends with request counters. */
+  static constexpr std::array<const char*, 6> backend_names_ = {
+      "file", "hdfs", "s3", "azure", "gcs", "mem"};
+
+  /**
+   * Moving estimate of the cost of the reads of a backend, fitted as
+   * `seconds = latency + nbytes / bandwidth` by exponentially weighted
+   * least squares over the observed reads.
+   */
+  class ReadCostModel {
+   public:
+    /** Adds an observed read of `nbytes` that took `seconds`. */
+    void add_sample(uint64_t nbytes, double seconds) {
+      // Sizes are in MB to keep the second moments well conditioned.
+      const double n = nbytes / (1024.0 * 1024.0);
+      const double a = samples_ == 0 ? 1.0 : alpha_;
+      mean_n_ += a * (n - mean_n_);
+      mean_t_ += a * (seconds - mean_t_);
+      mean_nn_ += a * (n * n - mean_nn_);
+      mean_nt_ += a * (n * seconds - mean_nt_);
+      samples_++;
+    }
+
+    /**
+     * Returns the request latency in seconds and the bandwidth in bytes per
+     * second. Returns `false` if there are too few samples, or if their sizes
+     * are too similar to tell latency from transfer time.
+     */
+    bool estimate(
+        uint64_t min_samples, double* latency, double* bandwidth) const {
+      if (samples_ < min_samples)
+        return false;
+      const double var_n = mean_nn_ - mean_n_ * mean_n_;
+      if (var_n <= 1e-9 * std::max(mean_nn_, 1e-9))
+        return false;
+      const double secs_per_mb = (mean_nt_ - mean_n_ * mean_t_) / var_n;
+      if (secs_per_mb <= 0)
+        return false;
+      *latency = std::max(mean_t_ - secs_per_mb * mean_n_, 0.0);
+      *bandwidth = 1024.0 * 1024.0 / secs_per_mb;
+      return true;
+    }
+
+    /** Sets the weight of a new sample. */
+    void set_alpha(double alpha) {
+      alpha_ = alpha;
+    }
+
+   private:
+    /** The weight of a new sample. */
+    double alpha_ = 0.1;
+
+    /** The number of samples. */
+    uint64_t samples_ = 0;
+
+    /** Moving means of the size (MB), time, size squared and size x time. */
+    double mean_n_ = 0, mean_t_ = 0, mean_nn_ = 0, mean_nt_ = 0;
+  };
+
+  /**
+   * The state of the stream of small reads of a file, used to detect
+   * sequential access and read ahead of it asynchronously.
+   */
+  struct ReadAheadStream {
+    /** The end offset of the last read. */
+    uint64_t last_end_ = 0;
+
+    /** The number of consecutive sequential reads. */
+    uint64_t sequential_reads_ = 0;
+
+    /** The read-ahead window, which grows while access is sequential. */
+    uint64_t window_ = 0;
+
+    /** The end of the file, once a read-ahead came back short. */
+    uint64_t file_end_ = std::numeric_limits<uint64_t>::max();
+
+    /** The offset of the asynchronous read-ahead. */
+    uint64_t prefetch_offset_ = 0;
+
+    /** The number of bytes requested by the asynchronous read-ahead. */
+    uint64_t prefetch_window_ = 0;
+
+    /** The buffer of the asynchronous read-ahead. */
+    std::shared_ptr<Buffer> prefetch_buffer_;
+
+    /** The asynchronous read-ahead, valid until it is waited on. */
+    ThreadPool::Task prefetch_task_;
+  };
+
   /**
    * Represents a sub-range of data within a URI file at a
    * specific file offset.
@@ -557,6 +766,23 @@ class VFS {
       return Status::Ok();
     }
 
+    /**
+     * Returns the end offset of the cached buffer of a URI.
+     *
+     * @param uri The URI associated with the cached buffer.
+     * @param end Set to the end offset of the cached buffer, if any.
+     * @return `true` if there is a cached buffer for `uri`.
+     */
+    bool cached_end(const URI& uri, uint64_t* const end) {
+      const std::string uri_str = uri.to_string();
+      std::lock_guard<std::mutex> lg(lru_mtx_);
+      if (!has_item(uri_str))
+        return false;
+      const ReadAheadBuffer* const ra_buffer = get_item(uri_str);
+      *end = ra_buffer->offset_ + ra_buffer->buffer_.size();
+      return true;
+    }
+
     /**
      * Writes a cached buffer for the given uri.
      *
@@ -613,6 +839,21 @@ class VFS {
   /** The class stats. */
   stats::Stats* stats_;
 
+  /** The `read_byte_num` counter of `stats_`, updated on every read. */
+  stats::Stats::Counter* read_byte_num_;
+
+  /** The `read_ops_num` counter of `stats_`, updated on every read. */
+  stats::Stats::Counter* read_ops_num_;
+
+  /** The `read_request` timer of `stats_`, the latency of every read. */
+  stats::Stats::Timer* read_request_timer_;
+
+  /** The `write_request` timer of `stats_`, the latency of every write. */
+  stats::Stats::Timer* write_request_timer_;
+
+  /** The request counters of each backend, indexed like `backend_names_`. */
+  std::array<BackendCounters, backend_names_.size()> backend_counters_;
+
   /** The in-memory filesystem which is always supported */
   MemFilesystem memfs_;
 
@@ -625,6 +866,15 @@ class VFS {
   /** The byte size to read-ahead for each read. */
   uint64_t read_ahead_size_;
 
+  /** The maximum read-ahead window of a sequential stream. */
+  uint64_t read_ahead_max_window_;
+
+  /** The read streams of files, by URI. */
+  std::unordered_map<std::string, ReadAheadStream> read_ahead_streams_;
+
+  /** Protects `read_ahead_streams_`. */
+  std::mutex read_ahead_streams_mtx_;
+
   /** The set with the supported filesystems. */
   std::set<Filesystem> supported_fs_;
 
@@ -640,6 +890,22 @@ class VFS {
   /** The read-ahead cache. */
   tdb_unique_ptr<ReadAheadCache> read_ahead_cache_;
 
+  /** The local disk cache of object store reads. */
+  DiskCache disk_cache_;
+
+  /** The memory mappings of local files, as (mapping, size) by path. */
+  std::unordered_map<std::string, std::pair<std::shared_ptr<char>, uint64_t>>
+      mapped_files_;
+
+  /** Protects `mapped_files_`. */
+  std::mutex mapped_files_mtx_;
+
+  /** The read cost estimates, by URI scheme. */
+  std::unordered_map<std::string, ReadCostModel> read_cost_models_;
+
+  /** Protects `read_cost_models_`. */
+  mutable std::mutex read_cost_models_mtx_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -648,15 +914,84 @@ class VFS {
    * Groups the given vector of regions to be read into a possibly smaller
    * vector of batched reads.
    *
+   * @param uri The URI of the file.
    * @param regions Vector of individual regions to be read. Each region is a
    *    tuple `(file_offset, dest_buffer, nbytes)`.
    * @param batches Vector storing the batched read information.
    * @return Status
    */
   Status compute_read_batches(
+      const URI& uri,
       const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions,
       std::vector<BatchedRead>* batches) const;
 
+  /**
+   * Computes the read batch gap of a URI from the read cost estimates of its
+   * backend, as the number of bytes that can be transferred during the
+   * latency of a request.
+   *
+   * @param uri The URI of the file.
+   * @param gap Set to the gap, if there is an estimate.
+   * @return `true` if there is an estimate.
+   */
+  bool adaptive_batch_gap(const URI& uri, uint64_t* gap) const;
+
+  /** Records the duration of a batched read of a URI. */
+  void add_read_sample(const URI& uri, uint64_t nbytes, double seconds);
+
+  /** Returns the scheme of a URI, keying its read cost estimates. */
+  static std::string uri_scheme(const URI& uri);
+
+  /**
+   * Returns the request counters of the backend of a URI, or null if the
+   * URI scheme is not supported.
+   */
+  const BackendCounters* backend_counters(const URI& uri) const;
+
+  /**
+   * Reads the given batches of a local file with a single submission, to
+   * io_uring or as overlapped I/O on Windows, and copies them back to the
+   * destination tiles. Batches made of a single region are read directly
+   * into the destination tile.
+   *
+   * @param uri The URI of the file.
+   * @param batches The batched reads to perform.
+   * @return Status
+   */
+  Status read_batches_at_once(
+      const URI& uri, const std::vector<BatchedRead>& batches);
+
+  /**
+   * Points the filtered buffers of the destination tiles to their regions
+   * in a memory mapping of the file, mapping the file if needed, or in the
+   * in-memory file.
+   *
+   * @param uri The URI of the file.
+   * @param regions The regions to read, as `(file_offset, tile, nbytes)`.
+   * @return Status
+   */
+  Status read_all_mapped(
+      const URI& uri,
+      const std::vector<std::tuple<uint64_t, Tile*, uint64_t>>& regions);
+
+  /**
+   * Reads from a file, serving immutable object store files from the local
+   * disk cache if it is enabled.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Number of bytes to read.
+   * @param use_read_ahead Whether to use the read-ahead cache.
+   * @return Status
+   */
+  Status read_cached(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      bool use_read_ahead);
+
   /**
    * Reads from a file by calling the specific backend read function.
    *
@@ -694,6 +1029,32 @@ class VFS {
       const uint64_t nbytes,
       const bool use_read_ahead);
 
+  /**
+   * Moves the asynchronous read-ahead of a file into the read-ahead cache
+   * once it completes, if it covers the given read.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param nbytes Number of bytes to read.
+   * @param success Set to `true` if the read is now cached.
+   * @return Status
+   */
+  Status take_read_ahead(
+      const URI& uri, uint64_t offset, uint64_t nbytes, bool* success);
+
+  /**
+   * Starts reading the next window of a sequentially read file, right after
+   * its cached buffer, on the I/O thread pool. The window doubles with each
+   * read-ahead up to `read_ahead_max_window_`.
+   *
+   * @param read_fn The read routine to execute.
+   * @param uri The URI of the file.
+   */
+  void start_read_ahead(
+      const std::function<Status(
+          const URI&, off_t, void*, uint64_t, uint64_t, uint64_t*)>& read_fn,
+      const URI& uri);
+
   /**
    * Retrieves the backend-specific max number of parallel operations for VFS
    * read.
@@ -48,6 +48,7 @@
 #include <wininet.h>  // For INTERNET_MAX_URL_LENGTH
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -360,6 +361,59 @@ Status Win::read(
   return Status::Ok();
 }
 
+Status Win::read_regions(
+    const std::string& path,
+    const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const {
+  bool found = false;
+  bool overlapped_io = false;
+  RETURN_NOT_OK(
+      config_.get<bool>("vfs.file.overlapped_io", &overlapped_io, &found));
+  assert(found);
+  if (!overlapped_io) {
+    for (const auto& region : regions)
+      RETURN_NOT_OK(read(
+          path, std::get<0>(region), std::get<1>(region), std::get<2>(region)));
+    return Status::Ok();
+  }
+
+  // Checks
+  uint64_t file_size;
+  RETURN_NOT_OK(this->file_size(path, &file_size));
+  for (const auto& region : regions) {
+    if (std::get<0>(region) + std::get<2>(region) > file_size)
+      return LOG_STATUS(Status_IOError(
+          "Cannot read from file '" + path + "'; Read exceeds file size"));
+  }
+
+  HANDLE file_h = CreateFile(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      NULL,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED,
+      NULL);
+  if (file_h == INVALID_HANDLE_VALUE) {
+    return LOG_STATUS(Status_IOError(
+        "Cannot read from file '" + path + "'; File opening error"));
+  }
+
+  // Issue all the regions at once
+  Status st = submit_overlapped(file_h, false, regions);
+  if (!st.ok()) {
+    CloseHandle(file_h);
+    return LOG_STATUS(Status_IOError(
+        "Cannot read from file '" + path + "'; " + st.message()));
+  }
+
+  if (CloseHandle(file_h) == 0) {
+    return LOG_STATUS(Status_IOError(
+        "Cannot read from file '" + path + "'; File closing error"));
+  }
+
+  return Status::Ok();
+}
+
 Status Win::sync(const std::string& path) const {
   if (!is_file(path)) {
     return Status::Ok();
@@ -406,6 +460,10 @@ Status Win::write(
   RETURN_NOT_OK(config_.get<uint64_t>(
       "vfs.file.max_parallel_ops", &max_parallel_ops, &found));
   assert(found);
+  bool overlapped_io = false;
+  RETURN_NOT_OK(
+      config_.get<bool>("vfs.file.overlapped_io", &overlapped_io, &found));
+  assert(found);
 
   Status st;
   // Open the file for appending, creating it if it doesn't exist.
@@ -415,7 +473,7 @@ Status Win::write(
       0,
       NULL,
       OPEN_ALWAYS,
-      FILE_ATTRIBUTE_NORMAL,
+      FILE_ATTRIBUTE_NORMAL | (overlapped_io ? FILE_FLAG_OVERLAPPED : 0),
       NULL);
   if (file_h == INVALID_HANDLE_VALUE) {
     return LOG_STATUS(Status_IOError(
@@ -433,7 +491,26 @@ Status Win::write(
   // bytes, and cap the number of parallel operations at the thread pool size.
   uint64_t num_ops = std::min(
       std::max(buffer_size / min_parallel_size, uint64_t(1)), max_parallel_ops);
-  if (num_ops == 1) {
+  if (overlapped_io) {
+    // Issue all the parts at once.
+    std::vector<std::tuple<uint64_t, void*, uint64_t>> ops;
+    uint64_t op_nbytes = utils::math::ceil(buffer_size, num_ops);
+    for (uint64_t begin = 0; begin < buffer_size; begin += op_nbytes) {
+      auto op_buffer =
+          const_cast<char*>(reinterpret_cast<const char*>(buffer) + begin);
+      ops.emplace_back(
+          file_offset + begin,
+          op_buffer,
+          std::min(op_nbytes, buffer_size - begin));
+    }
+    st = submit_overlapped(file_h, true, ops);
+    if (!st.ok()) {
+      CloseHandle(file_h);
+      std::stringstream errmsg;
+      errmsg << "Cannot write to file '" << path << "'; " << st.message();
+      return LOG_STATUS(Status_IOError(errmsg.str()));
+    }
+  } else if (num_ops == 1) {
     if (!write_at(file_h, file_offset, buffer, buffer_size).ok()) {
       CloseHandle(file_h);
       return LOG_STATUS(
@@ -471,6 +548,100 @@ Status Win::write(
   return st;
 }
 
+Status Win::submit_overlapped(
+    HANDLE file_h,
+    bool write,
+    const std::vector<std::tuple<uint64_t, void*, uint64_t>>& ops) {
+  // Split the I/Os into pieces whose size fits in a single call. The
+  // OVERLAPPED structure comes first, so that a completion maps back to its
+  // piece.
+  struct Piece {
+    OVERLAPPED ov;
+    char* buffer;
+    DWORD nbytes;
+  };
+  std::vector<Piece> pieces;
+  for (const auto& op : ops) {
+    uint64_t offset = std::get<0>(op);
+    char* buffer = static_cast<char*>(std::get<1>(op));
+    uint64_t nbytes = std::get<2>(op);
+    while (nbytes > 0) {
+      Piece piece;
+      std::memset(&piece.ov, 0, sizeof(OVERLAPPED));
+      LARGE_INTEGER offset_lg_int;
+      offset_lg_int.QuadPart = offset;
+      piece.ov.Offset = offset_lg_int.LowPart;
+      piece.ov.OffsetHigh = offset_lg_int.HighPart;
+      piece.buffer = buffer;
+      piece.nbytes = static_cast<DWORD>(
+          std::min<uint64_t>(nbytes, constants::max_write_bytes));
+      pieces.push_back(piece);
+      offset += piece.nbytes;
+      buffer += piece.nbytes;
+      nbytes -= piece.nbytes;
+    }
+  }
+  if (pieces.empty())
+    return Status::Ok();
+
+  HANDLE port = CreateIoCompletionPort(file_h, NULL, 0, 1);
+  if (port == NULL) {
+    return LOG_STATUS(Status_IOError(
+        "Cannot create I/O completion port; " + get_last_error_msg()));
+  }
+
+  // Keep the queue full, reaping one completion at a time. After an error,
+  // no more pieces are issued, but the ones in flight are still reaped as
+  // the kernel owns their OVERLAPPED structures until they complete.
+  std::string error;
+  uint64_t next = 0;
+  uint64_t in_flight = 0;
+  while (next < pieces.size() || in_flight > 0) {
+    while (error.empty() && next < pieces.size() &&
+           in_flight < constants::overlapped_io_queue_depth) {
+      auto& piece = pieces[next];
+      BOOL rc = write ?
+                    WriteFile(
+                        file_h, piece.buffer, piece.nbytes, NULL, &piece.ov) :
+                    ReadFile(
+                        file_h, piece.buffer, piece.nbytes, NULL, &piece.ov);
+      if (rc == 0 && GetLastError() != ERROR_IO_PENDING) {
+        error = get_last_error_msg();
+        break;
+      }
+      ++next;
+      ++in_flight;
+    }
+    if (in_flight == 0)
+      break;
+
+    DWORD nbytes = 0;
+    ULONG_PTR key = 0;
+    LPOVERLAPPED ov = NULL;
+    BOOL rc = GetQueuedCompletionStatus(port, &nbytes, &key, &ov, INFINITE);
+    if (ov == NULL) {
+      // Nothing was dequeued, so the port itself failed
+      error = get_last_error_msg();
+      CancelIoEx(file_h, NULL);
+      break;
+    }
+    --in_flight;
+    auto piece = reinterpret_cast<Piece*>(ov);
+    if (error.empty() && rc == 0)
+      error = get_last_error_msg();
+    else if (error.empty() && nbytes != piece->nbytes)
+      error = "Short I/O";
+  }
+  CloseHandle(port);
+
+  if (!error.empty()) {
+    return LOG_STATUS(Status_IOError(
+        std::string(write ? "Overlapped write" : "Overlapped read") +
+        " error: " + error));
+  }
+  return Status::Ok();
+}
+
 Status Win::write_at(
     HANDLE file_h,
     uint64_t file_offset,
@@ -37,6 +37,7 @@
 
 #include <sys/types.h>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "tiledb/common/status.h"
@@ -173,6 +174,19 @@ class Win {
       void* buffer,
       uint64_t nbytes) const;
 
+  /**
+   * Reads multiple regions of a file into buffers. If
+   * `vfs.file.overlapped_io` is set, all the regions are issued at once as
+   * overlapped reads. Otherwise they are read one after the other.
+   *
+   * @param path The name of the file.
+   * @param regions The regions to read, as (file offset, buffer, size) tuples.
+   * @return Status
+   */
+  Status read_regions(
+      const std::string& path,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const;
+
   /**
    * Syncs a file or directory.
    *
@@ -210,6 +224,21 @@ class Win {
    */
   Status recursively_remove_directory(const std::string& path) const;
 
+  /**
+   * Issues reads or writes as overlapped I/O, keeping up to
+   * `constants::overlapped_io_queue_depth` of them in flight, and waits for
+   * all of them on an I/O completion port.
+   *
+   * @param file_h File handle opened with `FILE_FLAG_OVERLAPPED`.
+   * @param write Whether to write the buffers instead of reading into them.
+   * @param ops The I/Os to issue, as (file offset, buffer, size) tuples.
+   * @return Status
+   */
+  static Status submit_overlapped(
+      HANDLE file_h,
+      bool write,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& ops);
+
   /**
    * Write data from the given buffer to the file handle, beginning at the
    * given offset. Multiple threads can safely write to the same open file
@@ -0,0 +1,445 @@
+/**
+ * @file   auto_compression_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class AutoCompressionFilter.
+ */
+
+#include "tiledb/sm/filter/auto_compression_filter.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/compressors/lz4_compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_option.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Number of candidates. */
+constexpr uint8_t candidate_num = 5;
+
+/**
+ * Relative decompression cost of each candidate, added to the compression
+ * ratio when weighted by the speed bias.
+ */
+constexpr double decompression_cost[candidate_num] = {
+    0.0, 0.1, 0.25, 0.25, 0.35};
+
+/** Size of the whole inputs that are used as their own sample. */
+constexpr uint64_t max_sample_size = 16384;
+
+/** Number and size of the slices of the sample of larger inputs. */
+constexpr uint64_t sample_slice_num = 4;
+constexpr uint64_t sample_slice_size = max_sample_size / sample_slice_num;
+
+/** ZStd levels of the candidates. */
+constexpr int zstd_fast_level = 1;
+constexpr int zstd_level = 9;
+
+/** Returns true if delta encoding applies to the given datatype. */
+bool delta_applies(Datatype type) {
+  return datatype_is_integer(type) || datatype_is_datetime(type) ||
+         datatype_is_time(type);
+}
+
+/** Replaces each value of type U with its difference from the previous one. */
+template <typename U>
+void delta_encode(const char* input, uint64_t size, char* output) {
+  const uint64_t num = size / sizeof(U);
+  U prev = 0;
+  for (uint64_t i = 0; i < num; i++) {
+    U value;
+    std::memcpy(&value, input + i * sizeof(U), sizeof(U));
+    const auto delta = static_cast<U>(value - prev);
+    std::memcpy(output + i * sizeof(U), &delta, sizeof(U));
+    prev = value;
+  }
+  std::memcpy(
+      output + num * sizeof(U), input + num * sizeof(U), size % sizeof(U));
+}
+
+/** Reverts delta_encode in place. */
+template <typename U>
+void delta_decode(char* data, uint64_t size) {
+  const uint64_t num = size / sizeof(U);
+  U prev = 0;
+  for (uint64_t i = 0; i < num; i++) {
+    U delta;
+    std::memcpy(&delta, data + i * sizeof(U), sizeof(U));
+    prev = static_cast<U>(prev + delta);
+    std::memcpy(data + i * sizeof(U), &prev, sizeof(U));
+  }
+}
+
+/** Delta encodes values of the given size. */
+void delta_encode(
+    uint64_t value_size, const char* input, uint64_t size, char* output) {
+  switch (value_size) {
+    case sizeof(uint8_t):
+      return delta_encode<uint8_t>(input, size, output);
+    case sizeof(uint16_t):
+      return delta_encode<uint16_t>(input, size, output);
+    case sizeof(uint32_t):
+      return delta_encode<uint32_t>(input, size, output);
+    default:
+      assert(value_size == sizeof(uint64_t));
+      return delta_encode<uint64_t>(input, size, output);
+  }
+}
+
+/** Delta decodes values of the given size in place. */
+void delta_decode(uint64_t value_size, char* data, uint64_t size) {
+  switch (value_size) {
+    case sizeof(uint8_t):
+      return delta_decode<uint8_t>(data, size);
+    case sizeof(uint16_t):
+      return delta_decode<uint16_t>(data, size);
+    case sizeof(uint32_t):
+      return delta_decode<uint32_t>(data, size);
+    default:
+      assert(value_size == sizeof(uint64_t));
+      return delta_decode<uint64_t>(data, size);
+  }
+}
+
+/** Returns the compression overhead of the candidate on nbytes. */
+uint64_t overhead(AutoCompressionFilter::Candidate candidate, uint64_t nbytes) {
+  switch (candidate) {
+    case AutoCompressionFilter::Candidate::NONE:
+      return 0;
+    case AutoCompressionFilter::Candidate::LZ4:
+      return LZ4::overhead(nbytes);
+    default:
+      return ZStd::overhead(nbytes);
+  }
+}
+
+}  // namespace
+
+AutoCompressionFilter::AutoCompressionFilter()
+    : AutoCompressionFilter(DEFAULT_SPEED_BIAS) {
+}
+
+AutoCompressionFilter::AutoCompressionFilter(uint32_t speed_bias)
+    : Filter(FilterType::FILTER_AUTO_COMPRESSION)
+    , speed_bias_(std::min(speed_bias, uint32_t(100)))
+    , zstd_compress_ctx_pool_(nullptr)
+    , zstd_decompress_ctx_pool_(nullptr) {
+}
+
+AutoCompressionFilter* AutoCompressionFilter::clone_impl() const {
+  return tdb_new(AutoCompressionFilter, speed_bias_);
+}
+
+void AutoCompressionFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "AutoCompression: AUTO_COMPRESSION_SPEED_BIAS=%u", speed_bias_);
+}
+
+uint32_t AutoCompressionFilter::speed_bias() const {
+  return speed_bias_;
+}
+
+Status AutoCompressionFilter::set_speed_bias(uint32_t speed_bias) {
+  if (speed_bias > 100)
+    return LOG_STATUS(Status_FilterError(
+        "Auto compression filter error; the speed bias must be at most 100"));
+  speed_bias_ = speed_bias;
+  return Status::Ok();
+}
+
+Status AutoCompressionFilter::run_forward(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  const uint64_t input_size = input->size();
+  if (input_size > std::numeric_limits<uint32_t>::max())
+    return LOG_STATUS(
+        Status_FilterError("Input is too large to be compressed."));
+
+  // Gather the input when it comes in multiple parts.
+  std::vector<char> gathered;
+  const char* input_data = nullptr;
+  if (input->num_buffers() == 1) {
+    ConstBuffer data(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+    input_data = static_cast<const char*>(data.data());
+  } else if (input_size > 0) {
+    gathered.resize(input_size);
+    RETURN_NOT_OK(input->copy_to(gathered.data()));
+    input_data = gathered.data();
+  }
+
+  Candidate candidate;
+  RETURN_NOT_OK(pick_candidate(tile, input_data, input_size, &candidate));
+
+  // Compress with the picked candidate.
+  uint64_t compressed_size = input_size;
+  if (candidate == Candidate::NONE) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    RETURN_NOT_OK(output->prepend_buffer(
+        input_size + overhead(candidate, input_size)));
+    Buffer* buffer_ptr = output->buffer_ptr(0);
+    assert(buffer_ptr != nullptr);
+    buffer_ptr->reset_offset();
+    ConstBuffer input_buffer(input_data, input_size);
+    RETURN_NOT_OK(compress(tile, candidate, &input_buffer, buffer_ptr));
+    compressed_size = buffer_ptr->size();
+  }
+
+  // Forward the existing metadata and write this filter's metadata.
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(
+      output_metadata->prepend_buffer(sizeof(uint8_t) + 2 * sizeof(uint32_t)));
+  const auto candidate_id = static_cast<uint8_t>(candidate);
+  const auto orig_size = static_cast<uint32_t>(input_size);
+  const auto compressed_size_32 = static_cast<uint32_t>(compressed_size);
+  RETURN_NOT_OK(output_metadata->write(&candidate_id, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&compressed_size_32, sizeof(uint32_t)));
+
+  return Status::Ok();
+}
+
+Status AutoCompressionFilter::pick_candidate(
+    const Tile& tile,
+    const char* data,
+    uint64_t size,
+    Candidate* candidate) const {
+  *candidate = Candidate::NONE;
+  if (size == 0)
+    return Status::Ok();
+
+  // Sample slices spread over the input, aligned to the datatype size so
+  // that delta encoding sees whole values.
+  std::vector<char> sample;
+  if (size <= max_sample_size) {
+    sample.assign(data, data + size);
+  } else {
+    const uint64_t value_size = datatype_size(tile.type());
+    for (uint64_t s = 0; s < sample_slice_num; s++) {
+      uint64_t start = s * (size / sample_slice_num);
+      start -= start % value_size;
+      sample.insert(
+          sample.end(), data + start, data + start + sample_slice_size);
+    }
+  }
+
+  // Score each candidate on the sample.
+  const bool try_delta = delta_applies(tile.type());
+  double best_score = 1.0;
+  for (uint8_t c = 1; c < candidate_num; c++) {
+    const auto cand = static_cast<Candidate>(c);
+    if (cand == Candidate::DELTA_ZSTD_FAST && !try_delta)
+      continue;
+
+    Buffer compressed;
+    RETURN_NOT_OK(
+        compressed.realloc(sample.size() + overhead(cand, sample.size())));
+    ConstBuffer sample_buffer(sample.data(), sample.size());
+    RETURN_NOT_OK(compress(tile, cand, &sample_buffer, &compressed));
+
+    const double ratio = (double)compressed.size() / sample.size();
+    const double score =
+        ratio + speed_bias_ / 100.0 * decompression_cost[c];
+    if (score < best_score) {
+      best_score = score;
+      *candidate = cand;
+    }
+  }
+
+  return Status::Ok();
+}
+
+Status AutoCompressionFilter::compress(
+    const Tile& tile,
+    Candidate candidate,
+    ConstBuffer* input,
+    Buffer* output) const {
+  switch (candidate) {
+    case Candidate::NONE:
+      return output->write(input->data(), input->size());
+    case Candidate::LZ4:
+      return LZ4::compress(LZ4::default_level(), input, output);
+    case Candidate::ZSTD_FAST:
+      return ZStd::compress(
+          zstd_fast_level, zstd_compress_ctx_pool_, input, output);
+    case Candidate::ZSTD:
+      return ZStd::compress(zstd_level, zstd_compress_ctx_pool_, input, output);
+    case Candidate::DELTA_ZSTD_FAST: {
+      std::vector<char> deltas(input->size());
+      delta_encode(
+          datatype_size(tile.type()),
+          static_cast<const char*>(input->data()),
+          input->size(),
+          deltas.data());
+      ConstBuffer delta_buffer(deltas.data(), deltas.size());
+      return ZStd::compress(
+          zstd_fast_level, zstd_compress_ctx_pool_, &delta_buffer, output);
+    }
+    default:
+      return LOG_STATUS(Status_FilterError(
+          "Auto compression filter error; unknown candidate"));
+  }
+}
+
+Status AutoCompressionFilter::run_reverse(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  (void)config;
+
+  uint8_t candidate_id;
+  uint32_t orig_size, compressed_size;
+  RETURN_NOT_OK(input_metadata->read(&candidate_id, sizeof(uint8_t)));
+  RETURN_NOT_OK(input_metadata->read(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(input_metadata->read(&compressed_size, sizeof(uint32_t)));
+  const auto candidate = static_cast<Candidate>(candidate_id);
+
+  if (candidate == Candidate::NONE) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    ConstBuffer input_buffer(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(compressed_size, &input_buffer));
+
+    RETURN_NOT_OK(output->prepend_buffer(orig_size));
+    Buffer* output_buf = output->buffer_ptr(0);
+    assert(output_buf != nullptr);
+    PreallocatedBuffer output_buffer(output_buf->cur_data(), orig_size);
+
+    switch (candidate) {
+      case Candidate::LZ4:
+        RETURN_NOT_OK(LZ4::decompress(&input_buffer, &output_buffer));
+        break;
+      case Candidate::ZSTD_FAST:
+      case Candidate::ZSTD:
+      case Candidate::DELTA_ZSTD_FAST:
+        RETURN_NOT_OK(ZStd::decompress(
+            zstd_decompress_ctx_pool_, &input_buffer, &output_buffer));
+        break;
+      default:
+        return LOG_STATUS(Status_FilterError(
+            "Auto compression filter error; unknown candidate"));
+    }
+    if (candidate == Candidate::DELTA_ZSTD_FAST) {
+      if (!delta_applies(tile.type()))
+        return LOG_STATUS(Status_FilterError(
+            "Auto compression filter error; invalid delta encoded input"));
+      delta_decode(
+          datatype_size(tile.type()),
+          static_cast<char*>(output_buf->cur_data()),
+          orig_size);
+    }
+
+    if (output_buf->owns_data())
+      output_buf->advance_size(orig_size);
+    output_buf->advance_offset(orig_size);
+    input->advance_offset(compressed_size);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+Status AutoCompressionFilter::set_option_impl(
+    FilterOption option, const void* value) {
+  if (value == nullptr)
+    return LOG_STATUS(Status_FilterError(
+        "Auto compression filter error; invalid option value"));
+
+  switch (option) {
+    case FilterOption::AUTO_COMPRESSION_SPEED_BIAS:
+      return set_speed_bias(*(uint32_t*)value);
+    default:
+      return LOG_STATUS(
+          Status_FilterError("Auto compression filter error; unknown option"));
+  }
+}
+
+Status AutoCompressionFilter::get_option_impl(
+    FilterOption option, void* value) const {
+  switch (option) {
+    case FilterOption::AUTO_COMPRESSION_SPEED_BIAS:
+      *(uint32_t*)value = speed_bias_;
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status_FilterError("Auto compression filter error; unknown option"));
+  }
+}
+
+Status AutoCompressionFilter::serialize_impl(Buffer* buff) const {
+  RETURN_NOT_OK(buff->write(&speed_bias_, sizeof(uint32_t)));
+  return Status::Ok();
+}
+
+void AutoCompressionFilter::init_compression_resource_pool(uint64_t size) {
+  std::lock_guard g(zstd_compress_ctx_pool_mtx_);
+  if (zstd_compress_ctx_pool_ == nullptr) {
+    zstd_compress_ctx_pool_ =
+        tdb::make_shared<BlockingResourcePool<ZStd::ZSTD_Compress_Context>>(
+            HERE(), size);
+  }
+}
+
+void AutoCompressionFilter::init_decompression_resource_pool(uint64_t size) {
+  std::lock_guard g(zstd_decompress_ctx_pool_mtx_);
+  if (zstd_decompress_ctx_pool_ == nullptr) {
+    zstd_decompress_ctx_pool_ =
+        tdb::make_shared<BlockingResourcePool<ZStd::ZSTD_Decompress_Context>>(
+            HERE(), size);
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,191 @@
+/**
+ * @file   auto_compression_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class AutoCompressionFilter.
+ */
+
+#ifndef TILEDB_AUTO_COMPRESSION_FILTER_H
+#define TILEDB_AUTO_COMPRESSION_FILTER_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/resource_pool.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that picks the compression of each chunk among a few candidates,
+ * for attributes whose data varies too much for one static compressor.
+ *
+ * The candidates are no compression, LZ4, ZStd at levels 1 and 9, and, for
+ * integer datatypes, delta encoding followed by ZStd at level 1. Each
+ * candidate compresses a sample of the chunk, and the candidate with the
+ * lowest score wins, where the score of a candidate is its compression ratio
+ * (compressed size over original size) plus its relative decompression cost
+ * weighted by the speed bias. A speed bias of 0 picks the best ratio, and a
+ * speed bias of 100 strongly favors the candidates that decompress faster.
+ *
+ * Input metadata is not compressed or modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - The candidate that compressed the chunk
+ *   uint32_t - Original input number of bytes
+ *   uint32_t - Compressed number of bytes
+ *
+ * The forward output data format is simply:
+ *   uint8_t[] - The compressed bytes
+ *
+ * The reverse output format is simply:
+ *   uint8_t[] - Array of uncompressed bytes
+ */
+class AutoCompressionFilter : public Filter {
+ public:
+  /** The candidate compressions. */
+  enum class Candidate : uint8_t {
+    NONE = 0,
+    LZ4 = 1,
+    ZSTD_FAST = 2,
+    ZSTD = 3,
+    DELTA_ZSTD_FAST = 4
+  };
+
+  /** Default speed bias. */
+  static constexpr uint32_t DEFAULT_SPEED_BIAS = 50;
+
+  /** Constructor. */
+  AutoCompressionFilter();
+
+  /**
+   * Constructor.
+   *
+   * @param speed_bias The weight of the decompression cost, from 0 to 100.
+   */
+  explicit AutoCompressionFilter(uint32_t speed_bias);
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Compress the given input into the given output with the best candidate.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decompress the given input into the given output.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+  /** Returns the speed bias. */
+  uint32_t speed_bias() const;
+
+  /** Sets the speed bias, from 0 to 100. */
+  Status set_speed_bias(uint32_t speed_bias);
+
+ private:
+  /** The weight of the decompression cost, from 0 to 100. */
+  uint32_t speed_bias_;
+
+  /** Mutex guarding zstd_compress_ctx_pool */
+  std::mutex zstd_compress_ctx_pool_mtx_;
+
+  /** Mutex guarding zstd_decompress_ctx_pool */
+  std::mutex zstd_decompress_ctx_pool_mtx_;
+
+  /** A resource pool to be used in ZStd compressor for improved performance */
+  shared_ptr<BlockingResourcePool<ZStd::ZSTD_Compress_Context>>
+      zstd_compress_ctx_pool_;
+
+  /** A resource pool to be used in ZStd decompressor for improved performance
+   */
+  shared_ptr<BlockingResourcePool<ZStd::ZSTD_Decompress_Context>>
+      zstd_decompress_ctx_pool_;
+
+  /** Returns a new clone of this filter. */
+  AutoCompressionFilter* clone_impl() const override;
+
+  /**
+   * Picks the candidate with the lowest score on a sample of the input.
+   *
+   * @param tile The tile of the input.
+   * @param data The input.
+   * @param size The size of the input.
+   * @param candidate Set to the picked candidate.
+   * @return Status
+   */
+  Status pick_candidate(
+      const Tile& tile,
+      const char* data,
+      uint64_t size,
+      Candidate* candidate) const;
+
+  /**
+   * Compresses the input with the given candidate into the given output,
+   * which must have room for the worst case.
+   */
+  Status compress(
+      const Tile& tile,
+      Candidate candidate,
+      ConstBuffer* input,
+      Buffer* output) const;
+
+  /** Gets an option from this filter. */
+  Status get_option_impl(FilterOption option, void* value) const override;
+
+  /** Sets an option on this filter. */
+  Status set_option_impl(FilterOption option, const void* value) override;
+
+  /** Serializes this filter's metadata to the given buffer. */
+  Status serialize_impl(Buffer* buff) const override;
+
+  /** Initializes the compression resource pool */
+  void init_compression_resource_pool(uint64_t size) override;
+
+  /** Initializes the decompression resource pool */
+  void init_decompression_resource_pool(uint64_t size) override;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_AUTO_COMPRESSION_FILTER_H
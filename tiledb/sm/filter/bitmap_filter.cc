@@ -0,0 +1,238 @@
+/**
+ * @file   bitmap_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class BitmapFilter.
+ */
+
+#include "tiledb/sm/filter/bitmap_filter.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Mask of the lowest bit of every byte of a word. */
+constexpr uint64_t low_bits = 0x0101010101010101ULL;
+
+/** Returns `true` if the filter applies to tiles of the given datatype. */
+inline bool applies_to(Datatype type) {
+  return type == Datatype::UINT8 || type == Datatype::INT8 ||
+         type == Datatype::CHAR;
+}
+
+}  // namespace
+
+BitmapFilter::BitmapFilter()
+    : Filter(FilterType::FILTER_BITMAP) {
+}
+
+BitmapFilter* BitmapFilter::clone_impl() const {
+  return tdb_new(BitmapFilter);
+}
+
+void BitmapFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "Bitmap");
+}
+
+bool BitmapFilter::pack(
+    const uint8_t* bytemap, uint64_t size, uint8_t* bitmap) {
+  // Pack eight bytes at a time: the multiplication gathers the lowest bit
+  // of every byte into the top byte of the product.
+  const uint64_t word_num = size / sizeof(uint64_t);
+  for (uint64_t w = 0; w < word_num; w++) {
+    uint64_t word;
+    std::memcpy(&word, bytemap + w * sizeof(uint64_t), sizeof(uint64_t));
+    if ((word & ~low_bits) != 0)
+      return false;
+    bitmap[w] = static_cast<uint8_t>((word * 0x0102040810204080ULL) >> 56);
+  }
+
+  // Pack the remaining bytes.
+  if (size % sizeof(uint64_t) != 0) {
+    uint8_t last = 0;
+    for (uint64_t i = word_num * sizeof(uint64_t); i < size; i++) {
+      if (bytemap[i] > 1)
+        return false;
+      last |= bytemap[i] << (i % 8);
+    }
+    bitmap[word_num] = last;
+  }
+
+  return true;
+}
+
+void BitmapFilter::unpack(
+    const uint8_t* bitmap, uint64_t size, uint8_t* bytemap) {
+  // Unpack eight bytes at a time: broadcast the bitmap byte to all the
+  // bytes of a word, keep bit `i` in byte `i` and turn it into a 0 or 1.
+  const uint64_t word_num = size / sizeof(uint64_t);
+  for (uint64_t w = 0; w < word_num; w++) {
+    uint64_t word = (bitmap[w] * low_bits) & 0x8040201008040201ULL;
+    word = (((word + 0x7F7F7F7F7F7F7F7FULL) | word) & (low_bits << 7)) >> 7;
+    std::memcpy(bytemap + w * sizeof(uint64_t), &word, sizeof(uint64_t));
+  }
+
+  // Unpack the remaining bytes.
+  for (uint64_t i = word_num * sizeof(uint64_t); i < size; i++)
+    bytemap[i] = (bitmap[i / 8] >> (i % 8)) & 1;
+}
+
+Status BitmapFilter::run_forward(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Packing can't work; just return the input unmodified.
+  if (!applies_to(tile.type())) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+    return Status::Ok();
+  }
+
+  const uint64_t input_size = input->size();
+  if (input_size == 0 || input_size > std::numeric_limits<uint32_t>::max())
+    return forward_unpacked(input_metadata, input, output_metadata, output);
+
+  // Gather the input when it comes in multiple parts.
+  std::vector<uint8_t> gathered;
+  const uint8_t* input_data = nullptr;
+  if (input->num_buffers() == 1) {
+    ConstBuffer data(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+    input_data = static_cast<const uint8_t*>(data.data());
+  } else {
+    gathered.resize(input_size);
+    RETURN_NOT_OK(input->copy_to(gathered.data()));
+    input_data = gathered.data();
+  }
+
+  // Pack the input, leaving it unmodified if it is not a byte map.
+  const uint64_t packed_size = (input_size + 7) / 8;
+  std::vector<uint8_t> packed(packed_size);
+  if (!pack(input_data, input_size, packed.data()))
+    return forward_unpacked(input_metadata, input, output_metadata, output);
+
+  // Forward the existing metadata and write this filter's metadata.
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(
+      output_metadata->prepend_buffer(sizeof(uint8_t) + sizeof(uint32_t)));
+  const uint8_t packed_flag = 1;
+  const auto orig_size = static_cast<uint32_t>(input_size);
+  RETURN_NOT_OK(output_metadata->write(&packed_flag, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&orig_size, sizeof(uint32_t)));
+
+  // Write the bitmap.
+  RETURN_NOT_OK(output->prepend_buffer(packed_size));
+  RETURN_NOT_OK(output->write(packed.data(), packed_size));
+
+  return Status::Ok();
+}
+
+Status BitmapFilter::forward_unpacked(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  const uint8_t packed_flag = 0;
+  RETURN_NOT_OK(output_metadata->write(&packed_flag, sizeof(uint8_t)));
+  return Status::Ok();
+}
+
+Status BitmapFilter::run_reverse(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  (void)config;
+
+  // Packing wasn't applied; just return the input unmodified.
+  if (!applies_to(tile.type())) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+    return Status::Ok();
+  }
+
+  uint8_t packed_flag;
+  RETURN_NOT_OK(input_metadata->read(&packed_flag, sizeof(uint8_t)));
+  if (packed_flag == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint32_t orig_size;
+    RETURN_NOT_OK(input_metadata->read(&orig_size, sizeof(uint32_t)));
+    const uint64_t packed_size = (uint64_t(orig_size) + 7) / 8;
+    if (input->size() - input->offset() < packed_size)
+      return LOG_STATUS(
+          Status_FilterError("Bitmap filter error; bitmap is truncated"));
+
+    std::vector<uint8_t> packed(packed_size);
+    RETURN_NOT_OK(input->read(packed.data(), packed_size));
+
+    RETURN_NOT_OK(output->prepend_buffer(orig_size));
+    Buffer* output_buf = output->buffer_ptr(0);
+    assert(output_buf != nullptr);
+    auto dest = static_cast<uint8_t*>(output_buf->cur_data());
+    unpack(packed.data(), orig_size, dest);
+
+    if (output_buf->owns_data())
+      output_buf->advance_size(orig_size);
+    output_buf->advance_offset(orig_size);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,126 @@
+/**
+ * @file   bitmap_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class BitmapFilter.
+ */
+
+#ifndef TILEDB_BITMAP_FILTER_H
+#define TILEDB_BITMAP_FILTER_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filter/filter.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that packs a byte map, where every byte is either 0 or 1, into a
+ * bitmap with one bit per byte. It is meant for validity tiles, which store
+ * one byte per cell, and shrinks them eight-fold before any compression.
+ *
+ * Cell `i` is stored in bit `i % 8` of byte `i / 8`. Bytes are packed and
+ * unpacked eight at a time.
+ *
+ * Inputs that are not of datatype UINT8, INT8 or CHAR, or that contain a
+ * byte other than 0 or 1, are left unmodified.
+ *
+ * Input metadata is not compressed or modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was packed
+ * followed, when packed, by:
+ *   uint32_t - Original input number of bytes
+ *
+ * The forward output data format, when packed, is:
+ *   uint8_t[] - The bitmap, of (original number of bytes + 7) / 8 bytes
+ *
+ * The reverse output format is simply:
+ *   uint8_t[] - The original byte map
+ */
+class BitmapFilter : public Filter {
+ public:
+  /** Constructor. */
+  BitmapFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Pack the given input into the given output.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Unpack the given input into the given output.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+  /**
+   * Packs the `size` bytes of `bytemap`, each 0 or 1, into `bitmap`, which
+   * must hold `(size + 7) / 8` bytes.
+   *
+   * @return `false` if `bytemap` has a byte other than 0 or 1.
+   */
+  static bool pack(const uint8_t* bytemap, uint64_t size, uint8_t* bitmap);
+
+  /**
+   * Unpacks the first `size` bits of `bitmap` into `bytemap`, which must
+   * hold `size` bytes.
+   */
+  static void unpack(const uint8_t* bitmap, uint64_t size, uint8_t* bytemap);
+
+ private:
+  /** Returns a new clone of this filter. */
+  BitmapFilter* clone_impl() const override;
+
+  /** Forwards the input unmodified, marking it as not packed. */
+  Status forward_unpacked(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BITMAP_FILTER_H
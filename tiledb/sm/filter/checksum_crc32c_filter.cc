@@ -0,0 +1,331 @@
+/**
+ * @file   checksum_crc32c_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ChecksumCRC32CFilter.
+ */
+
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
+#include "tiledb/common/heap_memory.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <sstream>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define TILEDB_CRC32C_SSE42
+#include <nmmintrin.h>
+#elif defined(_M_X64)
+#define TILEDB_CRC32C_SSE42
+#include <intrin.h>
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define TILEDB_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The reflected CRC32C (Castagnoli) polynomial. */
+constexpr uint32_t crc32c_poly = 0x82F63B78;
+
+/** Lookup tables to process 8 bytes at a time in software. */
+struct CRC32CTables {
+  uint32_t table[8][256];
+
+  CRC32CTables() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; j++)
+        crc = (crc >> 1) ^ ((crc & 1) ? crc32c_poly : 0);
+      table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (int k = 1; k < 8; k++) {
+        const uint32_t prev = table[k - 1][i];
+        table[k][i] = (prev >> 8) ^ table[0][prev & 0xff];
+      }
+    }
+  }
+};
+
+/** Computes the CRC32C of the input in software, 8 bytes at a time. */
+uint32_t crc32c_sw(uint32_t crc, const uint8_t* data, uint64_t size) {
+  static const CRC32CTables tables;
+  const auto& t = tables.table;
+  for (; size >= 8; size -= 8, data += 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    word ^= crc;
+    crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^
+          t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff] ^
+          t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^
+          t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+  }
+  for (; size > 0; size--, data++)
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+  return crc;
+}
+
+#if defined(TILEDB_CRC32C_SSE42)
+
+/** Returns true if the CPU supports the SSE4.2 CRC32 instructions. */
+bool has_hw_crc32c() {
+#if defined(_M_X64)
+  static const bool supported = []() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+  }();
+#else
+  static const bool supported = __builtin_cpu_supports("sse4.2");
+#endif
+  return supported;
+}
+
+/** Computes the CRC32C of the input with the SSE4.2 CRC32 instructions. */
+#if !defined(_M_X64)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t
+crc32c_hw(uint32_t crc, const uint8_t* data, uint64_t size) {
+#if defined(__x86_64__) || defined(_M_X64)
+  uint64_t crc64 = crc;
+  for (; size >= 8; size -= 8, data += 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  for (; size >= 4; size -= 4, data += 4) {
+    uint32_t word;
+    std::memcpy(&word, data, sizeof(uint32_t));
+    crc = _mm_crc32_u32(crc, word);
+  }
+  for (; size > 0; size--, data++)
+    crc = _mm_crc32_u8(crc, *data);
+  return crc;
+}
+
+#elif defined(TILEDB_CRC32C_ARM)
+
+/** The CRC32 instructions are always available when they are enabled. */
+bool has_hw_crc32c() {
+  return true;
+}
+
+/** Computes the CRC32C of the input with the ARMv8 CRC32 instructions. */
+uint32_t crc32c_hw(uint32_t crc, const uint8_t* data, uint64_t size) {
+  for (; size >= 8; size -= 8, data += 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    crc = __crc32cd(crc, word);
+  }
+  for (; size > 0; size--, data++)
+    crc = __crc32cb(crc, *data);
+  return crc;
+}
+
+#endif
+
+}  // namespace
+
+ChecksumCRC32CFilter::ChecksumCRC32CFilter()
+    : Filter(FilterType::FILTER_CHECKSUM_CRC32C) {
+}
+
+ChecksumCRC32CFilter* ChecksumCRC32CFilter::clone_impl() const {
+  return tdb_new(ChecksumCRC32CFilter);
+}
+
+void ChecksumCRC32CFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+
+  fprintf(out, "ChecksumCRC32C");
+}
+
+uint32_t ChecksumCRC32CFilter::crc32c(
+    uint32_t crc, const void* data, uint64_t size) {
+  const auto bytes = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+#if defined(TILEDB_CRC32C_SSE42) || defined(TILEDB_CRC32C_ARM)
+  if (has_hw_crc32c())
+    return ~crc32c_hw(crc, bytes, size);
+#endif
+  return ~crc32c_sw(crc, bytes, size);
+}
+
+Status ChecksumCRC32CFilter::run_forward(
+    const Tile&,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Set output buffer to input buffer
+  RETURN_NOT_OK(output->append_view(input));
+  // Add original input metadata as a view to the output metadata
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+
+  // Compute and write the metadata
+  std::vector<ConstBuffer> data_parts = input->buffers(),
+                           metadata_parts = input_metadata->buffers();
+  auto num_data_parts = (uint32_t)data_parts.size();
+  auto num_metadata_parts = (uint32_t)metadata_parts.size();
+  auto total_num_parts = num_data_parts + num_metadata_parts;
+
+  uint32_t part_md_size = CRC32C_BYTES + sizeof(uint64_t);
+  uint32_t metadata_size =
+      (total_num_parts * part_md_size) + (2 * sizeof(uint32_t));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(metadata_size));
+  RETURN_NOT_OK(output_metadata->write(&num_metadata_parts, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&num_data_parts, sizeof(uint32_t)));
+
+  // Checksum all parts
+  for (auto& part : metadata_parts)
+    RETURN_NOT_OK(checksum_part(&part, output_metadata));
+  for (auto& part : data_parts)
+    RETURN_NOT_OK(checksum_part(&part, output_metadata));
+
+  return Status::Ok();
+}
+
+Status ChecksumCRC32CFilter::run_reverse(
+    const Tile&,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  // Fetch the skip checksum configuration parameter.
+  bool found;
+  bool skip_validation;
+  RETURN_NOT_OK(config.get<bool>(
+      "sm.skip_checksum_validation", &skip_validation, &found));
+  assert(found);
+
+  // Set output buffer to input buffer
+  RETURN_NOT_OK(output->append_view(input));
+
+  // Read the number of parts from input metadata.
+  uint32_t num_metadata_parts, num_data_parts;
+  RETURN_NOT_OK(input_metadata->read(&num_metadata_parts, sizeof(uint32_t)));
+  RETURN_NOT_OK(input_metadata->read(&num_data_parts, sizeof(uint32_t)));
+
+  // Read the pairs of sizes and checksums.
+  std::vector<std::pair<uint64_t, uint32_t>> metadata_checksums(
+      num_metadata_parts);
+  std::vector<std::pair<uint64_t, uint32_t>> data_checksums(num_data_parts);
+  for (auto& checksum : metadata_checksums) {
+    RETURN_NOT_OK(input_metadata->read(&checksum.first, sizeof(uint64_t)));
+    RETURN_NOT_OK(input_metadata->read(&checksum.second, CRC32C_BYTES));
+  }
+  for (auto& checksum : data_checksums) {
+    RETURN_NOT_OK(input_metadata->read(&checksum.first, sizeof(uint64_t)));
+    RETURN_NOT_OK(input_metadata->read(&checksum.second, CRC32C_BYTES));
+  }
+
+  // Only run checksums if we are not set to skip
+  if (!skip_validation) {
+    // Save the metadata offset, as checking the metadata moves it.
+    uint64_t offset_before_checksum = input_metadata->offset();
+    for (const auto& checksum : metadata_checksums) {
+      RETURN_NOT_OK(compare_checksum_part(
+          input_metadata, checksum.first, checksum.second));
+    }
+    if (input_metadata->offset() != offset_before_checksum) {
+      input_metadata->set_offset(offset_before_checksum);
+    }
+
+    for (const auto& checksum : data_checksums) {
+      RETURN_NOT_OK(
+          compare_checksum_part(input, checksum.first, checksum.second));
+    }
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+Status ChecksumCRC32CFilter::checksum_part(
+    ConstBuffer* part, FilterBuffer* output_metadata) const {
+  const uint32_t checksum = crc32c(0, part->data(), part->size());
+
+  // Write metadata.
+  uint64_t part_size = part->size();
+  RETURN_NOT_OK(output_metadata->write(&part_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_metadata->write(&checksum, CRC32C_BYTES));
+
+  return Status::Ok();
+}
+
+Status ChecksumCRC32CFilter::compare_checksum_part(
+    FilterBuffer* part, uint64_t bytes_to_compare, uint32_t checksum) const {
+  // Checksum a view on the bytes when they are contiguous, otherwise copy
+  // them out of the underlying buffers.
+  uint32_t computed = 0;
+  ConstBuffer view(nullptr, 0);
+  if (bytes_to_compare == 0) {
+    computed = crc32c(0, nullptr, 0);
+  } else if (part->get_const_buffer(bytes_to_compare, &view).ok()) {
+    computed = crc32c(0, view.data(), bytes_to_compare);
+    part->advance_offset(bytes_to_compare);
+  } else {
+    Buffer buffer;
+    RETURN_NOT_OK(buffer.realloc(bytes_to_compare));
+    RETURN_NOT_OK(part->read(buffer.data(), bytes_to_compare));
+    computed = crc32c(0, buffer.data(), bytes_to_compare);
+  }
+
+  if (computed != checksum) {
+    std::stringstream message;
+    message << "Checksum mismatch for crc32c filter, expect " << std::hex
+            << checksum << " got " << computed;
+    return Status_ChecksumError(message.str());
+  }
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
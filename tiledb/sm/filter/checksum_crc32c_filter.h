@@ -0,0 +1,146 @@
+/**
+ * @file   checksum_crc32c_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class ChecksumCRC32CFilter.
+ */
+
+#ifndef TILEDB_CHECKSUM_CRC32C_FILTER_H
+#define TILEDB_CHECKSUM_CRC32C_FILTER_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filter/filter.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that computes a CRC32C (Castagnoli) checksum of the input data.
+ * Unlike the MD5 and SHA256 checksum filters, it is not a cryptographic
+ * hash: it detects corruption at a fraction of the cost, using the CRC32
+ * instructions of the CPU when they are available.
+ *
+ * If the input comes in multiple FilterBuffer parts, each part is checksummed
+ * independently in the forward direction. Input metadata is checksummed as
+ * well.
+ *
+ * The forward output metadata has the format:
+ *   uint32_t - number of metadata checksums
+ *   uint32_t - number of data checksums
+ *   metadata_checksum_part0
+ *   ...
+ *   metadata_checksum_partN
+ *   data_checksum_part0
+ *   ...
+ *   data_checksum_partN
+ *   input_metadata
+ *
+ * Where checksum_part is
+ *   uint64_t - size of the part that the checksum is computed over
+ *   uint32_t - checksum
+ *
+ * The forward output data format is just the input bytes forwarded untouched.
+ *
+ * The reverse output data format is simply:
+ *   uint8_t[] - Original input data
+ */
+class ChecksumCRC32CFilter : public Filter {
+ public:
+  /** Size of a checksum. */
+  static const unsigned CRC32C_BYTES = sizeof(uint32_t);
+
+  /**
+   * Constructor.
+   */
+  ChecksumCRC32CFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Checksum the bytes of the input data into the output metadata.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Verify the checksums of the bytes of the input data.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+  /**
+   * Extends a CRC32C checksum with the given bytes.
+   *
+   * @param crc The checksum of the preceding bytes, 0 for the first bytes.
+   * @param data The bytes to checksum.
+   * @param size The number of bytes.
+   * @return The checksum of the preceding bytes followed by `data`.
+   */
+  static uint32_t crc32c(uint32_t crc, const void* data, uint64_t size);
+
+ private:
+  /** Returns a new clone of this filter. */
+  ChecksumCRC32CFilter* clone_impl() const override;
+
+  /**
+   * Compares a passed checksum to a computed on for the part passed
+   *
+   * @param part Plaintext to checksum
+   * @param bytes_to_compare size of bytes to checksum
+   * @param checksum checksum to compare against
+   * @return Status
+   */
+  Status compare_checksum_part(
+      FilterBuffer* part, uint64_t bytes_to_compare, uint32_t checksum) const;
+
+  /**
+   * Compute and store the checksum
+   *
+   * @param part Plaintext to checksum
+   * @param output_metadata Metadata to store checksum in
+   * @return Status
+   */
+  Status checksum_part(ConstBuffer* part, FilterBuffer* output_metadata) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_CHECKSUM_CRC32C_FILTER_H
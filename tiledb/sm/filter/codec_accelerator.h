@@ -0,0 +1,132 @@
+/**
+ * @file codec_accelerator.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class CodecAccelerator, the interface of the
+ * accelerator backends compression filters can offload their chunks to.
+ */
+
+#ifndef TILEDB_CODEC_ACCELERATOR_H
+#define TILEDB_CODEC_ACCELERATOR_H
+
+#include <future>
+#include <vector>
+
+#include "tiledb/sm/enums/compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+
+namespace tiledb::sm {
+
+/**
+ * An accelerator backend, such as a QAT card or a GPU, that compresses and
+ * decompresses the parts of CompressionFilter chunks.
+ *
+ * Backends are registered with `FilterCreate::register_accelerator`, which
+ * attaches them to the compression filters made or deserialized afterwards.
+ * When such a filter is the last filter of a pipeline, the pipeline submits
+ * the parts of all the chunks of a tile as one batch rather than one chunk
+ * at a time, and the parts the backend does not complete are compressed or
+ * decompressed on the CPU instead.
+ *
+ * A backend must read and write the format of the CPU compressor, so that
+ * the data stays readable without the accelerator.
+ */
+class CodecAccelerator {
+ public:
+  /** The settings shared by all the parts of a batch. */
+  struct Codec {
+    /** The compressor. */
+    Compressor compressor_;
+
+    /** The compression level. */
+    int level_;
+
+    /** The datatype of the tile, for the compressors that use it. */
+    Datatype type_;
+
+    /** The cell size of the tile, for the compressors that use it. */
+    uint64_t cell_size_;
+
+    /** The format version of the tile. */
+    uint32_t format_version_;
+  };
+
+  /** A part to compress or decompress. */
+  struct Job {
+    /** The input bytes. */
+    const void* input_;
+
+    /** The size of the input. */
+    uint64_t input_size_;
+
+    /** The output buffer. */
+    void* output_;
+
+    /**
+     * The size of the output buffer. When decompressing, this is the exact
+     * size of the decompressed part. When compressing, it is an upper bound
+     * which the backend replaces with the size of the compressed part.
+     */
+    uint64_t output_size_;
+
+    /** Set by the backend once it completed the part successfully. */
+    bool done_;
+  };
+
+  /** Destructor. */
+  virtual ~CodecAccelerator() = default;
+
+  /** Returns true if the backend handles the parts of the given codec. */
+  virtual bool claims(Compressor compressor, int level) const = 0;
+
+  /**
+   * Starts compressing a batch of parts. The jobs and their buffers stay
+   * valid until the returned future is ready. A backend may leave some of
+   * the jobs undone, for instance when its queue is full.
+   *
+   * @param codec The settings of the parts.
+   * @param jobs The parts to compress.
+   * @return A future that is ready once the backend is done with the batch.
+   */
+  virtual std::future<void> compress(
+      const Codec& codec, std::vector<Job>& jobs) = 0;
+
+  /**
+   * Starts decompressing a batch of parts, as `compress`.
+   *
+   * @param codec The settings of the parts.
+   * @param jobs The parts to decompress.
+   * @return A future that is ready once the backend is done with the batch.
+   */
+  virtual std::future<void> decompress(
+      const Codec& codec, std::vector<Job>& jobs) = 0;
+};
+
+}  // namespace tiledb::sm
+
+#endif  // TILEDB_CODEC_ACCELERATOR_H
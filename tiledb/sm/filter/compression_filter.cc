@@ -45,6 +45,7 @@
 #include "tiledb/sm/enums/filter_option.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/tile/tile.h"
 
@@ -58,7 +59,10 @@ CompressionFilter::CompressionFilter(FilterType compressor, int level)
     , compressor_(filter_to_compressor(compressor))
     , level_(level)
     , zstd_compress_ctx_pool_(nullptr)
-    , zstd_decompress_ctx_pool_(nullptr) {
+    , zstd_decompress_ctx_pool_(nullptr)
+    , zstd_dictionary_(tdb::make_shared<std::vector<uint8_t>>(HERE()))
+    , zstd_compression_dictionary_(nullptr, ZSTD_freeCDict)
+    , zstd_decompression_dictionary_(nullptr, ZSTD_freeDDict) {
 }
 
 CompressionFilter::CompressionFilter(Compressor compressor, int level)
@@ -66,7 +70,10 @@ CompressionFilter::CompressionFilter(Compressor compressor, int level)
     , compressor_(compressor)
     , level_(level)
     , zstd_compress_ctx_pool_(nullptr)
-    , zstd_decompress_ctx_pool_(nullptr) {
+    , zstd_decompress_ctx_pool_(nullptr)
+    , zstd_dictionary_(tdb::make_shared<std::vector<uint8_t>>(HERE()))
+    , zstd_compression_dictionary_(nullptr, ZSTD_freeCDict)
+    , zstd_decompression_dictionary_(nullptr, ZSTD_freeDDict) {
 }
 
 Compressor CompressionFilter::compressor() const {
@@ -109,10 +116,15 @@ void CompressionFilter::dump(FILE* out) const {
   }
 
   fprintf(out, "%s: COMPRESSION_LEVEL=%i", compressor_str.c_str(), level_);
+  if (!zstd_dictionary_->empty())
+    fprintf(out, ", DICTIONARY_SIZE=%zu", zstd_dictionary_->size());
 }
 
 CompressionFilter* CompressionFilter::clone_impl() const {
-  return tdb_new(CompressionFilter, compressor_, level_);
+  auto clone = tdb_new(CompressionFilter, compressor_, level_);
+  clone->zstd_dictionary_ = zstd_dictionary_;
+  clone->accelerator_ = accelerator_;
+  return clone;
 }
 
 void CompressionFilter::set_compressor(Compressor compressor) {
@@ -122,6 +134,54 @@ void CompressionFilter::set_compressor(Compressor compressor) {
 
 void CompressionFilter::set_compression_level(int compressor_level) {
   level_ = compressor_level;
+
+  // The compression dictionary is digested for the level.
+  std::lock_guard g(zstd_dictionary_mtx_);
+  zstd_compression_dictionary_.reset();
+}
+
+Status CompressionFilter::set_zstd_dictionary(
+    const std::vector<uint8_t>& dictionary) {
+  if (compressor_ != Compressor::ZSTD && !dictionary.empty())
+    return LOG_STATUS(Status_FilterError(
+        "Compression filter error; dictionaries require the ZStd compressor"));
+
+  std::lock_guard g(zstd_dictionary_mtx_);
+  zstd_dictionary_ =
+      tdb::make_shared<std::vector<uint8_t>>(HERE(), dictionary);
+  zstd_compression_dictionary_.reset();
+  zstd_decompression_dictionary_.reset();
+  return Status::Ok();
+}
+
+Status CompressionFilter::train_zstd_dictionary(
+    const std::vector<ConstBuffer>& samples, uint64_t max_size) {
+  if (compressor_ != Compressor::ZSTD)
+    return LOG_STATUS(Status_FilterError(
+        "Compression filter error; dictionaries require the ZStd compressor"));
+
+  std::vector<uint8_t> dictionary;
+  RETURN_NOT_OK(ZStd::train_dictionary(samples, max_size, &dictionary));
+  return set_zstd_dictionary(dictionary);
+}
+
+const std::vector<uint8_t>& CompressionFilter::zstd_dictionary() const {
+  return *zstd_dictionary_;
+}
+
+void CompressionFilter::set_accelerator(
+    const shared_ptr<CodecAccelerator>& accelerator) {
+  accelerator_ = accelerator;
+}
+
+const shared_ptr<CodecAccelerator>& CompressionFilter::accelerator() const {
+  return accelerator_;
+}
+
+bool CompressionFilter::offloads() const {
+  return accelerator_ != nullptr &&
+         compressor_ != Compressor::NO_COMPRESSION &&
+         zstd_dictionary_->empty() && accelerator_->claims(compressor_, level_);
 }
 
 FilterType CompressionFilter::compressor_to_filter(Compressor compressor) {
@@ -176,7 +236,7 @@ Status CompressionFilter::set_option_impl(
 
   switch (option) {
     case FilterOption::COMPRESSION_LEVEL:
-      level_ = *(int*)value;
+      set_compression_level(*(int*)value);
       return Status::Ok();
     default:
       return LOG_STATUS(
@@ -293,34 +353,9 @@ Status CompressionFilter::compress_part(
   // Create const buffer
   ConstBuffer input_buffer(part->data(), part->size());
 
-  auto cell_size = tile.cell_size();
-  auto type = tile.type();
-
   // Invoke the proper compressor
   uint32_t orig_size = (uint32_t)output->size();
-  switch (compressor_) {
-    case Compressor::GZIP:
-      RETURN_NOT_OK(GZip::compress(level_, &input_buffer, output));
-      break;
-    case Compressor::ZSTD:
-      RETURN_NOT_OK(ZStd::compress(
-          level_, zstd_compress_ctx_pool_, &input_buffer, output));
-      break;
-    case Compressor::LZ4:
-      RETURN_NOT_OK(LZ4::compress(level_, &input_buffer, output));
-      break;
-    case Compressor::RLE:
-      RETURN_NOT_OK(RLE::compress(cell_size, &input_buffer, output));
-      break;
-    case Compressor::BZIP2:
-      RETURN_NOT_OK(BZip::compress(level_, &input_buffer, output));
-      break;
-    case Compressor::DOUBLE_DELTA:
-      RETURN_NOT_OK(DoubleDelta::compress(type, &input_buffer, output));
-      break;
-    default:
-      assert(0);
-  }
+  RETURN_NOT_OK(compress_buffer(tile, &input_buffer, output));
 
   if (output->size() > std::numeric_limits<uint32_t>::max())
     return LOG_STATUS(
@@ -335,14 +370,42 @@ Status CompressionFilter::compress_part(
   return Status::Ok();
 }
 
+Status CompressionFilter::compress_buffer(
+    const Tile& tile, ConstBuffer* input, Buffer* output) const {
+  auto cell_size = tile.cell_size();
+  auto type = tile.type();
+
+  switch (compressor_) {
+    case Compressor::GZIP:
+      return GZip::compress(level_, input, output);
+    case Compressor::ZSTD:
+      return ZStd::compress(
+          level_,
+          zstd_compress_ctx_pool_,
+          zstd_compression_dictionary_.get(),
+          input,
+          output);
+    case Compressor::LZ4:
+      return LZ4::compress(level_, input, output);
+    case Compressor::RLE:
+      return RLE::compress(cell_size, input, output);
+    case Compressor::BZIP2:
+      return BZip::compress(level_, input, output);
+    case Compressor::DOUBLE_DELTA:
+      // The block format is only readable from format version 12 onwards
+      return DoubleDelta::compress(
+          type, input, output, tile.format_version() >= 12);
+    default:
+      assert(0);
+      return Status::Ok();
+  }
+}
+
 Status CompressionFilter::decompress_part(
     const Tile& tile,
     FilterBuffer* input,
     Buffer* output,
     FilterBuffer* input_metadata) const {
-  auto cell_size = tile.cell_size();
-  auto type = tile.type();
-
   // Read the part metadata
   uint32_t compressed_size, uncompressed_size;
   RETURN_NOT_OK(input_metadata->read(&uncompressed_size, sizeof(uint32_t)));
@@ -362,38 +425,237 @@ Status CompressionFilter::decompress_part(
   PreallocatedBuffer output_buffer(output->cur_data(), uncompressed_size);
 
   // Invoke the proper decompressor
-  Status st = Status::Ok();
+  Status st = decompress_buffer(tile, &input_buffer, &output_buffer);
+
+  if (output->owns_data())
+    output->advance_size(uncompressed_size);
+  output->advance_offset(uncompressed_size);
+  input->advance_offset(compressed_size);
+
+  return st;
+}
+
+Status CompressionFilter::decompress_buffer(
+    const Tile& tile, ConstBuffer* input, PreallocatedBuffer* output) const {
+  auto cell_size = tile.cell_size();
+  auto type = tile.type();
+
   switch (compressor_) {
     case Compressor::NO_COMPRESSION:
       assert(0);
-      break;
+      return Status::Ok();
     case Compressor::GZIP:
-      st = GZip::decompress(&input_buffer, &output_buffer);
-      break;
+      return GZip::decompress(input, output);
     case Compressor::ZSTD:
-      st = ZStd::decompress(
-          zstd_decompress_ctx_pool_, &input_buffer, &output_buffer);
-      break;
+      return ZStd::decompress(
+          zstd_decompress_ctx_pool_,
+          zstd_decompression_dictionary_.get(),
+          input,
+          output);
     case Compressor::LZ4:
-      st = LZ4::decompress(&input_buffer, &output_buffer);
-      break;
+      return LZ4::decompress(input, output);
     case Compressor::RLE:
-      st = RLE::decompress(cell_size, &input_buffer, &output_buffer);
-      break;
+      return RLE::decompress(cell_size, input, output);
     case Compressor::BZIP2:
-      st = BZip::decompress(&input_buffer, &output_buffer);
-      break;
+      return BZip::decompress(input, output);
     case Compressor::DOUBLE_DELTA:
-      st = DoubleDelta::decompress(type, &input_buffer, &output_buffer);
-      break;
+      return DoubleDelta::decompress(type, input, output);
   }
 
-  if (output->owns_data())
-    output->advance_size(uncompressed_size);
-  output->advance_offset(uncompressed_size);
-  input->advance_offset(compressed_size);
+  return Status::Ok();
+}
 
-  return st;
+Status CompressionFilter::run_forward_batch(
+    const Tile& tile,
+    const std::vector<FilterBuffer*>& input_metadata,
+    const std::vector<FilterBuffer*>& input,
+    const std::vector<FilterBuffer*>& output_metadata,
+    const std::vector<FilterBuffer*>& output,
+    ThreadPool* const compute_tp) const {
+  // Each part is compressed into its own slot of the output of its chunk,
+  // sized for the worst case. The slots are packed once the batch is done.
+  std::vector<CodecAccelerator::Job> jobs;
+  std::vector<uint32_t> part_nums(input.size());
+  for (size_t c = 0; c < input.size(); c++) {
+    if (input[c]->size() > std::numeric_limits<uint32_t>::max())
+      return LOG_STATUS(
+          Status_FilterError("Input is too large to be compressed."));
+
+    std::vector<ConstBuffer> parts = input_metadata[c]->buffers();
+    auto num_metadata_parts = (uint32_t)parts.size();
+    for (const auto& part : input[c]->buffers())
+      parts.emplace_back(part);
+    auto num_data_parts = (uint32_t)parts.size() - num_metadata_parts;
+    part_nums[c] = (uint32_t)parts.size();
+
+    uint64_t output_size_ub = 0;
+    for (const auto& part : parts)
+      output_size_ub += part.size() + overhead(tile, part.size());
+    RETURN_NOT_OK(output[c]->prepend_buffer(output_size_ub));
+    Buffer* buffer_ptr = output[c]->buffer_ptr(0);
+    assert(buffer_ptr != nullptr);
+    buffer_ptr->reset_offset();
+
+    auto metadata_size =
+        2 * sizeof(uint32_t) + parts.size() * 2 * sizeof(uint32_t);
+    RETURN_NOT_OK(output_metadata[c]->prepend_buffer(metadata_size));
+    RETURN_NOT_OK(
+        output_metadata[c]->write(&num_metadata_parts, sizeof(uint32_t)));
+    RETURN_NOT_OK(output_metadata[c]->write(&num_data_parts, sizeof(uint32_t)));
+
+    uint64_t slot_offset = 0;
+    for (const auto& part : parts) {
+      const uint64_t slot_size = part.size() + overhead(tile, part.size());
+      jobs.push_back(
+          {part.data(),
+           part.size(),
+           static_cast<char*>(buffer_ptr->data()) + slot_offset,
+           slot_size,
+           false});
+      slot_offset += slot_size;
+    }
+  }
+
+  RETURN_NOT_OK(run_batch(tile, true, jobs, compute_tp));
+
+  // Pack the compressed parts and write their sizes to the metadata.
+  auto job = jobs.begin();
+  for (size_t c = 0; c < input.size(); c++) {
+    Buffer* buffer_ptr = output[c]->buffer_ptr(0);
+    auto data = static_cast<char*>(buffer_ptr->data());
+    uint64_t size = 0;
+    for (uint32_t p = 0; p < part_nums[c]; p++, job++) {
+      std::memmove(data + size, job->output_, job->output_size_);
+      size += job->output_size_;
+      if (size > std::numeric_limits<uint32_t>::max())
+        return LOG_STATUS(
+            Status_FilterError("Compressed output exceeds uint32 max."));
+
+      uint32_t input_size = (uint32_t)job->input_size_,
+               compressed_size = (uint32_t)job->output_size_;
+      RETURN_NOT_OK(output_metadata[c]->write(&input_size, sizeof(uint32_t)));
+      RETURN_NOT_OK(
+          output_metadata[c]->write(&compressed_size, sizeof(uint32_t)));
+    }
+    buffer_ptr->advance_size(size);
+  }
+
+  return Status::Ok();
+}
+
+Status CompressionFilter::run_reverse_batch(
+    const Tile& tile,
+    const std::vector<FilterBuffer*>& input_metadata,
+    const std::vector<FilterBuffer*>& input,
+    const std::vector<FilterBuffer*>& output_metadata,
+    const std::vector<FilterBuffer*>& output,
+    ThreadPool* const compute_tp) const {
+  std::vector<CodecAccelerator::Job> jobs;
+  for (size_t c = 0; c < input.size(); c++) {
+    // Read the number of parts and their sizes.
+    uint32_t num_metadata_parts, num_data_parts;
+    RETURN_NOT_OK(
+        input_metadata[c]->read(&num_metadata_parts, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata[c]->read(&num_data_parts, sizeof(uint32_t)));
+    std::vector<std::pair<uint32_t, uint32_t>> part_sizes(
+        num_metadata_parts + num_data_parts);
+    uint64_t metadata_size = 0, data_size = 0;
+    for (uint32_t p = 0; p < part_sizes.size(); p++) {
+      auto& [uncompressed_size, compressed_size] = part_sizes[p];
+      RETURN_NOT_OK(
+          input_metadata[c]->read(&uncompressed_size, sizeof(uint32_t)));
+      RETURN_NOT_OK(
+          input_metadata[c]->read(&compressed_size, sizeof(uint32_t)));
+      (p < num_metadata_parts ? metadata_size : data_size) +=
+          uncompressed_size;
+    }
+
+    // Get the output buffers, with the space for all the parts so that the
+    // jobs point to stable memory.
+    RETURN_NOT_OK(output[c]->prepend_buffer(0));
+    Buffer* data_buffer = output[c]->buffer_ptr(0);
+    assert(data_buffer != nullptr);
+    RETURN_NOT_OK(output_metadata[c]->prepend_buffer(0));
+    Buffer* metadata_buffer = output_metadata[c]->buffer_ptr(0);
+    assert(metadata_buffer != nullptr);
+    for (auto [buffer, size] :
+         {std::make_pair(metadata_buffer, metadata_size),
+          std::make_pair(data_buffer, data_size)}) {
+      if (size == 0) {
+        continue;
+      } else if (buffer->owns_data()) {
+        RETURN_NOT_OK(buffer->realloc(buffer->alloced_size() + size));
+      } else if (buffer->offset() + size > buffer->size()) {
+        return LOG_STATUS(Status_FilterError(
+            "CompressionFilter error; output buffer too small."));
+      }
+    }
+
+    for (uint32_t p = 0; p < part_sizes.size(); p++) {
+      const auto [uncompressed_size, compressed_size] = part_sizes[p];
+      Buffer* buffer = p < num_metadata_parts ? metadata_buffer : data_buffer;
+
+      ConstBuffer input_buffer(nullptr, 0);
+      RETURN_NOT_OK(input[c]->get_const_buffer(compressed_size, &input_buffer));
+      input[c]->advance_offset(compressed_size);
+
+      jobs.push_back(
+          {input_buffer.data(),
+           compressed_size,
+           buffer->cur_data(),
+           uncompressed_size,
+           false});
+      if (buffer->owns_data())
+        buffer->advance_size(uncompressed_size);
+      buffer->advance_offset(uncompressed_size);
+    }
+  }
+
+  return run_batch(tile, false, jobs, compute_tp);
+}
+
+Status CompressionFilter::run_batch(
+    const Tile& tile,
+    const bool compress,
+    std::vector<CodecAccelerator::Job>& jobs,
+    ThreadPool* const compute_tp) const {
+  if (jobs.empty())
+    return Status::Ok();
+
+  const CodecAccelerator::Codec codec = {compressor_,
+                                         level_,
+                                         tile.type(),
+                                         tile.cell_size(),
+                                         tile.format_version()};
+  std::future<void> batch = compress ? accelerator_->compress(codec, jobs) :
+                                       accelerator_->decompress(codec, jobs);
+  if (batch.valid())
+    batch.wait();
+
+  // Fall back to the CPU for the parts the accelerator did not complete.
+  std::vector<CodecAccelerator::Job*> undone;
+  for (auto& job : jobs) {
+    if (!job.done_)
+      undone.emplace_back(&job);
+  }
+
+  return parallel_for(compute_tp, 0, undone.size(), [&](uint64_t i) {
+    auto job = undone[i];
+    ConstBuffer input_buffer(job->input_, job->input_size_);
+    if (!compress) {
+      PreallocatedBuffer output_buffer(job->output_, job->output_size_);
+      return decompress_buffer(tile, &input_buffer, &output_buffer);
+    }
+
+    Buffer output_buffer;
+    RETURN_NOT_OK(compress_buffer(tile, &input_buffer, &output_buffer));
+    if (output_buffer.size() > job->output_size_)
+      return LOG_STATUS(Status_FilterError(
+          "CompressionFilter error; compressed part exceeds its bound."));
+    std::memcpy(job->output_, output_buffer.data(), output_buffer.size());
+    job->output_size_ = output_buffer.size();
+    return Status::Ok();
+  });
 }
 
 uint64_t CompressionFilter::overhead(const Tile& tile, uint64_t nbytes) const {
@@ -426,6 +688,14 @@ Status CompressionFilter::serialize_impl(Buffer* buff) const {
   RETURN_NOT_OK(buff->write(&compressor_char, sizeof(uint8_t)));
   RETURN_NOT_OK(buff->write(&level_, sizeof(int32_t)));
 
+  // The ZStd dictionary follows, if any.
+  if (compressor_ == Compressor::ZSTD && !zstd_dictionary_->empty()) {
+    auto dictionary_size = static_cast<uint32_t>(zstd_dictionary_->size());
+    RETURN_NOT_OK(buff->write(&dictionary_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(
+        buff->write(zstd_dictionary_->data(), zstd_dictionary_->size()));
+  }
+
   return Status::Ok();
 }
 
@@ -436,6 +706,14 @@ void CompressionFilter::init_compression_resource_pool(uint64_t size) {
         tdb::make_shared<BlockingResourcePool<ZStd::ZSTD_Compress_Context>>(
             HERE(), size);
   }
+
+  // Digest the dictionary once for all parts.
+  std::lock_guard dg(zstd_dictionary_mtx_);
+  if (compressor_ == Compressor::ZSTD && !zstd_dictionary_->empty() &&
+      zstd_compression_dictionary_ == nullptr) {
+    zstd_compression_dictionary_ =
+        ZStd::create_compression_dictionary(*zstd_dictionary_, level_);
+  }
 }
 
 void CompressionFilter::init_decompression_resource_pool(uint64_t size) {
@@ -445,6 +723,14 @@ void CompressionFilter::init_decompression_resource_pool(uint64_t size) {
         tdb::make_shared<BlockingResourcePool<ZStd::ZSTD_Decompress_Context>>(
             HERE(), size);
   }
+
+  // Digest the dictionary once for all parts.
+  std::lock_guard dg(zstd_dictionary_mtx_);
+  if (compressor_ == Compressor::ZSTD && !zstd_dictionary_->empty() &&
+      zstd_decompression_dictionary_ == nullptr) {
+    zstd_decompression_dictionary_ =
+        ZStd::create_decompression_dictionary(*zstd_dictionary_);
+  }
 }
 
 }  // namespace sm
@@ -34,10 +34,14 @@
 #define TILEDB_COMPRESSION_FILTER_H
 
 #include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/filter/codec_accelerator.h"
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/misc/resource_pool.h"
 
+#include <vector>
+
 using namespace tiledb::common;
 
 namespace tiledb {
@@ -74,6 +78,15 @@ enum class Compressor : uint8_t;
  *
  * The reverse (decompress) output format is simply:
  *   uint8_t[] - Array of uncompressed bytes
+ *
+ * A ZStd compression filter may have a dictionary, trained on sample data
+ * with `train_zstd_dictionary`. The dictionary is serialized with the filter
+ * and used to compress and decompress every part, which helps the compression
+ * of small tiles.
+ *
+ * A compression filter may offload its parts to a CodecAccelerator, in
+ * batches spanning all the chunks of a tile (see `run_forward_batch` and
+ * `run_reverse_batch`).
  */
 class CompressionFilter : public Filter {
  public:
@@ -129,6 +142,82 @@ class CompressionFilter : public Filter {
   /** Set the compression level used by this filter instance. */
   void set_compression_level(int compressor_level);
 
+  /**
+   * Sets the dictionary of a ZStd compression filter. An empty dictionary
+   * compresses without a dictionary.
+   *
+   * @param dictionary The dictionary.
+   * @return Status
+   */
+  Status set_zstd_dictionary(const std::vector<uint8_t>& dictionary);
+
+  /**
+   * Trains and sets the dictionary of a ZStd compression filter.
+   *
+   * @param samples Sample data to train on, typically tiles.
+   * @param max_size Maximum size in bytes of the dictionary.
+   * @return Status
+   */
+  Status train_zstd_dictionary(
+      const std::vector<ConstBuffer>& samples, uint64_t max_size);
+
+  /** Returns the ZStd dictionary, empty if there is none. */
+  const std::vector<uint8_t>& zstd_dictionary() const;
+
+  /** Sets the accelerator backend of this filter, nullptr for none. */
+  void set_accelerator(const shared_ptr<CodecAccelerator>& accelerator);
+
+  /** Returns the accelerator backend of this filter, if any. */
+  const shared_ptr<CodecAccelerator>& accelerator() const;
+
+  /**
+   * Returns true if the parts of this filter are offloaded to its
+   * accelerator backend. Parts compressed with a ZStd dictionary never are.
+   */
+  bool offloads() const;
+
+  /**
+   * Compresses a batch of chunks, submitting all their parts to the
+   * accelerator backend at once. The output has the same format as
+   * `run_forward`.
+   *
+   * @param tile The tile the chunks belong to.
+   * @param input_metadata The input metadata of each chunk.
+   * @param input The input of each chunk.
+   * @param output_metadata The output metadata of each chunk.
+   * @param output The output of each chunk.
+   * @param compute_tp The thread pool for the parts compressed on the CPU.
+   * @return Status
+   */
+  Status run_forward_batch(
+      const Tile& tile,
+      const std::vector<FilterBuffer*>& input_metadata,
+      const std::vector<FilterBuffer*>& input,
+      const std::vector<FilterBuffer*>& output_metadata,
+      const std::vector<FilterBuffer*>& output,
+      ThreadPool* compute_tp) const;
+
+  /**
+   * Decompresses a batch of chunks, submitting all their parts to the
+   * accelerator backend at once. The output has the same format as
+   * `run_reverse`.
+   *
+   * @param tile The tile the chunks belong to.
+   * @param input_metadata The input metadata of each chunk.
+   * @param input The input of each chunk.
+   * @param output_metadata The output metadata of each chunk.
+   * @param output The output of each chunk.
+   * @param compute_tp The thread pool for the parts decompressed on the CPU.
+   * @return Status
+   */
+  Status run_reverse_batch(
+      const Tile& tile,
+      const std::vector<FilterBuffer*>& input_metadata,
+      const std::vector<FilterBuffer*>& input,
+      const std::vector<FilterBuffer*>& output_metadata,
+      const std::vector<FilterBuffer*>& output,
+      ThreadPool* compute_tp) const;
+
  private:
   /** The compressor. */
   Compressor compressor_;
@@ -154,9 +243,45 @@ class CompressionFilter : public Filter {
   shared_ptr<BlockingResourcePool<ZStd::ZSTD_Decompress_Context>>
       zstd_decompress_ctx_pool_;
 
+  /**
+   * The ZStd dictionary, shared by the clones of this filter. Empty when
+   * compressing without a dictionary.
+   */
+  shared_ptr<const std::vector<uint8_t>> zstd_dictionary_;
+
+  /** Mutex guarding the digested ZStd dictionaries. */
+  std::mutex zstd_dictionary_mtx_;
+
+  /** The digested ZStd dictionary for compression, if any. */
+  ZStd::CompressionDictionary zstd_compression_dictionary_;
+
+  /** The digested ZStd dictionary for decompression, if any. */
+  ZStd::DecompressionDictionary zstd_decompression_dictionary_;
+
+  /** The accelerator backend, shared by the clones of this filter. */
+  shared_ptr<CodecAccelerator> accelerator_;
+
   /** Returns a new clone of this filter. */
   CompressionFilter* clone_impl() const override;
 
+  /** Compresses `input` with the compressor, appending onto `output`. */
+  Status compress_buffer(
+      const Tile& tile, ConstBuffer* input, Buffer* output) const;
+
+  /** Decompresses `input` with the compressor into `output`. */
+  Status decompress_buffer(
+      const Tile& tile, ConstBuffer* input, PreallocatedBuffer* output) const;
+
+  /**
+   * Submits a batch of parts to the accelerator backend and waits for it,
+   * then compresses or decompresses the parts it left undone on the CPU.
+   */
+  Status run_batch(
+      const Tile& tile,
+      bool compress,
+      std::vector<CodecAccelerator::Job>& jobs,
+      ThreadPool* compute_tp) const;
+
   /** Helper function to compress a single contiguous buffer (part). */
   Status compress_part(
       const Tile& tile,
@@ -0,0 +1,335 @@
+/**
+ * @file   dictionary_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DictionaryFilter.
+ */
+
+
+#include "tiledb/sm/filter/dictionary_filter.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+DictionaryFilter::DictionaryFilter()
+    : Filter(FilterType::FILTER_DICTIONARY) {
+}
+
+DictionaryFilter* DictionaryFilter::clone_impl() const {
+  return tdb_new(DictionaryFilter);
+}
+
+void DictionaryFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "Dictionary");
+}
+
+Status DictionaryFilter::run_forward(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // The cells must fit in the input.
+  const uint64_t value_size = tile.cell_size();
+  const uint64_t input_size = input->size();
+  if (value_size != 0 && value_size <= std::numeric_limits<uint32_t>::max() &&
+      input_size % value_size == 0) {
+    // Gather the input when it comes in multiple parts.
+    std::vector<char> gathered;
+    const char* cell_data = nullptr;
+    if (input->num_buffers() == 1) {
+      ConstBuffer data(nullptr, 0);
+      RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+      cell_data = static_cast<const char*>(data.data());
+    } else {
+      gathered.resize(input_size);
+      RETURN_NOT_OK(input->copy_to(gathered.data()));
+      cell_data = gathered.data();
+    }
+
+    const uint64_t cell_num = input_size / value_size;
+    std::vector<std::string_view> cells(cell_num);
+    for (uint64_t c = 0; c < cell_num; c++)
+      cells[c] = std::string_view(cell_data + c * value_size, value_size);
+
+    return encode(
+        cells,
+        static_cast<uint32_t>(value_size),
+        input_metadata,
+        input,
+        output_metadata,
+        output);
+  }
+
+  return forward_unencoded(input_metadata, input, output_metadata, output);
+}
+
+Status DictionaryFilter::run_forward_var(
+    const Tile& tile,
+    const uint64_t* cell_offsets,
+    uint64_t cell_num,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  (void)tile;
+
+  const uint64_t input_size = input->size();
+  if (cell_num == 0 || input->num_buffers() != 1 ||
+      cell_offsets[cell_num - 1] - cell_offsets[0] > input_size)
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  ConstBuffer data(nullptr, 0);
+  RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+  auto cell_data = static_cast<const char*>(data.data());
+
+  // The offsets are relative to the tile, the chunk starts at the first cell.
+  std::vector<std::string_view> cells(cell_num);
+  for (uint64_t c = 0; c < cell_num; c++) {
+    const uint64_t start = cell_offsets[c] - cell_offsets[0];
+    const uint64_t end = c == cell_num - 1 ?
+                             input_size :
+                             cell_offsets[c + 1] - cell_offsets[0];
+    cells[c] = std::string_view(cell_data + start, end - start);
+  }
+
+  return encode(cells, 0, input_metadata, input, output_metadata, output);
+}
+
+Status DictionaryFilter::encode(
+    const std::vector<std::string_view>& cells,
+    uint32_t value_size,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  const uint64_t input_size = input->size();
+  const uint64_t cell_num = cells.size();
+  if (cell_num == 0 || input_size > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Assign a code to each distinct value, in order of first appearance. Stop
+  // as soon as the dictionary alone is as large as the input.
+  std::unordered_map<std::string_view, uint32_t> value_codes;
+  std::vector<std::string_view> values;
+  std::vector<uint32_t> codes(cell_num);
+  uint64_t dictionary_size = 0;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    auto it = value_codes.find(cells[c]);
+    if (it == value_codes.end()) {
+      dictionary_size += cells[c].size();
+      if (value_size == 0)
+        dictionary_size += sizeof(uint32_t);
+      if (dictionary_size >= input_size)
+        return forward_unencoded(
+            input_metadata, input, output_metadata, output);
+      it = value_codes.emplace(cells[c], (uint32_t)values.size()).first;
+      values.push_back(cells[c]);
+    }
+    codes[c] = it->second;
+  }
+
+  // Encode only if the dictionary and the codes are smaller than the input.
+  uint8_t bit_width = 0;
+  while ((uint64_t(1) << bit_width) < values.size())
+    bit_width++;
+  const uint64_t codes_size = (cell_num * bit_width + 7) / 8;
+  const uint64_t output_size = dictionary_size + codes_size;
+  if (output_size >= input_size)
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Forward the existing metadata and write this filter's metadata.
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(
+      sizeof(uint8_t) + 4 * sizeof(uint32_t) + sizeof(uint8_t)));
+  const uint8_t encoded = 1;
+  const auto orig_size = static_cast<uint32_t>(input_size);
+  const auto cell_num_32 = static_cast<uint32_t>(cell_num);
+  const auto value_num = static_cast<uint32_t>(values.size());
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&cell_num_32, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&value_num, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&value_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&bit_width, sizeof(uint8_t)));
+
+  // Write the dictionary.
+  RETURN_NOT_OK(output->prepend_buffer(output_size));
+  if (value_size == 0) {
+    for (const auto& value : values) {
+      const auto size = static_cast<uint32_t>(value.size());
+      RETURN_NOT_OK(output->write(&size, sizeof(uint32_t)));
+    }
+  }
+  for (const auto& value : values)
+    RETURN_NOT_OK(output->write(value.data(), value.size()));
+
+  // Bit-pack the codes.
+  std::vector<uint8_t> packed(codes_size);
+  uint64_t bits = 0;
+  unsigned bit_num = 0;
+  size_t pos = 0;
+  for (uint64_t c = 0; c < cell_num && bit_width != 0; c++) {
+    bits |= uint64_t(codes[c]) << bit_num;
+    bit_num += bit_width;
+    while (bit_num >= 8) {
+      packed[pos++] = static_cast<uint8_t>(bits);
+      bits >>= 8;
+      bit_num -= 8;
+    }
+  }
+  if (bit_num > 0)
+    packed[pos++] = static_cast<uint8_t>(bits);
+  assert(pos == codes_size);
+  RETURN_NOT_OK(output->write(packed.data(), packed.size()));
+
+  return Status::Ok();
+}
+
+Status DictionaryFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  const uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+  return Status::Ok();
+}
+
+Status DictionaryFilter::run_reverse(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  (void)tile;
+  (void)config;
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint32_t orig_size, cell_num, value_num, value_size;
+    uint8_t bit_width;
+    RETURN_NOT_OK(input_metadata->read(&orig_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&cell_num, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&value_num, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&value_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&bit_width, sizeof(uint8_t)));
+    if (bit_width > 32)
+      return LOG_STATUS(
+          Status_FilterError("Dictionary filter error; invalid bit width"));
+
+    // Locate the values of the dictionary.
+    std::vector<uint64_t> value_offsets(value_num + 1, 0);
+    if (value_size == 0) {
+      for (uint32_t v = 0; v < value_num; v++) {
+        uint32_t size;
+        RETURN_NOT_OK(input->read(&size, sizeof(uint32_t)));
+        value_offsets[v + 1] = value_offsets[v] + size;
+      }
+    } else {
+      for (uint32_t v = 0; v < value_num; v++)
+        value_offsets[v + 1] = value_offsets[v] + value_size;
+    }
+    ConstBuffer values(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(value_offsets[value_num], &values));
+    auto values_data = static_cast<const char*>(values.data());
+    input->advance_offset(value_offsets[value_num]);
+
+    const uint64_t codes_size = (uint64_t(cell_num) * bit_width + 7) / 8;
+    ConstBuffer codes(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(codes_size, &codes));
+    auto packed = static_cast<const uint8_t*>(codes.data());
+    input->advance_offset(codes_size);
+
+    // Write the value of each cell.
+    RETURN_NOT_OK(output->prepend_buffer(orig_size));
+    Buffer* output_buf = output->buffer_ptr(0);
+    assert(output_buf != nullptr);
+    auto dest = static_cast<char*>(output_buf->cur_data());
+    uint64_t written = 0;
+    const uint64_t mask = (uint64_t(1) << bit_width) - 1;
+    uint64_t bits = 0;
+    unsigned bit_num = 0;
+    size_t pos = 0;
+    for (uint32_t c = 0; c < cell_num; c++) {
+      while (bit_num < bit_width) {
+        bits |= uint64_t(packed[pos++]) << bit_num;
+        bit_num += 8;
+      }
+      const uint64_t code = bits & mask;
+      bits >>= bit_width;
+      bit_num -= bit_width;
+
+      if (code >= value_num)
+        return LOG_STATUS(
+            Status_FilterError("Dictionary filter error; invalid code"));
+      const uint64_t size = value_offsets[code + 1] - value_offsets[code];
+      if (written + size > orig_size)
+        return LOG_STATUS(Status_FilterError(
+            "Dictionary filter error; decoded cells exceed the chunk size"));
+      std::memcpy(dest + written, values_data + value_offsets[code], size);
+      written += size;
+    }
+
+    if (output_buf->owns_data())
+      output_buf->advance_size(written);
+    output_buf->advance_offset(written);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
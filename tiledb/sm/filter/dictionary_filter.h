@@ -0,0 +1,153 @@
+/**
+ * @file   dictionary_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class DictionaryFilter.
+ */
+
+#ifndef TILEDB_DICTIONARY_FILTER_H
+#define TILEDB_DICTIONARY_FILTER_H
+
+#include <string_view>
+#include <vector>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filter/filter.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that encodes the cells of a chunk with a dictionary of their
+ * distinct values, replacing each cell with the bit-packed index of its value
+ * in the dictionary. It suits attributes with few distinct values, such as
+ * codes and categories.
+ *
+ * The cells of fixed-sized tiles have the cell size of the tile. The cells of
+ * var-sized tiles are given by their offsets when the filter is the first of
+ * the pipeline; otherwise the input is left unmodified. The input is also
+ * left unmodified when the dictionary and codes are not smaller than it.
+ *
+ * Input metadata is not compressed or modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded
+ * followed, when encoded, by:
+ *   uint32_t - Size in bytes of the input
+ *   uint32_t - Number of cells
+ *   uint32_t - Number of values in the dictionary
+ *   uint32_t - Size in bytes of each value, 0 for var-sized values
+ *   uint8_t - Bit width of the codes
+ *
+ * The forward output data format, when encoded, is:
+ *   uint32_t[] - Size in bytes of each value, for var-sized values only
+ *   uint8_t[] - Concatenated dictionary values
+ *   uint8_t[] - Codes of the cells, bit-packed from the least significant bit
+ *
+ * The reverse output format is simply:
+ *   uint8_t[] - The original cells
+ */
+class DictionaryFilter : public Filter {
+ public:
+  /** Constructor. */
+  DictionaryFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the fixed-sized cells of the given input into the given output.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Encode the var-sized cells of the given input into the given output.
+   */
+  Status run_forward_var(
+      const Tile& tile,
+      const uint64_t* cell_offsets,
+      uint64_t cell_num,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the cells of the given input into the given output.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  DictionaryFilter* clone_impl() const override;
+
+  /**
+   * Encodes the given cells, or forwards the input unmodified when encoding
+   * does not make it smaller.
+   *
+   * @param cells The cells of the input, in order.
+   * @param value_size The size of each cell, 0 for var-sized cells.
+   * @param input_metadata Buffer with metadata for `input`.
+   * @param input Buffer with the data of the cells.
+   * @param output_metadata Buffer to store output metadata.
+   * @param output Buffer to store the encoded cells.
+   * @return Status
+   */
+  Status encode(
+      const std::vector<std::string_view>& cells,
+      uint32_t value_size,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DICTIONARY_FILTER_H
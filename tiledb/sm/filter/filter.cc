@@ -107,6 +107,19 @@ Status Filter::serialize_impl(Buffer* buff) const {
   return Status::Ok();
 }
 
+Status Filter::run_forward_var(
+    const Tile& tile,
+    const uint64_t* cell_offsets,
+    uint64_t cell_num,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  (void)cell_offsets;
+  (void)cell_num;
+  return run_forward(tile, input_metadata, input, output_metadata, output);
+}
+
 FilterType Filter::type() const {
   return type_;
 }
@@ -104,6 +104,31 @@ class Filter {
       FilterBuffer* output_metadata,
       FilterBuffer* output) const = 0;
 
+  /**
+   * Runs this filter in the "forward" direction on a chunk of a var-sized
+   * tile, given the cells of the chunk. The pipeline calls it instead of
+   * `run_forward` for its first filter, whose input is the original chunk.
+   *
+   * Filters that do not use the cell boundaries run as in `run_forward`.
+   *
+   * @param tile Current tile on which the filter is being run
+   * @param cell_offsets The offsets in the tile of the cells of the chunk.
+   * @param cell_num The number of cells of the chunk.
+   * @param input_metadata Buffer with metadata for `input`
+   * @param input Buffer with data to be filtered.
+   * @param output_metadata Buffer with metadata for filtered data
+   * @param output Buffer with filtered data (unused by in-place filters).
+   * @return Status
+   */
+  virtual Status run_forward_var(
+      const Tile& tile,
+      const uint64_t* cell_offsets,
+      uint64_t cell_num,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
   /**
    * Runs this filter in the "reverse" direction (i.e. during read queries).
    *
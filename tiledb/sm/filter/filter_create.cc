@@ -32,13 +32,19 @@
  */
 
 #include "filter_create.h"
+#include "auto_compression_filter.h"
 #include "bit_width_reduction_filter.h"
+#include "bitmap_filter.h"
 #include "bitshuffle_filter.h"
 #include "byteshuffle_filter.h"
+#include "checksum_crc32c_filter.h"
 #include "checksum_md5_filter.h"
 #include "checksum_sha256_filter.h"
+#include "dictionary_filter.h"
 #include "compression_filter.h"
 #include "encryption_aes256gcm_filter.h"
+#include "float_xor_filter.h"
+#include "frame_of_reference_filter.h"
 #include "filter.h"
 #include "noop_filter.h"
 #include "positive_delta_filter.h"
@@ -47,6 +53,19 @@
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/filter_type.h"
 
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+/** Guards `accelerators`. */
+std::mutex accelerators_mtx;
+
+/** The registered accelerator backends, in registration order. */
+std::vector<std::shared_ptr<tiledb::sm::CodecAccelerator>> accelerators;
+
+}  // namespace
+
 tiledb::sm::Filter* tiledb::sm::FilterCreate::make(FilterType type) {
   switch (type) {
     case tiledb::sm::FilterType::FILTER_NONE:
@@ -56,8 +75,11 @@ tiledb::sm::Filter* tiledb::sm::FilterCreate::make(FilterType type) {
     case tiledb::sm::FilterType::FILTER_LZ4:
     case tiledb::sm::FilterType::FILTER_RLE:
     case tiledb::sm::FilterType::FILTER_BZIP2:
-    case tiledb::sm::FilterType::FILTER_DOUBLE_DELTA:
-      return tdb_new(tiledb::sm::CompressionFilter, type, -1);
+    case tiledb::sm::FilterType::FILTER_DOUBLE_DELTA: {
+      auto filter = tdb_new(tiledb::sm::CompressionFilter, type, -1);
+      attach_accelerator(filter);
+      return filter;
+    }
     case tiledb::sm::FilterType::FILTER_BIT_WIDTH_REDUCTION:
       return tdb_new(tiledb::sm::BitWidthReductionFilter);
     case tiledb::sm::FilterType::FILTER_BITSHUFFLE:
@@ -72,6 +94,18 @@ tiledb::sm::Filter* tiledb::sm::FilterCreate::make(FilterType type) {
       return tdb_new(tiledb::sm::ChecksumMD5Filter);
     case tiledb::sm::FilterType::FILTER_CHECKSUM_SHA256:
       return tdb_new(tiledb::sm::ChecksumSHA256Filter);
+    case tiledb::sm::FilterType::FILTER_DICTIONARY:
+      return tdb_new(tiledb::sm::DictionaryFilter);
+    case tiledb::sm::FilterType::FILTER_FRAME_OF_REFERENCE:
+      return tdb_new(tiledb::sm::FrameOfReferenceFilter);
+    case tiledb::sm::FilterType::FILTER_FLOAT_XOR:
+      return tdb_new(tiledb::sm::FloatXorFilter);
+    case tiledb::sm::FilterType::FILTER_AUTO_COMPRESSION:
+      return tdb_new(tiledb::sm::AutoCompressionFilter);
+    case tiledb::sm::FilterType::FILTER_CHECKSUM_CRC32C:
+      return tdb_new(tiledb::sm::ChecksumCRC32CFilter);
+    case tiledb::sm::FilterType::FILTER_BITMAP:
+      return tdb_new(tiledb::sm::BitmapFilter);
     default:
       assert(false);
       return nullptr;
@@ -121,9 +155,28 @@ tiledb::sm::FilterCreate::deserialize(
       if (!st.ok()) {
         return {st, nullopt};
       }
-      return {Status::Ok(),
-              tiledb::common::make_shared<CompressionFilter>(
-                  HERE(), compressor, compression_level)};
+      auto filter = tiledb::common::make_shared<CompressionFilter>(
+          HERE(), compressor, compression_level);
+      attach_accelerator(filter.get());
+
+      // A ZStd dictionary follows, if any.
+      if (filter_metadata_len > sizeof(uint8_t) + sizeof(int32_t)) {
+        uint32_t dictionary_size;
+        st = buff->read(&dictionary_size, sizeof(uint32_t));
+        if (!st.ok()) {
+          return {st, nullopt};
+        }
+        std::vector<uint8_t> dictionary(dictionary_size);
+        st = buff->read(dictionary.data(), dictionary_size);
+        if (!st.ok()) {
+          return {st, nullopt};
+        }
+        st = filter->set_zstd_dictionary(dictionary);
+        if (!st.ok()) {
+          return {st, nullopt};
+        }
+      }
+      return {Status::Ok(), filter};
     }
     case FilterType::FILTER_BIT_WIDTH_REDUCTION: {
       uint32_t max_window_size;
@@ -168,6 +221,30 @@ tiledb::sm::FilterCreate::deserialize(
     case FilterType::FILTER_CHECKSUM_SHA256:
       return {Status::Ok(),
               tiledb::common::make_shared<ChecksumSHA256Filter>(HERE())};
+    case FilterType::FILTER_DICTIONARY:
+      return {Status::Ok(),
+              tiledb::common::make_shared<DictionaryFilter>(HERE())};
+    case FilterType::FILTER_FRAME_OF_REFERENCE:
+      return {Status::Ok(),
+              tiledb::common::make_shared<FrameOfReferenceFilter>(HERE())};
+    case FilterType::FILTER_FLOAT_XOR:
+      return {Status::Ok(),
+              tiledb::common::make_shared<FloatXorFilter>(HERE())};
+    case FilterType::FILTER_AUTO_COMPRESSION: {
+      uint32_t speed_bias;
+      st = buff->read(&speed_bias, sizeof(uint32_t));
+      if (!st.ok()) {
+        return {st, nullopt};
+      }
+      return {Status::Ok(),
+              tiledb::common::make_shared<AutoCompressionFilter>(
+                  HERE(), speed_bias)};
+    }
+    case FilterType::FILTER_CHECKSUM_CRC32C:
+      return {Status::Ok(),
+              tiledb::common::make_shared<ChecksumCRC32CFilter>(HERE())};
+    case FilterType::FILTER_BITMAP:
+      return {Status::Ok(), tiledb::common::make_shared<BitmapFilter>(HERE())};
     default:
       assert(false);
       return {Status_FilterError("Deserialization error; unknown type"),
@@ -179,4 +256,32 @@ std::tuple<Status, optional<std::shared_ptr<tiledb::sm::Filter>>>
 tiledb::sm::FilterCreate::deserialize(ConstBuffer* buff) {
   EncryptionKey encryption_key;
   return tiledb::sm::FilterCreate::deserialize(buff, encryption_key);
-}
\ No newline at end of file
+}
+
+void tiledb::sm::FilterCreate::register_accelerator(
+    const std::shared_ptr<CodecAccelerator>& accelerator) {
+  std::lock_guard<std::mutex> lck(accelerators_mtx);
+  accelerators.emplace_back(accelerator);
+}
+
+void tiledb::sm::FilterCreate::unregister_accelerator(
+    const CodecAccelerator* accelerator) {
+  std::lock_guard<std::mutex> lck(accelerators_mtx);
+  accelerators.erase(
+      std::remove_if(
+          accelerators.begin(),
+          accelerators.end(),
+          [&](const auto& a) { return a.get() == accelerator; }),
+      accelerators.end());
+}
+
+void tiledb::sm::FilterCreate::attach_accelerator(CompressionFilter* filter) {
+  std::lock_guard<std::mutex> lck(accelerators_mtx);
+  for (const auto& accelerator : accelerators) {
+    if (accelerator->claims(
+            filter->compressor(), filter->compression_level())) {
+      filter->set_accelerator(accelerator);
+      return;
+    }
+  }
+}
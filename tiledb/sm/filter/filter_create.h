@@ -38,6 +38,8 @@
 
 namespace tiledb::sm {
 
+class CodecAccelerator;
+class CompressionFilter;
 class EncryptionKey;
 
 class FilterCreate {
@@ -68,6 +70,31 @@ class FilterCreate {
    */
   static std::tuple<Status, optional<std::shared_ptr<Filter>>> deserialize(
       ConstBuffer* buff);
+
+  /**
+   * Registers an accelerator backend. The compression filters made or
+   * deserialized afterwards offload their parts to the first registered
+   * backend that claims their compressor.
+   *
+   * @param accelerator The backend to register.
+   */
+  static void register_accelerator(
+      const std::shared_ptr<CodecAccelerator>& accelerator);
+
+  /**
+   * Unregisters an accelerator backend. The filters already attached to it
+   * keep it alive and keep using it.
+   *
+   * @param accelerator The backend to unregister.
+   */
+  static void unregister_accelerator(const CodecAccelerator* accelerator);
+
+ private:
+  /**
+   * Attaches the first registered accelerator backend that claims the
+   * compressor of `filter`, if any.
+   */
+  static void attach_accelerator(CompressionFilter* filter);
 };
 
 }  // namespace tiledb::sm
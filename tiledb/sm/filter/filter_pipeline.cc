@@ -34,6 +34,7 @@
 #include "filter_create.h"
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/memory_tracker.h"
 #include "tiledb/sm/crypto/encryption_key.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/filter_type.h"
@@ -46,11 +47,72 @@
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <algorithm>
+#include <deque>
+
 using namespace tiledb::common;
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * The filter storage of a compute thread. All the chunks filtered by the
+ * thread borrow their stage buffers from it, so that the buffers are
+ * allocated once per thread rather than once per chunk and filter.
+ */
+class ThreadFilterArena {
+ public:
+  /** Destructor. */
+  ~ThreadFilterArena() {
+    FilterPipeline::arena_memory_tracker()->release_memory(tracked_size_);
+  }
+
+  /**
+   * Returns the storage of the arena, with the buffers of the previous
+   * chunks reclaimed. Buffers grown past `max_retained_size` by a chunk are
+   * freed rather than kept for the next ones.
+   */
+  FilterStorage* storage(uint64_t max_retained_size) {
+    storage_.set_max_retained_size(max_retained_size);
+    storage_.reclaim_unused();
+
+    // Track the memory held by the arena.
+    auto tracker = FilterPipeline::arena_memory_tracker();
+    const uint64_t size = storage_.allocated_size();
+    if (size > tracked_size_)
+      tracker->take_memory(size - tracked_size_);
+    else
+      tracker->release_memory(tracked_size_ - size);
+    tracked_size_ = size;
+
+    return &storage_;
+  }
+
+ private:
+  /** The buffers of the arena. */
+  FilterStorage storage_;
+
+  /** The memory of the arena taken from the arena memory tracker. */
+  uint64_t tracked_size_ = 0;
+};
+
+/**
+ * Returns the filter storage of the calling thread.
+ *
+ * @param max_chunk_size The max chunk size of the pipeline.
+ */
+FilterStorage* thread_filter_storage(uint32_t max_chunk_size) {
+  thread_local ThreadFilterArena arena;
+
+  // The stage buffers of a chunk hold at most about twice the chunk size,
+  // for instance when compressing data that cannot be compressed.
+  return arena.storage(2 * (uint64_t)max_chunk_size);
+}
+
+}  // namespace
+
 FilterPipeline::FilterPipeline()
     : max_chunk_size_(constants::max_tile_chunk_size) {
 }
@@ -145,10 +207,19 @@ FilterPipeline::get_var_chunk_sizes(
   return {Status::Ok(), std::move(chunk_offsets)};
 }
 
+CompressionFilter* FilterPipeline::offloaded_compression_filter() const {
+  if (filters_.empty())
+    return nullptr;
+
+  auto filter = dynamic_cast<CompressionFilter*>(filters_.back().get());
+  return filter != nullptr && filter->offloads() ? filter : nullptr;
+}
+
 Status FilterPipeline::filter_chunks_forward(
     const Tile& tile,
     uint32_t chunk_size,
     std::vector<uint64_t>& chunk_offsets,
+    const Tile* offsets_tile,
     FilteredBuffer& output,
     ThreadPool* const compute_tp) const {
   bool var_sizes = chunk_offsets.size() > 0;
@@ -170,13 +241,18 @@ Status FilterPipeline::filter_chunks_forward(
   std::vector<std::pair<FilterBufferPair, FilterBufferPair>> final_stage_io(
       nchunks);
 
+  // An offloaded compression filter runs once over all the chunks, after
+  // the other filters.
+  CompressionFilter* const offloaded = offloaded_compression_filter();
+  const auto filters_end =
+      offloaded != nullptr ? std::prev(filters_.end()) : filters_.end();
+
   // Run each chunk through the entire pipeline.
   auto status = parallel_for(compute_tp, 0, nchunks, [&](uint64_t i) {
-    // TODO(ttd): can we instead allocate one FilterStorage per thread?
-    // or make it threadsafe?
-    FilterStorage storage;
-    FilterBuffer input_data(&storage), output_data(&storage);
-    FilterBuffer input_metadata(&storage), output_metadata(&storage);
+    // The stage buffers are borrowed from the storage of this thread.
+    FilterStorage* storage = thread_filter_storage(max_chunk_size_);
+    FilterBuffer input_data(storage), output_data(storage);
+    FilterBuffer input_metadata(storage), output_metadata(storage);
 
     // First filter's input is the original chunk.
     uint64_t offset = var_sizes ? chunk_offsets[i] : i * chunk_size;
@@ -188,7 +264,7 @@ Status FilterPipeline::filter_chunks_forward(
     RETURN_NOT_OK(input_data.init(chunk_buffer, chunk_buffer_size));
 
     // Apply the filters sequentially.
-    for (auto it = filters_.begin(), ite = filters_.end(); it != ite; ++it) {
+    for (auto it = filters_.begin(); it != filters_end; ++it) {
       auto& f = *it;
 
       // Clear and reset I/O buffers
@@ -202,8 +278,30 @@ Status FilterPipeline::filter_chunks_forward(
 
       f->init_compression_resource_pool(compute_tp->concurrency_level());
 
-      RETURN_NOT_OK(f->run_forward(
-          tile, &input_metadata, &input_data, &output_metadata, &output_data));
+      // The first filter of a var sized chunk is given its cells.
+      if (var_sizes && offsets_tile != nullptr && it == filters_.begin()) {
+        auto offsets = static_cast<const uint64_t*>(offsets_tile->data());
+        auto offsets_end =
+            offsets + offsets_tile->size() / constants::cell_var_offset_size;
+        auto cells_begin = std::lower_bound(offsets, offsets_end, offset);
+        auto cells_end = std::lower_bound(
+            cells_begin, offsets_end, offset + chunk_buffer_size);
+        RETURN_NOT_OK(f->run_forward_var(
+            tile,
+            cells_begin,
+            cells_end - cells_begin,
+            &input_metadata,
+            &input_data,
+            &output_metadata,
+            &output_data));
+      } else {
+        RETURN_NOT_OK(f->run_forward(
+            tile,
+            &input_metadata,
+            &input_data,
+            &output_metadata,
+            &output_data));
+      }
 
       input_data.set_read_only(false);
       input_data.swap(output_data);
@@ -213,11 +311,10 @@ Status FilterPipeline::filter_chunks_forward(
     }
 
     // Save the finished chunk (last stage's output). This is safe to do
-    // because when the local FilterStorage goes out of scope, it will not
-    // free the buffers saved here as their tdb_shared_ptr counters will not
-    // be zero. However, as the output may have been a view on the input, we
-    // do need to save both here to prevent the input buffer from being
-    // freed.
+    // because the storage of this thread does not reuse the buffers saved
+    // here until their tdb_shared_ptr counters drop back to one. However, as
+    // the output may have been a view on the input, we do need to save both
+    // here to prevent the input buffer from being reused.
     auto& io = final_stage_io[i];
     auto& io_input = io.first;
     auto& io_output = io.second;
@@ -230,6 +327,36 @@ Status FilterPipeline::filter_chunks_forward(
 
   RETURN_NOT_OK(status);
 
+  if (offloaded != nullptr) {
+    // Compress the final stage of all the chunks as one batch, and make
+    // the compressed chunks the final stage.
+    FilterStorage* storage = thread_filter_storage(max_chunk_size_);
+    std::deque<FilterBuffer> compressed;
+    std::vector<FilterBuffer*> input_metadata, input_data;
+    std::vector<FilterBuffer*> output_metadata, output_data;
+    for (auto& io : final_stage_io) {
+      input_metadata.emplace_back(&io.first.first);
+      input_data.emplace_back(&io.first.second);
+      output_metadata.emplace_back(&compressed.emplace_back(storage));
+      output_data.emplace_back(&compressed.emplace_back(storage));
+    }
+
+    filters_.back()->init_compression_resource_pool(
+        compute_tp->concurrency_level());
+    RETURN_NOT_OK(offloaded->run_forward_batch(
+        tile,
+        input_metadata,
+        input_data,
+        output_metadata,
+        output_data,
+        compute_tp));
+
+    for (uint64_t i = 0; i < nchunks; i++) {
+      RETURN_NOT_OK(input_metadata[i]->swap(*output_metadata[i]));
+      RETURN_NOT_OK(input_data[i]->swap(*output_data[i]));
+    }
+  }
+
   uint64_t total_processed_size = 0;
   std::vector<uint32_t> var_chunk_sizes(final_stage_io.size());
   uint64_t offset = sizeof(uint64_t);
@@ -321,6 +448,50 @@ Status FilterPipeline::filter_chunks_reverse(
         Status_FilterError("Error incorrect unfiltered tile size allocated."));
   }
 
+  // An offloaded compression filter decompresses all the chunks as one
+  // batch, before the other filters run on each chunk. When it is the only
+  // filter, it decompresses directly into the tile.
+  CompressionFilter* const offloaded = offloaded_compression_filter();
+  std::deque<FilterBuffer> decompressed;
+  std::vector<FilterBuffer*> decompressed_metadata, decompressed_data;
+  if (offloaded != nullptr) {
+    FilterStorage* storage = thread_filter_storage(max_chunk_size_);
+    std::vector<FilterBuffer*> input_metadata, input_data;
+    for (size_t i = 0; i < input.size(); i++) {
+      const auto& chunk_input = input[i];
+      void* const metadata = std::get<0>(chunk_input);
+      const uint32_t metadata_len = std::get<3>(chunk_input);
+      auto& chunk_metadata = decompressed.emplace_back(storage);
+      RETURN_NOT_OK(chunk_metadata.init(metadata, metadata_len));
+      input_metadata.emplace_back(&chunk_metadata);
+      auto& chunk_data = decompressed.emplace_back(storage);
+      RETURN_NOT_OK(chunk_data.init(
+          (char*)metadata + metadata_len, std::get<1>(chunk_input)));
+      input_data.emplace_back(&chunk_data);
+
+      decompressed_metadata.emplace_back(&decompressed.emplace_back(storage));
+      decompressed_data.emplace_back(&decompressed.emplace_back(storage));
+      if (filters_.size() == 1) {
+        void* output_chunk_buffer =
+            static_cast<char*>(tile.data()) + chunk_offsets[i];
+        RETURN_NOT_OK(decompressed_data.back()->set_fixed_allocation(
+            output_chunk_buffer, std::get<2>(chunk_input)));
+      }
+    }
+
+    filters_.back()->init_decompression_resource_pool(
+        compute_tp->concurrency_level());
+    RETURN_NOT_OK(offloaded->run_reverse_batch(
+        tile,
+        input_metadata,
+        input_data,
+        decompressed_metadata,
+        decompressed_data,
+        compute_tp));
+    if (filters_.size() == 1)
+      return Status::Ok();
+  }
+
   // Run each chunk through the entire pipeline.
   auto status = parallel_for(compute_tp, 0, input.size(), [&](uint64_t i) {
     const auto& chunk_input = input[i];
@@ -331,15 +502,28 @@ Status FilterPipeline::filter_chunks_reverse(
     void* const metadata = std::get<0>(chunk_input);
     void* const chunk_data = (char*)metadata + metadata_len;
 
-    // TODO(ttd): can we instead allocate one FilterStorage per thread?
-    // or make it threadsafe?
-    FilterStorage storage;
-    FilterBuffer input_data(&storage), output_data(&storage);
-    FilterBuffer input_metadata(&storage), output_metadata(&storage);
-
-    // First filter's input is the filtered chunk data.
-    RETURN_NOT_OK(input_metadata.init(metadata, metadata_len));
-    RETURN_NOT_OK(input_data.init(chunk_data, filtered_chunk_len));
+    // The stage buffers are borrowed from the storage of this thread.
+    FilterStorage* storage = thread_filter_storage(max_chunk_size_);
+    FilterBuffer input_data(storage), output_data(storage);
+    FilterBuffer input_metadata(storage), output_metadata(storage);
+
+    // First filter's input is the filtered chunk data, or the chunk
+    // decompressed by the offloaded compression filter.
+    int64_t first_filter_idx = (int64_t)filters_.size() - 1;
+    if (offloaded != nullptr) {
+      first_filter_idx--;
+      Buffer* metadata_buffer = decompressed_metadata[i]->buffer_ptr(0);
+      if (metadata_buffer->size() > 0)
+        RETURN_NOT_OK(input_metadata.init(
+            metadata_buffer->data(), metadata_buffer->size()));
+      Buffer* data_buffer = decompressed_data[i]->buffer_ptr(0);
+      if (data_buffer->size() > 0)
+        RETURN_NOT_OK(
+            input_data.init(data_buffer->data(), data_buffer->size()));
+    } else {
+      RETURN_NOT_OK(input_metadata.init(metadata, metadata_len));
+      RETURN_NOT_OK(input_data.init(chunk_data, filtered_chunk_len));
+    }
 
     // If the pipeline is empty, just copy input to output.
     if (filters_.empty()) {
@@ -350,7 +534,7 @@ Status FilterPipeline::filter_chunks_reverse(
     }
 
     // Apply the filters sequentially in reverse.
-    for (int64_t filter_idx = (int64_t)filters_.size() - 1; filter_idx >= 0;
+    for (int64_t filter_idx = first_filter_idx; filter_idx >= 0;
          filter_idx--) {
       auto& f = filters_[filter_idx];
 
@@ -436,6 +620,7 @@ Status FilterPipeline::run_forward(
           *tile,
           chunk_size,
           *chunk_offsets,
+          offsets_tile,
           tile->filtered_buffer(),
           compute_tp),
       tile->filtered_buffer().clear());
@@ -444,6 +629,10 @@ Status FilterPipeline::run_forward(
   // in 'filtered_buffer'. We can safely free 'buffer'.
   tile->clear_data();
 
+  writer_stats->set_max_counter(
+      "filter_arena_high_water_bytes",
+      arena_memory_tracker()->get_memory_high_water_mark());
+
   return Status::Ok();
 }
 
@@ -455,12 +644,16 @@ Status FilterPipeline::run_reverse_chunk_range(
     const uint64_t max_chunk_index,
     uint64_t concurrency_level,
     const Config& config) const {
+  auto unfiltered_byte_num =
+      reader_stats->register_counter("read_unfiltered_byte_num");
+
   // Run each chunk through the entire pipeline.
   for (size_t i = min_chunk_index; i < max_chunk_index; i++) {
     auto& chunk = chunk_data.filtered_chunks_[i];
-    FilterStorage storage;
-    FilterBuffer input_data(&storage), output_data(&storage);
-    FilterBuffer input_metadata(&storage), output_metadata(&storage);
+    // The stage buffers are borrowed from the storage of this thread.
+    FilterStorage* storage = thread_filter_storage(max_chunk_size_);
+    FilterBuffer input_data(storage), output_data(storage);
+    FilterBuffer input_metadata(storage), output_metadata(storage);
 
     // First filter's input is the filtered chunk data.
     RETURN_NOT_OK(input_metadata.init(
@@ -473,7 +666,7 @@ Status FilterPipeline::run_reverse_chunk_range(
       void* output_chunk_buffer =
           static_cast<char*>(tile->data()) + chunk_data.chunk_offsets_[i];
       RETURN_NOT_OK(input_data.copy_to(output_chunk_buffer));
-      return Status::Ok();
+      continue;
     }
 
     // Apply the filters sequentially in reverse.
@@ -497,8 +690,7 @@ Status FilterPipeline::run_reverse_chunk_range(
             static_cast<char*>(tile->data()) + chunk_data.chunk_offsets_[i];
         RETURN_NOT_OK(output_data.set_fixed_allocation(
             output_chunk_buffer, chunk.unfiltered_data_size_));
-        reader_stats->add_counter(
-            "read_unfiltered_byte_num", chunk.unfiltered_data_size_);
+        unfiltered_byte_num->add(chunk.unfiltered_data_size_);
       }
 
       f->init_decompression_resource_pool(concurrency_level);
@@ -581,6 +773,10 @@ Status FilterPipeline::run_reverse_internal(
   // 'tile->buffer()'.
   tile->filtered_buffer().clear();
 
+  reader_stats->set_max_counter(
+      "filter_arena_high_water_bytes",
+      arena_memory_tracker()->get_memory_high_water_mark());
+
   // Zip the coords.
   if (tile->stores_coords()) {
     // Note that format version < 2 only split the coordinates when compression
@@ -661,6 +857,13 @@ bool FilterPipeline::empty() const {
   return filters_.empty();
 }
 
+bool FilterPipeline::has_filter(FilterType filter_type) const {
+  return std::any_of(
+      filters_.begin(), filters_.end(), [filter_type](const auto& filter) {
+        return filter->type() == filter_type;
+      });
+}
+
 void FilterPipeline::swap(FilterPipeline& other) {
   filters_.swap(other.filters_);
   std::swap(max_chunk_size_, other.max_chunk_size_);
@@ -679,5 +882,16 @@ Status FilterPipeline::append_encryption_filter(
   }
 }
 
+MemoryTracker* FilterPipeline::arena_memory_tracker() {
+  // Never destroyed, as the arenas of the threads still running at exit
+  // release their memory when they are destroyed.
+  static MemoryTracker* tracker = []() {
+    auto tracker = tdb_new(MemoryTracker);
+    tracker->set_budget(std::numeric_limits<uint64_t>::max());
+    return tracker;
+  }();
+  return tracker;
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -51,7 +51,9 @@ namespace tiledb {
 namespace sm {
 
 class Buffer;
+class CompressionFilter;
 class EncryptionKey;
+class MemoryTracker;
 class Tile;
 
 /**
@@ -264,6 +266,9 @@ class FilterPipeline {
   /** Returns true if the pipeline is empty. */
   bool empty() const;
 
+  /** Returns true if the pipeline contains a filter of the given type. */
+  bool has_filter(FilterType filter_type) const;
+
   /** Swaps the contents of this pipeline with the given pipeline. */
   void swap(FilterPipeline& other);
 
@@ -277,6 +282,13 @@ class FilterPipeline {
   static Status append_encryption_filter(
       FilterPipeline* pipeline, const EncryptionKey& encryption_key);
 
+  /**
+   * Returns the memory tracker of the filter storage each compute thread
+   * reuses for the stage buffers of the chunks it filters. Its high-water
+   * mark is the most memory held by all the per-thread storages at once.
+   */
+  static MemoryTracker* arena_memory_tracker();
+
  private:
   /** A pair of FilterBuffers. */
   typedef std::pair<FilterBuffer, FilterBuffer> FilterBufferPair;
@@ -304,6 +316,13 @@ class FilterPipeline {
   std::tuple<Status, std::optional<std::vector<uint64_t>>> get_var_chunk_sizes(
       uint32_t chunk_size, Tile* const tile, Tile* const offsets_tile) const;
 
+  /**
+   * Returns the last filter of the pipeline if it is a compression filter
+   * that offloads its parts to an accelerator backend, nullptr otherwise.
+   * The parts of all the chunks of a tile are then offloaded as one batch.
+   */
+  CompressionFilter* offloaded_compression_filter() const;
+
   /**
    * Run the given buffer forward through the pipeline.
    *
@@ -311,6 +330,8 @@ class FilterPipeline {
    * @param input buffer to process.
    * @param chunk_size chunk size.
    * @param chunk_offsets chunk offsets computed for var sized attributes.
+   * @param offsets_tile The offsets tile of a var sized tile, whose cells
+   *    are given to the first filter.
    * @param output buffer where output of the last stage
    *    will be written.
    * @param compute_tp The thread pool for compute-bound tasks.
@@ -320,6 +341,7 @@ class FilterPipeline {
       const Tile& tile,
       uint32_t chunk_size,
       std::vector<uint64_t>& chunk_offsets,
+      const Tile* offsets_tile,
       FilteredBuffer& output,
       ThreadPool* const compute_tp) const;
 
@@ -31,6 +31,10 @@
  */
 
 #include "tiledb/sm/filter/filter_storage.h"
+
+#include <limits>
+#include <vector>
+
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/sm/buffer/buffer.h"
 
@@ -39,6 +43,10 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+FilterStorage::FilterStorage()
+    : max_retained_size_(std::numeric_limits<uint64_t>::max()) {
+}
+
 tdb_shared_ptr<Buffer> FilterStorage::get_buffer() {
   if (available_.empty())
     available_.emplace_back(tdb_new(Buffer));
@@ -52,6 +60,15 @@ tdb_shared_ptr<Buffer> FilterStorage::get_buffer() {
   return in_use_.back();
 }
 
+uint64_t FilterStorage::allocated_size() const {
+  uint64_t size = 0;
+  for (const auto& buf : available_)
+    size += buf->alloced_size();
+  for (const auto& buf : in_use_)
+    size += buf->alloced_size();
+  return size;
+}
+
 uint64_t FilterStorage::num_available() const {
   return available_.size();
 }
@@ -77,11 +94,27 @@ Status FilterStorage::reclaim(Buffer* buffer) {
     tdb_shared_ptr<Buffer> ptr = std::move(*list_node);
     in_use_.erase(list_node);
     in_use_list_map_.erase(it);
-    available_.push_front(std::move(ptr));
+    if (buffer->alloced_size() <= max_retained_size_)
+      available_.push_front(std::move(ptr));
   }
 
   return Status::Ok();
 }
 
+void FilterStorage::reclaim_unused() {
+  std::vector<Buffer*> unused;
+  for (const auto& buf : in_use_) {
+    if (buf.use_count() == 1)
+      unused.push_back(buf.get());
+  }
+
+  for (Buffer* b : unused)
+    reclaim(b);
+}
+
+void FilterStorage::set_max_retained_size(uint64_t nbytes) {
+  max_retained_size_ = nbytes;
+}
+
 }  // namespace sm
 }  // namespace tiledb
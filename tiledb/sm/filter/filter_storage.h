@@ -52,6 +52,9 @@ class Buffer;
  */
 class FilterStorage {
  public:
+  /** Constructor. */
+  FilterStorage();
+
   /**
    * Return a buffer from the pool, allocating a new one if necessary. The
    * buffer returned by this function will not be available for reuse until it
@@ -61,6 +64,12 @@ class FilterStorage {
    */
   tdb_shared_ptr<Buffer> get_buffer();
 
+  /**
+   * Return the number of bytes allocated by all the buffers of the pool,
+   * available or in use.
+   */
+  uint64_t allocated_size() const;
+
   /** Return the number of buffers in the internal available list. */
   uint64_t num_available() const;
 
@@ -79,6 +88,21 @@ class FilterStorage {
    */
   Status reclaim(Buffer* buffer);
 
+  /**
+   * Reclaims all the in-use buffers that are no longer referenced outside of
+   * the pool, such as the buffers of filter buffers destroyed without being
+   * cleared. This allows a pool to outlive the filter buffers using it.
+   */
+  void reclaim_unused();
+
+  /**
+   * Sets the largest allocation a reclaimed buffer may keep. Larger buffers
+   * are freed when reclaimed instead of being made available for reuse.
+   *
+   * @param nbytes The maximum allocation of a buffer kept for reuse.
+   */
+  void set_max_retained_size(uint64_t nbytes);
+
  private:
   /** List of buffers that are available to be used (may be empty). */
   std::list<tdb_shared_ptr<Buffer>> available_;
@@ -92,6 +116,9 @@ class FilterStorage {
    */
   std::unordered_map<Buffer*, std::list<tdb_shared_ptr<Buffer>>::iterator>
       in_use_list_map_;
+
+  /** The largest allocation of a buffer kept for reuse when reclaimed. */
+  uint64_t max_retained_size_;
 };
 
 }  // namespace sm
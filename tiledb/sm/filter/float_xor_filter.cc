@@ -0,0 +1,474 @@
+/**
+ * @file   float_xor_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FloatXorFilter.
+ */
+
+#include "tiledb/sm/filter/float_xor_filter.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Returns the number of leading zero bits of a non-zero 64-bit value. */
+inline uint32_t leading_zeros(uint64_t value) {
+  assert(value != 0);
+  uint32_t n = 0;
+  if (value <= 0x00000000FFFFFFFFULL) {
+    n += 32;
+    value <<= 32;
+  }
+  if (value <= 0x0000FFFFFFFFFFFFULL) {
+    n += 16;
+    value <<= 16;
+  }
+  if (value <= 0x00FFFFFFFFFFFFFFULL) {
+    n += 8;
+    value <<= 8;
+  }
+  if (value <= 0x0FFFFFFFFFFFFFFFULL) {
+    n += 4;
+    value <<= 4;
+  }
+  if (value <= 0x3FFFFFFFFFFFFFFFULL) {
+    n += 2;
+    value <<= 2;
+  }
+  if (value <= 0x7FFFFFFFFFFFFFFFULL)
+    n += 1;
+  return n;
+}
+
+/** Returns the number of trailing zero bits of a non-zero 64-bit value. */
+inline uint32_t trailing_zeros(uint64_t value) {
+  assert(value != 0);
+  uint32_t n = 0;
+  if ((value & 0xFFFFFFFFULL) == 0) {
+    n += 32;
+    value >>= 32;
+  }
+  if ((value & 0xFFFFULL) == 0) {
+    n += 16;
+    value >>= 16;
+  }
+  if ((value & 0xFFULL) == 0) {
+    n += 8;
+    value >>= 8;
+  }
+  if ((value & 0xFULL) == 0) {
+    n += 4;
+    value >>= 4;
+  }
+  if ((value & 0x3ULL) == 0) {
+    n += 2;
+    value >>= 2;
+  }
+  if ((value & 0x1ULL) == 0)
+    n += 1;
+  return n;
+}
+
+/** Writes bits from the most significant bit of 64-bit words. */
+class BitWriter {
+ public:
+  /** Writes the low `nbits` bits of `value`, with `nbits` at most 64. */
+  void write(uint64_t value, uint32_t nbits) {
+    if (nbits == 0)
+      return;
+    const uint32_t free = 64 - used_;
+    if (nbits < free) {
+      word_ |= value << (free - nbits);
+      used_ += nbits;
+    } else {
+      const uint32_t rest = nbits - free;
+      word_ |= rest == 0 ? value : value >> rest;
+      words_.push_back(word_);
+      used_ = rest;
+      word_ = rest == 0 ? 0 : value << (64 - rest);
+    }
+  }
+
+  /** Returns the number of bytes written so far, in whole words. */
+  uint64_t nbytes() const {
+    return (words_.size() + (used_ > 0 ? 1 : 0)) * sizeof(uint64_t);
+  }
+
+  /** Flushes the last partial word and returns the written words. */
+  const std::vector<uint64_t>& finish() {
+    if (used_ > 0) {
+      words_.push_back(word_);
+      word_ = 0;
+      used_ = 0;
+    }
+    return words_;
+  }
+
+ private:
+  /** The complete words. */
+  std::vector<uint64_t> words_;
+
+  /** The word being written. */
+  uint64_t word_ = 0;
+
+  /** Number of bits used in the word being written. */
+  uint32_t used_ = 0;
+};
+
+/** Reads bits written by BitWriter. */
+class BitReader {
+ public:
+  /** Constructor. */
+  BitReader(const uint64_t* words, uint64_t num_words)
+      : words_(words)
+      , num_words_(num_words) {
+  }
+
+  /** Reads `nbits` bits, with `nbits` at most 64. */
+  uint64_t read(uint32_t nbits) {
+    if (nbits == 0)
+      return 0;
+    const uint32_t avail = 64 - pos_;
+    uint64_t value;
+    if (nbits <= avail) {
+      value = (word() << pos_) >> (64 - nbits);
+      pos_ += nbits;
+      if (pos_ == 64) {
+        index_++;
+        pos_ = 0;
+      }
+    } else {
+      const uint32_t rest = nbits - avail;
+      value = ((word() << pos_) >> pos_) << rest;
+      index_++;
+      value |= word() >> (64 - rest);
+      pos_ = rest;
+    }
+    return value;
+  }
+
+  /** Returns true if bits past the end of the words were read. */
+  bool overrun() const {
+    return overrun_;
+  }
+
+ private:
+  /** The words to read. */
+  const uint64_t* words_;
+
+  /** Number of words. */
+  uint64_t num_words_;
+
+  /** Index of the word being read. */
+  uint64_t index_ = 0;
+
+  /** Number of bits read from the word being read. */
+  uint32_t pos_ = 0;
+
+  /** Whether bits past the end of the words were read. */
+  bool overrun_ = false;
+
+  /** Returns the word being read, or 0 past the end of the words. */
+  uint64_t word() {
+    if (index_ < num_words_)
+      return words_[index_];
+    overrun_ = true;
+    return 0;
+  }
+};
+
+}  // namespace
+
+FloatXorFilter::FloatXorFilter()
+    : Filter(FilterType::FILTER_FLOAT_XOR) {
+}
+
+FloatXorFilter* FloatXorFilter::clone_impl() const {
+  return tdb_new(FloatXorFilter);
+}
+
+void FloatXorFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "FloatXor");
+}
+
+Status FloatXorFilter::run_forward(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  switch (tile.type()) {
+    case Datatype::FLOAT32:
+      return run_forward<uint32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::FLOAT64:
+      return run_forward<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      // XOR encoding can't work; just return the input unmodified.
+      RETURN_NOT_OK(output->append_view(input));
+      RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+      return Status::Ok();
+  }
+}
+
+template <typename U>
+Status FloatXorFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  constexpr uint32_t width = sizeof(U) * 8;
+  constexpr uint32_t field_bits = sizeof(U) == sizeof(uint32_t) ? 5 : 6;
+
+  const uint64_t input_size = input->size();
+  const uint64_t num_values = input_size / sizeof(U);
+  if (num_values == 0 || input_size > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Gather the input when it comes in multiple parts.
+  std::vector<char> gathered;
+  const char* input_data = nullptr;
+  if (input->num_buffers() == 1) {
+    ConstBuffer data(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+    input_data = static_cast<const char*>(data.data());
+  } else {
+    gathered.resize(input_size);
+    RETURN_NOT_OK(input->copy_to(gathered.data()));
+    input_data = gathered.data();
+  }
+
+  // Encode the values, stopping as soon as the encoding is as large as the
+  // input.
+  BitWriter writer;
+  U prev;
+  std::memcpy(&prev, input_data, sizeof(U));
+  writer.write(prev, width);
+  uint32_t prev_lead = 0, prev_trail = 0;
+  bool has_window = false;
+  for (uint64_t i = 1; i < num_values; i++) {
+    U value;
+    std::memcpy(&value, input_data + i * sizeof(U), sizeof(U));
+    const U x = value ^ prev;
+    prev = value;
+
+    if (x == 0) {
+      writer.write(0, 1);
+      continue;
+    }
+
+    const uint32_t lead = leading_zeros(x) - (64 - width);
+    const uint32_t trail = trailing_zeros(x);
+    if (has_window && lead >= prev_lead && trail >= prev_trail) {
+      // The meaningful bits fit in the previous window.
+      writer.write(0x2, 2);
+      writer.write(x >> prev_trail, width - prev_lead - prev_trail);
+    } else {
+      const uint32_t len = width - lead - trail;
+      writer.write(0x3, 2);
+      writer.write(lead, field_bits);
+      writer.write(len - 1, field_bits);
+      writer.write(x >> trail, len);
+      prev_lead = lead;
+      prev_trail = trail;
+      has_window = true;
+    }
+
+    if (writer.nbytes() >= input_size)
+      return forward_unencoded(
+          input_metadata, input, output_metadata, output);
+  }
+  const std::vector<uint64_t>& words = writer.finish();
+
+  // Encode only if the encoded values are smaller than the input.
+  const uint64_t stream_size = words.size() * sizeof(uint64_t);
+  const uint64_t remaining_size = input_size - num_values * sizeof(U);
+  if (stream_size + remaining_size >= input_size)
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Forward the existing metadata and write this filter's metadata.
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(
+      output_metadata->prepend_buffer(sizeof(uint8_t) + 3 * sizeof(uint32_t)));
+  const uint8_t encoded = 1;
+  const auto orig_size = static_cast<uint32_t>(input_size);
+  const auto num_values_32 = static_cast<uint32_t>(num_values);
+  const auto stream_size_32 = static_cast<uint32_t>(stream_size);
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&num_values_32, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&stream_size_32, sizeof(uint32_t)));
+
+  // Write the encoded values and the remaining bytes.
+  RETURN_NOT_OK(output->prepend_buffer(stream_size + remaining_size));
+  RETURN_NOT_OK(output->write(words.data(), stream_size));
+  RETURN_NOT_OK(output->write(
+      input_data + num_values * sizeof(U), remaining_size));
+
+  return Status::Ok();
+}
+
+Status FloatXorFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  const uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+  return Status::Ok();
+}
+
+Status FloatXorFilter::run_reverse(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  (void)config;
+
+  switch (tile.type()) {
+    case Datatype::FLOAT32:
+      return run_reverse<uint32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::FLOAT64:
+      return run_reverse<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      // XOR encoding wasn't applied; just return the input unmodified.
+      RETURN_NOT_OK(output->append_view(input));
+      RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+      return Status::Ok();
+  }
+}
+
+template <typename U>
+Status FloatXorFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  constexpr uint32_t width = sizeof(U) * 8;
+  constexpr uint32_t field_bits = sizeof(U) == sizeof(uint32_t) ? 5 : 6;
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint32_t orig_size, num_values, stream_size;
+    RETURN_NOT_OK(input_metadata->read(&orig_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&num_values, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&stream_size, sizeof(uint32_t)));
+    const uint64_t values_size = uint64_t(num_values) * sizeof(U);
+    if (num_values == 0 || values_size > orig_size ||
+        stream_size % sizeof(uint64_t) != 0)
+      return LOG_STATUS(
+          Status_FilterError("Float XOR filter error; invalid metadata"));
+
+    std::vector<uint64_t> words(stream_size / sizeof(uint64_t));
+    RETURN_NOT_OK(input->read(words.data(), stream_size));
+
+    RETURN_NOT_OK(output->prepend_buffer(orig_size));
+    Buffer* output_buf = output->buffer_ptr(0);
+    assert(output_buf != nullptr);
+    auto dest = static_cast<char*>(output_buf->cur_data());
+
+    // Decode the values.
+    BitReader reader(words.data(), words.size());
+    auto value = static_cast<U>(reader.read(width));
+    std::memcpy(dest, &value, sizeof(U));
+    uint32_t prev_lead = 0, prev_trail = 0;
+    bool has_window = false;
+    for (uint32_t i = 1; i < num_values; i++) {
+      if (reader.read(1) != 0) {
+        U x;
+        if (reader.read(1) == 0) {
+          if (!has_window)
+            return LOG_STATUS(Status_FilterError(
+                "Float XOR filter error; invalid encoded value"));
+          x = static_cast<U>(
+              reader.read(width - prev_lead - prev_trail) << prev_trail);
+        } else {
+          const auto lead = static_cast<uint32_t>(reader.read(field_bits));
+          const auto len = static_cast<uint32_t>(reader.read(field_bits)) + 1;
+          if (lead + len > width)
+            return LOG_STATUS(Status_FilterError(
+                "Float XOR filter error; invalid encoded value"));
+          prev_lead = lead;
+          prev_trail = width - lead - len;
+          has_window = true;
+          x = static_cast<U>(reader.read(len) << prev_trail);
+        }
+        value ^= x;
+      }
+      std::memcpy(dest + i * sizeof(U), &value, sizeof(U));
+    }
+    if (reader.overrun())
+      return LOG_STATUS(Status_FilterError(
+          "Float XOR filter error; encoded values are truncated"));
+
+    // Copy the remaining bytes.
+    RETURN_NOT_OK(input->read(dest + values_size, orig_size - values_size));
+
+    if (output_buf->owns_data())
+      output_buf->advance_size(orig_size);
+    output_buf->advance_offset(orig_size);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
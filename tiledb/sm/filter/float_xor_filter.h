@@ -0,0 +1,145 @@
+/**
+ * @file   float_xor_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class FloatXorFilter.
+ */
+
+#ifndef TILEDB_FLOAT_XOR_FILTER_H
+#define TILEDB_FLOAT_XOR_FILTER_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filter/filter.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that losslessly compresses an array of floating-point values by
+ * XOR-ing each value with the previous one, as in the Gorilla time series
+ * encoding. Consecutive values of smooth series share their sign, exponent
+ * and high mantissa bits, so the XOR has long runs of leading and trailing
+ * zero bits and only its meaningful bits are stored.
+ *
+ * The first value is stored in full. Each next value is stored as:
+ *   '0' - The value is equal to the previous one.
+ *   '10' - The meaningful bits of the XOR, which fit in the window of
+ *     meaningful bits of the previous XOR.
+ *   '11' - The number of leading zeros of the XOR and the number of its
+ *     meaningful bits minus one, each in 5 bits for float32 and 6 bits for
+ *     float64, followed by the meaningful bits of the XOR.
+ * The bits are written from the most significant bit of 64-bit words.
+ *
+ * Inputs that are not of datatype FLOAT32 or FLOAT64 are left unmodified. The
+ * input is also left unmodified when the encoding is not smaller than it.
+ *
+ * Input metadata is not compressed or modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded
+ * followed, when encoded, by:
+ *   uint32_t - Original input number of bytes
+ *   uint32_t - Number of encoded values
+ *   uint32_t - Number of bytes of the encoded values
+ *
+ * The forward output data format, when encoded, is:
+ *   uint64_t[] - The encoded values
+ *   uint8_t[] - The input bytes that do not form a value, unmodified
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of original values
+ */
+class FloatXorFilter : public Filter {
+ public:
+  /** Constructor. */
+  FloatXorFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  FloatXorFilter* clone_impl() const override;
+
+  /**
+   * Run_forward method templated on the unsigned integer type of the size of
+   * the tile cell datatype.
+   */
+  template <typename U>
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /**
+   * Run_reverse method templated on the unsigned integer type of the size of
+   * the tile cell datatype.
+   */
+  template <typename U>
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FLOAT_XOR_FILTER_H
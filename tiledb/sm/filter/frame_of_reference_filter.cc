@@ -0,0 +1,426 @@
+/**
+ * @file   frame_of_reference_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FrameOfReferenceFilter.
+ */
+
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Number of 64-bit words of a block packed in the given bit width. */
+constexpr uint32_t packed_words(uint32_t bit_width) {
+  return FrameOfReferenceFilter::BLOCK_SIZE * bit_width / 64;
+}
+
+/** Returns the number of significant bits of the given value. */
+inline uint8_t significant_bits(uint64_t value) {
+  uint8_t bits = 0;
+  while (value > 0) {
+    bits++;
+    value >>= 1;
+  }
+  return bits;
+}
+
+/**
+ * Unpacks a block of values packed in B bits. The bit width is a template
+ * parameter so that the loop can be fully unrolled and vectorized.
+ */
+template <typename U, uint32_t B>
+void unpack_block(const uint64_t* packed, U* out) {
+  if constexpr (B == 0) {
+    std::fill(out, out + FrameOfReferenceFilter::BLOCK_SIZE, U(0));
+  } else {
+    constexpr uint64_t mask =
+        B == 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << B) - 1;
+    for (uint32_t i = 0; i < FrameOfReferenceFilter::BLOCK_SIZE; i++) {
+      const uint32_t pos = i * B;
+      const uint32_t word = pos / 64, shift = pos % 64;
+      uint64_t value = packed[word] >> shift;
+      if (shift + B > 64)
+        value |= packed[word + 1] << (64 - shift);
+      out[i] = static_cast<U>(value & mask);
+    }
+  }
+}
+
+/** Returns the table of the block unpacking functions, by bit width. */
+template <typename U, size_t... B>
+constexpr std::array<void (*)(const uint64_t*, U*), sizeof...(B)>
+unpack_block_table(std::index_sequence<B...>) {
+  return {{&unpack_block<U, B>...}};
+}
+
+/** Unpacks a block of values packed in the given bit width. */
+template <typename U>
+void unpack(uint8_t bit_width, const uint64_t* packed, U* out) {
+  static constexpr auto table =
+      unpack_block_table<U>(std::make_index_sequence<sizeof(U) * 8 + 1>());
+  assert(bit_width < table.size());
+  table[bit_width](packed, out);
+}
+
+}  // namespace
+
+FrameOfReferenceFilter::FrameOfReferenceFilter()
+    : Filter(FilterType::FILTER_FRAME_OF_REFERENCE) {
+}
+
+FrameOfReferenceFilter* FrameOfReferenceFilter::clone_impl() const {
+  return tdb_new(FrameOfReferenceFilter);
+}
+
+void FrameOfReferenceFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "FrameOfReference");
+}
+
+Status FrameOfReferenceFilter::run_forward(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  /* Note: Arithmetic operations cannot be performed on std::byte.
+    We will use uint8_t for the Datatype::BLOB case as it is the same size as
+    std::byte and can have arithmetic perfomed on it. */
+  switch (tile.type()) {
+    case Datatype::INT8:
+      return run_forward<int8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::BLOB:
+    case Datatype::UINT8:
+      return run_forward<uint8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT16:
+      return run_forward<int16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT16:
+      return run_forward<uint16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT32:
+      return run_forward<int32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT32:
+      return run_forward<uint32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT64:
+      return run_forward<int64_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT64:
+      return run_forward<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+    case Datatype::TIME_HR:
+    case Datatype::TIME_MIN:
+    case Datatype::TIME_SEC:
+    case Datatype::TIME_MS:
+    case Datatype::TIME_US:
+    case Datatype::TIME_NS:
+    case Datatype::TIME_PS:
+    case Datatype::TIME_FS:
+    case Datatype::TIME_AS:
+      return run_forward<int64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      // Frame-of-reference encoding can't work; just return the input
+      // unmodified.
+      RETURN_NOT_OK(output->append_view(input));
+      RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+      return Status::Ok();
+  }
+}
+
+template <typename T>
+Status FrameOfReferenceFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  const uint64_t input_size = input->size();
+
+  // Gather the input when it comes in multiple parts.
+  std::vector<char> gathered;
+  const char* input_data = nullptr;
+  if (input->num_buffers() == 1) {
+    ConstBuffer data(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(input_size, &data));
+    input_data = static_cast<const char*>(data.data());
+  } else {
+    gathered.resize(input_size);
+    RETURN_NOT_OK(input->copy_to(gathered.data()));
+    input_data = gathered.data();
+  }
+
+  // In the worst case, each block is stored in its full width.
+  const uint64_t block_nbytes = BLOCK_SIZE * sizeof(T);
+  const auto num_blocks = static_cast<uint32_t>(input_size / block_nbytes);
+  const uint64_t remaining_nbytes = input_size - num_blocks * block_nbytes;
+  const uint64_t output_size_ub =
+      num_blocks * (sizeof(T) + 2 * sizeof(uint8_t) + block_nbytes) +
+      remaining_nbytes;
+
+  // Forward the existing metadata and write this filter's metadata.
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(2 * sizeof(uint32_t)));
+  const auto orig_size = static_cast<uint32_t>(input_size);
+  RETURN_NOT_OK(output_metadata->write(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&num_blocks, sizeof(uint32_t)));
+
+  // Encode each block, then copy the remaining bytes unmodified.
+  RETURN_NOT_OK(output->prepend_buffer(output_size_ub));
+  T block[BLOCK_SIZE];
+  for (uint32_t b = 0; b < num_blocks; b++) {
+    std::memcpy(block, input_data + b * block_nbytes, block_nbytes);
+    RETURN_NOT_OK(encode_block<T>(block, output));
+  }
+  RETURN_NOT_OK(output->write(
+      input_data + num_blocks * block_nbytes, remaining_nbytes));
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status FrameOfReferenceFilter::encode_block(
+    const T* values, FilterBuffer* output) const {
+  using U = typename std::make_unsigned<T>::type;
+  constexpr uint32_t width = sizeof(T) * 8;
+
+  // Compute the difference of each value from the minimum, and a histogram
+  // of the number of bits they require.
+  const T reference = *std::min_element(values, values + BLOCK_SIZE);
+  U deltas[BLOCK_SIZE];
+  uint32_t bits_histogram[width + 1] = {0};
+  for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
+    deltas[i] = static_cast<U>(U(values[i]) - U(reference));
+    bits_histogram[significant_bits(deltas[i])]++;
+  }
+
+  // Pick the bit width that minimizes the size of the packed differences
+  // and of the exceptions, preferring fewer exceptions on ties.
+  uint8_t bit_width = width;
+  uint64_t best_nbytes = packed_words(width) * sizeof(uint64_t);
+  uint32_t exception_num = 0;
+  for (uint32_t b = width; b-- > 0;) {
+    exception_num += bits_histogram[b + 1];
+    const uint64_t nbytes = packed_words(b) * sizeof(uint64_t) +
+                            exception_num * (sizeof(uint8_t) + sizeof(T));
+    if (nbytes < best_nbytes) {
+      best_nbytes = nbytes;
+      bit_width = static_cast<uint8_t>(b);
+    }
+  }
+
+  // Pack the low bits of the differences, and collect the exceptions.
+  uint64_t packed[packed_words(width)] = {0};
+  uint8_t exception_pos[BLOCK_SIZE];
+  U exception_high[BLOCK_SIZE];
+  uint8_t exceptions = 0;
+  if (bit_width > 0) {
+    const uint64_t mask = bit_width == 64 ?
+                              std::numeric_limits<uint64_t>::max() :
+                              (uint64_t(1) << bit_width) - 1;
+    for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
+      const uint64_t value = uint64_t(deltas[i]) & mask;
+      const uint32_t pos = i * bit_width;
+      const uint32_t word = pos / 64, shift = pos % 64;
+      packed[word] |= value << shift;
+      if (shift + bit_width > 64)
+        packed[word + 1] |= value >> (64 - shift);
+    }
+  }
+  if (bit_width < width) {
+    for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
+      const U high = static_cast<U>(deltas[i] >> bit_width);
+      if (high != 0) {
+        exception_pos[exceptions] = static_cast<uint8_t>(i);
+        exception_high[exceptions] = high;
+        exceptions++;
+      }
+    }
+  }
+
+  RETURN_NOT_OK(output->write(&reference, sizeof(T)));
+  RETURN_NOT_OK(output->write(&bit_width, sizeof(uint8_t)));
+  RETURN_NOT_OK(output->write(&exceptions, sizeof(uint8_t)));
+  RETURN_NOT_OK(
+      output->write(packed, packed_words(bit_width) * sizeof(uint64_t)));
+  RETURN_NOT_OK(output->write(exception_pos, exceptions * sizeof(uint8_t)));
+  RETURN_NOT_OK(output->write(exception_high, exceptions * sizeof(U)));
+
+  return Status::Ok();
+}
+
+Status FrameOfReferenceFilter::run_reverse(
+    const Tile& tile,
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output,
+    const Config& config) const {
+  (void)config;
+
+  // Decoding only depends on the size of the datatype.
+  const auto type = tile.type();
+  if (datatype_is_integer(type) || datatype_is_datetime(type) ||
+      datatype_is_time(type)) {
+    switch (datatype_size(type)) {
+      case sizeof(uint8_t):
+        return run_reverse<uint8_t>(
+            input_metadata, input, output_metadata, output);
+      case sizeof(uint16_t):
+        return run_reverse<uint16_t>(
+            input_metadata, input, output_metadata, output);
+      case sizeof(uint32_t):
+        return run_reverse<uint32_t>(
+            input_metadata, input, output_metadata, output);
+      case sizeof(uint64_t):
+        return run_reverse<uint64_t>(
+            input_metadata, input, output_metadata, output);
+      default:
+        return LOG_STATUS(
+            Status_FilterError("Cannot filter; Unsupported input type"));
+    }
+  }
+
+  // Frame-of-reference encoding wasn't applied; just return the input
+  // unmodified.
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  return Status::Ok();
+}
+
+template <typename U>
+Status FrameOfReferenceFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  constexpr uint32_t width = sizeof(U) * 8;
+
+  uint32_t orig_size, num_blocks;
+  RETURN_NOT_OK(input_metadata->read(&orig_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(input_metadata->read(&num_blocks, sizeof(uint32_t)));
+  const uint64_t block_nbytes = BLOCK_SIZE * sizeof(U);
+  if (uint64_t(num_blocks) * block_nbytes > orig_size)
+    return LOG_STATUS(Status_FilterError(
+        "Frame of reference filter error; invalid number of blocks"));
+
+  RETURN_NOT_OK(output->prepend_buffer(orig_size));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+  auto dest = static_cast<char*>(output_buf->cur_data());
+
+  // Decode each block into the output.
+  U block[BLOCK_SIZE];
+  uint64_t packed[packed_words(width)];
+  uint8_t exception_pos[BLOCK_SIZE];
+  U exception_high[BLOCK_SIZE];
+  for (uint32_t b = 0; b < num_blocks; b++) {
+    U reference;
+    uint8_t bit_width, exceptions;
+    RETURN_NOT_OK(input->read(&reference, sizeof(U)));
+    RETURN_NOT_OK(input->read(&bit_width, sizeof(uint8_t)));
+    RETURN_NOT_OK(input->read(&exceptions, sizeof(uint8_t)));
+    if (bit_width > width || exceptions > BLOCK_SIZE ||
+        (exceptions > 0 && bit_width == width))
+      return LOG_STATUS(Status_FilterError(
+          "Frame of reference filter error; invalid block header"));
+
+    RETURN_NOT_OK(
+        input->read(packed, packed_words(bit_width) * sizeof(uint64_t)));
+    RETURN_NOT_OK(input->read(exception_pos, exceptions * sizeof(uint8_t)));
+    RETURN_NOT_OK(input->read(exception_high, exceptions * sizeof(U)));
+
+    unpack<U>(bit_width, packed, block);
+    for (uint8_t e = 0; e < exceptions; e++) {
+      if (exception_pos[e] >= BLOCK_SIZE)
+        return LOG_STATUS(Status_FilterError(
+            "Frame of reference filter error; invalid exception position"));
+      block[exception_pos[e]] |= static_cast<U>(exception_high[e] << bit_width);
+    }
+    for (uint32_t i = 0; i < BLOCK_SIZE; i++)
+      block[i] = static_cast<U>(block[i] + reference);
+
+    std::memcpy(dest + b * block_nbytes, block, block_nbytes);
+  }
+
+  // Copy the remaining bytes.
+  const uint64_t blocks_nbytes = num_blocks * block_nbytes;
+  RETURN_NOT_OK(input->read(dest + blocks_nbytes, orig_size - blocks_nbytes));
+
+  if (output_buf->owns_data())
+    output_buf->advance_size(orig_size);
+  output_buf->advance_offset(orig_size);
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
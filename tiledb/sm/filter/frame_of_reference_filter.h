@@ -0,0 +1,153 @@
+/**
+ * @file   frame_of_reference_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class FrameOfReferenceFilter.
+ */
+
+#ifndef TILEDB_FRAME_OF_REFERENCE_FILTER_H
+#define TILEDB_FRAME_OF_REFERENCE_FILTER_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filter/filter.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that compresses an array of integers with frame-of-reference
+ * encoding and bit-packing with patched exceptions (PFor).
+ *
+ * The input is split into blocks of 128 elements. Each element of a block is
+ * stored as its difference from the minimum value of the block, packed in the
+ * number of bits that minimizes the size of the block. The differences that
+ * do not fit in that bit width are exceptions, whose high bits are stored
+ * separately and patched in when decoding. Decoding is specialized per bit
+ * width, so that the compiler can unroll and vectorize it.
+ *
+ * This suits integer attributes with values that are close to each other
+ * within a block, as well as the offsets of var-sized attributes. The input
+ * of other datatypes is left unmodified.
+ *
+ * Input metadata is not compressed or modified.
+ *
+ * The forward output metadata has the format:
+ *   uint32_t - Original input number of bytes
+ *   uint32_t - Number of blocks
+ *
+ * The forward output data format is the concatenated blocks, followed by the
+ * input bytes that do not fill a block, unmodified:
+ *   block0
+ *   ...
+ *   blockN
+ *   uint8_t[] - Remaining input bytes
+ * Where each block has the format:
+ *   T - Reference value, the minimum element of the block
+ *   uint8_t - Bit width B of the packed differences
+ *   uint8_t - Number E of exceptions
+ *   uint64_t[2 * B] - The low B bits of the 128 differences, packed from the
+ *     least significant bit
+ *   uint8_t[E] - Position of each exception in the block
+ *   T[E] - The bits of each exception above the low B bits
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of original elements
+ */
+class FrameOfReferenceFilter : public Filter {
+ public:
+  /** Number of elements in a block. */
+  static constexpr uint32_t BLOCK_SIZE = 128;
+
+  /** Constructor. */
+  FrameOfReferenceFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      const Tile& tile,
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output,
+      const Config& config) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  FrameOfReferenceFilter* clone_impl() const override;
+
+  /** Run_forward method templated on the tile cell datatype. */
+  template <typename T>
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /**
+   * Run_reverse method templated on the unsigned integer type of the size of
+   * the tile cell datatype.
+   */
+  template <typename U>
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /**
+   * Encodes a block of BLOCK_SIZE elements into the given output.
+   *
+   * @tparam T Tile cell datatype
+   * @param values The elements of the block.
+   * @param output Buffer to store the encoded block.
+   * @return Status
+   */
+  template <typename T>
+  Status encode_block(const T* values, FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAME_OF_REFERENCE_FILTER_H
@@ -214,19 +214,23 @@ Status PositiveDeltaFilter::encode_part(
           output->write((char*)input->data() + input->offset(), window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Encode and write the relative values to output.
+      // Encode the relative values block by block and write them to output.
       T prev_value = input->value<T>();
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T curr_value = input->value<T>();
-        if (curr_value < prev_value)
-          return LOG_STATUS(Status_FilterError(
-              "Positive delta filter error: delta is not positive."));
-
-        T delta = curr_value - prev_value;
-        RETURN_NOT_OK(output->write(&delta, sizeof(T)));
-        input->advance_offset(sizeof(T));
-
-        prev_value = curr_value;
+      T deltas[BLOCK_SIZE];
+      for (uint32_t j = 0; j < window_nelts; j += BLOCK_SIZE) {
+        const uint32_t n = std::min(BLOCK_SIZE, window_nelts - j);
+        const T* values = reinterpret_cast<const T*>(
+            static_cast<const char*>(input->data()) + input->offset());
+        for (uint32_t k = 0; k < n; k++) {
+          if (values[k] < prev_value)
+            return LOG_STATUS(Status_FilterError(
+                "Positive delta filter error: delta is not positive."));
+          deltas[k] = values[k] - prev_value;
+          prev_value = values[k];
+        }
+
+        RETURN_NOT_OK(output->write(deltas, n * sizeof(T)));
+        input->advance_offset(n * sizeof(T));
       }
     }
   }
@@ -340,16 +344,19 @@ Status PositiveDeltaFilter::run_reverse(
       RETURN_NOT_OK(output->write(input, window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Read and decode each window value.
+      // Read the window values block by block and decode them with a
+      // prefix sum.
       uint32_t window_nelts = window_nbytes / sizeof(T);
       T prev_value = window_value_offset;
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T delta;
-        RETURN_NOT_OK(input->read(&delta, sizeof(T)));
-        T decoded_value = prev_value + delta;
-        RETURN_NOT_OK(output->write(&decoded_value, tile_type_size));
-
-        prev_value = decoded_value;
+      T values[BLOCK_SIZE];
+      for (uint32_t j = 0; j < window_nelts; j += BLOCK_SIZE) {
+        const uint32_t n = std::min(BLOCK_SIZE, window_nelts - j);
+        RETURN_NOT_OK(input->read(values, n * sizeof(T)));
+        for (uint32_t k = 0; k < n; k++) {
+          prev_value = static_cast<T>(prev_value + values[k]);
+          values[k] = prev_value;
+        }
+        RETURN_NOT_OK(output->write(values, n * sizeof(T)));
       }
     }
   }
@@ -73,6 +73,9 @@ namespace sm {
  */
 class PositiveDeltaFilter : public Filter {
  public:
+  /** Number of elements encoded or decoded at a time within a window. */
+  static constexpr uint32_t BLOCK_SIZE = 128;
+
   /** Constructor. */
   PositiveDeltaFilter();
 
@@ -26,10 +26,12 @@
  * THE SOFTWARE.
  */
 
+#include "../checksum_crc32c_filter.h"
 #include "../checksum_md5_filter.h"
 #include "../checksum_sha256_filter.h"
 
 int main() {
+  (void)sizeof(tiledb::sm::ChecksumCRC32CFilter);
   (void)sizeof(tiledb::sm::ChecksumMD5Filter);
   (void)sizeof(tiledb::sm::ChecksumSHA256Filter);
   return 0;
@@ -34,6 +34,7 @@
 #include "../bit_width_reduction_filter.h"
 #include "../bitshuffle_filter.h"
 #include "../byteshuffle_filter.h"
+#include "../checksum_crc32c_filter.h"
 #include "../checksum_md5_filter.h"
 #include "../checksum_sha256_filter.h"
 #include "../compression_filter.h"
@@ -149,6 +150,39 @@ TEST_CASE(
   CHECK(filter1.value()->type() == filtertype0);
 }
 
+TEST_CASE(
+    "Filter: Test checksum crc32c filter deserialization",
+    "[filter][checksum-crc32c]") {
+  FilterType filtertype0 = FilterType::FILTER_CHECKSUM_CRC32C;
+  char serialized_buffer[5];
+  char* p = &serialized_buffer[0];
+  buffer_offset<uint8_t, 0>(p) = static_cast<uint8_t>(filtertype0);
+  buffer_offset<uint32_t, 1>(p) = 0;  // metadata_length
+
+  ConstBuffer constbuffer(&serialized_buffer, sizeof(serialized_buffer));
+  auto&& [st_filter, filter1]{FilterCreate::deserialize(&constbuffer)};
+  REQUIRE(st_filter.ok());
+
+  // Check type
+  CHECK(filter1.value()->type() == filtertype0);
+}
+
+TEST_CASE(
+    "Filter: Test bitmap filter deserialization", "[filter][bitmap]") {
+  FilterType filtertype0 = FilterType::FILTER_BITMAP;
+  char serialized_buffer[5];
+  char* p = &serialized_buffer[0];
+  buffer_offset<uint8_t, 0>(p) = static_cast<uint8_t>(filtertype0);
+  buffer_offset<uint32_t, 1>(p) = 0;  // metadata_length
+
+  ConstBuffer constbuffer(&serialized_buffer, sizeof(serialized_buffer));
+  auto&& [st_filter, filter1]{FilterCreate::deserialize(&constbuffer)};
+  REQUIRE(st_filter.ok());
+
+  // Check type
+  CHECK(filter1.value()->type() == filtertype0);
+}
+
 TEST_CASE(
     "Filter: Test encryption aes256gcm filter deserialization",
     "[filter][encryption-aes256gcm]") {
@@ -0,0 +1,151 @@
+/**
+ * @file   bloom_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class BloomFilter.
+ */
+
+#include "tiledb/sm/fragment/bloom_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+BloomFilter::BloomFilter()
+    : hash_num_(0) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void BloomFilter::init(uint64_t item_num, uint64_t bits_per_item) {
+  // The number of hashes that minimizes the false positive rate is
+  // `bits_per_item * ln(2)`
+  hash_num_ = (uint32_t)std::lround(bits_per_item * 0.69);
+  hash_num_ = std::min(std::max(hash_num_, 1u), 30u);
+
+  auto bit_num = std::max(item_num * bits_per_item, (uint64_t)64);
+  words_.assign((bit_num + 63) / 64, 0);
+}
+
+void BloomFilter::add(uint64_t hash) {
+  for (uint32_t i = 0; i < hash_num_; ++i) {
+    auto b = bit(hash, i);
+    words_[b / 64] |= (uint64_t)1 << (b % 64);
+  }
+}
+
+bool BloomFilter::may_contain(uint64_t hash) const {
+  for (uint32_t i = 0; i < hash_num_; ++i) {
+    auto b = bit(hash, i);
+    if (!(words_[b / 64] & ((uint64_t)1 << (b % 64))))
+      return false;
+  }
+
+  return true;
+}
+
+bool BloomFilter::empty() const {
+  return words_.empty();
+}
+
+uint64_t BloomFilter::size() const {
+  return words_.size() * sizeof(uint64_t);
+}
+
+// ===== FORMAT =====
+// hash_num (uint32_t)
+// word_num (uint64_t)
+// word#1 (uint64_t) ... word#<word_num> (uint64_t)
+Status BloomFilter::serialize(Buffer* buff) const {
+  uint64_t word_num = words_.size();
+  RETURN_NOT_OK(buff->write(&hash_num_, sizeof(uint32_t)));
+  RETURN_NOT_OK(buff->write(&word_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(words_.data(), word_num * sizeof(uint64_t)));
+
+  return Status::Ok();
+}
+
+Status BloomFilter::deserialize(ConstBuffer* cbuff) {
+  uint64_t word_num;
+  RETURN_NOT_OK(cbuff->read(&hash_num_, sizeof(uint32_t)));
+  RETURN_NOT_OK(cbuff->read(&word_num, sizeof(uint64_t)));
+  if (word_num > cbuff->nbytes_left_to_read() / sizeof(uint64_t))
+    return Status_FragmentMetadataError(
+        "Cannot deserialize Bloom filter; Buffer too small");
+  words_.resize(word_num);
+  RETURN_NOT_OK(cbuff->read(words_.data(), word_num * sizeof(uint64_t)));
+
+  // A filter that sets no bits would reject every item
+  if (hash_num_ == 0)
+    words_.clear();
+
+  return Status::Ok();
+}
+
+uint64_t BloomFilter::hash(const void* data, uint64_t size, uint64_t seed) {
+  // FNV-1a, followed by the SplitMix64 finalizer to spread the bits
+  auto bytes = static_cast<const uint8_t*>(data);
+  uint64_t h = 14695981039346656037ULL ^ seed;
+  for (uint64_t i = 0; i < size; ++i) {
+    h ^= bytes[i];
+    h *= 1099511628211ULL;
+  }
+
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+
+  return h;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+uint64_t BloomFilter::bit(uint64_t hash, uint32_t i) const {
+  uint64_t h1 = hash;
+  uint64_t h2 = (hash >> 32) | (hash << 32) | 1;
+  return (h1 + i * h2) % (words_.size() * 64);
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,148 @@
+/**
+ * @file  bloom_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class BloomFilter.
+ */
+
+#ifndef TILEDB_BLOOM_FILTER_H
+#define TILEDB_BLOOM_FILTER_H
+
+#include <vector>
+
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Buffer;
+class ConstBuffer;
+
+/**
+ * A Bloom filter over 64-bit item hashes. It answers whether an item may
+ * have been added to the filter, with no false negatives and a false
+ * positive rate determined by the number of bits allotted per item.
+ *
+ * Sparse fragments use it over the hashes of their cell coordinates, so
+ * that point lookups can skip fragments that cannot contain the point.
+ */
+class BloomFilter {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. Creates an empty filter that contains every item. */
+  BloomFilter();
+
+  /** Copy constructor. */
+  BloomFilter(const BloomFilter&) = default;
+
+  /** Move constructor. */
+  BloomFilter(BloomFilter&&) = default;
+
+  /** Destructor. */
+  ~BloomFilter() = default;
+
+  /** Copy-assign operator. */
+  BloomFilter& operator=(const BloomFilter&) = default;
+
+  /** Move-assign operator. */
+  BloomFilter& operator=(BloomFilter&&) = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Sizes the filter for the input number of items, clearing its contents.
+   *
+   * @param item_num The number of items that will be added.
+   * @param bits_per_item The number of bits allotted per item. Ten bits per
+   *     item give a false positive rate of about 1%.
+   */
+  void init(uint64_t item_num, uint64_t bits_per_item);
+
+  /** Adds an item, given its hash. */
+  void add(uint64_t hash);
+
+  /**
+   * Returns `false` if the item with the input hash was certainly not
+   * added to the filter. An empty filter may contain every item.
+   */
+  bool may_contain(uint64_t hash) const;
+
+  /** Returns `true` if the filter has not been initialized. */
+  bool empty() const;
+
+  /** Returns the size of the filter bits in bytes. */
+  uint64_t size() const;
+
+  /** Serializes the filter into the input buffer. */
+  Status serialize(Buffer* buff) const;
+
+  /** Deserializes the filter from the input buffer. */
+  Status deserialize(ConstBuffer* cbuff);
+
+  /**
+   * Hashes the input bytes, chaining from `seed`. The hash is stable across
+   * platforms, as it is persisted with the filter. Multi-dimensional
+   * coordinates are hashed by passing the hash of each dimension as the
+   * seed of the next one.
+   */
+  static uint64_t hash(const void* data, uint64_t size, uint64_t seed = 0);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of bits set per item. */
+  uint32_t hash_num_;
+
+  /** The filter bits, packed in words. */
+  std::vector<uint64_t> words_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Returns the position of the `i`-th bit of the item with the input
+   * hash, using double hashing.
+   */
+  uint64_t bit(uint64_t hash, uint32_t i) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BLOOM_FILTER_H
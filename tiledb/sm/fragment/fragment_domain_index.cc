@@ -0,0 +1,270 @@
+/**
+ * @file   fragment_domain_index.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FragmentDomainIndex.
+ */
+
+#include "tiledb/sm/fragment/fragment_domain_index.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+FragmentDomainIndex::FragmentDomainIndex(
+    const Domain* const domain,
+    const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata) {
+  const unsigned dim_num = domain->dim_num();
+  dims_.resize(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim_index = &dims_[d];
+    dim_index->type_ = domain->dimension(d)->type();
+    switch (dim_index->type_) {
+      case Datatype::INT8:
+        build<int8_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::UINT8:
+        build<uint8_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::INT16:
+        build<int16_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::UINT16:
+        build<uint16_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::INT32:
+        build<int32_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::UINT32:
+        build<uint32_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::INT64:
+        build<int64_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::UINT64:
+        build<uint64_t>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::FLOAT32:
+        build<float>(d, fragment_metadata, dim_index);
+        break;
+      case Datatype::FLOAT64:
+        build<double>(d, fragment_metadata, dim_index);
+        break;
+      default:
+        if (datatype_is_datetime(dim_index->type_) ||
+            datatype_is_time(dim_index->type_))
+          build<int64_t>(d, fragment_metadata, dim_index);
+        break;
+    }
+  }
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+bool FragmentDomainIndex::indexed(unsigned dim_idx) const {
+  return dims_[dim_idx].indexed_;
+}
+
+void FragmentDomainIndex::mark_overlapping(
+    unsigned dim_idx,
+    const Range& range,
+    std::vector<uint8_t>* const frag_bytemap) const {
+  const auto& dim_index = dims_[dim_idx];
+  assert(dim_index.indexed_);
+  const uint64_t frag_num = dim_index.frag_idx_.size();
+
+  switch (dim_index.type_) {
+    case Datatype::INT8: {
+      auto r = (const int8_t*)range.data();
+      mark_overlapping<int8_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::UINT8: {
+      auto r = (const uint8_t*)range.data();
+      mark_overlapping<uint8_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::INT16: {
+      auto r = (const int16_t*)range.data();
+      mark_overlapping<int16_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::UINT16: {
+      auto r = (const uint16_t*)range.data();
+      mark_overlapping<uint16_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::INT32: {
+      auto r = (const int32_t*)range.data();
+      mark_overlapping<int32_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::UINT32: {
+      auto r = (const uint32_t*)range.data();
+      mark_overlapping<uint32_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::UINT64: {
+      auto r = (const uint64_t*)range.data();
+      mark_overlapping<uint64_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::FLOAT32: {
+      auto r = (const float*)range.data();
+      mark_overlapping<float>(dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    case Datatype::FLOAT64: {
+      auto r = (const double*)range.data();
+      mark_overlapping<double>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+    default: {
+      // INT64, datetime and time dimensions
+      auto r = (const int64_t*)range.data();
+      mark_overlapping<int64_t>(
+          dim_index, r[0], r[1], 0, frag_num, frag_bytemap);
+      break;
+    }
+  }
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T>
+void FragmentDomainIndex::build(
+    const unsigned dim_idx,
+    const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata,
+    DimIndex* const dim_index) {
+  const uint64_t frag_num = fragment_metadata.size();
+
+  // Sort the fragments by the start of their non-empty domain
+  auto& frag_idx = dim_index->frag_idx_;
+  frag_idx.resize(frag_num);
+  std::iota(frag_idx.begin(), frag_idx.end(), 0);
+  auto start = [&](unsigned f) {
+    return ((const T*)fragment_metadata[f]->non_empty_domain()[dim_idx].data())
+        [0];
+  };
+  std::stable_sort(
+      frag_idx.begin(), frag_idx.end(), [&](unsigned a, unsigned b) {
+        return start(a) < start(b);
+      });
+
+  dim_index->starts_.resize(frag_num * sizeof(T));
+  dim_index->ends_.resize(frag_num * sizeof(T));
+  dim_index->max_ends_.resize(frag_num * sizeof(T));
+  auto starts = (T*)dim_index->starts_.data();
+  auto ends = (T*)dim_index->ends_.data();
+  for (uint64_t i = 0; i < frag_num; ++i) {
+    auto r = (const T*)fragment_metadata[frag_idx[i]]
+                 ->non_empty_domain()[dim_idx]
+                 .data();
+    starts[i] = r[0];
+    ends[i] = r[1];
+  }
+
+  if (frag_num > 0)
+    build_max_ends<T>(ends, (T*)dim_index->max_ends_.data(), 0, frag_num);
+  dim_index->indexed_ = true;
+}
+
+template <class T>
+T FragmentDomainIndex::build_max_ends(
+    const T* const ends, T* const max_ends, uint64_t lo, uint64_t hi) {
+  const uint64_t mid = lo + (hi - lo) / 2;
+  T max_end = ends[mid];
+  if (lo < mid)
+    max_end = std::max(max_end, build_max_ends<T>(ends, max_ends, lo, mid));
+  if (mid + 1 < hi)
+    max_end =
+        std::max(max_end, build_max_ends<T>(ends, max_ends, mid + 1, hi));
+  max_ends[mid] = max_end;
+  return max_end;
+}
+
+template <class T>
+void FragmentDomainIndex::mark_overlapping(
+    const DimIndex& dim_index,
+    const T start,
+    const T end,
+    uint64_t lo,
+    uint64_t hi,
+    std::vector<uint8_t>* const frag_bytemap) {
+  auto starts = (const T*)dim_index.starts_.data();
+  auto ends = (const T*)dim_index.ends_.data();
+  auto max_ends = (const T*)dim_index.max_ends_.data();
+
+  // Descend to the right iteratively, recursing only to the left
+  while (lo < hi) {
+    const uint64_t mid = lo + (hi - lo) / 2;
+
+    // No interval of this subtree ends at or after the range start
+    if (max_ends[mid] < start)
+      return;
+
+    mark_overlapping<T>(dim_index, start, end, lo, mid, frag_bytemap);
+
+    // This and all the following intervals start after the range end
+    if (starts[mid] > end)
+      return;
+
+    if (ends[mid] >= start)
+      (*frag_bytemap)[dim_index.frag_idx_[mid]] = 1;
+
+    lo = mid + 1;
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,174 @@
+/**
+ * @file  fragment_domain_index.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2021 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FragmentDomainIndex.
+ */
+
+#ifndef TILEDB_FRAGMENT_DOMAIN_INDEX_H
+#define TILEDB_FRAGMENT_DOMAIN_INDEX_H
+
+#include <vector>
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/macros.h"
+#include "tiledb/sm/misc/types.h"
+
+namespace tiledb {
+namespace sm {
+
+class Domain;
+class FragmentMetadata;
+enum class Datatype : uint8_t;
+
+/**
+ * An index over the non-empty domains of the fragments of an open array,
+ * which finds the fragments overlapping a range on one dimension in time
+ * logarithmic in the number of fragments (plus the number of fragments
+ * found), instead of testing every fragment.
+ *
+ * For every fixed-sized dimension, the fragment intervals are sorted by
+ * their start and laid out as an implicit balanced binary search tree,
+ * where the node of a subarray `[lo, hi)` is its middle element and stores
+ * the maximum interval end in the subarray. Var-sized dimensions are not
+ * indexed.
+ */
+class FragmentDomainIndex {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor. Builds the index over the non-empty domains of the input
+   * fragments.
+   *
+   * @param domain The array domain.
+   * @param fragment_metadata The fragments of the open array.
+   */
+  FragmentDomainIndex(
+      const Domain* domain,
+      const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata);
+
+  DISABLE_COPY_AND_COPY_ASSIGN(FragmentDomainIndex);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(FragmentDomainIndex);
+
+  /** Destructor. */
+  ~FragmentDomainIndex() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns `true` if the input dimension is indexed. */
+  bool indexed(unsigned dim_idx) const;
+
+  /**
+   * Sets to 1 the bytes of `frag_bytemap` for the fragments whose non-empty
+   * domain on the input indexed dimension overlaps `range`.
+   *
+   * @param dim_idx The dimension index.
+   * @param range The range to check for overlap.
+   * @param frag_bytemap A byte per fragment of the open array.
+   */
+  void mark_overlapping(
+      unsigned dim_idx,
+      const Range& range,
+      std::vector<uint8_t>* frag_bytemap) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The index of a dimension. */
+  struct DimIndex {
+    /** The dimension datatype. */
+    Datatype type_;
+
+    /** Whether the dimension is indexed. */
+    bool indexed_ = false;
+
+    /** The fragment indexes, sorted by non-empty domain start. */
+    std::vector<unsigned> frag_idx_;
+
+    /** The sorted non-empty domain starts, as an array of the type. */
+    std::vector<uint8_t> starts_;
+
+    /** The non-empty domain ends, as an array of the type. */
+    std::vector<uint8_t> ends_;
+
+    /** The maximum end in the subtree of every node. */
+    std::vector<uint8_t> max_ends_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The index of each dimension. */
+  std::vector<DimIndex> dims_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Builds the index of a dimension of type `T`. */
+  template <class T>
+  void build(
+      unsigned dim_idx,
+      const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata,
+      DimIndex* dim_index);
+
+  /**
+   * Computes the maximum ends of the subtree rooted at the middle of
+   * `[lo, hi)`, returning it.
+   */
+  template <class T>
+  static T build_max_ends(
+      const T* ends, T* max_ends, uint64_t lo, uint64_t hi);
+
+  /**
+   * Marks the fragments in `[lo, hi)` whose interval overlaps
+   * `[start, end]`.
+   */
+  template <class T>
+  static void mark_overlapping(
+      const DimIndex& dim_index,
+      T start,
+      T end,
+      uint64_t lo,
+      uint64_t hi,
+      std::vector<uint8_t>* frag_bytemap);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAGMENT_DOMAIN_INDEX_H
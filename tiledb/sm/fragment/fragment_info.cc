@@ -48,7 +48,8 @@ using namespace tiledb::common;
 
 FragmentInfo::FragmentInfo()
     : storage_manager_(nullptr)
-    , unconsolidated_metadata_num_(0) {
+    , unconsolidated_metadata_num_(0)
+    , timestamp_end_now_(false) {
 }
 
 FragmentInfo::FragmentInfo(
@@ -56,7 +57,8 @@ FragmentInfo::FragmentInfo(
     : array_uri_(array_uri)
     , config_(storage_manager->config())
     , storage_manager_(storage_manager)
-    , unconsolidated_metadata_num_(0) {
+    , unconsolidated_metadata_num_(0)
+    , timestamp_end_now_(false) {
 }
 
 FragmentInfo::~FragmentInfo() = default;
@@ -813,6 +815,7 @@ Status FragmentInfo::load(
   }
 
   // Set the timestamp range
+  timestamp_end_now_ = set_timestamp_range_from_config;
   if (set_timestamp_range_from_config) {
     RETURN_NOT_OK(this->set_timestamp_range_from_config());
   }
@@ -833,10 +836,11 @@ Status FragmentInfo::load(
   auto fragment_num = (uint32_t)fragment_metadata.value().size();
   const auto& fragment_metadata_v = fragment_metadata.value();
 
-  // Get fragment sizes
+  // Get fragment sizes. This lists the fragment files, so it runs on the io
+  // thread pool.
   std::vector<uint64_t> sizes(fragment_num, 0);
   RETURN_NOT_OK(parallel_for(
-      storage_manager_->compute_tp(),
+      storage_manager_->io_tp(),
       0,
       fragment_num,
       [this, &fragment_metadata_v, &sizes](uint64_t i) {
@@ -892,10 +896,9 @@ Status FragmentInfo::load(
   to_vacuum_.clear();
 
   // Get the URIs to vacuum
-  std::vector<URI> vac_uris, fragment_uris;
-  URI meta_uri;
+  std::vector<URI> vac_uris, fragment_uris, meta_uris;
   RETURN_NOT_OK(storage_manager_->get_fragment_uris(
-      array_uri_, &fragment_uris, &meta_uri));
+      array_uri_, &fragment_uris, &meta_uris));
   RETURN_NOT_OK(storage_manager_->get_uris_to_vacuum(
       fragment_uris, timestamp_start_, timestamp_end_, &to_vacuum_, &vac_uris));
 
@@ -921,6 +924,82 @@ Status FragmentInfo::load_and_replace(
   return Status::Ok();
 }
 
+Status FragmentInfo::refresh() {
+  if (array_schemas_all_.empty())
+    return LOG_STATUS(Status_FragmentInfoError(
+        "Cannot refresh fragment info; Fragment info is not loaded"));
+
+  // The metadata of a new fragment is loaded with the latest array schema
+  // of the loaded fragments, so start over if there are none.
+  if (single_fragment_info_vec_.empty())
+    return load(timestamp_end_now_, false, false);
+
+  if (timestamp_end_now_)
+    timestamp_end_ = utils::time::timestamp_now_ms();
+
+  // Get the fragments in the timestamp range.
+  std::vector<URI> fragment_uris, meta_uris;
+  RETURN_NOT_OK(storage_manager_->get_fragment_uris(
+      array_uri_, &fragment_uris, &meta_uris));
+  std::vector<TimestampedURI> sorted_uris;
+  RETURN_NOT_OK(storage_manager_->get_sorted_uris(
+      fragment_uris, &sorted_uris, timestamp_start_, timestamp_end_));
+
+  // Keep the info of the loaded fragments, and find the new ones.
+  std::unordered_map<std::string, size_t> loaded;
+  for (size_t i = 0; i < single_fragment_info_vec_.size(); ++i)
+    loaded[single_fragment_info_vec_[i].uri().to_string()] = i;
+  std::vector<std::optional<SingleFragmentInfo>> infos(sorted_uris.size());
+  std::vector<size_t> new_fragments;
+  for (size_t i = 0; i < sorted_uris.size(); ++i) {
+    auto it = loaded.find(sorted_uris[i].uri_.to_string());
+    if (it != loaded.end())
+      infos[i] = single_fragment_info_vec_[it->second];
+    else
+      new_fragments.emplace_back(i);
+  }
+
+  // A new fragment may have been written with a new array schema.
+  if (!new_fragments.empty()) {
+    auto&& [st, array_schema_latest, array_schemas_all] =
+        storage_manager_->load_array_schemas(array_uri_, enc_key_);
+    RETURN_NOT_OK(st);
+    (void)array_schema_latest;  // Not needed here
+    array_schemas_all_ = std::move(array_schemas_all.value());
+  }
+
+  // Load the new fragments. This reads their footers and sizes, so it runs
+  // on the io thread pool.
+  RETURN_NOT_OK(parallel_for(
+      storage_manager_->io_tp(),
+      0,
+      new_fragments.size(),
+      [this, &sorted_uris, &new_fragments, &infos](uint64_t i) {
+        const auto idx = new_fragments[i];
+        auto&& [st, info] = load(sorted_uris[idx].uri_);
+        RETURN_NOT_OK(st);
+        infos[idx] = std::move(info);
+        return Status::Ok();
+      }));
+
+  single_fragment_info_vec_.clear();
+  single_fragment_info_vec_.reserve(infos.size());
+  for (auto& info : infos)
+    single_fragment_info_vec_.emplace_back(std::move(info.value()));
+
+  // Get the URIs to vacuum
+  std::vector<URI> vac_uris;
+  RETURN_NOT_OK(storage_manager_->get_uris_to_vacuum(
+      fragment_uris, timestamp_start_, timestamp_end_, &to_vacuum_, &vac_uris));
+
+  // Get number of unconsolidated fragment metadata
+  unconsolidated_metadata_num_ = 0;
+  for (const auto& f : single_fragment_info_vec_)
+    unconsolidated_metadata_num_ += (uint32_t)!f.has_consolidated_footer();
+
+  return Status::Ok();
+}
+
 const std::vector<SingleFragmentInfo>& FragmentInfo::single_fragment_info_vec()
     const {
   return single_fragment_info_vec_;
@@ -1080,6 +1159,7 @@ FragmentInfo FragmentInfo::clone() const {
   clone.anterior_ndrange_ = anterior_ndrange_;
   clone.timestamp_start_ = timestamp_start_;
   clone.timestamp_end_ = timestamp_end_;
+  clone.timestamp_end_now_ = timestamp_end_now_;
 
   return clone;
 }
@@ -1096,4 +1176,5 @@ void FragmentInfo::swap(FragmentInfo& fragment_info) {
   std::swap(anterior_ndrange_, fragment_info.anterior_ndrange_);
   std::swap(timestamp_start_, fragment_info.timestamp_start_);
   std::swap(timestamp_end_, fragment_info.timestamp_end_);
+  std::swap(timestamp_end_now_, fragment_info.timestamp_end_now_);
 }
@@ -301,6 +301,17 @@ class FragmentInfo {
       const URI& new_fragment_uri,
       const std::vector<TimestampedURI>& to_replace);
 
+  /**
+   * Refreshes the loaded fragment info with the fragments written, and
+   * removed, since it was loaded. The metadata of the new fragments is
+   * loaded in parallel, and that of the others is kept. If the timestamp
+   * range was not given explicitly, its end is moved to the current time.
+   * The non-empty domain before the start time is not recomputed.
+   *
+   * @return Status
+   */
+  Status refresh();
+
   /** Returns the vector with the info about individual fragments. */
   const std::vector<SingleFragmentInfo>& single_fragment_info_vec() const;
 
@@ -361,6 +372,12 @@ class FragmentInfo {
   /** Timestamp end used in load. */
   uint64_t timestamp_end_;
 
+  /**
+   * Whether `timestamp_end_` was set to the time of the load, in which case
+   * `refresh()` moves it to the time of the refresh.
+   */
+  bool timestamp_end_now_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -36,6 +36,7 @@
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/common/memory_tracker.h"
+#include "tiledb/common/stdx_string.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/array_schema/dimension.h"
@@ -43,7 +44,10 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/fragment/fragment_parts.h"
+#include "tiledb/sm/fragment/packed_fragment.h"
 #include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -51,6 +55,7 @@
 #include "tiledb/sm/tile/tile.h"
 #include "tiledb/sm/tile/tile_metadata_generator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -82,6 +87,7 @@ FragmentMetadata::FragmentMetadata(
     , last_tile_cell_num_(0)
     , sparse_tile_num_(0)
     , meta_file_size_(0)
+    , meta_base_(0)
     , rtree_(RTree(array_schema_->domain(), constants::rtree_fanout))
     , tile_index_base_(0)
     , version_(array_schema_->write_version())
@@ -103,6 +109,12 @@ FragmentMetadata::FragmentMetadata(const FragmentMetadata& other) {
   has_consolidated_footer_ = other.has_consolidated_footer_;
   rtree_ = other.rtree_;
   meta_file_size_ = other.meta_file_size_;
+  packed_ = other.packed_;
+  meta_base_ = other.meta_base_;
+  packed_offsets_ = other.packed_offsets_;
+  packed_var_offsets_ = other.packed_var_offsets_;
+  packed_validity_offsets_ = other.packed_validity_offsets_;
+  parts_ = other.parts_;
   version_ = other.version_;
   tile_index_base_ = other.tile_index_base_;
   sparse_tile_num_ = other.sparse_tile_num_;
@@ -122,6 +134,12 @@ FragmentMetadata& FragmentMetadata::operator=(const FragmentMetadata& other) {
   has_consolidated_footer_ = other.has_consolidated_footer_;
   rtree_ = other.rtree_;
   meta_file_size_ = other.meta_file_size_;
+  packed_ = other.packed_;
+  meta_base_ = other.meta_base_;
+  packed_offsets_ = other.packed_offsets_;
+  packed_var_offsets_ = other.packed_var_offsets_;
+  packed_validity_offsets_ = other.packed_validity_offsets_;
+  parts_ = other.parts_;
   version_ = other.version_;
   tile_index_base_ = other.tile_index_base_;
   sparse_tile_num_ = other.sparse_tile_num_;
@@ -145,10 +163,45 @@ Status FragmentMetadata::set_mbr(uint64_t tile, const NDRange& mbr) {
   return expand_non_empty_domain(mbr);
 }
 
+void FragmentMetadata::add_coords_hashes(
+    const std::vector<uint64_t>& hashes, uint64_t bits_per_cell) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  coords_hashes_.insert(coords_hashes_.end(), hashes.begin(), hashes.end());
+  coords_bloom_filter_bits_per_cell_ = bits_per_cell;
+}
+
+void FragmentMetadata::set_attribute_index(
+    const std::string& name, uint64_t tid, BloomFilter&& filter) {
+  tid += tile_index_base_;
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto& filters = attribute_index_[name];
+  if (tid >= filters.size())
+    filters.resize(tid + 1);
+  filters[tid] = std::move(filter);
+}
+
+const BloomFilter* FragmentMetadata::attribute_index(
+    const std::string& name, uint64_t tile_idx) const {
+  auto it = attribute_index_.find(name);
+  if (it == attribute_index_.end() || tile_idx >= it->second.size())
+    return nullptr;
+  return &it->second[tile_idx];
+}
+
 void FragmentMetadata::set_tile_index_base(uint64_t tile_base) {
   tile_index_base_ = tile_base;
 }
 
+void FragmentMetadata::add_part(uint32_t id, uint64_t first_tile) {
+  FragmentPart part;
+  part.id_ = id;
+  part.first_tile_ = first_tile;
+  part.offsets_ = file_sizes_;
+  part.var_offsets_ = file_var_sizes_;
+  part.validity_offsets_ = file_validity_sizes_;
+  parts_.emplace_back(std::move(part));
+}
+
 void FragmentMetadata::set_tile_offset(
     const std::string& name, uint64_t tid, uint64_t step) {
   auto it = idx_map_.find(name);
@@ -156,6 +209,19 @@ void FragmentMetadata::set_tile_offset(
   auto idx = it->second;
   tid += tile_index_base_;
   assert(tid < tile_offsets_[idx].size());
+
+  // The attributes of a group share a file, whose size is kept for all of
+  // them
+  auto group = array_schema_->attribute_group(name);
+  if (group.has_value()) {
+    const auto& names = array_schema_->attribute_groups()[*group];
+    tile_offsets_[idx][tid] = file_sizes_[idx];
+    const auto file_size = file_sizes_[idx] + step;
+    for (const auto& n : names)
+      file_sizes_[idx_map_[n]] = file_size;
+    return;
+  }
+
   tile_offsets_[idx][tid] = file_sizes_[idx];
   file_sizes_[idx] += step;
 }
@@ -553,6 +619,15 @@ Status FragmentMetadata::fragment_size(uint64_t* size) const {
   *size = 0;
   for (const auto& file_size : file_sizes_)
     *size += file_size;
+
+  // The attributes of a group share a file, count it once
+  for (const auto& group : array_schema_->attribute_groups()) {
+    for (size_t i = 1; i < group.size(); ++i) {
+      auto it = idx_map_.find(group[i]);
+      assert(it != idx_map_.end());
+      *size -= file_sizes_[it->second];
+    }
+  }
   for (const auto& file_var_size : file_var_sizes_)
     *size += file_var_size;
   for (const auto& file_validity_size : file_validity_sizes_)
@@ -562,10 +637,8 @@ Status FragmentMetadata::fragment_size(uint64_t* size) const {
   // metadata
   uint64_t meta_file_size = meta_file_size_;
   if (meta_file_size == 0) {
-    auto meta_uri = fragment_uri_.join_path(
-        std::string(constants::fragment_metadata_filename));
     RETURN_NOT_OK(
-        storage_manager_->vfs()->file_size(meta_uri, &meta_file_size));
+        storage_manager_->vfs()->file_size(meta_uri(), &meta_file_size));
   }
   // Validate that the meta_file_size is not zero, either preloaded or fetched
   // above
@@ -585,6 +658,10 @@ bool FragmentMetadata::has_consolidated_footer() const {
   return has_consolidated_footer_;
 }
 
+bool FragmentMetadata::packed() const {
+  return packed_ != nullptr;
+}
+
 bool FragmentMetadata::overlaps_non_empty_domain(const NDRange& range) const {
   return array_schema_->domain()->overlap(range, non_empty_domain_);
 }
@@ -592,10 +669,89 @@ bool FragmentMetadata::overlaps_non_empty_domain(const NDRange& range) const {
 Status FragmentMetadata::get_tile_overlap(
     const NDRange& range, TileOverlap* tile_overlap) {
   assert(version_ <= 2 || loaded_metadata_.rtree_);
+  if (!may_contain_point(range)) {
+    storage_manager_->stats()->add_counter("read_bloom_filter_skip_num", 1);
+    *tile_overlap = TileOverlap();
+    return Status::Ok();
+  }
+
   *tile_overlap = rtree_.get_tile_overlap(range);
   return Status::Ok();
 }
 
+Status FragmentMetadata::get_tile_overlap(
+    const std::vector<NDRange>& ranges,
+    ThreadPool* compute_tp,
+    std::vector<TileOverlap>* tile_overlaps) {
+  assert(version_ <= 2 || loaded_metadata_.rtree_);
+  tile_overlaps->clear();
+  tile_overlaps->resize(ranges.size());
+
+  // Leave out the points ruled out by the Bloom filter
+  std::vector<NDRange> batch;
+  std::vector<uint64_t> batch_idx;
+  batch.reserve(ranges.size());
+  batch_idx.reserve(ranges.size());
+  for (uint64_t r = 0; r < ranges.size(); ++r) {
+    if (!may_contain_point(ranges[r])) {
+      storage_manager_->stats()->add_counter("read_bloom_filter_skip_num", 1);
+      continue;
+    }
+    batch.emplace_back(ranges[r]);
+    batch_idx.emplace_back(r);
+  }
+  if (batch.empty())
+    return Status::Ok();
+
+  // Traverse disjoint leaf intervals in parallel
+  const uint64_t leaf_num = rtree_.leaves().size();
+  const uint64_t task_num = std::max<uint64_t>(
+      1, std::min<uint64_t>(compute_tp->concurrency_level(), leaf_num));
+  const uint64_t leaves_per_task = (leaf_num + task_num - 1) / task_num;
+  std::vector<std::vector<TileOverlap>> task_overlaps(task_num);
+  auto status = parallel_for(compute_tp, 0, task_num, [&](uint64_t t) {
+    rtree_.get_tile_overlap(
+        batch,
+        t * leaves_per_task,
+        (t + 1) * leaves_per_task - 1,
+        &task_overlaps[t]);
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
+
+  // Concatenate the results of each range in leaf order
+  for (uint64_t b = 0; b < batch.size(); ++b) {
+    auto& overlap = (*tile_overlaps)[batch_idx[b]];
+    for (auto& task_overlap : task_overlaps) {
+      auto& part = task_overlap[b];
+      overlap.tiles_.insert(
+          overlap.tiles_.end(), part.tiles_.begin(), part.tiles_.end());
+      overlap.tile_ranges_.insert(
+          overlap.tile_ranges_.end(),
+          part.tile_ranges_.begin(),
+          part.tile_ranges_.end());
+    }
+  }
+
+  return Status::Ok();
+}
+
+bool FragmentMetadata::may_contain_point(const NDRange& range) const {
+  if (coords_bloom_filter_.empty())
+    return true;
+
+  // Hash the point the same way the writer hashes the cell coordinates
+  uint64_t hash = 0;
+  for (const auto& r : range) {
+    if (!r.unary())
+      return true;
+    auto size = r.var_size() ? r.start_size() : r.size() / 2;
+    hash = BloomFilter::hash(r.start(), size, hash);
+  }
+
+  return coords_bloom_filter_.may_contain(hash);
+}
+
 void FragmentMetadata::compute_tile_bitmap(
     const Range& range, unsigned d, std::vector<uint8_t>* tile_bitmap) {
   assert(version_ <= 2 || loaded_metadata_.rtree_);
@@ -676,18 +832,20 @@ Status FragmentMetadata::load(
     uint64_t offset,
     std::unordered_map<std::string, tdb_shared_ptr<ArraySchema>>
         array_schemas) {
-  auto meta_uri = fragment_uri_.join_path(
-      std::string(constants::fragment_metadata_filename));
+  // The files of a packed fragment are located through its index
+  if (utils::parse::ends_with(
+          fragment_uri_.to_string(), constants::packed_fragment_suffix))
+    RETURN_NOT_OK(load_packed_index());
+
   // Load the metadata file size when we are not reading from consolidated
-  // buffer
-  if (f_buff == nullptr)
+  // buffer, unless it was read ahead with the file tail
+  if (f_buff == nullptr && file_tail_.size() == 0 && packed_ == nullptr)
     RETURN_NOT_OK(
-        storage_manager_->vfs()->file_size(meta_uri, &meta_file_size_));
+        storage_manager_->vfs()->file_size(meta_uri(), &meta_file_size_));
 
   // Get fragment name version
   uint32_t f_version;
-  auto name = fragment_uri_.remove_trailing_slash().last_path_part();
-  RETURN_NOT_OK(utils::parse::get_fragment_name_version(name, &f_version));
+  RETURN_NOT_OK(fragment_name_version(&f_version));
 
   // Note: The fragment name version is different from the fragment format
   // version.
@@ -699,13 +857,35 @@ Status FragmentMetadata::load(
   //    * __t1_t2_uuid_version
   if (f_version == 1)
     return load_v1_v2(encryption_key, array_schemas);
-  return load_v3_or_higher(encryption_key, f_buff, offset, array_schemas);
+  RETURN_NOT_OK(
+      load_v3_or_higher(encryption_key, f_buff, offset, array_schemas));
+
+  if (packed_ != nullptr)
+    RETURN_NOT_OK(set_packed_offsets());
+
+  // The tiles of a fragment written in parts are in the part directories
+  if (utils::parse::ends_with(
+          fragment_uri_.remove_trailing_slash().to_string(),
+          constants::fragment_parts_suffix))
+    RETURN_NOT_OK(load_parts(encryption_key));
+
+  return Status::Ok();
+}
+
+void FragmentMetadata::set_file_tail(
+    uint64_t meta_file_size, Buffer&& file_tail) {
+  meta_file_size_ = meta_file_size;
+  file_tail_ = std::move(file_tail);
 }
 
 Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
   auto timer_se =
       storage_manager_->stats()->start_timer("write_store_frag_meta");
 
+  RETURN_NOT_OK(store_coords_bloom_filter(encryption_key));
+  RETURN_NOT_OK(store_attribute_index(encryption_key));
+  RETURN_NOT_OK(store_parts(encryption_key));
+
   assert(version_ >= 7);
   if (version_ <= 10)
     return store_v7_v10(encryption_key);
@@ -1013,6 +1193,17 @@ tuple<Status, optional<std::string>> FragmentMetadata::encode_name(
 
 tuple<Status, optional<URI>> FragmentMetadata::uri(
     const std::string& name) const {
+  // All the files of a packed fragment are in its object
+  if (packed_ != nullptr)
+    return {Status::Ok(), fragment_uri_};
+
+  // The attributes of a group share the file of the group
+  auto group = array_schema_->attribute_group(name);
+  if (group.has_value())
+    return {Status::Ok(),
+            fragment_uri_.join_path(
+                "g" + std::to_string(*group) + constants::file_suffix)};
+
   auto&& [st, encoded_name] = encode_name(name);
   if (!st.ok())
     return {st, std::nullopt};
@@ -1022,6 +1213,9 @@ tuple<Status, optional<URI>> FragmentMetadata::uri(
 
 tuple<Status, optional<URI>> FragmentMetadata::var_uri(
     const std::string& name) const {
+  if (packed_ != nullptr)
+    return {Status::Ok(), fragment_uri_};
+
   auto&& [st, encoded_name] = encode_name(name);
   if (!st.ok())
     return {st, std::nullopt};
@@ -1033,6 +1227,9 @@ tuple<Status, optional<URI>> FragmentMetadata::var_uri(
 
 tuple<Status, optional<URI>> FragmentMetadata::validity_uri(
     const std::string& name) const {
+  if (packed_ != nullptr)
+    return {Status::Ok(), fragment_uri_};
+
   auto&& [st, encoded_name] = encode_name(name);
   if (!st.ok())
     return {st, std::nullopt};
@@ -1042,12 +1239,54 @@ tuple<Status, optional<URI>> FragmentMetadata::validity_uri(
               *encoded_name + "_validity" + constants::file_suffix)};
 }
 
+tuple<Status, optional<URI>> FragmentMetadata::uri(
+    const std::string& name, uint64_t tile_idx) const {
+  auto&& [st, uri] = this->uri(name);
+  if (!st.ok() || parts_.empty())
+    return {st, uri};
+  return {st, part_file_uri(*uri, tile_idx)};
+}
+
+tuple<Status, optional<URI>> FragmentMetadata::var_uri(
+    const std::string& name, uint64_t tile_idx) const {
+  auto&& [st, uri] = var_uri(name);
+  if (!st.ok() || parts_.empty())
+    return {st, uri};
+  return {st, part_file_uri(*uri, tile_idx)};
+}
+
+tuple<Status, optional<URI>> FragmentMetadata::validity_uri(
+    const std::string& name, uint64_t tile_idx) const {
+  auto&& [st, uri] = validity_uri(name);
+  if (!st.ok() || parts_.empty())
+    return {st, uri};
+  return {st, part_file_uri(*uri, tile_idx)};
+}
+
 const std::string& FragmentMetadata::array_schema_name() {
   return array_schema_name_;
 }
 
 Status FragmentMetadata::load_tile_offsets(
     const EncryptionKey& encryption_key, std::vector<std::string>&& names) {
+  // The tile sizes of a grouped attribute are computed from the offsets of
+  // the other attributes of its group, which are loaded as well.
+  const auto& groups = array_schema_->attribute_groups();
+  if (!groups.empty()) {
+    std::vector<bool> added(groups.size(), false);
+    const auto name_num = names.size();
+    for (size_t i = 0; i < name_num; ++i) {
+      auto group = array_schema_->attribute_group(names[i]);
+      if (!group.has_value() || added[*group])
+        continue;
+      added[*group] = true;
+      for (const auto& n : groups[*group]) {
+        if (std::find(names.begin(), names.end(), n) == names.end())
+          names.push_back(n);
+      }
+    }
+  }
+
   // Sort 'names' in ascending order of their index. The
   // motivation is to load the offsets in order of their
   // layout for sequential reads to the file.
@@ -1180,6 +1419,10 @@ Status FragmentMetadata::file_offset(
         "Trying to access metadata that's not loaded"));
 
   *offset = tile_offsets_[idx][tile_idx];
+  if (!packed_offsets_.empty())
+    *offset += packed_offsets_[idx];
+  if (!parts_.empty())
+    *offset -= part(tile_idx).offsets_[idx];
   return Status::Ok();
 }
 
@@ -1193,6 +1436,10 @@ Status FragmentMetadata::file_var_offset(
         "Trying to access metadata that's not loaded"));
 
   *offset = tile_var_offsets_[idx][tile_idx];
+  if (!packed_var_offsets_.empty())
+    *offset += packed_var_offsets_[idx];
+  if (!parts_.empty())
+    *offset -= part(tile_idx).var_offsets_[idx];
   return Status::Ok();
 }
 
@@ -1206,6 +1453,10 @@ Status FragmentMetadata::file_validity_offset(
         "Trying to access metadata that's not loaded"));
 
   *offset = tile_validity_offsets_[idx][tile_idx];
+  if (!packed_validity_offsets_.empty())
+    *offset += packed_validity_offsets_[idx];
+  if (!parts_.empty())
+    *offset -= part(tile_idx).validity_offsets_[idx];
   return Status::Ok();
 }
 
@@ -1230,6 +1481,26 @@ FragmentMetadata::persisted_tile_size(
 
   auto tile_num = this->tile_num();
 
+  // The tiles of the attributes of a group are interleaved in its file in
+  // the order of the group, so a tile ends where the tile of the next
+  // attribute starts, or that of the first attribute for the next tile
+  auto group = array_schema_->attribute_group(name);
+  if (group.has_value()) {
+    const auto& names = array_schema_->attribute_groups()[*group];
+    auto pos = std::find(names.begin(), names.end(), name) - names.begin();
+    uint64_t end = file_sizes_[idx];
+    if ((size_t)pos + 1 < names.size() || tile_idx != tile_num - 1) {
+      const bool next_tile = (size_t)pos + 1 == names.size();
+      const auto next_idx = idx_map_[names[next_tile ? 0 : pos + 1]];
+      if (!loaded_metadata_.tile_offsets_[next_idx])
+        return {LOG_STATUS(Status_FragmentMetadataError(
+                    "Trying to access metadata that's not loaded")),
+                std::nullopt};
+      end = tile_offsets_[next_idx][tile_idx + next_tile];
+    }
+    return {Status::Ok(), end - tile_offsets_[idx][tile_idx]};
+  }
+
   auto tile_size =
       (tile_idx != tile_num - 1) ?
           tile_offsets_[idx][tile_idx + 1] - tile_offsets_[idx][tile_idx] :
@@ -1487,6 +1758,122 @@ Status FragmentMetadata::load_rtree(const EncryptionKey& encryption_key) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_coords_bloom_filter(
+    const EncryptionKey& encryption_key) {
+  if (dense_)
+    return Status::Ok();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (loaded_metadata_.coords_bloom_filter_)
+    return Status::Ok();
+
+  // Fragments written without a filter do not have the file
+  auto uri = fragment_uri_.join_path(constants::coords_bloom_filter_filename);
+  uint64_t file_offset = 0;
+  bool is_file = false;
+  if (packed_ != nullptr) {
+    auto file = packed_file(constants::coords_bloom_filter_filename);
+    is_file = file.has_value();
+    uri = fragment_uri_;
+    file_offset = is_file ? file->first : 0;
+  } else {
+    RETURN_NOT_OK(storage_manager_->is_file(uri, &is_file));
+  }
+  if (is_file) {
+    Buffer buff;
+    GenericTileIO tile_io(storage_manager_, uri);
+    RETURN_NOT_OK(tile_io.read_generic(
+        &buff, file_offset, encryption_key, storage_manager_->config()));
+
+    storage_manager_->stats()->add_counter(
+        "read_bloom_filter_size", buff.size());
+
+    if (memory_tracker_ != nullptr &&
+        !memory_tracker_->take_memory(buff.size())) {
+      return LOG_STATUS(Status_FragmentMetadataError(
+          "Cannot load Bloom filter; Insufficient memory budget; Needed " +
+          std::to_string(buff.size()) + " but only had " +
+          std::to_string(memory_tracker_->get_memory_available()) +
+          " from budget " +
+          std::to_string(memory_tracker_->get_memory_budget())));
+    }
+
+    ConstBuffer cbuff(&buff);
+    RETURN_NOT_OK(coords_bloom_filter_.deserialize(&cbuff));
+  }
+
+  loaded_metadata_.coords_bloom_filter_ = true;
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::load_attribute_index(
+    const EncryptionKey& encryption_key) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (loaded_metadata_.attribute_index_)
+    return Status::Ok();
+
+  // Fragments written without an index do not have the file
+  auto uri = fragment_uri_.join_path(constants::attribute_index_filename);
+  uint64_t file_offset = 0;
+  bool is_file = false;
+  if (packed_ != nullptr) {
+    auto file = packed_file(constants::attribute_index_filename);
+    is_file = file.has_value();
+    uri = fragment_uri_;
+    file_offset = is_file ? file->first : 0;
+  } else {
+    RETURN_NOT_OK(storage_manager_->is_file(uri, &is_file));
+  }
+  if (is_file) {
+    Buffer buff;
+    GenericTileIO tile_io(storage_manager_, uri);
+    RETURN_NOT_OK(tile_io.read_generic(
+        &buff, file_offset, encryption_key, storage_manager_->config()));
+
+    storage_manager_->stats()->add_counter(
+        "read_attribute_index_size", buff.size());
+
+    if (memory_tracker_ != nullptr &&
+        !memory_tracker_->take_memory(buff.size())) {
+      return LOG_STATUS(Status_FragmentMetadataError(
+          "Cannot load attribute index; Insufficient memory budget; Needed " +
+          std::to_string(buff.size()) + " but only had " +
+          std::to_string(memory_tracker_->get_memory_available()) +
+          " from budget " +
+          std::to_string(memory_tracker_->get_memory_budget())));
+    }
+
+    // ===== FORMAT =====
+    // attribute_num (uint32_t)
+    //   name_size (uint32_t) | name (char[]) | tile_num (uint64_t)
+    //   filter#1 ... filter#<tile_num> (see BloomFilter::serialize)
+    //   ...
+    ConstBuffer cbuff(&buff);
+    uint32_t attribute_num, name_size;
+    uint64_t tile_num;
+    RETURN_NOT_OK(cbuff.read(&attribute_num, sizeof(uint32_t)));
+    for (uint32_t a = 0; a < attribute_num; ++a) {
+      RETURN_NOT_OK(cbuff.read(&name_size, sizeof(uint32_t)));
+      std::string name(name_size, '\0');
+      RETURN_NOT_OK(cbuff.read(name.data(), name_size));
+      RETURN_NOT_OK(cbuff.read(&tile_num, sizeof(uint64_t)));
+      auto& filters = attribute_index_[name];
+      filters.clear();
+      for (uint64_t t = 0; t < tile_num; ++t) {
+        filters.emplace_back();
+        RETURN_NOT_OK(filters.back().deserialize(&cbuff));
+      }
+    }
+  }
+
+  loaded_metadata_.attribute_index_ = true;
+
+  return Status::Ok();
+}
+
 void FragmentMetadata::free_rtree() {
   auto freed = rtree_.free_memory();
   if (memory_tracker_ != nullptr)
@@ -1531,23 +1918,28 @@ uint64_t FragmentMetadata::footer_size() const {
 Status FragmentMetadata::get_footer_offset_and_size(
     uint64_t* offset, uint64_t* size) const {
   uint32_t f_version;
-  auto name = fragment_uri_.remove_trailing_slash().last_path_part();
-  RETURN_NOT_OK(utils::parse::get_fragment_name_version(name, &f_version));
+  RETURN_NOT_OK(fragment_name_version(&f_version));
   if (array_schema_->domain()->all_dims_fixed() && f_version < 5) {
     RETURN_NOT_OK(get_footer_size(f_version, size));
     *offset = meta_file_size_ - *size;
   } else {
-    URI fragment_metadata_uri = fragment_uri_.join_path(
-        std::string(constants::fragment_metadata_filename));
     uint64_t size_offset = meta_file_size_ - sizeof(uint64_t);
-    Buffer buff;
-    RETURN_NOT_OK(storage_manager_->read(
-        fragment_metadata_uri, size_offset, &buff, sizeof(uint64_t)));
-    buff.reset_offset();
-    RETURN_NOT_OK(buff.read(size, sizeof(uint64_t)));
+    if (file_tail_.size() >= sizeof(uint64_t)) {
+      // The footer size ends the file tail read ahead.
+      std::memcpy(
+          size,
+          file_tail_.data(file_tail_.size() - sizeof(uint64_t)),
+          sizeof(uint64_t));
+    } else {
+      Buffer buff;
+      RETURN_NOT_OK(storage_manager_->read(
+          meta_uri(), meta_base_ + size_offset, &buff, sizeof(uint64_t)));
+      buff.reset_offset();
+      RETURN_NOT_OK(buff.read(size, sizeof(uint64_t)));
+      storage_manager_->stats()->add_counter(
+          "read_frag_meta_size", sizeof(uint64_t));
+    }
     *offset = meta_file_size_ - *size - sizeof(uint64_t);
-    storage_manager_->stats()->add_counter(
-        "read_frag_meta_size", sizeof(uint64_t));
   }
 
   return Status::Ok();
@@ -2205,10 +2597,10 @@ Status FragmentMetadata::load_mbrs(ConstBuffer* buff) {
     NDRange mbr(dim_num);
     for (unsigned d = 0; d < dim_num; ++d) {
       auto r_size = 2 * domain->dimension(d)->coord_size();
-      mbr[d].set_range(buff->cur_data(), r_size);
+      mbr[d].set_range_inline(buff->cur_data(), r_size);
       buff->advance_offset(r_size);
     }
-    rtree_.set_leaf(m, mbr);
+    rtree_.set_leaf(m, std::move(mbr));
   }
 
   // Build R-tree bottom-up
@@ -3055,15 +3447,9 @@ Status FragmentMetadata::load_v1_v2(
       std::string(constants::fragment_metadata_filename));
   // Read metadata
   GenericTileIO tile_io(storage_manager_, fragment_metadata_uri);
-  auto tile = (Tile*)nullptr;
-  RETURN_NOT_OK(tile_io.read_generic(
-      &tile, 0, encryption_key, storage_manager_->config()));
-
   Buffer buff;
-  RETURN_NOT_OK_ELSE(buff.realloc(tile->size()), tdb_delete(tile));
-  buff.set_size(tile->size());
-  RETURN_NOT_OK_ELSE(tile->read(buff.data(), 0, buff.size()), tdb_delete(tile));
-  tdb_delete(tile);
+  RETURN_NOT_OK(tile_io.read_generic(
+      &buff, 0, encryption_key, storage_manager_->config()));
 
   storage_manager_->stats()->add_counter("read_frag_meta_size", buff.size());
 
@@ -3195,6 +3581,7 @@ Status FragmentMetadata::load_footer(
   RETURN_NOT_OK(load_generic_tile_offsets(cbuff.get()));
 
   loaded_metadata_.footer_ = true;
+  file_tail_.clear();
 
   // If the footer_size is not set lets calculate from how much of the buffer we
   // read
@@ -3403,6 +3790,72 @@ Status FragmentMetadata::store_rtree(
   return Status::Ok();
 }
 
+Status FragmentMetadata::store_coords_bloom_filter(
+    const EncryptionKey& encryption_key) {
+  if (coords_hashes_.empty())
+    return Status::Ok();
+
+  BloomFilter filter;
+  filter.init(coords_hashes_.size(), coords_bloom_filter_bits_per_cell_);
+  for (auto hash : coords_hashes_)
+    filter.add(hash);
+  std::vector<uint64_t>().swap(coords_hashes_);
+
+  Buffer buff;
+  RETURN_NOT_OK(filter.serialize(&buff));
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      buff.data(),
+      buff.size());
+  buff.disown_data();
+
+  auto uri = fragment_uri_.join_path(constants::coords_bloom_filter_filename);
+  GenericTileIO tile_io(storage_manager_, uri);
+  uint64_t nbytes;
+  RETURN_NOT_OK(tile_io.write_generic(&tile, encryption_key, &nbytes));
+  storage_manager_->stats()->add_counter("write_bloom_filter_size", nbytes);
+
+  return storage_manager_->close_file(uri);
+}
+
+Status FragmentMetadata::store_attribute_index(
+    const EncryptionKey& encryption_key) {
+  if (attribute_index_.empty())
+    return Status::Ok();
+
+  // See `load_attribute_index` for the format
+  Buffer buff;
+  auto attribute_num = (uint32_t)attribute_index_.size();
+  RETURN_NOT_OK(buff.write(&attribute_num, sizeof(uint32_t)));
+  for (const auto& it : attribute_index_) {
+    auto name_size = (uint32_t)it.first.size();
+    uint64_t tile_num = it.second.size();
+    RETURN_NOT_OK(buff.write(&name_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff.write(it.first.data(), name_size));
+    RETURN_NOT_OK(buff.write(&tile_num, sizeof(uint64_t)));
+    for (const auto& filter : it.second)
+      RETURN_NOT_OK(filter.serialize(&buff));
+  }
+
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      buff.data(),
+      buff.size());
+  buff.disown_data();
+
+  auto uri = fragment_uri_.join_path(constants::attribute_index_filename);
+  GenericTileIO tile_io(storage_manager_, uri);
+  uint64_t nbytes;
+  RETURN_NOT_OK(tile_io.write_generic(&tile, encryption_key, &nbytes));
+  storage_manager_->stats()->add_counter("write_attribute_index_size", nbytes);
+
+  return storage_manager_->close_file(uri);
+}
+
 Status FragmentMetadata::write_rtree(Buffer* buff) {
   RETURN_NOT_OK(rtree_.build_tree());
   RETURN_NOT_OK(rtree_.serialize(buff));
@@ -3452,31 +3905,221 @@ Status FragmentMetadata::write_non_empty_domain(Buffer* buff) const {
   return Status::Ok();
 }
 
+URI FragmentMetadata::meta_uri() const {
+  if (packed_ != nullptr)
+    return fragment_uri_;
+  return fragment_uri_.join_path(constants::fragment_metadata_filename);
+}
+
+Status FragmentMetadata::load_packed_index() {
+  // See `PackedFragment::serialize` for the format. The size of the object
+  // and its tail may have been read ahead.
+  uint64_t object_size = meta_file_size_;
+  if (file_tail_.size() == 0)
+    RETURN_NOT_OK(
+        storage_manager_->vfs()->file_size(fragment_uri_, &object_size));
+  const uint64_t tail_offset = object_size - file_tail_.size();
+
+  // Reads a range of the object, from the tail if it covers the range
+  auto read = [&](uint64_t offset, void* data, uint64_t size) {
+    if (file_tail_.size() > 0 && offset >= tail_offset) {
+      std::memcpy(data, file_tail_.data(offset - tail_offset), size);
+      return Status::Ok();
+    }
+    return storage_manager_->read(fragment_uri_, offset, data, size);
+  };
+
+  uint64_t index_size = 0;
+  if (object_size >= sizeof(uint64_t))
+    RETURN_NOT_OK(
+        read(object_size - sizeof(uint64_t), &index_size, sizeof(uint64_t)));
+  if (object_size < sizeof(uint64_t) ||
+      index_size > object_size - sizeof(uint64_t))
+    return LOG_STATUS(Status_FragmentMetadataError(
+        "Cannot load packed fragment '" + fragment_uri_.to_string() +
+        "'; Invalid index size"));
+
+  Buffer buff;
+  RETURN_NOT_OK(buff.realloc(index_size));
+  RETURN_NOT_OK(read(
+      object_size - sizeof(uint64_t) - index_size, buff.data(), index_size));
+  buff.set_size(index_size);
+  storage_manager_->stats()->add_counter("read_packed_index_size", index_size);
+
+  auto packed = tdb::make_shared<PackedFragment>(HERE());
+  ConstBuffer cbuff(&buff);
+  RETURN_NOT_OK(packed->deserialize_index(&cbuff));
+  auto meta = packed->file(constants::fragment_metadata_filename);
+  if (!meta.has_value())
+    return LOG_STATUS(Status_FragmentMetadataError(
+        "Cannot load packed fragment '" + fragment_uri_.to_string() +
+        "'; Missing fragment metadata file"));
+
+  // Keep the part of the tail that ends the metadata file
+  const uint64_t meta_end = meta->first + meta->second;
+  if (file_tail_.size() > 0) {
+    Buffer tail;
+    if (meta_end > tail_offset) {
+      const auto start = std::max(tail_offset, meta->first);
+      RETURN_NOT_OK(
+          tail.write(file_tail_.data(start - tail_offset), meta_end - start));
+    }
+    file_tail_ = std::move(tail);
+  }
+
+  packed_ = packed;
+  meta_base_ = meta->first;
+  meta_file_size_ = meta->second;
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::set_packed_offsets() {
+  auto num = array_schema_->attribute_num() + array_schema_->dim_num() + 1;
+  packed_offsets_.assign(num, 0);
+  packed_var_offsets_.assign(num, 0);
+  packed_validity_offsets_.assign(num, 0);
+
+  // The file names are those the files would have in a fragment directory
+  for (const auto& it : idx_map_) {
+    auto group = array_schema_->attribute_group(it.first);
+    std::string encoded_name;
+    if (group.has_value()) {
+      encoded_name = "g" + std::to_string(*group);
+    } else {
+      auto&& [st, name] = encode_name(it.first);
+      RETURN_NOT_OK(st);
+      encoded_name = *name;
+    }
+
+    auto file = packed_file(encoded_name + constants::file_suffix);
+    if (file.has_value())
+      packed_offsets_[it.second] = file->first;
+    file = packed_file(encoded_name + "_var" + constants::file_suffix);
+    if (file.has_value())
+      packed_var_offsets_[it.second] = file->first;
+    file = packed_file(encoded_name + "_validity" + constants::file_suffix);
+    if (file.has_value())
+      packed_validity_offsets_[it.second] = file->first;
+  }
+
+  return Status::Ok();
+}
+
+optional<std::pair<uint64_t, uint64_t>> FragmentMetadata::packed_file(
+    const std::string& file_name) const {
+  if (packed_ == nullptr)
+    return nullopt;
+  return packed_->file(file_name);
+}
+
+const FragmentMetadata::FragmentPart& FragmentMetadata::part(
+    uint64_t tile_idx) const {
+  assert(!parts_.empty());
+  auto it = std::upper_bound(
+      parts_.begin(),
+      parts_.end(),
+      tile_idx,
+      [](uint64_t t, const FragmentPart& p) { return t < p.first_tile_; });
+  assert(it != parts_.begin());
+  return *(it - 1);
+}
+
+URI FragmentMetadata::part_file_uri(const URI& uri, uint64_t tile_idx) const {
+  return FragmentParts::part_uri(fragment_uri_, part(tile_idx).id_)
+      .join_path(uri.last_path_part());
+}
+
+Status FragmentMetadata::store_parts(const EncryptionKey& encryption_key) {
+  if (parts_.empty())
+    return Status::Ok();
+
+  // See `load_parts` for the format
+  Buffer buff;
+  auto part_num = (uint32_t)parts_.size();
+  RETURN_NOT_OK(buff.write(&part_num, sizeof(uint32_t)));
+  for (const auto& part : parts_) {
+    auto num = (uint32_t)part.offsets_.size();
+    RETURN_NOT_OK(buff.write(&part.id_, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff.write(&part.first_tile_, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff.write(&num, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff.write(part.offsets_.data(), num * sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        buff.write(part.var_offsets_.data(), num * sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        buff.write(part.validity_offsets_.data(), num * sizeof(uint64_t)));
+  }
+
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      buff.data(),
+      buff.size());
+  buff.disown_data();
+
+  auto uri = fragment_uri_.join_path(constants::fragment_parts_filename);
+  GenericTileIO tile_io(storage_manager_, uri);
+  uint64_t nbytes;
+  RETURN_NOT_OK(tile_io.write_generic(&tile, encryption_key, &nbytes));
+
+  return storage_manager_->close_file(uri);
+}
+
+Status FragmentMetadata::load_parts(const EncryptionKey& encryption_key) {
+  Buffer buff;
+  auto uri = fragment_uri_.join_path(constants::fragment_parts_filename);
+  GenericTileIO tile_io(storage_manager_, uri);
+  RETURN_NOT_OK(tile_io.read_generic(
+      &buff, 0, encryption_key, storage_manager_->config()));
+
+  // ===== FORMAT =====
+  // part_num (uint32_t)
+  //   id (uint32_t) | first_tile (uint64_t) | num (uint32_t)
+  //   offsets (uint64_t[num]) | var_offsets (uint64_t[num])
+  //   validity_offsets (uint64_t[num])
+  //   ...
+  ConstBuffer cbuff(&buff);
+  uint32_t part_num, num;
+  RETURN_NOT_OK(cbuff.read(&part_num, sizeof(uint32_t)));
+  parts_.resize(part_num);
+  for (auto& part : parts_) {
+    RETURN_NOT_OK(cbuff.read(&part.id_, sizeof(uint32_t)));
+    RETURN_NOT_OK(cbuff.read(&part.first_tile_, sizeof(uint64_t)));
+    RETURN_NOT_OK(cbuff.read(&num, sizeof(uint32_t)));
+    part.offsets_.resize(num);
+    part.var_offsets_.resize(num);
+    part.validity_offsets_.resize(num);
+    RETURN_NOT_OK(cbuff.read(part.offsets_.data(), num * sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        cbuff.read(part.var_offsets_.data(), num * sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        cbuff.read(part.validity_offsets_.data(), num * sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::fragment_name_version(uint32_t* f_version) const {
+  auto uri = fragment_uri_.remove_trailing_slash();
+  if (FragmentParts::is_part(uri))
+    uri = uri.parent();
+  return utils::parse::get_fragment_name_version(
+      uri.last_path_part(), f_version);
+}
+
 Status FragmentMetadata::read_generic_tile_from_file(
     const EncryptionKey& encryption_key, uint64_t offset, Buffer* buff) const {
-  URI fragment_metadata_uri = fragment_uri_.join_path(
-      std::string(constants::fragment_metadata_filename));
-
   // Read metadata
-  GenericTileIO tile_io(storage_manager_, fragment_metadata_uri);
-  Tile* tile = nullptr;
+  GenericTileIO tile_io(storage_manager_, meta_uri());
   RETURN_NOT_OK(tile_io.read_generic(
-      &tile, offset, encryption_key, storage_manager_->config()));
-
-  buff->realloc(tile->size());
-  buff->set_size(tile->size());
-  RETURN_NOT_OK_ELSE(
-      tile->read(buff->data(), 0, buff->size()), tdb_delete(tile));
-  tdb_delete(tile);
+      buff, meta_base_ + offset, encryption_key, storage_manager_->config()));
 
   return Status::Ok();
 }
 
 Status FragmentMetadata::read_file_footer(
     Buffer* buff, uint64_t* footer_offset, uint64_t* footer_size) const {
-  URI fragment_metadata_uri = fragment_uri_.join_path(
-      std::string(constants::fragment_metadata_filename));
-
   // Get footer offset
   RETURN_NOT_OK(get_footer_offset_and_size(footer_offset, footer_size));
 
@@ -3492,9 +4135,17 @@ Status FragmentMetadata::read_file_footer(
         std::to_string(memory_tracker_->get_memory_budget())));
   }
 
+  // Take the footer from the file tail read ahead, if it fits
+  const uint64_t file_tail_offset = meta_file_size_ - file_tail_.size();
+  if (file_tail_.size() > 0 && *footer_offset >= file_tail_offset) {
+    storage_manager_->stats()->add_counter("read_frag_meta_tail_hit_num", 1);
+    return buff->write(
+        file_tail_.data(*footer_offset - file_tail_offset), *footer_size);
+  }
+
   // Read footer
   return storage_manager_->read(
-      fragment_metadata_uri, *footer_offset, buff, *footer_size);
+      meta_uri(), meta_base_ + *footer_offset, buff, *footer_size);
 }
 
 Status FragmentMetadata::write_generic_tile_to_file(
@@ -40,7 +40,9 @@
 
 #include "tiledb/common/common.h"
 #include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/fragment/bloom_filter.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/rtree/rtree.h"
 
@@ -53,6 +55,7 @@ class ArraySchema;
 class Buffer;
 class EncryptionKey;
 class MemoryTracker;
+class PackedFragment;
 class StorageManager;
 
 /** Stores the metadata structures of a fragment. */
@@ -218,6 +221,12 @@ class FragmentMetadata {
   /** Returns true if the metadata footer is consolidated. */
   bool has_consolidated_footer() const;
 
+  /**
+   * Returns true if the fragment was loaded from a packed fragment object,
+   * which holds all its files.
+   */
+  bool packed() const;
+
   /**
    * Returns true if the input range overlaps the non-empty
    * domain of the fragment.
@@ -227,9 +236,30 @@ class FragmentMetadata {
   /**
    * Retrieves the overlap of all MBRs with the input ND range. The encryption
    * key is needed because certain metadata may have to be loaded on-the-fly.
+   * If the range is a single point that the coordinates Bloom filter rules
+   * out, the overlap is empty.
    */
   Status get_tile_overlap(const NDRange& range, TileOverlap* tile_overlap);
 
+  /**
+   * Retrieves the overlap of all MBRs with each of the input ND ranges,
+   * traversing the R-tree once for the whole batch. The leaves are split
+   * into contiguous intervals that are processed in parallel on
+   * `compute_tp`. `tile_overlaps` is resized to the number of ranges.
+   */
+  Status get_tile_overlap(
+      const std::vector<NDRange>& ranges,
+      ThreadPool* compute_tp,
+      std::vector<TileOverlap>* tile_overlaps);
+
+  /**
+   * Returns `false` if the input ND range is a single point that is
+   * certainly not in the fragment, according to the Bloom filter over its
+   * coordinates. Returns `true` otherwise, including when the fragment
+   * has no filter or it has not been loaded.
+   */
+  bool may_contain_point(const NDRange& range) const;
+
   /**
    * Compute tile bitmap for the curent fragment/range/dimension.
    */
@@ -259,6 +289,17 @@ class FragmentMetadata {
       std::unordered_map<std::string, tdb_shared_ptr<ArraySchema>>
           array_schemas);
 
+  /**
+   * Provides the size and the last bytes of the fragment metadata file, read
+   * ahead of `load` along with those of the other fragments of the array.
+   * `load` then takes the footer from them instead of reading it, unless it
+   * does not fit. The tail is released once the footer is loaded.
+   *
+   * @param meta_file_size The size of the fragment metadata file.
+   * @param file_tail The last bytes of the fragment metadata file.
+   */
+  void set_file_tail(uint64_t meta_file_size, Buffer&& file_tail);
+
   /** Stores all the metadata to storage. */
   Status store(const EncryptionKey& encryption_key);
 
@@ -297,6 +338,35 @@ class FragmentMetadata {
    */
   Status set_mbr(uint64_t tile, const NDRange& mbr);
 
+  /**
+   * Adds the hashes of written cell coordinates, from which a Bloom filter
+   * is built and stored with the fragment. Thread-safe.
+   *
+   * @param hashes The coordinate hashes, see `BloomFilter::hash`.
+   * @param bits_per_cell The number of filter bits allotted per cell.
+   */
+  void add_coords_hashes(
+      const std::vector<uint64_t>& hashes, uint64_t bits_per_cell);
+
+  /**
+   * Sets the Bloom filter over the values of an attribute in a tile, which
+   * is stored in the attribute value index of the fragment. Thread-safe.
+   *
+   * @param name The attribute name.
+   * @param tid The index of the tile.
+   * @param filter The filter over the hashes of the non-null tile values.
+   */
+  void set_attribute_index(
+      const std::string& name, uint64_t tid, BloomFilter&& filter);
+
+  /**
+   * Returns the Bloom filter over the values of an attribute in a tile, or
+   * `nullptr` if the fragment has no index on the attribute or the index
+   * has not been loaded.
+   */
+  const BloomFilter* attribute_index(
+      const std::string& name, uint64_t tile_idx) const;
+
   /**
    * Resizes the per-tile metadata vectors for the given number of tiles. This
    * is not serialized, and is only used during writes.
@@ -489,6 +559,38 @@ class FragmentMetadata {
   /** Returns the validity URI of the input nullable attribute. */
   tuple<Status, optional<URI>> validity_uri(const std::string& name) const;
 
+  /**
+   * Returns the URI of the input attribute/dimension file holding the input
+   * tile. For a fragment written in parts, this is the file of the part
+   * that wrote the tile.
+   */
+  tuple<Status, optional<URI>> uri(
+      const std::string& name, uint64_t tile_idx) const;
+
+  /**
+   * Returns the URI of the input variable-sized attribute/dimension file
+   * holding the input tile.
+   */
+  tuple<Status, optional<URI>> var_uri(
+      const std::string& name, uint64_t tile_idx) const;
+
+  /**
+   * Returns the validity URI of the input nullable attribute file holding
+   * the input tile.
+   */
+  tuple<Status, optional<URI>> validity_uri(
+      const std::string& name, uint64_t tile_idx) const;
+
+  /**
+   * Starts a new part of a fragment written in parts. The tiles set after
+   * this call, up to the next part, are located in the files of the part,
+   * whose offsets follow those of the previous parts.
+   *
+   * @param id The number of the part in the fragment.
+   * @param first_tile The index of the first tile of the part.
+   */
+  void add_part(uint32_t id, uint64_t first_tile);
+
   /** Return the array schema name. */
   const std::string& array_schema_name();
 
@@ -666,6 +768,18 @@ class FragmentMetadata {
   /** Frees the memory associated with the rtree. */
   void free_rtree();
 
+  /**
+   * Loads the Bloom filter over the coordinates from storage, if the
+   * fragment was written with one.
+   */
+  Status load_coords_bloom_filter(const EncryptionKey& encryption_key);
+
+  /**
+   * Loads the attribute value index from storage, if the fragment was
+   * written with one.
+   */
+  Status load_attribute_index(const EncryptionKey& encryption_key);
+
   /**
    * Loads the variable tile sizes for the input attribute or dimension idx
    * from storage.
@@ -752,10 +866,29 @@ class FragmentMetadata {
     std::vector<uint64_t> tile_null_count_offsets_;
   };
 
+  /**
+   * A part of a fragment written in parts. The tiles of the part are stored
+   * in its own directory, and the tile offsets of the fragment metadata
+   * are relative to the concatenated files of all the parts, so the bases
+   * of the part are subtracted from them to locate a tile.
+   */
+  struct FragmentPart {
+    /** The number of the part in the fragment. */
+    uint32_t id_ = 0;
+    /** The index of the first tile of the part. */
+    uint64_t first_tile_ = 0;
+    /** The bases of the fixed, var and validity offsets, per file index. */
+    std::vector<uint64_t> offsets_;
+    std::vector<uint64_t> var_offsets_;
+    std::vector<uint64_t> validity_offsets_;
+  };
+
   /** Keeps track of which metadata is loaded. */
   struct LoadedMetadata {
     bool footer_ = false;
     bool rtree_ = false;
+    bool coords_bloom_filter_ = false;
+    bool attribute_index_ = false;
     std::vector<bool> tile_offsets_;
     std::vector<bool> tile_var_offsets_;
     std::vector<bool> tile_var_sizes_;
@@ -838,6 +971,35 @@ class FragmentMetadata {
   /** The size of the fragment metadata file. */
   uint64_t meta_file_size_;
 
+  /**
+   * The last bytes of the fragment metadata file, if read ahead of `load`.
+   * Empty otherwise.
+   */
+  Buffer file_tail_;
+
+  /**
+   * The index of the files of a packed fragment, or nullptr if the
+   * fragment is a directory of files.
+   */
+  tdb_shared_ptr<PackedFragment> packed_;
+
+  /** The offset of the fragment metadata file in a packed fragment. */
+  uint64_t meta_base_;
+
+  /**
+   * The offsets of the fixed-sized, var-sized and validity tile files in a
+   * packed fragment, per attribute/dimension index. Empty otherwise.
+   */
+  std::vector<uint64_t> packed_offsets_;
+  std::vector<uint64_t> packed_var_offsets_;
+  std::vector<uint64_t> packed_validity_offsets_;
+
+  /**
+   * The parts of a fragment written in parts, in tile order. Empty
+   * otherwise.
+   */
+  std::vector<FragmentPart> parts_;
+
   /** Local mutex for thread-safety. */
   std::mutex mtx_;
 
@@ -850,6 +1012,24 @@ class FragmentMetadata {
   /** The non-empty domain of the fragment. */
   NDRange non_empty_domain_;
 
+  /** The Bloom filter over the fragment coordinates, possibly empty. */
+  BloomFilter coords_bloom_filter_;
+
+  /**
+   * The coordinate hashes of the cells written so far, from which
+   * `coords_bloom_filter_` is built when the metadata is stored.
+   */
+  std::vector<uint64_t> coords_hashes_;
+
+  /** The number of Bloom filter bits allotted per written cell. */
+  uint64_t coords_bloom_filter_bits_per_cell_ = 0;
+
+  /**
+   * The attribute value index, mapping the indexed attributes to one Bloom
+   * filter over the values of each tile.
+   */
+  std::unordered_map<std::string, std::vector<BloomFilter>> attribute_index_;
+
   /** An RTree for the MBRs. */
   RTree rtree_;
 
@@ -1287,6 +1467,19 @@ class FragmentMetadata {
   /** Stores a footer with the basic information. */
   Status store_footer(const EncryptionKey& encryption_key);
 
+  /**
+   * Builds the Bloom filter over the coordinate hashes added by the writer
+   * and stores it in its own file in the fragment directory. A no-op if
+   * no hashes were added.
+   */
+  Status store_coords_bloom_filter(const EncryptionKey& encryption_key);
+
+  /**
+   * Stores the attribute value index in its own file in the fragment
+   * directory. A no-op if no attribute is indexed.
+   */
+  Status store_attribute_index(const EncryptionKey& encryption_key);
+
   /** Writes the R-tree to the input buffer. */
   Status write_rtree(Buffer* buff);
 
@@ -1437,6 +1630,50 @@ class FragmentMetadata {
   /** Writes the number of sparse tiles to the buffer. */
   Status write_sparse_tile_num(Buffer* buff) const;
 
+  /** Returns the URI of the object holding the fragment metadata file. */
+  URI meta_uri() const;
+
+  /**
+   * Loads the index of a packed fragment from the end of its object, and
+   * narrows the metadata file size and tail read ahead to the metadata
+   * file within the object.
+   */
+  Status load_packed_index();
+
+  /**
+   * Computes the offsets of the tile files in a packed fragment, once the
+   * array schema of the fragment is known.
+   */
+  Status set_packed_offsets();
+
+  /** Returns the part of a fragment written in parts holding a tile. */
+  const FragmentPart& part(uint64_t tile_idx) const;
+
+  /**
+   * Returns the URI of the file of the part holding a tile, given the URI
+   * of the file in the fragment directory.
+   */
+  URI part_file_uri(const URI& uri, uint64_t tile_idx) const;
+
+  /** Stores the index of the parts of a fragment written in parts. */
+  Status store_parts(const EncryptionKey& encryption_key);
+
+  /** Loads the index of the parts of a fragment written in parts. */
+  Status load_parts(const EncryptionKey& encryption_key);
+
+  /**
+   * Retrieves the fragment name version, which for a part of a fragment
+   * written in parts is that of the fragment.
+   */
+  Status fragment_name_version(uint32_t* f_version) const;
+
+  /**
+   * Returns the offset and size of a file in the object of a packed
+   * fragment, or nullopt if the fragment is not packed or has no such file.
+   */
+  optional<std::pair<uint64_t, uint64_t>> packed_file(
+      const std::string& file_name) const;
+
   /**
    * Reads the contents of a generic tile starting at the input offset,
    * and stores them into buffer ``buff``.
@@ -0,0 +1,408 @@
+/**
+ * @file  fragment_parts.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FragmentParts.
+ */
+
+#include "tiledb/sm/fragment/fragment_parts.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/common/stdx_string.h"
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/time.h"
+#include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/misc/uuid.h"
+#include "tiledb/sm/stats/global_stats.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+FragmentParts::FragmentParts(Array* array, StorageManager* storage_manager)
+    : array_(array)
+    , storage_manager_(storage_manager) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+bool FragmentParts::is_part(const URI& uri) {
+  return utils::parse::starts_with(
+      uri.remove_trailing_slash().last_path_part(),
+      constants::fragment_part_prefix);
+}
+
+URI FragmentParts::part_uri(const URI& fragment_uri, uint32_t part) {
+  return fragment_uri.join_path(
+      constants::fragment_part_prefix + std::to_string(part));
+}
+
+Status FragmentParts::new_fragment_uri(URI* uri) const {
+  QueryType query_type;
+  RETURN_NOT_OK(array_->get_query_type(&query_type));
+  if (query_type != QueryType::WRITE)
+    return LOG_STATUS(Status_WriterError(
+        "Cannot create fragment in parts; Array must be opened for writes"));
+
+  uint64_t timestamp = array_->timestamp_end_opened_at();
+  timestamp = (timestamp != 0) ? timestamp : utils::time::timestamp_now_ms();
+  std::string uuid;
+  RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
+  std::stringstream ss;
+  ss << "__" << timestamp << "_" << timestamp << "_" << uuid << "_"
+     << array_->array_schema_latest()->write_version()
+     << constants::fragment_parts_suffix;
+  *uri = array_->array_uri().join_path(ss.str());
+
+  return Status::Ok();
+}
+
+Status FragmentParts::commit(const URI& fragment_uri) const {
+  auto timer_se = storage_manager_->stats()->start_timer("commit_frag_parts");
+
+  QueryType query_type;
+  RETURN_NOT_OK(array_->get_query_type(&query_type));
+  if (query_type != QueryType::WRITE)
+    return LOG_STATUS(Status_WriterError(
+        "Cannot commit fragment parts; Array must be opened for writes"));
+  auto array_schema = array_->array_schema_latest();
+  if (!array_schema->dense())
+    return LOG_STATUS(Status_WriterError(
+        "Cannot commit fragment parts; Only dense fragments can be written "
+        "in parts"));
+  if (!utils::parse::ends_with(
+          fragment_uri.remove_trailing_slash().to_string(),
+          constants::fragment_parts_suffix))
+    return LOG_STATUS(Status_WriterError(
+        "Cannot commit fragment parts; '" + fragment_uri.to_string() +
+        "' is not a fragment written in parts"));
+
+  std::vector<uint32_t> ids;
+  std::vector<tdb_shared_ptr<FragmentMetadata>> parts;
+  RETURN_NOT_OK(load_parts(fragment_uri, &ids, &parts));
+
+  // The tiles of the parts are consecutive in the tile order of the
+  // fragment if the parts are slabs along its slowest varying dimension
+  const auto dim_num = array_schema->dim_num();
+  const unsigned split_dim =
+      array_schema->tile_order() == Layout::COL_MAJOR ? dim_num - 1 : 0;
+  RETURN_NOT_OK(order_parts(split_dim, &ids, &parts));
+
+  // The fragment covers the union of the parts
+  auto non_empty_domain = parts.front()->non_empty_domain();
+  const auto& first = parts.front()->non_empty_domain()[split_dim];
+  const auto& last = parts.back()->non_empty_domain()[split_dim];
+  const auto coord_size = first.size() / 2;
+  std::vector<uint8_t> range(2 * coord_size);
+  std::memcpy(range.data(), first.start(), coord_size);
+  std::memcpy(range.data() + coord_size, last.end(), coord_size);
+  non_empty_domain[split_dim].set_range(range.data(), range.size());
+
+  std::pair<uint64_t, uint64_t> timestamp_range;
+  RETURN_NOT_OK(
+      utils::parse::get_timestamp_range(fragment_uri, &timestamp_range));
+  auto meta = tdb::make_shared<FragmentMetadata>(
+      HERE(),
+      storage_manager_,
+      nullptr,
+      array_schema,
+      fragment_uri,
+      timestamp_range,
+      true);
+  RETURN_NOT_OK(meta->init(non_empty_domain));
+
+  uint64_t tile_num = 0;
+  for (const auto& m : parts)
+    tile_num += m->tile_num();
+  if (tile_num != meta->tile_num())
+    return LOG_STATUS(Status_WriterError(
+        "Cannot commit fragment parts; The tiles of the parts do not cover "
+        "the fragment"));
+  RETURN_NOT_OK(meta->set_num_tiles(tile_num));
+
+  // The attributes of a group are visited in the order of the group, as
+  // their tiles are interleaved in the group file
+  std::vector<std::string> names;
+  for (const auto& attr : array_schema->attributes()) {
+    if (!array_schema->attribute_group(attr->name()).has_value())
+      names.emplace_back(attr->name());
+  }
+  for (const auto& group : array_schema->attribute_groups())
+    names.insert(names.end(), group.begin(), group.end());
+
+  // Set the tile offsets and metadata of each part, which follow those of
+  // the previous parts
+  uint64_t tid = 0;
+  for (size_t p = 0; p < parts.size(); ++p) {
+    const auto& m = parts[p];
+    meta->add_part(ids[p], tid);
+    for (uint64_t t = 0; t < m->tile_num(); ++t, ++tid) {
+      for (const auto& name : names) {
+        const auto var_size = array_schema->var_size(name);
+        const auto nullable = array_schema->is_nullable(name);
+        const auto type = array_schema->type(name);
+        const auto cell_val_num = array_schema->cell_val_num(name);
+        const auto has_min_max = TileMetadataGenerator::has_min_max_metadata(
+            type, false, var_size, cell_val_num);
+        const auto has_sum =
+            !var_size &&
+            TileMetadataGenerator::has_sum_metadata(type, false, cell_val_num);
+
+        auto&& [st, size] = m->persisted_tile_size(name, t);
+        RETURN_NOT_OK(st);
+        meta->set_tile_offset(name, tid, *size);
+
+        if (var_size) {
+          auto&& [st_v, var_persisted] = m->persisted_tile_var_size(name, t);
+          RETURN_NOT_OK(st_v);
+          auto&& [st_s, var_tile_size] = m->tile_var_size(name, t);
+          RETURN_NOT_OK(st_s);
+          meta->set_tile_var_offset(name, tid, *var_persisted);
+          meta->set_tile_var_size(name, tid, *var_tile_size);
+        }
+
+        if (nullable) {
+          auto&& [st_v, validity_size] =
+              m->persisted_tile_validity_size(name, t);
+          RETURN_NOT_OK(st_v);
+          meta->set_tile_validity_offset(name, tid, *validity_size);
+          auto&& [st_n, null_count] = m->get_tile_null_count(name, t);
+          RETURN_NOT_OK(st_n);
+          meta->set_tile_null_count(name, tid, *null_count);
+        }
+
+        if (has_min_max) {
+          auto&& [st_min, min, min_size] = m->get_tile_min(name, t);
+          RETURN_NOT_OK(st_min);
+          auto&& [st_max, max, max_size] = m->get_tile_max(name, t);
+          RETURN_NOT_OK(st_max);
+          if (var_size) {
+            meta->set_tile_min_var_size(name, tid, *min_size);
+            meta->set_tile_max_var_size(name, tid, *max_size);
+          } else {
+            meta->set_tile_min(name, tid, *min, *min_size);
+            meta->set_tile_max(name, tid, *max, *max_size);
+          }
+        }
+
+        if (has_sum) {
+          auto&& [st_sum, sum] = m->get_tile_sum(name, t);
+          RETURN_NOT_OK(st_sum);
+          ByteVec sum_vec(sizeof(uint64_t));
+          std::memcpy(sum_vec.data(), *sum, sizeof(uint64_t));
+          meta->set_tile_sum(name, tid, &sum_vec);
+        }
+      }
+    }
+  }
+
+  // The var-sized minimums and maximums are copied once all their sizes
+  // are known
+  for (const auto& name : names) {
+    if (!array_schema->var_size(name) ||
+        !TileMetadataGenerator::has_min_max_metadata(
+            array_schema->type(name),
+            false,
+            true,
+            array_schema->cell_val_num(name)))
+      continue;
+    meta->convert_tile_min_max_var_sizes_to_offsets(name);
+    tid = 0;
+    for (const auto& m : parts) {
+      for (uint64_t t = 0; t < m->tile_num(); ++t, ++tid) {
+        auto&& [st_min, min, min_size] = m->get_tile_min(name, t);
+        RETURN_NOT_OK(st_min);
+        auto&& [st_max, max, max_size] = m->get_tile_max(name, t);
+        RETURN_NOT_OK(st_max);
+        if (*min_size > 0)
+          meta->set_tile_min_var(name, tid, *min);
+        if (*max_size > 0)
+          meta->set_tile_max_var(name, tid, *max);
+      }
+    }
+  }
+
+  storage_manager_->stats()->add_counter("commit_frag_parts_num", parts.size());
+
+  // Store the metadata and make the fragment visible
+  RETURN_NOT_OK(meta->store(array_->get_encryption_key()));
+  auto ok_uri = URI(
+      fragment_uri.remove_trailing_slash().to_string() +
+      constants::ok_file_suffix);
+  return storage_manager_->vfs()->touch(ok_uri);
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+Status FragmentParts::load_parts(
+    const URI& fragment_uri,
+    std::vector<uint32_t>* ids,
+    std::vector<tdb_shared_ptr<FragmentMetadata>>* parts) const {
+  std::vector<URI> uris;
+  RETURN_NOT_OK(storage_manager_->vfs()->ls(fragment_uri, &uris));
+  for (const auto& uri : uris) {
+    if (!is_part(uri))
+      continue;
+    auto id = uri.remove_trailing_slash().last_path_part().substr(
+        constants::fragment_part_prefix.size());
+    if (id.empty() || id.find_first_not_of("0123456789") != std::string::npos)
+      continue;
+    ids->emplace_back((uint32_t)std::stoul(id));
+  }
+  if (ids->empty())
+    return LOG_STATUS(Status_WriterError(
+        "Cannot commit fragment parts; No parts found in '" +
+        fragment_uri.to_string() + "'"));
+
+  auto array_schema = array_->array_schema_latest();
+  std::vector<std::string> names;
+  for (const auto& attr : array_schema->attributes())
+    names.emplace_back(attr->name());
+
+  // Every part must have its metadata, which its writer stores last
+  const auto& enc_key = array_->get_encryption_key();
+  parts->resize(ids->size());
+  auto status = parallel_for(
+      storage_manager_->io_tp(), 0, ids->size(), [&](uint64_t i) {
+        auto& m = (*parts)[i];
+        m = tdb::make_shared<FragmentMetadata>(
+            HERE(),
+            storage_manager_,
+            nullptr,
+            array_schema,
+            part_uri(fragment_uri, (*ids)[i]),
+            std::pair<uint64_t, uint64_t>(0, 0),
+            true);
+        RETURN_NOT_OK(
+            m->load(enc_key, nullptr, 0, array_->array_schemas_all()));
+        RETURN_NOT_OK(m->load_tile_offsets(enc_key, std::vector(names)));
+        for (const auto& name : names) {
+          if (array_schema->var_size(name))
+            RETURN_NOT_OK(m->load_tile_var_sizes(enc_key, name));
+        }
+        RETURN_NOT_OK(m->load_tile_min_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(m->load_tile_max_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(m->load_tile_sum_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(
+            m->load_tile_null_count_values(enc_key, std::vector(names)));
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
+Status FragmentParts::order_parts(
+    unsigned split_dim,
+    std::vector<uint32_t>* ids,
+    std::vector<tdb_shared_ptr<FragmentMetadata>>* parts) const {
+  auto domain = array_->array_schema_latest()->domain();
+  const auto dim_num = domain->dim_num();
+  return apply_with_type(
+      domain->dimension(split_dim)->type(),
+      [&](auto t) {
+        using T = decltype(t);
+        auto start = [&](size_t p) {
+          return ((const T*)(*parts)[p]->non_empty_domain()[split_dim].data())
+              [0];
+        };
+        auto end = [&](size_t p) {
+          return ((const T*)(*parts)[p]->non_empty_domain()[split_dim].data())
+              [1];
+        };
+
+        std::vector<size_t> order(parts->size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+          return start(a) < start(b);
+        });
+        std::vector<uint32_t> sorted_ids;
+        std::vector<tdb_shared_ptr<FragmentMetadata>> sorted_parts;
+        for (auto p : order) {
+          sorted_ids.emplace_back((*ids)[p]);
+          sorted_parts.emplace_back((*parts)[p]);
+        }
+        *ids = std::move(sorted_ids);
+        *parts = std::move(sorted_parts);
+
+        for (size_t p = 1; p < parts->size(); ++p) {
+          for (unsigned d = 0; d < dim_num; ++d) {
+            if (d != split_dim &&
+                !((*parts)[p]->non_empty_domain()[d] ==
+                  (*parts)[0]->non_empty_domain()[d]))
+              return LOG_STATUS(Status_WriterError(
+                  "Cannot commit fragment parts; The parts must have the "
+                  "same ranges on all dimensions but the slowest varying "
+                  "one"));
+          }
+
+          // A part must end on a tile boundary, where the next part starts
+          const auto prev_end = end(p - 1);
+          const auto prev_tile_end =
+              ((const T*)(*parts)[p - 1]->domain()[split_dim].data())[1];
+          if (prev_end + 1 != start(p) || prev_end != prev_tile_end)
+            return LOG_STATUS(Status_WriterError(
+                "Cannot commit fragment parts; The parts must be adjacent "
+                "and end on tile boundaries"));
+        }
+
+        return Status::Ok();
+      },
+      [&]() {
+        return LOG_STATUS(Status_WriterError(
+            "Cannot commit fragment parts; Unsupported dimension type"));
+      });
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,149 @@
+/**
+ * @file  fragment_parts.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FragmentParts.
+ */
+
+#ifndef TILEDB_FRAGMENT_PARTS_H
+#define TILEDB_FRAGMENT_PARTS_H
+
+#include <string>
+#include <vector>
+
+#include "tiledb/common/heap_memory.h"
+#include "tiledb/common/macros.h"
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filesystem/uri.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Array;
+class FragmentMetadata;
+class StorageManager;
+
+/**
+ * A dense fragment written in parts by several writers, possibly in
+ * different processes, and committed once all the parts are written.
+ *
+ * Each writer writes the tiles of a slab of the fragment, along the slowest
+ * varying dimension of the tile order, into a part directory within the
+ * fragment directory, and stores the metadata of its part there. The
+ * commit merges the metadata of the parts into that of the fragment,
+ * whose tile offsets locate the tiles in the part files, so no tile data
+ * is rewritten.
+ */
+class FragmentParts {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param array The array of the fragment, opened for writes.
+   * @param storage_manager The storage manager.
+   */
+  FragmentParts(Array* array, StorageManager* storage_manager);
+
+  /** Destructor. */
+  ~FragmentParts() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(FragmentParts);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(FragmentParts);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns true if the input URI is that of a part of a fragment. */
+  static bool is_part(const URI& uri);
+
+  /** Returns the URI of a part of a fragment written in parts. */
+  static URI part_uri(const URI& fragment_uri, uint32_t part);
+
+  /**
+   * Generates the URI of a new fragment to be written in parts, at the
+   * timestamp the array is opened at.
+   */
+  Status new_fragment_uri(URI* uri) const;
+
+  /**
+   * Commits a fragment written in parts, merging the metadata of its parts
+   * and making the fragment visible. The parts must be tile-aligned slabs
+   * along the slowest varying dimension of the tile order, which together
+   * cover a contiguous range of that dimension.
+   *
+   * @param fragment_uri The URI of the fragment.
+   * @return Status
+   */
+  Status commit(const URI& fragment_uri) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The array of the fragment. */
+  Array* array_;
+
+  /** The storage manager. */
+  StorageManager* storage_manager_;
+
+  /* ********************************* */
+  /*           PRIVATE METHODS         */
+  /* ********************************* */
+
+  /**
+   * Loads the metadata of the parts of a fragment, along with their tile
+   * offsets and tile metadata.
+   */
+  Status load_parts(
+      const URI& fragment_uri,
+      std::vector<uint32_t>* ids,
+      std::vector<tdb_shared_ptr<FragmentMetadata>>* parts) const;
+
+  /**
+   * Sorts the parts along the input dimension, and checks that they are
+   * adjacent tile-aligned slabs along it with the same ranges on the other
+   * dimensions.
+   */
+  Status order_parts(
+      unsigned split_dim,
+      std::vector<uint32_t>* ids,
+      std::vector<tdb_shared_ptr<FragmentMetadata>>* parts) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAGMENT_PARTS_H
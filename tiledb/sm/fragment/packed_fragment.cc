@@ -0,0 +1,119 @@
+/**
+ * @file  packed_fragment.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class PackedFragment.
+ */
+
+#include "tiledb/sm/fragment/packed_fragment.h"
+#include "tiledb/sm/buffer/buffer.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void PackedFragment::append(
+    const std::string& file_name, const void* data, uint64_t size) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = file_idx_.find(file_name);
+  if (it == file_idx_.end()) {
+    it = file_idx_.emplace(file_name, files_.size()).first;
+    files_.emplace_back(file_name, std::vector<uint8_t>());
+  }
+
+  auto& file = files_[it->second].second;
+  auto bytes = static_cast<const uint8_t*>(data);
+  file.insert(file.end(), bytes, bytes + size);
+}
+
+// ===== FORMAT =====
+// file#1 (char[]) ... file#<file_num> (char[])
+// file_num (uint32_t)
+//   name_size (uint32_t) | name (char[]) | offset (uint64_t) | size (uint64_t)
+//   ...
+// index_size (uint64_t)
+Status PackedFragment::serialize(Buffer* buff) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (const auto& file : files_)
+    RETURN_NOT_OK(buff->write(file.second.data(), file.second.size()));
+
+  const uint64_t index_start = buff->size();
+  auto file_num = (uint32_t)files_.size();
+  RETURN_NOT_OK(buff->write(&file_num, sizeof(uint32_t)));
+  uint64_t offset = 0;
+  for (const auto& file : files_) {
+    auto name_size = (uint32_t)file.first.size();
+    uint64_t size = file.second.size();
+    RETURN_NOT_OK(buff->write(&name_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff->write(file.first.data(), name_size));
+    RETURN_NOT_OK(buff->write(&offset, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff->write(&size, sizeof(uint64_t)));
+    offset += size;
+  }
+
+  uint64_t index_size = buff->size() - index_start;
+  RETURN_NOT_OK(buff->write(&index_size, sizeof(uint64_t)));
+
+  return Status::Ok();
+}
+
+Status PackedFragment::deserialize_index(ConstBuffer* cbuff) {
+  uint32_t file_num, name_size;
+  uint64_t offset, size;
+  index_.clear();
+  RETURN_NOT_OK(cbuff->read(&file_num, sizeof(uint32_t)));
+  for (uint32_t f = 0; f < file_num; ++f) {
+    RETURN_NOT_OK(cbuff->read(&name_size, sizeof(uint32_t)));
+    if (name_size > cbuff->nbytes_left_to_read())
+      return Status_FragmentMetadataError(
+          "Cannot deserialize packed fragment index; Buffer too small");
+    std::string name(name_size, '\0');
+    RETURN_NOT_OK(cbuff->read(name.data(), name_size));
+    RETURN_NOT_OK(cbuff->read(&offset, sizeof(uint64_t)));
+    RETURN_NOT_OK(cbuff->read(&size, sizeof(uint64_t)));
+    index_[name] = {offset, size};
+  }
+
+  return Status::Ok();
+}
+
+std::optional<std::pair<uint64_t, uint64_t>> PackedFragment::file(
+    const std::string& file_name) const {
+  auto it = index_.find(file_name);
+  if (it == index_.end())
+    return std::nullopt;
+  return it->second;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,131 @@
+/**
+ * @file  packed_fragment.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class PackedFragment.
+ */
+
+#ifndef TILEDB_PACKED_FRAGMENT_H
+#define TILEDB_PACKED_FRAGMENT_H
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tiledb/common/macros.h"
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Buffer;
+class ConstBuffer;
+
+/**
+ * The files of a fragment packed in a single object, followed by an index
+ * of the files. Small fragments are written this way with a single PUT,
+ * instead of one PUT per attribute file plus the metadata and ok files.
+ *
+ * While a fragment is written, the data appended to each of its files is
+ * staged in memory. Once loaded, the index locates the files within the
+ * object.
+ */
+class PackedFragment {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  PackedFragment() = default;
+
+  /** Destructor. */
+  ~PackedFragment() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(PackedFragment);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(PackedFragment);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Appends data to a file, creating the file on its first append. It is
+   * safe to append to different files concurrently.
+   *
+   * @param file_name The name of the file within the fragment.
+   * @param data The data to append.
+   * @param size The data size in bytes.
+   */
+  void append(const std::string& file_name, const void* data, uint64_t size);
+
+  /** Serializes the files followed by their index into the input buffer. */
+  Status serialize(Buffer* buff) const;
+
+  /**
+   * Deserializes the index of a packed fragment.
+   *
+   * @param cbuff The buffer with the index, without its trailing size.
+   * @return Status
+   */
+  Status deserialize_index(ConstBuffer* cbuff);
+
+  /**
+   * Returns the offset and size of a file within the packed object, or
+   * nullopt if the fragment has no such file.
+   */
+  std::optional<std::pair<uint64_t, uint64_t>> file(
+      const std::string& file_name) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The staged files, in the order they were created. */
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> files_;
+
+  /** Maps a file name to its position in `files_`. */
+  std::unordered_map<std::string, size_t> file_idx_;
+
+  /** Maps a file name to its offset and size in a loaded object. */
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> index_;
+
+  /** Protects `files_` and `file_idx_`. */
+  mutable std::mutex mtx_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_PACKED_FRAGMENT_H
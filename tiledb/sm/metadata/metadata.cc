@@ -56,6 +56,8 @@ Metadata::Metadata() {
 
 Metadata::Metadata(const Metadata& rhs)
     : metadata_map_(rhs.metadata_map_)
+    , metadata_buffs_(rhs.metadata_buffs_)
+    , deleted_keys_(rhs.deleted_keys_)
     , timestamp_range_(rhs.timestamp_range_)
     , loaded_metadata_uris_(rhs.loaded_metadata_uris_)
     , uri_(rhs.uri_) {
@@ -71,7 +73,9 @@ Metadata::~Metadata() = default;
 
 void Metadata::clear() {
   metadata_map_.clear();
+  metadata_buffs_.clear();
   metadata_index_.clear();
+  deleted_keys_.clear();
   loaded_metadata_uris_.clear();
   timestamp_range_ = std::make_pair(0, 0);
   uri_ = URI();
@@ -105,10 +109,16 @@ Status Metadata::deserialize(
   if (metadata_buffs.empty())
     return Status::Ok();
 
+  // Replay the buffers from the newest one, so that only the latest value
+  // of every key is indexed. Every buffer holds a key at most once, in sorted
+  // order if it was serialized by `serialize`, which makes the insertions
+  // amortized constant time for consolidated metadata. The values are not
+  // copied, they are read in place on access.
   uint32_t key_len;
   char del;
   size_t value_len;
-  for (const auto& buff : metadata_buffs) {
+  for (auto b = metadata_buffs.rbegin(); b != metadata_buffs.rend(); ++b) {
+    const auto& buff = *b;
     // Iterate over all items
     buff->reset_offset();
     while (buff->offset() != buff->size()) {
@@ -117,37 +127,53 @@ Status Metadata::deserialize(
       buff->advance_offset(key_len);
       RETURN_NOT_OK(buff->read(&del, sizeof(char)));
 
-      metadata_map_.erase(key);
-
-      // Handle deletion
-      if (del)
+      // Skip the items overwritten or deleted by newer buffers
+      auto it = metadata_map_.lower_bound(key);
+      bool newer = (it != metadata_map_.end() && it->first == key) ||
+                   deleted_keys_.count(key) > 0;
+      if (del) {
+        if (!newer)
+          deleted_keys_.emplace(std::move(key));
         continue;
+      }
 
       MetadataValue value_struct;
       value_struct.del_ = del;
       RETURN_NOT_OK(buff->read(&value_struct.type_, sizeof(char)));
       RETURN_NOT_OK(buff->read(&value_struct.num_, sizeof(uint32_t)));
-      if (value_struct.num_) {
-        value_len = value_struct.num_ *
-                    datatype_size(static_cast<Datatype>(value_struct.type_));
-        value_struct.value_.resize(value_len);
-        RETURN_NOT_OK(buff->read((void*)value_struct.value_.data(), value_len));
+      value_len = value_struct.num_ *
+                  datatype_size(static_cast<Datatype>(value_struct.type_));
+      if (value_len > buff->size() - buff->offset())
+        return LOG_STATUS(Status_MetadataError(
+            "Cannot deserialize metadata; value of key '" + key +
+            "' exceeds the metadata buffer"));
+      if (newer) {
+        buff->advance_offset(value_len);
+        continue;
+      }
+      if (value_len) {
+        value_struct.ref_ = static_cast<const uint8_t*>(buff->cur_data());
+        value_struct.ref_size_ = value_len;
+        buff->advance_offset(value_len);
       }
 
       // Insert to metadata
-      metadata_map_.emplace(std::make_pair(key, std::move(value_struct)));
+      metadata_map_.emplace_hint(it, std::move(key), std::move(value_struct));
     }
   }
 
-  build_metadata_index();
-  // Note: `metadata_map_` and `metadata_index_` are immutable after this point
+  // Keep the buffers holding the values
+  metadata_buffs_ = metadata_buffs;
+
+  // Note: `metadata_map_` is immutable after this point. The index is built
+  // on the first access by index.
 
   return Status::Ok();
 }
 
 Status Metadata::serialize(Buffer* buff) const {
   // Do nothing if there are no metadata to serialize
-  if (metadata_map_.empty())
+  if (metadata_map_.empty() && deleted_keys_.empty())
     return Status::Ok();
 
   for (const auto& meta : metadata_map_) {
@@ -160,13 +186,25 @@ Status Metadata::serialize(Buffer* buff) const {
       RETURN_NOT_OK(buff->write(&value.type_, sizeof(char)));
       RETURN_NOT_OK(buff->write(&value.num_, sizeof(uint32_t)));
       if (value.num_)
-        RETURN_NOT_OK(buff->write(value.value_.data(), value.value_.size()));
+        RETURN_NOT_OK(buff->write(value.data(), value.size()));
     }
   }
 
+  const char del = 1;
+  for (const auto& key : deleted_keys_) {
+    auto key_len = (uint32_t)key.size();
+    RETURN_NOT_OK(buff->write(&key_len, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff->write(key.data(), key.size()));
+    RETURN_NOT_OK(buff->write(&del, sizeof(char)));
+  }
+
   return Status::Ok();
 }
 
+void Metadata::clear_deleted_keys() {
+  deleted_keys_.clear();
+}
+
 const std::pair<uint64_t, uint64_t>& Metadata::timestamp_range() const {
   return timestamp_range_;
 }
@@ -235,7 +273,7 @@ Status Metadata::get(
     *value = nullptr;
   } else {
     *value_num = value_struct.num_;
-    *value = (const void*)(value_struct.value_.data());
+    *value = (const void*)(value_struct.data());
   }
 
   return Status::Ok();
@@ -248,8 +286,11 @@ Status Metadata::get(
     Datatype* value_type,
     uint32_t* value_num,
     const void** value) {
-  if (metadata_index_.empty())
-    build_metadata_index();
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (metadata_index_.size() != metadata_map_.size())
+      build_metadata_index();
+  }
 
   if (index >= metadata_index_.size())
     return LOG_STATUS(
@@ -269,7 +310,7 @@ Status Metadata::get(
     *value = nullptr;
   } else {
     *value_num = value_struct.num_;
-    *value = (const void*)(value_struct.value_.data());
+    *value = (const void*)(value_struct.data());
   }
   return Status::Ok();
 }
@@ -317,7 +358,9 @@ const std::vector<URI>& Metadata::loaded_metadata_uris() const {
 
 void Metadata::swap(Metadata* metadata) {
   std::swap(metadata_map_, metadata->metadata_map_);
+  std::swap(metadata_buffs_, metadata->metadata_buffs_);
   std::swap(metadata_index_, metadata->metadata_index_);
+  std::swap(deleted_keys_, metadata->deleted_keys_);
   std::swap(timestamp_range_, metadata->timestamp_range_);
   std::swap(loaded_metadata_uris_, metadata->loaded_metadata_uris_);
 }
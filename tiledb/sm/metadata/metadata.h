@@ -36,6 +36,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "tiledb/common/heap_memory.h"
@@ -67,7 +68,11 @@ class Metadata {
   /*       PUBLIC TYPE DEFINITIONS     */
   /* ********************************* */
 
-  /** Represents a metadata value. */
+  /**
+   * Represents a metadata value. The values of deserialized metadata are not
+   * copied: they are read in place from the loaded metadata buffers, which
+   * the object keeps alive, whereas the values put by the user are owned.
+   */
   struct MetadataValue {
     /** 1 if it is a deletion and 0 if it is an insertion. */
     char del_ = 0;
@@ -75,8 +80,22 @@ class Metadata {
     char type_ = 0;
     /** The number of values. */
     uint32_t num_ = 0;
-    /** The value in binary format. */
+    /** The value in binary format, if owned. */
     std::vector<uint8_t> value_;
+    /** The value in a loaded metadata buffer, if not owned. */
+    const uint8_t* ref_ = nullptr;
+    /** The size of the value pointed to by `ref_`. */
+    uint64_t ref_size_ = 0;
+
+    /** Returns the value in binary format. */
+    const uint8_t* data() const {
+      return ref_ != nullptr ? ref_ : value_.data();
+    }
+
+    /** Returns the size of the value in bytes. */
+    uint64_t size() const {
+      return ref_ != nullptr ? ref_size_ : value_.size();
+    }
   };
 
   /** Iterator type for iterating over metadata values. */
@@ -112,12 +131,24 @@ class Metadata {
    * Deserializes the input metadata buffers. Note that the buffers are
    * assummed to be sorted on time. The function will take care of any
    * deleted or overwritten metadata items considering the order.
+   *
+   * Only the keys are copied, the values are read from the buffers, which
+   * the object keeps until it is cleared.
    */
   Status deserialize(const std::vector<tdb_shared_ptr<Buffer>>& metadata_buffs);
 
-  /** Serializes all key-value metadata items into the input buffer. */
+  /**
+   * Serializes all key-value metadata items into the input buffer, along
+   * with the deletions of the keys deleted by the deserialized metadata.
+   */
   Status serialize(Buffer* buff) const;
 
+  /**
+   * Forgets the keys deleted by the deserialized metadata, which need not be
+   * serialized when the metadata covers all the array metadata.
+   */
+  void clear_deleted_keys();
+
   /** Returns the timestamp range. */
   const std::pair<uint64_t, uint64_t>& timestamp_range() const;
 
@@ -234,6 +265,13 @@ class Metadata {
   /** A map from metadata key to metadata value. */
   std::map<std::string, MetadataValue> metadata_map_;
 
+  /**
+   * The deserialized metadata buffers, which hold the values of the
+   * deserialized items. They are shared by the copies of the object and
+   * are not modified after deserialization.
+   */
+  std::vector<tdb_shared_ptr<Buffer>> metadata_buffs_;
+
   /**
    * A vector pointing to all the values in `metadata_map_`. It facilitates
    * searching metadata from index. Used only for reading metadata (inapplicable
@@ -241,6 +279,13 @@ class Metadata {
    */
   std::vector<std::pair<const std::string*, MetadataValue*>> metadata_index_;
 
+  /**
+   * The keys deleted by the deserialized metadata, which are not in
+   * `metadata_map_`. They are serialized as deletions, so that merging only
+   * the newer metadata files does not revive the values of older ones.
+   */
+  std::set<std::string> deleted_keys_;
+
   /** Mutex for thread-safety. */
   mutable std::mutex mtx_;
 
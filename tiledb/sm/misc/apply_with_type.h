@@ -0,0 +1,117 @@
+/**
+ * @file   apply_with_type.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines `apply_with_type`, which resolves a Datatype to the C++
+ * type the typed kernels of the storage manager are instantiated with.
+ */
+
+#ifndef TILEDB_APPLY_WITH_TYPE_H
+#define TILEDB_APPLY_WITH_TYPE_H
+
+#include <cstdint>
+#include <utility>
+
+#include "tiledb/sm/enums/datatype.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Calls `fn` with a value of the C++ type that stores `type`, and returns
+ * its result. Integer and floating point types map to themselves, and the
+ * DATETIME_* and TIME_* types map to int64_t. `unsupported` is called
+ * instead for every other type (strings, chars, blobs, etc.), which the
+ * caller either handles separately or reports as an error.
+ *
+ * This is the single place the numeric datatype switch lives: the type is
+ * resolved once, typically when a function pointer is selected or before a
+ * loop over the cells of a tile, and the kernel `fn` then runs on the
+ * concrete type.
+ *
+ * @param type The datatype to dispatch on.
+ * @param fn Generic callable taking a value of the resolved type.
+ * @param unsupported Callable taking no arguments, returning the same type
+ *     as `fn`.
+ */
+template <class Fn, class Unsupported>
+decltype(auto) apply_with_type(
+    const Datatype type, Fn&& fn, Unsupported&& unsupported) {
+  switch (type) {
+    case Datatype::INT8:
+      return std::forward<Fn>(fn)(int8_t());
+    case Datatype::UINT8:
+      return std::forward<Fn>(fn)(uint8_t());
+    case Datatype::INT16:
+      return std::forward<Fn>(fn)(int16_t());
+    case Datatype::UINT16:
+      return std::forward<Fn>(fn)(uint16_t());
+    case Datatype::INT32:
+      return std::forward<Fn>(fn)(int32_t());
+    case Datatype::UINT32:
+      return std::forward<Fn>(fn)(uint32_t());
+    case Datatype::INT64:
+      return std::forward<Fn>(fn)(int64_t());
+    case Datatype::UINT64:
+      return std::forward<Fn>(fn)(uint64_t());
+    case Datatype::FLOAT32:
+      return std::forward<Fn>(fn)(float());
+    case Datatype::FLOAT64:
+      return std::forward<Fn>(fn)(double());
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+    case Datatype::TIME_HR:
+    case Datatype::TIME_MIN:
+    case Datatype::TIME_SEC:
+    case Datatype::TIME_MS:
+    case Datatype::TIME_US:
+    case Datatype::TIME_NS:
+    case Datatype::TIME_PS:
+    case Datatype::TIME_FS:
+    case Datatype::TIME_AS:
+      return std::forward<Fn>(fn)(int64_t());
+    default:
+      return std::forward<Unsupported>(unsupported)();
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_APPLY_WITH_TYPE_H
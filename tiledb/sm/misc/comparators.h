@@ -461,6 +461,209 @@ class GlobalCmpReverse {
   GlobalCmp cmp_;
 };
 
+/**
+ * Wrapper of comparison function for sorting coords on the global order,
+ * specialized on a domain of `N` fixed-sized dimensions that all have type
+ * `T`. The per-dimension orders, domain lows and tile extents are resolved
+ * once at construction, and the coordinates are read directly from the
+ * result tiles or buffers, so that a comparison involves no virtual or
+ * function pointer dispatch and the loops over `N` can be unrolled. The
+ * order is the same as that of `GlobalCmp`. Use `with_global_cmp()` to
+ * pick it when the domain allows it.
+ */
+template <class T, unsigned N>
+class TypedGlobalCmp {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param domain The array domain.
+   * @param buffs The coordinate query buffers, one per dimension, used
+   *     in positional comparisons.
+   */
+  TypedGlobalCmp(
+      const Domain* domain,
+      const std::vector<const QueryBuffer*>* buffs = nullptr) {
+    assert(domain->dim_num() == N);
+    const bool tile_row = domain->tile_order() == Layout::ROW_MAJOR;
+    const bool cell_row = domain->cell_order() == Layout::ROW_MAJOR;
+    tile_dim_num_ = 0;
+    for (unsigned i = 0; i < N; ++i) {
+      // Dimensions without a tile extent do not take part in the tile order
+      const unsigned d = tile_row ? i : N - 1 - i;
+      const auto dim = domain->dimension(d);
+      if (dim->tile_extent()) {
+        tile_dims_[tile_dim_num_] = d;
+        domain_low_[tile_dim_num_] = *(const T*)dim->domain().data();
+        tile_extent_[tile_dim_num_] = *(const T*)dim->tile_extent().data();
+        ++tile_dim_num_;
+      }
+      cell_dims_[i] = cell_row ? i : N - 1 - i;
+      data_[i] = buffs != nullptr ? (const T*)(*buffs)[i]->buffer_ : nullptr;
+    }
+  }
+
+  /**
+   * Comparison operator for a vector of `ResultCoords`.
+   *
+   * @param a The first coordinate.
+   * @param b The second coordinate.
+   * @return `true` if `a` precedes `b` and `false` otherwise.
+   */
+  bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    T ca[N], cb[N];
+    for (unsigned d = 0; d < N; ++d) {
+      ca[d] = a.tile_->template coord_as<T>(a.pos_, d);
+      cb[d] = b.tile_->template coord_as<T>(b.pos_, d);
+    }
+    return less(ca, cb);
+  }
+
+  /**
+   * Positional comparison operator.
+   *
+   * @param a The first cell position.
+   * @param b The second cell position.
+   * @return `true` if cell at `a` across all coordinate buffers precedes
+   *     cell at `b`, and `false` otherwise.
+   */
+  bool operator()(uint64_t a, uint64_t b) const {
+    assert(data_[0] != nullptr);
+    T ca[N], cb[N];
+    for (unsigned d = 0; d < N; ++d) {
+      ca[d] = data_[d][a];
+      cb[d] = data_[d][b];
+    }
+    return less(ca, cb);
+  }
+
+ private:
+  /** Number of dimensions with a tile extent. */
+  unsigned tile_dim_num_;
+  /** The dimensions with a tile extent, in tile order. */
+  unsigned tile_dims_[N];
+  /** The domain lows of `tile_dims_`. */
+  T domain_low_[N];
+  /** The tile extents of `tile_dims_`. */
+  T tile_extent_[N];
+  /** The dimensions in cell order. */
+  unsigned cell_dims_[N];
+  /** The coordinate buffers, used in positional comparisons. */
+  const T* data_[N];
+
+  /** Returns `true` if coordinates `a` precede coordinates `b`. */
+  bool less(const T* a, const T* b) const {
+    for (unsigned i = 0; i < N; ++i) {
+      if (i == tile_dim_num_)
+        break;
+      const auto d = tile_dims_[i];
+      const auto ta =
+          Dimension::tile_idx<T>(a[d], domain_low_[i], tile_extent_[i]);
+      const auto tb =
+          Dimension::tile_idx<T>(b[d], domain_low_[i], tile_extent_[i]);
+      if (ta != tb)
+        return ta < tb;
+    }
+
+    for (unsigned i = 0; i < N; ++i) {
+      const auto d = cell_dims_[i];
+      if (a[d] != b[d])
+        return a[d] < b[d];
+    }
+
+    return false;
+  }
+};
+
+/**
+ * Wrapper of comparison function for sorting coords on the global order of
+ * cells in reverse, specialized as `TypedGlobalCmp`.
+ */
+template <class T, unsigned N>
+class TypedGlobalCmpReverse {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param domain The array domain.
+   * @param buffs The coordinate query buffers, one per dimension.
+   */
+  TypedGlobalCmpReverse(
+      const Domain* domain,
+      const std::vector<const QueryBuffer*>* buffs = nullptr)
+      : cmp_(domain, buffs) {
+  }
+
+  /**
+   * Comparison operator for a vector of `ResultCoords`.
+   *
+   * @param a The first coordinate.
+   * @param b The second coordinate.
+   * @return `true` if `a` precedes `b` and `false` otherwise.
+   */
+  bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    return !cmp_.operator()(a, b);
+  }
+
+ private:
+  /** TypedGlobalCmp. */
+  TypedGlobalCmp<T, N> cmp_;
+};
+
+/**
+ * Calls `f` with the global order comparator best suited to the domain,
+ * and returns its result. This is `TypedCmp<T, N>` if the domain has up to
+ * four dimensions, all with the same 32 or 64-bit integer type (including
+ * the datetime and time types), and row or col-major tile and cell orders.
+ * Otherwise, `f` is called with `fallback`. Restricting the specialization
+ * to these common schemas bounds the number of instantiations of `f`.
+ *
+ * @tparam TypedCmp `TypedGlobalCmp` or `TypedGlobalCmpReverse`.
+ * @param domain The array domain.
+ * @param buffs The coordinate query buffers, or `nullptr`.
+ * @param fallback The generic comparator.
+ * @param f A callable taking the comparator.
+ */
+template <template <class, unsigned> class TypedCmp, class Cmp, class F>
+auto with_global_cmp(
+    const Domain* domain,
+    const std::vector<const QueryBuffer*>* buffs,
+    const Cmp& fallback,
+    F&& f) {
+  const auto dim_num = domain->dim_num();
+  const auto is_row_col = [](Layout l) {
+    return l == Layout::ROW_MAJOR || l == Layout::COL_MAJOR;
+  };
+  if (dim_num == 0 || dim_num > 4 || !domain->all_dims_same_type() ||
+      !is_row_col(domain->tile_order()) || !is_row_col(domain->cell_order()))
+    return f(fallback);
+
+  const auto type = domain->dimension(0)->type();
+  auto with_dim_num = [&](auto t) {
+    using T = decltype(t);
+    switch (dim_num) {
+      case 1:
+        return f(TypedCmp<T, 1>(domain, buffs));
+      case 2:
+        return f(TypedCmp<T, 2>(domain, buffs));
+      case 3:
+        return f(TypedCmp<T, 3>(domain, buffs));
+      default:
+        return f(TypedCmp<T, 4>(domain, buffs));
+    }
+  };
+  if (type == Datatype::INT32)
+    return with_dim_num(int32_t());
+  if (type == Datatype::UINT32)
+    return with_dim_num(uint32_t());
+  if (type == Datatype::UINT64)
+    return with_dim_num(uint64_t());
+  if (type == Datatype::INT64 || datatype_is_datetime(type) ||
+      datatype_is_time(type))
+    return with_dim_num(int64_t());
+  return f(fallback);
+}
+
 }  // namespace sm
 }  // namespace tiledb
 
@@ -77,9 +77,44 @@ const std::string array_schema_folder_name = "__schema";
 /** The array metadata folder name. */
 const std::string array_metadata_folder_name = "__meta";
 
+/** The folder name of the dimension label arrays of an array. */
+const std::string array_dimension_labels_folder_name = "__labels";
+
 /** The fragment metadata file name. */
 const std::string fragment_metadata_filename = "__fragment_metadata.tdb";
 
+/** The file name of the Bloom filter over the coordinates of a fragment. */
+const std::string coords_bloom_filter_filename = "__coords_bloom_filter.tdb";
+
+/** The file name of the attribute value index of a fragment. */
+const std::string attribute_index_filename = "__attribute_index.tdb";
+
+/** The file name of the part table of a fragment written in parts. */
+const std::string fragment_parts_filename = "__fragment_parts.tdb";
+
+/** The number of Bloom filter bits per cell of the attribute value index. */
+const uint64_t attribute_index_bits_per_cell = 10;
+
+/**
+ * The minimum number of ranges of an integer dimension for which the
+ * subarray ranges are sorted with a radix sort instead of a comparison
+ * sort.
+ */
+const uint64_t range_radix_sort_min_num = 4096;
+
+/**
+ * The minimum number of fragments of an open array for which the relevant
+ * fragments of a subarray are found through an index over the fragment
+ * non-empty domains instead of testing every fragment.
+ */
+const uint64_t fragment_domain_index_min_fragment_num = 64;
+
+/**
+ * The number of bytes read ahead from the end of each fragment metadata file
+ * on array open, expected to hold the footer.
+ */
+const uint64_t fragment_metadata_tail_size = 8192;
+
 /** The default tile capacity. */
 const uint64_t capacity = 10000;
 
@@ -89,6 +124,9 @@ const uint64_t cell_var_offset_size = sizeof(uint64_t);
 /** The type of a variable cell offset. */
 const Datatype cell_var_offset_type = Datatype::UINT64;
 
+/** The maximum size of the var size min/max values stored per tile. */
+const uint64_t tile_min_max_var_prefix_size = 64;
+
 /** The size of a validity cell. */
 const uint64_t cell_validity_size = sizeof(uint8_t);
 
@@ -98,12 +136,6 @@ const Datatype cell_validity_type = Datatype::UINT8;
 /** A special value indicating variable size. */
 const uint64_t var_size = std::numeric_limits<uint64_t>::max();
 
-/** The default compressor for the offsets of variable-sized cells. */
-Compressor cell_var_offsets_compression = Compressor::ZSTD;
-
-/** The default compression level for the offsets of variable-sized cells. */
-int cell_var_offsets_compression_level = -1;
-
 /** The default compressor for the validity value cells. */
 Compressor cell_validity_compression = Compressor::RLE;
 
@@ -188,6 +220,15 @@ const std::string vacuum_file_suffix = ".vac";
 /** Suffix for the special ok files used in TileDB. */
 const std::string ok_file_suffix = ".ok";
 
+/** Suffix for the single-file packed fragments. */
+const std::string packed_fragment_suffix = ".pack";
+
+/** Suffix for the fragments written in parts by several writers. */
+const std::string fragment_parts_suffix = ".parts";
+
+/** Prefix of the directories of the parts of a fragment. */
+const std::string fragment_part_prefix = "__part_";
+
 /** Suffix for the special metadata files used in TileDB. */
 const std::string meta_file_suffix = ".meta";
 
@@ -209,6 +250,36 @@ const std::string group_filename = "__tiledb_group.tdb";
 /** The maximum number of bytes written in a single I/O. */
 const uint64_t max_write_bytes = std::numeric_limits<int>::max();
 
+/** The maximum number of entries of an io_uring submission queue. */
+const uint32_t io_uring_queue_depth = 128;
+
+/** The maximum number of overlapped I/Os in flight on a Windows file. */
+const uint32_t overlapped_io_queue_depth = 128;
+
+/** The maximum number of idle HDFS file handles kept open for reads. */
+const uint64_t hdfs_max_idle_read_handles = 64;
+
+/** The offset, buffer and size alignment of direct (`O_DIRECT`) reads. */
+const uint64_t direct_io_alignment = 4096;
+
+/** The maximum size of the aligned scratch buffer of a direct read. */
+const uint64_t direct_io_max_scratch_size = 8 * 1024 * 1024;
+
+/** The number of reads observed before the read batch gap is adapted. */
+const uint64_t adaptive_batch_gap_min_samples = 8;
+
+/** The weight of a new read in the moving estimates of the read costs. */
+const double adaptive_batch_gap_smoothing = 0.1;
+
+/** The maximum adaptive read batch gap in bytes. */
+const uint64_t adaptive_batch_gap_max = 64 * 1024 * 1024;
+
+/** The maximum read-ahead window of a stream, in read-ahead sizes. */
+const uint64_t read_ahead_max_window_multiplier = 16;
+
+/** The number of file read streams tracked for sequential read-ahead. */
+const uint64_t read_ahead_max_streams = 1024;
+
 /** The maximum file path length (depending on platform). */
 #ifndef _WIN32
 const uint32_t path_max_len = PATH_MAX;
@@ -244,6 +315,9 @@ const std::string query_status_incomplete_str = "INCOMPLETE";
 /** TILEDB_UNINITIALIZED Query String **/
 const std::string query_status_uninitialized_str = "UNINITIALIZED";
 
+/** TILEDB_CANCELLED Query String **/
+const std::string query_status_cancelled_str = "CANCELLED";
+
 /** TILEDB_LT Query Condition Op String **/
 const std::string query_condition_op_lt_str = "LT";
 
@@ -262,6 +336,15 @@ const std::string query_condition_op_eq_str = "EQ";
 /** TILEDB_NE Query Condition Op String **/
 const std::string query_condition_op_ne_str = "NE";
 
+/** TILEDB_IN Query Condition Op String **/
+const std::string query_condition_op_in_str = "IN";
+
+/** TILEDB_NOT_IN Query Condition Op String **/
+const std::string query_condition_op_not_in_str = "NOT_IN";
+
+/** TILEDB_PREFIX Query Condition Op String **/
+const std::string query_condition_op_prefix_str = "PREFIX";
+
 /** TILEDB_AND Query Condition Combination Op String **/
 const std::string query_condition_combination_op_and_str = "AND";
 
@@ -271,6 +354,21 @@ const std::string query_condition_combination_op_or_str = "OR";
 /** TILEDB_NOT Query Condition Combination Op String **/
 const std::string query_condition_combination_op_not_str = "NOT";
 
+/** TILEDB_AGGREGATE_COUNT Query Aggregate Op String **/
+const std::string query_aggregate_op_count_str = "AGGREGATE_COUNT";
+
+/** TILEDB_AGGREGATE_SUM Query Aggregate Op String **/
+const std::string query_aggregate_op_sum_str = "AGGREGATE_SUM";
+
+/** TILEDB_AGGREGATE_MIN Query Aggregate Op String **/
+const std::string query_aggregate_op_min_str = "AGGREGATE_MIN";
+
+/** TILEDB_AGGREGATE_MAX Query Aggregate Op String **/
+const std::string query_aggregate_op_max_str = "AGGREGATE_MAX";
+
+/** TILEDB_AGGREGATE_NULL_COUNT Query Aggregate Op String **/
+const std::string query_aggregate_op_null_count_str = "AGGREGATE_NULL_COUNT";
+
 /** TILEDB_COMPRESSION Filter type string */
 const std::string filter_type_compression_str = "COMPRESSION";
 
@@ -325,6 +423,24 @@ const std::string filter_checksum_md5_str = "CHECKSUM_MD5";
 /** String describing FILTER_CHECKSUM_SHA256. */
 const std::string filter_checksum_sha256_str = "CHECKSUM_SHA256";
 
+/** String describing FILTER_DICTIONARY. */
+const std::string filter_dictionary_str = "DICTIONARY";
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+const std::string filter_frame_of_reference_str = "FRAME_OF_REFERENCE";
+
+/** String describing FILTER_FLOAT_XOR. */
+const std::string filter_float_xor_str = "FLOAT_XOR";
+
+/** String describing FILTER_AUTO_COMPRESSION. */
+const std::string filter_auto_compression_str = "AUTO_COMPRESSION";
+
+/** String describing FILTER_CHECKSUM_CRC32C. */
+const std::string filter_checksum_crc32c_str = "CHECKSUM_CRC32C";
+
+/** String describing FILTER_BITMAP. */
+const std::string filter_bitmap_str = "BITMAP";
+
 /** The string representation for FilterOption type compression_level. */
 const std::string filter_option_compression_level_str = "COMPRESSION_LEVEL";
 
@@ -337,6 +453,11 @@ const std::string filter_option_bit_width_max_window_str =
 const std::string filter_option_positive_delta_max_window_str =
     "POSITIVE_DELTA_MAX_WINDOW";
 
+/** The string representation for FilterOption type
+ * auto_compression_speed_bias. */
+const std::string filter_option_auto_compression_speed_bias_str =
+    "AUTO_COMPRESSION_SPEED_BIAS";
+
 /** The string representation for type int32. */
 const std::string int32_str = "INT32";
 
@@ -481,6 +602,9 @@ const std::string unordered_str = "unordered";
 /** The string representation for the Hilbert layout. */
 const std::string hilbert_str = "hilbert";
 
+/** The string representation for the Morton layout. */
+const std::string morton_str = "morton";
+
 /** The string representation of null. */
 const std::string null_str = "null";
 
@@ -514,6 +638,24 @@ const std::string walkorder_preorder_str = "PREORDER";
 /** The string representation for WalkOrder postorder. */
 const std::string walkorder_postorder_str = "POSTORDER";
 
+/** The string representation for CachePolicy lru. */
+const std::string cache_policy_lru_str = "lru";
+
+/** The string representation for CachePolicy slru. */
+const std::string cache_policy_slru_str = "slru";
+
+/** The string representation for CachePolicy tinylfu. */
+const std::string cache_policy_tinylfu_str = "tinylfu";
+
+/** The string representation for HugePageMode none. */
+const std::string huge_page_mode_none_str = "none";
+
+/** The string representation for HugePageMode transparent. */
+const std::string huge_page_mode_transparent_str = "transparent";
+
+/** The string representation for HugePageMode explicit. */
+const std::string huge_page_mode_explicit_str = "explicit";
+
 /** The string representation for VFSMode read. */
 const std::string vfsmode_read_str = "VFS_READ";
 
@@ -528,7 +670,7 @@ const int32_t library_version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
 /** The TileDB serialization format version number. */
-const uint32_t format_version = 11;
+const uint32_t format_version = 14;
 
 /** The lowest version supported for back compat writes. */
 const uint32_t back_compat_writes_min_format_version = 7;
@@ -548,6 +690,9 @@ const unsigned int s3_max_attempts = 100;
 /** Milliseconds of wait time between S3 attempts. */
 const unsigned int s3_attempt_sleep_ms = 100;
 
+/** Maximum number of keys of an S3 DeleteObjects request. */
+const unsigned int s3_max_delete_keys = 1000;
+
 /** Maximum number of attempts to wait for an Azure response. */
 const unsigned int azure_max_attempts = 10;
 
@@ -68,6 +68,9 @@ extern const std::string array_schema_folder_name;
 /** The array metadata folder name. */
 extern const std::string array_metadata_folder_name;
 
+/** The folder name of the dimension label arrays of an array. */
+extern const std::string array_dimension_labels_folder_name;
+
 /** The default tile capacity. */
 extern const uint64_t capacity;
 
@@ -77,6 +80,9 @@ extern const uint64_t cell_var_offset_size;
 /** The type of a variable offset cell. */
 extern const Datatype cell_var_offset_type;
 
+/** The maximum size of the var size min/max values stored per tile. */
+extern const uint64_t tile_min_max_var_prefix_size;
+
 /** The size of a validity cell. */
 extern const uint64_t cell_validity_size;
 
@@ -86,12 +92,6 @@ extern const Datatype cell_validity_type;
 /** A special value indicating varibale size. */
 extern const uint64_t var_size;
 
-/** The default compressor for the offsets of variable-sized cells. */
-extern Compressor cell_var_offsets_compression;
-
-/** The default compression level for the offsets of variable-sized cells. */
-extern int cell_var_offsets_compression_level;
-
 /** The default compressor for the validity value cells. */
 extern Compressor cell_validity_compression;
 
@@ -173,12 +173,53 @@ extern const std::string vacuum_file_suffix;
 /** Suffix for the special ok files used in TileDB. */
 extern const std::string ok_file_suffix;
 
+/** Suffix for the single-file packed fragments. */
+extern const std::string packed_fragment_suffix;
+
+/** Suffix for the fragments written in parts by several writers. */
+extern const std::string fragment_parts_suffix;
+
+/** Prefix of the directories of the parts of a fragment. */
+extern const std::string fragment_part_prefix;
+
 /** Suffix for the special metadata files used in TileDB. */
 extern const std::string meta_file_suffix;
 
 /** The fragment metadata file name. */
 extern const std::string fragment_metadata_filename;
 
+/** The file name of the Bloom filter over the coordinates of a fragment. */
+extern const std::string coords_bloom_filter_filename;
+
+/** The file name of the attribute value index of a fragment. */
+extern const std::string attribute_index_filename;
+
+/** The file name of the part table of a fragment written in parts. */
+extern const std::string fragment_parts_filename;
+
+/** The number of Bloom filter bits per cell of the attribute value index. */
+extern const uint64_t attribute_index_bits_per_cell;
+
+/**
+ * The minimum number of ranges of an integer dimension for which the
+ * subarray ranges are sorted with a radix sort instead of a comparison
+ * sort.
+ */
+extern const uint64_t range_radix_sort_min_num;
+
+/**
+ * The minimum number of fragments of an open array for which the relevant
+ * fragments of a subarray are found through an index over the fragment
+ * non-empty domains instead of testing every fragment.
+ */
+extern const uint64_t fragment_domain_index_min_fragment_num;
+
+/**
+ * The number of bytes read ahead from the end of each fragment metadata file
+ * on array open, expected to hold the footer.
+ */
+extern const uint64_t fragment_metadata_tail_size;
+
 /** Default datatype for a generic tile. */
 extern const Datatype generic_tile_datatype;
 
@@ -197,6 +238,36 @@ extern const std::string group_filename;
 /** The maximum number of bytes written in a single I/O. */
 extern const uint64_t max_write_bytes;
 
+/** The maximum number of entries of an io_uring submission queue. */
+extern const uint32_t io_uring_queue_depth;
+
+/** The maximum number of overlapped I/Os in flight on a Windows file. */
+extern const uint32_t overlapped_io_queue_depth;
+
+/** The maximum number of idle HDFS file handles kept open for reads. */
+extern const uint64_t hdfs_max_idle_read_handles;
+
+/** The offset, buffer and size alignment of direct (`O_DIRECT`) reads. */
+extern const uint64_t direct_io_alignment;
+
+/** The maximum size of the aligned scratch buffer of a direct read. */
+extern const uint64_t direct_io_max_scratch_size;
+
+/** The number of reads observed before the read batch gap is adapted. */
+extern const uint64_t adaptive_batch_gap_min_samples;
+
+/** The weight of a new read in the moving estimates of the read costs. */
+extern const double adaptive_batch_gap_smoothing;
+
+/** The maximum adaptive read batch gap in bytes. */
+extern const uint64_t adaptive_batch_gap_max;
+
+/** The maximum read-ahead window of a stream, in read-ahead sizes. */
+extern const uint64_t read_ahead_max_window_multiplier;
+
+/** The number of file read streams tracked for sequential read-ahead. */
+extern const uint64_t read_ahead_max_streams;
+
 /** The maximum file path length (depending on platform). */
 extern const uint32_t path_max_len;
 
@@ -230,6 +301,9 @@ extern const std::string query_status_incomplete_str;
 /** TILEDB_UNINITIALIZED Query String **/
 extern const std::string query_status_uninitialized_str;
 
+/** TILEDB_CANCELLED Query String **/
+extern const std::string query_status_cancelled_str;
+
 /** TILEDB_LT Query Condition Op String **/
 extern const std::string query_condition_op_lt_str;
 
@@ -248,6 +322,15 @@ extern const std::string query_condition_op_eq_str;
 /** TILEDB_NE Query Condition Op String **/
 extern const std::string query_condition_op_ne_str;
 
+/** TILEDB_IN Query Condition Op String **/
+extern const std::string query_condition_op_in_str;
+
+/** TILEDB_NOT_IN Query Condition Op String **/
+extern const std::string query_condition_op_not_in_str;
+
+/** TILEDB_PREFIX Query Condition Op String **/
+extern const std::string query_condition_op_prefix_str;
+
 /** TILEDB_AND Query Condition Combination Op String **/
 extern const std::string query_condition_combination_op_and_str;
 
@@ -257,6 +340,21 @@ extern const std::string query_condition_combination_op_or_str;
 /** TILEDB_NOT Query Condition Combination Op String **/
 extern const std::string query_condition_combination_op_not_str;
 
+/** TILEDB_AGGREGATE_COUNT Query Aggregate Op String **/
+extern const std::string query_aggregate_op_count_str;
+
+/** TILEDB_AGGREGATE_SUM Query Aggregate Op String **/
+extern const std::string query_aggregate_op_sum_str;
+
+/** TILEDB_AGGREGATE_MIN Query Aggregate Op String **/
+extern const std::string query_aggregate_op_min_str;
+
+/** TILEDB_AGGREGATE_MAX Query Aggregate Op String **/
+extern const std::string query_aggregate_op_max_str;
+
+/** TILEDB_AGGREGATE_NULL_COUNT Query Aggregate Op String **/
+extern const std::string query_aggregate_op_null_count_str;
+
 /** TILEDB_COMPRESSION Filter type string */
 extern const std::string filter_type_compression_str;
 
@@ -311,6 +409,24 @@ extern const std::string filter_checksum_md5_str;
 /** String describing FILTER_CHECKSUM_SHA256. */
 extern const std::string filter_checksum_sha256_str;
 
+/** String describing FILTER_DICTIONARY. */
+extern const std::string filter_dictionary_str;
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+extern const std::string filter_frame_of_reference_str;
+
+/** String describing FILTER_FLOAT_XOR. */
+extern const std::string filter_float_xor_str;
+
+/** String describing FILTER_AUTO_COMPRESSION. */
+extern const std::string filter_auto_compression_str;
+
+/** String describing FILTER_CHECKSUM_CRC32C. */
+extern const std::string filter_checksum_crc32c_str;
+
+/** String describing FILTER_BITMAP. */
+extern const std::string filter_bitmap_str;
+
 /** The string representation for FilterOption type compression_level. */
 extern const std::string filter_option_compression_level_str;
 
@@ -321,6 +437,10 @@ extern const std::string filter_option_bit_width_max_window_str;
  */
 extern const std::string filter_option_positive_delta_max_window_str;
 
+/** The string representation for FilterOption type
+ * auto_compression_speed_bias. */
+extern const std::string filter_option_auto_compression_speed_bias_str;
+
 /** The string representation for type int32. */
 extern const std::string int32_str;
 
@@ -465,6 +585,9 @@ extern const std::string unordered_str;
 /** The string representation for the Hilbert layout. */
 extern const std::string hilbert_str;
 
+/** The string representation for the Morton layout. */
+extern const std::string morton_str;
+
 /** The string representation of null. */
 extern const std::string null_str;
 
@@ -498,6 +621,24 @@ extern const std::string walkorder_preorder_str;
 /** The string representation for WalkOrder postorder. */
 extern const std::string walkorder_postorder_str;
 
+/** The string representation for CachePolicy lru. */
+extern const std::string cache_policy_lru_str;
+
+/** The string representation for CachePolicy slru. */
+extern const std::string cache_policy_slru_str;
+
+/** The string representation for CachePolicy tinylfu. */
+extern const std::string cache_policy_tinylfu_str;
+
+/** The string representation for HugePageMode none. */
+extern const std::string huge_page_mode_none_str;
+
+/** The string representation for HugePageMode transparent. */
+extern const std::string huge_page_mode_transparent_str;
+
+/** The string representation for HugePageMode explicit. */
+extern const std::string huge_page_mode_explicit_str;
+
 /** The string representation for VFSMode read. */
 extern const std::string vfsmode_read_str;
 
@@ -531,6 +672,9 @@ extern const unsigned int s3_max_attempts;
 /** Milliseconds of wait time between S3 attempts. */
 extern const unsigned int s3_attempt_sleep_ms;
 
+/** Maximum number of keys of an S3 DeleteObjects request. */
+extern const unsigned int s3_max_delete_keys;
+
 /** Maximum number of attempts to wait for an Azure response. */
 extern const unsigned int azure_max_attempts;
 
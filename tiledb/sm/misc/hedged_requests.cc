@@ -0,0 +1,185 @@
+/**
+ * @file   hedged_requests.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * @section DESCRIPTION
+ *
+ * This file defines the HedgePolicy and HedgeTimer classes.
+ */
+
+#include "tiledb/sm/misc/hedged_requests.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*            HEDGE POLICY           */
+/* ********************************* */
+
+HedgePolicy::HedgePolicy()
+    : percentile_(0)
+    , max_ratio_(0)
+    , next_sample_(0)
+    , threshold_us_(0)
+    , request_num_(0)
+    , hedge_num_(0) {
+}
+
+void HedgePolicy::init(double percentile, double max_ratio) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  percentile_ = percentile;
+  max_ratio_ = max_ratio;
+  samples_.clear();
+  samples_.reserve(sample_num_);
+  next_sample_ = 0;
+  threshold_us_ = 0;
+  request_num_ = 0;
+  hedge_num_ = 0;
+}
+
+bool HedgePolicy::enabled() const {
+  return percentile_ > 0 && percentile_ < 100 && max_ratio_ > 0;
+}
+
+uint64_t HedgePolicy::delay_us() {
+  if (!enabled())
+    return 0;
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  return threshold_us_;
+}
+
+bool HedgePolicy::acquire() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (hedge_num_ + 1 > max_ratio_ * request_num_)
+    return false;
+
+  ++hedge_num_;
+  return true;
+}
+
+void HedgePolicy::record(uint64_t latency_us) {
+  if (!enabled())
+    return;
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  ++request_num_;
+  if (samples_.size() < sample_num_) {
+    samples_.push_back(latency_us);
+  } else {
+    samples_[next_sample_] = latency_us;
+  }
+  next_sample_ = (next_sample_ + 1) % sample_num_;
+
+  // Recompute the threshold every 16 samples, once the window is full
+  if (samples_.size() < sample_num_ || next_sample_ % 16 != 0)
+    return;
+  std::vector<uint64_t> sorted(samples_);
+  auto pos = static_cast<size_t>(
+      std::ceil(percentile_ / 100 * static_cast<double>(sorted.size())));
+  pos = std::min(std::max<size_t>(pos, 1), sorted.size()) - 1;
+  std::nth_element(sorted.begin(), sorted.begin() + pos, sorted.end());
+  threshold_us_ = std::max<uint64_t>(sorted[pos], 1);
+}
+
+/* ********************************* */
+/*            HEDGE TIMER            */
+/* ********************************* */
+
+HedgeTimer::HedgeTimer()
+    : running_(0)
+    , next_id_(1)
+    , stop_(false) {
+}
+
+HedgeTimer::~HedgeTimer() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable())
+    thread_.join();
+}
+
+uint64_t HedgeTimer::schedule(uint64_t delay_us, std::function<void()>&& fn) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (!thread_.joinable())
+    thread_ = std::thread(&HedgeTimer::run, this);
+
+  const uint64_t id = next_id_++;
+  const auto deadline = Clock::now() + std::chrono::microseconds(delay_us);
+  pending_.emplace(std::make_pair(deadline, id), std::move(fn));
+  deadlines_.emplace(id, deadline);
+  cv_.notify_all();
+
+  return id;
+}
+
+void HedgeTimer::cancel(uint64_t id) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = deadlines_.find(id);
+  if (it != deadlines_.end()) {
+    pending_.erase(std::make_pair(it->second, id));
+    deadlines_.erase(it);
+  }
+  cv_.wait(lck, [this, id]() { return running_ != id; });
+}
+
+void HedgeTimer::run() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  while (!stop_) {
+    if (pending_.empty()) {
+      cv_.wait(lck);
+      continue;
+    }
+
+    auto first = pending_.begin();
+    if (Clock::now() < first->first.first) {
+      cv_.wait_until(lck, first->first.first);
+      continue;
+    }
+
+    // Run the callback without the lock, so that it can schedule
+    const uint64_t id = first->first.second;
+    auto fn = std::move(first->second);
+    pending_.erase(first);
+    deadlines_.erase(id);
+    running_ = id;
+    lck.unlock();
+    fn();
+    lck.lock();
+    running_ = 0;
+    cv_.notify_all();
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,182 @@
+/**
+ * @file   hedged_requests.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * @section DESCRIPTION
+ *
+ * This file declares the HedgePolicy and HedgeTimer classes, used to hedge
+ * slow requests to remote backends.
+ */
+
+#ifndef TILEDB_HEDGED_REQUESTS_H
+#define TILEDB_HEDGED_REQUESTS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Decides when a request is hedged, i.e. duplicated because it is slower
+ * than a percentile of the latencies recently observed. The number of
+ * hedges is capped to a ratio of the requests, which bounds the extra load
+ * put on the backend. This class is thread-safe.
+ */
+class HedgePolicy {
+ public:
+  /** Constructor. Hedging is disabled until `init` is called. */
+  HedgePolicy();
+
+  /**
+   * Initializes the policy.
+   *
+   * @param percentile The latency percentile, in (0, 100), after which a
+   *     request is hedged. Zero disables hedging.
+   * @param max_ratio The maximum ratio of hedges to requests.
+   */
+  void init(double percentile, double max_ratio);
+
+  /** Returns true if hedging is enabled. */
+  bool enabled() const;
+
+  /**
+   * Returns the delay in microseconds after which a request starting now
+   * should be hedged, or 0 if it should not be hedged because not enough
+   * latencies were observed yet.
+   */
+  uint64_t delay_us();
+
+  /**
+   * Reserves a hedge for a request that exceeded its delay.
+   *
+   * @return False if the cap on hedges was reached.
+   */
+  bool acquire();
+
+  /** Records the latency of a completed request. */
+  void record(uint64_t latency_us);
+
+ private:
+  /** The number of latencies the threshold is computed from. */
+  static const size_t sample_num_ = 256;
+
+  /** Protects all members. */
+  std::mutex mtx_;
+
+  /** The latency percentile after which requests are hedged. */
+  double percentile_;
+
+  /** The maximum ratio of hedges to requests. */
+  double max_ratio_;
+
+  /** A ring buffer of the latest latencies. */
+  std::vector<uint64_t> samples_;
+
+  /** The next position to write to in `samples_`. */
+  size_t next_sample_;
+
+  /** The current hedging delay, recomputed as latencies are recorded. */
+  uint64_t threshold_us_;
+
+  /** The number of requests that were recorded. */
+  uint64_t request_num_;
+
+  /** The number of hedges that were acquired. */
+  uint64_t hedge_num_;
+};
+
+/**
+ * Runs callbacks after a delay unless they are cancelled first, on a
+ * single thread started on first use. Callbacks must be short; they
+ * typically submit the hedged request to a thread pool.
+ */
+class HedgeTimer {
+ public:
+  /** Constructor. */
+  HedgeTimer();
+
+  /** Destructor. Stops the thread; pending callbacks are dropped. */
+  ~HedgeTimer();
+
+  HedgeTimer(const HedgeTimer&) = delete;
+  HedgeTimer& operator=(const HedgeTimer&) = delete;
+
+  /**
+   * Schedules `fn` to run after `delay_us` microseconds.
+   *
+   * @return An id to cancel the callback with.
+   */
+  uint64_t schedule(uint64_t delay_us, std::function<void()>&& fn);
+
+  /**
+   * Cancels a callback. If it is running, waits until it returns, so that
+   * the callback never runs after this call.
+   */
+  void cancel(uint64_t id);
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  /** The loop of `thread_`. */
+  void run();
+
+  /** Protects all members. */
+  std::mutex mtx_;
+
+  /** Signals new callbacks, the end of a callback and stopping. */
+  std::condition_variable cv_;
+
+  /** The pending callbacks by deadline; the id breaks ties. */
+  std::map<std::pair<Clock::time_point, uint64_t>, std::function<void()>>
+      pending_;
+
+  /** The deadline of each pending callback by id. */
+  std::map<uint64_t, Clock::time_point> deadlines_;
+
+  /** The id of the running callback, 0 if none. */
+  uint64_t running_;
+
+  /** The id of the next callback. */
+  uint64_t next_id_;
+
+  /** True when the thread must exit. */
+  bool stop_;
+
+  /** The thread running the callbacks. */
+  std::thread thread_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_HEDGED_REQUESTS_H
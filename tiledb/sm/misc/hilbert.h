@@ -39,6 +39,8 @@
 #include <cstdlib>
 #include <iostream>
 
+#include "tiledb/sm/misc/morton.h"
+
 namespace tiledb {
 namespace sm {
 
@@ -186,6 +188,32 @@ class Hilbert {
     return ret;
   }
 
+  /**
+   * Converts the coordinates of `cell_num` cells to Hilbert values,
+   * producing the same values as converting each cell on its own. The
+   * coordinates are stored dimension by dimension, i.e. coordinate `d` of
+   * cell `c` is `coords[d * cell_num + c]`. The conversion runs each step
+   * of Skilling's algorithm over all the cells without branching, so
+   * that the compiler can vectorize it.
+   *
+   * @param cell_num The number of cells.
+   * @param coords The coordinates to be converted. They are overwritten
+   *     with the transpose form of the Hilbert values.
+   * @param hilbert The output Hilbert values, of size `cell_num`.
+   */
+  void coords_to_hilbert(uint64_t cell_num, uint64_t* coords, uint64_t* hilbert)
+      const {
+    assert(coords != nullptr && hilbert != nullptr);
+
+    // Convert coords to the transpose form of the hilbert value
+    axes_to_transpose_batch(coords, cell_num);
+
+    // Interleaving the bits of the transpose form yields the hilbert value
+    for (uint64_t c = 0; c < cell_num; ++c)
+      hilbert[c] = 0;
+    Morton(bits_, dim_num_).interleave(coords, cell_num, cell_num, hilbert);
+  }
+
   /**
    * Converts a Hilbert value into a set of coordinates.
    *
@@ -288,6 +316,56 @@ class Hilbert {
       X[i] ^= t;
   }
 
+  /**
+   * Same as `axes_to_transpose`, for `cell_num` cells whose coordinates
+   * are stored dimension by dimension. The branches on the bits of the
+   * coordinates are turned into masks.
+   *
+   * @param X Input coordinates, and output transpose (the conversion is
+   *     done in place).
+   * @param cell_num The number of cells.
+   */
+  void axes_to_transpose_batch(uint64_t* X, uint64_t cell_num) const {
+    const int b = bits_;
+    const int n = dim_num_;
+    uint64_t* const X0 = X;
+
+    // Inverse undo
+    for (int q = b - 1; q > 0; --q) {
+      const uint64_t P = ((uint64_t)1 << q) - 1;
+      for (uint64_t c = 0; c < cell_num; ++c) {
+        const uint64_t invert = 0 - ((X0[c] >> q) & 1);
+        X0[c] ^= invert & P;
+      }
+      for (int i = 1; i < n; ++i) {
+        uint64_t* const Xi = X + i * cell_num;
+        for (uint64_t c = 0; c < cell_num; ++c) {
+          const uint64_t invert = 0 - ((Xi[c] >> q) & 1);
+          const uint64_t t = (X0[c] ^ Xi[c]) & P & ~invert;
+          X0[c] ^= (invert & P) | t;
+          Xi[c] ^= t;
+        }
+      }
+    }
+
+    // Gray encode (inverse of decode)
+    for (int i = 1; i < n; ++i) {
+      uint64_t* const Xi = X + i * cell_num;
+      const uint64_t* const Xp = Xi - cell_num;
+      for (uint64_t c = 0; c < cell_num; ++c)
+        Xi[c] ^= Xp[c];
+    }
+    uint64_t* const Xn = X + (n - 1) * cell_num;
+    for (uint64_t c = 0; c < cell_num; ++c) {
+      uint64_t t = Xn[c];
+      for (int i = 1; i < b; i <<= 1)
+        Xn[c] ^= Xn[c] >> i;
+      t ^= Xn[c];
+      for (int i = n - 2; i >= 0; --i)
+        X[i * cell_num + c] ^= t;
+    }
+  }
+
   /**
    * From John Skilling's work. It converts the transpose of a
    * Hilbert value into the corresponding coordinates. This is done in place.
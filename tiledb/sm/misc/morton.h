@@ -0,0 +1,258 @@
+/**
+ * @file   morton.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Morton, which computes Morton (Z-order) values
+ * by interleaving the bits of coordinates.
+ */
+
+#ifndef TILEDB_MORTON_H
+#define TILEDB_MORTON_H
+
+#include <cassert>
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * The Morton (or Z-order) curve fills a multi-dimensional space with a 1D
+ * line by interleaving the bits of the coordinates. It preserves less
+ * locality than the Hilbert curve, since it jumps at every power of two
+ * boundary, but computing a Morton value is a handful of shifts and masks.
+ *
+ * For the 2D case with 2 bits per dimension, the Morton curve looks as
+ * follows:
+ *
+ \verbatim
+         |
+       3 |   10--11  14--15
+         |      /       /
+       2 |    8---9  12--13
+  Dim[0] |       ___/
+       1 |    2---3   6---7
+         |      /       /
+       0 |    0---1   4---5
+         |
+          ------------------
+              0   1   2   3    Dim[1]
+ \endverbatim
+ *
+ * As with class Hilbert, the bit of the first dimension is the most
+ * significant of each group of interleaved bits, i.e. the Morton value of
+ * (1,2) is 6.
+ */
+class Morton {
+ public:
+  /* ********************************* */
+  /*             CONSTANTS             */
+  /* ********************************* */
+
+  /**
+   * Maximum number of dimensions, which matches that of the Hilbert curve
+   * as the Morton value is also stored in a uint64_t number.
+   */
+  static const int MC_MAX_DIM = 16;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param bits Number of bits used for coordinate values across each dimension
+   * @param dim_num Number of dimensions
+   */
+  Morton(int bits, int dim_num)
+      : bits_(bits)
+      , dim_num_(dim_num) {
+    assert(dim_num > 0 && dim_num < MC_MAX_DIM);
+    assert(bits * dim_num <= int(sizeof(uint64_t) * 8 - 1));
+  }
+
+  /**
+   * Constructor. The number of bits will be calculated based
+   * on the number of dimensions, as for class Hilbert.
+   *
+   * @param dim_num Number of dimensions
+   */
+  Morton(int dim_num)
+      : dim_num_(dim_num) {
+    assert(dim_num > 0 && dim_num < MC_MAX_DIM);
+    bits_ = (sizeof(uint64_t) * 8 - 1) / dim_num_;
+  }
+
+  /** Destructor. */
+  ~Morton() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of bits. */
+  int bits() const {
+    return bits_;
+  }
+
+  /** Returns the number of dimensions. */
+  int dim_num() const {
+    return dim_num_;
+  }
+
+  /**
+   * Converts a set of coordinates to a Morton value.
+   *
+   * @param coords The coordinates to be converted.
+   * @return The output Morton value.
+   */
+  uint64_t coords_to_morton(const uint64_t* coords) const {
+    assert(coords != nullptr);
+    uint64_t ret = 0;
+    interleave(coords, 1, 1, &ret);
+    return ret;
+  }
+
+  /**
+   * Converts the coordinates of `cell_num` cells to Morton values. The
+   * coordinates are stored dimension by dimension, i.e. coordinate `d` of
+   * cell `c` is `coords[d * cell_num + c]`, so that the conversion runs
+   * over contiguous arrays the compiler can vectorize.
+   *
+   * @param cell_num The number of cells.
+   * @param coords The coordinates to be converted.
+   * @param morton The output Morton values, of size `cell_num`.
+   */
+  void coords_to_morton(
+      uint64_t cell_num, const uint64_t* coords, uint64_t* morton) const {
+    assert(coords != nullptr && morton != nullptr);
+    for (uint64_t c = 0; c < cell_num; ++c)
+      morton[c] = 0;
+    interleave(coords, cell_num, cell_num, morton);
+  }
+
+  /**
+   * Converts a Morton value into a set of coordinates.
+   *
+   * @param morton The Morton value to be converted.
+   * @param coords The output coordinates.
+   */
+  void morton_to_coords(uint64_t morton, uint64_t* coords) const {
+    assert(coords != nullptr);
+    for (int i = 0; i < dim_num_; ++i)
+      coords[i] = 0;
+
+    uint64_t c = 1;  // This is a bit shifted from right to left over coords[i]
+    uint64_t m = 1;  // This is a bit shifted from right to left over morton
+    for (int j = 0; j < bits_; ++j, c <<= 1) {
+      for (int i = dim_num_ - 1; i >= 0; --i, m <<= 1) {
+        if (morton & m)
+          coords[i] |= c;
+      }
+    }
+  }
+
+  /**
+   * Interleaves the bits of the coordinates of `cell_num` cells, OR-ing
+   * the result into `out`. Coordinate `d` of cell `c` is
+   * `X[d * stride + c]`. Class Hilbert uses this to convert the transpose
+   * form of Hilbert values to integers.
+   *
+   * @param X The coordinates to interleave.
+   * @param cell_num The number of cells.
+   * @param stride The distance between the coordinates of two dimensions.
+   * @param out The output values, of size `cell_num`.
+   */
+  void interleave(
+      const uint64_t* X, uint64_t cell_num, uint64_t stride, uint64_t* out)
+      const {
+    // Spread the bits of each dimension with shifts and masks where the
+    // bits fit, and fall back to moving one bit at a time otherwise.
+    const uint64_t mask =
+        (bits_ == 64) ? UINT64_MAX : (((uint64_t)1 << bits_) - 1);
+    for (int i = 0; i < dim_num_; ++i) {
+      const uint64_t* x = X + i * stride;
+      const int shift = dim_num_ - 1 - i;
+      if (dim_num_ == 1) {
+        for (uint64_t c = 0; c < cell_num; ++c)
+          out[c] |= x[c] & mask;
+      } else if (dim_num_ == 2 && bits_ <= 32) {
+        for (uint64_t c = 0; c < cell_num; ++c)
+          out[c] |= spread_2(x[c] & mask) << shift;
+      } else if (dim_num_ == 3 && bits_ <= 21) {
+        for (uint64_t c = 0; c < cell_num; ++c)
+          out[c] |= spread_3(x[c] & mask) << shift;
+      } else {
+        for (int j = 0; j < bits_; ++j) {
+          const int pos = j * dim_num_ + shift;
+          for (uint64_t c = 0; c < cell_num; ++c)
+            out[c] |= ((x[c] >> j) & 1) << pos;
+        }
+      }
+    }
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Number of bits for representing a coordinate per dimension. */
+  int bits_;
+  /** Number of dimensions. */
+  int dim_num_;
+
+  /* ********************************* */
+  /*           PRIVATE METHODS         */
+  /* ********************************* */
+
+  /** Inserts a zero bit between each of the low 32 bits of `x`. */
+  static uint64_t spread_2(uint64_t x) {
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x << 2)) & 0x3333333333333333ull;
+    x = (x | (x << 1)) & 0x5555555555555555ull;
+    return x;
+  }
+
+  /** Inserts two zero bits between each of the low 21 bits of `x`. */
+  static uint64_t spread_3(uint64_t x) {
+    x = (x | (x << 32)) & 0x001F00000000FFFFull;
+    x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+    x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+    x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+    x = (x | (x << 2)) & 0x1249249249249249ull;
+    return x;
+  }
+};
+
+}  // namespace sm
+}  // end namespace tiledb
+
+#endif  // TILEDB_MORTON_H
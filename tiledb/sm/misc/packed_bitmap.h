@@ -0,0 +1,312 @@
+/**
+ * @file   packed_bitmap.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This defines a bitmap storing one bit per cell, in 64-bit words.
+ */
+
+#ifndef TILEDB_PACKED_BITMAP_H
+#define TILEDB_PACKED_BITMAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A bitmap storing one bit per cell. It mimics the parts of the
+ * `std::vector<uint8_t>` interface used for result bitmaps, and adds the
+ * counting operations that can be done a word at a time.
+ *
+ * The bits past the size of the bitmap in the last word are always zero.
+ */
+class PackedBitmap {
+ public:
+  /** Proxy to a single bit of the bitmap. */
+  class Reference {
+   public:
+    Reference(uint64_t* word, uint64_t mask)
+        : word_(word)
+        , mask_(mask) {
+    }
+
+    /** Returns the bit value. */
+    operator uint8_t() const {
+      return (*word_ & mask_) != 0;
+    }
+
+    /** Sets the bit, to 1 for any non-zero value. */
+    Reference& operator=(uint8_t value) {
+      if (value)
+        *word_ |= mask_;
+      else
+        *word_ &= ~mask_;
+      return *this;
+    }
+
+   private:
+    /** The word holding the bit. */
+    uint64_t* word_;
+
+    /** The mask of the bit in its word. */
+    uint64_t mask_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  PackedBitmap()
+      : size_(0) {
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of bytes used to store `cell_num` cells. */
+  static uint64_t alloc_size(uint64_t cell_num) {
+    return word_num(cell_num) * sizeof(uint64_t);
+  }
+
+  /** Returns the number of cells. */
+  uint64_t size() const {
+    return size_;
+  }
+
+  /** Returns `true` if the bitmap has no cells. */
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  /** Removes all the cells and releases the memory. */
+  void clear() {
+    words_.clear();
+    words_.shrink_to_fit();
+    size_ = 0;
+  }
+
+  /**
+   * Resizes the bitmap to `cell_num` cells, setting the added cells to
+   * `value`.
+   */
+  void resize(uint64_t cell_num, uint8_t value = 0) {
+    const auto old_size = size_;
+    words_.resize(word_num(cell_num), 0);
+    size_ = cell_num;
+    if (cell_num == 0) {
+      words_.shrink_to_fit();
+      return;
+    }
+
+    if (value && cell_num > old_size) {
+      // Fill the partial word then full words.
+      uint64_t c = old_size;
+      if (c % 64 != 0) {
+        words_[c / 64] |= ~uint64_t(0) << (c % 64);
+        c += 64 - c % 64;
+      }
+      for (uint64_t w = c / 64; w < words_.size(); w++)
+        words_[w] = ~uint64_t(0);
+    }
+
+    clear_trailing_bits();
+  }
+
+  /** Returns the value of a cell. */
+  uint8_t operator[](uint64_t c) const {
+    assert(c < size_);
+    return (words_[c / 64] >> (c % 64)) & 1;
+  }
+
+  /** Returns a proxy to the value of a cell. */
+  Reference operator[](uint64_t c) {
+    assert(c < size_);
+    return Reference(&words_[c / 64], uint64_t(1) << (c % 64));
+  }
+
+  /** Returns the number of set cells in `[start, end)`. */
+  uint64_t count(uint64_t start, uint64_t end) const {
+    assert(start <= end && end <= size_);
+    if (start == end)
+      return 0;
+
+    const uint64_t first_word = start / 64;
+    const uint64_t last_word = (end - 1) / 64;
+    uint64_t result = 0;
+    for (uint64_t w = first_word; w <= last_word; w++) {
+      uint64_t word = words_[w];
+      if (w == first_word)
+        word &= ~uint64_t(0) << (start % 64);
+      if (w == last_word && end % 64 != 0)
+        word &= ~(~uint64_t(0) << (end % 64));
+      result += popcount(word);
+    }
+
+    return result;
+  }
+
+  /**
+   * Returns the position of the `n`-th set cell starting from `start`, or
+   * the last position if there are fewer set cells.
+   */
+  uint64_t pos_with_count(uint64_t start, uint64_t n) const {
+    assert(n != 0 && start < size_);
+    for (uint64_t w = start / 64; w < words_.size(); w++) {
+      uint64_t word = words_[w];
+      if (w == start / 64)
+        word &= ~uint64_t(0) << (start % 64);
+
+      const auto word_count = popcount(word);
+      if (word_count < n) {
+        n -= word_count;
+        continue;
+      }
+
+      // Drop the lowest set bits until the one we look for is the lowest.
+      for (uint64_t i = 1; i < n; i++)
+        word &= word - 1;
+      return w * 64 + lowest_set_bit(word);
+    }
+
+    return size_ - 1;
+  }
+
+  /**
+   * Returns the end of the run of cells starting at `start` that all have
+   * the value of cell `start`, bounded by `end`. Runs are found a word at a
+   * time by looking for the first cell that differs.
+   */
+  uint64_t run_end(uint64_t start, uint64_t end) const {
+    assert(start < end && end <= size_);
+    const uint64_t flip = ((words_[start / 64] >> (start % 64)) & 1) ?
+                              ~uint64_t(0) :
+                              uint64_t(0);
+    for (uint64_t w = start / 64; w * 64 < end; w++) {
+      // Set bits of `diff` are the cells that differ from the run value.
+      uint64_t diff = words_[w] ^ flip;
+      if (w == start / 64)
+        diff &= ~uint64_t(0) << (start % 64);
+      if (diff != 0)
+        return std::min(end, w * 64 + lowest_set_bit(diff));
+    }
+
+    return end;
+  }
+
+  /** Replaces the bitmap with the non-zero cells of `cells`. */
+  void assign(const std::vector<uint8_t>& cells) {
+    words_.assign(word_num(cells.size()), ~uint64_t(0));
+    size_ = cells.size();
+    clear_trailing_bits();
+    and_with(cells);
+  }
+
+  /** Clears the cells that are zero in `cells`, a word at a time. */
+  void and_with(const std::vector<uint8_t>& cells) {
+    assert(cells.size() == size_);
+    const uint8_t* data = cells.data();
+    for (uint64_t w = 0; w < words_.size(); w++) {
+      const uint64_t len = std::min<uint64_t>(64, size_ - w * 64);
+      uint64_t mask = 0;
+      for (uint64_t b = 0; b < len; b++)
+        mask |= uint64_t(data[w * 64 + b] != 0) << b;
+      words_[w] &= mask;
+    }
+  }
+
+  /** Writes the bitmap as one byte per cell into `cells`. */
+  void unpack(std::vector<uint8_t>* cells) const {
+    cells->resize(size_);
+    for (uint64_t c = 0; c < size_; c++)
+      (*cells)[c] = (words_[c / 64] >> (c % 64)) & 1;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The bits, 64 cells per word. */
+  std::vector<uint64_t> words_;
+
+  /** The number of cells. */
+  uint64_t size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the number of words needed for `cell_num` cells. */
+  static uint64_t word_num(uint64_t cell_num) {
+    return (cell_num + 63) / 64;
+  }
+
+  /** Returns the number of set bits of a word. */
+  static uint64_t popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) +
+           ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (word * 0x0101010101010101ULL) >> 56;
+#endif
+  }
+
+  /** Returns the index of the lowest set bit of a non-zero word. */
+  static uint64_t lowest_set_bit(uint64_t word) {
+    assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    uint64_t index = 0;
+    while ((word & 1) == 0) {
+      word >>= 1;
+      index++;
+    }
+    return index;
+#endif
+  }
+
+  /** Zeroes the bits past the size of the bitmap in the last word. */
+  void clear_trailing_bits() {
+    if (size_ % 64 != 0)
+      words_.back() &= ~(~uint64_t(0) << (size_ % 64));
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_PACKED_BITMAP_H
@@ -37,7 +37,14 @@
 #include "tiledb/sm/global_state/global_state.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
 
 using namespace tiledb::common;
 
@@ -45,7 +52,10 @@ namespace tiledb {
 namespace sm {
 
 /**
- * Sort the given iterator range, possibly in parallel.
+ * Sort the given iterator range, possibly in parallel, with a quicksort
+ * whose recursion runs on the thread pool down to a depth where all the
+ * threads have a subrange, which is then sorted with `std::sort`. The
+ * partitioning of each subrange is sequential. See also `parallel_sort`.
  *
  * @tparam IterT Iterator type
  * @tparam CmpT Comparator type
@@ -57,7 +67,7 @@ namespace sm {
 template <
     typename IterT,
     typename CmpT = std::less<typename std::iterator_traits<IterT>::value_type>>
-void parallel_sort(
+void parallel_quick_sort(
     ThreadPool* const tp, IterT begin, IterT end, const CmpT& cmp = CmpT()) {
   // Sort the range using a quicksort. The algorithm is:
   // 1. Pick a pivot value in the range.
@@ -158,80 +168,196 @@ void parallel_sort(
   quick_sort(0, begin, end);
 }
 
+/** Statistics of a single `parallel_for` or `parallel_for_2d` call. */
+struct ParallelForStats {
+  /** The number of chunks the range was split into. */
+  uint64_t chunk_num = 0;
+
+  /** The number of tasks scheduled on the thread pool. */
+  uint64_t task_num = 0;
+
+  /** The wall time of the call, in nanoseconds. */
+  uint64_t elapsed_ns = 0;
+
+  /**
+   * The wall time between the first participant running out of work and
+   * the last one finishing, in nanoseconds.
+   */
+  uint64_t imbalance_ns = 0;
+};
+
 /**
  * Call the given function on each element in the given iterator range.
  *
- * @tparam IterT Iterator type
+ * The range is scheduled adaptively. The calling thread starts on the range
+ * alone, in chunks of the grain size, and only shares the rest with
+ * the thread pool once the loop has run for longer than a target chunk
+ * time. Cheap loops therefore never pay the task overhead. The participants
+ * then claim chunks of the grain size, which is derived from the measured
+ * cost of the latest chunk so that a chunk takes about the target chunk
+ * time, and is capped by the guided size `remaining / (2 * concurrency_level)`
+ * so that the end of the range is spread over all the participants.
+ * Expensive iterations are claimed one by one and a skewed range keeps all
+ * the participants busy. The cancellation token of the calling thread is
+ * checked before each chunk.
+ *
  * @tparam FuncT Function type (returning Status).
  * @param tp The threadpool to use.
  * @param begin Beginning of range (inclusive).
  * @param end End of range (exclusive).
  * @param F Function to call on each item
+ * @param stats If not null, receives the scheduling statistics of the call.
  * @return Status
  */
 template <typename FuncT>
 Status parallel_for(
-    ThreadPool* const tp, uint64_t begin, uint64_t end, const FuncT& F) {
+    ThreadPool* const tp,
+    uint64_t begin,
+    uint64_t end,
+    const FuncT& F,
+    ParallelForStats* const stats = nullptr) {
   assert(begin <= end);
 
   const uint64_t range_len = end - begin;
-  if (range_len == 0)
+  if (range_len == 0) {
+    if (stats != nullptr)
+      *stats = ParallelForStats();
     return Status::Ok();
+  }
 
   assert(tp);
 
-  bool failed = false;
+  // The wall time a chunk should take, large enough to amortize the cost of
+  // claiming it and of scheduling a task.
+  constexpr uint64_t target_chunk_ns = 50000;
+
+  using clock = std::chrono::steady_clock;
+  const auto start = clock::now();
+  auto elapsed_ns = [start]() -> uint64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               clock::now() - start)
+        .count();
+  };
+
+  const uint64_t concurrency_level = tp->concurrency_level();
+  std::atomic<uint64_t> next(begin);
+  std::atomic<uint64_t> grain(1);
+  std::atomic<uint64_t> chunk_num(0);
+  std::atomic<uint64_t> first_done_ns(std::numeric_limits<uint64_t>::max());
+  std::atomic<uint64_t> last_done_ns(0);
+  std::atomic<bool> failed(false);
   Status return_st = Status::Ok();
   std::mutex return_st_mutex;
 
-  // Executes subrange [subrange_start, subrange_end) that exists
-  // within the range [begin, end).
-  std::function<Status(uint64_t, uint64_t)> execute_subrange =
-      [&failed, &return_st, &return_st_mutex, &F](
-          const uint64_t subrange_start,
-          const uint64_t subrange_end) -> Status {
-    for (uint64_t i = subrange_start; i < subrange_end; ++i) {
-      const Status st = F(i);
-      if (!st.ok() && !failed) {
-        failed = true;
-        std::lock_guard<std::mutex> lock(return_st_mutex);
-        return_st = st;
+  // Claims the next chunk of the range, of the grain size. Guided chunks
+  // are also capped by a share of the remaining range. Returns the length of
+  // the chunk, 0 once the range is exhausted.
+  auto claim = [&](const bool guided, uint64_t* const chunk_start) {
+    uint64_t cur = next.load(std::memory_order_relaxed);
+    while (cur < end) {
+      const uint64_t remaining = end - cur;
+      uint64_t len = std::min(remaining, grain.load(std::memory_order_relaxed));
+      if (guided)
+        len = std::min(
+            len, std::max<uint64_t>(1, remaining / (2 * concurrency_level)));
+      if (next.compare_exchange_weak(cur, cur + len)) {
+        *chunk_start = cur;
+        return len;
       }
     }
+    return uint64_t(0);
+  };
 
-    return Status::Ok();
+  // Records the first failure of the loop.
+  auto set_failure = [&](const Status& st) {
+    if (!failed.exchange(true)) {
+      std::lock_guard<std::mutex> lock(return_st_mutex);
+      return_st = st;
+    }
   };
 
-  // Calculate the length of the subrange that each thread will
-  // be responsible for.
-  const uint64_t concurrency_level = tp->concurrency_level();
-  const uint64_t subrange_len = range_len / concurrency_level;
-  const uint64_t subrange_len_carry = range_len % concurrency_level;
+  // Executes the chunk [chunk_start, chunk_start + len) and updates the
+  // grain size from its cost. If the operation of the calling thread is
+  // cancelled, skips the chunk and the rest of the range instead.
+  auto execute_chunk = [&](const uint64_t chunk_start, const uint64_t len) {
+    const Status cancel_st = ThreadPool::check_cancellation();
+    if (!cancel_st.ok()) {
+      set_failure(cancel_st);
+      next = end;
+      return;
+    }
 
-  // Execute a bound instance of `execute_subrange` for each
-  // subrange on the global thread pool.
-  uint64_t fn_iter = 0;
-  std::vector<ThreadPool::Task> tasks;
-  tasks.reserve(concurrency_level);
-  for (size_t i = 0; i < concurrency_level; ++i) {
-    const uint64_t task_subrange_len =
-        subrange_len + ((i < subrange_len_carry) ? 1 : 0);
+    chunk_num.fetch_add(1, std::memory_order_relaxed);
+    const auto chunk_begin = clock::now();
+    for (uint64_t i = chunk_start; i < chunk_start + len; ++i) {
+      const Status st = F(i);
+      if (!st.ok())
+        set_failure(st);
+    }
+    const uint64_t chunk_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now() - chunk_begin)
+            .count();
+    const uint64_t chunk_grain =
+        chunk_ns == 0 ? 2 * len : len * target_chunk_ns / chunk_ns;
+    grain.store(
+        std::max<uint64_t>(1, std::min(chunk_grain, range_len)),
+        std::memory_order_relaxed);
+  };
 
-    if (task_subrange_len == 0)
-      break;
+  // Executes guided chunks until the range is exhausted.
+  auto execute_guided = [&]() -> Status {
+    uint64_t chunk_start;
+    while (const uint64_t len = claim(true, &chunk_start))
+      execute_chunk(chunk_start, len);
 
-    const uint64_t subrange_start = begin + fn_iter;
-    const uint64_t subrange_end = begin + fn_iter + task_subrange_len;
-    std::function<Status()> bound_fn =
-        std::bind(execute_subrange, subrange_start, subrange_end);
-    tasks.emplace_back(tp->execute(std::move(bound_fn)));
+    const uint64_t done_ns = elapsed_ns();
+    uint64_t first = first_done_ns.load();
+    while (done_ns < first &&
+           !first_done_ns.compare_exchange_weak(first, done_ns)) {
+    }
+    uint64_t last = last_done_ns.load();
+    while (done_ns > last &&
+           !last_done_ns.compare_exchange_weak(last, done_ns)) {
+    }
+    return Status::Ok();
+  };
 
-    fn_iter += task_subrange_len;
+  // Run the loop inline until it is known to be worth sharing.
+  uint64_t chunk_start;
+  while (concurrency_level > 1 && elapsed_ns() < target_chunk_ns) {
+    const uint64_t len = claim(false, &chunk_start);
+    if (len == 0)
+      break;
+    execute_chunk(chunk_start, len);
   }
 
-  // Wait for all instances of `execute_subrange` to complete.
+  // Share the rest of the range with at most one task per other thread,
+  // each with at least a grain of work.
+  std::vector<ThreadPool::Task> tasks;
+  const uint64_t cur = next.load();
+  if (cur < end) {
+    const uint64_t task_num = std::min(
+        concurrency_level - 1,
+        (end - cur) / grain.load(std::memory_order_relaxed));
+    tasks.reserve(task_num);
+    for (uint64_t t = 0; t < task_num; ++t) {
+      std::function<Status()> fn = execute_guided;
+      tasks.emplace_back(tp->execute(std::move(fn)));
+    }
+  }
+  execute_guided();
+
+  // Wait for all instances of `execute_guided` to complete.
   tp->wait_all(tasks);
 
+  if (stats != nullptr) {
+    stats->chunk_num = chunk_num;
+    stats->task_num = tasks.size();
+    stats->elapsed_ns = elapsed_ns();
+    stats->imbalance_ns = last_done_ns - first_done_ns;
+  }
+
   return return_st;
 }
 
@@ -239,6 +365,9 @@ Status parallel_for(
  * Call the given function on every pair (i, j) in the given i and j ranges,
  * possibly in parallel.
  *
+ * The ranges are split into a grid of up to `concurrency_level` subranges
+ * per dimension, whose blocks are scheduled with `parallel_for`.
+ *
  * @tparam FuncT Function type (returning Status).
  * @param tp The threadpool to use.
  * @param i0 Inclusive start of outer (rows) range.
@@ -246,6 +375,7 @@ Status parallel_for(
  * @param j0 Inclusive start of inner (cols) range.
  * @param j1 Exclusive end of inner range.
  * @param F Function to call on each (i, j) pair.
+ * @param stats If not null, receives the scheduling statistics of the call.
  * @return Status
  */
 template <typename FuncT>
@@ -255,7 +385,8 @@ Status parallel_for_2d(
     uint64_t i1,
     uint64_t j0,
     uint64_t j1,
-    const FuncT& F) {
+    const FuncT& F,
+    ParallelForStats* const stats = nullptr) {
   assert(i0 <= i1);
   assert(j0 <= j1);
 
@@ -264,43 +395,19 @@ Status parallel_for_2d(
   const uint64_t range_len_i = i1 - i0;
   const uint64_t range_len_j = j1 - j0;
 
-  if (range_len_i == 0 || range_len_j == 0)
+  if (range_len_i == 0 || range_len_j == 0) {
+    if (stats != nullptr)
+      *stats = ParallelForStats();
     return Status::Ok();
+  }
 
-  bool failed = false;
-  Status return_st = Status::Ok();
-  std::mutex return_st_mutex;
-
-  // Calculate the length of the subrange-i and subrange-j that
-  // each thread will be responsible for.
+  // Calculate the length of the subrange-i and subrange-j of each block.
   const uint64_t concurrency_level = tp->concurrency_level();
   const uint64_t subrange_len_i = range_len_i / concurrency_level;
   const uint64_t subrange_len_i_carry = range_len_i % concurrency_level;
   const uint64_t subrange_len_j = range_len_j / concurrency_level;
   const uint64_t subrange_len_j_carry = range_len_j % concurrency_level;
 
-  // Executes subarray [begin_i, end_i) x [start_j, end_j) within the
-  // array [i0, i1) x [j0, j1).
-  std::function<Status(uint64_t, uint64_t, uint64_t, uint64_t)>
-      execute_subrange_ij = [&failed, &return_st, &return_st_mutex, &F](
-                                const uint64_t begin_i,
-                                const uint64_t end_i,
-                                const uint64_t start_j,
-                                const uint64_t end_j) -> Status {
-    for (uint64_t i = begin_i; i < end_i; ++i) {
-      for (uint64_t j = start_j; j < end_j; ++j) {
-        const Status st = F(i, j);
-        if (!st.ok() && !failed) {
-          failed = true;
-          std::lock_guard<std::mutex> lock(return_st_mutex);
-          return_st = st;
-        }
-      }
-    }
-
-    return Status::Ok();
-  };
-
   // Calculate the subranges for each dimension, i and j.
   std::vector<std::pair<uint64_t, uint64_t>> subranges_i;
   std::vector<std::pair<uint64_t, uint64_t>> subranges_j;
@@ -330,26 +437,239 @@ Status parallel_for_2d(
     }
   }
 
-  // Execute a bound instance of `execute_subrange_ij` for each
-  // 2D subarray on the global thread pool.
-  std::vector<ThreadPool::Task> tasks;
-  tasks.reserve(concurrency_level * concurrency_level);
-  for (const auto& subrange_i : subranges_i) {
-    for (const auto& subrange_j : subranges_j) {
-      std::function<Status()> bound_fn = std::bind(
-          execute_subrange_ij,
-          subrange_i.first,
-          subrange_i.second,
-          subrange_j.first,
-          subrange_j.second);
-      tasks.emplace_back(tp->execute(std::move(bound_fn)));
+  // Executes the block [begin_i, end_i) x [start_j, end_j) with index
+  // `block` within the array [i0, i1) x [j0, j1), returning the first error.
+  const uint64_t block_num = subranges_i.size() * subranges_j.size();
+  auto execute_block = [&](const uint64_t block) -> Status {
+    const auto& subrange_i = subranges_i[block / subranges_j.size()];
+    const auto& subrange_j = subranges_j[block % subranges_j.size()];
+    Status return_st = Status::Ok();
+    for (uint64_t i = subrange_i.first; i < subrange_i.second; ++i) {
+      for (uint64_t j = subrange_j.first; j < subrange_j.second; ++j) {
+        const Status st = F(i, j);
+        if (!st.ok() && return_st.ok())
+          return_st = st;
+      }
+    }
+
+    return return_st;
+  };
+
+  return parallel_for(tp, 0, block_num, execute_block, stats);
+}
+
+/**
+ * Sort the given iterator range, possibly in parallel, with a sample sort:
+ *
+ * 1. Sort an evenly spaced sample of the range and pick splitters from it.
+ * 2. Classify the elements in buckets between and equal to the splitters,
+ *    counting the bucket sizes per chunk of the range in parallel.
+ * 3. Scatter the chunks in parallel to a temporary buffer, bucket by bucket.
+ * 4. Sort the buckets in parallel and move them back to the range. Buckets
+ *    of elements equal to a splitter are already sorted.
+ *
+ * Unlike the recursive `parallel_quick_sort`, every step of the sort runs
+ * in parallel, and it only allocates the temporary buffer and the bucket of
+ * each element. Small ranges are sorted with `std::sort`. The sort is not
+ * stable and the value type must be default constructible.
+ *
+ * The sort always completes: the cancellation token of the calling thread
+ * is not checked.
+ *
+ * @tparam IterT Iterator type
+ * @tparam CmpT Comparator type
+ * @param tp The threadpool to use.
+ * @param begin Beginning of range to sort (inclusive).
+ * @param end End of range to sort (exclusive).
+ * @param cmp Comparator.
+ */
+template <
+    typename IterT,
+    typename CmpT = std::less<typename std::iterator_traits<IterT>::value_type>>
+void parallel_sort(
+    ThreadPool* const tp, IterT begin, IterT end, const CmpT& cmp = CmpT()) {
+  using ValueT = typename std::iterator_traits<IterT>::value_type;
+  assert(tp);
+
+  // The minimum number of elements of a bucket, below which the overhead
+  // of the sample sort outweighs its parallelism.
+  constexpr uint64_t min_bucket_size = 1 << 12;
+  // The number of samples per bucket.
+  constexpr uint64_t oversampling = 16;
+  // The number of buckets per thread, for load balancing.
+  constexpr uint64_t buckets_per_thread = 4;
+
+  const uint64_t n = std::distance(begin, end);
+  const uint64_t concurrency_level = tp->concurrency_level();
+  const uint64_t splitter_num =
+      std::min(buckets_per_thread * concurrency_level, n / min_bucket_size);
+  if (concurrency_level <= 1 || splitter_num <= 1) {
+    std::sort(begin, end, cmp);
+    return;
+  }
+
+  // The sort must complete, do not cancel its chunks.
+  ThreadPool::ScopedCancellation no_cancellation(nullptr);
+
+  // Pick the splitters from a sorted sample, without duplicates.
+  std::vector<ValueT> splitters;
+  {
+    const uint64_t sample_num = splitter_num * oversampling;
+    std::vector<ValueT> sample;
+    sample.reserve(sample_num);
+    for (uint64_t i = 0; i < sample_num; ++i)
+      sample.emplace_back(*(begin + i * (n / sample_num)));
+    std::sort(sample.begin(), sample.end(), cmp);
+    splitters.reserve(splitter_num);
+    for (uint64_t i = oversampling / 2; i < sample_num; i += oversampling) {
+      if (splitters.empty() || cmp(splitters.back(), sample[i]))
+        splitters.emplace_back(std::move(sample[i]));
     }
   }
 
-  // Wait for all instances of `execute_subrange` to complete.
-  tp->wait_all(tasks);
+  // Bucket `2 * s` holds the elements between splitters `s - 1` and `s`,
+  // and bucket `2 * s + 1` the elements equal to splitter `s`.
+  const uint64_t bucket_num = 2 * splitters.size() + 1;
+  auto bucket_of = [&](const ValueT& value) -> uint32_t {
+    const uint64_t s =
+        std::upper_bound(splitters.begin(), splitters.end(), value, cmp) -
+        splitters.begin();
+    if (s > 0 && !cmp(splitters[s - 1], value))
+      return static_cast<uint32_t>(2 * s - 1);
+    return static_cast<uint32_t>(2 * s);
+  };
 
-  return return_st;
+  // Classify the elements and count the bucket sizes of each chunk.
+  const uint64_t chunk_num = concurrency_level;
+  const uint64_t chunk_size = (n + chunk_num - 1) / chunk_num;
+  std::vector<uint32_t> buckets(n);
+  std::vector<std::vector<uint64_t>> offsets(
+      chunk_num, std::vector<uint64_t>(bucket_num, 0));
+  parallel_for(tp, 0, chunk_num, [&](uint64_t c) {
+    auto& count = offsets[c];
+    const uint64_t chunk_end = std::min(n, (c + 1) * chunk_size);
+    for (uint64_t i = c * chunk_size; i < chunk_end; ++i) {
+      buckets[i] = bucket_of(*(begin + i));
+      ++count[buckets[i]];
+    }
+    return Status::Ok();
+  });
+
+  // Compute where each chunk writes each bucket.
+  std::vector<uint64_t> bucket_starts(bucket_num + 1);
+  uint64_t sum = 0;
+  for (uint64_t b = 0; b < bucket_num; ++b) {
+    bucket_starts[b] = sum;
+    for (uint64_t c = 0; c < chunk_num; ++c) {
+      const uint64_t count = offsets[c][b];
+      offsets[c][b] = sum;
+      sum += count;
+    }
+  }
+  bucket_starts[bucket_num] = sum;
+
+  // Scatter the chunks.
+  std::vector<ValueT> tmp(n);
+  parallel_for(tp, 0, chunk_num, [&](uint64_t c) {
+    auto& pos = offsets[c];
+    const uint64_t chunk_end = std::min(n, (c + 1) * chunk_size);
+    for (uint64_t i = c * chunk_size; i < chunk_end; ++i)
+      tmp[pos[buckets[i]]++] = std::move(*(begin + i));
+    return Status::Ok();
+  });
+
+  // Sort the buckets and move them back.
+  parallel_for(tp, 0, bucket_num, [&](uint64_t b) {
+    auto bucket_begin = tmp.begin() + bucket_starts[b];
+    auto bucket_end = tmp.begin() + bucket_starts[b + 1];
+    if (b % 2 == 0)
+      std::sort(bucket_begin, bucket_end, cmp);
+    std::move(bucket_begin, bucket_end, begin + bucket_starts[b]);
+    return Status::Ok();
+  });
+}
+
+/**
+ * Sorts the values by their unsigned integer keys with a stable LSD radix
+ * sort, 8 bits per pass. Each pass counts and scatters chunks of the range
+ * in parallel. Passes where all the keys have the same digit are skipped.
+ *
+ * @tparam ValueT Value type.
+ * @param tp The threadpool to use.
+ * @param keys The keys, sorted on return.
+ * @param values The values, in the order of the sorted keys on return.
+ * @param key_bits The number of least significant bits set in the keys.
+ */
+template <typename ValueT>
+void parallel_radix_sort(
+    ThreadPool* const tp,
+    std::vector<uint64_t>* const keys,
+    std::vector<ValueT>* const values,
+    const unsigned key_bits) {
+  assert(tp);
+  assert(keys->size() == values->size());
+
+  constexpr unsigned radix_bits = 8;
+  constexpr uint64_t radix = uint64_t(1) << radix_bits;
+  constexpr uint64_t min_chunk_size = 1 << 16;
+  const uint64_t n = keys->size();
+  if (n <= 1)
+    return;
+
+  // Split in chunks processed by one thread each.
+  const uint64_t chunk_num = std::max<uint64_t>(
+      1, std::min<uint64_t>(tp->concurrency_level(), n / min_chunk_size));
+  const uint64_t chunk_size = (n + chunk_num - 1) / chunk_num;
+
+  // The sort must complete, do not cancel its chunks.
+  ThreadPool::ScopedCancellation no_cancellation(nullptr);
+
+  std::vector<uint64_t> keys_tmp(n);
+  std::vector<ValueT> values_tmp(n);
+  std::vector<std::array<uint64_t, radix>> counts(chunk_num);
+  for (unsigned shift = 0; shift < key_bits; shift += radix_bits) {
+    // Count the digits of each chunk.
+    parallel_for(tp, 0, chunk_num, [&](uint64_t c) {
+      auto& count = counts[c];
+      count.fill(0);
+      const uint64_t end = std::min(n, (c + 1) * chunk_size);
+      for (uint64_t i = c * chunk_size; i < end; i++) {
+        count[((*keys)[i] >> shift) & (radix - 1)]++;
+      }
+      return Status::Ok();
+    });
+
+    // Compute where each chunk writes each digit, in digit then chunk order
+    // to keep the sort stable.
+    bool same_digit = false;
+    uint64_t sum = 0;
+    for (uint64_t d = 0; d < radix; d++) {
+      const uint64_t digit_start = sum;
+      for (uint64_t c = 0; c < chunk_num; c++) {
+        const uint64_t count = counts[c][d];
+        counts[c][d] = sum;
+        sum += count;
+      }
+      same_digit |= sum - digit_start == n;
+    }
+    if (same_digit)
+      continue;
+
+    // Scatter the chunks.
+    parallel_for(tp, 0, chunk_num, [&](uint64_t c) {
+      auto& pos = counts[c];
+      const uint64_t end = std::min(n, (c + 1) * chunk_size);
+      for (uint64_t i = c * chunk_size; i < end; i++) {
+        const uint64_t p = pos[((*keys)[i] >> shift) & (radix - 1)]++;
+        keys_tmp[p] = (*keys)[i];
+        values_tmp[p] = (*values)[i];
+      }
+      return Status::Ok();
+    });
+
+    keys->swap(keys_tmp);
+    values->swap(values_tmp);
+  }
 }
 
 }  // namespace sm
@@ -0,0 +1,101 @@
+/**
+ * @file   shared_registry.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class SharedRegistry.
+ */
+
+#ifndef TILEDB_SHARED_REGISTRY_H
+#define TILEDB_SHARED_REGISTRY_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Objects shared by all their users in the process, keyed by the
+ * configuration they were created with. The registry only holds weak
+ * references, so an object is destroyed with its last user and created
+ * again for the next one.
+ */
+template <class T>
+class SharedRegistry {
+ public:
+  /**
+   * Gets the object of `key`, creating it with `create` if there is none.
+   *
+   * @param key The configuration of the object.
+   * @param create Called as `Status create(std::shared_ptr<T>*)` to create
+   *     the object. The registry stays locked meanwhile.
+   * @param object Set to the object.
+   * @return Status
+   */
+  template <class F>
+  Status get(const std::string& key, F&& create, std::shared_ptr<T>* object) {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto it = objects_.find(key);
+    if (it != objects_.end()) {
+      *object = it->second.lock();
+      if (*object != nullptr)
+        return Status::Ok();
+    }
+
+    RETURN_NOT_OK(create(object));
+
+    // Drop the objects whose users are all gone.
+    for (auto e = objects_.begin(); e != objects_.end();) {
+      if (e->second.expired())
+        e = objects_.erase(e);
+      else
+        ++e;
+    }
+    objects_[key] = *object;
+
+    return Status::Ok();
+  }
+
+ private:
+  /** Protects `objects_`. */
+  std::mutex mtx_;
+
+  /** The objects, by key. */
+  std::unordered_map<std::string, std::weak_ptr<T>> objects_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARED_REGISTRY_H
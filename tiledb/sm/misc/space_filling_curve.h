@@ -0,0 +1,124 @@
+/**
+ * @file   space_filling_curve.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class SpaceFillingCurve.
+ */
+
+#ifndef TILEDB_SPACE_FILLING_CURVE_H
+#define TILEDB_SPACE_FILLING_CURVE_H
+
+#include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/hilbert.h"
+#include "tiledb/sm/misc/morton.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Computes the values of the space-filling curve of a HILBERT or MORTON
+ * cell order. Cells are sorted on these values, and the code handling
+ * both orders refers to them as Hilbert values.
+ */
+class SpaceFillingCurve {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param cell_order The cell order, HILBERT or MORTON.
+   * @param dim_num Number of dimensions
+   */
+  SpaceFillingCurve(Layout cell_order, int dim_num)
+      : morton_(cell_order == Layout::MORTON)
+      , hilbert_(dim_num) {
+    assert(layout_is_curve(cell_order));
+  }
+
+  /** Destructor. */
+  ~SpaceFillingCurve() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of bits per dimension. */
+  int bits() const {
+    return hilbert_.bits();
+  }
+
+  /**
+   * Converts a set of coordinates to a curve value.
+   *
+   * @param coords The coordinates to be converted. They may be modified.
+   * @return The output curve value.
+   */
+  uint64_t coords_to_value(uint64_t* coords) {
+    if (morton_)
+      return Morton(hilbert_.bits(), hilbert_.dim_num())
+          .coords_to_morton(coords);
+    return hilbert_.coords_to_hilbert(coords);
+  }
+
+  /**
+   * Converts the coordinates of `cell_num` cells to curve values. The
+   * coordinates are stored dimension by dimension, i.e. coordinate `d` of
+   * cell `c` is `coords[d * cell_num + c]`.
+   *
+   * @param cell_num The number of cells.
+   * @param coords The coordinates to be converted. They may be modified.
+   * @param values The output curve values, of size `cell_num`.
+   */
+  void coords_to_values(uint64_t cell_num, uint64_t* coords, uint64_t* values)
+      const {
+    if (morton_)
+      Morton(hilbert_.bits(), hilbert_.dim_num())
+          .coords_to_morton(cell_num, coords, values);
+    else
+      hilbert_.coords_to_hilbert(cell_num, coords, values);
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** True for the Morton curve, false for the Hilbert curve. */
+  bool morton_;
+
+  /** The Hilbert curve, which also provides the number of bits. */
+  Hilbert hilbert_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SPACE_FILLING_CURVE_H
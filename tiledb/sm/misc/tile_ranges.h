@@ -0,0 +1,301 @@
+/**
+ * @file   tile_ranges.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This defines a compact ordered set of tile ids.
+ */
+
+#ifndef TILEDB_TILE_RANGES_H
+#define TILEDB_TILE_RANGES_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "tiledb/sm/misc/packed_bitmap.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * An ordered set of tile ids, built from increasing ranges of ids and
+ * consumed from the lowest id. It holds the tiles of a fragment a query
+ * overlaps, which for queries with many ranges may span most tiles of
+ * thousands of fragments.
+ *
+ * As in a Roaring bitmap, the ids are split in blocks of `BLOCK_SIZE` ids
+ * sharing their high bits. A block stores its ids as runs of consecutive
+ * ids, four bytes per run, or as a bitmap of one bit per id once that is
+ * smaller. Blocks are released as soon as their ids are consumed.
+ */
+class TileRanges {
+ public:
+  /* ********************************* */
+  /*             CONSTANTS             */
+  /* ********************************* */
+
+  /** The number of low bits of a tile id indexing into its block. */
+  static const unsigned BLOCK_BITS = 16;
+
+  /** The number of tile ids in a block. */
+  static const uint64_t BLOCK_SIZE = uint64_t(1) << BLOCK_BITS;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  TileRanges()
+      : cursor_block_(0)
+      , cursor_run_(0)
+      , front_(0)
+      , back_(0)
+      , memory_usage_(0) {
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns `true` if there are no tile ids left. */
+  bool empty() const {
+    return cursor_block_ == blocks_.size();
+  }
+
+  /** Returns the lowest tile id left. */
+  uint64_t front() const {
+    assert(!empty());
+    return front_;
+  }
+
+  /** Returns the highest tile id. */
+  uint64_t back() const {
+    assert(!empty());
+    return back_;
+  }
+
+  /** Returns the number of bytes allocated for the tile ids. */
+  uint64_t memory_usage() const {
+    return memory_usage_;
+  }
+
+  /**
+   * Adds the tile ids in `[start, end]`, which must all be greater than
+   * the ids added before.
+   */
+  void add_range(uint64_t start, uint64_t end) {
+    assert(start <= end);
+    assert(blocks_.empty() || start > back_);
+    assert(cursor_block_ == 0 && cursor_run_ == 0);
+
+    // Only the last block and the blocks added here change.
+    const size_t first_changed = blocks_.empty() ? 0 : blocks_.size() - 1;
+    memory_usage_ -= blocks_memory_usage(first_changed);
+    if (blocks_.empty())
+      front_ = start;
+
+    for (uint64_t s = start;;) {
+      const uint64_t key = s >> BLOCK_BITS;
+      const uint64_t e = std::min(end, (key << BLOCK_BITS) | (BLOCK_SIZE - 1));
+      if (blocks_.empty() || blocks_.back().key_ != key)
+        blocks_.emplace_back(key);
+      add_to_block(&blocks_.back(), s & (BLOCK_SIZE - 1), e & (BLOCK_SIZE - 1));
+      if (e == end)
+        break;
+      s = e + 1;
+    }
+
+    back_ = end;
+    memory_usage_ += blocks_memory_usage(first_changed);
+  }
+
+  /** Releases the memory reserved for adding more tile ids. */
+  void shrink_to_fit() {
+    blocks_.shrink_to_fit();
+    for (auto& block : blocks_)
+      block.runs_.shrink_to_fit();
+    memory_usage_ = blocks_memory_usage(0);
+  }
+
+  /** Removes the lowest tile id, releasing its block if it was the last. */
+  void pop_front() {
+    assert(!empty());
+    Block& block = blocks_[cursor_block_];
+    const uint64_t id = front_ & (BLOCK_SIZE - 1);
+
+    // Find the next id of the block, `BLOCK_SIZE` if there is none.
+    uint64_t next = BLOCK_SIZE;
+    if (block.bitmap_.empty()) {
+      const uint64_t run_last =
+          block.runs_[2 * cursor_run_] + block.runs_[2 * cursor_run_ + 1];
+      if (id < run_last) {
+        next = id + 1;
+      } else if (2 * ++cursor_run_ < block.runs_.size()) {
+        next = block.runs_[2 * cursor_run_];
+      }
+    } else if (id + 1 < BLOCK_SIZE) {
+      next = block.bitmap_[id + 1] ?
+                 id + 1 :
+                 block.bitmap_.run_end(id + 1, BLOCK_SIZE);
+    }
+
+    if (next < BLOCK_SIZE) {
+      front_ = (block.key_ << BLOCK_BITS) | next;
+      return;
+    }
+
+    // Release the consumed block and move to the next one.
+    memory_usage_ -= block_memory_usage(block);
+    std::vector<uint16_t>().swap(block.runs_);
+    block.bitmap_.clear();
+    cursor_block_++;
+    cursor_run_ = 0;
+    if (empty()) {
+      memory_usage_ -= blocks_.capacity() * sizeof(Block);
+      std::vector<Block>().swap(blocks_);
+      cursor_block_ = 0;
+      return;
+    }
+
+    front_ = first_id(blocks_[cursor_block_]);
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The tile ids sharing the same high bits. */
+  struct Block {
+    /** Constructor. */
+    explicit Block(uint64_t key)
+        : key_(key) {
+    }
+
+    /** The high bits of the tile ids. */
+    uint64_t key_;
+
+    /**
+     * The runs of ids, as pairs of the low bits of the first id of the run
+     * and the run length minus one. Empty when the bitmap is used.
+     */
+    std::vector<uint16_t> runs_;
+
+    /** One bit per id of the block, or empty when the runs are used. */
+    PackedBitmap bitmap_;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The blocks, in increasing order of their keys. */
+  std::vector<Block> blocks_;
+
+  /** The block of the lowest id left. */
+  size_t cursor_block_;
+
+  /** The run of the lowest id left, when its block uses runs. */
+  size_t cursor_run_;
+
+  /** The lowest id left. */
+  uint64_t front_;
+
+  /** The highest id. */
+  uint64_t back_;
+
+  /** The number of bytes allocated. */
+  uint64_t memory_usage_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Adds the ids with low bits in `[start, end]` to a block. */
+  static void add_to_block(Block* block, uint64_t start, uint64_t end) {
+    if (!block->bitmap_.empty()) {
+      for (uint64_t id = start; id <= end; id++)
+        block->bitmap_[id] = 1;
+      return;
+    }
+
+    // Extend the last run if the ids follow it.
+    auto& runs = block->runs_;
+    if (!runs.empty() &&
+        uint64_t(runs[runs.size() - 2]) + runs.back() + 1 == start) {
+      runs.back() += static_cast<uint16_t>(end - start + 1);
+      return;
+    }
+
+    runs.emplace_back(static_cast<uint16_t>(start));
+    runs.emplace_back(static_cast<uint16_t>(end - start));
+
+    // Switch to a bitmap once it is smaller than the runs.
+    if (runs.size() * sizeof(uint16_t) > PackedBitmap::alloc_size(BLOCK_SIZE)) {
+      block->bitmap_.resize(BLOCK_SIZE);
+      for (size_t r = 0; r < runs.size(); r += 2) {
+        for (uint64_t id = runs[r]; id <= uint64_t(runs[r]) + runs[r + 1]; id++)
+          block->bitmap_[id] = 1;
+      }
+      std::vector<uint16_t>().swap(runs);
+    }
+  }
+
+  /** Returns the first id of a block. */
+  static uint64_t first_id(const Block& block) {
+    const uint64_t low = !block.bitmap_.empty() ?
+                             (block.bitmap_[0] ?
+                                  0 :
+                                  block.bitmap_.run_end(0, BLOCK_SIZE)) :
+                             block.runs_[0];
+    return (block.key_ << BLOCK_BITS) | low;
+  }
+
+  /** Returns the number of bytes allocated by a block. */
+  static uint64_t block_memory_usage(const Block& block) {
+    return block.runs_.capacity() * sizeof(uint16_t) +
+           PackedBitmap::alloc_size(block.bitmap_.size());
+  }
+
+  /**
+   * Returns the number of bytes allocated for the blocks, counting the
+   * contents of the blocks from `first_block` only.
+   */
+  uint64_t blocks_memory_usage(size_t first_block) const {
+    uint64_t size = blocks_.capacity() * sizeof(Block);
+    for (size_t b = first_block; b < blocks_.size(); b++)
+      size += block_memory_usage(blocks_[b]);
+    return size;
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_RANGES_H
@@ -59,7 +59,10 @@ class Range {
   Range()
       : range_start_size_(0)
       , var_size_(false)
-      , partition_depth_(0) {
+      , partition_depth_(0)
+      , inline_(false)
+      , inline_range_()
+      , size_(0) {
   }
 
   /** Constructor setting a range. */
@@ -74,8 +77,14 @@ class Range {
     set_range(range, range_size, range_start_size);
   }
 
-  /** Copy constructor. */
-  Range(const Range&) = default;
+  /**
+   * Copy constructor. The copy always stores its bytes on the heap, so that
+   * pointers to them survive moving it, e.g. in the ranges of a subarray.
+   */
+  Range(const Range& r)
+      : Range() {
+    *this = r;
+  }
 
   /** Move constructor. */
   Range(Range&&) = default;
@@ -83,22 +92,42 @@ class Range {
   /** Destructor. */
   ~Range() = default;
 
-  /** Copy-assign operator.*/
-  Range& operator=(const Range&) = default;
+  /** Copy-assign operator. Same as the copy constructor. */
+  Range& operator=(const Range& r) {
+    if (this == &r)
+      return *this;
+
+    if (r.size_ == 0)
+      clear();
+    else
+      std::memcpy(alloc(r.size_, false), r.bytes(), r.size_);
+    range_start_size_ = r.range_start_size_;
+    var_size_ = r.var_size_;
+    partition_depth_ = r.partition_depth_;
+    return *this;
+  }
 
   /** Move-assign operator. */
   Range& operator=(Range&&) = default;
 
   /** Sets a fixed-sized range serialized in `r`. */
   void set_range(const void* r, uint64_t r_size) {
-    range_.resize(r_size);
-    std::memcpy(range_.data(), r, r_size);
+    std::memcpy(alloc(r_size, false), r, r_size);
+  }
+
+  /**
+   * Sets a fixed-sized range serialized in `r`, stored inside this object
+   * if it fits. This spares an allocation per range, e.g. per MBR dimension
+   * when loading the R-trees of fragments, but pointers to the range bytes
+   * are then only valid until the range is moved.
+   */
+  void set_range_inline(const void* r, uint64_t r_size) {
+    std::memcpy(alloc(r_size, true), r, r_size);
   }
 
   /** Sets a var-sized range serialized in `r`. */
   void set_range(const void* r, uint64_t r_size, uint64_t range_start_size) {
-    range_.resize(r_size);
-    std::memcpy(range_.data(), r, r_size);
+    std::memcpy(alloc(r_size, false), r, r_size);
     range_start_size_ = range_start_size;
     var_size_ = true;
   }
@@ -106,9 +135,8 @@ class Range {
   /** Sets a var-sized range `[r1, r2]`. */
   void set_range_var(
       const void* r1, uint64_t r1_size, const void* r2, uint64_t r2_size) {
-    range_.resize(r1_size + r2_size);
-    std::memcpy(range_.data(), r1, r1_size);
-    auto c = (char*)(range_.data());
+    auto c = alloc(r1_size + r2_size, false);
+    std::memcpy(c, r1, r1_size);
     std::memcpy(c + r1_size, r2, r2_size);
     range_start_size_ = r1_size;
     var_size_ = true;
@@ -118,7 +146,7 @@ class Range {
   void set_str_range(const std::string& s1, const std::string& s2) {
     auto size = s1.size() + s2.size();
     if (size == 0) {
-      range_.clear();
+      clear();
       range_start_size_ = 0;
       return;
     }
@@ -128,12 +156,12 @@ class Range {
 
   /** Returns the pointer to the range flattened bytes. */
   const void* data() const {
-    return range_.empty() ? nullptr : range_.data();
+    return size_ == 0 ? nullptr : bytes();
   }
 
   /** Returns a pointer to the start of the range. */
   const void* start() const {
-    return range_.data();
+    return bytes();
   }
 
   /** Copies 'start' into this range's start bytes for fixed-size ranges. */
@@ -143,8 +171,8 @@ class Range {
       return;
     }
 
-    const size_t fixed_size = range_.size() / 2;
-    std::memcpy(range_.data(), start, fixed_size);
+    const size_t fixed_size = size_ / 2;
+    std::memcpy(bytes(), start, fixed_size);
   }
 
   /** Returns the start as a string view. */
@@ -172,13 +200,13 @@ class Range {
   uint64_t end_size() const {
     if (!var_size_)
       return 0;
-    return range_.size() - range_start_size_;
+    return size_ - range_start_size_;
   }
 
   /** Returns a pointer to the end of the range. */
   const void* end() const {
-    auto end_pos = var_size_ ? range_start_size_ : range_.size() / 2;
-    return range_.empty() ? nullptr : &range_[end_pos];
+    auto end_pos = var_size_ ? range_start_size_ : size_ / 2;
+    return size_ == 0 ? nullptr : bytes() + end_pos;
   }
 
   /** Copies 'end' into this range's end bytes for fixed-size ranges. */
@@ -187,41 +215,42 @@ class Range {
       LOG_ERROR("Unexpected var-sized range; cannot set end range.");
       return;
     }
-    const size_t fixed_size = range_.size() / 2;
-    std::memcpy(&range_[fixed_size], end, fixed_size);
+    const size_t fixed_size = size_ / 2;
+    std::memcpy(bytes() + fixed_size, end, fixed_size);
   }
 
   /** Returns true if the range is empty. */
   bool empty() const {
-    return range_.empty();
+    return size_ == 0;
   }
 
   /** Clears the range. */
   void clear() {
     range_.clear();
+    inline_ = false;
+    size_ = 0;
   }
 
   /** Returns the range size in bytes. */
   uint64_t size() const {
-    return range_.size();
+    return size_;
   }
 
   /** Equality operator. */
   bool operator==(const Range& r) const {
-    return range_ == r.range_ && range_start_size_ == r.range_start_size_;
+    return size_ == r.size_ && range_start_size_ == r.range_start_size_ &&
+           (size_ == 0 || !std::memcmp(bytes(), r.bytes(), size_));
   }
 
   /** Returns true if the range start is the same as its end. */
   bool unary() const {
     // If the range is empty, then it corresponds to strings
     // covering the whole domain (so it is not unary)
-    if (range_.empty())
+    if (size_ == 0)
       return false;
 
-    bool same_size = !var_size_ || 2 * range_start_size_ == range_.size();
-    return same_size &&
-           !std::memcmp(
-               range_.data(), &range_[range_.size() / 2], range_.size() / 2);
+    bool same_size = !var_size_ || 2 * range_start_size_ == size_;
+    return same_size && !std::memcmp(bytes(), bytes() + size_ / 2, size_ / 2);
   }
 
   /** True if the range is variable sized. */
@@ -240,10 +269,17 @@ class Range {
   }
 
  private:
-  /** The range as a flat byte vector. */
+  /**
+   * Ranges set with `set_range_inline` up to this size in bytes are stored
+   * in `inline_range_`, which covers the fixed-sized ranges of all the
+   * dimension datatypes.
+   */
+  static constexpr uint64_t INLINE_SIZE = 16;
+
+  /** The range as a flat byte vector, if not stored inline. */
   std::vector<uint8_t> range_;
 
-  /** The size of the start of `range_`. */
+  /** The size of the start of the range. */
   uint64_t range_start_size_;
 
   /** Is the range var sized. */
@@ -255,6 +291,42 @@ class Range {
    * set to +1 the depth of the original range.
    */
   uint64_t partition_depth_;
+
+  /** Are the range bytes stored in `inline_range_`. */
+  bool inline_;
+
+  /** The range bytes, if stored inline. */
+  uint8_t inline_range_[INLINE_SIZE];
+
+  /** The size of the range in bytes. */
+  uint64_t size_;
+
+  /** Returns the range bytes. */
+  const uint8_t* bytes() const {
+    return inline_ ? inline_range_ : range_.data();
+  }
+
+  /** Returns the range bytes. */
+  uint8_t* bytes() {
+    return inline_ ? inline_range_ : range_.data();
+  }
+
+  /**
+   * Sets the size of the range, without preserving its contents.
+   *
+   * @param size The size of the range in bytes.
+   * @param allow_inline Whether the range may be stored inline.
+   * @return The range bytes, to be filled in by the caller.
+   */
+  uint8_t* alloc(uint64_t size, bool allow_inline) {
+    size_ = size;
+    inline_ = allow_inline && size <= INLINE_SIZE;
+    if (inline_)
+      range_.clear();
+    else
+      range_.resize(size);
+    return bytes();
+  }
 };
 
 /** An N-dimensional range, consisting of a vector of 1D ranges. */
@@ -30,7 +30,10 @@
  * This file defines a platform-independent UUID generator.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <mutex>
+#include <random>
 #include <vector>
 
 #include "tiledb/sm/misc/uuid.h"
@@ -40,7 +43,7 @@
 #else
 #include <openssl/err.h>
 #include <openssl/rand.h>
-#include <cstdio>
+#include <unistd.h>
 #endif
 
 using namespace tiledb::common;
@@ -49,63 +52,33 @@ namespace tiledb {
 namespace sm {
 namespace uuid {
 
-/** Mutex to guard UUID generation. */
+/** Mutex to guard the random sources that seed the UUID generators. */
 static std::mutex uuid_mtx;
 
 #ifdef _WIN32
 
 /**
- * Generate a UUID using Win32 RPC API.
+ * Generate random bytes using the Win32 RPC API, whose UUIDs are random
+ * except for their version and variant bits.
  */
-Status generate_uuid_win32(std::string* uuid_str) {
-  if (uuid_str == nullptr)
-    return Status_UtilsError("Null UUID string argument");
-
-  UUID uuid;
-  RPC_STATUS rc = UuidCreate(&uuid);
-  if (rc != RPC_S_OK)
-    return Status_UtilsError("Unable to generate Win32 UUID: creation error");
-
-  char* buf = nullptr;
-  rc = UuidToStringA(&uuid, reinterpret_cast<RPC_CSTR*>(&buf));
-  if (rc != RPC_S_OK)
-    return Status_UtilsError(
-        "Unable to generate Win32 UUID: string conversion error");
-
-  *uuid_str = std::string(buf);
-
-  rc = RpcStringFreeA(reinterpret_cast<RPC_CSTR*>(&buf));
-  if (rc != RPC_S_OK)
-    return Status_UtilsError("Unable to generate Win32 UUID: free error");
+Status random_bytes_win32(uint8_t* bytes, size_t nbytes) {
+  for (size_t i = 0; i < nbytes; i += sizeof(UUID)) {
+    UUID uuid;
+    RPC_STATUS rc = UuidCreate(&uuid);
+    if (rc != RPC_S_OK)
+      return Status_UtilsError(
+          "Unable to generate Win32 UUID: creation error");
+    memcpy(bytes + i, &uuid, std::min(sizeof(UUID), nbytes - i));
+  }
 
   return Status::Ok();
 }
 
 #else
 
-/**
- * Generate a UUID using OpenSSL.
- *
- * Initially from: https://gist.github.com/kvelakur/9069c9896577c3040030
- * "Generating a Version 4 UUID using OpenSSL"
- */
-Status generate_uuid_openssl(std::string* uuid_str) {
-  if (uuid_str == nullptr)
-    return Status_UtilsError("Null UUID string argument");
-
-  union {
-    struct {
-      uint32_t time_low;
-      uint16_t time_mid;
-      uint16_t time_hi_and_version;
-      uint8_t clk_seq_hi_res;
-      uint8_t clk_seq_low;
-      uint8_t node[6];
-    };
-    uint8_t __rnd[16];
-  } uuid;
-
-  int rc = RAND_bytes(uuid.__rnd, sizeof(uuid));
+/** Generate random bytes using OpenSSL. */
+Status random_bytes_openssl(uint8_t* bytes, size_t nbytes) {
+  int rc = RAND_bytes(bytes, static_cast<int>(nbytes));
   if (rc < 1) {
     char err_msg[256];
     ERR_error_string_n(ERR_get_error(), err_msg, sizeof(err_msg));
@@ -113,61 +86,101 @@ Status generate_uuid_openssl(std::string* uuid_str) {
         "Cannot generate random bytes with OpenSSL: " + std::string(err_msg));
   }
 
-  // Refer Section 4.2 of RFC-4122
-  // https://tools.ietf.org/html/rfc4122#section-4.2
-  uuid.clk_seq_hi_res = (uint8_t)((uuid.clk_seq_hi_res & 0x3F) | 0x80);
-  uuid.time_hi_and_version =
-      (uint16_t)((uuid.time_hi_and_version & 0x0FFF) | 0x4000);
-
-  // Format the UUID as a string.
-  char buf[128];
-  rc = snprintf(
-      buf,
-      sizeof(buf),
-      "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-      uuid.time_low,
-      uuid.time_mid,
-      uuid.time_hi_and_version,
-      uuid.clk_seq_hi_res,
-      uuid.clk_seq_low,
-      uuid.node[0],
-      uuid.node[1],
-      uuid.node[2],
-      uuid.node[3],
-      uuid.node[4],
-      uuid.node[5]);
-
-  if (rc < 0)
-    return Status_UtilsError("Error formatting UUID string");
-
-  *uuid_str = std::string(buf);
-
   return Status::Ok();
 }
 
 #endif
 
-Status generate_uuid(std::string* uuid, bool hyphenate) {
-  if (uuid == nullptr)
-    return Status_UtilsError("Null UUID string argument");
+/**
+ * The UUID generator of a thread. It is seeded once from the random source
+ * of the platform, which is shared and needs the lock, and then generates
+ * the UUIDs of the thread without it.
+ */
+class ThreadUUIDGenerator {
+ public:
+  /**
+   * Generates the random bits of a version 4 UUID.
+   *
+   * @param uuid Set to the 16 bytes of the UUID.
+   * @return Status
+   */
+  Status generate(uint8_t* uuid) {
+#ifndef _WIN32
+    // A forked child would otherwise repeat the UUIDs of its parent.
+    if (seeded_ && pid_ != getpid())
+      seeded_ = false;
+#endif
+    if (!seeded_)
+      RETURN_NOT_OK(seed());
+
+    const uint64_t hi = rng_(), lo = rng_();
+    for (int i = 0; i < 8; ++i) {
+      uuid[i] = static_cast<uint8_t>(hi >> (56 - 8 * i));
+      uuid[8 + i] = static_cast<uint8_t>(lo >> (56 - 8 * i));
+    }
+
+    // Refer Section 4.4 of RFC-4122
+    // https://tools.ietf.org/html/rfc4122#section-4.4
+    uuid[6] = (uint8_t)((uuid[6] & 0x0F) | 0x40);
+    uuid[8] = (uint8_t)((uuid[8] & 0x3F) | 0x80);
+
+    return Status::Ok();
+  }
+
+ private:
+  /** Whether `rng_` was seeded. */
+  bool seeded_ = false;
+
+#ifndef _WIN32
+  /** The process in which `rng_` was seeded. */
+  pid_t pid_ = 0;
+#endif
 
-  std::string uuid_str;
-  {
-    // OpenSSL is not threadsafe, so grab a lock here. We are locking in the
-    // Windows case as well just to be careful.
-    std::unique_lock<std::mutex> lck(uuid_mtx);
+  /** The random generator. */
+  std::mt19937_64 rng_;
+
+  /** Seeds `rng_` with the random source of the platform. */
+  Status seed() {
+    uint32_t seed[8];
+    {
+      // OpenSSL is not threadsafe, so grab a lock here. We are locking in the
+      // Windows case as well just to be careful.
+      std::unique_lock<std::mutex> lck(uuid_mtx);
 #ifdef _WIN32
-    RETURN_NOT_OK(generate_uuid_win32(&uuid_str));
+      RETURN_NOT_OK(
+          random_bytes_win32(reinterpret_cast<uint8_t*>(seed), sizeof(seed)));
 #else
-    RETURN_NOT_OK(generate_uuid_openssl(&uuid_str));
+      RETURN_NOT_OK(random_bytes_openssl(
+          reinterpret_cast<uint8_t*>(seed), sizeof(seed)));
+      pid_ = getpid();
 #endif
+    }
+
+    std::seed_seq seq(std::begin(seed), std::end(seed));
+    rng_.seed(seq);
+    seeded_ = true;
+
+    return Status::Ok();
   }
+};
 
+Status generate_uuid(std::string* uuid, bool hyphenate) {
+  if (uuid == nullptr)
+    return Status_UtilsError("Null UUID string argument");
+
+  static thread_local ThreadUUIDGenerator generator;
+  uint8_t bytes[16];
+  RETURN_NOT_OK(generator.generate(bytes));
+
+  // Format the UUID as a string.
+  static const char digits[] = "0123456789abcdef";
   uuid->clear();
-  for (unsigned i = 0; i < uuid_str.length(); i++) {
-    if (uuid_str[i] == '-' && !hyphenate)
-      continue;
-    uuid->push_back(uuid_str[i]);
+  uuid->reserve(36);
+  for (int i = 0; i < 16; i++) {
+    if (hyphenate && (i == 4 || i == 6 || i == 8 || i == 10))
+      uuid->push_back('-');
+    uuid->push_back(digits[bytes[i] >> 4]);
+    uuid->push_back(digits[bytes[i] & 0x0F]);
   }
 
   return Status::Ok();
@@ -43,8 +43,10 @@ namespace uuid {
 
 /**
  * Generates a 128-bit UUID. The string is formatted with hyphens like:
- * 'xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxx' where 'x' is a hexadecimal digit.
- * Note: this function internally acquires a lock.
+ * 'xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx' where 'x' is a hexadecimal digit.
+ * The UUIDs are random (version 4), generated by a per-thread generator
+ * that is seeded from the random source of the platform on its first use,
+ * which acquires a lock.
  *
  * @param uuid Output parameter which will store the UUID in string format.
  * @param hyphenate If false, the UUID string will not be hyphenated.
@@ -40,12 +40,15 @@
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/dense_reader.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/result_tile.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/subarray/cell_slab_iter.h"
 #include "tiledb/sm/subarray/subarray.h"
 
+#include <unordered_set>
+
 using namespace tiledb;
 using namespace tiledb::common;
 using namespace tiledb::sm::stats;
@@ -101,7 +104,7 @@ Status DenseReader::init() {
   if (array_schema_ == nullptr)
     return LOG_STATUS(Status_DenseReaderError(
         "Cannot initialize dense reader; Array schema not set"));
-  if (buffers_.empty())
+  if (buffers_.empty() && !has_aggregates())
     return LOG_STATUS(Status_DenseReaderError(
         "Cannot initialize dense reader; Buffers not set"));
   if (!subarray_.is_set())
@@ -187,6 +190,23 @@ Status DenseReader::dowork() {
 void DenseReader::reset() {
 }
 
+Status DenseReader::rebind() {
+  if (!subarray_.is_set())
+    return LOG_STATUS(Status_ReaderError(
+        "Cannot rebind reader; Dense reads must have a subarray set"));
+
+  // Only the read state depends on the subarray.
+  RETURN_NOT_OK(check_subarray());
+  RETURN_NOT_OK(init_read_state());
+  RETURN_NOT_OK(check_validity_buffer_sizes());
+
+  return Status::Ok();
+}
+
+void DenseReader::set_progress(QueryProgress* progress) {
+  progress_ = progress;
+}
+
 template <class OffType>
 Status DenseReader::dense_read() {
   auto type = array_schema_->domain()->dimension(0)->type();
@@ -299,6 +319,16 @@ Status DenseReader::dense_read() {
     }
   }
 
+  // Aggregate mode, fold the tiles into the aggregates instead of copying.
+  if (has_aggregates()) {
+    return dense_aggregate<DimType, OffType>(
+        subarray,
+        tile_subarrays,
+        tile_offsets,
+        range_offsets,
+        result_space_tiles);
+  }
+
   // Compute attribute names to load and copy.
   std::vector<std::string> names;
   std::vector<std::string> fixed_names;
@@ -326,17 +356,28 @@ Status DenseReader::dense_read() {
     }
   }
 
+  // Skip the tiles excluded by the query condition tile metadata.
+  RETURN_CANCEL_OR_ERROR(
+      skip_qc_tiles<DimType>(result_space_tiles, result_tiles));
+
   // Pre-load all attribute offsets into memory for attributes
   // in query condition to be read.
   RETURN_CANCEL_OR_ERROR(
       load_tile_offsets(read_state_.partitioner_.subarray(), names));
 
-  // Read and unfilter tiles.
-  RETURN_CANCEL_OR_ERROR(read_attribute_tiles(names, result_tiles));
+  // Unfilter the tiles copied verbatim directly into the user buffers.
+  RETURN_NOT_OK(compute_unfilter_dests<DimType>(
+      fixed_names,
+      subarray,
+      tile_subarrays,
+      tile_offsets,
+      range_offsets,
+      result_space_tiles));
 
-  for (const auto& name : names) {
-    RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, result_tiles));
-  }
+  // Read and unfilter tiles, overlapping the reads with the unfiltering.
+  status = read_and_unfilter_attribute_tiles(names, result_tiles);
+  unfilter_dests_.clear();
+  RETURN_CANCEL_OR_ERROR(status);
 
   // Compute the result of the query condition.
   auto&& [st, qc_result] = apply_query_condition<DimType, OffType>(
@@ -372,6 +413,324 @@ Status DenseReader::dense_read() {
   return Status::Ok();
 }
 
+template <class DimType, class OffType>
+Status DenseReader::dense_aggregate(
+    Subarray& subarray,
+    std::vector<Subarray>& tile_subarrays,
+    std::vector<uint64_t>& tile_offsets,
+    const std::vector<uint64_t>& range_offsets,
+    std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles) {
+  auto timer_se = stats_->start_timer("dense_aggregate");
+
+  // For easy reference.
+  const auto& tile_coords = subarray.tile_coords();
+  const auto dim_num = array_schema_->dim_num();
+  const auto domain = array_schema_->domain();
+  const auto cell_order = array_schema_->cell_order();
+  const auto cell_num_per_tile = domain->cell_num_per_tile();
+  const auto global_order = layout_ == Layout::GLOBAL_ORDER;
+  auto stride = domain->stride<DimType>(layout_);
+  if (stride == UINT64_MAX) {
+    stride = 1;
+  }
+
+  // A space tile is answered from the tile metadata when it is fully covered
+  // by the subarray and by a single fragment, and there is no query
+  // condition. Dense fragments write full tiles, so the tile metadata of a
+  // fragment that only partially covers the space tile includes the fill
+  // values outside of its non-empty domain.
+  std::vector<std::pair<unsigned, uint64_t>> metadata_tiles;
+  std::vector<uint64_t> data_tile_idx;
+  std::vector<ResultTile*> result_tiles;
+  for (uint64_t t = 0; t < tile_coords.size(); t++) {
+    auto it = result_space_tiles.find((const DimType*)&tile_coords[t][0]);
+    assert(it != result_space_tiles.end());
+    const auto& frag_domains = it->second.frag_domains();
+
+    if (condition_.empty() && frag_domains.size() == 1 &&
+        tile_subarrays[t].range_num() == 1 &&
+        tile_subarrays[t].cell_num() == cell_num_per_tile &&
+        aggregates_have_tile_metadata(frag_domains[0].first) &&
+        covers_space_tile<DimType>(
+            frag_domains[0].second, it->second.start_coords())) {
+      const auto frag_idx = frag_domains[0].first;
+      metadata_tiles.emplace_back(
+          frag_idx, it->second.result_tile(frag_idx)->tile_idx());
+      continue;
+    }
+
+    data_tile_idx.emplace_back(t);
+    for (const auto& result_tile : it->second.result_tiles()) {
+      result_tiles.push_back(const_cast<ResultTile*>(&result_tile.second));
+    }
+  }
+
+  if (!metadata_tiles.empty()) {
+    RETURN_CANCEL_OR_ERROR(
+        load_tile_aggregate_metadata(read_state_.partitioner_.subarray()));
+    RETURN_NOT_OK(aggregate_tiles_metadata(metadata_tiles));
+  }
+
+  if (data_tile_idx.empty()) {
+    return Status::Ok();
+  }
+
+  // Read and unfilter the tiles for the query condition and the aggregated
+  // fields.
+  std::vector<std::string> names;
+  auto condition_names = condition_.field_names();
+  for (auto& name : condition_names) {
+    names.emplace_back(name);
+  }
+
+  for (auto& name : aggregate_field_names()) {
+    if (condition_names.count(name) == 0) {
+      names.emplace_back(name);
+    }
+  }
+
+  RETURN_CANCEL_OR_ERROR(
+      skip_qc_tiles<DimType>(result_space_tiles, result_tiles));
+  RETURN_CANCEL_OR_ERROR(
+      load_tile_offsets(read_state_.partitioner_.subarray(), names));
+  RETURN_CANCEL_OR_ERROR(
+      read_and_unfilter_attribute_tiles(names, result_tiles));
+
+  // Compute the result of the query condition.
+  auto&& [st, qc_result] = apply_query_condition<DimType, OffType>(
+      subarray,
+      tile_subarrays,
+      tile_offsets,
+      range_offsets,
+      result_space_tiles);
+  RETURN_CANCEL_OR_ERROR(st);
+  const auto& qc = *qc_result;
+
+  // Compute the bitmap of the cells to aggregate for each result tile. Each
+  // cell is taken from the most recent fragment that wrote it, cells that
+  // were not written by any fragment do not contribute.
+  std::vector<std::vector<std::vector<uint64_t>>> bitmaps(
+      data_tile_idx.size());
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, data_tile_idx.size(), [&](uint64_t i) {
+        const auto t = data_tile_idx[i];
+        const DimType* tc = (DimType*)&tile_coords[t][0];
+        auto it = result_space_tiles.find(tc);
+        const auto& frag_domains = it->second.frag_domains();
+        auto& tile_bitmaps = bitmaps[i];
+        tile_bitmaps.resize(frag_domains.size());
+
+        uint64_t cell_offset = global_order ? tile_offsets[t] : 0;
+        std::vector<uint8_t> claimed;
+
+        // Iterate over all coordinates, retrieved in cell slab.
+        CellSlabIter<DimType> iter(&tile_subarrays[t]);
+        RETURN_NOT_OK(iter.begin());
+        while (!iter.end()) {
+          auto cell_slab = iter.cell_slab();
+
+          // Compute the query condition offset for row/col major orders.
+          if (!global_order) {
+            cell_offset = get_dest_cell_offset_row_col(
+                dim_num,
+                subarray,
+                tile_subarrays[t],
+                cell_slab.coords_.data(),
+                iter.range_coords(),
+                range_offsets);
+          }
+
+          // Get the source cell offset.
+          uint64_t src_cell = get_cell_pos_in_tile(
+              cell_order, dim_num, domain, it->second, cell_slab.coords_.data());
+
+          claimed.assign(cell_slab.length_, 0);
+          for (uint64_t f = 0; f < frag_domains.size(); f++) {
+            auto&& [overlaps, start, end] = cell_slab_overlaps_range(
+                dim_num,
+                frag_domains[f].second,
+                cell_slab.coords_.data(),
+                cell_slab.length_);
+            if (!overlaps) {
+              continue;
+            }
+
+            auto& bitmap = tile_bitmaps[f];
+            for (uint64_t c = start; c <= end; c++) {
+              if (claimed[c]) {
+                continue;
+              }
+
+              claimed[c] = 1;
+              if (!qc.empty() && qc[cell_offset + c] == 0) {
+                continue;
+              }
+
+              if (bitmap.empty()) {
+                bitmap.resize(cell_num_per_tile, 0);
+              }
+              bitmap[src_cell + c * stride]++;
+            }
+          }
+
+          // Adjust the query condition offset for global order.
+          if (global_order) {
+            cell_offset += cell_slab.length_;
+          }
+
+          ++iter;
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  // Fold the result tiles with at least one cell to aggregate.
+  std::vector<ResultTile*> data_tiles;
+  std::vector<const std::vector<uint64_t>*> data_bitmaps;
+  for (uint64_t i = 0; i < data_tile_idx.size(); i++) {
+    const DimType* tc = (DimType*)&tile_coords[data_tile_idx[i]][0];
+    auto it = result_space_tiles.find(tc);
+    const auto& frag_domains = it->second.frag_domains();
+    for (uint64_t f = 0; f < frag_domains.size(); f++) {
+      if (bitmaps[i][f].empty()) {
+        continue;
+      }
+
+      data_tiles.emplace_back(it->second.result_tile(frag_domains[f].first));
+      data_bitmaps.emplace_back(&bitmaps[i][f]);
+    }
+  }
+
+  RETURN_NOT_OK(aggregate_tiles<uint64_t>(data_tiles, data_bitmaps));
+
+  for (const auto& name : names) {
+    clear_tiles(name, result_tiles);
+  }
+
+  return Status::Ok();
+}
+
+template <class DimType>
+Status DenseReader::compute_unfilter_dests(
+    const std::vector<std::string>& names,
+    const Subarray& subarray,
+    const std::vector<Subarray>& tile_subarrays,
+    const std::vector<uint64_t>& tile_offsets,
+    const std::vector<uint64_t>& range_offsets,
+    std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles) {
+  unfilter_dests_.clear();
+
+  // Tiles are copied verbatim only without a query condition, and when the
+  // subarray cells are laid out in the tile cell order.
+  const auto global_order = layout_ == Layout::GLOBAL_ORDER;
+  if (names.empty() || !condition_.empty() ||
+      (!global_order && (layout_ != array_schema_->cell_order() ||
+                         subarray.range_num() != 1))) {
+    return Status::Ok();
+  }
+
+  // The tiles are unfiltered before the user buffer sizes are checked, so
+  // they must hold the results of the whole subarray.
+  const auto cell_num = subarray.cell_num();
+  for (const auto& name : names) {
+    const auto& buffer = buffers_[name];
+    if (cell_num * array_schema_->cell_size(name) > *buffer.buffer_size_ ||
+        (array_schema_->is_nullable(name) &&
+         cell_num > *buffer.validity_vector_.buffer_size())) {
+      return Status::Ok();
+    }
+  }
+
+  const auto dim_num = array_schema_->dim_num();
+  const auto domain = array_schema_->domain();
+  const auto cell_num_per_tile = domain->cell_num_per_tile();
+  const unsigned slowest_dim = layout_ == Layout::COL_MAJOR ? dim_num - 1 : 0;
+  const std::vector<DimType> range_coords(dim_num, 0);
+  const auto& tile_coords = subarray.tile_coords();
+  for (uint64_t t = 0; t < tile_coords.size(); t++) {
+    auto it = result_space_tiles.find((const DimType*)&tile_coords[t][0]);
+    assert(it != result_space_tiles.end());
+    auto& result_space_tile = it->second;
+    const auto& frag_domains = result_space_tile.frag_domains();
+    const auto& start_coords = result_space_tile.start_coords();
+    if (frag_domains.size() != 1 || tile_subarrays[t].range_num() != 1 ||
+        tile_subarrays[t].cell_num() != cell_num_per_tile ||
+        !covers_space_tile<DimType>(frag_domains[0].second, start_coords)) {
+      continue;
+    }
+
+    // Compute the offset of the tile cells in the user buffers. For row or
+    // col-major, the tile must span the subarray on all dimensions but the
+    // slowest varying one for its cells to be contiguous.
+    uint64_t cell_offset = 0;
+    if (global_order) {
+      cell_offset = tile_offsets[t];
+    } else {
+      bool contiguous = true;
+      for (unsigned d = 0; d < dim_num && contiguous; d++) {
+        auto range = (const DimType*)subarray.ranges_for_dim(d)[0].data();
+        auto tile_extent = *(const DimType*)domain->tile_extent(d).data();
+        contiguous = d == slowest_dim ||
+                     (range[0] == start_coords[d] &&
+                      range[1] == (DimType)(start_coords[d] + tile_extent - 1));
+      }
+
+      if (!contiguous) {
+        continue;
+      }
+
+      cell_offset = get_dest_cell_offset_row_col(
+          dim_num,
+          subarray,
+          tile_subarrays[t],
+          start_coords.data(),
+          range_coords.data(),
+          range_offsets);
+    }
+
+    const auto frag_idx = frag_domains[0].first;
+    const auto fragment = fragment_metadata_[frag_idx];
+    const ResultTile* result_tile = result_space_tile.result_tile(frag_idx);
+    for (const auto& name : names) {
+      // Attributes added by schema evolution are filled instead.
+      const auto cell_size = array_schema_->cell_size(name);
+      if (!fragment->array_schema()->is_field(name) ||
+          fragment->tile_size(name, result_tile->tile_idx()) !=
+              cell_num_per_tile * cell_size) {
+        continue;
+      }
+
+      auto& buffer = buffers_[name];
+      void* validity = array_schema_->is_nullable(name) ?
+                           buffer.validity_vector_.buffer() + cell_offset :
+                           nullptr;
+      unfilter_dests_[{result_tile, name}] = {
+          (uint8_t*)buffer.buffer_ + cell_offset * cell_size, validity};
+    }
+  }
+
+  stats_->add_counter("unfilter_in_place_num", unfilter_dests_.size());
+
+  return Status::Ok();
+}
+
+template <class DimType>
+bool DenseReader::covers_space_tile(
+    const NDRange& ndrange, const std::vector<DimType>& start_coords) {
+  const auto domain = array_schema_->domain();
+  for (unsigned d = 0; d < array_schema_->dim_num(); ++d) {
+    auto dom = (const DimType*)ndrange[d].data();
+    auto tile_extent = *(const DimType*)domain->tile_extent(d).data();
+    if (dom[0] > start_coords[d] ||
+        dom[1] < (DimType)(start_coords[d] + tile_extent - 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 Status DenseReader::init_read_state() {
   auto timer_se = stats_->start_timer("init_state");
 
@@ -384,19 +743,12 @@ Status DenseReader::init_read_state() {
                            "support global order"));
 
   // Get config values.
-  bool found = false;
-  uint64_t memory_budget = 0;
-  RETURN_NOT_OK(
-      config_.get<uint64_t>("sm.memory_budget", &memory_budget, &found));
-  assert(found);
-
-  uint64_t memory_budget_var = 0;
-  RETURN_NOT_OK(config_.get<uint64_t>(
-      "sm.memory_budget_var", &memory_budget_var, &found));
-  assert(found);
-
-  offsets_format_mode_ = config_.get("sm.var_offsets.mode", &found);
-  assert(found);
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  uint64_t memory_budget = config->memory_budget;
+  uint64_t memory_budget_var = config->memory_budget_var;
+
+  offsets_format_mode_ = config->var_offsets_mode;
   if (offsets_format_mode_ != "bytes" && offsets_format_mode_ != "elements") {
     return LOG_STATUS(
         Status_ReaderError("Cannot initialize reader; Unsupported offsets "
@@ -404,18 +756,14 @@ Status DenseReader::init_read_state() {
   }
   elements_mode_ = offsets_format_mode_ == "elements";
 
-  RETURN_NOT_OK(config_.get<bool>(
-      "sm.var_offsets.extra_element", &offsets_extra_element_, &found));
-  assert(found);
+  offsets_extra_element_ = config->var_offsets_extra_element;
 
-  RETURN_NOT_OK(config_.get<uint32_t>(
-      "sm.var_offsets.bitsize", &offsets_bitsize_, &found));
+  offsets_bitsize_ = config->var_offsets_bitsize;
   if (offsets_bitsize_ != 32 && offsets_bitsize_ != 64) {
     return LOG_STATUS(
         Status_ReaderError("Cannot initialize reader; Unsupported offsets "
                            "bitsize in configuration"));
   }
-  assert(found);
 
   // Consider the validity memory budget to be identical to `sm.memory_budget`
   // because the validity vector is currently a bytemap. When converted to a
@@ -470,6 +818,48 @@ Status DenseReader::init_read_state() {
   return Status::Ok();
 }
 
+template <class DimType>
+Status DenseReader::skip_qc_tiles(
+    std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles,
+    std::vector<ResultTile*>& result_tiles) {
+  if (condition_.empty()) {
+    return Status::Ok();
+  }
+
+  RETURN_CANCEL_OR_ERROR(
+      load_tile_condition_metadata(read_state_.partitioner_.subarray()));
+
+  auto&& [st, skipped] = compute_qc_skipped_tiles(result_tiles);
+  RETURN_NOT_OK(st);
+
+  std::unordered_set<const ResultTile*> skipped_tiles;
+  uint64_t current = 0;
+  for (uint64_t t = 0; t < result_tiles.size(); t++) {
+    if ((*skipped)[t]) {
+      skipped_tiles.insert(result_tiles[t]);
+    } else {
+      result_tiles[current++] = result_tiles[t];
+    }
+  }
+  result_tiles.resize(current);
+
+  if (skipped_tiles.empty()) {
+    return Status::Ok();
+  }
+
+  // Mark the skipped tiles in their result space tile, all cells they cover
+  // will fail the query condition.
+  for (auto& result_space_tile : result_space_tiles) {
+    for (const auto& result_tile : result_space_tile.second.result_tiles()) {
+      if (skipped_tiles.count(&result_tile.second) != 0) {
+        result_space_tile.second.set_qc_skipped(result_tile.first);
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
 /** Apply the query condition. */
 template <class DimType, class OffType>
 std::tuple<Status, std::optional<std::vector<uint8_t>>>
@@ -481,6 +871,8 @@ DenseReader::apply_query_condition(
     std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles) {
   std::vector<uint8_t> qc_result;
   if (!condition_.clauses().empty()) {
+    set_progress_phase(QueryPhase::PROCESS_TILES);
+
     // For easy reference.
     const auto& tile_coords = subarray.tile_coords();
     const auto cell_num = subarray.cell_num();
@@ -544,6 +936,13 @@ DenseReader::apply_query_condition(
                   cell_slab.coords_.data(),
                   cell_slab.length_);
               if (overlaps) {
+                // Skipped tiles are not loaded, none of their cells satisfy
+                // the condition.
+                if (it->second.qc_skipped(frag_domains[i].first)) {
+                  std::memset(dest_ptr + start, 0, end - start + 1);
+                  continue;
+                }
+
                 RETURN_NOT_OK(condition_.apply_dense(
                     fragment_metadata_[frag_domains[i].first]->array_schema(),
                     it->second.result_tile(frag_domains[i].first),
@@ -618,6 +1017,8 @@ Status DenseReader::read_attributes(
     const std::vector<uint64_t>& range_offsets,
     std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles,
     const std::vector<uint8_t>& qc_result) {
+  set_progress_phase(QueryPhase::COPY_RESULTS);
+
   // For easy reference
   const auto& tile_coords = subarray.tile_coords();
   const auto cell_num = subarray.cell_num();
@@ -961,8 +1362,13 @@ Status DenseReader::copy_fixed_tiles(
           frag_domains[fd].second,
           cell_slab.coords_.data(),
           cell_slab.length_);
+
+      // Tiles skipped by the query condition are not loaded, their cells are
+      // filled below.
+      const bool qc_skipped =
+          result_space_tile.qc_skipped(frag_domains[fd].first);
       if (overlaps) {
-        for (uint64_t n = 0; n < names.size(); n++) {
+        for (uint64_t n = 0; !qc_skipped && n < names.size(); n++) {
           // Calculate the destination pointers.
           const auto cell_size = cell_sizes[n];
           auto dest_ptr = dst_bufs[n] + cell_offset * cell_size;
@@ -979,18 +1385,20 @@ Status DenseReader::copy_fixed_tiles(
           auto src_offset = src_cell + start * stride;
 
           // If the subarray and tile are in the same order, copy the whole
-          // slab.
+          // slab, unless the tile was unfiltered in place.
           if (stride == 1) {
-            std::memcpy(
-                dest_ptr + cell_size * start,
-                tile->data_as<char>() + cell_size * src_offset,
-                cell_size * (end - start + 1));
+            auto src = tile->data_as<char>() + cell_size * src_offset;
+            auto dest = dest_ptr + cell_size * start;
+            if (src != (char*)dest) {
+              std::memcpy(dest, src, cell_size * (end - start + 1));
+            }
 
             if (attributes[n]->nullable()) {
-              std::memcpy(
-                  dest_validity_ptr + start,
-                  tile_nullable->data_as<char>() + src_offset,
-                  (end - start + 1));
+              auto src_validity = tile_nullable->data_as<char>() + src_offset;
+              auto dest_validity = dest_validity_ptr + start;
+              if (src_validity != (char*)dest_validity) {
+                std::memcpy(dest_validity, src_validity, (end - start + 1));
+              }
             }
           } else {
             // Go cell by cell.
@@ -1164,8 +1572,13 @@ Status DenseReader::copy_offset_tiles(
           frag_domains[fd].second,
           cell_slab.coords_.data(),
           cell_slab.length_);
+
+      // Tiles skipped by the query condition are not loaded, their cells are
+      // filled below.
+      const bool qc_skipped =
+          result_space_tile.qc_skipped(frag_domains[fd].first);
       if (overlaps) {
-        for (uint64_t n = 0; n < names.size(); n++) {
+        for (uint64_t n = 0; !qc_skipped && n < names.size(); n++) {
           // Calculate the destination pointers.
           auto dest_ptr = dst_bufs[n] + cell_offset * sizeof(OffType);
           auto var_data_buff = var_data[n].data() + cell_offset;
@@ -113,6 +113,12 @@ class DenseReader : public ReaderBase, public IQueryStrategy {
   /** Resets the reader object. */
   void reset();
 
+  /** Prepares the reader to run again over a new subarray. */
+  Status rebind();
+
+  /** Sets the progress to update as the query is processed. */
+  void set_progress(QueryProgress* progress);
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -142,6 +148,17 @@ class DenseReader : public ReaderBase, public IQueryStrategy {
   /** Initializes the read state. */
   Status init_read_state();
 
+  /**
+   * Skip the result tiles that cannot contain a cell satisfying the query
+   * condition, using the tile metadata. Skipped tiles are marked in their
+   * result space tile and removed from `result_tiles` so that they are not
+   * read.
+   */
+  template <class DimType>
+  Status skip_qc_tiles(
+      std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles,
+      std::vector<ResultTile*>& result_tiles);
+
   /** Apply the query condition. */
   template <class DimType, class OffType>
   std::tuple<Status, std::optional<std::vector<uint8_t>>> apply_query_condition(
@@ -151,6 +168,50 @@ class DenseReader : public ReaderBase, public IQueryStrategy {
       const std::vector<uint64_t>& range_offsets,
       std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles);
 
+  /**
+   * Fold the result space tiles into the aggregates. Space tiles fully
+   * covered by the subarray and by a single fragment are answered from the
+   * tile metadata, the others are read and unfiltered.
+   */
+  template <class DimType, class OffType>
+  Status dense_aggregate(
+      Subarray& subarray,
+      std::vector<Subarray>& tile_subarrays,
+      std::vector<uint64_t>& tile_offsets,
+      const std::vector<uint64_t>& range_offsets,
+      std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles);
+
+  /**
+   * Computes the user buffer regions that fixed-sized attribute tiles can be
+   * unfiltered into directly, storing them in `unfilter_dests_`. This is the
+   * case for tiles fully covered by the subarray and by a single fragment,
+   * whose cells are contiguous and in the same order in the user buffers.
+   *
+   * @param names The fixed-sized attribute names.
+   * @param subarray The subarray of the current partition.
+   * @param tile_subarrays The subarray of each space tile.
+   * @param tile_offsets The cell offset of each space tile for global order.
+   * @param range_offsets The cell offset of each range for row/col-major.
+   * @param result_space_tiles The result space tiles.
+   * @return Status
+   */
+  template <class DimType>
+  Status compute_unfilter_dests(
+      const std::vector<std::string>& names,
+      const Subarray& subarray,
+      const std::vector<Subarray>& tile_subarrays,
+      const std::vector<uint64_t>& tile_offsets,
+      const std::vector<uint64_t>& range_offsets,
+      std::map<const DimType*, ResultSpaceTile<DimType>>& result_space_tiles);
+
+  /**
+   * Returns true if the fragment domain covers the whole space tile starting
+   * at `start_coords`.
+   */
+  template <class DimType>
+  bool covers_space_tile(
+      const NDRange& ndrange, const std::vector<DimType>& start_coords);
+
   /** Fix offsets buffer after reading all offsets. */
   template <class OffType>
   uint64_t fix_offsets_buffer(
@@ -78,6 +78,7 @@ DenseTiler<T>::DenseTiler(
   calculate_subarray_tile_coord_strides();
   calculate_first_sub_tile_coords();
   calculate_tile_and_subarray_strides();
+  calculate_copy_plans();
 }
 
 template <class T>
@@ -93,96 +94,9 @@ const typename DenseTiler<T>::CopyPlan DenseTiler<T>::copy_plan(
     uint64_t id) const {
   assert(id < tile_num_);
 
-  // For easy reference
-  CopyPlan ret;
-  auto dim_num = (int32_t)array_schema_->dim_num();
-  auto domain = array_schema_->domain();
-  auto subarray = subarray_->ndrange(0);  // Guaranteed to be unary
-  std::vector<std::array<T, 2>> sub(dim_num);
-  for (int32_t d = 0; d < dim_num; ++d)
-    sub[d] = {*(const T*)subarray[d].start(), *(const T*)subarray[d].end()};
-  auto tile_layout = array_schema_->cell_order();
-  auto sub_layout = subarray_->layout();
-
-  // Copy tile and subarray strides
-  ret.tile_strides_el_ = tile_strides_el_;
-  ret.sub_strides_el_ = sub_strides_el_;
-
-  // Focus on the input tile
-  auto tile_sub = this->tile_subarray(id);
-  auto sub_in_tile = utils::geometry::intersection<T>(sub, tile_sub);
-
-  // Compute the starting element to copy from in the subarray, and
-  // to copy to in the tile
-  ret.sub_start_el_ = 0;
-  ret.tile_start_el_ = 0;
-  for (int32_t d = 0; d < dim_num; ++d) {
-    ret.sub_start_el_ += (sub_in_tile[d][0] - sub[d][0]) * sub_strides_el_[d];
-    ret.tile_start_el_ +=
-        (sub_in_tile[d][0] - tile_sub[d][0]) * tile_strides_el_[d];
-  }
-
-  // Calculate the copy elements per iteration, as well as the
-  // dimension ranges to focus on
-  if (dim_num == 1) {  // Special case, copy the entire subarray 1D range
-    ret.dim_ranges_.push_back({0, 0});
-    ret.copy_el_ = sub_in_tile[0][1] - sub_in_tile[0][0] + 1;
-    ret.first_d_ = 0;
-  } else if (sub_layout != tile_layout) {
-    ret.copy_el_ = 1;
-    ret.first_d_ = 0;
-    for (int32_t d = 0; d < dim_num; ++d) {
-      ret.dim_ranges_.push_back(
-          {(uint64_t)0, uint64_t(sub_in_tile[d][1] - sub_in_tile[d][0])});
-    }
-  } else {  // dim_num > 1 && same layout of tile and subarray cells
-    if (tile_layout == Layout::ROW_MAJOR) {
-      ret.copy_el_ =
-          sub_in_tile[dim_num - 1][1] - sub_in_tile[dim_num - 1][0] + 1;
-      int32_t last_d = dim_num - 2;
-      for (; last_d >= 0; --last_d) {
-        auto tile_extent = *(const T*)domain->tile_extent(last_d + 1).data();
-        if (sub_in_tile[last_d + 1][1] - sub_in_tile[last_d + 1][0] + 1 ==
-                tile_extent &&
-            sub_in_tile[last_d + 1][0] == sub[last_d + 1][0] &&
-            sub_in_tile[last_d + 1][1] == sub[last_d + 1][1])
-          ret.copy_el_ *= sub_in_tile[last_d][1] - sub_in_tile[last_d][0] + 1;
-        else
-          break;
-      }
-      if (last_d < 0) {
-        ret.dim_ranges_.push_back({0, 0});
-      } else {
-        for (int32_t d = 0; d <= last_d; ++d)
-          ret.dim_ranges_.push_back(
-              {0, (uint64_t)(sub_in_tile[d][1] - sub_in_tile[d][0])});
-      }
-      ret.first_d_ = 0;
-    } else {  // COL_MAJOR
-      ret.copy_el_ = sub_in_tile[0][1] - sub_in_tile[0][0] + 1;
-      int32_t last_d = 1;
-      for (; last_d < dim_num; ++last_d) {
-        auto tile_extent = *(const T*)domain->tile_extent(last_d - 1).data();
-        if (sub_in_tile[last_d - 1][1] - sub_in_tile[last_d - 1][0] + 1 ==
-                tile_extent &&
-            sub_in_tile[last_d - 1][0] == sub[last_d - 1][0] &&
-            sub_in_tile[last_d - 1][1] == sub[last_d - 1][1])
-          ret.copy_el_ *= sub_in_tile[last_d][1] - sub_in_tile[last_d][0] + 1;
-        else
-          break;
-      }
-      if (last_d == dim_num) {
-        ret.dim_ranges_.push_back({0, 0});
-        ret.first_d_ = dim_num - 1;
-      } else {
-        for (int32_t d = last_d; d < dim_num; ++d)
-          ret.dim_ranges_.push_back(
-              {0, (uint64_t)(sub_in_tile[d][1] - sub_in_tile[d][0])});
-        ret.first_d_ = last_d;
-      }
-    }
-  }
-
+  auto tile_coords_in_sub = this->tile_coords_in_sub(id);
+  CopyPlan ret = copy_plans_.find(copy_plan_idx(tile_coords_in_sub))->second;
+  ret.sub_start_el_ = sub_start_el(tile_coords_in_sub);
   return ret;
 }
 
@@ -286,31 +200,19 @@ Status DenseTiler<T>::get_tile_var(
   auto cell_size = datatype_size(type);
   std::vector<uint8_t> fill_var(sizeof(uint64_t), 0);
 
-  // Initialize position tile
-  WriterTile tile_pos;
-  RETURN_NOT_OK(tile_pos.init_unfiltered(
-      constants::format_version,
-      constants::cell_var_offset_type,
-      tile_off_size,
-      constants::cell_var_offset_size,
-      0));
-
-  // Fill entire tile with MAX_UINT64
-  std::vector<uint64_t> to_write(
-      cell_num_in_tile, std::numeric_limits<uint64_t>::max());
-  RETURN_NOT_OK(tile_pos.write(to_write.data(), 0, tile_off_size));
-  to_write.clear();
-  to_write.shrink_to_fit();
-
-  // Get position tile
+  // Get the position in the buffer of each cell of the tile, in a scratch
+  // vector reused by the thread
+  thread_local std::vector<uint64_t> tile_pos;
+  tile_pos.assign(cell_num_in_tile, std::numeric_limits<uint64_t>::max());
   auto cell_num_in_buff =  // TODO: fix
       (buff_off_size - (offsets_extra_element_ * offsets_bytesize_)) /
       offsets_bytesize_;
-  std::vector<uint64_t> cell_pos(cell_num_in_buff);
-  for (uint64_t i = 0; i < cell_num_in_buff; ++i)
-    cell_pos[i] = i;
-  RETURN_NOT_OK(copy_tile(
-      id, constants::cell_var_offset_size, (uint8_t*)&cell_pos[0], &tile_pos));
+  RETURN_NOT_OK(for_each_copy(
+      id, [&](uint64_t sub_el, uint64_t tile_el, uint64_t el_num) {
+        for (uint64_t i = 0; i < el_num; ++i)
+          tile_pos[tile_el + i] = sub_el + i;
+        return Status::Ok();
+      }));
 
   // Initialize offset and value tiles
   RETURN_NOT_OK(tile_off->init_unfiltered(
@@ -327,12 +229,10 @@ Status DenseTiler<T>::get_tile_var(
       0));
 
   // Copy real offsets and values to the corresponding tiles
-  void* tile_pos_buff_tmp = tile_pos.data();
-  auto tile_pos_buff = (uint64_t*)tile_pos_buff_tmp;
   uint64_t tile_off_offset = 0, offset = 0, val_offset, val_size, pos;
   auto mul = (offsets_format_mode_ == "bytes") ? 1 : cell_size;
   for (uint64_t i = 0; i < cell_num_in_tile; ++i) {
-    pos = tile_pos_buff[i];
+    pos = tile_pos[i];
     RETURN_NOT_OK(tile_off->write(&offset, tile_off_offset, sizeof(offset)));
     tile_off_offset += sizeof(offset);
     if (pos == std::numeric_limits<uint64_t>::max()) {  // Empty
@@ -390,6 +290,51 @@ const std::vector<uint64_t>& DenseTiler<T>::first_sub_tile_coords() const {
 /*          PRIVATE METHODS       */
 /* ****************************** */
 
+template <class T>
+void DenseTiler<T>::calculate_copy_plans() {
+  // For easy reference
+  auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  auto subarray = subarray_->ndrange(0);
+
+  // The positions that exist on each dimension: the first tile, an interior
+  // tile and the last tile of the subarray
+  sub_tile_nums_.resize(dim_num);
+  std::vector<std::vector<uint64_t>> positions(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    sub_tile_nums_[d] = domain->dimension(d)->tile_num(subarray[d]);
+    positions[d].push_back(0);
+    if (sub_tile_nums_[d] > 2)
+      positions[d].push_back(1);
+    if (sub_tile_nums_[d] > 1)
+      positions[d].push_back(2);
+  }
+
+  // Compute the plan of one tile for each combination of positions
+  std::vector<size_t> pos_idx(dim_num, 0);
+  std::vector<uint64_t> tile_coords(dim_num);
+  while (true) {
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto pos = positions[d][pos_idx[d]];
+      tile_coords[d] = (pos == 2) ? sub_tile_nums_[d] - 1 : pos;
+    }
+    uint64_t id = 0;
+    for (unsigned d = 0; d < dim_num; ++d)
+      id += tile_coords[d] * sub_tile_coord_strides_[d];
+    copy_plans_[copy_plan_idx(tile_coords)] = compute_copy_plan(id);
+
+    // Next combination
+    int32_t d = (int32_t)dim_num - 1;
+    for (; d >= 0; --d) {
+      if (++pos_idx[d] < positions[d].size())
+        break;
+      pos_idx[d] = 0;
+    }
+    if (d < 0)
+      break;
+  }
+}
+
 template <class T>
 void DenseTiler<T>::calculate_first_sub_tile_coords() {
   // For easy reference
@@ -503,6 +448,119 @@ void DenseTiler<T>::calculate_tile_num() {
   tile_num_ = array_schema_->domain()->tile_num(subarray_->ndrange(0));
 }
 
+template <class T>
+typename DenseTiler<T>::CopyPlan DenseTiler<T>::compute_copy_plan(
+    uint64_t id) const {
+  assert(id < tile_num_);
+
+  // For easy reference
+  CopyPlan ret;
+  auto dim_num = (int32_t)array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  auto subarray = subarray_->ndrange(0);  // Guaranteed to be unary
+  std::vector<std::array<T, 2>> sub(dim_num);
+  for (int32_t d = 0; d < dim_num; ++d)
+    sub[d] = {*(const T*)subarray[d].start(), *(const T*)subarray[d].end()};
+  auto tile_layout = array_schema_->cell_order();
+  auto sub_layout = subarray_->layout();
+
+  // Copy tile and subarray strides
+  ret.tile_strides_el_ = tile_strides_el_;
+  ret.sub_strides_el_ = sub_strides_el_;
+
+  // Focus on the input tile
+  auto tile_sub = this->tile_subarray(id);
+  auto sub_in_tile = utils::geometry::intersection<T>(sub, tile_sub);
+
+  // Compute the starting element to copy from in the subarray, and
+  // to copy to in the tile
+  ret.sub_start_el_ = 0;
+  ret.tile_start_el_ = 0;
+  for (int32_t d = 0; d < dim_num; ++d) {
+    ret.sub_start_el_ += (sub_in_tile[d][0] - sub[d][0]) * sub_strides_el_[d];
+    ret.tile_start_el_ +=
+        (sub_in_tile[d][0] - tile_sub[d][0]) * tile_strides_el_[d];
+  }
+
+  // Calculate the copy elements per iteration, as well as the
+  // dimension ranges to focus on
+  if (dim_num == 1) {  // Special case, copy the entire subarray 1D range
+    ret.dim_ranges_.push_back({0, 0});
+    ret.copy_el_ = sub_in_tile[0][1] - sub_in_tile[0][0] + 1;
+    ret.first_d_ = 0;
+  } else if (sub_layout != tile_layout) {
+    ret.copy_el_ = 1;
+    ret.first_d_ = 0;
+    for (int32_t d = 0; d < dim_num; ++d) {
+      ret.dim_ranges_.push_back(
+          {(uint64_t)0, uint64_t(sub_in_tile[d][1] - sub_in_tile[d][0])});
+    }
+  } else {  // dim_num > 1 && same layout of tile and subarray cells
+    if (tile_layout == Layout::ROW_MAJOR) {
+      ret.copy_el_ =
+          sub_in_tile[dim_num - 1][1] - sub_in_tile[dim_num - 1][0] + 1;
+      int32_t last_d = dim_num - 2;
+      for (; last_d >= 0; --last_d) {
+        auto tile_extent = *(const T*)domain->tile_extent(last_d + 1).data();
+        if (sub_in_tile[last_d + 1][1] - sub_in_tile[last_d + 1][0] + 1 ==
+                tile_extent &&
+            sub_in_tile[last_d + 1][0] == sub[last_d + 1][0] &&
+            sub_in_tile[last_d + 1][1] == sub[last_d + 1][1])
+          ret.copy_el_ *= sub_in_tile[last_d][1] - sub_in_tile[last_d][0] + 1;
+        else
+          break;
+      }
+      if (last_d < 0) {
+        ret.dim_ranges_.push_back({0, 0});
+      } else {
+        for (int32_t d = 0; d <= last_d; ++d)
+          ret.dim_ranges_.push_back(
+              {0, (uint64_t)(sub_in_tile[d][1] - sub_in_tile[d][0])});
+      }
+      ret.first_d_ = 0;
+    } else {  // COL_MAJOR
+      ret.copy_el_ = sub_in_tile[0][1] - sub_in_tile[0][0] + 1;
+      int32_t last_d = 1;
+      for (; last_d < dim_num; ++last_d) {
+        auto tile_extent = *(const T*)domain->tile_extent(last_d - 1).data();
+        if (sub_in_tile[last_d - 1][1] - sub_in_tile[last_d - 1][0] + 1 ==
+                tile_extent &&
+            sub_in_tile[last_d - 1][0] == sub[last_d - 1][0] &&
+            sub_in_tile[last_d - 1][1] == sub[last_d - 1][1])
+          ret.copy_el_ *= sub_in_tile[last_d][1] - sub_in_tile[last_d][0] + 1;
+        else
+          break;
+      }
+      if (last_d == dim_num) {
+        ret.dim_ranges_.push_back({0, 0});
+        ret.first_d_ = dim_num - 1;
+      } else {
+        for (int32_t d = last_d; d < dim_num; ++d)
+          ret.dim_ranges_.push_back(
+              {0, (uint64_t)(sub_in_tile[d][1] - sub_in_tile[d][0])});
+        ret.first_d_ = last_d;
+      }
+    }
+  }
+
+  return ret;
+}
+
+template <class T>
+uint64_t DenseTiler<T>::copy_plan_idx(
+    const std::vector<uint64_t>& tile_coords_in_sub) const {
+  // Each dimension is a base-3 digit: 0 for the first tile of the subarray,
+  // 1 for an interior tile and 2 for the last tile
+  uint64_t idx = 0;
+  for (size_t d = 0; d < tile_coords_in_sub.size(); ++d) {
+    auto c = tile_coords_in_sub[d];
+    uint64_t pos = (c == 0) ? 0 : ((c == sub_tile_nums_[d] - 1) ? 2 : 1);
+    idx = idx * 3 + pos;
+  }
+
+  return idx;
+}
+
 template <class T>
 std::vector<uint64_t> DenseTiler<T>::tile_coords_in_sub(uint64_t id) const {
   // For easy reference
@@ -558,19 +616,27 @@ std::vector<std::array<T, 2>> DenseTiler<T>::tile_subarray(uint64_t id) const {
 template <class T>
 Status DenseTiler<T>::copy_tile(
     uint64_t id, uint64_t cell_size, uint8_t* buff, WriterTile* tile) const {
-  // Calculate copy plan
-  const CopyPlan copy_plan = this->copy_plan(id);
+  return for_each_copy(
+      id, [&](uint64_t sub_el, uint64_t tile_el, uint64_t el_num) {
+        return tile->write(
+            &buff[sub_el * cell_size], tile_el * cell_size, el_num * cell_size);
+      });
+}
+
+template <class T>
+template <class F>
+Status DenseTiler<T>::for_each_copy(uint64_t id, const F& f) const {
+  // Get the copy plan of the tile shape
+  auto tile_coords_in_sub = this->tile_coords_in_sub(id);
+  const CopyPlan& copy_plan =
+      copy_plans_.find(copy_plan_idx(tile_coords_in_sub))->second;
 
   // For easy reference
-  auto sub_offset = copy_plan.sub_start_el_ * cell_size;
-  auto tile_offset = copy_plan.tile_start_el_ * cell_size;
-  auto copy_nbytes = copy_plan.copy_el_ * cell_size;
-  auto sub_strides_nbytes = copy_plan.sub_strides_el_;
-  for (auto& bsn : sub_strides_nbytes)
-    bsn *= cell_size;
-  auto tile_strides_nbytes = copy_plan.tile_strides_el_;
-  for (auto& tsn : tile_strides_nbytes)
-    tsn *= cell_size;
+  auto sub_offset = sub_start_el(tile_coords_in_sub);
+  auto tile_offset = copy_plan.tile_start_el_;
+  auto copy_el = copy_plan.copy_el_;
+  const auto& sub_strides_el = copy_plan.sub_strides_el_;
+  const auto& tile_strides_el = copy_plan.tile_strides_el_;
   const auto& dim_ranges = copy_plan.dim_ranges_;
   auto first_d = copy_plan.first_d_;
   auto dim_num = (int64_t)dim_ranges.size();
@@ -591,8 +657,7 @@ Status DenseTiler<T>::copy_tile(
   auto d = dim_num - 1;
   while (true) {
     // Copy a slab
-    RETURN_NOT_OK(
-        tile->write(&buff[sub_offsets[d]], tile_offsets[d], copy_nbytes));
+    RETURN_NOT_OK(f(sub_offsets[d], tile_offsets[d], copy_el));
 
     // Advance cell coordinates, tile and buffer offsets
     auto last_dim_changed = d;
@@ -610,9 +675,8 @@ Status DenseTiler<T>::copy_tile(
 
     // Update the offsets
     tile_offsets[last_dim_changed] +=
-        tile_strides_nbytes[last_dim_changed + first_d];
-    sub_offsets[last_dim_changed] +=
-        sub_strides_nbytes[last_dim_changed + first_d];
+        tile_strides_el[last_dim_changed + first_d];
+    sub_offsets[last_dim_changed] += sub_strides_el[last_dim_changed + first_d];
     for (auto i = last_dim_changed + 1; i < dim_num; ++i) {
       tile_offsets[i] = tile_offsets[i - 1];
       sub_offsets[i] = sub_offsets[i - 1];
@@ -622,6 +686,29 @@ Status DenseTiler<T>::copy_tile(
   return Status::Ok();
 }
 
+template <class T>
+uint64_t DenseTiler<T>::sub_start_el(
+    const std::vector<uint64_t>& tile_coords_in_sub) const {
+  // For easy reference
+  auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  auto subarray = subarray_->ndrange(0);
+
+  uint64_t ret = 0;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dom_start = *(const T*)domain->dimension(d)->domain().start();
+    auto tile_extent = *(const T*)domain->tile_extent(d).data();
+    auto sub_start = *(const T*)subarray[d].start();
+    T tile_start = Dimension::tile_coord_low(
+        tile_coords_in_sub[d] + first_sub_tile_coords_[d],
+        dom_start,
+        tile_extent);
+    ret += (std::max(tile_start, sub_start) - sub_start) * sub_strides_el_[d];
+  }
+
+  return ret;
+}
+
 // Explicit template instantiations
 template class DenseTiler<int8_t>;
 template class DenseTiler<uint8_t>;
@@ -159,7 +159,10 @@ class DenseTiler {
   /*                 API               */
   /* ********************************* */
 
-  /** Computes and returns the copy plan for the give tile id. */
+  /**
+   * Returns the copy plan for the give tile id. The plans are computed once
+   * per tile shape in the subarray and shared by all the attributes.
+   */
   const CopyPlan copy_plan(uint64_t id) const;
 
   /**
@@ -288,6 +291,18 @@ class DenseTiler {
   /** The coordinates of the first tile intersecting the subarray. */
   std::vector<uint64_t> first_sub_tile_coords_;
 
+  /**
+   * The copy plans of the tile shapes in the subarray, without their
+   * `sub_start_el_`. On each dimension, a tile is either the first, an
+   * interior or the last tile of the subarray, and all the tiles with the
+   * same position on all dimensions have the same plan. The key is given by
+   * `copy_plan_idx`.
+   */
+  std::unordered_map<uint64_t, CopyPlan> copy_plans_;
+
+  /** The number of tiles intersecting the subarray on each dimension. */
+  std::vector<uint64_t> sub_tile_nums_;
+
   /** The offset format used for variable-sized attributes. */
   std::string offsets_format_mode_;
 
@@ -316,6 +331,12 @@ class DenseTiler {
    */
   void calculate_subarray_tile_coord_strides();
 
+  /**
+   * Calculates the copy plans of the tile shapes in the subarray. Must be
+   * invoked after the tile and subarray strides are calculated.
+   */
+  void calculate_copy_plans();
+
   /**
    * Calculates the tile and subarray strides. These are fixed for all
    * tiles.
@@ -325,6 +346,32 @@ class DenseTiler {
   /** Calculates the number of tiles to be created. */
   void calculate_tile_num();
 
+  /** Computes the copy plan for the given tile id. */
+  CopyPlan compute_copy_plan(uint64_t id) const;
+
+  /**
+   * Returns the key in `copy_plans_` of the plan of the tile with the
+   * input coordinates in the subarray tile domain.
+   */
+  uint64_t copy_plan_idx(
+      const std::vector<uint64_t>& tile_coords_in_sub) const;
+
+  /**
+   * Calls `f(sub_el, tile_el, el_num)` for each run of `el_num` contiguous
+   * elements copied from position `sub_el` in the subarray to position
+   * `tile_el` in the tile with the input id, following its copy plan.
+   *
+   * @return The first non-ok status returned by `f`, or ok.
+   */
+  template <class F>
+  Status for_each_copy(uint64_t id, const F& f) const;
+
+  /**
+   * Returns the position of the first element to copy from the subarray
+   * for the tile with the input coordinates in the subarray tile domain.
+   */
+  uint64_t sub_start_el(const std::vector<uint64_t>& tile_coords_in_sub) const;
+
   /**
    * Returns the tile coordinates of the given tile id inside
    * the subarray tile domain.
@@ -90,10 +90,15 @@ GlobalOrderWriter::GlobalOrderWriter(
           written_fragment_info,
           disable_check_global_order,
           coords_info,
-          fragment_uri) {
+          fragment_uri)
+    , max_in_flight_bytes_(0)
+    , budget_(0)
+    , in_flight_bytes_(0)
+    , flush_running_(false) {
 }
 
 GlobalOrderWriter::~GlobalOrderWriter() {
+  wait_flush();
 }
 
 /* ****************************** */
@@ -119,12 +124,16 @@ Status GlobalOrderWriter::dowork() {
 Status GlobalOrderWriter::finalize() {
   auto timer_se = stats_->start_timer("finalize");
 
-  if (global_write_state_ != nullptr)
+  if (global_write_state_ != nullptr) {
+    const auto uri = global_write_state_->frag_meta_->fragment_uri();
+    RETURN_NOT_OK_ELSE(wait_flush(), clean_up(uri));
     return finalize_global_write_state();
+  }
   return Status::Ok();
 }
 
 void GlobalOrderWriter::reset() {
+  wait_flush();
   if (global_write_state_ != nullptr)
     nuke_global_write_state();
   initialized_ = false;
@@ -234,8 +243,8 @@ Status GlobalOrderWriter::check_global_order() const {
   if (!coords_info_.has_coords_ || coords_info_.coords_num_ < 2)
     return Status::Ok();
 
-  // Special case for Hilbert
-  if (array_schema_->cell_order() == Layout::HILBERT)
+  // Special case for Hilbert and Morton
+  if (layout_is_curve(array_schema_->cell_order()))
     return check_global_order_hilbert();
 
   // Prepare auxiliary vector for better performance
@@ -314,6 +323,72 @@ void GlobalOrderWriter::clean_up(const URI& uri) {
   global_write_state_.reset(nullptr);
 }
 
+Status GlobalOrderWriter::enqueue_full_tiles(
+    uint64_t tile_num,
+    std::unordered_map<std::string, std::vector<WriterTile>>&& tiles) {
+  uint64_t size = 0;
+  for (const auto& it : tiles) {
+    for (const auto& tile : it.second) {
+      size += tile.size();
+    }
+  }
+
+  {
+    // A batch larger than the limit is written once the queue is empty.
+    std::unique_lock<std::mutex> lck(flush_mtx_);
+    flush_cv_.wait(lck, [&]() {
+      return !flush_status_.ok() || in_flight_bytes_ == 0 ||
+             in_flight_bytes_ + size <= max_in_flight_bytes_;
+    });
+    RETURN_NOT_OK(flush_status_);
+
+    flush_queue_.push_back({std::move(tiles), tile_num, size});
+    in_flight_bytes_ += size;
+    if (flush_running_)
+      return Status::Ok();
+    flush_running_ = true;
+  }
+
+  // The task might run on this thread, so it is started without the lock.
+  flush_task_ = storage_manager_->io_tp()->execute(
+      [this]() { return flush_full_tiles(); });
+  if (!flush_task_.valid()) {
+    return flush_full_tiles();
+  }
+
+  return Status::Ok();
+}
+
+Status GlobalOrderWriter::flush_full_tiles() {
+  while (true) {
+    FullTilesBatch* batch = nullptr;
+    {
+      std::unique_lock<std::mutex> lck(flush_mtx_);
+      if (flush_queue_.empty() || !flush_status_.ok()) {
+        flush_queue_.clear();
+        in_flight_bytes_ = 0;
+        flush_running_ = false;
+        flush_cv_.notify_all();
+        return flush_status_;
+      }
+
+      // References to the front of the deque survive pushes at the back.
+      batch = &flush_queue_.front();
+    }
+
+    auto st = write_full_tiles(batch->tile_num_, &batch->tiles_);
+
+    {
+      std::unique_lock<std::mutex> lck(flush_mtx_);
+      in_flight_bytes_ -= batch->size_;
+      flush_queue_.pop_front();
+      if (!st.ok())
+        flush_status_ = st;
+      flush_cv_.notify_all();
+    }
+  }
+}
+
 Status GlobalOrderWriter::filter_last_tiles(uint64_t cell_num) {
   // Adjust cell num
   for (auto& last_tiles : global_write_state_->last_tiles_) {
@@ -342,6 +417,10 @@ Status GlobalOrderWriter::filter_last_tiles(uint64_t cell_num) {
   // Compute tile metadata.
   RETURN_NOT_OK(compute_tiles_metadata(1, global_write_state_->last_tiles_));
 
+  // Compute the attribute value index
+  RETURN_NOT_OK(
+      compute_attribute_index(1, global_write_state_->last_tiles_, meta));
+
   // Gather stats
   stats_->add_counter(
       "cell_num",
@@ -490,9 +569,7 @@ Status GlobalOrderWriter::finalize_global_write_state() {
   RETURN_NOT_OK_ELSE(add_written_fragment_info(uri), clean_up(uri));
 
   // The following will make the fragment visible
-  auto ok_uri =
-      URI(uri.remove_trailing_slash().to_string() + constants::ok_file_suffix);
-  RETURN_NOT_OK_ELSE(storage_manager_->vfs()->touch(ok_uri), clean_up(uri));
+  RETURN_NOT_OK_ELSE(commit_fragment(uri), clean_up(uri));
 
   // Delete global write state
   global_write_state_.reset(nullptr);
@@ -549,27 +626,19 @@ Status GlobalOrderWriter::global_write() {
     return Status::Ok();
   }
 
-  // Set new number of tiles in the fragment metadata
-  auto new_num_tiles = frag_meta->tile_index_base() + tile_num;
-  frag_meta->set_num_tiles(new_num_tiles);
-
-  // Compute coordinate metadata (if coordinates are present)
-  RETURN_CANCEL_OR_ERROR_ELSE(
-      compute_coords_metadata(tiles, frag_meta), clean_up(uri));
-
-  // Compute tile metadata.
-  RETURN_CANCEL_OR_ERROR_ELSE(
-      compute_tiles_metadata(tile_num, tiles), clean_up(uri));
-
-  // Filter all tiles
-  RETURN_CANCEL_OR_ERROR_ELSE(filter_tiles(&tiles), clean_up(uri));
+  // The user buffers are no longer needed, the tiles can be filtered and
+  // written in the background.
+  if (max_in_flight_bytes_ > 0) {
+    auto st = enqueue_full_tiles(tile_num, std::move(tiles));
+    if (!st.ok()) {
+      wait_flush();
+      clean_up(uri);
+    }
+    return st;
+  }
 
-  // Write tiles for all attributes
   RETURN_CANCEL_OR_ERROR_ELSE(
-      write_all_tiles(frag_meta, &tiles), clean_up(uri));
-
-  // Increment the tile index base for the next global order write.
-  frag_meta->set_tile_index_base(new_num_tiles);
+      write_full_tiles(tile_num, &tiles), clean_up(uri));
 
   return Status::Ok();
 }
@@ -612,6 +681,16 @@ Status GlobalOrderWriter::init_global_write_state() {
                            "properly finalized"));
   global_write_state_.reset(new GlobalWriteState);
 
+  bool found = false;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.mem.writer.global_order.max_in_flight_bytes",
+      &max_in_flight_bytes_,
+      &found));
+  assert(found);
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.mem.writer.global_order.budget", &budget_, &found));
+  assert(found);
+
   // Create fragment
   global_write_state_->frag_meta_ = tdb::make_shared<FragmentMetadata>(HERE());
   RETURN_NOT_OK(create_fragment(
@@ -662,6 +741,118 @@ Status GlobalOrderWriter::init_global_write_state() {
   return Status::Ok();
 }
 
+Status GlobalOrderWriter::wait_flush() {
+  std::unique_lock<std::mutex> lck(flush_mtx_);
+  flush_cv_.wait(lck, [this]() { return !flush_running_; });
+  return flush_status_;
+}
+
+Status GlobalOrderWriter::write_full_tiles(
+    uint64_t tile_num,
+    std::unordered_map<std::string, std::vector<WriterTile>>* tiles) {
+  auto frag_meta = global_write_state_->frag_meta_;
+
+  // Set new number of tiles in the fragment metadata
+  auto new_num_tiles = frag_meta->tile_index_base() + tile_num;
+  frag_meta->set_num_tiles(new_num_tiles);
+
+  // Compute coordinate metadata (if coordinates are present)
+  RETURN_CANCEL_OR_ERROR(compute_coords_metadata(*tiles, frag_meta));
+
+  // Compute tile metadata.
+  RETURN_CANCEL_OR_ERROR(compute_tiles_metadata(tile_num, *tiles));
+
+  // Compute the attribute value index
+  RETURN_CANCEL_OR_ERROR(compute_attribute_index(tile_num, *tiles, frag_meta));
+
+  // The memory held by the tiles, including the batches queued behind these
+  // ones when they are written in the background
+  uint64_t held_size = 0;
+  for (const auto& it : *tiles) {
+    for (const auto& tile : it.second)
+      held_size += tile.size();
+  }
+  if (max_in_flight_bytes_ > 0) {
+    std::unique_lock<std::mutex> lck(flush_mtx_);
+    held_size = std::max(held_size, in_flight_bytes_);
+  }
+
+  // Each batch holds at most the budget split evenly among the attributes
+  // and dimensions of tiles of each of them
+  uint64_t batch_tile_num = tile_num;
+  if (budget_ > 0) {
+    const uint64_t name_budget = std::max(budget_ / tiles->size(), uint64_t(1));
+    for (const auto& it : *tiles) {
+      uint64_t size = 0;
+      for (const auto& tile : it.second)
+        size += tile.size();
+      const uint64_t tile_size =
+          std::max(utils::math::ceil(size, tile_num), uint64_t(1));
+      batch_tile_num = std::min(
+          batch_tile_num, std::max(name_budget / tile_size, uint64_t(1)));
+    }
+  }
+
+  // Filter and write the tiles one batch at a time, freeing the filtered
+  // buffers of a batch once it is written
+  uint64_t peak_size = 0;
+  for (uint64_t b = 0; b < tile_num; b += batch_tile_num) {
+    const uint64_t e = std::min(b + batch_tile_num, tile_num);
+    std::unordered_map<std::string, std::vector<WriterTile>> batch_tiles;
+    auto batch = tiles;
+    if (e - b != tile_num) {
+      batch = &batch_tiles;
+      for (auto& it : *tiles) {
+        const uint64_t t = it.second.size() / tile_num;
+        auto& batch_vec = batch_tiles[it.first];
+        batch_vec.reserve((e - b) * t);
+        for (uint64_t i = b * t; i < e * t; ++i)
+          batch_vec.emplace_back(std::move(it.second[i]));
+      }
+    }
+
+    uint64_t batch_size = 0;
+    for (const auto& it : *batch) {
+      for (const auto& tile : it.second)
+        batch_size += tile.size();
+    }
+
+    // Filter the tiles of the batch, which frees their unfiltered data
+    RETURN_CANCEL_OR_ERROR(filter_tiles(batch));
+
+    uint64_t filtered_size = 0;
+    for (auto& it : *batch) {
+      for (auto& tile : it.second)
+        filtered_size += tile.filtered_buffer().size();
+    }
+    peak_size = std::max(peak_size, held_size + filtered_size);
+    held_size -= std::min(held_size, batch_size);
+
+    // Write the tiles of the batch for all attributes
+    RETURN_CANCEL_OR_ERROR(upload_tiles(frag_meta, b, batch));
+
+    // Free the filtered buffers, keeping the tiles for their metadata
+    for (auto& it : *batch) {
+      auto& src = (*tiles)[it.first];
+      const uint64_t t = src.size() / tile_num;
+      for (uint64_t i = 0; i < it.second.size(); ++i) {
+        FilteredBuffer(0).swap(it.second[i].filtered_buffer());
+        if (batch != tiles)
+          src[b * t + i] = std::move(it.second[i]);
+      }
+    }
+  }
+  stats_->set_max_counter("peak_memory_bytes", peak_size);
+
+  // Set the metadata of the tiles for all attributes
+  set_all_tiles_metadata(frag_meta, tiles);
+
+  // Increment the tile index base for the next global order write.
+  frag_meta->set_tile_index_base(new_num_tiles);
+
+  return Status::Ok();
+}
+
 void GlobalOrderWriter::nuke_global_write_state() {
   auto meta = global_write_state_->frag_meta_;
   close_files(meta);
@@ -775,9 +966,19 @@ Status GlobalOrderWriter::prepare_full_tiles_fixed(
 
   if (full_tile_num > 0) {
     const uint64_t t = 1 + (nullable ? 1 : 0);
+    const bool last_tile_full = last_tile_cell_idx == cell_num_per_tile;
     tiles->resize(t * full_tile_num);
 
-    for (uint64_t i = 0; i < tiles->size(); i += t)
+    // Without duplicates to skip, full tiles are exact slices of the user
+    // buffers and can view them instead of copying them, as long as they are
+    // filtered and written before the submit returns. Only the tile swapped
+    // with the last tile needs its own buffer, as it becomes the new last
+    // tile.
+    const bool view_buffers =
+        coord_dups.empty() && max_in_flight_bytes_ == 0;
+    const uint64_t tiles_to_init =
+        view_buffers ? (last_tile_full ? t : 0) : tiles->size();
+    for (uint64_t i = 0; i < tiles_to_init; i += t)
       if (!nullable)
         RETURN_NOT_OK(init_tile(name, &((*tiles)[i])));
       else
@@ -785,7 +986,7 @@ Status GlobalOrderWriter::prepare_full_tiles_fixed(
             init_tile_nullable(name, &((*tiles)[i]), &((*tiles)[i + 1])));
 
     // Handle last tile (it must be either full or empty)
-    if (last_tile_cell_idx == cell_num_per_tile) {
+    if (last_tile_full) {
       (*tiles)[0].swap(last_tile);
       if (nullable) {
         (*tiles)[1].swap(last_tile_validity);
@@ -794,9 +995,35 @@ Status GlobalOrderWriter::prepare_full_tiles_fixed(
       assert(last_tile_cell_idx == 0);
     }
 
-    // Write all remaining cells one by one
-    if (coord_dups.empty()) {
-      for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;) {
+    // Write all remaining cells, after the previous last tile
+    uint64_t tile_idx = last_tile_full ? t : 0;
+    if (view_buffers) {
+      const auto type = array_schema_->type(name);
+      const auto format_version = array_schema_->write_version();
+      for (uint64_t i = 0; i < cell_num_to_write; i += cell_num_per_tile) {
+        RETURN_NOT_OK((*tiles)[tile_idx].init_unfiltered_view(
+            format_version,
+            type,
+            cell_size,
+            0,
+            buffer + cell_idx * cell_size,
+            cell_size * cell_num_per_tile));
+
+        if (nullable) {
+          RETURN_NOT_OK((*tiles)[tile_idx + 1].init_unfiltered_view(
+              format_version,
+              constants::cell_validity_type,
+              constants::cell_validity_size,
+              0,
+              buffer_validity + cell_idx * constants::cell_validity_size,
+              constants::cell_validity_size * cell_num_per_tile));
+        }
+
+        cell_idx += cell_num_per_tile;
+        tile_idx += t;
+      }
+    } else if (coord_dups.empty()) {
+      for (uint64_t i = 0; i < cell_num_to_write;) {
         RETURN_NOT_OK((*tiles)[tile_idx].write(
             buffer + cell_idx * cell_size, 0, cell_size * cell_num_per_tile));
 
@@ -813,8 +1040,7 @@ Status GlobalOrderWriter::prepare_full_tiles_fixed(
       }
     } else {
       uint64_t current_tile_cell_idx = 0;
-      for (uint64_t tile_idx = 0, i = 0; i < cell_num_to_write;
-           ++cell_idx, ++i) {
+      for (uint64_t i = 0; i < cell_num_to_write; ++cell_idx, ++i) {
         if (current_tile_cell_idx == cell_num_per_tile) {
           tile_idx += t;
           current_tile_cell_idx = 0;
@@ -822,14 +1048,17 @@ Status GlobalOrderWriter::prepare_full_tiles_fixed(
 
         if (coord_dups.find(cell_idx) == coord_dups.end()) {
           RETURN_NOT_OK((*tiles)[tile_idx].write(
-              buffer + cell_idx * cell_size, cell_idx * cell_size, cell_size));
+              buffer + cell_idx * cell_size,
+              current_tile_cell_idx * cell_size,
+              cell_size));
 
           if (nullable) {
             RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
                 buffer_validity + cell_idx * constants::cell_validity_size,
-                cell_idx * constants::cell_validity_size,
+                current_tile_cell_idx * constants::cell_validity_size,
                 constants::cell_validity_size));
           }
+          ++current_tile_cell_idx;
         }
       }
     }
@@ -1004,9 +1233,9 @@ Status GlobalOrderWriter::prepare_full_tiles_var(
       assert(last_tile_cell_idx == 0);
     }
 
-    // Write all remaining cells one by one
+    // Write all remaining cells one by one, after the previous last tile
     uint64_t current_tile_cell_idx = 0;
-    uint64_t tile_idx = 0;
+    uint64_t tile_idx = last_tile_cell_idx == cell_num_per_tile ? t : 0;
     if (coord_dups.empty()) {
       for (uint64_t i = 0; i < cell_num_to_write;
            ++cell_idx, ++i, ++current_tile_cell_idx) {
@@ -34,8 +34,12 @@
 #define TILEDB_GLOBAL_ORDER_WRITER_H
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 #include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/query/writer_base.h"
 
 using namespace tiledb::common;
@@ -84,6 +88,21 @@ class GlobalOrderWriter : public WriterBase {
     tdb_shared_ptr<FragmentMetadata> frag_meta_;
   };
 
+  /**
+   * The full tiles prepared by one submit, waiting to be filtered and
+   * written in the background.
+   */
+  struct FullTilesBatch {
+    /** The full tiles, keyed by attribute/dimension name. */
+    std::unordered_map<std::string, std::vector<WriterTile>> tiles_;
+
+    /** The number of tiles per attribute/dimension. */
+    uint64_t tile_num_;
+
+    /** The unfiltered size of all the tiles. */
+    uint64_t size_;
+  };
+
   /* ********************************* */
   /*     CONSTRUCTORS & DESTRUCTORS    */
   /* ********************************* */
@@ -130,6 +149,39 @@ class GlobalOrderWriter : public WriterBase {
   /** The state associated with global writes. */
   tdb_unique_ptr<GlobalWriteState> global_write_state_;
 
+  /**
+   * Maximum number of bytes of full tiles filtered and written in the
+   * background. When 0, the tiles are filtered and written in each submit.
+   */
+  uint64_t max_in_flight_bytes_;
+
+  /**
+   * Memory budget for the full tiles filtered and written at once. When 0,
+   * all the full tiles of a submit are filtered before being written.
+   */
+  uint64_t budget_;
+
+  /** Protects the background write state below. */
+  std::mutex flush_mtx_;
+
+  /** Notified when the background task writes a batch or stops. */
+  std::condition_variable flush_cv_;
+
+  /** The batches of full tiles to write in the background, in order. */
+  std::deque<FullTilesBatch> flush_queue_;
+
+  /** The size of the tiles queued or being written in the background. */
+  uint64_t in_flight_bytes_;
+
+  /** Whether the background task is draining `flush_queue_`. */
+  bool flush_running_;
+
+  /** The first error of the background task. */
+  Status flush_status_;
+
+  /** The background task draining `flush_queue_`. */
+  ThreadPool::Task flush_task_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -181,6 +233,27 @@ class GlobalOrderWriter : public WriterBase {
    */
   Status compute_coord_dups(std::set<uint64_t>* coord_dups) const;
 
+  /**
+   * Queues the full tiles of a submit to be filtered and written in the
+   * background, starting the background task if needed. Blocks while the
+   * tiles already in flight and the new ones exceed `max_in_flight_bytes_`.
+   *
+   * @param tile_num The number of tiles per attribute/dimension.
+   * @param tiles The full tiles to write.
+   * @return Status
+   */
+  Status enqueue_full_tiles(
+      uint64_t tile_num,
+      std::unordered_map<std::string, std::vector<WriterTile>>&& tiles);
+
+  /**
+   * Background task writing the queued batches of full tiles in order,
+   * until the queue is empty or a batch fails.
+   *
+   * @return Status
+   */
+  Status flush_full_tiles();
+
   /**
    * Applicable only to global writes. Filters the last attribute and
    * coordinate tiles.
@@ -208,6 +281,27 @@ class GlobalOrderWriter : public WriterBase {
   /** Initializes the global write state. */
   Status init_global_write_state();
 
+  /**
+   * Waits for the background task to write the queued full tiles.
+   *
+   * @return The first error of the background task, if any.
+   */
+  Status wait_flush();
+
+  /**
+   * Computes the metadata of full tiles, filters them and writes them to
+   * the fragment, after the tiles previously written. With a memory budget,
+   * the tiles are filtered and written in batches, freeing the filtered
+   * buffers of each batch once it is written.
+   *
+   * @param tile_num The number of tiles per attribute/dimension.
+   * @param tiles The full tiles to write.
+   * @return Status
+   */
+  Status write_full_tiles(
+      uint64_t tile_num,
+      std::unordered_map<std::string, std::vector<WriterTile>>* tiles);
+
   /**
    * This deletes the global write state and deletes the potentially
    * partially written fragment.
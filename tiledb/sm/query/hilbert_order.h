@@ -30,12 +30,24 @@
 #define TILEDB_QUERY_HILBERT_ORDER_H
 
 #include "tiledb/common/common.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
+
+#include <algorithm>
+#include <vector>
+
 class Dimension;
 class QueryBuffer;
 class ResultCoords;
 
 namespace tiledb::sm::hilbert_order {
 
+/**
+ * The number of cells whose Hilbert values are computed together. The
+ * mapped coordinates of a batch fit in the L1 cache for a few dimensions.
+ */
+const uint64_t batch_size = 512;
+
 uint64_t map_to_uint64(
     const Dimension& dim,
     const QueryBuffer* buff,
@@ -50,5 +62,67 @@ uint64_t map_to_uint64(
     int bits,
     uint64_t max_bucket_val);
 
+/**
+ * Computes the Hilbert (or Morton) values of the cells in [begin, end), in
+ * batches of `batch_size` cells.
+ *
+ * @param curve The curve of the cell order.
+ * @param dim_num The number of dimensions.
+ * @param begin The first cell.
+ * @param end The cell after the last one.
+ * @param map_func Returns the coordinate of a cell on a dimension mapped to
+ *     uint64, called as `map_func(d, c, bits, max_bucket_val)`.
+ * @param value_func Receives the value of each cell, called as
+ *     `value_func(c, value)`.
+ */
+template <class MapFuncT, class ValueFuncT>
+void calculate_values(
+    const SpaceFillingCurve& curve,
+    uint32_t dim_num,
+    uint64_t begin,
+    uint64_t end,
+    const MapFuncT& map_func,
+    const ValueFuncT& value_func) {
+  const int bits = curve.bits();
+  const uint64_t max_bucket_val = ((uint64_t)1 << bits) - 1;
+  std::vector<uint64_t> coords(dim_num * std::min(batch_size, end - begin));
+  std::vector<uint64_t> values(std::min(batch_size, end - begin));
+  for (uint64_t b = begin; b < end; b += batch_size) {
+    const uint64_t n = std::min(batch_size, end - b);
+    for (uint32_t d = 0; d < dim_num; ++d) {
+      for (uint64_t i = 0; i < n; ++i)
+        coords[d * n + i] = map_func(d, b + i, bits, max_bucket_val);
+    }
+    curve.coords_to_values(n, coords.data(), values.data());
+    for (uint64_t i = 0; i < n; ++i)
+      value_func(b + i, values[i]);
+  }
+}
+
+/**
+ * Computes the Hilbert (or Morton) values of `cell_num` cells in parallel.
+ * See `calculate_values`.
+ */
+template <class MapFuncT, class ValueFuncT>
+Status parallel_calculate_values(
+    ThreadPool* tp,
+    const SpaceFillingCurve& curve,
+    uint32_t dim_num,
+    uint64_t cell_num,
+    const MapFuncT& map_func,
+    const ValueFuncT& value_func) {
+  const uint64_t batch_num = (cell_num + batch_size - 1) / batch_size;
+  return parallel_for(tp, 0, batch_num, [&](uint64_t b) {
+    calculate_values(
+        curve,
+        dim_num,
+        b * batch_size,
+        std::min((b + 1) * batch_size, cell_num),
+        map_func,
+        value_func);
+    return Status::Ok();
+  });
+}
+
 }  // namespace tiledb::sm::hilbert_order
 #endif  // TILEDB_QUERY_HILBERT_ORDER_H
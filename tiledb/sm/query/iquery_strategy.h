@@ -42,6 +42,8 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+class QueryProgress;
+
 class IQueryStrategy {
  public:
   /** Destructor. */
@@ -67,6 +69,15 @@ class IQueryStrategy {
 
   /** Resets the object */
   virtual void reset() = 0;
+
+  /**
+   * Prepares the strategy to run again after the subarray or the buffers
+   * changed, keeping the state that does not depend on them.
+   */
+  virtual Status rebind() = 0;
+
+  /** Sets the progress to update as the query is processed. */
+  virtual void set_progress(QueryProgress* progress) = 0;
 };
 
 }  // namespace sm
@@ -90,7 +90,14 @@ OrderedWriter::OrderedWriter(
           written_fragment_info,
           disable_check_global_order,
           coords_info,
-          fragment_uri) {
+          fragment_uri)
+    , streaming_(false)
+    , stream_dim_(0)
+    , stream_slice_cell_num_(0)
+    , stream_slice_num_(0)
+    , stream_slab_start_(0)
+    , stream_cell_num_(0)
+    , stream_tile_id_(0) {
 }
 
 OrderedWriter::~OrderedWriter() {
@@ -100,6 +107,29 @@ OrderedWriter::~OrderedWriter() {
 /*               API              */
 /* ****************************** */
 
+Status OrderedWriter::init() {
+  bool found = false;
+  RETURN_NOT_OK(config_.get<bool>(
+      "sm.query.dense.streaming_write", &streaming_, &found));
+  assert(found);
+
+  RETURN_NOT_OK(WriterBase::init());
+
+  if (streaming_) {
+    // Slabs are appended along the slowest varying dimension of the layout,
+    // so the tiles of a tile slab are contiguous in the fragment only if
+    // the layout matches the tile order
+    auto dim_num = array_schema_->dim_num();
+    if (dim_num > 1 && layout_ != array_schema_->tile_order())
+      return logger_->status(Status_WriterError(
+          "Cannot initialize writer; Streaming dense writes require the "
+          "query layout to match the tile order"));
+    stream_dim_ = (layout_ == Layout::COL_MAJOR) ? dim_num - 1 : 0;
+  }
+
+  return Status::Ok();
+}
+
 Status OrderedWriter::dowork() {
   get_dim_attr_stats();
 
@@ -119,6 +149,9 @@ Status OrderedWriter::dowork() {
 Status OrderedWriter::finalize() {
   auto timer_se = stats_->start_timer("finalize");
 
+  if (stream_frag_meta_ != nullptr)
+    RETURN_NOT_OK(stream_finalize());
+
   return Status::Ok();
 }
 
@@ -130,6 +163,13 @@ void OrderedWriter::reset() {
 /*        PRIVATE METHODS         */
 /* ****************************** */
 
+Status OrderedWriter::check_buffer_sizes() const {
+  if (streaming_)
+    return Status::Ok();
+
+  return WriterBase::check_buffer_sizes();
+}
+
 Status OrderedWriter::ordered_write() {
   // Applicable only to ordered write on dense arrays
   assert(layout_ == Layout::ROW_MAJOR || layout_ == Layout::COL_MAJOR);
@@ -186,6 +226,9 @@ Status OrderedWriter::ordered_write() {
 
 template <class T>
 Status OrderedWriter::ordered_write() {
+  if (streaming_)
+    return ordered_write_streaming<T>();
+
   auto timer_se = stats_->start_timer("filter_tile");
 
   // Create new fragment
@@ -297,12 +340,304 @@ Status OrderedWriter::ordered_write() {
       add_written_fragment_info(uri), storage_manager_->vfs()->remove_dir(uri));
 
   // The following will make the fragment visible
-  auto ok_uri =
-      URI(uri.remove_trailing_slash().to_string() + constants::ok_file_suffix);
   RETURN_NOT_OK_ELSE(
-      storage_manager_->vfs()->touch(ok_uri),
+      commit_fragment(uri), storage_manager_->vfs()->remove_dir(uri));
+
+  return Status::Ok();
+}
+
+template <class T>
+Status OrderedWriter::ordered_write_streaming() {
+  auto timer_se = stats_->start_timer("filter_tile");
+
+  // Create the fragment on the first submit
+  if (stream_frag_meta_ == nullptr) {
+    auto frag_meta = tdb::make_shared<FragmentMetadata>(HERE());
+    RETURN_CANCEL_OR_ERROR(create_fragment(true, frag_meta));
+
+    // Set number of tiles in the fragment metadata
+    DenseTiler<T> dense_tiler(
+        &buffers_,
+        &subarray_,
+        stats_,
+        offsets_format_mode_,
+        offsets_bitsize_,
+        offsets_extra_element_);
+    frag_meta->set_num_tiles(dense_tiler.tile_num());
+
+    auto ndrange = subarray_.ndrange(0);
+    const auto& range = ndrange[stream_dim_];
+    stream_slice_num_ =
+        uint64_t(*(const T*)range.end() - *(const T*)range.start()) + 1;
+    stream_slice_cell_num_ =
+        array_schema_->domain()->cell_num(ndrange) / stream_slice_num_;
+    for (const auto& buff : buffers_)
+      stream_buffers_[buff.first] = StreamBuffer();
+    stream_frag_meta_ = frag_meta;
+  }
+
+  // Get the number of cells in the slab
+  uint64_t cell_num = 0;
+  bool first = true;
+  for (const auto& buff : buffers_) {
+    const auto& name = buff.first;
+    uint64_t num = 0;
+    if (array_schema_->var_size(name)) {
+      num = *buff.second.buffer_size_ / (offsets_bitsize_ / 8) -
+            (offsets_extra_element_ ? 1 : 0);
+    } else {
+      num = *buff.second.buffer_size_ / array_schema_->cell_size(name);
+    }
+    if (array_schema_->is_nullable(name) &&
+        *buff.second.validity_vector_.buffer_size() /
+                constants::cell_validity_size !=
+            num)
+      return logger_->status(Status_WriterError(
+          "Cannot write slab; Invalid number of validity cells given for "
+          "attribute '" +
+          name + "'"));
+    if (!first && num != cell_num)
+      return logger_->status(Status_WriterError(
+          "Cannot write slab; Invalid number of cells given for attribute '" +
+          name + "'"));
+    cell_num = num;
+    first = false;
+  }
+  if (cell_num % stream_slice_cell_num_ != 0)
+    return logger_->status(Status_WriterError(
+        "Cannot write slab; The number of cells must be a multiple of the "
+        "number of cells in a subarray slice"));
+  auto written_cell_num =
+      stream_slab_start_ * stream_slice_cell_num_ + stream_cell_num_;
+  if (written_cell_num + cell_num > stream_slice_num_ * stream_slice_cell_num_)
+    return logger_->status(Status_WriterError(
+        "Cannot write slab; The slab exceeds the subarray"));
+
+  // Append the cells to the current tile slab, writing every tile slab
+  // that becomes complete
+  const auto& uri = stream_frag_meta_->fragment_uri();
+  uint64_t copied = 0;
+  while (copied < cell_num) {
+    auto slab_end = stream_slab_end<T>();
+    auto slab_cell_num =
+        (slab_end - stream_slab_start_ + 1) * stream_slice_cell_num_;
+    auto num = std::min(slab_cell_num - stream_cell_num_, cell_num - copied);
+    stream_copy_cells(cell_num, copied, num);
+    copied += num;
+    stream_cell_num_ += num;
+
+    if (stream_cell_num_ == slab_cell_num) {
+      RETURN_NOT_OK_ELSE(
+          stream_write_slab<T>(slab_end),
+          storage_manager_->vfs()->remove_dir(uri));
+    }
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+uint64_t OrderedWriter::stream_slab_end() const {
+  auto dim = array_schema_->dimension(stream_dim_);
+  auto dom_start = *(const T*)dim->domain().start();
+  auto extent = *(const T*)dim->tile_extent().data();
+  auto sub_start = *(const T*)subarray_.ndrange(0)[stream_dim_].start();
+
+  // The slab ends with the tile containing its first slice, or with the
+  // subarray
+  auto sub_offset = Dimension::tile_idx<T>(sub_start, dom_start, 1);
+  auto tile_idx = (sub_offset + stream_slab_start_) / (uint64_t)extent;
+  auto tile_end = (tile_idx + 1) * (uint64_t)extent - 1 - sub_offset;
+  return std::min(tile_end, stream_slice_num_ - 1);
+}
+
+void OrderedWriter::stream_copy_cells(
+    uint64_t cell_num, uint64_t start, uint64_t num) {
+  for (const auto& buff : buffers_) {
+    const auto& name = buff.first;
+    auto& stream_buff = stream_buffers_[name];
+
+    if (!array_schema_->var_size(name)) {
+      auto cell_size = array_schema_->cell_size(name);
+      auto data = (const uint8_t*)buff.second.buffer_ + start * cell_size;
+      stream_buff.fixed_.insert(
+          stream_buff.fixed_.end(), data, data + num * cell_size);
+    } else {
+      // Rebase the offsets on the var-sized data of the tile slab
+      auto datasize = datatype_size(array_schema_->type(name));
+      auto buff_off = buff.second.buffer_;
+      auto buff_var = (const uint8_t*)buff.second.buffer_var_;
+      for (uint64_t c = start; c < start + num; ++c) {
+        auto off = prepare_buffer_offset(buff_off, c, datasize);
+        auto end = (c + 1 < cell_num) ?
+                       prepare_buffer_offset(buff_off, c + 1, datasize) :
+                       *buff.second.buffer_var_size_;
+        uint64_t stream_off = stream_buff.var_.size();
+        auto off_data = (const uint8_t*)&stream_off;
+        stream_buff.fixed_.insert(
+            stream_buff.fixed_.end(), off_data, off_data + sizeof(uint64_t));
+        stream_buff.var_.insert(
+            stream_buff.var_.end(), buff_var + off, buff_var + end);
+      }
+    }
+
+    if (array_schema_->is_nullable(name)) {
+      auto validity = buff.second.validity_vector_.buffer() + start;
+      stream_buff.validity_.insert(
+          stream_buff.validity_.end(), validity, validity + num);
+    }
+  }
+}
+
+template <class T>
+Status OrderedWriter::stream_write_slab(uint64_t slab_end) {
+  // Create the subarray of the tile slab
+  Subarray slab_subarray(array_, layout_, stats_, logger_, false);
+  auto ndrange = subarray_.ndrange(0);
+  for (unsigned d = 0; d < array_schema_->dim_num(); ++d) {
+    if (d == stream_dim_) {
+      auto sub_start = *(const T*)ndrange[d].start();
+      T range[2] = {T(sub_start + stream_slab_start_),
+                    T(sub_start + slab_end)};
+      RETURN_NOT_OK(slab_subarray.add_range(d, &range[0], &range[1], nullptr));
+    } else {
+      RETURN_NOT_OK(slab_subarray.add_range(
+          d, ndrange[d].start(), ndrange[d].end(), nullptr));
+    }
+  }
+
+  // Create buffers over the received cells
+  std::unordered_map<std::string, QueryBuffer> slab_buffers;
+  for (auto& it : stream_buffers_) {
+    auto& stream_buff = it.second;
+    stream_buff.fixed_size_ = stream_buff.fixed_.size();
+    stream_buff.var_size_ = stream_buff.var_.size();
+    stream_buff.validity_size_ = stream_buff.validity_.size();
+    const bool var_size = array_schema_->var_size(it.first);
+    slab_buffers.emplace(
+        it.first,
+        QueryBuffer(
+            stream_buff.fixed_.data(),
+            var_size ? stream_buff.var_.data() : nullptr,
+            &stream_buff.fixed_size_,
+            var_size ? &stream_buff.var_size_ : nullptr,
+            ValidityVector(
+                stream_buff.validity_.data(), &stream_buff.validity_size_)));
+  }
+
+  // Prepare, filter and write the tiles of the slab. The attribute files
+  // are closed with the last slab.
+  DenseTiler<T> dense_tiler(&slab_buffers, &slab_subarray, stats_);
+  auto tile_num = dense_tiler.tile_num();
+  auto attr_num = slab_buffers.size();
+  auto compute_tp = storage_manager_->compute_tp();
+  auto thread_num = compute_tp->concurrency_level();
+  const bool close_files = (slab_end == stream_slice_num_ - 1);
+  std::unordered_map<std::string, std::vector<std::vector<WriterTile>>> tiles;
+  for (const auto& buff : slab_buffers) {
+    tiles.emplace(buff.first, std::vector<std::vector<WriterTile>>());
+  }
+
+  if (attr_num > tile_num) {  // Parallelize over attributes
+    RETURN_NOT_OK(parallel_for(compute_tp, 0, attr_num, [&](uint64_t i) {
+      auto buff_it = slab_buffers.begin();
+      std::advance(buff_it, i);
+      const auto& attr = buff_it->first;
+      return prepare_filter_and_write_tiles<T>(
+          attr,
+          tiles[attr],
+          stream_frag_meta_,
+          &dense_tiler,
+          1,
+          stream_tile_id_,
+          close_files);
+    }));
+  } else {  // Parallelize over tiles
+    for (const auto& buff : slab_buffers) {
+      const auto& attr = buff.first;
+      RETURN_NOT_OK(prepare_filter_and_write_tiles<T>(
+          attr,
+          tiles[attr],
+          stream_frag_meta_,
+          &dense_tiler,
+          thread_num,
+          stream_tile_id_,
+          close_files));
+    }
+  }
+
+  // Keep the var-sized min/max values, which can be set in the fragment
+  // metadata only after the var sizes of all tiles are known
+  for (const auto& buff : slab_buffers) {
+    const auto& attr = buff.first;
+    const auto var_size = array_schema_->var_size(attr);
+    if (!has_min_max_metadata(attr, var_size) || !var_size)
+      continue;
+    auto& min_max = stream_var_min_max_[attr];
+    const uint64_t tile_num_mult =
+        2 + (array_schema_->is_nullable(attr) ? 1 : 0);
+    for (const auto& batch : tiles[attr]) {
+      for (uint64_t i = 0; i < batch.size(); i += tile_num_mult) {
+        auto&& [min, min_size, max, max_size, sum, null_count] =
+            batch[i].metadata();
+        (void)sum;
+        (void)null_count;
+        auto min_data = (const uint8_t*)min;
+        auto max_data = (const uint8_t*)max;
+        min_max.emplace_back(
+            std::vector<uint8_t>(min_data, min_data + min_size),
+            std::vector<uint8_t>(max_data, max_data + max_size));
+      }
+    }
+  }
+
+  // Move on to the next tile slab
+  stream_tile_id_ += tile_num;
+  stream_slab_start_ = slab_end + 1;
+  stream_cell_num_ = 0;
+  for (auto& it : stream_buffers_) {
+    it.second.fixed_.clear();
+    it.second.var_.clear();
+    it.second.validity_.clear();
+  }
+
+  return Status::Ok();
+}
+
+Status OrderedWriter::stream_finalize() {
+  const auto& uri = stream_frag_meta_->fragment_uri();
+  if (stream_slab_start_ != stream_slice_num_) {
+    storage_manager_->vfs()->remove_dir(uri);
+    stream_frag_meta_.reset();
+    return logger_->status(Status_WriterError(
+        "Cannot finalize streaming write; The written slabs do not cover "
+        "the subarray"));
+  }
+
+  // Set the var-sized tile min/max values
+  for (const auto& it : stream_var_min_max_) {
+    const auto& attr = it.first;
+    stream_frag_meta_->convert_tile_min_max_var_sizes_to_offsets(attr);
+    for (uint64_t t = 0; t < it.second.size(); ++t) {
+      stream_frag_meta_->set_tile_min_var(attr, t, it.second[t].first.data());
+      stream_frag_meta_->set_tile_max_var(attr, t, it.second[t].second.data());
+    }
+  }
+
+  // Write the fragment metadata
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      stream_frag_meta_->store(array_->get_encryption_key()),
       storage_manager_->vfs()->remove_dir(uri));
 
+  // Add written fragment info
+  RETURN_NOT_OK_ELSE(
+      add_written_fragment_info(uri), storage_manager_->vfs()->remove_dir(uri));
+
+  // The following will make the fragment visible
+  RETURN_NOT_OK_ELSE(
+      commit_fragment(uri), storage_manager_->vfs()->remove_dir(uri));
+
+  stream_frag_meta_.reset();
   return Status::Ok();
 }
 
@@ -312,7 +647,9 @@ Status OrderedWriter::prepare_filter_and_write_tiles(
     std::vector<std::vector<WriterTile>>& tile_batches,
     tdb_shared_ptr<FragmentMetadata> frag_meta,
     DenseTiler<T>* dense_tiler,
-    uint64_t thread_num) {
+    uint64_t thread_num,
+    uint64_t start_tile_id,
+    bool close_files) {
   auto timer_se = stats_->start_timer("prepare_filter_and_write_tiles");
 
   // For easy reference
@@ -333,7 +670,6 @@ Status OrderedWriter::prepare_filter_and_write_tiles(
 
   // Process batches
   uint64_t frag_tile_id = 0;
-  bool close_files = false;
   tile_batches.resize(batch_num);
   for (uint64_t b = 0; b < batch_num; ++b) {
     auto batch_size = (b == batch_num - 1) ? last_batch_size : thread_num;
@@ -359,6 +695,9 @@ Status OrderedWriter::prepare_filter_and_write_tiles(
             RETURN_NOT_OK(dense_tiler->get_tile(frag_tile_id + i, name, tile));
             md_generator.process_tile(tile, nullptr, tile_val);
             tile->set_metadata(md_generator.metadata());
+            if (elide_fill_tile(name, tile, tile_val)) {
+              return Status::Ok();
+            }
             RETURN_NOT_OK(filter_tile(name, tile, nullptr, false, false));
           } else {
             auto tile_var = &tile_batches[b][tiles_id + 1];
@@ -377,9 +716,12 @@ Status OrderedWriter::prepare_filter_and_write_tiles(
     RETURN_NOT_OK(st);
 
     // Write tiles
-    close_files = (b == batch_num - 1);
     RETURN_NOT_OK(write_tiles(
-        name, frag_meta, frag_tile_id, &tile_batches[b], close_files));
+        name,
+        frag_meta,
+        start_tile_id + frag_tile_id,
+        &tile_batches[b],
+        close_files && (b == batch_num - 1)));
 
     frag_tile_id += batch_size;
   }
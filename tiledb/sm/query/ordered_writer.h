@@ -75,6 +75,9 @@ class OrderedWriter : public WriterBase {
   /*                 API               */
   /* ********************************* */
 
+  /** Initializes the writer. */
+  Status init();
+
   /** Performs a write query using its set members. */
   Status dowork();
 
@@ -85,14 +88,95 @@ class OrderedWriter : public WriterBase {
   void reset();
 
  private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /**
+   * Cells of the current tile slab received so far in a streaming write,
+   * copied out of the user buffers. Offsets are stored in bytes, in 64 bits
+   * and without an extra element.
+   */
+  struct StreamBuffer {
+    /** The fixed-sized data, or the offsets for var-sized attributes. */
+    std::vector<uint8_t> fixed_;
+
+    /** The var-sized data. */
+    std::vector<uint8_t> var_;
+
+    /** The validity values. */
+    std::vector<uint8_t> validity_;
+
+    /** Size of `fixed_`, referenced by the slab query buffer. */
+    uint64_t fixed_size_;
+
+    /** Size of `var_`, referenced by the slab query buffer. */
+    uint64_t var_size_;
+
+    /** Size of `validity_`, referenced by the slab query buffer. */
+    uint64_t validity_size_;
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
 
+  /**
+   * If `true`, the subarray is received as a sequence of slabs over
+   * successive submits, and each tile slab is written as soon as it is
+   * complete.
+   */
+  bool streaming_;
+
+  /** The fragment being written by a streaming write. */
+  tdb_shared_ptr<FragmentMetadata> stream_frag_meta_;
+
+  /**
+   * The dimension along which the slabs of a streaming write are appended,
+   * i.e., the slowest varying dimension in the query layout.
+   */
+  unsigned stream_dim_;
+
+  /** The number of cells in one slice of the subarray along `stream_dim_`. */
+  uint64_t stream_slice_cell_num_;
+
+  /** The number of slices of the subarray along `stream_dim_`. */
+  uint64_t stream_slice_num_;
+
+  /**
+   * The first slice (relative to the subarray start) of the tile slab
+   * currently being received.
+   */
+  uint64_t stream_slab_start_;
+
+  /** The number of cells of the current tile slab received so far. */
+  uint64_t stream_cell_num_;
+
+  /** The fragment tile id of the first tile of the current tile slab. */
+  uint64_t stream_tile_id_;
+
+  /** The received cells of the current tile slab, per attribute. */
+  std::unordered_map<std::string, StreamBuffer> stream_buffers_;
+
+  /**
+   * The min/max values of the tiles written so far for var-sized
+   * attributes, set in the fragment metadata once all tiles are written.
+   */
+  std::unordered_map<
+      std::string,
+      std::vector<std::pair<std::vector<uint8_t>, std::vector<uint8_t>>>>
+      stream_var_min_max_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /**
+   * Checks the buffer sizes against the subarray. In a streaming write the
+   * buffers hold only a slab, which is checked on every submit instead.
+   */
+  Status check_buffer_sizes() const override;
+
   /**
    * Writes in an ordered layout (col- or row-major order). Applicable only
    * to dense arrays.
@@ -108,6 +192,45 @@ class OrderedWriter : public WriterBase {
   template <class T>
   Status ordered_write();
 
+  /**
+   * Appends the cells in the user buffers to the current tile slab of a
+   * streaming write, and writes every tile slab that becomes complete.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  Status ordered_write_streaming();
+
+  /**
+   * Returns the last slice (relative to the subarray start) of the tile
+   * slab starting at `stream_slab_start_`.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  uint64_t stream_slab_end() const;
+
+  /**
+   * Copies `num` cells starting at cell `start` of the user buffers, which
+   * hold `cell_num` cells, to the stream buffers.
+   */
+  void stream_copy_cells(uint64_t cell_num, uint64_t start, uint64_t num);
+
+  /**
+   * Prepares, filters and writes the tiles of the tile slab held in the
+   * stream buffers, which ends at slice `slab_end`.
+   *
+   * @tparam T The domain type.
+   */
+  template <class T>
+  Status stream_write_slab(uint64_t slab_end);
+
+  /**
+   * Sets the var-sized tile min/max values, stores the fragment metadata
+   * and commits the fragment of a streaming write.
+   */
+  Status stream_finalize();
+
   /**
    * Prepares, filters and writes dense tiles for the given attribute.
    *
@@ -117,7 +240,10 @@ class OrderedWriter : public WriterBase {
    * @param frag_meta The metadata of the new fragment.
    * @param dense_tiler The dense tiler that will prepare the tiles.
    * @param thread_num The number of threads to be used for the function.
-   * @param stats Statistics to gather in the function.
+   * @param start_tile_id The fragment tile id of the first tile of the
+   *     dense tiler.
+   * @param close_files Whether to close the attribute files after the
+   *     last tile is written.
    */
   template <class T>
   Status prepare_filter_and_write_tiles(
@@ -125,7 +251,9 @@ class OrderedWriter : public WriterBase {
       std::vector<std::vector<WriterTile>>& tile_batches,
       tdb_shared_ptr<FragmentMetadata> frag_meta,
       DenseTiler<T>* dense_tiler,
-      uint64_t thread_num);
+      uint64_t thread_num,
+      uint64_t start_tile_id = 0,
+      bool close_files = true);
 };
 
 }  // namespace sm
@@ -34,10 +34,13 @@
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/common/memory.h"
+#include "tiledb/common/stdx_string.h"
+#include "tiledb/common/tracer.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/fragment/fragment_parts.h"
 #include "tiledb/sm/misc/parse_argument.h"
 #include "tiledb/sm/query/dense_reader.h"
 #include "tiledb/sm/query/global_order_writer.h"
@@ -49,11 +52,14 @@
 #include "tiledb/sm/query/unordered_writer.h"
 #include "tiledb/sm/rest/rest_client.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
+#include "tiledb/sm/subarray/subarray_partitioner.h"
 #include "tiledb/sm/tile/writer_tile.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <sstream>
+#include <unordered_set>
 
 using namespace tiledb::common;
 using namespace tiledb::sm::stats;
@@ -69,8 +75,10 @@ Query::Query(StorageManager* storage_manager, Array* array, URI fragment_uri)
     : array_(array)
     , layout_(Layout::ROW_MAJOR)
     , storage_manager_(storage_manager)
+    , cancellation_token_(make_shared<CancellationToken>(HERE()))
     , stats_(storage_manager_->stats()->create_child("Query"))
     , logger_(storage_manager->logger()->clone("Query", ++logger_id_))
+    , trace_id_(tracer.next_trace_id())
     , has_coords_buffer_(false)
     , has_zipped_coords_buffer_(false)
     , coord_buffer_is_set_(false)
@@ -106,6 +114,12 @@ Query::Query(StorageManager* storage_manager, Array* array, URI fragment_uri)
   callback_ = nullptr;
   callback_data_ = nullptr;
   status_ = QueryStatus::UNINITIALIZED;
+  group_by_width_ = 0;
+  sample_fraction_ = 1.0;
+  sample_seed_ = 0;
+  stream_ = nullptr;
+  prepared_ = false;
+  rebind_ = false;
 
   if (storage_manager != nullptr)
     config_ = storage_manager->config();
@@ -122,6 +136,8 @@ Query::~Query() {
   const Status& st =
       config_.get<bool>("sm.mem.malloc_trim", &use_malloc_trim, &found);
   if (st.ok() && found && use_malloc_trim) {
+    if (storage_manager_ != nullptr)
+      storage_manager_->trim_tile_buffer_pool();
     tdb_malloc_trim();
   }
 };
@@ -130,6 +146,196 @@ Query::~Query() {
 /*               API              */
 /* ****************************** */
 
+Status Query::add_aggregate(
+    const std::string& field_name, QueryAggregateOp op) {
+  if (type_ == QueryType::WRITE)
+    return logger_->status(Status_QueryError(
+        "Cannot add aggregate; Operation only applicable to read queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(Status_QueryError(
+        "Cannot add aggregate; Query already initialized"));
+
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.field_name() == field_name && aggregate.op() == op)
+      return logger_->status(Status_QueryError(
+          "Cannot add aggregate; " + query_aggregate_op_str(op) + " on '" +
+          field_name + "' already added"));
+  }
+
+  QueryAggregate aggregate(field_name, op);
+  auto st = aggregate.init(array_schema_);
+  RETURN_NOT_OK_ELSE(st, logger_->status(st));
+
+  aggregates_.emplace_back(std::move(aggregate));
+  return Status::Ok();
+}
+
+Status Query::get_aggregate(
+    const std::string& field_name,
+    QueryAggregateOp op,
+    void* value,
+    uint64_t* value_size) const {
+  if (status_ != QueryStatus::COMPLETED)
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate; Query is not completed"));
+
+  if (!group_by_dim_.empty())
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate; The aggregates are grouped by a dimension, "
+        "use get_aggregate_bucket"));
+
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.field_name() == field_name && aggregate.op() == op) {
+      auto st = aggregate.get_result(value, value_size);
+      RETURN_NOT_OK_ELSE(st, logger_->status(st));
+      return Status::Ok();
+    }
+  }
+
+  return logger_->status(Status_QueryError(
+      "Cannot get aggregate; " + query_aggregate_op_str(op) + " on '" +
+      field_name + "' was not added to the query"));
+}
+
+Status Query::set_aggregate_group_by(
+    const std::string& dim_name, uint64_t bucket_width) {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot set aggregate group by; Operation only applicable to read "
+        "queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(Status_QueryError(
+        "Cannot set aggregate group by; Query already initialized"));
+
+  if (!array_schema_->is_dim(dim_name))
+    return logger_->status(Status_QueryError(
+        "Cannot set aggregate group by; '" + dim_name +
+        "' is not a dimension"));
+
+  const auto type = array_schema_->type(dim_name);
+  if (!datatype_is_integer(type) && !datatype_is_datetime(type) &&
+      !datatype_is_time(type))
+    return logger_->status(Status_QueryError(
+        "Cannot set aggregate group by; Dimension '" + dim_name +
+        "' must be an integer or datetime dimension"));
+
+  if (bucket_width == 0)
+    return logger_->status(Status_QueryError(
+        "Cannot set aggregate group by; The bucket width must be positive"));
+
+  group_by_dim_ = dim_name;
+  group_by_width_ = bucket_width;
+  return Status::Ok();
+}
+
+Status Query::get_aggregate_bucket_num(uint64_t* bucket_num) const {
+  if (status_ != QueryStatus::COMPLETED)
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate bucket number; Query is not completed"));
+
+  if (group_by_dim_.empty())
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate bucket number; The aggregates are not grouped "
+        "by a dimension"));
+
+  *bucket_num = aggregate_groups_.size();
+  return Status::Ok();
+}
+
+Status Query::get_aggregate_bucket(
+    uint64_t bucket_idx,
+    const std::string& field_name,
+    QueryAggregateOp op,
+    int64_t* bucket,
+    void* value,
+    uint64_t* value_size) const {
+  if (status_ != QueryStatus::COMPLETED)
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate bucket; Query is not completed"));
+
+  if (group_by_dim_.empty())
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate bucket; The aggregates are not grouped by a "
+        "dimension"));
+
+  if (bucket_idx >= aggregate_groups_.size())
+    return logger_->status(Status_QueryError(
+        "Cannot get aggregate bucket; Bucket index out of bounds"));
+
+  const auto it = std::next(aggregate_groups_.begin(), bucket_idx);
+  for (const auto& aggregate : it->second) {
+    if (aggregate.field_name() == field_name && aggregate.op() == op) {
+      auto st = aggregate.get_result(value, value_size);
+      RETURN_NOT_OK_ELSE(st, logger_->status(st));
+      *bucket = it->first;
+      return Status::Ok();
+    }
+  }
+
+  return logger_->status(Status_QueryError(
+      "Cannot get aggregate bucket; " + query_aggregate_op_str(op) + " on '" +
+      field_name + "' was not added to the query"));
+}
+
+Status Query::set_sample(double fraction, uint64_t seed) {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot set sample; Operation only applicable to read queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(
+        Status_QueryError("Cannot set sample; Query already initialized"));
+
+  if (!(fraction > 0.0 && fraction <= 1.0))
+    return logger_->status(Status_QueryError(
+        "Cannot set sample; The fraction must be in (0, 1]"));
+
+  sample_fraction_ = fraction;
+  sample_seed_ = seed;
+  return Status::Ok();
+}
+
+Status Query::set_top_k(
+    const std::string& field_name, uint64_t k, bool largest) {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot set top K; Operation only applicable to read queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(
+        Status_QueryError("Cannot set top K; Query already initialized"));
+
+  QueryTopK top_k(field_name, k, largest);
+  auto st = top_k.init(array_schema_);
+  RETURN_NOT_OK_ELSE(st, logger_->status(st));
+
+  top_k_.emplace(std::move(top_k));
+  return Status::Ok();
+}
+
+Status Query::set_fragment_part(const URI& fragment_uri, uint32_t part) {
+  if (type_ != QueryType::WRITE || !array_schema_->dense())
+    return logger_->status(
+        Status_QueryError("Cannot set fragment part; Operation only "
+                          "applicable to dense write queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(Status_QueryError(
+        "Cannot set fragment part; Query already initialized"));
+
+  if (!utils::parse::ends_with(
+          fragment_uri.remove_trailing_slash().to_string(),
+          constants::fragment_parts_suffix))
+    return logger_->status(Status_QueryError(
+        "Cannot set fragment part; '" + fragment_uri.to_string() +
+        "' is not a fragment written in parts"));
+
+  fragment_uri_ = FragmentParts::part_uri(fragment_uri, part);
+  return Status::Ok();
+}
+
 Status Query::add_range(
     unsigned dim_idx, const void* start, const void* end, const void* stride) {
   if (dim_idx >= array_schema_->dim_num())
@@ -506,6 +712,236 @@ Status Query::get_est_result_size_nullable(
       storage_manager_->compute_tp());
 }
 
+Status Query::get_est_result_size_condition(
+    const char* name,
+    uint64_t* size_fixed,
+    uint64_t* size_var,
+    uint64_t* size_validity) {
+  if (type_ == QueryType::WRITE)
+    return logger_->status(Status_QueryError(
+        "Cannot get estimated result size; Operation currently "
+        "unsupported for write queries"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_QueryError(
+        "Error in query estimate result size; query condition estimates "
+        "are unimplemented for remote arrays."));
+
+  return subarray_.get_est_result_size_condition(
+      name,
+      condition_,
+      size_fixed,
+      size_var,
+      size_validity,
+      &config_,
+      storage_manager_->compute_tp());
+}
+
+Status Query::explain(std::string* plan) {
+  if (type_ == QueryType::WRITE)
+    return logger_->status(Status_QueryError(
+        "Cannot explain query; Operation currently unsupported for write "
+        "queries"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_QueryError(
+        "Cannot explain query; Operation currently unsupported for remote "
+        "arrays"));
+
+  auto timer_se = stats_->start_timer("explain");
+  auto compute_tp = storage_manager_->compute_tp();
+  const auto range_num = subarray_.range_num();
+
+  // Compute the relevant fragments and the tile overlap for all ranges
+  RETURN_NOT_OK(subarray_.precompute_tile_overlap(
+      0, range_num - 1, &config_, compute_tp, true));
+  auto est_result_size =
+      subarray_.get_est_result_size_map(&config_, compute_tp);
+  auto max_mem_size = subarray_.get_max_mem_size_map(&config_, compute_tp);
+
+  // Count the unique tiles of the relevant fragments across all ranges
+  const auto relevant_fragments = *subarray_.relevant_fragments();
+  uint64_t tile_num = 0;
+  std::unordered_set<uint64_t> tiles;
+  for (const auto f : relevant_fragments) {
+    tiles.clear();
+    for (uint64_t r = 0; r < range_num; ++r) {
+      const auto tile_overlap = subarray_.tile_overlap(f, r);
+      for (const auto& tile_range : tile_overlap->tile_ranges_) {
+        for (uint64_t t = tile_range.first; t <= tile_range.second; ++t)
+          tiles.insert(t);
+      }
+      for (const auto& tile : tile_overlap->tiles_)
+        tiles.insert(tile.first);
+    }
+    tile_num += tiles.size();
+  }
+
+  // Describe the fields with buffers set, or all of them
+  std::vector<std::string> names;
+  if (!buffers_.empty()) {
+    for (const auto& buffer : buffers_)
+      names.emplace_back(buffer.first);
+  } else {
+    for (const auto& attr : array_schema_->attributes())
+      names.emplace_back(attr->name());
+    for (const auto& dim_name : array_schema_->dim_names())
+      names.emplace_back(dim_name);
+  }
+  std::sort(names.begin(), names.end());
+
+  // Compute the persisted size of the overlapping tiles per field
+  std::vector<uint64_t> persisted_sizes(names.size(), 0);
+  uint64_t est_memory = subarray_.tile_overlap_byte_size();
+  for (size_t i = 0; i < names.size(); ++i) {
+    std::vector<std::vector<Subarray::ResultSize>> result_sizes;
+    std::vector<std::vector<Subarray::MemorySize>> mem_sizes;
+    std::vector<uint64_t> range_persisted_sizes;
+    RETURN_NOT_OK(subarray_.compute_relevant_fragment_est_result_sizes(
+        {names[i]},
+        0,
+        range_num - 1,
+        &result_sizes,
+        &mem_sizes,
+        compute_tp,
+        &range_persisted_sizes));
+    for (const auto size : range_persisted_sizes)
+      persisted_sizes[i] += size;
+
+    const auto& mem_size = max_mem_size[names[i]];
+    est_memory +=
+        mem_size.size_fixed_ + mem_size.size_var_ + mem_size.size_validity_;
+  }
+
+  const auto strategy = read_strategy();
+  std::string reader;
+  switch (strategy) {
+    case ReadStrategy::LEGACY:
+      reader = "legacy";
+      break;
+    case ReadStrategy::DENSE:
+      reader = "dense";
+      break;
+    case ReadStrategy::SPARSE_GLOBAL_ORDER:
+      reader = "sparse_global_order";
+      break;
+    case ReadStrategy::SPARSE_UNORDERED_WITH_DUPS:
+      reader = "sparse_unordered_with_dups";
+      break;
+  }
+
+  // Escapes a field name to be used as a JSON key
+  auto json_str = [](const std::string& str) {
+    std::string ret = "\"";
+    for (const auto c : str) {
+      if (c == '"' || c == '\\')
+        ret += '\\';
+      ret += c;
+    }
+    return ret + "\"";
+  };
+
+  std::stringstream ss;
+  ss << "{\n";
+  ss << "  \"reader\": \"" << reader << "\",\n";
+  ss << "  \"fragment_num\": " << fragment_metadata_.size() << ",\n";
+  ss << "  \"relevant_fragment_num\": " << relevant_fragments.size()
+     << ",\n";
+  ss << "  \"range_num\": " << range_num << ",\n";
+  ss << "  \"tile_num\": " << tile_num << ",\n";
+  ss << "  \"fields\": {";
+  for (size_t i = 0; i < names.size(); ++i) {
+    const auto& est = est_result_size[names[i]];
+    const auto& mem = max_mem_size[names[i]];
+    ss << (i == 0 ? "\n" : ",\n");
+    ss << "    " << json_str(names[i]) << ": {\n";
+    ss << "      \"est_result_size\": {\"fixed\": "
+       << (uint64_t)est.size_fixed_ << ", \"var\": " << (uint64_t)est.size_var_
+       << ", \"validity\": " << (uint64_t)est.size_validity_ << "},\n";
+    ss << "      \"max_mem_size\": {\"fixed\": " << mem.size_fixed_
+       << ", \"var\": " << mem.size_var_
+       << ", \"validity\": " << mem.size_validity_ << "},\n";
+    ss << "      \"persisted_size\": " << persisted_sizes[i] << "\n";
+    ss << "    }";
+  }
+  ss << "\n  },\n";
+  ss << "  \"est_memory\": " << est_memory;
+
+  // Only the legacy reader partitions the subarray on the result budgets
+  if (strategy == ReadStrategy::LEGACY && !buffers_.empty()) {
+    uint64_t partition_num = 0;
+    bool unsplittable = false;
+    RETURN_NOT_OK(count_partitions(&partition_num, &unsplittable));
+    ss << ",\n  \"partition_num\": " << partition_num;
+    ss << ",\n  \"unsplittable\": " << (unsplittable ? "true" : "false");
+  }
+  ss << "\n}\n";
+
+  *plan = ss.str();
+
+  return Status::Ok();
+}
+
+Status Query::count_partitions(uint64_t* partition_num, bool* unsplittable) {
+  bool found = false;
+  uint64_t memory_budget = 0;
+  RETURN_NOT_OK(
+      config_.get<uint64_t>("sm.memory_budget", &memory_budget, &found));
+  assert(found);
+  uint64_t memory_budget_var = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.memory_budget_var", &memory_budget_var, &found));
+  assert(found);
+
+  // Budget the validity vectors like `Reader::init_read_state` does
+  SubarrayPartitioner partitioner(
+      &config_,
+      subarray_,
+      memory_budget,
+      memory_budget_var,
+      memory_budget,
+      storage_manager_->compute_tp(),
+      stats_,
+      logger_);
+  for (const auto& buffer : buffers_) {
+    const auto& name = buffer.first;
+    const auto buffer_size = *buffer.second.buffer_size_;
+    const auto buffer_var_size = buffer.second.buffer_var_size_;
+    const auto buffer_validity_size =
+        buffer.second.validity_vector_.buffer_size();
+    if (!array_schema_->var_size(name)) {
+      if (!array_schema_->is_nullable(name)) {
+        RETURN_NOT_OK(partitioner.set_result_budget(name.c_str(), buffer_size));
+      } else {
+        RETURN_NOT_OK(partitioner.set_result_budget_nullable(
+            name.c_str(), buffer_size, *buffer_validity_size));
+      }
+    } else {
+      if (!array_schema_->is_nullable(name)) {
+        RETURN_NOT_OK(partitioner.set_result_budget(
+            name.c_str(), buffer_size, *buffer_var_size));
+      } else {
+        RETURN_NOT_OK(partitioner.set_result_budget_nullable(
+            name.c_str(),
+            buffer_size,
+            *buffer_var_size,
+            *buffer_validity_size));
+      }
+    }
+  }
+
+  *partition_num = 0;
+  *unsplittable = false;
+  while (!partitioner.done()) {
+    RETURN_NOT_OK(partitioner.next(unsplittable));
+    if (*unsplittable)
+      break;
+    ++(*partition_num);
+  }
+
+  return Status::Ok();
+}
+
 std::unordered_map<std::string, Subarray::ResultSize>
 Query::get_est_result_size_map() {
   return subarray_.get_est_result_size_map(
@@ -927,9 +1363,65 @@ Status Query::init() {
       return logger_->status(Status_QueryError(errmsg.str()));
     }
 
+    // Aggregates do not return cells.
+    if (!aggregates_.empty() && !buffers_.empty())
+      return logger_->status(Status_QueryError(
+          "Cannot init query; Aggregates cannot be combined with buffers"));
+
+    // Only the sparse unordered reader groups the aggregates.
+    if (!group_by_dim_.empty()) {
+      if (aggregates_.empty())
+        return logger_->status(Status_QueryError(
+            "Cannot init query; A group by requires aggregates"));
+
+      if (array_schema_->dense())
+        return logger_->status(Status_QueryError(
+            "Cannot init query; Grouping aggregates is only supported for "
+            "sparse arrays"));
+    }
+
+    // Only the sparse unordered reader selects the top K cells.
+    if (top_k_.has_value()) {
+      if (!aggregates_.empty())
+        return logger_->status(Status_QueryError(
+            "Cannot init query; Top K cannot be combined with aggregates"));
+
+      if (read_strategy() != ReadStrategy::SPARSE_UNORDERED_WITH_DUPS)
+        return logger_->status(Status_QueryError(
+            "Cannot init query; Top K is only supported by unordered reads "
+            "of sparse arrays"));
+
+      top_k_->reset();
+    }
+
+    // The parts of a fragment hold the tiles of a subarray.
+    if (FragmentParts::is_part(fragment_uri_) && layout_ == Layout::UNORDERED)
+      return logger_->status(Status_QueryError(
+          "Cannot init query; A fragment part cannot be written with an "
+          "unordered layout"));
+
+    // Only the sparse unordered reader samples cells.
+    if (sample_fraction_ < 1.0 &&
+        read_strategy() != ReadStrategy::SPARSE_UNORDERED_WITH_DUPS)
+      return logger_->status(Status_QueryError(
+          "Cannot init query; Sampling is only supported by unordered reads "
+          "of sparse arrays"));
+
     RETURN_NOT_OK(check_buffer_names());
     RETURN_NOT_OK(create_strategy());
     RETURN_NOT_OK(strategy_->init());
+    rebind_ = false;
+  } else if (rebind_) {
+    // A prepared query keeps its strategy, only the results are reset.
+    RETURN_NOT_OK(check_buffer_names());
+    if (top_k_.has_value())
+      top_k_->reset();
+    for (auto& aggregate : aggregates_)
+      aggregate.reset();
+    aggregate_groups_.clear();
+    RETURN_NOT_OK(strategy_->rebind());
+    stats_->add_counter("rebind_num", 1);
+    rebind_ = false;
   }
 
   status_ = QueryStatus::INPROGRESS;
@@ -937,6 +1429,25 @@ Status Query::init() {
   return Status::Ok();
 }
 
+Status Query::prepare() {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot prepare query; Operation only applicable to read queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(
+        Status_QueryError("Cannot prepare query; Query already submitted"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_QueryError(
+        "Cannot prepare query; Remote arrays are not supported"));
+
+  RETURN_NOT_OK(init());
+  prepared_ = true;
+
+  return Status::Ok();
+}
+
 URI Query::first_fragment_uri() const {
   if (type_ == QueryType::WRITE || fragment_metadata_.empty())
     return URI();
@@ -964,18 +1475,43 @@ Status Query::cancel() {
   return Status::Ok();
 }
 
+void Query::request_cancellation() {
+  cancellation_token_->cancel();
+}
+
 Status Query::process() {
   if (status_ == QueryStatus::UNINITIALIZED)
     return logger_->status(
         Status_QueryError("Cannot process query; Query is not initialized"));
+  if (cancellation_token_->cancel_requested()) {
+    status_ = QueryStatus::CANCELLED;
+    return logger_->status(
+        Status_QueryError("Cannot process query; Query was cancelled"));
+  }
   status_ = QueryStatus::INPROGRESS;
 
-  // Process query
+  // Process query at the configured thread pool priority
+  ThreadPool::Priority priority;
+  bool found = false;
+  RETURN_NOT_OK(ThreadPool::priority_enum(
+      config_.get("sm.query.priority", &found), &priority));
+  assert(found);
+  ThreadPool::ScopedPriority scoped_priority(priority);
+
+  // Stop at the next tile once the query is cancelled or past its deadline
+  uint64_t timeout_ms = 0;
+  RETURN_NOT_OK(
+      config_.get<uint64_t>("sm.query.timeout_ms", &timeout_ms, &found));
+  assert(found);
+  cancellation_token_->set_timeout(timeout_ms);
+  ThreadPool::ScopedCancellation scoped_cancellation(cancellation_token_);
+  Tracer::ScopedTraceId scoped_trace_id(trace_id_);
   Status st = strategy_->dowork();
 
   // Handle error
   if (!st.ok()) {
-    status_ = QueryStatus::FAILED;
+    status_ = cancellation_token_->cancelled() ? QueryStatus::CANCELLED :
+                                                 QueryStatus::FAILED;
     return st;
   }
 
@@ -990,8 +1526,24 @@ Status Query::process() {
   // Check if the query is complete
   bool completed = !strategy_->incomplete();
 
+  // Attribute the results to the copy phase of the progress
+  if (type_ == QueryType::READ) {
+    uint64_t result_bytes = 0;
+    for (const auto& it : buffers_) {
+      const auto& buffer = it.second;
+      if (buffer.buffer_size_ != nullptr)
+        result_bytes += *buffer.buffer_size_;
+      if (buffer.buffer_var_size_ != nullptr)
+        result_bytes += *buffer.buffer_var_size_;
+      if (buffer.validity_vector_.buffer_size() != nullptr)
+        result_bytes += *buffer.validity_vector_.buffer_size();
+    }
+    progress_.add_phase_bytes(QueryPhase::COPY_RESULTS, result_bytes);
+  }
+
   // Handle callback and status
   if (completed) {
+    progress_.set_phase(QueryPhase::COMPLETED);
     if (callback_ != nullptr)
       callback_(callback_data_);
     status_ = QueryStatus::COMPLETED;
@@ -1052,20 +1604,52 @@ Status Query::create_strategy() {
     } else {
       assert(false);
     }
+  } else if (!aggregates_.empty()) {
+    RETURN_NOT_OK(create_aggregate_strategy());
   } else {
-    bool use_default = true;
-    if (use_refactored_sparse_unordered_with_dups_reader() &&
-        !array_schema_->dense() && layout_ == Layout::UNORDERED &&
-        array_schema_->allows_dups()) {
-      use_default = false;
-
-      auto&& [st, non_overlapping_ranges]{Query::non_overlapping_ranges()};
-      RETURN_NOT_OK(st);
-
-      if (*non_overlapping_ranges || !subarray_.is_set() ||
-          subarray_.range_num() == 1) {
+    switch (read_strategy()) {
+      case ReadStrategy::SPARSE_UNORDERED_WITH_DUPS: {
+        auto&& [st, non_overlapping_ranges]{Query::non_overlapping_ranges()};
+        RETURN_NOT_OK(st);
+
+        if (*non_overlapping_ranges || !subarray_.is_set() ||
+            subarray_.range_num() == 1) {
+          auto reader = tdb_new(
+              SparseUnorderedWithDupsReader<uint8_t>,
+              stats_->create_child("Reader"),
+              logger_,
+              storage_manager_,
+              array_,
+              config_,
+              buffers_,
+              subarray_,
+              layout_,
+              condition_);
+          reader->set_sample(sample_fraction_, sample_seed_);
+          reader->set_top_k(top_k_.has_value() ? &*top_k_ : nullptr);
+          strategy_ = tdb_unique_ptr<IQueryStrategy>(reader);
+        } else {
+          auto reader = tdb_new(
+              SparseUnorderedWithDupsReader<uint64_t>,
+              stats_->create_child("Reader"),
+              logger_,
+              storage_manager_,
+              array_,
+              config_,
+              buffers_,
+              subarray_,
+              layout_,
+              condition_);
+          reader->set_sample(sample_fraction_, sample_seed_);
+          reader->set_top_k(top_k_.has_value() ? &*top_k_ : nullptr);
+          strategy_ = tdb_unique_ptr<IQueryStrategy>(reader);
+        }
+        break;
+      }
+      case ReadStrategy::SPARSE_GLOBAL_ORDER:
+        // Using the reader for unordered queries to do deduplication.
         strategy_ = tdb_unique_ptr<IQueryStrategy>(tdb_new(
-            SparseUnorderedWithDupsReader<uint8_t>,
+            SparseGlobalOrderReader,
             stats_->create_child("Reader"),
             logger_,
             storage_manager_,
@@ -1075,9 +1659,10 @@ Status Query::create_strategy() {
             subarray_,
             layout_,
             condition_));
-      } else {
+        break;
+      case ReadStrategy::DENSE:
         strategy_ = tdb_unique_ptr<IQueryStrategy>(tdb_new(
-            SparseUnorderedWithDupsReader<uint64_t>,
+            DenseReader,
             stats_->create_child("Reader"),
             logger_,
             storage_manager_,
@@ -1087,34 +1672,10 @@ Status Query::create_strategy() {
             subarray_,
             layout_,
             condition_));
-      }
-    } else if (
-        use_refactored_sparse_global_order_reader() &&
-        !array_schema_->dense() &&
-        (layout_ == Layout::GLOBAL_ORDER ||
-         (layout_ == Layout::UNORDERED && subarray_.range_num() <= 1))) {
-      // Using the reader for unordered queries to do deduplication.
-      use_default = false;
-      strategy_ = tdb_unique_ptr<IQueryStrategy>(tdb_new(
-          SparseGlobalOrderReader,
-          stats_->create_child("Reader"),
-          logger_,
-          storage_manager_,
-          array_,
-          config_,
-          buffers_,
-          subarray_,
-          layout_,
-          condition_));
-    } else if (use_refactored_dense_reader() && array_schema_->dense()) {
-      bool all_dense = true;
-      for (auto& frag_md : fragment_metadata_)
-        all_dense &= frag_md->dense();
-
-      if (all_dense) {
-        use_default = false;
+        break;
+      case ReadStrategy::LEGACY:
         strategy_ = tdb_unique_ptr<IQueryStrategy>(tdb_new(
-            DenseReader,
+            Reader,
             stats_->create_child("Reader"),
             logger_,
             storage_manager_,
@@ -1124,12 +1685,74 @@ Status Query::create_strategy() {
             subarray_,
             layout_,
             condition_));
-      }
+        break;
     }
+  }
 
-    if (use_default) {
-      strategy_ = tdb_unique_ptr<IQueryStrategy>(tdb_new(
-          Reader,
+  if (strategy_ == nullptr)
+    return logger_->status(
+        Status_QueryError("Cannot create strategy; allocation failed"));
+
+  strategy_->set_progress(&progress_);
+
+  return Status::Ok();
+}
+
+Status Query::create_aggregate_strategy() {
+  // Aggregates are only computed by the refactored readers, the tile
+  // metadata they rely on is not used by the legacy reader.
+  ReaderBase* reader = nullptr;
+  if (array_schema_->dense()) {
+    for (auto& frag_md : fragment_metadata_) {
+      if (!frag_md->dense())
+        return logger_->status(
+            Status_QueryError("Cannot compute aggregates; Dense arrays with "
+                              "sparse fragments are not supported"));
+    }
+
+    auto dense_reader = tdb_new(
+        DenseReader,
+        stats_->create_child("Reader"),
+        logger_,
+        storage_manager_,
+        array_,
+        config_,
+        buffers_,
+        subarray_,
+        layout_,
+        condition_);
+    strategy_ = tdb_unique_ptr<IQueryStrategy>(dense_reader);
+    reader = dense_reader;
+  } else {
+    // Cells are not deduplicated, which is only correct when the array
+    // allows duplicates or when there is a single fragment.
+    if (!array_schema_->allows_dups() && fragment_metadata_.size() > 1)
+      return logger_->status(Status_QueryError(
+          "Cannot compute aggregates; Sparse arrays that do not allow "
+          "duplicates must have a single fragment, consolidate the array "
+          "first"));
+
+    auto&& [st, non_overlapping_ranges]{Query::non_overlapping_ranges()};
+    RETURN_NOT_OK(st);
+
+    if (*non_overlapping_ranges || !subarray_.is_set() ||
+        subarray_.range_num() == 1) {
+      auto sparse_reader = tdb_new(
+          SparseUnorderedWithDupsReader<uint8_t>,
+          stats_->create_child("Reader"),
+          logger_,
+          storage_manager_,
+          array_,
+          config_,
+          buffers_,
+          subarray_,
+          layout_,
+          condition_);
+      strategy_ = tdb_unique_ptr<IQueryStrategy>(sparse_reader);
+      reader = sparse_reader;
+    } else {
+      auto sparse_reader = tdb_new(
+          SparseUnorderedWithDupsReader<uint64_t>,
           stats_->create_child("Reader"),
           logger_,
           storage_manager_,
@@ -1138,17 +1761,51 @@ Status Query::create_strategy() {
           buffers_,
           subarray_,
           layout_,
-          condition_));
+          condition_);
+      strategy_ = tdb_unique_ptr<IQueryStrategy>(sparse_reader);
+      reader = sparse_reader;
     }
   }
 
-  if (strategy_ == nullptr)
-    return logger_->status(
-        Status_QueryError("Cannot create strategy; allocation failed"));
+  for (auto& aggregate : aggregates_)
+    aggregate.reset();
+  reader->set_aggregates(&aggregates_);
+  aggregate_groups_.clear();
+  if (!group_by_dim_.empty())
+    reader->set_aggregate_groups(
+        group_by_dim_, group_by_width_, &aggregate_groups_);
+  reader->set_sample(sample_fraction_, sample_seed_);
 
   return Status::Ok();
 }
 
+Query::ReadStrategy Query::read_strategy() {
+  // Aggregates are only computed by the refactored readers
+  if (!aggregates_.empty())
+    return array_schema_->dense() ? ReadStrategy::DENSE :
+                                    ReadStrategy::SPARSE_UNORDERED_WITH_DUPS;
+
+  if (use_refactored_sparse_unordered_reader() && !array_schema_->dense() &&
+      layout_ == Layout::UNORDERED)
+    return ReadStrategy::SPARSE_UNORDERED_WITH_DUPS;
+
+  if (use_refactored_sparse_global_order_reader() && !array_schema_->dense() &&
+      (layout_ == Layout::GLOBAL_ORDER ||
+       (layout_ == Layout::UNORDERED && subarray_.range_num() <= 1)))
+    return ReadStrategy::SPARSE_GLOBAL_ORDER;
+
+  if (use_refactored_dense_reader() && array_schema_->dense()) {
+    bool all_dense = true;
+    for (auto& frag_md : fragment_metadata_)
+      all_dense &= frag_md->dense();
+
+    if (all_dense)
+      return ReadStrategy::DENSE;
+  }
+
+  return ReadStrategy::LEGACY;
+}
+
 IQueryStrategy* Query::strategy() {
   if (strategy_ == nullptr) {
     create_strategy();
@@ -1831,9 +2488,10 @@ Status Query::set_layout(Layout layout) {
     return logger_->status(
         Status_QueryError("Cannot set layout after initialization"));
 
-  if (layout == Layout::HILBERT)
+  if (layout_is_curve(layout))
     return logger_->status(Status_QueryError(
-        "Cannot set layout; Hilbert order is not applicable to queries"));
+        "Cannot set layout; Hilbert and Morton orders are not applicable to "
+        "queries"));
 
   if (type_ == QueryType::WRITE && array_schema_->dense() &&
       layout == Layout::UNORDERED) {
@@ -1918,7 +2576,7 @@ Status Query::set_subarray(const void* subarray) {
 
   subarray_ = sub;
 
-  status_ = QueryStatus::UNINITIALIZED;
+  subarray_changed();
 
   return Status::Ok();
 }
@@ -1935,7 +2593,7 @@ Status Query::set_subarray_unsafe(const Subarray& subarray) {
 Status Query::set_subarray(const tiledb::sm::Subarray& subarray) {
   auto query_status = status();
   if (query_status != tiledb::sm::QueryStatus::UNINITIALIZED &&
-      query_status != tiledb::sm::QueryStatus::COMPLETED) {
+      query_status != tiledb::sm::QueryStatus::COMPLETED && !prepared_) {
     // Can be in this initialized state when query has been de-serialized
     // server-side and are trying to perform local submit.
     // Don't change anything and return indication of success.
@@ -1952,7 +2610,7 @@ Status Query::set_subarray(const tiledb::sm::Subarray& subarray) {
   subarray_ = subarray;
   subarray_.set_layout(prev_layout);
 
-  status_ = QueryStatus::UNINITIALIZED;
+  subarray_changed();
 
   return Status::Ok();
 }
@@ -1969,11 +2627,22 @@ Status Query::set_subarray_unsafe(const NDRange& subarray) {
   assert(layout_ == sub.layout());
   subarray_ = sub;
 
-  status_ = QueryStatus::UNINITIALIZED;
+  subarray_changed();
 
   return Status::Ok();
 }
 
+void Query::subarray_changed() {
+  if (prepared_ && strategy_ != nullptr &&
+      (status_ == QueryStatus::COMPLETED ||
+       status_ == QueryStatus::INPROGRESS)) {
+    rebind_ = true;
+    status_ = QueryStatus::INPROGRESS;
+  } else {
+    status_ = QueryStatus::UNINITIALIZED;
+  }
+}
+
 Status Query::check_buffers_correctness() {
   // Iterate through each attribute
   for (auto& attr : buffer_names()) {
@@ -2034,6 +2703,21 @@ Status Query::submit() {
       return logger_->status(Status_QueryError(
           "Error in query submission; remote array with no rest client."));
 
+    if (!aggregates_.empty())
+      return logger_->status(Status_QueryError(
+          "Error in query submission; aggregates are not supported on remote "
+          "arrays"));
+
+    if (sample_fraction_ < 1.0)
+      return logger_->status(Status_QueryError(
+          "Error in query submission; sampling is not supported on remote "
+          "arrays"));
+
+    if (top_k_.has_value())
+      return logger_->status(Status_QueryError(
+          "Error in query submission; top K is not supported on remote "
+          "arrays"));
+
     array_schema_->set_array_uri(array_->array_uri());
     if (status_ == QueryStatus::UNINITIALIZED) {
       RETURN_NOT_OK(create_strategy());
@@ -2041,6 +2725,12 @@ Status Query::submit() {
     }
     return rest_client->submit_query_to_rest(array_->array_uri(), this);
   }
+  if (managed_buffers_ != nullptr && !managed_buffers_->running()) {
+    auto st = managed_buffers_->run();
+    RETURN_NOT_OK_ELSE(st, logger_->status(st));
+    return Status::Ok();
+  }
+
   RETURN_NOT_OK(init());
   return storage_manager_->query_submit(this);
 }
@@ -2052,6 +2742,10 @@ Status Query::submit_async(
     callback(callback_data);
     return Status::Ok();
   }
+  if (managed_buffers_ != nullptr)
+    return logger_->status(Status_QueryError(
+        "Error in async query submission; async queries not supported with "
+        "managed buffers."));
   RETURN_NOT_OK(init());
   if (array_->is_remote())
     return logger_->status(
@@ -2063,6 +2757,141 @@ Status Query::submit_async(
   return storage_manager_->query_submit_async(this);
 }
 
+Status Query::submit_streaming(
+    const QueryStream::Callback& callback, uint64_t max_inflight_batches) {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot stream query; Operation only applicable to read queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(
+        Status_QueryError("Cannot stream query; Query already submitted"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_QueryError(
+        "Cannot stream query; Streaming is not supported for remote arrays"));
+
+  if (buffers_.empty())
+    return logger_->status(
+        Status_QueryError("Cannot stream query; No buffer is set"));
+
+  if (managed_buffers_ != nullptr)
+    return logger_->status(Status_QueryError(
+        "Cannot stream query; Streaming is not supported with managed "
+        "buffers"));
+
+  if (max_inflight_batches == 0)
+    return logger_->status(Status_QueryError(
+        "Cannot stream query; At least one batch must be in flight"));
+
+  QueryStream stream(this, max_inflight_batches);
+  stream_ = &stream;
+  auto st = stream.run(callback);
+  stream_ = nullptr;
+  RETURN_NOT_OK_ELSE(st, logger_->status(st));
+
+  return Status::Ok();
+}
+
+Status Query::get_stream_buffer(
+    const std::string& name,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size) const {
+  if (stream_ == nullptr || stream_->current_batch() == nullptr)
+    return logger_->status(Status_QueryError(
+        "Cannot get stream buffer; No batch is being consumed"));
+
+  const auto batch = stream_->current_batch();
+  auto it = batch->find(name);
+  if (it == batch->end())
+    return logger_->status(Status_QueryError(
+        "Cannot get stream buffer; No buffer is set for '" + name + "'"));
+
+  const auto& buffer = it->second;
+  *data = buffer.data_.data();
+  *data_size = buffer.data_size_;
+  *offsets = buffer.offsets_.empty() ? nullptr : buffer.offsets_.data();
+  *offsets_size = buffer.offsets_size_;
+  *validity = buffer.validity_.empty() ? nullptr : buffer.validity_.data();
+  *validity_size = buffer.validity_size_;
+  return Status::Ok();
+}
+
+Status Query::set_managed_buffer(const std::string& name) {
+  if (type_ != QueryType::READ)
+    return logger_->status(Status_QueryError(
+        "Cannot set managed buffer; Operation only applicable to read "
+        "queries"));
+
+  if (status_ != QueryStatus::UNINITIALIZED)
+    return logger_->status(Status_QueryError(
+        "Cannot set managed buffer; Query already submitted"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_QueryError(
+        "Cannot set managed buffer; Managed buffers are not supported for "
+        "remote arrays"));
+
+  if (!array_schema_->is_dim(name) && !array_schema_->is_attr(name))
+    return logger_->status(Status_QueryError(
+        "Cannot set managed buffer; Invalid attribute/dimension '" + name +
+        "'"));
+
+  if (managed_buffers_ == nullptr)
+    managed_buffers_ = tdb_unique_ptr<QueryManagedBuffers>(
+        tdb_new(QueryManagedBuffers, this));
+  managed_buffers_->add(name);
+
+  return Status::Ok();
+}
+
+Status Query::get_managed_buffer_chunk_num(uint64_t* chunk_num) const {
+  if (managed_buffers_ == nullptr)
+    return logger_->status(Status_QueryError(
+        "Cannot get managed buffer chunk number; No managed buffer is set"));
+
+  *chunk_num = managed_buffers_->chunk_num();
+  return Status::Ok();
+}
+
+Status Query::get_managed_buffer(
+    const std::string& name,
+    uint64_t chunk,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size) {
+  if (managed_buffers_ == nullptr)
+    return logger_->status(Status_QueryError(
+        "Cannot get managed buffer; No managed buffer is set"));
+
+  auto st = managed_buffers_->get(
+      name,
+      chunk,
+      data,
+      data_size,
+      offsets,
+      offsets_size,
+      validity,
+      validity_size);
+  RETURN_NOT_OK_ELSE(st, logger_->status(st));
+  return Status::Ok();
+}
+
+void Query::set_partial_results_callback(PartialResultsCallback callback) {
+  partial_results_callback_ = std::move(callback);
+}
+
+const Query::PartialResultsCallback& Query::partial_results_callback() const {
+  return partial_results_callback_;
+}
+
 QueryStatus Query::status() const {
   return status_;
 }
@@ -2086,10 +2915,22 @@ stats::Stats* Query::stats() const {
   return stats_;
 }
 
+const QueryProgress& Query::progress() const {
+  return progress_;
+}
+
 tdb_shared_ptr<Buffer> Query::rest_scratch() const {
   return rest_scratch_;
 }
 
+tdb_shared_ptr<RestPrefetch> Query::rest_prefetch() const {
+  return rest_prefetch_;
+}
+
+void Query::set_rest_prefetch(tdb_shared_ptr<RestPrefetch> rest_prefetch) {
+  rest_prefetch_ = std::move(rest_prefetch);
+}
+
 bool Query::use_refactored_dense_reader() {
   bool use_refactored_readers = false;
   bool found = false;
@@ -2158,6 +2999,21 @@ bool Query::use_refactored_sparse_unordered_with_dups_reader() {
   return val == "refactored";
 }
 
+bool Query::use_refactored_sparse_unordered_no_dups_reader() {
+  bool found = false;
+  const std::string& val =
+      config_.get("sm.query.sparse_unordered_no_dups.reader", &found);
+  assert(found);
+
+  return val == "refactored";
+}
+
+bool Query::use_refactored_sparse_unordered_reader() {
+  return array_schema_->allows_dups() ?
+             use_refactored_sparse_unordered_with_dups_reader() :
+             use_refactored_sparse_unordered_no_dups_reader();
+}
+
 std::tuple<Status, std::optional<bool>> Query::non_overlapping_ranges() {
   return subarray_.non_overlapping_ranges(storage_manager_->compute_tp());
 }
@@ -35,19 +35,26 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <sstream>
 #include <utility>
 #include <vector>
 
 #include "tiledb/common/logger_public.h"
 #include "tiledb/common/status.h"
+#include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/query_status_details.h"
 #include "tiledb/sm/fragment/written_fragment_info.h"
 #include "tiledb/sm/query/iquery_strategy.h"
+#include "tiledb/sm/query/query_aggregate.h"
+#include "tiledb/sm/query/query_top_k.h"
 #include "tiledb/sm/query/query_condition.h"
+#include "tiledb/sm/query/query_progress.h"
+#include "tiledb/sm/query/query_managed_buffers.h"
+#include "tiledb/sm/query/query_stream.h"
 #include "tiledb/sm/query/validity_vector.h"
 #include "tiledb/sm/subarray/subarray.h"
 
@@ -57,6 +64,7 @@ namespace tiledb {
 namespace sm {
 
 class Array;
+class RestPrefetch;
 class StorageManager;
 
 enum class QueryStatus : uint8_t;
@@ -69,6 +77,21 @@ class Query {
   /*          PUBLIC DATATYPES         */
   /* ********************************* */
 
+  /** The strategies a read query can be processed with. */
+  enum class ReadStrategy {
+    LEGACY,
+    DENSE,
+    SPARSE_GLOBAL_ORDER,
+    SPARSE_UNORDERED_WITH_DUPS
+  };
+
+  /**
+   * Function called with a buffer name and the sizes of its offsets, data
+   * and validity results received so far from a remote array.
+   */
+  using PartialResultsCallback = std::function<void(
+      const std::string&, uint64_t, uint64_t, uint64_t)>;
+
   /**
    * Contains any current state related to (de)serialization of this query.
    * Mostly this supports setting buffers on this query that were allocated
@@ -150,6 +173,120 @@ class Query {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Adds an aggregate to compute in a read query. A query with aggregates
+   * does not return any cell: it must not have any buffer set and the
+   * results are retrieved with `get_aggregate` once the query completes.
+   *
+   * @param field_name The attribute/dimension to aggregate.
+   * @param op The aggregate operator.
+   * @return Status
+   */
+  Status add_aggregate(const std::string& field_name, QueryAggregateOp op);
+
+  /**
+   * Retrieves the result of an aggregate of a completed query.
+   *
+   * @param field_name The aggregated attribute/dimension.
+   * @param op The aggregate operator.
+   * @param value The buffer to copy the result into.
+   * @param value_size On input, the size of `value`. On output, the size of
+   *     the result, zero if there is no result (e.g. MIN over no cell).
+   * @return Status
+   */
+  Status get_aggregate(
+      const std::string& field_name,
+      QueryAggregateOp op,
+      void* value,
+      uint64_t* value_size) const;
+
+  /**
+   * Groups the aggregates of a query on a sparse array by buckets of the
+   * values of a dimension: a cell with coordinate `x` falls in bucket
+   * `floor(x / bucket_width)`. The aggregates are then computed once per
+   * non-empty bucket and retrieved with `get_aggregate_bucket`. Tiles whose
+   * MBR lies within a single bucket are still answered from the tile
+   * metadata when possible.
+   *
+   * @param dim_name The integer or datetime dimension to group by.
+   * @param bucket_width The width of the buckets, in dimension units.
+   * @return Status
+   */
+  Status set_aggregate_group_by(
+      const std::string& dim_name, uint64_t bucket_width);
+
+  /**
+   * Retrieves the number of non-empty buckets of a completed query whose
+   * aggregates are grouped by a dimension.
+   *
+   * @param bucket_num Set to the number of buckets.
+   * @return Status
+   */
+  Status get_aggregate_bucket_num(uint64_t* bucket_num) const;
+
+  /**
+   * Retrieves the result of an aggregate for a bucket of a completed query
+   * whose aggregates are grouped by a dimension. The buckets are sorted in
+   * increasing order.
+   *
+   * @param bucket_idx The index of the bucket, smaller than the number of
+   *     buckets.
+   * @param field_name The aggregated attribute/dimension.
+   * @param op The aggregate operator.
+   * @param bucket Set to the bucket, i.e. `floor(x / bucket_width)` for the
+   *     cells `x` of the bucket.
+   * @param value The buffer to copy the result into.
+   * @param value_size On input, the size of `value`. On output, the size of
+   *     the result, zero if there is no result.
+   * @return Status
+   */
+  Status get_aggregate_bucket(
+      uint64_t bucket_idx,
+      const std::string& field_name,
+      QueryAggregateOp op,
+      int64_t* bucket,
+      void* value,
+      uint64_t* value_size) const;
+
+  /**
+   * Makes a sparse unordered read query return a random sample of the
+   * qualifying cells. Each cell is kept with probability `fraction`, and
+   * the tiles in which no cell is kept are not read. The sample only
+   * depends on `seed` and the cell positions, so the same query on the
+   * same opened array returns the same cells.
+   *
+   * @param fraction The fraction of the cells to sample, in (0, 1].
+   * @param seed The seed of the sample.
+   * @return Status
+   */
+  Status set_sample(double fraction, uint64_t seed);
+
+  /**
+   * Makes a sparse unordered read query return only the `k` cells with the
+   * largest (or smallest) values of an attribute. The query first scans the
+   * tiles for the top K cells, skipping the tiles whose tile metadata shows
+   * they cannot hold one, then reads and copies the selected cells. The
+   * cells are not returned in the order of the attribute.
+   *
+   * @param field_name The fixed size attribute to order on.
+   * @param k The number of cells to return.
+   * @param largest True to return the largest values, false for the
+   *     smallest.
+   * @return Status
+   */
+  Status set_top_k(const std::string& field_name, uint64_t k, bool largest);
+
+  /**
+   * Makes a dense write query write a part of a fragment written in parts,
+   * which concurrent queries write the other parts of. The fragment is
+   * visible once its parts are committed together.
+   *
+   * @param fragment_uri The URI of the fragment written in parts.
+   * @param part The number of the part, unique within the fragment.
+   * @return Status
+   */
+  Status set_fragment_part(const URI& fragment_uri, uint32_t part);
+
   /**
    * Adds a range to the (read/write) query on the input dimension by index,
    * in the form of (start, end, stride).
@@ -326,6 +463,38 @@ class Query {
       uint64_t* size_val,
       uint64_t* size_validity);
 
+  /**
+   * Gets the estimated result sizes (in bytes) for the input
+   * attribute/dimension, accounting for the query condition through the
+   * tile metadata. See `Subarray::get_est_result_size_condition`.
+   */
+  Status get_est_result_size_condition(
+      const char* name,
+      uint64_t* size_fixed,
+      uint64_t* size_var,
+      uint64_t* size_validity);
+
+  /**
+   * Runs the setup phase of a read query without reading any tile and
+   * describes what processing it would take, as a JSON object with:
+   *
+   * - `reader`: the strategy the query would be processed with.
+   * - `fragment_num`, `relevant_fragment_num`, `range_num` and `tile_num`:
+   *   the fragments, subarray ranges and unique fragment tiles involved.
+   * - `fields`: per attribute/dimension (the ones with buffers set, or all
+   *   of them if none is set), the estimated result size, the maximum
+   *   in-memory size of the overlapping tiles and their persisted (i.e.,
+   *   filtered and possibly compressed) size in bytes.
+   * - `est_memory`: the bytes needed to hold the tile overlap and the
+   *   overlapping tiles of all fields in memory.
+   * - `partition_num` and `unsplittable`: the partitions the subarray is
+   *   split into for the set buffers, only for the legacy reader.
+   *
+   * @param plan The output JSON string.
+   * @return Status
+   */
+  Status explain(std::string* plan);
+
   /** Retrieves the number of written fragments. */
   Status get_written_fragment_num(uint32_t* num) const;
 
@@ -365,6 +534,14 @@ class Query {
    */
   Status cancel();
 
+  /**
+   * Requests the cancellation of the query. It is safe to call from another
+   * thread while the query is in progress: the query stops at the next tile
+   * and its status becomes `QueryStatus::CANCELLED`. A cancelled query
+   * cannot be submitted again.
+   */
+  void request_cancellation();
+
   /**
    * Finalizes the query, flushing all internal state. Applicable only to global
    * layout writes. It has no effect for any other query type.
@@ -527,6 +704,17 @@ class Query {
   /** Initializes the query. */
   Status init();
 
+  /**
+   * Prepares a read query to be executed repeatedly. The query is
+   * validated and its reader is created once. Setting a new subarray on a
+   * completed prepared query then keeps the reader, with its memory budget,
+   * loaded tile offsets and tile buffers, and the next submission only
+   * rebinds the subarray and the buffers.
+   *
+   * @return Status
+   */
+  Status prepare();
+
   /** Returns the first fragment uri. */
   URI first_fragment_uri() const;
 
@@ -548,6 +736,27 @@ class Query {
   /** Create the strategy. */
   Status create_strategy();
 
+  /** Create the strategy for a query computing aggregates. */
+  Status create_aggregate_strategy();
+
+  /**
+   * Picks the strategy a read query is processed with, based on the
+   * array, the layout, the aggregates and the `sm.query.*.reader`
+   * config parameters.
+   */
+  ReadStrategy read_strategy();
+
+  /**
+   * Counts the partitions the subarray is split into by the legacy reader
+   * for the result budgets of the set buffers.
+   *
+   * @param partition_num The number of partitions.
+   * @param unsplittable Set to `true` if partitioning stopped at a
+   *     partition that cannot be split to fit the budgets.
+   * @return Status
+   */
+  Status count_partitions(uint64_t* partition_num, bool* unsplittable);
+
   /** Gets the strategy of the query. */
   IQueryStrategy* strategy();
 
@@ -856,6 +1065,100 @@ class Query {
    */
   Status submit_async(std::function<void(void*)> callback, void* callback_data);
 
+  /**
+   * Submits a read query until it completes, streaming the results to
+   * `callback` in batches of buffers owned by the query, sized like the
+   * buffers set by the user. The query is resubmitted into the next batch
+   * while the callback consumes the previous ones, with at most
+   * `max_inflight_batches` batches in flight. The callback retrieves the
+   * results with `get_stream_buffer`, and stops the stream by returning a
+   * status other than Ok. The user buffers are never written to.
+   *
+   * @param callback The function called with each batch, on a single
+   *     thread and in the order of the results.
+   * @param max_inflight_batches The maximum number of batches in flight.
+   * @return Status
+   */
+  Status submit_streaming(
+      const QueryStream::Callback& callback, uint64_t max_inflight_batches);
+
+  /**
+   * Retrieves the results of a buffer in the batch being consumed by the
+   * callback of `submit_streaming`. The pointers are valid until the
+   * callback returns.
+   *
+   * @param name The buffer name.
+   * @param data Set to the data, or the var-sized data.
+   * @param data_size Set to the size of `data`.
+   * @param offsets Set to the offsets of a var-sized field, else `nullptr`.
+   * @param offsets_size Set to the size of `offsets`.
+   * @param validity Set to the validity of a nullable field, else `nullptr`.
+   * @param validity_size Set to the size of `validity`.
+   * @return Status
+   */
+  Status get_stream_buffer(
+      const std::string& name,
+      const void** data,
+      uint64_t* data_size,
+      const void** offsets,
+      uint64_t* offsets_size,
+      const uint8_t** validity,
+      uint64_t* validity_size) const;
+
+  /**
+   * Lets the library allocate the result buffers of `name` for a read
+   * query, in chunks grown until the query completes or reaches the memory
+   * budget (see `QueryManagedBuffers`). The buffers of all the fields of
+   * the query must then be managed, and the results are retrieved with
+   * `get_managed_buffer` after each submission.
+   *
+   * @param name The attribute/dimension name.
+   * @return Status
+   */
+  Status set_managed_buffer(const std::string& name);
+
+  /**
+   * Retrieves the number of chunks of the managed buffers holding the
+   * results of the last submission.
+   */
+  Status get_managed_buffer_chunk_num(uint64_t* chunk_num) const;
+
+  /**
+   * Retrieves the results of a managed buffer in a chunk. The pointers are
+   * valid until the query is resubmitted or destroyed.
+   *
+   * @param name The buffer name.
+   * @param chunk The chunk index.
+   * @param data Set to the data, or the var-sized data.
+   * @param data_size Set to the size of `data`.
+   * @param offsets Set to the offsets of a var-sized field, else `nullptr`.
+   * @param offsets_size Set to the size of `offsets`.
+   * @param validity Set to the validity of a nullable field, else `nullptr`.
+   * @param validity_size Set to the size of `validity`.
+   * @return Status
+   */
+  Status get_managed_buffer(
+      const std::string& name,
+      uint64_t chunk,
+      const void** data,
+      uint64_t* data_size,
+      const void** offsets,
+      uint64_t* offsets_size,
+      const uint8_t** validity,
+      uint64_t* validity_size);
+
+  /**
+   * Sets a function called for every buffer of a query on a remote array,
+   * each time a chunk of the server response has been copied into the user
+   * buffers. It receives the buffer name and the bytes of its offsets, data
+   * and validity buffers filled so far in the current submission, which
+   * are final and can be consumed before the submission completes.
+   */
+  void set_partial_results_callback(PartialResultsCallback callback);
+
+  /** Returns the function set with `set_partial_results_callback`. */
+  const PartialResultsCallback& partial_results_callback() const;
+
   /** Returns the query status. */
   QueryStatus status() const;
 
@@ -868,9 +1171,21 @@ class Query {
   /** Returns the internal stats object. */
   stats::Stats* stats() const;
 
+  /**
+   * Returns the progress of the query, which may be polled from another
+   * thread while the query is submitted.
+   */
+  const QueryProgress& progress() const;
+
   /** Returns the scratch space used for REST requests. */
   tdb_shared_ptr<Buffer> rest_scratch() const;
 
+  /** Returns the prefetched submission of a remote read, if any. */
+  tdb_shared_ptr<RestPrefetch> rest_prefetch() const;
+
+  /** Sets the prefetched submission of a remote read. */
+  void set_rest_prefetch(tdb_shared_ptr<RestPrefetch> rest_prefetch);
+
   /** Use the refactored dense reader or not. */
   bool use_refactored_dense_reader();
 
@@ -880,6 +1195,12 @@ class Query {
   /** Use the refactored sparse unordered with dups reader or not. */
   bool use_refactored_sparse_unordered_with_dups_reader();
 
+  /** Use the refactored sparse unordered reader for arrays without dups. */
+  bool use_refactored_sparse_unordered_no_dups_reader();
+
+  /** Use the refactored sparse unordered reader for this array or not. */
+  bool use_refactored_sparse_unordered_reader();
+
   /** Returns if all ranges for this query are non overlapping. */
   std::tuple<Status, std::optional<bool>> non_overlapping_ranges();
 
@@ -903,6 +1224,9 @@ class Query {
   /** The data input to the callback function. */
   void* callback_data_;
 
+  /** A function called as partial results of remote queries arrive. */
+  PartialResultsCallback partial_results_callback_;
+
   /** The layout of the cells in the result of the subarray. */
   Layout layout_;
 
@@ -915,6 +1239,12 @@ class Query {
   /** The storage manager. */
   StorageManager* storage_manager_;
 
+  /**
+   * Cancels the query explicitly or at its deadline, shared with the tasks
+   * the query schedules.
+   */
+  tdb_shared_ptr<CancellationToken> cancellation_token_;
+
   /** The query type. */
   QueryType type_;
 
@@ -930,6 +1260,12 @@ class Query {
   /** UID of the logger instance */
   inline static std::atomic<uint64_t> logger_id_ = 0;
 
+  /** The id of the query in the spans of the global tracer. */
+  const uint64_t trace_id_;
+
+  /** The progress of the query, accumulated over its submissions. */
+  QueryProgress progress_;
+
   /**
    * Maps attribute/dimension names to their buffers.
    * `TILEDB_COORDS` may be used for the special zipped coordinates
@@ -946,6 +1282,39 @@ class Query {
   /** The query condition. */
   QueryCondition condition_;
 
+  /** The aggregates computed by the query. */
+  std::vector<QueryAggregate> aggregates_;
+
+  /** The dimension the aggregates are grouped by, empty if none. */
+  std::string group_by_dim_;
+
+  /** The width of the buckets the aggregates are grouped by. */
+  uint64_t group_by_width_;
+
+  /** The aggregates of each non-empty bucket, when grouped by a dimension. */
+  std::map<int64_t, std::vector<QueryAggregate>> aggregate_groups_;
+
+  /** The fraction of the cells to sample, 1 when not sampling. */
+  double sample_fraction_;
+
+  /** The seed of the sample. */
+  uint64_t sample_seed_;
+
+  /** The top K selection, if the query has one. */
+  std::optional<QueryTopK> top_k_;
+
+  /** The stream run by `submit_streaming`, `nullptr` otherwise. */
+  QueryStream* stream_;
+
+  /** The managed result buffers, `nullptr` if there are none. */
+  tdb_unique_ptr<QueryManagedBuffers> managed_buffers_;
+
+  /** True if the query was prepared to be executed repeatedly. */
+  bool prepared_;
+
+  /** True if the strategy must be rebound before the next execution. */
+  bool rebind_;
+
   /** The fragment metadata that this query will focus on. */
   std::vector<tdb_shared_ptr<FragmentMetadata>> fragment_metadata_;
 
@@ -985,6 +1354,9 @@ class Query {
   /* Scratch space used for REST requests. */
   tdb_shared_ptr<Buffer> rest_scratch_;
 
+  /** The prefetched submission of the next partition of a remote read. */
+  tdb_shared_ptr<RestPrefetch> rest_prefetch_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -994,6 +1366,13 @@ class Query {
   /** Checks if the buffers names have been appropriately set for the query. */
   Status check_buffer_names();
 
+  /**
+   * Updates the status after the subarray changed. A prepared query that
+   * is not in the middle of a read keeps its strategy, which is rebound on
+   * the next submission. Other queries create their strategy again.
+   */
+  void subarray_changed();
+
   /**
    * Internal routine for checking the completeness of all attribute
    * and dimensions buffers. Iteratively searches that all attributes &
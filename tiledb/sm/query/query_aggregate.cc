@@ -0,0 +1,489 @@
+/**
+ * @file   query_aggregate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the QueryAggregate class.
+ */
+
+#include "tiledb/sm/query/query_aggregate.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
+#include "tiledb/sm/query/result_tile.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/**
+ * Calls `fn` with a value of the C++ type matching `type`. Returns an error
+ * for the types that cannot be summed or compared as a single value.
+ */
+template <class Fn>
+Status apply_with_type(const Datatype type, Fn&& fn) {
+  return sm::apply_with_type(type, std::forward<Fn>(fn), [type]() {
+    return Status_QueryError(
+        "Cannot aggregate; Unsupported datatype " + datatype_str(type));
+  });
+}
+
+/** Adds `value` to `sum`, saturating the same way the tile metadata does. */
+template <class SUM_T>
+void add_saturating(SUM_T* sum, const SUM_T value) {
+  if constexpr (std::is_same<SUM_T, int64_t>::value) {
+    if (*sum > 0 && value > 0 &&
+        (*sum > std::numeric_limits<int64_t>::max() - value)) {
+      *sum = std::numeric_limits<int64_t>::max();
+      return;
+    }
+
+    if (*sum < 0 && value < 0 &&
+        (*sum < std::numeric_limits<int64_t>::min() - value)) {
+      *sum = std::numeric_limits<int64_t>::min();
+      return;
+    }
+  } else if constexpr (std::is_same<SUM_T, uint64_t>::value) {
+    if (*sum > std::numeric_limits<uint64_t>::max() - value) {
+      *sum = std::numeric_limits<uint64_t>::max();
+      return;
+    }
+  }
+
+  *sum += value;
+}
+
+/**
+ * Adds `count` times `value` to `sum`, saturating as if the value were added
+ * one at a time.
+ */
+template <class SUM_T>
+void add_saturating(SUM_T* sum, const SUM_T value, const uint64_t count) {
+  if constexpr (std::is_same<SUM_T, int64_t>::value) {
+    // The partial sums are monotonic, so only the final sum may saturate.
+    const auto current = static_cast<uint64_t>(*sum);
+    if (value >= 0) {
+      const uint64_t room =
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - current;
+      if (value != 0 && count > room / static_cast<uint64_t>(value)) {
+        *sum = std::numeric_limits<int64_t>::max();
+        return;
+      }
+      *sum = static_cast<int64_t>(
+          current + static_cast<uint64_t>(value) * count);
+    } else {
+      const uint64_t room =
+          current - static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
+      const uint64_t magnitude = uint64_t(0) - static_cast<uint64_t>(value);
+      if (count > room / magnitude) {
+        *sum = std::numeric_limits<int64_t>::min();
+        return;
+      }
+      *sum = static_cast<int64_t>(current - magnitude * count);
+    }
+  } else if constexpr (std::is_same<SUM_T, uint64_t>::value) {
+    if (value != 0 &&
+        count > (std::numeric_limits<uint64_t>::max() - *sum) / value) {
+      *sum = std::numeric_limits<uint64_t>::max();
+      return;
+    }
+    *sum += value * count;
+  } else {
+    *sum += value * static_cast<SUM_T>(count);
+  }
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+QueryAggregate::QueryAggregate(
+    const std::string& field_name, QueryAggregateOp op)
+    : field_name_(field_name)
+    , op_(op)
+    , type_(Datatype::ANY)
+    , nullable_(false)
+    , run_encoded_(false)
+    , count_(0)
+    , has_value_(false)
+    , value_(0) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status QueryAggregate::init(const ArraySchema* array_schema) {
+  if (!array_schema->is_field(field_name_))
+    return Status_QueryError(
+        "Cannot add aggregate; Unknown field '" + field_name_ + "'");
+
+  type_ = array_schema->type(field_name_);
+  nullable_ = array_schema->is_nullable(field_name_);
+
+  if (op_ == QueryAggregateOp::AGGREGATE_SUM ||
+      op_ == QueryAggregateOp::AGGREGATE_MIN ||
+      op_ == QueryAggregateOp::AGGREGATE_MAX) {
+    if (!array_schema->is_attr(field_name_))
+      return Status_QueryError(
+          "Cannot add aggregate; " + query_aggregate_op_str(op_) +
+          " is only supported on attributes");
+
+    if (array_schema->var_size(field_name_) ||
+        array_schema->cell_val_num(field_name_) != 1)
+      return Status_QueryError(
+          "Cannot add aggregate; " + query_aggregate_op_str(op_) +
+          " requires a fixed size attribute with one value per cell");
+
+    RETURN_NOT_OK(apply_with_type(type_, [](auto) { return Status::Ok(); }));
+
+    run_encoded_ = array_schema->attribute(field_name_)->filters().has_filter(
+        FilterType::FILTER_RLE);
+  }
+
+  reset();
+  return Status::Ok();
+}
+
+void QueryAggregate::reset() {
+  count_ = 0;
+  has_value_ = false;
+  value_ = 0;
+}
+
+const std::string& QueryAggregate::field_name() const {
+  return field_name_;
+}
+
+QueryAggregateOp QueryAggregate::op() const {
+  return op_;
+}
+
+bool QueryAggregate::needs_data() const {
+  switch (op_) {
+    case QueryAggregateOp::AGGREGATE_COUNT:
+      return false;
+    case QueryAggregateOp::AGGREGATE_NULL_COUNT:
+      return nullable_;
+    default:
+      return true;
+  }
+}
+
+bool QueryAggregate::needs_tile_min_max() const {
+  return op_ == QueryAggregateOp::AGGREGATE_MIN ||
+         op_ == QueryAggregateOp::AGGREGATE_MAX;
+}
+
+bool QueryAggregate::needs_tile_sum() const {
+  return op_ == QueryAggregateOp::AGGREGATE_SUM;
+}
+
+bool QueryAggregate::needs_tile_null_count() const {
+  // Sum, min and max need the null count to detect tiles without any
+  // non-null value.
+  return nullable_ && op_ != QueryAggregateOp::AGGREGATE_COUNT;
+}
+
+bool QueryAggregate::has_tile_metadata(const FragmentMetadata* fragment) const {
+  if (op_ == QueryAggregateOp::AGGREGATE_COUNT)
+    return true;
+
+  // Tile metadata was introduced in format version 11.
+  if (fragment->format_version() <= 10)
+    return false;
+
+  return fragment->array_schema()->is_field(field_name_);
+}
+
+Status QueryAggregate::aggregate_tile_metadata(
+    FragmentMetadata* fragment, uint64_t tile_idx) {
+  const auto cell_num = fragment->cell_num(tile_idx);
+  if (op_ == QueryAggregateOp::AGGREGATE_COUNT) {
+    count_ += cell_num;
+    return Status::Ok();
+  }
+
+  uint64_t null_count = 0;
+  if (needs_tile_null_count()) {
+    auto&& [st, tile_null_count] =
+        fragment->get_tile_null_count(field_name_, tile_idx);
+    RETURN_NOT_OK(st);
+    null_count = *tile_null_count;
+  }
+
+  if (op_ == QueryAggregateOp::AGGREGATE_NULL_COUNT) {
+    count_ += null_count;
+    return Status::Ok();
+  }
+
+  // No non-null value in this tile.
+  if (null_count == cell_num)
+    return Status::Ok();
+
+  return apply_with_type(type_, [&](auto t) {
+    using T = decltype(t);
+    return aggregate_tile_metadata<T>(fragment, tile_idx);
+  });
+}
+
+template <class BitmapType>
+Status QueryAggregate::aggregate_tile(
+    ResultTile* result_tile,
+    uint64_t cell_num,
+    const std::vector<BitmapType>& bitmap) {
+  if (!needs_data()) {
+    if (op_ == QueryAggregateOp::AGGREGATE_COUNT) {
+      if (bitmap.empty()) {
+        count_ += cell_num;
+      } else {
+        for (uint64_t c = 0; c < cell_num; c++)
+          count_ += bitmap[c];
+      }
+    }
+
+    return Status::Ok();
+  }
+
+  // The field is not present in this fragment, it does not contribute.
+  auto tile_tuple = result_tile->tile_tuple(field_name_);
+  if (tile_tuple == nullptr)
+    return Status::Ok();
+
+  const auto& tile = std::get<0>(*tile_tuple);
+  const uint8_t* validity =
+      nullable_ ? std::get<2>(*tile_tuple).data_as<uint8_t>() : nullptr;
+
+  if (op_ == QueryAggregateOp::AGGREGATE_NULL_COUNT) {
+    for (uint64_t c = 0; c < cell_num; c++) {
+      if (validity[c] == 0)
+        count_ += bitmap.empty() ? 1 : bitmap[c];
+    }
+
+    return Status::Ok();
+  }
+
+  return apply_with_type(type_, [&](auto t) {
+    using T = decltype(t);
+    aggregate_tile<T, BitmapType>(
+        tile.data_as<T>(), validity, cell_num, bitmap);
+    return Status::Ok();
+  });
+}
+
+Status QueryAggregate::merge(const QueryAggregate& other) {
+  if (other.op_ != op_ || other.field_name_ != field_name_)
+    return Status_QueryError("Cannot merge aggregates; Mismatched aggregates");
+
+  count_ += other.count_;
+  if (!other.has_value_)
+    return Status::Ok();
+
+  return apply_with_type(type_, [&](auto t) {
+    using T = decltype(t);
+    merge<T>(other);
+    return Status::Ok();
+  });
+}
+
+uint64_t QueryAggregate::result_size() const {
+  switch (op_) {
+    case QueryAggregateOp::AGGREGATE_COUNT:
+    case QueryAggregateOp::AGGREGATE_NULL_COUNT:
+      return sizeof(uint64_t);
+    case QueryAggregateOp::AGGREGATE_SUM:
+      return has_value_ ? sizeof(uint64_t) : 0;
+    default:
+      return has_value_ ? datatype_size(type_) : 0;
+  }
+}
+
+Status QueryAggregate::get_result(void* value, uint64_t* value_size) const {
+  const auto size = result_size();
+  if (*value_size < size)
+    return Status_QueryError(
+        "Cannot get aggregate result; Buffer too small for " +
+        query_aggregate_op_str(op_) + " on '" + field_name_ + "'");
+
+  if (op_ == QueryAggregateOp::AGGREGATE_COUNT ||
+      op_ == QueryAggregateOp::AGGREGATE_NULL_COUNT) {
+    std::memcpy(value, &count_, size);
+  } else if (size != 0) {
+    std::memcpy(value, &value_, size);
+  }
+
+  *value_size = size;
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+template <class T>
+void QueryAggregate::fold_value(const T value) {
+  if (op_ == QueryAggregateOp::AGGREGATE_SUM) {
+    using SUM_T = typename metadata_generator_type_data<T>::sum_type;
+    SUM_T sum;
+    std::memcpy(&sum, &value_, sizeof(SUM_T));
+    add_saturating<SUM_T>(&sum, static_cast<SUM_T>(value));
+    std::memcpy(&value_, &sum, sizeof(SUM_T));
+  } else {
+    T current;
+    std::memcpy(&current, &value_, sizeof(T));
+    if (!has_value_ ||
+        (op_ == QueryAggregateOp::AGGREGATE_MIN ? value < current :
+                                                  value > current))
+      std::memcpy(&value_, &value, sizeof(T));
+  }
+
+  has_value_ = true;
+}
+
+template <class T>
+void QueryAggregate::fold_run(const T value, uint64_t count) {
+  if (op_ == QueryAggregateOp::AGGREGATE_SUM) {
+    using SUM_T = typename metadata_generator_type_data<T>::sum_type;
+    SUM_T sum;
+    std::memcpy(&sum, &value_, sizeof(SUM_T));
+    add_saturating<SUM_T>(&sum, static_cast<SUM_T>(value), count);
+    std::memcpy(&value_, &sum, sizeof(SUM_T));
+    has_value_ = true;
+  } else {
+    // Min and max are not affected by the cell multiplicity.
+    fold_value<T>(value);
+  }
+}
+
+template <class T>
+void QueryAggregate::fold_sum(const void* sum) {
+  using SUM_T = typename metadata_generator_type_data<T>::sum_type;
+  SUM_T current, tile_sum;
+  std::memcpy(&current, &value_, sizeof(SUM_T));
+  std::memcpy(&tile_sum, sum, sizeof(SUM_T));
+  add_saturating<SUM_T>(&current, tile_sum);
+  std::memcpy(&value_, &current, sizeof(SUM_T));
+  has_value_ = true;
+}
+
+template <class T, class BitmapType>
+void QueryAggregate::aggregate_tile(
+    const T* values,
+    const uint8_t* validity,
+    uint64_t cell_num,
+    const std::vector<BitmapType>& bitmap) {
+  // Fold each run of equal cells once for run-length encoded fields.
+  if (run_encoded_) {
+    uint64_t c = 0;
+    while (c < cell_num) {
+      const bool valid = validity == nullptr || validity[c] != 0;
+      uint64_t count = 0;
+      uint64_t end = c;
+      while (end < cell_num && values[end] == values[c] &&
+             (validity == nullptr || (validity[end] != 0) == valid)) {
+        count += bitmap.empty() ? 1 : bitmap[end];
+        ++end;
+      }
+
+      // A value that is not equal to itself (NaN) ends its own run.
+      if (end == c) {
+        count = bitmap.empty() ? 1 : bitmap[c];
+        end = c + 1;
+      }
+
+      if (valid && count != 0)
+        fold_run<T>(values[c], count);
+      c = end;
+    }
+    return;
+  }
+
+  const bool is_sum = op_ == QueryAggregateOp::AGGREGATE_SUM;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    const uint64_t count = bitmap.empty() ? 1 : bitmap[c];
+    if (count == 0 || (validity != nullptr && validity[c] == 0))
+      continue;
+
+    // Min and max are not affected by the cell multiplicity.
+    const uint64_t fold_num = is_sum ? count : 1;
+    for (uint64_t i = 0; i < fold_num; i++)
+      fold_value<T>(values[c]);
+  }
+}
+
+template <class T>
+Status QueryAggregate::aggregate_tile_metadata(
+    FragmentMetadata* fragment, uint64_t tile_idx) {
+  if (op_ == QueryAggregateOp::AGGREGATE_SUM) {
+    auto&& [st, sum] = fragment->get_tile_sum(field_name_, tile_idx);
+    RETURN_NOT_OK(st);
+    fold_sum<T>(*sum);
+  } else if (op_ == QueryAggregateOp::AGGREGATE_MIN) {
+    auto&& [st, min, min_size] = fragment->get_tile_min(field_name_, tile_idx);
+    RETURN_NOT_OK(st);
+    fold_value<T>(*static_cast<const T*>(*min));
+  } else {
+    auto&& [st, max, max_size] = fragment->get_tile_max(field_name_, tile_idx);
+    RETURN_NOT_OK(st);
+    fold_value<T>(*static_cast<const T*>(*max));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+void QueryAggregate::merge(const QueryAggregate& other) {
+  if (op_ == QueryAggregateOp::AGGREGATE_SUM) {
+    fold_sum<T>(&other.value_);
+  } else {
+    T value;
+    std::memcpy(&value, &other.value_, sizeof(T));
+    fold_value<T>(value);
+  }
+}
+
+// Explicit template instantiations
+template Status QueryAggregate::aggregate_tile<uint8_t>(
+    ResultTile*, uint64_t, const std::vector<uint8_t>&);
+template Status QueryAggregate::aggregate_tile<uint64_t>(
+    ResultTile*, uint64_t, const std::vector<uint64_t>&);
+
+}  // namespace sm
+}  // namespace tiledb
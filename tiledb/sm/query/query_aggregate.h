@@ -0,0 +1,254 @@
+/**
+ * @file   query_aggregate.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines the QueryAggregate class.
+ */
+
+#ifndef TILEDB_QUERY_AGGREGATE_H
+#define TILEDB_QUERY_AGGREGATE_H
+
+#include <string>
+#include <vector>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/enums/query_aggregate_op.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class FragmentMetadata;
+class ResultTile;
+enum class Datatype : uint8_t;
+
+/**
+ * Accumulates a single aggregate (COUNT, SUM, MIN, MAX or NULL_COUNT) over
+ * the cells of a read query. Tiles that are fully covered by the query are
+ * folded in from the tile metadata stored in the fragment metadata, the
+ * remaining tiles are folded in cell by cell.
+ */
+class QueryAggregate {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  QueryAggregate(const std::string& field_name, QueryAggregateOp op);
+
+  /** Copy constructor. */
+  QueryAggregate(const QueryAggregate& rhs) = default;
+
+  /** Move constructor. */
+  QueryAggregate(QueryAggregate&& rhs) = default;
+
+  /** Destructor. */
+  ~QueryAggregate() = default;
+
+  /* ********************************* */
+  /*             OPERATORS             */
+  /* ********************************* */
+
+  /** Assignment operator. */
+  QueryAggregate& operator=(const QueryAggregate& rhs) = default;
+
+  /** Move-assignment operator. */
+  QueryAggregate& operator=(QueryAggregate&& rhs) = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Verifies that the aggregate is valid for the input array schema and
+   * caches the field properties used by the accumulators.
+   *
+   * @param array_schema The current array schema.
+   * @return Status
+   */
+  Status init(const ArraySchema* array_schema);
+
+  /** Resets the accumulated result. */
+  void reset();
+
+  /** Returns the name of the aggregated field. */
+  const std::string& field_name() const;
+
+  /** Returns the aggregate operator. */
+  QueryAggregateOp op() const;
+
+  /**
+   * Returns true if computing the aggregate from cells requires reading the
+   * data of the field. This is false for COUNT, which only needs the number
+   * of result cells.
+   */
+  bool needs_data() const;
+
+  /** Returns true if the tile min/max values are required from metadata. */
+  bool needs_tile_min_max() const;
+
+  /** Returns true if the tile sum values are required from metadata. */
+  bool needs_tile_sum() const;
+
+  /** Returns true if the tile null counts are required from metadata. */
+  bool needs_tile_null_count() const;
+
+  /**
+   * Returns true if the tile metadata needed by this aggregate is available
+   * in the input fragment.
+   */
+  bool has_tile_metadata(const FragmentMetadata* fragment) const;
+
+  /**
+   * Folds a tile that is fully covered by the query into the aggregate,
+   * using only the tile metadata that was previously loaded for the
+   * fragment.
+   *
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status
+   */
+  Status aggregate_tile_metadata(FragmentMetadata* fragment, uint64_t tile_idx);
+
+  /**
+   * Folds the cells of a tile into the aggregate. Each cell `c` is counted
+   * `bitmap[c]` times. An empty bitmap means all cells in the tile are
+   * included exactly once.
+   *
+   * @tparam BitmapType The bitmap type.
+   * @param result_tile The result tile, with the field data loaded when
+   *     `needs_data()` is true.
+   * @param cell_num The number of cells in the tile.
+   * @param bitmap The cell multiplicities.
+   * @return Status
+   */
+  template <class BitmapType>
+  Status aggregate_tile(
+      ResultTile* result_tile,
+      uint64_t cell_num,
+      const std::vector<BitmapType>& bitmap);
+
+  /** Merges the partial result of another aggregate into this one. */
+  Status merge(const QueryAggregate& other);
+
+  /**
+   * Returns the size in bytes of the result. This is zero for MIN and MAX
+   * aggregates that did not see a non-null value.
+   */
+  uint64_t result_size() const;
+
+  /**
+   * Copies the result into `value`. On input `value_size` holds the size of
+   * the buffer, on output it holds the size of the result.
+   *
+   * The result is a `uint64_t` for COUNT and NULL_COUNT, the saturated
+   * `int64_t`, `uint64_t` or `double` sum for SUM, and a value of the field
+   * type for MIN and MAX.
+   *
+   * @param value The output buffer.
+   * @param value_size The size of the output buffer.
+   * @return Status
+   */
+  Status get_result(void* value, uint64_t* value_size) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The name of the aggregated field. */
+  std::string field_name_;
+
+  /** The aggregate operator. */
+  QueryAggregateOp op_;
+
+  /** The datatype of the field. */
+  Datatype type_;
+
+  /** Whether the field is nullable. */
+  bool nullable_;
+
+  /**
+   * Whether the field is run-length encoded, in which case its tiles are
+   * folded in one run of equal cells at a time.
+   */
+  bool run_encoded_;
+
+  /** Number of cells (COUNT) or null cells (NULL_COUNT) accumulated. */
+  uint64_t count_;
+
+  /** Set to true once MIN/MAX have seen at least one non-null value. */
+  bool has_value_;
+
+  /**
+   * The running sum, min or max. Every supported type fits in 8 bytes; sums
+   * are stored as the `int64_t`, `uint64_t` or `double` type used by the
+   * tile metadata.
+   */
+  uint64_t value_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Folds a single value of type `T` into the sum, min or max. */
+  template <class T>
+  void fold_value(const T value);
+
+  /** Folds `count` times the same value of type `T` into the aggregate. */
+  template <class T>
+  void fold_run(const T value, uint64_t count);
+
+  /** Folds a precomputed sum into the sum. */
+  template <class T>
+  void fold_sum(const void* sum);
+
+  /** Typed implementation of `aggregate_tile`. */
+  template <class T, class BitmapType>
+  void aggregate_tile(
+      const T* values,
+      const uint8_t* validity,
+      uint64_t cell_num,
+      const std::vector<BitmapType>& bitmap);
+
+  /** Typed implementation of `aggregate_tile_metadata` for sum/min/max. */
+  template <class T>
+  Status aggregate_tile_metadata(FragmentMetadata* fragment, uint64_t tile_idx);
+
+  /** Typed implementation of `merge` for sum/min/max. */
+  template <class T>
+  void merge(const QueryAggregate& other);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_AGGREGATE_H
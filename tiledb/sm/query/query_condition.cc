@@ -33,20 +33,130 @@
 #include "tiledb/sm/query/query_condition.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/enums/query_condition_combination_op.h"
 #include "tiledb/sm/enums/query_condition_op.h"
+#include "tiledb/sm/fragment/bloom_filter.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <mutex>
 #include <numeric>
+#include <string_view>
+#include <type_traits>
 
 using namespace tiledb::common;
 
 namespace tiledb {
 namespace sm {
 
+/**
+ * Number of cells processed by every clause before moving to the next block
+ * of cells when applying a query condition to a sparse tile.
+ */
+static const uint64_t sparse_block_cell_num = 1024;
+
+/*
+ * The condition values of the set operators are encoded as the number of
+ * members, followed by the byte offset of each member, followed by the data
+ * of the members sorted in byte order.
+ */
+
+/** Returns the number of members of an encoded set. */
+inline uint64_t set_member_num(const void* set) {
+  return *static_cast<const uint64_t*>(set);
+}
+
+/** Returns the byte offset of each member of an encoded set. */
+inline const uint64_t* set_member_offsets(const void* set) {
+  return static_cast<const uint64_t*>(set) + 1;
+}
+
+/** Returns the data of the members of an encoded set. */
+inline const char* set_member_data(const void* set) {
+  return reinterpret_cast<const char*>(
+      set_member_offsets(set) + set_member_num(set));
+}
+
+/**
+ * Returns true if the value is a member of the encoded set, with a binary
+ * search over the sorted members.
+ */
+inline bool set_contains(
+    const void* value,
+    const uint64_t value_size,
+    const void* set,
+    const uint64_t set_size) {
+  const uint64_t num = set_member_num(set);
+  const uint64_t* offsets = set_member_offsets(set);
+  const char* data = set_member_data(set);
+  const uint64_t data_size = set_size - (num + 1) * sizeof(uint64_t);
+  const std::string_view v(static_cast<const char*>(value), value_size);
+
+  uint64_t left = 0;
+  uint64_t right = num;
+  while (left < right) {
+    const uint64_t mid = left + (right - left) / 2;
+    const uint64_t end = mid + 1 < num ? offsets[mid + 1] : data_size;
+    const std::string_view member(data + offsets[mid], end - offsets[mid]);
+    const int cmp = member.compare(v);
+    if (cmp == 0) {
+      return true;
+    }
+
+    if (cmp < 0) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Multiplies the `length` result values starting at `start` by whether the
+ * corresponding cell of the validity byte map is valid, or null if
+ * `keep_null` is true. Byte results are processed eight cells at a time.
+ */
+template <typename BitmapType>
+inline void apply_validity(
+    const uint8_t* const validity,
+    const uint64_t start,
+    const uint64_t length,
+    const bool keep_null,
+    BitmapType* const result) {
+  uint64_t c = start;
+  const uint64_t end = start + length;
+  if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+    constexpr uint64_t low_bits = 0x0101010101010101ULL;
+    constexpr uint64_t low_7_bits = 0x7F7F7F7F7F7F7F7FULL;
+    for (; c + sizeof(uint64_t) <= end; c += sizeof(uint64_t)) {
+      uint64_t v;
+      std::memcpy(&v, validity + c, sizeof(uint64_t));
+
+      // Set the lowest bit of the bytes of the valid cells, then turn it
+      // into a byte mask.
+      uint64_t keep = ((((v & low_7_bits) + low_7_bits) | v) >> 7) & low_bits;
+      if (keep_null)
+        keep ^= low_bits;
+
+      uint64_t r;
+      std::memcpy(&r, result + c, sizeof(uint64_t));
+      r &= keep * 0xFF;
+      std::memcpy(result + c, &r, sizeof(uint64_t));
+    }
+  }
+
+  for (; c < end; c++)
+    result[c] *= (validity[c] != 0) != keep_null;
+}
+
 QueryCondition::QueryCondition() {
 }
 
@@ -86,12 +196,84 @@ Status QueryCondition::init(
     return Status_QueryConditionError("Cannot reinitialize query condition");
   }
 
+  if (op == QueryConditionOp::IN || op == QueryConditionOp::NOT_IN) {
+    return Status_QueryConditionError(
+        "Cannot initialize query condition; Set operators must be "
+        "initialized with a set of values");
+  }
+
   clauses_.emplace_back(
       std::move(field_name), condition_value, condition_value_size, op);
 
   return Status::Ok();
 }
 
+Status QueryCondition::init_set(
+    std::string&& field_name,
+    const void* const values,
+    const uint64_t values_size,
+    const uint64_t* const offsets,
+    const uint64_t offsets_num,
+    const QueryConditionOp op) {
+  if (!clauses_.empty()) {
+    return Status_QueryConditionError("Cannot reinitialize query condition");
+  }
+
+  if (op != QueryConditionOp::IN && op != QueryConditionOp::NOT_IN) {
+    return Status_QueryConditionError(
+        "Cannot initialize query condition; A set of values can only be used "
+        "with set operators");
+  }
+
+  if ((values == nullptr && values_size != 0) ||
+      (offsets == nullptr && offsets_num != 0)) {
+    return Status_QueryConditionError(
+        "Cannot initialize query condition; Invalid set values or offsets");
+  }
+
+  // Collect the members, sorted and without duplicates.
+  const char* const data = static_cast<const char*>(values);
+  std::vector<std::string_view> members;
+  members.reserve(offsets_num);
+  for (uint64_t i = 0; i < offsets_num; i++) {
+    const uint64_t end = i + 1 < offsets_num ? offsets[i + 1] : values_size;
+    if (offsets[i] > end || end > values_size) {
+      return Status_QueryConditionError(
+          "Cannot initialize query condition; Set offsets must be ascending "
+          "and within the values");
+    }
+
+    members.emplace_back(data + offsets[i], end - offsets[i]);
+  }
+  std::sort(members.begin(), members.end());
+  members.erase(std::unique(members.begin(), members.end()), members.end());
+
+  // Encode the number of members, their offsets and their data.
+  const uint64_t num = members.size();
+  const uint64_t header_size = (num + 1) * sizeof(uint64_t);
+  uint64_t members_size = 0;
+  for (const auto& member : members) {
+    members_size += member.size();
+  }
+
+  std::vector<uint8_t> set(header_size + members_size);
+  uint64_t* const header = reinterpret_cast<uint64_t*>(set.data());
+  header[0] = num;
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < num; i++) {
+    header[i + 1] = offset;
+    memcpy(
+        set.data() + header_size + offset,
+        members[i].data(),
+        members[i].size());
+    offset += members[i].size();
+  }
+
+  clauses_.emplace_back(std::move(field_name), set.data(), set.size(), op);
+
+  return Status::Ok();
+}
+
 Status QueryCondition::check(const ArraySchema* const array_schema) const {
   for (const auto& clause : clauses_) {
     const std::string field_name = clause.field_name_;
@@ -137,7 +319,21 @@ Status QueryCondition::check(const ArraySchema* const array_schema) const {
           field_name);
     }
 
-    if (attribute->cell_size() != constants::var_size &&
+    const bool set_op = clause.op_ == QueryConditionOp::IN ||
+                        clause.op_ == QueryConditionOp::NOT_IN;
+    if (set_op) {
+      RETURN_NOT_OK(check_set(clause, attribute));
+    }
+
+    if (clause.op_ == QueryConditionOp::PREFIX &&
+        attribute->type() != Datatype::STRING_ASCII &&
+        attribute->type() != Datatype::CHAR) {
+      return Status_QueryConditionError(
+          "Clause prefix operator may only be used on ASCII strings: " +
+          field_name);
+    }
+
+    if (!set_op && attribute->cell_size() != constants::var_size &&
         attribute->cell_size() != condition_value_size &&
         !(attribute->nullable() && clause.condition_value_ == nullptr) &&
         attribute->type() != Datatype::STRING_ASCII &&
@@ -167,6 +363,49 @@ Status QueryCondition::check(const ArraySchema* const array_schema) const {
   return Status::Ok();
 }
 
+bool QueryCondition::compares_as_string(const Attribute* const attribute) {
+  // Fixed-size strings are compared byte-wise over their `cell_val_num`
+  // characters, the same way as var size strings.
+  return attribute->type() == Datatype::STRING_ASCII ||
+         (attribute->type() == Datatype::CHAR &&
+          attribute->cell_val_num() != 1);
+}
+
+Status QueryCondition::check_set(
+    const Clause& clause, const Attribute* const attribute) const {
+  const uint64_t size = clause.condition_value_data_.size();
+  if (clause.condition_value_ == nullptr || size < sizeof(uint64_t)) {
+    return Status_QueryConditionError(
+        "Clause set value is invalid: " + clause.field_name_);
+  }
+
+  const uint64_t num = set_member_num(clause.condition_value_);
+  if (num > size / sizeof(uint64_t) - 1) {
+    return Status_QueryConditionError(
+        "Clause set value is invalid: " + clause.field_name_);
+  }
+
+  // Fixed size attributes can only be compared to members of the same size.
+  const uint64_t* const offsets = set_member_offsets(clause.condition_value_);
+  const uint64_t data_size = size - (num + 1) * sizeof(uint64_t);
+  for (uint64_t i = 0; i < num; i++) {
+    const uint64_t end = i + 1 < num ? offsets[i + 1] : data_size;
+    if (offsets[i] > end || end > data_size) {
+      return Status_QueryConditionError(
+          "Clause set value is invalid: " + clause.field_name_);
+    }
+
+    if (!attribute->var_size() && end - offsets[i] != attribute->cell_size()) {
+      return Status_QueryConditionError(
+          "Clause set member size mismatch: " +
+          std::to_string(attribute->cell_size()) +
+          " != " + std::to_string(end - offsets[i]));
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status QueryCondition::combine(
     const QueryCondition& rhs,
     const QueryConditionCombinationOp combination_op,
@@ -218,7 +457,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::LT> {
     }
 
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp < 0;
@@ -238,7 +477,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::LE> {
     }
 
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp < 0;
@@ -258,7 +497,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::GT> {
     }
 
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp > 0;
@@ -278,7 +517,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::GE> {
     }
 
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp > 0;
@@ -305,7 +544,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::EQ> {
       return false;
     }
 
-    return strncmp(
+    return memcmp(
                static_cast<const char*>(lhs),
                static_cast<const char*>(rhs),
                lhs_size) == 0;
@@ -329,7 +568,7 @@ struct QueryCondition::BinaryCmpNullChecks<char*, QueryConditionOp::NE> {
       return true;
     }
 
-    return strncmp(
+    return memcmp(
                static_cast<const char*>(lhs),
                static_cast<const char*>(rhs),
                lhs_size) != 0;
@@ -404,6 +643,48 @@ struct QueryCondition::BinaryCmpNullChecks<T, QueryConditionOp::NE> {
   }
 };
 
+/** Partial template specialization for `QueryConditionOp::IN`. */
+template <typename T>
+struct QueryCondition::BinaryCmpNullChecks<T, QueryConditionOp::IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    if (lhs == nullptr || rhs == nullptr) {
+      return false;
+    }
+
+    return BinaryCmp<T, QueryConditionOp::IN>::cmp(
+        lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Partial template specialization for `QueryConditionOp::NOT_IN`. */
+template <typename T>
+struct QueryCondition::BinaryCmpNullChecks<T, QueryConditionOp::NOT_IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    if (lhs == nullptr || rhs == nullptr) {
+      return false;
+    }
+
+    return BinaryCmp<T, QueryConditionOp::NOT_IN>::cmp(
+        lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Partial template specialization for `QueryConditionOp::PREFIX`. */
+template <typename T>
+struct QueryCondition::BinaryCmpNullChecks<T, QueryConditionOp::PREFIX> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    if (lhs == nullptr || rhs == nullptr) {
+      return false;
+    }
+
+    return BinaryCmp<T, QueryConditionOp::PREFIX>::cmp(
+        lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
 /** Used to create a new result slab in QueryCondition::apply_clause. */
 uint64_t create_new_result_slab(
     uint64_t start,
@@ -578,6 +859,18 @@ QueryCondition::apply_clause(
       ret = apply_clause<T, QueryConditionOp::NE>(
           clause, stride, var_size, nullable, fill_value, result_cell_slabs);
       break;
+    case QueryConditionOp::IN:
+      ret = apply_clause<T, QueryConditionOp::IN>(
+          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
+      break;
+    case QueryConditionOp::NOT_IN:
+      ret = apply_clause<T, QueryConditionOp::NOT_IN>(
+          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
+      break;
+    case QueryConditionOp::PREFIX:
+      ret = apply_clause<T, QueryConditionOp::PREFIX>(
+          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
+      break;
     default:
       return {Status_QueryConditionError(
                   "Cannot perform query comparison; Unknown query "
@@ -605,78 +898,28 @@ QueryCondition::apply_clause(
   const ByteVecValue fill_value = attribute->fill_value();
   const bool var_size = attribute->var_size();
   const bool nullable = attribute->nullable();
-  switch (attribute->type()) {
-    case Datatype::INT8:
-      return apply_clause<int8_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::UINT8:
-      return apply_clause<uint8_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::INT16:
-      return apply_clause<int16_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::UINT16:
-      return apply_clause<uint16_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::INT32:
-      return apply_clause<int32_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::UINT32:
-      return apply_clause<uint32_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::INT64:
-      return apply_clause<int64_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::UINT64:
-      return apply_clause<uint64_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::FLOAT32:
-      return apply_clause<float>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::FLOAT64:
-      return apply_clause<double>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::STRING_ASCII:
-      return apply_clause<char*>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::CHAR:
-      if (var_size) {
-        return apply_clause<char*>(
-            clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-      }
-      return apply_clause<char>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::DATETIME_YEAR:
-    case Datatype::DATETIME_MONTH:
-    case Datatype::DATETIME_WEEK:
-    case Datatype::DATETIME_DAY:
-    case Datatype::DATETIME_HR:
-    case Datatype::DATETIME_MIN:
-    case Datatype::DATETIME_SEC:
-    case Datatype::DATETIME_MS:
-    case Datatype::DATETIME_US:
-    case Datatype::DATETIME_NS:
-    case Datatype::DATETIME_PS:
-    case Datatype::DATETIME_FS:
-    case Datatype::DATETIME_AS:
-      return apply_clause<int64_t>(
-          clause, stride, var_size, nullable, fill_value, result_cell_slabs);
-    case Datatype::ANY:
-    case Datatype::BLOB:
-    case Datatype::STRING_UTF8:
-    case Datatype::STRING_UTF16:
-    case Datatype::STRING_UTF32:
-    case Datatype::STRING_UCS2:
-    case Datatype::STRING_UCS4:
-    default:
-      return {Status_QueryConditionError(
-                  "Cannot perform query comparison; Unsupported query "
-                  "conditional type on " +
-                  clause.field_name_),
-              std::nullopt};
+  auto apply = [&](auto t) {
+    return apply_clause<decltype(t)>(
+        clause, stride, var_size, nullable, fill_value, result_cell_slabs);
+  };
+
+  // Strings are compared as `char*`, and single chars as `char`.
+  const Datatype type = attribute->type();
+  if (compares_as_string(attribute)) {
+    return apply(static_cast<char*>(nullptr));
+  }
+  if (type == Datatype::CHAR) {
+    return apply(char());
   }
 
-  return {Status::Ok(), std::nullopt};
+  return apply_with_type(type, apply, [&]() {
+    return std::make_tuple(
+        Status_QueryConditionError(
+            "Cannot perform query comparison; Unsupported query "
+            "conditional type on " +
+            clause.field_name_),
+        std::optional<std::vector<ResultCellSlab>>());
+  });
 }
 
 Status QueryCondition::apply(
@@ -710,6 +953,7 @@ void QueryCondition::apply_clause_dense(
     const uint64_t src_cell,
     const uint64_t stride,
     const bool var_size,
+    const bool run_encoded,
     uint8_t* result_buffer) const {
   const std::string& field_name = clause.field_name_;
 
@@ -760,6 +1004,35 @@ void QueryCondition::apply_clause_dense(
     const auto& tile = std::get<0>(*tile_tuple);
     const char* buffer = static_cast<char*>(tile.data());
     const uint64_t cell_size = tile.cell_size();
+
+    // Compare each run of equal cells once for run-length encoded attributes.
+    if (run_encoded) {
+      apply_cmp_runs<T, Op>(
+          buffer + (start + src_cell) * cell_size,
+          cell_size,
+          length,
+          stride,
+          clause.condition_value_,
+          clause.condition_value_data_.size(),
+          result_buffer + start);
+      return;
+    }
+
+    // Use typed values for single value numeric cells so that the loop can be
+    // vectorized.
+    if constexpr (std::is_arithmetic_v<T>) {
+      if (cell_size == sizeof(T)) {
+        apply_cmp_fixed<T, Op>(
+            reinterpret_cast<const T*>(buffer) + start + src_cell,
+            length,
+            stride,
+            clause.condition_value_,
+            clause.condition_value_data_.size(),
+            result_buffer + start);
+        return;
+      }
+    }
+
     uint64_t buffer_offset = (start + src_cell) * cell_size;
     const uint64_t buffer_offset_inc = stride * cell_size;
 
@@ -791,6 +1064,7 @@ Status QueryCondition::apply_clause_dense(
     const uint64_t src_cell,
     const uint64_t stride,
     const bool var_size,
+    const bool run_encoded,
     uint8_t* result_buffer) const {
   switch (clause.op_) {
     case QueryConditionOp::LT:
@@ -802,6 +1076,7 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
           result_buffer);
       break;
     case QueryConditionOp::LE:
@@ -813,6 +1088,7 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
           result_buffer);
       break;
     case QueryConditionOp::GT:
@@ -824,6 +1100,7 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
           result_buffer);
       break;
     case QueryConditionOp::GE:
@@ -835,6 +1112,7 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
           result_buffer);
       break;
     case QueryConditionOp::EQ:
@@ -846,6 +1124,7 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
           result_buffer);
       break;
     case QueryConditionOp::NE:
@@ -857,6 +1136,43 @@ Status QueryCondition::apply_clause_dense(
           src_cell,
           stride,
           var_size,
+          run_encoded,
+          result_buffer);
+      break;
+    case QueryConditionOp::IN:
+      apply_clause_dense<T, QueryConditionOp::IN>(
+          clause,
+          result_tile,
+          start,
+          length,
+          src_cell,
+          stride,
+          var_size,
+          run_encoded,
+          result_buffer);
+      break;
+    case QueryConditionOp::NOT_IN:
+      apply_clause_dense<T, QueryConditionOp::NOT_IN>(
+          clause,
+          result_tile,
+          start,
+          length,
+          src_cell,
+          stride,
+          var_size,
+          run_encoded,
+          result_buffer);
+      break;
+    case QueryConditionOp::PREFIX:
+      apply_clause_dense<T, QueryConditionOp::PREFIX>(
+          clause,
+          result_tile,
+          start,
+          length,
+          src_cell,
+          stride,
+          var_size,
+          run_encoded,
           result_buffer);
       break;
     default:
@@ -886,6 +1202,8 @@ Status QueryCondition::apply_clause_dense(
 
   const bool var_size = attribute->var_size();
   const bool nullable = attribute->nullable();
+  const bool run_encoded =
+      !var_size && attribute->filters().has_filter(FilterType::FILTER_RLE);
 
   // Process the validity buffer now.
   if (nullable) {
@@ -895,195 +1213,50 @@ Status QueryCondition::apply_clause_dense(
         static_cast<uint8_t*>(tile_validity.data()) + src_cell;
     ;
 
-    // Null values can only be specified for equality operators.
-    if (clause.condition_value_ == nullptr) {
-      if (clause.op_ == QueryConditionOp::NE) {
-        for (uint64_t c = 0; c < length; ++c) {
-          result_buffer[start + c] *= buffer_validity[start + c * stride] != 0;
-        }
-      } else {
-        for (uint64_t c = 0; c < length; ++c) {
-          result_buffer[start + c] *= buffer_validity[start + c * stride] == 0;
-        }
-      }
-      return Status::Ok();
+    // Null values can only be specified for equality operators. When
+    // comparing to a value, this turns off bitmap values for null cells.
+    const bool keep_null = clause.condition_value_ == nullptr &&
+                           clause.op_ != QueryConditionOp::NE;
+    if (stride == 1) {
+      apply_validity(buffer_validity, start, length, keep_null, result_buffer);
     } else {
-      // Turn off bitmap values for null cells.
       for (uint64_t c = 0; c < length; ++c) {
-        result_buffer[start + c] *= buffer_validity[start + c * stride] != 0;
+        result_buffer[start + c] *=
+            (buffer_validity[start + c * stride] != 0) != keep_null;
       }
     }
+    if (clause.condition_value_ == nullptr)
+      return Status::Ok();
   }
 
-  switch (attribute->type()) {
-    case Datatype::INT8:
-      return apply_clause_dense<int8_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::UINT8:
-      return apply_clause_dense<uint8_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::INT16:
-      return apply_clause_dense<int16_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::UINT16:
-      return apply_clause_dense<uint16_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::INT32:
-      return apply_clause_dense<int32_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::UINT32:
-      return apply_clause_dense<uint32_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::INT64:
-      return apply_clause_dense<int64_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::UINT64:
-      return apply_clause_dense<uint64_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::FLOAT32:
-      return apply_clause_dense<float>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::FLOAT64:
-      return apply_clause_dense<double>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::STRING_ASCII:
-      return apply_clause_dense<char*>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::CHAR:
-      if (var_size) {
-        return apply_clause_dense<char*>(
-            clause,
-            result_tile,
-            start,
-            length,
-            src_cell,
-            stride,
-            var_size,
-            result_buffer);
-      }
-      return apply_clause_dense<char>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::DATETIME_YEAR:
-    case Datatype::DATETIME_MONTH:
-    case Datatype::DATETIME_WEEK:
-    case Datatype::DATETIME_DAY:
-    case Datatype::DATETIME_HR:
-    case Datatype::DATETIME_MIN:
-    case Datatype::DATETIME_SEC:
-    case Datatype::DATETIME_MS:
-    case Datatype::DATETIME_US:
-    case Datatype::DATETIME_NS:
-    case Datatype::DATETIME_PS:
-    case Datatype::DATETIME_FS:
-    case Datatype::DATETIME_AS:
-      return apply_clause_dense<int64_t>(
-          clause,
-          result_tile,
-          start,
-          length,
-          src_cell,
-          stride,
-          var_size,
-          result_buffer);
-    case Datatype::ANY:
-    case Datatype::BLOB:
-    case Datatype::STRING_UTF8:
-    case Datatype::STRING_UTF16:
-    case Datatype::STRING_UTF32:
-    case Datatype::STRING_UCS2:
-    case Datatype::STRING_UCS4:
-    default:
-      return Status_QueryConditionError(
-          "Cannot perform query comparison; Unsupported query "
-          "conditional type on " +
-          clause.field_name_);
+  auto apply = [&](auto t) {
+    return apply_clause_dense<decltype(t)>(
+        clause,
+        result_tile,
+        start,
+        length,
+        src_cell,
+        stride,
+        var_size,
+        run_encoded,
+        result_buffer);
+  };
+
+  // Strings are compared as `char*`, and single chars as `char`.
+  const Datatype type = attribute->type();
+  if (compares_as_string(attribute)) {
+    return apply(static_cast<char*>(nullptr));
+  }
+  if (type == Datatype::CHAR) {
+    return apply(char());
   }
 
-  return Status::Ok();
+  return apply_with_type(type, apply, [&]() {
+    return Status_QueryConditionError(
+        "Cannot perform query comparison; Unsupported query "
+        "conditional type on " +
+        clause.field_name_);
+  });
 }
 
 Status QueryCondition::apply_dense(
@@ -1117,7 +1290,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::LT> {
   static inline bool cmp(
       const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp < 0;
@@ -1133,7 +1306,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::LE> {
   static inline bool cmp(
       const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp < 0;
@@ -1149,7 +1322,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::GT> {
   static inline bool cmp(
       const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp > 0;
@@ -1165,7 +1338,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::GE> {
   static inline bool cmp(
       const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
     const size_t min_size = std::min<size_t>(lhs_size, rhs_size);
-    const int cmp = strncmp(
+    const int cmp = memcmp(
         static_cast<const char*>(lhs), static_cast<const char*>(rhs), min_size);
     if (cmp != 0) {
       return cmp > 0;
@@ -1184,7 +1357,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::EQ> {
       return false;
     }
 
-    return strncmp(
+    return memcmp(
                static_cast<const char*>(lhs),
                static_cast<const char*>(rhs),
                lhs_size) == 0;
@@ -1200,7 +1373,7 @@ struct QueryCondition::BinaryCmp<char*, QueryConditionOp::NE> {
       return true;
     }
 
-    return strncmp(
+    return memcmp(
                static_cast<const char*>(lhs),
                static_cast<const char*>(rhs),
                lhs_size) != 0;
@@ -1255,11 +1428,153 @@ struct QueryCondition::BinaryCmp<T, QueryConditionOp::NE> {
   }
 };
 
+/** Full template specialization for `char*` and `QueryConditionOp::IN`. */
+template <>
+struct QueryCondition::BinaryCmp<char*, QueryConditionOp::IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return set_contains(lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Full template specialization for `char` and `QueryConditionOp::IN`. */
+template <>
+struct QueryCondition::BinaryCmp<char, QueryConditionOp::IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return set_contains(lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Full template specialization for `char*` and `QueryConditionOp::NOT_IN`. */
+template <>
+struct QueryCondition::BinaryCmp<char*, QueryConditionOp::NOT_IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return !set_contains(lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Full template specialization for `char` and `QueryConditionOp::NOT_IN`. */
+template <>
+struct QueryCondition::BinaryCmp<char, QueryConditionOp::NOT_IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return !set_contains(lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/**
+ * Partial template specialization for `QueryConditionOp::IN`. Sets of typed
+ * values are usually small, so all members are compared without branches.
+ */
+template <typename T>
+struct QueryCondition::BinaryCmp<T, QueryConditionOp::IN> {
+  static inline bool cmp(const void* lhs, uint64_t, const void* rhs, uint64_t) {
+    const T value = *static_cast<const T*>(lhs);
+    const uint64_t num = set_member_num(rhs);
+    const T* members = reinterpret_cast<const T*>(set_member_data(rhs));
+    bool found = false;
+    for (uint64_t i = 0; i < num; i++) {
+      found |= value == members[i];
+    }
+
+    return found;
+  }
+};
+
+/** Partial template specialization for `QueryConditionOp::NOT_IN`. */
+template <typename T>
+struct QueryCondition::BinaryCmp<T, QueryConditionOp::NOT_IN> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return !BinaryCmp<T, QueryConditionOp::IN>::cmp(
+        lhs, lhs_size, rhs, rhs_size);
+  }
+};
+
+/** Partial template specialization for `QueryConditionOp::PREFIX`. */
+template <typename T>
+struct QueryCondition::BinaryCmp<T, QueryConditionOp::PREFIX> {
+  static inline bool cmp(
+      const void* lhs, uint64_t lhs_size, const void* rhs, uint64_t rhs_size) {
+    return lhs_size >= rhs_size && memcmp(lhs, rhs, rhs_size) == 0;
+  }
+};
+
+template <typename T, QueryConditionOp Op, typename ResultType>
+void QueryCondition::apply_cmp_fixed(
+    const T* values,
+    const uint64_t count,
+    const uint64_t stride,
+    const void* condition_value,
+    const uint64_t condition_value_size,
+    ResultType* result) {
+  // The set and prefix operators compare against the whole condition value,
+  // the other operators against a local copy of the single value.
+  T value{};
+  const void* rhs = condition_value;
+  uint64_t rhs_size = condition_value_size;
+  if constexpr (
+      Op != QueryConditionOp::IN && Op != QueryConditionOp::NOT_IN &&
+      Op != QueryConditionOp::PREFIX) {
+    value = *static_cast<const T*>(condition_value);
+    rhs = &value;
+    rhs_size = sizeof(T);
+  }
+
+  // The contiguous case is split out so that the compiler can vectorize it.
+  if (stride == 1) {
+    for (uint64_t c = 0; c < count; ++c) {
+      const bool cmp =
+          BinaryCmp<T, Op>::cmp(&values[c], sizeof(T), rhs, rhs_size);
+      result[c] *= static_cast<ResultType>(cmp);
+    }
+  } else {
+    for (uint64_t c = 0; c < count; ++c) {
+      const bool cmp =
+          BinaryCmp<T, Op>::cmp(&values[c * stride], sizeof(T), rhs, rhs_size);
+      result[c] *= static_cast<ResultType>(cmp);
+    }
+  }
+}
+
+template <typename T, QueryConditionOp Op, typename ResultType>
+void QueryCondition::apply_cmp_runs(
+    const char* cells,
+    const uint64_t cell_size,
+    const uint64_t count,
+    const uint64_t stride,
+    const void* condition_value,
+    const uint64_t condition_value_size,
+    ResultType* result) {
+  const uint64_t cell_stride = stride * cell_size;
+  uint64_t c = 0;
+  while (c < count) {
+    // Find the end of the run of cells equal to cell `c`.
+    const char* const value = cells + c * cell_stride;
+    uint64_t end = c + 1;
+    while (end < count &&
+           std::memcmp(cells + end * cell_stride, value, cell_size) == 0)
+      ++end;
+
+    // Compare the run once and clear its results if it does not match.
+    if (!BinaryCmp<T, Op>::cmp(
+            value, cell_size, condition_value, condition_value_size))
+      std::memset(result + c, 0, (end - c) * sizeof(ResultType));
+
+    c = end;
+  }
+}
+
 template <typename T, QueryConditionOp Op, typename BitmapType>
 void QueryCondition::apply_clause_sparse(
     const QueryCondition::Clause& clause,
     ResultTile& result_tile,
     const bool var_size,
+    const bool run_encoded,
+    const uint64_t start,
+    const uint64_t length,
     std::vector<BitmapType>& result_bitmap) const {
   const auto tile_tuple = result_tile.tile_tuple(clause.field_name_);
 
@@ -1276,7 +1591,7 @@ void QueryCondition::apply_clause_sparse(
         tile_offsets.size() / constants::cell_var_offset_size;
 
     // Iterate through each cell.
-    for (uint64_t c = 0; c < buffer_offsets_el; ++c) {
+    for (uint64_t c = start; c < start + length; ++c) {
       // Check the previous cell here, which breaks vectorization but as this
       // is string data requiring a strcmp which cannot be vectorized, this is
       // ok.
@@ -1305,11 +1620,38 @@ void QueryCondition::apply_clause_sparse(
     const auto& tile = std::get<0>(*tile_tuple);
     const char* buffer = static_cast<char*>(tile.data());
     const uint64_t cell_size = tile.cell_size();
-    const uint64_t buffer_el = tile.size() / cell_size;
+
+    // Compare each run of equal cells once for run-length encoded attributes.
+    if (run_encoded) {
+      apply_cmp_runs<T, Op>(
+          buffer + start * cell_size,
+          cell_size,
+          length,
+          1,
+          clause.condition_value_,
+          clause.condition_value_data_.size(),
+          result_bitmap.data() + start);
+      return;
+    }
+
+    // Use typed values for single value numeric cells so that the loop can be
+    // vectorized.
+    if constexpr (std::is_arithmetic_v<T>) {
+      if (cell_size == sizeof(T)) {
+        apply_cmp_fixed<T, Op>(
+            reinterpret_cast<const T*>(buffer) + start,
+            length,
+            1,
+            clause.condition_value_,
+            clause.condition_value_data_.size(),
+            result_bitmap.data() + start);
+        return;
+      }
+    }
 
     // Iterate through each cell without checking the bitmap to enable
     // vectorization.
-    for (uint64_t c = 0; c < buffer_el; ++c) {
+    for (uint64_t c = start; c < start + length; ++c) {
       // Get the cell value.
       const void* const cell_value = buffer + c * cell_size;
 
@@ -1331,31 +1673,100 @@ Status QueryCondition::apply_clause_sparse(
     const Clause& clause,
     ResultTile& result_tile,
     const bool var_size,
+    const bool run_encoded,
+    const uint64_t start,
+    const uint64_t length,
     std::vector<BitmapType>& result_bitmap) const {
   switch (clause.op_) {
     case QueryConditionOp::LT:
       apply_clause_sparse<T, QueryConditionOp::LT>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     case QueryConditionOp::LE:
       apply_clause_sparse<T, QueryConditionOp::LE>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     case QueryConditionOp::GT:
       apply_clause_sparse<T, QueryConditionOp::GT>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     case QueryConditionOp::GE:
       apply_clause_sparse<T, QueryConditionOp::GE>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     case QueryConditionOp::EQ:
       apply_clause_sparse<T, QueryConditionOp::EQ>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     case QueryConditionOp::NE:
       apply_clause_sparse<T, QueryConditionOp::NE>(
-          clause, result_tile, var_size, result_bitmap);
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
+      break;
+    case QueryConditionOp::IN:
+      apply_clause_sparse<T, QueryConditionOp::IN>(
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
+      break;
+    case QueryConditionOp::NOT_IN:
+      apply_clause_sparse<T, QueryConditionOp::NOT_IN>(
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
+      break;
+    case QueryConditionOp::PREFIX:
+      apply_clause_sparse<T, QueryConditionOp::PREFIX>(
+          clause,
+          result_tile,
+          var_size,
+          run_encoded,
+          start,
+          length,
+          result_bitmap);
       break;
     default:
       return Status_QueryConditionError(
@@ -1371,6 +1782,8 @@ Status QueryCondition::apply_clause_sparse(
     const QueryCondition::Clause& clause,
     const ArraySchema* const array_schema,
     ResultTile& result_tile,
+    const uint64_t start,
+    const uint64_t length,
     std::vector<BitmapType>& result_bitmap) const {
   const Attribute* const attribute =
       array_schema->attribute(clause.field_name_);
@@ -1381,6 +1794,8 @@ Status QueryCondition::apply_clause_sparse(
 
   const bool var_size = attribute->var_size();
   const bool nullable = attribute->nullable();
+  const bool run_encoded =
+      !var_size && attribute->filters().has_filter(FilterType::FILTER_RLE);
 
   // Process the validity buffer now.
 
@@ -1389,67 +1804,109 @@ Status QueryCondition::apply_clause_sparse(
     const auto& tile_validity = std::get<2>(*tile_tuple);
     const auto buffer_validity = static_cast<uint8_t*>(tile_validity.data());
 
-    // Null values can only be specified for equality operators.
-    if (clause.condition_value_ == nullptr) {
-      if (clause.op_ == QueryConditionOp::NE) {
-        for (uint64_t c = 0; c < result_tile.cell_num(); c++) {
-          result_bitmap[c] *= buffer_validity[c] != 0;
-        }
-      } else {
-        for (uint64_t c = 0; c < result_tile.cell_num(); c++) {
-          result_bitmap[c] *= buffer_validity[c] == 0;
-        }
-      }
+    // Null values can only be specified for equality operators. When
+    // comparing to a value, this turns off bitmap values for null cells.
+    const bool keep_null = clause.condition_value_ == nullptr &&
+                           clause.op_ != QueryConditionOp::NE;
+    apply_validity(
+        buffer_validity, start, length, keep_null, result_bitmap.data());
+    if (clause.condition_value_ == nullptr)
       return Status::Ok();
-    } else {
-      // Turn off bitmap values for null cells.
-      for (uint64_t c = 0; c < result_tile.cell_num(); c++) {
-        result_bitmap[c] *= buffer_validity[c] != 0;
+  }
+
+  auto apply = [&](auto t) {
+    return apply_clause_sparse<decltype(t), BitmapType>(
+        clause,
+        result_tile,
+        var_size,
+        run_encoded,
+        start,
+        length,
+        result_bitmap);
+  };
+
+  // Strings are compared as `char*`, and single chars as `char`.
+  const Datatype type = attribute->type();
+  if (compares_as_string(attribute)) {
+    return apply(static_cast<char*>(nullptr));
+  }
+  if (type == Datatype::CHAR) {
+    return apply(char());
+  }
+
+  return apply_with_type(type, apply, [&]() {
+    return Status_QueryConditionError(
+        "Cannot perform query comparison; Unsupported query "
+        "conditional type on " +
+        clause.field_name_);
+  });
+}
+
+template <typename BitmapType>
+Status QueryCondition::apply_sparse(
+    const ArraySchema* const array_schema,
+    ResultTile& result_tile,
+    std::vector<BitmapType>& result_bitmap,
+    uint64_t* cell_count) {
+  // Process the cells in blocks, applying all clauses to a block before
+  // moving to the next one.
+  // This assumes all clauses are combined with a logical "AND".
+  const uint64_t cell_num = result_tile.cell_num();
+  for (uint64_t start = 0; start < cell_num; start += sparse_block_cell_num) {
+    const uint64_t length = std::min(sparse_block_cell_num, cell_num - start);
+    for (const auto& clause : clauses_) {
+      RETURN_NOT_OK(apply_clause_sparse(
+          clause, array_schema, result_tile, start, length, result_bitmap));
+
+      // No need to evaluate the other clauses if no cell is left in the block.
+      if (std::all_of(
+              result_bitmap.begin() + start,
+              result_bitmap.begin() + start + length,
+              [](const BitmapType v) { return v == 0; })) {
+        break;
       }
     }
   }
 
+  *cell_count = std::accumulate(result_bitmap.begin(), result_bitmap.end(), 0);
+
+  return Status::Ok();
+}
+
+bool QueryCondition::clause_has_tile_metadata(
+    const Clause& clause, const FragmentMetadata* fragment) const {
+  // Tile min/max values are only stored from version 11.
+  if (fragment->format_version() <= 10) {
+    return false;
+  }
+
+  const Attribute* const attribute =
+      fragment->array_schema()->attribute(clause.field_name_);
+  if (attribute == nullptr) {
+    return false;
+  }
+
+  // Var size strings store a prefix of their min/max values per tile. The
+  // min/max of fixed-size strings are compared byte-wise from version 14.
+  if (compares_as_string(attribute)) {
+    return attribute->var_size() || fragment->format_version() >= 14;
+  }
+
+  if (attribute->var_size() || attribute->cell_val_num() != 1) {
+    return false;
+  }
+
   switch (attribute->type()) {
     case Datatype::INT8:
-      return apply_clause_sparse<int8_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::UINT8:
-      return apply_clause_sparse<uint8_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::INT16:
-      return apply_clause_sparse<int16_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::UINT16:
-      return apply_clause_sparse<uint16_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::INT32:
-      return apply_clause_sparse<int32_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::UINT32:
-      return apply_clause_sparse<uint32_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::INT64:
-      return apply_clause_sparse<int64_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::UINT64:
-      return apply_clause_sparse<uint64_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::FLOAT32:
-      return apply_clause_sparse<float, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::FLOAT64:
-      return apply_clause_sparse<double, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
-    case Datatype::STRING_ASCII:
-      return apply_clause_sparse<char*, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
-    case Datatype::CHAR:
-      if (var_size) {
-        return apply_clause_sparse<char*, BitmapType>(
-            clause, result_tile, var_size, result_bitmap);
-      }
-      return apply_clause_sparse<char, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
     case Datatype::DATETIME_YEAR:
     case Datatype::DATETIME_MONTH:
     case Datatype::DATETIME_WEEK:
@@ -1463,41 +1920,418 @@ Status QueryCondition::apply_clause_sparse(
     case Datatype::DATETIME_PS:
     case Datatype::DATETIME_FS:
     case Datatype::DATETIME_AS:
-      return apply_clause_sparse<int64_t, BitmapType>(
-          clause, result_tile, var_size, result_bitmap);
-    case Datatype::ANY:
-    case Datatype::BLOB:
-    case Datatype::STRING_UTF8:
-    case Datatype::STRING_UTF16:
-    case Datatype::STRING_UTF32:
-    case Datatype::STRING_UCS2:
-    case Datatype::STRING_UCS4:
+      return true;
     default:
-      return Status_QueryConditionError(
-          "Cannot perform query comparison; Unsupported query "
-          "conditional type on " +
-          clause.field_name_);
+      return false;
   }
+}
 
-  return Status::Ok();
+void QueryCondition::tile_metadata_names(
+    const FragmentMetadata* fragment,
+    std::vector<std::string>* min_max_names,
+    std::vector<std::string>* null_count_names) const {
+  for (const auto& name : field_names()) {
+    bool has_metadata = false;
+    for (const auto& clause : clauses_) {
+      if (clause.field_name_ == name &&
+          clause_has_tile_metadata(clause, fragment)) {
+        has_metadata = true;
+        break;
+      }
+    }
+
+    if (!has_metadata) {
+      continue;
+    }
+
+    min_max_names->emplace_back(name);
+    if (fragment->array_schema()->attribute(name)->nullable()) {
+      null_count_names->emplace_back(name);
+    }
+  }
 }
 
-template <typename BitmapType>
-Status QueryCondition::apply_sparse(
-    const ArraySchema* const array_schema,
-    ResultTile& result_tile,
-    std::vector<BitmapType>& result_bitmap,
-    uint64_t* cell_count) {
-  // Iterate through each clause.
-  // This assumes all clauses are combined with a logical "AND".
+bool QueryCondition::index_can_skip_tile(
+    const Clause& clause,
+    const FragmentMetadata* fragment,
+    uint64_t tile_idx) const {
+  if (clause.condition_value_ == nullptr) {
+    return false;
+  }
+
+  const BloomFilter* const filter =
+      fragment->attribute_index(clause.field_name_, tile_idx);
+  if (filter == nullptr) {
+    return false;
+  }
+
+  if (clause.op_ == QueryConditionOp::EQ) {
+    return !filter->may_contain(BloomFilter::hash(
+        clause.condition_value_, clause.condition_value_data_.size()));
+  }
+
+  // The tile can be skipped for `IN` if it contains no member.
+  if (clause.op_ == QueryConditionOp::IN) {
+    const uint64_t num = set_member_num(clause.condition_value_);
+    const uint64_t* offsets = set_member_offsets(clause.condition_value_);
+    const char* data = set_member_data(clause.condition_value_);
+    const uint64_t data_size =
+        clause.condition_value_data_.size() - (num + 1) * sizeof(uint64_t);
+    for (uint64_t i = 0; i < num; i++) {
+      const uint64_t end = i + 1 < num ? offsets[i + 1] : data_size;
+      if (filter->may_contain(
+              BloomFilter::hash(data + offsets[i], end - offsets[i]))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+template <typename T>
+bool QueryCondition::can_skip_tile(
+    const Clause& clause, const void* min, const void* max) const {
+  const T tile_min = *static_cast<const T*>(min);
+  const T tile_max = *static_cast<const T*>(max);
+
+  // A tile can be skipped for `IN` if no member is within its range, and for
+  // `NOT_IN` if all its cells have the same value, which is a member.
+  if (clause.op_ == QueryConditionOp::IN ||
+      clause.op_ == QueryConditionOp::NOT_IN) {
+    const bool in = clause.op_ == QueryConditionOp::IN;
+    const uint64_t num = set_member_num(clause.condition_value_);
+    const T* members =
+        reinterpret_cast<const T*>(set_member_data(clause.condition_value_));
+    for (uint64_t i = 0; i < num; i++) {
+      if (in && !(members[i] < tile_min || members[i] > tile_max)) {
+        return false;
+      }
+
+      if (!in && tile_min == members[i] && tile_max == members[i]) {
+        return true;
+      }
+    }
+
+    return in;
+  }
+
+  const T value = *static_cast<const T*>(clause.condition_value_);
+
+  // The comparisons are written so that they are false when a value is NaN,
+  // which keeps the tile.
+  switch (clause.op_) {
+    case QueryConditionOp::LT:
+      return tile_min >= value;
+    case QueryConditionOp::LE:
+      return tile_min > value;
+    case QueryConditionOp::GT:
+      return tile_max <= value;
+    case QueryConditionOp::GE:
+      return tile_max < value;
+    case QueryConditionOp::EQ:
+      return value < tile_min || value > tile_max;
+    case QueryConditionOp::NE:
+      return tile_min == value && tile_max == value;
+    default:
+      return false;
+  }
+}
+
+bool QueryCondition::can_skip_tile_var(
+    const Clause& clause,
+    std::string_view tile_min,
+    std::string_view tile_max) const {
+  // The tile min/max values are only a lower and an upper bound of the
+  // values of the tile, as they are truncated for long strings. They are
+  // equal only when all the cells of the tile have the same value.
+  if (clause.op_ == QueryConditionOp::IN ||
+      clause.op_ == QueryConditionOp::NOT_IN) {
+    const bool in = clause.op_ == QueryConditionOp::IN;
+    const uint64_t num = set_member_num(clause.condition_value_);
+    const uint64_t* offsets = set_member_offsets(clause.condition_value_);
+    const char* data = set_member_data(clause.condition_value_);
+    const uint64_t data_size =
+        clause.condition_value_data_.size() - (num + 1) * sizeof(uint64_t);
+    for (uint64_t i = 0; i < num; i++) {
+      const uint64_t end = i + 1 < num ? offsets[i + 1] : data_size;
+      const std::string_view member(data + offsets[i], end - offsets[i]);
+      if (in && !(member < tile_min || member > tile_max)) {
+        return false;
+      }
+
+      if (!in && tile_min == member && tile_max == member) {
+        return true;
+      }
+    }
+
+    return in;
+  }
+
+  const std::string_view value(
+      static_cast<const char*>(clause.condition_value_),
+      clause.condition_value_data_.size());
+  switch (clause.op_) {
+    case QueryConditionOp::LT:
+      return tile_min >= value;
+    case QueryConditionOp::LE:
+      return tile_min > value;
+    case QueryConditionOp::GT:
+      return tile_max <= value;
+    case QueryConditionOp::GE:
+      return tile_max < value;
+    case QueryConditionOp::EQ:
+      return value < tile_min || value > tile_max;
+    case QueryConditionOp::NE:
+      return tile_min == value && tile_max == value;
+    default:
+      return false;
+  }
+}
+
+std::tuple<Status, std::optional<bool>> QueryCondition::can_skip_tile(
+    const Clause& clause,
+    FragmentMetadata* fragment,
+    uint64_t tile_idx) const {
+  const Attribute* const attribute =
+      fragment->array_schema()->attribute(clause.field_name_);
+
+  // Null cells never satisfy a comparison against a non-null value, and
+  // only null cells satisfy an equality against null.
+  if (attribute->nullable()) {
+    auto&& [st, null_count] =
+        fragment->get_tile_null_count(clause.field_name_, tile_idx);
+    RETURN_NOT_OK_TUPLE(st, std::nullopt);
+
+    const auto cell_num = fragment->cell_num(tile_idx);
+    if (clause.condition_value_ == nullptr) {
+      if (clause.op_ == QueryConditionOp::EQ) {
+        return {Status::Ok(), *null_count == 0};
+      }
+
+      return {Status::Ok(), *null_count == cell_num};
+    }
+
+    // The min/max values of a tile with only null cells are not meaningful.
+    if (*null_count == cell_num) {
+      return {Status::Ok(), true};
+    }
+  }
+
+  if (clause.condition_value_ == nullptr) {
+    return {Status::Ok(), false};
+  }
+
+  auto&& [st_min, min, min_size] =
+      fragment->get_tile_min(clause.field_name_, tile_idx);
+  RETURN_NOT_OK_TUPLE(st_min, std::nullopt);
+  auto&& [st_max, max, max_size] =
+      fragment->get_tile_max(clause.field_name_, tile_idx);
+  RETURN_NOT_OK_TUPLE(st_max, std::nullopt);
+
+  if (compares_as_string(attribute)) {
+    return {Status::Ok(),
+            can_skip_tile_var(
+                clause,
+                std::string_view(static_cast<const char*>(*min), *min_size),
+                std::string_view(static_cast<const char*>(*max), *max_size))};
+  }
+
+  const bool skip = apply_with_type(
+      attribute->type(),
+      [&](auto t) {
+        return can_skip_tile<decltype(t)>(clause, *min, *max);
+      },
+      []() { return false; });
+  return {Status::Ok(), skip};
+}
+
+std::tuple<Status, std::optional<bool>> QueryCondition::can_skip_tile(
+    FragmentMetadata* fragment, uint64_t tile_idx) const {
+  // This assumes all clauses are combined with a logical "AND", so a single
+  // clause that no cell can satisfy is enough to skip the tile.
   for (const auto& clause : clauses_) {
-    RETURN_NOT_OK(
-        apply_clause_sparse(clause, array_schema, result_tile, result_bitmap));
+    if (index_can_skip_tile(clause, fragment, tile_idx)) {
+      return {Status::Ok(), true};
+    }
+
+    if (!clause_has_tile_metadata(clause, fragment)) {
+      continue;
+    }
+
+    auto&& [st, skip] = can_skip_tile(clause, fragment, tile_idx);
+    RETURN_NOT_OK_TUPLE(st, std::nullopt);
+    if (*skip) {
+      return {Status::Ok(), true};
+    }
   }
 
-  *cell_count = std::accumulate(result_bitmap.begin(), result_bitmap.end(), 0);
+  return {Status::Ok(), false};
+}
 
-  return Status::Ok();
+template <typename T>
+double QueryCondition::clause_selectivity(
+    const Clause& clause,
+    const void* min,
+    const void* max,
+    const uint64_t cell_num) const {
+  if (can_skip_tile<T>(clause, min, max)) {
+    return 0.0;
+  }
+
+  // A tile with a single value that is not skipped has all cells matching.
+  // The negated comparison also keeps all cells when a bound is NaN.
+  const double tile_min = *static_cast<const T*>(min);
+  const double tile_max = *static_cast<const T*>(max);
+  if (!(tile_max > tile_min)) {
+    return 1.0;
+  }
+
+  // Integer values are counted over [min, max], while a single floating
+  // point value is assumed to match one cell.
+  constexpr bool integral = std::is_integral_v<T>;
+  const double width = integral ? tile_max - tile_min + 1 : tile_max - tile_min;
+  const double point = integral ? 1.0 / width : 1.0 / cell_num;
+  const double step = integral ? 1.0 : 0.0;
+
+  double selectivity = 1.0;
+  if (clause.op_ == QueryConditionOp::IN ||
+      clause.op_ == QueryConditionOp::NOT_IN) {
+    const uint64_t num = set_member_num(clause.condition_value_);
+    const T* members =
+        reinterpret_cast<const T*>(set_member_data(clause.condition_value_));
+    double in = 0.0;
+    for (uint64_t i = 0; i < num; i++) {
+      if (!(members[i] < tile_min || members[i] > tile_max)) {
+        in += point;
+      }
+    }
+
+    in = std::min(in, 1.0);
+    selectivity = clause.op_ == QueryConditionOp::IN ? in : 1.0 - in;
+  } else {
+    const double value = *static_cast<const T*>(clause.condition_value_);
+    switch (clause.op_) {
+      case QueryConditionOp::LT:
+        selectivity = (value - tile_min) / width;
+        break;
+      case QueryConditionOp::LE:
+        selectivity = (value - tile_min + step) / width;
+        break;
+      case QueryConditionOp::GT:
+        selectivity = (tile_max - value) / width;
+        break;
+      case QueryConditionOp::GE:
+        selectivity = (tile_max - value + step) / width;
+        break;
+      case QueryConditionOp::EQ:
+        selectivity = point;
+        break;
+      case QueryConditionOp::NE:
+        selectivity = 1.0 - point;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // NaN values fall back to keeping all cells.
+  if (!(selectivity >= 0.0)) {
+    return selectivity < 0.0 ? 0.0 : 1.0;
+  }
+
+  return std::min(selectivity, 1.0);
+}
+
+std::tuple<Status, std::optional<double>> QueryCondition::clause_selectivity(
+    const Clause& clause,
+    FragmentMetadata* fragment,
+    uint64_t tile_idx) const {
+  const Attribute* const attribute =
+      fragment->array_schema()->attribute(clause.field_name_);
+  const auto cell_num = fragment->cell_num(tile_idx);
+
+  // Only the non-null cells can satisfy a comparison against a value.
+  double non_null = 1.0;
+  if (attribute->nullable()) {
+    auto&& [st, null_count] =
+        fragment->get_tile_null_count(clause.field_name_, tile_idx);
+    RETURN_NOT_OK_TUPLE(st, std::nullopt);
+
+    const double null = cell_num == 0 ? 0.0 : (double)*null_count / cell_num;
+    if (clause.condition_value_ == nullptr) {
+      if (clause.op_ == QueryConditionOp::EQ) {
+        return {Status::Ok(), null};
+      }
+
+      if (clause.op_ == QueryConditionOp::NE) {
+        return {Status::Ok(), 1.0 - null};
+      }
+
+      return {Status::Ok(), 1.0};
+    }
+
+    non_null = 1.0 - null;
+    if (*null_count == cell_num) {
+      return {Status::Ok(), 0.0};
+    }
+  }
+
+  if (clause.condition_value_ == nullptr) {
+    return {Status::Ok(), non_null};
+  }
+
+  auto&& [st_min, min, min_size] =
+      fragment->get_tile_min(clause.field_name_, tile_idx);
+  RETURN_NOT_OK_TUPLE(st_min, std::nullopt);
+  auto&& [st_max, max, max_size] =
+      fragment->get_tile_max(clause.field_name_, tile_idx);
+  RETURN_NOT_OK_TUPLE(st_max, std::nullopt);
+
+  // There is no estimate within the range of a string tile.
+  if (compares_as_string(attribute)) {
+    const bool skip = can_skip_tile_var(
+        clause,
+        std::string_view(static_cast<const char*>(*min), *min_size),
+        std::string_view(static_cast<const char*>(*max), *max_size));
+    return {Status::Ok(), skip ? 0.0 : non_null};
+  }
+
+  const double selectivity = apply_with_type(
+      attribute->type(),
+      [&](auto t) {
+        return clause_selectivity<decltype(t)>(clause, *min, *max, cell_num);
+      },
+      []() { return 1.0; });
+
+  return {Status::Ok(), non_null * selectivity};
+}
+
+std::tuple<Status, std::optional<double>> QueryCondition::tile_selectivity(
+    FragmentMetadata* fragment, uint64_t tile_idx) const {
+  // As in `can_skip_tile`, this assumes all clauses are combined with a
+  // logical "AND".
+  double selectivity = 1.0;
+  for (const auto& clause : clauses_) {
+    if (index_can_skip_tile(clause, fragment, tile_idx)) {
+      return {Status::Ok(), 0.0};
+    }
+
+    if (!clause_has_tile_metadata(clause, fragment)) {
+      continue;
+    }
+
+    auto&& [st, clause_sel] = clause_selectivity(clause, fragment, tile_idx);
+    RETURN_NOT_OK_TUPLE(st, std::nullopt);
+    selectivity *= *clause_sel;
+    if (selectivity == 0.0) {
+      break;
+    }
+  }
+
+  return {Status::Ok(), selectivity};
 }
 
 void QueryCondition::set_clauses(std::vector<Clause>&& clauses) {
@@ -33,6 +33,7 @@
 #ifndef TILEDB_QUERY_CONDITION_H
 #define TILEDB_QUERY_CONDITION_H
 
+#include <string_view>
 #include <unordered_set>
 
 #include "tiledb/common/status.h"
@@ -46,6 +47,7 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+class FragmentMetadata;
 enum class QueryConditionCombinationOp : uint8_t;
 
 class QueryCondition {
@@ -180,6 +182,26 @@ class QueryCondition {
       uint64_t condition_value_size,
       QueryConditionOp op);
 
+  /**
+   * Initializes the instance with a set of values, for the set membership
+   * operators. The members are stored sorted and deduplicated, prefixed by
+   * their count and offsets, as the condition value of the clause.
+   *
+   * @param field_name The name of the field this operation applies to.
+   * @param values The members of the set, stored contiguously.
+   * @param values_size The byte size of `values`.
+   * @param offsets The starting byte offset of each member in `values`.
+   * @param offsets_num The number of members.
+   * @param op The set operation, `IN` or `NOT_IN`.
+   */
+  Status init_set(
+      std::string&& field_name,
+      const void* values,
+      uint64_t values_size,
+      const uint64_t* offsets,
+      uint64_t offsets_num,
+      QueryConditionOp op);
+
   /**
    * Verifies that the current state contains supported comparison
    * operations. Currently, we support the following:
@@ -252,7 +274,10 @@ class QueryCondition {
       uint8_t* result_buffer);
 
   /**
-   * Applies this query condition to a set of cells.
+   * Applies this query condition to a set of cells. The clauses are all
+   * evaluated on one block of cells before moving to the next block, so that
+   * the bitmap and attribute data for the block stay in cache, and the
+   * remaining clauses are skipped for blocks where no cell is left.
    *
    * @param array_schema The array schema.
    * @param result_tile The result tile to get the cells from.
@@ -267,6 +292,48 @@ class QueryCondition {
       std::vector<BitmapType>& result_bitmap,
       uint64_t* cell_count);
 
+  /**
+   * Returns the names of the fields for which the tile metadata of the input
+   * fragment can be used by `can_skip_tile`. Tile min/max values need to be
+   * loaded for `min_max_names` and tile null counts for `null_count_names`.
+   *
+   * @param fragment The fragment metadata.
+   * @param min_max_names The fields requiring the tile min/max values.
+   * @param null_count_names The fields requiring the tile null counts.
+   */
+  void tile_metadata_names(
+      const FragmentMetadata* fragment,
+      std::vector<std::string>* min_max_names,
+      std::vector<std::string>* null_count_names) const;
+
+  /**
+   * Checks, using only the tile min/max and null count metadata and the
+   * attribute value index, whether no cell of a fragment tile can satisfy
+   * this condition. The metadata listed by `tile_metadata_names` must be
+   * loaded for the fragment.
+   *
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, true if the tile can be skipped.
+   */
+  std::tuple<Status, std::optional<bool>> can_skip_tile(
+      FragmentMetadata* fragment, uint64_t tile_idx) const;
+
+  /**
+   * Estimates, using only the tile min/max and null count metadata and the
+   * attribute value index, the fraction of the cells of a fragment tile that
+   * satisfy this condition. Values are assumed to be uniformly distributed
+   * between the tile min and max, and clauses to be independent. Clauses
+   * that cannot be evaluated on the tile metadata keep all cells. The
+   * metadata listed by `tile_metadata_names` must be loaded for the fragment.
+   *
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, the estimated fraction in [0, 1].
+   */
+  std::tuple<Status, std::optional<double>> tile_selectivity(
+      FragmentMetadata* fragment, uint64_t tile_idx) const;
+
   /**
    * Sets the clauses. This is internal state to only be used in
    * the serialization path.
@@ -337,6 +404,119 @@ class QueryCondition {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /**
+   * Validates the encoded set of values of an `IN` or `NOT_IN` clause
+   * against the attribute it is applied on.
+   *
+   * @param clause The set clause.
+   * @param attribute The attribute of the clause.
+   * @return Status
+   */
+  Status check_set(const Clause& clause, const Attribute* attribute) const;
+
+  /**
+   * Returns true if the values of the attribute are compared as strings, i.e.
+   * as `char*` of the cell size, rather than as single values. This is the
+   * case for ASCII strings and multi-char cells, fixed or var size.
+   */
+  static bool compares_as_string(const Attribute* attribute);
+
+  /**
+   * Returns true if the tile metadata of the input fragment can be used to
+   * evaluate the clause on whole tiles. This is the case for fixed-size,
+   * single-value numeric and datetime attributes and for strings in fragments
+   * with a format version that stores the tile min/max values.
+   */
+  bool clause_has_tile_metadata(
+      const Clause& clause, const FragmentMetadata* fragment) const;
+
+  /**
+   * Checks, using the attribute value index of the fragment, whether no
+   * cell of a tile can satisfy an equality or `IN` clause. Returns false if
+   * the attribute is not indexed.
+   *
+   * @param clause The clause to check.
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return True if the tile can be skipped.
+   */
+  bool index_can_skip_tile(
+      const Clause& clause,
+      const FragmentMetadata* fragment,
+      uint64_t tile_idx) const;
+
+  /**
+   * Checks, using the tile min/max values, whether no cell of a tile can
+   * satisfy the clause.
+   *
+   * @param clause The clause to check.
+   * @param min The tile min value.
+   * @param max The tile max value.
+   * @return True if the tile can be skipped.
+   */
+  template <typename T>
+  bool can_skip_tile(
+      const Clause& clause, const void* min, const void* max) const;
+
+  /**
+   * Checks, using the tile min/max values of a string attribute,
+   * whether no cell of a tile can satisfy the clause.
+   *
+   * @param clause The clause to check.
+   * @param min A lower bound of the tile values.
+   * @param max An upper bound of the tile values.
+   * @return True if the tile can be skipped.
+   */
+  bool can_skip_tile_var(
+      const Clause& clause,
+      std::string_view min,
+      std::string_view max) const;
+
+  /**
+   * Checks, using the tile metadata, whether no cell of a tile can satisfy
+   * the clause.
+   *
+   * @param clause The clause to check.
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, true if the tile can be skipped.
+   */
+  std::tuple<Status, std::optional<bool>> can_skip_tile(
+      const Clause& clause,
+      FragmentMetadata* fragment,
+      uint64_t tile_idx) const;
+
+  /**
+   * Estimates the fraction of the non-null cells of a tile that satisfy the
+   * clause, from the tile min/max values.
+   *
+   * @param clause The clause to estimate.
+   * @param min The tile min value.
+   * @param max The tile max value.
+   * @param cell_num The number of cells in the tile.
+   * @return The estimated fraction in [0, 1].
+   */
+  template <typename T>
+  double clause_selectivity(
+      const Clause& clause,
+      const void* min,
+      const void* max,
+      uint64_t cell_num) const;
+
+  /**
+   * Estimates, from the tile metadata, the fraction of the cells of a tile
+   * that satisfy the clause.
+   *
+   * @param clause The clause to estimate.
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, the estimated fraction in [0, 1].
+   */
+  std::tuple<Status, std::optional<double>> clause_selectivity(
+      const Clause& clause,
+      FragmentMetadata* fragment,
+      uint64_t tile_idx) const;
+
   /**
    * Applies a clause on primitive-typed result cell slabs,
    * templated for a query condition operator.
@@ -405,6 +585,7 @@ class QueryCondition {
    * @param src_cell The cell offset in the source tile.
    * @param stride The stride between cells.
    * @param var_size The attribute is var sized or not.
+   * @param run_encoded The attribute is run-length encoded or not.
    * @param result_buffer The result buffer.
    */
   template <typename T, QueryConditionOp Op>
@@ -416,6 +597,7 @@ class QueryCondition {
       const uint64_t src_cell,
       const uint64_t stride,
       const bool var_size,
+      const bool run_encoded,
       uint8_t* result_buffer) const;
 
   /**
@@ -428,6 +610,7 @@ class QueryCondition {
    * @param src_cell The cell offset in the source tile.
    * @param stride The stride between cells.
    * @param var_size The attribute is var sized or not.
+   * @param run_encoded The attribute is run-length encoded or not.
    * @param result_buffer The result buffer.
    * @return Status.
    */
@@ -440,6 +623,7 @@ class QueryCondition {
       const uint64_t src_cell,
       const uint64_t stride,
       const bool var_size,
+      const bool run_encoded,
       uint8_t* result_buffer) const;
 
   /**
@@ -466,6 +650,52 @@ class QueryCondition {
       const uint64_t stride,
       uint8_t* result_buffer) const;
 
+  /**
+   * Compares fixed size, single value cells against the condition value and
+   * clears the results of the cells that do not match. As the values are
+   * typed and contiguous when `stride` is 1, the loop is vectorized by the
+   * compiler.
+   *
+   * @param values The first value to compare.
+   * @param count The number of values to compare.
+   * @param stride The stride between values.
+   * @param condition_value The value to compare against.
+   * @param condition_value_size The byte size of `condition_value`.
+   * @param result The results, one per value.
+   */
+  template <typename T, QueryConditionOp Op, typename ResultType>
+  static void apply_cmp_fixed(
+      const T* values,
+      const uint64_t count,
+      const uint64_t stride,
+      const void* condition_value,
+      const uint64_t condition_value_size,
+      ResultType* result);
+
+  /**
+   * Compares fixed size cells that hold long runs of equal values, as for
+   * run-length encoded attributes, against the condition value. Each run is
+   * compared once and the results of the cells of a run that does not match
+   * are cleared at once.
+   *
+   * @param cells The first cell to compare.
+   * @param cell_size The byte size of a cell.
+   * @param count The number of cells to compare.
+   * @param stride The stride between cells.
+   * @param condition_value The value to compare against.
+   * @param condition_value_size The byte size of `condition_value`.
+   * @param result The results, one per cell.
+   */
+  template <typename T, QueryConditionOp Op, typename ResultType>
+  static void apply_cmp_runs(
+      const char* cells,
+      const uint64_t cell_size,
+      const uint64_t count,
+      const uint64_t stride,
+      const void* condition_value,
+      const uint64_t condition_value_size,
+      ResultType* result);
+
   /**
    * Applies a clause on a sparse result tile,
    * templated for a query condition operator.
@@ -473,6 +703,9 @@ class QueryCondition {
    * @param clause The clause to apply.
    * @param result_tile The result tile to get the cells from.
    * @param var_size The attribute is var sized or not.
+   * @param run_encoded The attribute is run-length encoded or not.
+   * @param start The first cell to process.
+   * @param length The number of cells to process.
    * @param result_bitmap The result bitmap.
    */
   template <typename T, QueryConditionOp Op, typename BitmapType>
@@ -480,6 +713,9 @@ class QueryCondition {
       const QueryCondition::Clause& clause,
       ResultTile& result_tile,
       const bool var_size,
+      const bool run_encoded,
+      const uint64_t start,
+      const uint64_t length,
       std::vector<BitmapType>& result_bitmap) const;
 
   /**
@@ -488,6 +724,9 @@ class QueryCondition {
    * @param clause The clause to apply.
    * @param result_tile The result tile to get the cells from.
    * @param var_size The attribute is var sized or not.
+   * @param run_encoded The attribute is run-length encoded or not.
+   * @param start The first cell to process.
+   * @param length The number of cells to process.
    * @param result_bitmap The result bitmap.
    * @return Status.
    */
@@ -496,6 +735,9 @@ class QueryCondition {
       const Clause& clause,
       ResultTile& result_tile,
       const bool var_size,
+      const bool run_encoded,
+      const uint64_t start,
+      const uint64_t length,
       std::vector<BitmapType>& result_bitmap) const;
 
   /**
@@ -505,6 +747,8 @@ class QueryCondition {
    * @param clause The clause to apply.
    * @param array_schema The current array schema.
    * @param result_tile The result tile to get the cells from.
+   * @param start The first cell to process.
+   * @param length The number of cells to process.
    * @param result_bitmap The result bitmap.
    * @return Status.
    */
@@ -513,6 +757,8 @@ class QueryCondition {
       const QueryCondition::Clause& clause,
       const ArraySchema* const array_schema,
       ResultTile& result_tile,
+      const uint64_t start,
+      const uint64_t length,
       std::vector<BitmapType>& result_bitmap) const;
 };
 
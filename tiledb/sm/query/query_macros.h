@@ -40,8 +40,9 @@ namespace sm {
 
 #ifndef RETURN_CANCEL_OR_ERROR
 /**
- * Returns an error status if the given Status is not Status::Ok, or
- * if the StorageManager that owns this Query has requested cancellation.
+ * Returns an error status if the given Status is not Status::Ok, if the
+ * StorageManager that owns this Query has requested cancellation, or if the
+ * Query itself was cancelled or exceeded its deadline.
  */
 #define RETURN_CANCEL_OR_ERROR(s)                              \
   do {                                                         \
@@ -50,14 +51,20 @@ namespace sm {
       return _s;                                               \
     } else if (storage_manager_->cancellation_in_progress()) { \
       return Status_QueryError("Query cancelled.");            \
+    } else {                                                   \
+      Status _cancel_st = ThreadPool::check_cancellation();    \
+      if (!_cancel_st.ok()) {                                  \
+        return _cancel_st;                                     \
+      }                                                        \
     }                                                          \
   } while (false)
 #endif
 
 #ifndef RETURN_CANCEL_OR_ERROR_TUPLE
 /**
- * Returns an error status if the given Status is not Status::Ok, or
- * if the StorageManager that owns this Query has requested cancellation.
+ * Returns an error status if the given Status is not Status::Ok, if the
+ * StorageManager that owns this Query has requested cancellation, or if the
+ * Query itself was cancelled or exceeded its deadline.
  */
 #define RETURN_CANCEL_OR_ERROR_TUPLE(s)                             \
   do {                                                              \
@@ -66,15 +73,21 @@ namespace sm {
       return {_s, std::nullopt};                                    \
     } else if (storage_manager_->cancellation_in_progress()) {      \
       return {Status_QueryError("Query cancelled."), std::nullopt}; \
+    } else {                                                        \
+      Status _cancel_st = ThreadPool::check_cancellation();         \
+      if (!_cancel_st.ok()) {                                       \
+        return {_cancel_st, std::nullopt};                          \
+      }                                                             \
     }                                                               \
   } while (false)
 #endif
 
 #ifndef RETURN_CANCEL_OR_ERROR_ELSE
 /**
- * Returns an error status if the given Status is not Status::Ok, or
- * if the StorageManager that owns this Query has requested cancellation.
- * If an error status is returned, also execute the 'else' code.
+ * Returns an error status if the given Status is not Status::Ok, if the
+ * StorageManager that owns this Query has requested cancellation, or if the
+ * Query itself was cancelled or exceeded its deadline. If an error status is
+ * returned, also execute the 'else' code.
  */
 #define RETURN_CANCEL_OR_ERROR_ELSE(s, _else)                  \
   do {                                                         \
@@ -85,14 +98,21 @@ namespace sm {
     } else if (storage_manager_->cancellation_in_progress()) { \
       _else;                                                   \
       return Status_QueryError("Query cancelled.");            \
+    } else {                                                   \
+      Status _cancel_st = ThreadPool::check_cancellation();    \
+      if (!_cancel_st.ok()) {                                  \
+        _else;                                                 \
+        return _cancel_st;                                     \
+      }                                                        \
     }                                                          \
   } while (false)
 #endif
 
 #ifndef BREAK_CANCEL_OR_ERROR
 /**
- * If the given status 's' is not Status::Ok, sets the Status variable
- * 'outer_st' to 's' and breaks the containing loop.
+ * If the given status 's' is not Status::Ok, or if the query is cancelled,
+ * sets the Status variable 'outer_st' to the error and breaks the
+ * containing loop.
  */
 #define BREAK_CANCEL_OR_ERROR(outer_st, s)                     \
   do {                                                         \
@@ -103,6 +123,12 @@ namespace sm {
     } else if (storage_manager_->cancellation_in_progress()) { \
       outer_st = Status_QueryError("Query cancelled.");        \
       break;                                                   \
+    } else {                                                   \
+      Status _cancel_st = ThreadPool::check_cancellation();    \
+      if (!_cancel_st.ok()) {                                  \
+        outer_st = _cancel_st;                                 \
+        break;                                                 \
+      }                                                        \
     }                                                          \
   } while (false)
 #endif
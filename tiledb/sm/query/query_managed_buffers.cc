@@ -0,0 +1,359 @@
+/**
+ * @file   query_managed_buffers.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the QueryManagedBuffers class.
+ */
+
+#include "tiledb/sm/query/query_managed_buffers.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/config/config.h"
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/enums/query_status_details.h"
+#include "tiledb/sm/query/query.h"
+
+#include <algorithm>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The smallest capacity of a chunk buffer. */
+const uint64_t min_chunk_capacity = 64 * 1024;
+
+}  // namespace
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+QueryManagedBuffers::QueryManagedBuffers(Query* query)
+    : query_(query)
+    , chunk_num_(0)
+    , running_(false)
+    , budget_(0)
+    , budget_var_(0)
+    , alloced_(0)
+    , alloced_var_(0) {
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+void QueryManagedBuffers::add(const std::string& name) {
+  if (fields_.find(name) != fields_.end())
+    return;
+
+  names_.push_back(name);
+  fields_[name];
+}
+
+bool QueryManagedBuffers::has(const std::string& name) const {
+  return fields_.find(name) != fields_.end();
+}
+
+bool QueryManagedBuffers::running() const {
+  return running_;
+}
+
+Status QueryManagedBuffers::run() {
+  for (const auto& name : query_->buffer_names()) {
+    if (!has(name))
+      return Status_QueryError(
+          "Cannot submit query; Buffer '" + name +
+          "' set by the user cannot be mixed with managed buffers");
+  }
+
+  // Release the chunks of the previous run.
+  for (auto& [name, field] : fields_) {
+    field.data_ = BufferList();
+    field.offsets_ = BufferList();
+    field.validity_ = BufferList();
+  }
+  chunk_num_ = 0;
+  alloced_ = 0;
+  alloced_var_ = 0;
+
+  bool found = false;
+  RETURN_NOT_OK(
+      query_->config()->get<uint64_t>("sm.memory_budget", &budget_, &found));
+  assert(found);
+  RETURN_NOT_OK(query_->config()->get<uint64_t>(
+      "sm.memory_budget_var", &budget_var_, &found));
+  assert(found);
+
+  if (capacity() == 0)
+    init_capacities();
+  if (!scale_capacities(1))
+    return Status_QueryError(
+        "Cannot submit query; The memory budget is too small for the managed "
+        "buffers");
+
+  // Submit into new chunks while the query stops on full buffers, doubling
+  // their capacity each time, or on the memory budget of the query.
+  running_ = true;
+  auto st = Status::Ok();
+  while (true) {
+    bool kept = false;
+    st = submit_chunk(&kept);
+    if (!st.ok() || query_->status() != QueryStatus::INCOMPLETE)
+      break;
+
+    const bool full = query_->status_incomplete_reason() ==
+                      QueryStatusDetailsReason::REASON_USER_BUFFER_SIZE;
+    const uint64_t prev_capacity = capacity();
+    if (!scale_capacities(full ? 2 : 1))
+      break;
+
+    if (!kept && full && capacity() <= prev_capacity) {
+      // The chunks are released by the next submission, which leaves room
+      // for larger ones.
+      if (chunk_num_ == 0)
+        st = Status_QueryError(
+            "Cannot submit query; The managed buffers cannot hold a single "
+            "result within the memory budget");
+      break;
+    }
+  }
+  running_ = false;
+
+  return st;
+}
+
+uint64_t QueryManagedBuffers::chunk_num() const {
+  return chunk_num_;
+}
+
+Status QueryManagedBuffers::get(
+    const std::string& name,
+    uint64_t chunk,
+    const void** data,
+    uint64_t* data_size,
+    const void** offsets,
+    uint64_t* offsets_size,
+    const uint8_t** validity,
+    uint64_t* validity_size) {
+  auto it = fields_.find(name);
+  if (it == fields_.end())
+    return Status_QueryError(
+        "Cannot get managed buffer; Buffer of '" + name + "' is not managed");
+  if (chunk >= chunk_num_)
+    return Status_QueryError(
+        "Cannot get managed buffer; Chunk index " + std::to_string(chunk) +
+        " out of bounds");
+
+  auto& field = it->second;
+  Buffer* buffer = nullptr;
+  RETURN_NOT_OK(field.data_.get_buffer(chunk, &buffer));
+  *data = buffer->data();
+  *data_size = buffer->size();
+
+  *offsets = nullptr;
+  *offsets_size = 0;
+  if (field.offsets_.num_buffers() > 0) {
+    RETURN_NOT_OK(field.offsets_.get_buffer(chunk, &buffer));
+    *offsets = buffer->data();
+    *offsets_size = buffer->size();
+  }
+
+  *validity = nullptr;
+  *validity_size = 0;
+  if (field.validity_.num_buffers() > 0) {
+    RETURN_NOT_OK(field.validity_.get_buffer(chunk, &buffer));
+    *validity = static_cast<const uint8_t*>(buffer->data());
+    *validity_size = buffer->size();
+  }
+
+  return Status::Ok();
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+void QueryManagedBuffers::init_capacities() {
+  const auto array_schema = query_->array_schema();
+  for (const auto& name : names_) {
+    const bool var_size = array_schema->var_size(name);
+    const bool nullable = array_schema->is_nullable(name);
+
+    // A failed estimate leaves the smallest capacity, the chunks grow on
+    // the first submissions instead.
+    uint64_t size = 0, size_var = 0, size_validity = 0;
+    auto c_name = name.c_str();
+    Status st;
+    if (!var_size && !nullable)
+      st = query_->get_est_result_size(c_name, &size);
+    else if (!nullable)
+      st = query_->get_est_result_size(c_name, &size, &size_var);
+    else if (!var_size)
+      st = query_->get_est_result_size_nullable(c_name, &size, &size_validity);
+    else
+      st = query_->get_est_result_size_nullable(
+          c_name, &size, &size_var, &size_validity);
+    if (!st.ok())
+      size = size_var = size_validity = 0;
+
+    auto& field = fields_[name];
+    if (var_size) {
+      field.offsets_capacity_ = std::max(size, min_chunk_capacity);
+      field.data_capacity_ = std::max(size_var, min_chunk_capacity);
+    } else {
+      field.data_capacity_ = std::max(size, min_chunk_capacity);
+    }
+    if (nullable)
+      field.validity_capacity_ = std::max(size_validity, min_chunk_capacity);
+  }
+}
+
+bool QueryManagedBuffers::scale_capacities(uint64_t factor) {
+  const auto array_schema = query_->array_schema();
+  uint64_t next = 0, next_var = 0;
+  for (const auto& [name, field] : fields_) {
+    if (array_schema->var_size(name)) {
+      next += field.offsets_capacity_ * factor;
+      next_var += field.data_capacity_ * factor;
+    } else {
+      next += field.data_capacity_ * factor;
+    }
+    next += field.validity_capacity_ * factor;
+  }
+
+  const uint64_t left = budget_ > alloced_ ? budget_ - alloced_ : 0;
+  const uint64_t left_var =
+      budget_var_ > alloced_var_ ? budget_var_ - alloced_var_ : 0;
+  if (left < min_chunk_capacity || (next_var > 0 && left_var == 0))
+    return false;
+
+  // Shrink the capacities proportionally to fit the budget left.
+  const double ratio = next > left ? double(left) / next : 1.0;
+  const double ratio_var =
+      next_var > left_var ? double(left_var) / next_var : 1.0;
+  auto scale = [factor](uint64_t capacity, double r) {
+    return std::max<uint64_t>(
+        static_cast<uint64_t>(capacity * factor * r), sizeof(uint64_t));
+  };
+  for (auto& [name, field] : fields_) {
+    if (array_schema->var_size(name)) {
+      field.offsets_capacity_ = scale(field.offsets_capacity_, ratio);
+      field.data_capacity_ = scale(field.data_capacity_, ratio_var);
+    } else {
+      field.data_capacity_ = scale(field.data_capacity_, ratio);
+    }
+    if (field.validity_capacity_ > 0)
+      field.validity_capacity_ = scale(field.validity_capacity_, ratio);
+  }
+
+  return true;
+}
+
+uint64_t QueryManagedBuffers::capacity() const {
+  uint64_t ret = 0;
+  for (const auto& [name, field] : fields_)
+    ret += field.data_capacity_ + field.offsets_capacity_ +
+           field.validity_capacity_;
+  return ret;
+}
+
+Status QueryManagedBuffers::submit_chunk(bool* kept) {
+  struct Chunk {
+    Buffer data_;
+    Buffer offsets_;
+    Buffer validity_;
+  };
+  std::vector<Chunk> chunks(names_.size());
+
+  // Point the query to the new chunk.
+  for (size_t i = 0; i < names_.size(); i++) {
+    const auto& name = names_[i];
+    auto& field = fields_[name];
+    auto& chunk = chunks[i];
+    RETURN_NOT_OK(chunk.data_.realloc(field.data_capacity_));
+    field.data_size_ = field.data_capacity_;
+    if (field.offsets_capacity_ > 0) {
+      RETURN_NOT_OK(chunk.offsets_.realloc(field.offsets_capacity_));
+      field.offsets_size_ = field.offsets_capacity_;
+      RETURN_NOT_OK(query_->set_offsets_buffer(
+          name,
+          static_cast<uint64_t*>(chunk.offsets_.data()),
+          &field.offsets_size_));
+    }
+    RETURN_NOT_OK(
+        query_->set_data_buffer(name, chunk.data_.data(), &field.data_size_));
+    if (field.validity_capacity_ > 0) {
+      RETURN_NOT_OK(chunk.validity_.realloc(field.validity_capacity_));
+      field.validity_size_ = field.validity_capacity_;
+      RETURN_NOT_OK(query_->set_validity_buffer(
+          name,
+          static_cast<uint8_t*>(chunk.validity_.data()),
+          &field.validity_size_));
+    }
+  }
+
+  RETURN_NOT_OK(query_->submit());
+
+  const auto& first = fields_[names_[0]];
+  *kept = first.offsets_capacity_ > 0 ? first.offsets_size_ != 0 :
+                                        first.data_size_ != 0;
+  if (!*kept)
+    return Status::Ok();
+
+  // Keep the chunk, sized to its results.
+  for (size_t i = 0; i < names_.size(); i++) {
+    auto& field = fields_[names_[i]];
+    auto& chunk = chunks[i];
+    chunk.data_.set_size(field.data_size_);
+    if (field.offsets_capacity_ > 0) {
+      alloced_ += chunk.offsets_.alloced_size();
+      alloced_var_ += chunk.data_.alloced_size();
+      chunk.offsets_.set_size(field.offsets_size_);
+      RETURN_NOT_OK(field.offsets_.add_buffer(std::move(chunk.offsets_)));
+    } else {
+      alloced_ += chunk.data_.alloced_size();
+    }
+    RETURN_NOT_OK(field.data_.add_buffer(std::move(chunk.data_)));
+    if (field.validity_capacity_ > 0) {
+      alloced_ += chunk.validity_.alloced_size();
+      chunk.validity_.set_size(field.validity_size_);
+      RETURN_NOT_OK(field.validity_.add_buffer(std::move(chunk.validity_)));
+    }
+  }
+  chunk_num_++;
+  query_->stats()->add_counter("managed_buffer_chunk_num", 1);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,223 @@
+/**
+ * @file   query_managed_buffers.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines the QueryManagedBuffers class.
+ */
+
+#ifndef TILEDB_QUERY_MANAGED_BUFFERS_H
+#define TILEDB_QUERY_MANAGED_BUFFERS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/buffer/buffer_list.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Query;
+
+/**
+ * Result buffers of a read query allocated by the library instead of the
+ * user. The query is submitted into chunks of buffers sized after the
+ * estimated result sizes, and resubmitted into a new chunk of twice the size
+ * when it stops on full buffers, until it completes or the chunks reach the
+ * memory budget (`sm.memory_budget` for the fixed-sized data, offsets and
+ * validity, `sm.memory_budget_var` for the var-sized data). Most queries
+ * thus complete in a single submission from the user's point of view.
+ *
+ * The chunks of every field are kept in buffer lists and handed to the user
+ * without copies. Chunk `i` holds the results of the `i`-th internal
+ * submission for every field, with the offsets of a var-sized field
+ * relative to the var-sized data of the same chunk.
+ */
+class QueryManagedBuffers {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param query The read query.
+   */
+  explicit QueryManagedBuffers(Query* query);
+
+  /** Destructor. */
+  ~QueryManagedBuffers() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Adds a field whose result buffers are managed. */
+  void add(const std::string& name);
+
+  /** Returns true if the buffers of `name` are managed. */
+  bool has(const std::string& name) const;
+
+  /** Returns true while `run` submits the query. */
+  bool running() const;
+
+  /**
+   * Submits the query into new chunks until it completes or the chunks
+   * reach the memory budget, in which case the query is left incomplete.
+   * The chunks of a previous run are released first.
+   *
+   * @return Status
+   */
+  Status run();
+
+  /** Returns the number of chunks holding results. */
+  uint64_t chunk_num() const;
+
+  /**
+   * Retrieves the results of a field in a chunk. The sizes are in bytes.
+   *
+   * @param name The attribute/dimension name.
+   * @param chunk The chunk index.
+   * @param data Set to the data, or the var-sized data.
+   * @param data_size Set to the size of `data`.
+   * @param offsets Set to the offsets of a var-sized field, else `nullptr`.
+   * @param offsets_size Set to the size of `offsets`.
+   * @param validity Set to the validity of a nullable field, else `nullptr`.
+   * @param validity_size Set to the size of `validity`.
+   * @return Status
+   */
+  Status get(
+      const std::string& name,
+      uint64_t chunk,
+      const void** data,
+      uint64_t* data_size,
+      const void** offsets,
+      uint64_t* offsets_size,
+      const uint8_t** validity,
+      uint64_t* validity_size);
+
+ private:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** The managed buffers of a field. */
+  struct Field {
+    /** The chunks of the data, or the var-sized data of a var-sized field. */
+    BufferList data_;
+
+    /** The chunks of the offsets of a var-sized field. */
+    BufferList offsets_;
+
+    /** The chunks of the validity of a nullable field. */
+    BufferList validity_;
+
+    /** The capacity of the next chunk of `data_`. */
+    uint64_t data_capacity_ = 0;
+
+    /** The capacity of the next chunk of `offsets_`. */
+    uint64_t offsets_capacity_ = 0;
+
+    /** The capacity of the next chunk of `validity_`. */
+    uint64_t validity_capacity_ = 0;
+
+    /** The data size set on the query, updated by the submissions. */
+    uint64_t data_size_ = 0;
+
+    /** The offsets size set on the query, updated by the submissions. */
+    uint64_t offsets_size_ = 0;
+
+    /** The validity size set on the query, updated by the submissions. */
+    uint64_t validity_size_ = 0;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The read query. */
+  Query* query_;
+
+  /** The managed field names, in the order they were added. */
+  std::vector<std::string> names_;
+
+  /** The managed buffers, per field name. */
+  std::unordered_map<std::string, Field> fields_;
+
+  /** The number of chunks holding results. */
+  uint64_t chunk_num_;
+
+  /** True while `run` submits the query. */
+  bool running_;
+
+  /** The memory budget of the fixed-sized data, offsets and validity. */
+  uint64_t budget_;
+
+  /** The memory budget of the var-sized data. */
+  uint64_t budget_var_;
+
+  /** The bytes allocated to the kept chunks, within `budget_`. */
+  uint64_t alloced_;
+
+  /** The bytes allocated to the kept chunks, within `budget_var_`. */
+  uint64_t alloced_var_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Sizes the first chunk of every field after its estimated result size. */
+  void init_capacities();
+
+  /**
+   * Scales the capacities of the next chunk by `factor`, within the memory
+   * budget left by the kept chunks. Returns false if no budget is left.
+   */
+  bool scale_capacities(uint64_t factor);
+
+  /** Returns the sum of the capacities of the next chunk. */
+  uint64_t capacity() const;
+
+  /**
+   * Submits the query once into a new chunk, which is kept if it holds
+   * results.
+   *
+   * @param kept Set to true if the chunk was kept.
+   * @return Status
+   */
+  Status submit_chunk(bool* kept);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_MANAGED_BUFFERS_H
@@ -0,0 +1,201 @@
+/**
+ * @file   query_progress.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the QueryProgress class.
+ */
+
+#include "tiledb/sm/query/query_progress.h"
+
+#include <sstream>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Writes `str` as a JSON string. */
+void write_json_str(std::stringstream& ss, const std::string& str) {
+  ss << "\"";
+  for (const char c : str) {
+    if (c == '"' || c == '\\')
+      ss << '\\';
+    ss << c;
+  }
+  ss << "\"";
+}
+
+}  // namespace
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+QueryProgress::QueryProgress()
+    : phase_(QueryPhase::NOT_STARTED)
+    , phase_start_(std::chrono::steady_clock::now())
+    , tiles_read_(0)
+    , tiles_total_(0)
+    , bytes_read_(0)
+    , bytes_total_(0) {
+  phase_ns_.fill(0);
+  for (auto& bytes : phase_bytes_)
+    bytes = 0;
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+const std::string& QueryProgress::phase_str(QueryPhase phase) {
+  static const std::array<std::string, phase_num_> names = {
+      "not_started",
+      "load_metadata",
+      "read_tiles",
+      "unfilter_tiles",
+      "process_tiles",
+      "copy_results",
+      "completed"};
+  return names[static_cast<size_t>(phase)];
+}
+
+QueryPhase QueryProgress::phase() const {
+  return phase_;
+}
+
+void QueryProgress::set_phase(QueryPhase phase) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  const auto now = std::chrono::steady_clock::now();
+  phase_ns_[static_cast<size_t>(phase_.load())] +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - phase_start_)
+          .count();
+  phase_start_ = now;
+  phase_ = phase;
+}
+
+void QueryProgress::add_tile_to_read(
+    const std::string& fragment, const std::string& field, uint64_t bytes) {
+  tiles_total_ += 1;
+  bytes_total_ += bytes;
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto& fragment_totals = fragment_totals_[fragment];
+  fragment_totals.tiles_ += 1;
+  fragment_totals.bytes_ += bytes;
+  auto& field_totals = field_totals_[field];
+  field_totals.tiles_ += 1;
+  field_totals.bytes_ += bytes;
+}
+
+void QueryProgress::add_tile_read() {
+  tiles_read_ += 1;
+}
+
+void QueryProgress::add_bytes_read(uint64_t bytes) {
+  bytes_read_ += bytes;
+  phase_bytes_[static_cast<size_t>(QueryPhase::READ_TILES)] += bytes;
+}
+
+void QueryProgress::add_phase_bytes(QueryPhase phase, uint64_t bytes) {
+  phase_bytes_[static_cast<size_t>(phase)] += bytes;
+}
+
+uint64_t QueryProgress::tiles_read() const {
+  return tiles_read_;
+}
+
+uint64_t QueryProgress::tiles_total() const {
+  return tiles_total_;
+}
+
+uint64_t QueryProgress::bytes_read() const {
+  return bytes_read_;
+}
+
+uint64_t QueryProgress::bytes_total() const {
+  return bytes_total_;
+}
+
+std::string QueryProgress::report() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Include the time spent in the current phase so far.
+  auto phase_ns = phase_ns_;
+  phase_ns[static_cast<size_t>(phase_.load())] +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - phase_start_)
+          .count();
+
+  std::stringstream ss;
+  ss << "{\n";
+  ss << "  \"phase\": \"" << phase_str(phase_) << "\",\n";
+  ss << "  \"tiles_read\": " << tiles_read_ << ",\n";
+  ss << "  \"tiles_total\": " << tiles_total_ << ",\n";
+  ss << "  \"bytes_read\": " << bytes_read_ << ",\n";
+  ss << "  \"bytes_total\": " << bytes_total_ << ",\n";
+
+  // The phases the query went through.
+  ss << "  \"phases\": [";
+  bool first = true;
+  for (size_t p = 1; p < phase_num_ - 1; p++) {
+    if (phase_ns[p] == 0 && phase_bytes_[p] == 0)
+      continue;
+    ss << (first ? "\n" : ",\n");
+    first = false;
+    ss << "    {\"phase\": \"" << phase_str(static_cast<QueryPhase>(p))
+       << "\", \"time_ms\": " << phase_ns[p] / 1000000.0
+       << ", \"bytes\": " << phase_bytes_[p] << "}";
+  }
+  ss << (first ? "],\n" : "\n  ],\n");
+
+  // The tiles and bytes read per fragment and per field.
+  auto write_totals = [&ss](
+                          const std::string& key,
+                          const std::map<std::string, ReadTotals>& totals) {
+    ss << "  \"" << key << "\": [";
+    bool first = true;
+    for (const auto& [name, t] : totals) {
+      ss << (first ? "\n" : ",\n");
+      first = false;
+      ss << "    {\"name\": ";
+      write_json_str(ss, name);
+      ss << ", \"tiles\": " << t.tiles_ << ", \"bytes\": " << t.bytes_ << "}";
+    }
+    ss << (first ? "]" : "\n  ]");
+  };
+  write_totals("fragments", fragment_totals_);
+  ss << ",\n";
+  write_totals("fields", field_totals_);
+  ss << "\n}\n";
+
+  return ss.str();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,194 @@
+/**
+ * @file   query_progress.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Defines the QueryProgress class.
+ */
+
+#ifndef TILEDB_QUERY_PROGRESS_H
+#define TILEDB_QUERY_PROGRESS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "tiledb/common/macros.h"
+
+namespace tiledb {
+namespace sm {
+
+/** The phases a read query goes through, in their usual order. */
+enum class QueryPhase : uint8_t {
+  NOT_STARTED = 0,
+  LOAD_METADATA,
+  READ_TILES,
+  UNFILTER_TILES,
+  PROCESS_TILES,
+  COPY_RESULTS,
+  COMPLETED
+};
+
+/**
+ * Tracks the progress of a query while it runs: its current phase, the
+ * tiles read out of the tiles scheduled for reading and the bytes read out
+ * of the bytes scheduled. It also accumulates the time and bytes of every
+ * phase, and the tiles and bytes read per fragment and per field, for the
+ * report produced once the query has run.
+ *
+ * The progress is updated by the readers, possibly from several threads,
+ * and may be polled from another thread while the query is submitted.
+ */
+class QueryProgress {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  QueryProgress();
+
+  /** Destructor. */
+  ~QueryProgress() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(QueryProgress);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(QueryProgress);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the string representation of a phase. */
+  static const std::string& phase_str(QueryPhase phase);
+
+  /** Returns the current phase. */
+  QueryPhase phase() const;
+
+  /**
+   * Enters a phase. The time since the previous phase was entered is
+   * attributed to that phase.
+   */
+  void set_phase(QueryPhase phase);
+
+  /**
+   * Schedules a tile for reading.
+   *
+   * @param fragment The URI of the fragment of the tile.
+   * @param field The attribute or dimension of the tile.
+   * @param bytes The bytes to read for the tile, 0 if it is cached.
+   */
+  void add_tile_to_read(
+      const std::string& fragment, const std::string& field, uint64_t bytes);
+
+  /** Records that a scheduled tile was read in full. */
+  void add_tile_read();
+
+  /** Records that `bytes` of the scheduled bytes were read. */
+  void add_bytes_read(uint64_t bytes);
+
+  /** Attributes `bytes` to a phase, e.g. the bytes unfiltered or copied. */
+  void add_phase_bytes(QueryPhase phase, uint64_t bytes);
+
+  /** Returns the number of tiles read in full. */
+  uint64_t tiles_read() const;
+
+  /** Returns the number of tiles scheduled for reading. */
+  uint64_t tiles_total() const;
+
+  /** Returns the number of bytes read. */
+  uint64_t bytes_read() const;
+
+  /** Returns the number of bytes scheduled for reading. */
+  uint64_t bytes_total() const;
+
+  /**
+   * Returns a JSON report of the time and bytes spent in every phase, and
+   * of the tiles and bytes read per fragment and per field.
+   */
+  std::string report() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE DATATYPES         */
+  /* ********************************* */
+
+  /** The number of phases. */
+  static const size_t phase_num_ =
+      static_cast<size_t>(QueryPhase::COMPLETED) + 1;
+
+  /** The tiles and bytes read from a fragment or for a field. */
+  struct ReadTotals {
+    uint64_t tiles_ = 0;
+    uint64_t bytes_ = 0;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Protects the phase changes and the per fragment and field totals. */
+  mutable std::mutex mtx_;
+
+  /** The current phase. */
+  std::atomic<QueryPhase> phase_;
+
+  /** The time the current phase was entered. */
+  std::chrono::steady_clock::time_point phase_start_;
+
+  /** The nanoseconds spent in every phase. */
+  std::array<uint64_t, phase_num_> phase_ns_;
+
+  /** The bytes attributed to every phase. */
+  std::array<std::atomic<uint64_t>, phase_num_> phase_bytes_;
+
+  /** The number of tiles read in full. */
+  std::atomic<uint64_t> tiles_read_;
+
+  /** The number of tiles scheduled for reading. */
+  std::atomic<uint64_t> tiles_total_;
+
+  /** The number of bytes read. */
+  std::atomic<uint64_t> bytes_read_;
+
+  /** The number of bytes scheduled for reading. */
+  std::atomic<uint64_t> bytes_total_;
+
+  /** The tiles and bytes scheduled per fragment URI. */
+  std::map<std::string, ReadTotals> fragment_totals_;
+
+  /** The tiles and bytes scheduled per field. */
+  std::map<std::string, ReadTotals> field_totals_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_PROGRESS_H
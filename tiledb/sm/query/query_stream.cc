@@ -0,0 +1,252 @@
+/**
+ * @file   query_stream.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the QueryStream class.
+ */
+
+#include "tiledb/sm/query/query_stream.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/enums/query_status_details.h"
+#include "tiledb/sm/query/query.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+QueryStream::QueryStream(Query* query, uint64_t max_inflight)
+    : query_(query)
+    , batches_(max_inflight)
+    , done_(false)
+    , callback_status_(Status::Ok())
+    , current_batch_(nullptr) {
+  for (const auto& name : query_->buffer_names())
+    user_buffers_.emplace_back(name, query_->buffer(name));
+
+  // Buffers are allocated with at least a byte, as the query rejects null
+  // buffers.
+  const auto array_schema = query_->array_schema();
+  for (auto& batch : batches_) {
+    for (const auto& [name, buffer] : user_buffers_) {
+      auto& batch_buffer = batch[name];
+      if (array_schema->var_size(name)) {
+        batch_buffer.offsets_.resize(
+            std::max<uint64_t>(buffer.original_buffer_size_, 1));
+        batch_buffer.data_.resize(
+            std::max<uint64_t>(buffer.original_buffer_var_size_, 1));
+      } else {
+        batch_buffer.data_.resize(
+            std::max<uint64_t>(buffer.original_buffer_size_, 1));
+      }
+
+      if (array_schema->is_nullable(name))
+        batch_buffer.validity_.resize(
+            std::max<uint64_t>(buffer.original_validity_vector_size_, 1));
+    }
+  }
+
+  for (uint64_t b = 0; b < batches_.size(); b++)
+    free_.push_back(b);
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+Status QueryStream::run(const Callback& callback) {
+  std::thread consumer([this, &callback]() { consume(callback); });
+
+  // Fill the free batches until the query completes or the callback stops
+  // the stream.
+  auto st = Status::Ok();
+  do {
+    uint64_t b;
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_.wait(lck, [this]() {
+        return !free_.empty() || !callback_status_.ok();
+      });
+      if (!callback_status_.ok())
+        break;
+
+      b = free_.front();
+      free_.pop_front();
+    }
+
+    st = set_batch_buffers(batches_[b]);
+    if (st.ok())
+      st = query_->submit();
+    if (!st.ok())
+      break;
+
+    // A submission may stop on the memory budget without any result, the
+    // batch is then filled again.
+    const bool results = has_results(batches_[b]);
+    if (!results && query_->status() == QueryStatus::INCOMPLETE &&
+        query_->status_incomplete_reason() ==
+            QueryStatusDetailsReason::REASON_USER_BUFFER_SIZE) {
+      st = Status_QueryError(
+          "Cannot stream query; The buffers are too small to hold a single "
+          "result");
+      break;
+    }
+
+    if (results)
+      query_->stats()->add_counter("stream_batch_num", 1);
+
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      if (results)
+        ready_.push_back(b);
+      else
+        free_.push_back(b);
+    }
+    cv_.notify_all();
+  } while (query_->status() == QueryStatus::INCOMPLETE);
+
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    done_ = true;
+  }
+  cv_.notify_all();
+  consumer.join();
+
+  RETURN_NOT_OK(restore_user_buffers());
+  RETURN_NOT_OK(st);
+  return callback_status_;
+}
+
+const QueryStream::Batch* QueryStream::current_batch() const {
+  return current_batch_;
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+Status QueryStream::set_batch_buffers(Batch& batch) {
+  for (const auto& [name, buffer] : user_buffers_) {
+    auto& batch_buffer = batch[name];
+    if (!batch_buffer.offsets_.empty()) {
+      batch_buffer.offsets_size_ = buffer.original_buffer_size_;
+      batch_buffer.data_size_ = buffer.original_buffer_var_size_;
+      RETURN_NOT_OK(query_->set_offsets_buffer(
+          name,
+          reinterpret_cast<uint64_t*>(batch_buffer.offsets_.data()),
+          &batch_buffer.offsets_size_));
+    } else {
+      batch_buffer.data_size_ = buffer.original_buffer_size_;
+    }
+    RETURN_NOT_OK(query_->set_data_buffer(
+        name, batch_buffer.data_.data(), &batch_buffer.data_size_));
+
+    if (!batch_buffer.validity_.empty()) {
+      batch_buffer.validity_size_ = buffer.original_validity_vector_size_;
+      RETURN_NOT_OK(query_->set_validity_buffer(
+          name, batch_buffer.validity_.data(), &batch_buffer.validity_size_));
+    }
+  }
+
+  return Status::Ok();
+}
+
+Status QueryStream::restore_user_buffers() {
+  for (auto& [name, buffer] : user_buffers_) {
+    if (query_->array_schema()->var_size(name)) {
+      RETURN_NOT_OK(query_->set_offsets_buffer(
+          name, static_cast<uint64_t*>(buffer.buffer_), buffer.buffer_size_));
+      RETURN_NOT_OK(query_->set_data_buffer(
+          name, buffer.buffer_var_, buffer.buffer_var_size_));
+    } else {
+      RETURN_NOT_OK(
+          query_->set_data_buffer(name, buffer.buffer_, buffer.buffer_size_));
+    }
+
+    if (query_->array_schema()->is_nullable(name))
+      RETURN_NOT_OK(query_->set_validity_buffer(
+          name,
+          buffer.validity_vector_.bytemap(),
+          buffer.validity_vector_.bytemap_size()));
+  }
+
+  return Status::Ok();
+}
+
+bool QueryStream::has_results(const Batch& batch) const {
+  if (batch.empty())
+    return false;
+
+  const auto& batch_buffer = batch.begin()->second;
+  return batch_buffer.offsets_.empty() ? batch_buffer.data_size_ != 0 :
+                                         batch_buffer.offsets_size_ != 0;
+}
+
+void QueryStream::consume(const Callback& callback) {
+  while (true) {
+    uint64_t b;
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_.wait(lck, [this]() { return !ready_.empty() || done_; });
+      if (ready_.empty())
+        return;
+
+      b = ready_.front();
+      ready_.pop_front();
+    }
+
+    current_batch_ = &batches_[b];
+    auto st = callback();
+    current_batch_ = nullptr;
+
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      free_.push_back(b);
+      if (!st.ok()) {
+        callback_status_ = st;
+        ready_.clear();
+      }
+    }
+    cv_.notify_all();
+
+    if (!st.ok())
+      return;
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
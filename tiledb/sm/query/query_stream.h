@@ -0,0 +1,190 @@
+/**
+ * @file   query_stream.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines the QueryStream class.
+ */
+
+#ifndef TILEDB_QUERY_STREAM_H
+#define TILEDB_QUERY_STREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/query/query_buffer.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Query;
+
+/**
+ * Streams the results of a read query to a callback. The query is submitted
+ * into batches of buffers owned by the stream, sized like the buffers set
+ * by the user, and each filled batch is handed to the callback on a
+ * consumer thread while the query is resubmitted into the next free batch.
+ * At most `max_inflight` batches are being filled or waiting for the
+ * callback at any time, which bounds the memory used by the stream. The
+ * callback is called on one thread, with the batches in the order of the
+ * results.
+ */
+class QueryStream {
+ public:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** The results of a batch for one buffer. */
+  struct BatchBuffer {
+    /** The data, or the var-sized data of a var-sized field. */
+    std::vector<uint8_t> data_;
+
+    /** The size of the results in `data_`. */
+    uint64_t data_size_ = 0;
+
+    /** The offsets of a var-sized field. */
+    std::vector<uint8_t> offsets_;
+
+    /** The size of the results in `offsets_`. */
+    uint64_t offsets_size_ = 0;
+
+    /** The validity of a nullable field. */
+    std::vector<uint8_t> validity_;
+
+    /** The size of the results in `validity_`. */
+    uint64_t validity_size_ = 0;
+  };
+
+  /** The results of a batch, per buffer name. */
+  using Batch = std::unordered_map<std::string, BatchBuffer>;
+
+  /**
+   * The function called with each batch, retrieved with `current_batch`.
+   * A status other than Ok stops the stream.
+   */
+  using Callback = std::function<Status()>;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param query The read query to stream, with its buffers set.
+   * @param max_inflight The maximum number of batches in flight.
+   */
+  QueryStream(Query* query, uint64_t max_inflight);
+
+  /** Destructor. */
+  ~QueryStream() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Submits the query until it completes, calling `callback` with every
+   * batch of results. The buffers set by the user on the query are restored
+   * on return, they are never written to.
+   *
+   * @param callback The function to call with each batch.
+   * @return Status
+   */
+  Status run(const Callback& callback);
+
+  /**
+   * Returns the batch passed to the callback, only valid while the callback
+   * runs.
+   */
+  const Batch* current_batch() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The query to stream. */
+  Query* query_;
+
+  /** The buffers set by the user, which give the capacity of the batches. */
+  std::vector<std::pair<std::string, QueryBuffer>> user_buffers_;
+
+  /** The batches, `max_inflight` of them. */
+  std::vector<Batch> batches_;
+
+  /** The batches that can be filled. */
+  std::deque<uint64_t> free_;
+
+  /** The filled batches waiting for the callback, in order. */
+  std::deque<uint64_t> ready_;
+
+  /** Set when no more batches will be filled. */
+  bool done_;
+
+  /** The status of the callback, which stops the stream if not Ok. */
+  Status callback_status_;
+
+  /** The batch passed to the callback. */
+  const Batch* current_batch_;
+
+  /** Protects the queues and the statuses. */
+  std::mutex mtx_;
+
+  /** Signals changes of the queues. */
+  std::condition_variable cv_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Points the buffers of the query to a batch, reset to its capacity. */
+  Status set_batch_buffers(Batch& batch);
+
+  /** Points the buffers of the query back to the user buffers. */
+  Status restore_user_buffers();
+
+  /** Returns true if the query copied results to the batch. */
+  bool has_results(const Batch& batch) const;
+
+  /** Calls `callback` with the filled batches until the stream is done. */
+  void consume(const Callback& callback);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_STREAM_H
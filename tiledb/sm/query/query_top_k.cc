@@ -0,0 +1,317 @@
+/**
+ * @file   query_top_k.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the QueryTopK class.
+ */
+
+#include "tiledb/sm/query/query_top_k.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
+#include "tiledb/sm/query/result_tile.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Compares two values of type `T` stored in the low bytes of `a` and `b`. */
+template <class T>
+int compare_values(uint64_t a, uint64_t b) {
+  T value_a, value_b;
+  std::memcpy(&value_a, &a, sizeof(T));
+  std::memcpy(&value_b, &b, sizeof(T));
+  return value_a < value_b ? -1 : (value_b < value_a ? 1 : 0);
+}
+
+/** Stores `value` in the low bytes of a `uint64_t`. */
+template <class T>
+uint64_t store_value(const T value) {
+  uint64_t ret = 0;
+  std::memcpy(&ret, &value, sizeof(T));
+  return ret;
+}
+
+/** Returns true if `value` is not a NaN. */
+template <class T>
+bool is_ordered(const T value) {
+  return value == value;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+QueryTopK::QueryTopK(const std::string& field_name, uint64_t k, bool largest)
+    : field_name_(field_name)
+    , k_(k)
+    , largest_(largest)
+    , type_(Datatype::ANY)
+    , nullable_(false)
+    , compare_(nullptr) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status QueryTopK::init(const ArraySchema* array_schema) {
+  if (k_ == 0)
+    return Status_QueryError("Cannot set top K; K must be positive");
+
+  if (!array_schema->is_attr(field_name_))
+    return Status_QueryError(
+        "Cannot set top K; Unknown attribute '" + field_name_ + "'");
+
+  if (array_schema->var_size(field_name_) ||
+      array_schema->cell_val_num(field_name_) != 1)
+    return Status_QueryError(
+        "Cannot set top K; The attribute must be fixed size with one value "
+        "per cell");
+
+  type_ = array_schema->type(field_name_);
+  nullable_ = array_schema->is_nullable(field_name_);
+  compare_ = apply_with_type(
+      type_,
+      [](auto t) {
+        using T = decltype(t);
+        return &compare_values<T>;
+      },
+      []() -> int (*)(uint64_t, uint64_t) { return nullptr; });
+  if (compare_ == nullptr)
+    return Status_QueryError(
+        "Cannot set top K; Unsupported datatype " + datatype_str(type_));
+
+  reset();
+  return Status::Ok();
+}
+
+void QueryTopK::reset() {
+  heap_.clear();
+}
+
+const std::string& QueryTopK::field_name() const {
+  return field_name_;
+}
+
+uint64_t QueryTopK::k() const {
+  return k_;
+}
+
+bool QueryTopK::largest() const {
+  return largest_;
+}
+
+bool QueryTopK::has_tile_metadata(const FragmentMetadata* fragment) const {
+  // Tile metadata was introduced in format version 11.
+  if (fragment->format_version() <= 10)
+    return false;
+
+  const auto schema = fragment->array_schema();
+  return schema->is_attr(field_name_) &&
+         TileMetadataGenerator::has_min_max_metadata(
+             type_, false, false, schema->cell_val_num(field_name_));
+}
+
+std::tuple<Status, std::optional<bool>> QueryTopK::can_skip_tile(
+    FragmentMetadata* fragment, uint64_t tile_idx) const {
+  if (heap_.size() < k_)
+    return {Status::Ok(), false};
+
+  auto&& [st, bound] = tile_bound(fragment, tile_idx);
+  RETURN_NOT_OK_TUPLE(st, std::nullopt);
+  if (!bound->has_value())
+    return {Status::Ok(), false};
+
+  // Ties may still beat the K-th cell on their position.
+  const int cmp = compare_(**bound, heap_.front().value_);
+  return {Status::Ok(), largest_ ? cmp < 0 : cmp > 0};
+}
+
+Status QueryTopK::sort_tiles(
+    const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata,
+    std::vector<ResultTile*>& result_tiles) const {
+  std::vector<std::pair<std::optional<uint64_t>, ResultTile*>> bounds;
+  bounds.reserve(result_tiles.size());
+  for (auto rt : result_tiles) {
+    auto&& [st, bound] = tile_bound(
+        fragment_metadata[rt->frag_idx()].get(), rt->tile_idx());
+    RETURN_NOT_OK(st);
+    bounds.emplace_back(*bound, rt);
+  }
+
+  std::stable_sort(
+      bounds.begin(), bounds.end(), [this](const auto& a, const auto& b) {
+        if (!a.first.has_value() || !b.first.has_value())
+          return !a.first.has_value() && b.first.has_value();
+
+        const int cmp = compare_(*a.first, *b.first);
+        return largest_ ? cmp > 0 : cmp < 0;
+      });
+
+  for (uint64_t t = 0; t < bounds.size(); t++)
+    result_tiles[t] = bounds[t].second;
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status QueryTopK::add_tile(
+    ResultTile* result_tile,
+    uint64_t cell_num,
+    const std::vector<BitmapType>& bitmap) {
+  // The attribute is not present in this fragment, it has no candidate.
+  auto tile_tuple = result_tile->tile_tuple(field_name_);
+  if (tile_tuple == nullptr)
+    return Status::Ok();
+
+  const auto& tile = std::get<0>(*tile_tuple);
+  const uint8_t* validity =
+      nullable_ ? std::get<2>(*tile_tuple).data_as<uint8_t>() : nullptr;
+
+  return apply_with_type(
+      type_,
+      [&](auto t) {
+        using T = decltype(t);
+        add_tile<T, BitmapType>(
+            result_tile, tile.data_as<T>(), validity, cell_num, bitmap);
+        return Status::Ok();
+      },
+      [&]() {
+        return Status_QueryError(
+            "Cannot select top K; Unsupported datatype " +
+            datatype_str(type_));
+      });
+}
+
+void QueryTopK::merge(const QueryTopK& other) {
+  for (const auto& cell : other.heap_)
+    add(cell);
+}
+
+std::vector<QueryTopK::Cell> QueryTopK::cells() const {
+  auto ret = heap_;
+  std::sort(ret.begin(), ret.end(), [](const Cell& a, const Cell& b) {
+    return std::tie(a.frag_idx_, a.tile_idx_, a.pos_) <
+           std::tie(b.frag_idx_, b.tile_idx_, b.pos_);
+  });
+  return ret;
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+std::tuple<Status, std::optional<std::optional<uint64_t>>>
+QueryTopK::tile_bound(FragmentMetadata* fragment, uint64_t tile_idx) const {
+  if (!has_tile_metadata(fragment))
+    return {Status::Ok(), std::optional<uint64_t>()};
+
+  auto&& [st, bound, bound_size] =
+      largest_ ? fragment->get_tile_max(field_name_, tile_idx) :
+                 fragment->get_tile_min(field_name_, tile_idx);
+  RETURN_NOT_OK_TUPLE(st, std::nullopt);
+
+  // A NaN bound does not order the tile.
+  uint64_t value = 0;
+  std::memcpy(&value, *bound, datatype_size(type_));
+  const bool ordered = apply_with_type(
+      type_,
+      [&](auto t) {
+        using T = decltype(t);
+        T tile_bound;
+        std::memcpy(&tile_bound, *bound, sizeof(T));
+        return is_ordered(tile_bound);
+      },
+      []() { return false; });
+  if (!ordered)
+    return {Status::Ok(), std::optional<uint64_t>()};
+
+  return {Status::Ok(), value};
+}
+
+bool QueryTopK::better(const Cell& a, const Cell& b) const {
+  const int cmp = compare_(a.value_, b.value_);
+  if (cmp != 0)
+    return largest_ ? cmp > 0 : cmp < 0;
+
+  return std::tie(a.frag_idx_, a.tile_idx_, a.pos_) <
+         std::tie(b.frag_idx_, b.tile_idx_, b.pos_);
+}
+
+void QueryTopK::add(const Cell& cell) {
+  // The heap is ordered on `better`, which puts the worst cell on top.
+  auto cmp = [this](const Cell& a, const Cell& b) { return better(a, b); };
+  if (heap_.size() < k_) {
+    heap_.emplace_back(cell);
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+  } else if (better(cell, heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), cmp);
+    heap_.back() = cell;
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+  }
+}
+
+template <class T, class BitmapType>
+void QueryTopK::add_tile(
+    const ResultTile* result_tile,
+    const T* values,
+    const uint8_t* validity,
+    uint64_t cell_num,
+    const std::vector<BitmapType>& bitmap) {
+  const unsigned frag_idx = result_tile->frag_idx();
+  const uint64_t tile_idx = result_tile->tile_idx();
+  for (uint64_t c = 0; c < cell_num; c++) {
+    if ((!bitmap.empty() && bitmap[c] == 0) ||
+        (validity != nullptr && validity[c] == 0) || !is_ordered(values[c]))
+      continue;
+
+    add({store_value<T>(values[c]), frag_idx, tile_idx, c});
+  }
+}
+
+// Explicit template instantiations
+template Status QueryTopK::add_tile<uint8_t>(
+    ResultTile*, uint64_t, const std::vector<uint8_t>&);
+template Status QueryTopK::add_tile<uint64_t>(
+    ResultTile*, uint64_t, const std::vector<uint64_t>&);
+
+}  // namespace sm
+}  // namespace tiledb
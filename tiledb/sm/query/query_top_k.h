@@ -0,0 +1,241 @@
+/**
+ * @file   query_top_k.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Defines the QueryTopK class.
+ */
+
+#ifndef TILEDB_QUERY_TOP_K_H
+#define TILEDB_QUERY_TOP_K_H
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "tiledb/common/common.h"
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class FragmentMetadata;
+class ResultTile;
+enum class Datatype : uint8_t;
+
+/**
+ * Selects the K cells of a read query with the largest (or smallest) values
+ * of an attribute. The candidates are kept in a bounded heap whose worst
+ * cell is the current K-th value, and tiles whose min/max tile metadata
+ * cannot beat it are skipped without being read. Partial selections built
+ * over different tiles are merged into the final one.
+ *
+ * Cells with equal values are ranked by fragment, tile and position, so the
+ * selected cells do not depend on the order in which tiles are processed.
+ */
+class QueryTopK {
+ public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** A selected cell. */
+  struct Cell {
+    /** The attribute value, stored in the low bytes. */
+    uint64_t value_;
+
+    /** The fragment index. */
+    unsigned frag_idx_;
+
+    /** The tile index in the fragment. */
+    uint64_t tile_idx_;
+
+    /** The cell position in the tile. */
+    uint64_t pos_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  QueryTopK(const std::string& field_name, uint64_t k, bool largest);
+
+  /** Copy constructor. */
+  QueryTopK(const QueryTopK& rhs) = default;
+
+  /** Destructor. */
+  ~QueryTopK() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Verifies that the attribute can be ordered and caches its properties.
+   *
+   * @param array_schema The current array schema.
+   * @return Status
+   */
+  Status init(const ArraySchema* array_schema);
+
+  /** Resets the selection. */
+  void reset();
+
+  /** Returns the name of the ordering attribute. */
+  const std::string& field_name() const;
+
+  /** Returns the number of cells to select. */
+  uint64_t k() const;
+
+  /** Returns true if the largest values are selected. */
+  bool largest() const;
+
+  /**
+   * Returns true if the tile min/max values of the attribute are available
+   * in the input fragment.
+   */
+  bool has_tile_metadata(const FragmentMetadata* fragment) const;
+
+  /**
+   * Returns true if no cell of a tile can be selected, because the bound of
+   * the tile from its metadata is worse than the current K-th value. The
+   * tile metadata must have been loaded for the fragment.
+   *
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, true if the tile can be skipped.
+   */
+  std::tuple<Status, std::optional<bool>> can_skip_tile(
+      FragmentMetadata* fragment, uint64_t tile_idx) const;
+
+  /**
+   * Sorts result tiles so that the tiles with the best bound in their tile
+   * metadata come first, after the tiles without tile metadata. Processing
+   * the tiles in this order fills the selection with good cells early, so
+   * that more of the remaining tiles can be skipped.
+   *
+   * @param fragment_metadata The fragment metadata of the array.
+   * @param result_tiles The result tiles to sort.
+   * @return Status
+   */
+  Status sort_tiles(
+      const std::vector<tdb_shared_ptr<FragmentMetadata>>& fragment_metadata,
+      std::vector<ResultTile*>& result_tiles) const;
+
+  /**
+   * Adds the cells of a tile to the selection. Only the cells `c` with a
+   * non zero `bitmap[c]` are candidates, an empty bitmap means all cells in
+   * the tile are. Null values are never selected.
+   *
+   * @tparam BitmapType The bitmap type.
+   * @param result_tile The result tile, with the attribute data loaded.
+   * @param cell_num The number of cells in the tile.
+   * @param bitmap The cell multiplicities.
+   * @return Status
+   */
+  template <class BitmapType>
+  Status add_tile(
+      ResultTile* result_tile,
+      uint64_t cell_num,
+      const std::vector<BitmapType>& bitmap);
+
+  /** Merges the selection of another top K into this one. */
+  void merge(const QueryTopK& other);
+
+  /** Returns the selected cells, sorted by fragment, tile and position. */
+  std::vector<Cell> cells() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The name of the ordering attribute. */
+  std::string field_name_;
+
+  /** The number of cells to select. */
+  uint64_t k_;
+
+  /** Whether the largest values are selected. */
+  bool largest_;
+
+  /** The datatype of the attribute. */
+  Datatype type_;
+
+  /** Whether the attribute is nullable. */
+  bool nullable_;
+
+  /**
+   * Compares two values of the attribute type stored in the low bytes of
+   * `uint64_t` values, returning a negative, zero or positive number.
+   */
+  int (*compare_)(uint64_t, uint64_t);
+
+  /** The selected cells, a heap with the worst selected cell on top. */
+  std::vector<Cell> heap_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Retrieves the bound of a tile from its tile metadata, which is its max
+   * value when selecting the largest values and its min value otherwise.
+   *
+   * @param fragment The fragment metadata.
+   * @param tile_idx The tile index in the fragment.
+   * @return Status, the bound stored in the low bytes of a `uint64_t`, or
+   *     `std::nullopt` if the tile has no usable bound.
+   */
+  std::tuple<Status, std::optional<std::optional<uint64_t>>> tile_bound(
+      FragmentMetadata* fragment, uint64_t tile_idx) const;
+
+  /** Returns true if `a` ranks before `b`. */
+  bool better(const Cell& a, const Cell& b) const;
+
+  /** Adds a candidate cell to the selection. */
+  void add(const Cell& cell);
+
+  /** Adds the cells of a tile with values of type `T`. */
+  template <class T, class BitmapType>
+  void add_tile(
+      const ResultTile* result_tile,
+      const T* values,
+      const uint8_t* validity,
+      uint64_t cell_num,
+      const std::vector<BitmapType>& bitmap);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_TOP_K_H
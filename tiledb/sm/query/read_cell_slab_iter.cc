@@ -64,9 +64,11 @@ ReadCellSlabIter<T>::ReadCellSlabIter(
                 subarray->array()->array_schema_latest()->domain() :
                 nullptr;
   layout_ = (subarray != nullptr) ? subarray->layout() : Layout::ROW_MAJOR;
+  dim_num_ = (domain_ != nullptr) ? domain_->dim_num() : 0;
   cell_slab_iter_ = CellSlabIter<T>(subarray);
   end_ = true;
   compute_cell_offsets();
+  set_compute_result_cell_slabs_func();
 }
 
 /* ****************************** */
@@ -154,11 +156,12 @@ void ReadCellSlabIter<T>::compute_cell_offsets_row() {
 }
 
 template <class T>
+template <unsigned D>
 void ReadCellSlabIter<T>::compute_cell_slab_start(
     const T* cell_slab_coords,
     const std::vector<T>& tile_start_coords,
     uint64_t* start) {
-  auto dim_num = domain_->dim_num();
+  const unsigned dim_num = (D == 0) ? dim_num_ : D;
 
   // Compute start
   *start = 0;
@@ -167,13 +170,14 @@ void ReadCellSlabIter<T>::compute_cell_slab_start(
 }
 
 template <class T>
+template <unsigned D>
 void ReadCellSlabIter<T>::compute_cell_slab_overlap(
     const CellSlab<T>& cell_slab,
     const NDRange& frag_domain,
     std::vector<T>* slab_overlap,
     uint64_t* overlap_length,
     unsigned* overlap_type) {
-  auto dim_num = domain_->dim_num();
+  const unsigned dim_num = (D == 0) ? dim_num_ : D;
   assert(slab_overlap->size() == dim_num);
   unsigned slab_dim = (layout_ == Layout::ROW_MAJOR) ? dim_num - 1 : 0;
   T slab_end, slab_start;
@@ -207,6 +211,7 @@ void ReadCellSlabIter<T>::compute_cell_slab_overlap(
 }
 
 template <class T>
+template <unsigned D>
 void ReadCellSlabIter<T>::compute_result_cell_slabs(
     const CellSlab<T>& cell_slab) {
   // Find the result space tile
@@ -219,7 +224,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs(
   // Only the valid result coordinates are considered (non-valid
   // coordinates are the filtered ones).
 
-  auto dim_num = domain_->dim_num();
+  const unsigned dim_num = (D == 0) ? dim_num_ : D;
   unsigned slab_dim = (layout_ == Layout::ROW_MAJOR) ? dim_num - 1 : 0;
   CellSlab<T> cell_slab_copy = cell_slab;
   auto slab_start = cell_slab_copy.coords_[slab_dim];
@@ -257,7 +262,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs(
     auto result_coord = *(const T*)(*result_coords_)[i].coord(slab_dim);
     if (result_coord > slab_start) {
       cell_slab_copy.length_ = result_coord - cell_slab_copy.coords_[slab_dim];
-      compute_result_cell_slabs_dense(cell_slab_copy, &result_space_tile);
+      compute_result_cell_slabs_dense<D>(cell_slab_copy, &result_space_tile);
     }
 
     // Add result
@@ -275,17 +280,18 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs(
   auto cell_slab_end = (T)(cell_slab.coords_[slab_dim] + cell_slab.length_ - 1);
   if (slab_start <= cell_slab_end) {
     cell_slab_copy.length_ = slab_end - slab_start + 1;
-    compute_result_cell_slabs_dense(cell_slab_copy, &result_space_tile);
+    compute_result_cell_slabs_dense<D>(cell_slab_copy, &result_space_tile);
   }
 }
 
 template <class T>
+template <unsigned D>
 void ReadCellSlabIter<T>::compute_result_cell_slabs_dense(
     const CellSlab<T>& cell_slab, ResultSpaceTile<T>* result_space_tile) {
   std::list<CellSlab<T>> to_process;
   to_process.push_back(cell_slab);
   const auto& frag_domains = result_space_tile->frag_domains();
-  auto dim_num = domain_->dim_num();
+  const unsigned dim_num = (D == 0) ? dim_num_ : D;
   std::vector<T> slab_overlap;
   slab_overlap.resize(dim_num);
   unsigned overlap_type;  // 0: no overlap, 1: full overlap, 2: partial overlap
@@ -298,7 +304,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs_dense(
   // in the result space tile
   for (const auto& fd : frag_domains) {
     for (auto pit = to_process.begin(); pit != to_process.end();) {
-      compute_cell_slab_overlap(
+      compute_cell_slab_overlap<D>(
           *pit, fd.second, &slab_overlap, &overlap_length, &overlap_type);
 
       // No overlap
@@ -308,7 +314,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs_dense(
       }
 
       // Compute new result cell slab
-      compute_cell_slab_start(
+      compute_cell_slab_start<D>(
           &slab_overlap[0], result_space_tile->start_coords(), &start);
       auto tile = result_space_tile->result_tile(fd.first);
       result_cell_slabs.emplace_back(tile, start, overlap_length);
@@ -330,7 +336,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs_dense(
   }
 
   // Append temporary results for empty cell slabs
-  compute_result_cell_slabs_empty(
+  compute_result_cell_slabs_empty<D>(
       *result_space_tile, to_process, result_cell_slabs);
 
   // Sort the temporary result cell slabs on starting position
@@ -344,6 +350,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs_dense(
 }
 
 template <class T>
+template <unsigned D>
 void ReadCellSlabIter<T>::compute_result_cell_slabs_empty(
     const ResultSpaceTile<T>& result_space_tile,
     const std::list<CellSlab<T>>& to_process,
@@ -355,7 +362,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs_empty(
   // Create result cell slabs that belong to no fragment
   uint64_t start;
   for (auto pit = to_process.begin(); pit != to_process.end(); ++pit) {
-    compute_cell_slab_start(
+    compute_cell_slab_start<D>(
         &pit->coords_[0], result_space_tile.start_coords(), &start);
     result_cell_slabs.emplace_back(nullptr, start, pit->length_);
   }
@@ -424,7 +431,32 @@ void ReadCellSlabIter<T>::update_result_cell_slab() {
   result_cell_slabs_.clear();
   auto cell_slab = cell_slab_iter_.cell_slab();
 
-  compute_result_cell_slabs(cell_slab);
+  (this->*compute_result_cell_slabs_func_)(cell_slab);
+}
+
+template <class T>
+void ReadCellSlabIter<T>::set_compute_result_cell_slabs_func() {
+  switch (dim_num_) {
+    case 1:
+      compute_result_cell_slabs_func_ =
+          &ReadCellSlabIter<T>::compute_result_cell_slabs<1>;
+      break;
+    case 2:
+      compute_result_cell_slabs_func_ =
+          &ReadCellSlabIter<T>::compute_result_cell_slabs<2>;
+      break;
+    case 3:
+      compute_result_cell_slabs_func_ =
+          &ReadCellSlabIter<T>::compute_result_cell_slabs<3>;
+      break;
+    case 4:
+      compute_result_cell_slabs_func_ =
+          &ReadCellSlabIter<T>::compute_result_cell_slabs<4>;
+      break;
+    default:
+      compute_result_cell_slabs_func_ =
+          &ReadCellSlabIter<T>::compute_result_cell_slabs<0>;
+  }
 }
 
 // Explicit template instantiations
@@ -132,6 +132,16 @@ class ReadCellSlabIter {
   /** The subarray layout. */
   Layout layout_;
 
+  /** The number of dimensions. */
+  unsigned dim_num_;
+
+  /**
+   * Computes the result cell slabs of a cell slab, specialized on the
+   * number of dimensions (up to 4). Set in the constructor.
+   */
+  void (ReadCellSlabIter<T>::*compute_result_cell_slabs_func_)(
+      const CellSlab<T>&);
+
   /** `True` if the iterator has reached its end. */
   bool end_;
 
@@ -210,7 +220,11 @@ class ReadCellSlabIter {
    * @param tile_start_coords The global position of the first cell in the
    *     tile the cell slab belongs to.
    * @param start The computed start cell position of the slab.
+   *
+   * @tparam D The number of dimensions, so that the loops over them are
+   *     unrolled, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void compute_cell_slab_start(
       const T* cell_slab_coords,
       const std::vector<T>& tile_start_coords,
@@ -228,7 +242,11 @@ class ReadCellSlabIter {
    *     a subset of the input cell slab).
    * @param overlap_type The type of overlap, where `0` means no overlap,
    *     `1` means full overlap, and `2` means partial overlap.
+   *
+   * @tparam D The number of dimensions, so that the loops over them are
+   *     unrolled, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void compute_cell_slab_overlap(
       const CellSlab<T>& cell_slab,
       const NDRange& frag_domain,
@@ -244,13 +262,21 @@ class ReadCellSlabIter {
    *
    * In other words, this function creates result cell slabs based
    * on both sparse and dense fragments in the dense array.
+   *
+   * @tparam D The number of dimensions, so that the loops over them are
+   *     unrolled, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void compute_result_cell_slabs(const CellSlab<T>& cell_slab);
 
   /**
    * Given the input cell slab and result space tile,
    * it creates result cell slabs based on dense fragments in the dense array.
+   *
+   * @tparam D The number of dimensions, so that the loops over them are
+   *     unrolled, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void compute_result_cell_slabs_dense(
       const CellSlab<T>& cell_slab, ResultSpaceTile<T>* result_space_tile);
 
@@ -259,7 +285,11 @@ class ReadCellSlabIter {
    * it creates result cell slabs that correspond to "empty" cells
    * (i.e., to cells without any overlap with any fragments), and appends
    * them to `result_cell_slabs`.
+   *
+   * @tparam D The number of dimensions, so that the loops over them are
+   *     unrolled, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void compute_result_cell_slabs_empty(
       const ResultSpaceTile<T>& result_space_tile,
       const std::list<CellSlab<T>>& to_process,
@@ -293,6 +323,11 @@ class ReadCellSlabIter {
    * retrieved from `cell_slab_iter_`.
    */
   void update_result_cell_slab();
+
+  /**
+   * Sets `compute_result_cell_slabs_func_` for the number of dimensions.
+   */
+  void set_compute_result_cell_slabs_func();
 };
 
 }  // namespace sm
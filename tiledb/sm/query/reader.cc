@@ -39,9 +39,11 @@
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/hilbert_order.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/read_cell_slab_iter.h"
 #include "tiledb/sm/query/result_tile.h"
 #include "tiledb/sm/stats/global_stats.h"
@@ -249,6 +251,23 @@ Status Reader::dowork() {
 void Reader::reset() {
 }
 
+Status Reader::rebind() {
+  if (array_schema_->dense() && !subarray_.is_set())
+    return logger_->status(Status_ReaderError(
+        "Cannot rebind reader; Dense reads must have a subarray set"));
+
+  // Only the read state depends on the subarray.
+  RETURN_NOT_OK(check_subarray());
+  RETURN_NOT_OK(init_read_state());
+  RETURN_NOT_OK(check_validity_buffer_sizes());
+
+  return Status::Ok();
+}
+
+void Reader::set_progress(QueryProgress* progress) {
+  progress_ = progress;
+}
+
 /* ****************************** */
 /*         PRIVATE METHODS        */
 /* ****************************** */
@@ -404,12 +423,12 @@ Status Reader::compute_range_result_coords(
 
   // To de-dupe the ranges, we may need to sort them. If the
   // read layout is UNORDERED, we will sort by the cell layout.
-  // If the cell layout is hilbert, we will sort in row-major to
+  // If the cell layout is hilbert or morton, we will sort in row-major to
   // avoid the expense of calculating hilbert values.
   Layout sort_layout = layout_;
   if (sort_layout == Layout::UNORDERED) {
     sort_layout = cell_order;
-    if (sort_layout == Layout::HILBERT) {
+    if (layout_is_curve(sort_layout)) {
       sort_layout = Layout::ROW_MAJOR;
     }
   }
@@ -651,6 +670,7 @@ Status Reader::copy_coordinates(
     const std::vector<ResultTile*>& result_tiles,
     std::vector<ResultCellSlab>& result_cell_slabs) {
   auto timer_se = stats_->start_timer("copy_coordinates");
+  set_progress_phase(QueryPhase::COPY_RESULTS);
 
   if (result_cell_slabs.empty() && result_tiles.empty()) {
     zero_out_buffer_sizes();
@@ -719,6 +739,7 @@ Status Reader::copy_attribute_values(
     std::vector<ResultCellSlab>& result_cell_slabs,
     Subarray& subarray) {
   auto timer_se = stats_->start_timer("copy_attr_values");
+  set_progress_phase(QueryPhase::COPY_RESULTS);
 
   if (result_cell_slabs.empty() && result_tiles.empty()) {
     zero_out_buffer_sizes();
@@ -903,18 +924,25 @@ Status Reader::copy_partitioned_fixed_cells(
     if ((cs.tile_ == nullptr || cs.tile_->tile_tuple(*name) == nullptr) &&
         !split_buffer_for_zipped_coords) {  // Empty range or attributed added
                                             // in schema evolution
+      // Write the fill value once, then double the filled range, so that
+      // long runs of empty cells take a few large copies
       auto bytes_to_copy = cs_length * cell_size;
-      auto fill_num = bytes_to_copy / fill_value_size;
-      for (uint64_t j = 0; j < fill_num; ++j) {
+      auto fill_size = bytes_to_copy / fill_value_size * fill_value_size;
+      if (fill_size > 0) {
         std::memcpy(buffer + offset, fill_value.data(), fill_value_size);
+        uint64_t filled = fill_value_size;
+        while (filled < fill_size) {
+          auto n = std::min(filled, fill_size - filled);
+          std::memcpy(buffer + offset + filled, buffer + offset, n);
+          filled += n;
+        }
         if (nullable) {
           std::memset(
               buffer_validity +
                   (offset / cell_size * constants::cell_validity_size),
               fill_value_validity,
-              constants::cell_validity_size);
+              fill_size / cell_size * constants::cell_validity_size);
         }
-        offset += fill_value_size;
       }
     } else {  // Non-empty range
       if (stride == UINT64_MAX) {
@@ -1214,9 +1242,14 @@ Status Reader::copy_partitioned_var_cells(
       tile_cell_num = tile->cell_num();
     }
 
-    // Copy each cell in the range
+    // The values of a contiguous run of cells of a tile are contiguous in
+    // the var tile and in the destination, so they are copied at once after
+    // the offsets
     uint64_t dest_vec_idx = 0;
     stride = (stride == UINT64_MAX) ? 1 : stride;
+    const bool copy_run = stride == 1 && tile_var != nullptr;
+
+    // Copy each cell in the range
     for (auto cell_idx = cs.start_; dest_vec_idx < cs_length;
          cell_idx += stride, dest_vec_idx++) {
       auto offset_offsets = (*offset_offsets_per_cs)[arr_offset + dest_vec_idx];
@@ -1240,7 +1273,7 @@ Status Reader::copy_partitioned_var_cells(
               validity_dest,
               fill_value_validity,
               constants::cell_validity_size);
-      } else {
+      } else if (!copy_run) {
         const uint64_t cell_var_size =
             (cell_idx != tile_cell_num - 1) ?
                 tile_offsets[cell_idx + 1] - tile_offsets[cell_idx] :
@@ -1256,6 +1289,26 @@ Status Reader::copy_partitioned_var_cells(
       }
     }
 
+    if (copy_run && cs_length > 0) {
+      const uint64_t last = cs.start_ + cs_length - 1;
+      const uint64_t var_begin = tile_offsets[cs.start_] - tile_offsets[0];
+      const uint64_t var_end = (last != tile_cell_num - 1) ?
+                                   tile_offsets[last + 1] - tile_offsets[0] :
+                                   tile_var->size();
+      RETURN_NOT_OK(tile_var->read(
+          buffer_var + (*var_offsets_per_cs)[arr_offset],
+          var_begin,
+          var_end - var_begin));
+      if (nullable) {
+        auto validity_offset =
+            (*offset_offsets_per_cs)[arr_offset] / offset_size;
+        RETURN_NOT_OK(tile_validity->read(
+            buffer_validity + validity_offset,
+            cs.start_,
+            cs_length * constants::cell_validity_size));
+      }
+    }
+
     arr_offset += cs_length;
   }
 
@@ -1436,9 +1489,22 @@ Status Reader::compute_result_cell_slabs_row_col(
   // or in `result_space_tiles` (dense).
   auto rcs_it = ReadCellSlabIter<T>(
       &subarray, &result_space_tiles, &result_coords, *result_coords_pos);
+  const auto stride = array_schema_->domain()->stride<T>(subarray.layout());
   for (rcs_it.begin(); !rcs_it.end(); ++rcs_it) {
-    // Add result cell slab
+    // Add result cell slab, extending the previous one instead if the cells
+    // follow it in the same tile (or are both empty), so that they are
+    // copied at once
     auto result_cell_slab = rcs_it.result_cell_slab();
+    if (!result_cell_slabs.empty() &&
+        result_cell_slabs.back().tile_ == result_cell_slab.tile_ &&
+        (result_cell_slab.tile_ == nullptr ||
+         result_cell_slabs.back().start_ +
+                 result_cell_slabs.back().length_ *
+                     (stride == UINT64_MAX ? 1 : stride) ==
+             result_cell_slab.start_)) {
+      result_cell_slabs.back().length_ += result_cell_slab.length_;
+      continue;
+    }
     result_cell_slabs.push_back(result_cell_slab);
     // Add result tile
     if (result_cell_slab.tile_ != nullptr) {
@@ -1494,6 +1560,7 @@ Status Reader::compute_result_coords(
     std::vector<ResultTile>& result_tiles,
     std::vector<ResultCoords>& result_coords) {
   auto timer_se = stats_->start_timer("compute_result_coords");
+  set_progress_phase(QueryPhase::PROCESS_TILES);
 
   // Get overlapping tile indexes
   typedef std::pair<unsigned, uint64_t> FragTileTuple;
@@ -1726,33 +1793,23 @@ Status Reader::init_read_state() {
                            "support global order"));
 
   // Get config
-  bool found = false;
-  uint64_t memory_budget = 0;
-  RETURN_NOT_OK(
-      config_.get<uint64_t>("sm.memory_budget", &memory_budget, &found));
-  assert(found);
-  uint64_t memory_budget_var = 0;
-  RETURN_NOT_OK(config_.get<uint64_t>(
-      "sm.memory_budget_var", &memory_budget_var, &found));
-  assert(found);
-  offsets_format_mode_ = config_.get("sm.var_offsets.mode", &found);
-  assert(found);
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  uint64_t memory_budget = config->memory_budget;
+  uint64_t memory_budget_var = config->memory_budget_var;
+  offsets_format_mode_ = config->var_offsets_mode;
   if (offsets_format_mode_ != "bytes" && offsets_format_mode_ != "elements") {
     return logger_->status(
         Status_ReaderError("Cannot initialize reader; Unsupported offsets "
                            "format in configuration"));
   }
-  RETURN_NOT_OK(config_.get<bool>(
-      "sm.var_offsets.extra_element", &offsets_extra_element_, &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<uint32_t>(
-      "sm.var_offsets.bitsize", &offsets_bitsize_, &found));
+  offsets_extra_element_ = config->var_offsets_extra_element;
+  offsets_bitsize_ = config->var_offsets_bitsize;
   if (offsets_bitsize_ != 32 && offsets_bitsize_ != 64) {
     return logger_->status(
         Status_ReaderError("Cannot initialize reader; Unsupported offsets "
                            "bitsize in configuration"));
   }
-  assert(found);
 
   // Consider the validity memory budget to be identical to `sm.memory_budget`
   // because the validity vector is currently a bytemap. When converted to a
@@ -1822,7 +1879,7 @@ Status Reader::sort_result_coords(
     parallel_sort(
         storage_manager_->compute_tp(), iter_begin, iter_end, ColCmp(domain));
   } else if (layout == Layout::GLOBAL_ORDER) {
-    if (array_schema_->cell_order() == Layout::HILBERT) {
+    if (layout_is_curve(array_schema_->cell_order())) {
       std::vector<std::pair<uint64_t, uint64_t>> hilbert_values(coords_num);
       RETURN_NOT_OK(calculate_hilbert_values(iter_begin, &hilbert_values));
       parallel_sort(
@@ -1832,11 +1889,11 @@ Status Reader::sort_result_coords(
           HilbertCmp(domain, iter_begin));
       RETURN_NOT_OK(reorganize_result_coords(iter_begin, &hilbert_values));
     } else {
-      parallel_sort(
-          storage_manager_->compute_tp(),
-          iter_begin,
-          iter_end,
-          GlobalCmp(domain));
+      with_global_cmp<TypedGlobalCmp>(
+          domain, nullptr, GlobalCmp(domain), [&](const auto& cmp) {
+            parallel_sort(
+                storage_manager_->compute_tp(), iter_begin, iter_end, cmp);
+          });
     }
   } else {
     assert(false);
@@ -1966,23 +2023,25 @@ Status Reader::calculate_hilbert_values(
     std::vector<std::pair<uint64_t, uint64_t>>* hilbert_values) const {
   auto timer_se = stats_->start_timer("calculate_hilbert_values");
   auto dim_num = array_schema_->dim_num();
-  Hilbert h(dim_num);
-  auto bits = h.bits();
-  auto max_bucket_val = ((uint64_t)1 << bits) - 1;
+  SpaceFillingCurve curve(array_schema_->cell_order(), dim_num);
   auto coords_num = (uint64_t)hilbert_values->size();
 
-  // Calculate Hilbert values in parallel
-  auto status = parallel_for(
-      storage_manager_->compute_tp(), 0, coords_num, [&](uint64_t c) {
-        std::vector<uint64_t> coords(dim_num);
-        for (uint32_t d = 0; d < dim_num; ++d) {
-          auto dim = array_schema_->dimension(d);
-          coords[d] = hilbert_order::map_to_uint64(
-              *dim, *(iter_begin + c), d, bits, max_bucket_val);
-        }
-        (*hilbert_values)[c] =
-            std::pair<uint64_t, uint64_t>(h.coords_to_hilbert(&coords[0]), c);
-        return Status::Ok();
+  // Calculate Hilbert values in parallel, in batches of cells
+  auto status = hilbert_order::parallel_calculate_values(
+      storage_manager_->compute_tp(),
+      curve,
+      dim_num,
+      coords_num,
+      [&](uint32_t d, uint64_t c, int bits, uint64_t max_bucket_val) {
+        return hilbert_order::map_to_uint64(
+            *array_schema_->dimension(d),
+            *(iter_begin + c),
+            d,
+            bits,
+            max_bucket_val);
+      },
+      [&](uint64_t c, uint64_t value) {
+        (*hilbert_values)[c] = std::pair<uint64_t, uint64_t>(value, c);
       });
 
   RETURN_NOT_OK_ELSE(status, logger_->status(status));
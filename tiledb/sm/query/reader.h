@@ -116,6 +116,12 @@ class Reader : public ReaderBase, public IQueryStrategy {
   /** Resets the reader object. */
   void reset();
 
+  /** Prepares the reader to run again over a new subarray. */
+  Status rebind();
+
+  /** Sets the progress to update as the query is processed. */
+  void set_progress(QueryProgress* progress);
+
   /**
    * Computes the result cell slabs for the input subarray, given the
    * input result coordinates (retrieved from the sparse fragments).
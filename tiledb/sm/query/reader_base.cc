@@ -32,22 +32,48 @@
 
 #include "tiledb/sm/query/reader_base.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/scoped_executor.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/cache/inflight_tile_reads.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/strategy_base.h"
 #include "tiledb/sm/subarray/cell_slab_iter.h"
 #include "tiledb/sm/subarray/subarray.h"
 
+#include <atomic>
+#include <mutex>
+#include <numeric>
+
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Returns the bucket `floor(coord / width)` of a coordinate. */
+template <class T>
+int64_t coord_bucket(const T coord, const uint64_t width) {
+  if constexpr (std::is_signed<T>::value) {
+    const int64_t c = static_cast<int64_t>(coord);
+    if (c < 0)
+      return -static_cast<int64_t>(static_cast<uint64_t>(-(c + 1)) / width) -
+             1;
+    return static_cast<int64_t>(static_cast<uint64_t>(c) / width);
+  } else {
+    return static_cast<int64_t>(static_cast<uint64_t>(coord) / width);
+  }
+}
+
+}  // namespace
+
 /* ****************************** */
 /*          CONSTRUCTORS          */
 /* ****************************** */
@@ -71,7 +97,14 @@ ReaderBase::ReaderBase(
           buffers,
           subarray,
           layout)
-    , condition_(condition) {
+    , condition_(condition)
+    , aggregates_(nullptr)
+    , group_by_dim_idx_(0)
+    , group_by_width_(0)
+    , aggregate_groups_(nullptr)
+    , sample_fraction_(1.0)
+    , sample_seed_(0)
+    , top_k_(nullptr) {
   if (array != nullptr)
     fragment_metadata_ = array->fragment_metadata();
 }
@@ -135,6 +168,36 @@ void ReaderBase::compute_result_space_tiles(
   }
 }
 
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void ReaderBase::set_aggregates(std::vector<QueryAggregate>* aggregates) {
+  aggregates_ = aggregates;
+}
+
+void ReaderBase::set_aggregate_groups(
+    const std::string& dim_name,
+    uint64_t bucket_width,
+    std::map<int64_t, std::vector<QueryAggregate>>* groups) {
+  group_by_dim_ = dim_name;
+  for (unsigned d = 0; d < array_schema_->dim_num(); d++) {
+    if (array_schema_->dimension(d)->name() == dim_name)
+      group_by_dim_idx_ = d;
+  }
+  group_by_width_ = bucket_width;
+  aggregate_groups_ = groups;
+}
+
+void ReaderBase::set_sample(double fraction, uint64_t seed) {
+  sample_fraction_ = fraction;
+  sample_seed_ = seed;
+}
+
+void ReaderBase::set_top_k(QueryTopK* top_k) {
+  top_k_ = top_k;
+}
+
 /* ****************************** */
 /*        PROTECTED METHODS       */
 /* ****************************** */
@@ -143,7 +206,7 @@ void ReaderBase::clear_tiles(
     const std::string& name,
     const std::vector<ResultTile*>& result_tiles) const {
   for (auto& result_tile : result_tiles)
-    result_tile->erase_tile(name);
+    result_tile->erase_tile(name, tile_buffer_pool_.get());
 }
 
 void ReaderBase::reset_buffer_sizes() {
@@ -221,6 +284,7 @@ Status ReaderBase::check_validity_buffer_sizes() const {
 Status ReaderBase::load_tile_offsets(
     Subarray& subarray, const std::vector<std::string>& names) {
   auto timer_se = stats_->start_timer("load_tile_offsets");
+  set_progress_phase(QueryPhase::LOAD_METADATA);
   const auto encryption_key = array_->encryption_key();
 
   // Fetch relevant fragments so we load tile offsets only from intersecting
@@ -229,8 +293,10 @@ Status ReaderBase::load_tile_offsets(
 
   bool all_frag = !subarray.is_set();
 
+  // Loading the metadata is bound by the reads of the fragment files, so
+  // it runs on the io thread pool instead of blocking compute workers.
   const auto status = parallel_for(
-      storage_manager_->compute_tp(),
+      storage_manager_->io_tp(),
       0,
       all_frag ? fragment_metadata_.size() : relevant_fragments->size(),
       [&](const uint64_t i) {
@@ -273,6 +339,7 @@ Status ReaderBase::load_tile_offsets(
 Status ReaderBase::load_tile_var_sizes(
     Subarray& subarray, const std::vector<std::string>& names) {
   auto timer_se = stats_->start_timer("load_tile_var_sizes");
+  set_progress_phase(QueryPhase::LOAD_METADATA);
   const auto encryption_key = array_->encryption_key();
 
   // Fetch relevant fragments so we load tile var sizes only from intersecting
@@ -282,7 +349,7 @@ Status ReaderBase::load_tile_var_sizes(
   bool all_frag = !subarray.is_set();
 
   const auto status = parallel_for(
-      storage_manager_->compute_tp(),
+      storage_manager_->io_tp(),
       0,
       all_frag ? fragment_metadata_.size() : relevant_fragments->size(),
       [&](const uint64_t i) {
@@ -311,6 +378,350 @@ Status ReaderBase::load_tile_var_sizes(
   return Status::Ok();
 }
 
+Status ReaderBase::load_tile_condition_metadata(Subarray& subarray) {
+  auto timer_se = stats_->start_timer("load_tile_condition_metadata");
+  set_progress_phase(QueryPhase::LOAD_METADATA);
+  const auto encryption_key = array_->encryption_key();
+
+  // Fetch relevant fragments so we load tile metadata only from intersecting
+  // fragments
+  const auto relevant_fragments = subarray.relevant_fragments();
+
+  bool all_frag = !subarray.is_set();
+
+  const auto status = parallel_for(
+      storage_manager_->io_tp(),
+      0,
+      all_frag ? fragment_metadata_.size() : relevant_fragments->size(),
+      [&](const uint64_t i) {
+        auto frag_idx = all_frag ? i : relevant_fragments->at(i);
+        auto& fragment = fragment_metadata_[frag_idx];
+
+        std::vector<std::string> min_names;
+        std::vector<std::string> null_count_names;
+        condition_.tile_metadata_names(
+            fragment.get(), &min_names, &null_count_names);
+
+        auto max_names = min_names;
+        RETURN_NOT_OK(fragment->load_tile_min_values(
+            *encryption_key, std::move(min_names)));
+        RETURN_NOT_OK(fragment->load_tile_max_values(
+            *encryption_key, std::move(max_names)));
+        RETURN_NOT_OK(fragment->load_tile_null_count_values(
+            *encryption_key, std::move(null_count_names)));
+
+        // Only sparse writes index attribute values
+        if (!fragment->dense())
+          RETURN_NOT_OK(fragment->load_attribute_index(*encryption_key));
+        return Status::Ok();
+      });
+
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
+std::tuple<Status, std::optional<std::vector<uint8_t>>>
+ReaderBase::compute_qc_skipped_tiles(
+    const std::vector<ResultTile*>& result_tiles) {
+  auto timer_se = stats_->start_timer("compute_qc_skipped_tiles");
+
+  std::vector<uint8_t> skipped(result_tiles.size(), 0);
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
+        auto rt = result_tiles[t];
+        auto&& [st, skip] = condition_.can_skip_tile(
+            fragment_metadata_[rt->frag_idx()].get(), rt->tile_idx());
+        RETURN_NOT_OK(st);
+        skipped[t] = *skip;
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
+
+  stats_->add_counter(
+      "qc_skipped_tile_num",
+      std::accumulate(skipped.begin(), skipped.end(), (uint64_t)0));
+  return {Status::Ok(), std::move(skipped)};
+}
+
+bool ReaderBase::has_aggregates() const {
+  return aggregates_ != nullptr && !aggregates_->empty();
+}
+
+std::vector<std::string> ReaderBase::aggregate_field_names() const {
+  std::vector<std::string> names;
+  if (!has_aggregates())
+    return names;
+
+  for (const auto& aggregate : *aggregates_) {
+    if (!aggregate.needs_data())
+      continue;
+
+    if (std::find(names.begin(), names.end(), aggregate.field_name()) ==
+        names.end())
+      names.emplace_back(aggregate.field_name());
+  }
+
+  return names;
+}
+
+Status ReaderBase::load_tile_aggregate_metadata(Subarray& subarray) {
+  auto timer_se = stats_->start_timer("load_tile_aggregate_metadata");
+  const auto encryption_key = array_->encryption_key();
+
+  // Fetch relevant fragments so we load tile metadata only from intersecting
+  // fragments
+  const auto relevant_fragments = subarray.relevant_fragments();
+
+  bool all_frag = !subarray.is_set();
+
+  const auto status = parallel_for(
+      storage_manager_->io_tp(),
+      0,
+      all_frag ? fragment_metadata_.size() : relevant_fragments->size(),
+      [&](const uint64_t i) {
+        auto frag_idx = all_frag ? i : relevant_fragments->at(i);
+        auto& fragment = fragment_metadata_[frag_idx];
+
+        // Compute the metadata to load for this fragment.
+        std::vector<std::string> min_max_names;
+        std::vector<std::string> sum_names;
+        std::vector<std::string> null_count_names;
+        for (const auto& aggregate : *aggregates_) {
+          if (!aggregate.has_tile_metadata(fragment.get()))
+            continue;
+
+          const auto& name = aggregate.field_name();
+          if (aggregate.needs_tile_min_max())
+            min_max_names.emplace_back(name);
+          if (aggregate.needs_tile_sum())
+            sum_names.emplace_back(name);
+          if (aggregate.needs_tile_null_count())
+            null_count_names.emplace_back(name);
+        }
+
+        auto max_names = min_max_names;
+        RETURN_NOT_OK(fragment->load_tile_min_values(
+            *encryption_key, std::move(min_max_names)));
+        RETURN_NOT_OK(fragment->load_tile_max_values(
+            *encryption_key, std::move(max_names)));
+        RETURN_NOT_OK(fragment->load_tile_sum_values(
+            *encryption_key, std::move(sum_names)));
+        RETURN_NOT_OK(fragment->load_tile_null_count_values(
+            *encryption_key, std::move(null_count_names)));
+        return Status::Ok();
+      });
+
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
+bool ReaderBase::has_top_k() const {
+  return top_k_ != nullptr;
+}
+
+Status ReaderBase::load_tile_top_k_metadata(Subarray& subarray) {
+  auto timer_se = stats_->start_timer("load_tile_top_k_metadata");
+  const auto encryption_key = array_->encryption_key();
+
+  // Fetch relevant fragments so we load tile metadata only from intersecting
+  // fragments
+  const auto relevant_fragments = subarray.relevant_fragments();
+
+  bool all_frag = !subarray.is_set();
+
+  const auto status = parallel_for(
+      storage_manager_->io_tp(),
+      0,
+      all_frag ? fragment_metadata_.size() : relevant_fragments->size(),
+      [&](const uint64_t i) {
+        auto frag_idx = all_frag ? i : relevant_fragments->at(i);
+        auto& fragment = fragment_metadata_[frag_idx];
+        if (!top_k_->has_tile_metadata(fragment.get()))
+          return Status::Ok();
+
+        std::vector<std::string> names = {top_k_->field_name()};
+        if (top_k_->largest()) {
+          RETURN_NOT_OK(fragment->load_tile_max_values(
+              *encryption_key, std::move(names)));
+        } else {
+          RETURN_NOT_OK(fragment->load_tile_min_values(
+              *encryption_key, std::move(names)));
+        }
+        return Status::Ok();
+      });
+
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
+bool ReaderBase::aggregates_have_tile_metadata(unsigned frag_idx) const {
+  for (const auto& aggregate : *aggregates_) {
+    if (!aggregate.has_tile_metadata(fragment_metadata_[frag_idx].get()))
+      return false;
+  }
+
+  return true;
+}
+
+bool ReaderBase::has_aggregate_groups() const {
+  return aggregate_groups_ != nullptr;
+}
+
+std::optional<int64_t> ReaderBase::tile_bucket(
+    unsigned frag_idx, uint64_t tile_idx) const {
+  const auto& mbr = fragment_metadata_[frag_idx]->mbr(tile_idx);
+  const auto& range = mbr[group_by_dim_idx_];
+  return apply_with_type(
+      array_schema_->dimension(group_by_dim_idx_)->type(),
+      [&](auto t) -> std::optional<int64_t> {
+        using T = decltype(t);
+        const auto start =
+            coord_bucket(*(const T*)range.start(), group_by_width_);
+        const auto end = coord_bucket(*(const T*)range.end(), group_by_width_);
+        if (start != end)
+          return std::nullopt;
+        return start;
+      },
+      []() -> std::optional<int64_t> { return std::nullopt; });
+}
+
+std::vector<QueryAggregate>& ReaderBase::aggregate_group(int64_t bucket) {
+  auto it = aggregate_groups_->find(bucket);
+  if (it == aggregate_groups_->end())
+    it = aggregate_groups_->emplace(bucket, *aggregates_).first;
+  return it->second;
+}
+
+template <class BitmapType>
+void ReaderBase::compute_bucket_bitmaps(
+    ResultTile* result_tile,
+    uint64_t cell_num,
+    const std::vector<BitmapType>& bitmap,
+    std::map<int64_t, std::vector<BitmapType>>& bucket_bitmaps) const {
+  apply_with_type(
+      array_schema_->dimension(group_by_dim_idx_)->type(),
+      [&](auto t) {
+        using T = decltype(t);
+
+        // Consecutive cells mostly fall in the same bucket, so the bitmap
+        // of the last bucket is kept at hand.
+        std::vector<BitmapType>* current = nullptr;
+        int64_t current_bucket = 0;
+        for (uint64_t c = 0; c < cell_num; c++) {
+          const BitmapType count = bitmap.empty() ? 1 : bitmap[c];
+          if (count == 0)
+            continue;
+
+          const auto bucket = coord_bucket(
+              *(const T*)result_tile->coord(c, group_by_dim_idx_),
+              group_by_width_);
+          if (current == nullptr || bucket != current_bucket) {
+            current = &bucket_bitmaps[bucket];
+            current_bucket = bucket;
+            if (current->empty())
+              current->resize(cell_num, 0);
+          }
+
+          (*current)[c] = count;
+        }
+      },
+      []() {});
+}
+
+Status ReaderBase::aggregate_tiles_metadata(
+    const std::vector<std::pair<unsigned, uint64_t>>& tiles) {
+  auto timer_se = stats_->start_timer("aggregate_tiles_metadata");
+
+  for (const auto& tile : tiles) {
+    // Grouped tiles lie within a single bucket.
+    auto aggregates = aggregates_;
+    if (has_aggregate_groups()) {
+      auto bucket = tile_bucket(tile.first, tile.second);
+      assert(bucket.has_value());
+      aggregates = &aggregate_group(*bucket);
+    }
+
+    for (auto& aggregate : *aggregates) {
+      RETURN_NOT_OK(aggregate.aggregate_tile_metadata(
+          fragment_metadata_[tile.first].get(), tile.second));
+    }
+  }
+
+  stats_->add_counter("aggregate_tiles_from_metadata", tiles.size());
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status ReaderBase::aggregate_tiles(
+    const std::vector<ResultTile*>& result_tiles,
+    const std::vector<const std::vector<BitmapType>*>& bitmaps) {
+  auto timer_se = stats_->start_timer("aggregate_tiles");
+  assert(result_tiles.size() == bitmaps.size());
+
+  // Each tile is folded into a partial result that is then merged into the
+  // aggregates.
+  std::mutex aggregates_mtx;
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
+        auto rt = result_tiles[t];
+        const auto cell_num =
+            fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+
+        // When grouping, the cells of each bucket are folded into partial
+        // results that are merged into the aggregates of the bucket.
+        if (has_aggregate_groups()) {
+          std::map<int64_t, std::vector<BitmapType>> bucket_bitmaps;
+          auto bucket = tile_bucket(rt->frag_idx(), rt->tile_idx());
+          if (!bucket.has_value())
+            compute_bucket_bitmaps(rt, cell_num, *bitmaps[t], bucket_bitmaps);
+
+          const uint64_t bucket_num =
+              bucket.has_value() ? 1 : bucket_bitmaps.size();
+          auto it = bucket_bitmaps.begin();
+          for (uint64_t b = 0; b < bucket_num; b++) {
+            const auto& bitmap = bucket.has_value() ? *bitmaps[t] : it->second;
+            std::vector<QueryAggregate> partials;
+            for (auto& aggregate : *aggregates_) {
+              QueryAggregate partial(aggregate.field_name(), aggregate.op());
+              RETURN_NOT_OK(partial.init(array_schema_));
+              RETURN_NOT_OK(partial.aggregate_tile(rt, cell_num, bitmap));
+              partials.emplace_back(std::move(partial));
+            }
+
+            std::unique_lock<std::mutex> lck(aggregates_mtx);
+            auto& group =
+                aggregate_group(bucket.has_value() ? *bucket : it->first);
+            for (uint64_t i = 0; i < partials.size(); i++)
+              RETURN_NOT_OK(group[i].merge(partials[i]));
+
+            if (!bucket.has_value())
+              ++it;
+          }
+
+          return Status::Ok();
+        }
+
+        for (auto& aggregate : *aggregates_) {
+          QueryAggregate partial(aggregate.field_name(), aggregate.op());
+          RETURN_NOT_OK(partial.init(array_schema_));
+          RETURN_NOT_OK(partial.aggregate_tile(rt, cell_num, *bitmaps[t]));
+
+          std::unique_lock<std::mutex> lck(aggregates_mtx);
+          RETURN_NOT_OK(aggregate.merge(partial));
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+  stats_->add_counter("aggregate_tiles_from_data", result_tiles.size());
+  return Status::Ok();
+}
+
 Status ReaderBase::init_tile(
     uint32_t format_version, const std::string& name, Tile* tile) const {
   // For easy reference
@@ -396,6 +807,7 @@ Status ReaderBase::read_attribute_tiles(
     const std::vector<ResultTile*>& result_tiles,
     const bool disable_cache) const {
   auto timer_se = stats_->start_timer("read_attribute_tiles");
+  stats_->add_counter("attr_tile_num", names.size() * result_tiles.size());
   return read_tiles(names, result_tiles, disable_cache);
 }
 
@@ -410,13 +822,25 @@ Status ReaderBase::read_coordinate_tiles(
 Status ReaderBase::read_tiles(
     const std::vector<std::string>& names,
     const std::vector<ResultTile*>& result_tiles,
-    const bool disable_cache) const {
+    const bool disable_cache,
+    const std::function<Status(const std::string&, ResultTile*)>&
+        on_tile_read) const {
   auto timer_se = stats_->start_timer("read_tiles");
 
   // Shortcut for empty tile vec
   if (result_tiles.empty())
     return Status::Ok();
 
+  set_progress_phase(QueryPhase::READ_TILES);
+
+  // The number of tiles of dense fragments that were not stored because
+  // they only hold fill values.
+  uint64_t fill_tile_num = 0;
+
+  // Tiles read through memory mappings need no filtered buffer allocation.
+  bool mmap = false;
+  RETURN_NOT_OK(storage_manager_->vfs()->use_mmap(array_->array_uri(), &mmap));
+
   // Populate the list of regions per file to be read.
   std::unordered_map<
       URI,
@@ -424,6 +848,39 @@ Status ReaderBase::read_tiles(
       URIHasher>
       all_regions;
 
+  // The tile tuples to hand over to `on_tile_read` or to report in the
+  // progress, the number of regions each of them waits for and the tile
+  // tuple and size of every region.
+  const bool track_regions = on_tile_read || progress_ != nullptr;
+  std::vector<std::pair<std::string, ResultTile*>> read_tile_tuples;
+  std::vector<uint64_t> region_nums;
+  std::unordered_map<const Tile*, std::pair<uint64_t, uint64_t>>
+      region_tile_tuples;
+
+  // Tiles being read by concurrent queries are copied from their reads
+  // instead of being read again, unless they are read through memory
+  // mappings. The reads this query leads are completed as they finish, and
+  // those it follows are waited for once its own reads are done.
+  InflightTileReads* const inflight_reads =
+      mmap ? nullptr : storage_manager_->inflight_tile_reads();
+  std::unordered_map<const Tile*, tdb_shared_ptr<InflightTileReads::Read>>
+      led_reads;
+  std::vector<std::tuple<
+      tdb_shared_ptr<InflightTileReads::Read>,
+      Tile*,
+      URI,
+      uint64_t,
+      uint64_t>>
+      followed_reads;
+
+  // Fails the led reads not completed yet, on errors and once the reads are
+  // done, so that their followers read the tiles themselves.
+  auto fail_led_reads = [&]() {
+    for (auto& led_read : led_reads)
+      inflight_reads->complete(led_read.second, nullptr, 0);
+  };
+  ScopedExecutor fail_led_reads_on_exit(fail_led_reads);
+
   // Run all tiles and attributes.
   for (auto name : names) {
     for (auto tile : result_tiles) {
@@ -484,44 +941,30 @@ Status ReaderBase::read_tiles(
           RETURN_NOT_OK(init_tile(format_version, name, t, t_var));
       }
 
-      // Get information about the tile in its fragment
-      auto&& [status, tile_attr_uri] = fragment->uri(name);
-      RETURN_NOT_OK(status);
-
+      // Get information about the tiles in their fragment: the file and
+      // offset of their filtered data, its size and their unfiltered size.
       auto tile_idx = tile->tile_idx();
-      uint64_t tile_attr_offset;
-      RETURN_NOT_OK(fragment->file_offset(name, tile_idx, &tile_attr_offset));
-      auto&& [st, tile_persisted_size] =
-          fragment->persisted_tile_size(name, tile_idx);
-      RETURN_NOT_OK(st);
-      uint64_t tile_size = fragment->tile_size(name, tile_idx);
-
-      // Try the cache first.
-      bool cache_hit = false;
-      if (!disable_cache) {
-        RETURN_NOT_OK(storage_manager_->read_from_cache(
+      std::vector<std::tuple<Tile*, URI, uint64_t, uint64_t, uint64_t>> parts;
+      {
+        auto&& [status, tile_attr_uri] = fragment->uri(name, tile_idx);
+        RETURN_NOT_OK(status);
+        uint64_t tile_attr_offset;
+        RETURN_NOT_OK(
+            fragment->file_offset(name, tile_idx, &tile_attr_offset));
+        auto&& [st, tile_persisted_size] =
+            fragment->persisted_tile_size(name, tile_idx);
+        RETURN_NOT_OK(st);
+        parts.emplace_back(
+            t,
             *tile_attr_uri,
             tile_attr_offset,
-            t->filtered_buffer(),
             *tile_persisted_size,
-            &cache_hit));
-      }
-
-      if (!cache_hit) {
-        // Add the region of the fragment to be read.
-        all_regions[*tile_attr_uri].emplace_back(
-            tile_attr_offset, t, *tile_persisted_size);
-
-        t->filtered_buffer().expand(*tile_persisted_size);
+            fragment->tile_size(name, tile_idx));
       }
 
-      // Pre-allocate the unfiltered buffer.
-      RETURN_NOT_OK(t->alloc_data(tile_size));
-
       if (var_size) {
-        auto&& [status, tile_attr_var_uri] = fragment->var_uri(name);
+        auto&& [status, tile_attr_var_uri] = fragment->var_uri(name, tile_idx);
         RETURN_NOT_OK(status);
-
         uint64_t tile_attr_var_offset;
         RETURN_NOT_OK(
             fragment->file_var_offset(name, tile_idx, &tile_attr_var_offset));
@@ -530,66 +973,192 @@ Status ReaderBase::read_tiles(
         RETURN_NOT_OK(st);
         auto&& [st_2, tile_var_size] = fragment->tile_var_size(name, tile_idx);
         RETURN_NOT_OK(st_2);
-
-        if (!disable_cache) {
-          RETURN_NOT_OK(storage_manager_->read_from_cache(
-              *tile_attr_var_uri,
-              tile_attr_var_offset,
-              t_var->filtered_buffer(),
-              *tile_var_persisted_size,
-              &cache_hit));
-        }
-
-        if (!cache_hit) {
-          // Add the region of the fragment to be read.
-          all_regions[*tile_attr_var_uri].emplace_back(
-              tile_attr_var_offset, t_var, *tile_var_persisted_size);
-
-          t_var->filtered_buffer().expand(*tile_var_persisted_size);
-        }
-
-        // Pre-allocate the unfiltered buffer.
-        RETURN_NOT_OK(t_var->alloc_data(*tile_var_size));
+        parts.emplace_back(
+            t_var,
+            *tile_attr_var_uri,
+            tile_attr_var_offset,
+            *tile_var_persisted_size,
+            *tile_var_size);
       }
 
       if (nullable) {
-        auto&& [status, tile_validity_attr_uri] = fragment->validity_uri(name);
+        auto&& [status, tile_validity_attr_uri] =
+            fragment->validity_uri(name, tile_idx);
         RETURN_NOT_OK(status);
-
         uint64_t tile_attr_validity_offset;
         RETURN_NOT_OK(fragment->file_validity_offset(
             name, tile_idx, &tile_attr_validity_offset));
         auto&& [st, tile_validity_persisted_size] =
             fragment->persisted_tile_validity_size(name, tile_idx);
         RETURN_NOT_OK(st);
-        uint64_t tile_validity_size =
-            fragment->cell_num(tile_idx) * constants::cell_validity_size;
+        parts.emplace_back(
+            t_validity,
+            *tile_validity_attr_uri,
+            tile_attr_validity_offset,
+            *tile_validity_persisted_size,
+            fragment->cell_num(tile_idx) * constants::cell_validity_size);
+      }
+
+      // Pre-allocate the unfiltered buffers, unless the tiles are unfiltered
+      // directly into user buffers.
+      auto unfilter_dest = unfilter_dests_.find({tile, name});
+      for (auto& [part_tile, uri, offset, persisted_size, size] : parts) {
+        void* dest = nullptr;
+        if (unfilter_dest != unfilter_dests_.end()) {
+          if (part_tile == t)
+            dest = unfilter_dest->second.first;
+          else if (part_tile == t_validity)
+            dest = unfilter_dest->second.second;
+        }
 
+        if (dest != nullptr)
+          part_tile->set_data_view(dest, size);
+        else
+          RETURN_NOT_OK(part_tile->alloc_data(
+              size,
+              tile_buffer_pool_ != nullptr ?
+                  tile_buffer_pool_.get() :
+                  storage_manager_->tile_buffer_pool(),
+              storage_manager_->large_buffer_allocator()));
+      }
+
+      // Tiles of fixed-sized attributes stored with no data only hold fill
+      // values, which are set here. Like the tiles found in the unfiltered
+      // tile cache below, they need neither a read nor an unfilter, which
+      // is signaled by an empty filtered buffer.
+      const bool fill_tile = format_version >= 14 && !is_dim && !var_size &&
+                             std::get<3>(parts[0]) == 0 &&
+                             std::get<4>(parts[0]) > 0;
+      if (fill_tile) {
+        const auto attr = fragment->array_schema()->attribute(name);
+        fill_tile_values(attr->fill_value(), t);
+        if (nullable)
+          std::memset(
+              t_validity->data(),
+              attr->fill_value_validity(),
+              t_validity->size());
+        ++fill_tile_num;
+      }
+
+      // Tiles found in the unfiltered tile cache need neither a read nor an
+      // unfilter. All the tiles of the tuple must be found for it to be used.
+      bool unfiltered_hit = fill_tile ||
+                            (!disable_cache && name != constants::coords &&
+                             storage_manager_->unfiltered_tile_cache_enabled());
+      for (auto& [part_tile, uri, offset, persisted_size, size] : parts) {
+        if (fill_tile)
+          break;
+        if (!unfiltered_hit)
+          break;
+        RETURN_NOT_OK(storage_manager_->read_unfiltered_from_cache(
+            uri, offset, part_tile->data(), size, &unfiltered_hit));
+      }
+
+      // Track the regions of the tile tuple and their sizes.
+      std::vector<std::pair<const Tile*, uint64_t>> region_tiles;
+
+      for (auto& [part_tile, uri, offset, persisted_size, size] : parts) {
+        if (unfiltered_hit)
+          break;
+
+        // Try the cache first.
+        bool cache_hit = false;
         if (!disable_cache) {
           RETURN_NOT_OK(storage_manager_->read_from_cache(
-              *tile_validity_attr_uri,
-              tile_attr_validity_offset,
-              t_validity->filtered_buffer(),
-              *tile_validity_persisted_size,
+              uri,
+              offset,
+              part_tile->filtered_buffer(),
+              persisted_size,
               &cache_hit));
         }
 
         if (!cache_hit) {
-          // Add the region of the fragment to be read.
-          all_regions[*tile_validity_attr_uri].emplace_back(
-              tile_attr_validity_offset,
-              t_validity,
-              *tile_validity_persisted_size);
+          region_tiles.emplace_back(part_tile, persisted_size);
+          if (!mmap)
+            part_tile->filtered_buffer().expand(persisted_size);
+
+          // Follow the read of the tile by a concurrent query, if any, or
+          // lead it for the concurrent queries needing the tile next.
+          if (inflight_reads != nullptr) {
+            auto&& [read, leader] = inflight_reads->join(uri, offset);
+            if (!leader) {
+              followed_reads.emplace_back(
+                  read, part_tile, uri, offset, persisted_size);
+              continue;
+            }
+            led_reads.emplace(part_tile, read);
+          }
 
-          t_validity->filtered_buffer().expand(*tile_validity_persisted_size);
+          // Add the region of the fragment to be read. The attributes of a
+          // group share a file and their tiles of the same cells are
+          // adjacent, so the batched read fetches them in one request.
+          all_regions[uri].emplace_back(offset, part_tile, persisted_size);
         }
+      }
 
-        // Pre-allocate the unfiltered buffer.
-        RETURN_NOT_OK(t_validity->alloc_data(tile_validity_size));
+      if (track_regions) {
+        uint64_t tile_tuple_bytes = 0;
+        for (auto& [region_tile, region_size] : region_tiles) {
+          region_tile_tuples[region_tile] = {read_tile_tuples.size(),
+                                             region_size};
+          tile_tuple_bytes += region_size;
+        }
+        region_nums.push_back(region_tiles.size());
+        read_tile_tuples.emplace_back(name, tile);
+        if (progress_ != nullptr)
+          progress_->add_tile_to_read(
+              fragment->fragment_uri().to_string(), name, tile_tuple_bytes);
       }
     }
   }
 
+  stats_->add_counter("read_fill_tile_num", fill_tile_num);
+
+  // Reports a tile tuple read in the progress and hands it over to
+  // `on_tile_read` on the compute thread pool. This is called from the IO
+  // threads as reads complete.
+  std::mutex on_tile_read_mtx;
+  std::vector<ThreadPool::Task> on_tile_read_tasks;
+  auto tile_tuple_read = [&](uint64_t i) {
+    if (progress_ != nullptr)
+      progress_->add_tile_read();
+    if (!on_tile_read)
+      return;
+
+    auto task = storage_manager_->compute_tp()->execute([&, i]() {
+      return on_tile_read(
+          read_tile_tuples[i].first, read_tile_tuples[i].second);
+    });
+    std::lock_guard<std::mutex> lock(on_tile_read_mtx);
+    on_tile_read_tasks.push_back(std::move(task));
+  };
+
+  // Completes the led reads and counts down the regions of the tile tuples
+  // as they are read.
+  std::vector<std::atomic<uint64_t>> pending_region_nums(region_nums.size());
+  std::function<Status(Tile*)> on_region_read = nullptr;
+  if (track_regions || !led_reads.empty()) {
+    for (uint64_t i = 0; i < region_nums.size(); i++)
+      pending_region_nums[i] = region_nums[i];
+    on_region_read = [&](Tile* const t) {
+      auto led_read = led_reads.find(t);
+      if (led_read != led_reads.end())
+        inflight_reads->complete(
+            led_read->second,
+            t->filtered_buffer().data(),
+            t->filtered_buffer().size());
+      if (!track_regions)
+        return Status::Ok();
+
+      const auto& [i, region_size] = region_tile_tuples.at(t);
+      if (progress_ != nullptr)
+        progress_->add_bytes_read(region_size);
+      if (--pending_region_nums[i] == 0)
+        tile_tuple_read(i);
+      return Status::Ok();
+    };
+  }
+
   // Do not use the read-ahead cache because tiles will be
   // cached in the tile cache.
   const bool use_read_ahead = false;
@@ -598,23 +1167,80 @@ Status ReaderBase::read_tiles(
   std::vector<ThreadPool::Task> tasks;
 
   // Enqueue all regions to be read.
+  Status read_st = Status::Ok();
   for (const auto& item : all_regions) {
-    RETURN_NOT_OK(storage_manager_->vfs()->read_all(
+    read_st = storage_manager_->vfs()->read_all(
         item.first,
         item.second,
         storage_manager_->io_tp(),
         &tasks,
-        use_read_ahead));
+        use_read_ahead,
+        on_region_read);
+    if (!read_st.ok())
+      break;
   }
 
-  // Wait for the reads to finish and check statuses.
+  // Tile tuples served from the tile cache are ready right away.
+  for (uint64_t i = 0; read_st.ok() && i < region_nums.size(); i++) {
+    if (region_nums[i] == 0)
+      tile_tuple_read(i);
+  }
+
+  // Wait for the reads to finish, then for the followed reads, then for the
+  // tile tuples they handed over, even on error as all use the state above.
+  // Then check statuses.
   auto statuses = storage_manager_->io_tp()->wait_all_status(tasks);
+  fail_led_reads();
+  uint64_t shared_tile_num = 0;
+  Status follow_st = Status::Ok();
+  for (auto& [read, part_tile, uri, offset, persisted_size] : followed_reads) {
+    if (!read_st.ok())
+      break;
+    auto buffer = part_tile->filtered_buffer().data();
+    if (InflightTileReads::wait(read, buffer, persisted_size)) {
+      ++shared_tile_num;
+    } else {
+      follow_st = storage_manager_->vfs()->read(
+          uri, offset, buffer, persisted_size, use_read_ahead);
+      if (!follow_st.ok())
+        break;
+    }
+    if (on_region_read) {
+      follow_st = on_region_read(part_tile);
+      if (!follow_st.ok())
+        break;
+    }
+  }
+  stats_->add_counter("read_shared_tile_num", shared_tile_num);
+  auto on_tile_read_statuses =
+      storage_manager_->compute_tp()->wait_all_status(on_tile_read_tasks);
+  RETURN_NOT_OK(read_st);
   for (const auto& st : statuses)
     RETURN_CANCEL_OR_ERROR(st);
+  RETURN_NOT_OK(follow_st);
+  for (const auto& st : on_tile_read_statuses)
+    RETURN_CANCEL_OR_ERROR(st);
 
   return Status::Ok();
 }
 
+void ReaderBase::fill_tile_values(const ByteVecValue& fill_value, Tile* tile) {
+  const uint64_t cell_size = fill_value.size();
+  const uint64_t size = tile->size();
+  auto data = static_cast<char*>(tile->data());
+  if (cell_size == 0 || size < cell_size)
+    return;
+
+  // Copy the fill value once, then double the filled range at each copy.
+  std::memcpy(data, fill_value.data(), cell_size);
+  uint64_t filled = cell_size;
+  while (filled < size) {
+    const uint64_t n = std::min(filled, size - filled);
+    std::memcpy(data + filled, data, n);
+    filled += n;
+  }
+}
+
 std::tuple<Status, std::optional<uint64_t>> ReaderBase::load_chunk_data(
     Tile* const tile, ChunkData* unfiltered_tile) const {
   assert(tile);
@@ -1179,6 +1805,8 @@ Status ReaderBase::unfilter_tiles(
                              "unfilter_attr_tiles" :
                              "unfilter_coord_tiles";
   const auto timer_se = stats_->start_timer(stat_type);
+  set_progress_phase(QueryPhase::UNFILTER_TILES);
+
   // The per tile cache is only used in readers where unfiltering
   // was done in parallel on tiles. The new readers parallelize both on
   // tiles and chunk ranges and don't benefit from using a tile cache.
@@ -1186,108 +1814,163 @@ Status ReaderBase::unfilter_tiles(
     return unfilter_tiles_chunk_range(name, result_tiles);
   }
 
-  auto var_size = array_schema_->var_size(name);
-  auto nullable = array_schema_->is_nullable(name);
   auto num_tiles = static_cast<uint64_t>(result_tiles.size());
-
   auto status = parallel_for(
       storage_manager_->compute_tp(), 0, num_tiles, [&, this](uint64_t i) {
-        ResultTile* const tile = result_tiles[i];
-
-        auto& fragment = fragment_metadata_[tile->frag_idx()];
-        auto format_version = fragment->format_version();
-
-        // Applicable for zipped coordinates only to versions < 5
-        // Applicable for separate coordinates only to version >= 5
-        if (name != constants::coords ||
-            (name == constants::coords && format_version < 5) ||
-            (array_schema_->is_dim(name) && format_version >= 5)) {
-          auto tile_tuple = tile->tile_tuple(name);
-
-          // Skip non-existent attributes/dimensions (e.g. coords in the
-          // dense case).
-          if (tile_tuple == nullptr ||
-              std::get<0>(*tile_tuple).filtered_buffer().size() == 0)
-            return Status::Ok();
-
-          auto& t = std::get<0>(*tile_tuple);
-          auto& t_var = std::get<1>(*tile_tuple);
-          auto& t_validity = std::get<2>(*tile_tuple);
-
-          logger_->info("using cache");
-          // Get information about the tile in its fragment.
-          auto&& [status, tile_attr_uri] = fragment->uri(name);
-          RETURN_NOT_OK(status);
-
-          auto tile_idx = tile->tile_idx();
-          uint64_t tile_attr_offset;
-          RETURN_NOT_OK(
-              fragment->file_offset(name, tile_idx, &tile_attr_offset));
+        return unfilter_result_tile(name, result_tiles[i]);
+      });
 
-          // Cache 't'.
-          if (t.filtered()) {
-            // Store the filtered buffer in the tile cache.
-            RETURN_NOT_OK(storage_manager_->write_to_cache(
-                *tile_attr_uri, tile_attr_offset, t.filtered_buffer()));
-          }
+  RETURN_CANCEL_OR_ERROR(status);
 
-          // Cache 't_var'.
-          if (var_size && t_var.filtered()) {
-            auto&& [status, tile_attr_var_uri] = fragment->var_uri(name);
-            RETURN_NOT_OK(status);
+  return Status::Ok();
+}
 
-            uint64_t tile_attr_var_offset;
-            RETURN_NOT_OK(fragment->file_var_offset(
-                name, tile_idx, &tile_attr_var_offset));
+Status ReaderBase::unfilter_result_tile(
+    const std::string& name, ResultTile* const tile) const {
+  auto var_size = array_schema_->var_size(name);
+  auto nullable = array_schema_->is_nullable(name);
 
-            // Store the filtered buffer in the tile cache.
-            RETURN_NOT_OK(storage_manager_->write_to_cache(
-                *tile_attr_var_uri,
-                tile_attr_var_offset,
-                t_var.filtered_buffer()));
-          }
+  auto& fragment = fragment_metadata_[tile->frag_idx()];
+  auto format_version = fragment->format_version();
 
-          // Cache 't_validity'.
-          if (nullable && t_validity.filtered()) {
-            auto&& [status, tile_attr_validity_uri] =
-                fragment->validity_uri(name);
-            RETURN_NOT_OK(status);
-
-            uint64_t tile_attr_validity_offset;
-            RETURN_NOT_OK(fragment->file_validity_offset(
-                name, tile_idx, &tile_attr_validity_offset));
-
-            // Store the filtered buffer in the tile cache.
-            RETURN_NOT_OK(storage_manager_->write_to_cache(
-                *tile_attr_validity_uri,
-                tile_attr_validity_offset,
-                t_validity.filtered_buffer()));
-          }
+  // Applicable for zipped coordinates only to versions < 5
+  // Applicable for separate coordinates only to version >= 5
+  if (name != constants::coords ||
+      (name == constants::coords && format_version < 5) ||
+      (array_schema_->is_dim(name) && format_version >= 5)) {
+    auto tile_tuple = tile->tile_tuple(name);
 
-          // Unfilter 't' for fixed-sized tiles, otherwise unfilter both 't' and
-          // 't_var' for var-sized tiles.
-          if (!var_size) {
-            if (!nullable)
-              RETURN_NOT_OK(unfilter_tile(name, &t));
-            else
-              RETURN_NOT_OK(unfilter_tile_nullable(name, &t, &t_validity));
-          } else {
-            if (!nullable)
-              RETURN_NOT_OK(unfilter_tile(name, &t, &t_var));
-            else
-              RETURN_NOT_OK(
-                  unfilter_tile_nullable(name, &t, &t_var, &t_validity));
-          }
-        }
+    // Skip non-existent attributes/dimensions (e.g. coords in the
+    // dense case).
+    if (tile_tuple == nullptr ||
+        std::get<0>(*tile_tuple).filtered_buffer().size() == 0)
+      return Status::Ok();
 
-        return Status::Ok();
-      });
+    auto& t = std::get<0>(*tile_tuple);
+    auto& t_var = std::get<1>(*tile_tuple);
+    auto& t_validity = std::get<2>(*tile_tuple);
 
-  RETURN_CANCEL_OR_ERROR(status);
+    logger_->info("using cache");
+    // Get information about the tile in its fragment.
+    auto tile_idx = tile->tile_idx();
+    auto&& [status, tile_attr_uri] = fragment->uri(name, tile_idx);
+    RETURN_NOT_OK(status);
+
+    uint64_t tile_attr_offset;
+    RETURN_NOT_OK(fragment->file_offset(name, tile_idx, &tile_attr_offset));
+
+    // Cache 't'.
+    if (t.filtered()) {
+      // Store the filtered buffer in the tile cache.
+      RETURN_NOT_OK(storage_manager_->write_to_cache(
+          *tile_attr_uri, tile_attr_offset, t.filtered_buffer()));
+    }
+
+    // Cache 't_var'.
+    if (var_size && t_var.filtered()) {
+      auto&& [status, tile_attr_var_uri] = fragment->var_uri(name, tile_idx);
+      RETURN_NOT_OK(status);
+
+      uint64_t tile_attr_var_offset;
+      RETURN_NOT_OK(
+          fragment->file_var_offset(name, tile_idx, &tile_attr_var_offset));
+
+      // Store the filtered buffer in the tile cache.
+      RETURN_NOT_OK(storage_manager_->write_to_cache(
+          *tile_attr_var_uri, tile_attr_var_offset, t_var.filtered_buffer()));
+    }
+
+    // Cache 't_validity'.
+    if (nullable && t_validity.filtered()) {
+      auto&& [status, tile_attr_validity_uri] =
+          fragment->validity_uri(name, tile_idx);
+      RETURN_NOT_OK(status);
+
+      uint64_t tile_attr_validity_offset;
+      RETURN_NOT_OK(fragment->file_validity_offset(
+          name, tile_idx, &tile_attr_validity_offset));
+
+      // Store the filtered buffer in the tile cache.
+      RETURN_NOT_OK(storage_manager_->write_to_cache(
+          *tile_attr_validity_uri,
+          tile_attr_validity_offset,
+          t_validity.filtered_buffer()));
+    }
+
+    // Unfilter 't' for fixed-sized tiles, otherwise unfilter both 't' and
+    // 't_var' for var-sized tiles.
+    if (!var_size) {
+      if (!nullable)
+        RETURN_NOT_OK(unfilter_tile(name, &t));
+      else
+        RETURN_NOT_OK(unfilter_tile_nullable(name, &t, &t_validity));
+    } else {
+      if (!nullable)
+        RETURN_NOT_OK(unfilter_tile(name, &t, &t_var));
+      else
+        RETURN_NOT_OK(unfilter_tile_nullable(name, &t, &t_var, &t_validity));
+    }
+
+    // Store the unfiltered tiles in the unfiltered tile cache.
+    if (name != constants::coords &&
+        storage_manager_->unfiltered_tile_cache_enabled()) {
+      RETURN_NOT_OK(storage_manager_->write_unfiltered_to_cache(
+          *tile_attr_uri, tile_attr_offset, t.data(), t.size()));
+
+      if (var_size) {
+        auto&& [status, tile_attr_var_uri] = fragment->var_uri(name, tile_idx);
+        RETURN_NOT_OK(status);
+
+        uint64_t tile_attr_var_offset;
+        RETURN_NOT_OK(
+            fragment->file_var_offset(name, tile_idx, &tile_attr_var_offset));
+        RETURN_NOT_OK(storage_manager_->write_unfiltered_to_cache(
+            *tile_attr_var_uri,
+            tile_attr_var_offset,
+            t_var.data(),
+            t_var.size()));
+      }
+
+      if (nullable) {
+        auto&& [status, tile_attr_validity_uri] =
+            fragment->validity_uri(name, tile_idx);
+        RETURN_NOT_OK(status);
+
+        uint64_t tile_attr_validity_offset;
+        RETURN_NOT_OK(fragment->file_validity_offset(
+            name, tile_idx, &tile_attr_validity_offset));
+        RETURN_NOT_OK(storage_manager_->write_unfiltered_to_cache(
+            *tile_attr_validity_uri,
+            tile_attr_validity_offset,
+            t_validity.data(),
+            t_validity.size()));
+      }
+    }
+  }
 
   return Status::Ok();
 }
 
+Status ReaderBase::read_and_unfilter_attribute_tiles(
+    const std::vector<std::string>& names,
+    const std::vector<ResultTile*>& result_tiles) const {
+  auto timer_se = stats_->start_timer("read_and_unfilter_attribute_tiles");
+
+  if (names.empty())
+    return Status::Ok();
+
+  // Unfilter every tile as soon as it is read, instead of waiting for all
+  // the reads of an attribute to finish.
+  stats_->add_counter("attr_tile_num", names.size() * result_tiles.size());
+  return read_tiles(
+      names,
+      result_tiles,
+      false,
+      [this](const std::string& name, ResultTile* const tile) {
+        return unfilter_result_tile(name, tile);
+      });
+}
+
 Status ReaderBase::unfilter_tile(const std::string& name, Tile* tile) const {
   FilterPipeline filters = array_schema_->filters(name);
 
@@ -1731,6 +2414,13 @@ template void ReaderBase::compute_result_space_tiles<uint64_t>(
     const Subarray&,
     std::map<const uint64_t*, ResultSpaceTile<uint64_t>>&) const;
 
+template Status ReaderBase::aggregate_tiles<uint8_t>(
+    const std::vector<ResultTile*>&,
+    const std::vector<const std::vector<uint8_t>*>&);
+template Status ReaderBase::aggregate_tiles<uint64_t>(
+    const std::vector<ResultTile*>&,
+    const std::vector<const std::vector<uint64_t>*>&);
+
 template std::tuple<Status, std::optional<bool>>
 ReaderBase::fill_dense_coords<int8_t>(const Subarray&);
 template std::tuple<Status, std::optional<bool>>
@@ -33,16 +33,21 @@
 #ifndef TILEDB_READER_BASE_H
 #define TILEDB_READER_BASE_H
 
+#include <functional>
+#include <map>
 #include <queue>
 #include "strategy_base.h"
 #include "tiledb/common/status.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/tile_domain.h"
 #include "tiledb/sm/misc/types.h"
+#include "tiledb/sm/query/query_aggregate.h"
+#include "tiledb/sm/query/query_top_k.h"
 #include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/query/result_cell_slab.h"
 #include "tiledb/sm/query/result_space_tile.h"
 #include "tiledb/sm/subarray/subarray_partitioner.h"
+#include "tiledb/sm/tile/tile_buffer_pool.h"
 
 namespace tiledb {
 namespace sm {
@@ -119,6 +124,51 @@ class ReaderBase : public StrategyBase {
   /** Destructor. */
   ~ReaderBase() = default;
 
+  /* ********************************* */
+  /*                 API               */
+  /* ********************************* */
+
+  /**
+   * Sets the aggregates to compute. When set, the reader runs in aggregate
+   * mode: no cell is copied to the user buffers and the results are
+   * accumulated into `aggregates` instead.
+   *
+   * @param aggregates The aggregates, owned by the query.
+   */
+  void set_aggregates(std::vector<QueryAggregate>* aggregates);
+
+  /**
+   * Groups the aggregates by buckets of the values of a dimension. Each
+   * non-empty bucket gets its own copy of the aggregates in `groups`, the
+   * aggregates set with `set_aggregates` are only used as templates.
+   *
+   * @param dim_name The integer or datetime dimension to group by.
+   * @param bucket_width The width of the buckets.
+   * @param groups The aggregates of each bucket, owned by the query.
+   */
+  void set_aggregate_groups(
+      const std::string& dim_name,
+      uint64_t bucket_width,
+      std::map<int64_t, std::vector<QueryAggregate>>* groups);
+
+  /**
+   * Sets the fraction of the qualifying cells to return. Each cell is kept
+   * with probability `fraction`, decided by a hash of `seed` and the cell
+   * position so that the sample is reproducible.
+   *
+   * @param fraction The fraction of the cells to sample, in (0, 1].
+   * @param seed The seed of the sample.
+   */
+  void set_sample(double fraction, uint64_t seed);
+
+  /**
+   * Sets the top K selection. When set, the reader only returns the cells
+   * selected by `top_k`.
+   *
+   * @param top_k The top K selection, owned by the query.
+   */
+  void set_top_k(QueryTopK* top_k);
+
   /* ********************************* */
   /*          STATIC FUNCTIONS         */
   /* ********************************* */
@@ -159,9 +209,48 @@ class ReaderBase : public StrategyBase {
   /** The query condition. */
   QueryCondition& condition_;
 
+  /** The aggregates computed in aggregate mode, `nullptr` otherwise. */
+  std::vector<QueryAggregate>* aggregates_;
+
+  /** The dimension the aggregates are grouped by. */
+  std::string group_by_dim_;
+
+  /** The index of the dimension the aggregates are grouped by. */
+  unsigned group_by_dim_idx_;
+
+  /** The width of the buckets the aggregates are grouped by. */
+  uint64_t group_by_width_;
+
+  /** The aggregates of each bucket, `nullptr` if they are not grouped. */
+  std::map<int64_t, std::vector<QueryAggregate>>* aggregate_groups_;
+
+  /** The fraction of the cells to sample, 1 when not sampling. */
+  double sample_fraction_;
+
+  /** The seed of the sample. */
+  uint64_t sample_seed_;
+
+  /** The top K selection, `nullptr` if the query has none. */
+  QueryTopK* top_k_;
+
   /** The fragment metadata that the reader will focus on. */
   std::vector<tdb_shared_ptr<FragmentMetadata>> fragment_metadata_;
 
+  /**
+   * The user buffer regions some tiles are unfiltered into, instead of
+   * buffers of their own, per result tile and attribute. The value holds
+   * the regions for the fixed-sized values and for the validity values,
+   * the latter being `nullptr` for non-nullable attributes.
+   */
+  std::map<std::pair<const ResultTile*, std::string>, std::pair<void*, void*>>
+      unfilter_dests_;
+
+  /**
+   * The pool the tile buffers are drawn from and returned to across the
+   * iterations of the query, `nullptr` if the reader does not recycle them.
+   */
+  tdb_unique_ptr<TileBufferPool> tile_buffer_pool_;
+
   /* ********************************* */
   /*         PROTECTED METHODS         */
   /* ********************************* */
@@ -215,6 +304,125 @@ class ReaderBase : public StrategyBase {
   Status load_tile_var_sizes(
       Subarray& subarray, const std::vector<std::string>& names);
 
+  /**
+   * Loads the tile min/max and null count metadata used to skip tiles
+   * with the query condition into their associated element in
+   * `fragment_metadata_`.
+   *
+   * @param subarray The subarray to load the tile metadata for.
+   * @return Status
+   */
+  Status load_tile_condition_metadata(Subarray& subarray);
+
+  /**
+   * Computes, using the tile metadata loaded by
+   * `load_tile_condition_metadata`, which of the input result tiles cannot
+   * contain a cell satisfying the query condition.
+   *
+   * @param result_tiles The result tiles.
+   * @return Status, one value per result tile, set to 1 if the tile can be
+   *     skipped.
+   */
+  std::tuple<Status, std::optional<std::vector<uint8_t>>>
+  compute_qc_skipped_tiles(const std::vector<ResultTile*>& result_tiles);
+
+  /** Returns true if the reader runs in aggregate mode. */
+  bool has_aggregates() const;
+
+  /**
+   * Returns the names of the fields whose tiles must be read to fold
+   * partially covered tiles into the aggregates.
+   */
+  std::vector<std::string> aggregate_field_names() const;
+
+  /**
+   * Loads the tile min/max/sum/null count metadata required by the
+   * aggregates into their associated element in `fragment_metadata_`.
+   *
+   * @param subarray The subarray to load the tile metadata for.
+   * @return Status
+   */
+  Status load_tile_aggregate_metadata(Subarray& subarray);
+
+  /** Returns true if the reader returns the top K cells. */
+  bool has_top_k() const;
+
+  /**
+   * Loads the tile min/max metadata of the top K attribute, used to skip
+   * the tiles that cannot hold a top K cell, into their associated element
+   * in `fragment_metadata_`.
+   *
+   * @param subarray The subarray to load the tile metadata for.
+   * @return Status
+   */
+  Status load_tile_top_k_metadata(Subarray& subarray);
+
+  /**
+   * Returns true if all the aggregates can be computed from the tile
+   * metadata of the input fragment.
+   */
+  bool aggregates_have_tile_metadata(unsigned frag_idx) const;
+
+  /** Returns true if the aggregates are grouped by a dimension. */
+  bool has_aggregate_groups() const;
+
+  /**
+   * Returns the bucket of a tile if its MBR lies within a single bucket of
+   * the grouped dimension, `std::nullopt` otherwise.
+   */
+  std::optional<int64_t> tile_bucket(
+      unsigned frag_idx, uint64_t tile_idx) const;
+
+  /**
+   * Returns the aggregates of a bucket, created from the templates the
+   * first time the bucket is seen.
+   */
+  std::vector<QueryAggregate>& aggregate_group(int64_t bucket);
+
+  /**
+   * Splits the cells of a tile by bucket of the grouped dimension, whose
+   * coordinates must be loaded.
+   *
+   * @tparam BitmapType The bitmap type.
+   * @param result_tile The result tile.
+   * @param cell_num The number of cells in the tile.
+   * @param bitmap The cell multiplicities, empty if all cells are included.
+   * @param bucket_bitmaps Set to the cell multiplicities of each bucket.
+   */
+  template <class BitmapType>
+  void compute_bucket_bitmaps(
+      ResultTile* result_tile,
+      uint64_t cell_num,
+      const std::vector<BitmapType>& bitmap,
+      std::map<int64_t, std::vector<BitmapType>>& bucket_bitmaps) const;
+
+  /**
+   * Folds tiles that are fully covered by the query into the aggregates,
+   * using only the tile metadata.
+   *
+   * @param tiles The (fragment index, tile index) pairs to fold.
+   * @return Status
+   */
+  Status aggregate_tiles_metadata(
+      const std::vector<std::pair<unsigned, uint64_t>>& tiles);
+
+  /**
+   * Folds the cells of the input result tiles into the aggregates. The
+   * tiles for `aggregate_field_names()` must be loaded, as well as the
+   * coordinates of the grouped dimension for the tiles that span more than
+   * one bucket.
+   *
+   * @tparam BitmapType The bitmap type.
+   * @param result_tiles The result tiles.
+   * @param bitmaps The cell multiplicities for each result tile, an empty
+   *     bitmap meaning all cells are included once.
+   * @return Status
+   */
+  template <class BitmapType>
+  Status aggregate_tiles(
+      const std::vector<ResultTile*>& result_tiles,
+      const std::vector<const std::vector<BitmapType>*>& bitmaps);
+
   /**
    * Initializes a fixed-sized tile.
    *
@@ -320,12 +528,17 @@ class ReaderBase : public StrategyBase {
    * @param result_tiles The retrieved tiles will be stored inside the
    *     `ResultTile` instances in this vector.
    * @param disable_cache Disable the tile cache or not.
+   * @param on_tile_read If set, invoked on the compute thread pool with the
+   *     name and result tile of every tile tuple as soon as all of its tiles
+   *     are read, while the remaining reads are still in flight.
    * @return Status
    */
   Status read_tiles(
       const std::vector<std::string>& names,
       const std::vector<ResultTile*>& result_tiles,
-      const bool disable_cache = false) const;
+      const bool disable_cache = false,
+      const std::function<Status(const std::string&, ResultTile*)>&
+          on_tile_read = nullptr) const;
 
   /**
    * Filters the tiles on a particular attribute/dimension from all input
@@ -450,6 +663,31 @@ class ReaderBase : public StrategyBase {
       const std::vector<ResultTile*>& result_tiles,
       const bool disable_cache = false) const;
 
+  /**
+   * Stores the filtered tiles of a particular attribute/dimension of a
+   * result tile in the tile cache, then unfilters them.
+   *
+   * @param name Attribute/dimension whose tiles will be unfiltered.
+   * @param tile The result tile holding the tiles to be unfiltered.
+   * @return Status
+   */
+  Status unfilter_result_tile(const std::string& name, ResultTile* tile) const;
+
+  /**
+   * Reads and unfilters the tiles of the attributes in `names`. Each tile is
+   * unfiltered on the compute thread pool as soon as its data is read, so
+   * that the IO latency of the slowest read is hidden behind the unfiltering
+   * of the tiles already read.
+   *
+   * @param names The attribute names.
+   * @param result_tiles The retrieved tiles will be stored inside the
+   *     `ResultTile` instances in this vector.
+   * @return Status
+   */
+  Status read_and_unfilter_attribute_tiles(
+      const std::vector<std::string>& names,
+      const std::vector<ResultTile*>& result_tiles) const;
+
   /**
    * Runs the input fixed-sized tile for the input attribute or dimension
    * through the filter pipeline. The tile buffer is modified to contain the
@@ -715,6 +953,14 @@ class ReaderBase : public StrategyBase {
       ChunkData* const tile_chunk_var_data,
       ChunkData* const tile_chunk_validity_data) const;
 
+  /**
+   * Sets all the cells of a tile to a fill value.
+   *
+   * @param fill_value The fill value of one cell.
+   * @param tile The tile to fill.
+   */
+  static void fill_tile_values(const ByteVecValue& fill_value, Tile* tile);
+
   /**
    * Reads the chunk data of a tile buffer and populates a chunk data structure
    *
@@ -37,6 +37,7 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "tiledb/sm/misc/types.h"
@@ -112,6 +113,19 @@ class ResultSpaceTile {
     return &(it->second);
   }
 
+  /**
+   * Marks the result tile of the input fragment as skipped, meaning that no
+   * cell in it satisfies the query condition. Skipped tiles are not read.
+   */
+  void set_qc_skipped(unsigned frag_idx) {
+    qc_skipped_frags_.insert(frag_idx);
+  }
+
+  /** Returns true if the result tile of the input fragment was skipped. */
+  bool qc_skipped(unsigned frag_idx) const {
+    return qc_skipped_frags_.count(frag_idx) != 0;
+  }
+
   /** Equality operator (mainly for debugging purposes). */
   bool operator==(const ResultSpaceTile& rst) const {
     if (frag_domains_.size() != rst.frag_domains_.size())
@@ -143,6 +157,12 @@ class ResultSpaceTile {
    * `(fragment id) -> (result tile)`.
    */
   std::map<unsigned, ResultTile> result_tiles_;
+
+  /**
+   * The fragments whose result tile was skipped using the query condition
+   * and the tile metadata.
+   */
+  std::set<unsigned> qc_skipped_frags_;
 };
 
 }  // namespace sm
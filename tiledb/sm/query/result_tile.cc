@@ -35,6 +35,8 @@
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/apply_with_type.h"
+#include "tiledb/sm/tile/tile_buffer_pool.h"
 
 #include <cassert>
 #include <iostream>
@@ -57,6 +59,7 @@ ResultTile::ResultTile(
   assert(array_schema != nullptr);
   domain_ = array_schema->domain();
   coord_tiles_.resize(domain_->dim_num());
+  coord_string_prefixes_.resize(domain_->dim_num());
   attr_tiles_.resize(array_schema->attribute_num());
   for (uint64_t i = 0; i < array_schema->attribute_num(); i++) {
     const Attribute* attribute = array_schema->attribute(i);
@@ -90,6 +93,7 @@ void ResultTile::swap(ResultTile& tile) {
   std::swap(attr_tiles_, tile.attr_tiles_);
   std::swap(coords_tile_, tile.coords_tile_);
   std::swap(coord_tiles_, tile.coord_tiles_);
+  std::swap(coord_string_prefixes_, tile.coord_string_prefixes_);
   std::swap(compute_results_dense_func_, tile.compute_results_dense_func_);
   std::swap(coord_func_, tile.coord_func_);
   std::swap(compute_results_sparse_func_, tile.compute_results_sparse_func_);
@@ -131,17 +135,22 @@ const Domain* ResultTile::domain() const {
   return domain_;
 }
 
-void ResultTile::erase_tile(const std::string& name) {
+void ResultTile::erase_tile(const std::string& name, TileBufferPool* pool) {
   // Handle zipped coordinates tiles
   if (name == constants::coords) {
+    recycle_tile_tuple(coords_tile_, pool);
     coords_tile_ = TileTuple(Tile(), Tile(), Tile());
     return;
   }
 
   // Handle dimension tile
-  for (auto& ct : coord_tiles_) {
+  for (unsigned d = 0; d < coord_tiles_.size(); ++d) {
+    auto& ct = coord_tiles_[d];
     if (ct.first == name) {
+      recycle_tile_tuple(ct.second, pool);
       ct.second = TileTuple(Tile(), Tile(), Tile());
+      coord_string_prefixes_[d].clear();
+      coord_string_prefixes_[d].shrink_to_fit();
       return;
     }
   }
@@ -149,12 +158,24 @@ void ResultTile::erase_tile(const std::string& name) {
   // Handle attribute tile
   for (auto& at : attr_tiles_) {
     if (at.first == name) {
+      if (at.second.has_value())
+        recycle_tile_tuple(*at.second, pool);
       at.second = TileTuple(Tile(), Tile(), Tile());
       return;
     }
   }
 }
 
+void ResultTile::recycle_tiles(TileBufferPool* pool) {
+  recycle_tile_tuple(coords_tile_, pool);
+  for (auto& ct : coord_tiles_)
+    recycle_tile_tuple(ct.second, pool);
+  for (auto& at : attr_tiles_) {
+    if (at.second.has_value())
+      recycle_tile_tuple(*at.second, pool);
+  }
+}
+
 void ResultTile::init_attr_tile(const std::string& name) {
   // Nothing to do for the special zipped coordinates tile
   if (name == constants::coords)
@@ -172,6 +193,7 @@ void ResultTile::init_attr_tile(const std::string& name) {
 void ResultTile::init_coord_tile(const std::string& name, unsigned dim_idx) {
   coord_tiles_[dim_idx] = std::pair<std::string, TileTuple>(
       name, TileTuple(Tile(), Tile(), Tile()));
+  coord_string_prefixes_[dim_idx].clear();
 
   // When at least one unzipped coordinate has been initialized, we will
   // use the unzipped `coord()` implementation.
@@ -219,26 +241,62 @@ std::string_view ResultTile::coord_string(
   const auto& coord_tile_off = std::get<0>(coord_tiles_[dim_idx].second);
   const auto& coord_tile_val = std::get<1>(coord_tiles_[dim_idx].second);
   auto cell_num = coord_tile_off.cell_num();
-  auto val_size = coord_tile_val.size();
+  assert(pos < cell_num);
 
-  uint64_t offset = 0;
-  Status st =
-      coord_tile_off.read(&offset, pos * sizeof(uint64_t), sizeof(uint64_t));
-  assert(st.ok());
+  // Read the offsets in place, this is on the critical path of sorting.
+  auto offsets = static_cast<const uint64_t*>(coord_tile_off.data());
+  const uint64_t offset = offsets[pos];
+  const uint64_t next_offset =
+      (pos == cell_num - 1) ? coord_tile_val.size() : offsets[pos + 1];
 
-  uint64_t next_offset = 0;
-  if (pos == cell_num - 1) {
-    next_offset = val_size;
-  } else {
-    st = coord_tile_off.read(
-        &next_offset, (pos + 1) * sizeof(uint64_t), sizeof(uint64_t));
-    assert(st.ok());
-  }
+  auto* buffer = static_cast<char*>(coord_tile_val.data()) + offset;
+  return std::string_view(buffer, next_offset - offset);
+}
 
-  auto size = next_offset - offset;
+void ResultTile::compute_coord_string_prefixes(unsigned dim_idx) {
+  assert(domain_->dimension(dim_idx)->var_size());
+  auto& prefixes = coord_string_prefixes_[dim_idx];
+  prefixes.clear();
 
-  auto* buffer = static_cast<char*>(coord_tile_val.data()) + offset;
-  return std::string_view(buffer, size);
+  const auto& coord_tile_off = std::get<0>(coord_tiles_[dim_idx].second);
+  if (coord_tile_off.empty())
+    return;
+
+  const auto cell_num = coord_tile_off.cell_num();
+  prefixes.resize(cell_num);
+  for (uint64_t pos = 0; pos < cell_num; ++pos)
+    prefixes[pos] = string_prefix(coord_string(pos, dim_idx));
+}
+
+uint64_t ResultTile::string_prefix(const std::string_view& str) {
+  const auto size = std::min<uint64_t>(str.size(), sizeof(uint64_t));
+  uint64_t prefix = 0;
+  for (uint64_t i = 0; i < size; ++i)
+    prefix |= static_cast<uint64_t>(static_cast<uint8_t>(str[i]))
+              << (56 - 8 * i);
+  return prefix;
+}
+
+int ResultTile::compare_coord_strings(
+    const ResultTile& a,
+    uint64_t pos_a,
+    const ResultTile& b,
+    uint64_t pos_b,
+    unsigned dim_idx) {
+  // Try to decide from the prefixes only.
+  auto prefixes_a = a.coord_string_prefixes(dim_idx);
+  auto prefixes_b = b.coord_string_prefixes(dim_idx);
+  if (prefixes_a != nullptr && prefixes_b != nullptr) {
+    if (prefixes_a[pos_a] < prefixes_b[pos_b])
+      return -1;
+    if (prefixes_a[pos_a] > prefixes_b[pos_b])
+      return 1;
+  }
+
+  // Tie, compare the full strings.
+  auto cmp = a.coord_string(pos_a, dim_idx)
+                 .compare(b.coord_string(pos_b, dim_idx));
+  return (cmp > 0) - (cmp < 0);
 }
 
 uint64_t ResultTile::coord_size(unsigned dim_idx) const {
@@ -260,7 +318,7 @@ bool ResultTile::same_coords(
       if (std::memcmp(coord(pos_a, d), rt.coord(pos_b, d), coord_size(d)) != 0)
         return false;
     } else {  // Var-sized
-      if (coord_string(pos_a, d) != rt.coord_string(pos_b, d))
+      if (compare_coord_strings(*this, pos_a, rt, pos_b, d) != 0)
         return false;
     }
   }
@@ -501,6 +559,29 @@ inline bool ResultTile::str_coord_intersects(
   return str >= range_start && str <= range_end;
 }
 
+inline bool ResultTile::str_coord_intersects(
+    const uint64_t* prefixes,
+    const uint64_t pos,
+    const uint64_t range_start_prefix,
+    const uint64_t range_end_prefix,
+    const uint64_t c_offset,
+    const uint64_t c_size,
+    const char* const buff_str,
+    const std::string_view& range_start,
+    const std::string_view& range_end) {
+  if (prefixes != nullptr) {
+    // A strict prefix inequality implies the same strict string inequality.
+    const uint64_t prefix = prefixes[pos];
+    if (prefix < range_start_prefix || prefix > range_end_prefix)
+      return false;
+    if (prefix > range_start_prefix && prefix < range_end_prefix)
+      return true;
+  }
+
+  return str_coord_intersects(
+      c_offset, c_size, buff_str, range_start, range_end);
+}
+
 template <>
 void ResultTile::compute_results_sparse<char>(
     const ResultTile* result_tile,
@@ -519,6 +600,11 @@ void ResultTile::compute_results_sparse<char>(
   if (coords_num == 0)
     return;
 
+  // Get the cached coordinate prefixes, if any.
+  const auto prefixes = result_tile->coord_string_prefixes(dim_idx);
+  const auto range_start_prefix = string_prefix(range_start);
+  const auto range_end_prefix = string_prefix(range_end);
+
   // Get coordinate tile
   const auto& coord_tile = result_tile->coord_tile(dim_idx);
 
@@ -603,7 +689,15 @@ void ResultTile::compute_results_sparse<char>(
           c_size = (pos < coords_num - 1) ? buff_off[pos + 1] - c_offset :
                                             buff_str_size - c_offset;
           r_bitmap[pos] = str_coord_intersects(
-              c_offset, c_size, buff_str, range_start, range_end);
+              prefixes,
+              pos,
+              range_start_prefix,
+              range_end_prefix,
+              c_offset,
+              c_size,
+              buff_str,
+              range_start,
+              range_end);
         }
       }
     }
@@ -649,7 +743,15 @@ void ResultTile::compute_results_sparse<char>(
       c_size = (pos < coords_num - 1) ? buff_off[pos + 1] - c_offset :
                                         buff_str_size - c_offset;
       r_bitmap[pos] = str_coord_intersects(
-          c_offset, c_size, buff_str, range_start, range_end);
+          prefixes,
+          pos,
+          range_start_prefix,
+          range_end_prefix,
+          c_offset,
+          c_size,
+          buff_str,
+          range_start,
+          range_end);
     }
   }
 }
@@ -1056,6 +1158,16 @@ Status ResultTile::compute_results_count_sparse<uint64_t>(
 /*         PRIVATE METHODS        */
 /* ****************************** */
 
+void ResultTile::recycle_tile_tuple(
+    TileTuple& tile_tuple, TileBufferPool* pool) {
+  if (pool == nullptr)
+    return;
+
+  std::get<0>(tile_tuple).recycle_data(pool);
+  std::get<1>(tile_tuple).recycle_data(pool);
+  std::get<2>(tile_tuple).recycle_data(pool);
+}
+
 void ResultTile::set_compute_results_func() {
   auto dim_num = domain_->dim_num();
   compute_results_dense_func_.resize(dim_num);
@@ -1064,131 +1176,30 @@ void ResultTile::set_compute_results_func() {
   compute_results_count_sparse_uint64_t_func_.resize(dim_num);
   for (unsigned d = 0; d < dim_num; ++d) {
     auto dim = domain_->dimension(d);
-    switch (dim->type()) {
-      case Datatype::INT32:
-        compute_results_dense_func_[d] = compute_results_dense<int32_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<int32_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, int32_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, int32_t>;
-        break;
-      case Datatype::INT64:
-        compute_results_dense_func_[d] = compute_results_dense<int64_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<int64_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, int64_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, int64_t>;
-        break;
-      case Datatype::INT8:
-        compute_results_dense_func_[d] = compute_results_dense<int8_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<int8_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, int8_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, int8_t>;
-        break;
-      case Datatype::UINT8:
-        compute_results_dense_func_[d] = compute_results_dense<uint8_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<uint8_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, uint8_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, uint8_t>;
-        break;
-      case Datatype::INT16:
-        compute_results_dense_func_[d] = compute_results_dense<int16_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<int16_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, int16_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, int16_t>;
-        break;
-      case Datatype::UINT16:
-        compute_results_dense_func_[d] = compute_results_dense<uint16_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<uint16_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, uint16_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, uint16_t>;
-        break;
-      case Datatype::UINT32:
-        compute_results_dense_func_[d] = compute_results_dense<uint32_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<uint32_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, uint32_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, uint32_t>;
-        break;
-      case Datatype::UINT64:
-        compute_results_dense_func_[d] = compute_results_dense<uint64_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<uint64_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, uint64_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, uint64_t>;
-        break;
-      case Datatype::FLOAT32:
-        compute_results_dense_func_[d] = compute_results_dense<float>;
-        compute_results_sparse_func_[d] = compute_results_sparse<float>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, float>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, float>;
-        break;
-      case Datatype::FLOAT64:
-        compute_results_dense_func_[d] = compute_results_dense<double>;
-        compute_results_sparse_func_[d] = compute_results_sparse<double>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, double>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, double>;
-        break;
-      case Datatype::DATETIME_YEAR:
-      case Datatype::DATETIME_MONTH:
-      case Datatype::DATETIME_WEEK:
-      case Datatype::DATETIME_DAY:
-      case Datatype::DATETIME_HR:
-      case Datatype::DATETIME_MIN:
-      case Datatype::DATETIME_SEC:
-      case Datatype::DATETIME_MS:
-      case Datatype::DATETIME_US:
-      case Datatype::DATETIME_NS:
-      case Datatype::DATETIME_PS:
-      case Datatype::DATETIME_FS:
-      case Datatype::DATETIME_AS:
-      case Datatype::TIME_HR:
-      case Datatype::TIME_MIN:
-      case Datatype::TIME_SEC:
-      case Datatype::TIME_MS:
-      case Datatype::TIME_US:
-      case Datatype::TIME_NS:
-      case Datatype::TIME_PS:
-      case Datatype::TIME_FS:
-      case Datatype::TIME_AS:
-        compute_results_dense_func_[d] = compute_results_dense<int64_t>;
-        compute_results_sparse_func_[d] = compute_results_sparse<int64_t>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse<uint8_t, int64_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse<uint64_t, int64_t>;
-        break;
-      case Datatype::STRING_ASCII:
-        compute_results_dense_func_[d] = nullptr;
-        compute_results_sparse_func_[d] = compute_results_sparse<char>;
-        compute_results_count_sparse_uint8_t_func_[d] =
-            compute_results_count_sparse_string<uint8_t>;
-        compute_results_count_sparse_uint64_t_func_[d] =
-            compute_results_count_sparse_string<uint64_t>;
-        break;
-      default:
-        compute_results_dense_func_[d] = nullptr;
-        compute_results_sparse_func_[d] = nullptr;
-        compute_results_count_sparse_uint8_t_func_[d] = nullptr;
-        compute_results_count_sparse_uint64_t_func_[d] = nullptr;
-        break;
-    }
+    compute_results_dense_func_[d] = nullptr;
+    compute_results_sparse_func_[d] = nullptr;
+    compute_results_count_sparse_uint8_t_func_[d] = nullptr;
+    compute_results_count_sparse_uint64_t_func_[d] = nullptr;
+    apply_with_type(
+        dim->type(),
+        [&](auto t) {
+          using T = decltype(t);
+          compute_results_dense_func_[d] = compute_results_dense<T>;
+          compute_results_sparse_func_[d] = compute_results_sparse<T>;
+          compute_results_count_sparse_uint8_t_func_[d] =
+              compute_results_count_sparse<uint8_t, T>;
+          compute_results_count_sparse_uint64_t_func_[d] =
+              compute_results_count_sparse<uint64_t, T>;
+        },
+        [&]() {
+          if (dim->type() == Datatype::STRING_ASCII) {
+            compute_results_sparse_func_[d] = compute_results_sparse<char>;
+            compute_results_count_sparse_uint8_t_func_[d] =
+                compute_results_count_sparse_string<uint8_t>;
+            compute_results_count_sparse_uint64_t_func_[d] =
+                compute_results_count_sparse_string<uint64_t>;
+          }
+        });
   }
 }
 
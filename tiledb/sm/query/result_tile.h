@@ -53,6 +53,7 @@ namespace sm {
 class Domain;
 class FragmentMetadata;
 class Subarray;
+class TileBufferPool;
 
 /**
  * Stores information about a logical dense or sparse result tile. Note that it
@@ -122,8 +123,14 @@ class ResultTile {
   /** Returns the stored domain. */
   const Domain* domain() const;
 
-  /** Erases the tile for the input attribute/dimension. */
-  void erase_tile(const std::string& name);
+  /**
+   * Erases the tile for the input attribute/dimension, returning its
+   * buffers to `pool` if not `nullptr`.
+   */
+  void erase_tile(const std::string& name, TileBufferPool* pool = nullptr);
+
+  /** Returns the buffers of all the tiles drawn from `pool` to it. */
+  void recycle_tiles(TileBufferPool* pool);
 
   /** Initializes the result tile for the given attribute. */
   void init_attr_tile(const std::string& name);
@@ -145,12 +152,67 @@ class ResultTile {
     return (this->*coord_func_)(pos, dim_idx);
   }
 
+  /**
+   * Returns the coordinate at position `pos` for dimension `dim_idx` as a
+   * value of type `T`, which must be the type of the dimension. Unlike
+   * `coord()`, this does not go through a function pointer, so it can be
+   * inlined in comparators specialized on the dimension types.
+   */
+  template <class T>
+  inline const T& coord_as(uint64_t pos, unsigned dim_idx) const {
+    if (coord_func_ == &ResultTile::unzipped_coord)
+      return std::get<0>(coord_tiles_[dim_idx].second)
+          .template data_as<T>()[pos];
+    const auto& coords_tile = std::get<0>(coords_tile_);
+    return coords_tile
+        .template data_as<T>()[pos * coords_tile.dim_num() + dim_idx];
+  }
+
   /**
    * Returns the string coordinate at position `pos` for
    * dimension `dim_idx`. Applicable only to string dimensions.
    */
   std::string_view coord_string(uint64_t pos, unsigned dim_idx) const;
 
+  /**
+   * Caches the first 8 bytes of every string coordinate of dimension
+   * `dim_idx` as a big-endian integer, so that most comparisons between
+   * string coordinates reduce to a single integer comparison. Must be
+   * invoked after the coordinate tiles of `dim_idx` are unfiltered.
+   */
+  void compute_coord_string_prefixes(unsigned dim_idx);
+
+  /**
+   * Returns the cached string coordinate prefixes for dimension `dim_idx`,
+   * or `nullptr` if `compute_coord_string_prefixes()` was not invoked.
+   */
+  inline const uint64_t* coord_string_prefixes(unsigned dim_idx) const {
+    const auto& prefixes = coord_string_prefixes_[dim_idx];
+    return prefixes.empty() ? nullptr : prefixes.data();
+  }
+
+  /**
+   * Returns the first 8 bytes of `str` packed as a big-endian integer,
+   * padded with zeros. Comparing two prefixes as integers orders them
+   * the same way as comparing the strings, except on ties.
+   */
+  static uint64_t string_prefix(const std::string_view& str);
+
+  /**
+   * Compares the string coordinate at position `pos_a` of tile `a` with
+   * the one at `pos_b` of tile `b` on dimension `dim_idx`. Uses the cached
+   * prefixes when available and only compares the full strings on ties.
+   *
+   * @return -1, 0 or 1 if the first coordinate is smaller, equal or
+   *     larger than the second one.
+   */
+  static int compare_coord_strings(
+      const ResultTile& a,
+      uint64_t pos_a,
+      const ResultTile& b,
+      uint64_t pos_b,
+      unsigned dim_idx);
+
   /** Returns the coordinate size on the input dimension. */
   uint64_t coord_size(unsigned dim_idx) const;
 
@@ -350,6 +412,13 @@ class ResultTile {
    */
   std::vector<std::pair<std::string, TileTuple>> coord_tiles_;
 
+  /**
+   * The cached big-endian 8-byte prefixes of the string coordinates, one
+   * vector per dimension. Empty for fixed-sized dimensions or if not
+   * computed.
+   */
+  std::vector<std::vector<uint64_t>> coord_string_prefixes_;
+
   /**
    * Stores the appropriate templated compute_results_dense() function based for
    * each dimension, based on the dimension datatype.
@@ -420,6 +489,12 @@ class ResultTile {
   /** Sets the templated compute_results() function. */
   void set_compute_results_func();
 
+  /**
+   * Returns the buffers of the tiles of `tile_tuple` drawn from `pool` to
+   * it. This is a no-op if `pool` is `nullptr`.
+   */
+  static void recycle_tile_tuple(TileTuple& tile_tuple, TileBufferPool* pool);
+
   /** Implements coord() for zipped coordinates. */
   const void* zipped_coord(uint64_t pos, unsigned dim_idx) const;
 
@@ -446,6 +521,22 @@ class ResultTile {
       const char* const buff_str,
       const std::string_view& range_start,
       const std::string_view& range_end);
+
+  /**
+   * Same as above, but first tries to decide the intersection from the
+   * cached prefix of the coordinate at position `pos`, if `prefixes` is
+   * not `nullptr`.
+   */
+  static bool str_coord_intersects(
+      const uint64_t* prefixes,
+      const uint64_t pos,
+      const uint64_t range_start_prefix,
+      const uint64_t range_end_prefix,
+      const uint64_t c_offset,
+      const uint64_t c_size,
+      const char* const buff_str,
+      const std::string_view& range_start,
+      const std::string_view& range_end);
 };
 
 }  // namespace sm
@@ -41,9 +41,11 @@
 #include "tiledb/sm/misc/hash.h"
 #include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/hilbert_order.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/result_tile.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -56,6 +58,25 @@ using namespace tiledb::sm::stats;
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Minimum number of cells worth merging in a partition of its own. */
+constexpr uint64_t min_merge_partition_cells = 1024;
+
+/**
+ * Returns the position of the `n`-th cell in the bitmap of a tile, starting
+ * at `start`.
+ */
+uint64_t result_pos(
+    const ResultTileWithBitmap<uint8_t>* tile, uint64_t start, uint64_t n) {
+  if (tile->bitmap_.size() == 0)
+    return start + n - 1;
+
+  return tile->bitmap_.pos_with_count(start, n);
+}
+
+}  // namespace
+
 /* ****************************** */
 /*          CONSTRUCTORS          */
 /* ****************************** */
@@ -110,30 +131,17 @@ Status SparseGlobalOrderReader::init() {
 }
 
 Status SparseGlobalOrderReader::initialize_memory_budget() {
-  bool found = false;
-  RETURN_NOT_OK(
-      config_.get<uint64_t>("sm.mem.total_budget", &memory_budget_, &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_global_order.ratio_array_data",
-      &memory_budget_ratio_array_data_,
-      &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_global_order.ratio_coords",
-      &memory_budget_ratio_coords_,
-      &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_global_order.ratio_query_condition",
-      &memory_budget_ratio_query_condition_,
-      &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_global_order.ratio_tile_ranges",
-      &memory_budget_ratio_tile_ranges_,
-      &found));
-  assert(found);
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  memory_budget_ = config->mem_total_budget;
+  memory_budget_ratio_array_data_ = config->sparse_global_order.array_data;
+  memory_budget_ratio_coords_ = config->sparse_global_order.coords;
+  memory_budget_ratio_query_condition_ =
+      config->sparse_global_order.query_condition;
+  memory_budget_ratio_tile_ranges_ = config->sparse_global_order.tile_ranges;
+
+  // Reserve the budget from the context, which may shrink it.
+  RETURN_NOT_OK(reserve_memory_budget());
 
   return Status::Ok();
 }
@@ -191,11 +199,15 @@ Status SparseGlobalOrderReader::dowork() {
         }
       }
 
+      // Skip the tiles excluded by the query condition tile metadata.
+      RETURN_NOT_OK(skip_qc_tiles<uint8_t>(tmp_result_tiles));
+
       // Read and unfilter coords.
       RETURN_NOT_OK(read_and_unfilter_coords(true, tmp_result_tiles));
 
       // Compute the tile bitmaps.
       RETURN_NOT_OK(compute_tile_bitmaps<uint8_t>(tmp_result_tiles));
+      report_memory_usage();
 
       // Apply query condition.
       RETURN_NOT_OK(apply_query_condition<uint8_t>(tmp_result_tiles));
@@ -217,7 +229,7 @@ Status SparseGlobalOrderReader::dowork() {
       RETURN_NOT_OK_ELSE(status, logger_->status(status));
 
       // Compute hilbert values.
-      if (array_schema_->cell_order() == Layout::HILBERT) {
+      if (layout_is_curve(array_schema_->cell_order())) {
         RETURN_NOT_OK(compute_hilbert_values(tmp_result_tiles));
       }
     }
@@ -255,6 +267,18 @@ Status SparseGlobalOrderReader::dowork() {
 void SparseGlobalOrderReader::reset() {
 }
 
+Status SparseGlobalOrderReader::rebind() {
+  if (memory_used_for_coords_total_ != 0)
+    return logger_->status(Status_SparseGlobalOrderReaderError(
+        "Cannot rebind reader; The previous read is incomplete"));
+
+  return SparseIndexReaderBase::rebind();
+}
+
+void SparseGlobalOrderReader::set_progress(QueryProgress* progress) {
+  progress_ = progress;
+}
+
 std::tuple<Status, std::optional<bool>>
 SparseGlobalOrderReader::add_result_tile(
     const unsigned dim_num,
@@ -270,7 +294,7 @@ SparseGlobalOrderReader::add_result_tile(
   auto tiles_size_qc = tiles_sizes->second;
 
   // Account for hilbert data.
-  if (array_schema_->cell_order() == Layout::HILBERT) {
+  if (layout_is_curve(array_schema_->cell_order())) {
     tiles_size += fragment_metadata_[f]->cell_num(t) * sizeof(uint64_t);
   }
 
@@ -285,6 +309,7 @@ SparseGlobalOrderReader::add_result_tile(
     std::unique_lock<std::mutex> lck(mem_budget_mtx_);
     memory_used_for_coords_total_ += tiles_size + sizeof(ResultTile);
     memory_used_qc_tiles_total_ += tiles_size_qc;
+    memory_used_bitmaps_total_ += get_tile_bitmap_size<uint8_t>(f, t);
   }
 
   // Adjust per fragment memory used.
@@ -322,38 +347,34 @@ SparseGlobalOrderReader::create_result_tiles() {
     // Load as many tiles as the memory budget allows.
     auto status = parallel_for(
         storage_manager_->compute_tp(), 0, fragment_num, [&](uint64_t f) {
-          uint64_t t = 0;
           while (!result_tile_ranges_[f].empty()) {
-            auto& range = result_tile_ranges_[f].back();
-            for (t = range.first; t <= range.second; t++) {
-              auto&& [st, budget_exceeded] = add_result_tile(
-                  dim_num,
-                  per_fragment_memory_,
-                  per_fragment_qc_memory_,
+            const uint64_t t = result_tile_ranges_[f].front();
+            auto&& [st, budget_exceeded] = add_result_tile(
+                dim_num,
+                per_fragment_memory_,
+                per_fragment_qc_memory_,
+                f,
+                t,
+                fragment_metadata_[f]->array_schema());
+            RETURN_NOT_OK(st);
+            tiles_found = true;
+
+            if (*budget_exceeded) {
+              TILEDB_LOG_DEBUG(
+                  *logger_,
+                  "Budget exceeded adding result tiles, fragment {0}, tile "
+                  "{1}",
                   f,
-                  t,
-                  fragment_metadata_[f]->array_schema());
-              RETURN_NOT_OK(st);
-              tiles_found = true;
-
-              if (*budget_exceeded) {
-                logger_->debug(
-                    "Budget exceeded adding result tiles, fragment {0}, tile "
-                    "{1}",
-                    f,
-                    t);
-
-                if (result_tiles_[f].empty())
-                  return logger_->status(Status_SparseGlobalOrderReaderError(
-                      "Cannot load a single tile for fragment, increase memory "
-                      "budget"));
-                return Status::Ok();
-              }
+                  t);
 
-              range.first++;
+              if (result_tiles_[f].empty())
+                return logger_->status(Status_SparseGlobalOrderReaderError(
+                    "Cannot load a single tile for fragment, increase memory "
+                    "budget"));
+              return Status::Ok();
             }
 
-            remove_result_tile_range(f);
+            consume_result_tile(f);
           }
 
           all_tiles_loaded_[f] = true;
@@ -385,7 +406,8 @@ SparseGlobalOrderReader::create_result_tiles() {
             tiles_found = true;
 
             if (*budget_exceeded) {
-              logger_->debug(
+              TILEDB_LOG_DEBUG(
+                  *logger_,
                   "Budget exceeded adding result tiles, fragment {0}, tile {1}",
                   f,
                   t);
@@ -411,10 +433,13 @@ SparseGlobalOrderReader::create_result_tiles() {
     done_adding_result_tiles &= all_tiles_loaded_[f] != 0;
   }
 
-  logger_->debug("Done adding result tiles, num result tiles {0}", num_rt);
+  TILEDB_LOG_DEBUG(
+      *logger_,
+      "Done adding result tiles, num result tiles {0}",
+      num_rt);
 
   if (done_adding_result_tiles) {
-    logger_->debug("All result tiles loaded");
+    TILEDB_LOG_DEBUG(*logger_, "All result tiles loaded");
   }
 
   read_state_.done_adding_result_tiles_ = done_adding_result_tiles;
@@ -452,85 +477,16 @@ SparseGlobalOrderReader::compute_result_cell_slab() {
     return {Status::Ok(), std::nullopt};
   }
 
-  if (array_schema_->cell_order() == Layout::HILBERT) {
+  if (layout_is_curve(array_schema_->cell_order())) {
     return merge_result_cell_slabs(
         num_cells, HilbertCmpReverse(array_schema_->domain()));
   } else {
-    return merge_result_cell_slabs(
-        num_cells, GlobalCmpReverse(array_schema_->domain()));
-  }
-}
-
-template <class T>
-std::tuple<Status, std::optional<bool>>
-SparseGlobalOrderReader::add_next_tile_to_queue(
-    unsigned int frag_idx,
-    uint64_t cell_idx,
-    std::vector<std::list<ResultTileWithBitmap<uint8_t>>::iterator>&
-        result_tiles_it,
-    std::vector<uint8_t>& result_tile_used,
-    std::priority_queue<ResultCoords, std::vector<ResultCoords>, T>& tile_queue,
-    std::mutex& tile_queue_mutex) {
-  bool found = false;
-
-  // Remove the tile from result tiles if it wasn't used at all.
-  if (!result_tile_used[frag_idx]) {
-    auto to_delete = result_tiles_it[frag_idx];
-    to_delete--;
-    remove_result_tile(frag_idx, to_delete);
-  }
-
-  // Try to find a tile.
-  while (!found && result_tiles_it[frag_idx] != result_tiles_[frag_idx].end()) {
-    bool has_bmp = result_tiles_it[frag_idx]->bitmap_.size() > 0;
-    found = !has_bmp;
-    auto tile = &*result_tiles_it[frag_idx];
-
-    // Find a cell that's in the subarray.
-    if (has_bmp) {
-      while (cell_idx < tile->cell_num()) {
-        if (tile->bitmap_.size() == 0 || tile->bitmap_[cell_idx]) {
-          found = true;
-          break;
-        }
-
-        cell_idx++;
-      }
-    }
-
-    // There was more tiles in this fragment, insert it in the queue.
-    if (found) {
-      std::unique_lock<std::mutex> ul(tile_queue_mutex);
-      tile_queue.emplace(tile, cell_idx);
-      result_tiles_it[frag_idx]++;
-    } else {
-      // Remove the tile.
-      auto to_delete = result_tiles_it[frag_idx];
-      result_tiles_it[frag_idx]++;
-      remove_result_tile(frag_idx, to_delete);
-    }
-
-    result_tile_used[frag_idx] = false;
-
-    // Once we move to the next tile, the saved cell index doesn't matter.
-    cell_idx = 0;
-  }
-
-  if (!found) {
-    // Increment the tile index, which should clear all tiles in end_iteration.
-    if (!result_tiles_[frag_idx].empty()) {
-      read_state_.frag_tile_idx_[frag_idx].first++;
-      read_state_.frag_tile_idx_[frag_idx].second = 0;
-    }
-
-    // This fragment has more tiles potentially.
-    if (!all_tiles_loaded_[frag_idx]) {
-      // Return we need more tiles.
-      return {Status::Ok(), true};
-    }
+    auto domain = array_schema_->domain();
+    return with_global_cmp<TypedGlobalCmpReverse>(
+        domain, nullptr, GlobalCmpReverse(domain), [&](const auto& cmp) {
+          return merge_result_cell_slabs(num_cells, cmp);
+        });
   }
-
-  return {Status::Ok(), false};
 }
 
 Status SparseGlobalOrderReader::compute_hilbert_values(
@@ -540,34 +496,41 @@ Status SparseGlobalOrderReader::compute_hilbert_values(
   // For easy reference.
   auto dim_num = array_schema_->dim_num();
 
-  // Create a Hilbet class.
-  Hilbert h(dim_num);
-  auto bits = h.bits();
-  auto max_bucket_val = ((uint64_t)1 << bits) - 1;
+  // Create the curve of the cell order.
+  SpaceFillingCurve curve(array_schema_->cell_order(), dim_num);
 
   // Parallelize on tiles.
   auto status = parallel_for(
       storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
         auto tile = (ResultTileWithBitmap<uint8_t>*)result_tiles[t];
         auto cell_num = tile->cell_num();
-        auto rc = ResultCoords(tile, 0);
-        std::vector<uint64_t> coords(dim_num);
-
         tile->hilbert_values_.resize(cell_num);
-        for (rc.pos_ = 0; rc.pos_ < cell_num; rc.pos_++) {
-          // Process only values in bitmap.
-          if (tile->bitmap_.size() == 0 || tile->bitmap_[rc.pos_]) {
-            // Compute Hilbert number for all dimensions first.
-            for (uint32_t d = 0; d < dim_num; ++d) {
-              auto dim = array_schema_->dimension(d);
-              coords[d] = hilbert_order::map_to_uint64(
-                  *dim, rc, d, bits, max_bucket_val);
-            }
 
-            // Now we are ready to get the final number.
-            tile->hilbert_values_[rc.pos_] = h.coords_to_hilbert(&coords[0]);
+        // Process only values in bitmap, in batches of cells.
+        std::vector<uint64_t> cell_pos;
+        if (tile->bitmap_.size() != 0) {
+          for (uint64_t c = 0; c < cell_num; c++) {
+            if (tile->bitmap_[c])
+              cell_pos.push_back(c);
           }
         }
+        const bool all_cells = tile->bitmap_.size() == 0;
+        auto pos = [&](uint64_t i) { return all_cells ? i : cell_pos[i]; };
+
+        auto rc = ResultCoords(tile, 0);
+        hilbert_order::calculate_values(
+            curve,
+            dim_num,
+            0,
+            all_cells ? cell_num : cell_pos.size(),
+            [&](uint32_t d, uint64_t i, int bits, uint64_t max_bucket_val) {
+              rc.pos_ = pos(i);
+              return hilbert_order::map_to_uint64(
+                  *array_schema_->dimension(d), rc, d, bits, max_bucket_val);
+            },
+            [&](uint64_t i, uint64_t value) {
+              tile->hilbert_values_[pos(i)] = value;
+            });
 
         return Status::Ok();
       });
@@ -577,62 +540,121 @@ Status SparseGlobalOrderReader::compute_hilbert_values(
 }
 
 template <class T>
-std::tuple<Status, std::optional<std::vector<ResultCellSlab>>>
-SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
-  auto timer_se = stats_->start_timer("merge_result_cell_slabs");
-  std::vector<ResultCellSlab> result_cell_slabs;
+SparseGlobalOrderReader::MergeCursor SparseGlobalOrderReader::find_merge_cursor(
+    const T& cmp,
+    const std::vector<TileListIt>& tiles,
+    const MergeCursor& begin,
+    const MergeCursor& end,
+    const ResultCoords& key,
+    bool after_key) const {
+  // The cells before the one to find. `cmp(a, b)` is true if `a` does not
+  // precede `b`.
+  auto before = [&](const ResultCoords& rc) {
+    return after_key ? cmp(key, rc) : !cmp(rc, key);
+  };
+
+  // Find the first tile whose last cell is not before the key, as the tiles
+  // of a fragment are in global order.
+  uint64_t left = begin.first;
+  uint64_t right = std::min<uint64_t>(end.first + 1, tiles.size());
+  while (left < right) {
+    auto mid = left + (right - left) / 2;
+    auto tile = &*tiles[mid];
+    auto result_num = tile->result_num_between_pos(0, tile->cell_num());
+    if (result_num == 0 ||
+        before(ResultCoords(tile, result_pos(tile, 0, result_num))))
+      left = mid + 1;
+    else
+      right = mid;
+  }
+
+  // Run a bisection search on the cells in the bitmap of that tile.
+  for (auto t = left; t < tiles.size() && MergeCursor(t, 0) < end; t++) {
+    auto tile = &*tiles[t];
+    const uint64_t from = t == begin.first ? begin.second : 0;
+    const uint64_t to = t == end.first ? end.second : tile->cell_num();
+    if (from >= to)
+      continue;
+
+    const auto result_num = tile->result_num_between_pos(from, to);
+    uint64_t first = 0;
+    uint64_t last = result_num;
+    while (first < last) {
+      auto mid = first + (last - first) / 2;
+      if (before(ResultCoords(tile, result_pos(tile, from, mid + 1))))
+        first = mid + 1;
+      else
+        last = mid;
+    }
 
-  // TODO Parallelize.
+    if (first < result_num)
+      return {t, result_pos(tile, from, first + 1)};
+  }
+
+  return end;
+}
 
+template <class T>
+uint64_t SparseGlobalOrderReader::merge_partition(
+    const T& cmp,
+    const std::vector<std::vector<TileListIt>>& frag_tiles,
+    const std::vector<MergeCursor>& ends,
+    uint64_t num_cells,
+    std::vector<MergeCursor>& cursors,
+    std::vector<ResultCellSlab>& result_cell_slabs) {
   // For easy reference.
   auto allows_dups = array_schema_->allows_dups();
+  const auto max_cells = num_cells;
 
   // A tile min heap, contains one ResultCoords per fragment.
   std::vector<ResultCoords> container;
-  container.reserve(result_tiles_.size());
+  container.reserve(frag_tiles.size());
   std::priority_queue<ResultCoords, std::vector<ResultCoords>, T> tile_queue(
       cmp, std::move(container));
 
-  std::mutex tile_queue_mutex;
+  // Puts the first cell in the bitmap at or after the cursor of a fragment
+  // in the queue, if it is in the partition.
+  auto add_next_tile_to_queue = [&](unsigned f) {
+    auto& cursor = cursors[f];
+    while (cursor < ends[f]) {
+      auto tile = &*frag_tiles[f][cursor.first];
+      const uint64_t end_pos =
+          cursor.first == ends[f].first ? ends[f].second : tile->cell_num();
+      if (cursor.second < end_pos &&
+          tile->result_num_between_pos(cursor.second, end_pos) != 0) {
+        cursor.second = result_pos(tile, cursor.second, 1);
+        tile_queue.emplace(tile, cursor.second);
+        return;
+      }
 
-  // If any fragments needs to load more tiles.
-  bool need_more_tiles = false;
+      cursor = {cursor.first + 1, 0};
+    }
 
-  // Tile iterators, per fragments.
-  std::vector<std::list<ResultTileWithBitmap<uint8_t>>::iterator>
-      result_tiles_it(result_tiles_.size());
+    cursor = ends[f];
+  };
 
-  // Boolean per fragment that keeps track of when a tile is used.
-  std::vector<uint8_t> result_tile_used(result_tiles_.size(), true);
+  // Puts the cell after `rc` in the queue, if it is in the partition.
+  auto add_next_cell_to_queue = [&](ResultCoords& rc) {
+    const auto f = rc.tile_->frag_idx();
+    auto& cursor = cursors[f];
+    if (!rc.next()) {
+      // Done with this tile, fetch another.
+      cursor = {cursor.first + 1, 0};
+      add_next_tile_to_queue(f);
+    } else {
+      cursor.second = rc.pos_;
+      if (cursor < ends[f])
+        tile_queue.emplace(std::move(rc));
+    }
+  };
 
   // For all fragments, get the first tile.
-  auto status = parallel_for(
-      storage_manager_->compute_tp(), 0, result_tiles_.size(), [&](uint64_t f) {
-        if (result_tiles_[f].size() > 0) {
-          // Initialize the iterator for this fragment.
-          result_tiles_it[f] = result_tiles_[f].begin();
-
-          // Get the cell index we were processing.
-          auto cell_idx = read_state_.frag_tile_idx_[f].second;
-
-          // Add the tile to the queue.
-          auto&& [st, more_tiles] = add_next_tile_to_queue(
-              f,
-              cell_idx,
-              result_tiles_it,
-              result_tile_used,
-              tile_queue,
-              tile_queue_mutex);
-          RETURN_NOT_OK(st);
-          need_more_tiles = *more_tiles;
-        }
-
-        return Status::Ok();
-      });
-  RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
+  for (unsigned f = 0; f < frag_tiles.size(); f++) {
+    add_next_tile_to_queue(f);
+  }
 
   // Process all elements.
-  while (!tile_queue.empty() && !need_more_tiles && num_cells > 0) {
+  while (!tile_queue.empty() && num_cells > 0) {
     auto to_process = tile_queue.top();
     tile_queue.pop();
 
@@ -650,52 +672,38 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
 
       // If we allow duplicates, create one slab for all the dups.
       if (allows_dups) {
-        result_tile_used[next_tile.tile_->frag_idx()] = true;
         result_cell_slabs.emplace_back(next_tile.tile_, next_tile.pos_, 1);
         num_cells--;
-        read_state_.frag_tile_idx_[next_tile.tile_->frag_idx()] =
-            std::pair<uint64_t, uint64_t>(
-                next_tile.tile_->tile_idx(), next_tile.pos_);
       }
 
       // Put the next cell in the queue.
-      if (!next_tile.next()) {
-        // Done with this tile, fetch another.
-        auto&& [st, more_tiles] = add_next_tile_to_queue(
-            next_tile.tile_->frag_idx(),
-            0,
-            result_tiles_it,
-            result_tile_used,
-            tile_queue,
-            tile_queue_mutex);
-        RETURN_NOT_OK_TUPLE(st, std::nullopt);
-        need_more_tiles = *more_tiles;
-      } else {
-        tile_queue.emplace(std::move(next_tile));
-      }
+      add_next_cell_to_queue(next_tile);
     }
 
     if (num_cells == 0) {
       break;
     }
 
-    // Get the tile and flag it as used.
+    // Get the tile.
     auto tile = (ResultTileWithBitmap<uint8_t>*)to_process.tile_;
     auto has_bmp = tile->bitmap_.size() > 0;
-    result_tile_used[tile->frag_idx()] = true;
 
     // Find how many cells to process using the top of the queue.
     // Temp result coord used to find the last position.
     ResultCoords temp_rc = to_process;
 
     // Check the top of the queue against last possible cell in the current
-    // tile.
+    // tile, or of the partition.
+    const auto& end = ends[tile->frag_idx()];
+    const auto last_pos = cursors[tile->frag_idx()].first == end.first ?
+                              end.second - 1 :
+                              tile->cell_num() - 1;
     if (!has_bmp) {
-      temp_rc.pos_ =
-          std::min(tile->cell_num() - 1, to_process.pos_ + num_cells - 1);
+      temp_rc.pos_ = std::min(last_pos, to_process.pos_ + num_cells - 1);
     } else {
-      temp_rc.pos_ =
-          tile->pos_with_given_result_sum(to_process.pos_, num_cells);
+      temp_rc.pos_ = std::min(
+          last_pos,
+          tile->pos_with_given_result_sum(to_process.pos_, num_cells));
     }
 
     // If there is more than one fragment and we can't add the whole tile,
@@ -704,9 +712,21 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
     if (!tile_queue.empty()) {
       auto& next_tile = tile_queue.top();
       if (cmp(temp_rc, next_tile)) {
-        // Run a bisection seach on to find the last cell.
+        // With many interleaved fragments, the runs are usually short, so
+        // first gallop from the current cell to bound the last cell, then run
+        // a bisection search in that bound to find it.
         uint64_t left = to_process.pos_;
         uint64_t right = temp_rc.pos_;
+        for (uint64_t step = 1; left + step < right; step *= 2) {
+          temp_rc.pos_ = left + step;
+          if (cmp(temp_rc, next_tile)) {
+            right = temp_rc.pos_;
+            break;
+          }
+
+          left = temp_rc.pos_;
+        }
+
         while (left != right - 1) {
           // Check against mid.
           temp_rc.pos_ = left + (right - left) / 2;
@@ -724,14 +744,11 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
 
     // Generate the result cell slabs.
     auto start = to_process.pos_;
-    const auto tile_idx = tile->tile_idx();
-    auto& frag_idx = read_state_.frag_tile_idx_[tile->frag_idx()];
 
     // If no bitmap is set, add all cells.
     if (!has_bmp) {
       auto length = std::min(temp_rc.pos_ - to_process.pos_ + 1, num_cells);
       result_cell_slabs.emplace_back(tile, start, length);
-      frag_idx = std::pair<uint64_t, uint64_t>(tile_idx, start + length);
       num_cells -= length;
     } else {
       // Process all cells, when there is a "hole" in the cell contiguity,
@@ -741,7 +758,6 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
         if (!tile->bitmap_[c]) {
           if (length != 0) {
             result_cell_slabs.emplace_back(tile, start, length);
-            frag_idx = std::pair<uint64_t, uint64_t>(tile_idx, start + length);
             num_cells -= length;
             length = 0;
           }
@@ -758,7 +774,6 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
       // Add the last cell slab.
       if (length != 0) {
         result_cell_slabs.emplace_back(tile, start, length);
-        frag_idx = std::pair<uint64_t, uint64_t>(tile_idx, start + length - 1);
         num_cells -= length;
       }
     }
@@ -767,28 +782,229 @@ SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
     to_process.pos_ = temp_rc.pos_;
 
     // Put the next cell in the queue.
-    if (!to_process.next()) {
-      // Done with this tile, fetch another.
-      auto&& [st, more_tiles] = add_next_tile_to_queue(
-          tile->frag_idx(),
-          0,
-          result_tiles_it,
-          result_tile_used,
-          tile_queue,
-          tile_queue_mutex);
-      RETURN_NOT_OK_TUPLE(st, std::nullopt);
-      need_more_tiles = *more_tiles;
-    } else {
-      // Put the next cell on the queue to be resorted.
-      read_state_.frag_tile_idx_[tile->frag_idx()] =
-          std::pair<uint64_t, uint64_t>(tile->tile_idx(), to_process.pos_);
-      tile_queue.emplace(std::move(to_process));
+    add_next_cell_to_queue(to_process);
+  }
+
+  return max_cells - num_cells;
+}
+
+template <class T>
+std::tuple<Status, std::optional<std::vector<ResultCellSlab>>>
+SparseGlobalOrderReader::merge_result_cell_slabs(uint64_t num_cells, T cmp) {
+  auto timer_se = stats_->start_timer("merge_result_cell_slabs");
+  set_progress_phase(QueryPhase::PROCESS_TILES);
+
+  // For easy reference.
+  auto fragment_num = result_tiles_.size();
+  auto compute_tp = storage_manager_->compute_tp();
+
+  // The result tiles per fragment, and the cursors the merge starts and ends
+  // at, per fragment.
+  std::vector<std::vector<TileListIt>> frag_tiles(fragment_num);
+  std::vector<MergeCursor> starts(fragment_num);
+  std::vector<MergeCursor> ends(fragment_num);
+  for (unsigned f = 0; f < fragment_num; f++) {
+    for (auto it = result_tiles_[f].begin(); it != result_tiles_[f].end();
+         ++it) {
+      frag_tiles[f].emplace_back(it);
+    }
+
+    // Start at the cell we were processing.
+    if (!frag_tiles[f].empty()) {
+      starts[f] = {0, read_state_.frag_tile_idx_[f].second};
+      if (starts[f].second >= frag_tiles[f][0]->cell_num())
+        starts[f] = {1, 0};
     }
+    ends[f] = {frag_tiles[f].size(), 0};
+  }
+
+  // The cells of the tiles a fragment has not loaded yet come after its last
+  // loaded cell, so the merge stops after the smallest of those cells. If a
+  // fragment has no cells left to merge, it needs more tiles first.
+  std::optional<ResultCoords> last_cell;
+  bool need_more_tiles = false;
+  for (unsigned f = 0; f < fragment_num && !need_more_tiles; f++) {
+    if (all_tiles_loaded_[f] || frag_tiles[f].empty()) {
+      continue;
+    }
+
+    need_more_tiles = true;
+    for (auto t = frag_tiles[f].size(); t > starts[f].first; t--) {
+      auto tile = &*frag_tiles[f][t - 1];
+      const uint64_t from = t - 1 == starts[f].first ? starts[f].second : 0;
+      auto result_num = tile->result_num_between_pos(from, tile->cell_num());
+      if (result_num != 0) {
+        ResultCoords rc(tile, result_pos(tile, from, result_num));
+        if (!last_cell.has_value() || !cmp(rc, *last_cell))
+          last_cell = rc;
+        need_more_tiles = false;
+        break;
+      }
+    }
+  }
+
+  if (need_more_tiles) {
+    ends = starts;
+  } else if (last_cell.has_value()) {
+    auto status = parallel_for(compute_tp, 0, fragment_num, [&](uint64_t f) {
+      ends[f] = find_merge_cursor(
+          cmp, frag_tiles[f], starts[f], ends[f], *last_cell, true);
+      return Status::Ok();
+    });
+    RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
   }
 
+  // Use the first cell of the tiles as splitters for the partitions, each
+  // holding about the same number of cells up to what the user buffers can
+  // hold.
+  std::vector<std::vector<MergeCursor>> partition_starts{starts};
+  const uint64_t thread_num = compute_tp->concurrency_level();
+  if (thread_num > 1 && fragment_num > 1) {
+    std::vector<std::pair<ResultCoords, uint64_t>> tile_starts;
+    uint64_t total_cells = 0;
+    for (unsigned f = 0; f < fragment_num; f++) {
+      for (auto t = starts[f].first;
+           t < frag_tiles[f].size() && MergeCursor(t, 0) < ends[f];
+           t++) {
+        auto tile = &*frag_tiles[f][t];
+        const uint64_t from = t == starts[f].first ? starts[f].second : 0;
+        const uint64_t to =
+            t == ends[f].first ? ends[f].second : tile->cell_num();
+        if (from >= to)
+          continue;
+
+        auto result_num = tile->result_num_between_pos(from, to);
+        if (result_num != 0) {
+          tile_starts.emplace_back(
+              ResultCoords(tile, result_pos(tile, from, 1)), result_num);
+          total_cells += result_num;
+        }
+      }
+    }
+
+    const auto merge_cells = std::min(total_cells, num_cells);
+    const auto partition_num =
+        std::min(thread_num, merge_cells / min_merge_partition_cells);
+    if (partition_num > 1) {
+      std::sort(
+          tile_starts.begin(),
+          tile_starts.end(),
+          [&](const auto& a, const auto& b) { return !cmp(a.first, b.first); });
+
+      std::vector<ResultCoords> splitters;
+      uint64_t cells = 0;
+      for (const auto& [rc, result_num] : tile_starts) {
+        if (cells >= (splitters.size() + 1) * merge_cells / partition_num &&
+            (splitters.empty() || !cmp(splitters.back(), rc))) {
+          splitters.emplace_back(rc);
+          if (splitters.size() == partition_num - 1)
+            break;
+        }
+
+        cells += result_num;
+      }
+
+      partition_starts.resize(splitters.size() + 1);
+      auto status = parallel_for(
+          compute_tp, 0, splitters.size(), [&](uint64_t s) {
+            auto& cursors = partition_starts[s + 1];
+            cursors.resize(fragment_num);
+            for (unsigned f = 0; f < fragment_num; f++) {
+              cursors[f] = find_merge_cursor(
+                  cmp, frag_tiles[f], starts[f], ends[f], splitters[s], false);
+            }
+
+            return Status::Ok();
+          });
+      RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
+    }
+  }
+
+  // Merge the partitions in parallel.
+  const auto partition_num = partition_starts.size();
+  stats_->add_counter("merge_partition_num", partition_num);
+  auto partition_ends = [&](uint64_t p) -> const std::vector<MergeCursor>& {
+    return p + 1 < partition_num ? partition_starts[p + 1] : ends;
+  };
+  std::vector<std::vector<MergeCursor>> cursors(partition_starts);
+  std::vector<std::vector<ResultCellSlab>> partition_slabs(partition_num);
+  std::vector<uint64_t> partition_cells(partition_num);
+  auto status = parallel_for(compute_tp, 0, partition_num, [&](uint64_t p) {
+    partition_cells[p] = merge_partition(
+        cmp,
+        frag_tiles,
+        partition_ends(p),
+        num_cells,
+        cursors[p],
+        partition_slabs[p]);
+    return Status::Ok();
+  });
+  RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
+
+  // Concatenate the partitions until the user buffers are full.
+  std::vector<ResultCellSlab> result_cell_slabs;
+  uint64_t p = 0;
+  for (; p < partition_num; p++) {
+    if (partition_cells[p] > num_cells) {
+      // Merge the partition again up to the cells that fit, to know where
+      // each fragment stops.
+      cursors[p] = partition_starts[p];
+      partition_slabs[p].clear();
+      partition_cells[p] = merge_partition(
+          cmp,
+          frag_tiles,
+          partition_ends(p),
+          num_cells,
+          cursors[p],
+          partition_slabs[p]);
+    }
+
+    result_cell_slabs.insert(
+        result_cell_slabs.end(),
+        partition_slabs[p].begin(),
+        partition_slabs[p].end());
+    num_cells -= partition_cells[p];
+    if (num_cells == 0)
+      break;
+  }
+
+  // Save where each fragment stops, and remove the tiles the merge went past
+  // without using them.
+  const auto& merge_ends = cursors[std::min(p, partition_num - 1)];
+  std::unordered_set<ResultTile*> used_tiles;
+  for (const auto& rcs : result_cell_slabs) {
+    used_tiles.emplace(rcs.tile_);
+  }
+
+  status = parallel_for(compute_tp, 0, fragment_num, [&](uint64_t f) {
+    if (frag_tiles[f].empty()) {
+      return Status::Ok();
+    }
+
+    const auto& cursor = merge_ends[f];
+    if (cursor.first < frag_tiles[f].size()) {
+      read_state_.frag_tile_idx_[f] = std::pair<uint64_t, uint64_t>(
+          frag_tiles[f][cursor.first]->tile_idx(), cursor.second);
+    } else {
+      read_state_.frag_tile_idx_[f] = std::pair<uint64_t, uint64_t>(
+          frag_tiles[f].back()->tile_idx() + 1, 0);
+    }
+
+    const auto passed = std::min<uint64_t>(cursor.first, frag_tiles[f].size());
+    for (uint64_t t = 0; t < passed; t++) {
+      if (used_tiles.count(&*frag_tiles[f][t]) == 0) {
+        RETURN_NOT_OK(remove_result_tile(f, frag_tiles[f][t]));
+      }
+    }
+
+    return Status::Ok();
+  });
+  RETURN_NOT_OK_ELSE_TUPLE(status, logger_->status(status), std::nullopt);
+
   buffers_full_ = num_cells == 0;
 
-  logger_->debug(
+  TILEDB_LOG_DEBUG(
+      *logger_,
       "Done merging result cell slabs, num slabs {0}, buffers full {1}",
       result_cell_slabs.size(),
       buffers_full_);
@@ -1214,6 +1430,7 @@ Status SparseGlobalOrderReader::process_slabs(
     std::vector<std::string>& names,
     std::vector<ResultCellSlab>& result_cell_slabs) {
   auto timer_se = stats_->start_timer("process_slabs");
+  set_progress_phase(QueryPhase::COPY_RESULTS);
 
   // Compute parallelization parameters.
   uint64_t num_range_threads = 1;
@@ -1360,7 +1577,7 @@ Status SparseGlobalOrderReader::process_slabs(
     }
   }
 
-  logger_->debug("Done copying tiles");
+  TILEDB_LOG_DEBUG(*logger_, "Done copying tiles");
   return Status::Ok();
 }
 
@@ -1376,7 +1593,7 @@ Status SparseGlobalOrderReader::remove_result_tile(
   auto tiles_size_qc = tiles_sizes->second;
 
   // Account for hilbert data.
-  if (array_schema_->cell_order() == Layout::HILBERT) {
+  if (layout_is_curve(array_schema_->cell_order())) {
     tiles_size += fragment_metadata_[frag_idx]->cell_num(rt->tile_idx()) *
                   sizeof(uint64_t);
   }
@@ -1390,9 +1607,12 @@ Status SparseGlobalOrderReader::remove_result_tile(
     std::unique_lock<std::mutex> lck(mem_budget_mtx_);
     memory_used_for_coords_total_ -= tiles_size + sizeof(ResultTile);
     memory_used_qc_tiles_total_ -= tiles_size_qc;
+    memory_used_bitmaps_total_ -=
+        get_tile_bitmap_size<uint8_t>(frag_idx, rt->tile_idx());
   }
 
-  // Delete the tile.
+  // Delete the tile, recycling its buffers.
+  rt->recycle_tiles(tile_buffer_pool_.get());
   result_tiles_[frag_idx].erase(rt);
 
   return Status::Ok();
@@ -1425,7 +1645,13 @@ Status SparseGlobalOrderReader::end_iteration() {
     num_rt += result_tiles_[f].size();
   }
 
-  logger_->debug("Done with iteration, num result tiles {1}", num_rt);
+  TILEDB_LOG_DEBUG(
+      *logger_,
+      "Done with iteration, num result tiles {0}",
+      num_rt);
+
+  memory_used_attribute_tiles_ = 0;
+  report_memory_usage();
 
   array_memory_tracker_->set_budget(std::numeric_limits<uint64_t>::max());
   return Status::Ok();
@@ -132,7 +132,26 @@ class SparseGlobalOrderReader : public SparseIndexReaderBase,
   /** Resets the reader object. */
   void reset();
 
+  /** Prepares the reader to run again over a new subarray. */
+  Status rebind();
+
+  /** Sets the progress to update as the query is processed. */
+  void set_progress(QueryProgress* progress);
+
  private:
+  /* ********************************* */
+  /*      PRIVATE TYPE DEFINITIONS     */
+  /* ********************************* */
+
+  /** Iterator in the list of result tiles of a fragment. */
+  typedef std::list<ResultTileWithBitmap<uint8_t>>::iterator TileListIt;
+
+  /**
+   * Position of a cell in the loaded result tiles of a fragment, as the
+   * index of its tile in the fragment's list and its position in the tile.
+   */
+  typedef std::pair<uint64_t, uint64_t> MergeCursor;
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -195,28 +214,50 @@ class SparseGlobalOrderReader : public SparseIndexReaderBase,
   compute_result_cell_slab();
 
   /**
-   * Add a new tile to the queue of tiles currently being processed
-   * for a specific fragment.
+   * Finds the first cell in the bitmap of a fragment's result tiles, between
+   * two cursors, that does not precede a key in the global order.
    *
-   * @param frag_idx Fragment index.
-   * @param cell_idx Cell index.
-   * @param result_tiles_it Iterator, per frag, in the list of retult tiles.
-   * @param result_tile_used Boolean, per frag, to know if a tile was used.
-   * @param tile_queue Queue of one result coords, per fragment, sorted.
-   * @param tile_queue_mutex Protects tile_queue.
+   * @param cmp Comparator used to merge cells.
+   * @param tiles The result tiles of the fragment.
+   * @param begin Cursor to start the search at.
+   * @param end Cursor to end the search at, returned if no cell is found.
+   * @param key The key to search.
+   * @param after_key If true, also skips the cells equal to the key.
    *
-   * @return Status, more_tiles.
+   * @return The cursor of the cell.
    */
   template <class T>
-  std::tuple<Status, std::optional<bool>> add_next_tile_to_queue(
-      unsigned int frag_idx,
-      uint64_t cell_idx,
-      std::vector<std::list<ResultTileWithBitmap<uint8_t>>::iterator>&
-          result_tiles_it,
-      std::vector<uint8_t>& result_tile_used,
-      std::priority_queue<ResultCoords, std::vector<ResultCoords>, T>&
-          tile_queue,
-      std::mutex& tile_queue_mutex);
+  MergeCursor find_merge_cursor(
+      const T& cmp,
+      const std::vector<TileListIt>& tiles,
+      const MergeCursor& begin,
+      const MergeCursor& end,
+      const ResultCoords& key,
+      bool after_key) const;
+
+  /**
+   * Merges the cells of a partition of the global order, between a start
+   * and an end cursor per fragment. It does not update the read state, so
+   * that partitions can be merged in parallel.
+   *
+   * @param cmp Comparator used to merge cells.
+   * @param frag_tiles The result tiles, per fragment.
+   * @param ends The end cursors of the partition, per fragment.
+   * @param num_cells Maximum number of cells to merge.
+   * @param cursors The start cursors of the partition, per fragment. On
+   *     return, the cursors of the first cells that were not merged.
+   * @param result_cell_slabs The merged result cell slabs.
+   *
+   * @return The number of cells merged.
+   */
+  template <class T>
+  uint64_t merge_partition(
+      const T& cmp,
+      const std::vector<std::vector<TileListIt>>& frag_tiles,
+      const std::vector<MergeCursor>& ends,
+      uint64_t num_cells,
+      std::vector<MergeCursor>& cursors,
+      std::vector<ResultCellSlab>& result_cell_slabs);
 
   /**
    * Computes a tile's Hilbert values for a tile.
@@ -228,7 +269,9 @@ class SparseGlobalOrderReader : public SparseIndexReaderBase,
   Status compute_hilbert_values(std::vector<ResultTile*>& result_tiles);
 
   /**
-   * Compute the result cell slabs once tiles are loaded.
+   * Compute the result cell slabs once tiles are loaded. The loaded cells
+   * are split in partitions of the global order, using the first cells of
+   * the tiles as splitters, and the partitions are merged in parallel.
    *
    * @param num_cells Number of cells that can be copied in the user buffer.
    * @param cmp Comparator used to merge cells.
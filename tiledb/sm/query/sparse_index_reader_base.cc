@@ -33,6 +33,7 @@
 #include "tiledb/sm/query/sparse_index_reader_base.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/common/memory_tracker.h"
+#include "tiledb/common/thread_pool/task_graph.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/filesystem/vfs.h"
@@ -41,14 +42,50 @@
 #include "tiledb/sm/misc/resource_pool.h"
 #include "tiledb/sm/query/iquery_strategy.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/strategy_base.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/subarray/subarray.h"
 
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
 #include <numeric>
+#include <string_view>
+#include <type_traits>
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Mixes the bits of `x`, as the finalizer of SplitMix64. */
+inline uint64_t mix_bits(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/**
+ * Returns the hash of the cells of a tile, from which a cell is sampled if
+ * `mix_bits(tile_hash + cell_pos)` is below the sample threshold.
+ */
+inline uint64_t sample_tile_hash(uint64_t seed, unsigned f, uint64_t t) {
+  return mix_bits(mix_bits(seed + f) + t);
+}
+
+/** Returns the hash threshold under which a cell is sampled. */
+inline uint64_t sample_threshold(double fraction) {
+  if (fraction >= 1.0)
+    return std::numeric_limits<uint64_t>::max();
+
+  return static_cast<uint64_t>(fraction * 18446744073709551616.0);
+}
+
+}  // namespace
+
 /* ****************************** */
 /*          CONSTRUCTORS          */
 /* ****************************** */
@@ -75,18 +112,27 @@ SparseIndexReaderBase::SparseIndexReaderBase(
           condition)
     , initial_data_loaded_(false)
     , memory_budget_(0)
+    , memory_budget_reserved_(0)
     , array_memory_tracker_(array->memory_tracker())
     , memory_used_for_coords_total_(0)
     , memory_used_qc_tiles_total_(0)
     , memory_used_result_tile_ranges_(0)
+    , memory_used_bitmaps_total_(0)
+    , memory_used_attribute_tiles_(0)
     , memory_budget_ratio_coords_(0.5)
     , memory_budget_ratio_query_condition_(0.25)
     , memory_budget_ratio_tile_ranges_(0.1)
     , memory_budget_ratio_array_data_(0.1)
+    , top_k_selected_(false)
     , buffers_full_(false) {
   read_state_.done_adding_result_tiles_ = false;
 }
 
+SparseIndexReaderBase::~SparseIndexReaderBase() {
+  if (memory_budget_reserved_ > 0)
+    storage_manager_->governor()->release(memory_budget_reserved_);
+}
+
 /* ****************************** */
 /*        PROTECTED METHODS       */
 /* ****************************** */
@@ -109,7 +155,7 @@ Status SparseIndexReaderBase::init() {
   if (array_schema_ == nullptr)
     return logger_->status(Status_ReaderError(
         "Cannot initialize sparse global order reader; Array schema not set"));
-  if (buffers_.empty())
+  if (buffers_.empty() && !has_aggregates())
     return logger_->status(Status_ReaderError(
         "Cannot initialize sparse global order reader; Buffers not set"));
 
@@ -117,9 +163,9 @@ Status SparseIndexReaderBase::init() {
   RETURN_NOT_OK(check_subarray());
 
   // Load offset configuration options.
-  bool found = false;
-  offsets_format_mode_ = config_.get("sm.var_offsets.mode", &found);
-  assert(found);
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  offsets_format_mode_ = config->var_offsets_mode;
   if (offsets_format_mode_ != "bytes" && offsets_format_mode_ != "elements") {
     return logger_->status(
         Status_ReaderError("Cannot initialize reader; Unsupported offsets "
@@ -127,11 +173,8 @@ Status SparseIndexReaderBase::init() {
   }
   elements_mode_ = offsets_format_mode_ == "elements";
 
-  RETURN_NOT_OK(config_.get<bool>(
-      "sm.var_offsets.extra_element", &offsets_extra_element_, &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<uint32_t>(
-      "sm.var_offsets.bitsize", &offsets_bitsize_, &found));
+  offsets_extra_element_ = config->var_offsets_extra_element;
+  offsets_bitsize_ = config->var_offsets_bitsize;
   if (offsets_bitsize_ != 32 && offsets_bitsize_ != 64) {
     return logger_->status(
         Status_ReaderError("Cannot initialize reader; "
@@ -144,6 +187,22 @@ Status SparseIndexReaderBase::init() {
   return Status::Ok();
 }
 
+Status SparseIndexReaderBase::rebind() {
+  RETURN_NOT_OK(check_subarray());
+  RETURN_NOT_OK(check_validity_buffer_sizes());
+
+  // The initial data depends on the subarray. The tile offsets it loads
+  // stay in the fragment metadata, so loading it again is cheap.
+  initial_data_loaded_ = false;
+  result_tile_ranges_.clear();
+  memory_used_result_tile_ranges_ = 0;
+  top_k_selected_ = false;
+  top_k_cells_.clear();
+  buffers_full_ = false;
+
+  return Status::Ok();
+}
+
 uint64_t SparseIndexReaderBase::cells_copied(
     const std::vector<std::string>& names) {
   auto& last_name = names.back();
@@ -174,6 +233,9 @@ SparseIndexReaderBase::get_coord_tiles_size(
             fragment_metadata_[f]->tile_var_size(dim_names_[d], t);
         RETURN_NOT_OK_TUPLE(st, std::nullopt);
         tiles_size += *temp;
+
+        // The string coordinate prefixes take as much as the offsets.
+        tiles_size += fragment_metadata_[f]->tile_size(dim_names_[d], t);
       }
     }
   }
@@ -182,8 +244,7 @@ SparseIndexReaderBase::get_coord_tiles_size(
   tiles_size += sizeof(ResultTileWithBitmap<BitmapType>);
 
   // Add the tile bitmap size if there is a subarray.
-  if (subarray_.is_set())
-    tiles_size += fragment_metadata_[f]->cell_num(t) * sizeof(BitmapType);
+  tiles_size += get_tile_bitmap_size<BitmapType>(f, t);
 
   // Compute query condition tile sizes.
   uint64_t tiles_size_qc = 0;
@@ -199,6 +260,43 @@ SparseIndexReaderBase::get_coord_tiles_size(
   return {Status::Ok(), std::make_pair(tiles_size, tiles_size_qc)};
 }
 
+template <class BitmapType>
+uint64_t SparseIndexReaderBase::get_tile_bitmap_size(unsigned f, uint64_t t) {
+  if (!subarray_.is_set())
+    return 0;
+
+  const auto cell_num = fragment_metadata_[f]->cell_num(t);
+  if constexpr (std::is_same<BitmapType, uint8_t>::value)
+    return PackedBitmap::alloc_size(cell_num);
+  else
+    return cell_num * sizeof(BitmapType);
+}
+
+void SparseIndexReaderBase::report_memory_usage() {
+  uint64_t coord_tiles, bitmaps, qc_tiles;
+  {
+    std::unique_lock<std::mutex> lck(mem_budget_mtx_);
+    coord_tiles = memory_used_for_coords_total_ - memory_used_bitmaps_total_;
+    bitmaps = memory_used_bitmaps_total_;
+    qc_tiles = memory_used_qc_tiles_total_;
+  }
+  const uint64_t array_data = array_memory_tracker_->get_memory_usage();
+
+  stats_->set_memory_usage("coord_tiles", coord_tiles);
+  stats_->set_memory_usage("bitmaps", bitmaps);
+  stats_->set_memory_usage("query_condition_tiles", qc_tiles);
+  stats_->set_memory_usage("attribute_tiles", memory_used_attribute_tiles_);
+  stats_->set_memory_usage("tile_overlap", memory_used_result_tile_ranges_);
+  stats_->set_memory_usage("array_data", array_data);
+  stats_->set_memory_usage(
+      "total",
+      coord_tiles + bitmaps + qc_tiles + memory_used_attribute_tiles_ +
+          memory_used_result_tile_ranges_ + array_data);
+
+  // The tile caches are shared by the queries of the context.
+  stats_->set_memory_usage("tile_cache", storage_manager_->tile_cache_size());
+}
+
 Status SparseIndexReaderBase::load_initial_data() {
   if (initial_data_loaded_)
     return Status::Ok();
@@ -207,11 +305,10 @@ Status SparseIndexReaderBase::load_initial_data() {
   read_state_.done_adding_result_tiles_ = false;
 
   // Make a list of dim/attr that will be loaded for query condition.
-  if (!initial_data_loaded_) {
-    if (!condition_.empty()) {
-      for (auto& name : condition_.field_names()) {
-        qc_loaded_names_.emplace_back(name);
-      }
+  qc_loaded_names_.clear();
+  if (!condition_.empty()) {
+    for (auto& name : condition_.field_names()) {
+      qc_loaded_names_.emplace_back(name);
     }
   }
 
@@ -238,9 +335,8 @@ Status SparseIndexReaderBase::load_initial_data() {
     RETURN_NOT_OK(subarray_.precompute_all_ranges_tile_overlap(
         storage_manager_->compute_tp(), &result_tile_ranges_));
 
-    for (auto frag_result_tile_ranges : result_tile_ranges_) {
-      memory_used_result_tile_ranges_ += frag_result_tile_ranges.size() *
-                                         sizeof(std::pair<uint64_t, uint64_t>);
+    for (const auto& tile_ranges : result_tile_ranges_) {
+      memory_used_result_tile_ranges_ += tile_ranges.memory_usage();
     }
 
     if (memory_used_result_tile_ranges_ >
@@ -253,6 +349,13 @@ Status SparseIndexReaderBase::load_initial_data() {
   array_memory_tracker_->set_budget(
       memory_budget_ * memory_budget_ratio_array_data_);
 
+  // Recycle the tile buffers across iterations, and across the executions
+  // of a prepared query. The idle buffers are bounded by the coordinate
+  // tiles budget.
+  if (tile_buffer_pool_ == nullptr)
+    tile_buffer_pool_ = tdb_unique_ptr<TileBufferPool>(tdb_new(
+        TileBufferPool, memory_budget_ * memory_budget_ratio_coords_));
+
   // Preload zipped coordinate tile offsets. Note that this will
   // ignore fragments with a version >= 5.
   std::vector<std::string> zipped_coords_names = {constants::coords};
@@ -261,6 +364,8 @@ Status SparseIndexReaderBase::load_initial_data() {
   // Preload unzipped coordinate tile offsets. Note that this will
   // ignore fragments with a version < 5.
   const auto dim_num = array_schema_->dim_num();
+  dim_names_.clear();
+  is_dim_var_size_.clear();
   dim_names_.reserve(dim_num);
   is_dim_var_size_.reserve(dim_num);
   std::vector<std::string> var_size_to_load;
@@ -285,11 +390,62 @@ Status SparseIndexReaderBase::load_initial_data() {
       var_size_to_load.emplace_back(name);
   }
 
+  // Query condition fields are read even when they are not requested.
+  for (auto& name : qc_loaded_names_) {
+    if (array_schema_->is_dim(name) || buffers_.count(name) != 0)
+      continue;
+
+    attr_tile_offsets_to_load.emplace_back(name);
+
+    if (array_schema_->var_size(name))
+      var_size_to_load.emplace_back(name);
+  }
+
+  // Aggregated fields are read for the tiles that cannot be answered from
+  // the tile metadata.
+  for (auto& name : aggregate_field_names()) {
+    if (array_schema_->is_dim(name) ||
+        std::find(
+            attr_tile_offsets_to_load.begin(),
+            attr_tile_offsets_to_load.end(),
+            name) != attr_tile_offsets_to_load.end())
+      continue;
+
+    attr_tile_offsets_to_load.emplace_back(name);
+
+    if (array_schema_->var_size(name))
+      var_size_to_load.emplace_back(name);
+  }
+
+  // The top K attribute is read to select the cells.
+  if (has_top_k() &&
+      std::find(
+          attr_tile_offsets_to_load.begin(),
+          attr_tile_offsets_to_load.end(),
+          top_k_->field_name()) == attr_tile_offsets_to_load.end()) {
+    attr_tile_offsets_to_load.emplace_back(top_k_->field_name());
+  }
+
   // Load tile offsets and var sizes for attributes.
   RETURN_CANCEL_OR_ERROR(load_tile_var_sizes(subarray_, var_size_to_load));
   RETURN_CANCEL_OR_ERROR(
       load_tile_offsets(subarray_, attr_tile_offsets_to_load));
 
+  // Load the tile metadata used to skip tiles with the query condition.
+  if (!condition_.empty()) {
+    RETURN_CANCEL_OR_ERROR(load_tile_condition_metadata(subarray_));
+  }
+
+  // Load the tile metadata used to answer the aggregates.
+  if (has_aggregates()) {
+    RETURN_CANCEL_OR_ERROR(load_tile_aggregate_metadata(subarray_));
+  }
+
+  // Load the tile metadata used to skip tiles when selecting the top K.
+  if (has_top_k()) {
+    RETURN_CANCEL_OR_ERROR(load_tile_top_k_metadata(subarray_));
+  }
+
   logger_->debug("Initial data loaded");
   initial_data_loaded_ = true;
   return Status::Ok();
@@ -319,6 +475,22 @@ Status SparseIndexReaderBase::read_and_unfilter_coords(
     for (const auto& dim_name : dim_names_) {
       RETURN_CANCEL_OR_ERROR(unfilter_tiles(dim_name, result_tiles, true));
     }
+
+    // Cache the string coordinate prefixes used for comparisons.
+    for (unsigned d = 0; d < dim_names_.size(); d++) {
+      if (!is_dim_var_size_[d])
+        continue;
+
+      auto status = parallel_for(
+          storage_manager_->compute_tp(),
+          0,
+          result_tiles.size(),
+          [&](uint64_t t) {
+            result_tiles[t]->compute_coord_string_prefixes(d);
+            return Status::Ok();
+          });
+      RETURN_NOT_OK_ELSE(status, logger_->status(status));
+    }
   }
 
   if (!condition_.empty()) {
@@ -337,14 +509,15 @@ Status SparseIndexReaderBase::read_and_unfilter_coords(
 
 template <class BitmapType>
 Status SparseIndexReaderBase::allocate_tile_bitmap(
-    ResultTileWithBitmap<BitmapType>* rt) {
+    ResultTileWithBitmap<BitmapType>* rt,
+    std::vector<BitmapType>& cell_results) {
   // Bitmap was already computed for this tile.
   if (rt->bitmap_result_num_ != std::numeric_limits<uint64_t>::max()) {
     return Status::Ok();
   }
 
   auto cell_num = fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
-  rt->bitmap_.resize(cell_num, 1);
+  cell_results.resize(cell_num, 1);
 
   return Status::Ok();
 }
@@ -353,6 +526,7 @@ template <class BitmapType>
 Status SparseIndexReaderBase::compute_tile_bitmaps(
     std::vector<ResultTile*>& result_tiles) {
   auto timer_se = stats_->start_timer("compute_tile_bitmaps");
+  set_progress_phase(QueryPhase::PROCESS_TILES);
 
   // For easy reference.
   const auto domain = array_schema_->domain();
@@ -372,6 +546,20 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
     num_range_threads = 1 + ((num_threads - 1) / result_tiles.size());
   }
 
+  // Boolean bitmaps are bit-packed, so their per cell results are computed
+  // with a byte per cell first and packed once the cells are counted. Count
+  // bitmaps are computed in place.
+  std::vector<std::vector<uint8_t>> byte_results;
+  if constexpr (std::is_same<BitmapType, uint8_t>::value)
+    byte_results.resize(result_tiles.size());
+  auto cell_results = [&](uint64_t t) -> std::vector<BitmapType>& {
+    if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+      return byte_results[t];
+    } else {
+      return ((ResultTileWithBitmap<BitmapType>*)result_tiles[t])->bitmap_;
+    }
+  };
+
   // Perforance runs have shown that running multiple parallel_for's has a
   // measurable performance impact. So only pre-allocate tile bitmaps if we
   // are going to run multiple range threads.
@@ -383,7 +571,8 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
         result_tiles.size(),
         [&](uint64_t t) {
           return allocate_tile_bitmap(
-              (ResultTileWithBitmap<BitmapType>*)result_tiles[t]);
+              (ResultTileWithBitmap<BitmapType>*)result_tiles[t],
+              cell_results(t));
         });
     RETURN_NOT_OK_ELSE(status, logger_->status(status));
   }
@@ -406,8 +595,9 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
           return Status::Ok();
 
         // Allocate the bitmap if not preallocated.
+        auto& results = cell_results(t);
         if (num_range_threads == 1)
-          RETURN_NOT_OK(allocate_tile_bitmap(rt));
+          RETURN_NOT_OK(allocate_tile_bitmap(rt, results));
 
         // Prevent processing past the end of the cells in case there are more
         // threads than cells.
@@ -469,7 +659,7 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
                 dim_idx,
                 ranges_for_dim,
                 relevant_ranges,
-                rt->bitmap_,
+                results,
                 cell_order,
                 min,
                 max));
@@ -479,7 +669,7 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
         // Only compute bitmap cells here if we are processing a single cell
         // range. If not, it will be done below.
         if (num_range_threads == 1)
-          RETURN_NOT_OK(count_tile_bitmap_cells(rt));
+          RETURN_NOT_OK(count_tile_bitmap_cells(rt, results));
 
         return Status::Ok();
       });
@@ -495,7 +685,8 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
         result_tiles.size(),
         [&](uint64_t t) {
           return count_tile_bitmap_cells(
-              (ResultTileWithBitmap<BitmapType>*)result_tiles[t]);
+              (ResultTileWithBitmap<BitmapType>*)result_tiles[t],
+              cell_results(t));
         });
     RETURN_NOT_OK_ELSE(status, logger_->status(status));
   }
@@ -507,7 +698,8 @@ Status SparseIndexReaderBase::compute_tile_bitmaps(
 /** Count the number of cells in a bitmap. */
 template <class BitmapType>
 Status SparseIndexReaderBase::count_tile_bitmap_cells(
-    ResultTileWithBitmap<BitmapType>* rt) {
+    ResultTileWithBitmap<BitmapType>* rt,
+    std::vector<BitmapType>& cell_results) {
   // Bitmap was already computed for this tile.
   if (rt->bitmap_result_num_ != std::numeric_limits<uint64_t>::max()) {
     return Status::Ok();
@@ -517,22 +709,280 @@ Status SparseIndexReaderBase::count_tile_bitmap_cells(
   auto cell_num = fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
   rt->bitmap_result_num_ = 0;
   for (uint64_t c = 0; c < cell_num; ++c) {
-    rt->bitmap_result_num_ += rt->bitmap_[c];
+    rt->bitmap_result_num_ += cell_results[c];
   }
 
   // Clear the bitmap, which will also signal the copy operation to copy the
-  // whole tile.
-  if (rt->bitmap_result_num_ == cell_num) {
+  // whole tile. Otherwise, pack the per cell results into the tile bitmap.
+  if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+    if (rt->bitmap_result_num_ != cell_num)
+      rt->bitmap_.assign(cell_results);
+    std::vector<uint8_t>().swap(cell_results);
+  } else if (rt->bitmap_result_num_ == cell_num) {
     rt->bitmap_.resize(0);
   }
 
   return Status::Ok();
 }
 
+Status SparseIndexReaderBase::reserve_memory_budget() {
+  auto governor = storage_manager_->governor();
+  if (governor == nullptr)
+    return Status::Ok();
+
+  if (memory_budget_reserved_ > 0) {
+    governor->release(memory_budget_reserved_);
+    memory_budget_reserved_ = 0;
+  }
+
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  const double min_ratio = config->mem_governor_min_ratio;
+  const uint64_t timeout_ms = config->mem_governor_timeout_ms;
+
+  auto timer_se = stats_->start_timer("reserve_memory_budget");
+  const uint64_t granted = governor->reserve(
+      memory_budget_,
+      static_cast<uint64_t>(memory_budget_ * min_ratio),
+      std::chrono::milliseconds(timeout_ms));
+  if (granted == 0)
+    return logger_->status(Status_ReaderError(
+        "Cannot reserve the memory budget; the total budget of the context "
+        "is exhausted by other queries"));
+
+  if (granted < memory_budget_) {
+    stats_->add_counter("memory_budget_shrunk_num", 1);
+    memory_budget_ = granted;
+  }
+  memory_budget_reserved_ = granted;
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::skip_qc_tiles(
+    std::vector<ResultTile*>& result_tiles) {
+  if (condition_.empty()) {
+    return Status::Ok();
+  }
+
+  auto&& [st, skipped] = compute_qc_skipped_tiles(result_tiles);
+  RETURN_NOT_OK(st);
+
+  // Skipped tiles have no results, they will be cleared by the caller.
+  uint64_t current = 0;
+  for (uint64_t t = 0; t < result_tiles.size(); t++) {
+    if ((*skipped)[t]) {
+      ((ResultTileWithBitmap<BitmapType>*)result_tiles[t])
+          ->bitmap_result_num_ = 0;
+    } else {
+      result_tiles[current++] = result_tiles[t];
+    }
+  }
+  result_tiles.resize(current);
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::skip_unsampled_tiles(
+    std::vector<ResultTile*>& result_tiles) {
+  if (sample_fraction_ >= 1.0) {
+    return Status::Ok();
+  }
+
+  const auto threshold = sample_threshold(sample_fraction_);
+  std::vector<uint8_t> sampled(result_tiles.size());
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
+        auto rt = result_tiles[t];
+        const auto hash =
+            sample_tile_hash(sample_seed_, rt->frag_idx(), rt->tile_idx());
+        const auto cell_num =
+            fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+        for (uint64_t c = 0; c < cell_num; c++) {
+          if (mix_bits(hash + c) < threshold) {
+            sampled[t] = 1;
+            break;
+          }
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+  // Skipped tiles have no results, they will be cleared by the caller.
+  uint64_t current = 0;
+  for (uint64_t t = 0; t < result_tiles.size(); t++) {
+    if (!sampled[t]) {
+      ((ResultTileWithBitmap<BitmapType>*)result_tiles[t])
+          ->bitmap_result_num_ = 0;
+    } else {
+      result_tiles[current++] = result_tiles[t];
+    }
+  }
+  stats_->add_counter("unsampled_tile_num", result_tiles.size() - current);
+  result_tiles.resize(current);
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::apply_sample(
+    std::vector<ResultTile*>& result_tiles) {
+  if (sample_fraction_ >= 1.0) {
+    return Status::Ok();
+  }
+
+  auto timer_se = stats_->start_timer("apply_sample");
+  const auto threshold = sample_threshold(sample_fraction_);
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
+        auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[t];
+        const auto hash =
+            sample_tile_hash(sample_seed_, rt->frag_idx(), rt->tile_idx());
+        const auto cell_num =
+            fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+
+        // Full overlap in bitmap calculation, make a bitmap.
+        if (rt->bitmap_.size() == 0) {
+          rt->bitmap_.resize(cell_num, 1);
+        }
+
+        rt->bitmap_result_num_ = 0;
+        for (uint64_t c = 0; c < cell_num; c++) {
+          if (mix_bits(hash + c) >= threshold) {
+            rt->bitmap_[c] = 0;
+          } else {
+            rt->bitmap_result_num_ += rt->bitmap_[c];
+          }
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::skip_top_k_tiles(
+    std::vector<ResultTile*>& result_tiles) {
+  if (!has_top_k() || top_k_selected_) {
+    return Status::Ok();
+  }
+
+  // Skipped tiles have no results, they will be cleared by the caller.
+  uint64_t current = 0;
+  for (uint64_t t = 0; t < result_tiles.size(); t++) {
+    auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[t];
+    auto&& [st, skip] = top_k_->can_skip_tile(
+        fragment_metadata_[rt->frag_idx()].get(), rt->tile_idx());
+    RETURN_NOT_OK(st);
+    if (*skip) {
+      rt->bitmap_result_num_ = 0;
+    } else {
+      result_tiles[current++] = rt;
+    }
+  }
+  stats_->add_counter("top_k_skipped_tile_num", result_tiles.size() - current);
+  result_tiles.resize(current);
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::apply_top_k_selection(
+    std::vector<ResultTile*>& result_tiles) {
+  if (!has_top_k() || !top_k_selected_) {
+    return Status::Ok();
+  }
+
+  for (auto result_tile : result_tiles) {
+    auto rt = (ResultTileWithBitmap<BitmapType>*)result_tile;
+    const auto cell_num =
+        fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+
+    // Full overlap in bitmap calculation, make a bitmap.
+    if (rt->bitmap_.size() == 0) {
+      rt->bitmap_.resize(cell_num, 1);
+    }
+
+    // Each selected cell is returned once.
+    TileBitmap<BitmapType> selected;
+    selected.resize(cell_num, 0);
+    rt->bitmap_result_num_ = 0;
+    auto it = top_k_cells_.find({rt->frag_idx(), rt->tile_idx()});
+    if (it != top_k_cells_.end()) {
+      for (auto pos : it->second) {
+        if (rt->bitmap_[pos] != 0) {
+          selected[pos] = 1;
+          rt->bitmap_result_num_++;
+        }
+      }
+    }
+    rt->bitmap_ = std::move(selected);
+  }
+
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::skip_covered_tiles(
+    std::vector<ResultTile*>& result_tiles,
+    std::vector<ResultTile*>* covered_tiles) {
+  // Count bitmaps count the cells of overlapping ranges more than once, and
+  // the overwritten cells of the covered tiles could not be resolved.
+  if (!std::is_same<BitmapType, uint8_t>::value || !has_aggregates() ||
+      !condition_.empty() || sample_fraction_ < 1.0 || !subarray_.is_set() ||
+      (!array_schema_->allows_dups() && fragment_metadata_.size() > 1))
+    return Status::Ok();
+
+  const auto domain = array_schema_->domain();
+  const auto dim_num = array_schema_->dim_num();
+  uint64_t current = 0;
+  for (uint64_t t = 0; t < result_tiles.size(); t++) {
+    auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[t];
+    const auto& fragment = fragment_metadata_[rt->frag_idx()];
+    const auto& mbr = fragment->mbr(rt->tile_idx());
+
+    // The tile is covered if its MBR is covered by a range of every
+    // dimension. When grouping, the covered tiles must also lie within a
+    // single bucket as their coordinates are not read.
+    bool covered = !has_aggregate_groups() ||
+                   tile_bucket(rt->frag_idx(), rt->tile_idx()).has_value();
+    for (unsigned d = 0; covered && d < dim_num; d++) {
+      if (subarray_.is_default(d))
+        continue;
+
+      const auto& ranges_for_dim = subarray_.ranges_for_dim(d);
+      std::vector<uint64_t> relevant_ranges;
+      domain->dimension(d)->relevant_ranges(
+          ranges_for_dim, mbr[d], relevant_ranges);
+      auto covered_bitmap = domain->dimension(d)->covered_vec(
+          ranges_for_dim, mbr[d], relevant_ranges);
+      covered = std::find(covered_bitmap.begin(), covered_bitmap.end(), true) !=
+                covered_bitmap.end();
+    }
+
+    if (covered) {
+      rt->bitmap_result_num_ = fragment->cell_num(rt->tile_idx());
+      covered_tiles->emplace_back(rt);
+    } else {
+      result_tiles[current++] = rt;
+    }
+  }
+  result_tiles.resize(current);
+
+  stats_->add_counter("covered_tile_num", covered_tiles->size());
+  return Status::Ok();
+}
+
 template <class BitmapType>
 Status SparseIndexReaderBase::apply_query_condition(
     std::vector<ResultTile*>& result_tiles) {
   auto timer_se = stats_->start_timer("apply_query_condition");
+  set_progress_phase(QueryPhase::PROCESS_TILES);
 
   if (!condition_.empty()) {
     // Process all tiles in parallel.
@@ -558,12 +1008,25 @@ Status SparseIndexReaderBase::apply_query_condition(
             rt->bitmap_result_num_ = cell_num;
           }
 
-          // Compute the result of the query condition for this tile.
-          RETURN_NOT_OK(condition_.apply_sparse<BitmapType>(
-              fragment_metadata_[rt->frag_idx()]->array_schema(),
-              *rt,
-              rt->bitmap_,
-              &rt->bitmap_result_num_));
+          // Compute the result of the query condition for this tile. For
+          // bit-packed bitmaps, it is computed with a byte per cell then
+          // combined with the bitmap a word at a time.
+          if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+            std::vector<uint8_t> cell_results;
+            rt->bitmap_.unpack(&cell_results);
+            RETURN_NOT_OK(condition_.apply_sparse<BitmapType>(
+                fragment_metadata_[rt->frag_idx()]->array_schema(),
+                *rt,
+                cell_results,
+                &rt->bitmap_result_num_));
+            rt->bitmap_.and_with(cell_results);
+          } else {
+            RETURN_NOT_OK(condition_.apply_sparse<BitmapType>(
+                fragment_metadata_[rt->frag_idx()]->array_schema(),
+                *rt,
+                rt->bitmap_,
+                &rt->bitmap_result_num_));
+          }
 
           return Status::Ok();
         });
@@ -574,6 +1037,247 @@ Status SparseIndexReaderBase::apply_query_condition(
   return Status::Ok();
 }
 
+bool SparseIndexReaderBase::has_overwrites() const {
+  return !array_schema_->allows_dups() && fragment_metadata_.size() > 1;
+}
+
+template <class BitmapType>
+Status SparseIndexReaderBase::resolve_overwrites(
+    const uint64_t memory_budget, std::vector<ResultTile*>& result_tiles) {
+  auto timer_se = stats_->start_timer("resolve_overwrites");
+
+  // For easy reference.
+  const auto fragment_num = fragment_metadata_.size();
+  const auto dim_num = array_schema_->dim_num();
+
+  // Cells that are in multiple ranges are only returned once.
+  if constexpr (!std::is_same_v<BitmapType, uint8_t>) {
+    for (auto result_tile : result_tiles) {
+      auto rt = (ResultTileWithBitmap<BitmapType>*)result_tile;
+      if (rt->bitmap_.size() == 0)
+        continue;
+
+      rt->bitmap_result_num_ = 0;
+      for (auto& count : rt->bitmap_) {
+        count = std::min<BitmapType>(count, 1);
+        rt->bitmap_result_num_ += count;
+      }
+    }
+  }
+
+  if (!has_overwrites()) {
+    return Status::Ok();
+  }
+
+  // The tile MBRs of the more recent fragments are used to find the tiles
+  // that can hold the same coordinates as a result tile. Those fragments
+  // intersect the subarray, if it is set.
+  std::vector<uint8_t> relevant(fragment_num, !subarray_.is_set());
+  if (subarray_.is_set()) {
+    for (auto f : *subarray_.relevant_fragments()) {
+      relevant[f] = 1;
+    }
+  }
+
+  const auto encryption_key = array_->encryption_key();
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, fragment_num, [&](uint64_t f) {
+        if (!relevant[f])
+          return Status::Ok();
+
+        return fragment_metadata_[f]->load_rtree(*encryption_key);
+      });
+  RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+  // Hashes the coordinates of a cell.
+  auto coords_hash = [&](const ResultTile* rt, uint64_t pos) {
+    uint64_t hash = 0;
+    for (unsigned d = 0; d < dim_num; d++) {
+      const auto value =
+          is_dim_var_size_[d] ?
+              rt->coord_string(pos, d) :
+              std::string_view(
+                  static_cast<const char*>(rt->coord(pos, d)),
+                  rt->coord_size(d));
+      hash ^= std::hash<std::string_view>()(value) + 0x9e3779b97f4a7c15 +
+              (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+  };
+
+  // Process as many result tiles at a time as the tiles overlapping them fit
+  // in the memory budget.
+  uint64_t t = 0;
+  while (t < result_tiles.size()) {
+    // Find the overlapping tiles of the more recent fragments, overlapping
+    // tiles are shared between the result tiles.
+    std::map<std::pair<unsigned, uint64_t>, uint64_t> overlapping_idx;
+    std::vector<std::pair<unsigned, uint64_t>> overlapping_ids;
+    std::vector<std::vector<uint64_t>> overlapping_per_tile;
+    uint64_t memory_used = 0;
+    const uint64_t first_t = t;
+    for (; t < result_tiles.size(); t++) {
+      auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[t];
+      std::vector<uint64_t> overlapping;
+      std::vector<std::pair<unsigned, uint64_t>> new_ids;
+      uint64_t new_memory = 0;
+      if (rt->bitmap_result_num_ != 0) {
+        const auto& mbr = fragment_metadata_[rt->frag_idx()]->mbr(
+            rt->tile_idx());
+        for (unsigned g = rt->frag_idx() + 1; g < fragment_num; g++) {
+          if (!relevant[g])
+            continue;
+
+          TileOverlap tile_overlap;
+          RETURN_NOT_OK(
+              fragment_metadata_[g]->get_tile_overlap(mbr, &tile_overlap));
+
+          std::vector<uint64_t> tile_ids;
+          for (const auto& tr : tile_overlap.tile_ranges_) {
+            for (uint64_t tid = tr.first; tid <= tr.second; tid++) {
+              tile_ids.emplace_back(tid);
+            }
+          }
+          for (const auto& tile : tile_overlap.tiles_) {
+            tile_ids.emplace_back(tile.first);
+          }
+
+          for (auto tid : tile_ids) {
+            const auto id = std::make_pair(g, tid);
+            auto it = overlapping_idx.find(id);
+            if (it == overlapping_idx.end()) {
+              auto&& [st, tiles_sizes] =
+                  get_coord_tiles_size<BitmapType>(true, dim_num, g, tid);
+              RETURN_NOT_OK(st);
+              new_memory += tiles_sizes->first;
+              it = overlapping_idx
+                       .emplace(
+                           id, overlapping_ids.size() + new_ids.size())
+                       .first;
+              new_ids.emplace_back(id);
+            }
+
+            overlapping.emplace_back(it->second);
+          }
+        }
+      }
+
+      // Make sure the tiles overlapping at least one result tile fit.
+      if (memory_used + new_memory > memory_budget) {
+        if (t == first_t) {
+          return logger_->status(Status_ReaderError(
+              "Cannot load the tiles overlapping a single tile, increase "
+              "memory budget"));
+        }
+
+        for (const auto& id : new_ids) {
+          overlapping_idx.erase(id);
+        }
+        break;
+      }
+
+      memory_used += new_memory;
+      overlapping_ids.insert(
+          overlapping_ids.end(), new_ids.begin(), new_ids.end());
+      overlapping_per_tile.emplace_back(std::move(overlapping));
+    }
+
+    // Read and unfilter the coordinates of the overlapping tiles.
+    std::list<ResultTile> overlapping_tiles;
+    std::vector<ResultTile*> overlapping_ptrs;
+    overlapping_ptrs.reserve(overlapping_ids.size());
+    for (const auto& id : overlapping_ids) {
+      overlapping_tiles.emplace_back(
+          id.first, id.second, fragment_metadata_[id.first]->array_schema());
+      overlapping_ptrs.emplace_back(&overlapping_tiles.back());
+    }
+
+    std::vector<std::string> zipped_coords_names = {constants::coords};
+    RETURN_CANCEL_OR_ERROR(
+        read_coordinate_tiles(zipped_coords_names, overlapping_ptrs, true));
+    RETURN_CANCEL_OR_ERROR(
+        unfilter_tiles(constants::coords, overlapping_ptrs, true));
+    RETURN_CANCEL_OR_ERROR(
+        read_coordinate_tiles(dim_names_, overlapping_ptrs, true));
+    for (const auto& dim_name : dim_names_) {
+      RETURN_CANCEL_OR_ERROR(
+          unfilter_tiles(dim_name, overlapping_ptrs, true));
+    }
+
+    // Sort the cells of the overlapping tiles by coordinate hash.
+    std::vector<std::vector<std::pair<uint64_t, uint64_t>>> hashes(
+        overlapping_ptrs.size());
+    status = parallel_for(
+        storage_manager_->compute_tp(),
+        0,
+        overlapping_ptrs.size(),
+        [&](uint64_t i) {
+          const auto tile = overlapping_ptrs[i];
+          const auto cell_num =
+              fragment_metadata_[tile->frag_idx()]->cell_num(tile->tile_idx());
+          hashes[i].reserve(cell_num);
+          for (uint64_t c = 0; c < cell_num; c++) {
+            hashes[i].emplace_back(coords_hash(tile, c), c);
+          }
+          std::sort(hashes[i].begin(), hashes[i].end());
+
+          return Status::Ok();
+        });
+    RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+    // Clear the overwritten cells from the bitmaps.
+    status = parallel_for(
+        storage_manager_->compute_tp(), first_t, t, [&](uint64_t i) {
+          auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[i];
+          const auto& overlapping = overlapping_per_tile[i - first_t];
+          if (overlapping.empty())
+            return Status::Ok();
+
+          const auto cell_num =
+              fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+          if (rt->bitmap_.size() == 0) {
+            rt->bitmap_.resize(cell_num, 1);
+            rt->bitmap_result_num_ = cell_num;
+          }
+
+          for (uint64_t c = 0; c < cell_num; c++) {
+            if (rt->bitmap_[c] == 0)
+              continue;
+
+            const auto hash = coords_hash(rt, c);
+            bool overwritten = false;
+            for (auto o = overlapping.begin();
+                 o != overlapping.end() && !overwritten;
+                 o++) {
+              const auto& tile_hashes = hashes[*o];
+              auto it = std::lower_bound(
+                  tile_hashes.begin(),
+                  tile_hashes.end(),
+                  std::make_pair(hash, uint64_t(0)));
+              for (; it != tile_hashes.end() && it->first == hash; it++) {
+                if (rt->same_coords(*overlapping_ptrs[*o], c, it->second)) {
+                  overwritten = true;
+                  break;
+                }
+              }
+            }
+
+            if (overwritten) {
+              rt->bitmap_result_num_ -= rt->bitmap_[c];
+              rt->bitmap_[c] = 0;
+            }
+          }
+
+          return Status::Ok();
+        });
+    RETURN_NOT_OK_ELSE(status, logger_->status(status));
+  }
+
+  logger_->debug("Done resolving overwrites");
+  return Status::Ok();
+}
+
 std::tuple<Status, std::optional<std::vector<uint64_t>>>
 SparseIndexReaderBase::read_and_unfilter_attributes(
     const uint64_t memory_budget,
@@ -603,12 +1307,24 @@ SparseIndexReaderBase::read_and_unfilter_attributes(
     }
   }
 
-  // Read and unfilter tiles.
-  RETURN_NOT_OK_TUPLE(
-      read_attribute_tiles(names_to_read, result_tiles, true), std::nullopt);
+  // Read and unfilter tiles. Every attribute is read on the I/O pool and
+  // unfiltered on the compute pool as soon as its tiles are read, so the
+  // unfiltering of an attribute overlaps the reading of the next ones.
+  TaskGraph graph;
+  for (auto& name : names_to_read) {
+    auto read_node =
+        graph.add_node(storage_manager_->io_tp(), [&, name]() {
+          return read_attribute_tiles({name}, result_tiles, true);
+        });
+    graph.add_node(
+        storage_manager_->compute_tp(),
+        [&, name]() { return unfilter_tiles(name, result_tiles, true); },
+        {read_node});
+  }
+  RETURN_NOT_OK_TUPLE(graph.run(), std::nullopt);
 
-  for (auto& name : names_to_read)
-    RETURN_NOT_OK_TUPLE(unfilter_tiles(name, result_tiles, true), std::nullopt);
+  memory_used_attribute_tiles_ = memory_used;
+  report_memory_usage();
 
   return {Status::Ok(), std::move(index_to_copy)};
 }
@@ -694,11 +1410,14 @@ Status SparseIndexReaderBase::add_extra_offset() {
   return Status::Ok();
 }
 
-void SparseIndexReaderBase::remove_result_tile_range(uint64_t f) {
-  result_tile_ranges_[f].pop_back();
-  {
+void SparseIndexReaderBase::consume_result_tile(uint64_t f) {
+  auto& tile_ranges = result_tile_ranges_[f];
+  const uint64_t memory_usage = tile_ranges.memory_usage();
+  tile_ranges.pop_front();
+  if (tile_ranges.memory_usage() != memory_usage) {
     std::unique_lock<std::mutex> lck(mem_budget_mtx_);
-    memory_used_result_tile_ranges_ -= sizeof(std::pair<uint64_t, uint64_t>);
+    memory_used_result_tile_ranges_ -=
+        memory_usage - tile_ranges.memory_usage();
   }
 }
 
@@ -709,6 +1428,34 @@ SparseIndexReaderBase::get_coord_tiles_size<uint64_t>(
 template std::tuple<Status, std::optional<std::pair<uint64_t, uint64_t>>>
 SparseIndexReaderBase::get_coord_tiles_size<uint8_t>(
     bool, unsigned, unsigned, uint64_t);
+template uint64_t SparseIndexReaderBase::get_tile_bitmap_size<uint64_t>(
+    unsigned, uint64_t);
+template uint64_t SparseIndexReaderBase::get_tile_bitmap_size<uint8_t>(
+    unsigned, uint64_t);
+template Status SparseIndexReaderBase::skip_qc_tiles<uint64_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_qc_tiles<uint8_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_unsampled_tiles<uint64_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_unsampled_tiles<uint8_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::apply_sample<uint64_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::apply_sample<uint8_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_top_k_tiles<uint64_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_top_k_tiles<uint8_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::apply_top_k_selection<uint64_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::apply_top_k_selection<uint8_t>(
+    std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::skip_covered_tiles<uint64_t>(
+    std::vector<ResultTile*>&, std::vector<ResultTile*>*);
+template Status SparseIndexReaderBase::skip_covered_tiles<uint8_t>(
+    std::vector<ResultTile*>&, std::vector<ResultTile*>*);
 template Status SparseIndexReaderBase::apply_query_condition<uint64_t>(
     std::vector<ResultTile*>&);
 template Status SparseIndexReaderBase::apply_query_condition<uint8_t>(
@@ -717,6 +1464,10 @@ template Status SparseIndexReaderBase::compute_tile_bitmaps<uint64_t>(
     std::vector<ResultTile*>&);
 template Status SparseIndexReaderBase::compute_tile_bitmaps<uint8_t>(
     std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::resolve_overwrites<uint64_t>(
+    const uint64_t, std::vector<ResultTile*>&);
+template Status SparseIndexReaderBase::resolve_overwrites<uint8_t>(
+    const uint64_t, std::vector<ResultTile*>&);
 
 }  // namespace sm
 }  // namespace tiledb
@@ -33,10 +33,13 @@
 #ifndef TILEDB_SPARSE_INDEX_READER_BASE_H
 #define TILEDB_SPARSE_INDEX_READER_BASE_H
 
+#include <map>
 #include <queue>
 #include "reader_base.h"
 #include "tiledb/common/status.h"
 #include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/misc/packed_bitmap.h"
+#include "tiledb/sm/misc/tile_ranges.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/query/result_cell_slab.h"
@@ -50,6 +53,16 @@ class MemoryTracker;
 class StorageManager;
 class Subarray;
 
+/**
+ * Storage of a tile bitmap. Boolean bitmaps are bit-packed, while count
+ * bitmaps keep a count per cell.
+ */
+template <class BitmapType>
+using TileBitmap = typename std::conditional<
+    std::is_same<BitmapType, uint8_t>::value,
+    PackedBitmap,
+    std::vector<BitmapType>>::type;
+
 /** Result tile with bitmap. */
 template <class BitmapType>
 class ResultTileWithBitmap : public ResultTile {
@@ -98,6 +111,9 @@ class ResultTileWithBitmap : public ResultTile {
     if (bitmap_.size() == 0)
       return end_pos - start_pos;
 
+    if constexpr (std::is_same<BitmapType, uint8_t>::value)
+      return bitmap_.count(start_pos, end_pos);
+
     uint64_t result_num = 0;
     for (uint64_t c = start_pos; c < end_pos; c++)
       result_num += bitmap_[c];
@@ -121,6 +137,9 @@ class ResultTileWithBitmap : public ResultTile {
     if (bitmap_.size() == 0)
       return start_pos + result_num - 1;
 
+    if constexpr (std::is_same<BitmapType, uint8_t>::value)
+      return bitmap_.pos_with_count(start_pos, result_num);
+
     uint64_t sum = 0;
     for (uint64_t c = start_pos; c < bitmap_.size(); c++) {
       sum += bitmap_[c];
@@ -132,6 +151,29 @@ class ResultTileWithBitmap : public ResultTile {
     return bitmap_.size() - 1;
   }
 
+  /**
+   * Returns the end of the run of cells starting at `start_pos` that all
+   * have the same bitmap value, bounded by `end_pos`.
+   *
+   * @param start_pos Starting cell position in the bitmap.
+   * @param end_pos End position in the bitmap.
+   *
+   * @return End position of the run.
+   */
+  uint64_t bitmap_run_end(uint64_t start_pos, uint64_t end_pos) const {
+    if (bitmap_.size() == 0)
+      return end_pos;
+
+    if constexpr (std::is_same<BitmapType, uint8_t>::value)
+      return bitmap_.run_end(start_pos, end_pos);
+
+    uint64_t c = start_pos + 1;
+    while (c < end_pos && bitmap_[c] == bitmap_[start_pos])
+      c++;
+
+    return c;
+  }
+
   /** Swaps the contents (all field values) of this tile with the given tile. */
   void swap(ResultTileWithBitmap<BitmapType>& tile) {
     ResultTile::swap(tile);
@@ -146,7 +188,7 @@ class ResultTileWithBitmap : public ResultTile {
   /* ********************************* */
 
   /** Bitmap for this tile. */
-  std::vector<BitmapType> bitmap_;
+  TileBitmap<BitmapType> bitmap_;
 
   /** Number of cells in this bitmap. */
   uint64_t bitmap_result_num_;
@@ -200,7 +242,7 @@ class SparseIndexReaderBase : public ReaderBase {
       QueryCondition& condition);
 
   /** Destructor. */
-  ~SparseIndexReaderBase() = default;
+  ~SparseIndexReaderBase();
 
   /* ********************************* */
   /*          PUBLIC METHODS           */
@@ -227,6 +269,16 @@ class SparseIndexReaderBase : public ReaderBase {
    */
   Status init();
 
+  /**
+   * Prepares the reader to run again over a new subarray. The tile ranges
+   * and the fragment positions are computed again by the next read, while
+   * the memory budget, the loaded tile offsets and the tile buffers are
+   * kept.
+   *
+   * @return Status.
+   */
+  Status rebind();
+
   /**
    * Resize the output buffers to the correct size after copying.
    *
@@ -253,9 +305,12 @@ class SparseIndexReaderBase : public ReaderBase {
   /** Are dimensions var sized. */
   std::vector<bool> is_dim_var_size_;
 
-  /** Reverse sorted vector, per fragments, of tiles ranges in the subarray, if
-   * set. */
-  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> result_tile_ranges_;
+  /**
+   * The tiles in the subarray, if set, per fragment. They are stored
+   * compactly so that queries with many ranges over many fragments fit in
+   * the memory budget.
+   */
+  std::vector<TileRanges> result_tile_ranges_;
 
   /** Have ve loaded the initial data. */
   bool initial_data_loaded_;
@@ -263,6 +318,9 @@ class SparseIndexReaderBase : public ReaderBase {
   /** Total memory budget. */
   uint64_t memory_budget_;
 
+  /** The part of `memory_budget_` reserved from the context governor. */
+  uint64_t memory_budget_reserved_;
+
   /** Mutex protecting memory budget variables. */
   std::mutex mem_budget_mtx_;
 
@@ -278,6 +336,12 @@ class SparseIndexReaderBase : public ReaderBase {
   /** Memory used for result tile ranges. */
   uint64_t memory_used_result_tile_ranges_;
 
+  /** Memory used for tile bitmaps, included in the coordinates memory. */
+  uint64_t memory_used_bitmaps_total_;
+
+  /** Memory used for the attribute tiles being copied. */
+  uint64_t memory_used_attribute_tiles_;
+
   /** How much of the memory budget is reserved for coords. */
   double memory_budget_ratio_coords_;
 
@@ -296,6 +360,15 @@ class SparseIndexReaderBase : public ReaderBase {
   /** Names of dim/attr loaded for query condition. */
   std::vector<std::string> qc_loaded_names_;
 
+  /**
+   * Set once all the tiles were scanned for the top K cells, after which
+   * only the tiles holding them are read again.
+   */
+  bool top_k_selected_;
+
+  /** The positions of the top K cells, per (fragment, tile). */
+  std::map<std::pair<unsigned, uint64_t>, std::vector<uint64_t>> top_k_cells_;
+
   /* Are the users buffers full. */
   bool buffers_full_;
 
@@ -327,6 +400,25 @@ class SparseIndexReaderBase : public ReaderBase {
   get_coord_tiles_size(
       bool include_coords, unsigned dim_num, unsigned f, uint64_t t);
 
+  /**
+   * Get the bitmap size of a result tile.
+   *
+   * @param f Fragment index.
+   * @param t Tile index.
+   *
+   * @return Bitmap size, 0 if there is no subarray.
+   */
+  template <class BitmapType>
+  uint64_t get_tile_bitmap_size(unsigned f, uint64_t t);
+
+  /**
+   * Records the current memory usage of the reader in its stats, by
+   * category: coordinate tiles, bitmaps, query condition tiles, attribute
+   * tiles, tile overlap and array data. Also records the size of the tile
+   * caches of the context.
+   */
+  void report_memory_usage();
+
   /**
    * Load tile offsets and result tile ranges.
    *
@@ -334,6 +426,94 @@ class SparseIndexReaderBase : public ReaderBase {
    */
   Status load_initial_data();
 
+  /**
+   * Reserves `memory_budget_` from the governor of the context, if any,
+   * releasing any previous reservation. If less memory is available, the
+   * budget is reduced to what was granted, down to
+   * `sm.mem.governor.min_ratio` of it; below that, waits for memory to be
+   * released for up to `sm.mem.governor.timeout_ms`.
+   *
+   * @return Status.
+   */
+  Status reserve_memory_budget();
+
+  /**
+   * Skip the result tiles that cannot contain a cell satisfying the query
+   * condition, using the tile metadata. Skipped tiles get a result count of
+   * zero and are removed from `result_tiles` so that none of their tiles are
+   * read.
+   *
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status skip_qc_tiles(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Skips the result tiles in which no cell is sampled, without reading
+   * them. The skipped tiles get a result count of 0 and are removed from
+   * `result_tiles`.
+   *
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status skip_unsampled_tiles(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Clears the cells that are not sampled from the bitmaps of the result
+   * tiles, and updates their result counts.
+   *
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status apply_sample(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Skips the result tiles that cannot hold a top K cell according to their
+   * tile metadata, while scanning for the top K cells. The skipped tiles get
+   * a result count of 0 and are removed from `result_tiles`.
+   *
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status skip_top_k_tiles(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Once the top K cells are selected, clears the other cells from the
+   * bitmaps of the result tiles and updates their result counts.
+   *
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status apply_top_k_selection(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Moves the result tiles fully covered by the subarray to `covered_tiles`
+   * for queries that only compute aggregates, so that they are counted
+   * from the fragment metadata without reading their coordinates. Covered
+   * tiles get a result count of their cell number and an empty bitmap.
+   * Nothing is moved for queries with a query condition, or with ranges
+   * that may overlap and count cells more than once.
+   *
+   * @param result_tiles Result tiles to process.
+   * @param covered_tiles The covered result tiles.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status skip_covered_tiles(
+      std::vector<ResultTile*>& result_tiles,
+      std::vector<ResultTile*>* covered_tiles);
+
   /**
    * Read and unfilter coord tiles.
    *
@@ -346,14 +526,18 @@ class SparseIndexReaderBase : public ReaderBase {
       bool include_coords, const std::vector<ResultTile*>& result_tiles);
 
   /**
-   * Allocate a tile bitmap if required for this tile.
+   * Allocate the per cell results of a tile bitmap if required for this
+   * tile.
    *
    * @param rt Result tile currently in process.
+   * @param cell_results The per cell results to allocate.
    *
    * @return Status.
    */
   template <class BitmapType>
-  Status allocate_tile_bitmap(ResultTileWithBitmap<BitmapType>* rt);
+  Status allocate_tile_bitmap(
+      ResultTileWithBitmap<BitmapType>* rt,
+      std::vector<BitmapType>& cell_results);
 
   /**
    * Compute tile bitmaps.
@@ -366,14 +550,18 @@ class SparseIndexReaderBase : public ReaderBase {
   Status compute_tile_bitmaps(std::vector<ResultTile*>& result_tiles);
 
   /**
-   * Count the number of cells in a bitmap.
+   * Count the number of cells in a bitmap, and store the per cell results
+   * in the tile bitmap.
    *
    * @param rt Result tile currently in process.
+   * @param cell_results The per cell results of the tile.
    *
    * @return Status.
    */
   template <class BitmapType>
-  Status count_tile_bitmap_cells(ResultTileWithBitmap<BitmapType>* rt);
+  Status count_tile_bitmap_cells(
+      ResultTileWithBitmap<BitmapType>* rt,
+      std::vector<BitmapType>& cell_results);
 
   /**
    * Apply query condition.
@@ -385,6 +573,31 @@ class SparseIndexReaderBase : public ReaderBase {
   template <class BitmapType>
   Status apply_query_condition(std::vector<ResultTile*>& result_tiles);
 
+  /**
+   * Returns true if the cells of a fragment can be overwritten by the cells
+   * of a more recent fragment, i.e. if the array does not allow duplicates
+   * and has more than one fragment.
+   *
+   * @return Can cells be overwritten.
+   */
+  bool has_overwrites() const;
+
+  /**
+   * For arrays that do not allow duplicates, clears from the tile bitmaps the
+   * cells overwritten by a cell with the same coordinates in a more recent
+   * fragment and counts the cells in multiple ranges only once. The
+   * coordinates of the more recent tiles overlapping the tile MBRs are read
+   * a few result tiles at a time, within the memory budget.
+   *
+   * @param memory_budget Memory budget for the overlapping coordinate tiles.
+   * @param result_tiles Result tiles to process.
+   *
+   * @return Status.
+   */
+  template <class BitmapType>
+  Status resolve_overwrites(
+      const uint64_t memory_budget, std::vector<ResultTile*>& result_tiles);
+
   /**
    * Read and unfilter as many attributes as can fit in the memory budget and
    * return the names loaded in 'names_to_copy'. Also keep the 'buffer_idx'
@@ -415,11 +628,12 @@ class SparseIndexReaderBase : public ReaderBase {
   Status add_extra_offset();
 
   /**
-   * Remove a result tile range for a specific fragment.
+   * Consumes the first tile in the result tile ranges of a fragment,
+   * releasing the memory of the ranges as they are consumed.
    *
    * @param f Fragment index.
    */
-  void remove_result_tile_range(uint64_t f);
+  void consume_result_tile(uint64_t f);
 };
 
 }  // namespace sm
@@ -41,6 +41,7 @@
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/query_macros.h"
+#include "tiledb/sm/query/query_progress.h"
 #include "tiledb/sm/query/result_tile.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -87,7 +88,8 @@ SparseUnorderedWithDupsReader<BitmapType>::SparseUnorderedWithDupsReader(
 
 template <class BitmapType>
 bool SparseUnorderedWithDupsReader<BitmapType>::incomplete() const {
-  return !read_state_.done_adding_result_tiles_ || !result_tiles_[0].empty();
+  return !read_state_.done_adding_result_tiles_ || !result_tiles_[0].empty() ||
+         (has_top_k() && !top_k_selected_);
 }
 
 template <class BitmapType>
@@ -117,34 +119,19 @@ Status SparseUnorderedWithDupsReader<BitmapType>::init() {
 
 template <class BitmapType>
 Status SparseUnorderedWithDupsReader<BitmapType>::initialize_memory_budget() {
-  bool found = false;
-  RETURN_NOT_OK(
-      config_.get<uint64_t>("sm.mem.total_budget", &memory_budget_, &found));
-  assert(found);
-
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_unordered_with_dups.ratio_array_data",
-      &memory_budget_ratio_array_data_,
-      &found));
-  assert(found);
-
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_unordered_with_dups.ratio_coords",
-      &memory_budget_ratio_coords_,
-      &found));
-  assert(found);
-
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_unordered_with_dups.ratio_query_condition",
-      &memory_budget_ratio_query_condition_,
-      &found));
-  assert(found);
-
-  RETURN_NOT_OK(config_.get<double>(
-      "sm.mem.reader.sparse_unordered_with_dups.ratio_tile_ranges",
-      &memory_budget_ratio_tile_ranges_,
-      &found));
-  assert(found);
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  memory_budget_ = config->mem_total_budget;
+  memory_budget_ratio_array_data_ =
+      config->sparse_unordered_with_dups.array_data;
+  memory_budget_ratio_coords_ = config->sparse_unordered_with_dups.coords;
+  memory_budget_ratio_query_condition_ =
+      config->sparse_unordered_with_dups.query_condition;
+  memory_budget_ratio_tile_ranges_ =
+      config->sparse_unordered_with_dups.tile_ranges;
+
+  // Reserve the budget from the context, which may shrink it.
+  RETURN_NOT_OK(reserve_memory_budget());
 
   return Status::Ok();
 }
@@ -167,6 +154,7 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
   // Handle empty array.
   if (fragment_metadata_.empty()) {
     read_state_.done_adding_result_tiles_ = true;
+    top_k_selected_ = true;
     return Status::Ok();
   }
 
@@ -189,6 +177,11 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
     // Create the result tiles we are going to process.
     RETURN_NOT_OK(create_result_tiles());
 
+    // All the tiles were scanned, read the top K cells.
+    if (result_tiles_[0].empty() && has_top_k() && !top_k_selected_) {
+      RETURN_NOT_OK(create_top_k_result_tiles());
+    }
+
     // No more tiles to process, done.
     if (result_tiles_[0].empty()) {
       assert(read_state_.done_adding_result_tiles_);
@@ -210,16 +203,44 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
     }
 
     if (!result_tiles_created.empty()) {
+      // Skip the tiles excluded by the query condition tile metadata.
+      RETURN_NOT_OK(skip_qc_tiles<BitmapType>(result_tiles_created));
+
+      // Skip the tiles in which no cell is sampled.
+      RETURN_NOT_OK(skip_unsampled_tiles<BitmapType>(result_tiles_created));
+
+      // Skip the tiles that cannot hold a top K cell.
+      RETURN_NOT_OK(skip_top_k_tiles<BitmapType>(result_tiles_created));
+
+      // Aggregate the tiles covered by the subarray without reading them.
+      std::vector<ResultTile*> covered_tiles;
+      RETURN_NOT_OK(
+          skip_covered_tiles<BitmapType>(result_tiles_created, &covered_tiles));
+
       // Read and unfilter coords.
       RETURN_NOT_OK(
-          read_and_unfilter_coords(subarray_.is_set(), result_tiles_created));
+          read_and_unfilter_coords(include_coords(), result_tiles_created));
 
       // Compute the tile bitmaps.
       RETURN_NOT_OK(compute_tile_bitmaps<BitmapType>(result_tiles_created));
+      report_memory_usage();
+
+      // Clear the cells overwritten by more recent fragments.
+      if (!array_schema_->allows_dups()) {
+        RETURN_NOT_OK(resolve_overwrites<BitmapType>(
+            memory_budget_ * memory_budget_ratio_coords_ / 2,
+            result_tiles_created));
+      }
 
       // Apply query condition.
       RETURN_NOT_OK(apply_query_condition<BitmapType>(result_tiles_created));
 
+      // Keep the sampled cells only.
+      RETURN_NOT_OK(apply_sample<BitmapType>(result_tiles_created));
+
+      // Keep the top K cells only.
+      RETURN_NOT_OK(apply_top_k_selection<BitmapType>(result_tiles_created));
+
       // Clear result tiles that are not necessary anymore.
       uint64_t current = 0;
       for (uint64_t i = 0; i < result_tiles_created.size(); i++) {
@@ -229,6 +250,10 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
         }
       }
       result_tiles_created.resize(current);
+      result_tiles_created.insert(
+          result_tiles_created.end(),
+          covered_tiles.begin(),
+          covered_tiles.end());
 
       // Clear result tiles that are not necessary anymore, part 2.
       auto it = result_tiles_[0].begin();
@@ -252,8 +277,14 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
       continue;
     }
 
-    // Copy tiles.
-    if (offsets_bitsize_ == 64) {
+    if (has_aggregates()) {
+      // Fold the tiles into the aggregates, no cells are copied.
+      RETURN_NOT_OK(process_aggregates(result_tiles_loaded));
+    } else if (has_top_k() && !top_k_selected_) {
+      // Select the top K cells, they are copied once all tiles are scanned.
+      RETURN_NOT_OK(process_top_k(result_tiles_loaded));
+    } else if (offsets_bitsize_ == 64) {
+      // Copy tiles.
       RETURN_NOT_OK(process_tiles<uint64_t>(names, result_tiles_loaded));
     } else {
       RETURN_NOT_OK(process_tiles<uint32_t>(names, result_tiles_loaded));
@@ -263,6 +294,11 @@ Status SparseUnorderedWithDupsReader<BitmapType>::dowork() {
     RETURN_NOT_OK(end_iteration());
   } while (!buffers_full_ && incomplete());
 
+  // Aggregate mode, there are no output buffers to fix.
+  if (has_aggregates()) {
+    return Status::Ok();
+  }
+
   // Fix the output buffer sizes.
   RETURN_NOT_OK(resize_output_buffers(cells_copied(names)));
 
@@ -277,6 +313,21 @@ template <class BitmapType>
 void SparseUnorderedWithDupsReader<BitmapType>::reset() {
 }
 
+template <class BitmapType>
+Status SparseUnorderedWithDupsReader<BitmapType>::rebind() {
+  if (!result_tiles_[0].empty())
+    return logger_->status(Status_SparseUnorderedWithDupsReaderError(
+        "Cannot rebind reader; The previous read is incomplete"));
+
+  return SparseIndexReaderBase::rebind();
+}
+
+template <class BitmapType>
+void SparseUnorderedWithDupsReader<BitmapType>::set_progress(
+    QueryProgress* progress) {
+  progress_ = progress;
+}
+
 template <class BitmapType>
 std::tuple<Status, std::optional<bool>>
 SparseUnorderedWithDupsReader<BitmapType>::add_result_tile(
@@ -289,7 +340,7 @@ SparseUnorderedWithDupsReader<BitmapType>::add_result_tile(
     const ArraySchema* const array_schema) {
   // Calculate memory consumption for this tile.
   auto&& [st, tiles_sizes] =
-      get_coord_tiles_size<BitmapType>(subarray_.is_set(), dim_num, f, t);
+      get_coord_tiles_size<BitmapType>(include_coords(), dim_num, f, t);
   RETURN_NOT_OK_TUPLE(st, std::nullopt);
   auto tiles_size = tiles_sizes->first;
   auto tiles_size_qc = tiles_sizes->second;
@@ -303,6 +354,7 @@ SparseUnorderedWithDupsReader<BitmapType>::add_result_tile(
   // Adjust memory usage.
   memory_used_for_coords_total_ += tiles_size;
   memory_used_qc_tiles_total_ += tiles_size_qc;
+  memory_used_bitmaps_total_ += get_tile_bitmap_size<BitmapType>(f, t);
 
   // Add the result tile.
   result_tiles_[0].emplace_back(f, t, array_schema);
@@ -324,8 +376,11 @@ Status SparseUnorderedWithDupsReader<BitmapType>::create_result_tiles() {
 
   const uint64_t memory_budget_qc_tiles =
       memory_budget_ * memory_budget_ratio_query_condition_;
-  const uint64_t memory_budget_coords =
-      memory_budget_ * memory_budget_ratio_coords_;
+  // Half of the coordinates budget is kept for the overlapping tiles read
+  // to resolve the overwritten cells.
+  const uint64_t memory_budget_coords = memory_budget_ *
+                                        memory_budget_ratio_coords_ /
+                                        (has_overwrites() ? 2 : 1);
 
   // Create result tiles.
   if (subarray_.is_set()) {
@@ -336,41 +391,35 @@ Status SparseUnorderedWithDupsReader<BitmapType>::create_result_tiles() {
       if (!all_tiles_loaded_[f]) {
         all_tiles_loaded_[f] = result_tile_ranges_[f].empty();
         while (!result_tile_ranges_[f].empty()) {
-          auto& range = result_tile_ranges_[f].back();
-          const auto last_t = result_tile_ranges_[f].front().second;
-
-          // Add all tiles for this range.
-          for (uint64_t t = range.first; t <= range.second; t++) {
-            auto&& [st, exceeded] = add_result_tile(
-                dim_num,
-                memory_budget_qc_tiles,
-                memory_budget_coords,
+          const auto t = result_tile_ranges_[f].front();
+          const auto last_t = result_tile_ranges_[f].back();
+
+          // Add the next tile.
+          auto&& [st, exceeded] = add_result_tile(
+              dim_num,
+              memory_budget_qc_tiles,
+              memory_budget_coords,
+              f,
+              t,
+              last_t,
+              fragment_metadata_[f]->array_schema());
+          RETURN_NOT_OK(st);
+
+          // Make sure we can add at least one tile.
+          if (*exceeded) {
+            TILEDB_LOG_DEBUG(
+                *logger_,
+                "Budget exceeded adding result tiles, fragment {0}, tile {1}",
                 f,
-                t,
-                last_t,
-                fragment_metadata_[f]->array_schema());
-            RETURN_NOT_OK(st);
-
-            // Make sure we can add at least one tile.
-            if (*exceeded) {
-              logger_->debug(
-                  "Budget exceeded adding result tiles, fragment {0}, tile {1}",
-                  f,
-                  t);
-              if (result_tiles_[0].empty())
-                return logger_->status(
-                    Status_SparseUnorderedWithDupsReaderError(
-                        "Cannot load a single tile, increase memory budget"));
-              budget_exceeded = true;
-              break;
-            }
-
-            range.first++;
+                t);
+            if (result_tiles_[0].empty())
+              return logger_->status(Status_SparseUnorderedWithDupsReaderError(
+                  "Cannot load a single tile, increase memory budget"));
+            budget_exceeded = true;
+            break;
           }
 
-          if (budget_exceeded)
-            break;
-          remove_result_tile_range(f);
+          consume_result_tile(f);
         }
       }
 
@@ -404,7 +453,8 @@ Status SparseUnorderedWithDupsReader<BitmapType>::create_result_tiles() {
           (void)st;
           // Make sure we can add at least one tile.
           if (*exceeded) {
-            logger_->debug(
+            TILEDB_LOG_DEBUG(
+                *logger_,
                 "Budget exceeded adding result tiles, fragment {0}, tile {1}",
                 f,
                 t);
@@ -426,12 +476,13 @@ Status SparseUnorderedWithDupsReader<BitmapType>::create_result_tiles() {
     done_adding_result_tiles &= all_tiles_loaded_[f] != 0;
   }
 
-  logger_->debug(
+  TILEDB_LOG_DEBUG(
+      *logger_,
       "Done adding result tiles, num result tiles {0}",
       result_tiles_[0].size());
 
   if (done_adding_result_tiles) {
-    logger_->debug("All result tiles loaded");
+    TILEDB_LOG_DEBUG(*logger_, "All result tiles loaded");
   }
 
   read_state_.done_adding_result_tiles_ = done_adding_result_tiles;
@@ -812,35 +863,39 @@ Status SparseUnorderedWithDupsReader<uint64_t>::copy_fixed_data_tile(
   const auto t = &std::get<0>(*tile_tuple);
   const auto src_buff = t->data_as<uint8_t>();
 
-  // Copy values.
-  if (!stores_zipped_coords) {
-    for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-      for (uint64_t i = 0; i < rt->bitmap_[c]; i++) {
-        memcpy(buffer, src_buff + c * cell_size, cell_size);
-        buffer += cell_size;
-      }
-    }
-  } else {  // Copy for zipped coords.
-    const auto dim_num = rt->domain()->dim_num();
-    for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-      for (uint64_t i = 0; i < rt->bitmap_[c]; i++) {
-        auto pos = c * dim_num + dim_idx;
-        memcpy(buffer, src_buff + pos * cell_size, cell_size);
-        buffer += cell_size;
+  const auto src_val_buff =
+      nullable ? std::get<2>(*tile_tuple).data_as<uint8_t>() : nullptr;
+  const auto dim_num = rt->domain()->dim_num();
+
+  // Go through the bitmap one run of equal counts at a time. Runs of single
+  // results are copied with one memcpy, skipped cells cost nothing.
+  for (uint64_t c = src_min_pos; c < src_max_pos;) {
+    const auto run_end = rt->bitmap_run_end(c, src_max_pos);
+    const auto count = rt->bitmap_[c];
+    if (count == 1 && !stores_zipped_coords) {
+      const auto length = run_end - c;
+      memcpy(buffer, src_buff + c * cell_size, length * cell_size);
+      buffer += length * cell_size;
+      if (nullable) {
+        memcpy(val_buffer, src_val_buff + c, length);
+        val_buffer += length;
       }
-    }
-  }
+    } else if (count != 0) {
+      for (; c < run_end; c++) {
+        const auto pos = stores_zipped_coords ? c * dim_num + dim_idx : c;
+        for (uint64_t i = 0; i < count; i++) {
+          memcpy(buffer, src_buff + pos * cell_size, cell_size);
+          buffer += cell_size;
+        }
 
-  // Copy nullable values.
-  if (nullable) {
-    const auto t_val = &std::get<2>(*tile_tuple);
-    const auto src_val_buff = t_val->data_as<uint8_t>();
-    for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-      for (uint64_t i = 0; i < rt->bitmap_[c]; i++) {
-        *val_buffer = src_val_buff[c];
-        val_buffer++;
+        if (nullable) {
+          memset(val_buffer, src_val_buff[c], count);
+          val_buffer += count;
+        }
       }
     }
+
+    c = run_end;
   }
 
   return Status::Ok();
@@ -868,68 +923,34 @@ Status SparseUnorderedWithDupsReader<uint8_t>::copy_fixed_data_tile(
 
   // 0 sized bitmap means full tile, full tile copy done below.
   if (rt->bitmap_.size() != 0) {
-    // Copy values.
-    if (!stores_zipped_coords) {
-      // Go through bitmap, when there is a hole in cell contiguity, do a
-      // memcpy.
-      uint64_t length = 0;
-      uint64_t start = src_min_pos;
-      for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-        if (rt->bitmap_[c]) {
-          length++;
-        } else {
-          if (length != 0) {
-            memcpy(buffer, src_buff + start * cell_size, length * cell_size);
-            buffer += length * cell_size;
-            length = 0;
-          }
-
-          start = c + 1;
-        }
-      }
-
-      // Do last memcpy.
-      if (length != 0) {
-        memcpy(buffer, src_buff + start * cell_size, length * cell_size);
-        buffer += length * cell_size;
-      }
-    } else {  // Copy for zipped coords.
-      const auto dim_num = rt->domain()->dim_num();
-      for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-        if (rt->bitmap_[c]) {
-          auto pos = c * dim_num + dim_idx;
-          memcpy(buffer, src_buff + pos * cell_size, cell_size);
-          buffer += cell_size;
-        }
-      }
-    }
+    const auto src_val_buff = nullable ? t_val->data_as<uint8_t>() : nullptr;
+    const auto dim_num = rt->domain()->dim_num();
 
-    // Copy nullable values.
-    if (nullable) {
-      // Go through bitmap, when there is a hole in cell contiguity, do a
-      // memcpy.
-      uint64_t length = 0;
-      uint64_t start = src_min_pos;
-      const auto src_val_buff = t_val->data_as<uint8_t>();
-      for (uint64_t c = src_min_pos; c < src_max_pos; c++) {
-        if (rt->bitmap_[c]) {
-          length++;
-        } else {
-          if (length != 0) {
-            memcpy(val_buffer, src_val_buff + start, length);
-            val_buffer += length;
-            length = 0;
+    // Go through the bitmap one run at a time, skipping the runs of unset
+    // cells and copying the runs of set cells with one memcpy.
+    for (uint64_t c = src_min_pos; c < src_max_pos;) {
+      const auto run_end = rt->bitmap_run_end(c, src_max_pos);
+      if (rt->bitmap_[c]) {
+        const auto length = run_end - c;
+        if (!stores_zipped_coords) {
+          memcpy(buffer, src_buff + c * cell_size, length * cell_size);
+          buffer += length * cell_size;
+        } else {  // Copy for zipped coords.
+          for (uint64_t i = c; i < run_end; i++) {
+            auto pos = i * dim_num + dim_idx;
+            memcpy(buffer, src_buff + pos * cell_size, cell_size);
+            buffer += cell_size;
           }
+        }
 
-          start = c + 1;
+        // Copy nullable values.
+        if (nullable) {
+          memcpy(val_buffer, src_val_buff + c, length);
+          val_buffer += length;
         }
       }
 
-      // Do last memcpy.
-      if (length != 0) {
-        memcpy(val_buffer, src_val_buff + start, length);
-        val_buffer += length;
-      }
+      c = run_end;
     }
   } else {  // Copy full tile.
     memcpy(
@@ -1005,7 +1026,8 @@ Status SparseUnorderedWithDupsReader<BitmapType>::copy_fixed_data_tiles(
                 max_pos_tile,
                 cell_offsets[i],
                 rt);
-        if (skip_copy) {
+        // Tiles unfiltered in place are already in the user buffers.
+        if (skip_copy || unfilter_dests_.count({rt, name}) != 0) {
           return Status::Ok();
         }
 
@@ -1136,9 +1158,9 @@ SparseUnorderedWithDupsReader<BitmapType>::respect_copy_memory_budget(
         const auto var_sized = array_schema_->var_size(name);
         auto mem_usage = &total_mem_usage_per_attr[i];
 
-        // For dimensions, when we have a subarray, tiles are already all
-        // loaded in memory.
-        if ((subarray_.is_set() && array_schema_->is_dim(name)) ||
+        // For dimensions, when the coordinates are loaded with the result
+        // tiles, tiles are already all loaded in memory.
+        if ((include_coords() && array_schema_->is_dim(name)) ||
             condition_.field_names().count(name) != 0)
           return Status::Ok();
 
@@ -1260,11 +1282,52 @@ SparseUnorderedWithDupsReader<BitmapType>::compute_var_size_offsets(
   return {buffers_full, new_var_buffer_size, new_result_tiles_size};
 }
 
+template <class BitmapType>
+void SparseUnorderedWithDupsReader<BitmapType>::compute_unfilter_dests(
+    const std::vector<std::string>& names,
+    const std::vector<ResultTile*>& result_tiles,
+    const std::vector<uint64_t>& cell_offsets) {
+  unfilter_dests_.clear();
+  for (uint64_t i = 0; i < result_tiles.size(); i++) {
+    // Only tiles without a bitmap have all their cells in the results. The
+    // first tile might have been partially copied in a previous iteration.
+    auto rt = (ResultTileWithBitmap<BitmapType>*)result_tiles[i];
+    const auto fragment = fragment_metadata_[rt->frag_idx()];
+    const auto cell_num = fragment->cell_num(rt->tile_idx());
+    if (!rt->bitmap_.empty() ||
+        cell_offsets[i + 1] - cell_offsets[i] != cell_num ||
+        (i == 0 && read_state_.frag_tile_idx_[rt->frag_idx()].second != 0)) {
+      continue;
+    }
+
+    for (const auto& name : names) {
+      // Dimensions are already loaded and attributes added by schema
+      // evolution are filled instead.
+      const auto cell_size = array_schema_->cell_size(name);
+      if (array_schema_->is_dim(name) || array_schema_->var_size(name) ||
+          !fragment->array_schema()->is_field(name) ||
+          fragment->tile_size(name, rt->tile_idx()) != cell_num * cell_size) {
+        continue;
+      }
+
+      auto& buffer = buffers_[name];
+      void* validity = array_schema_->is_nullable(name) ?
+                           buffer.validity_vector_.buffer() + cell_offsets[i] :
+                           nullptr;
+      unfilter_dests_[{rt, name}] = {
+          (uint8_t*)buffer.buffer_ + cell_offsets[i] * cell_size, validity};
+    }
+  }
+
+  stats_->add_counter("unfilter_in_place_num", unfilter_dests_.size());
+}
+
 template <class BitmapType>
 template <class OffType>
 Status SparseUnorderedWithDupsReader<BitmapType>::process_tiles(
     std::vector<std::string>& names, std::vector<ResultTile*>& result_tiles) {
   auto timer_se = stats_->start_timer("process_tiles");
+  set_progress_phase(QueryPhase::COPY_RESULTS);
 
   // Vector for storing the cell offsets of each tiles into the user buffers.
   // This also stores the last offset to facilitate calculations later on.
@@ -1293,13 +1356,19 @@ Status SparseUnorderedWithDupsReader<BitmapType>::process_tiles(
     num_range_threads = 1 + ((num_threads - 1) / result_tiles.size());
   }
 
+  // Tiles fully copied to the user buffers are unfiltered in place.
+  compute_unfilter_dests(names, result_tiles, cell_offsets);
+
   // Read a few attributes a a time.
   uint64_t buffer_idx = 0;
   while (buffer_idx < names.size()) {
     // Read and unfilter as many attributes as can fit in the budget.
     auto&& [st, index_to_copy] = read_and_unfilter_attributes(
         memory_budget, names, *mem_usage_per_attr, &buffer_idx, result_tiles);
-    RETURN_NOT_OK(st);
+    if (!st.ok()) {
+      unfilter_dests_.clear();
+      return st;
+    }
 
     // Copy one attribute at a time for buffers in memory.
     for (const auto& idx : *index_to_copy) {
@@ -1406,12 +1475,13 @@ Status SparseUnorderedWithDupsReader<BitmapType>::process_tiles(
         *query_buffer.validity_vector_.buffer_size() = total_cells;
 
       // Clear tiles from memory.
-      if (!subarray_.is_set() || !is_dim) {
+      if (!include_coords() || !is_dim) {
         clear_tiles(name, result_tiles);
       }
       result_tiles.resize(result_tiles_size);
     }
   }
+  unfilter_dests_.clear();
 
   // Compute the number of cells copied for the last tile before updating tile
   // index.
@@ -1449,7 +1519,219 @@ Status SparseUnorderedWithDupsReader<BitmapType>::process_tiles(
     frag_tile_idx.second = last_tile_cells_copied;
   }
 
-  logger_->debug("Done copying tiles");
+  TILEDB_LOG_DEBUG(*logger_, "Done copying tiles");
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseUnorderedWithDupsReader<BitmapType>::process_aggregates(
+    std::vector<ResultTile*>& result_tiles) {
+  auto timer_se = stats_->start_timer("process_aggregates");
+
+  // Tiles fully covered by the subarray and the query condition have an
+  // empty bitmap, they are answered from the tile metadata. When grouping,
+  // they must also lie within a single bucket.
+  std::vector<std::pair<unsigned, uint64_t>> metadata_tiles;
+  std::vector<ResultTile*> data_tiles;
+  std::vector<const std::vector<BitmapType>*> bitmaps;
+  std::vector<std::vector<BitmapType>> unpacked_bitmaps;
+  unpacked_bitmaps.reserve(result_tiles.size());
+  for (auto result_tile : result_tiles) {
+    auto rt = (ResultTileWithBitmap<BitmapType>*)result_tile;
+    if (rt->bitmap_.empty() && aggregates_have_tile_metadata(rt->frag_idx()) &&
+        (!has_aggregate_groups() ||
+         tile_bucket(rt->frag_idx(), rt->tile_idx()).has_value())) {
+      metadata_tiles.emplace_back(rt->frag_idx(), rt->tile_idx());
+    } else {
+      // Bit-packed bitmaps are aggregated with a byte per cell.
+      data_tiles.emplace_back(rt);
+      if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+        rt->bitmap_.unpack(&unpacked_bitmaps.emplace_back());
+        bitmaps.emplace_back(&unpacked_bitmaps.back());
+      } else {
+        bitmaps.emplace_back(&rt->bitmap_);
+      }
+    }
+  }
+
+  RETURN_NOT_OK(aggregate_tiles_metadata(metadata_tiles));
+
+  if (!data_tiles.empty()) {
+    // Read and unfilter the aggregated fields, the query condition fields
+    // were already loaded with the coordinates.
+    const auto condition_names = condition_.field_names();
+    std::vector<std::string> names_to_read;
+    for (auto& name : aggregate_field_names()) {
+      if (condition_names.count(name) == 0)
+        names_to_read.emplace_back(name);
+    }
+
+    RETURN_CANCEL_OR_ERROR(
+        read_attribute_tiles(names_to_read, data_tiles, true));
+    for (auto& name : names_to_read) {
+      RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, data_tiles, true));
+    }
+
+    // When grouping, the tiles that span more than one bucket are split
+    // using the coordinates of the grouped dimension, which are only read
+    // with the other coordinates when a subarray is set.
+    std::vector<std::string> coords_to_read;
+    std::vector<ResultTile*> multi_bucket_tiles;
+    if (has_aggregate_groups() && !include_coords()) {
+      coords_to_read.emplace_back(constants::coords);
+      if (std::find(
+              names_to_read.begin(), names_to_read.end(), group_by_dim_) ==
+          names_to_read.end())
+        coords_to_read.emplace_back(group_by_dim_);
+
+      for (auto rt : data_tiles) {
+        if (!tile_bucket(rt->frag_idx(), rt->tile_idx()).has_value())
+          multi_bucket_tiles.emplace_back(rt);
+      }
+    }
+
+    RETURN_CANCEL_OR_ERROR(
+        read_coordinate_tiles(coords_to_read, multi_bucket_tiles, true));
+    for (auto& name : coords_to_read) {
+      RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, multi_bucket_tiles, true));
+    }
+
+    RETURN_NOT_OK(aggregate_tiles<BitmapType>(data_tiles, bitmaps));
+
+    for (auto& name : names_to_read) {
+      clear_tiles(name, data_tiles);
+    }
+    for (auto& name : coords_to_read) {
+      clear_tiles(name, multi_bucket_tiles);
+    }
+  }
+
+  // All tiles were processed, they will be removed at the end of the
+  // iteration.
+  for (auto rt : result_tiles) {
+    read_state_.frag_tile_idx_[rt->frag_idx()] =
+        std::make_pair(rt->tile_idx() + 1, 0);
+  }
+
+  TILEDB_LOG_DEBUG(*logger_, "Done processing aggregates");
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseUnorderedWithDupsReader<BitmapType>::process_top_k(
+    std::vector<ResultTile*>& result_tiles) {
+  auto timer_se = stats_->start_timer("process_top_k");
+
+  // The tiles are processed by batches of one tile per thread, best bound
+  // first, so that the batches that follow the first ones are mostly
+  // skipped.
+  std::vector<ResultTile*> sorted_tiles = result_tiles;
+  RETURN_NOT_OK(top_k_->sort_tiles(fragment_metadata_, sorted_tiles));
+  const uint64_t batch_size = std::max<uint64_t>(
+      1, storage_manager_->compute_tp()->concurrency_level());
+
+  // The top K attribute is read unless it was already loaded with the query
+  // condition.
+  const auto& name = top_k_->field_name();
+  const bool loaded = condition_.field_names().count(name) != 0;
+  uint64_t skipped_num = 0;
+  for (uint64_t b = 0; b < sorted_tiles.size(); b += batch_size) {
+    std::vector<ResultTile*> batch;
+    for (uint64_t t = b; t < std::min(b + batch_size, sorted_tiles.size());
+         t++) {
+      auto rt = sorted_tiles[t];
+      auto&& [st, skip] = top_k_->can_skip_tile(
+          fragment_metadata_[rt->frag_idx()].get(), rt->tile_idx());
+      RETURN_NOT_OK(st);
+      if (*skip) {
+        skipped_num++;
+      } else {
+        batch.emplace_back(rt);
+      }
+    }
+
+    if (batch.empty())
+      continue;
+
+    if (!loaded) {
+      RETURN_CANCEL_OR_ERROR(read_attribute_tiles({name}, batch, true));
+      RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, batch, true));
+    }
+
+    // Each tile is added to a partial selection that is then merged into
+    // the top K.
+    std::mutex top_k_mtx;
+    auto status = parallel_for(
+        storage_manager_->compute_tp(), 0, batch.size(), [&](uint64_t t) {
+          auto rt = (ResultTileWithBitmap<BitmapType>*)batch[t];
+          const auto cell_num =
+              fragment_metadata_[rt->frag_idx()]->cell_num(rt->tile_idx());
+
+          QueryTopK partial(*top_k_);
+          partial.reset();
+          if constexpr (std::is_same<BitmapType, uint8_t>::value) {
+            std::vector<uint8_t> bitmap;
+            rt->bitmap_.unpack(&bitmap);
+            RETURN_NOT_OK(partial.add_tile(rt, cell_num, bitmap));
+          } else {
+            RETURN_NOT_OK(partial.add_tile(rt, cell_num, rt->bitmap_));
+          }
+
+          std::unique_lock<std::mutex> lck(top_k_mtx);
+          top_k_->merge(partial);
+          return Status::Ok();
+        });
+    RETURN_NOT_OK_ELSE(status, logger_->status(status));
+
+    if (!loaded) {
+      clear_tiles(name, batch);
+    }
+  }
+  stats_->add_counter("top_k_skipped_tile_num", skipped_num);
+
+  // All tiles were processed, they will be removed at the end of the
+  // iteration.
+  for (auto rt : result_tiles) {
+    read_state_.frag_tile_idx_[rt->frag_idx()] =
+        std::make_pair(rt->tile_idx() + 1, 0);
+  }
+
+  TILEDB_LOG_DEBUG(*logger_, "Done selecting top K cells");
+  return Status::Ok();
+}
+
+template <class BitmapType>
+Status SparseUnorderedWithDupsReader<BitmapType>::create_top_k_result_tiles() {
+  auto timer_se = stats_->start_timer("create_top_k_result_tiles");
+  top_k_selected_ = true;
+
+  // The tiles are read again from the start.
+  for (auto& frag_tile_idx : read_state_.frag_tile_idx_) {
+    frag_tile_idx = std::make_pair(0, 0);
+  }
+
+  // The selected cells are sorted by fragment and tile, and there are at
+  // most K tiles, which are added regardless of the memory budget.
+  const auto dim_num = array_schema_->dim_num();
+  const auto uint64_t_max = std::numeric_limits<uint64_t>::max();
+  for (const auto& cell : top_k_->cells()) {
+    auto& positions = top_k_cells_[{cell.frag_idx_, cell.tile_idx_}];
+    if (positions.empty()) {
+      auto&& [st, exceeded] = add_result_tile(
+          dim_num,
+          uint64_t_max,
+          uint64_t_max,
+          cell.frag_idx_,
+          cell.tile_idx_,
+          cell.tile_idx_,
+          fragment_metadata_[cell.frag_idx_]->array_schema());
+      RETURN_NOT_OK(st);
+      assert(!*exceeded);
+    }
+    positions.emplace_back(cell.pos_);
+  }
+
+  stats_->add_counter("top_k_tile_num", top_k_cells_.size());
   return Status::Ok();
 }
 
@@ -1460,7 +1742,7 @@ Status SparseUnorderedWithDupsReader<BitmapType>::remove_result_tile(
   // Remove coord tile size from memory budget.
   const auto tile_idx = rt->tile_idx();
   auto&& [st, tiles_sizes] = get_coord_tiles_size<BitmapType>(
-      subarray_.is_set(), array_schema_->dim_num(), frag_idx, tile_idx);
+      include_coords(), array_schema_->dim_num(), frag_idx, tile_idx);
   RETURN_NOT_OK(st);
   auto tiles_size = tiles_sizes->first;
   auto tiles_size_qc = tiles_sizes->second;
@@ -1469,9 +1751,12 @@ Status SparseUnorderedWithDupsReader<BitmapType>::remove_result_tile(
     std::unique_lock<std::mutex> lck(mem_budget_mtx_);
     memory_used_for_coords_total_ -= tiles_size;
     memory_used_qc_tiles_total_ -= tiles_size_qc;
+    memory_used_bitmaps_total_ -=
+        get_tile_bitmap_size<BitmapType>(frag_idx, tile_idx);
   }
 
-  // Delete the tile.
+  // Delete the tile, recycling its buffers.
+  rt->recycle_tiles(tile_buffer_pool_.get());
   result_tiles_[0].erase(rt);
 
   return Status::Ok();
@@ -1496,9 +1781,13 @@ Status SparseUnorderedWithDupsReader<BitmapType>::end_iteration() {
     assert(memory_used_result_tile_ranges_ == 0);
   }
 
-  logger_->debug(
+  TILEDB_LOG_DEBUG(
+      *logger_,
       "Done with iteration, num result tiles {0}", result_tiles_[0].size());
 
+  memory_used_attribute_tiles_ = 0;
+  report_memory_usage();
+
   const auto uint64_t_max = std::numeric_limits<uint64_t>::max();
   array_memory_tracker_->set_budget(uint64_t_max);
   return Status::Ok();
@@ -55,7 +55,11 @@ namespace sm {
 class Array;
 class StorageManager;
 
-/** Processes sparse unordered with duplicates read queries. */
+/**
+ * Processes sparse unordered read queries. For arrays that do not allow
+ * duplicates, the cells overwritten by more recent fragments are cleared from
+ * the tile bitmaps, tile by tile.
+ */
 template <class BitmapType>
 class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
                                       public IQueryStrategy {
@@ -157,6 +161,12 @@ class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
   /** Resets the reader object. */
   void reset();
 
+  /** Prepares the reader to run again over a new subarray. */
+  Status rebind();
+
+  /** Sets the progress to update as the query is processed. */
+  void set_progress(QueryProgress* progress);
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -172,6 +182,15 @@ class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /**
+   * Returns true if the coordinate tiles are loaded with the result tiles,
+   * which is needed to compute the tile bitmaps of a subarray and to resolve
+   * the overwritten cells.
+   */
+  bool include_coords() const {
+    return subarray_.is_set() || has_overwrites();
+  }
+
   /**
    * Add a result tile to process, making sure maximum budget is respected.
    *
@@ -201,6 +220,14 @@ class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
    */
   Status create_result_tiles();
 
+  /**
+   * Once all the tiles were scanned for the top K cells, creates the result
+   * tiles holding them so that they are read again and copied.
+   *
+   * @return Status.
+   */
+  Status create_top_k_result_tiles();
+
   /**
    * Compute parallelization parameters for a tile copy operation.
    *
@@ -393,6 +420,21 @@ class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
       const std::vector<std::string>& names,
       std::vector<ResultTile*>& result_tiles);
 
+  /**
+   * Computes the user buffer regions that fixed-sized attribute tiles can be
+   * unfiltered into directly, storing them in `unfilter_dests_`. This is the
+   * case for tiles whose cells are all results and are all copied in this
+   * iteration.
+   *
+   * @param names Attribute/dimensions to compute for.
+   * @param result_tiles The result tiles to process.
+   * @param cell_offsets Cell offset per result tile.
+   */
+  void compute_unfilter_dests(
+      const std::vector<std::string>& names,
+      const std::vector<ResultTile*>& result_tiles,
+      const std::vector<uint64_t>& cell_offsets);
+
   /**
    * Make sure we respect memory budget for copy operation by making sure that,
    * for all attributes to be copied, the size of tiles in memory can fit into
@@ -422,6 +464,25 @@ class SparseUnorderedWithDupsReader : public SparseIndexReaderBase,
   Status process_tiles(
       std::vector<std::string>& names, std::vector<ResultTile*>& result_tiles);
 
+  /**
+   * Fold tiles into the aggregates. Fully covered tiles are answered from
+   * the tile metadata, the others are read and unfiltered.
+   *
+   * @param result_tiles The result tiles to process.
+   *
+   * @return Status.
+   */
+  Status process_aggregates(std::vector<ResultTile*>& result_tiles);
+
+  /**
+   * Adds the cells of the tiles to the top K selection, no cell is copied.
+   *
+   * @param result_tiles The result tiles to process.
+   *
+   * @return Status.
+   */
+  Status process_top_k(std::vector<ResultTile*>& result_tiles);
+
   /**
    * Remove a result tile from memory
    *
@@ -35,6 +35,7 @@
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/query/query_progress.h"
 
 namespace tiledb {
 namespace sm {
@@ -62,7 +63,8 @@ StrategyBase::StrategyBase(
     , subarray_(subarray)
     , offsets_format_mode_(Config::SM_OFFSETS_FORMAT_MODE)
     , offsets_extra_element_(false)
-    , offsets_bitsize_(constants::cell_var_offset_size * 8) {
+    , offsets_bitsize_(constants::cell_var_offset_size * 8)
+    , progress_(nullptr) {
   if (array != nullptr) {
     array_schema_ = array->array_schema_latest();
   }
@@ -105,6 +107,11 @@ void StrategyBase::get_dim_attr_stats() const {
   }
 }
 
+void StrategyBase::set_progress_phase(QueryPhase phase) const {
+  if (progress_ != nullptr)
+    progress_->set_phase(phase);
+}
+
 std::string StrategyBase::offsets_mode() const {
   return offsets_format_mode_;
 }
@@ -44,6 +44,8 @@ namespace sm {
 class Array;
 class ArraySchema;
 enum class Layout : uint8_t;
+enum class QueryPhase : uint8_t;
+class QueryProgress;
 class StorageManager;
 class Subarray;
 class QueryBuffer;
@@ -142,6 +144,9 @@ class StrategyBase {
   /** The offset bitsize used for variable-sized attributes. */
   uint32_t offsets_bitsize_;
 
+  /** The progress of the query, if tracked. */
+  QueryProgress* progress_;
+
   /* ********************************* */
   /*          PROTECTED METHODS        */
   /* ********************************* */
@@ -151,6 +156,9 @@ class StrategyBase {
    * the query.
    */
   void get_dim_attr_stats() const;
+
+  /** Enters a phase in the progress of the query, if tracked. */
+  void set_progress_phase(QueryPhase phase) const;
 };
 
 }  // namespace sm
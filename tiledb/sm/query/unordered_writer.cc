@@ -34,6 +34,7 @@
 #include "tiledb/common/common.h"
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger.h"
+#include "tiledb/common/stdx_string.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
@@ -43,9 +44,11 @@
 #include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/math.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
 #include "tiledb/sm/misc/time.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
+#include "tiledb/sm/query/global_order_writer.h"
 #include "tiledb/sm/query/hilbert_order.h"
 #include "tiledb/sm/query/query_macros.h"
 #include "tiledb/sm/stats/global_stats.h"
@@ -54,6 +57,11 @@
 #include "tiledb/sm/tile/tile_metadata_generator.h"
 #include "tiledb/sm/tile/writer_tile.h"
 
+#include <numeric>
+#include <queue>
+#include <string_view>
+#include <unordered_set>
+
 using namespace tiledb;
 using namespace tiledb::common;
 using namespace tiledb::sm::stats;
@@ -61,6 +69,60 @@ using namespace tiledb::sm::stats;
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * Calls `f` with a value of the type of the input integer datatype, which
+ * includes the datetime and time datatypes.
+ *
+ * @return false if the datatype is not an integer datatype.
+ */
+template <class F>
+bool apply_with_integer_type(const Datatype type, const F& f) {
+  switch (type) {
+    case Datatype::INT8:
+      f(int8_t());
+      return true;
+    case Datatype::UINT8:
+      f(uint8_t());
+      return true;
+    case Datatype::INT16:
+      f(int16_t());
+      return true;
+    case Datatype::UINT16:
+      f(uint16_t());
+      return true;
+    case Datatype::INT32:
+      f(int32_t());
+      return true;
+    case Datatype::UINT32:
+      f(uint32_t());
+      return true;
+    case Datatype::INT64:
+      f(int64_t());
+      return true;
+    case Datatype::UINT64:
+      f(uint64_t());
+      return true;
+    default:
+      if (datatype_is_datetime(type) || datatype_is_time(type)) {
+        f(int64_t());
+        return true;
+      }
+      return false;
+  }
+}
+
+/** Returns the number of bits needed to store the input value. */
+unsigned bit_width(uint64_t v) {
+  unsigned bits = 0;
+  for (; v != 0; v >>= 1)
+    bits++;
+  return bits;
+}
+
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -90,16 +152,53 @@ UnorderedWriter::UnorderedWriter(
           written_fragment_info,
           disable_check_global_order,
           coords_info,
-          fragment_uri) {
+          fragment_uri)
+    , dedup_coords_hash_(false)
+    , spill_budget_(0)
+    , packed_fragment_max_size_(0) {
 }
 
 UnorderedWriter::~UnorderedWriter() {
+  spill_clean_up();
 }
 
 /* ****************************** */
 /*               API              */
 /* ****************************** */
 
+Status UnorderedWriter::init() {
+  bool found = false;
+  auto dedup_coords_method = config_.get("sm.dedup_coords_method", &found);
+  assert(found);
+  dedup_coords_hash_ = dedup_coords_method == "hash";
+
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.mem.writer.unordered.spill_budget", &spill_budget_, &found));
+  assert(found);
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.packed_fragment_max_size", &packed_fragment_max_size_, &found));
+  assert(found);
+  if (spill_budget_ > 0 && spill_uri_.is_invalid()) {
+    std::string spill_path =
+        config_.get("sm.mem.writer.unordered.spill_path", &found);
+    assert(found);
+    if (spill_path.empty()) {
+#ifdef _WIN32
+      const char* tmp_dir = getenv("TEMP");
+      spill_path = tmp_dir != nullptr ? tmp_dir : ".";
+#else
+      const char* tmp_dir = getenv("TMPDIR");
+      spill_path = tmp_dir != nullptr ? tmp_dir : "/tmp";
+#endif
+    }
+    std::string uuid;
+    RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
+    spill_uri_ = URI(spill_path).join_path("__unordered_spill_" + uuid);
+  }
+
+  return WriterBase::init();
+}
+
 Status UnorderedWriter::dowork() {
   get_dim_attr_stats();
 
@@ -111,7 +210,10 @@ Status UnorderedWriter::dowork() {
   if (check_coord_oob_)
     RETURN_NOT_OK(check_coord_oob());
 
-  RETURN_NOT_OK(unordered_write());
+  if (spill_budget_ > 0)
+    RETURN_NOT_OK(spill_run());
+  else
+    RETURN_NOT_OK(unordered_write());
 
   return Status::Ok();
 }
@@ -119,6 +221,12 @@ Status UnorderedWriter::dowork() {
 Status UnorderedWriter::finalize() {
   auto timer_se = stats_->start_timer("finalize");
 
+  if (!spill_runs_.empty()) {
+    auto st = spill_merge();
+    spill_clean_up();
+    RETURN_NOT_OK(st);
+  }
+
   return Status::Ok();
 }
 
@@ -228,6 +336,16 @@ Status UnorderedWriter::check_coord_dups(
 }
 
 void UnorderedWriter::clean_up(const URI& uri) {
+  if (utils::parse::ends_with(
+          uri.to_string(), constants::packed_fragment_suffix)) {
+    storage_manager_->discard_packed_fragment(uri);
+    bool is_file = false;
+    storage_manager_->vfs()->is_file(uri, &is_file);
+    if (is_file)
+      storage_manager_->vfs()->remove_file(uri);
+    return;
+  }
+
   storage_manager_->vfs()->remove_dir(uri);
 }
 
@@ -324,6 +442,134 @@ Status UnorderedWriter::compute_coord_dups(
   return Status::Ok();
 }
 
+Status UnorderedWriter::dedup_coords_hash(
+    std::vector<uint64_t>* cell_pos) const {
+  auto timer_se = stats_->start_timer("dedup_coords_hash");
+
+  if (!coords_info_.has_coords_) {
+    return logger_->status(
+        Status_WriterError("Cannot check for coordinate duplicates; "
+                           "Coordinates buffer not found"));
+  }
+
+  // Prepare auxiliary vectors for better performance
+  auto dim_num = array_schema_->dim_num();
+  auto cell_num = coords_info_.coords_num_;
+  std::vector<const unsigned char*> buffs(dim_num);
+  std::vector<uint64_t> coord_sizes(dim_num);
+  std::vector<const unsigned char*> buffs_var(dim_num);
+  std::vector<uint64_t*> buffs_var_sizes(dim_num);
+  std::vector<bool> var_size(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    const auto& dim_name = array_schema_->dimension(d)->name();
+    buffs[d] = (const unsigned char*)buffers_.find(dim_name)->second.buffer_;
+    coord_sizes[d] = array_schema_->cell_size(dim_name);
+    buffs_var[d] =
+        (const unsigned char*)buffers_.find(dim_name)->second.buffer_var_;
+    buffs_var_sizes[d] = buffers_.find(dim_name)->second.buffer_var_size_;
+    var_size[d] = array_schema_->dimension(d)->var_size();
+  }
+
+  // Returns the coordinate of a cell on a dimension.
+  auto coord = [&](uint64_t c, unsigned d) {
+    if (!var_size[d]) {
+      return std::string_view(
+          (const char*)buffs[d] + c * coord_sizes[d], coord_sizes[d]);
+    }
+
+    auto offs = (const uint64_t*)buffs[d];
+    auto end = (c == cell_num - 1) ? *(buffs_var_sizes[d]) : offs[c + 1];
+    return std::string_view(
+        (const char*)buffs_var[d] + offs[c], end - offs[c]);
+  };
+
+  // Hash the coordinates of all cells
+  auto compute_tp = storage_manager_->compute_tp();
+  std::vector<uint64_t> hashes(cell_num);
+  RETURN_NOT_OK(parallel_for(compute_tp, 0, cell_num, [&](uint64_t c) {
+    uint64_t hash = 0;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      hash ^= std::hash<std::string_view>()(coord(c, d)) +
+              0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    }
+    hashes[c] = hash;
+    return Status::Ok();
+  }));
+
+  // Partition the cells on their hash, keeping them in increasing order in
+  // each partition. Each chunk of cells counts its cells per partition
+  // first, so that all chunks can then be scattered in parallel.
+  const uint64_t partition_num =
+      std::max<uint64_t>(1, compute_tp->concurrency_level());
+  const uint64_t chunk_num = std::min<uint64_t>(
+      partition_num, std::max<uint64_t>(1, cell_num / 65536));
+  const uint64_t chunk_size = utils::math::ceil(cell_num, chunk_num);
+  std::vector<std::vector<uint64_t>> counts(
+      chunk_num, std::vector<uint64_t>(partition_num, 0));
+  RETURN_NOT_OK(parallel_for(compute_tp, 0, chunk_num, [&](uint64_t k) {
+    auto end = std::min(cell_num, (k + 1) * chunk_size);
+    for (uint64_t c = k * chunk_size; c < end; ++c)
+      counts[k][hashes[c] % partition_num]++;
+    return Status::Ok();
+  }));
+
+  std::vector<uint64_t> partition_start(partition_num + 1, 0);
+  uint64_t offset = 0;
+  for (uint64_t p = 0; p < partition_num; ++p) {
+    partition_start[p] = offset;
+    for (uint64_t k = 0; k < chunk_num; ++k) {
+      auto count = counts[k][p];
+      counts[k][p] = offset;
+      offset += count;
+    }
+  }
+  partition_start[partition_num] = offset;
+
+  std::vector<uint64_t> partitioned(cell_num);
+  RETURN_NOT_OK(parallel_for(compute_tp, 0, chunk_num, [&](uint64_t k) {
+    auto end = std::min(cell_num, (k + 1) * chunk_size);
+    for (uint64_t c = k * chunk_size; c < end; ++c)
+      partitioned[counts[k][hashes[c] % partition_num]++] = c;
+    return Status::Ok();
+  }));
+
+  // Find the duplicates of each partition with a hash table, the first
+  // occurrence of each coordinates is inserted first
+  std::vector<uint8_t> is_dup(cell_num, 0);
+  RETURN_NOT_OK(parallel_for(compute_tp, 0, partition_num, [&](uint64_t p) {
+    auto cell_hash = [&](uint64_t c) { return hashes[c]; };
+    auto cell_equal = [&](uint64_t a, uint64_t b) {
+      for (unsigned d = 0; d < dim_num; ++d) {
+        if (coord(a, d) != coord(b, d))
+          return false;
+      }
+      return true;
+    };
+    std::unordered_set<uint64_t, decltype(cell_hash), decltype(cell_equal)>
+        cells(
+            partition_start[p + 1] - partition_start[p],
+            cell_hash,
+            cell_equal);
+    for (uint64_t i = partition_start[p]; i < partition_start[p + 1]; ++i) {
+      auto c = partitioned[i];
+      if (!cells.insert(c).second)
+        is_dup[c] = 1;
+    }
+    return Status::Ok();
+  }));
+
+  // Keep the cells that are not duplicates
+  cell_pos->clear();
+  cell_pos->reserve(cell_num);
+  for (uint64_t c = 0; c < cell_num; ++c) {
+    if (!is_dup[c])
+      cell_pos->push_back(c);
+  }
+  stats_->add_counter("dedup_coords_hash_dup_num", cell_num - cell_pos->size());
+
+  return Status::Ok();
+}
+
 Status UnorderedWriter::prepare_tiles(
     const std::vector<uint64_t>& cell_pos,
     const std::set<uint64_t>& coord_dups,
@@ -574,9 +820,131 @@ Status UnorderedWriter::prepare_tiles_var(
   return Status::Ok();
 }
 
+std::optional<unsigned> UnorderedWriter::compute_global_order_keys(
+    const std::vector<const QueryBuffer*>& buffs,
+    std::vector<uint64_t>* keys) const {
+  // For easy reference
+  auto domain = array_schema_->domain();
+  const auto dim_num = array_schema_->dim_num();
+  const auto cell_num = coords_info_.coords_num_;
+  if (cell_num == 0)
+    return std::nullopt;
+
+  // The tile extent of each dimension (0 if absent), and the minimum and
+  // maximum positions of the written coordinates from the domain low value.
+  std::vector<uint64_t> extents(dim_num, 0);
+  std::vector<uint64_t> min_pos(dim_num);
+  std::vector<uint64_t> max_pos(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain->dimension(d);
+    bool integer = apply_with_integer_type(dim->type(), [&](auto t) {
+      using T = decltype(t);
+      using unsigned_t = typename std::make_unsigned<T>::type;
+      const auto low = (unsigned_t)((const T*)dim->domain().data())[0];
+      if (dim->tile_extent())
+        extents[d] = (unsigned_t)dim->tile_extent().rvalue_as<T>();
+
+      auto coords = (const T*)buffs[d]->buffer_;
+      uint64_t min = std::numeric_limits<uint64_t>::max(), max = 0;
+      for (uint64_t i = 0; i < cell_num; ++i) {
+        const uint64_t pos = (unsigned_t)((unsigned_t)coords[i] - low);
+        min = std::min(min, pos);
+        max = std::max(max, pos);
+      }
+      min_pos[d] = min;
+      max_pos[d] = max;
+    });
+    if (!integer || dim->var_size())
+      return std::nullopt;
+  }
+
+  // The key fields, from the most significant. A tile field stores the tile
+  // index from the first written tile. A cell field stores the position in
+  // the tile, or the position from the minimum coordinate when all the cells
+  // are in the same tile on that dimension.
+  struct KeyField {
+    unsigned dim_;
+    bool tile_;
+    unsigned bits_;
+    unsigned shift_;
+  };
+  std::vector<KeyField> fields;
+  auto tiled = [&](unsigned d) {
+    return extents[d] != 0 &&
+           max_pos[d] / extents[d] != min_pos[d] / extents[d];
+  };
+  for (unsigned i = 0; i < dim_num; ++i) {
+    const unsigned d =
+        domain->tile_order() == Layout::ROW_MAJOR ? i : dim_num - i - 1;
+    if (tiled(d)) {
+      fields.push_back(
+          {d,
+           true,
+           bit_width(max_pos[d] / extents[d] - min_pos[d] / extents[d]),
+           0});
+    }
+  }
+  for (unsigned i = 0; i < dim_num; ++i) {
+    const unsigned d =
+        domain->cell_order() == Layout::ROW_MAJOR ? i : dim_num - i - 1;
+    fields.push_back(
+        {d,
+         false,
+         tiled(d) ? bit_width(extents[d] - 1) :
+                    bit_width(max_pos[d] - min_pos[d]),
+         0});
+  }
+
+  unsigned key_bits = 0;
+  for (auto it = fields.rbegin(); it != fields.rend(); ++it) {
+    it->shift_ = key_bits;
+    key_bits += it->bits_;
+    if (key_bits > 64)
+      return std::nullopt;
+  }
+
+  // Pack the fields.
+  keys->assign(cell_num, 0);
+  for (const auto& field : fields) {
+    if (field.bits_ == 0)
+      continue;
+
+    const auto d = field.dim_;
+    auto dim = domain->dimension(d);
+    apply_with_integer_type(dim->type(), [&](auto t) {
+      using T = decltype(t);
+      using unsigned_t = typename std::make_unsigned<T>::type;
+      const auto low = (unsigned_t)((const T*)dim->domain().data())[0];
+      auto coords = (const T*)buffs[d]->buffer_;
+      const auto extent = extents[d];
+      const bool tiled_dim = tiled(d);
+      const uint64_t min_tile = tiled_dim ? min_pos[d] / extent : 0;
+      auto st = parallel_for(
+          storage_manager_->compute_tp(), 0, cell_num, [&](uint64_t i) {
+            const uint64_t pos = (unsigned_t)((unsigned_t)coords[i] - low);
+            uint64_t value;
+            if (field.tile_) {
+              value = pos / extent - min_tile;
+            } else {
+              value = tiled_dim ? pos % extent : pos - min_pos[d];
+            }
+            (*keys)[i] |= value << field.shift_;
+            return Status::Ok();
+          });
+      assert(st.ok());
+      (void)st;
+    });
+  }
+
+  return key_bits;
+}
+
 Status UnorderedWriter::sort_coords(std::vector<uint64_t>* cell_pos) const {
   auto timer_se = stats_->start_timer("sort_coords");
 
+  if (cell_pos->empty())
+    return Status::Ok();
+
   // For easy reference
   auto domain = array_schema_->domain();
   auto cell_order = array_schema_->cell_order();
@@ -589,26 +957,530 @@ Status UnorderedWriter::sort_coords(std::vector<uint64_t>* cell_pos) const {
     buffs[d] = &(buffers_.find(dim_name)->second);
   }
 
-  // Populate cell_pos
-  cell_pos->resize(coords_info_.coords_num_);
-  for (uint64_t i = 0; i < coords_info_.coords_num_; ++i)
-    (*cell_pos)[i] = i;
+  // The keys are computed for all the cells, keep the ones of the cells to
+  // sort when some cells were left out
+  auto compute_tp = storage_manager_->compute_tp();
+  auto gather = [&](std::vector<uint64_t>* values) {
+    if (cell_pos->size() == values->size())
+      return Status::Ok();
+    std::vector<uint64_t> cell_values(cell_pos->size());
+    RETURN_NOT_OK(
+        parallel_for(compute_tp, 0, cell_pos->size(), [&](uint64_t i) {
+          cell_values[i] = (*values)[(*cell_pos)[i]];
+          return Status::Ok();
+        }));
+    values->swap(cell_values);
+    return Status::Ok();
+  };
 
   // Sort the coordinates in global order
-  if (cell_order != Layout::HILBERT) {  // Row- or col-major
-    parallel_sort(
-        storage_manager_->compute_tp(),
-        cell_pos->begin(),
-        cell_pos->end(),
-        GlobalCmp(domain, &buffs));
-  } else {  // Hilbert order
+  if (!layout_is_curve(cell_order)) {  // Row- or col-major
+    std::vector<uint64_t> keys;
+    auto key_bits = compute_global_order_keys(buffs, &keys);
+    if (key_bits.has_value()) {
+      RETURN_NOT_OK(gather(&keys));
+      parallel_radix_sort(compute_tp, &keys, cell_pos, *key_bits);
+    } else {
+      with_global_cmp<TypedGlobalCmp>(
+          domain, &buffs, GlobalCmp(domain, &buffs), [&](const auto& cmp) {
+            parallel_sort(compute_tp, cell_pos->begin(), cell_pos->end(), cmp);
+          });
+    }
+  } else {  // Hilbert or Morton order
     std::vector<uint64_t> hilbert_values(coords_info_.coords_num_);
     RETURN_NOT_OK(calculate_hilbert_values(buffs, &hilbert_values));
-    parallel_sort(
-        storage_manager_->compute_tp(),
-        cell_pos->begin(),
-        cell_pos->end(),
-        HilbertCmp(domain, &buffs, &hilbert_values));
+    RETURN_NOT_OK(gather(&hilbert_values));
+    const uint64_t max_hilbert_value =
+        *std::max_element(hilbert_values.begin(), hilbert_values.end());
+    parallel_radix_sort(
+        compute_tp, &hilbert_values, cell_pos, bit_width(max_hilbert_value));
+
+    // Order the cells with the same Hilbert value on the cell order.
+    const auto cell_num = cell_pos->size();
+    for (uint64_t i = 0, j = 0; i < cell_num; i = j) {
+      for (j = i + 1;
+           j < cell_num && hilbert_values[j] == hilbert_values[i];
+           j++) {
+      }
+
+      if (j - i > 1) {
+        std::sort(
+            cell_pos->begin() + i,
+            cell_pos->begin() + j,
+            [&](uint64_t a, uint64_t b) {
+              return domain->cell_order_cmp(buffs, a, b) == -1;
+            });
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
+void UnorderedWriter::spill_append(
+    const SpillCells& src,
+    const std::vector<uint64_t>& pos,
+    SpillCells* dst) const {
+  if (pos.empty())
+    return;
+
+  dst->fields_.resize(spill_fields_.size());
+  for (size_t f = 0; f < spill_fields_.size(); ++f) {
+    const auto& name = spill_fields_[f];
+    const auto& in = src.fields_[f];
+    auto& out = dst->fields_[f];
+    const auto fixed_size = out.fixed_.size();
+    if (array_schema_->var_size(name)) {
+      auto in_offsets = (const uint64_t*)in.fixed_.data();
+      out.fixed_.resize(fixed_size + pos.size() * sizeof(uint64_t));
+      auto out_offsets = (uint64_t*)(out.fixed_.data() + fixed_size);
+      for (uint64_t i = 0; i < pos.size(); ++i) {
+        const auto p = pos[i];
+        const auto start = in_offsets[p];
+        const auto end =
+            p + 1 < src.cell_num_ ? in_offsets[p + 1] : in.var_.size();
+        out_offsets[i] = out.var_.size();
+        out.var_.insert(
+            out.var_.end(), in.var_.begin() + start, in.var_.begin() + end);
+      }
+    } else {
+      const auto cell_size = array_schema_->cell_size(name);
+      out.fixed_.resize(fixed_size + pos.size() * cell_size);
+      for (uint64_t i = 0; i < pos.size(); ++i) {
+        std::memcpy(
+            &out.fixed_[fixed_size + i * cell_size],
+            &in.fixed_[pos[i] * cell_size],
+            cell_size);
+      }
+    }
+
+    if (array_schema_->is_nullable(name)) {
+      for (const auto p : pos)
+        out.validity_.push_back(in.validity_[p]);
+    }
+  }
+  dst->cell_num_ += pos.size();
+}
+
+void UnorderedWriter::spill_clean_up() {
+  if (spill_runs_.empty())
+    return;
+
+  storage_manager_->vfs()->remove_dir(spill_uri_);
+  spill_runs_.clear();
+}
+
+Status UnorderedWriter::spill_load(SpillRun* run, uint64_t cell_num) const {
+  auto vfs = storage_manager_->vfs();
+  const auto first = run->next_cell_;
+  const auto end = first + cell_num;
+  auto& window = run->window_;
+  window.fields_.resize(spill_fields_.size());
+  for (size_t f = 0; f < spill_fields_.size(); ++f) {
+    const auto& name = spill_fields_[f];
+    const auto prefix = std::to_string(f);
+    auto& field = window.fields_[f];
+    const auto fixed_size = field.fixed_.size();
+    if (array_schema_->var_size(name)) {
+      // Read one more offset to know where the last value ends
+      std::vector<uint64_t> offsets(cell_num + (end < run->cell_num_ ? 1 : 0));
+      RETURN_NOT_OK(vfs->read(
+          run->uri_.join_path(prefix + ".fixed"),
+          first * sizeof(uint64_t),
+          offsets.data(),
+          offsets.size() * sizeof(uint64_t),
+          false));
+      const auto var_start = offsets[0];
+      const auto var_end =
+          end < run->cell_num_ ? offsets[cell_num] : run->var_sizes_[f];
+
+      // Rebase the offsets on the values already in the window
+      const auto var_size = field.var_.size();
+      field.fixed_.resize(fixed_size + cell_num * sizeof(uint64_t));
+      auto window_offsets = (uint64_t*)(field.fixed_.data() + fixed_size);
+      for (uint64_t i = 0; i < cell_num; ++i)
+        window_offsets[i] = offsets[i] - var_start + var_size;
+
+      if (var_end > var_start) {
+        field.var_.resize(var_size + var_end - var_start);
+        RETURN_NOT_OK(vfs->read(
+            run->uri_.join_path(prefix + ".var"),
+            var_start,
+            &field.var_[var_size],
+            var_end - var_start,
+            false));
+      }
+    } else {
+      const auto cell_size = array_schema_->cell_size(name);
+      field.fixed_.resize(fixed_size + cell_num * cell_size);
+      RETURN_NOT_OK(vfs->read(
+          run->uri_.join_path(prefix + ".fixed"),
+          first * cell_size,
+          &field.fixed_[fixed_size],
+          cell_num * cell_size,
+          false));
+    }
+
+    if (array_schema_->is_nullable(name)) {
+      const auto validity_size = field.validity_.size();
+      field.validity_.resize(validity_size + cell_num);
+      RETURN_NOT_OK(vfs->read(
+          run->uri_.join_path(prefix + ".validity"),
+          first,
+          &field.validity_[validity_size],
+          cell_num,
+          false));
+    }
+  }
+
+  window.cell_num_ += cell_num;
+  run->next_cell_ = end;
+
+  return Status::Ok();
+}
+
+Status UnorderedWriter::spill_merge() {
+  auto timer_se = stats_->start_timer("spill_merge");
+
+  // For easy reference
+  auto domain = array_schema_->domain();
+  const auto dim_num = array_schema_->dim_num();
+  const auto run_num = spill_runs_.size();
+  const bool hilbert = layout_is_curve(array_schema_->cell_order());
+  auto compute_tp = storage_manager_->compute_tp();
+
+  // The merged cells are written by a global order writer, with the offsets
+  // format of `SpillCells`. The coordinates were checked on submit.
+  Config merge_config = config_;
+  RETURN_NOT_OK(merge_config.set("sm.var_offsets.mode", "bytes"));
+  RETURN_NOT_OK(merge_config.set("sm.var_offsets.bitsize", "64"));
+  RETURN_NOT_OK(merge_config.set("sm.var_offsets.extra_element", "false"));
+  RETURN_NOT_OK(merge_config.set("sm.check_coord_oob", "false"));
+  std::unordered_map<std::string, QueryBuffer> merge_buffers;
+  Query::CoordsInfo merge_coords_info{true, nullptr, nullptr, 0};
+  Subarray merge_subarray(array_, Layout::GLOBAL_ORDER, stats_, logger_);
+  GlobalOrderWriter writer(
+      stats_,
+      logger_,
+      storage_manager_,
+      const_cast<Array*>(array_),
+      merge_config,
+      merge_buffers,
+      merge_subarray,
+      Layout::GLOBAL_ORDER,
+      written_fragment_info_,
+      false,
+      merge_coords_info,
+      fragment_uri_);
+
+  // Returns a query buffer over the cells of a field
+  auto query_buffer = [&](const std::string& name, SpillCells::Field* field) {
+    field->fixed_size_ = field->fixed_.size();
+    field->var_size_ = field->var_.size();
+    field->validity_size_ = field->validity_.size();
+    const bool var_size = array_schema_->var_size(name);
+    void* buffer_var = var_size ? field->var_.data() : nullptr;
+    uint64_t* buffer_var_size = var_size ? &field->var_size_ : nullptr;
+    if (!array_schema_->is_nullable(name)) {
+      return QueryBuffer(
+          field->fixed_.data(),
+          buffer_var,
+          &field->fixed_size_,
+          buffer_var_size);
+    }
+    return QueryBuffer(
+        field->fixed_.data(),
+        buffer_var,
+        &field->fixed_size_,
+        buffer_var_size,
+        ValidityVector(field->validity_.data(), &field->validity_size_));
+  };
+
+  // Each window holds about a third of the budget divided by the number of
+  // runs, as the windows are copied once for merging and once for writing
+  std::vector<uint64_t> window_cell_num(run_num);
+  for (size_t r = 0; r < run_num; ++r) {
+    const auto& run = spill_runs_[r];
+    const auto cell_size = std::max<uint64_t>(1, run.size_ / run.cell_num_);
+    window_cell_num[r] =
+        std::max<uint64_t>(1, spill_budget_ / (3 * run_num) / cell_size);
+  }
+
+  // Each round concatenates the windows of all the runs and writes all the
+  // cells up to the smallest last cell of the windows of the runs that have
+  // more cells on disk. The remaining cells stay in the windows.
+  auto merge = [&]() {
+    std::vector<uint64_t> begin(run_num), end(run_num), merge_end(run_num);
+    std::vector<uint64_t> pos;
+    bool writer_initialized = false;
+    while (true) {
+      SpillCells cells;
+      for (size_t r = 0; r < run_num; ++r) {
+        auto& run = spill_runs_[r];
+        const auto window_cells = run.window_.cell_num_;
+        if (window_cells < window_cell_num[r] &&
+            run.next_cell_ < run.cell_num_) {
+          RETURN_NOT_OK(spill_load(
+              &run,
+              std::min(
+                  window_cell_num[r] - window_cells,
+                  run.cell_num_ - run.next_cell_)));
+        }
+
+        begin[r] = cells.cell_num_;
+        pos.resize(run.window_.cell_num_);
+        std::iota(pos.begin(), pos.end(), 0);
+        spill_append(run.window_, pos, &cells);
+        end[r] = cells.cell_num_;
+        run.window_ = SpillCells();
+      }
+      if (cells.cell_num_ == 0)
+        break;
+
+      // Prepare the comparison of the cells in global order
+      std::vector<QueryBuffer> dim_buffers;
+      std::vector<const QueryBuffer*> buffs(dim_num);
+      dim_buffers.reserve(dim_num);
+      for (unsigned d = 0; d < dim_num; ++d) {
+        const auto& dim_name = array_schema_->dimension(d)->name();
+        const auto f =
+            std::lower_bound(
+                spill_fields_.begin(), spill_fields_.end(), dim_name) -
+            spill_fields_.begin();
+        dim_buffers.emplace_back(query_buffer(dim_name, &cells.fields_[f]));
+        buffs[d] = &dim_buffers.back();
+      }
+      std::vector<uint64_t> hilbert_values;
+      if (hilbert) {
+        SpaceFillingCurve curve(array_schema_->cell_order(), dim_num);
+        hilbert_values.resize(cells.cell_num_);
+        RETURN_NOT_OK(hilbert_order::parallel_calculate_values(
+            compute_tp,
+            curve,
+            dim_num,
+            cells.cell_num_,
+            [&](uint32_t d, uint64_t c, int bits, uint64_t max_bucket_val) {
+              return hilbert_order::map_to_uint64(
+                  *array_schema_->dimension(d),
+                  buffs[d],
+                  c,
+                  bits,
+                  max_bucket_val);
+            },
+            [&](uint64_t c, uint64_t value) { hilbert_values[c] = value; }));
+      }
+      GlobalCmp global_cmp(domain, &buffs);
+      auto cmp = [&](uint64_t a, uint64_t b) {
+        if (hilbert) {
+          if (hilbert_values[a] != hilbert_values[b])
+            return hilbert_values[a] < hilbert_values[b];
+          return domain->cell_order_cmp(buffs, a, b) == -1;
+        }
+        return global_cmp(a, b);
+      };
+
+      // Find the cells that can be written
+      std::optional<uint64_t> cutoff;
+      for (size_t r = 0; r < run_num; ++r) {
+        const auto& run = spill_runs_[r];
+        if (run.next_cell_ < run.cell_num_ &&
+            (!cutoff.has_value() || cmp(end[r] - 1, *cutoff)))
+          cutoff = end[r] - 1;
+      }
+      for (size_t r = 0; r < run_num; ++r) {
+        uint64_t lo = begin[r], hi = end[r];
+        if (cutoff.has_value()) {
+          while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (cmp(*cutoff, mid))
+              hi = mid;
+            else
+              lo = mid + 1;
+          }
+        }
+        merge_end[r] = cutoff.has_value() ? lo : end[r];
+      }
+
+      // Merge the sorted cells of the runs
+      using HeapEntry = std::pair<uint64_t, size_t>;
+      auto heap_cmp = [&](const HeapEntry& a, const HeapEntry& b) {
+        return cmp(b.first, a.first);
+      };
+      std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(heap_cmp)>
+          heap(heap_cmp);
+      for (size_t r = 0; r < run_num; ++r) {
+        if (begin[r] < merge_end[r])
+          heap.emplace(begin[r], r);
+      }
+      pos.clear();
+      while (!heap.empty()) {
+        const auto entry = heap.top();
+        heap.pop();
+        pos.push_back(entry.first);
+        if (entry.first + 1 < merge_end[entry.second])
+          heap.emplace(entry.first + 1, entry.second);
+      }
+
+      // Write the merged cells
+      SpillCells merged;
+      spill_append(cells, pos, &merged);
+      for (size_t f = 0; f < spill_fields_.size(); ++f) {
+        merge_buffers[spill_fields_[f]] =
+            query_buffer(spill_fields_[f], &merged.fields_[f]);
+      }
+      merge_coords_info.coords_num_ = merged.cell_num_;
+      if (!writer_initialized) {
+        RETURN_NOT_OK(writer.init());
+        writer_initialized = true;
+      }
+      RETURN_NOT_OK(writer.dowork());
+
+      // Keep the remaining cells in the windows
+      for (size_t r = 0; r < run_num; ++r) {
+        pos.resize(end[r] - merge_end[r]);
+        std::iota(pos.begin(), pos.end(), merge_end[r]);
+        spill_append(cells, pos, &spill_runs_[r].window_);
+      }
+    }
+
+    return writer.finalize();
+  };
+
+  auto st = merge();
+  if (!st.ok())
+    writer.reset();
+
+  return st;
+}
+
+Status UnorderedWriter::spill_run() {
+  auto timer_se = stats_->start_timer("spill_run");
+
+  // Sort the cells and remove their duplicates as for a fragment
+  std::vector<uint64_t> cell_pos;
+  const bool dedup_before_sort = dedup_coords_ && dedup_coords_hash_;
+  if (dedup_before_sort) {
+    RETURN_CANCEL_OR_ERROR(dedup_coords_hash(&cell_pos));
+  } else {
+    cell_pos.resize(coords_info_.coords_num_);
+    for (uint64_t i = 0; i < coords_info_.coords_num_; ++i)
+      cell_pos[i] = i;
+  }
+  RETURN_CANCEL_OR_ERROR(sort_coords(&cell_pos));
+  RETURN_CANCEL_OR_ERROR(check_coord_dups(cell_pos));
+  if (dedup_coords_ && !dedup_before_sort) {
+    std::set<uint64_t> coord_dups;
+    RETURN_CANCEL_OR_ERROR(compute_coord_dups(cell_pos, &coord_dups));
+    if (!coord_dups.empty()) {
+      std::vector<uint64_t> unique_cell_pos;
+      unique_cell_pos.reserve(cell_pos.size() - coord_dups.size());
+      for (const auto pos : cell_pos) {
+        if (coord_dups.find(pos) == coord_dups.end())
+          unique_cell_pos.push_back(pos);
+      }
+      cell_pos.swap(unique_cell_pos);
+    }
+  }
+  if (cell_pos.empty())
+    return Status::Ok();
+
+  // All the runs must have the same attributes and dimensions
+  if (spill_fields_.empty()) {
+    for (const auto& it : buffers_)
+      spill_fields_.push_back(it.first);
+    std::sort(spill_fields_.begin(), spill_fields_.end());
+  } else {
+    bool same_fields = buffers_.size() == spill_fields_.size();
+    for (const auto& name : spill_fields_)
+      same_fields = same_fields && buffers_.count(name) != 0;
+    if (!same_fields) {
+      return logger_->status(Status_WriterError(
+          "Cannot spill unordered write; The buffers differ from the buffers "
+          "of the previous submits"));
+    }
+  }
+
+  // Write the run
+  auto vfs = storage_manager_->vfs();
+  if (spill_runs_.empty())
+    RETURN_NOT_OK(vfs->create_dir(spill_uri_));
+  SpillRun run;
+  run.uri_ = spill_uri_.join_path("run_" + std::to_string(spill_runs_.size()));
+  run.cell_num_ = cell_pos.size();
+  run.var_sizes_.assign(spill_fields_.size(), 0);
+  RETURN_NOT_OK(vfs->create_dir(run.uri_));
+  for (unsigned f = 0; f < spill_fields_.size(); ++f) {
+    RETURN_NOT_OK_ELSE(
+        spill_write_field(&run, f, cell_pos), vfs->remove_dir(run.uri_));
+  }
+
+  stats_->add_counter("spill_run_num", 1);
+  stats_->add_counter("spill_bytes", run.size_);
+  spill_runs_.emplace_back(std::move(run));
+
+  return Status::Ok();
+}
+
+Status UnorderedWriter::spill_write_field(
+    SpillRun* run,
+    unsigned field,
+    const std::vector<uint64_t>& cell_pos) const {
+  // For easy reference
+  auto vfs = storage_manager_->vfs();
+  const auto& name = spill_fields_[field];
+  const auto& buff = buffers_.find(name)->second;
+  const auto cell_num = cell_pos.size();
+  const auto prefix = std::to_string(field);
+
+  // Writes a run file, skipped if empty
+  auto write_file = [&](const std::string& suffix,
+                        const void* data,
+                        uint64_t size) {
+    if (size == 0)
+      return Status::Ok();
+    const auto uri = run->uri_.join_path(prefix + suffix);
+    RETURN_NOT_OK(vfs->write(uri, data, size));
+    RETURN_NOT_OK(vfs->close_file(uri));
+    run->size_ += size;
+    return Status::Ok();
+  };
+
+  if (array_schema_->var_size(name)) {
+    const auto value_size = datatype_size(array_schema_->type(name));
+    auto buffer_var = (const uint8_t*)buff.buffer_var_;
+    std::vector<uint64_t> offsets(cell_num);
+    std::vector<uint8_t> values;
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      const auto p = cell_pos[i];
+      const auto start = prepare_buffer_offset(buff.buffer_, p, value_size);
+      const auto end =
+          (p == coords_info_.coords_num_ - 1) ?
+              *buff.buffer_var_size_ :
+              prepare_buffer_offset(buff.buffer_, p + 1, value_size);
+      offsets[i] = values.size();
+      values.insert(values.end(), buffer_var + start, buffer_var + end);
+    }
+    RETURN_NOT_OK(write_file(
+        ".fixed", offsets.data(), offsets.size() * sizeof(uint64_t)));
+    RETURN_NOT_OK(write_file(".var", values.data(), values.size()));
+    run->var_sizes_[field] = values.size();
+  } else {
+    const auto cell_size = array_schema_->cell_size(name);
+    auto buffer = (const uint8_t*)buff.buffer_;
+    std::vector<uint8_t> values(cell_num * cell_size);
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      std::memcpy(
+          &values[i * cell_size], buffer + cell_pos[i] * cell_size, cell_size);
+    }
+    RETURN_NOT_OK(write_file(".fixed", values.data(), values.size()));
+  }
+
+  if (array_schema_->is_nullable(name)) {
+    auto buffer_validity = (const uint8_t*)buff.validity_vector_.buffer();
+    std::vector<uint8_t> validity(cell_num);
+    for (uint64_t i = 0; i < cell_num; ++i)
+      validity[i] = buffer_validity[cell_pos[i]];
+    RETURN_NOT_OK(write_file(".validity", validity.data(), validity.size()));
   }
 
   return Status::Ok();
@@ -619,8 +1491,18 @@ Status UnorderedWriter::unordered_write() {
   assert(layout_ == Layout::UNORDERED);
   assert(!array_schema_->dense());
 
-  // Sort coordinates first
+  // Remove coordinate duplicates before sorting if a hash table is used
   std::vector<uint64_t> cell_pos;
+  const bool dedup_before_sort = dedup_coords_ && dedup_coords_hash_;
+  if (dedup_before_sort) {
+    RETURN_CANCEL_OR_ERROR(dedup_coords_hash(&cell_pos));
+  } else {
+    cell_pos.resize(coords_info_.coords_num_);
+    for (uint64_t i = 0; i < coords_info_.coords_num_; ++i)
+      cell_pos[i] = i;
+  }
+
+  // Sort coordinates
   RETURN_CANCEL_OR_ERROR(sort_coords(&cell_pos));
 
   // Check for coordinate duplicates
@@ -628,12 +1510,27 @@ Status UnorderedWriter::unordered_write() {
 
   // Retrieve coordinate duplicates
   std::set<uint64_t> coord_dups;
-  if (dedup_coords_)
+  if (dedup_coords_ && !dedup_before_sort)
     RETURN_CANCEL_OR_ERROR(compute_coord_dups(cell_pos, &coord_dups));
 
+  // Small writes are packed in a single object instead of a directory
+  bool packed = false;
+  if (packed_fragment_max_size_ > 0 && fragment_uri_.to_string().empty()) {
+    uint64_t size = 0;
+    for (const auto& it : buffers_) {
+      const auto& buff = it.second;
+      size += *buff.buffer_size_;
+      if (buff.buffer_var_size_ != nullptr)
+        size += *buff.buffer_var_size_;
+      if (buff.validity_vector_.buffer_size() != nullptr)
+        size += *buff.validity_vector_.buffer_size();
+    }
+    packed = size <= packed_fragment_max_size_;
+  }
+
   // Create new fragment
   auto frag_meta = tdb::make_shared<FragmentMetadata>(HERE());
-  RETURN_CANCEL_OR_ERROR(create_fragment(false, frag_meta));
+  RETURN_CANCEL_OR_ERROR(create_fragment(false, frag_meta, packed));
   const auto& uri = frag_meta->fragment_uri();
 
   // Prepare tiles
@@ -645,8 +1542,11 @@ Status UnorderedWriter::unordered_write() {
   coord_dups.clear();
 
   // No tiles
-  if (tiles.empty() || tiles.begin()->second.empty())
+  if (tiles.empty() || tiles.begin()->second.empty()) {
+    if (packed)
+      clean_up(uri);
     return Status::Ok();
+  }
 
   // Set the number of tiles in the metadata
   auto it = tiles.begin();
@@ -667,6 +1567,10 @@ Status UnorderedWriter::unordered_write() {
   RETURN_CANCEL_OR_ERROR_ELSE(
       compute_tiles_metadata(tile_num, tiles), clean_up(uri));
 
+  // Compute the attribute value index
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_attribute_index(tile_num, tiles, frag_meta), clean_up(uri));
+
   // Filter all tiles
   RETURN_CANCEL_OR_ERROR_ELSE(filter_tiles(&tiles), clean_up(uri));
 
@@ -682,8 +1586,15 @@ Status UnorderedWriter::unordered_write() {
   RETURN_NOT_OK_ELSE(add_written_fragment_info(uri), clean_up(uri));
 
   // The following will make the fragment visible
+  if (packed) {
+    RETURN_NOT_OK_ELSE(
+        storage_manager_->store_packed_fragment(uri), clean_up(uri));
+    return Status::Ok();
+  }
   auto ok_uri =
       URI(uri.remove_trailing_slash().to_string() + constants::ok_file_suffix);
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->vfs()->commit_group(uri), clean_up(uri));
   RETURN_NOT_OK_ELSE(storage_manager_->vfs()->touch(ok_uri), clean_up(uri));
 
   return Status::Ok();
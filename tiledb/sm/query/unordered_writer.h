@@ -34,6 +34,7 @@
 #define TILEDB_UNORDERED_WRITER_H
 
 #include <atomic>
+#include <optional>
 
 #include "tiledb/common/status.h"
 #include "tiledb/sm/query/writer_base.h"
@@ -75,20 +76,109 @@ class UnorderedWriter : public WriterBase {
   /*                 API               */
   /* ********************************* */
 
+  /** Initializes the writer. */
+  Status init();
+
   /** Performs a write query using its set members. */
   Status dowork();
 
-  /** Finalizes the writer. */
+  /**
+   * Finalizes the writer. If runs were spilled to disk, they are merged into
+   * a single fragment in global order.
+   */
   Status finalize();
 
   /** Resets the writer object, rendering it incomplete. */
   void reset();
 
  private:
+  /* ********************************* */
+  /*      PRIVATE TYPE DEFINITIONS     */
+  /* ********************************* */
+
+  /**
+   * Cells of the written attributes and dimensions held in memory while
+   * merging spilled runs. Var-sized offsets are 64-bit byte offsets, without
+   * an extra element.
+   */
+  struct SpillCells {
+    /** The cells of an attribute or dimension. */
+    struct Field {
+      /** The fixed-sized values, or the offsets of the var-sized values. */
+      std::vector<uint8_t> fixed_;
+
+      /** The var-sized values. */
+      std::vector<uint8_t> var_;
+
+      /** The validity values. */
+      std::vector<uint8_t> validity_;
+
+      /** The sizes of the vectors, referenced by query buffers. */
+      uint64_t fixed_size_ = 0;
+      uint64_t var_size_ = 0;
+      uint64_t validity_size_ = 0;
+    };
+
+    /** The cells of each field, in the order of `spill_fields_`. */
+    std::vector<Field> fields_;
+
+    /** The number of cells. */
+    uint64_t cell_num_ = 0;
+  };
+
+  /** A run of cells sorted in global order and spilled to disk. */
+  struct SpillRun {
+    /** The directory of the run files. */
+    URI uri_;
+
+    /** The number of cells of the run. */
+    uint64_t cell_num_ = 0;
+
+    /** The total size of the run files. */
+    uint64_t size_ = 0;
+
+    /** The size of the var-sized values of each field. */
+    std::vector<uint64_t> var_sizes_;
+
+    /** The first cell of the run not loaded in memory yet. */
+    uint64_t next_cell_ = 0;
+
+    /** The loaded cells of the run that are not merged yet. */
+    SpillCells window_;
+  };
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
 
+  /**
+   * If `true`, coordinate duplicates are removed with a hash table before
+   * sorting, instead of by comparing neighbors after sorting. Meaningful
+   * only when `dedup_coords_` is `true`.
+   */
+  bool dedup_coords_hash_;
+
+  /**
+   * The memory budget for merging the spilled runs. If 0, each submit
+   * writes its own fragment and nothing is spilled.
+   */
+  uint64_t spill_budget_;
+
+  /**
+   * The maximum total size of the buffers of a write that writes a packed
+   * fragment. If 0, fragments are never packed.
+   */
+  uint64_t packed_fragment_max_size_;
+
+  /** The scratch directory of the spilled runs of this writer. */
+  URI spill_uri_;
+
+  /** The names of the attributes and dimensions in the spilled runs. */
+  std::vector<std::string> spill_fields_;
+
+  /** The runs spilled so far, one per submit. */
+  std::vector<SpillRun> spill_runs_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -103,8 +193,8 @@ class UnorderedWriter : public WriterBase {
   Status check_coord_dups(const std::vector<uint64_t>& cell_pos) const;
 
   /**
-   * Invoked on error. It removes the directory of the input URI and
-   * resets the global write state.
+   * Invoked on error. It removes the directory of the input URI, or
+   * discards the packed fragment, and resets the global write state.
    */
   void clean_up(const URI& uri);
 
@@ -125,6 +215,17 @@ class UnorderedWriter : public WriterBase {
       const std::vector<uint64_t>& cell_pos,
       std::set<uint64_t>* coord_dups) const;
 
+  /**
+   * Computes the positions of the cells to write without their coordinate
+   * duplicates, in a single pass over the coordinates with hash tables
+   * partitioned by coordinate hash across threads. The first occurrence of
+   * duplicate coordinates is kept.
+   *
+   * @param cell_pos The increasing positions of the cells to write.
+   * @return Status
+   */
+  Status dedup_coords_hash(std::vector<uint64_t>* cell_pos) const;
+
   /**
    * It prepares the attribute and coordinate tiles, re-organizing the cells
    * from the user buffers based on the input sorted positions and coordinate
@@ -200,14 +301,86 @@ class UnorderedWriter : public WriterBase {
       std::vector<WriterTile>* tiles) const;
 
   /**
-   * Sorts the coordinates of the user buffers, creating a vector with
-   * the sorted positions.
+   * Computes a key per cell whose unsigned integer order is the global
+   * order, when all the dimensions are integers: the tile indices in tile
+   * order, followed by the cell positions in their tile in cell order. Each
+   * field only takes the bits needed for the range of the written
+   * coordinates.
    *
-   * @param cell_pos The sorted cell positions to be created.
+   * @param buffs The coordinate buffers, one per dimension.
+   * @param keys The keys to be computed.
+   * @return The number of key bits, or nullopt if the dimensions are not all
+   *     integers or the fields do not fit in 64 bits.
+   */
+  std::optional<unsigned> compute_global_order_keys(
+      const std::vector<const QueryBuffer*>& buffs,
+      std::vector<uint64_t>* keys) const;
+
+  /**
+   * Sorts the input cell positions of the user buffers in global order.
+   * Integer coordinates and Hilbert values are radix sorted on packed keys,
+   * other coordinates use a comparison sort.
+   *
+   * @param cell_pos The increasing positions of the cells to sort, sorted
+   *     in place.
    * @return Status
    */
   Status sort_coords(std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Appends the input cells of `src` to `dst`, in the input order.
+   *
+   * @param src The cells to copy from.
+   * @param pos The positions of the cells to copy in `src`.
+   * @param dst The cells to append to.
+   */
+  void spill_append(
+      const SpillCells& src,
+      const std::vector<uint64_t>& pos,
+      SpillCells* dst) const;
+
+  /** Removes the scratch directory of the spilled runs. */
+  void spill_clean_up();
+
+  /**
+   * Loads the next cells of a spilled run at the end of its window.
+   *
+   * @param run The spilled run.
+   * @param cell_num The number of cells to load.
+   * @return Status
+   */
+  Status spill_load(SpillRun* run, uint64_t cell_num) const;
+
+  /**
+   * Merges the spilled runs in windows that fit the spill budget, and writes
+   * the merged cells into a single fragment with a global order writer.
+   *
+   * @return Status
+   */
+  Status spill_merge();
+
+  /**
+   * Sorts the cells of the user buffers in global order and spills them to
+   * disk as a new run, instead of writing a fragment.
+   *
+   * @return Status
+   */
+  Status spill_run();
+
+  /**
+   * Writes the cells of an attribute or dimension of the user buffers to the
+   * files of a spilled run.
+   *
+   * @param run The spilled run.
+   * @param field The index of the attribute or dimension in `spill_fields_`.
+   * @param cell_pos The positions of the cells to write, in their order.
+   * @return Status
+   */
+  Status spill_write_field(
+      SpillRun* run,
+      unsigned field,
+      const std::vector<uint64_t>& cell_pos) const;
+
   /**
    * Writes in unordered layout. Applicable to both dense and sparse arrays.
    * Explicit coordinates must be provided for this write.
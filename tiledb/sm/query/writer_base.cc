@@ -38,11 +38,14 @@
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/bloom_filter.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/fragment/fragment_parts.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/math.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
 #include "tiledb/sm/misc/time.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
@@ -93,6 +96,8 @@ WriterBase::WriterBase(
     , check_coord_oob_(false)
     , check_global_order_(false)
     , dedup_coords_(false)
+    , coords_bloom_filter_bits_per_cell_(0)
+    , elide_fill_tiles_(false)
     , initialized_(false)
     , written_fragment_info_(written_fragment_info) {
   fragment_uri_ = fragment_uri;
@@ -130,6 +135,15 @@ void WriterBase::set_dedup_coords(bool b) {
   dedup_coords_ = b;
 }
 
+void WriterBase::set_progress(QueryProgress* progress) {
+  progress_ = progress;
+}
+
+Status WriterBase::rebind() {
+  return logger_->status(
+      Status_WriterError("Cannot rebind writer; Writes cannot be prepared"));
+}
+
 Status WriterBase::check_var_attr_offsets() const {
   for (const auto& it : buffers_) {
     const auto& attr = it.first;
@@ -206,37 +220,48 @@ Status WriterBase::init() {
   }
 
   // Get configuration parameters
-  const char *check_coord_dups, *check_coord_oob, *check_global_order;
-  const char* dedup_coords;
-  RETURN_NOT_OK(config_.get("sm.check_coord_dups", &check_coord_dups));
-  RETURN_NOT_OK(config_.get("sm.check_coord_oob", &check_coord_oob));
-  RETURN_NOT_OK(config_.get("sm.check_global_order", &check_global_order));
-  RETURN_NOT_OK(config_.get("sm.dedup_coords", &dedup_coords));
-  assert(check_coord_dups != nullptr && dedup_coords != nullptr);
-  check_coord_dups_ = !strcmp(check_coord_dups, "true");
-  check_coord_oob_ = !strcmp(check_coord_oob, "true");
+  std::shared_ptr<const ConfigSnapshot> config;
+  RETURN_NOT_OK(config_.snapshot(&config));
+  check_coord_dups_ = config->check_coord_dups;
+  check_coord_oob_ = config->check_coord_oob;
   check_global_order_ =
-      disable_check_global_order_ ? false : !strcmp(check_global_order, "true");
-  dedup_coords_ = !strcmp(dedup_coords, "true");
-  bool found = false;
-  offsets_format_mode_ = config_.get("sm.var_offsets.mode", &found);
-  assert(found);
+      disable_check_global_order_ ? false : config->check_global_order;
+  dedup_coords_ = config->dedup_coords;
+  offsets_format_mode_ = config->var_offsets_mode;
   if (offsets_format_mode_ != "bytes" && offsets_format_mode_ != "elements") {
     return logger_->status(
         Status_WriterError("Cannot initialize writer; Unsupported offsets "
                            "format in configuration"));
   }
-  RETURN_NOT_OK(config_.get<bool>(
-      "sm.var_offsets.extra_element", &offsets_extra_element_, &found));
-  assert(found);
-  RETURN_NOT_OK(config_.get<uint32_t>(
-      "sm.var_offsets.bitsize", &offsets_bitsize_, &found));
+  offsets_extra_element_ = config->var_offsets_extra_element;
+  offsets_bitsize_ = config->var_offsets_bitsize;
   if (offsets_bitsize_ != 32 && offsets_bitsize_ != 64) {
     return logger_->status(
         Status_WriterError("Cannot initialize writer; Unsupported offsets "
                            "bitsize in configuration"));
   }
-  assert(found);
+  coords_bloom_filter_bits_per_cell_ =
+      config->coords_bloom_filter_bits_per_cell;
+  elide_fill_tiles_ = config->dense_elide_fill_tiles;
+
+  // Equal real coordinates may differ in their bytes (e.g., 0.0 and -0.0),
+  // so point lookups could not rely on a filter over their hashes
+  for (unsigned d = 0; d < array_schema_->dim_num(); ++d) {
+    if (datatype_is_real(array_schema_->dimension(d)->type()))
+      coords_bloom_filter_bits_per_cell_ = 0;
+  }
+
+  // Keep the indexed attributes that are written; equal real values may
+  // differ in their bytes, so they cannot be indexed by hash either
+  bool found = false;
+  std::stringstream names(config_.get("sm.attribute_index_names", &found));
+  std::string name;
+  while (std::getline(names, name, ',')) {
+    auto attr = array_schema_->attribute(name);
+    if (attr != nullptr && buffers_.count(name) != 0 &&
+        !datatype_is_real(attr->type()))
+      attribute_index_names_.emplace_back(name);
+  }
 
   // Set a default subarray
   if (!subarray_.is_set())
@@ -264,37 +289,43 @@ Status WriterBase::initialize_memory_budget() {
 /* ****************************** */
 
 Status WriterBase::add_written_fragment_info(const URI& uri) {
+  // A part of a fragment is named after its number within the fragment
   std::pair<uint64_t, uint64_t> timestamp_range;
-  RETURN_NOT_OK(utils::parse::get_timestamp_range(uri, &timestamp_range));
+  RETURN_NOT_OK(utils::parse::get_timestamp_range(
+      FragmentParts::is_part(uri) ? uri.remove_trailing_slash().parent() : uri,
+      &timestamp_range));
   written_fragment_info_.emplace_back(uri, timestamp_range);
   return Status::Ok();
 }
 
+Status WriterBase::commit_fragment(const URI& uri) const {
+  if (FragmentParts::is_part(uri))
+    return Status::Ok();
+
+  auto ok_uri =
+      URI(uri.remove_trailing_slash().to_string() + constants::ok_file_suffix);
+  RETURN_NOT_OK(storage_manager_->vfs()->commit_group(uri));
+  return storage_manager_->vfs()->touch(ok_uri);
+}
+
 Status WriterBase::calculate_hilbert_values(
     const std::vector<const QueryBuffer*>& buffs,
     std::vector<uint64_t>* hilbert_values) const {
   auto dim_num = array_schema_->dim_num();
-  Hilbert h(dim_num);
-  auto bits = h.bits();
-  auto max_bucket_val = ((uint64_t)1 << bits) - 1;
+  SpaceFillingCurve curve(array_schema_->cell_order(), dim_num);
 
-  // Calculate Hilbert values in parallel
+  // Calculate Hilbert values in parallel, in batches of cells
   assert(hilbert_values->size() >= coords_info_.coords_num_);
-  auto status = parallel_for(
+  auto status = hilbert_order::parallel_calculate_values(
       storage_manager_->compute_tp(),
-      0,
+      curve,
+      dim_num,
       coords_info_.coords_num_,
-      [&](uint64_t c) {
-        std::vector<uint64_t> coords(dim_num);
-        for (uint32_t d = 0; d < dim_num; ++d) {
-          auto dim = array_schema_->dimension(d);
-          coords[d] = hilbert_order::map_to_uint64(
-              *dim, buffs[d], c, bits, max_bucket_val);
-        }
-        (*hilbert_values)[c] = h.coords_to_hilbert(&coords[0]);
-
-        return Status::Ok();
-      });
+      [&](uint32_t d, uint64_t c, int bits, uint64_t max_bucket_val) {
+        return hilbert_order::map_to_uint64(
+            *array_schema_->dimension(d), buffs[d], c, bits, max_bucket_val);
+      },
+      [&](uint64_t c, uint64_t value) { (*hilbert_values)[c] = value; });
 
   RETURN_NOT_OK_ELSE(status, logger_->status(status));
 
@@ -447,7 +478,16 @@ Status WriterBase::close_files(tdb_shared_ptr<FragmentMetadata> meta) const {
   std::vector<URI> file_uris;
   file_uris.reserve(buffer_name.size() * 3);
 
+  std::vector<bool> groups(array_schema_->attribute_groups().size(), false);
   for (const auto& name : buffer_name) {
+    // The attributes of a group share one file
+    auto group = array_schema_->attribute_group(name);
+    if (group.has_value()) {
+      if (groups[*group])
+        continue;
+      groups[*group] = true;
+    }
+
     auto&& [status, uri] = meta->uri(name);
     RETURN_NOT_OK(status);
 
@@ -517,6 +557,13 @@ Status WriterBase::compute_coords_metadata(
         }
 
         meta->set_mbr(i, mbr);
+
+        if (coords_bloom_filter_bits_per_cell_ > 0) {
+          std::vector<uint64_t> hashes;
+          compute_coords_hashes(tiles, i, &hashes);
+          meta->add_coords_hashes(hashes, coords_bloom_filter_bits_per_cell_);
+        }
+
         return Status::Ok();
       });
 
@@ -532,6 +579,98 @@ Status WriterBase::compute_coords_metadata(
   return Status::Ok();
 }
 
+void WriterBase::compute_coords_hashes(
+    const std::unordered_map<std::string, std::vector<WriterTile>>& tiles,
+    uint64_t tile_idx,
+    std::vector<uint64_t>* hashes) const {
+  // The hash of each dimension seeds the hash of the next one
+  auto dim_num = array_schema_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = array_schema_->dimension(d);
+    const auto& dim_tiles = tiles.find(dim->name())->second;
+    if (!dim->var_size()) {
+      const auto& tile = dim_tiles[tile_idx];
+      const auto cell_num = tile.cell_num();
+      const auto coord_size = dim->coord_size();
+      auto data = static_cast<const uint8_t*>(tile.data());
+      hashes->resize(cell_num, 0);
+      for (uint64_t c = 0; c < cell_num; ++c) {
+        (*hashes)[c] = BloomFilter::hash(
+            &data[c * coord_size], coord_size, (*hashes)[c]);
+      }
+    } else {
+      const auto& tile_off = dim_tiles[2 * tile_idx];
+      const auto& tile_val = dim_tiles[2 * tile_idx + 1];
+      const auto cell_num = tile_off.cell_num();
+      auto offsets = static_cast<const uint64_t*>(tile_off.data());
+      auto data = static_cast<const uint8_t*>(tile_val.data());
+      hashes->resize(cell_num, 0);
+      for (uint64_t c = 0; c < cell_num; ++c) {
+        auto size = (c == cell_num - 1) ? tile_val.size() - offsets[c] :
+                                          offsets[c + 1] - offsets[c];
+        (*hashes)[c] =
+            BloomFilter::hash(&data[offsets[c]], size, (*hashes)[c]);
+      }
+    }
+  }
+}
+
+Status WriterBase::compute_attribute_index(
+    uint64_t tile_num,
+    const std::unordered_map<std::string, std::vector<WriterTile>>& tiles,
+    tdb_shared_ptr<FragmentMetadata> meta) const {
+  if (attribute_index_names_.empty())
+    return Status::Ok();
+
+  auto timer_se = stats_->start_timer("compute_attribute_index");
+
+  const auto name_num = attribute_index_names_.size();
+  auto status = parallel_for(
+      storage_manager_->compute_tp(), 0, name_num * tile_num, [&](uint64_t i) {
+        const auto& name = attribute_index_names_[i / tile_num];
+        const auto t = i % tile_num;
+        const auto var_size = array_schema_->var_size(name);
+        const auto nullable = array_schema_->is_nullable(name);
+        const auto& attr_tiles = tiles.find(name)->second;
+        const auto tile_pos = t * (1 + var_size + nullable);
+        const auto& tile = attr_tiles[tile_pos];
+        const auto cell_num = tile.cell_num();
+        auto validity =
+            nullable ? static_cast<const uint8_t*>(
+                           attr_tiles[tile_pos + var_size + 1].data()) :
+                       nullptr;
+
+        // Null cells never satisfy an equality with a value
+        BloomFilter filter;
+        filter.init(cell_num, constants::attribute_index_bits_per_cell);
+        if (!var_size) {
+          const auto cell_size = array_schema_->cell_size(name);
+          auto data = static_cast<const uint8_t*>(tile.data());
+          for (uint64_t c = 0; c < cell_num; ++c) {
+            if (validity == nullptr || validity[c])
+              filter.add(BloomFilter::hash(&data[c * cell_size], cell_size));
+          }
+        } else {
+          const auto& tile_val = attr_tiles[tile_pos + 1];
+          auto offsets = static_cast<const uint64_t*>(tile.data());
+          auto data = static_cast<const uint8_t*>(tile_val.data());
+          for (uint64_t c = 0; c < cell_num; ++c) {
+            if (validity != nullptr && !validity[c])
+              continue;
+            auto size = (c == cell_num - 1) ? tile_val.size() - offsets[c] :
+                                              offsets[c + 1] - offsets[c];
+            filter.add(BloomFilter::hash(&data[offsets[c]], size));
+          }
+        }
+
+        meta->set_attribute_index(name, t, std::move(filter));
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  return Status::Ok();
+}
+
 Status WriterBase::compute_tiles_metadata(
     uint64_t tile_num,
     std::unordered_map<std::string, std::vector<WriterTile>>& tiles) const {
@@ -614,7 +753,9 @@ std::string WriterBase::coords_to_str(uint64_t i) const {
 }
 
 Status WriterBase::create_fragment(
-    bool dense, tdb_shared_ptr<FragmentMetadata>& frag_meta) const {
+    bool dense,
+    tdb_shared_ptr<FragmentMetadata>& frag_meta,
+    bool packed) const {
   URI uri;
   uint64_t timestamp = array_->timestamp_end_opened_at();
   if (!fragment_uri_.to_string().empty()) {
@@ -625,6 +766,8 @@ Status WriterBase::create_fragment(
         timestamp,
         array_->array_schema_latest()->write_version(),
         &new_fragment_str));
+    if (packed)
+      new_fragment_str += constants::packed_fragment_suffix;
     uri = array_schema_->array_uri().join_path(new_fragment_str);
   }
   auto timestamp_range = std::pair<uint64_t, uint64_t>(timestamp, timestamp);
@@ -638,7 +781,36 @@ Status WriterBase::create_fragment(
       dense);
 
   RETURN_NOT_OK((frag_meta)->init(subarray_.ndrange(0)));
-  return storage_manager_->create_dir(uri);
+  if (packed)
+    return storage_manager_->start_packed_fragment(uri);
+
+  // The writers of the parts of a fragment create the fragment directory
+  // concurrently, but each part is written once
+  if (FragmentParts::is_part(uri)) {
+    bool exists = false;
+    RETURN_NOT_OK(storage_manager_->is_dir(uri, &exists));
+    if (exists)
+      return logger_->status(Status_WriterError(
+          "Cannot create fragment part; Part '" + uri.to_string() +
+          "' already exists"));
+    auto fragment_uri = uri.remove_trailing_slash().parent();
+    if (!storage_manager_->create_dir(fragment_uri).ok()) {
+      RETURN_NOT_OK(storage_manager_->is_dir(fragment_uri, &exists));
+      if (!exists)
+        return logger_->status(Status_WriterError(
+            "Cannot create fragment part; Failed to create fragment '" +
+            fragment_uri.to_string() + "'"));
+    }
+  }
+
+  RETURN_NOT_OK(storage_manager_->create_dir(uri));
+
+  // The files of a part are synced as they are closed, as the part does not
+  // commit the fragment
+  if (!FragmentParts::is_part(uri))
+    RETURN_NOT_OK(storage_manager_->vfs()->begin_group_commit(uri));
+
+  return Status::Ok();
 }
 
 Status WriterBase::filter_tiles(
@@ -661,6 +833,52 @@ Status WriterBase::filter_tiles(
   return Status::Ok();
 }
 
+bool WriterBase::elide_fill_tile(
+    const std::string& name,
+    WriterTile* const tile,
+    WriterTile* const validity_tile) const {
+  if (!elide_fill_tiles_ || !array_schema_->dense() ||
+      array_schema_->var_size(name)) {
+    return false;
+  }
+
+  const auto attr = array_schema_->attribute(name);
+  if (attr == nullptr) {
+    return false;
+  }
+
+  // All the cells are equal to the fill value if the first one is, and if
+  // each cell is equal to the next one.
+  const auto& fill_value = attr->fill_value();
+  const auto cell_size = fill_value.size();
+  const auto size = tile->size();
+  const auto data = static_cast<const char*>(tile->data());
+  if (cell_size == 0 || size < cell_size || size % cell_size != 0 ||
+      memcmp(data, fill_value.data(), cell_size) != 0 ||
+      memcmp(data, data + cell_size, size - cell_size) != 0) {
+    return false;
+  }
+
+  if (validity_tile != nullptr) {
+    const auto validity = static_cast<const uint8_t*>(validity_tile->data());
+    const auto fill_validity = attr->fill_value_validity();
+    for (uint64_t c = 0; c < validity_tile->size(); ++c) {
+      if (validity[c] != fill_validity) {
+        return false;
+      }
+    }
+  }
+
+  // The tiles keep an empty filtered buffer, so nothing is written for them
+  // and their persisted size is zero.
+  tile->set_pre_filtered_size(size);
+  if (validity_tile != nullptr) {
+    validity_tile->set_pre_filtered_size(validity_tile->size());
+  }
+
+  return true;
+}
+
 Status WriterBase::filter_tiles(
     const std::string& name, std::vector<WriterTile>* tiles) {
   const bool var_size = array_schema_->var_size(name);
@@ -688,6 +906,14 @@ Status WriterBase::filter_tiles(
   }
 
   for (size_t tile_idx = 0; tile_idx < tile_num; tile_idx += tile_step) {
+    if (!var_size &&
+        elide_fill_tile(
+            name,
+            &(*tiles)[tile_idx],
+            nullable ? &(*tiles)[tile_idx + 1] : nullptr)) {
+      continue;
+    }
+
     if (var_size) {
       args_offsets.emplace_back(&(*tiles)[tile_idx], nullptr, true, false);
       args.emplace_back(
@@ -965,6 +1191,43 @@ Status WriterBase::check_extra_element() {
   return Status::Ok();
 }
 
+void WriterBase::set_tiles_metadata(
+    const std::string& name,
+    tdb_shared_ptr<FragmentMetadata> frag_meta,
+    uint64_t start_tile_id,
+    std::vector<WriterTile>* const tiles) {
+  // For easy reference
+  const bool var_size = array_schema_->var_size(name);
+  const bool nullable = array_schema_->is_nullable(name);
+  const uint64_t tile_num_mult = 1 + var_size + nullable;
+  const auto has_min_max_md = has_min_max_metadata(name, var_size);
+  const auto has_sum_md = has_sum_metadata(name, var_size);
+
+  auto tile_id = start_tile_id;
+  for (size_t i = 0; i < tiles->size(); i += tile_num_mult, ++tile_id) {
+    auto&& [min, min_size, max, max_size, sum, null_count] =
+        (*tiles)[i].metadata();
+    if (var_size) {
+      if (has_min_max_md && null_count != frag_meta->cell_num(tile_id)) {
+        frag_meta->set_tile_min_var_size(name, tile_id, min_size);
+        frag_meta->set_tile_max_var_size(name, tile_id, max_size);
+      }
+    } else {
+      if (has_min_max_md && null_count != frag_meta->cell_num(tile_id)) {
+        frag_meta->set_tile_min(name, tile_id, min, min_size);
+        frag_meta->set_tile_max(name, tile_id, max, max_size);
+      }
+
+      if (has_sum_md) {
+        frag_meta->set_tile_sum(name, tile_id, sum);
+      }
+    }
+
+    if (nullable)
+      frag_meta->set_tile_null_count(name, tile_id, null_count);
+  }
+}
+
 Status WriterBase::split_coords_buffer() {
   auto timer_se = stats_->start_timer("split_coords_buff");
 
@@ -1019,144 +1282,259 @@ Status WriterBase::write_all_tiles(
 
   assert(!tiles->empty());
 
-  std::vector<ThreadPool::Task> tasks;
+  RETURN_NOT_OK(upload_tiles(frag_meta, 0, tiles));
+  set_all_tiles_metadata(frag_meta, tiles);
+
+  return Status::Ok();
+}
+
+Status WriterBase::upload_tiles(
+    tdb_shared_ptr<FragmentMetadata> frag_meta,
+    uint64_t start_tile_id,
+    std::unordered_map<std::string, std::vector<WriterTile>>* const tiles) {
+  // The files of all the attributes and dimensions. The attributes of a
+  // group are written together in the file of the group.
+  struct TileFile {
+    const std::string* name_;
+    std::vector<WriterTile>* tiles_;
+    unsigned file_;
+    std::optional<unsigned> group_;
+  };
+  std::vector<TileFile> files;
+  std::vector<bool> groups(array_schema_->attribute_groups().size(), false);
   for (auto& it : *tiles) {
-    tasks.push_back(storage_manager_->io_tp()->execute([&, this]() {
-      auto& attr = it.first;
-      auto& tiles = it.second;
-      RETURN_CANCEL_OR_ERROR(write_tiles(attr, frag_meta, 0, &tiles));
+    if (it.second.empty())
+      continue;
+    auto group = array_schema_->attribute_group(it.first);
+    if (group.has_value()) {
+      if (!groups[*group])
+        files.push_back({&it.first, &it.second, 0, group});
+      groups[*group] = true;
+      continue;
+    }
+    const unsigned file_num = 1 + array_schema_->var_size(it.first) +
+                              array_schema_->is_nullable(it.first);
+    for (unsigned f = 0; f < file_num; ++f)
+      files.push_back({&it.first, &it.second, f, std::nullopt});
+  }
 
-      // Fix var size attributes metadata.
-      const auto var_size = array_schema_->var_size(attr);
-      if (has_min_max_metadata(attr, var_size) &&
-          array_schema_->var_size(attr)) {
-        frag_meta->convert_tile_min_max_var_sizes_to_offsets(attr);
-
-        const auto nullable = array_schema_->is_nullable(attr);
-        const uint64_t tile_num_mult = 1 + var_size + nullable;
-        for (uint64_t i = 0; i < tiles.size(); i += tile_num_mult) {
-          auto tile_idx = i / tile_num_mult;
-          frag_meta->set_tile_min_var(attr, tile_idx, tiles[i].min());
-          frag_meta->set_tile_max_var(attr, tile_idx, tiles[i].max());
-        }
-      }
-      return Status::Ok();
-    }));
+  // Each file of an object store is its own multipart upload, bound the
+  // number of uploads at once by the parallel operations of the backend
+  uint64_t max_uploads = files.size();
+  const auto& fragment_uri = frag_meta->fragment_uri();
+  std::string max_parallel_ops_param;
+  if (fragment_uri.is_s3())
+    max_parallel_ops_param = "vfs.s3.max_parallel_ops";
+  else if (fragment_uri.is_azure())
+    max_parallel_ops_param = "vfs.azure.max_parallel_ops";
+  else if (fragment_uri.is_gcs())
+    max_parallel_ops_param = "vfs.gcs.max_parallel_ops";
+  if (!max_parallel_ops_param.empty()) {
+    bool found = false;
+    uint64_t max_parallel_ops = 0;
+    RETURN_NOT_OK(config_.get<uint64_t>(
+        max_parallel_ops_param, &max_parallel_ops, &found));
+    assert(found);
+    max_uploads =
+        std::min(max_uploads, std::max(max_parallel_ops, (uint64_t)1));
   }
 
-  // Wait for writes and check all statuses
-  auto statuses = storage_manager_->io_tp()->wait_all_status(tasks);
-  for (auto& st : statuses)
-    RETURN_NOT_OK(st);
+  // Each task writes the next file until all the files are written
+  const bool close_files = layout_ != Layout::GLOBAL_ORDER;
+  std::atomic<size_t> next_file(0);
+  std::atomic<uint64_t> upload_bytes(0);
+  {
+    auto timer_upload = stats_->start_timer("upload");
+    std::vector<ThreadPool::Task> tasks;
+    for (uint64_t i = 0; i < max_uploads; ++i) {
+      tasks.push_back(storage_manager_->io_tp()->execute([&, this]() {
+        uint64_t task_bytes = 0;
+        for (size_t f = next_file++; f < files.size(); f = next_file++) {
+          const auto& file = files[f];
+          if (file.group_.has_value()) {
+            RETURN_CANCEL_OR_ERROR(write_group_file(
+                *file.group_,
+                frag_meta,
+                start_tile_id,
+                tiles,
+                close_files,
+                &task_bytes));
+            continue;
+          }
+          RETURN_CANCEL_OR_ERROR(write_tile_file(
+              *file.name_,
+              frag_meta,
+              start_tile_id,
+              file.tiles_,
+              file.file_,
+              close_files,
+              &task_bytes));
+        }
+        upload_bytes += task_bytes;
+        return Status::Ok();
+      }));
+    }
+
+    // Wait for writes and check all statuses
+    auto statuses = storage_manager_->io_tp()->wait_all_status(tasks);
+    for (auto& st : statuses)
+      RETURN_NOT_OK(st);
+  }
+  stats_->add_counter("upload_bytes", upload_bytes);
 
   return Status::Ok();
 }
 
-Status WriterBase::write_tiles(
+void WriterBase::set_all_tiles_metadata(
+    tdb_shared_ptr<FragmentMetadata> frag_meta,
+    std::unordered_map<std::string, std::vector<WriterTile>>* const tiles) {
+  for (auto& it : *tiles) {
+    auto& attr = it.first;
+    auto& tiles = it.second;
+    if (tiles.empty())
+      continue;
+    set_tiles_metadata(attr, frag_meta, 0, &tiles);
+
+    // Fix var size attributes metadata.
+    const auto var_size = array_schema_->var_size(attr);
+    if (has_min_max_metadata(attr, var_size) &&
+        array_schema_->var_size(attr)) {
+      frag_meta->convert_tile_min_max_var_sizes_to_offsets(attr);
+
+      const auto nullable = array_schema_->is_nullable(attr);
+      const uint64_t tile_num_mult = 1 + var_size + nullable;
+      for (uint64_t i = 0; i < tiles.size(); i += tile_num_mult) {
+        auto tile_idx = i / tile_num_mult;
+        frag_meta->set_tile_min_var(attr, tile_idx, tiles[i].min());
+        frag_meta->set_tile_max_var(attr, tile_idx, tiles[i].max());
+      }
+    }
+  }
+}
+
+Status WriterBase::write_tile_file(
     const std::string& name,
     tdb_shared_ptr<FragmentMetadata> frag_meta,
     uint64_t start_tile_id,
     std::vector<WriterTile>* const tiles,
-    bool close_files) {
-  auto timer_se = stats_->start_timer("tiles");
-
-  // Handle zero tiles
-  if (tiles->empty())
-    return Status::Ok();
-
+    unsigned file,
+    bool close_file,
+    uint64_t* bytes) {
   // For easy reference
   const bool var_size = array_schema_->var_size(name);
   const bool nullable = array_schema_->is_nullable(name);
-  auto&& [status, uri] = frag_meta->uri(name);
-  RETURN_NOT_OK(status);
+  const uint64_t tile_num_mult = 1 + var_size + nullable;
+  const bool var_file = var_size && file == 1;
+  const bool validity_file = file != 0 && !var_file;
 
   Status st;
-  optional<URI> var_uri;
-  if (!var_size)
-    var_uri = URI("");
-  else {
-    tie(st, var_uri) = frag_meta->var_uri(name);
-    RETURN_NOT_OK(st);
-  }
-
-  optional<URI> validity_uri;
-  if (!nullable)
-    validity_uri = URI("");
-  else {
-    tie(st, validity_uri) = frag_meta->validity_uri(name);
-    RETURN_NOT_OK(st);
-  }
-
-  // Compute and set var buffer sizes for the min/max metadata
-  const auto has_min_max_md = has_min_max_metadata(name, var_size);
-  const auto has_sum_md = has_sum_metadata(name, var_size);
-  auto tile_num = tiles->size();
+  optional<URI> uri;
+  if (file == 0)
+    tie(st, uri) = frag_meta->uri(name);
+  else if (var_file)
+    tie(st, uri) = frag_meta->var_uri(name);
+  else
+    tie(st, uri) = frag_meta->validity_uri(name);
+  RETURN_NOT_OK(st);
 
   // Write tiles
-  for (size_t i = 0, tile_id = start_tile_id; i < tile_num; ++i, ++tile_id) {
+  auto tile_id = start_tile_id;
+  for (size_t i = file; i < tiles->size(); i += tile_num_mult, ++tile_id) {
     WriterTile* tile = &(*tiles)[i];
-    RETURN_NOT_OK(storage_manager_->write(
-        *uri, tile->filtered_buffer().data(), tile->filtered_buffer().size()));
-    frag_meta->set_tile_offset(name, tile_id, tile->filtered_buffer().size());
-
-    auto&& [min, min_size, max, max_size, sum, null_count] = tile->metadata();
-    if (var_size) {
-      ++i;
-
-      tile = &(*tiles)[i];
+    const auto size = tile->filtered_buffer().size();
+    if (size > 0) {
       RETURN_NOT_OK(storage_manager_->write(
-          *var_uri,
-          tile->filtered_buffer().data(),
-          tile->filtered_buffer().size()));
-      frag_meta->set_tile_var_offset(
-          name, tile_id, tile->filtered_buffer().size());
+          *uri, tile->filtered_buffer().data(), size));
+    }
+    if (var_file) {
+      frag_meta->set_tile_var_offset(name, tile_id, size);
       frag_meta->set_tile_var_size(name, tile_id, tile->pre_filtered_size());
-      if (has_min_max_md && null_count != frag_meta->cell_num(tile_id)) {
-        frag_meta->set_tile_min_var_size(name, tile_id, min_size);
-        frag_meta->set_tile_max_var_size(name, tile_id, max_size);
-      }
+    } else if (validity_file) {
+      frag_meta->set_tile_validity_offset(name, tile_id, size);
     } else {
-      if (has_min_max_md && null_count != frag_meta->cell_num(tile_id)) {
-        frag_meta->set_tile_min(name, tile_id, min, min_size);
-        frag_meta->set_tile_max(name, tile_id, max, max_size);
-      }
-
-      if (has_sum_md) {
-        frag_meta->set_tile_sum(name, tile_id, sum);
-      }
+      frag_meta->set_tile_offset(name, tile_id, size);
     }
+    *bytes += size;
+  }
 
-    if (nullable) {
-      ++i;
+  if (close_file)
+    RETURN_NOT_OK(storage_manager_->close_file(*uri));
 
-      tile = &(*tiles)[i];
-      RETURN_NOT_OK(storage_manager_->write(
-          *validity_uri,
-          tile->filtered_buffer().data(),
-          tile->filtered_buffer().size()));
-      frag_meta->set_tile_validity_offset(
-          name, tile_id, tile->filtered_buffer().size());
-      frag_meta->set_tile_null_count(name, tile_id, null_count);
-    }
+  return Status::Ok();
+}
+
+Status WriterBase::write_group_file(
+    unsigned group,
+    tdb_shared_ptr<FragmentMetadata> frag_meta,
+    uint64_t start_tile_id,
+    std::unordered_map<std::string, std::vector<WriterTile>>* const tiles,
+    bool close_file,
+    uint64_t* bytes) {
+  const auto& names = array_schema_->attribute_groups()[group];
+  std::vector<std::vector<WriterTile>*> group_tiles;
+  for (const auto& name : names) {
+    auto it = tiles->find(name);
+    if (it == tiles->end())
+      return LOG_STATUS(Status_WriterError(
+          "Cannot write attribute group; Missing tiles for attribute '" +
+          name + "'"));
+    group_tiles.push_back(&it->second);
   }
 
-  // Close files, except in the case of global order
-  if (close_files && layout_ != Layout::GLOBAL_ORDER) {
-    auto&& [st1, uri] = frag_meta->uri(name);
-    RETURN_NOT_OK(st1);
+  auto&& [st, uri] = frag_meta->uri(names[0]);
+  RETURN_NOT_OK(st);
+
+  // Interleave the tiles of the attributes, all fixed-sized and not
+  // nullable, so that the tiles of a cell range are contiguous
+  const auto tile_num = group_tiles[0]->size();
+  for (size_t t = 0; t < tile_num; ++t) {
+    for (size_t a = 0; a < names.size(); ++a) {
+      assert(group_tiles[a]->size() == tile_num);
+      WriterTile* tile = &(*group_tiles[a])[t];
+      const auto size = tile->filtered_buffer().size();
+      RETURN_NOT_OK(
+          storage_manager_->write(*uri, tile->filtered_buffer().data(), size));
+      frag_meta->set_tile_offset(names[a], start_tile_id + t, size);
+      *bytes += size;
+    }
+  }
 
+  if (close_file)
     RETURN_NOT_OK(storage_manager_->close_file(*uri));
-    if (var_size) {
-      auto&& [st2, var_uri] = frag_meta->var_uri(name);
-      RETURN_NOT_OK(st2);
-      RETURN_NOT_OK(storage_manager_->close_file(*var_uri));
-    }
-    if (nullable) {
-      auto&& [st2, validity_uri] = frag_meta->validity_uri(name);
-      RETURN_NOT_OK(st2);
-      RETURN_NOT_OK(storage_manager_->close_file(*validity_uri));
-    }
+
+  return Status::Ok();
+}
+
+Status WriterBase::write_tiles(
+    const std::string& name,
+    tdb_shared_ptr<FragmentMetadata> frag_meta,
+    uint64_t start_tile_id,
+    std::vector<WriterTile>* const tiles,
+    bool close_files) {
+  auto timer_se = stats_->start_timer("tiles");
+
+  // Handle zero tiles
+  if (tiles->empty())
+    return Status::Ok();
+
+  // Write the files one after the other, closing them except in the case of
+  // global order
+  const unsigned file_num =
+      1 + array_schema_->var_size(name) + array_schema_->is_nullable(name);
+  uint64_t upload_bytes = 0;
+  for (unsigned f = 0; f < file_num; ++f) {
+    RETURN_NOT_OK(write_tile_file(
+        name,
+        frag_meta,
+        start_tile_id,
+        tiles,
+        f,
+        close_files && layout_ != Layout::GLOBAL_ORDER,
+        &upload_bytes));
   }
+  stats_->add_counter("upload_bytes", upload_bytes);
+
+  set_tiles_metadata(name, frag_meta, start_tile_id, tiles);
 
   return Status::Ok();
 }
@@ -125,6 +125,12 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
   /** Sets current setting of dedup_coords_ */
   void set_dedup_coords(bool b);
 
+  /** Sets the progress to update as the query is processed. */
+  void set_progress(QueryProgress* progress);
+
+  /** Writers cannot be rebound, a new writer is created instead. */
+  Status rebind();
+
  protected:
   /* ********************************* */
   /*        PROTECTED ATTRIBUTES       */
@@ -175,6 +181,21 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
    */
   bool dedup_coords_;
 
+  /**
+   * The number of bits per cell of the Bloom filter over the coordinates
+   * stored with sparse fragments. If 0, no filter is stored.
+   */
+  uint64_t coords_bloom_filter_bits_per_cell_;
+
+  /**
+   * If `true`, the tiles of dense fragments that only hold fill values are
+   * not stored.
+   */
+  bool elide_fill_tiles_;
+
+  /** The attributes indexed by value in the written fragments. */
+  std::vector<std::string> attribute_index_names_;
+
   /** The name of the new fragment to be created. */
   URI fragment_uri_;
 
@@ -197,13 +218,20 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
   /** Adss a fragment to `written_fragment_info_`. */
   Status add_written_fragment_info(const URI& uri);
 
+  /**
+   * Makes a written fragment visible by creating its ok file. The parts of
+   * a fragment written in parts are committed together instead, once all
+   * of them are written.
+   */
+  Status commit_fragment(const URI& uri) const;
+
   /** Calculates the hilbert values of the input coordinate buffers. */
   Status calculate_hilbert_values(
       const std::vector<const QueryBuffer*>& buffs,
       std::vector<uint64_t>* hilbert_values) const;
 
   /** Correctness checks for buffer sizes. */
-  Status check_buffer_sizes() const;
+  virtual Status check_buffer_sizes() const;
 
   /**
    * Throws an error if there are coordinates falling out-of-bounds, i.e.,
@@ -244,6 +272,34 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
       const std::unordered_map<std::string, std::vector<WriterTile>>& tiles,
       tdb_shared_ptr<FragmentMetadata> meta) const;
 
+  /**
+   * Computes the hashes of the coordinates of the cells in a tile, from
+   * which the fragment coordinates Bloom filter is built.
+   *
+   * @param tiles The coordinate tiles, one vector of tiles per dimension.
+   * @param tile_idx The index of the tile whose cells will be hashed.
+   * @param hashes The cell hashes to be computed.
+   */
+  void compute_coords_hashes(
+      const std::unordered_map<std::string, std::vector<WriterTile>>& tiles,
+      uint64_t tile_idx,
+      std::vector<uint64_t>* hashes) const;
+
+  /**
+   * Computes the attribute value index, i.e., a Bloom filter over the
+   * non-null values of each tile of every indexed attribute.
+   *
+   * @param tile_num The number of tiles.
+   * @param tiles The tiles to index. It is a map of vectors, one vector of
+   *     tiles per attribute.
+   * @param meta The fragment metadata that will store the index.
+   * @return Status
+   */
+  Status compute_attribute_index(
+      uint64_t tile_num,
+      const std::unordered_map<std::string, std::vector<WriterTile>>& tiles,
+      tdb_shared_ptr<FragmentMetadata> meta) const;
+
   /**
    * Computes the tiles metadata (min/max/sum/null count).
    *
@@ -267,10 +323,13 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
    *
    * @param dense Whether the fragment is dense or not.
    * @param frag_meta The fragment metadata to be generated.
+   * @param packed Whether the fragment files are packed in a single object.
    * @return Status
    */
   Status create_fragment(
-      bool dense, tdb_shared_ptr<FragmentMetadata>& frag_meta) const;
+      bool dense,
+      tdb_shared_ptr<FragmentMetadata>& frag_meta,
+      bool packed = false) const;
 
   /**
    * Runs the input coordinate and attribute tiles through their
@@ -290,6 +349,23 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
    */
   Status filter_tiles(const std::string& name, std::vector<WriterTile>* tiles);
 
+  /**
+   * Checks whether the tile of a fixed-sized attribute of a dense array,
+   * along with its validity tile, only holds the fill value of the
+   * attribute. Such tiles are left unfiltered with an empty filtered
+   * buffer, so that they are recorded with a zero persisted size and no
+   * data is written for them.
+   *
+   * @param name The attribute the tiles belong to.
+   * @param tile The data tile.
+   * @param validity_tile The validity tile, or null.
+   * @return True if the tiles are elided.
+   */
+  bool elide_fill_tile(
+      const std::string& name,
+      WriterTile* tile,
+      WriterTile* validity_tile) const;
+
   /**
    * Runs the input tile for the input attribute/dimension through the filter
    * pipeline. The tile buffer is modified to contain the output of the
@@ -454,6 +530,21 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
     return offsets_format_mode_ == "elements" ? offset * datasize : offset;
   }
 
+  /**
+   * Sets the min/max, sum and null count metadata of the input tiles of an
+   * attribute/dimension in the fragment metadata.
+   *
+   * @param name The attribute/dimension the tiles belong to.
+   * @param frag_meta The fragment metadata.
+   * @param start_tile_id The id of the first tile in the fragment.
+   * @param tiles The tiles of the attribute/dimension.
+   */
+  void set_tiles_metadata(
+      const std::string& name,
+      tdb_shared_ptr<FragmentMetadata> frag_meta,
+      uint64_t start_tile_id,
+      std::vector<WriterTile>* tiles);
+
   /**
    * Splits the coordinates buffer into separate coordinate
    * buffers, one per dimension. Note that this will require extra memory
@@ -464,17 +555,92 @@ class WriterBase : public StrategyBase, public IQueryStrategy {
   Status split_coords_buffer();
 
   /**
-   * Writes all the input tiles to storage.
+   * Writes all the input tiles to storage and sets their metadata in the
+   * fragment metadata.
    *
+   * @param frag_meta The fragment metadata.
    * @param tiles Attribute/Coordinate tiles to be written, one element per
    *     attribute or dimension.
-   * @param tiles Attribute/Coordinate tiles to be written.
    * @return Status
    */
   Status write_all_tiles(
       tdb_shared_ptr<FragmentMetadata> frag_meta,
       std::unordered_map<std::string, std::vector<WriterTile>>* tiles);
 
+  /**
+   * Uploads all the input tiles to storage and sets their offsets in the
+   * fragment metadata. The files of all the attributes and dimensions are
+   * uploaded concurrently on the IO thread pool, at most
+   * `vfs.<backend>.max_parallel_ops` at once on object stores.
+   *
+   * @param frag_meta The fragment metadata.
+   * @param start_tile_id The id of the first tile in the fragment.
+   * @param tiles Attribute/Coordinate tiles to be written, one element per
+   *     attribute or dimension.
+   * @return Status
+   */
+  Status upload_tiles(
+      tdb_shared_ptr<FragmentMetadata> frag_meta,
+      uint64_t start_tile_id,
+      std::unordered_map<std::string, std::vector<WriterTile>>* tiles);
+
+  /**
+   * Sets the metadata of all the input tiles in the fragment metadata, once
+   * all the tiles of the write have been uploaded.
+   *
+   * @param frag_meta The fragment metadata.
+   * @param tiles Attribute/Coordinate tiles, one element per attribute or
+   *     dimension.
+   */
+  void set_all_tiles_metadata(
+      tdb_shared_ptr<FragmentMetadata> frag_meta,
+      std::unordered_map<std::string, std::vector<WriterTile>>* tiles);
+
+  /**
+   * Writes the tiles of the attributes of an attribute group to the file of
+   * the group, interleaved in the order of the group, and sets their offsets
+   * in the fragment metadata.
+   *
+   * @param group The index of the attribute group.
+   * @param frag_meta The fragment metadata.
+   * @param start_tile_id The id of the first tile in the fragment.
+   * @param tiles The tiles, one element per attribute or dimension.
+   * @param close_file Whether to close the file after writing the tiles.
+   * @param bytes Incremented by the number of bytes written.
+   * @return Status
+   */
+  Status write_group_file(
+      unsigned group,
+      tdb_shared_ptr<FragmentMetadata> frag_meta,
+      uint64_t start_tile_id,
+      std::unordered_map<std::string, std::vector<WriterTile>>* tiles,
+      bool close_file,
+      uint64_t* bytes);
+
+  /**
+   * Writes the tiles of an attribute/dimension that go to one of its files,
+   * and sets their offsets in the fragment metadata.
+   *
+   * @param name The attribute/dimension the tiles belong to.
+   * @param frag_meta The fragment metadata.
+   * @param start_tile_id The id of the first tile in the fragment.
+   * @param tiles The tiles of the attribute/dimension.
+   * @param file The position of the tiles of the file in each group of tiles
+   *     of the same cells: 0 for the fixed-sized tiles or the offsets, 1 for
+   *     the var-sized tiles, and the last one for the validity tiles.
+   * @param close_file Whether to close the file after writing the tiles.
+   * @param bytes Incremented by the number of bytes written.
+   * @return Status
+   */
+  Status write_tile_file(
+      const std::string& name,
+      tdb_shared_ptr<FragmentMetadata> frag_meta,
+      uint64_t start_tile_id,
+      std::vector<WriterTile>* tiles,
+      unsigned file,
+      bool close_file,
+      uint64_t* bytes);
+
   /**
    * Writes the input tiles for the input attribute/dimension to storage.
    *
@@ -243,12 +243,61 @@ size_t write_header_callback(
           header_scheme + "://" + header_value_domain;
       std::unique_lock<std::mutex> rd_lck(*(pmHeader->redirect_uri_map_lock));
       (*pmHeader->redirect_uri_map)[*pmHeader->uri] = redirection_value;
+    } else if (header_key == "etag") {
+      // Strip the ": " and the trailing CR LF as above
+      pmHeader->etag = header.substr(
+          header_key_end_pos + 2, header_length - header_key_end_pos - 4);
     }
   }
 
   return size * count;
 }
 
+CurlConnectionPool::CurlConnectionPool()
+    : share_(nullptr, curl_share_cleanup) {
+}
+
+Status CurlConnectionPool::init() {
+  share_.reset(curl_share_init());
+  if (share_ == nullptr)
+    return LOG_STATUS(Status_RestError(
+        "Error initializing libcurl connection pool; share init failed"));
+
+  CURLSH* share = share_.get();
+  if (curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock) != CURLSHE_OK ||
+      curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock) != CURLSHE_OK ||
+      curl_share_setopt(share, CURLSHOPT_USERDATA, this) != CURLSHE_OK)
+    return LOG_STATUS(Status_RestError(
+        "Error initializing libcurl connection pool; failed to set the lock "
+        "functions"));
+
+  // DNS entries and TLS sessions can be shared by all supported libcurl
+  // versions, connections only since 7.57.
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+  curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+
+  return Status::Ok();
+}
+
+Status CurlConnectionPool::attach(CURL* curl) const {
+  if (curl_easy_setopt(curl, CURLOPT_SHARE, share_.get()) != CURLE_OK)
+    return LOG_STATUS(Status_RestError(
+        "Error initializing libcurl; failed to set CURLOPT_SHARE"));
+  return Status::Ok();
+}
+
+void CurlConnectionPool::lock(
+    CURL*, curl_lock_data data, curl_lock_access, void* pool) {
+  static_cast<CurlConnectionPool*>(pool)->mtx_[data].lock();
+}
+
+void CurlConnectionPool::unlock(CURL*, curl_lock_data data, void* pool) {
+  static_cast<CurlConnectionPool*>(pool)->mtx_[data].unlock();
+}
+
 Curl::Curl()
     : config_(nullptr)
     , curl_(nullptr, curl_easy_cleanup)
@@ -261,7 +310,8 @@ Status Curl::init(
     const Config* config,
     const std::unordered_map<std::string, std::string>& extra_headers,
     std::unordered_map<std::string, std::string>* const res_headers,
-    std::mutex* const res_mtx) {
+    std::mutex* const res_mtx,
+    const CurlConnectionPool* const connection_pool) {
   if (config == nullptr)
     return LOG_STATUS(
         Status_RestError("Error initializing libcurl; config is null."));
@@ -338,6 +388,42 @@ Status Curl::init(
       "rest.retry_http_codes", &retry_http_codes_, &found));
   assert(found);
 
+  // Reuse the connections of previous requests, keeping them alive
+  // in between
+  if (connection_pool != nullptr)
+    RETURN_NOT_OK(connection_pool->attach(curl_.get()));
+  curl_easy_setopt(curl_.get(), CURLOPT_TCP_KEEPALIVE, 1L);
+
+  // Negotiate HTTP/2 over TLS if the user has set rest.http2 = true. This
+  // fails if libcurl was built without HTTP/2 support, in which case
+  // HTTP/1.1 is used.
+  bool http2 = false;
+  RETURN_NOT_OK(config_->get<bool>("rest.http2", &http2, &found));
+  assert(found);
+  if (http2)
+    curl_easy_setopt(
+        curl_.get(), CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+
+  return Status::Ok();
+}
+
+void Curl::add_header(const std::string& name, const std::string& value) {
+  extra_headers_[name] = value;
+}
+
+const std::string& Curl::etag() const {
+  return headerData.etag;
+}
+
+Status Curl::last_http_code(long* const http_code) const {
+  *http_code = 0;
+  CURL* curl = curl_.get();
+  if (curl == nullptr)
+    return LOG_STATUS(
+        Status_RestError("Error getting HTTP code; curl instance is null."));
+  if (curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, http_code) != CURLE_OK)
+    return LOG_STATUS(
+        Status_RestError("Error getting HTTP code; curl getinfo failed."));
   return Status::Ok();
 }
 
@@ -514,6 +600,15 @@ Status Curl::make_curl_request_common(
     /* fetch the url */
     CURLcode tmp_curl_code = curl_easy_perform(curl);
 
+    // Track whether the request reused a pooled connection
+    long num_connects = 0;
+    if (curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &num_connects) ==
+        CURLE_OK)
+      stats->add_counter(
+          num_connects == 0 ? "rest_connection_reused_num" :
+                              "rest_connection_new_num",
+          1);
+
     bool retry;
     RETURN_NOT_OK(should_retry(&retry));
     /* If Curl call was successful (not http status, but no socket error, etc)
@@ -542,13 +637,15 @@ Status Curl::make_curl_request_common(
         return LOG_STATUS(Status_RestError(
             "Error checking curl error; could not get HTTP code."));
 
-      global_logger().debug(
-          "Request to {} failed with http response code {}, will sleep {}ms, "
-          "retry count {}",
-          url,
-          http_code,
-          retry_delay,
-          i);
+      // A failing server makes every client retry, so warn at most once a
+      // second rather than once per request.
+      TILEDB_LOG_WARN_RATE_LIMITED(
+          global_logger(),
+          1000,
+          "Request to " + std::string(url) +
+              " failed with http response code " + std::to_string(http_code) +
+              ", will sleep " + std::to_string(retry_delay) +
+              "ms, retry count " + std::to_string(i));
       // Increment counter for number of retries
       stats->add_counter("rest_http_retries", 1);
       stats->add_counter("rest_http_retry_time", retry_delay);
@@ -748,6 +845,7 @@ Status Curl::get_data(
 
   CURLcode ret;
   headerData.uri = &res_ns_uri;
+  headerData.etag.clear();
   auto st = make_curl_request(stats, url.c_str(), &ret, returned_data);
   curl_slist_free_all(headers);
   RETURN_NOT_OK(st);
@@ -76,6 +76,9 @@ struct HeaderCbData {
 
   /** A pointer to the lock attached to the shared resource of the cache map */
   std::mutex* redirect_uri_map_lock;
+
+  /** The value of the `ETag` header of the latest response, if any. */
+  std::string etag;
 };
 
 /**
@@ -94,6 +97,44 @@ struct HeaderCbData {
 size_t write_header_callback(
     void* res_data, size_t size, size_t count, void* userdata);
 
+/**
+ * A pool of the connections, TLS sessions and DNS entries shared by the
+ * libcurl handles of a REST client. Requests performed with handles
+ * attached to the pool reuse the kept-alive connections of previous
+ * requests instead of performing new handshakes. The pool is threadsafe and
+ * must outlive the handles attached to it.
+ */
+class CurlConnectionPool {
+ public:
+  /** Constructor. */
+  CurlConnectionPool();
+
+  /** Destructor. */
+  ~CurlConnectionPool() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(CurlConnectionPool);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(CurlConnectionPool);
+
+  /** Initializes the pool. */
+  Status init();
+
+  /** Attaches the input libcurl handle to the pool. */
+  Status attach(CURL* curl) const;
+
+ private:
+  /** The libcurl share handle. */
+  std::unique_ptr<CURLSH, decltype(&curl_share_cleanup)> share_;
+
+  /** One mutex per type of data shared by the handles. */
+  std::mutex mtx_[CURL_LOCK_DATA_LAST];
+
+  /** Locks the mutex of the input data, invoked by libcurl. */
+  static void lock(CURL*, curl_lock_data data, curl_lock_access, void* pool);
+
+  /** Unlocks the mutex of the input data, invoked by libcurl. */
+  static void unlock(CURL*, curl_lock_data data, void* pool);
+};
+
 class Curl {
  public:
   /** Constructor. */
@@ -113,13 +154,35 @@ class Curl {
    * @param res_ns_uri Pointer to Array namespace : Array URI cache key
    * @param res_headers Pointer to cache map
    * @param res_mtx Pointer to mtx that handles the lock of the cache map
+   * @param connection_pool The pool of connections to reuse, or null to
+   *     connect for every request.
    * @return Status
    */
   Status init(
       const Config* config,
       const std::unordered_map<std::string, std::string>& extra_headers,
       std::unordered_map<std::string, std::string>* res_headers,
-      std::mutex* res_mtx);
+      std::mutex* res_mtx,
+      const CurlConnectionPool* connection_pool = nullptr);
+
+  /**
+   * Attaches an additional header to the requests.
+   *
+   * @param name Header name
+   * @param value Header value
+   */
+  void add_header(const std::string& name, const std::string& value);
+
+  /** Returns the `ETag` header of the latest response, or an empty string. */
+  const std::string& etag() const;
+
+  /**
+   * Gets the HTTP code of the latest response.
+   *
+   * @param http_code Set to the HTTP code
+   * @return Status
+   */
+  Status last_http_code(long* http_code) const;
 
   /**
    * Escapes the given URL.
@@ -47,12 +47,18 @@
 #endif
 
 #include <cassert>
+#include <cstring>
 
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/crypto/crypto.h"
+#include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/endian.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/parse_argument.h"
 #include "tiledb/sm/query/query.h"
 #include "tiledb/sm/rest/rest_client.h"
@@ -65,11 +71,39 @@ namespace sm {
 
 #ifdef TILEDB_SERIALIZATION
 
+/** The size of the chunks of a request compressed in parallel. */
+static const uint64_t request_compression_chunk_size = 4 * 1024 * 1024;
+
+RestPrefetch::RestPrefetch(ThreadPool* const io_tp)
+    : io_tp_(io_tp) {
+}
+
+RestPrefetch::~RestPrefetch() {
+  wait();
+}
+
+bool RestPrefetch::pending() const {
+  return !tasks_.empty();
+}
+
+Status RestPrefetch::wait() {
+  if (tasks_.empty())
+    return Status::Ok();
+  const Status st = io_tp_->wait_all(tasks_);
+  tasks_.clear();
+  return st;
+}
+
 RestClient::RestClient()
     : stats_(nullptr)
     , config_(nullptr)
     , compute_tp_(nullptr)
-    , resubmit_incomplete_(true) {
+    , io_tp_(nullptr)
+    , resubmit_incomplete_(true)
+    , request_compressor_("none")
+    , request_compression_min_size_(0)
+    , pipeline_array_open_(false)
+    , prefetch_incomplete_(false) {
   auto st = utils::parse::convert(
       Config::REST_SERIALIZATION_DEFAULT_FORMAT, &serialization_type_);
   assert(st.ok());
@@ -79,7 +113,8 @@ RestClient::RestClient()
 Status RestClient::init(
     stats::Stats* const parent_stats,
     const Config* config,
-    ThreadPool* compute_tp) {
+    ThreadPool* compute_tp,
+    ThreadPool* io_tp) {
   if (config == nullptr)
     return LOG_STATUS(
         Status_RestError("Error initializing rest client; config is null."));
@@ -88,6 +123,7 @@ Status RestClient::init(
 
   config_ = config;
   compute_tp_ = compute_tp;
+  io_tp_ = io_tp;
 
   const char* c_str;
   RETURN_NOT_OK(config_->get("rest.server_address", &c_str));
@@ -105,6 +141,29 @@ Status RestClient::init(
   RETURN_NOT_OK(config_->get<bool>(
       "rest.resubmit_incomplete", &resubmit_incomplete_, &found));
 
+  RETURN_NOT_OK(config_->get("rest.request_compressor", &c_str));
+  if (c_str != nullptr)
+    request_compressor_ = std::string(c_str);
+  RETURN_NOT_OK(config_->get<uint64_t>(
+      "rest.request_compression_min_size",
+      &request_compression_min_size_,
+      &found));
+  assert(found);
+  RETURN_NOT_OK(config_->get<bool>(
+      "rest.prefetch_incomplete", &prefetch_incomplete_, &found));
+  assert(found);
+  RETURN_NOT_OK(config_->get<bool>(
+      "rest.pipeline_array_open", &pipeline_array_open_, &found));
+  assert(found);
+
+  bool share_connections = true;
+  RETURN_NOT_OK(config_->get<bool>(
+      "rest.share_connections", &share_connections, &found));
+  if (share_connections) {
+    connection_pool_ = make_shared<CurlConnectionPool>(HERE());
+    RETURN_NOT_OK(connection_pool_->init());
+  }
+
   return Status::Ok();
 }
 
@@ -121,21 +180,64 @@ Status RestClient::get_array_schema_from_rest(
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri);
 
+  // Revalidate the schema received for the array last time, if any
+  CachedArraySchema cached;
+  {
+    std::lock_guard<std::mutex> lck(array_schema_cache_mtx_);
+    auto it = array_schema_cache_.find(cache_key);
+    if (it != array_schema_cache_.end())
+      cached = it->second;
+  }
+  if (!cached.etag_.empty())
+    curlc.add_header("If-None-Match", cached.etag_);
+
   // Get the data
   Buffer returned_data;
   RETURN_NOT_OK(curlc.get_data(
       stats_, url, serialization_type_, &returned_data, cache_key));
+  long http_code = 0;
+  RETURN_NOT_OK(curlc.last_http_code(&http_code));
+  if (http_code == 304 && cached.array_schema_ != nullptr) {
+    stats_->add_counter("rest_array_schema_not_modified_num", 1);
+    *array_schema = tdb_new(ArraySchema, cached.array_schema_.get());
+    return Status::Ok();
+  }
   if (returned_data.data() == nullptr || returned_data.size() == 0)
     return LOG_STATUS(Status_RestError(
         "Error getting array schema from REST; server returned no data."));
 
-  return serialization::array_schema_deserialize(
-      array_schema, serialization_type_, returned_data);
+  // Servers without validators send the schema again, whose deserialization
+  // is skipped if it did not change.
+  Buffer digest_buff;
+  RETURN_NOT_OK(Crypto::sha256(
+      returned_data.data(), returned_data.size(), &digest_buff));
+  const std::string digest(
+      static_cast<const char*>(digest_buff.data()),
+      Crypto::SHA256_DIGEST_BYTES);
+  if (cached.array_schema_ != nullptr && digest == cached.digest_) {
+    stats_->add_counter("rest_array_schema_unchanged_num", 1);
+    *array_schema = tdb_new(ArraySchema, cached.array_schema_.get());
+  } else {
+    RETURN_NOT_OK(serialization::array_schema_deserialize(
+        array_schema, serialization_type_, returned_data));
+    cached.array_schema_ = make_shared<ArraySchema>(HERE(), *array_schema);
+  }
+
+  cached.etag_ = curlc.etag();
+  cached.digest_ = digest;
+  std::lock_guard<std::mutex> lck(array_schema_cache_mtx_);
+  array_schema_cache_[cache_key] = std::move(cached);
+
+  return Status::Ok();
 }
 
 Status RestClient::post_array_schema_to_rest(
@@ -160,8 +262,12 @@ Status RestClient::post_array_schema_to_rest(
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   auto deduced_url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns + "/" +
                      curlc.url_escape(array_uri);
   Buffer returned_data;
@@ -181,8 +287,12 @@ Status RestClient::deregister_array_from_rest(const URI& uri) {
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri) + "/deregister";
 
@@ -200,13 +310,31 @@ Status RestClient::get_array_non_empty_domain(
     return LOG_STATUS(Status_RestError(
         "Cannot get array non-empty domain; array URI is empty"));
 
+  Buffer returned_data;
+  RETURN_NOT_OK(get_array_non_empty_domain_data(
+      array->array_uri(), timestamp_start, timestamp_end, &returned_data));
+
+  // Deserialize data returned
+  return serialization::nonempty_domain_deserialize(
+      array, returned_data, serialization_type_);
+}
+
+Status RestClient::get_array_non_empty_domain_data(
+    const URI& uri,
+    uint64_t timestamp_start,
+    uint64_t timestamp_end,
+    Buffer* returned_data) {
   // Init curl and form the URL
   Curl curlc;
   std::string array_ns, array_uri;
-  RETURN_NOT_OK(array->array_uri().get_rest_components(&array_ns, &array_uri));
+  RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v2/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri) +
                           "/non_empty_domain?" +
@@ -214,18 +342,15 @@ Status RestClient::get_array_non_empty_domain(
                           "&end_timestamp=" + std::to_string(timestamp_end);
 
   // Get the data
-  Buffer returned_data;
   RETURN_NOT_OK(curlc.get_data(
-      stats_, url, serialization_type_, &returned_data, cache_key));
+      stats_, url, serialization_type_, returned_data, cache_key));
 
-  if (returned_data.data() == nullptr || returned_data.size() == 0)
+  if (returned_data->data() == nullptr || returned_data->size() == 0)
     return LOG_STATUS(
         Status_RestError("Error getting array non-empty domain "
                          "from REST; server returned no data."));
 
-  // Deserialize data returned
-  return serialization::nonempty_domain_deserialize(
-      array, returned_data, serialization_type_);
+  return Status::Ok();
 }
 
 Status RestClient::get_array_max_buffer_sizes(
@@ -245,8 +370,12 @@ Status RestClient::get_array_max_buffer_sizes(
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri) +
                           "/max_buffer_sizes" + subarray_query_param;
@@ -275,13 +404,30 @@ Status RestClient::get_array_metadata_from_rest(
     return LOG_STATUS(Status_RestError(
         "Error getting array metadata from REST; array is null."));
 
+  Buffer returned_data;
+  RETURN_NOT_OK(get_array_metadata_data(
+      uri, timestamp_start, timestamp_end, &returned_data));
+
+  return serialization::array_metadata_deserialize(
+      array, serialization_type_, returned_data);
+}
+
+Status RestClient::get_array_metadata_data(
+    const URI& uri,
+    uint64_t timestamp_start,
+    uint64_t timestamp_end,
+    Buffer* returned_data) {
   // Init curl and form the URL
   Curl curlc;
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri) +
                           "/array_metadata?" +
@@ -289,15 +435,73 @@ Status RestClient::get_array_metadata_from_rest(
                           "&end_timestamp=" + std::to_string(timestamp_end);
 
   // Get the data
-  Buffer returned_data;
   RETURN_NOT_OK(curlc.get_data(
-      stats_, url, serialization_type_, &returned_data, cache_key));
-  if (returned_data.data() == nullptr || returned_data.size() == 0)
+      stats_, url, serialization_type_, returned_data, cache_key));
+  if (returned_data->data() == nullptr || returned_data->size() == 0)
     return LOG_STATUS(Status_RestError(
         "Error getting array metadata from REST; server returned no data."));
 
-  return serialization::array_metadata_deserialize(
-      array, serialization_type_, returned_data);
+  return Status::Ok();
+}
+
+Status RestClient::open_array_from_rest(
+    Array* array,
+    uint64_t timestamp_start,
+    uint64_t timestamp_end,
+    ArraySchema** array_schema,
+    bool* non_empty_domain_loaded,
+    bool* metadata_loaded) {
+  if (array == nullptr)
+    return LOG_STATUS(
+        Status_RestError("Cannot open array from REST; array is null"));
+
+  *non_empty_domain_loaded = false;
+  *metadata_loaded = false;
+  const URI& uri = array->array_uri();
+  if (!pipeline_array_open_)
+    return get_array_schema_from_rest(uri, array_schema);
+
+  // The server has no combined endpoint for the open array state, so the
+  // requests are pipelined instead: the non-empty domain and metadata are
+  // fetched on the io thread pool while the schema is fetched here.
+  auto timer_se = stats_->start_timer("rest_array_open_pipelined");
+  Buffer non_empty_domain_data, metadata_data;
+  Status non_empty_domain_st, metadata_st;
+  std::vector<ThreadPool::Task> tasks;
+  tasks.emplace_back(io_tp_->execute([&]() {
+    non_empty_domain_st = get_array_non_empty_domain_data(
+        uri, timestamp_start, timestamp_end, &non_empty_domain_data);
+    return Status::Ok();
+  }));
+  tasks.emplace_back(io_tp_->execute([&]() {
+    metadata_st = get_array_metadata_data(
+        uri, timestamp_start, timestamp_end, &metadata_data);
+    return Status::Ok();
+  }));
+
+  // Always wait, the tasks reference the local buffers
+  const Status st = get_array_schema_from_rest(uri, array_schema);
+  RETURN_NOT_OK(io_tp_->wait_all(tasks));
+  RETURN_NOT_OK(st);
+  stats_->add_counter("rest_array_open_pipelined_num", 1);
+
+  // The non-empty domain is deserialized against the schema set above.
+  // Failures are not fatal, the state is fetched again on first use.
+  if (non_empty_domain_st.ok() &&
+      serialization::nonempty_domain_deserialize(
+          array, non_empty_domain_data, serialization_type_)
+          .ok())
+    *non_empty_domain_loaded = true;
+  if (metadata_st.ok()) {
+    if (serialization::array_metadata_deserialize(
+            array, serialization_type_, metadata_data)
+            .ok())
+      *metadata_loaded = true;
+    else
+      array->metadata()->clear();
+  }
+
+  return Status::Ok();
 }
 
 Status RestClient::post_array_metadata_to_rest(
@@ -321,8 +525,12 @@ Status RestClient::post_array_metadata_to_rest(
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns +
                           "/" + curlc.url_escape(array_uri) +
                           "/array_metadata?" +
@@ -372,21 +580,30 @@ Status RestClient::post_query_submit(
   RETURN_NOT_OK(serialization::query_serialize(
       query, serialization_type_, true, &serialized));
 
-  // Init curl and form the URL
-  Curl curlc;
-  std::string array_ns, array_uri;
-  RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
-  const std::string cache_key = array_ns + ":" + array_uri;
+  // The server may have already answered this submission in the background
+  bool prefetched = false;
   RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
-  std::string url = redirect_uri(cache_key) + "/v2/arrays/" + array_ns + "/" +
-                    curlc.url_escape(array_uri) +
-                    "/query/submit?type=" + query_type_str(query->type()) +
-                    "&read_all=" + (resubmit_incomplete_ ? "true" : "false");
+      use_prefetched_response(query, &serialized, copy_state, &prefetched));
+  if (prefetched)
+    return prefetch_submission(uri, query);
 
-  // Remote array reads always supply the timestamp.
-  url += "&start_timestamp=" + std::to_string(array->timestamp_start());
-  url += "&end_timestamp=" + std::to_string(array->timestamp_end());
+  // Compress it, if configured
+  BufferList compressed;
+  std::string content_encoding;
+  RETURN_NOT_OK(compress_request(&serialized, &compressed, &content_encoding));
+
+  // Init curl and form the URL
+  Curl curlc;
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
+  if (!content_encoding.empty())
+    curlc.add_header("Content-Encoding", content_encoding);
+  std::string url, cache_key;
+  RETURN_NOT_OK(query_submit_url(uri, query, curlc, &url, &cache_key));
 
   // Create the callback that will process the response buffers as they
   // are received.
@@ -405,7 +622,7 @@ Status RestClient::post_query_submit(
       stats_,
       url,
       serialization_type_,
-      &serialized,
+      content_encoding.empty() ? &serialized : &compressed,
       rest_scratch.get(),
       std::move(write_cb),
       cache_key);
@@ -417,8 +634,133 @@ Status RestClient::post_query_submit(
         "Curl error: " +
         st.message()));
   }
+  RETURN_NOT_OK(st);
 
-  return st;
+  return prefetch_submission(uri, query);
+}
+
+Status RestClient::query_submit_url(
+    const URI& uri,
+    const Query* query,
+    const Curl& curlc,
+    std::string* url,
+    std::string* cache_key) {
+  std::string array_ns, array_uri;
+  RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
+  *cache_key = array_ns + ":" + array_uri;
+  *url = redirect_uri(*cache_key) + "/v2/arrays/" + array_ns + "/" +
+         curlc.url_escape(array_uri) +
+         "/query/submit?type=" + query_type_str(query->type()) +
+         "&read_all=" + (resubmit_incomplete_ ? "true" : "false");
+
+  // Remote array reads always supply the timestamp.
+  const Array* array = query->array();
+  *url += "&start_timestamp=" + std::to_string(array->timestamp_start());
+  *url += "&end_timestamp=" + std::to_string(array->timestamp_end());
+
+  return Status::Ok();
+}
+
+Status RestClient::use_prefetched_response(
+    Query* query,
+    BufferList* serialized,
+    serialization::CopyState* copy_state,
+    bool* used) {
+  *used = false;
+  auto prefetch = query->rest_prefetch();
+  if (prefetch == nullptr || !prefetch->pending())
+    return Status::Ok();
+
+  // The prefetched response is used only if the user did not change the
+  // query, e.g. its buffers, since it was submitted.
+  const Status st = prefetch->wait();
+  const uint64_t request_size = serialized->total_size();
+  Buffer request;
+  RETURN_NOT_OK(request.realloc(std::max<uint64_t>(request_size, 1)));
+  serialized->reset_offset();
+  RETURN_NOT_OK(serialized->read(request.data(), request_size));
+  serialized->reset_offset();
+  if (!st.ok() || prefetch->response_.size() == 0 ||
+      prefetch->request_.size() != request_size ||
+      std::memcmp(prefetch->request_.data(), request.data(), request_size) !=
+          0) {
+    stats_->add_counter("rest_prefetch_miss_num", 1);
+    return Status::Ok();
+  }
+
+  bool skip_retries = false;
+  const size_t processed = query_post_call_back(
+      false,
+      prefetch->response_.data(),
+      prefetch->response_.size(),
+      &skip_retries,
+      query->rest_scratch(),
+      query,
+      copy_state);
+  if (processed != prefetch->response_.size())
+    return LOG_STATUS(Status_RestError(
+        "Error submitting query to REST; cannot deserialize the prefetched "
+        "response"));
+  stats_->add_counter("rest_prefetch_hit_num", 1);
+
+  *used = true;
+  return Status::Ok();
+}
+
+Status RestClient::prefetch_submission(const URI& uri, Query* query) {
+  if (!prefetch_incomplete_ || resubmit_incomplete_ || io_tp_ == nullptr ||
+      query->type() != QueryType::READ ||
+      query->status() != QueryStatus::INCOMPLETE)
+    return Status::Ok();
+
+  auto prefetch = query->rest_prefetch();
+  if (prefetch == nullptr) {
+    prefetch = make_shared<RestPrefetch>(HERE(), io_tp_);
+    query->set_rest_prefetch(prefetch);
+  }
+
+  // The query now carries the state of the next partition, which is what
+  // its next submission will send unless the user changes it.
+  BufferList serialized;
+  RETURN_NOT_OK(serialization::query_serialize(
+      query, serialization_type_, true, &serialized));
+  const uint64_t request_size = serialized.total_size();
+  prefetch->request_.reset_size();
+  prefetch->request_.reset_offset();
+  RETURN_NOT_OK(
+      prefetch->request_.realloc(std::max<uint64_t>(request_size, 1)));
+  RETURN_NOT_OK(serialized.read(prefetch->request_.data(), request_size));
+  prefetch->request_.advance_size(request_size);
+  prefetch->response_.reset_size();
+  prefetch->response_.reset_offset();
+
+  auto curlc = make_shared<Curl>(HERE());
+  RETURN_NOT_OK(curlc->init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
+  std::string url, cache_key;
+  RETURN_NOT_OK(query_submit_url(uri, query, *curlc, &url, &cache_key));
+
+  stats_->add_counter("rest_prefetch_num", 1);
+  RestPrefetch* const prefetch_ptr = prefetch.get();
+  prefetch->tasks_.emplace_back(io_tp_->execute(
+      [this, curlc, url, cache_key, prefetch_ptr]() {
+        BufferList request;
+        RETURN_NOT_OK(request.add_buffer(Buffer(
+            prefetch_ptr->request_.data(), prefetch_ptr->request_.size())));
+        return curlc->post_data(
+            stats_,
+            url,
+            serialization_type_,
+            &request,
+            &prefetch_ptr->response_,
+            cache_key);
+      }));
+
+  return Status::Ok();
 }
 
 size_t RestClient::query_post_call_back(
@@ -470,55 +812,69 @@ size_t RestClient::query_post_call_back(
   // a previous callback.
   bytes_processed -= scratch->size();
 
-  // Copy 'contents' to the end of 'scratch'. As a future optimization, if
-  // 'scratch' is empty, we could attempt to process 'contents' in-place and
-  // only copy the remaining, unprocessed bytes into 'scratch'.
-  scratch->set_offset(scratch->size());
-  Status st = scratch->write(contents, content_nbytes);
-  if (!st.ok()) {
-    LOG_ERROR(
-        "Cannot copy libcurl response data; buffer write failed: " +
-        st.to_string());
-    return return_wrapper(bytes_processed);
+  // Without a partial serialized query left by a previous callback, the
+  // queries in 'contents' are processed in-place and only the unprocessed
+  // bytes are copied into 'scratch'. Otherwise, 'contents' is appended to
+  // 'scratch'.
+  Buffer in_place(contents, content_nbytes);
+  Buffer* src = &in_place;
+  Status st;
+  if (scratch->size() > 0) {
+    scratch->set_offset(scratch->size());
+    st = scratch->write(contents, content_nbytes);
+    if (!st.ok()) {
+      LOG_ERROR(
+          "Cannot copy libcurl response data; buffer write failed: " +
+          st.to_string());
+      return return_wrapper(bytes_processed);
+    }
+    src = scratch.get();
   }
 
-  // Process all of the serialized queries contained within 'scratch'.
-  scratch->reset_offset();
-  while (scratch->offset() < scratch->size()) {
+  // Process all of the serialized queries contained within 'src'.
+  src->reset_offset();
+  while (src->offset() < src->size()) {
     // We need at least 8 bytes to determine the size of the next
     // serialized query.
-    if (scratch->offset() + 8 > scratch->size()) {
+    if (src->offset() + 8 > src->size()) {
       break;
     }
 
     // Decode the query size. We could cache this from the previous
     // callback to prevent decoding the same prefix multiple times.
     const uint64_t query_size =
-        utils::endianness::decode_le<uint64_t>(scratch->cur_data());
+        utils::endianness::decode_le<uint64_t>(src->cur_data());
 
     // We must have the full serialized query before attempting to
     // deserialize it.
-    if (scratch->offset() + 8 + query_size > scratch->size()) {
+    if (src->offset() + 8 + query_size > src->size()) {
       break;
     }
 
     // At this point of execution, we know that we the next serialized
-    // query is entirely in 'scratch'. For convenience, we will advance
+    // query is entirely in 'src'. For convenience, we will advance
     // the offset to point to the start of the serialized query.
-    scratch->advance_offset(8);
+    src->advance_offset(8);
 
     // We can only deserialize the query if it is 8-byte aligned. If the
     // offset is 8-byte aligned, we can deserialize the query in-place.
-    // Otherwise, we must make a copy to an auxiliary buffer.
-    if (scratch->offset() % 8 != 0) {
-      // Copy the entire serialized buffer to a newly allocated, 8-byte
-      // aligned auxiliary buffer.
+    // Otherwise, we must copy its message to an auxiliary buffer, while
+    // the attribute data is copied from where it is.
+    if (!serialization::utils::is_aligned<sizeof(uint64_t)>(
+            src->cur_data())) {
+      // Copy the message of the serialized query to a newly allocated,
+      // 8-byte aligned auxiliary buffer.
+      uint64_t message_size = 0;
       Buffer aux;
-      st = aux.write(scratch->cur_data(), query_size);
+      st = serialization::query_message_size(
+          src->cur_data(), query_size, serialization_type_, &message_size);
+      if (st.ok())
+        st = aux.write(src->cur_data(), message_size);
       if (!st.ok()) {
-        scratch->set_offset(scratch->offset() - 8);
+        src->set_offset(src->offset() - 8);
         return return_wrapper(bytes_processed);
       }
+      stats_->add_counter("rest_unaligned_message_size", message_size);
 
       // Deserialize the buffer and store it in 'copy_state'. If
       // the user buffers are too small to accomodate the attribute
@@ -526,9 +882,15 @@ size_t RestClient::query_post_call_back(
       // error status.
       aux.reset_offset();
       st = serialization::query_deserialize(
-          aux, serialization_type_, true, copy_state, query, compute_tp_);
+          aux,
+          serialization_type_,
+          true,
+          copy_state,
+          query,
+          compute_tp_,
+          static_cast<const char*>(src->cur_data()) + message_size);
       if (!st.ok()) {
-        scratch->set_offset(scratch->offset() - 8);
+        src->set_offset(src->offset() - 8);
         return return_wrapper(bytes_processed);
       }
     } else {
@@ -537,23 +899,48 @@ size_t RestClient::query_post_call_back(
       // data when deserializing read queries, this will return an
       // error status.
       st = serialization::query_deserialize(
-          *scratch, serialization_type_, true, copy_state, query, compute_tp_);
+          *src, serialization_type_, true, copy_state, query, compute_tp_);
       if (!st.ok()) {
-        scratch->set_offset(scratch->offset() - 8);
+        src->set_offset(src->offset() - 8);
         return return_wrapper(bytes_processed);
       }
     }
 
-    scratch->advance_offset(query_size);
+    src->advance_offset(query_size);
     bytes_processed += (query_size + 8);
+
+    // The results copied so far are final, surface them to the user
+    // while the rest of the response is still arriving.
+    const auto& partial_results_callback = query->partial_results_callback();
+    if (partial_results_callback != nullptr) {
+      for (const auto& it : *copy_state)
+        partial_results_callback(
+            it.first,
+            it.second.offset_size,
+            it.second.data_size,
+            it.second.validity_size);
+      stats_->add_counter("rest_partial_results_num", 1);
+    }
   }
 
-  // If there are unprocessed bytes left in the scratch space, copy them
-  // to the beginning of 'scratch'. The intent is to reduce memory
-  // consumption by overwriting the serialized query objects that we
-  // have already processed.
-  const uint64_t length = scratch->size() - scratch->offset();
-  if (scratch->offset() != 0 && length != 0) {
+  // If there are unprocessed bytes left, move them to the beginning of
+  // 'scratch'. The intent is to reduce memory consumption by overwriting
+  // the serialized query objects that we have already processed.
+  const uint64_t length = src->size() - src->offset();
+  if (src == &in_place) {
+    if (length != 0) {
+      scratch->reset_size();
+      scratch->reset_offset();
+      st = scratch->write(in_place.cur_data(), length);
+      if (!st.ok()) {
+        LOG_ERROR(
+            "Cannot copy libcurl response data; buffer write failed: " +
+            st.to_string());
+        return return_wrapper(bytes_processed);
+      }
+      stats_->add_counter("rest_response_copied_size", length);
+    }
+  } else if (scratch->offset() != 0 && length != 0) {
     const uint64_t offset = scratch->offset();
     scratch->reset_offset();
 
@@ -602,8 +989,12 @@ Status RestClient::finalize_query_to_rest(const URI& uri, Query* query) {
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   const std::string url =
       redirect_uri(cache_key) + "/v1/arrays/" + array_ns + "/" +
       curlc.url_escape(array_uri) +
@@ -729,6 +1120,63 @@ Status RestClient::update_attribute_buffer_sizes(
   return Status::Ok();
 }
 
+Status RestClient::compress_request(
+    BufferList* const serialized,
+    BufferList* const compressed,
+    std::string* const content_encoding) const {
+  content_encoding->clear();
+  const uint64_t total_size = serialized->total_size();
+  if (request_compressor_ != "zstd" ||
+      total_size < request_compression_min_size_ || total_size == 0)
+    return Status::Ok();
+
+  auto timer_se = stats_->start_timer("rest_request_compress");
+
+  // Split the serialized buffers in chunks, compressed as independent
+  // frames. Concatenated zstd frames decompress to the concatenation of
+  // their contents, so the server decodes the request as one stream.
+  std::vector<ConstBuffer> chunks;
+  for (uint64_t i = 0; i < serialized->num_buffers(); ++i) {
+    Buffer* buffer = nullptr;
+    RETURN_NOT_OK(serialized->get_buffer(i, &buffer));
+    const auto data = static_cast<const char*>(buffer->data());
+    for (uint64_t offset = 0; offset < buffer->size();
+         offset += request_compression_chunk_size) {
+      const uint64_t size = std::min(
+          request_compression_chunk_size, buffer->size() - offset);
+      chunks.emplace_back(data + offset, size);
+    }
+  }
+
+  const auto concurrency_level =
+      static_cast<unsigned>(compute_tp_->concurrency_level());
+  auto compress_ctx_pool =
+      tdb::make_shared<BlockingResourcePool<ZStd::ZSTD_Compress_Context>>(
+          HERE(), std::max(concurrency_level, 1u));
+  std::vector<Buffer> outputs(chunks.size());
+  RETURN_NOT_OK(
+      parallel_for(compute_tp_, 0, chunks.size(), [&](uint64_t i) {
+        RETURN_NOT_OK(outputs[i].realloc(
+            chunks[i].size() + ZStd::overhead(chunks[i].size())));
+        return ZStd::compress(
+            ZStd::default_level(),
+            compress_ctx_pool,
+            &chunks[i],
+            &outputs[i]);
+      }));
+
+  uint64_t compressed_size = 0;
+  for (auto& output : outputs) {
+    compressed_size += output.size();
+    RETURN_NOT_OK(compressed->add_buffer(std::move(output)));
+  }
+  stats_->add_counter("rest_request_uncompressed_size", total_size);
+  stats_->add_counter("rest_request_compressed_size", compressed_size);
+
+  *content_encoding = request_compressor_;
+  return Status::Ok();
+}
+
 Status RestClient::get_query_est_result_sizes(const URI& uri, Query* query) {
   if (query == nullptr)
     return LOG_STATUS(Status_RestError(
@@ -751,8 +1199,12 @@ Status RestClient::get_query_est_result_sizes(const URI& uri, Query* query) {
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   std::string url =
       redirect_uri(cache_key) + "/v1/arrays/" + array_ns + "/" +
       curlc.url_escape(array_uri) +
@@ -803,10 +1255,18 @@ Status RestClient::post_array_schema_evolution_to_rest(
   std::string array_ns, array_uri;
   RETURN_NOT_OK(uri.get_rest_components(&array_ns, &array_uri));
   const std::string cache_key = array_ns + ":" + array_uri;
-  RETURN_NOT_OK(
-      curlc.init(config_, extra_headers_, &redirect_meta_, &redirect_mtx_));
+  RETURN_NOT_OK(curlc.init(
+      config_,
+      extra_headers_,
+      &redirect_meta_,
+      &redirect_mtx_,
+      connection_pool_.get()));
   auto deduced_url = redirect_uri(cache_key) + "/v1/arrays/" + array_ns + "/" +
                      curlc.url_escape(array_uri) + "/evolve";
+  {
+    std::lock_guard<std::mutex> lck(array_schema_cache_mtx_);
+    array_schema_cache_.erase(cache_key);
+  }
   Buffer returned_data;
   const Status sc = curlc.post_data(
       stats_,
@@ -826,7 +1286,8 @@ RestClient::RestClient() {
   (void)serialization_type_;
 }
 
-Status RestClient::init(stats::Stats*, const Config*, ThreadPool*) {
+Status RestClient::init(
+    stats::Stats*, const Config*, ThreadPool*, ThreadPool*) {
   return LOG_STATUS(
       Status_RestError("Cannot use rest client; serialization not enabled."));
 }
@@ -871,6 +1332,12 @@ Status RestClient::get_array_metadata_from_rest(
       Status_RestError("Cannot use rest client; serialization not enabled."));
 }
 
+Status RestClient::open_array_from_rest(
+    Array*, uint64_t, uint64_t, ArraySchema**, bool*, bool*) {
+  return LOG_STATUS(
+      Status_RestError("Cannot use rest client; serialization not enabled."));
+}
+
 Status RestClient::post_array_metadata_to_rest(
     const URI&, uint64_t, uint64_t, Array*) {
   return LOG_STATUS(
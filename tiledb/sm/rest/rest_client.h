@@ -38,6 +38,7 @@
 
 #include "tiledb/common/status.h"
 #include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/serialization/query.h"
 #include "tiledb/sm/stats/stats.h"
 
@@ -48,10 +49,51 @@ namespace sm {
 
 class ArraySchema;
 class Config;
+class Curl;
+class CurlConnectionPool;
 class Query;
 
 enum class SerializationType : uint8_t;
 
+/**
+ * A speculative submission of the next partition of an incomplete read on a
+ * remote array, performed in the background while the user consumes the
+ * current results. Its buffers are reused by the following submissions of
+ * the query.
+ */
+class RestPrefetch {
+ public:
+  /** Constructor. */
+  RestPrefetch(ThreadPool* io_tp);
+
+  /** Destructor, waiting for the submission in progress. */
+  ~RestPrefetch();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(RestPrefetch);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(RestPrefetch);
+
+  /** Returns true if a submission is in progress or has not been used. */
+  bool pending() const;
+
+  /** Waits for the submission in progress and returns its status. */
+  Status wait();
+
+ private:
+  /** The thread pool the submission runs on. */
+  ThreadPool* io_tp_;
+
+  /** The task of the submission in progress. */
+  std::vector<ThreadPool::Task> tasks_;
+
+  /** The serialized query submitted. */
+  Buffer request_;
+
+  /** The response of the server. */
+  Buffer response_;
+
+  friend class RestClient;
+};
+
 class RestClient {
  public:
   /** Constructor. */
@@ -59,7 +101,10 @@ class RestClient {
 
   /** Initialize the REST client with the given config. */
   Status init(
-      stats::Stats* parent_stats, const Config* config, ThreadPool* compute_tp);
+      stats::Stats* parent_stats,
+      const Config* config,
+      ThreadPool* compute_tp,
+      ThreadPool* io_tp);
 
   /** Sets a header that will be attached to all requests. */
   Status set_header(const std::string& name, const std::string& value);
@@ -73,6 +118,29 @@ class RestClient {
    */
   Status get_array_schema_from_rest(const URI& uri, ArraySchema** array_schema);
 
+  /**
+   * Gets the state of an array opened for reads from the REST server. This
+   * is the array schema and, if `rest.pipeline_array_open` is set, the
+   * non-empty domain and metadata, which are requested concurrently with
+   * the schema.
+   *
+   * @param array Array being opened
+   * @param timestamp_start Inclusive starting timestamp at which to open array
+   * @param timestamp_end Inclusive ending timestamp at which to open array
+   * @param array_schema Set to the array schema
+   * @param non_empty_domain_loaded Set to true if the non-empty domain of
+   *     the array was set
+   * @param metadata_loaded Set to true if the metadata of the array was set
+   * @return Status Ok() on success Error() on failures
+   */
+  Status open_array_from_rest(
+      Array* array,
+      uint64_t timestamp_start,
+      uint64_t timestamp_end,
+      ArraySchema** array_schema,
+      bool* non_empty_domain_loaded,
+      bool* metadata_loaded);
+
   /**
    * Post a data array schema to rest server
    *
@@ -198,6 +266,9 @@ class RestClient {
   /** The thread pool for compute-bound tasks. */
   ThreadPool* compute_tp_;
 
+  /** The thread pool for io-bound tasks. */
+  ThreadPool* io_tp_;
+
   /** Rest server config param. */
   std::string rest_server_;
 
@@ -215,6 +286,24 @@ class RestClient {
    */
   bool resubmit_incomplete_;
 
+  /** The content encoding of the requests posted to the server. */
+  std::string request_compressor_;
+
+  /** The minimum size of the requests compressed for the server. */
+  uint64_t request_compression_min_size_;
+
+  /**
+   * If true, incomplete reads prefetch their next partition when
+   * `resubmit_incomplete_` is false.
+   */
+  bool prefetch_incomplete_;
+
+  /**
+   * If true, remote array opens fetch the non-empty domain and metadata
+   * concurrently with the array schema.
+   */
+  bool pipeline_array_open_;
+
   /** Collection of extra headers that are attached to REST requests. */
   std::unordered_map<std::string, std::string> extra_headers_;
 
@@ -224,6 +313,33 @@ class RestClient {
   /** Mutex for thread-safety. */
   mutable std::mutex redirect_mtx_;
 
+  /** An array schema received from the server, with its validators. */
+  struct CachedArraySchema {
+    /** The `ETag` the server returned with the schema, if any. */
+    std::string etag_;
+
+    /** The SHA-256 digest of the serialized schema. */
+    std::string digest_;
+
+    /** A copy of the deserialized schema. */
+    tdb_shared_ptr<ArraySchema> array_schema_;
+  };
+
+  /**
+   * The latest array schemas received from the server, per array. They
+   * are revalidated on every open and only copied if unchanged.
+   */
+  std::unordered_map<std::string, CachedArraySchema> array_schema_cache_;
+
+  /** Mutex protecting `array_schema_cache_`. */
+  std::mutex array_schema_cache_mtx_;
+
+  /**
+   * The connections, TLS sessions and DNS entries shared by the requests
+   * of this client, or null if `rest.share_connections` is false.
+   */
+  tdb_shared_ptr<CurlConnectionPool> connection_pool_;
+
   /* ********************************* */
   /*         PRIVATE METHODS           */
   /* ********************************* */
@@ -305,6 +421,96 @@ class RestClient {
   Status update_attribute_buffer_sizes(
       const serialization::CopyState& copy_state, Query* query) const;
 
+  /**
+   * Fetches the serialized non-empty domain of an array.
+   *
+   * @param uri Array URI
+   * @param timestamp_start Inclusive starting timestamp at which to open array
+   * @param timestamp_end Inclusive ending timestamp at which to open array
+   * @param returned_data Set to the serialized non-empty domain
+   * @return Status
+   */
+  Status get_array_non_empty_domain_data(
+      const URI& uri,
+      uint64_t timestamp_start,
+      uint64_t timestamp_end,
+      Buffer* returned_data);
+
+  /**
+   * Fetches the serialized metadata of an array.
+   *
+   * @param uri Array URI
+   * @param timestamp_start Inclusive starting timestamp at which to open array
+   * @param timestamp_end Inclusive ending timestamp at which to open array
+   * @param returned_data Set to the serialized metadata
+   * @return Status
+   */
+  Status get_array_metadata_data(
+      const URI& uri,
+      uint64_t timestamp_start,
+      uint64_t timestamp_end,
+      Buffer* returned_data);
+
+  /**
+   * Forms the URL of the query submissions to the server.
+   *
+   * @param uri Array URI
+   * @param query Query to submit
+   * @param curlc Curl instance, initialized
+   * @param url Receives the URL
+   * @param cache_key Receives the key of the server redirections
+   * @return Status
+   */
+  Status query_submit_url(
+      const URI& uri,
+      const Query* query,
+      const Curl& curlc,
+      std::string* url,
+      std::string* cache_key);
+
+  /**
+   * Deserializes the response of the prefetched submission of the query, if
+   * it submitted the same serialized query.
+   *
+   * @param query Query to submit
+   * @param serialized The serialized query
+   * @param copy_state Map of copy state per attribute
+   * @param used Set to true if the prefetched response was used
+   * @return Status
+   */
+  Status use_prefetched_response(
+      Query* query,
+      BufferList* serialized,
+      serialization::CopyState* copy_state,
+      bool* used);
+
+  /**
+   * Submits the next partition of an incomplete read in the background, if
+   * `rest.prefetch_incomplete` is set.
+   *
+   * @param uri Array URI
+   * @param query Query to prefetch the next partition of
+   * @return Status
+   */
+  Status prefetch_submission(const URI& uri, Query* query);
+
+  /**
+   * Compresses a serialized request with `rest.request_compressor`, if it is
+   * set and the request is at least `rest.request_compression_min_size`
+   * bytes. The request is split in chunks compressed in parallel as
+   * independent zstd frames.
+   *
+   * @param serialized The serialized request.
+   * @param compressed Receives the compressed request.
+   * @param content_encoding Receives the content encoding of the compressed
+   *     request, or an empty string if the request is not compressed.
+   * @return Status
+   */
+  Status compress_request(
+      BufferList* serialized,
+      BufferList* compressed,
+      std::string* content_encoding) const;
+
   /**
    * Helper function encapsulating the functionality of looking up for cached
    * redirected rest server addresses to avoid the redirection overhead
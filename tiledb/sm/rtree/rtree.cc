@@ -38,8 +38,10 @@
 #include "tiledb/sm/misc/math.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <list>
 
@@ -101,8 +103,10 @@ Status RTree::build_tree() {
 
   auto leaf_num = levels_[0].size();
   assert(leaf_num >= 1);
-  if (leaf_num == 1)
+  if (leaf_num == 1) {
+    pack_levels();
     return Status::Ok();
+  }
 
   // Build the tree bottom up
   auto height = (size_t)std::ceil(utils::math::log(fanout_, leaf_num)) + 1;
@@ -113,6 +117,7 @@ Status RTree::build_tree() {
 
   // Make the root as the first level
   std::reverse(std::begin(levels_), std::end(levels_));
+  pack_levels();
 
   return Status::Ok();
 }
@@ -120,6 +125,7 @@ Status RTree::build_tree() {
 uint64_t RTree::free_memory() {
   auto ret = deserialized_buffer_size_;
   levels_.clear();
+  packed_levels_.clear();
   deserialized_buffer_size_ = 0;
   return ret;
 }
@@ -143,6 +149,9 @@ TileOverlap RTree::get_tile_overlap(const NDRange& range) const {
   if (domain_ == nullptr || levels_.empty())
     return overlap;
 
+  if (!packed_levels_.empty())
+    return get_tile_overlap_packed(range);
+
   // This will keep track of the traversal
   std::list<Entry> traversal;
   traversal.push_front({0, 0});
@@ -188,12 +197,37 @@ TileOverlap RTree::get_tile_overlap(const NDRange& range) const {
   return overlap;
 }
 
+void RTree::get_tile_overlap(
+    const std::vector<NDRange>& ranges,
+    uint64_t leaf_start,
+    uint64_t leaf_end,
+    std::vector<TileOverlap>* overlaps) const {
+  overlaps->clear();
+  overlaps->resize(ranges.size());
+
+  // Empty tree or leaf interval
+  if (domain_ == nullptr || levels_.empty() || ranges.empty())
+    return;
+  leaf_end = std::min<uint64_t>(leaf_end, levels_.back().size() - 1);
+  if (leaf_start > leaf_end)
+    return;
+
+  // All ranges are checked against the root
+  std::vector<uint64_t> active(ranges.size());
+  for (uint64_t r = 0; r < ranges.size(); ++r)
+    active[r] = r;
+  get_tile_overlap(ranges, 0, 0, active, leaf_start, leaf_end, overlaps);
+}
+
 void RTree::compute_tile_bitmap(
     const Range& range, unsigned d, std::vector<uint8_t>* tile_bitmap) const {
   // Empty tree
   if (domain_ == nullptr || levels_.empty())
     return;
 
+  if (!packed_levels_.empty())
+    return compute_tile_bitmap_packed(range, d, tile_bitmap);
+
   // This will keep track of the traversal
   std::list<Entry> traversal;
   traversal.push_front({0, 0});
@@ -296,7 +330,7 @@ Status RTree::set_domain(const Domain* domain) {
   return Status::Ok();
 }
 
-Status RTree::set_leaf(uint64_t leaf_id, const NDRange& mbr) {
+Status RTree::set_leaf(uint64_t leaf_id, NDRange mbr) {
   if (levels_.size() != 1)
     return LOG_STATUS(Status_RTreeError(
         "Cannot set leaf; There are more than one levels in the tree"));
@@ -304,7 +338,8 @@ Status RTree::set_leaf(uint64_t leaf_id, const NDRange& mbr) {
   if (leaf_id >= levels_[0].size())
     return LOG_STATUS(Status_RTreeError("Cannot set leaf; Invalid lead index"));
 
-  levels_[0][leaf_id] = mbr;
+  levels_[0][leaf_id] = std::move(mbr);
+  packed_levels_.clear();
 
   return Status::Ok();
 }
@@ -313,6 +348,7 @@ Status RTree::set_leaves(const std::vector<NDRange>& mbrs) {
   levels_.clear();
   levels_.resize(1);
   levels_[0] = mbrs;
+  packed_levels_.clear();
   return Status::Ok();
 }
 
@@ -327,6 +363,7 @@ Status RTree::set_leaf_num(uint64_t num) {
                           "cannot be smaller than the current leaf number"));
 
   levels_[0].resize(num);
+  packed_levels_.clear();
   return Status::Ok();
 }
 
@@ -356,11 +393,313 @@ RTree::Level RTree::build_level(const Level& level) {
   return new_level;
 }
 
+void RTree::pack_levels() {
+  packed_levels_.clear();
+  packed_overlap_funcs_.clear();
+  if (domain_ == nullptr || levels_.empty())
+    return;
+
+  // Only fixed-sized numeric dimensions are packed
+  auto dim_num = domain_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain_->dimension(d);
+    if (dim->var_size() || dim->cell_val_num() != 1)
+      return;
+
+    switch (dim->type()) {
+      case Datatype::INT8:
+        packed_overlap_funcs_.emplace_back(packed_overlap<int8_t>);
+        break;
+      case Datatype::UINT8:
+        packed_overlap_funcs_.emplace_back(packed_overlap<uint8_t>);
+        break;
+      case Datatype::INT16:
+        packed_overlap_funcs_.emplace_back(packed_overlap<int16_t>);
+        break;
+      case Datatype::UINT16:
+        packed_overlap_funcs_.emplace_back(packed_overlap<uint16_t>);
+        break;
+      case Datatype::INT32:
+        packed_overlap_funcs_.emplace_back(packed_overlap<int32_t>);
+        break;
+      case Datatype::UINT32:
+        packed_overlap_funcs_.emplace_back(packed_overlap<uint32_t>);
+        break;
+      case Datatype::INT64:
+      case Datatype::DATETIME_YEAR:
+      case Datatype::DATETIME_MONTH:
+      case Datatype::DATETIME_WEEK:
+      case Datatype::DATETIME_DAY:
+      case Datatype::DATETIME_HR:
+      case Datatype::DATETIME_MIN:
+      case Datatype::DATETIME_SEC:
+      case Datatype::DATETIME_MS:
+      case Datatype::DATETIME_US:
+      case Datatype::DATETIME_NS:
+      case Datatype::DATETIME_PS:
+      case Datatype::DATETIME_FS:
+      case Datatype::DATETIME_AS:
+      case Datatype::TIME_HR:
+      case Datatype::TIME_MIN:
+      case Datatype::TIME_SEC:
+      case Datatype::TIME_MS:
+      case Datatype::TIME_US:
+      case Datatype::TIME_NS:
+      case Datatype::TIME_PS:
+      case Datatype::TIME_FS:
+      case Datatype::TIME_AS:
+        packed_overlap_funcs_.emplace_back(packed_overlap<int64_t>);
+        break;
+      case Datatype::UINT64:
+        packed_overlap_funcs_.emplace_back(packed_overlap<uint64_t>);
+        break;
+      case Datatype::FLOAT32:
+        packed_overlap_funcs_.emplace_back(packed_overlap<float>);
+        break;
+      case Datatype::FLOAT64:
+        packed_overlap_funcs_.emplace_back(packed_overlap<double>);
+        break;
+      default:
+        packed_overlap_funcs_.clear();
+        return;
+    }
+  }
+
+  packed_levels_.resize(levels_.size());
+  for (size_t l = 0; l < levels_.size(); ++l) {
+    const auto& level = levels_[l];
+    auto& packed = packed_levels_[l];
+    packed.low_.resize(dim_num);
+    packed.high_.resize(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto coord_size = domain_->dimension(d)->coord_size();
+      packed.low_[d].resize(level.size() * coord_size);
+      packed.high_[d].resize(level.size() * coord_size);
+      for (uint64_t m = 0; m < level.size(); ++m) {
+        auto r = static_cast<const uint8_t*>(level[m][d].data());
+        std::memcpy(&packed.low_[d][m * coord_size], r, coord_size);
+        std::memcpy(
+            &packed.high_[d][m * coord_size], r + coord_size, coord_size);
+      }
+    }
+  }
+}
+
+void RTree::get_tile_overlap(
+    const std::vector<NDRange>& ranges,
+    uint64_t level,
+    uint64_t mbr_idx,
+    const std::vector<uint64_t>& active,
+    uint64_t leaf_start,
+    uint64_t leaf_end,
+    std::vector<TileOverlap>* overlaps) const {
+  auto leaf_num = levels_.back().size();
+  auto subtree_leaf_num = this->subtree_leaf_num(level);
+  assert(subtree_leaf_num > 0);
+  auto is_leaf = (level == levels_.size() - 1);
+  auto mbr_end = std::min<uint64_t>(mbr_idx + fanout_, levels_[level].size());
+
+  // The MBRs are visited in order and the children of an MBR before its
+  // next sibling, so the results of every range remain sorted
+  std::vector<uint64_t> child_active;
+  for (auto m = mbr_idx; m < mbr_end; ++m) {
+    // Skip the subtrees outside the leaf interval
+    uint64_t start = m * subtree_leaf_num;
+    uint64_t end = std::min(start + subtree_leaf_num, leaf_num) - 1;
+    if (end < leaf_start || start > leaf_end)
+      continue;
+    start = std::max(start, leaf_start);
+    end = std::min(end, leaf_end);
+
+    const auto& mbr = levels_[level][m];
+    child_active.clear();
+    for (auto r : active) {
+      auto ratio = domain_->overlap_ratio(ranges[r], mbr);
+      if (ratio == 0.0)
+        continue;
+
+      if (ratio == 1.0) {  // Full overlap
+        (*overlaps)[r].tile_ranges_.emplace_back(start, end);
+      } else if (is_leaf) {  // Partial overlap on a leaf
+        (*overlaps)[r].tiles_.emplace_back(m, ratio);
+      } else {  // Partial overlap, check again against the children
+        child_active.push_back(r);
+      }
+    }
+
+    if (!child_active.empty()) {
+      get_tile_overlap(
+          ranges,
+          level + 1,
+          m * fanout_,
+          child_active,
+          leaf_start,
+          leaf_end,
+          overlaps);
+    }
+  }
+}
+
+template <class T>
+void RTree::packed_overlap(
+    const std::vector<uint8_t>& low,
+    const std::vector<uint8_t>& high,
+    uint64_t start,
+    uint64_t num,
+    const Range& range,
+    uint8_t* overlap,
+    uint8_t* covered) {
+  auto l = reinterpret_cast<const T*>(low.data()) + start;
+  auto h = reinterpret_cast<const T*>(high.data()) + start;
+  auto r = static_cast<const T*>(range.data());
+  const T r_low = r[0], r_high = r[1];
+
+  // Branch-free, so that the compiler can vectorize across the fanout
+  for (uint64_t i = 0; i < num; ++i) {
+    overlap[i] &= (uint8_t)(l[i] <= r_high) & (uint8_t)(h[i] >= r_low);
+    covered[i] &= (uint8_t)(l[i] >= r_low) & (uint8_t)(h[i] <= r_high);
+  }
+}
+
+uint64_t RTree::packed_node_overlap(
+    uint64_t level,
+    uint64_t mbr_idx,
+    const Range* ranges,
+    unsigned dim_start,
+    unsigned dim_end,
+    std::vector<uint8_t>* overlap,
+    std::vector<uint8_t>* covered) const {
+  const auto& packed = packed_levels_[level];
+  auto num = std::min<uint64_t>(fanout_, levels_[level].size() - mbr_idx);
+  std::fill(overlap->begin(), overlap->begin() + num, 1);
+  std::fill(covered->begin(), covered->begin() + num, 1);
+  for (unsigned d = dim_start; d < dim_end; ++d) {
+    packed_overlap_funcs_[d](
+        packed.low_[d],
+        packed.high_[d],
+        mbr_idx,
+        num,
+        ranges[d - dim_start],
+        overlap->data(),
+        covered->data());
+  }
+
+  return num;
+}
+
+TileOverlap RTree::get_tile_overlap_packed(const NDRange& range) const {
+  TileOverlap overlap;
+
+  // The traversal visits the MBRs in the same (depth-first) order as
+  // `get_tile_overlap`, but compares all the MBRs of a node at once and
+  // only pushes those that overlap the range
+  struct PackedEntry {
+    uint64_t level_;
+    uint64_t mbr_idx_;
+    bool covered_;
+  };
+  std::vector<PackedEntry> traversal;
+  std::vector<uint8_t> node_overlap(std::max(fanout_, 1u));
+  std::vector<uint8_t> node_covered(std::max(fanout_, 1u));
+  auto leaf_num = levels_.back().size();
+  auto height = this->height();
+  auto dim_num = this->dim_num();
+
+  auto push_node = [&](uint64_t level, uint64_t mbr_idx) {
+    auto num = packed_node_overlap(
+        level,
+        mbr_idx,
+        range.data(),
+        0,
+        dim_num,
+        &node_overlap,
+        &node_covered);
+    for (uint64_t i = num; i-- > 0;) {
+      if (node_overlap[i])
+        traversal.push_back({level, mbr_idx + i, (bool)node_covered[i]});
+    }
+  };
+  push_node(0, 0);
+
+  while (!traversal.empty()) {
+    auto entry = traversal.back();
+    traversal.pop_back();
+
+    // Covered MBRs have a ratio of 1.0, the others need the exact ratio
+    double ratio = 1.0;
+    if (!entry.covered_) {
+      const auto& mbr = levels_[entry.level_][entry.mbr_idx_];
+      ratio = domain_->overlap_ratio(range, mbr);
+      if (ratio == 0.0)
+        continue;
+    }
+
+    if (ratio == 1.0) {  // Full overlap
+      auto subtree_leaf_num = this->subtree_leaf_num(entry.level_);
+      assert(subtree_leaf_num > 0);
+      uint64_t start = entry.mbr_idx_ * subtree_leaf_num;
+      uint64_t end = start + std::min(subtree_leaf_num, leaf_num - start) - 1;
+      overlap.tile_ranges_.emplace_back(start, end);
+    } else if (entry.level_ == height - 1) {  // Partial overlap on a leaf
+      overlap.tiles_.emplace_back(entry.mbr_idx_, ratio);
+    } else {  // Partial overlap, visit the children
+      push_node(entry.level_ + 1, entry.mbr_idx_ * fanout_);
+    }
+  }
+
+  return overlap;
+}
+
+void RTree::compute_tile_bitmap_packed(
+    const Range& range, unsigned d, std::vector<uint8_t>* tile_bitmap) const {
+  std::vector<Entry> traversal;
+  std::vector<uint8_t> node_overlap(std::max(fanout_, 1u));
+  std::vector<uint8_t> node_covered(std::max(fanout_, 1u));
+  auto leaf_num = levels_.back().size();
+  auto height = this->height();
+
+  // Each entry is a node to visit
+  traversal.push_back({0, 0});
+  while (!traversal.empty()) {
+    auto entry = traversal.back();
+    traversal.pop_back();
+
+    auto num = packed_node_overlap(
+        entry.level_,
+        entry.mbr_idx_,
+        &range,
+        d,
+        d + 1,
+        &node_overlap,
+        &node_covered);
+    for (uint64_t i = 0; i < num; ++i) {
+      if (!node_overlap[i])
+        continue;
+
+      auto mbr_idx = entry.mbr_idx_ + i;
+      if (node_covered[i]) {  // Full overlap
+        auto subtree_leaf_num = this->subtree_leaf_num(entry.level_);
+        assert(subtree_leaf_num > 0);
+        uint64_t start = mbr_idx * subtree_leaf_num;
+        uint64_t end = start + std::min(subtree_leaf_num, leaf_num - start);
+        for (uint64_t t = start; t < end; t++)
+          tile_bitmap->at(t) = 1;
+      } else if (entry.level_ == height - 1) {  // Partial overlap on a leaf
+        tile_bitmap->at(mbr_idx) = 1;
+      } else {  // Partial overlap, visit the children
+        traversal.push_back({entry.level_ + 1, mbr_idx * fanout_});
+      }
+    }
+  }
+}
+
 RTree RTree::clone() const {
   RTree clone;
   clone.domain_ = domain_;
   clone.fanout_ = fanout_;
   clone.levels_ = levels_;
+  clone.packed_levels_ = packed_levels_;
+  clone.packed_overlap_funcs_ = packed_overlap_funcs_;
 
   return clone;
 }
@@ -387,7 +726,7 @@ Status RTree::deserialize_v1_v4(ConstBuffer* cbuff, const Domain* domain) {
       levels_[l][m].resize(dim_num);
       for (unsigned d = 0; d < dim_num; ++d) {
         auto r_size = 2 * domain->dimension(d)->coord_size();
-        levels_[l][m][d].set_range(cbuff->cur_data(), r_size);
+        levels_[l][m][d].set_range_inline(cbuff->cur_data(), r_size);
         cbuff->advance_offset(r_size);
       }
     }
@@ -395,6 +734,7 @@ Status RTree::deserialize_v1_v4(ConstBuffer* cbuff, const Domain* domain) {
 
   domain_ = domain;
   deserialized_buffer_size_ = cbuff->size();
+  pack_levels();
 
   return Status::Ok();
 }
@@ -422,7 +762,7 @@ Status RTree::deserialize_v5(ConstBuffer* cbuff, const Domain* domain) {
         auto dim = domain_->dimension(d);
         if (!dim->var_size()) {  // Fixed-sized
           auto r_size = 2 * domain->dimension(d)->coord_size();
-          levels_[l][m][d].set_range(cbuff->cur_data(), r_size);
+          levels_[l][m][d].set_range_inline(cbuff->cur_data(), r_size);
           cbuff->advance_offset(r_size);
         } else {  // Var-sized
           // range_size | start_size | range
@@ -438,6 +778,7 @@ Status RTree::deserialize_v5(ConstBuffer* cbuff, const Domain* domain) {
 
   domain_ = domain;
   deserialized_buffer_size_ = cbuff->size();
+  pack_levels();
 
   return Status::Ok();
 }
@@ -446,6 +787,8 @@ void RTree::swap(RTree& rtree) {
   std::swap(domain_, rtree.domain_);
   std::swap(fanout_, rtree.fanout_);
   std::swap(levels_, rtree.levels_);
+  std::swap(packed_levels_, rtree.packed_levels_);
+  std::swap(packed_overlap_funcs_, rtree.packed_overlap_funcs_);
 }
 
 }  // namespace sm
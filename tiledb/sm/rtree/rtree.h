@@ -107,6 +107,23 @@ class RTree {
    */
   TileOverlap get_tile_overlap(const NDRange& range) const;
 
+  /**
+   * Computes the tile overlap of a batch of ranges with a single traversal
+   * of the tree, considering only the leaves in [`leaf_start`, `leaf_end`].
+   * At every node, only the ranges that partially overlap its MBR are
+   * carried down to its children. `overlaps` is resized to the number of
+   * ranges and its i-th element receives the overlap of `ranges[i]`.
+   *
+   * Disjoint leaf intervals can be processed concurrently, and the
+   * per-interval results of a range concatenated in interval order give
+   * the same tiles as `get_tile_overlap`.
+   */
+  void get_tile_overlap(
+      const std::vector<NDRange>& ranges,
+      uint64_t leaf_start,
+      uint64_t leaf_end,
+      std::vector<TileOverlap>* overlaps) const;
+
   /**
    * Compute tile bitmap for the curent range.
    */
@@ -144,7 +161,7 @@ class RTree {
    * if the number of levels in the tree is different from exactly
    * 1 (the leaf level), and if `leaf_id` is out of bounds / invalid.
    */
-  Status set_leaf(uint64_t leaf_id, const NDRange& mbr);
+  Status set_leaf(uint64_t leaf_id, NDRange mbr);
 
   /**
    * Sets the input MBRs as leaves. This will destroy the existing
@@ -210,6 +227,33 @@ class RTree {
     uint64_t mbr_idx_;
   };
 
+  /**
+   * An R-Tree level in struct-of-arrays form. For every dimension, it
+   * stores the low bounds of all the MBRs of the level contiguously, and
+   * likewise the high bounds, so that the MBRs of a node can be compared
+   * against a range in a single pass over their fanout.
+   */
+  struct PackedLevel {
+    /** The low bounds per dimension, as contiguous arrays of values. */
+    std::vector<std::vector<uint8_t>> low_;
+    /** The high bounds per dimension, as contiguous arrays of values. */
+    std::vector<std::vector<uint8_t>> high_;
+  };
+
+  /**
+   * Compares `num` packed MBR bounds of a dimension, starting at `start`,
+   * against a range. It clears the `overlap` flag of the MBRs that do not
+   * overlap the range and the `covered` flag of those not covered by it.
+   */
+  typedef void (*PackedOverlapFunc)(
+      const std::vector<uint8_t>& low,
+      const std::vector<uint8_t>& high,
+      uint64_t start,
+      uint64_t num,
+      const Range& range,
+      uint8_t* overlap,
+      uint8_t* covered);
+
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
@@ -226,6 +270,15 @@ class RTree {
    */
   std::vector<Level> levels_;
 
+  /**
+   * The tree levels in struct-of-arrays form, mirroring `levels_`. Built
+   * only if all dimensions are fixed-sized numeric, empty otherwise.
+   */
+  std::vector<PackedLevel> packed_levels_;
+
+  /** The packed MBR comparison function of each dimension. */
+  std::vector<PackedOverlapFunc> packed_overlap_funcs_;
+
   /**
    * Stores the size of the buffer used to deserialize the data, used for
    * memory tracking pusposes on reads.
@@ -239,6 +292,62 @@ class RTree {
   /** Builds a single tree level on top of the input level. */
   Level build_level(const Level& level);
 
+  /**
+   * Builds `packed_levels_` from `levels_`, if all the dimensions are
+   * fixed-sized numeric.
+   */
+  void pack_levels();
+
+  /**
+   * Visits the node starting at `mbr_idx` on level `level` for the batched
+   * tile overlap computation, checking its MBRs against the ranges whose
+   * indices are in `active`. Only the leaves in [`leaf_start`, `leaf_end`]
+   * are considered.
+   */
+  void get_tile_overlap(
+      const std::vector<NDRange>& ranges,
+      uint64_t level,
+      uint64_t mbr_idx,
+      const std::vector<uint64_t>& active,
+      uint64_t leaf_start,
+      uint64_t leaf_end,
+      std::vector<TileOverlap>* overlaps) const;
+
+  /** Implements `PackedOverlapFunc` for a dimension of type `T`. */
+  template <class T>
+  static void packed_overlap(
+      const std::vector<uint8_t>& low,
+      const std::vector<uint8_t>& high,
+      uint64_t start,
+      uint64_t num,
+      const Range& range,
+      uint8_t* overlap,
+      uint8_t* covered);
+
+  /**
+   * Computes the `overlap` and `covered` flags of the MBRs of the node
+   * starting at `mbr_idx` on level `level` against the input ranges of
+   * the dimensions in [`dim_start`, `dim_end`), using the packed levels.
+   * `ranges[0]` is the range of dimension `dim_start`.
+   *
+   * @return The number of MBRs in the node.
+   */
+  uint64_t packed_node_overlap(
+      uint64_t level,
+      uint64_t mbr_idx,
+      const Range* ranges,
+      unsigned dim_start,
+      unsigned dim_end,
+      std::vector<uint8_t>* overlap,
+      std::vector<uint8_t>* covered) const;
+
+  /** Implements `get_tile_overlap` on the packed levels. */
+  TileOverlap get_tile_overlap_packed(const NDRange& range) const;
+
+  /** Implements `compute_tile_bitmap` on the packed levels. */
+  void compute_tile_bitmap_packed(
+      const Range& range, unsigned d, std::vector<uint8_t>* tile_bitmap) const;
+
   /** Returns a deep copy of this RTree. */
   RTree clone() const;
 
@@ -83,7 +83,7 @@ Status array_metadata_to_capnp(
     entry_builder.setType(datatype_str(datatype));
     entry_builder.setValueNum(entry.num_);
     entry_builder.setValue(kj::arrayPtr(
-        static_cast<const uint8_t*>(entry.value_.data()), entry.value_.size()));
+        static_cast<const uint8_t*>(entry.data()), entry.size()));
     entry_builder.setDel(entry.del_ == 1);
   }
 
@@ -123,7 +123,8 @@ Status array_metadata_from_capnp(
 Status array_to_capnp(
     Array* array,
     capnp::Array::Builder* array_builder,
-    const bool client_side) {
+    const bool client_side,
+    const bool include_state) {
   // The serialized URI is set if it exists
   // this is used for backwards compatibility with pre TileDB 2.5 clients that
   // want to serialized a query object TileDB >= 2.5 no longer needs to send the
@@ -134,6 +135,10 @@ Status array_to_capnp(
   array_builder->setStartTimestamp(array->timestamp_start());
   array_builder->setEndTimestamp(array->timestamp_end());
 
+  // The receiver keeps the state of the array it opened itself
+  if (!include_state)
+    return Status::Ok();
+
   ArraySchema* array_schema_latest = array->array_schema_latest();
   auto array_schema_latest_builder = array_builder->initArraySchemaLatest();
   RETURN_NOT_OK(array_schema_to_capnp(
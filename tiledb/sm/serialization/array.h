@@ -59,10 +59,15 @@ namespace serialization {
  * @param array to serialize
  * @param array_builder cap'n proto class
  * @param cleint_side is serialization client or server side
+ * @param include_state If false, only the URI and timestamps of the array
+ *     are serialized, without its schemas, non-empty domain and metadata.
  * @return Status
  */
 Status array_to_capnp(
-    Array* array, capnp::Array::Builder* array_builder, const bool client_side);
+    Array* array,
+    capnp::Array::Builder* array_builder,
+    const bool client_side,
+    const bool include_state = true);
 
 /**
  * DeSerialize an Array from Cap'n proto
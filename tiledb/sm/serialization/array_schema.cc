@@ -48,10 +48,12 @@
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/enums/serialization_type.h"
+#include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/filter/filter_create.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/serialization/array_schema.h"
 
+#include <cstring>
 #include <set>
 
 using namespace tiledb::common;
@@ -96,6 +98,14 @@ Status filter_pipeline_to_capnp(
         data.setUint32(window);
         break;
       }
+      case FilterType::FILTER_AUTO_COMPRESSION: {
+        uint32_t speed_bias;
+        RETURN_NOT_OK(filter->get_option(
+            FilterOption::AUTO_COMPRESSION_SPEED_BIAS, &speed_bias));
+        auto data = filter_builder.initData();
+        data.setUint32(speed_bias);
+        break;
+      }
       case FilterType::FILTER_GZIP:
       case FilterType::FILTER_ZSTD:
       case FilterType::FILTER_LZ4:
@@ -106,7 +116,19 @@ Status filter_pipeline_to_capnp(
         RETURN_NOT_OK(
             filter->get_option(FilterOption::COMPRESSION_LEVEL, &level));
         auto data = filter_builder.initData();
-        data.setInt32(level);
+        const auto& dictionary =
+            static_cast<const CompressionFilter*>(filter)->zstd_dictionary();
+        if (dictionary.empty()) {
+          data.setInt32(level);
+        } else {
+          // The level is followed by the ZStd dictionary.
+          auto bytes = data.initBytes(sizeof(int32_t) + dictionary.size());
+          std::memcpy(bytes.begin(), &level, sizeof(int32_t));
+          std::memcpy(
+              bytes.begin() + sizeof(int32_t),
+              dictionary.data(),
+              dictionary.size());
+        }
         break;
       }
       default:
@@ -148,6 +170,13 @@ Status filter_pipeline_from_capnp(
             FilterOption::POSITIVE_DELTA_MAX_WINDOW, &window));
         break;
       }
+      case FilterType::FILTER_AUTO_COMPRESSION: {
+        auto data = filter_reader.getData();
+        uint32_t speed_bias = data.getUint32();
+        RETURN_NOT_OK(filter->set_option(
+            FilterOption::AUTO_COMPRESSION_SPEED_BIAS, &speed_bias));
+        break;
+      }
       case FilterType::FILTER_GZIP:
       case FilterType::FILTER_ZSTD:
       case FilterType::FILTER_LZ4:
@@ -155,7 +184,23 @@ Status filter_pipeline_from_capnp(
       case FilterType::FILTER_BZIP2:
       case FilterType::FILTER_DOUBLE_DELTA: {
         auto data = filter_reader.getData();
-        int32_t level = data.getInt32();
+        int32_t level;
+        if (data.isBytes()) {
+          // The level is followed by the ZStd dictionary.
+          auto bytes = data.getBytes();
+          if (type != FilterType::FILTER_ZSTD ||
+              bytes.size() < sizeof(int32_t))
+            return LOG_STATUS(Status_SerializationError(
+                "Error deserializing filter pipeline; invalid compression "
+                "filter data."));
+          std::memcpy(&level, bytes.begin(), sizeof(int32_t));
+          RETURN_NOT_OK(static_cast<CompressionFilter*>(filter.get())
+                            ->set_zstd_dictionary(std::vector<uint8_t>(
+                                bytes.begin() + sizeof(int32_t),
+                                bytes.end())));
+        } else {
+          level = data.getInt32();
+        }
         RETURN_NOT_OK(
             filter->set_option(FilterOption::COMPRESSION_LEVEL, &level));
         break;
@@ -439,6 +484,13 @@ Status array_schema_to_capnp(
     return LOG_STATUS(Status_SerializationError(
         "Error serializing array schema; array schema is null."));
 
+  // The capnp schema does not carry attribute groups, so remote arrays
+  // would see a schema that does not match the fragments on disk.
+  if (!array_schema->attribute_groups().empty())
+    return LOG_STATUS(Status_SerializationError(
+        "Error serializing array schema; attribute groups are not supported "
+        "on remote arrays."));
+
   // Only set the URI if client side
   if (client_side)
     array_schema_builder->setUri(array_schema->array_uri().to_string());
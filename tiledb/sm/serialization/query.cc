@@ -54,6 +54,7 @@
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/enums/serialization_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/endian.h"
 #include "tiledb/sm/misc/hash.h"
 #include "tiledb/sm/misc/parse_argument.h"
 #include "tiledb/sm/query/dense_reader.h"
@@ -1002,10 +1003,18 @@ Status query_to_capnp(
   query_builder->setLayout(layout_str(layout));
   query_builder->setStatus(query_status_str(query.status()));
 
-  // Serialize array
+  // Serialize array. Clients may leave its state to the server, which opens
+  // the array at the same timestamps.
   if (query.array() != nullptr) {
+    bool submit_array_state = true;
+    if (client_side) {
+      bool found = false;
+      RETURN_NOT_OK(query.config()->get<bool>(
+          "rest.submit_array_state", &submit_array_state, &found));
+    }
     auto builder = query_builder->initArray();
-    RETURN_NOT_OK(array_to_capnp(array, &builder, client_side));
+    RETURN_NOT_OK(
+        array_to_capnp(array, &builder, client_side, submit_array_state));
   }
 
   // Serialize attribute buffer metadata
@@ -1065,9 +1074,8 @@ Status query_to_capnp(
     bool all_dense = true;
     for (auto& frag_md : array->fragment_metadata())
       all_dense &= frag_md->dense();
-    if (query.use_refactored_sparse_unordered_with_dups_reader() &&
-        !schema->dense() && layout == Layout::UNORDERED &&
-        schema->allows_dups()) {
+    if (query.use_refactored_sparse_unordered_reader() && !schema->dense() &&
+        layout == Layout::UNORDERED) {
       auto builder = query_builder->initReaderIndex();
 
       auto&& [st, non_overlapping_ranges]{query.non_overlapping_ranges()};
@@ -1659,7 +1667,8 @@ Status query_from_capnp(
           index_reader_from_capnp(schema, reader_reader, query, reader));
     } else if (
         query_reader.hasReaderIndex() && !schema->dense() &&
-        layout == Layout::UNORDERED && schema->allows_dups()) {
+        layout == Layout::UNORDERED &&
+        query->use_refactored_sparse_unordered_reader()) {
       // Strategy needs to be cleared here to create the correct reader.
       query->clear_strategy();
       RETURN_NOT_OK(query->set_layout_unsafe(layout));
@@ -1922,7 +1931,8 @@ Status do_query_deserialize(
     const SerializationContext context,
     CopyState* const copy_state,
     Query* query,
-    ThreadPool* compute_tp) {
+    ThreadPool* compute_tp,
+    const void* attribute_data) {
   if (serialize_type == SerializationType::JSON)
     return LOG_STATUS(Status_SerializationError(
         "Cannot deserialize query; json format not supported."));
@@ -1962,9 +1972,11 @@ Status do_query_deserialize(
         capnp::Query::Reader query_reader = reader.getRoot<capnp::Query>();
 
         // Get a pointer to the start of the attribute buffer data (which
-        // was concatenated after the CapnP message on serialization).
-        auto attribute_buffer_start = reader.getEnd();
-        auto buffer_start = const_cast<::capnp::word*>(attribute_buffer_start);
+        // was concatenated after the CapnP message on serialization), unless
+        // it was given separately.
+        void* buffer_start = const_cast<void*>(attribute_data);
+        if (buffer_start == nullptr)
+          buffer_start = const_cast<::capnp::word*>(reader.getEnd());
         return query_from_capnp(
             query_reader, context, buffer_start, copy_state, query, compute_tp);
       }
@@ -1989,7 +2001,8 @@ Status query_deserialize(
     bool clientside,
     CopyState* copy_state,
     Query* query,
-    ThreadPool* compute_tp) {
+    ThreadPool* compute_tp,
+    const void* attribute_data) {
   // Create an original, serialized copy of the 'query' that we will revert
   // to if we are unable to deserialize 'serialized_buffer'.
   BufferList original_bufferlist;
@@ -2015,7 +2028,8 @@ Status query_deserialize(
       clientside ? SerializationContext::CLIENT : SerializationContext::SERVER,
       copy_state,
       query,
-      compute_tp);
+      compute_tp,
+      attribute_data);
 
   // If the deserialization failed, deserialize 'serialized_query_original'
   // into 'query' to ensure that 'query' is in the state it was before the
@@ -2033,7 +2047,8 @@ Status query_deserialize(
         SerializationContext::BACKUP,
         copy_state,
         query,
-        compute_tp);
+        compute_tp,
+        nullptr);
     if (!st2.ok()) {
       LOG_ERROR(st2.message());
       return st2;
@@ -2043,6 +2058,44 @@ Status query_deserialize(
   return st;
 }
 
+Status query_message_size(
+    const void* data,
+    uint64_t size,
+    SerializationType serialize_type,
+    uint64_t* message_size) {
+  // A JSON query carries no attribute data
+  if (serialize_type != SerializationType::CAPNP) {
+    *message_size = size;
+    return Status::Ok();
+  }
+
+  // The segment table holds the number of segments minus one and the size of
+  // each segment in words, as 32-bit integers padded to a word.
+  auto bytes = static_cast<const uint8_t*>(data);
+  if (size < sizeof(uint32_t))
+    return LOG_STATUS(Status_SerializationError(
+        "Cannot get the query message size; truncated segment table"));
+  const uint64_t segment_num =
+      uint64_t(utils::endianness::decode_le<uint32_t>(bytes)) + 1;
+  const uint64_t table_size =
+      (sizeof(uint32_t) * (segment_num + 1) + sizeof(::capnp::word) - 1) /
+      sizeof(::capnp::word) * sizeof(::capnp::word);
+  if (table_size > size)
+    return LOG_STATUS(Status_SerializationError(
+        "Cannot get the query message size; truncated segment table"));
+  uint64_t total_size = table_size;
+  for (uint64_t i = 0; i < segment_num; ++i)
+    total_size += sizeof(::capnp::word) *
+                  uint64_t(utils::endianness::decode_le<uint32_t>(
+                      bytes + sizeof(uint32_t) * (i + 1)));
+  if (total_size > size)
+    return LOG_STATUS(Status_SerializationError(
+        "Cannot get the query message size; truncated message"));
+
+  *message_size = total_size;
+  return Status::Ok();
+}
+
 Status query_est_result_size_reader_to_capnp(
     Query& query,
     capnp::EstimatedResultSize::Builder* est_result_size_builder) {
@@ -2231,7 +2284,18 @@ Status query_serialize(Query*, SerializationType, bool, BufferList*) {
 }
 
 Status query_deserialize(
-    const Buffer&, SerializationType, bool, CopyState*, Query*, ThreadPool*) {
+    const Buffer&,
+    SerializationType,
+    bool,
+    CopyState*,
+    Query*,
+    ThreadPool*,
+    const void*) {
+  return LOG_STATUS(Status_SerializationError(
+      "Cannot deserialize; serialization not enabled."));
+}
+
+Status query_message_size(const void*, uint64_t, SerializationType, uint64_t*) {
   return LOG_STATUS(Status_SerializationError(
       "Cannot deserialize; serialization not enabled."));
 }
@@ -147,6 +147,9 @@ Status query_serialize(
  *      query's buffer sizes are updated directly. If it is not null, the buffer
  *      sizes are not modified but the entries in the map are.
  * @param query Query to deserialize into
+ * @param attribute_data The attribute data of the serialized query, if it
+ *      does not follow the Cap'n Proto message in `serialized_buffer`. It
+ *      needs no alignment, as it is only copied into the query buffers.
  */
 Status query_deserialize(
     const Buffer& serialized_buffer,
@@ -154,7 +157,25 @@ Status query_deserialize(
     bool clientside,
     CopyState* copy_state,
     Query* query,
-    ThreadPool* compute_tp);
+    ThreadPool* compute_tp,
+    const void* attribute_data = nullptr);
+
+/**
+ * Computes the size of the message at the start of a serialized query,
+ * which is followed by the attribute data. For Cap'n Proto, this is read
+ * from the segment table of the message, which may be unaligned.
+ *
+ * @param data The serialized query.
+ * @param size The size of the serialized query.
+ * @param serialize_type Serialization type of serialized query
+ * @param message_size Set to the size of the message.
+ * @return Status
+ */
+Status query_message_size(
+    const void* data,
+    uint64_t size,
+    SerializationType serialize_type,
+    uint64_t* message_size);
 
 /**
  * Serialize an estimated result size map for all fields from a query object
@@ -46,7 +46,8 @@ GlobalStats all_stats;
 /* ****************************** */
 
 GlobalStats::GlobalStats()
-    : enabled_(false) {
+    : enabled_(false)
+    , next_refresh_id_(0) {
 }
 
 /* ****************************** */
@@ -89,6 +90,10 @@ void GlobalStats::set_enabled(bool enabled) {
 
 void GlobalStats::reset() {
   std::unique_lock<std::mutex> ul(mtx_);
+
+  // Consume the external counters, so that they restart from the reset.
+  for (const auto& refresh : refreshes_)
+    refresh.second();
   for (auto& register_stat : registered_stats_) {
     register_stat->reset();
   }
@@ -99,6 +104,18 @@ void GlobalStats::register_stats(const tdb_shared_ptr<Stats>& stats) {
   registered_stats_.emplace_back(stats);
 }
 
+uint64_t GlobalStats::register_refresh(std::function<void()>&& fn) {
+  std::unique_lock<std::mutex> ul(mtx_);
+  const uint64_t id = next_refresh_id_++;
+  refreshes_.emplace(id, std::move(fn));
+  return id;
+}
+
+void GlobalStats::unregister_refresh(const uint64_t id) {
+  std::unique_lock<std::mutex> ul(mtx_);
+  refreshes_.erase(id);
+}
+
 /* ****************************** */
 /*       PRIVATE FUNCTIONS        */
 /* ****************************** */
@@ -106,6 +123,9 @@ void GlobalStats::register_stats(const tdb_shared_ptr<Stats>& stats) {
 std::string GlobalStats::dump_registered_stats() const {
   std::unique_lock<std::mutex> ul(mtx_);
 
+  for (const auto& refresh : refreshes_)
+    refresh.second();
+
   std::stringstream ss;
 
   ss << "[\n";
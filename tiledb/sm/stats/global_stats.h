@@ -36,9 +36,11 @@
 #include <inttypes.h>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <list>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -99,6 +101,18 @@ class GlobalStats {
    */
   void register_stats(const tdb_shared_ptr<Stats>& stats);
 
+  /**
+   * Registers a function updating registered stats from counters kept
+   * outside of them. The function is called before the stats are dumped.
+   *
+   * @param fn The function.
+   * @return The id to unregister the function with.
+   */
+  uint64_t register_refresh(std::function<void()>&& fn);
+
+  /** Unregisters a function registered with `register_refresh`. */
+  void unregister_refresh(uint64_t id);
+
   /** Dump the current stats to the given file. */
   void dump(FILE* out) const;
 
@@ -137,6 +151,12 @@ class GlobalStats {
   /** The aggregated stats. */
   std::list<tdb_shared_ptr<stats::Stats>> registered_stats_;
 
+  /** The functions updating the registered stats, by id. */
+  std::map<uint64_t, std::function<void()>> refreshes_;
+
+  /** The id of the next function registered with `register_refresh`. */
+  uint64_t next_refresh_id_;
+
   /* ****************************** */
   /*       PRIVATE FUNCTIONS        */
   /* ****************************** */
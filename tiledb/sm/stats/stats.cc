@@ -32,10 +32,12 @@
 
 #include "tiledb/sm/stats/stats.h"
 #include "tiledb/common/stdx_string.h"
+#include "tiledb/common/tracer.h"
 #include "tiledb/sm/misc/utils.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <sstream>
 #include <vector>
 
@@ -72,6 +74,11 @@ void Stats::reset() {
 
   timers_.clear();
   counters_.clear();
+  histograms_.clear();
+  for (auto& counter : registered_counters_)
+    counter.second.reset();
+  for (auto& timer : registered_timers_)
+    timer.second.reset();
 
   for (auto& child : children_) {
     child.reset();
@@ -82,10 +89,12 @@ std::string Stats::dump(
     const uint64_t indent_size, const uint64_t num_indents) const {
   std::unordered_map<std::string, double> flattened_timers;
   std::unordered_map<std::string, uint64_t> flattened_counters;
+  std::unordered_map<std::string, Histogram> flattened_histograms;
 
   // Recursively populate the flattened stats with the stats from
   // this instance and all of its children.
-  populate_flattened_stats(&flattened_timers, &flattened_counters);
+  populate_flattened_stats(
+      &flattened_timers, &flattened_counters, &flattened_histograms);
 
   // Return an empty string if there are no stats.
   if (flattened_timers.empty() && flattened_counters.empty()) {
@@ -137,6 +146,22 @@ std::string Stats::dump(
       auto avg = timer.second / it->second;
       ss << l_indent << indent << indent << "\"" << stat + ".avg"
          << "\": " << avg;
+      const double max = flattened_timers[stat + ".max"];
+      ss << ",\n"
+         << l_indent << indent << indent << "\"" << stat + ".max"
+         << "\": " << max;
+
+      // The percentiles are bucket upper bounds, so cap them at the maximum.
+      auto hist = flattened_histograms.find(stat);
+      if (hist != flattened_histograms.end() && hist->second.count() > 0) {
+        for (const unsigned p : {50, 90, 99}) {
+          const double value = std::min(
+              max, static_cast<double>(hist->second.percentile(p)) / 1e9);
+          ss << ",\n"
+             << l_indent << indent << indent << "\"" << stat << ".p" << p
+             << "\": " << value;
+        }
+      }
       printed_first_timer = true;
     }
   }
@@ -186,51 +211,132 @@ void Stats::add_counter(const std::string& stat, uint64_t count) {
   }
 }
 
-ScopedExecutor Stats::start_timer(const std::string& stat) {
+void Stats::set_max_counter(const std::string& stat, uint64_t count) {
   if (!enabled_)
-    return ScopedExecutor();
+    return;
 
   std::string new_stat = prefix_ + stat;
   std::unique_lock<std::mutex> lck(mtx_);
-  const std::thread::id tid = std::this_thread::get_id();
-  start_times_[new_stat][tid] = std::chrono::high_resolution_clock::now();
+  auto it = counters_.find(new_stat);
+  if (it == counters_.end()) {  // Counter not found
+    counters_[new_stat] = count;
+  } else if (count > it->second) {  // Counter found
+    it->second = count;
+  }
+}
+
+void Stats::set_memory_usage(const std::string& category, uint64_t bytes) {
+  if (!enabled_)
+    return;
+
+  const std::string new_stat = prefix_ + "memory." + category;
+  std::unique_lock<std::mutex> lck(mtx_);
+  counters_[new_stat + ".current"] = bytes;
+  auto& peak = counters_[new_stat + ".peak"];
+  peak = std::max(peak, bytes);
+}
+
+ScopedExecutor Stats::start_timer(const std::string& stat) {
+  if (!enabled_)
+    return ScopedExecutor();
 
-  std::function<void()> end_timer_fn = std::bind(&Stats::end_timer, this, stat);
+  // The start time is kept by the returned executor, so only ending the
+  // timer needs to lock.
+  std::function<void()> end_timer_fn = std::bind(
+      &Stats::end_timer, this, stat, std::chrono::high_resolution_clock::now());
   return ScopedExecutor(std::move(end_timer_fn));
 }
 
-void Stats::end_timer(const std::string& stat) {
+ScopedExecutor Stats::start_timer(Timer* const timer) {
+  if (!enabled_)
+    return ScopedExecutor();
+
+  const auto start_time = std::chrono::high_resolution_clock::now();
+  return ScopedExecutor([timer, start_time]() {
+    const std::chrono::nanoseconds duration =
+        std::chrono::high_resolution_clock::now() - start_time;
+    timer->add_duration(duration);
+    if (tracer.enabled()) {
+      const uint64_t end_ns = Tracer::now_ns();
+      tracer.record(timer->name(), "stats", end_ns - duration.count(), end_ns);
+    }
+  });
+}
+
+void Stats::end_timer(
+    const std::string& stat,
+    const std::chrono::high_resolution_clock::time_point start_time) {
   if (!enabled_)
     return;
 
   std::string new_stat = prefix_ + stat;
-  std::unique_lock<std::mutex> lck(mtx_);
 
   // Calculate duration
-  const std::thread::id tid = std::this_thread::get_id();
-  auto it = start_times_.find(new_stat);
-  assert(it != start_times_.end());
-  auto tit = it->second.find(tid);
-  assert(tit != it->second.end());
-  auto start_time = tit->second;
   auto end_time = std::chrono::high_resolution_clock::now();
   const std::chrono::duration<double> duration = end_time - start_time;
 
+  if (tracer.enabled()) {
+    const uint64_t end_ns = Tracer::now_ns();
+    const uint64_t duration_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            end_time - start_time)
+            .count();
+    tracer.record(new_stat, "stats", end_ns - duration_ns, end_ns);
+  }
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  add_duration_locked(new_stat, duration.count());
+}
+
+void Stats::Counter::add(const uint64_t count) {
+  if (!owner_->enabled_)
+    return;
+
+  shards_[shard_index()].value_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void Stats::Timer::add_duration(const std::chrono::nanoseconds duration) {
+  if (!owner_->enabled_)
+    return;
+
+  const uint64_t ns = static_cast<uint64_t>(duration.count());
+  auto& shard = shards_[shard_index()];
+  shard.value_.fetch_add(ns, std::memory_order_relaxed);
+  shard.count_.fetch_add(1, std::memory_order_relaxed);
+  histogram_.record(ns);
+
+  // Contended only while the maximum grows
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (ns > max &&
+         !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+void Stats::add_duration(const std::string& stat, double seconds) {
+  if (!enabled_)
+    return;
+
+  std::string new_stat = prefix_ + stat;
+  std::unique_lock<std::mutex> lck(mtx_);
+  add_duration_locked(new_stat, seconds);
+}
+
+void Stats::add_duration_locked(const std::string& new_stat, double seconds) {
   // Add duration to timer total
   auto it2 = timers_.find(new_stat + ".sum");
   if (it2 == timers_.end()) {  // Timer not found
-    timers_[new_stat + ".sum"] = duration.count();
+    timers_[new_stat + ".sum"] = seconds;
   } else {  // Timer found
-    it2->second += duration.count();
+    it2->second += seconds;
   }
 
   // Add duration to timer max
   auto it3 = timers_.find(new_stat + ".max");
   if (it3 == timers_.end()) {  // Timer not found
-    timers_[new_stat + ".max"] = duration.count();
+    timers_[new_stat + ".max"] = seconds;
   } else {  // Timer found
-    if (duration.count() > it3->second)
-      it3->second = duration.count();
+    if (seconds > it3->second)
+      it3->second = seconds;
   }
 
   // Increment the timer counter
@@ -240,6 +346,8 @@ void Stats::end_timer(const std::string& stat) {
   } else {  // Timer found
     it4->second += 1;
   }
+
+  histograms_[new_stat].record(static_cast<uint64_t>(seconds * 1e9));
 }
 
 #else
@@ -248,17 +356,247 @@ void Stats::add_counter(const std::string& stat, uint64_t count) {
   (void)stat;
   (void)count;
 }
+
+void Stats::set_max_counter(const std::string& stat, uint64_t count) {
+  (void)stat;
+  (void)count;
+}
+
+void Stats::set_memory_usage(const std::string& category, uint64_t bytes) {
+  (void)category;
+  (void)bytes;
+}
+
 ScopedExecutor Stats::start_timer(const std::string& stat) {
   (void)stat;
   return ScopedExecutor();
 }
 
-void Stats::end_timer(const std::string& stat) {
+ScopedExecutor Stats::start_timer(Timer* const timer) {
+  (void)timer;
+  return ScopedExecutor();
+}
+
+void Stats::end_timer(
+    const std::string& stat,
+    const std::chrono::high_resolution_clock::time_point start_time) {
   (void)stat;
+  (void)start_time;
+}
+
+void Stats::Counter::add(const uint64_t count) {
+  (void)count;
+}
+
+void Stats::Timer::add_duration(const std::chrono::nanoseconds duration) {
+  (void)duration;
+}
+
+void Stats::add_duration(const std::string& stat, double seconds) {
+  (void)stat;
+  (void)seconds;
 }
 
 #endif
 
+void Stats::memory_usage(
+    const std::string& category, uint64_t* current, uint64_t* peak) const {
+  std::unordered_map<std::string, double> flattened_timers;
+  std::unordered_map<std::string, uint64_t> flattened_counters;
+  populate_flattened_stats(&flattened_timers, &flattened_counters);
+
+  *current = 0;
+  *peak = 0;
+  const std::string current_suffix = ".memory." + category + ".current";
+  const std::string peak_suffix = ".memory." + category + ".peak";
+  for (const auto& counter : flattened_counters) {
+    if (utils::parse::ends_with(counter.first, current_suffix))
+      *current += counter.second;
+    else if (utils::parse::ends_with(counter.first, peak_suffix))
+      *peak += counter.second;
+  }
+}
+
+size_t Stats::shard_index() {
+  // Threads are assigned shards round-robin on first use
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) % shard_num_;
+  return shard;
+}
+
+Stats::Histogram::Histogram() {
+  reset();
+}
+
+unsigned Stats::Histogram::bucket_index(uint64_t ns) {
+  // The first sub-buckets hold the small durations exactly
+  if (ns < sub_bucket_num_)
+    return static_cast<unsigned>(ns);
+
+  unsigned msb = 0;
+  while (msb < 63 && (ns >> (msb + 1)) != 0)
+    ++msb;
+  const unsigned shift = msb - sub_bucket_bits_;
+  const unsigned sub_bucket =
+      static_cast<unsigned>(ns >> shift) & (sub_bucket_num_ - 1);
+  return (shift + 1) * sub_bucket_num_ + sub_bucket;
+}
+
+uint64_t Stats::Histogram::bucket_upper_bound(const unsigned index) {
+  if (index < sub_bucket_num_)
+    return index;
+
+  const unsigned shift = index / sub_bucket_num_ - 1;
+  const uint64_t sub_bucket = index % sub_bucket_num_;
+  const uint64_t lower = (sub_bucket_num_ + sub_bucket) << shift;
+  return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void Stats::Histogram::record(const uint64_t ns) {
+  buckets_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Stats::Histogram::merge(const Histogram& other) {
+  for (unsigned i = 0; i < bucket_num_; ++i) {
+    const uint64_t count = other.buckets_[i].load(std::memory_order_relaxed);
+    if (count != 0)
+      buckets_[i].fetch_add(count, std::memory_order_relaxed);
+  }
+}
+
+uint64_t Stats::Histogram::count() const {
+  uint64_t count = 0;
+  for (const auto& bucket : buckets_)
+    count += bucket.load(std::memory_order_relaxed);
+  return count;
+}
+
+uint64_t Stats::Histogram::percentile(const double percentile) const {
+  const uint64_t total = count();
+  if (total == 0)
+    return 0;
+
+  // The rank of the percentile, between 1 and `total`
+  auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+  rank = std::min(std::max(rank, uint64_t(1)), total);
+
+  uint64_t seen = 0;
+  for (unsigned i = 0; i < bucket_num_; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank)
+      return bucket_upper_bound(i);
+  }
+
+  return bucket_upper_bound(bucket_num_ - 1);
+}
+
+void Stats::Histogram::reset() {
+  for (auto& bucket : buckets_)
+    bucket.store(0, std::memory_order_relaxed);
+}
+
+Stats::Counter::Counter(const Stats* const owner)
+    : owner_(owner) {
+}
+
+uint64_t Stats::Counter::value() const {
+  uint64_t value = 0;
+  for (const auto& shard : shards_)
+    value += shard.value_.load(std::memory_order_relaxed);
+  return value;
+}
+
+void Stats::Counter::reset() {
+  for (auto& shard : shards_)
+    shard.value_.store(0, std::memory_order_relaxed);
+}
+
+Stats::Timer::Timer(const Stats* const owner, const std::string& name)
+    : owner_(owner)
+    , name_(name)
+    , max_(0) {
+}
+
+double Stats::Timer::sum() const {
+  uint64_t ns = 0;
+  for (const auto& shard : shards_)
+    ns += shard.value_.load(std::memory_order_relaxed);
+  return static_cast<double>(ns) / 1e9;
+}
+
+double Stats::Timer::max() const {
+  return static_cast<double>(max_.load(std::memory_order_relaxed)) / 1e9;
+}
+
+const std::string& Stats::Timer::name() const {
+  return name_;
+}
+
+const Stats::Histogram& Stats::Timer::histogram() const {
+  return histogram_;
+}
+
+uint64_t Stats::Timer::count() const {
+  uint64_t count = 0;
+  for (const auto& shard : shards_)
+    count += shard.count_.load(std::memory_order_relaxed);
+  return count;
+}
+
+void Stats::Timer::reset() {
+  for (auto& shard : shards_) {
+    shard.value_.store(0, std::memory_order_relaxed);
+    shard.count_.store(0, std::memory_order_relaxed);
+  }
+  max_.store(0, std::memory_order_relaxed);
+  histogram_.reset();
+}
+
+Stats::Counter* Stats::register_counter(const std::string& stat) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = registered_counters_
+                .emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(prefix_ + stat),
+                    std::forward_as_tuple(this))
+                .first;
+  return &it->second;
+}
+
+Stats::Timer* Stats::register_timer(const std::string& stat) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = registered_timers_
+                .emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(prefix_ + stat),
+                    std::forward_as_tuple(this, prefix_ + stat))
+                .first;
+  return &it->second;
+}
+
+void Stats::merge_registered_locked() {
+  for (auto& counter : registered_counters_) {
+    const uint64_t value = counter.second.value();
+    if (value == 0)
+      continue;
+    counters_[counter.first] += value;
+    counter.second.reset();
+  }
+
+  for (auto& timer : registered_timers_) {
+    const uint64_t count = timer.second.count();
+    if (count == 0)
+      continue;
+    timers_[timer.first + ".sum"] += timer.second.sum();
+    auto& max = timers_[timer.first + ".max"];
+    max = std::max(max, timer.second.max());
+    counters_[timer.first + ".timer_count"] += count;
+    histograms_[timer.first].merge(timer.second.histogram());
+    timer.second.reset();
+  }
+}
+
 Stats* Stats::parent() {
   return parent_;
 }
@@ -273,29 +611,64 @@ Stats* Stats::create_child(const std::string& prefix) {
 
 void Stats::populate_flattened_stats(
     std::unordered_map<std::string, double>* const flattened_timers,
-    std::unordered_map<std::string, uint64_t>* const flattened_counters) const {
+    std::unordered_map<std::string, uint64_t>* const flattened_counters,
+    std::unordered_map<std::string, Histogram>* const flattened_histograms)
+    const {
   // We will acquire the locks top-down in the tree and hold
   // until the recursion terminates.
   std::unique_lock<std::mutex> lck(mtx_);
 
-  // Append the stats from this instance.
-  for (const auto& timer : timers_)
-    (*flattened_timers)[timer.first] += timer.second;
+  // Append the stats from this instance. The timer maximums are
+  // aggregated as maximums, everything else as sums.
+  for (const auto& timer : timers_) {
+    auto& value = (*flattened_timers)[timer.first];
+    if (utils::parse::ends_with(timer.first, ".max"))
+      value = std::max(value, timer.second);
+    else
+      value += timer.second;
+  }
   for (const auto& counter : counters_)
     (*flattened_counters)[counter.first] += counter.second;
+  if (flattened_histograms != nullptr) {
+    for (const auto& hist : histograms_)
+      (*flattened_histograms)[hist.first].merge(hist.second);
+  }
+
+  // Append the registered stats, summing their shards.
+  for (const auto& counter : registered_counters_) {
+    const uint64_t value = counter.second.value();
+    if (value != 0)
+      (*flattened_counters)[counter.first] += value;
+  }
+  for (const auto& timer : registered_timers_) {
+    const uint64_t count = timer.second.count();
+    if (count == 0)
+      continue;
+    (*flattened_timers)[timer.first + ".sum"] += timer.second.sum();
+    auto& max = (*flattened_timers)[timer.first + ".max"];
+    max = std::max(max, timer.second.max());
+    (*flattened_counters)[timer.first + ".timer_count"] += count;
+    if (flattened_histograms != nullptr)
+      (*flattened_histograms)[timer.first].merge(timer.second.histogram());
+  }
 
   // Populate the stats from all of the children.
   for (const auto& child : children_) {
-    child.populate_flattened_stats(flattened_timers, flattened_counters);
+    child.populate_flattened_stats(
+        flattened_timers, flattened_counters, flattened_histograms);
   }
 }
 
 std::unordered_map<std::string, double>* Stats::timers() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  merge_registered_locked();
   return &timers_;
 }
 
 /** Return pointer to conters map, used for serialization only. */
 std::unordered_map<std::string, uint64_t>* Stats::counters() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  merge_registered_locked();
   return &counters_;
 }
 
@@ -36,6 +36,8 @@
 #include "tiledb/common/scoped_executor.h"
 
 #include <inttypes.h>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -55,7 +57,146 @@ namespace stats {
  * Class that defines stats counters and methods to manipulate them.
  */
 class Stats {
+ private:
+  /** The number of shards a registered stat is accumulated in. */
+  static const size_t shard_num_ = 16;
+
+  /** A shard of a registered stat, on its own cache line. */
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value_{0};
+    std::atomic<uint64_t> count_{0};
+  };
+
+  /** Returns the shard index of the calling thread. */
+  static size_t shard_index();
+
  public:
+  /**
+   * A log-linear histogram of durations in nanoseconds, in the style of
+   * HDR histograms: every power of two is split into 8 linear sub-buckets,
+   * so a percentile is reported within 12.5% of its value. Recording is a
+   * single relaxed atomic increment.
+   */
+  class Histogram {
+   public:
+    /** Constructor. */
+    Histogram();
+
+    /** Records a duration, in nanoseconds. */
+    void record(uint64_t ns);
+
+    /** Adds the counts of `other` to this histogram. */
+    void merge(const Histogram& other);
+
+    /** Returns the number of recorded durations. */
+    uint64_t count() const;
+
+    /**
+     * Returns an upper bound of the input percentile of the recorded
+     * durations, in nanoseconds, or 0 if the histogram is empty.
+     *
+     * @param percentile The percentile, in [0, 100].
+     */
+    uint64_t percentile(double percentile) const;
+
+    /** Resets the histogram. */
+    void reset();
+
+   private:
+    /** The number of linear sub-buckets per power of two, as bits. */
+    static const unsigned sub_bucket_bits_ = 3;
+
+    /** The number of sub-buckets per power of two. */
+    static const unsigned sub_bucket_num_ = 1u << sub_bucket_bits_;
+
+    /** The number of buckets, covering all 64-bit durations. */
+    static const unsigned bucket_num_ =
+        sub_bucket_num_ * (64 - sub_bucket_bits_ + 1);
+
+    /** The bucket counts. */
+    std::array<std::atomic<uint64_t>, bucket_num_> buckets_;
+
+    /** Returns the bucket of the input duration. */
+    static unsigned bucket_index(uint64_t ns);
+
+    /** Returns the largest duration that falls in the input bucket. */
+    static uint64_t bucket_upper_bound(unsigned index);
+  };
+
+  /**
+   * A counter stat registered with `register_counter`. It is updated
+   * without locking: each thread adds to one of several shards, which are
+   * summed when the stats are dumped.
+   */
+  class Counter {
+   public:
+    /** Constructor. */
+    explicit Counter(const Stats* owner);
+
+    /** Adds `count` to the counter. */
+    void add(uint64_t count);
+
+    /** Returns the sum of the shards. */
+    uint64_t value() const;
+
+    /** Resets the counter to zero. */
+    void reset();
+
+   private:
+    /** The instance the counter is registered with. */
+    const Stats* owner_;
+
+    /** The shards of the counter. */
+    std::array<Shard, shard_num_> shards_;
+  };
+
+  /**
+   * A timer stat registered with `register_timer`, updated without locking
+   * like a `Counter`. Durations are accumulated in nanoseconds.
+   */
+  class Timer {
+   public:
+    /** Constructor. */
+    Timer(const Stats* owner, const std::string& name);
+
+    /** Returns the (prefixed) name of the timer. */
+    const std::string& name() const;
+
+    /** Adds a duration to the timer. */
+    void add_duration(std::chrono::nanoseconds duration);
+
+    /** Returns the sum of the durations, in seconds. */
+    double sum() const;
+
+    /** Returns the maximum duration, in seconds. */
+    double max() const;
+
+    /** Returns the number of durations. */
+    uint64_t count() const;
+
+    /** Returns the histogram of the durations. */
+    const Histogram& histogram() const;
+
+    /** Resets the timer. */
+    void reset();
+
+   private:
+    /** The instance the timer is registered with. */
+    const Stats* owner_;
+
+    /** The (prefixed) name of the timer. */
+    const std::string name_;
+
+    /** The shards of the timer. */
+    std::array<Shard, shard_num_> shards_;
+
+    /** The maximum duration, in nanoseconds. */
+    std::atomic<uint64_t> max_;
+
+    /** The histogram of the durations. */
+    Histogram histogram_;
+  };
+
   /* ****************************** */
   /*   CONSTRUCTORS & DESTRUCTORS   */
   /* ****************************** */
@@ -77,13 +218,58 @@ class Stats {
 
   /**
    * Starts a timer for the input timer stat. The timer
-   * ends when the returned `ScopedExecutor` object is destroyed.
+   * ends when the returned `ScopedExecutor` object is destroyed. While
+   * the global tracer is enabled, the timer is also recorded as a span.
    */
   common::ScopedExecutor start_timer(const std::string& stat);
 
+  /**
+   * Starts a registered timer, which ends when the returned
+   * `ScopedExecutor` object is destroyed. Unlike the overload by name,
+   * this takes no lock.
+   */
+  common::ScopedExecutor start_timer(Timer* timer);
+
+  /**
+   * Registers the input counter stat, for the counters updated in hot
+   * loops. The returned handle is owned by this instance and remains
+   * valid for its lifetime; registering a name again returns the same
+   * handle.
+   */
+  Counter* register_counter(const std::string& stat);
+
+  /** Registers the input timer stat. See `register_counter`. */
+  Timer* register_timer(const std::string& stat);
+
+  /**
+   * Adds a duration measured by the caller to the input timer stat, for the
+   * durations that do not start and end on the same thread.
+   */
+  void add_duration(const std::string& stat, double seconds);
+
   /** Adds `count` to the input counter stat. */
   void add_counter(const std::string& stat, uint64_t count);
 
+  /** Raises the input counter stat to `count` if it is lower. */
+  void set_max_counter(const std::string& stat, uint64_t count);
+
+  /**
+   * Records the current memory usage of a category, as the counters
+   * `memory.<category>.current` and `memory.<category>.peak`.
+   */
+  void set_memory_usage(const std::string& category, uint64_t bytes);
+
+  /**
+   * Retrieves the current and peak memory usage of a category recorded with
+   * `set_memory_usage` by this instance and its children.
+   *
+   * @param category The memory category.
+   * @param current Set to the current memory usage, in bytes.
+   * @param peak Set to the peak memory usage, in bytes.
+   */
+  void memory_usage(
+      const std::string& category, uint64_t* current, uint64_t* peak) const;
+
   /** Returns true if statistics are currently enabled. */
   bool enabled() const;
 
@@ -95,7 +281,9 @@ class Stats {
 
   /**
    * Dumps the stats for this instance as a JSON dictionary of
-   * timers and stats.
+   * timers and stats. Every timer is reported with its sum, average and
+   * maximum, and with the `p50`, `p90` and `p99` percentiles of its
+   * durations.
    *
    * @param indent_size The number of spaces in an indentation.
    * @param num_indents The number of leading indentations.
@@ -108,10 +296,16 @@ class Stats {
   /** Creates a child instance, managed by this instance. */
   Stats* create_child(const std::string& prefix);
 
-  /** Return pointer to timers map, used for serialization only. */
+  /**
+   * Return pointer to timers map, used for serialization only. The
+   * registered stats are merged into the maps first.
+   */
   std::unordered_map<std::string, double>* timers();
 
-  /** Return pointer to conters map, used for serialization only. */
+  /**
+   * Return pointer to conters map, used for serialization only. The
+   * registered stats are merged into the maps first.
+   */
   std::unordered_map<std::string, uint64_t>* counters();
 
  private:
@@ -131,13 +325,14 @@ class Stats {
   /** A map of counter stats. */
   std::unordered_map<std::string, uint64_t> counters_;
 
-  typedef std::unordered_map<
-      std::thread::id,
-      std::chrono::high_resolution_clock::time_point>
-      ThreadTimer;
+  /** The duration histograms of the timer stats, by (prefixed) name. */
+  std::unordered_map<std::string, Histogram> histograms_;
+
+  /** The registered counters by (prefixed) name. */
+  std::unordered_map<std::string, Counter> registered_counters_;
 
-  /** The start time for all pending timers. */
-  std::unordered_map<std::string, ThreadTimer> start_times_;
+  /** The registered timers by (prefixed) name. */
+  std::unordered_map<std::string, Timer> registered_timers_;
 
   /** Prefix used for the various timers and counters. */
   const std::string prefix_;
@@ -155,8 +350,22 @@ class Stats {
   /*       PRIVATE FUNCTIONS        */
   /* ****************************** */
 
-  /** Ends a timer for the input timer stat. */
-  void end_timer(const std::string& stat);
+  /** Ends a timer for the input timer stat, started at `start_time`. */
+  void end_timer(
+      const std::string& stat,
+      std::chrono::high_resolution_clock::time_point start_time);
+
+  /**
+   * Adds a duration to the input (prefixed) timer stat. The `mtx_` must be
+   * locked when entering this routine.
+   */
+  void add_duration_locked(const std::string& new_stat, double seconds);
+
+  /**
+   * Moves the values of the registered stats into `timers_` and
+   * `counters_`. The `mtx_` must be locked when entering this routine.
+   */
+  void merge_registered_locked();
 
   /**
    * Populates the input stats with the instance stats. This is a
@@ -166,11 +375,13 @@ class Stats {
    *
    * @param flattened_timers Timers to append to.
    * @param flattened_counters Counters to append to.
+   * @param flattened_histograms If non-null, timer histograms to append to.
    */
   void populate_flattened_stats(
       std::unordered_map<std::string, double>* const flattened_timers,
-      std::unordered_map<std::string, uint64_t>* const flattened_counters)
-      const;
+      std::unordered_map<std::string, uint64_t>* const flattened_counters,
+      std::unordered_map<std::string, Histogram>* const flattened_histograms =
+          nullptr) const;
 };
 
 }  // namespace stats
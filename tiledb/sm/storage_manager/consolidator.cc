@@ -37,6 +37,7 @@
 #include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/fragment/single_fragment_info.h"
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
@@ -46,7 +47,9 @@
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/generic_tile_io.h"
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -103,12 +106,36 @@ Status Consolidator::consolidate_array_meta(
     uint32_t key_length) {
   auto timer_se = stats_->start_timer("consolidate_array_meta");
 
-  // Open array for reading
+  // Merge only the array metadata written after the latest consolidated
+  // file, unless there are already `array_meta_max_deltas_` of them. The
+  // consolidated files are the ones spanning more than one timestamp.
   auto array_uri = URI(array_name);
+  uint64_t timestamp_start = config_.timestamp_start_;
+  if (config_.array_meta_max_deltas_ > 0) {
+    std::vector<URI> array_metadata_uris;
+    RETURN_NOT_OK(storage_manager_->get_array_metadata_uris(
+        array_uri, &array_metadata_uris));
+    uint32_t consolidated_num = 0;
+    uint64_t consolidated_end = 0;
+    for (const auto& uri : array_metadata_uris) {
+      std::pair<uint64_t, uint64_t> timestamp_range;
+      RETURN_NOT_OK(utils::parse::get_timestamp_range(uri, &timestamp_range));
+      if (timestamp_range.first < timestamp_range.second) {
+        ++consolidated_num;
+        consolidated_end = std::max(consolidated_end, timestamp_range.second);
+      }
+    }
+    if (consolidated_num > 0 &&
+        consolidated_num < config_.array_meta_max_deltas_ &&
+        consolidated_end < UINT64_MAX)
+      timestamp_start = std::max(timestamp_start, consolidated_end + 1);
+  }
+
+  // Open array for reading
   Array array_for_reads(array_uri, storage_manager_);
   RETURN_NOT_OK(array_for_reads.open(
       QueryType::READ,
-      config_.timestamp_start_,
+      timestamp_start,
       config_.timestamp_end_,
       encryption_type,
       encryption_key,
@@ -138,10 +165,23 @@ Status Consolidator::consolidate_array_meta(
     array_for_writes.close();
     return st;
   }
+
+  // Nothing to merge since the latest consolidated file
+  if (timestamp_start != config_.timestamp_start_ &&
+      metadata_r->loaded_metadata_uris().size() < 2) {
+    RETURN_NOT_OK_ELSE(array_for_reads.close(), array_for_writes.close());
+    return array_for_writes.close();
+  }
+
   metadata_r->swap(metadata_w);
 
+  // The deletions matter only if older metadata is left unmerged
+  if (timestamp_start == 0)
+    metadata_w->clear_deleted_keys();
+
   // Metadata uris to delete
   const auto to_vacuum = metadata_w->loaded_metadata_uris();
+  stats_->add_counter("consolidate_array_meta_num", to_vacuum.size());
 
   // Generate new name for consolidated metadata
   st = metadata_w->generate_uri(array_uri);
@@ -221,19 +261,59 @@ Status Consolidator::consolidate_fragments(
   }
 
   uint32_t step = 0;
+  uint64_t rewritten_bytes = 0;
   std::vector<TimestampedURI> to_consolidate;
   do {
     // No need to consolidate if no more than 1 fragment exist
     if (fragment_info.fragment_num() <= 1)
       break;
 
+    // Independent steps of sparse fragments run concurrently
+    auto array_schema = array_for_reads.array_schema_latest();
+    if (config_.concurrent_budget_ > 0 && !array_schema->dense()) {
+      std::vector<std::vector<TimestampedURI>> groups;
+      std::vector<NDRange> unions;
+      st = plan_next_steps(
+          array_schema, fragment_info, config_.steps_ - step, &groups, &unions);
+      if (!st.ok()) {
+        array_for_reads.close();
+        array_for_writes.close();
+        return st;
+      }
+      if (groups.empty())
+        break;
+
+      std::vector<URI> new_fragment_uris(groups.size());
+      st = consolidate_concurrently(
+          array_schema,
+          array_for_reads.array_uri(),
+          encryption_type,
+          encryption_key,
+          key_length,
+          groups,
+          unions,
+          &new_fragment_uris);
+
+      // Replace the consolidated fragments in the order of the groups, so
+      // that the fragment info does not depend on which step ends first
+      for (size_t g = 0; st.ok() && g < groups.size(); ++g) {
+        rewritten_bytes += fragments_size(fragment_info, groups[g]);
+        st = fragment_info.load_and_replace(new_fragment_uris[g], groups[g]);
+      }
+      if (!st.ok()) {
+        array_for_reads.close();
+        array_for_writes.close();
+        return st;
+      }
+
+      step += (uint32_t)groups.size();
+      continue;
+    }
+
     // Find the next fragments to be consolidated
     NDRange union_non_empty_domains;
     st = compute_next_to_consolidate(
-        array_for_reads.array_schema_latest(),
-        fragment_info,
-        &to_consolidate,
-        &union_non_empty_domains);
+        array_schema, fragment_info, &to_consolidate, &union_non_empty_domains);
     if (!st.ok()) {
       array_for_reads.close();
       array_for_writes.close();
@@ -261,6 +341,7 @@ Status Consolidator::consolidate_fragments(
     // Load info of the consolidated fragment and add it
     // to the fragment info, replacing the fragments that it
     // consolidated.
+    rewritten_bytes += fragments_size(fragment_info, to_consolidate);
     st = fragment_info.load_and_replace(new_fragment_uri, to_consolidate);
     if (!st.ok()) {
       array_for_reads.close();
@@ -277,6 +358,123 @@ Status Consolidator::consolidate_fragments(
   RETURN_NOT_OK(array_for_writes.close());
 
   stats_->add_counter("consolidate_step_num", step);
+  stats_->add_counter("consolidate_rewritten_bytes", rewritten_bytes);
+
+  return Status::Ok();
+}
+
+Status Consolidator::plan_next_steps(
+    const ArraySchema* array_schema,
+    const FragmentInfo& fragment_info,
+    uint32_t max_steps,
+    std::vector<std::vector<TimestampedURI>>* groups,
+    std::vector<NDRange>* unions) const {
+  auto timer_se = stats_->start_timer("consolidate_plan_steps");
+
+  // Every selected set of fragments splits the range of fragments it was
+  // selected from in two ranges, searched for the next steps
+  const auto& fragments = fragment_info.single_fragment_info_vec();
+  std::vector<std::pair<size_t, size_t>> ranges = {{0, fragments.size()}};
+  std::vector<std::pair<size_t, size_t>> selected;
+  std::vector<TimestampedURI> to_consolidate;
+  while (!ranges.empty() && selected.size() < max_steps) {
+    auto range = ranges.back();
+    ranges.pop_back();
+    if (range.second - range.first <= 1)
+      continue;
+
+    NDRange union_non_empty_domains;
+    RETURN_NOT_OK(compute_next_to_consolidate(
+        array_schema,
+        fragment_info,
+        range.first,
+        range.second,
+        &to_consolidate,
+        &union_non_empty_domains));
+    if (to_consolidate.size() <= 1)
+      continue;
+
+    size_t first = range.first;
+    while (fragments[first].uri() != to_consolidate.front().uri_)
+      ++first;
+    const size_t last = first + to_consolidate.size();
+    selected.emplace_back(first, unions->size());
+    groups->emplace_back(std::move(to_consolidate));
+    unions->emplace_back(std::move(union_non_empty_domains));
+    to_consolidate.clear();
+    ranges.emplace_back(range.first, first);
+    ranges.emplace_back(last, range.second);
+  }
+
+  // Order the steps by the position of their fragments
+  std::sort(selected.begin(), selected.end());
+  std::vector<std::vector<TimestampedURI>> ordered_groups;
+  std::vector<NDRange> ordered_unions;
+  for (const auto& s : selected) {
+    ordered_groups.emplace_back(std::move((*groups)[s.second]));
+    ordered_unions.emplace_back(std::move((*unions)[s.second]));
+  }
+  *groups = std::move(ordered_groups);
+  *unions = std::move(ordered_unions);
+
+  return Status::Ok();
+}
+
+Status Consolidator::consolidate_concurrently(
+    const ArraySchema* array_schema,
+    const URI& array_uri,
+    EncryptionType encryption_type,
+    const void* encryption_key,
+    uint32_t key_length,
+    const std::vector<std::vector<TimestampedURI>>& groups,
+    const std::vector<NDRange>& unions,
+    std::vector<URI>* new_fragment_uris) {
+  auto timer_se = stats_->start_timer("consolidate_concurrently");
+
+  // Every step opens its own arrays, as they hold the loaded fragments
+  auto consolidate_group = [&](uint64_t g) {
+    Array array_for_reads(array_uri, storage_manager_);
+    RETURN_NOT_OK(array_for_reads.open_without_fragments(
+        encryption_type, encryption_key, key_length));
+    Array array_for_writes(array_uri, storage_manager_);
+    RETURN_NOT_OK_ELSE(
+        array_for_writes.open(
+            QueryType::WRITE, encryption_type, encryption_key, key_length),
+        array_for_reads.close());
+    auto st = consolidate(
+        array_for_reads,
+        array_for_writes,
+        groups[g],
+        unions[g],
+        &(*new_fragment_uris)[g]);
+    array_for_reads.close();
+    array_for_writes.close();
+    return st;
+  };
+
+  // Run as many steps at a time as their buffers fit in the budget
+  uint64_t buffer_num = 0;
+  for (const auto& attr : array_schema->attributes())
+    buffer_num += 1 + attr->var_size() + attr->nullable();
+  for (unsigned d = 0; d < array_schema->dim_num(); ++d)
+    buffer_num += 1 + array_schema->dimension(d)->var_size();
+  uint64_t step_bytes = buffer_num * config_.buffer_size_;
+  if (config_.max_in_flight_bytes_ > 0)
+    step_bytes = 2 * step_bytes;
+  if (config_.total_buffer_size_ > 0)
+    step_bytes = config_.total_buffer_size_;
+  step_bytes += config_.max_in_flight_bytes_;
+  const uint64_t concurrency =
+      std::max<uint64_t>(1, config_.concurrent_budget_ / step_bytes);
+  stats_->add_counter("consolidate_concurrent_step_num", groups.size());
+
+  for (uint64_t b = 0; b < groups.size(); b += concurrency) {
+    RETURN_NOT_OK(parallel_for(
+        storage_manager_->compute_tp(),
+        b,
+        std::min<uint64_t>(b + concurrency, groups.size()),
+        consolidate_group));
+  }
 
   return Status::Ok();
 }
@@ -324,13 +522,27 @@ Status Consolidator::consolidate(
     return Status::Ok();
   }
 
-  // Get schema
-  auto array_schema = array_for_reads.array_schema_latest();
-
-  // Prepare buffers
-  std::vector<ByteVec> buffers;
-  std::vector<uint64_t> buffer_sizes;
-  RETURN_NOT_OK(create_buffers(array_schema, &buffers, &buffer_sizes));
+  // Fragments with disjoint space tiles are concatenated without unfiltering
+  // their tiles
+  std::vector<tdb_shared_ptr<FragmentMetadata>> ordered_meta;
+  if (config_.tile_copy_ && can_copy_tiles(array_for_reads, &ordered_meta)) {
+    auto meta = array_for_reads.fragment_metadata();
+    RETURN_NOT_OK(compute_new_fragment_uri(
+        meta.front()->fragment_uri(),
+        meta.back()->fragment_uri(),
+        array_for_reads.array_schema_latest()->write_version(),
+        new_fragment_uri));
+    auto st = copy_tiles(array_for_reads, ordered_meta, *new_fragment_uri);
+    if (st.ok())
+      st = write_vacuum_file(*new_fragment_uri, to_consolidate);
+    if (!st.ok()) {
+      bool is_dir = false;
+      storage_manager_->vfs()->is_dir(*new_fragment_uri, &is_dir);
+      if (is_dir)
+        storage_manager_->vfs()->remove_dir(*new_fragment_uri);
+    }
+    return st;
+  }
 
   // Create queries
   auto query_r = (Query*)nullptr;
@@ -348,8 +560,42 @@ Status Consolidator::consolidate(
     return st;
   }
 
+  // Reserve the buffers from the memory governor, if enabled
+  uint64_t budget = config_.total_buffer_size_;
+  auto governor = storage_manager_->governor();
+  if (budget > 0 && governor != nullptr) {
+    budget = governor->reserve(
+        budget,
+        static_cast<uint64_t>(budget * config_.governor_min_ratio_),
+        std::chrono::milliseconds(config_.governor_timeout_ms_));
+    if (budget == 0) {
+      tdb_delete(query_r);
+      tdb_delete(query_w);
+      return logger_->status(Status_ConsolidatorError(
+          "Cannot consolidate; Cannot reserve the consolidation buffers, the "
+          "total budget of the context is exhausted"));
+    }
+    if (budget < config_.total_buffer_size_)
+      stats_->add_counter("consolidate_buffer_budget_shrunk_num", 1);
+  }
+
   // Read from one array and write to the other
-  st = copy_array(query_r, query_w, &buffers, &buffer_sizes);
+  std::vector<uint64_t> sizes;
+  if (config_.max_in_flight_bytes_ > 0) {
+    st = compute_buffer_sizes(array_for_reads, budget / 2, &sizes);
+    if (st.ok())
+      st = copy_array_pipelined(query_r, query_w, sizes);
+  } else {
+    std::vector<ByteVec> buffers;
+    std::vector<uint64_t> buffer_sizes;
+    st = compute_buffer_sizes(array_for_reads, budget, &sizes);
+    if (st.ok())
+      st = create_buffers(sizes, &buffers, &buffer_sizes);
+    if (st.ok())
+      st = copy_array(query_r, query_w, &buffers, &buffer_sizes);
+  }
+  if (config_.total_buffer_size_ > 0 && governor != nullptr)
+    governor->release(budget);
   if (!st.ok()) {
     tdb_delete(query_r);
     tdb_delete(query_w);
@@ -388,6 +634,288 @@ Status Consolidator::consolidate(
   return st;
 }
 
+bool Consolidator::can_copy_tiles(
+    Array& array_for_reads,
+    std::vector<tdb_shared_ptr<FragmentMetadata>>* ordered_meta) const {
+  auto array_schema = array_for_reads.array_schema_latest();
+  auto domain = array_schema->domain();
+  auto dim_num = array_schema->dim_num();
+  if (array_schema->dense() || layout_is_curve(array_schema->cell_order()))
+    return false;
+
+  // The tiles of grouped attributes are interleaved in one file, which
+  // cannot be appended attribute by attribute
+  if (!array_schema->attribute_groups().empty())
+    return false;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (array_schema->dimension(d)->var_size())
+      return false;
+  }
+
+  // The filtered tiles can be copied only if they were written with the
+  // same filters and format, in separate files
+  auto meta = array_for_reads.fragment_metadata();
+  for (const auto& m : meta) {
+    if (m->dense() || m->packed() || m->array_schema() != array_schema ||
+        m->format_version() != array_schema->write_version())
+      return false;
+  }
+
+  // Compares the tiles of a corner of two ranges on the tile order
+  const bool row_major = array_schema->tile_order() == Layout::ROW_MAJOR;
+  auto cmp = [&](const NDRange& a, bool a_end, const NDRange& b, bool b_end) {
+    for (unsigned i = 0; i < dim_num; ++i) {
+      auto d = row_major ? i : dim_num - 1 - i;
+      auto res = domain->tile_order_cmp(
+          d,
+          a_end ? a[d].end() : a[d].start(),
+          b_end ? b[d].end() : b[d].start());
+      if (res != 0)
+        return res;
+    }
+    return 0;
+  };
+
+  // Order the fragments by their first space tile. The cells of a fragment
+  // all precede those of the next one if its last space tile precedes the
+  // first space tile of the next one.
+  *ordered_meta = meta;
+  std::sort(
+      ordered_meta->begin(),
+      ordered_meta->end(),
+      [&](const tdb_shared_ptr<FragmentMetadata>& a,
+          const tdb_shared_ptr<FragmentMetadata>& b) {
+        return cmp(a->non_empty_domain(), false, b->non_empty_domain(), false) <
+               0;
+      });
+  for (size_t i = 1; i < ordered_meta->size(); ++i) {
+    const auto& prev = (*ordered_meta)[i - 1];
+    const auto& next = (*ordered_meta)[i];
+    if (cmp(prev->non_empty_domain(), true, next->non_empty_domain(), false) >=
+        0)
+      return false;
+
+    // Only the last tile of the new fragment may be partial
+    if (prev->last_tile_cell_num() != array_schema->capacity())
+      return false;
+  }
+
+  return true;
+}
+
+Status Consolidator::copy_tiles(
+    Array& array_for_reads,
+    const std::vector<tdb_shared_ptr<FragmentMetadata>>& ordered_meta,
+    const URI& new_fragment_uri) {
+  auto timer_se = stats_->start_timer("consolidate_copy_tiles");
+
+  auto array_schema = array_for_reads.array_schema_latest();
+  const auto& enc_key = array_for_reads.get_encryption_key();
+  std::vector<std::string> names;
+  for (const auto& attr : array_schema->attributes())
+    names.emplace_back(attr->name());
+  for (const auto& dim_name : array_schema->dim_names())
+    names.emplace_back(dim_name);
+
+  // Load the MBRs, tile offsets and tile metadata of the fragments
+  auto status = parallel_for(
+      storage_manager_->io_tp(), 0, ordered_meta.size(), [&](uint64_t i) {
+        const auto& m = ordered_meta[i];
+        RETURN_NOT_OK(m->load_rtree(enc_key));
+        RETURN_NOT_OK(m->load_tile_offsets(enc_key, std::vector(names)));
+        for (const auto& name : names) {
+          if (array_schema->var_size(name))
+            RETURN_NOT_OK(m->load_tile_var_sizes(enc_key, name));
+        }
+        RETURN_NOT_OK(m->load_tile_min_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(m->load_tile_max_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(m->load_tile_sum_values(enc_key, std::vector(names)));
+        RETURN_NOT_OK(
+            m->load_tile_null_count_values(enc_key, std::vector(names)));
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  // Create the new fragment
+  std::pair<uint64_t, uint64_t> timestamp_range;
+  RETURN_NOT_OK(
+      utils::parse::get_timestamp_range(new_fragment_uri, &timestamp_range));
+  auto new_meta = tdb::make_shared<FragmentMetadata>(
+      HERE(),
+      storage_manager_,
+      nullptr,
+      array_schema,
+      new_fragment_uri,
+      timestamp_range,
+      false);
+  RETURN_NOT_OK(new_meta->init(ordered_meta.front()->non_empty_domain()));
+  RETURN_NOT_OK(storage_manager_->create_dir(new_fragment_uri));
+  RETURN_NOT_OK(storage_manager_->vfs()->begin_group_commit(new_fragment_uri));
+
+  uint64_t tile_num = 0;
+  for (const auto& m : ordered_meta)
+    tile_num += m->tile_num();
+  RETURN_NOT_OK(new_meta->set_num_tiles(tile_num));
+
+  // The MBRs expand the non-empty domain of the new fragment
+  uint64_t tid = 0;
+  for (const auto& m : ordered_meta) {
+    for (uint64_t t = 0; t < m->tile_num(); ++t, ++tid)
+      RETURN_NOT_OK(new_meta->set_mbr(tid, m->mbr(t)));
+  }
+  new_meta->set_last_tile_cell_num(ordered_meta.back()->last_tile_cell_num());
+
+  // Append the files of each field and set its tile offsets and metadata
+  status = parallel_for(
+      storage_manager_->io_tp(), 0, names.size(), [&](uint64_t i) {
+        const auto& name = names[i];
+        const auto var_size = array_schema->var_size(name);
+        const auto nullable = array_schema->is_nullable(name);
+        const auto type = array_schema->type(name);
+        const auto cell_val_num = array_schema->cell_val_num(name);
+        const auto has_min_max = TileMetadataGenerator::has_min_max_metadata(
+            type, array_schema->is_dim(name), var_size, cell_val_num);
+        const auto has_sum =
+            !var_size &&
+            TileMetadataGenerator::has_sum_metadata(type, false, cell_val_num);
+
+        auto&& [st_uri, uri] = new_meta->uri(name);
+        RETURN_NOT_OK(st_uri);
+        optional<URI> var_uri, validity_uri;
+        if (var_size) {
+          auto&& [st, u] = new_meta->var_uri(name);
+          RETURN_NOT_OK(st);
+          var_uri = u;
+        }
+        if (nullable) {
+          auto&& [st, u] = new_meta->validity_uri(name);
+          RETURN_NOT_OK(st);
+          validity_uri = u;
+        }
+
+        uint64_t tid = 0;
+        for (const auto& m : ordered_meta) {
+          uint64_t nbytes = 0, var_nbytes = 0, validity_nbytes = 0;
+          for (uint64_t t = 0; t < m->tile_num(); ++t, ++tid) {
+            auto&& [st, size] = m->persisted_tile_size(name, t);
+            RETURN_NOT_OK(st);
+            new_meta->set_tile_offset(name, tid, *size);
+            nbytes += *size;
+
+            if (var_size) {
+              auto&& [st_v, var_persisted] = m->persisted_tile_var_size(name, t);
+              RETURN_NOT_OK(st_v);
+              auto&& [st_s, var_tile_size] = m->tile_var_size(name, t);
+              RETURN_NOT_OK(st_s);
+              new_meta->set_tile_var_offset(name, tid, *var_persisted);
+              new_meta->set_tile_var_size(name, tid, *var_tile_size);
+              var_nbytes += *var_persisted;
+            }
+
+            if (nullable) {
+              auto&& [st_v, validity_size] =
+                  m->persisted_tile_validity_size(name, t);
+              RETURN_NOT_OK(st_v);
+              new_meta->set_tile_validity_offset(name, tid, *validity_size);
+              validity_nbytes += *validity_size;
+
+              auto&& [st_n, null_count] = m->get_tile_null_count(name, t);
+              RETURN_NOT_OK(st_n);
+              new_meta->set_tile_null_count(name, tid, *null_count);
+            }
+
+            if (has_min_max) {
+              auto&& [st_min, min, min_size] = m->get_tile_min(name, t);
+              RETURN_NOT_OK(st_min);
+              auto&& [st_max, max, max_size] = m->get_tile_max(name, t);
+              RETURN_NOT_OK(st_max);
+              if (var_size) {
+                new_meta->set_tile_min_var_size(name, tid, *min_size);
+                new_meta->set_tile_max_var_size(name, tid, *max_size);
+              } else {
+                new_meta->set_tile_min(name, tid, *min, *min_size);
+                new_meta->set_tile_max(name, tid, *max, *max_size);
+              }
+            }
+
+            if (has_sum) {
+              auto&& [st_sum, sum] = m->get_tile_sum(name, t);
+              RETURN_NOT_OK(st_sum);
+              ByteVec sum_vec(sizeof(uint64_t));
+              std::memcpy(sum_vec.data(), *sum, sizeof(uint64_t));
+              new_meta->set_tile_sum(name, tid, &sum_vec);
+            }
+          }
+
+          auto&& [st_u, m_uri] = m->uri(name);
+          RETURN_NOT_OK(st_u);
+          RETURN_NOT_OK(append_file(*m_uri, *uri, nbytes));
+          if (var_size) {
+            auto&& [st, m_var_uri] = m->var_uri(name);
+            RETURN_NOT_OK(st);
+            RETURN_NOT_OK(append_file(*m_var_uri, *var_uri, var_nbytes));
+          }
+          if (nullable) {
+            auto&& [st, m_validity_uri] = m->validity_uri(name);
+            RETURN_NOT_OK(st);
+            RETURN_NOT_OK(
+                append_file(*m_validity_uri, *validity_uri, validity_nbytes));
+          }
+        }
+
+        // The var-sized minimums and maximums are copied once all their
+        // sizes are known
+        if (has_min_max && var_size) {
+          new_meta->convert_tile_min_max_var_sizes_to_offsets(name);
+          tid = 0;
+          for (const auto& m : ordered_meta) {
+            for (uint64_t t = 0; t < m->tile_num(); ++t, ++tid) {
+              auto&& [st_min, min, min_size] = m->get_tile_min(name, t);
+              RETURN_NOT_OK(st_min);
+              auto&& [st_max, max, max_size] = m->get_tile_max(name, t);
+              RETURN_NOT_OK(st_max);
+              if (*min_size > 0)
+                new_meta->set_tile_min_var(name, tid, *min);
+              if (*max_size > 0)
+                new_meta->set_tile_max_var(name, tid, *max);
+            }
+          }
+        }
+
+        RETURN_NOT_OK(storage_manager_->close_file(*uri));
+        if (var_size)
+          RETURN_NOT_OK(storage_manager_->close_file(*var_uri));
+        if (nullable)
+          RETURN_NOT_OK(storage_manager_->close_file(*validity_uri));
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  stats_->add_counter("consolidate_copied_tile_num", tile_num);
+
+  // Store the metadata and make the fragment visible
+  RETURN_NOT_OK(new_meta->store(enc_key));
+  auto ok_uri = URI(
+      new_fragment_uri.remove_trailing_slash().to_string() +
+      constants::ok_file_suffix);
+  RETURN_NOT_OK(storage_manager_->vfs()->commit_group(new_fragment_uri));
+  return storage_manager_->vfs()->touch(ok_uri);
+}
+
+Status Consolidator::append_file(
+    const URI& from, const URI& to, uint64_t nbytes) const {
+  auto vfs = storage_manager_->vfs();
+  std::vector<uint8_t> buff(
+      std::min(nbytes, std::max<uint64_t>(config_.buffer_size_, 1)));
+  for (uint64_t offset = 0; offset < nbytes; offset += buff.size()) {
+    auto size = std::min<uint64_t>(buff.size(), nbytes - offset);
+    RETURN_NOT_OK(vfs->read(from, offset, buff.data(), size, false));
+    RETURN_NOT_OK(storage_manager_->write(to, buff.data(), size));
+  }
+
+  return Status::Ok();
+}
+
 Status Consolidator::consolidate_fragment_meta(
     const URI& array_uri,
     EncryptionType encryption_type,
@@ -400,30 +928,62 @@ Status Consolidator::consolidate_fragment_meta(
   RETURN_NOT_OK(
       array.open(QueryType::READ, encryption_type, encryption_key, key_length));
 
-  // Include only fragments with footers / separate basic metadata
+  // Append a delta to the latest consolidated fragment metadata, unless it
+  // already has the maximum number of deltas
+  std::vector<URI> fragment_uris, meta_uris;
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->get_fragment_uris(
+          array_uri, &fragment_uris, &meta_uris),
+      array.close());
+  bool delta = config_.frag_meta_max_deltas_ > 0 && !meta_uris.empty() &&
+               meta_uris.size() <= config_.frag_meta_max_deltas_;
+  std::pair<uint64_t, uint64_t> meta_range = {0, 0};
+  if (!meta_uris.empty())
+    RETURN_NOT_OK_ELSE(
+        utils::parse::get_timestamp_range(meta_uris.back(), &meta_range),
+        array.close());
+
+  // Include only fragments with footers / separate basic metadata, and
+  // for a delta only those missing from the consolidated metadata
   Buffer buff;
   const auto& tmp_meta = array.fragment_metadata();
   std::vector<tdb_shared_ptr<FragmentMetadata>> meta;
   for (auto m : tmp_meta) {
-    if (m->format_version() > 2)
+    if (m->format_version() > 2 && !(delta && m->has_consolidated_footer()))
       meta.emplace_back(m);
   }
   auto fragment_num = (unsigned)meta.size();
 
-  // Do not consolidate if the number of fragments is not >1
-  if (fragment_num < 2)
+  // Do not consolidate if the number of fragments is not >1, or if there
+  // is nothing to append
+  if (fragment_num < (delta ? 1u : 2u))
     return array.close();
 
   // Write number of fragments
   RETURN_NOT_OK(buff.write(&fragment_num, sizeof(uint32_t)));
 
-  // Compute new URI
+  // Compute new URI. It must end after the latest consolidated metadata so
+  // that it is the latest one, and a delta must start after it.
   URI uri;
   auto first = meta.front()->fragment_uri();
   auto last = meta.back()->fragment_uri();
-  RETURN_NOT_OK(compute_new_fragment_uri(
-      first, last, array.array_schema_latest()->write_version(), &uri));
-  uri = URI(uri.to_string() + constants::meta_file_suffix);
+  std::pair<uint64_t, uint64_t> t_first, t_last;
+  RETURN_NOT_OK(utils::parse::get_timestamp_range(first, &t_first));
+  RETURN_NOT_OK(utils::parse::get_timestamp_range(last, &t_last));
+  uint64_t t_start = delta ? meta_range.second + 1 : t_first.first;
+  uint64_t t_end = t_last.second;
+  if (!meta_uris.empty())
+    t_end = std::max(t_end, meta_range.second + 1);
+  std::string uuid;
+  RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
+  std::stringstream ss;
+  ss << first.parent().to_string() << "/__" << t_start << "_" << t_end << "_"
+     << uuid << "_" << array.array_schema_latest()->write_version()
+     << constants::meta_file_suffix;
+  uri = URI(ss.str());
+  stats_->add_counter(
+      delta ? "consolidate_frag_meta_delta_num" : "consolidate_frag_meta_num",
+      1);
 
   // Get the consolidated fragment metadata version
   auto meta_name = uri.remove_trailing_slash().last_path_part();
@@ -527,38 +1087,173 @@ Status Consolidator::copy_array(
   return Status::Ok();
 }
 
-Status Consolidator::create_buffers(
-    const ArraySchema* array_schema,
-    std::vector<ByteVec>* buffers,
-    std::vector<uint64_t>* buffer_sizes) {
-  auto timer_se = stats_->start_timer("consolidate_create_buffers");
+Status Consolidator::copy_array_pipelined(
+    Query* query_r, Query* query_w, const std::vector<uint64_t>& sizes) {
+  auto timer_se = stats_->start_timer("consolidate_copy_array");
+
+  // The write query filters and writes the full tiles in the background, so
+  // that they no longer reference the buffers once its submission returns.
+  Config config_w = *query_w->config();
+  RETURN_NOT_OK(config_w.set(
+      "sm.mem.writer.global_order.max_in_flight_bytes",
+      std::to_string(config_.max_in_flight_bytes_)));
+  RETURN_NOT_OK(query_w->set_config(config_w));
+
+  // Two sets of buffers, the cells of one are written while the next cells
+  // are read into the other.
+  std::vector<ByteVec> buffers[2];
+  std::vector<uint64_t> buffer_sizes[2];
+  for (unsigned i = 0; i < 2; ++i)
+    RETURN_NOT_OK(create_buffers(sizes, &buffers[i], &buffer_sizes[i]));
+
+  unsigned cur = 0;
+  RETURN_NOT_OK(set_query_buffers(query_r, &buffers[cur], &buffer_sizes[cur]));
+  RETURN_NOT_OK(query_r->submit());
+
+  auto compute_tp = storage_manager_->compute_tp();
+  while (true) {
+    // WRITE the current set in a task
+    RETURN_NOT_OK(
+        set_query_buffers(query_w, &buffers[cur], &buffer_sizes[cur]));
+    std::vector<ThreadPool::Task> tasks;
+    tasks.emplace_back(
+        compute_tp->execute([query_w]() { return query_w->submit(); }));
+
+    // READ the next cells into the other set meanwhile. The read query
+    // buffer sizes are reset, as they hold the sizes of the last results.
+    const bool incomplete = query_r->status() == QueryStatus::INCOMPLETE;
+    auto st = Status::Ok();
+    if (incomplete) {
+      const unsigned next = 1 - cur;
+      buffer_sizes[next] = sizes;
+      st = set_query_buffers(query_r, &buffers[next], &buffer_sizes[next]);
+      if (st.ok())
+        st = query_r->submit();
+      cur = next;
+    }
+
+    // The write must complete before its buffers are read into again.
+    RETURN_NOT_OK(compute_tp->wait_all(tasks));
+    RETURN_NOT_OK(st);
+
+    if (!incomplete)
+      break;
+  }
+
+  return Status::Ok();
+}
+
+Status Consolidator::compute_buffer_sizes(
+    Array& array_for_reads,
+    uint64_t budget,
+    std::vector<uint64_t>* sizes) const {
+  auto timer_se = stats_->start_timer("consolidate_compute_buffer_sizes");
 
   // For easy reference
-  auto attribute_num = array_schema->attribute_num();
-  auto domain = array_schema->domain();
+  auto array_schema = array_for_reads.array_schema_latest();
   auto dim_num = array_schema->dim_num();
   auto sparse = !array_schema->dense();
+  auto meta = array_for_reads.fragment_metadata();
 
-  // Calculate number of buffers
-  size_t buffer_num = 0;
-  for (unsigned i = 0; i < attribute_num; ++i) {
-    buffer_num += (array_schema->attributes()[i]->var_size()) ? 2 : 1;
-    buffer_num += (array_schema->attributes()[i]->nullable()) ? 1 : 0;
-  }
+  // The names of the attributes and dimensions with a buffer, in the order
+  // of `set_query_buffers`
+  std::vector<std::string> names;
+  for (const auto& attr : array_schema->attributes())
+    names.emplace_back(attr->name());
   if (sparse) {
-    for (unsigned i = 0; i < dim_num; ++i)
-      buffer_num += (domain->dimension(i)->var_size()) ? 2 : 1;
+    for (unsigned d = 0; d < dim_num; ++d)
+      names.emplace_back(array_schema->dimension(d)->name());
   }
 
-  // Create buffers
-  buffers->resize(buffer_num);
-  buffer_sizes->resize(buffer_num);
+  // The var tile sizes are needed for the average var cell sizes
+  if (budget > 0) {
+    const auto& encryption_key = *array_for_reads.encryption_key();
+    RETURN_NOT_OK(parallel_for(
+        storage_manager_->compute_tp(), 0, meta.size(), [&](size_t f) {
+          for (const auto& name : names) {
+            if (!array_schema->var_size(name) ||
+                !meta[f]->array_schema()->is_field(name))
+              continue;
+            RETURN_NOT_OK(meta[f]->load_tile_var_sizes(encryption_key, name));
+          }
+          return Status::Ok();
+        }));
+  }
+
+  // Compute the average cell size and the largest tile of every buffer
+  std::vector<double> cell_sizes;
+  std::vector<uint64_t> min_sizes;
+  uint64_t cell_num = 0;
+  uint64_t max_tile_cell_num = 0;
+  for (const auto& m : meta) {
+    cell_num += m->cell_num();
+    max_tile_cell_num = std::max(max_tile_cell_num, m->cell_num(0));
+  }
+  for (const auto& name : names) {
+    if (!array_schema->var_size(name)) {
+      const uint64_t cell_size = array_schema->cell_size(name);
+      cell_sizes.push_back(cell_size);
+      min_sizes.push_back(cell_size * max_tile_cell_num);
+    } else {
+      cell_sizes.push_back(constants::cell_var_offset_size);
+      min_sizes.push_back(constants::cell_var_offset_size * max_tile_cell_num);
+      uint64_t var_size = 0;
+      uint64_t max_var_size = 0;
+      for (const auto& m : meta) {
+        if (budget == 0 || m->format_version() <= 2 ||
+            !m->array_schema()->is_field(name))
+          continue;
+        for (uint64_t t = 0; t < m->tile_num(); ++t) {
+          auto&& [st, tile_var_size] = m->tile_var_size(name, t);
+          RETURN_NOT_OK(st);
+          var_size += *tile_var_size;
+          max_var_size = std::max(max_var_size, *tile_var_size);
+        }
+      }
+      cell_sizes.push_back(cell_num == 0 ? 1.0 : double(var_size) / cell_num);
+      min_sizes.push_back(max_var_size);
+    }
+    if (array_schema->is_nullable(name)) {
+      cell_sizes.push_back(constants::cell_validity_size);
+      min_sizes.push_back(constants::cell_validity_size * max_tile_cell_num);
+    }
+  }
+
+  // Without a budget, every buffer has the configured size
+  sizes->clear();
+  if (budget == 0) {
+    sizes->resize(cell_sizes.size(), config_.buffer_size_);
+    return Status::Ok();
+  }
+
+  // Split the budget in proportion to the cell sizes
+  double total_cell_size = 0;
+  for (auto cell_size : cell_sizes)
+    total_cell_size += std::max(cell_size, 1.0);
+  for (size_t i = 0; i < cell_sizes.size(); ++i) {
+    const auto share = static_cast<uint64_t>(
+        budget * (std::max(cell_sizes[i], 1.0) / total_cell_size));
+    sizes->push_back(std::max(share, min_sizes[i]));
+  }
+
+  return Status::Ok();
+}
+
+Status Consolidator::create_buffers(
+    const std::vector<uint64_t>& sizes,
+    std::vector<ByteVec>* buffers,
+    std::vector<uint64_t>* buffer_sizes) {
+  auto timer_se = stats_->start_timer("consolidate_create_buffers");
 
   // Allocate space for each buffer
-  for (unsigned i = 0; i < buffer_num; ++i) {
-    (*buffers)[i].resize(config_.buffer_size_);
-    (*buffer_sizes)[i] = config_.buffer_size_;
+  buffers->resize(sizes.size());
+  *buffer_sizes = sizes;
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    (*buffers)[i].resize(sizes[i]);
+    total_size += sizes[i];
   }
+  stats_->set_max_counter("consolidate_buffers_size", total_size);
 
   // Success
   return Status::Ok();
@@ -612,17 +1307,43 @@ Status Consolidator::compute_next_to_consolidate(
     const FragmentInfo& fragment_info,
     std::vector<TimestampedURI>* to_consolidate,
     NDRange* union_non_empty_domains) const {
+  return compute_next_to_consolidate(
+      array_schema,
+      fragment_info,
+      0,
+      fragment_info.single_fragment_info_vec().size(),
+      to_consolidate,
+      union_non_empty_domains);
+}
+
+Status Consolidator::compute_next_to_consolidate(
+    const ArraySchema* array_schema,
+    const FragmentInfo& fragment_info,
+    size_t begin,
+    size_t end,
+    std::vector<TimestampedURI>* to_consolidate,
+    NDRange* union_non_empty_domains) const {
   auto timer_se = stats_->start_timer("consolidate_compute_next");
 
+  if (config_.policy_ != "size_ratio")
+    return compute_next_by_tiers(
+        array_schema,
+        fragment_info,
+        begin,
+        end,
+        to_consolidate,
+        union_non_empty_domains);
+
   // Preparation
   auto sparse = !array_schema->dense();
   const auto& fragments = fragment_info.single_fragment_info_vec();
   auto domain = array_schema->domain();
   to_consolidate->clear();
+  const auto frag_num = end - begin;
   auto min = config_.min_frags_;
-  min = (uint32_t)((min > fragments.size()) ? fragments.size() : min);
+  min = (uint32_t)((min > frag_num) ? frag_num : min);
   auto max = config_.max_frags_;
-  max = (uint32_t)((max > fragments.size()) ? fragments.size() : max);
+  max = (uint32_t)((max > frag_num) ? frag_num : max);
   auto size_ratio = config_.size_ratio_;
 
   // Trivial case - no fragments
@@ -632,14 +1353,15 @@ Status Consolidator::compute_next_to_consolidate(
   // Prepare the dynamic-programming matrices. The rows are from 1 to max
   // and the columns represent the fragments in `fragments`. One matrix
   // stores the sum of fragment sizes, and the other the union of the
-  // corresponding non-empty domains of the fragments.
+  // corresponding non-empty domains of the fragments. The columns outside
+  // of [begin, end) are invalid entries.
   std::vector<std::vector<uint64_t>> m_sizes;
   std::vector<std::vector<NDRange>> m_union;
   auto col_num = fragments.size();
   auto row_num = max;
   m_sizes.resize(row_num);
   for (auto& row : m_sizes)
-    row.resize(col_num);
+    row.resize(col_num, UINT64_MAX);
   m_union.resize(row_num);
   for (auto& row : m_union) {
     row.resize(col_num);
@@ -654,11 +1376,11 @@ Status Consolidator::compute_next_to_consolidate(
   // This marks this entry as invalid and it will never be selected
   // as the winner for choosing which fragments to consolidate next.
   for (size_t i = 0; i < row_num; ++i) {
-    for (size_t j = 0; j < col_num; ++j) {
+    for (size_t j = begin; j < end; ++j) {
       if (i == 0) {  // In the first row we store the sizes of `fragments`
         m_sizes[i][j] = fragments[j].fragment_size();
         m_union[i][j] = fragments[j].non_empty_domain();
-      } else if (i + j >= col_num) {  // Non-valid entries
+      } else if (i + j >= end) {  // Non-valid entries
         m_sizes[i][j] = UINT64_MAX;
         m_union[i][j].clear();
         m_union[i][j].shrink_to_fit();
@@ -724,6 +1446,85 @@ Status Consolidator::compute_next_to_consolidate(
   return Status::Ok();
 }
 
+Status Consolidator::compute_next_by_tiers(
+    const ArraySchema* array_schema,
+    const FragmentInfo& fragment_info,
+    size_t begin,
+    size_t end,
+    std::vector<TimestampedURI>* to_consolidate,
+    NDRange* union_non_empty_domains) const {
+  auto sparse = !array_schema->dense();
+  const auto& fragments = fragment_info.single_fragment_info_vec();
+  auto domain = array_schema->domain();
+  auto fanout = config_.tier_fanout_;
+  to_consolidate->clear();
+
+  // Selects fragments [first, last) if they are consolidatable
+  auto select = [&](size_t first, size_t last) {
+    NDRange union_ned = fragments[first].non_empty_domain();
+    for (size_t f = first + 1; f < last; ++f)
+      domain->expand_ndrange(fragments[f].non_empty_domain(), &union_ned);
+    domain->expand_to_tiles(&union_ned);
+    if (!sparse &&
+        !are_consolidatable(domain, fragment_info, first, last - 1, union_ned))
+      return false;
+    for (size_t f = first; f < last; ++f)
+      to_consolidate->emplace_back(
+          fragments[f].uri(), fragments[f].timestamp_range());
+    *union_non_empty_domains = std::move(union_ned);
+    return true;
+  };
+
+  if (config_.policy_ == "size_tiered") {
+    // Tier 0 holds the fragments smaller than the base size, and every next
+    // tier fragments `fanout` times larger
+    auto tier = [&](uint64_t size) {
+      uint32_t t = 0;
+      uint64_t bound = std::max<uint64_t>(config_.tier_base_size_, 1);
+      while (size >= bound) {
+        ++t;
+        if (bound > UINT64_MAX / fanout)
+          break;
+        bound *= fanout;
+      }
+      return t;
+    };
+
+    // Select the oldest run of `fanout` adjacent fragments of the same tier
+    size_t run_len = std::min<size_t>(fanout, config_.max_frags_);
+    if (run_len < 2)
+      return Status::Ok();
+    for (size_t j = begin; j + run_len <= end; ++j) {
+      auto t = tier(fragments[j].fragment_size());
+      size_t f = j + 1;
+      while (f < j + run_len && tier(fragments[f].fragment_size()) == t)
+        ++f;
+      if (f == j + run_len && select(j, f))
+        break;
+    }
+  } else {
+    // Select the oldest fragment whose newer fragments add up to at least a
+    // `fanout` fraction of its size, along with all of them
+    if (config_.max_frags_ < 2)
+      return Status::Ok();
+    uint64_t newer_size = 0;
+    std::vector<uint64_t> newer_sizes(end - begin);
+    for (size_t j = end; j-- > begin;) {
+      newer_sizes[j - begin] = newer_size;
+      newer_size += fragments[j].fragment_size();
+    }
+    for (size_t j = begin; j + 1 < end; ++j) {
+      if (newer_sizes[j - begin] < fragments[j].fragment_size() / fanout)
+        continue;
+      auto last = std::min<size_t>(end, j + config_.max_frags_);
+      if (select(j, last))
+        break;
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status Consolidator::compute_new_fragment_uri(
     const URI& first,
     const URI& last,
@@ -821,6 +1622,21 @@ Status Consolidator::set_query_buffers(
   return Status::Ok();
 }
 
+uint64_t Consolidator::fragments_size(
+    const FragmentInfo& fragment_info,
+    const std::vector<TimestampedURI>& to_consolidate) const {
+  uint64_t size = 0;
+  for (const auto& fragment : fragment_info.single_fragment_info_vec()) {
+    for (const auto& uri : to_consolidate) {
+      if (uri.uri_ == fragment.uri()) {
+        size += fragment.fragment_size();
+        break;
+      }
+    }
+  }
+  return size;
+}
+
 Status Consolidator::set_config(const Config* config) {
   // Set the consolidation config for ease of use
   Config merged_config = storage_manager_->config();
@@ -839,6 +1655,36 @@ Status Consolidator::set_config(const Config* config) {
   RETURN_NOT_OK(merged_config.get<uint64_t>(
       "sm.consolidation.buffer_size", &config_.buffer_size_, &found));
   assert(found);
+  config_.total_buffer_size_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.consolidation.total_buffer_size",
+      &config_.total_buffer_size_,
+      &found));
+  assert(found);
+  config_.governor_min_ratio_ = 0;
+  RETURN_NOT_OK(merged_config.get<double>(
+      "sm.mem.governor.min_ratio", &config_.governor_min_ratio_, &found));
+  assert(found);
+  config_.governor_timeout_ms_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.mem.governor.timeout_ms", &config_.governor_timeout_ms_, &found));
+  assert(found);
+  config_.max_in_flight_bytes_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.consolidation.max_in_flight_bytes",
+      &config_.max_in_flight_bytes_,
+      &found));
+  assert(found);
+  config_.tile_copy_ = false;
+  RETURN_NOT_OK(merged_config.get<bool>(
+      "sm.consolidation.tile_copy", &config_.tile_copy_, &found));
+  assert(found);
+  config_.concurrent_budget_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.consolidation.concurrent_budget",
+      &config_.concurrent_budget_,
+      &found));
+  assert(found);
   config_.size_ratio_ = 0.0f;
   RETURN_NOT_OK(merged_config.get<float>(
       "sm.consolidation.step_size_ratio", &config_.size_ratio_, &found));
@@ -851,6 +1697,28 @@ Status Consolidator::set_config(const Config* config) {
   RETURN_NOT_OK(merged_config.get<uint32_t>(
       "sm.consolidation.step_max_frags", &config_.max_frags_, &found));
   assert(found);
+  config_.policy_ = merged_config.get("sm.consolidation.policy", &found);
+  assert(found);
+  config_.tier_fanout_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint32_t>(
+      "sm.consolidation.tier_fanout", &config_.tier_fanout_, &found));
+  assert(found);
+  config_.tier_base_size_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.consolidation.tier_base_size", &config_.tier_base_size_, &found));
+  assert(found);
+  config_.array_meta_max_deltas_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint32_t>(
+      "sm.consolidation.array_meta.max_deltas",
+      &config_.array_meta_max_deltas_,
+      &found));
+  assert(found);
+  config_.frag_meta_max_deltas_ = 0;
+  RETURN_NOT_OK(merged_config.get<uint32_t>(
+      "sm.consolidation.fragment_meta.max_deltas",
+      &config_.frag_meta_max_deltas_,
+      &found));
+  assert(found);
   const std::string mode = merged_config.get("sm.consolidation.mode", &found);
   if (!found)
     return logger_->status(Status_ConsolidatorError(
@@ -867,6 +1735,16 @@ Status Consolidator::set_config(const Config* config) {
   assert(found);
   config_.use_refactored_reader_ = reader.compare("refactored") == 0;
 
+  // Copied tiles do not carry the per-cell indexes built by the writer
+  uint64_t bloom_filter_bits = 0;
+  RETURN_NOT_OK(merged_config.get<uint64_t>(
+      "sm.coords_bloom_filter_bits_per_cell", &bloom_filter_bits, &found));
+  assert(found);
+  const std::string index_names =
+      merged_config.get("sm.attribute_index_names", &found);
+  if (bloom_filter_bits > 0 || !index_names.empty())
+    config_.tile_copy_ = false;
+
   // Sanity checks
   if (config_.min_frags_ > config_.max_frags_)
     return logger_->status(Status_ConsolidatorError(
@@ -876,6 +1754,15 @@ Status Consolidator::set_config(const Config* config) {
     return logger_->status(Status_ConsolidatorError(
         "Invalid configuration; Step size ratio config parameter must be in "
         "[0.0, 1.0]"));
+  if (config_.policy_ != "size_ratio" && config_.policy_ != "size_tiered" &&
+      config_.policy_ != "leveled")
+    return logger_->status(Status_ConsolidatorError(
+        "Invalid configuration; Unknown consolidation policy '" +
+        config_.policy_ + "'"));
+  if (config_.tier_fanout_ < 2)
+    return logger_->status(Status_ConsolidatorError(
+        "Invalid configuration; Tier fanout config parameter must be at "
+        "least 2"));
   if (config_.amplification_ < 0)
     return logger_->status(
         Status_ConsolidatorError("Invalid configuration; Amplification config "
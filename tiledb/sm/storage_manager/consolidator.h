@@ -48,6 +48,7 @@ namespace sm {
 
 class ArraySchema;
 class Config;
+class FragmentMetadata;
 class Query;
 class StorageManager;
 class URI;
@@ -73,6 +74,34 @@ class Consolidator {
     float amplification_;
     /** Attribute buffer size. */
     uint64_t buffer_size_;
+    /**
+     * The total size of the buffers of a fragment consolidation step, split
+     * across the buffers by their average cell sizes. 0 allocates
+     * `buffer_size_` bytes for every buffer.
+     */
+    uint64_t total_buffer_size_;
+    /**
+     * The smallest fraction of `total_buffer_size_` granted by the memory
+     * governor, if enabled.
+     */
+    double governor_min_ratio_;
+    /** How long to wait for the memory governor to grant the buffers. */
+    uint64_t governor_timeout_ms_;
+    /**
+     * The maximum bytes of consolidated tiles written in the background
+     * while the next cells are read. 0 reads and writes in turn.
+     */
+    uint64_t max_in_flight_bytes_;
+    /**
+     * Whether sparse fragments with disjoint space tiles are consolidated
+     * by copying their filtered tiles.
+     */
+    bool tile_copy_;
+    /**
+     * The total bytes of buffers of the sparse consolidation steps running
+     * concurrently. 0 runs the steps one at a time.
+     */
+    uint64_t concurrent_budget_;
     /**
      * Number of consolidation steps performed in a single
      * consolidation invocation.
@@ -82,6 +111,30 @@ class Consolidator {
     uint32_t min_frags_;
     /** Maximum number of fragments to consolidate in a single step. */
     uint32_t max_frags_;
+    /**
+     * The policy that selects the fragments of each step. It can be one of:
+     *     - "size_ratio": the smallest set of adjacent fragments satisfying
+     *       the size ratio, amplification and min/max fragment parameters
+     *     - "size_tiered": the oldest run of `tier_fanout_` adjacent
+     *       fragments of the same size tier
+     *     - "leveled": the oldest fragment with all the newer ones, once
+     *       these add up to a `tier_fanout_` fraction of its size
+     */
+    std::string policy_;
+    /** The size ratio of consecutive tiers or levels. */
+    uint32_t tier_fanout_;
+    /** The size under which fragments belong to the first tier. */
+    uint64_t tier_base_size_;
+    /**
+     * The maximum number of deltas appended to a consolidated fragment
+     * metadata file. 0 rewrites all the footers every time.
+     */
+    uint32_t frag_meta_max_deltas_;
+    /**
+     * The maximum number of consolidated array metadata files. 0 merges all
+     * the array metadata every time.
+     */
+    uint32_t array_meta_max_deltas_;
     /**
      * Minimum size ratio for two fragments to be considered for
      * consolidation.
@@ -199,6 +252,53 @@ class Consolidator {
       const void* encryption_key,
       uint32_t key_length);
 
+  /**
+   * Plans the next consolidation steps on disjoint sets of fragments, which
+   * can run concurrently. The fragments of each step are selected like in
+   * `compute_next_to_consolidate`, among the fragments left between the
+   * sets already selected.
+   *
+   * @param array_schema The array schema.
+   * @param fragment_info Information about all the fragments.
+   * @param max_steps The maximum number of steps to plan.
+   * @param groups The fragments to consolidate in each step, in the order
+   *     of the fragments.
+   * @param unions The union of the non-empty domains of each step.
+   * @return Status
+   */
+  Status plan_next_steps(
+      const ArraySchema* array_schema,
+      const FragmentInfo& fragment_info,
+      uint32_t max_steps,
+      std::vector<std::vector<TimestampedURI>>* groups,
+      std::vector<NDRange>* unions) const;
+
+  /**
+   * Runs the input consolidation steps concurrently, as many at a time as
+   * their buffers fit in `sm.consolidation.concurrent_budget`. Every step
+   * opens its own arrays for reads and writes.
+   *
+   * @param array_schema The array schema.
+   * @param array_uri The array URI.
+   * @param encryption_type The encryption type of the array.
+   * @param encryption_key If the array is encrypted, the private encryption
+   *    key. For unencrypted arrays, pass `nullptr`.
+   * @param key_length The length in bytes of the encryption key.
+   * @param groups The fragments to consolidate in each step.
+   * @param unions The union of the non-empty domains of each step.
+   * @param new_fragment_uris The URIs of the fragments created by the steps.
+   * @return Status
+   */
+  Status consolidate_concurrently(
+      const ArraySchema* array_schema,
+      const URI& array_uri,
+      EncryptionType encryption_type,
+      const void* encryption_key,
+      uint32_t key_length,
+      const std::vector<std::vector<TimestampedURI>>& groups,
+      const std::vector<NDRange>& unions,
+      std::vector<URI>* new_fragment_uris);
+
   /**
    * Checks if the fragments between `start` and `end` (inclusive)
    * in `fragments` are allowed to be consolidated. A set of fragments
@@ -249,6 +349,48 @@ class Consolidator {
       const NDRange& union_non_empty_domains,
       URI* new_fragment_uri);
 
+  /**
+   * Checks if the fragments loaded in `array_for_reads` can be consolidated
+   * by copying their filtered tiles. This is the case if the array is sparse
+   * with a row-major or col-major cell order and fixed-sized dimensions, and
+   * the fragments have the latest array schema and format version, their
+   * non-empty domains cover disjoint space tiles that can be ordered in the
+   * tile order, and all of them but the last one in that order end with a
+   * full tile.
+   *
+   * @param array_for_reads The array with the fragments to consolidate
+   *     loaded.
+   * @param ordered_meta The metadata of the fragments, in the global order
+   *     of their cells, if they can be consolidated by copying tiles.
+   * @return `True` if the fragments can be consolidated by copying tiles.
+   */
+  bool can_copy_tiles(
+      Array& array_for_reads,
+      std::vector<tdb_shared_ptr<FragmentMetadata>>* ordered_meta) const;
+
+  /**
+   * Creates the new fragment by concatenating the filtered tiles of the
+   * input fragments, which must satisfy `can_copy_tiles`. Only the tile
+   * offsets, MBRs and tile metadata of the new fragment are computed.
+   *
+   * @param array_for_reads The array with the fragments to consolidate
+   *     loaded.
+   * @param ordered_meta The metadata of the fragments, in the global order
+   *     of their cells.
+   * @param new_fragment_uri The URI of the new fragment.
+   * @return Status
+   */
+  Status copy_tiles(
+      Array& array_for_reads,
+      const std::vector<tdb_shared_ptr<FragmentMetadata>>& ordered_meta,
+      const URI& new_fragment_uri);
+
+  /**
+   * Appends the first `nbytes` bytes of file `from` to file `to`, in chunks
+   * of at most `sm.consolidation.buffer_size` bytes.
+   */
+  Status append_file(const URI& from, const URI& to, uint64_t nbytes) const;
+
   /**
    * Consolidates the fragment metadata of the input array.
    *
@@ -257,6 +399,12 @@ class Consolidator {
    * fragment whose footers it consolidates, and `v` is the
    * format version.
    *
+   * If the latest consolidated fragment metadata has fewer than
+   * `sm.consolidation.fragment_meta.max_deltas` deltas, the file is a delta
+   * with the footers of the fragments it misses only. `t1` is then right
+   * after the end timestamp of the latest file, which makes the file a
+   * delta of it.
+   *
    * The file format is as follows:
    * <number of fragments whose footers are consolidated in the file>
    * <framgment #1 name size> <fragment #1 name> <fragment #1 footer offset>
@@ -294,18 +442,49 @@ class Consolidator {
       std::vector<ByteVec>* buffers,
       std::vector<uint64_t>* buffer_sizes);
 
+  /**
+   * Copies the array like `copy_array`, but through two sets of buffers:
+   * the cells read into one set are written while the next cells are read
+   * into the other. The write query filters and writes the full tiles in the
+   * background, with at most `config_.max_in_flight_bytes_` bytes in flight.
+   *
+   * @param query_r The read query.
+   * @param query_w The write query.
+   * @param sizes The sizes of the buffers of each set.
+   * @return Status
+   */
+  Status copy_array_pipelined(
+      Query* query_r, Query* query_w, const std::vector<uint64_t>& sizes);
+
+  /**
+   * Computes the sizes of the buffers used upon reading the input fragments
+   * and writing into the new fragment, in the order of `set_query_buffers`.
+   * With a budget of 0, every buffer gets `config_.buffer_size_` bytes.
+   * Otherwise, the budget is split in proportion to the average cell sizes
+   * of the buffers in the fragments of `array_for_reads`, each buffer
+   * holding at least its largest tile.
+   *
+   * @param array_for_reads The array opened for reads.
+   * @param budget The total bytes of the buffers.
+   * @param sizes The computed buffer sizes.
+   * @return Status
+   */
+  Status compute_buffer_sizes(
+      Array& array_for_reads,
+      uint64_t budget,
+      std::vector<uint64_t>* sizes) const;
+
   /**
    * Creates the buffers that will be used upon reading the input fragments and
-   * writing into the new fragment. It also retrieves the number of buffers
-   * created.
+   * writing into the new fragment.
    *
-   * @param array_schema The array schema.
+   * @param sizes The sizes of the buffers.
    * @param buffers The buffers to be created.
    * @param buffer_sizes The corresponding buffer sizes.
    * @return Status
    */
   Status create_buffers(
-      const ArraySchema* array_schema,
+      const std::vector<uint64_t>& sizes,
       std::vector<ByteVec>* buffers,
       std::vector<uint64_t>* buffer_sizes);
 
@@ -350,6 +529,36 @@ class Consolidator {
       std::vector<TimestampedURI>* to_consolidate,
       NDRange* union_non_empty_domains) const;
 
+  /**
+   * Like `compute_next_to_consolidate` above, but selects only among the
+   * fragments at positions `[begin, end)` of the fragment info.
+   */
+  Status compute_next_to_consolidate(
+      const ArraySchema* array_schema,
+      const FragmentInfo& fragment_info,
+      size_t begin,
+      size_t end,
+      std::vector<TimestampedURI>* to_consolidate,
+      NDRange* union_non_empty_domains) const;
+
+  /**
+   * Implements the `size_tiered` and `leveled` consolidation policies for
+   * `compute_next_to_consolidate`, selecting among the fragments at
+   * positions `[begin, end)` of the fragment info.
+   */
+  Status compute_next_by_tiers(
+      const ArraySchema* array_schema,
+      const FragmentInfo& fragment_info,
+      size_t begin,
+      size_t end,
+      std::vector<TimestampedURI>* to_consolidate,
+      NDRange* union_non_empty_domains) const;
+
+  /** Returns the total size of the `to_consolidate` fragments. */
+  uint64_t fragments_size(
+      const FragmentInfo& fragment_info,
+      const std::vector<TimestampedURI>& to_consolidate) const;
+
   /**
    * The new fragment URI is computed
    * as `__<first_URI_timestamp>_<last_URI_timestamp>_<uuid>`.
@@ -34,6 +34,7 @@
 
 #include "tiledb/common/logger.h"
 #include "tiledb/common/memory.h"
+#include "tiledb/sm/misc/shared_registry.h"
 #include "tiledb/sm/storage_manager/context.h"
 
 using namespace tiledb::common;
@@ -48,12 +49,19 @@ namespace sm {
 Context::Context()
     : last_error_(Status::Ok())
     , storage_manager_(nullptr)
+    , compute_tp_(tdb::make_shared<ThreadPool>(HERE()))
+    , io_tp_(tdb::make_shared<ThreadPool>(HERE()))
     , stats_(tdb::make_shared<stats::Stats>(HERE(), "Context"))
     , logger_(tdb::make_shared<Logger>(
           HERE(), "Context: " + std::to_string(++logger_id_))) {
 }
 
 Context::~Context() {
+  // Stop recording the activity of the thread pools before they are
+  // destructed.
+  if (thread_pool_stats_id_.has_value())
+    stats::all_stats.unregister_refresh(*thread_pool_stats_id_);
+
   bool found = false;
   bool use_malloc_trim = false;
 
@@ -61,6 +69,7 @@ Context::~Context() {
     const Status& st = storage_manager_->config().get<bool>(
         "sm.mem.malloc_trim", &use_malloc_trim, &found);
     if (st.ok() && found && use_malloc_trim) {
+      storage_manager_->trim_tile_buffer_pool();
       tdb_malloc_trim();
     }
   }
@@ -82,20 +91,27 @@ Status Context::init(Config* const config) {
     return logger_->status(Status_ContextError(
         "Cannot initialize context; Context already initialized"));
 
-  // Initialize `compute_tp_` and `io_tp_`.
-  RETURN_NOT_OK(init_thread_pools(config));
+  // Initialize `compute_tp_` and `io_tp_`. Their workers are started with
+  // the first task.
+  {
+    auto timer_se = stats_->start_timer("init_thread_pools");
+    RETURN_NOT_OK(init_thread_pools(config));
+  }
 
   // Register stats.
   stats::all_stats.register_stats(stats_);
 
   // Create storage manager
   storage_manager_ = new (std::nothrow)
-      tiledb::sm::StorageManager(&compute_tp_, &io_tp_, stats_.get(), logger_);
+      tiledb::sm::StorageManager(
+          compute_tp_.get(), io_tp_.get(), stats_.get(), logger_);
   if (storage_manager_ == nullptr)
     return logger_->status(Status_ContextError(
         "Cannot initialize context Storage manager allocation failed"));
 
-  // Initialize storage manager
+  // Initialize storage manager. The storage backends are only initialized
+  // on the first use of their URI scheme.
+  auto timer_se = stats_->start_timer("init_storage_manager");
   auto sm = storage_manager_->init(config);
 
   return sm;
@@ -116,11 +132,11 @@ StorageManager* Context::storage_manager() const {
 }
 
 ThreadPool* Context::compute_tp() const {
-  return &compute_tp_;
+  return compute_tp_.get();
 }
 
 ThreadPool* Context::io_tp() const {
-  return &io_tp_;
+  return io_tp_.get();
 }
 
 stats::Stats* Context::stats() const {
@@ -210,13 +226,108 @@ Status Context::init_thread_pools(Config* const config) {
       std::max(max_thread_count, compute_concurrency_level);
   io_concurrency_level = std::max(max_thread_count, io_concurrency_level);
 
-  // Initialize the thread pools.
-  RETURN_NOT_OK(compute_tp_.init(compute_concurrency_level));
-  RETURN_NOT_OK(io_tp_.init(io_concurrency_level));
+  // Fetch the CPUs to pin the workers of the thread pools to.
+  std::vector<ThreadPool::CpuSet> compute_affinity, io_affinity;
+  RETURN_NOT_OK(ThreadPool::parse_affinity(
+      tmp_config.get("sm.compute_affinity", &found), &compute_affinity));
+  assert(found);
+  RETURN_NOT_OK(ThreadPool::parse_affinity(
+      tmp_config.get("sm.io_affinity", &found), &io_affinity));
+  assert(found);
+
+  // Initialize the thread pools, or get the ones of the other contexts
+  // with the same configuration.
+  bool shared_resources = false;
+  RETURN_NOT_OK(tmp_config.get<bool>(
+      "sm.shared_resources", &shared_resources, &found));
+  assert(found);
+  if (shared_resources) {
+    RETURN_NOT_OK(get_shared_thread_pool(
+        "compute",
+        compute_concurrency_level,
+        tmp_config.get("sm.compute_affinity", &found),
+        compute_affinity,
+        &compute_tp_));
+    RETURN_NOT_OK(get_shared_thread_pool(
+        "io",
+        io_concurrency_level,
+        tmp_config.get("sm.io_affinity", &found),
+        io_affinity,
+        &io_tp_));
+  } else {
+    RETURN_NOT_OK(
+        compute_tp_->init(compute_concurrency_level, compute_affinity));
+    RETURN_NOT_OK(io_tp_->init(io_concurrency_level, io_affinity));
+  }
+
+  // Record the activity of the thread pools in the stats when they are
+  // dumped.
+  bool thread_pool_stats = false;
+  RETURN_NOT_OK(tmp_config.get<bool>(
+      "sm.thread_pool_stats", &thread_pool_stats, &found));
+  assert(found);
+  if (thread_pool_stats) {
+    compute_tp_->set_counters_enabled(true);
+    io_tp_->set_counters_enabled(true);
+    auto compute_stats = stats_->create_child("ComputeThreadPool");
+    auto io_stats = stats_->create_child("IOThreadPool");
+    thread_pool_stats_id_ =
+        stats::all_stats.register_refresh([this, compute_stats, io_stats]() {
+          record_thread_pool_stats(compute_tp_.get(), compute_stats);
+          record_thread_pool_stats(io_tp_.get(), io_stats);
+        });
+  }
 
   return Status::Ok();
 }
 
+Status Context::get_shared_thread_pool(
+    const std::string& kind,
+    const uint64_t concurrency_level,
+    const std::string& affinity_str,
+    const std::vector<ThreadPool::CpuSet>& affinity,
+    tdb_shared_ptr<ThreadPool>* tp) {
+  static SharedRegistry<ThreadPool> shared_thread_pools;
+
+  const std::string key =
+      kind + "," + std::to_string(concurrency_level) + "," + affinity_str;
+  return shared_thread_pools.get(
+      key,
+      [&](tdb_shared_ptr<ThreadPool>* created) {
+        auto pool = tdb::make_shared<ThreadPool>(HERE());
+        RETURN_NOT_OK(pool->init(concurrency_level, affinity));
+        *created = pool;
+        return Status::Ok();
+      },
+      tp);
+}
+
+void Context::record_thread_pool_stats(
+    ThreadPool* const tp, stats::Stats* const stats) {
+  const auto counters = tp->take_counters();
+  stats->add_counter("task_submitted_num", counters.task_submitted_num);
+  stats->add_counter("task_executed_num", counters.task_executed_num);
+  stats->set_max_counter("queue_depth_max", counters.queue_depth_max);
+
+  // Bucket `i` of the histogram counts the waits under 2^i microseconds.
+  const auto& histogram = counters.task_wait_histogram;
+  for (uint64_t i = 0; i < histogram.size(); ++i) {
+    if (histogram[i] == 0)
+      continue;
+    const std::string bucket =
+        i + 1 == histogram.size() ?
+            "inf" :
+            "lt_" + std::to_string(uint64_t(1) << i) + "us";
+    stats->add_counter("task_wait." + bucket, histogram[i]);
+  }
+
+  for (uint64_t i = 0; i < counters.worker_busy_ns.size(); ++i) {
+    const std::string worker = "worker_" + std::to_string(i);
+    stats->add_counter(worker + ".busy_ns", counters.worker_busy_ns[i]);
+    stats->add_counter(worker + ".idle_ns", counters.worker_idle_ns[i]);
+  }
+}
+
 Status Context::init_loggers(Config* const config) {
   // If `config` is null, use a default-constructed config.
   Config tmp_config;
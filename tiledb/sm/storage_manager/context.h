@@ -38,6 +38,7 @@
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
 #include <mutex>
+#include <optional>
 
 using namespace tiledb::common;
 
@@ -99,15 +100,27 @@ class Context {
   /** The storage manager. */
   StorageManager* storage_manager_;
 
-  /** The thread pool for compute-bound tasks. */
-  mutable ThreadPool compute_tp_;
+  /**
+   * The thread pool for compute-bound tasks, shared with other contexts if
+   * `sm.shared_resources` is set.
+   */
+  tdb_shared_ptr<ThreadPool> compute_tp_;
 
-  /** The thread pool for io-bound tasks. */
-  mutable ThreadPool io_tp_;
+  /**
+   * The thread pool for io-bound tasks, shared with other contexts if
+   * `sm.shared_resources` is set.
+   */
+  tdb_shared_ptr<ThreadPool> io_tp_;
 
   /** The class stats. */
   tdb_shared_ptr<stats::Stats> stats_;
 
+  /**
+   * The id of the function recording the activity of the thread pools in
+   * `stats_` before they are dumped, if `sm.thread_pool_stats` is set.
+   */
+  std::optional<uint64_t> thread_pool_stats_id_;
+
   /** The class logger. */
   tdb_shared_ptr<Logger> logger_;
 
@@ -125,6 +138,33 @@ class Context {
    */
   Status init_thread_pools(Config* config);
 
+  /**
+   * Gets the thread pool shared by the contexts with the same configuration,
+   * creating it if there is none.
+   *
+   * @param kind The kind of the thread pool, "compute" or "io".
+   * @param concurrency_level The concurrency level of the thread pool.
+   * @param affinity_str The configured affinity of the workers.
+   * @param affinity The parsed affinity of the workers.
+   * @param tp Set to the thread pool.
+   * @return Status
+   */
+  static Status get_shared_thread_pool(
+      const std::string& kind,
+      uint64_t concurrency_level,
+      const std::string& affinity_str,
+      const std::vector<ThreadPool::CpuSet>& affinity,
+      tdb_shared_ptr<ThreadPool>* tp);
+
+  /**
+   * Records the activity of a thread pool since the last call in the given
+   * stats.
+   *
+   * @param tp The thread pool.
+   * @param stats The stats of the thread pool.
+   */
+  static void record_thread_pool_stats(ThreadPool* tp, stats::Stats* stats);
+
   /**
    * Initializes global and local logger.
    *
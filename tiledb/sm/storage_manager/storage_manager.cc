@@ -44,16 +44,26 @@
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/array_schema_evolution.h"
+#include "tiledb/sm/cache/array_schema_lru_cache.h"
+#include "tiledb/sm/cache/array_snapshot_lru_cache.h"
 #include "tiledb/sm/cache/buffer_lru_cache.h"
+#include "tiledb/sm/cache/fragment_metadata_lru_cache.h"
+#include "tiledb/sm/cache/inflight_tile_reads.h"
+#include "tiledb/sm/cache/sharded_buffer_lru_cache.h"
+#include "tiledb/sm/cache/shared_memory_tile_cache.h"
 #include "tiledb/sm/enums/array_type.h"
+#include "tiledb/sm/enums/cache_policy.h"
+#include "tiledb/sm/enums/huge_page_mode.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/enums/object_type.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/fragment/fragment_info.h"
+#include "tiledb/sm/fragment/packed_fragment.h"
 #include "tiledb/sm/global_state/global_state.h"
 #include "tiledb/sm/global_state/unit_test_config.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/time.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
 #include "tiledb/sm/query/query.h"
@@ -62,7 +72,9 @@
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/generic_tile_io.h"
+#include "tiledb/sm/tile/large_buffer_allocator.h"
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_buffer_pool.h"
 
 #include <algorithm>
 #include <iostream>
@@ -88,7 +100,13 @@ StorageManager::StorageManager(
     , queries_in_progress_(0)
     , compute_tp_(compute_tp)
     , io_tp_(io_tp)
-    , vfs_(nullptr) {
+    , async_running_(0)
+    , async_max_concurrent_(0)
+    , auto_consolidation_fragment_num_(0)
+    , auto_consolidation_interval_(0)
+    , auto_consolidation_backlog_(0)
+    , vfs_(nullptr)
+    , packed_fragment_num_(0) {
 }
 
 StorageManager::~StorageManager() {
@@ -116,6 +134,9 @@ Status StorageManager::array_close_for_reads(Array* array) {
   std::lock_guard<std::mutex> lock{open_arrays_mtx_};
   open_arrays_.erase(array);
 
+  // Release the memory mappings of the array files
+  vfs_->unmap_files(array->array_uri());
+
   return Status::Ok();
 }
 
@@ -126,6 +147,12 @@ Status StorageManager::array_close_for_writes(Array* array) {
   RETURN_NOT_OK(store_array_metadata(
       array->array_uri(), *array->encryption_key(), array->metadata()));
 
+  // List the written fragments on the next open
+  invalidate_listing_cache(array->array_uri());
+
+  // Keep the fragment count in check
+  RETURN_NOT_OK(auto_consolidate(array));
+
   // Remove entry from open arrays
   std::lock_guard<std::mutex> lock{open_arrays_mtx_};
   open_arrays_.erase(array);
@@ -143,15 +170,15 @@ StorageManager::load_array_schemas_and_fragment_metadata(
     MemoryTracker* memory_tracker,
     const EncryptionKey& enc_key,
     uint64_t timestamp_start,
-    uint64_t timestamp_end) {
+    uint64_t timestamp_end,
+    const std::vector<uint8_t>& open_subarray) {
   auto timer_se =
       stats_->start_timer("get_array_schemas_and_fragment_metadata");
 
   // Get the fragment URIs
-  std::vector<URI> fragment_uris;
-  URI meta_uri;
+  std::vector<URI> fragment_uris, meta_uris;
   RETURN_NOT_OK_TUPLE(
-      get_fragment_uris(array_uri, &fragment_uris, &meta_uri),
+      get_fragment_uris(array_uri, &fragment_uris, &meta_uris),
       std::nullopt,
       std::nullopt,
       std::nullopt);
@@ -169,7 +196,7 @@ StorageManager::load_array_schemas_and_fragment_metadata(
   Buffer f_buff;
   std::unordered_map<std::string, uint64_t> offsets;
   RETURN_NOT_OK_TUPLE(
-      load_consolidated_fragment_meta(meta_uri, enc_key, &f_buff, &offsets),
+      load_consolidated_fragment_meta(meta_uris, enc_key, &f_buff, &offsets),
       std::nullopt,
       std::nullopt,
       std::nullopt);
@@ -179,6 +206,31 @@ StorageManager::load_array_schemas_and_fragment_metadata(
       load_array_schemas(array_uri, enc_key);
   RETURN_NOT_OK_TUPLE(st_schemas, std::nullopt, std::nullopt, std::nullopt);
 
+  // Get the subarray hint the fragments are filtered with
+  NDRange subarray;
+  if (!open_subarray.empty()) {
+    auto domain = array_schema_latest.value()->domain();
+    uint64_t offset = 0;
+    for (unsigned d = 0; d < domain->dim_num(); ++d) {
+      auto dim = domain->dimension(d);
+      auto range_size = 2 * dim->coord_size();
+      if (dim->var_size() || offset + range_size > open_subarray.size()) {
+        offset = UINT64_MAX;
+        break;
+      }
+      subarray.emplace_back(&open_subarray[offset], range_size);
+      offset += range_size;
+    }
+    if (offset != open_subarray.size())
+      return {logger_->status(Status_StorageManagerError(
+                  "Cannot open array; The open subarray must hold a range "
+                  "for each dimension, and all dimensions must be "
+                  "fixed-sized")),
+              std::nullopt,
+              std::nullopt,
+              std::nullopt};
+  }
+
   // Load the fragment metadata
   auto&& [st_fragment_meta, fragment_metadata] = load_fragment_metadata(
       memory_tracker,
@@ -187,7 +239,8 @@ StorageManager::load_array_schemas_and_fragment_metadata(
       enc_key,
       fragments_to_load,
       &f_buff,
-      offsets);
+      offsets,
+      subarray.empty() ? nullptr : &subarray);
   RETURN_NOT_OK_TUPLE(
       st_fragment_meta, std::nullopt, std::nullopt, std::nullopt);
 
@@ -202,15 +255,59 @@ std::tuple<
     std::optional<std::vector<tdb_shared_ptr<FragmentMetadata>>>>
 StorageManager::array_open_for_reads(Array* array) {
   auto timer_se = stats_->start_timer("array_open_for_reads");
+
+  // An array opened at an explicit timestamp reuses the snapshot of an
+  // earlier open at the same timestamps
+  std::string snapshot_key;
+  if (array_snapshot_cache_ != nullptr &&
+      array->timestamp_end() != UINT64_MAX && array->open_subarray().empty()) {
+    snapshot_key = ArraySnapshotLRUCache::key(
+        array->array_uri(),
+        array->timestamp_start(),
+        array->timestamp_end_opened_at(),
+        *array->encryption_key());
+    auto snapshot = array_snapshot_cache_->get(snapshot_key);
+    if (snapshot != nullptr) {
+      stats_->add_counter("array_snapshot_cache_hit_num", 1);
+      auto array_schema_latest =
+          tdb_new(ArraySchema, snapshot->array_schema_latest_.get());
+
+      // Mark the array as open
+      std::lock_guard<std::mutex> lock{open_arrays_mtx_};
+      open_arrays_.insert(array);
+
+      return {Status::Ok(),
+              array_schema_latest,
+              snapshot->array_schemas_all_,
+              snapshot->fragment_metadata_};
+    }
+  }
+
+  // The fragment metadata shared through a snapshot outlive the array, so
+  // they are not tracked against its memory budget.
   auto&& [st, array_schema_latest, array_schemas_all, fragment_metadata] =
       load_array_schemas_and_fragment_metadata(
           array->array_uri(),
-          array->memory_tracker(),
+          snapshot_key.empty() ? array->memory_tracker() : nullptr,
           *array->encryption_key(),
           array->timestamp_start(),
-          array->timestamp_end_opened_at());
+          array->timestamp_end_opened_at(),
+          array->open_subarray());
   RETURN_NOT_OK_TUPLE(st, std::nullopt, std::nullopt, std::nullopt);
 
+  if (!snapshot_key.empty()) {
+    auto snapshot = tdb::make_shared<ArraySnapshot>(HERE());
+    snapshot->array_schema_latest_ = tdb_shared_ptr<ArraySchema>(
+        tdb_new(ArraySchema, array_schema_latest.value()));
+    snapshot->array_schemas_all_ = array_schemas_all.value();
+    snapshot->fragment_metadata_ = fragment_metadata.value();
+    RETURN_NOT_OK_TUPLE(
+        array_snapshot_cache_->insert(snapshot_key, snapshot),
+        std::nullopt,
+        std::nullopt,
+        std::nullopt);
+  }
+
   // Mark the array as open
   std::lock_guard<std::mutex> lock{open_arrays_mtx_};
   open_arrays_.insert(array);
@@ -238,6 +335,16 @@ StorageManager::array_open_for_reads_without_fragments(Array* array) {
   return {Status::Ok(), array_schema_latest, array_schemas_all};
 }
 
+Status StorageManager::array_open_for_reads_from_snapshot(Array* array) {
+  stats_->add_counter("array_open_from_snapshot_num", 1);
+
+  // Mark the array as open
+  std::lock_guard<std::mutex> lock{open_arrays_mtx_};
+  open_arrays_.insert(array);
+
+  return Status::Ok();
+}
+
 std::tuple<
     Status,
     std::optional<ArraySchema*>,
@@ -388,10 +495,18 @@ Status StorageManager::array_consolidate(
     }
   }
 
-  // Consolidate
+  // Consolidate at the configured thread pool priority
+  ThreadPool::Priority priority;
+  bool found = false;
+  RETURN_NOT_OK(ThreadPool::priority_enum(
+      config->get("sm.consolidation.priority", &found), &priority));
+  assert(found);
+  ThreadPool::ScopedPriority scoped_priority(priority);
   Consolidator consolidator(this);
-  return consolidator.consolidate(
+  auto st = consolidator.consolidate(
       array_name, encryption_type, encryption_key, key_length, config);
+  invalidate_listing_cache(array_uri);
+  return st;
 }
 
 Status StorageManager::array_vacuum(
@@ -417,6 +532,13 @@ Status StorageManager::array_vacuum(
       config->get<uint64_t>("sm.vacuum.timestamp_end", &timestamp_end, &found));
   assert(found);
 
+  // Vacuum at the consolidation thread pool priority
+  ThreadPool::Priority priority;
+  RETURN_NOT_OK(ThreadPool::priority_enum(
+      config->get("sm.consolidation.priority", &found), &priority));
+  assert(found);
+  ThreadPool::ScopedPriority scoped_priority(priority);
+
   if (mode == nullptr)
     return logger_->status(Status_StorageManagerError(
         "Cannot vacuum array; Vacuum mode cannot be null"));
@@ -432,6 +554,8 @@ Status StorageManager::array_vacuum(
     return logger_->status(
         Status_StorageManagerError("Cannot vacuum array; Invalid vacuum mode"));
 
+  invalidate_listing_cache(URI(array_name));
+
   return Status::Ok();
 }
 
@@ -451,30 +575,28 @@ Status StorageManager::array_vacuum_fragments(
   RETURN_NOT_OK(get_uris_to_vacuum(
       uris, timestamp_start, timestamp_end, &to_vacuum, &vac_uris));
 
-  // Delete the ok files
-  auto status =
-      parallel_for(compute_tp_, 0, to_vacuum.size(), [&, this](size_t i) {
-        auto uri = URI(to_vacuum[i].to_string() + constants::ok_file_suffix);
-        RETURN_NOT_OK(vfs_->remove_file(uri));
-
-        return Status::Ok();
-      });
-  RETURN_NOT_OK(status);
+  // Delete the ok files, and the packed fragments which have none
+  std::vector<URI> file_uris, dir_uris;
+  file_uris.reserve(to_vacuum.size());
+  dir_uris.reserve(to_vacuum.size());
+  for (const auto& uri : to_vacuum) {
+    if (utils::parse::ends_with(
+            uri.to_string(), constants::packed_fragment_suffix)) {
+      file_uris.emplace_back(uri);
+    } else {
+      file_uris.emplace_back(uri.to_string() + constants::ok_file_suffix);
+      dir_uris.emplace_back(uri);
+    }
+  }
+  RETURN_NOT_OK(vfs_->remove_files(file_uris));
 
   // Delete fragment directories
-  status = parallel_for(compute_tp_, 0, to_vacuum.size(), [&, this](size_t i) {
-    RETURN_NOT_OK(vfs_->remove_dir(to_vacuum[i]));
-
-    return Status::Ok();
-  });
-  RETURN_NOT_OK(status);
+  RETURN_NOT_OK(vfs_->remove_dirs(dir_uris));
 
   // Delete vacuum files
-  status = parallel_for(compute_tp_, 0, vac_uris.size(), [&, this](size_t i) {
-    RETURN_NOT_OK(vfs_->remove_file(vac_uris[i]));
-    return Status::Ok();
-  });
-  RETURN_NOT_OK(status);
+  RETURN_NOT_OK(vfs_->remove_files(vac_uris));
+
+  stats_->add_counter("vacuum_fragment_num", to_vacuum.size());
 
   return Status::Ok();
 }
@@ -485,26 +607,21 @@ Status StorageManager::array_vacuum_fragment_meta(const char* array_name) {
         "Cannot vacuum fragment metadata; Array name cannot be null"));
 
   // Get the consolidated fragment metadata URIs to be deleted
-  // (all except the last one)
+  // (all except the last one and its deltas)
   URI array_uri(array_name);
-  std::vector<URI> uris, to_vacuum;
-  URI last;
+  std::vector<URI> uris, to_vacuum, meta_uris;
   RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
-  RETURN_NOT_OK(get_consolidated_fragment_meta_uri(uris, &last));
+  RETURN_NOT_OK(get_consolidated_fragment_meta_uris(uris, &meta_uris));
+  std::set<URI> to_keep(meta_uris.begin(), meta_uris.end());
   to_vacuum.reserve(uris.size());
   for (const auto& uri : uris) {
     if (utils::parse::ends_with(uri.to_string(), constants::meta_file_suffix) &&
-        uri != last)
+        to_keep.count(uri) == 0)
       to_vacuum.emplace_back(uri);
   }
 
   // Vacuum after exclusively locking the array
-  auto status =
-      parallel_for(compute_tp_, 0, to_vacuum.size(), [&, this](size_t i) {
-        RETURN_NOT_OK(vfs_->remove_file(to_vacuum[i]));
-        return Status::Ok();
-      });
-  RETURN_NOT_OK(status);
+  RETURN_NOT_OK(vfs_->remove_files(to_vacuum));
 
   return Status::Ok();
 }
@@ -527,20 +644,10 @@ Status StorageManager::array_vacuum_array_meta(
       uris, timestamp_start, timestamp_end, &to_vacuum, &vac_uris));
 
   // Delete the array metadata files
-  auto status =
-      parallel_for(compute_tp_, 0, to_vacuum.size(), [&, this](size_t i) {
-        RETURN_NOT_OK(vfs_->remove_file(to_vacuum[i]));
-
-        return Status::Ok();
-      });
-  RETURN_NOT_OK(status);
+  RETURN_NOT_OK(vfs_->remove_files(to_vacuum));
 
   // Delete vacuum files
-  status = parallel_for(compute_tp_, 0, vac_uris.size(), [&, this](size_t i) {
-    RETURN_NOT_OK(vfs_->remove_file(vac_uris[i]));
-    return Status::Ok();
-  });
-  RETURN_NOT_OK(status);
+  RETURN_NOT_OK(vfs_->remove_files(vac_uris));
 
   return Status::Ok();
 }
@@ -605,7 +712,13 @@ Status StorageManager::array_metadata_consolidate(
     }
   }
 
-  // Consolidate
+  // Consolidate at the configured thread pool priority
+  ThreadPool::Priority priority;
+  bool found = false;
+  RETURN_NOT_OK(ThreadPool::priority_enum(
+      config->get("sm.consolidation.priority", &found), &priority));
+  assert(found);
+  ThreadPool::ScopedPriority scoped_priority(priority);
   Consolidator consolidator(this);
   return consolidator.consolidate_array_meta(
       array_name, encryption_type, encryption_key, key_length);
@@ -729,6 +842,7 @@ Status StorageManager::array_evolve_schema(
       schema_evolution->evolve_schema(array_schema, &array_schema_evolved));
 
   Status st = store_array_schema(array_schema_evolved, encryption_key);
+  invalidate_listing_cache(array_uri);
   if (!st.ok()) {
     tdb_delete(array_schema_evolved);
     logger_->status(st);
@@ -1122,23 +1236,155 @@ Status StorageManager::array_get_encryption(
 }
 
 Status StorageManager::async_push_query(Query* query) {
+  bool found = false;
+  std::string tag = query->config()->get("sm.async_query.tag", &found);
+  assert(found);
+
+  // Queue the query, then admit the next one if there is a free slot. It
+  // may be a query of another tag.
+  PendingAsyncQuery pending;
+  {
+    std::unique_lock<std::mutex> lck(async_mtx_);
+    async_queue_[tag].push_back({query, std::chrono::steady_clock::now()});
+    if (async_max_concurrent_ != 0 && async_running_ >= async_max_concurrent_)
+      return Status::Ok();
+    async_pop_query(&pending);
+    ++async_running_;
+  }
+
+  // The admitted query runs outside of the lock, as the pool may execute it
+  // inline.
+  async_run_queries(pending);
+
+  return Status::Ok();
+}
+
+Status StorageManager::auto_consolidate(Array* array) {
+  if (auto_consolidation_fragment_num_ == 0 || array->is_remote())
+    return Status::Ok();
+
+  const auto array_uri = array->array_uri();
+  const auto key = array_uri.to_string();
+  {
+    std::unique_lock<std::mutex> lck(auto_consolidation_mtx_);
+    if (auto_consolidation_active_.count(key) > 0)
+      return Status::Ok();
+    auto it = auto_consolidation_last_.find(key);
+    if (it != auto_consolidation_last_.end() &&
+        std::chrono::steady_clock::now() - it->second <
+            auto_consolidation_interval_)
+      return Status::Ok();
+  }
+
+  std::vector<URI> fragment_uris, meta_uris;
+  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris, &meta_uris));
+  if (fragment_uris.size() < auto_consolidation_fragment_num_)
+    return Status::Ok();
+
+  {
+    std::unique_lock<std::mutex> lck(auto_consolidation_mtx_);
+    if (!auto_consolidation_active_.insert(key).second)
+      return Status::Ok();
+    stats_->set_max_counter(
+        "auto_consolidation_backlog", ++auto_consolidation_backlog_);
+  }
+
+  // The task keeps its own copy of the encryption key
+  auto enc_type = array->encryption_key()->encryption_type();
+  auto enc_key_buf = array->encryption_key()->key();
+  std::string enc_key(
+      static_cast<const char*>(enc_key_buf.data()), enc_key_buf.size());
+
+  // Queue the task in the background lane
+  ThreadPool::ScopedPriority scoped_priority(
+      ThreadPool::Priority::BACKGROUND);
   cancelable_tasks_.execute(
       compute_tp_,
-      [this, query]() {
-        // Process query.
-        Status st = query_submit(query);
+      [this, key, enc_type, enc_key]() {
+        {
+          std::unique_lock<std::mutex> lck(auto_consolidation_mtx_);
+          --auto_consolidation_backlog_;
+          auto_consolidation_last_[key] = std::chrono::steady_clock::now();
+        }
+        stats_->add_counter("auto_consolidation_num", 1);
+
+        auto st = array_consolidate(
+            key.c_str(),
+            enc_type,
+            enc_key.empty() ? nullptr : enc_key.data(),
+            static_cast<uint32_t>(enc_key.size()),
+            &config_);
+        if (st.ok())
+          st = array_vacuum(key.c_str(), &config_);
         if (!st.ok())
           logger_->status(st);
+
+        std::unique_lock<std::mutex> lck(auto_consolidation_mtx_);
+        auto_consolidation_active_.erase(key);
+        return st;
+      },
+      [this, key]() {
+        std::unique_lock<std::mutex> lck(auto_consolidation_mtx_);
+        --auto_consolidation_backlog_;
+        auto_consolidation_active_.erase(key);
+      });
+
+  return Status::Ok();
+}
+
+bool StorageManager::async_pop_query(PendingAsyncQuery* pending) {
+  if (async_queue_.empty())
+    return false;
+
+  // Serve the tag following the last served one, wrapping around.
+  auto it = async_queue_.upper_bound(async_last_tag_);
+  if (it == async_queue_.end())
+    it = async_queue_.begin();
+  async_last_tag_ = it->first;
+  *pending = it->second.front();
+  it->second.pop_front();
+  if (it->second.empty())
+    async_queue_.erase(it);
+
+  return true;
+}
+
+void StorageManager::async_run_queries(const PendingAsyncQuery& first) {
+  cancelable_tasks_.execute(
+      compute_tp_,
+      [this, first]() {
+        // Process the admitted query, then the queued ones as long as there
+        // are any, keeping the slot of the first one.
+        PendingAsyncQuery pending = first;
+        Status st;
+        while (true) {
+          const std::chrono::duration<double> wait =
+              std::chrono::steady_clock::now() - pending.submitted_;
+          pending.query_->stats()->add_duration(
+              "async_queue_wait", wait.count());
+
+          // Process query.
+          st = query_submit(pending.query_);
+          if (!st.ok())
+            logger_->status(st);
+
+          std::unique_lock<std::mutex> lck(async_mtx_);
+          if (!async_pop_query(&pending)) {
+            --async_running_;
+            break;
+          }
+        }
         return st;
       },
-      [query]() {
+      [this, first]() {
         // Task was cancelled. This is safe to perform in a separate thread,
         // as we are guaranteed by the thread pool not to have entered
         // query->process() yet.
-        query->cancel();
-      });
+        first.query_->cancel();
 
-  return Status::Ok();
+        std::unique_lock<std::mutex> lck(async_mtx_);
+        --async_running_;
+      });
 }
 
 Status StorageManager::cancel_all_tasks() {
@@ -1154,6 +1400,17 @@ Status StorageManager::cancel_all_tasks() {
 
   // Handle the cancellation.
   if (handle_cancel) {
+    // Cancel the async queries waiting for admission.
+    std::map<std::string, std::deque<PendingAsyncQuery>> async_queue;
+    {
+      std::unique_lock<std::mutex> lck(async_mtx_);
+      async_queue.swap(async_queue_);
+    }
+    for (auto& tag_queue : async_queue) {
+      for (auto& pending : tag_queue.second)
+        pending.query_->cancel();
+    }
+
     // Cancel any queued tasks.
     cancelable_tasks_.cancel_all_tasks();
 
@@ -1193,12 +1450,59 @@ Status StorageManager::touch(const URI& uri) {
   return vfs_->touch(uri);
 }
 
+Status StorageManager::start_packed_fragment(const URI& uri) {
+  std::lock_guard<std::mutex> lock(packed_fragments_mtx_);
+  auto& packed = packed_fragments_[uri.remove_trailing_slash().to_string()];
+  if (packed == nullptr) {
+    packed = tdb_unique_ptr<PackedFragment>(tdb_new(PackedFragment));
+    ++packed_fragment_num_;
+  }
+
+  return Status::Ok();
+}
+
+Status StorageManager::store_packed_fragment(const URI& uri) {
+  tdb_unique_ptr<PackedFragment> packed;
+  {
+    std::lock_guard<std::mutex> lock(packed_fragments_mtx_);
+    auto it = packed_fragments_.find(uri.remove_trailing_slash().to_string());
+    if (it == packed_fragments_.end())
+      return logger_->status(Status_StorageManagerError(
+          "Cannot store packed fragment '" + uri.to_string() +
+          "'; The fragment was not started"));
+    packed = std::move(it->second);
+    packed_fragments_.erase(it);
+    --packed_fragment_num_;
+  }
+
+  Buffer buff;
+  RETURN_NOT_OK(packed->serialize(&buff));
+  RETURN_NOT_OK(vfs_->write(uri, buff.data(), buff.size()));
+  RETURN_NOT_OK(vfs_->close_file(uri));
+  stats_->add_counter("write_packed_fragment_num", 1);
+  stats_->add_counter("write_packed_fragment_size", buff.size());
+
+  return Status::Ok();
+}
+
+void StorageManager::discard_packed_fragment(const URI& uri) {
+  std::lock_guard<std::mutex> lock(packed_fragments_mtx_);
+  if (packed_fragments_.erase(uri.remove_trailing_slash().to_string()) > 0)
+    --packed_fragment_num_;
+}
+
 void StorageManager::decrement_in_progress() {
   std::unique_lock<std::mutex> lck(queries_in_progress_mtx_);
   queries_in_progress_--;
   queries_in_progress_cv_.notify_all();
 }
 
+std::string StorageManager::tile_cache_key(const URI& uri, uint64_t offset) {
+  std::string key = uri.to_string();
+  key.append(reinterpret_cast<const char*>(&offset), sizeof(offset));
+  return key;
+}
+
 Status StorageManager::object_remove(const char* path) const {
   auto uri = URI(path);
   if (uri.is_invalid())
@@ -1212,6 +1516,12 @@ Status StorageManager::object_remove(const char* path) const {
         std::string("Cannot remove object '") + path +
         "'; Invalid TileDB object"));
 
+  invalidate_listing_cache(uri);
+
+  // Legacy schema files are not uniquely named, drop them with the array
+  if (array_schema_cache_ != nullptr)
+    array_schema_cache_->clear();
+
   return vfs_->remove_dir(uri);
 }
 
@@ -1234,17 +1544,30 @@ Status StorageManager::object_move(
         std::string("Cannot move object '") + old_path +
         "'; Invalid TileDB object"));
 
+  invalidate_listing_cache(old_uri);
+  invalidate_listing_cache(new_uri);
+
+  // Legacy schema files are not uniquely named, drop them with the array
+  if (array_schema_cache_ != nullptr)
+    array_schema_cache_->clear();
+
   return vfs_->move_dir(old_uri, new_uri);
 }
 
 Status StorageManager::get_fragment_uris(
     const URI& array_uri,
     std::vector<URI>* fragment_uris,
-    URI* meta_uri) const {
+    std::vector<URI>* meta_uris) const {
   auto timer_se = stats_->start_timer("read_get_fragment_uris");
   // Get all uris in the array directory
   std::vector<URI> uris;
-  RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
+  const URI array_dir_uri = array_uri.add_trailing_slash();
+  if (!cached_listing(array_dir_uri, &uris)) {
+    std::vector<std::string> split_names;
+    RETURN_NOT_OK(get_fragment_listing_splits(array_uri, &split_names));
+    RETURN_NOT_OK(vfs_->ls_sharded(array_dir_uri, split_names, &uris));
+    cache_listing(array_dir_uri, uris);
+  }
 
   // Get the fragments that have special "ok" URIs, which indicate
   // that fragments are "committed" for versions >= 5
@@ -1275,8 +1598,8 @@ Status StorageManager::get_fragment_uris(
       fragment_uris->emplace_back(uris[i]);
   }
 
-  // Get the latest consolidated fragment metadata URI
-  RETURN_NOT_OK(get_consolidated_fragment_meta_uri(uris, meta_uri));
+  // Get the latest consolidated fragment metadata URIs
+  RETURN_NOT_OK(get_consolidated_fragment_meta_uris(uris, meta_uris));
 
   return Status::Ok();
 }
@@ -1409,16 +1732,160 @@ Status StorageManager::init(const Config* config) {
       config_.get<uint64_t>("sm.tile_cache_size", &tile_cache_size, &found));
   assert(found);
 
-  tile_cache_ =
-      tdb_unique_ptr<BufferLRUCache>(tdb_new(BufferLRUCache, tile_cache_size));
+  uint64_t tile_cache_shard_num = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.tile_cache_shard_num", &tile_cache_shard_num, &found));
+  assert(found);
+
+  std::string tile_cache_policy_str =
+      config_.get("sm.tile_cache_policy", &found);
+  assert(found);
+  CachePolicy tile_cache_policy = CachePolicy::LRU;
+  RETURN_NOT_OK(cache_policy_enum(tile_cache_policy_str, &tile_cache_policy));
+
+  tile_cache_ = tdb_unique_ptr<ShardedBufferLRUCache>(tdb_new(
+      ShardedBufferLRUCache,
+      tile_cache_size,
+      tile_cache_shard_num,
+      tile_cache_policy));
+
+  std::string tile_cache_shared_memory_name =
+      config_.get("sm.tile_cache_shared_memory_name", &found);
+  assert(found);
+  if (!tile_cache_shared_memory_name.empty()) {
+    shared_tile_cache_ = tdb_unique_ptr<SharedMemoryTileCache>(
+        tdb_new(SharedMemoryTileCache));
+    RETURN_NOT_OK(shared_tile_cache_->init(
+        tile_cache_shared_memory_name, tile_cache_size));
+  }
+
+  uint64_t unfiltered_tile_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.tile_cache_unfiltered_size", &unfiltered_tile_cache_size, &found));
+  assert(found);
+  if (unfiltered_tile_cache_size > 0)
+    unfiltered_tile_cache_ = tdb_unique_ptr<ShardedBufferLRUCache>(tdb_new(
+        ShardedBufferLRUCache,
+        unfiltered_tile_cache_size,
+        tile_cache_shard_num,
+        tile_cache_policy));
+
+  bool governor_enabled = false;
+  RETURN_NOT_OK(config_.get<bool>(
+      "sm.mem.governor.enabled", &governor_enabled, &found));
+  assert(found);
+  if (governor_enabled) {
+    uint64_t total_budget = 0;
+    RETURN_NOT_OK(
+        config_.get<uint64_t>("sm.mem.total_budget", &total_budget, &found));
+    assert(found);
+    governor_ = tdb_unique_ptr<Governor>(tdb_new(Governor, total_budget));
+
+    // The tile caches count against the budget and are shed first.
+    for (auto cache : {tile_cache_.get(), unfiltered_tile_cache_.get()}) {
+      if (cache == nullptr)
+        continue;
+      governor_->add_reclaimer(
+          [cache]() { return cache->size(); },
+          [cache](uint64_t nbytes) { cache->shed(nbytes); });
+    }
+  }
+
+  uint64_t tile_buffer_pool_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.mem.tile_buffer_pool_size", &tile_buffer_pool_size, &found));
+  assert(found);
+  if (tile_buffer_pool_size > 0)
+    tile_buffer_pool_ = tdb_unique_ptr<TileBufferPool>(
+        tdb_new(TileBufferPool, tile_buffer_pool_size, true));
+
+  bool shared_scan = false;
+  RETURN_NOT_OK(
+      config_.get<bool>("sm.query.shared_scan", &shared_scan, &found));
+  assert(found);
+  if (shared_scan)
+    inflight_tile_reads_ =
+        tdb_unique_ptr<InflightTileReads>(tdb_new(InflightTileReads));
+
+  std::string huge_pages_str =
+      config_.get("sm.mem.large_buffer.huge_pages", &found);
+  assert(found);
+  HugePageMode huge_page_mode = HugePageMode::NONE;
+  RETURN_NOT_OK(huge_page_mode_enum(huge_pages_str, &huge_page_mode));
+  bool numa_local = false;
+  RETURN_NOT_OK(config_.get<bool>(
+      "sm.mem.large_buffer.numa_local", &numa_local, &found));
+  assert(found);
+  uint64_t large_buffer_threshold = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.mem.large_buffer.threshold", &large_buffer_threshold, &found));
+  assert(found);
+  if (huge_page_mode != HugePageMode::NONE || numa_local)
+    large_buffer_allocator_ = tdb_unique_ptr<LargeBufferAllocator>(tdb_new(
+        LargeBufferAllocator,
+        large_buffer_threshold,
+        huge_page_mode,
+        numa_local));
+
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.async_query.max_concurrent", &async_max_concurrent_, &found));
+  assert(found);
+
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.consolidation.auto.fragment_num",
+      &auto_consolidation_fragment_num_,
+      &found));
+  assert(found);
+  uint64_t auto_consolidation_interval_ms = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.consolidation.auto.min_interval_ms",
+      &auto_consolidation_interval_ms,
+      &found));
+  assert(found);
+  auto_consolidation_interval_ =
+      std::chrono::milliseconds(auto_consolidation_interval_ms);
+
+  uint64_t fragment_metadata_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.fragment_metadata_cache_size",
+      &fragment_metadata_cache_size,
+      &found));
+  assert(found);
+  if (fragment_metadata_cache_size > 0)
+    fragment_metadata_cache_ = tdb_unique_ptr<FragmentMetadataLRUCache>(
+        tdb_new(FragmentMetadataLRUCache, fragment_metadata_cache_size));
+
+  uint64_t array_schema_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.array_schema_cache_size", &array_schema_cache_size, &found));
+  assert(found);
+  if (array_schema_cache_size > 0)
+    array_schema_cache_ = tdb_unique_ptr<ArraySchemaLRUCache>(
+        tdb_new(ArraySchemaLRUCache, array_schema_cache_size));
+
+  uint64_t array_snapshot_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.array_snapshot_cache_size", &array_snapshot_cache_size, &found));
+  assert(found);
+  if (array_snapshot_cache_size > 0)
+    array_snapshot_cache_ = tdb_unique_ptr<ArraySnapshotLRUCache>(
+        tdb_new(ArraySnapshotLRUCache, array_snapshot_cache_size));
 
   // GlobalState must be initialized before `vfs->init` because S3::init calls
   // GetGlobalState
   auto& global_state = global_state::GlobalState::GetGlobalState();
-  RETURN_NOT_OK(global_state.init(config));
+  {
+    auto timer_se = stats_->start_timer("init_global_state");
+    RETURN_NOT_OK(global_state.init(config));
+  }
 
+  // The backends of the VFS are initialized on the first use of their URI
+  // scheme, which is timed as their "init_client".
   vfs_ = tdb_new(VFS);
-  RETURN_NOT_OK(vfs_->init(stats_, compute_tp_, io_tp_, &config_, nullptr));
+  {
+    auto timer_se = stats_->start_timer("init_vfs");
+    RETURN_NOT_OK(vfs_->init(stats_, compute_tp_, io_tp_, &config_, nullptr));
+  }
 #ifdef TILEDB_SERIALIZATION
   RETURN_NOT_OK(init_rest_client());
 #endif
@@ -1472,9 +1939,17 @@ Status StorageManager::is_file(const URI& uri, bool* is_file) const {
 
 Status StorageManager::is_fragment(
     const URI& uri, const std::set<URI>& ok_uris, int* is_fragment) const {
-  // If the URI name has a suffix, then it is not a fragment
+  // A packed fragment is committed by writing its single object
   auto name = uri.remove_trailing_slash().last_path_part();
-  if (name.find_first_of('.') != std::string::npos) {
+  if (utils::parse::ends_with(name, constants::packed_fragment_suffix)) {
+    *is_fragment = 1;
+    return Status::Ok();
+  }
+
+  // If the URI name has any other suffix, then it is not a fragment. A
+  // fragment written in parts is committed with an ok file as usual.
+  if (name.find_first_of('.') != std::string::npos &&
+      !utils::parse::ends_with(name, constants::fragment_parts_suffix)) {
     *is_fragment = 0;
     return Status::Ok();
   }
@@ -1520,7 +1995,13 @@ Status StorageManager::get_array_schema_uris(
     const URI& array_uri, std::vector<URI>* schema_uris) const {
   auto timer_se = stats_->start_timer("read_get_array_schema_uris");
 
+  // The cached schema URIs include the old schema file, if any.
   schema_uris->clear();
+  URI schema_folder_uri =
+      array_uri.join_path(constants::array_schema_folder_name);
+  if (cached_listing(schema_folder_uri, schema_uris))
+    return Status::Ok();
+
   URI old_schema_uri = array_uri.join_path(constants::array_schema_filename);
   bool has_file = false;
   RETURN_NOT_OK(vfs_->is_file(old_schema_uri, &has_file));
@@ -1528,8 +2009,6 @@ Status StorageManager::get_array_schema_uris(
     schema_uris->push_back(old_schema_uri);
   }
 
-  URI schema_folder_uri =
-      array_uri.join_path(constants::array_schema_folder_name);
   // Check if schema_folder_uri exists. For some file systems, such as win, ls
   // will return error if the folder does not exist.
   bool has_dir = false;
@@ -1552,9 +2031,118 @@ Status StorageManager::get_array_schema_uris(
         "Cannot get the array schemas; No array schemas found."));
   }
 
+  cache_listing(schema_folder_uri, *schema_uris);
+
   return Status::Ok();
 }
 
+Status StorageManager::get_fragment_listing_splits(
+    const URI& array_uri, std::vector<std::string>* split_names) const {
+  split_names->clear();
+
+  // Only object stores listing in pages benefit from concurrent listings.
+  if (!array_uri.is_s3())
+    return Status::Ok();
+
+  bool found = false;
+  uint64_t shards = 1;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.fragment_listing_shards", &shards, &found));
+  assert(found);
+  if (shards <= 1)
+    return Status::Ok();
+
+  // The array was created with its first schema. Schema names start with
+  // their timestamp like fragment names; the old schema file has none.
+  std::vector<URI> schema_uris;
+  RETURN_NOT_OK(get_array_schema_uris(array_uri, &schema_uris));
+  uint64_t created = std::numeric_limits<uint64_t>::max();
+  for (const auto& uri : schema_uris) {
+    auto name = uri.last_path_part();
+    if (!utils::parse::starts_with(name, "__"))
+      continue;
+    auto digits = name.substr(2, name.find('_', 2) - 2);
+    if (!digits.empty() && digits.size() < 20 &&
+        utils::parse::is_uint(digits))
+      created = std::min<uint64_t>(created, std::stoull(digits));
+  }
+
+  // The timestamps must have as many digits for the fragment names to sort
+  // by timestamp.
+  const uint64_t now = utils::time::timestamp_now_ms();
+  if (created >= now ||
+      std::to_string(created).size() != std::to_string(now).size())
+    return Status::Ok();
+
+  for (uint64_t i = 1; i < shards; i++) {
+    const uint64_t timestamp = created + (now - created) / shards * i;
+    split_names->emplace_back("__" + std::to_string(timestamp));
+  }
+
+  return Status::Ok();
+}
+
+bool StorageManager::cached_listing(
+    const URI& uri, std::vector<URI>* uris) const {
+  bool found = false;
+  uint64_t ttl_ms = 0;
+  if (!config_.get<uint64_t>("sm.listing_cache_ttl_ms", &ttl_ms, &found)
+           .ok() ||
+      ttl_ms == 0)
+    return false;
+
+  std::lock_guard<std::mutex> lock(listing_cache_mtx_);
+  auto it = listing_cache_.find(uri.to_string());
+  if (it == listing_cache_.end())
+    return false;
+  if (std::chrono::steady_clock::now() - it->second.time_ >
+      std::chrono::milliseconds(ttl_ms)) {
+    listing_cache_.erase(it);
+    return false;
+  }
+
+  *uris = it->second.uris_;
+  stats_->add_counter("listing_cache_hit_num", 1);
+  return true;
+}
+
+void StorageManager::cache_listing(
+    const URI& uri, const std::vector<URI>& uris) const {
+  bool found = false;
+  uint64_t ttl_ms = 0;
+  if (!config_.get<uint64_t>("sm.listing_cache_ttl_ms", &ttl_ms, &found)
+           .ok() ||
+      ttl_ms == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(listing_cache_mtx_);
+  listing_cache_[uri.to_string()] = {std::chrono::steady_clock::now(), uris};
+}
+
+PackedFragment* StorageManager::packed_fragment(const URI& file_uri) const {
+  if (packed_fragment_num_ == 0)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(packed_fragments_mtx_);
+  auto it = packed_fragments_.find(
+      file_uri.parent().remove_trailing_slash().to_string());
+  return it == packed_fragments_.end() ? nullptr : it->second.get();
+}
+
+void StorageManager::invalidate_listing_cache(const URI& uri) const {
+  if (array_snapshot_cache_ != nullptr)
+    array_snapshot_cache_->invalidate(uri);
+
+  const std::string prefix = uri.remove_trailing_slash().to_string();
+  std::lock_guard<std::mutex> lock(listing_cache_mtx_);
+  for (auto it = listing_cache_.begin(); it != listing_cache_.end();) {
+    if (utils::parse::starts_with(it->first, prefix))
+      it = listing_cache_.erase(it);
+    else
+      ++it;
+  }
+}
+
 Status StorageManager::get_latest_array_schema_uri(
     const URI& array_uri, URI* uri) const {
   auto timer_se = stats_->start_timer("read_get_latest_array_schema_uri");
@@ -1581,9 +2169,11 @@ Status StorageManager::load_array_schema_from_uri(
   auto timer_se = stats_->start_timer("read_load_array_schema_from_uri");
 
   GenericTileIO tile_io(this, schema_uri);
-  Tile* tile = nullptr;
+  Buffer buff;
 
   // Get encryption key from config
+  const EncryptionKey* read_key = &encryption_key;
+  EncryptionKey encryption_key_cfg;
   if (encryption_key.encryption_type() == EncryptionType::NO_ENCRYPTION) {
     bool found = false;
     std::string encryption_key_from_cfg =
@@ -1596,7 +2186,6 @@ Status StorageManager::load_array_schema_from_uri(
     RETURN_NOT_OK(st);
     EncryptionType encryption_type_cfg = etc.value();
 
-    EncryptionKey encryption_key_cfg;
     if (encryption_key_from_cfg.empty()) {
       RETURN_NOT_OK(
           encryption_key_cfg.set_key(encryption_type_cfg, nullptr, 0));
@@ -1617,16 +2206,23 @@ Status StorageManager::load_array_schema_from_uri(
           (const void*)encryption_key_from_cfg.c_str(),
           key_length));
     }
-    RETURN_NOT_OK(tile_io.read_generic(&tile, 0, encryption_key_cfg, config_));
-  } else {
-    RETURN_NOT_OK(tile_io.read_generic(&tile, 0, encryption_key, config_));
+    read_key = &encryption_key_cfg;
   }
 
-  Buffer buff;
-  buff.realloc(tile->size());
-  buff.set_size(tile->size());
-  RETURN_NOT_OK_ELSE(tile->read(buff.data(), 0, buff.size()), tdb_delete(tile));
-  tdb_delete(tile);
+  // Copy the schema if it was already loaded
+  std::string cache_key;
+  if (array_schema_cache_ != nullptr) {
+    cache_key = ArraySchemaLRUCache::key(schema_uri, *read_key);
+    bool in_cache = false;
+    RETURN_NOT_OK(
+        array_schema_cache_->read(cache_key, array_schema, &in_cache));
+    if (in_cache) {
+      stats_->add_counter("array_schema_cache_hit_num", 1);
+      return Status::Ok();
+    }
+  }
+
+  RETURN_NOT_OK(tile_io.read_generic(&buff, 0, *read_key, config_));
 
   stats_->add_counter("read_array_schema_size", buff.size());
 
@@ -1640,6 +2236,11 @@ Status StorageManager::load_array_schema_from_uri(
     return st;
   }
   (*array_schema)->set_uri(schema_uri);
+
+  if (array_schema_cache_ != nullptr)
+    RETURN_NOT_OK(
+        array_schema_cache_->insert(cache_key, *array_schema, buff.size()));
+
   return st;
 }
 
@@ -1737,6 +2338,22 @@ Status StorageManager::load_array_metadata(
   if (metadata == nullptr)
     return Status::Ok();
 
+  // Copy the metadata of the snapshot of the array at these timestamps
+  tdb_shared_ptr<ArraySnapshot> snapshot;
+  if (array_snapshot_cache_ != nullptr) {
+    snapshot = array_snapshot_cache_->get(ArraySnapshotLRUCache::key(
+        array_uri, timestamp_start, timestamp_end, encryption_key));
+    if (snapshot != nullptr) {
+      std::lock_guard<std::mutex> lock(snapshot->mtx_);
+      if (snapshot->metadata_ != nullptr) {
+        stats_->add_counter("array_snapshot_meta_hit_num", 1);
+        Metadata copy(*snapshot->metadata_);
+        metadata->swap(&copy);
+        return Status::Ok();
+      }
+    }
+  }
+
   // Determine which array metadata to load
   std::vector<TimestampedURI> array_metadata_to_load;
   std::vector<URI> array_metadata_uris;
@@ -1753,15 +2370,9 @@ Status StorageManager::load_array_metadata(
   auto status = parallel_for(compute_tp_, 0, metadata_num, [&](size_t m) {
     const auto& uri = array_metadata_to_load[m].uri_;
     GenericTileIO tile_io(this, uri);
-    auto tile = (Tile*)nullptr;
-    RETURN_NOT_OK(tile_io.read_generic(&tile, 0, encryption_key, config_));
     auto metadata_buff = tdb::make_shared<Buffer>(HERE());
-    RETURN_NOT_OK(metadata_buff->realloc(tile->size()));
-    metadata_buff->set_size(tile->size());
-    RETURN_NOT_OK_ELSE(
-        tile->read(metadata_buff->data(), 0, metadata_buff->size()),
-        tdb_delete(tile));
-    tdb_delete(tile);
+    RETURN_NOT_OK(tile_io.read_generic(
+        metadata_buff.get(), 0, encryption_key, config_));
 
     metadata_buffs[m] = metadata_buff;
 
@@ -1781,6 +2392,11 @@ Status StorageManager::load_array_metadata(
   // Sets the loaded metadata URIs
   metadata->set_loaded_metadata_uris(array_metadata_to_load);
 
+  if (snapshot != nullptr) {
+    std::lock_guard<std::mutex> lock(snapshot->mtx_);
+    snapshot->metadata_ = tdb::make_shared<Metadata>(HERE(), *metadata);
+  }
+
   return Status::Ok();
 }
 
@@ -2003,10 +2619,68 @@ Status StorageManager::read_from_cache(
     FilteredBuffer& buffer,
     uint64_t nbytes,
     bool* in_cache) const {
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
   buffer.expand(nbytes);
-  RETURN_NOT_OK(tile_cache_->read(key.str(), buffer, 0, nbytes, in_cache));
+  if (shared_tile_cache_ != nullptr) {
+    RETURN_NOT_OK(shared_tile_cache_->read(
+        tile_cache_key(uri, offset), buffer.data(), nbytes, in_cache));
+  } else {
+    RETURN_NOT_OK(tile_cache_->read(
+        tile_cache_key(uri, offset), buffer.data(), 0, nbytes, in_cache));
+  }
+  stats_->add_counter(
+      *in_cache ? "tile_cache_hit_num" : "tile_cache_miss_num", 1);
+
+  return Status::Ok();
+}
+
+bool StorageManager::unfiltered_tile_cache_enabled() const {
+  return unfiltered_tile_cache_ != nullptr;
+}
+
+uint64_t StorageManager::tile_cache_size() const {
+  uint64_t size = tile_cache_->size();
+  if (unfiltered_tile_cache_ != nullptr)
+    size += unfiltered_tile_cache_->size();
+  return size;
+}
+
+TileBufferPool* StorageManager::tile_buffer_pool() const {
+  return tile_buffer_pool_.get();
+}
+
+void StorageManager::trim_tile_buffer_pool() {
+  if (tile_buffer_pool_ != nullptr)
+    tile_buffer_pool_->trim();
+}
+
+InflightTileReads* StorageManager::inflight_tile_reads() const {
+  return inflight_tile_reads_.get();
+}
+
+const LargeBufferAllocator* StorageManager::large_buffer_allocator() const {
+  return large_buffer_allocator_.get();
+}
+
+Governor* StorageManager::governor() const {
+  return governor_.get();
+}
+
+Status StorageManager::read_unfiltered_from_cache(
+    const URI& uri,
+    uint64_t offset,
+    void* data,
+    uint64_t nbytes,
+    bool* in_cache) const {
+  *in_cache = false;
+  if (unfiltered_tile_cache_ == nullptr)
+    return Status::Ok();
+
+  RETURN_NOT_OK(unfiltered_tile_cache_->read(
+      tile_cache_key(uri, offset), data, 0, nbytes, in_cache));
+  stats_->add_counter(
+      *in_cache ? "unfiltered_tile_cache_hit_num" :
+                  "unfiltered_tile_cache_miss_num",
+      1);
 
   return Status::Ok();
 }
@@ -2129,6 +2803,10 @@ Status StorageManager::store_array_metadata(
 }
 
 Status StorageManager::close_file(const URI& uri) {
+  // The files of a packed fragment are written with the fragment
+  if (packed_fragment(uri) != nullptr)
+    return Status::Ok();
+
   return vfs_->close_file(uri);
 }
 
@@ -2151,7 +2829,7 @@ Status StorageManager::init_rest_client() {
   RETURN_NOT_OK(config_.get("rest.server_address", &server_address));
   if (server_address != nullptr) {
     rest_client_.reset(tdb_new(RestClient));
-    RETURN_NOT_OK(rest_client_->init(stats_, &config_, compute_tp_));
+    RETURN_NOT_OK(rest_client_->init(stats_, &config_, compute_tp_, io_tp_));
   }
 
   return Status::Ok();
@@ -2169,23 +2847,61 @@ Status StorageManager::write_to_cache(
     return Status::Ok();
   }
 
-  // Generate key (uri + offset)
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
+  // Insert to the shared cache, which copies the buffer
+  if (shared_tile_cache_ != nullptr)
+    return shared_tile_cache_->insert(
+        tile_cache_key(uri, offset), buffer.data(), buffer.size());
 
   // Insert to cache
   FilteredBuffer cached_buffer(buffer);
-  RETURN_NOT_OK(
-      tile_cache_->insert(key.str(), std::move(cached_buffer), false));
+  uint64_t evicted_num = 0;
+  bool admitted = false;
+  RETURN_NOT_OK(tile_cache_->insert(
+      tile_cache_key(uri, offset),
+      std::move(cached_buffer),
+      false,
+      &evicted_num,
+      &admitted));
+  stats_->add_counter("tile_cache_eviction_num", evicted_num);
+  if (!admitted)
+    stats_->add_counter("tile_cache_rejection_num", 1);
+
+  return Status::Ok();
+}
+
+Status StorageManager::write_unfiltered_to_cache(
+    const URI& uri, uint64_t offset, const void* data, uint64_t nbytes) const {
+  if (unfiltered_tile_cache_ == nullptr)
+    return Status::Ok();
+
+  FilteredBuffer cached_buffer(nbytes);
+  memcpy(cached_buffer.data(), data, nbytes);
+  uint64_t evicted_num = 0;
+  bool admitted = false;
+  RETURN_NOT_OK(unfiltered_tile_cache_->insert(
+      tile_cache_key(uri, offset),
+      std::move(cached_buffer),
+      false,
+      &evicted_num,
+      &admitted));
+  stats_->add_counter("unfiltered_tile_cache_eviction_num", evicted_num);
+  if (!admitted)
+    stats_->add_counter("unfiltered_tile_cache_rejection_num", 1);
 
   return Status::Ok();
 }
 
 Status StorageManager::write(const URI& uri, Buffer* buffer) const {
-  return vfs_->write(uri, buffer->data(), buffer->size());
+  return write(uri, buffer->data(), buffer->size());
 }
 
 Status StorageManager::write(const URI& uri, void* data, uint64_t size) const {
+  auto packed = packed_fragment(uri);
+  if (packed != nullptr) {
+    packed->append(uri.last_path_part(), data, size);
+    return Status::Ok();
+  }
+
   return vfs_->write(uri, data, size);
 }
 
@@ -2237,15 +2953,86 @@ StorageManager::load_fragment_metadata(
     const EncryptionKey& encryption_key,
     const std::vector<TimestampedURI>& fragments_to_load,
     Buffer* meta_buff,
-    const std::unordered_map<std::string, uint64_t>& offsets) {
+    const std::unordered_map<std::string, uint64_t>& offsets,
+    const NDRange* subarray) {
   auto timer_se = stats_->start_timer("load_fragment_metadata");
 
-  // Load the metadata for each fragment
+  // Read the sizes and the ends of the metadata files of all the fragments
+  // up front, concurrently on the io thread pool. The footers are then
+  // parsed from these tails, without a separate read of their size and
+  // contents per fragment.
   auto fragment_num = fragments_to_load.size();
+  std::vector<uint64_t> meta_file_sizes(fragment_num, 0);
+  std::vector<Buffer> file_tails(fragment_num);
+
+  // Reuse the metadata of the fragments already loaded by other arrays
   std::vector<tdb_shared_ptr<FragmentMetadata>> fragment_metadata;
   fragment_metadata.resize(fragment_num);
-  auto status = parallel_for(compute_tp_, 0, fragment_num, [&](size_t f) {
+  std::vector<std::string> cache_keys;
+  if (fragment_metadata_cache_ != nullptr) {
+    cache_keys.resize(fragment_num);
+    for (size_t f = 0; f < fragment_num; ++f) {
+      cache_keys[f] = FragmentMetadataLRUCache::key(
+          fragments_to_load[f].uri_, encryption_key);
+      fragment_metadata[f] = fragment_metadata_cache_->get(cache_keys[f]);
+      if (fragment_metadata[f] != nullptr)
+        stats_->add_counter("frag_meta_cache_hit_num", 1);
+    }
+  }
+
+  auto status = parallel_for(io_tp_, 0, fragment_num, [&](size_t f) {
+    const auto& sf = fragments_to_load[f];
+    if (fragment_metadata[f] != nullptr)
+      return Status::Ok();
+
+    // Skip fragments whose footer is in the consolidated metadata, and the
+    // oldest fragments which have no footer. The tail of a packed fragment
+    // holds the index of its files, which is always needed.
+    auto name = sf.uri_.remove_trailing_slash().last_path_part();
+    const bool packed =
+        utils::parse::ends_with(name, constants::packed_fragment_suffix);
+    if (!packed &&
+        (offsets.count(name) > 0 || offsets.count(sf.uri_.to_string()) > 0))
+      return Status::Ok();
+    uint32_t f_version;
+    RETURN_NOT_OK(utils::parse::get_fragment_name_version(name, &f_version));
+    if (f_version == 1)
+      return Status::Ok();
+
+    // The metadata file of a packed fragment ends its object, followed by
+    // the index of its files
+    URI meta_uri = packed ?
+                       sf.uri_ :
+                       sf.uri_.join_path(constants::fragment_metadata_filename);
+    RETURN_NOT_OK(vfs_->file_size(meta_uri, &meta_file_sizes[f]));
+    const uint64_t tail_size = std::min(
+        meta_file_sizes[f], constants::fragment_metadata_tail_size);
+    if (tail_size == 0)
+      return Status::Ok();
+
+    auto& file_tail = file_tails[f];
+    RETURN_NOT_OK(file_tail.realloc(tail_size));
+    RETURN_NOT_OK(vfs_->read(
+        meta_uri,
+        meta_file_sizes[f] - tail_size,
+        file_tail.data(),
+        tail_size,
+        false));
+    file_tail.set_size(tail_size);
+    stats_->add_counter("read_frag_meta_tail_size", tail_size);
+    return Status::Ok();
+  });
+  RETURN_NOT_OK_TUPLE(status, std::nullopt);
+
+  // Load the metadata for each fragment. The metadata shared through the
+  // cache outlive the array, so they are not tracked against its memory
+  // budget.
+  auto fragment_memory_tracker =
+      fragment_metadata_cache_ == nullptr ? memory_tracker : nullptr;
+  status = parallel_for(compute_tp_, 0, fragment_num, [&](size_t f) {
     const auto& sf = fragments_to_load[f];
+    if (fragment_metadata[f] != nullptr)
+      return Status::Ok();
 
     URI coords_uri =
         sf.uri_.join_path(constants::coords + constants::file_suffix);
@@ -2264,7 +3051,7 @@ StorageManager::load_fragment_metadata(
       metadata = tdb::make_shared<FragmentMetadata>(
           HERE(),
           this,
-          memory_tracker,
+          fragment_memory_tracker,
           array_schema_latest,
           sf.uri_,
           sf.timestamp_range_,
@@ -2273,7 +3060,7 @@ StorageManager::load_fragment_metadata(
       metadata = tdb::make_shared<FragmentMetadata>(
           HERE(),
           this,
-          memory_tracker,
+          fragment_memory_tracker,
           array_schema_latest,
           sf.uri_,
           sf.timestamp_range_);
@@ -2290,6 +3077,8 @@ StorageManager::load_fragment_metadata(
     } else {
       it = offsets.find(sf.uri_.to_string());
     }
+    if (file_tails[f].size() > 0)
+      metadata->set_file_tail(meta_file_sizes[f], std::move(file_tails[f]));
     if (it != offsets.end()) {
       f_buff = meta_buff;
       offset = it->second;
@@ -2299,67 +3088,121 @@ StorageManager::load_fragment_metadata(
     RETURN_NOT_OK(
         metadata->load(encryption_key, f_buff, offset, array_schemas_all));
 
+    if (fragment_metadata_cache_ != nullptr) {
+      // The metadata reference the array schema they were loaded with, which
+      // must live as long as the metadata are shared
+      auto schema_it = array_schemas_all.find(metadata->array_schema_name());
+      if (schema_it != array_schemas_all.end()) {
+        auto array_schema = schema_it->second;
+        metadata = tdb_shared_ptr<FragmentMetadata>(
+            metadata.get(), [metadata, array_schema](FragmentMetadata*) {});
+        RETURN_NOT_OK(
+            fragment_metadata_cache_->insert(cache_keys[f], metadata));
+      }
+    }
+
     fragment_metadata[f] = metadata;
     return Status::Ok();
   });
   RETURN_NOT_OK_TUPLE(status, std::nullopt);
 
+  // Drop the fragments that do not intersect the subarray hint
+  if (subarray != nullptr) {
+    auto domain = array_schema_latest->domain();
+    auto irrelevant_it = std::remove_if(
+        fragment_metadata.begin(),
+        fragment_metadata.end(),
+        [&](const tdb_shared_ptr<FragmentMetadata>& metadata) {
+          return !domain->overlap(*subarray, metadata->non_empty_domain());
+        });
+    stats_->add_counter(
+        "frag_meta_skipped_num",
+        std::distance(irrelevant_it, fragment_metadata.end()));
+    fragment_metadata.erase(irrelevant_it, fragment_metadata.end());
+  }
+
   return {Status::Ok(), fragment_metadata};
 }
 
 Status StorageManager::load_consolidated_fragment_meta(
-    const URI& uri,
+    const std::vector<URI>& uris,
     const EncryptionKey& enc_key,
     Buffer* f_buff,
     std::unordered_map<std::string, uint64_t>* offsets) {
   auto timer_se = stats_->start_timer("read_load_consolidated_frag_meta");
 
   // No consolidated fragment metadata file
-  if (uri.to_string().empty())
+  if (uris.empty())
     return Status::Ok();
 
-  GenericTileIO tile_io(this, uri);
-  Tile* tile = nullptr;
-  RETURN_NOT_OK(tile_io.read_generic(&tile, 0, enc_key, config_));
-
-  f_buff->realloc(tile->size());
-  f_buff->set_size(tile->size());
-  RETURN_NOT_OK_ELSE(
-      tile->read(f_buff->data(), 0, f_buff->size()), tdb_delete(tile));
-  tdb_delete(tile);
+  // Read the latest consolidated fragment metadata and its deltas at once
+  std::vector<Buffer> buffs(uris.size());
+  auto status = parallel_for(io_tp_, 0, uris.size(), [&](size_t i) {
+    GenericTileIO tile_io(this, uris[i]);
+    RETURN_NOT_OK(tile_io.read_generic(&buffs[i], 0, enc_key, config_));
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(status);
+  if (buffs.size() == 1) {
+    *f_buff = std::move(buffs[0]);
+  } else {
+    for (const auto& buff : buffs)
+      RETURN_NOT_OK(f_buff->write(buff.data(), buff.size()));
+  }
 
   stats_->add_counter("consolidated_frag_meta_size", f_buff->size());
-
-  uint32_t fragment_num;
-  f_buff->reset_offset();
-  f_buff->read(&fragment_num, sizeof(uint32_t));
-
-  uint64_t name_size, offset;
-  std::string name;
-  for (uint32_t f = 0; f < fragment_num; ++f) {
-    f_buff->read(&name_size, sizeof(uint64_t));
-    name.resize(name_size);
-    f_buff->read(&name[0], name_size);
-    f_buff->read(&offset, sizeof(uint64_t));
-    (*offsets)[name] = offset;
+  stats_->add_counter("consolidated_frag_meta_num", uris.size());
+
+  // Shift the footer offsets of every file by its position in `f_buff`
+  uint64_t file_offset = 0;
+  for (const auto& buff : buffs) {
+    uint32_t fragment_num;
+    f_buff->set_offset(file_offset);
+    f_buff->read(&fragment_num, sizeof(uint32_t));
+
+    uint64_t name_size, offset;
+    std::string name;
+    for (uint32_t f = 0; f < fragment_num; ++f) {
+      f_buff->read(&name_size, sizeof(uint64_t));
+      name.resize(name_size);
+      f_buff->read(&name[0], name_size);
+      f_buff->read(&offset, sizeof(uint64_t));
+      (*offsets)[name] = file_offset + offset;
+    }
+    file_offset += buff.size();
   }
 
   return Status::Ok();
 }
 
-Status StorageManager::get_consolidated_fragment_meta_uri(
-    const std::vector<URI>& uris, URI* meta_uri) const {
-  uint64_t t_latest = 0;
-  std::pair<uint64_t, uint64_t> timestamp_range;
+Status StorageManager::get_consolidated_fragment_meta_uris(
+    const std::vector<URI>& uris, std::vector<URI>* meta_uris) const {
+  // Sort the consolidated fragment metadata by descending end timestamp
+  std::vector<std::pair<std::pair<uint64_t, uint64_t>, URI>> metas;
   for (const auto& uri : uris) {
     if (utils::parse::ends_with(uri.to_string(), constants::meta_file_suffix)) {
+      std::pair<uint64_t, uint64_t> timestamp_range;
       RETURN_NOT_OK(utils::parse::get_timestamp_range(uri, &timestamp_range));
-      if (timestamp_range.second > t_latest) {
-        t_latest = timestamp_range.second;
-        *meta_uri = uri;
-      }
+      metas.emplace_back(timestamp_range, uri);
+    }
+  }
+  std::stable_sort(
+      metas.begin(), metas.end(), [](const auto& a, const auto& b) {
+        return a.first.second > b.first.second;
+      });
+
+  // Follow the deltas from the latest one back to the first full one
+  meta_uris->clear();
+  uint64_t t_start = UINT64_MAX;
+  for (const auto& meta : metas) {
+    if (meta.first.second < t_start) {
+      meta_uris->emplace_back(meta.second);
+      t_start = meta.first.first;
+      if (t_start == 0)
+        break;
     }
   }
+  std::reverse(meta_uris->begin(), meta_uris->end());
 
   return Status::Ok();
 }
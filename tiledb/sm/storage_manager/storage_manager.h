@@ -35,7 +35,9 @@
 #define TILEDB_STORAGE_MANAGER_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <list>
 #include <map>
@@ -44,7 +46,9 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
+#include "tiledb/common/governor/governor.h"
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger_public.h"
 #include "tiledb/common/status.h"
@@ -66,13 +70,21 @@ class Array;
 class ArraySchema;
 class ArraySchemaEvolution;
 class Buffer;
-class BufferLRUCache;
+class ArraySchemaLRUCache;
+class ArraySnapshotLRUCache;
+class ShardedBufferLRUCache;
+class SharedMemoryTileCache;
+class LargeBufferAllocator;
+class TileBufferPool;
+class InflightTileReads;
+class FragmentMetadataLRUCache;
 class Consolidator;
 class EncryptionKey;
 class FragmentMetadata;
 class FragmentInfo;
 class Metadata;
 class OpenArray;
+class PackedFragment;
 class MemoryTracker;
 class Query;
 class RestClient;
@@ -158,6 +170,9 @@ class StorageManager {
    * @param timestamp_end The end timestamp.
    *     In TileDB, timestamps are in ms elapsed since
    *     1970-01-01 00:00:00 +0000 (UTC).
+   * @param open_subarray An optional subarray hint, as a [low, high] pair
+   *     for each (fixed-sized) dimension. If not empty, only the fragments
+   *     intersecting it are loaded.
    * @return tuple of Status, latest ArraySchema, map of all array schemas and
    * vector of FragmentMetadata
    *        Status Ok on success, else error
@@ -178,7 +193,8 @@ class StorageManager {
       MemoryTracker* memory_tracker,
       const EncryptionKey& enc_key,
       uint64_t timestamp_start,
-      uint64_t timestamp_end);
+      uint64_t timestamp_end,
+      const std::vector<uint8_t>& open_subarray = {});
 
   /**
    * Opens an array for reads at a timestamp. All the metadata of the
@@ -222,6 +238,15 @@ class StorageManager {
           std::unordered_map<std::string, tdb_shared_ptr<ArraySchema>>>>
   array_open_for_reads_without_fragments(Array* array);
 
+  /**
+   * Marks an array opened from a snapshot as open for reads. The schemas
+   * and fragment metadata of the array come from the snapshot.
+   *
+   * @param array The array opened from a snapshot.
+   * @return Status
+   */
+  Status array_open_for_reads_from_snapshot(Array* array);
+
   /** Opens an array for writes.
    *
    * @param array The array to open.
@@ -529,7 +554,10 @@ class StorageManager {
       const std::string& array_uri, EncryptionType* encryption_type);
 
   /**
-   * Pushes an async query to the queue.
+   * Pushes an async query to the queue. The query is processed once admitted,
+   * when fewer than `sm.async_query.max_concurrent` async queries are in
+   * flight, the queries of the different `sm.async_query.tag` admitted
+   * round-robin.
    *
    * @param query The async query.
    * @return Status
@@ -552,13 +580,40 @@ class StorageManager {
   Status touch(const URI& uri);
 
   /**
-   * Retrieves all the fragment URIs of an array, along with the latest
-   * consolidated fragment metadata URI `meta_uri`.
+   * Starts a packed fragment. Until the fragment is stored or discarded,
+   * the writes to the files under the input URI are staged in memory
+   * instead of creating a directory of files.
+   *
+   * @param uri The URI of the packed fragment object.
+   * @return Status
+   */
+  Status start_packed_fragment(const URI& uri);
+
+  /**
+   * Writes a packed fragment started with `start_packed_fragment` as a
+   * single object, which commits the fragment.
+   *
+   * @param uri The URI of the packed fragment object.
+   * @return Status
+   */
+  Status store_packed_fragment(const URI& uri);
+
+  /** Discards the staged files of a packed fragment. */
+  void discard_packed_fragment(const URI& uri);
+
+  /** Retrieves all the array metadata URI's of an array. */
+  Status get_array_metadata_uris(
+      const URI& array_uri, std::vector<URI>* array_metadata_uris) const;
+
+  /**
+   * Retrieves all the fragment URIs of an array, along with the URIs
+   * `meta_uris` of the latest consolidated fragment metadata and the deltas
+   * appended to it, as returned by `get_consolidated_fragment_meta_uris`.
    */
   Status get_fragment_uris(
       const URI& array_uri,
       std::vector<URI>* fragment_uris,
-      URI* meta_uri) const;
+      std::vector<URI>* meta_uris) const;
 
   /**
    * It computes the URIs `to_vacuum` from the input `uris`, considering
@@ -586,6 +641,21 @@ class StorageManager {
       std::vector<URI>* vac_uris,
       bool allow_partial = true) const;
 
+  /**
+   * Applicable to fragment and array metadata URIs.
+   *
+   * Gets the sorted URIs in ascending first timestamp order,
+   * breaking ties with lexicographic
+   * sorting of UUID. Only the URIs with timestamp between `timestamp_start`
+   * and `timestamp_end` (inclusive) are considered. The sorted URIs are
+   * stored in the last input, including their timestamps.
+   */
+  Status get_sorted_uris(
+      const std::vector<URI>& uris,
+      std::vector<TimestampedURI>* sorted_uris,
+      uint64_t timestamp_start,
+      uint64_t timestamp_end) const;
+
   /** Returns the current map of any set tags. */
   const std::unordered_map<std::string, std::string>& tags() const;
 
@@ -643,7 +713,7 @@ class StorageManager {
    * in `ok_uris`. For versions < 5, `ok_uris` is empty so the function
    * checks for the existence of the fragment metadata file in the fragment
    * URI directory. Therefore, the function is more expensive for earlier
-   * fragment versions.
+   * fragment versions. Packed fragment objects are always fragments.
    *
    * @param The URI to be checked.
    * @param ok_uris For checking URI existence of versions >= 5.
@@ -900,6 +970,60 @@ class StorageManager {
       uint64_t nbytes,
       bool* in_cache) const;
 
+  /** Returns `true` if the unfiltered tile cache is enabled. */
+  bool unfiltered_tile_cache_enabled() const;
+
+  /** Returns the byte size of the tiles in the in-process tile caches. */
+  uint64_t tile_cache_size() const;
+
+  /**
+   * Returns the pool recycling the tile buffers of the queries of this
+   * context, or `nullptr` if `sm.mem.tile_buffer_pool_size` is 0.
+   */
+  TileBufferPool* tile_buffer_pool() const;
+
+  /** Frees the idle buffers of the tile buffer pool, if any. */
+  void trim_tile_buffer_pool();
+
+  /**
+   * Returns the tile reads in flight for the queries of this context, or
+   * `nullptr` if `sm.query.shared_scan` is false.
+   */
+  InflightTileReads* inflight_tile_reads() const;
+
+  /**
+   * Returns the allocator of the large tile buffers, or `nullptr` if
+   * neither `sm.mem.large_buffer.huge_pages` nor
+   * `sm.mem.large_buffer.numa_local` is set.
+   */
+  const LargeBufferAllocator* large_buffer_allocator() const;
+
+  /**
+   * Returns the governor brokering `sm.mem.total_budget` between the
+   * queries of this context, or `nullptr` if `sm.mem.governor.enabled` is
+   * false.
+   */
+  Governor* governor() const;
+
+  /**
+   * Reads an unfiltered tile from the unfiltered tile cache. The tile is
+   * identified by the `uri`, `offset` pair of its filtered data.
+   *
+   * @param uri The URI of the file holding the tile.
+   * @param offset The offset of the tile in the file.
+   * @param data The memory to write the unfiltered tile into.
+   * @param nbytes Number of bytes to be read.
+   * @param in_cache This is set to `true` if the tile is in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_unfiltered_from_cache(
+      const URI& uri,
+      uint64_t offset,
+      void* data,
+      uint64_t nbytes,
+      bool* in_cache) const;
+
   /**
    * Reads from a file into the input buffer.
    *
@@ -983,6 +1107,20 @@ class StorageManager {
   Status write_to_cache(
       const URI& uri, uint64_t offset, const FilteredBuffer& buffer) const;
 
+  /**
+   * Writes an unfiltered tile into the unfiltered tile cache, if it is
+   * enabled. The tile is identified by the `uri`, `offset` pair of its
+   * filtered data.
+   *
+   * @param uri The URI of the file holding the tile.
+   * @param offset The offset of the tile in the file.
+   * @param data The unfiltered tile data.
+   * @param nbytes The unfiltered tile size.
+   * @return Status.
+   */
+  Status write_unfiltered_to_cache(
+      const URI& uri, uint64_t offset, const void* data, uint64_t nbytes) const;
+
   /**
    * Writes the contents of a buffer into a URI file.
    *
@@ -1036,6 +1174,15 @@ class StorageManager {
     }
   };
 
+  /** An async query waiting for admission. */
+  struct PendingAsyncQuery {
+    /** The query. */
+    Query* query_;
+
+    /** The time the query was submitted at. */
+    std::chrono::steady_clock::time_point submitted_;
+  };
+
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
@@ -1090,11 +1237,116 @@ class StorageManager {
    */
   CancelableTasks cancelable_tasks_;
 
+  /**
+   * The async queries waiting for admission, queued per client tag. The tags
+   * are served round-robin, in the order of this map.
+   */
+  std::map<std::string, std::deque<PendingAsyncQuery>> async_queue_;
+
+  /** The tag the last admitted async query was queued under. */
+  std::string async_last_tag_;
+
+  /** The number of admitted async queries that have not completed. */
+  uint64_t async_running_;
+
+  /**
+   * The maximum number of admitted async queries, 0 for no limit. This is
+   * `sm.async_query.max_concurrent`.
+   */
+  uint64_t async_max_concurrent_;
+
+  /** Protects the async queue, `async_last_tag_` and `async_running_`. */
+  std::mutex async_mtx_;
+
+  /**
+   * The number of fragments from which closing an array for writes
+   * schedules a background consolidation, 0 to disable it. This is
+   * `sm.consolidation.auto.fragment_num`.
+   */
+  uint64_t auto_consolidation_fragment_num_;
+
+  /**
+   * The minimum time between the starts of two background consolidations of
+   * an array. This is `sm.consolidation.auto.min_interval_ms`.
+   */
+  std::chrono::milliseconds auto_consolidation_interval_;
+
+  /** The URIs of the arrays with a background consolidation in flight. */
+  std::set<std::string> auto_consolidation_active_;
+
+  /** When the last background consolidation of each array started. */
+  std::map<std::string, std::chrono::steady_clock::time_point>
+      auto_consolidation_last_;
+
+  /** The number of background consolidations scheduled but not started. */
+  uint64_t auto_consolidation_backlog_;
+
+  /** Protects the background consolidation state. */
+  std::mutex auto_consolidation_mtx_;
+
   /** Tags for the context object. */
   std::unordered_map<std::string, std::string> tags_;
 
-  /** A tile cache. */
-  tdb_unique_ptr<BufferLRUCache> tile_cache_;
+  /**
+   * Recycles the tile buffers of the queries of this context. This is
+   * `nullptr` if `sm.mem.tile_buffer_pool_size` is 0.
+   */
+  tdb_unique_ptr<TileBufferPool> tile_buffer_pool_;
+
+  /**
+   * The tile reads in flight, shared by the concurrent queries of this
+   * context. This is `nullptr` if `sm.query.shared_scan` is false.
+   */
+  tdb_unique_ptr<InflightTileReads> inflight_tile_reads_;
+
+  /**
+   * Allocates the large tile buffers of the queries of this context. This
+   * is `nullptr` if neither `sm.mem.large_buffer.huge_pages` nor
+   * `sm.mem.large_buffer.numa_local` is set.
+   */
+  tdb_unique_ptr<LargeBufferAllocator> large_buffer_allocator_;
+
+  /** A tile cache, holding filtered tiles. */
+  tdb_unique_ptr<ShardedBufferLRUCache> tile_cache_;
+
+  /**
+   * A tile cache holding filtered tiles in shared memory, used instead of
+   * `tile_cache_`. This is `nullptr` if `sm.tile_cache_shared_memory_name`
+   * is empty.
+   */
+  tdb_unique_ptr<SharedMemoryTileCache> shared_tile_cache_;
+
+  /**
+   * A cache of unfiltered tiles. This is `nullptr` if
+   * `sm.tile_cache_unfiltered_size` is 0.
+   */
+  tdb_unique_ptr<ShardedBufferLRUCache> unfiltered_tile_cache_;
+
+  /**
+   * Brokers `sm.mem.total_budget` between the queries of this context, the
+   * tile caches shedding first. This is `nullptr` if
+   * `sm.mem.governor.enabled` is false.
+   */
+  tdb_unique_ptr<Governor> governor_;
+
+  /**
+   * The fragment metadata shared by the arrays opened with this storage
+   * manager. This is `nullptr` if `sm.fragment_metadata_cache_size` is 0.
+   */
+  tdb_unique_ptr<FragmentMetadataLRUCache> fragment_metadata_cache_;
+
+  /**
+   * The deserialized array schemas, copied into the arrays opened with this
+   * storage manager. This is `nullptr` if `sm.array_schema_cache_size` is 0.
+   */
+  tdb_unique_ptr<ArraySchemaLRUCache> array_schema_cache_;
+
+  /**
+   * The snapshots of the arrays opened for reads at explicit timestamps,
+   * shared by the arrays opened again at the same timestamps. This is
+   * `nullptr` if `sm.array_snapshot_cache_size` is 0.
+   */
+  tdb_unique_ptr<ArraySnapshotLRUCache> array_snapshot_cache_;
 
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
@@ -1105,16 +1357,124 @@ class StorageManager {
   /** The rest client (may be null if none was configured). */
   tdb_unique_ptr<RestClient> rest_client_;
 
+  /** A cached directory listing. */
+  struct CachedListing {
+    /** The time of the listing. */
+    std::chrono::steady_clock::time_point time_;
+
+    /** The listed URIs. */
+    std::vector<URI> uris_;
+  };
+
+  /**
+   * Directory listings of arrays, keyed by the listed URI, reused for
+   * `sm.listing_cache_ttl_ms` milliseconds.
+   */
+  mutable std::unordered_map<std::string, CachedListing> listing_cache_;
+
+  /** Mutex protecting `listing_cache_`. */
+  mutable std::mutex listing_cache_mtx_;
+
+  /**
+   * The packed fragments being written, keyed by their URI. The files
+   * written under these URIs are staged in the packed fragments.
+   */
+  mutable std::unordered_map<std::string, tdb_unique_ptr<PackedFragment>>
+      packed_fragments_;
+
+  /** The number of packed fragments being written. */
+  std::atomic<uint64_t> packed_fragment_num_;
+
+  /** Mutex protecting `packed_fragments_`. */
+  mutable std::mutex packed_fragments_mtx_;
+
   /* ********************************* */
   /*         PRIVATE METHODS           */
   /* ********************************* */
 
+  /**
+   * Pops the next async query waiting for admission, from the tag following
+   * `async_last_tag_`. The `async_mtx_` must be locked.
+   *
+   * @param pending The popped query.
+   * @return False if no query is waiting.
+   */
+  bool async_pop_query(PendingAsyncQuery* pending);
+
+  /**
+   * Processes an admitted async query on the compute thread pool, followed
+   * by the queries waiting for admission until there are none left.
+   *
+   * @param first The admitted query.
+   */
+  void async_run_queries(const PendingAsyncQuery& first);
+
+  /**
+   * Schedules a consolidation and vacuum of the fragments of the array
+   * closed for writes in the background, if it has at least
+   * `sm.consolidation.auto.fragment_num` fragments, none is in flight for
+   * it and the last one started at least
+   * `sm.consolidation.auto.min_interval_ms` ago.
+   *
+   * @param array The array being closed for writes.
+   * @return Status
+   */
+  Status auto_consolidate(Array* array);
+
   /** Decrement the count of in-progress queries. */
   void decrement_in_progress();
 
-  /** Retrieves all the array metadata URI's of an array. */
-  Status get_array_metadata_uris(
-      const URI& array_uri, std::vector<URI>* array_metadata_uris) const;
+  /**
+   * Returns the key of a tile in the tile caches: the URI of its file
+   * followed by the binary offset of the tile in the file.
+   */
+  static std::string tile_cache_key(const URI& uri, uint64_t offset);
+
+  /**
+   * Retrieves the listing of a directory of an array cached within the last
+   * `sm.listing_cache_ttl_ms` milliseconds.
+   *
+   * @param uri The listed directory.
+   * @param uris Set to the cached listing on a hit.
+   * @return `true` on a cache hit.
+   */
+  bool cached_listing(const URI& uri, std::vector<URI>* uris) const;
+
+  /**
+   * Caches the listing of a directory of an array, if the listing cache is
+   * enabled.
+   *
+   * @param uri The listed directory.
+   * @param uris The listing.
+   */
+  void cache_listing(const URI& uri, const std::vector<URI>& uris) const;
+
+  /**
+   * Computes the names to split the listing of the fragments of an array at,
+   * evenly dividing the timestamps since the creation of the array into
+   * `sm.fragment_listing_shards` ranges. Fragment names start with their
+   * timestamp, so that each range is listed by a separate request.
+   *
+   * @param array_uri The array URI.
+   * @param split_names Set to the split names; empty for a single listing.
+   * @return Status
+   */
+  Status get_fragment_listing_splits(
+      const URI& array_uri, std::vector<std::string>* split_names) const;
+
+  /**
+   * Drops the cached listings of the directories under the given URI, and
+   * the snapshots of the arrays under it, after the objects in them changed.
+   *
+   * @param uri The URI of the changed array or object.
+   */
+  void invalidate_listing_cache(const URI& uri) const;
+
+  /**
+   * Returns the packed fragment being written that stages the input file,
+   * or nullptr if the file is not part of a packed fragment.
+   */
+  PackedFragment* packed_fragment(const URI& file_uri) const;
 
   /** Increment the count of in-progress queries. */
   void increment_in_progress();
@@ -1145,6 +1505,8 @@ class StorageManager {
    *     where the basic fragment metadata can be found. If the offset
    *     cannot be found, then the metadata of that fragment will be loaded from
    *     storage instead.
+   * @param subarray If not `nullptr`, only the metadata of the fragments
+   *     whose non-empty domain intersects it are returned.
    * @return tuple of Status and vector of FragmentMetadata
    *        Status Ok on success, else error
    *        Vector of FragmentMetadata is the fragment metadata to be retrieved.
@@ -1160,12 +1522,15 @@ class StorageManager {
       const EncryptionKey& encryption_key,
       const std::vector<TimestampedURI>& fragments_to_load,
       Buffer* meta_buff,
-      const std::unordered_map<std::string, uint64_t>& offsets);
+      const std::unordered_map<std::string, uint64_t>& offsets,
+      const NDRange* subarray = nullptr);
 
   /**
-   * Loads the latest consolidated fragment metadata from storage.
+   * Loads the latest consolidated fragment metadata and its deltas from
+   * storage, reading the files in parallel and concatenating them in
+   * `f_buff`. The footers of the later files take precedence.
    *
-   * @param uri The URI of the consolidated fragment metadata.
+   * @param uris The URIs of the consolidated fragment metadata, oldest first.
    * @param enc_key The encryption key that may be needed to access the file.
    * @param f_buff The buffer to hold the consolidated fragment metadata.
    * @param offsets A map from the fragment name to the offset in `f_buff` where
@@ -1173,32 +1538,19 @@ class StorageManager {
    * @return Status
    */
   Status load_consolidated_fragment_meta(
-      const URI& uri,
+      const std::vector<URI>& uris,
       const EncryptionKey& enc_key,
       Buffer* f_buff,
       std::unordered_map<std::string, uint64_t>* offsets);
 
   /**
-   * Retrieves the URI of the latest consolidated fragment metadata,
-   * among the URIs in `uris`.
+   * Retrieves the URIs of the latest consolidated fragment metadata among
+   * the URIs in `uris`, along with the older ones it is a delta of, oldest
+   * first. A consolidated fragment metadata file is a delta of the latest
+   * one whose timestamp range ends before its own starts.
    */
-  Status get_consolidated_fragment_meta_uri(
-      const std::vector<URI>& uris, URI* meta_uri) const;
-
-  /**
-   * Applicable to fragment and array metadata URIs.
-   *
-   * Gets the sorted URIs in ascending first timestamp order,
-   * breaking ties with lexicographic
-   * sorting of UUID. Only the URIs with timestamp between `timestamp_start`
-   * and `timestamp_end` (inclusive) are considered. The sorted URIs are
-   * stored in the last input, including their timestamps.
-   */
-  Status get_sorted_uris(
-      const std::vector<URI>& uris,
-      std::vector<TimestampedURI>* sorted_uris,
-      uint64_t timestamp_start,
-      uint64_t timestamp_end) const;
+  Status get_consolidated_fragment_meta_uris(
+      const std::vector<URI>& uris, std::vector<URI>* meta_uris) const;
 
   /** Block until there are zero in-progress queries. */
   void wait_for_zero_in_progress();
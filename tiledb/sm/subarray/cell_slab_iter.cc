@@ -55,18 +55,24 @@ template <class T>
 CellSlabIter<T>::CellSlabIter() {
   subarray_ = nullptr;
   end_ = true;
+  dim_num_ = 0;
+  slab_dim_ = 0;
+  next_func_ = nullptr;
 }
 
 template <class T>
 CellSlabIter<T>::CellSlabIter(const Subarray* subarray)
     : subarray_(subarray) {
   end_ = true;
+  dim_num_ = 0;
+  slab_dim_ = 0;
+  next_func_ = nullptr;
   if (subarray != nullptr) {
     auto array_schema = subarray->array()->array_schema_latest();
-    auto dim_num = array_schema->dim_num();
+    dim_num_ = array_schema->dim_num();
     auto coord_size = array_schema->dimension(0)->coord_size();
-    aux_tile_coords_.resize(dim_num);
-    aux_tile_coords_2_.resize(dim_num * coord_size);
+    aux_tile_coords_.resize(dim_num_);
+    aux_tile_coords_2_.resize(dim_num_ * coord_size);
   }
 }
 
@@ -80,11 +86,12 @@ Status CellSlabIter<T>::begin() {
     return Status::Ok();
 
   RETURN_NOT_OK(sanity_check());
-  cell_slab_.init(subarray_->dim_num());
+  cell_slab_.init(dim_num_);
   RETURN_NOT_OK(init_ranges());
   init_coords();
   init_cell_slab_lengths();
-  update_cell_slab();
+  set_next_func();
+  update_cell_slab<0>();
 
   end_ = false;
 
@@ -112,18 +119,7 @@ void CellSlabIter<T>::operator++() {
   if (end_)
     return;
 
-  // Advance the iterator
-  if (subarray_->layout() == Layout::ROW_MAJOR)
-    advance_row();
-  else
-    advance_col();
-
-  if (end_) {
-    cell_slab_.reset();
-    return;
-  }
-
-  update_cell_slab();
+  (this->*next_func_)();
 }
 
 /* ****************************** */
@@ -131,8 +127,9 @@ void CellSlabIter<T>::operator++() {
 /* ****************************** */
 
 template <class T>
+template <unsigned D>
 void CellSlabIter<T>::advance_col() {
-  auto dim_num = (int)subarray_->dim_num();
+  const int dim_num = (D == 0) ? (int)dim_num_ : (int)D;
 
   for (int i = 0; i < dim_num; ++i) {
     cell_slab_coords_[i] += (i == 0) ? cell_slab_lengths_[range_coords_[i]] : 1;
@@ -158,8 +155,9 @@ void CellSlabIter<T>::advance_col() {
 }
 
 template <class T>
+template <unsigned D>
 void CellSlabIter<T>::advance_row() {
-  auto dim_num = (int)subarray_->dim_num();
+  const int dim_num = (D == 0) ? (int)dim_num_ : (int)D;
 
   for (int i = dim_num - 1; i >= 0; --i) {
     cell_slab_coords_[i] +=
@@ -185,6 +183,61 @@ void CellSlabIter<T>::advance_row() {
   }
 }
 
+template <class T>
+template <unsigned D, bool row_major>
+void CellSlabIter<T>::next() {
+  if (row_major)
+    advance_row<D>();
+  else
+    advance_col<D>();
+
+  if (end_) {
+    cell_slab_.reset();
+    return;
+  }
+
+  update_cell_slab<D>();
+}
+
+template <class T>
+void CellSlabIter<T>::set_next_func() {
+  if (subarray_->layout() == Layout::ROW_MAJOR) {
+    switch (dim_num_) {
+      case 1:
+        next_func_ = &CellSlabIter<T>::next<1, true>;
+        break;
+      case 2:
+        next_func_ = &CellSlabIter<T>::next<2, true>;
+        break;
+      case 3:
+        next_func_ = &CellSlabIter<T>::next<3, true>;
+        break;
+      case 4:
+        next_func_ = &CellSlabIter<T>::next<4, true>;
+        break;
+      default:
+        next_func_ = &CellSlabIter<T>::next<0, true>;
+    }
+  } else {
+    switch (dim_num_) {
+      case 1:
+        next_func_ = &CellSlabIter<T>::next<1, false>;
+        break;
+      case 2:
+        next_func_ = &CellSlabIter<T>::next<2, false>;
+        break;
+      case 3:
+        next_func_ = &CellSlabIter<T>::next<3, false>;
+        break;
+      case 4:
+        next_func_ = &CellSlabIter<T>::next<4, false>;
+        break;
+      default:
+        next_func_ = &CellSlabIter<T>::next<0, false>;
+    }
+  }
+}
+
 template <class T>
 void CellSlabIter<T>::create_ranges(
     const T* range,
@@ -212,9 +265,10 @@ void CellSlabIter<T>::create_ranges(
 template <class T>
 void CellSlabIter<T>::init_cell_slab_lengths() {
   auto layout = subarray_->layout();
-  auto dim_num = subarray_->dim_num();
+  auto dim_num = dim_num_;
 
   if (layout == Layout::ROW_MAJOR) {
+    slab_dim_ = dim_num - 1;
     auto range_num = ranges_[dim_num - 1].size();
     cell_slab_lengths_.resize(range_num);
     for (size_t i = 0; i < range_num; ++i)
@@ -222,6 +276,7 @@ void CellSlabIter<T>::init_cell_slab_lengths() {
           ranges_[dim_num - 1][i].end_ - ranges_[dim_num - 1][i].start_ + 1;
   } else {
     assert(layout == Layout::COL_MAJOR);
+    slab_dim_ = 0;
     auto range_num = ranges_[0].size();
     cell_slab_lengths_.resize(range_num);
     for (size_t i = 0; i < range_num; ++i)
@@ -345,9 +400,9 @@ Status CellSlabIter<T>::sanity_check() const {
 }
 
 template <class T>
+template <unsigned D>
 void CellSlabIter<T>::update_cell_slab() {
-  auto dim_num = subarray_->dim_num();
-  auto layout = subarray_->layout();
+  const unsigned dim_num = (D == 0) ? dim_num_ : D;
 
   for (unsigned i = 0; i < dim_num; ++i) {
     aux_tile_coords_[i] = ranges_[i][range_coords_[i]].tile_coord_;
@@ -355,9 +410,7 @@ void CellSlabIter<T>::update_cell_slab() {
   }
   cell_slab_.tile_coords_ =
       subarray_->tile_coords_ptr(aux_tile_coords_, &aux_tile_coords_2_);
-  cell_slab_.length_ = (layout == Layout::ROW_MAJOR) ?
-                           cell_slab_lengths_[range_coords_[dim_num - 1]] :
-                           cell_slab_lengths_[range_coords_[0]];
+  cell_slab_.length_ = cell_slab_lengths_[range_coords_[slab_dim_]];
 }
 
 // Explicit template instantiations
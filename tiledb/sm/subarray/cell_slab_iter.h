@@ -216,16 +216,58 @@ class CellSlabIter {
   /** Auxiliary tile coordinates to avoid repeated allocations. */
   std::vector<uint8_t> aux_tile_coords_2_;
 
+  /** The number of dimensions. */
+  unsigned dim_num_;
+
+  /**
+   * The dimension the cell slabs lie along, i.e., the last one for
+   * row-major and the first one for col-major.
+   */
+  unsigned slab_dim_;
+
+  /**
+   * Advances to the next cell slab, specialized on the number of dimensions
+   * and the subarray layout. Set in `begin`.
+   */
+  void (CellSlabIter<T>::*next_func_)();
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
-  /** Advances to the next cell slab when the layout is col-major. */
+  /**
+   * Advances to the next cell slab when the layout is col-major.
+   *
+   * @tparam D The number of dimensions, so that the loop over them is
+   *     unrolled, or 0 for any number of dimensions.
+   */
+  template <unsigned D>
   void advance_col();
 
-  /** Advances to the next cell slab when the layout is row-major. */
+  /**
+   * Advances to the next cell slab when the layout is row-major.
+   *
+   * @tparam D The number of dimensions, so that the loop over them is
+   *     unrolled, or 0 for any number of dimensions.
+   */
+  template <unsigned D>
   void advance_row();
 
+  /**
+   * Advances to the next cell slab and updates it.
+   *
+   * @tparam D The number of dimensions, or 0 for any number of dimensions.
+   * @tparam row_major Whether the subarray layout is row-major.
+   */
+  template <unsigned D, bool row_major>
+  void next();
+
+  /**
+   * Sets `next_func_` for the number of dimensions and the layout of
+   * the subarray. Specializations exist for up to 4 dimensions.
+   */
+  void set_next_func();
+
   /**
    * Given an input 1D range (corresponding to a single dimension),
    * it potentially splits it into ranges at the tile boundaries, and
@@ -265,7 +307,10 @@ class CellSlabIter {
   /**
    * Updates the current cell slab, based on the current state of
    * the iterator.
+   *
+   * @tparam D The number of dimensions, or 0 for any number of dimensions.
    */
+  template <unsigned D>
   void update_cell_slab();
 };
 
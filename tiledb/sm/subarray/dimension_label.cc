@@ -0,0 +1,281 @@
+/**
+ * @file   dimension_label.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DimensionLabel.
+ */
+
+#include "tiledb/sm/subarray/dimension_label.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/misc/apply_with_type.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/query/query.h"
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+DimensionLabel::DimensionLabel(const Array* array, uint32_t dim_idx)
+    : array_(array)
+    , dim_idx_(dim_idx) {
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+URI DimensionLabel::uri(const URI& array_uri, const std::string& dim_name) {
+  return array_uri.join_path(constants::array_dimension_labels_folder_name)
+      .join_path(dim_name);
+}
+
+Status DimensionLabel::index_range(
+    const void* start, const void* end, Range* range) const {
+  if (array_->is_remote())
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; Dimension labels are not supported on "
+        "remote arrays"));
+
+  // Open the label array at the same timestamp as the labeled array.
+  const auto dim = array_->array_schema_latest()->dimension(dim_idx_);
+  Array label_array(
+      uri(array_->array_uri(), dim->name()), array_->storage_manager());
+  const auto& encryption_key = array_->get_encryption_key();
+  const auto key = encryption_key.key();
+  RETURN_NOT_OK(label_array.open(
+      QueryType::READ,
+      0,
+      array_->timestamp_end_opened_at(),
+      encryption_key.encryption_type(),
+      key.data(),
+      static_cast<uint32_t>(key.size())));
+
+  RETURN_NOT_OK_ELSE(
+      index_range(&label_array, start, end, range), label_array.close());
+  return label_array.close();
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+Status DimensionLabel::index_range(
+    Array* label_array,
+    const void* start,
+    const void* end,
+    Range* range) const {
+  const auto dim = array_->array_schema_latest()->dimension(dim_idx_);
+  const auto label_schema = label_array->array_schema_latest();
+  if (!label_schema->dense() || label_schema->dim_num() != 1 ||
+      label_schema->attribute_num() != 1)
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; The label array must be dense, with one "
+        "dimension and one attribute"));
+
+  const auto index_dim = label_schema->dimension(0);
+  if (index_dim->type() != dim->type())
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; The label array dimension type must be the "
+        "labeled dimension type"));
+
+  const auto label_attr = label_schema->attribute(0);
+  if (label_attr->var_size() || label_attr->cell_val_num() != 1 ||
+      label_attr->nullable())
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; The labels must be fixed-sized single "
+        "values that are not nullable"));
+
+  auto unsupported = []() {
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; Unsupported label datatype"));
+  };
+  return apply_with_type(
+      index_dim->type(),
+      [&](auto i) {
+        using I = decltype(i);
+        if constexpr (std::is_integral_v<I>) {
+          return apply_with_type(
+              label_attr->type(),
+              [&](auto l) {
+                using L = decltype(l);
+                return index_range<I, L>(
+                    label_array,
+                    *static_cast<const L*>(start),
+                    *static_cast<const L*>(end),
+                    range);
+              },
+              unsupported);
+        } else {
+          return unsupported();
+        }
+      },
+      unsupported);
+}
+
+template <class I, class L>
+Status DimensionLabel::index_range(
+    Array* label_array, const L start, const L end, Range* range) const {
+  if (end < start)
+    return LOG_STATUS(
+        Status_SubarrayError("Cannot add label range; Invalid range"));
+
+  auto&& [st, non_empty_domain] = label_array->non_empty_domain();
+  RETURN_NOT_OK(st);
+  if (non_empty_domain->empty() || (*non_empty_domain)[0].empty())
+    return LOG_STATUS(
+        Status_SubarrayError("Cannot add label range; The label array is "
+                             "empty"));
+
+  // Search the written labels, by blocks aligned to the tiles.
+  const auto index_dim = label_array->array_schema_latest()->dimension(0);
+  const auto written = static_cast<const I*>((*non_empty_domain)[0].data());
+  const auto domain = static_cast<const I*>(index_dim->domain().data());
+  const I lo = written[0];
+  const uint64_t n = uint64_t(written[1]) - uint64_t(lo) + 1;
+  const uint64_t offset = uint64_t(lo) - uint64_t(domain[0]);
+  const uint64_t extent = index_dim->tile_extent() ?
+                        uint64_t(index_dim->tile_extent().rvalue_as<I>()) :
+                        n;
+
+  uint64_t first = 0;
+  RETURN_NOT_OK((partition_point<I, L>(
+      label_array,
+      lo,
+      n,
+      offset % extent,
+      extent,
+      [&](const L label) { return !(label < start); },
+      &first)));
+  uint64_t last = 0;
+  RETURN_NOT_OK((partition_point<I, L>(
+      label_array,
+      lo,
+      n,
+      offset % extent,
+      extent,
+      [&](const L label) { return end < label; },
+      &last)));
+  if (first >= last)
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; No label is within the range"));
+
+  const I indices[2] = {I(uint64_t(lo) + first), I(uint64_t(lo) + last - 1)};
+  range->set_range(indices, sizeof(indices));
+  return Status::Ok();
+}
+
+template <class I, class L, class Pred>
+Status DimensionLabel::partition_point(
+    Array* label_array,
+    const I lo,
+    const uint64_t n,
+    const uint64_t offset,
+    const uint64_t extent,
+    Pred pred,
+    uint64_t* pos) const {
+  // The labels before `left` do not satisfy `pred`, the label at `right`
+  // does (or `right` is `n`).
+  std::vector<L> labels;
+  uint64_t left = 0;
+  uint64_t right = n;
+  while (left < right) {
+    // Read the labels of the tile holding the middle position, bounded by
+    // the search interval and the block size.
+    const uint64_t mid = left + (right - left) / 2;
+    const uint64_t tile_start = mid - (mid + offset) % extent;
+    const uint64_t block_start = std::max(
+        {left, tile_start, mid - std::min(mid, MAX_BLOCK_CELLS / 2)});
+    const uint64_t block_end =
+        std::min({right, tile_start + extent, block_start + MAX_BLOCK_CELLS});
+    RETURN_NOT_OK((read_labels<I, L>(
+        label_array,
+        I(uint64_t(lo) + block_start),
+        I(uint64_t(lo) + block_end - 1),
+        &labels)));
+
+    const auto it = std::partition_point(
+        labels.begin(), labels.end(), [&](const L label) {
+          return !pred(label);
+        });
+    const uint64_t p = block_start + (it - labels.begin());
+    if (p == block_end) {
+      left = block_end;
+    } else if (p > block_start || block_start == left) {
+      *pos = p;
+      return Status::Ok();
+    } else {
+      right = block_start;
+    }
+  }
+
+  *pos = left;
+  return Status::Ok();
+}
+
+template <class I, class L>
+Status DimensionLabel::read_labels(
+    Array* label_array,
+    const I first,
+    const I last,
+    std::vector<L>* labels) const {
+  labels->resize(uint64_t(last) - uint64_t(first) + 1);
+  uint64_t size = labels->size() * sizeof(L);
+  const I subarray[2] = {first, last};
+  const auto& name = label_array->array_schema_latest()->attribute(0)->name();
+
+  Query query(array_->storage_manager(), label_array);
+  RETURN_NOT_OK(query.set_layout(Layout::ROW_MAJOR));
+  RETURN_NOT_OK(query.set_subarray(subarray));
+  RETURN_NOT_OK(query.set_data_buffer(name, labels->data(), &size));
+  RETURN_NOT_OK(query.submit());
+  if (query.status() != QueryStatus::COMPLETED ||
+      size != labels->size() * sizeof(L))
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; Cannot read the labels"));
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
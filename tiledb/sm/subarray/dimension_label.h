@@ -0,0 +1,182 @@
+/**
+ * @file   dimension_label.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DimensionLabel.
+ */
+
+#ifndef TILEDB_DIMENSION_LABEL_H
+#define TILEDB_DIMENSION_LABEL_H
+
+#include <string>
+#include <vector>
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/filesystem/uri.h"
+#include "tiledb/sm/misc/types.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Array;
+
+/**
+ * A dimension label maps label values, such as timestamps or float
+ * coordinates, to the indices of a dimension of an array. The labels are
+ * stored in a dense array at `<array_uri>/__labels/<dim_name>`, which has a
+ * single dimension of the type of the labeled dimension and a single
+ * fixed-sized, non-nullable numeric attribute holding the labels. The labels
+ * must be non-decreasing along the dimension.
+ *
+ * A range of labels is translated to a range of indices with a binary search
+ * over the label array. Each step reads the labels of one tile, so only a
+ * handful of tiles are read instead of the whole label vector.
+ */
+class DimensionLabel {
+ public:
+  /* ********************************* */
+  /*             CONSTANTS             */
+  /* ********************************* */
+
+  /** The maximum number of labels read by one step of the search. */
+  static constexpr uint64_t MAX_BLOCK_CELLS = 65536;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param array The labeled array, opened.
+   * @param dim_idx The index of the labeled dimension.
+   */
+  DimensionLabel(const Array* array, uint32_t dim_idx);
+
+  /** Destructor. */
+  ~DimensionLabel() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns the URI of the label array of a dimension.
+   *
+   * @param array_uri The URI of the labeled array.
+   * @param dim_name The name of the labeled dimension.
+   * @return The URI of the label array.
+   */
+  static URI uri(const URI& array_uri, const std::string& dim_name);
+
+  /**
+   * Computes the range of the indices whose labels are within
+   * `[start, end]`. The label array is opened at the end timestamp of the
+   * labeled array.
+   *
+   * @param start The start label, of the type of the label attribute.
+   * @param end The end label, of the type of the label attribute.
+   * @param range The index range, set on success.
+   * @return Status
+   */
+  Status index_range(const void* start, const void* end, Range* range) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The labeled array. */
+  const Array* array_;
+
+  /** The index of the labeled dimension. */
+  uint32_t dim_idx_;
+
+  /* ********************************* */
+  /*           PRIVATE METHODS         */
+  /* ********************************* */
+
+  /** Checks the schema of the opened label array and searches it. */
+  Status index_range(
+      Array* label_array,
+      const void* start,
+      const void* end,
+      Range* range) const;
+
+  /**
+   * Searches the label array for the indices of the labels within
+   * `[start, end]`.
+   *
+   * @tparam I The index type.
+   * @tparam L The label type.
+   */
+  template <class I, class L>
+  Status index_range(
+      Array* label_array, const L start, const L end, Range* range) const;
+
+  /**
+   * Finds the first position, among the `n` labels starting at index `lo`,
+   * whose label satisfies `pred`. `pred` must be false then true along the
+   * labels. The labels are read by blocks aligned to the tiles of the label
+   * array, `offset` being the position of index `lo` within its tile.
+   *
+   * @param label_array The label array.
+   * @param lo The first index.
+   * @param n The number of labels.
+   * @param offset The position of `lo` within its tile.
+   * @param extent The tile extent of the label array.
+   * @param pred The predicate.
+   * @param pos The position found, `n` if no label satisfies `pred`.
+   * @return Status
+   */
+  template <class I, class L, class Pred>
+  Status partition_point(
+      Array* label_array,
+      const I lo,
+      const uint64_t n,
+      const uint64_t offset,
+      const uint64_t extent,
+      Pred pred,
+      uint64_t* pos) const;
+
+  /** Reads the labels of the indices in `[first, last]`. */
+  template <class I, class L>
+  Status read_labels(
+      Array* label_array,
+      const I first,
+      const I last,
+      std::vector<L>* labels) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DIMENSION_LABEL_H
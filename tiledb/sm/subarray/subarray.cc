@@ -31,6 +31,7 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
@@ -42,8 +43,10 @@
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/cache/tile_overlap_lru_cache.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/fragment/fragment_domain_index.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/hash.h"
 #include "tiledb/sm/misc/math.h"
@@ -55,6 +58,7 @@
 #include "tiledb/sm/rtree/rtree.h"
 #include "tiledb/sm/stats/global_stats.h"
 #include "tiledb/sm/subarray/subarray.h"
+#include "tiledb/sm/subarray/dimension_label.h"
 
 using namespace tiledb::common;
 using namespace tiledb::sm::stats;
@@ -277,8 +281,27 @@ Status Subarray::add_range(
       dim_idx, Range(&range[0], 2 * coord_size), err_on_range_oob_);
 }
 
+Status Subarray::add_label_range(
+    unsigned dim_idx, const void* start, const void* end) {
+  if (dim_idx >= array_->array_schema_latest()->dim_num())
+    return LOG_STATUS(Status_SubarrayError(
+        "Cannot add label range; Invalid dimension index"));
+
+  if (start == nullptr || end == nullptr)
+    return LOG_STATUS(
+        Status_SubarrayError("Cannot add label range; Invalid range"));
+
+  Range range;
+  DimensionLabel label(array_, dim_idx);
+  RETURN_NOT_OK(label.index_range(start, end, &range));
+  return add_range(dim_idx, std::move(range), err_on_range_oob_);
+}
+
 Status Subarray::add_point_ranges(
-    unsigned dim_idx, const void* start, uint64_t count) {
+    unsigned dim_idx,
+    const void* start,
+    uint64_t count,
+    ThreadPool* const compute_tp) {
   if (dim_idx >= this->array_->array_schema_latest()->dim_num())
     return LOG_STATUS(
         Status_SubarrayError("Cannot add range; Invalid dimension index"));
@@ -308,6 +331,16 @@ Status Subarray::add_point_ranges(
     return LOG_STATUS(
         Status_SubarrayError("Cannot add range; Range must be fixed-sized"));
 
+  // Global order queries accept a single range, which the per-point path
+  // checks
+  if (compute_tp != nullptr && layout_ != Layout::GLOBAL_ORDER) {
+    bool added = false;
+    RETURN_NOT_OK(
+        add_point_ranges_bulk(dim_idx, start, count, compute_tp, &added));
+    if (added)
+      return Status::Ok();
+  }
+
   // Prepare a temp range
   std::vector<uint8_t> range;
   auto coord_size =
@@ -509,7 +542,7 @@ uint64_t Subarray::cell_num(uint64_t range_idx) const {
   unsigned dim_num = array_schema->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
   uint64_t tmp_idx = range_idx;
 
@@ -1388,7 +1421,7 @@ std::vector<uint64_t> Subarray::get_range_coords(uint64_t range_idx) const {
   auto dim_num = this->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
 
   if (layout == Layout::ROW_MAJOR) {
@@ -1405,8 +1438,8 @@ std::vector<uint64_t> Subarray::get_range_coords(uint64_t range_idx) const {
     }
     std::reverse(ret.begin(), ret.end());
   } else {
-    // Global order or Hilbert - single range
-    assert(layout == Layout::GLOBAL_ORDER || layout == Layout::HILBERT);
+    // Global order, Hilbert or Morton - single range
+    assert(layout == Layout::GLOBAL_ORDER || layout_is_curve(layout));
     assert(range_num() == 1);
     for (unsigned i = 0; i < dim_num; ++i)
       ret.push_back(0);
@@ -1420,7 +1453,7 @@ void Subarray::get_next_range_coords(
   auto dim_num = array_->array_schema_latest()->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
 
   if (layout == Layout::ROW_MAJOR) {
@@ -1480,7 +1513,7 @@ NDRange Subarray::ndrange(uint64_t range_idx) const {
   auto dim_num = this->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
   ret.reserve(dim_num);
 
@@ -1657,17 +1690,20 @@ Status Subarray::compute_relevant_fragment_est_result_sizes(
     uint64_t range_end,
     std::vector<std::vector<ResultSize>>* result_sizes,
     std::vector<std::vector<MemorySize>>* mem_sizes,
-    ThreadPool* const compute_tp) {
+    ThreadPool* const compute_tp,
+    std::vector<uint64_t>* const persisted_sizes) {
   // For easy reference
   auto array_schema = array_->array_schema_latest();
   auto fragment_metadata = array_->fragment_metadata();
   auto dim_num = array_->array_schema_latest()->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
 
   RETURN_NOT_OK(load_relevant_fragment_tile_var_sizes(names, compute_tp));
+  if (persisted_sizes != nullptr)
+    RETURN_NOT_OK(load_relevant_fragment_tile_offsets(names, compute_tp));
 
   // Prepare result sizes vectors
   auto range_num = range_end - range_start + 1;
@@ -1739,6 +1775,8 @@ Status Subarray::compute_relevant_fragment_est_result_sizes(
   mem_sizes->resize(range_num);
   for (auto& ms : *mem_sizes)
     ms.resize(names.size(), {0, 0, 0});
+  if (persisted_sizes != nullptr)
+    persisted_sizes->assign(range_num, 0);
   std::unordered_set<std::pair<unsigned, uint64_t>, utils::hash::pair_hash>
       all_frag_tiles;
   for (uint64_t r = 0; r < range_num; ++r) {
@@ -1771,6 +1809,13 @@ Status Subarray::compute_relevant_fragment_est_result_sizes(
               mem_vec[i].size_validity_ +=
                   *tile_var_size / cell_size * constants::cell_validity_size;
           }
+
+          if (persisted_sizes != nullptr) {
+            uint64_t persisted_size = 0;
+            RETURN_NOT_OK(persisted_tile_size(
+                meta.get(), names[i], ft.second, &persisted_size));
+            (*persisted_sizes)[r] += persisted_size;
+          }
         }
       }
     }
@@ -1779,6 +1824,82 @@ Status Subarray::compute_relevant_fragment_est_result_sizes(
   return Status::Ok();
 }
 
+Status Subarray::load_relevant_fragment_tile_offsets(
+    const std::vector<std::string>& names, ThreadPool* const compute_tp) const {
+  auto encryption_key = array_->encryption_key();
+  auto meta = array_->fragment_metadata();
+
+  return parallel_for(
+      compute_tp, 0, relevant_fragments_.size(), [&](const size_t i) {
+        auto f = relevant_fragments_[i];
+        auto schema = meta[f]->array_schema();
+
+        // Zipped coordinates are stored per dimension since version 5 and
+        // attributes added in schema evolution may not exist at all
+        std::vector<std::string> fragment_names;
+        fragment_names.reserve(names.size());
+        for (const auto& name : names) {
+          if (name == constants::coords) {
+            if (meta[f]->format_version() >= 5) {
+              for (const auto& dim_name : schema->dim_names())
+                fragment_names.emplace_back(dim_name);
+            }
+          } else if (schema->is_field(name)) {
+            fragment_names.emplace_back(name);
+          }
+        }
+
+        return meta[f]->load_tile_offsets(
+            *encryption_key, std::move(fragment_names));
+      });
+}
+
+Status Subarray::persisted_tile_size(
+    FragmentMetadata* const meta,
+    const std::string& name,
+    const uint64_t tid,
+    uint64_t* const size) const {
+  // Zipped coordinates are split into their dimensions since version 5
+  if (name == constants::coords && meta->format_version() >= 5) {
+    *size = 0;
+    for (const auto& dim_name : meta->array_schema()->dim_names()) {
+      uint64_t dim_size = 0;
+      RETURN_NOT_OK(persisted_tile_size(meta, dim_name, tid, &dim_size));
+      *size += dim_size;
+    }
+    return Status::Ok();
+  }
+
+  // Tile offsets are not loaded for zipped coordinates and are not stored
+  // for fragments older than version 3, so charge the in-memory size instead
+  if (meta->format_version() <= 2 || name == constants::coords) {
+    *size = meta->tile_size(name, tid);
+    if (meta->array_schema()->var_size(name)) {
+      auto&& [st, tile_var_size] = meta->tile_var_size(name, tid);
+      RETURN_NOT_OK(st);
+      *size += *tile_var_size;
+    }
+    return Status::Ok();
+  }
+
+  auto&& [st, tile_size] = meta->persisted_tile_size(name, tid);
+  RETURN_NOT_OK(st);
+  *size = *tile_size;
+  if (meta->array_schema()->var_size(name)) {
+    auto&& [st_var, tile_var_size] = meta->persisted_tile_var_size(name, tid);
+    RETURN_NOT_OK(st_var);
+    *size += *tile_var_size;
+  }
+  if (meta->array_schema()->is_nullable(name)) {
+    auto&& [st_val, tile_validity_size] =
+        meta->persisted_tile_validity_size(name, tid);
+    RETURN_NOT_OK(st_val);
+    *size += *tile_validity_size;
+  }
+
+  return Status::Ok();
+}
+
 std::unordered_map<std::string, Subarray::ResultSize>
 Subarray::get_est_result_size_map(
     const Config* const config, ThreadPool* const compute_tp) {
@@ -2063,7 +2184,7 @@ void Subarray::compute_range_offsets() {
   auto dim_num = this->dim_num();
   auto layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
 
   if (layout == Layout::COL_MAJOR) {
@@ -2083,8 +2204,8 @@ void Subarray::compute_range_offsets() {
     }
     std::reverse(range_offsets_.begin(), range_offsets_.end());
   } else {
-    // Global order or Hilbert - single range
-    assert(layout == Layout::GLOBAL_ORDER || layout == Layout::HILBERT);
+    // Global order, Hilbert or Morton - single range
+    assert(layout == Layout::GLOBAL_ORDER || layout_is_curve(layout));
     assert(range_num() == 1);
     range_offsets_.push_back(1);
     if (dim_num > 1) {
@@ -2203,6 +2324,166 @@ bool Subarray::est_result_size_computed() {
   return est_result_size_computed_;
 }
 
+Status Subarray::get_est_result_size_condition(
+    const char* name,
+    const QueryCondition& condition,
+    uint64_t* size_fixed,
+    uint64_t* size_var,
+    uint64_t* size_validity,
+    const Config* const config,
+    ThreadPool* const compute_tp) {
+  // Check attribute/dimension name
+  if (name == nullptr)
+    return logger_->status(
+        Status_SubarrayError("Cannot get estimated result size; "
+                             "Attribute/Dimension name cannot be null"));
+
+  // Check size pointers
+  if (size_fixed == nullptr || size_var == nullptr || size_validity == nullptr)
+    return logger_->status(Status_SubarrayError(
+        "Cannot get estimated result size; Input sizes cannot be null"));
+
+  // Check if attribute/dimension exists
+  const auto array_schema = array_->array_schema_latest();
+  if (name != constants::coords && !array_schema->is_dim(name) &&
+      !array_schema->is_attr(name))
+    return logger_->status(Status_SubarrayError(
+        std::string("Cannot get estimated result size; Attribute/Dimension '") +
+        name + "' does not exist"));
+
+  if (name == constants::coords &&
+      (!array_schema->domain()->all_dims_same_type() ||
+       !array_schema->domain()->all_dims_fixed()))
+    return logger_->status(Status_SubarrayError(
+        "Cannot get estimated result size; Not applicable to zipped "
+        "coordinates in arrays with heterogeneous or var-sized domains"));
+
+  if (array_->is_remote())
+    return logger_->status(Status_SubarrayError(
+        "Cannot get estimated result size; Query condition estimates are "
+        "unimplemented for remote arrays"));
+
+  // Compute tile overlap for each fragment
+  RETURN_NOT_OK(compute_est_result_size(config, compute_tp));
+  const auto& est = est_result_size_[name];
+
+  double selectivity = 1.0;
+  double selectivity_var = 1.0;
+  if (!condition.empty()) {
+    RETURN_NOT_OK(compute_condition_selectivity(
+        name, condition, compute_tp, &selectivity, &selectivity_var));
+  }
+
+  *size_fixed =
+      static_cast<uint64_t>(std::ceil(est.size_fixed_ * selectivity));
+  *size_var =
+      static_cast<uint64_t>(std::ceil(est.size_var_ * selectivity_var));
+  *size_validity =
+      static_cast<uint64_t>(std::ceil(est.size_validity_ * selectivity));
+
+  // If the size is non-zero, ensure it is large enough to contain at
+  // least one cell.
+  const bool var_size = array_schema->var_size(name);
+  const uint64_t cell_size = var_size ? constants::cell_var_offset_size :
+                                        array_schema->cell_size(name);
+  if (*size_fixed > 0 && *size_fixed < cell_size)
+    *size_fixed = cell_size;
+  if (var_size && *size_fixed > 0 && *size_var == 0)
+    *size_var = datatype_size(array_schema->type(name));
+  if (*size_validity > 0 && *size_validity < constants::cell_validity_size)
+    *size_validity = constants::cell_validity_size;
+
+  return Status::Ok();
+}
+
+Status Subarray::compute_condition_selectivity(
+    const std::string& name,
+    const QueryCondition& condition,
+    ThreadPool* const compute_tp,
+    double* selectivity,
+    double* selectivity_var) {
+  auto timer_se = stats_->start_timer("compute_condition_selectivity");
+  auto encryption_key = array_->encryption_key();
+  auto meta = array_->fragment_metadata();
+  const bool var_size = array_->array_schema_latest()->var_size(name);
+  const uint64_t range_num = this->range_num();
+
+  // The selected and total weights of the tiles of each relevant fragment
+  struct Weights {
+    double selected_ = 0.0;
+    double total_ = 0.0;
+    double selected_var_ = 0.0;
+    double total_var_ = 0.0;
+  };
+  std::vector<Weights> weights(relevant_fragments_.size());
+
+  auto status = parallel_for(
+      compute_tp, 0, relevant_fragments_.size(), [&](const size_t i) {
+        auto f = relevant_fragments_[i];
+        auto fragment = meta[f].get();
+
+        // Load the tile metadata the condition can be evaluated on
+        std::vector<std::string> min_names;
+        std::vector<std::string> null_count_names;
+        condition.tile_metadata_names(fragment, &min_names, &null_count_names);
+        auto max_names = min_names;
+        RETURN_NOT_OK(fragment->load_tile_min_values(
+            *encryption_key, std::move(min_names)));
+        RETURN_NOT_OK(fragment->load_tile_max_values(
+            *encryption_key, std::move(max_names)));
+        RETURN_NOT_OK(fragment->load_tile_null_count_values(
+            *encryption_key, std::move(null_count_names)));
+        if (!fragment->dense())
+          RETURN_NOT_OK(fragment->load_attribute_index(*encryption_key));
+
+        const bool has_var =
+            var_size && fragment->array_schema()->is_field(name);
+        auto add_tile = [&](uint64_t tid, double ratio) -> Status {
+          auto&& [st, tile_sel] = condition.tile_selectivity(fragment, tid);
+          RETURN_NOT_OK(st);
+          const double cells = ratio * fragment->cell_num(tid);
+          weights[i].total_ += cells;
+          weights[i].selected_ += cells * *tile_sel;
+          if (has_var) {
+            auto&& [st_var, tile_var_size] = fragment->tile_var_size(name, tid);
+            RETURN_NOT_OK(st_var);
+            const double bytes = ratio * *tile_var_size;
+            weights[i].total_var_ += bytes;
+            weights[i].selected_var_ += bytes * *tile_sel;
+          }
+          return Status::Ok();
+        };
+
+        for (uint64_t r = 0; r < range_num; ++r) {
+          const TileOverlap* const overlap =
+              tile_overlap_.at(f, r - tile_overlap_.range_idx_start());
+          for (const auto& tr : overlap->tile_ranges_) {
+            for (uint64_t tid = tr.first; tid <= tr.second; ++tid)
+              RETURN_NOT_OK(add_tile(tid, 1.0));
+          }
+          for (const auto& t : overlap->tiles_)
+            RETURN_NOT_OK(add_tile(t.first, t.second));
+        }
+
+        return Status::Ok();
+      });
+  RETURN_NOT_OK(status);
+
+  Weights sum;
+  for (const auto& w : weights) {
+    sum.selected_ += w.selected_;
+    sum.total_ += w.total_;
+    sum.selected_var_ += w.selected_var_;
+    sum.total_var_ += w.total_var_;
+  }
+
+  *selectivity = sum.total_ > 0 ? sum.selected_ / sum.total_ : 1.0;
+  *selectivity_var =
+      sum.total_var_ > 0 ? sum.selected_var_ / sum.total_var_ : *selectivity;
+
+  return Status::Ok();
+}
+
 Status Subarray::compute_relevant_fragment_est_result_sizes(
     const ArraySchema* array_schema,
     bool all_dims_same_type,
@@ -2503,6 +2784,26 @@ Status Subarray::precompute_tile_overlap(
       "sm.max_tile_overlap_size", &max_tile_overlap_size, &found));
   assert(found);
 
+  // Reuse the tile overlap computed by an earlier query with the same
+  // ranges on the opened array, if any.
+  auto cache = array_->tile_overlap_cache();
+  std::string cache_key;
+  if (cache != nullptr) {
+    cache_key = tile_overlap_cache_key(
+        start_range_idx,
+        end_range_idx,
+        max_tile_overlap_size,
+        override_memory_constraint || fragment_num == 0);
+    bool cache_hit = false;
+    RETURN_NOT_OK(cache->read(
+        cache_key, &tile_overlap_, &relevant_fragments_, &cache_hit));
+    if (cache_hit) {
+      stats_->add_counter(
+          "precompute_tile_overlap.tile_overlap_lru_cache_hit", 1);
+      return load_relevant_fragment_rtrees(compute_tp);
+    }
+  }
+
   uint64_t tile_overlap_start = start_range_idx;
   uint64_t tile_overlap_end = end_range_idx;
 
@@ -2546,6 +2847,10 @@ Status Subarray::precompute_tile_overlap(
     tile_overlap.expand(tmp_tile_overlap_end);
   } while (true);
 
+  if (cache != nullptr)
+    RETURN_NOT_OK(
+        cache->insert(cache_key, tile_overlap_, relevant_fragments_));
+
   stats_->add_counter("precompute_tile_overlap.fragment_num", fragment_num);
   stats_->add_counter(
       "precompute_tile_overlap.relevant_fragment_num",
@@ -2562,8 +2867,7 @@ Status Subarray::precompute_tile_overlap(
 
 Status Subarray::precompute_all_ranges_tile_overlap(
     ThreadPool* const compute_tp,
-    std::vector<std::vector<std::pair<uint64_t, uint64_t>>>*
-        result_tile_ranges) {
+    std::vector<TileRanges>* result_tile_ranges) {
   auto timer_se = stats_->start_timer("read_compute_simple_tile_overlap");
 
   // For easy reference.
@@ -2593,6 +2897,13 @@ Status Subarray::precompute_all_ranges_tile_overlap(
   auto status =
       parallel_for(compute_tp, 0, relevant_fragments_.size(), [&](uint64_t i) {
         const auto f = relevant_fragments_[i];
+
+        // Skip the fragment if it cannot contain the single point queried
+        if (is_unary() && !meta[f]->may_contain_point(ndrange(0))) {
+          stats_->add_counter("bloom_filter_skip_num", 1);
+          return Status::Ok();
+        }
+
         auto tile_bitmaps_resource_guard =
             ResourceGuard(all_threads_tile_bitmaps);
         auto tile_bitmaps = tile_bitmaps_resource_guard.get();
@@ -2635,11 +2946,12 @@ Status Subarray::precompute_all_ranges_tile_overlap(
           RETURN_NOT_OK(status_ranges);
         }
 
-        // Go through the bitmaps in reverse, whenever there is a "hole" in tile
-        // contiguity, push a new result tile range.
-        uint64_t end = tile_bitmaps[0].size() - 1;
+        // Go through the bitmaps, whenever there is a "hole" in tile
+        // contiguity, add a new result tile range.
+        auto& tile_ranges = result_tile_ranges->at(f);
+        uint64_t start = 0;
         uint64_t length = 0;
-        for (int64_t t = tile_bitmaps[0].size() - 1; t >= 0; t--) {
+        for (uint64_t t = 0; t < tile_bitmaps[0].size(); t++) {
           bool comb = true;
           for (unsigned d = 0; d < dim_num; d++) {
             comb &= (bool)tile_bitmaps[d][t];
@@ -2647,19 +2959,20 @@ Status Subarray::precompute_all_ranges_tile_overlap(
 
           if (!comb) {
             if (length != 0) {
-              result_tile_ranges->at(f).emplace_back(end + 1 - length, end);
+              tile_ranges.add_range(start, start + length - 1);
               length = 0;
             }
 
-            end = t - 1;
+            start = t + 1;
           } else {
             length++;
           }
         }
 
-        // Push the last result tile range.
+        // Add the last result tile range.
         if (length != 0)
-          result_tile_ranges->at(f).emplace_back(end + 1 - length, end);
+          tile_ranges.add_range(start, start + length - 1);
+        tile_ranges.shrink_to_fit();
 
         return Status::Ok();
       });
@@ -2668,6 +2981,39 @@ Status Subarray::precompute_all_ranges_tile_overlap(
   return Status::Ok();
 }
 
+std::string Subarray::tile_overlap_cache_key(
+    const uint64_t start_range_idx,
+    const uint64_t end_range_idx,
+    const uint64_t max_tile_overlap_size,
+    const bool override_memory_constraint) const {
+  std::string key;
+  auto append = [&key](const void* data, uint64_t size) {
+    key.append(static_cast<const char*>(data), size);
+  };
+
+  // The layouts determine the order of the ranges
+  append(&layout_, sizeof(layout_));
+  append(&cell_order_, sizeof(cell_order_));
+  append(&start_range_idx, sizeof(start_range_idx));
+  append(&end_range_idx, sizeof(end_range_idx));
+  append(&max_tile_overlap_size, sizeof(max_tile_overlap_size));
+  append(&override_memory_constraint, sizeof(override_memory_constraint));
+
+  for (const auto& dim_ranges : ranges_) {
+    uint64_t range_num = dim_ranges.size();
+    append(&range_num, sizeof(range_num));
+    for (const auto& range : dim_ranges) {
+      uint64_t size = range.size();
+      uint64_t start_size = range.start_size();
+      append(&size, sizeof(size));
+      append(&start_size, sizeof(start_size));
+      append(range.data(), size);
+    }
+  }
+
+  return key;
+}
+
 Subarray Subarray::clone() const {
   Subarray clone;
   clone.stats_ = stats_;
@@ -2926,10 +3272,10 @@ void Subarray::get_expanded_coordinates(
   // layouts. We will treat unordered layouts as the cell layout.
   const Layout coords_layout =
       (layout_ == Layout::UNORDERED) ?
-          ((cell_order_ == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order_) :
+          (layout_is_curve(cell_order_) ? Layout::ROW_MAJOR : cell_order_) :
           layout_;
   if (coords_layout == Layout::GLOBAL_ORDER ||
-      coords_layout == Layout::HILBERT) {
+      layout_is_curve(coords_layout)) {
     assert(*start_coords == *end_coords);
     return;
   }
@@ -2992,6 +3338,15 @@ Status Subarray::compute_relevant_fragments_for_dim(
     const std::vector<uint64_t>& start_coords,
     const std::vector<uint64_t>& end_coords,
     std::vector<uint8_t>* const frag_bytemap) const {
+  // With many fragments, look the ranges up in the index over the
+  // fragment non-empty domains instead of testing every fragment.
+  const FragmentDomainIndex* const index = array_->fragment_domain_index();
+  if (index != nullptr && index->indexed(dim_idx)) {
+    for (uint64_t r = start_coords[dim_idx]; r <= end_coords[dim_idx]; ++r)
+      index->mark_overlapping(dim_idx, ranges_[dim_idx][r], frag_bytemap);
+    return Status::Ok();
+  }
+
   const auto meta = array_->fragment_metadata();
   const Dimension* const dim =
       array_->array_schema_latest()->dimension(dim_idx);
@@ -3027,15 +3382,31 @@ Status Subarray::load_relevant_fragment_rtrees(
   auto meta = array_->fragment_metadata();
   auto encryption_key = array_->encryption_key();
 
+  const bool points = all_ranges_unary();
   auto status =
       parallel_for(compute_tp, 0, relevant_fragments_.size(), [&](uint64_t f) {
-        return meta[relevant_fragments_[f]]->load_rtree(*encryption_key);
+        auto& frag_meta = meta[relevant_fragments_[f]];
+        RETURN_NOT_OK(frag_meta->load_rtree(*encryption_key));
+        if (points)
+          RETURN_NOT_OK(frag_meta->load_coords_bloom_filter(*encryption_key));
+        return Status::Ok();
       });
   RETURN_NOT_OK(status);
 
   return Status::Ok();
 }
 
+bool Subarray::all_ranges_unary() const {
+  for (const auto& dim_ranges : ranges_) {
+    for (const auto& range : dim_ranges) {
+      if (!range.unary())
+        return false;
+    }
+  }
+
+  return true;
+}
+
 Status Subarray::compute_relevant_fragment_tile_overlap(
     ThreadPool* const compute_tp,
     SubarrayTileOverlap* const tile_overlap,
@@ -3070,6 +3441,30 @@ Status Subarray::compute_relevant_fragment_tile_overlap(
   const auto num_threads = compute_tp->concurrency_level();
   const auto range_num = fn_ctx->range_len_;
 
+  // Sparse fragments compute the overlap of all the ranges with a single
+  // traversal of the R-tree
+  if (!dense) {
+    if (range_num == 0)
+      return Status::Ok();
+
+    std::vector<NDRange> ranges(range_num);
+    auto status = parallel_for(compute_tp, 0, range_num, [&](uint64_t r) {
+      ranges[r] = this->ndrange(
+          fn_ctx->range_idx_offset_ + r + tile_overlap->range_idx_start());
+      return Status::Ok();
+    });
+    RETURN_NOT_OK(status);
+
+    std::vector<TileOverlap> overlaps;
+    RETURN_NOT_OK(meta->get_tile_overlap(ranges, compute_tp, &overlaps));
+    for (uint64_t r = 0; r < range_num; ++r) {
+      *tile_overlap->at(frag_idx, fn_ctx->range_idx_offset_ + r) =
+          std::move(overlaps[r]);
+    }
+
+    return Status::Ok();
+  }
+
   const auto ranges_per_thread =
       (uint64_t)std::ceil((double)range_num / num_threads);
   const auto status = parallel_for(compute_tp, 0, num_threads, [&](uint64_t t) {
@@ -3077,14 +3472,8 @@ Status Subarray::compute_relevant_fragment_tile_overlap(
     const auto r_end = fn_ctx->range_idx_offset_ +
                        std::min((t + 1) * ranges_per_thread - 1, range_num - 1);
     for (uint64_t r = r_start; r <= r_end; ++r) {
-      if (dense) {  // Dense fragment
-        *tile_overlap->at(frag_idx, r) =
-            compute_tile_overlap(r + tile_overlap->range_idx_start(), frag_idx);
-      } else {  // Sparse fragment
-        const auto& range = this->ndrange(r + tile_overlap->range_idx_start());
-        RETURN_NOT_OK(
-            meta->get_tile_overlap(range, tile_overlap->at(frag_idx, r)));
-      }
+      *tile_overlap->at(frag_idx, r) =
+          compute_tile_overlap(r + tile_overlap->range_idx_start(), frag_idx);
     }
 
     return Status::Ok();
@@ -3148,6 +3537,11 @@ template <typename T>
 Status Subarray::sort_ranges_for_dim(
     ThreadPool* const compute_tp, const uint64_t& dim_idx) {
   auto& ranges = ranges_[dim_idx];
+  if constexpr (std::is_integral<T>::value) {
+    if (ranges.size() >= constants::range_radix_sort_min_num)
+      return radix_sort_ranges_for_dim<T>(compute_tp, dim_idx);
+  }
+
   parallel_sort(
       compute_tp,
       ranges.begin(),
@@ -3241,6 +3635,267 @@ Status Subarray::sort_ranges_for_dim(
   return Status::Ok();
 }
 
+template <typename T>
+Status Subarray::radix_sort_ranges_for_dim(
+    ThreadPool* const compute_tp, const uint64_t dim_idx) {
+  typedef typename std::make_unsigned<T>::type U;
+  auto& ranges = ranges_[dim_idx];
+  const uint64_t range_num = ranges.size();
+  if (range_num < 2)
+    return Status::Ok();
+
+  // Flipping the sign bit maps signed bounds to unsigned keys with the
+  // same order
+  const U sign_flip =
+      std::is_signed<T>::value ? (U)((U)1 << (8 * sizeof(U) - 1)) : (U)0;
+  struct Key {
+    U start_;
+    U end_;
+    uint64_t idx_;
+  };
+  std::vector<Key> keys(range_num);
+  std::vector<Key> tmp(range_num);
+
+  // Every thread works on a contiguous chunk of the ranges
+  const uint64_t chunk_num =
+      std::min<uint64_t>(compute_tp->concurrency_level(), range_num);
+  const uint64_t chunk_size = (range_num + chunk_num - 1) / chunk_num;
+  auto chunk_end = [&](uint64_t c) {
+    return std::min((c + 1) * chunk_size, range_num);
+  };
+
+  auto st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+    for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i) {
+      auto r = static_cast<const T*>(ranges[i].data());
+      keys[i] = {(U)((U)r[0] ^ sign_flip), (U)((U)r[1] ^ sign_flip), i};
+    }
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(st);
+
+  // Sort by the bytes of the ends first and of the starts last, from the
+  // least to the most significant
+  std::vector<std::array<uint64_t, 256>> hist(chunk_num);
+  for (unsigned pass = 0; pass < 2 * sizeof(U); ++pass) {
+    const bool by_end = pass < sizeof(U);
+    const unsigned shift = 8 * (pass % sizeof(U));
+    auto digit = [&](const Key& k) {
+      return (uint8_t)((uint64_t)(by_end ? k.end_ : k.start_) >> shift);
+    };
+
+    st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+      hist[c].fill(0);
+      for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i)
+        ++hist[c][digit(keys[i])];
+      return Status::Ok();
+    });
+    RETURN_NOT_OK(st);
+
+    // Skip the pass if all the keys have the same digit
+    const auto first_digit = digit(keys[0]);
+    uint64_t first_digit_num = 0;
+    for (uint64_t c = 0; c < chunk_num; ++c)
+      first_digit_num += hist[c][first_digit];
+    if (first_digit_num == range_num)
+      continue;
+
+    // Turn the histograms into output offsets. For a digit, the chunks
+    // are laid out in order so that the sort is stable.
+    uint64_t offset = 0;
+    for (unsigned d = 0; d < 256; ++d) {
+      for (uint64_t c = 0; c < chunk_num; ++c) {
+        auto num = hist[c][d];
+        hist[c][d] = offset;
+        offset += num;
+      }
+    }
+
+    st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+      for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i)
+        tmp[hist[c][digit(keys[i])]++] = keys[i];
+      return Status::Ok();
+    });
+    RETURN_NOT_OK(st);
+    keys.swap(tmp);
+  }
+
+  // Move the ranges to their sorted positions
+  std::vector<Range> sorted(range_num);
+  st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+    for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i)
+      sorted[i] = std::move(ranges[keys[i].idx_]);
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(st);
+  ranges.swap(sorted);
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status Subarray::add_point_ranges_bulk(
+    const unsigned dim_idx,
+    const T* const points,
+    const uint64_t count,
+    ThreadPool* const compute_tp,
+    bool* const added) {
+  *added = false;
+  if (count == 0) {
+    *added = true;
+    return Status::Ok();
+  }
+
+  // Every thread works on a contiguous chunk of the points
+  const uint64_t chunk_num =
+      std::min<uint64_t>(compute_tp->concurrency_level(), count);
+  const uint64_t chunk_size = (count + chunk_num - 1) / chunk_num;
+  auto chunk_end = [&](uint64_t c) {
+    return std::min((c + 1) * chunk_size, count);
+  };
+
+  // Out-of-bounds points are reported or clamped by the per-point path
+  auto dim = array_->array_schema_latest()->dimension(dim_idx);
+  auto domain = static_cast<const T*>(dim->domain().data());
+  std::atomic<bool> in_domain = true;
+  auto st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+    for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i) {
+      if (points[i] < domain[0] || points[i] > domain[1]) {
+        in_domain = false;
+        break;
+      }
+    }
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(st);
+  if (!in_domain)
+    return Status::Ok();
+
+  // Find where the runs of consecutive points start. This coalesces the
+  // points exactly like adding them one by one would.
+  std::vector<std::vector<uint64_t>> run_starts(chunk_num);
+  st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+    for (uint64_t i = c * chunk_size; i < chunk_end(c); ++i) {
+      if (i == 0 || !coalesce_ranges_ ||
+          points[i - 1] == std::numeric_limits<T>::max() ||
+          points[i - 1] + 1 != points[i])
+        run_starts[c].push_back(i);
+    }
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(st);
+
+  // Create one range per run
+  std::vector<uint64_t> run_offsets(chunk_num + 1, 0);
+  for (uint64_t c = 0; c < chunk_num; ++c)
+    run_offsets[c + 1] = run_offsets[c] + run_starts[c].size();
+  std::vector<Range> runs(run_offsets[chunk_num]);
+  st = parallel_for(compute_tp, 0, chunk_num, [&](uint64_t c) {
+    for (uint64_t r = 0; r < run_starts[c].size(); ++r) {
+      // A run ends before the start of the next one, which may be the
+      // first run of a later chunk
+      uint64_t next = count;
+      if (r + 1 < run_starts[c].size()) {
+        next = run_starts[c][r + 1];
+      } else {
+        for (auto n = c + 1; n < chunk_num; ++n) {
+          if (!run_starts[n].empty()) {
+            next = run_starts[n][0];
+            break;
+          }
+        }
+      }
+
+      const T bounds[2] = {points[run_starts[c][r]], points[next - 1]};
+      runs[run_offsets[c] + r].set_range(bounds, sizeof(bounds));
+    }
+    return Status::Ok();
+  });
+  RETURN_NOT_OK(st);
+
+  // Must reset the result size and tile overlap
+  est_result_size_computed_ = false;
+  tile_overlap_.clear();
+
+  // Remove the default range
+  if (is_default_[dim_idx]) {
+    ranges_[dim_idx].clear();
+    is_default_[dim_idx] = false;
+  }
+
+  // Only the first run may coalesce with the ranges already added
+  auto& ranges = ranges_[dim_idx];
+  ranges.reserve(ranges.size() + runs.size());
+  add_or_coalesce_range_func_[dim_idx](this, dim_idx, runs[0]);
+  ranges.insert(
+      ranges.end(),
+      std::make_move_iterator(runs.begin() + 1),
+      std::make_move_iterator(runs.end()));
+
+  *added = true;
+  return Status::Ok();
+}
+
+Status Subarray::add_point_ranges_bulk(
+    const unsigned dim_idx,
+    const void* const points,
+    const uint64_t count,
+    ThreadPool* const compute_tp,
+    bool* const added) {
+  *added = false;
+  const Datatype type =
+      array_->array_schema_latest()->dimension(dim_idx)->type();
+  switch (type) {
+    case Datatype::INT8:
+      return add_point_ranges_bulk<int8_t>(
+          dim_idx, (const int8_t*)points, count, compute_tp, added);
+    case Datatype::UINT8:
+      return add_point_ranges_bulk<uint8_t>(
+          dim_idx, (const uint8_t*)points, count, compute_tp, added);
+    case Datatype::INT16:
+      return add_point_ranges_bulk<int16_t>(
+          dim_idx, (const int16_t*)points, count, compute_tp, added);
+    case Datatype::UINT16:
+      return add_point_ranges_bulk<uint16_t>(
+          dim_idx, (const uint16_t*)points, count, compute_tp, added);
+    case Datatype::INT32:
+      return add_point_ranges_bulk<int32_t>(
+          dim_idx, (const int32_t*)points, count, compute_tp, added);
+    case Datatype::UINT32:
+      return add_point_ranges_bulk<uint32_t>(
+          dim_idx, (const uint32_t*)points, count, compute_tp, added);
+    case Datatype::INT64:
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+    case Datatype::TIME_HR:
+    case Datatype::TIME_MIN:
+    case Datatype::TIME_SEC:
+    case Datatype::TIME_MS:
+    case Datatype::TIME_US:
+    case Datatype::TIME_NS:
+    case Datatype::TIME_PS:
+    case Datatype::TIME_FS:
+    case Datatype::TIME_AS:
+      return add_point_ranges_bulk<int64_t>(
+          dim_idx, (const int64_t*)points, count, compute_tp, added);
+    case Datatype::UINT64:
+      return add_point_ranges_bulk<uint64_t>(
+          dim_idx, (const uint64_t*)points, count, compute_tp, added);
+    default:
+      return Status::Ok();
+  }
+}
+
 template <typename T>
 std::tuple<Status, std::optional<bool>>
 Subarray::non_overlapping_ranges_for_dim(const uint64_t dim_idx) {
@@ -41,6 +41,7 @@
 #include "tiledb/sm/config/config.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/misc/tile_overlap.h"
+#include "tiledb/sm/misc/tile_ranges.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/stats/stats.h"
 #include "tiledb/sm/subarray/subarray_tile_overlap.h"
@@ -62,6 +63,7 @@ class Array;
 class ArraySchema;
 class EncryptionKey;
 class FragmentMetadata;
+class QueryCondition;
 class StorageManager;
 
 enum class Layout : uint8_t;
@@ -257,12 +259,35 @@ class Subarray {
   /**
    * @brief Set point ranges from an array
    *
+   * For integer dimensions, the points are coalesced into ranges of
+   * consecutive values in bulk, in parallel on `compute_tp` if it is
+   * given. A range is only created per coalesced run, so sorted points
+   * are the cheapest to add.
+   *
    * @param dim_idx Dimension index
    * @param start Pointer to start of the array
    * @param count Number of elements to add
+   * @param compute_tp The thread pool for the bulk path, or `nullptr`
+   * @return Status
+   */
+  Status add_point_ranges(
+      unsigned dim_idx,
+      const void* start,
+      uint64_t count,
+      ThreadPool* compute_tp = nullptr);
+
+  /**
+   * Adds a range of labels along the dimension with the given index. The
+   * label range is translated to the range of the dimension indices whose
+   * labels are within `[start, end]` by searching the label array of the
+   * dimension (see `DimensionLabel`), and the index range is added.
+   *
+   * @param dim_idx The index of the labeled dimension.
+   * @param start The start label, of the type of the labels.
+   * @param end The end label, of the type of the labels.
    * @return Status
    */
-  Status add_point_ranges(unsigned dim_idx, const void* start, uint64_t count);
+  Status add_label_range(unsigned dim_idx, const void* start, const void* end);
 
   /**
    * Adds a variable-sized range to the (read/write) query on the input
@@ -427,12 +452,11 @@ class Subarray {
    * Precomputes the tile overlap with all subarray ranges for all fragments.
    *
    * @param compute_tp The compute thread pool.
-   * @param result_tile_ranges The resulting tile ranges.
+   * @param result_tile_ranges The resulting tile ranges, per fragment.
    */
   Status precompute_all_ranges_tile_overlap(
       ThreadPool* const compute_tp,
-      std::vector<std::vector<std::pair<uint64_t, uint64_t>>>*
-          result_tile_ranges);
+      std::vector<TileRanges>* result_tile_ranges);
 
   /**
    * Computes the estimated result size (calibrated using the maximum size)
@@ -641,6 +665,24 @@ class Subarray {
       const Config* config,
       ThreadPool* compute_tp);
 
+  /**
+   * Gets the estimated result sizes (in bytes) for the input
+   * attribute/dimension, scaled by the fraction of cells estimated to
+   * satisfy the input query condition. The fraction is derived per tile
+   * from the tile min/max and null count metadata and the attribute value
+   * index, weighted by the bytes each tile contributes to the estimate.
+   * `size_var` and `size_validity` are set to zero for fixed-sized and
+   * non-nullable fields, respectively.
+   */
+  Status get_est_result_size_condition(
+      const char* name,
+      const QueryCondition& condition,
+      uint64_t* size_fixed,
+      uint64_t* size_var,
+      uint64_t* size_validity,
+      const Config* config,
+      ThreadPool* compute_tp);
+
   /** returns whether the estimated result size has been computed or not */
   bool est_result_size_computed();
 
@@ -869,6 +911,11 @@ class Subarray {
    * the **unique** bytes that the correpsonding range contributes to
    * the maximum memory size for all ranges (i.e., based on whether
    * it overlaps a unique tile versus all previous ranges in the vector).
+   *
+   * If `persisted_sizes` is not null, it receives one value per range with
+   * the persisted (i.e., filtered and possibly compressed) bytes of those
+   * same unique tiles across all the input names. The tile offsets of the
+   * relevant fragments are loaded for this purpose.
    */
   Status compute_relevant_fragment_est_result_sizes(
       const std::vector<std::string>& names,
@@ -876,7 +923,8 @@ class Subarray {
       uint64_t range_end,
       std::vector<std::vector<ResultSize>>* result_sizes,
       std::vector<std::vector<MemorySize>>* mem_sizes,
-      ThreadPool* compute_tp);
+      ThreadPool* compute_tp,
+      std::vector<uint64_t>* persisted_sizes = nullptr);
 
   /**
    * Used by serialization to set the estimated result size
@@ -1169,6 +1217,25 @@ class Subarray {
   template <class T>
   TileOverlap compute_tile_overlap(uint64_t range_idx, unsigned fid) const;
 
+  /**
+   * Returns the key of the tile overlap computed by
+   * `precompute_tile_overlap` in the tile overlap cache of the array. It
+   * encodes the layouts and ranges of the subarray, along with the
+   * arguments of `precompute_tile_overlap` that determine the result.
+   * The fragments are implied by the array owning the cache.
+   *
+   * @param start_range_idx The start range index.
+   * @param end_range_idx The end range index.
+   * @param max_tile_overlap_size The maximum tile overlap size.
+   * @param override_memory_constraint Whether the memory budget is ignored.
+   * @return The cache key.
+   */
+  std::string tile_overlap_cache_key(
+      uint64_t start_range_idx,
+      uint64_t end_range_idx,
+      uint64_t max_tile_overlap_size,
+      bool override_memory_constraint) const;
+
   /**
    * Swaps the contents (all field values) of this subarray with the
    * given subarray.
@@ -1208,9 +1275,15 @@ class Subarray {
       const std::vector<uint64_t>& end_coords,
       std::vector<uint8_t>* frag_bytemap) const;
 
-  /** Loads the R-Trees of all relevant fragments in parallel. */
+  /**
+   * Loads the R-Trees of all relevant fragments in parallel. If every range
+   * is a single point, it also loads the fragment coordinates Bloom filters.
+   */
   Status load_relevant_fragment_rtrees(ThreadPool* compute_tp) const;
 
+  /** Returns `true` if all the ranges on every dimension are unary. */
+  bool all_ranges_unary() const;
+
   /**
    * Computes the tile overlap for each range and relevant fragment.
    *
@@ -1251,6 +1324,37 @@ class Subarray {
   Status load_relevant_fragment_tile_var_sizes(
       const std::vector<std::string>& names, ThreadPool* compute_tp) const;
 
+  /**
+   * Loads the tile offsets for the input names from the relevant
+   * fragments, so that their persisted tile sizes can be retrieved.
+   */
+  Status load_relevant_fragment_tile_offsets(
+      const std::vector<std::string>& names, ThreadPool* compute_tp) const;
+
+  /**
+   * Computes the fraction of the cells of the tiles overlapping all ranges
+   * that are estimated to satisfy the input condition, weighted by cell
+   * count (`selectivity`) and, for var-sized fields, by the var-sized tile
+   * sizes of `name` (`selectivity_var`). Assumes the tile overlap of all
+   * ranges has been computed.
+   */
+  Status compute_condition_selectivity(
+      const std::string& name,
+      const QueryCondition& condition,
+      ThreadPool* compute_tp,
+      double* selectivity,
+      double* selectivity_var);
+
+  /**
+   * Retrieves the persisted size of tile `tid` of `name` in the input
+   * fragment, summed over its fixed, var and validity tiles.
+   */
+  Status persisted_tile_size(
+      FragmentMetadata* meta,
+      const std::string& name,
+      uint64_t tid,
+      uint64_t* size) const;
+
   /**
    * Constructs `add_or_coalesce_range_func_` for all dimensions
    * in `array_->array_schema_latest()`.
@@ -1287,6 +1391,54 @@ class Subarray {
   Status sort_ranges_for_dim(
       ThreadPool* const compute_tp, const uint64_t& dim_idx);
 
+  /**
+   * Sort ranges for a particular integer dimension with a parallel, stable
+   * LSD radix sort on the (start, end) bounds. The passes whose byte is
+   * the same for all the ranges are skipped.
+   *
+   * @tparam T dimension type
+   * @param compute_tp threadpool for the histograms and scatters
+   * @param dim_idx dimension index to sort
+   * @return Status
+   */
+  template <typename T>
+  Status radix_sort_ranges_for_dim(
+      ThreadPool* const compute_tp, const uint64_t dim_idx);
+
+  /**
+   * Adds point ranges to an integer dimension in bulk. The runs of
+   * consecutive points are found in parallel and each becomes one range,
+   * unless coalescing is disabled. Sets `added` to `false` without adding
+   * anything if a point is out of the dimension domain, so that the caller
+   * can fall back to adding the points one by one.
+   *
+   * @tparam T dimension type
+   * @param dim_idx dimension index
+   * @param points the points to add
+   * @param count the number of points
+   * @param compute_tp the thread pool
+   * @param added set to `true` if the points were added
+   * @return Status
+   */
+  template <typename T>
+  Status add_point_ranges_bulk(
+      unsigned dim_idx,
+      const T* points,
+      uint64_t count,
+      ThreadPool* compute_tp,
+      bool* added);
+
+  /**
+   * Dispatches `add_point_ranges_bulk` on the dimension type. Sets `added`
+   * to `false` for non-integer dimensions.
+   */
+  Status add_point_ranges_bulk(
+      unsigned dim_idx,
+      const void* points,
+      uint64_t count,
+      ThreadPool* compute_tp,
+      bool* added);
+
   /**
    * Sort ranges for a particular dimension
    *
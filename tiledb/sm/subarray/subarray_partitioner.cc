@@ -40,6 +40,7 @@
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/math.h"
+#include "tiledb/sm/misc/space_filling_curve.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/stats/global_stats.h"
 
@@ -88,6 +89,14 @@ SubarrayPartitioner::SubarrayPartitioner(
   bool found = false;
   config_->get<bool>(
       "sm.skip_est_size_partitioning", &skip_split_on_est_size_, &found);
+  assert(found);
+  config_->get<double>("sm.partitioner.target_cost", &target_cost_, &found);
+  assert(found);
+  config_->get<double>(
+      "sm.partitioner.io_cost_per_byte", &io_cost_per_byte_, &found);
+  assert(found);
+  config_->get<double>(
+      "sm.partitioner.cpu_cost_per_byte", &cpu_cost_per_byte_, &found);
   (void)found;
   assert(found);
 }
@@ -674,7 +683,7 @@ Status SubarrayPartitioner::calibrate_current_start_end(bool* must_split_slab) {
 
   auto layout = subarray_.layout();
   auto cell_order = subarray_.array()->array_schema_latest()->cell_order();
-  cell_order = (cell_order == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order;
+  cell_order = layout_is_curve(cell_order) ? Layout::ROW_MAJOR : cell_order;
   layout = (layout == Layout::UNORDERED) ? cell_order : layout;
   assert(layout == Layout::ROW_MAJOR || layout == Layout::COL_MAJOR);
 
@@ -757,6 +766,9 @@ SubarrayPartitioner SubarrayPartitioner::clone() const {
   clone.memory_budget_var_ = memory_budget_var_;
   clone.memory_budget_validity_ = memory_budget_validity_;
   clone.skip_split_on_est_size_ = skip_split_on_est_size_;
+  clone.target_cost_ = target_cost_;
+  clone.io_cost_per_byte_ = io_cost_per_byte_;
+  clone.cpu_cost_per_byte_ = cpu_cost_per_byte_;
   clone.compute_tp_ = compute_tp_;
 
   return clone;
@@ -791,20 +803,40 @@ Status SubarrayPartitioner::compute_current_start_end(bool* found) {
   // Compute the estimated result sizes
   std::vector<std::vector<Subarray::ResultSize>> result_sizes;
   std::vector<std::vector<Subarray::MemorySize>> memory_sizes;
+  std::vector<uint64_t> persisted_sizes;
+  const bool use_cost = target_cost_ > 0;
   RETURN_NOT_OK(subarray_.compute_relevant_fragment_est_result_sizes(
       names,
       tile_overlap->range_idx_start(),
       tile_overlap->range_idx_end(),
       &result_sizes,
       &memory_sizes,
-      compute_tp_));
+      compute_tp_,
+      use_cost ? &persisted_sizes : nullptr));
 
   bool done = false;
+  double cur_cost = 0;
   current_.start_ = tile_overlap->range_idx_start();
   for (current_.end_ = tile_overlap->range_idx_start();
        current_.end_ <= tile_overlap->range_idx_end();
        ++current_.end_) {
     size_t r = current_.end_ - tile_overlap->range_idx_start();
+
+    // Charge the I/O of the new persisted tiles of this range and the
+    // unfiltering of their in-memory bytes. A single range is never
+    // rejected on cost, as it cannot be split any further here.
+    if (use_cost) {
+      uint64_t unfiltered_size = 0;
+      for (const auto& ms : memory_sizes[r])
+        unfiltered_size += ms.size_fixed_ + ms.size_var_ + ms.size_validity_;
+      cur_cost += io_cost_per_byte_ * persisted_sizes[r] +
+                  cpu_cost_per_byte_ * unfiltered_size;
+      if (current_.end_ != current_.start_ && cur_cost > target_cost_) {
+        stats_->add_counter("compute_current_start_end.cost_overflow", 1);
+        break;
+      }
+    }
+
     for (size_t i = 0; i < names.size(); ++i) {
       auto& cur_size = cur_sizes[i];
       auto& mem_size = mem_sizes[i];
@@ -880,8 +912,9 @@ void SubarrayPartitioner::compute_splitting_value_on_tiles(
   assert(range.layout() == Layout::GLOBAL_ORDER);
   *unsplittable = true;
 
-  // Inapplicable to Hilbert cell order
-  if (subarray_.array()->array_schema_latest()->cell_order() == Layout::HILBERT)
+  // Inapplicable to Hilbert and Morton cell orders
+  if (layout_is_curve(
+          subarray_.array()->array_schema_latest()->cell_order()))
     return;
 
   // For easy reference
@@ -944,7 +977,7 @@ void SubarrayPartitioner::compute_splitting_value_single_range(
   auto cell_order = array_schema->cell_order();
   assert(!range.is_unary());
   auto layout = subarray_.layout();
-  if (layout == Layout::UNORDERED && cell_order == Layout::HILBERT) {
+  if (layout == Layout::UNORDERED && layout_is_curve(cell_order)) {
     cell_order = Layout::ROW_MAJOR;
   } else {
     layout = (layout == Layout::UNORDERED || layout == Layout::GLOBAL_ORDER) ?
@@ -953,8 +986,8 @@ void SubarrayPartitioner::compute_splitting_value_single_range(
   }
   *splitting_dim = UINT32_MAX;
 
-  // Special case for Hilbert cell order
-  if (cell_order == Layout::HILBERT) {
+  // Special case for Hilbert and Morton cell orders
+  if (layout_is_curve(cell_order)) {
     compute_splitting_value_single_range_hilbert(
         range, splitting_dim, splitting_value, normal_order, unsplittable);
     return;
@@ -1001,7 +1034,7 @@ void SubarrayPartitioner::compute_splitting_value_single_range_hilbert(
   // For easy reference
   auto array_schema = subarray_.array()->array_schema_latest();
   auto dim_num = array_schema->dim_num();
-  Hilbert h(dim_num);
+  SpaceFillingCurve h(array_schema->cell_order(), dim_num);
 
   // Compute the uint64 mapping of the range (bits properly shifted)
   std::vector<std::array<uint64_t, 2>> range_uint64;
@@ -1031,14 +1064,14 @@ void SubarrayPartitioner::compute_splitting_value_single_range_hilbert(
   std::vector<uint64_t> hilbert_coords(dim_num);
   for (uint32_t d = 0; d < dim_num; ++d)
     hilbert_coords[d] = range_uint64[d][0];
-  auto hilbert_left = h.coords_to_hilbert(&hilbert_coords[0]);
+  auto hilbert_left = h.coords_to_value(&hilbert_coords[0]);
   for (uint32_t d = 0; d < dim_num; ++d) {
     if (d == *splitting_dim)
       hilbert_coords[d] = range_uint64[d][1];
     else
       hilbert_coords[d] = range_uint64[d][0];
   }
-  auto hilbert_right = h.coords_to_hilbert(&hilbert_coords[0]);
+  auto hilbert_right = h.coords_to_value(&hilbert_coords[0]);
   *normal_order = (hilbert_left < hilbert_right);
 }
 
@@ -1062,7 +1095,7 @@ Status SubarrayPartitioner::compute_splitting_value_multi_range(
   auto layout = subarray_.layout();
   auto array_schema = subarray_.array()->array_schema_latest();
   auto dim_num = array_schema->dim_num();
-  auto cell_order = (array_schema->cell_order() == Layout::HILBERT) ?
+  auto cell_order = layout_is_curve(array_schema->cell_order()) ?
                         Layout::ROW_MAJOR :
                         array_schema->cell_order();
   layout = (layout == Layout::UNORDERED) ? cell_order : layout;
@@ -1357,6 +1390,9 @@ void SubarrayPartitioner::swap(SubarrayPartitioner& partitioner) {
   std::swap(memory_budget_var_, partitioner.memory_budget_var_);
   std::swap(memory_budget_validity_, partitioner.memory_budget_validity_);
   std::swap(skip_split_on_est_size_, partitioner.skip_split_on_est_size_);
+  std::swap(target_cost_, partitioner.target_cost_);
+  std::swap(io_cost_per_byte_, partitioner.io_cost_per_byte_);
+  std::swap(cpu_cost_per_byte_, partitioner.cpu_cost_per_byte_);
   std::swap(compute_tp_, partitioner.compute_tp_);
 }
 
@@ -1443,12 +1479,12 @@ void SubarrayPartitioner::compute_splitting_dim_hilbert(
   std::vector<uint64_t> grid_coords(dim_num, 1);
   std::vector<uint64_t> hilbert_coords(dim_num);
   uint64_t hilbert_value;
-  Hilbert h(dim_num);
+  SpaceFillingCurve h(array_schema->cell_order(), dim_num);
   while (grid_coords[0] < grid_size[0] + 1) {
     // Map hilbert values of range_uint64 endpoints to range grid
     for (uint32_t d = 0; d < dim_num; ++d)
       hilbert_coords[d] = range_uint64[d][grid_coords[d] - 1];
-    hilbert_value = h.coords_to_hilbert(&hilbert_coords[0]);
+    hilbert_value = h.coords_to_value(&hilbert_coords[0]);
     range_grid.push_back(std::make_pair(hilbert_value, grid_coords));
 
     // Advance coordinates
@@ -381,6 +381,18 @@ class SubarrayPartitioner {
    */
   bool skip_split_on_est_size_;
 
+  /**
+   * The cost target of a partition with multiple ranges, as set by
+   * `sm.partitioner.target_cost`. Zero disables the cost model.
+   */
+  double target_cost_;
+
+  /** The cost per persisted tile byte fetched from storage. */
+  double io_cost_per_byte_;
+
+  /** The cost per in-memory tile byte that has to be unfiltered. */
+  double cpu_cost_per_byte_;
+
   /** The thread pool for compute-bound tasks. */
   ThreadPool* compute_tp_;
 
@@ -451,7 +463,7 @@ class SubarrayPartitioner {
 
   /**
    * Same as `compute_splitting_value_single_range` but this is applicable
-   * only to global order reads when the cell order is Hilbert.
+   * only to global order reads when the cell order is Hilbert or Morton.
    */
   void compute_splitting_value_single_range_hilbert(
       const Subarray& range,
@@ -533,7 +545,7 @@ class SubarrayPartitioner {
       bool* unsplittable) const;
 
   /**
-   * Calculates the splitting dimension for Hilbert cell order,
+   * Calculates the splitting dimension for Hilbert or Morton cell order,
    * based on the mapped uint64 range.
    */
   void compute_splitting_dim_hilbert(
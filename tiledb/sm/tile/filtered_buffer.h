@@ -33,6 +33,7 @@
 #ifndef TILEDB_FILTERED_BUFFER_H
 #define TILEDB_FILTERED_BUFFER_H
 
+#include <memory>
 #include <vector>
 
 #include "tiledb/common/status.h"
@@ -65,6 +66,9 @@ class FilteredBuffer {
    */
   FilteredBuffer(const FilteredBuffer& other) {
     filtered_buffer_ = other.filtered_buffer_;
+    view_ = other.view_;
+    view_size_ = other.view_size_;
+    view_owner_ = other.view_owner_;
   }
 
   /** Move constructor. */
@@ -89,42 +93,61 @@ class FilteredBuffer {
 
   /** Returns the size. */
   inline size_t size() const {
-    return filtered_buffer_.size();
+    return view_ != nullptr ? view_size_ : filtered_buffer_.size();
   }
 
   /** Returns the data. */
   inline char* data() {
-    return filtered_buffer_.data();
+    return view_ != nullptr ? view_ : filtered_buffer_.data();
   }
 
   /** Returns the data. */
   inline const char* data() const {
-    return filtered_buffer_.data();
+    return view_ != nullptr ? view_ : filtered_buffer_.data();
   }
 
   /** Returns the data casted as a type. */
   template <class T>
   inline T* data_as() {
-    return static_cast<T*>(static_cast<void*>(filtered_buffer_.data()));
+    return static_cast<T*>(static_cast<void*>(data()));
   }
 
   /** Converts the data at an offset to a specific type. */
   template <class T>
   inline T value_at_as(uint64_t offset) const {
-    assert(offset + sizeof(T) <= filtered_buffer_.size());
-    return *static_cast<const T*>(
-        static_cast<const void*>(&filtered_buffer_.data()[offset]));
+    assert(offset + sizeof(T) <= size());
+    return *static_cast<const T*>(static_cast<const void*>(&data()[offset]));
   }
 
   /** Expands the size of the underlying container. */
   inline void expand(size_t size) {
+    assert(view_ == nullptr);
     assert(size >= filtered_buffer_.size());
     filtered_buffer_.resize(size);
   }
 
+  /**
+   * Makes the filtered buffer a view of memory it does not own, e.g. a
+   * region of a memory-mapped file, releasing any owned data.
+   *
+   * @param data The start of the viewed memory.
+   * @param size The size of the viewed memory.
+   * @param owner Keeps the viewed memory alive for the life of the view.
+   */
+  inline void set_view(
+      char* data, size_t size, const std::shared_ptr<void>& owner) {
+    std::vector<char>().swap(filtered_buffer_);
+    view_ = data;
+    view_size_ = size;
+    view_owner_ = owner;
+  }
+
   /** Clears the data. */
   inline void clear() {
     filtered_buffer_.clear();
+    view_ = nullptr;
+    view_size_ = 0;
+    view_owner_.reset();
   }
 
   /**
@@ -133,6 +156,9 @@ class FilteredBuffer {
    */
   void swap(FilteredBuffer& other) {
     std::swap(filtered_buffer_, other.filtered_buffer_);
+    std::swap(view_, other.view_);
+    std::swap(view_size_, other.view_size_);
+    std::swap(view_owner_, other.view_owner_);
   }
 
  private:
@@ -142,6 +168,15 @@ class FilteredBuffer {
 
   /** Storing container for the filtered buffer. */
   std::vector<char> filtered_buffer_;
+
+  /** The viewed memory, if the filtered buffer does not own its data. */
+  char* view_ = nullptr;
+
+  /** The size of the viewed memory. */
+  size_t view_size_ = 0;
+
+  /** Keeps the viewed memory alive. */
+  std::shared_ptr<void> view_owner_;
 };
 
 }  // namespace sm
@@ -107,6 +107,21 @@ Status GenericTileIO::read_generic(
   return Status::Ok();
 }
 
+Status GenericTileIO::read_generic(
+    Buffer* buff,
+    uint64_t file_offset,
+    const EncryptionKey& encryption_key,
+    const Config& config) {
+  Tile* tile = nullptr;
+  RETURN_NOT_OK(read_generic(&tile, file_offset, encryption_key, config));
+  tdb_unique_ptr<Tile> tile_ptr(tile);
+
+  auto size = tile->size();
+  buff->own_data(tile->release_data(), size);
+
+  return Status::Ok();
+}
+
 Status GenericTileIO::read_generic_tile_header(
     const StorageManager* sm,
     const URI& uri,
@@ -43,6 +43,7 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+class Buffer;
 class StorageManager;
 class Tile;
 
@@ -134,6 +135,24 @@ class GenericTileIO {
       const EncryptionKey& encryption_key,
       const Config& config);
 
+  /**
+   * Reads a generic tile from the file into a buffer. The unfiltered tile
+   * data is handed over to the buffer rather than copied, which matters for
+   * large tiles such as consolidated fragment metadata, where the chunks are
+   * unfiltered in parallel and a copy would be the only serial pass.
+   *
+   * @param buff The buffer that will hold the read data.
+   * @param file_offset The offset in the file to read from.
+   * @param encryption_key The encryption key to use.
+   * @param config The storage manager's config.
+   * @return Status
+   */
+  Status read_generic(
+      Buffer* buff,
+      uint64_t file_offset,
+      const EncryptionKey& encryption_key,
+      const Config& config);
+
   /**
    * Reads the generic tile header from the file.
    *
@@ -0,0 +1,148 @@
+/**
+ * @file   large_buffer_allocator.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class LargeBufferAllocator.
+ */
+
+#include "tiledb/sm/tile/large_buffer_allocator.h"
+#include "tiledb/common/heap_memory.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+LargeBufferAllocator::LargeBufferAllocator(
+    const uint64_t threshold,
+    const HugePageMode huge_page_mode,
+    const bool numa_local)
+    : threshold_(threshold)
+    , huge_page_mode_(huge_page_mode)
+    , numa_local_(numa_local) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+bool LargeBufferAllocator::use_for(const uint64_t size) const {
+  return size >= threshold_;
+}
+
+void* LargeBufferAllocator::allocate(const uint64_t size) const {
+#ifdef _WIN32
+  auto block = static_cast<char*>(tdb_malloc(size + HEADER_SIZE));
+  if (block == nullptr)
+    return nullptr;
+  const uint64_t length = 0;
+#else
+  // Round the mapping up to whole huge pages, so that its end can be backed
+  // by a huge page too.
+  uint64_t length = size + HEADER_SIZE;
+  if (huge_page_mode_ != HugePageMode::NONE)
+    length = (length + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+  void* map = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (huge_page_mode_ == HugePageMode::EXPLICIT)
+    map = mmap(
+        nullptr,
+        length,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+        -1,
+        0);
+#endif
+  if (map == MAP_FAILED) {
+    map = mmap(
+        nullptr,
+        length,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (map == MAP_FAILED)
+      return nullptr;
+#ifdef MADV_HUGEPAGE
+    if (huge_page_mode_ != HugePageMode::NONE)
+      madvise(map, length, MADV_HUGEPAGE);
+#endif
+  }
+
+#if defined(__linux__) && defined(SYS_mbind)
+  // Bind the mapping to the local node of the thread first touching each
+  // page. This is best effort: the pages stay on the default policy if the
+  // kernel does not support it.
+  if (numa_local_) {
+    const int mpol_local = 4;
+    syscall(SYS_mbind, map, length, mpol_local, nullptr, 0, 0);
+  }
+#endif
+
+  auto block = static_cast<char*>(map);
+#endif
+
+  // Only the first page is touched here, so the other pages are placed by
+  // the thread writing them.
+  std::memcpy(block, &length, sizeof(uint64_t));
+  return block + HEADER_SIZE;
+}
+
+void LargeBufferAllocator::free_block(void* data) {
+  if (data == nullptr)
+    return;
+
+  auto block = static_cast<char*>(data) - HEADER_SIZE;
+  uint64_t length;
+  std::memcpy(&length, block, sizeof(uint64_t));
+#ifndef _WIN32
+  if (length != 0) {
+    munmap(block, length);
+    return;
+  }
+#endif
+  tdb_free(block);
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,125 @@
+/**
+ * @file   large_buffer_allocator.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class LargeBufferAllocator.
+ */
+
+#ifndef TILEDB_LARGE_BUFFER_ALLOCATOR_H
+#define TILEDB_LARGE_BUFFER_ALLOCATOR_H
+
+#include "tiledb/sm/enums/huge_page_mode.h"
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Allocates large tile buffers with their own memory mapping, so that they
+ * can be backed by huge pages to reduce TLB misses, and placed on the NUMA
+ * node of the thread that first writes them.
+ *
+ * The pages of a mapping are only placed when first touched. Since tiles
+ * are unfiltered by the compute threads, which write their buffers first,
+ * this places a tile on the node of the thread processing it. With
+ * `numa_local`, the mapping is also bound to the local node of the touching
+ * thread, overriding any process-wide interleaving policy.
+ *
+ * A buffer stores the size of its mapping in a header before the data, so
+ * that it can be freed with `free_block`. On platforms without memory
+ * mappings, buffers fall back to the heap.
+ *
+ * This class is thread-safe.
+ */
+class LargeBufferAllocator {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param threshold The smallest buffer size allocated by this allocator.
+   * @param huge_page_mode How buffers are backed by huge pages.
+   * @param numa_local Whether buffers are bound to the local NUMA node of
+   *     the thread first touching them.
+   */
+  LargeBufferAllocator(
+      uint64_t threshold, HugePageMode huge_page_mode, bool numa_local);
+
+  /** Destructor. */
+  ~LargeBufferAllocator() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns `true` if buffers of `size` bytes go to this allocator. */
+  bool use_for(uint64_t size) const;
+
+  /**
+   * Allocates a buffer.
+   *
+   * @param size The buffer size.
+   * @return The buffer, or `nullptr` if the allocation failed.
+   */
+  void* allocate(uint64_t size) const;
+
+  /** Frees a buffer returned by `allocate`. */
+  static void free_block(void* data);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /**
+   * The size of the header before the data of a buffer, holding the size
+   * of its mapping, or 0 if it was allocated on the heap.
+   */
+  static constexpr uint64_t HEADER_SIZE = 64;
+
+  /** The size of a huge page. */
+  static constexpr uint64_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  /** The smallest buffer size allocated by this allocator. */
+  const uint64_t threshold_;
+
+  /** How buffers are backed by huge pages. */
+  const HugePageMode huge_page_mode_;
+
+  /** Whether buffers are bound to the local NUMA node. */
+  const bool numa_local_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_LARGE_BUFFER_ALLOCATOR_H
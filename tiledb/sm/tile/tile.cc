@@ -34,6 +34,8 @@
 #include "tiledb/common/heap_memory.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/tile/large_buffer_allocator.h"
+#include "tiledb/sm/tile/tile_buffer_pool.h"
 
 #include <iostream>
 
@@ -139,6 +141,7 @@ Status Tile::init_unfiltered(
 
   if (tile_size > 0) {
     data_.reset(static_cast<char*>(tdb_malloc(tile_size)));
+    data_.get_deleter() = tiledb_free;
     if (data_ == nullptr)
       return LOG_STATUS(
           Status_TileError("Cannot initialize tile; Buffer allocation failed"));
@@ -154,6 +157,26 @@ Status Tile::init_unfiltered(
   return Status::Ok();
 }
 
+Status Tile::init_unfiltered_view(
+    uint32_t format_version,
+    Datatype type,
+    uint64_t cell_size,
+    unsigned int dim_num,
+    const void* data,
+    uint64_t size) {
+  cell_size_ = cell_size;
+  dim_num_ = dim_num;
+  type_ = type;
+  format_version_ = format_version;
+
+  // The viewed bytes are not owned by the tile, they are never freed.
+  data_.reset(static_cast<char*>(const_cast<void*>(data)));
+  data_.get_deleter() = [](void*) {};
+  size_ = size;
+
+  return Status::Ok();
+}
+
 Status Tile::init_filtered(
     uint32_t format_version,
     Datatype type,
@@ -173,9 +196,35 @@ void Tile::clear_data() {
   size_ = 0;
 }
 
-Status Tile::alloc_data(uint64_t size) {
+void* Tile::release_data() {
+  size_ = 0;
+  return data_.release();
+}
+
+void Tile::set_data_view(void* data, uint64_t size) {
   assert(data_ == nullptr);
-  data_.reset(static_cast<char*>(tdb_malloc(size)));
+
+  // The viewed bytes are not owned by the tile, they are never freed.
+  data_.reset(static_cast<char*>(data));
+  data_.get_deleter() = [](void*) {};
+  size_ = size;
+}
+
+Status Tile::alloc_data(
+    uint64_t size,
+    TileBufferPool* pool,
+    const LargeBufferAllocator* large_allocator) {
+  assert(data_ == nullptr);
+  if (large_allocator != nullptr && large_allocator->use_for(size)) {
+    data_.reset(static_cast<char*>(large_allocator->allocate(size)));
+    data_.get_deleter() = LargeBufferAllocator::free_block;
+  } else if (pool != nullptr) {
+    data_.reset(static_cast<char*>(pool->acquire(size)));
+    data_.get_deleter() = TileBufferPool::free_block;
+  } else {
+    data_.reset(static_cast<char*>(tdb_malloc(size)));
+    data_.get_deleter() = tiledb_free;
+  }
   if (data_ == nullptr) {
     return LOG_STATUS(
         Status_TileError("Cannot allocate buffer; Memory allocation failed"));
@@ -185,33 +234,17 @@ Status Tile::alloc_data(uint64_t size) {
   return Status::Ok();
 }
 
-bool Tile::empty() const {
-  assert(!filtered());
-  return data_ == nullptr;
-}
+void Tile::recycle_data(TileBufferPool* pool) {
+  if (data_ == nullptr || data_.get_deleter() != TileBufferPool::free_block)
+    return;
 
-Status Tile::read(
-    void* const buffer, const uint64_t offset, const uint64_t nbytes) const {
-  assert(!filtered());
-  if (nbytes > size_ - offset) {
-    return LOG_STATUS(Status_TileError(
-        "Read tile overflow; may not read beyond buffer size"));
-  }
-  std::memcpy(buffer, data_.get() + offset, nbytes);
-  return Status::Ok();
+  pool->release(data_.release());
+  size_ = 0;
 }
 
-Status Tile::write(const void* data, uint64_t offset, uint64_t nbytes) {
+bool Tile::empty() const {
   assert(!filtered());
-  if (nbytes > size_ - offset) {
-    return LOG_STATUS(
-        Status_TileError("Write tile overflow; would write out of bounds"));
-  }
-
-  std::memcpy(data_.get() + offset, data, nbytes);
-  size_ = std::max(offset + nbytes, size_);
-
-  return Status::Ok();
+  return data_ == nullptr;
 }
 
 Status Tile::zip_coordinates() {
@@ -255,5 +288,19 @@ void Tile::swap(Tile& tile) {
   std::swap(type_, tile.type_);
 }
 
+/* ****************************** */
+/*        PROTECTED METHODS       */
+/* ****************************** */
+
+Status Tile::read_overflow_error() {
+  return LOG_STATUS(
+      Status_TileError("Read tile overflow; may not read beyond buffer size"));
+}
+
+Status Tile::write_overflow_error() {
+  return LOG_STATUS(
+      Status_TileError("Write tile overflow; would write out of bounds"));
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -37,13 +37,19 @@
 #include "tiledb/sm/array_schema/attribute.h"
 #include "tiledb/sm/tile/filtered_buffer.h"
 
+#include <algorithm>
+#include <cassert>
 #include <cinttypes>
+#include <cstring>
 
 using namespace tiledb::common;
 
 namespace tiledb {
 namespace sm {
 
+class LargeBufferAllocator;
+class TileBufferPool;
+
 /**
  * Handles tile information. A tile can be in main memory if it has been
  * fetched from the disk or has been mmap-ed from a file. However, a tile
@@ -148,6 +154,28 @@ class Tile {
       unsigned int dim_num,
       bool fill_with_zeros = false);
 
+  /**
+   * Tile initializer viewing unfiltered bytes owned by the caller, e.g. a
+   * slice of a user buffer, without copying them. The tile does not free the
+   * bytes, which must outlive it, and they must not be written through it.
+   *
+   * @param format_version The format version of the data in this tile.
+   * @param type The type of the data to be stored.
+   * @param cell_size The cell size.
+   * @param dim_num The number of dimensions in case the tile stores
+   *      coordinates.
+   * @param data The bytes to view.
+   * @param size The number of bytes to view.
+   * @return Status
+   */
+  Status init_unfiltered_view(
+      uint32_t format_version,
+      Datatype type,
+      uint64_t cell_size,
+      unsigned int dim_num,
+      const void* data,
+      uint64_t size);
+
   /**
    * Tile initializer for storing filtered bytes.
    *
@@ -174,13 +202,46 @@ class Tile {
   /** Clears the internal buffer. */
   void clear_data();
 
+  /**
+   * Releases the ownership of the internal buffer and clears it. The caller
+   * must free the returned buffer with `tdb_free`.
+   *
+   * @return The internal buffer.
+   */
+  void* release_data();
+
   /**
    * Allocate the internal buffer.
    *
    * @param size New size.
+   * @param pool If not `nullptr`, the pool the buffer is drawn from.
+   * @param large_allocator If not `nullptr`, the allocator used instead of
+   *     `pool` for the buffers it is configured for.
    * @return Status.
    */
-  Status alloc_data(uint64_t size);
+  Status alloc_data(
+      uint64_t size,
+      TileBufferPool* pool = nullptr,
+      const LargeBufferAllocator* large_allocator = nullptr);
+
+  /**
+   * Returns the internal buffer to `pool` and clears it, if the buffer was
+   * drawn from a `TileBufferPool`. Otherwise, this is a no-op.
+   *
+   * @param pool The pool to return the buffer to.
+   */
+  void recycle_data(TileBufferPool* pool);
+
+  /**
+   * Sets the internal buffer to bytes owned by the caller instead of
+   * allocating it, e.g. so that a filtered tile is unfiltered directly
+   * into a user buffer. The tile does not free the bytes, which must
+   * outlive it.
+   *
+   * @param data The bytes to use as the internal buffer.
+   * @param size The number of bytes.
+   */
+  void set_data_view(void* data, uint64_t size);
 
   /** Returns the cell size. */
   inline uint64_t cell_size() const {
@@ -219,8 +280,16 @@ class Tile {
    * Reads from the tile at the given offset into the input
    * buffer of size nbytes. Does not mutate the internal offset.
    * Thread-safe among readers.
+   *
+   * Inlined, as it is called per cell by the readers.
    */
-  Status read(void* buffer, uint64_t offset, uint64_t nbytes) const;
+  Status read(void* buffer, uint64_t offset, uint64_t nbytes) const {
+    assert(!filtered());
+    if (nbytes > size_ - offset)
+      return read_overflow_error();
+    std::memcpy(buffer, data_.get() + offset, nbytes);
+    return Status::Ok();
+  }
 
   /** Returns the tile size. */
   inline uint64_t size() const {
@@ -242,8 +311,17 @@ class Tile {
    *
    * @note This function assumes that the tile buffer has already been
    *     properly allocated. It does not alter the tile offset and size.
+   *
+   * Inlined, as it is called per cell by the writers.
    */
-  Status write(const void* data, uint64_t offset, uint64_t nbytes);
+  Status write(const void* data, uint64_t offset, uint64_t nbytes) {
+    assert(!filtered());
+    if (nbytes > size_ - offset)
+      return write_overflow_error();
+    std::memcpy(data_.get() + offset, data, nbytes);
+    size_ = std::max(offset + nbytes, size_);
+    return Status::Ok();
+  }
 
   /**
    * Zips the coordinate values such that a cell's coordinates across
@@ -298,6 +376,19 @@ class Tile {
    * to override the value in tests.
    */
   static uint64_t max_tile_chunk_size_;
+
+  /* ********************************* */
+  /*         PROTECTED METHODS         */
+  /* ********************************* */
+
+  /**
+   * Returns the error of a read beyond the tile size. It is out of line so
+   * that the message is only built, and the code only inlined, on failure.
+   */
+  static Status read_overflow_error();
+
+  /** Returns the error of a write beyond the tile size. */
+  static Status write_overflow_error();
 };
 
 }  // namespace sm
@@ -0,0 +1,168 @@
+/**
+ * @file   tile_buffer_pool.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileBufferPool.
+ */
+
+#include "tiledb/sm/tile/tile_buffer_pool.h"
+#include "tiledb/common/heap_memory.h"
+
+#include <cstring>
+#include <functional>
+#include <thread>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TileBufferPool::TileBufferPool(uint64_t max_idle_size, bool recycle_on_free)
+    : recycle_on_free_(recycle_on_free)
+    , reuse_num_(0) {
+  memory_tracker_.set_budget(max_idle_size);
+}
+
+TileBufferPool::~TileBufferPool() {
+  trim();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void* TileBufferPool::acquire(uint64_t size) {
+  const uint64_t capacity = size_class(size);
+
+  {
+    auto& shard = thread_shard();
+    std::lock_guard<std::mutex> lg(shard.mtx_);
+    auto it = shard.idle_buffers_.find(capacity);
+    if (it != shard.idle_buffers_.end() && !it->second.empty()) {
+      void* data = it->second.back();
+      it->second.pop_back();
+      memory_tracker_.release_memory(capacity + HEADER_SIZE);
+      reuse_num_++;
+      return data;
+    }
+  }
+
+  auto block = static_cast<char*>(tdb_malloc(capacity + HEADER_SIZE));
+  if (block == nullptr)
+    return nullptr;
+  TileBufferPool* const owner = recycle_on_free_ ? this : nullptr;
+  std::memcpy(block, &capacity, sizeof(uint64_t));
+  std::memcpy(block + sizeof(uint64_t), &owner, sizeof(TileBufferPool*));
+
+  return block + HEADER_SIZE;
+}
+
+void TileBufferPool::release(void* data) {
+  uint64_t capacity;
+  std::memcpy(
+      &capacity, static_cast<char*>(data) - HEADER_SIZE, sizeof(uint64_t));
+
+  if (memory_tracker_.take_memory(capacity + HEADER_SIZE)) {
+    auto& shard = thread_shard();
+    std::lock_guard<std::mutex> lg(shard.mtx_);
+    shard.idle_buffers_[capacity].push_back(data);
+    return;
+  }
+
+  free_memory(data);
+}
+
+void TileBufferPool::free_block(void* data) {
+  if (data == nullptr)
+    return;
+
+  TileBufferPool* owner;
+  std::memcpy(
+      &owner,
+      static_cast<char*>(data) - HEADER_SIZE + sizeof(uint64_t),
+      sizeof(TileBufferPool*));
+  if (owner != nullptr)
+    owner->release(data);
+  else
+    free_memory(data);
+}
+
+void TileBufferPool::trim() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lg(shard.mtx_);
+    for (auto& idle : shard.idle_buffers_) {
+      for (auto data : idle.second) {
+        free_memory(data);
+        memory_tracker_.release_memory(idle.first + HEADER_SIZE);
+      }
+    }
+    shard.idle_buffers_.clear();
+  }
+}
+
+uint64_t TileBufferPool::idle_size() {
+  return memory_tracker_.get_memory_usage();
+}
+
+uint64_t TileBufferPool::reuse_num() const {
+  return reuse_num_;
+}
+
+uint64_t TileBufferPool::size_class(uint64_t size) {
+  if (size <= 64)
+    return 64;
+
+  // Round up to a multiple of a quarter of the largest power of 2 that is
+  // not larger than `size`.
+  uint64_t power = 64;
+  while (power <= size / 2)
+    power *= 2;
+  const uint64_t step = power / 4;
+
+  return (size + step - 1) / step * step;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+TileBufferPool::Shard& TileBufferPool::thread_shard() {
+  const auto id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  return shards_[id % SHARD_NUM];
+}
+
+void TileBufferPool::free_memory(void* data) {
+  tdb_free(static_cast<char*>(data) - HEADER_SIZE);
+}
+
+}  // namespace sm
+}  // namespace tiledb
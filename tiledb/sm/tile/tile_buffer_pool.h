@@ -0,0 +1,170 @@
+/**
+ * @file   tile_buffer_pool.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileBufferPool.
+ */
+
+#ifndef TILEDB_TILE_BUFFER_POOL_H
+#define TILEDB_TILE_BUFFER_POOL_H
+
+#include "tiledb/common/macros.h"
+#include "tiledb/common/memory_tracker.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Recycles tile buffers, across the iterations of a query or across the
+ * queries of a context. Buffers are allocated in size classes spaced by a
+ * quarter of a power of 2, and released buffers are kept per size class to
+ * serve later requests of the same class instead of going back to the
+ * allocator.
+ *
+ * A buffer stores its size class in a small header before the data, so that
+ * it can be freed with `free_block` without the pool, e.g. by the deleter of
+ * a tile that outlives the pool. If the pool recycles on free, the header
+ * also points to the pool and `free_block` returns the buffer to it, so the
+ * pool must outlive its buffers. The idle buffers are accounted in a
+ * `MemoryTracker` whose budget bounds how much memory the pool keeps.
+ *
+ * The idle buffers are split in shards chosen by thread, each with its own
+ * lock, so that concurrent threads rarely contend.
+ *
+ * This class is thread-safe.
+ */
+class TileBufferPool {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_idle_size The maximum size of the buffers kept for reuse.
+   * @param recycle_on_free If `true`, `free_block` returns the buffers of
+   *     this pool to it instead of freeing them.
+   */
+  explicit TileBufferPool(uint64_t max_idle_size, bool recycle_on_free = false);
+
+  /** Destructor. Frees the idle buffers. */
+  ~TileBufferPool();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(TileBufferPool);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(TileBufferPool);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Returns a buffer of at least `size` bytes, reusing an idle buffer of the
+   * same size class if any. Returns `nullptr` if the allocation fails.
+   */
+  void* acquire(uint64_t size);
+
+  /**
+   * Keeps a buffer returned by `acquire` for reuse, or frees it if the idle
+   * buffers would exceed their budget.
+   */
+  void release(void* data);
+
+  /**
+   * Frees a buffer returned by `acquire`, or returns it to its pool if the
+   * pool recycles on free.
+   */
+  static void free_block(void* data);
+
+  /** Frees all the idle buffers. */
+  void trim();
+
+  /** Returns the size of the idle buffers. */
+  uint64_t idle_size();
+
+  /** Returns the number of buffers served by reusing an idle buffer. */
+  uint64_t reuse_num() const;
+
+  /** Returns the size class of a buffer of `size` bytes. */
+  static uint64_t size_class(uint64_t size);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The idle buffers of a shard. */
+  struct Shard {
+    /** Protects `idle_buffers_`. */
+    std::mutex mtx_;
+
+    /** The idle buffers, by size class. */
+    std::unordered_map<uint64_t, std::vector<void*>> idle_buffers_;
+  };
+
+  /**
+   * The size of the header before the data of a buffer, holding the size
+   * class and the pool recycling the buffer on free, if any.
+   */
+  static constexpr uint64_t HEADER_SIZE = 16;
+
+  /** The number of shards. */
+  static constexpr uint64_t SHARD_NUM = 16;
+
+  /** Accounts the idle buffers. */
+  MemoryTracker memory_tracker_;
+
+  /** Whether `free_block` returns the buffers of this pool to it. */
+  const bool recycle_on_free_;
+
+  /** The shards of idle buffers. */
+  Shard shards_[SHARD_NUM];
+
+  /** The number of buffers served by reusing an idle buffer. */
+  std::atomic<uint64_t> reuse_num_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the shard of the calling thread. */
+  Shard& thread_shard();
+
+  /** Frees the memory of a buffer. */
+  static void free_memory(void* data);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_BUFFER_POOL_H
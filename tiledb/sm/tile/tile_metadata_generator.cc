@@ -37,6 +37,152 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Number of cells reduced at a time when processing numeric tiles. */
+constexpr uint64_t metadata_block_cell_num = 1024;
+
+/**
+ * Adds a value to a sum, saturating it on overflow.
+ *
+ * @return `false` if the sum overflowed.
+ */
+inline bool saturating_add(int64_t& sum, int64_t value) {
+  if (sum > 0 && value > 0 &&
+      (sum > std::numeric_limits<int64_t>::max() - value)) {
+    sum = std::numeric_limits<int64_t>::max();
+    return false;
+  }
+
+  if (sum < 0 && value < 0 &&
+      (sum < std::numeric_limits<int64_t>::min() - value)) {
+    sum = std::numeric_limits<int64_t>::min();
+    return false;
+  }
+
+  sum += value;
+  return true;
+}
+
+/**
+ * Adds a value to a sum, saturating it on overflow.
+ *
+ * @return `false` if the sum overflowed.
+ */
+inline bool saturating_add(uint64_t& sum, uint64_t value) {
+  if (sum > std::numeric_limits<uint64_t>::max() - value) {
+    sum = std::numeric_limits<uint64_t>::max();
+    return false;
+  }
+
+  sum += value;
+  return true;
+}
+
+/**
+ * Adds a value to a sum, saturating it on overflow.
+ *
+ * @return `false` if the sum overflowed.
+ */
+inline bool saturating_add(double& sum, double value) {
+  if ((sum < 0.0) == (value < 0.0) &&
+      std::abs(sum) > std::numeric_limits<double>::max() - std::abs(value)) {
+    sum = sum < 0.0 ? std::numeric_limits<double>::lowest() :
+                      std::numeric_limits<double>::max();
+    return false;
+  }
+
+  sum += value;
+  return true;
+}
+
+/**
+ * Reduces the min, max and null count of a block of cells. The loop has no
+ * data dependent branches so that it can be vectorized.
+ */
+template <class T, bool nullable>
+inline void block_min_max(
+    const T* values,
+    const uint8_t* validity,
+    uint64_t cell_num,
+    T& min,
+    T& max,
+    uint64_t& null_count) {
+  T block_min = min;
+  T block_max = max;
+  uint64_t block_null_count = 0;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    const T value = values[c];
+    if constexpr (nullable) {
+      const bool is_null = validity[c] == 0;
+      block_min = (is_null || block_min < value) ? block_min : value;
+      block_max = (is_null || block_max > value) ? block_max : value;
+      block_null_count += is_null;
+    } else {
+      block_min = block_min < value ? block_min : value;
+      block_max = block_max > value ? block_max : value;
+    }
+  }
+
+  min = block_min;
+  max = block_max;
+  null_count += block_null_count;
+}
+
+/**
+ * Adds a block of cells to a sum, saturating it on overflow like a cell by
+ * cell sum would.
+ *
+ * @return `false` if the sum overflowed.
+ */
+template <class T, class SUM_T, bool nullable>
+inline bool block_sum(
+    const T* values, const uint8_t* validity, uint64_t cell_num, SUM_T& sum) {
+  // The sum of a block of values of at most 32 bits fits in 42 bits, so
+  // when the running sum is that far from the limits it cannot overflow at
+  // any cell of the block and the block can be summed without checks.
+  if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(uint32_t)) {
+    static_assert(metadata_block_cell_num <= 1024);
+    constexpr SUM_T margin = SUM_T(1) << 42;
+    if (sum <= std::numeric_limits<SUM_T>::max() - margin &&
+        (std::is_unsigned_v<SUM_T> ||
+         sum >= std::numeric_limits<SUM_T>::min() + margin)) {
+      SUM_T block_sum = 0;
+      for (uint64_t c = 0; c < cell_num; c++) {
+        if constexpr (nullable) {
+          block_sum += validity[c] != 0 ? static_cast<SUM_T>(values[c]) : 0;
+        } else {
+          block_sum += static_cast<SUM_T>(values[c]);
+        }
+      }
+
+      sum += block_sum;
+      return true;
+    }
+  }
+
+  for (uint64_t c = 0; c < cell_num; c++) {
+    if (nullable && validity[c] == 0)
+      continue;
+    if (!saturating_add(sum, static_cast<SUM_T>(values[c])))
+      return false;
+  }
+
+  return true;
+}
+
+/** Counts the null cells of a validity tile. */
+inline uint64_t null_count(const uint8_t* validity, uint64_t cell_num) {
+  uint64_t count = 0;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    count += validity[c] == 0;
+  }
+
+  return count;
+}
+
+}  // namespace
+
 /* ****************************** */
 /*    STRUCTURED BINDINGS APIS    */
 /* ****************************** */
@@ -331,8 +477,8 @@ const std::tuple<void*, void*> TileMetadataGenerator::min_max<char>(
   auto value = data + cell_size;
   auto cell_num = size / cell_size;
   for (uint64_t c = 1; c < cell_num; c++) {
-    min = strncmp((const char*)min, (const char*)value, size) > 0 ? value : min;
-    max = strncmp((const char*)max, (const char*)value, size) < 0 ? value : max;
+    min = memcmp(min, value, cell_size) > 0 ? value : min;
+    max = memcmp(max, value, cell_size) < 0 ? value : max;
     value += cell_size;
   }
 
@@ -385,18 +531,12 @@ TileMetadataGenerator::min_max_nullable<char>(
   // Process cell by cell.
   for (uint64_t c = 0; c < cell_num; c++) {
     const bool is_null = validity_values[c] == 0;
-    min =
-        !is_null &&
-                (min == nullptr ||
-                 strncmp((const char*)min, (const char*)value, cell_size) > 0) ?
-            value :
-            min;
-    max =
-        !is_null &&
-                (max == nullptr ||
-                 strncmp((const char*)max, (const char*)value, cell_size) < 0) ?
-            value :
-            max;
+    min = !is_null && (min == nullptr || memcmp(min, value, cell_size) > 0) ?
+              value :
+              min;
+    max = !is_null && (max == nullptr || memcmp(max, value, cell_size) < 0) ?
+              value :
+              max;
     value += cell_size;
     null_count += is_null;
   }
@@ -420,6 +560,8 @@ TileMetadataGenerator::TileMetadataGenerator(
     , max_(nullptr)
     , max_size_(0)
     , null_count_(0)
+    , min_value_(sizeof(uint64_t))
+    , max_value_(sizeof(uint64_t))
     , cell_size_(cell_size) {
   has_min_max_ = has_min_max_metadata(type, is_dim, var_size, cell_val_num);
   has_sum_ = has_sum_metadata(type, var_size, cell_val_num);
@@ -454,34 +596,34 @@ void TileMetadataGenerator::process_tile(
     // Switch depending on datatype.
     switch (type_) {
       case Datatype::INT8:
-        process_tile<int8_t>(tile, tile_validity);
+        process_tile_numeric<int8_t>(tile, tile_validity);
         break;
       case Datatype::INT16:
-        process_tile<int16_t>(tile, tile_validity);
+        process_tile_numeric<int16_t>(tile, tile_validity);
         break;
       case Datatype::INT32:
-        process_tile<int32_t>(tile, tile_validity);
+        process_tile_numeric<int32_t>(tile, tile_validity);
         break;
       case Datatype::INT64:
-        process_tile<int64_t>(tile, tile_validity);
+        process_tile_numeric<int64_t>(tile, tile_validity);
         break;
       case Datatype::UINT8:
-        process_tile<uint8_t>(tile, tile_validity);
+        process_tile_numeric<uint8_t>(tile, tile_validity);
         break;
       case Datatype::UINT16:
-        process_tile<uint16_t>(tile, tile_validity);
+        process_tile_numeric<uint16_t>(tile, tile_validity);
         break;
       case Datatype::UINT32:
-        process_tile<uint32_t>(tile, tile_validity);
+        process_tile_numeric<uint32_t>(tile, tile_validity);
         break;
       case Datatype::UINT64:
-        process_tile<uint64_t>(tile, tile_validity);
+        process_tile_numeric<uint64_t>(tile, tile_validity);
         break;
       case Datatype::FLOAT32:
-        process_tile<float>(tile, tile_validity);
+        process_tile_numeric<float>(tile, tile_validity);
         break;
       case Datatype::FLOAT64:
-        process_tile<double>(tile, tile_validity);
+        process_tile_numeric<double>(tile, tile_validity);
         break;
       case Datatype::DATETIME_YEAR:
       case Datatype::DATETIME_MONTH:
@@ -505,9 +647,10 @@ void TileMetadataGenerator::process_tile(
       case Datatype::TIME_PS:
       case Datatype::TIME_FS:
       case Datatype::TIME_AS:
-        process_tile<int64_t>(tile, tile_validity);
+        process_tile_numeric<int64_t>(tile, tile_validity);
         break;
       case Datatype::STRING_ASCII:
+      case Datatype::CHAR:
         process_tile<char>(tile, tile_validity);
         break;
       default:
@@ -563,6 +706,74 @@ void TileMetadataGenerator::process_tile(Tile* tile, Tile* tile_validity) {
   }
 }
 
+template <class T>
+void TileMetadataGenerator::process_tile_numeric(
+    const Tile* tile, const Tile* tile_validity) {
+  assert(tile != nullptr);
+  min_size_ = max_size_ = cell_size_;
+  auto cell_num = tile->size() / cell_size_;
+  auto validity = tile_validity == nullptr ?
+                      nullptr :
+                      tile_validity->data_as<uint8_t>();
+
+  // Cells with more than one value only have a null count.
+  if (!has_min_max_ && !has_sum_) {
+    if (validity != nullptr)
+      null_count_ = null_count(validity, cell_num);
+    return;
+  }
+
+  // Process the tile block by block, reducing the min/max and null count
+  // and then summing each block while it is in cache.
+  typedef typename metadata_generator_type_data<T>::sum_type SUM_T;
+  auto values = tile->data_as<T>();
+  T min = metadata_generator_type_data<T>::min;
+  T max = metadata_generator_type_data<T>::max;
+  SUM_T sum = 0;
+  bool sum_overflow = false;
+  for (uint64_t start = 0; start < cell_num;
+       start += metadata_block_cell_num) {
+    auto block_cell_num =
+        std::min<uint64_t>(metadata_block_cell_num, cell_num - start);
+    auto block_values = values + start;
+    auto block_validity = validity == nullptr ? nullptr : validity + start;
+    if (block_validity == nullptr) {
+      if (has_min_max_)
+        block_min_max<T, false>(
+            block_values, nullptr, block_cell_num, min, max, null_count_);
+      if (has_sum_ && !sum_overflow)
+        sum_overflow = !block_sum<T, SUM_T, false>(
+            block_values, nullptr, block_cell_num, sum);
+    } else {
+      if (has_min_max_)
+        block_min_max<T, true>(
+            block_values,
+            block_validity,
+            block_cell_num,
+            min,
+            max,
+            null_count_);
+      else
+        null_count_ += null_count(block_validity, block_cell_num);
+      if (has_sum_ && !sum_overflow)
+        sum_overflow = !block_sum<T, SUM_T, true>(
+            block_values, block_validity, block_cell_num, sum);
+    }
+  }
+
+  if (has_min_max_) {
+    memcpy(min_value_.data(), &min, sizeof(T));
+    memcpy(max_value_.data(), &max, sizeof(T));
+    min_ = min_value_.data();
+    max_ = max_value_.data();
+  }
+
+  if (has_sum_) {
+    sum_.assign(sizeof(uint64_t), 0);
+    memcpy(sum_.data(), &sum, sizeof(SUM_T));
+  }
+}
+
 void TileMetadataGenerator::process_tile_var(
     Tile* tile, Tile* tile_var, Tile* tile_validity) {
   assert(tile != nullptr);
@@ -616,6 +827,39 @@ void TileMetadataGenerator::process_tile_var(
       validity_value++;
     }
   }
+
+  truncate_min_max_var();
+}
+
+void TileMetadataGenerator::truncate_min_max_var() {
+  const uint64_t prefix_size = constants::tile_min_max_var_prefix_size;
+
+  // A prefix of the minimum is still a lower bound.
+  if (min_ != nullptr && min_size_ > prefix_size) {
+    min_size_ = prefix_size;
+  }
+
+  // The prefix of the maximum becomes an upper bound once its last byte is
+  // incremented, after dropping the trailing bytes that cannot be. If all
+  // the bytes of the prefix are 0xFF, the full maximum is kept.
+  if (max_ == nullptr || max_size_ <= prefix_size) {
+    return;
+  }
+
+  auto max = static_cast<const uint8_t*>(max_);
+  uint64_t size = prefix_size;
+  while (size > 0 && max[size - 1] == 0xFF) {
+    size--;
+  }
+
+  if (size == 0) {
+    return;
+  }
+
+  max_value_.assign(max, max + size);
+  max_value_[size - 1]++;
+  max_ = max_value_.data();
+  max_size_ = size;
 }
 
 inline void TileMetadataGenerator::min_max_var(
@@ -624,7 +868,7 @@ inline void TileMetadataGenerator::min_max_var(
 
   // Process min.
   size_t min_size = std::min<size_t>(min_size_, size);
-  int cmp = strncmp(static_cast<const char*>(min_), value, min_size);
+  int cmp = memcmp(min_, value, min_size);
   if (cmp != 0) {
     if (cmp > 0) {
       min_ = value;
@@ -639,7 +883,7 @@ inline void TileMetadataGenerator::min_max_var(
 
   // Process max.
   min_size = std::min<size_t>(max_size_, size);
-  cmp = strncmp(static_cast<const char*>(max_), value, min_size);
+  cmp = memcmp(max_, value, min_size);
   if (cmp != 0) {
     if (cmp < 0) {
       max_ = value;
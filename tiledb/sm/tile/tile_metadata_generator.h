@@ -256,6 +256,15 @@ class TileMetadataGenerator {
   /** Count of null values. */
   uint64_t null_count_;
 
+  /** Storage for the minimum value of numeric tiles. */
+  ByteVec min_value_;
+
+  /**
+   * Storage for the maximum value of numeric tiles, or for the truncated
+   * maximum of var size tiles.
+   */
+  ByteVec max_value_;
+
   /** Cell size. */
   uint64_t cell_size_;
 
@@ -280,7 +289,7 @@ class TileMetadataGenerator {
   void process_tile_var(Tile* tile, Tile* tile_var, Tile* tile_validity);
 
   /**
-   * Process fixed size attribute.
+   * Process fixed size string attribute.
    *
    * @param tile The fixed size tile.
    * @param tile_validity The validity tile.
@@ -288,6 +297,17 @@ class TileMetadataGenerator {
   template <class T>
   void process_tile(Tile* tile, Tile* tile_validity);
 
+  /**
+   * Process fixed size numeric attribute. Computes the min, max, sum and
+   * null count in a single pass over the tile, one block of cells at a
+   * time, with reductions that the compiler can vectorize.
+   *
+   * @param tile The fixed size tile.
+   * @param tile_validity The validity tile.
+   */
+  template <class T>
+  void process_tile_numeric(const Tile* tile, const Tile* tile_validity);
+
   /**
    * Min max function for var sized attributes.
    *
@@ -295,6 +315,13 @@ class TileMetadataGenerator {
    * @param size Value size.
    */
   void min_max_var(const char* value, const uint64_t size);
+
+  /**
+   * Truncates the var size min/max to
+   * `constants::tile_min_max_var_prefix_size` bytes, keeping the min a
+   * lower bound and the max an upper bound of the values in the tile.
+   */
+  void truncate_min_max_var();
 };
 
 }  // namespace sm
@@ -0,0 +1,449 @@
+/**
+ * @file  bench_command.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the bench command.
+ */
+
+#include "commands/bench_command.h"
+#include "misc/common.h"
+
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/config/config.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/query/query.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace tiledb {
+namespace cli {
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Size of the result buffers of a point lookup. */
+const uint64_t lookup_buffer_size = 1024 * 1024;
+
+/** Returns the seconds elapsed since `start`. */
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/** Returns the throughput in MiB/s of reading `bytes` in `secs` seconds. */
+double mib_per_sec(uint64_t bytes, double secs) {
+  return secs > 0 ? (bytes / (1024.0 * 1024.0)) / secs : 0;
+}
+
+/**
+ * Writes a random value of type `T` within the fixed-sized range `r`
+ * to `out`.
+ */
+template <class T>
+void random_coord(const Range& r, std::mt19937_64* gen, void* out) {
+  T lo, hi;
+  std::memcpy(&lo, r.start(), sizeof(T));
+  std::memcpy(&hi, r.end(), sizeof(T));
+  T v;
+  if constexpr (std::is_floating_point_v<T>) {
+    v = std::uniform_real_distribution<T>(lo, hi)(*gen);
+  } else if constexpr (std::is_signed_v<T>) {
+    v = static_cast<T>(std::uniform_int_distribution<int64_t>(lo, hi)(*gen));
+  } else {
+    v = static_cast<T>(std::uniform_int_distribution<uint64_t>(lo, hi)(*gen));
+  }
+  std::memcpy(out, &v, sizeof(T));
+}
+
+/**
+ * Writes a random coordinate of type `type` within the fixed-sized range
+ * `r` to `out`.
+ */
+void random_coord(
+    Datatype type, const Range& r, std::mt19937_64* gen, void* out) {
+  switch (type) {
+    case Datatype::INT8:
+      return random_coord<int8_t>(r, gen, out);
+    case Datatype::UINT8:
+      return random_coord<uint8_t>(r, gen, out);
+    case Datatype::INT16:
+      return random_coord<int16_t>(r, gen, out);
+    case Datatype::UINT16:
+      return random_coord<uint16_t>(r, gen, out);
+    case Datatype::INT32:
+      return random_coord<int32_t>(r, gen, out);
+    case Datatype::UINT32:
+      return random_coord<uint32_t>(r, gen, out);
+    case Datatype::UINT64:
+      return random_coord<uint64_t>(r, gen, out);
+    case Datatype::FLOAT32:
+      return random_coord<float>(r, gen, out);
+    case Datatype::FLOAT64:
+      return random_coord<double>(r, gen, out);
+    default:
+      // INT64 and the datetime and time types.
+      return random_coord<int64_t>(r, gen, out);
+  }
+}
+
+/**
+ * Runs `worker(t)` for every client thread index `t` in `[0, threads)`,
+ * rethrowing the first exception a worker throws.
+ */
+void run_workers(
+    unsigned threads, const std::function<void(unsigned)>& worker) {
+  std::vector<std::exception_ptr> errors(threads);
+  auto guarded = [&](unsigned t) {
+    try {
+      worker(t);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; t++)
+    workers.emplace_back(guarded, t);
+  guarded(0);
+  for (auto& w : workers)
+    w.join();
+
+  for (const auto& e : errors) {
+    if (e)
+      std::rethrow_exception(e);
+  }
+}
+
+}  // namespace
+
+BenchCommand::ReadBuffers::ReadBuffers(uint64_t size)
+    : data_(size)
+    , offsets_(size / sizeof(uint64_t))
+    , validity_(size) {
+}
+
+clipp::group BenchCommand::get_cli() {
+  using namespace clipp;
+  auto cli =
+      ((option("-a", "--array").required(true) & value("uri", array_uri_)) %
+           "URI of TileDB array",
+       repeatable(
+           option("-c", "--config") & value("key=value", config_)) %
+           "Config parameter override (repeatable)",
+       (option("--compute-threads") & value("N", compute_threads_)) %
+           "Size of the compute thread pool",
+       (option("--io-threads") & value("N", io_threads_)) %
+           "Size of the IO thread pool",
+       (option("-t", "--threads") & value("N", threads_)) %
+           "Client threads for point lookups and raw reads",
+       (option("--opens") & value("N", opens_)) %
+           "Number of array opens to time",
+       (option("-n", "--lookups") & value("N", lookups_)) %
+           "Number of random point lookups",
+       (option("-b", "--buffer-size") & value("MiB", buffer_size_mb_)) %
+           "Size of each result buffer of the scans");
+  return cli;
+}
+
+void BenchCommand::run() {
+  const unsigned hw = std::thread::hardware_concurrency();
+  THROW_NOT_OK(compute_tp_.init(compute_threads_ ? compute_threads_ : hw));
+  THROW_NOT_OK(io_tp_.init(io_threads_ ? io_threads_ : hw));
+  threads_ = std::max(threads_, 1u);
+
+  Config config;
+  for (const auto& kv : config_) {
+    auto pos = kv.find('=');
+    if (pos == std::string::npos)
+      throw std::invalid_argument(
+          "Invalid config override '" + kv + "'; expected key=value");
+    THROW_NOT_OK(config.set(kv.substr(0, pos), kv.substr(pos + 1)));
+  }
+
+  stats::Stats stats("");
+  StorageManager sm(
+      &compute_tp_, &io_tp_, &stats, make_shared<Logger>(HERE(), ""));
+  THROW_NOT_OK(sm.init(&config));
+
+  std::cout << "Array URI: " << array_uri_ << std::endl;
+  bench_open(&sm);
+
+  // Open the array
+  URI uri(array_uri_);
+  Array array(uri, &sm);
+  THROW_NOT_OK(
+      array.open(QueryType::READ, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+
+  auto&& [st, non_empty_domain] = array.non_empty_domain();
+  THROW_NOT_OK(st);
+  if (!non_empty_domain.has_value() || non_empty_domain->empty()) {
+    std::cout << "Array is empty; skipping the read probes." << std::endl;
+  } else {
+    bench_scan(&sm, &array, *non_empty_domain);
+    bench_lookups(&sm, &array, *non_empty_domain);
+    bench_vfs_read(&sm, &array);
+  }
+
+  // Close the array.
+  THROW_NOT_OK(array.close());
+
+  std::cout << "VFS requests:" << std::endl;
+  for (const auto& [name, count] : sm.vfs()->request_counts())
+    std::cout << "  " << name << ": " << count << std::endl;
+
+  std::cout << "Stats:" << std::endl << stats.dump(2, 0) << std::endl;
+}
+
+void BenchCommand::bench_open(StorageManager* sm) const {
+  URI uri(array_uri_);
+  double first = 0, total = 0;
+  for (unsigned i = 0; i < opens_; i++) {
+    auto start = std::chrono::steady_clock::now();
+    Array array(uri, sm);
+    THROW_NOT_OK(
+        array.open(QueryType::READ, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+    const double secs = seconds_since(start);
+    THROW_NOT_OK(array.close());
+    if (i == 0)
+      first = secs;
+    total += secs;
+  }
+
+  if (opens_ > 0)
+    std::cout << "Open latency: first " << first * 1000 << " ms, mean "
+              << total * 1000 / opens_ << " ms over " << opens_ << " opens."
+              << std::endl;
+}
+
+void BenchCommand::bench_scan(
+    StorageManager* sm, Array* array, const NDRange& non_empty_domain) const {
+  const auto* schema = array->array_schema_latest();
+  ReadBuffers buffers(uint64_t(buffer_size_mb_) * 1024 * 1024);
+
+  std::cout << "Full scan throughput (per attribute):" << std::endl;
+  for (const auto* attr : schema->attributes()) {
+    uint64_t cell_num = 0;
+    auto start = std::chrono::steady_clock::now();
+    const uint64_t bytes =
+        read(sm, array, attr->name(), non_empty_domain, &buffers, &cell_num);
+    const double secs = seconds_since(start);
+    std::cout << "- " << attr->name() << ": " << cell_num << " cells, "
+              << bytes << " bytes in " << secs << " s ("
+              << mib_per_sec(bytes, secs) << " MiB/s)." << std::endl;
+  }
+}
+
+void BenchCommand::bench_lookups(
+    StorageManager* sm, Array* array, const NDRange& non_empty_domain) const {
+  const auto* schema = array->array_schema_latest();
+  const unsigned dim_num = schema->dim_num();
+  for (unsigned d = 0; d < dim_num; d++) {
+    if (schema->dimension(d)->var_size()) {
+      std::cout << "Point lookups: skipped for var-sized dimensions."
+                << std::endl;
+      return;
+    }
+  }
+  if (lookups_ == 0)
+    return;
+
+  // Look up the first attribute, or the first dimension of arrays
+  // without attributes.
+  const std::string name = schema->attribute_num() > 0 ?
+                               schema->attribute(0)->name() :
+                               schema->dimension(0)->name();
+
+  // Every client thread runs its share of the lookups with its own
+  // generator, seeded with the thread index for reproducible points.
+  std::vector<double> latencies(lookups_);
+  std::atomic<uint64_t> found{0};
+  auto worker = [&](unsigned t) {
+    std::mt19937_64 gen(t);
+    ReadBuffers buffers(lookup_buffer_size);
+    for (uint64_t i = t; i < lookups_; i += threads_) {
+      NDRange point(dim_num);
+      for (unsigned d = 0; d < dim_num; d++) {
+        const auto* dim = schema->dimension(d);
+        const auto coord_size = dim->coord_size();
+        std::vector<uint8_t> range(2 * coord_size);
+        random_coord(dim->type(), non_empty_domain[d], &gen, range.data());
+        std::memcpy(&range[coord_size], range.data(), coord_size);
+        point[d] = Range(range.data(), range.size());
+      }
+
+      uint64_t cell_num = 0;
+      auto start = std::chrono::steady_clock::now();
+      read(sm, array, name, point, &buffers, &cell_num);
+      latencies[i] = seconds_since(start);
+      found += cell_num > 0;
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  run_workers(threads_, worker);
+  const double secs = seconds_since(start);
+
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0;
+  for (auto l : latencies)
+    total += l;
+  auto percentile = [&](double p) {
+    return latencies[std::min<size_t>(
+               latencies.size() - 1, size_t(p * latencies.size()))] *
+           1000;
+  };
+  std::cout << "Point lookups (" << lookups_ << " on " << threads_
+            << " threads, " << found << " non-empty): mean "
+            << total * 1000 / lookups_ << " ms, p50 " << percentile(0.5)
+            << " ms, p99 " << percentile(0.99) << " ms, "
+            << (secs > 0 ? lookups_ / secs : 0) << " lookups/s." << std::endl;
+}
+
+void BenchCommand::bench_vfs_read(StorageManager* sm, Array* array) const {
+  auto vfs = sm->vfs();
+
+  // Collect the files of every fragment.
+  std::vector<std::pair<URI, uint64_t>> files;
+  for (const auto& f : array->fragment_metadata()) {
+    std::vector<URI> uris;
+    THROW_NOT_OK(vfs->ls(f->fragment_uri(), &uris));
+    for (const auto& uri : uris) {
+      bool is_dir = false;
+      THROW_NOT_OK(vfs->is_dir(uri, &is_dir));
+      if (is_dir)
+        continue;
+      uint64_t size = 0;
+      THROW_NOT_OK(vfs->file_size(uri, &size));
+      files.emplace_back(uri, size);
+    }
+  }
+
+  // Read the files in buffer-sized chunks, bypassing the read-ahead cache,
+  // with the client threads taking the files in turn.
+  const uint64_t chunk = uint64_t(buffer_size_mb_) * 1024 * 1024;
+  std::atomic<uint64_t> bytes{0};
+  auto worker = [&](unsigned t) {
+    std::vector<uint8_t> buffer(std::max<uint64_t>(chunk, 1));
+    for (size_t i = t; i < files.size(); i += threads_) {
+      const auto& [uri, size] = files[i];
+      for (uint64_t offset = 0; offset < size; offset += buffer.size()) {
+        const uint64_t nbytes =
+            std::min<uint64_t>(buffer.size(), size - offset);
+        THROW_NOT_OK(vfs->read(uri, offset, buffer.data(), nbytes, false));
+        bytes += nbytes;
+      }
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  run_workers(threads_, worker);
+  const double secs = seconds_since(start);
+
+  std::cout << "VFS raw read: " << files.size() << " files, " << bytes
+            << " bytes in " << secs << " s (" << mib_per_sec(bytes, secs)
+            << " MiB/s)." << std::endl;
+}
+
+uint64_t BenchCommand::read(
+    StorageManager* sm,
+    Array* array,
+    const std::string& name,
+    const NDRange& ranges,
+    ReadBuffers* buffers,
+    uint64_t* cell_num) const {
+  const auto* schema = array->array_schema_latest();
+  const bool var_size = schema->var_size(name);
+  const bool nullable = schema->is_nullable(name);
+
+  Query query(sm, array);
+  THROW_NOT_OK(query.set_layout(
+      schema->dense() ? Layout::ROW_MAJOR : Layout::UNORDERED));
+  for (unsigned d = 0; d < ranges.size(); d++) {
+    const auto& r = ranges[d];
+    if (r.var_size()) {
+      THROW_NOT_OK(query.add_range_var(
+          d, r.start(), r.start_size(), r.end(), r.end_size()));
+    } else {
+      THROW_NOT_OK(query.add_range(d, r.start(), r.end(), nullptr));
+    }
+  }
+
+  uint64_t data_size = 0, offsets_size = 0, validity_size = 0;
+  THROW_NOT_OK(query.set_data_buffer(name, buffers->data_.data(), &data_size));
+  if (var_size)
+    THROW_NOT_OK(query.set_offsets_buffer(
+        name, buffers->offsets_.data(), &offsets_size));
+  if (nullable)
+    THROW_NOT_OK(query.set_validity_buffer(
+        name, buffers->validity_.data(), &validity_size));
+
+  uint64_t bytes = 0;
+  *cell_num = 0;
+  do {
+    data_size = buffers->data_.size();
+    offsets_size = buffers->offsets_.size() * sizeof(uint64_t);
+    validity_size = buffers->validity_.size();
+    THROW_NOT_OK(query.submit());
+    if (query.status() == QueryStatus::FAILED)
+      throw std::runtime_error("Read of '" + name + "' failed");
+
+    const uint64_t cells = var_size ? offsets_size / sizeof(uint64_t) :
+                                      data_size / schema->cell_size(name);
+    if (query.status() == QueryStatus::INCOMPLETE && cells == 0)
+      throw std::runtime_error(
+          "Result buffers too small to read '" + name +
+          "'; increase --buffer-size");
+    bytes += data_size + (var_size ? offsets_size : 0) +
+             (nullable ? validity_size : 0);
+    *cell_num += cells;
+  } while (query.status() == QueryStatus::INCOMPLETE);
+
+  return bytes;
+}
+
+}  // namespace cli
+}  // namespace tiledb
@@ -0,0 +1,154 @@
+/**
+ * @file  bench_command.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2022 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the bench command.
+ */
+
+#ifndef TILEDB_CLI_BENCH_COMMAND_H
+#define TILEDB_CLI_BENCH_COMMAND_H
+
+#include "commands/command.h"
+
+#include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/misc/types.h"
+
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+class Array;
+class StorageManager;
+}  // namespace sm
+
+namespace cli {
+
+/**
+ * Command that runs standard performance probes against a TileDB array, to
+ * tell storage bottlenecks from compute bottlenecks on site: array open
+ * latency, full-scan throughput per attribute, random point lookups and raw
+ * VFS read bandwidth over the fragment files. The probes are followed by the
+ * stats JSON and the storage backend request counts.
+ */
+class BenchCommand : public Command {
+ public:
+  /** Get the CLI for this command instance. */
+  clipp::group get_cli();
+
+  /** Runs this bench command. */
+  void run();
+
+ private:
+  /** Buffers a read query writes its results to. */
+  struct ReadBuffers {
+    /** Constructor. Every buffer holds `size` bytes. */
+    explicit ReadBuffers(uint64_t size);
+
+    /** The data buffer. */
+    std::vector<uint8_t> data_;
+
+    /** The offsets buffer, for var-sized attributes and dimensions. */
+    std::vector<uint64_t> offsets_;
+
+    /** The validity buffer, for nullable attributes. */
+    std::vector<uint8_t> validity_;
+  };
+
+  /** Array to benchmark. */
+  std::string array_uri_;
+
+  /** Config parameter overrides, in the form `key=value`. */
+  std::vector<std::string> config_;
+
+  /** Size of the compute thread pool (0 for the hardware concurrency). */
+  unsigned compute_threads_ = 0;
+
+  /** Size of the IO thread pool (0 for the hardware concurrency). */
+  unsigned io_threads_ = 0;
+
+  /** Number of client threads issuing point lookups and raw reads. */
+  unsigned threads_ = 1;
+
+  /** Number of times the array is opened to measure the open latency. */
+  unsigned opens_ = 5;
+
+  /** Number of random point lookups. */
+  unsigned lookups_ = 100;
+
+  /** Size in MiB of each result buffer of the full scans and raw reads. */
+  unsigned buffer_size_mb_ = 64;
+
+  /** The thread pool for compute-bound tasks. */
+  common::ThreadPool compute_tp_;
+
+  /** The thread pool for io-bound tasks. */
+  common::ThreadPool io_tp_;
+
+  /** Opens and closes the array `opens_` times and prints the latency. */
+  void bench_open(sm::StorageManager* sm) const;
+
+  /** Reads every attribute of the array in full and prints the throughput. */
+  void bench_scan(
+      sm::StorageManager* sm,
+      sm::Array* array,
+      const sm::NDRange& non_empty_domain) const;
+
+  /** Runs random point lookups in the non-empty domain. */
+  void bench_lookups(
+      sm::StorageManager* sm,
+      sm::Array* array,
+      const sm::NDRange& non_empty_domain) const;
+
+  /** Reads every fragment file with the VFS and prints the bandwidth. */
+  void bench_vfs_read(sm::StorageManager* sm, sm::Array* array) const;
+
+  /**
+   * Reads `name` over the given ranges to completion.
+   *
+   * @param sm The storage manager.
+   * @param array The array, opened for reads.
+   * @param name The attribute or dimension to read.
+   * @param ranges One range per dimension.
+   * @param buffers The buffers to read into, reused across submissions.
+   * @param cell_num Set to the number of cells read.
+   * @return The number of bytes read into the buffers.
+   */
+  uint64_t read(
+      sm::StorageManager* sm,
+      sm::Array* array,
+      const std::string& name,
+      const sm::NDRange& ranges,
+      ReadBuffers* buffers,
+      uint64_t* cell_num) const;
+};
+
+}  // namespace cli
+}  // namespace tiledb
+
+#endif
@@ -50,6 +50,12 @@ void HelpCommand::run(const std::map<std::string, clipp::group>& group_help) {
     description = "Displays help about a specific command.";
   } else if (command_ == "info") {
     description = "Displays information about a TileDB array.";
+  } else if (command_ == "bench") {
+    description =
+        "Runs performance probes against a TileDB array: open latency, "
+        "full-scan throughput per attribute, random point lookups and raw "
+        "VFS read bandwidth, followed by the stats and the storage request "
+        "counts.";
   } else if (command_ == "all") {
     description =
         "Command-line interface for performing common TileDB tasks. Choose a "
@@ -41,12 +41,18 @@
 #include "tiledb/sm/crypto/encryption_key.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
+#include <array>
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
 
 namespace tiledb {
@@ -60,6 +66,130 @@ ThreadPool compute_tp_;
 /** The thread pool for io-bound tasks. */
 ThreadPool io_tp_;
 
+namespace {
+
+/** Number of buckets of the tile size histograms, one per power of two. */
+const unsigned size_bucket_num = 64;
+
+/**
+ * Fragment count beyond which consolidation is recommended even without
+ * overlap, for the cost of loading the metadata of every fragment.
+ */
+const uint64_t max_fragment_num = 16;
+
+/**
+ * Mean persisted tile size below which larger tiles are recommended, as
+ * every tile is a separate IO request and filter pipeline run.
+ */
+const uint64_t min_mean_tile_size = 64 * 1024;
+
+/** Sizes of a set of tiles. */
+struct TileSizes {
+  /** Number of tiles. */
+  uint64_t tile_num_ = 0;
+
+  /** Sum of the persisted (filtered) tile sizes. */
+  uint64_t persisted_ = 0;
+
+  /** Sum of the in-memory (unfiltered) tile sizes. */
+  uint64_t in_memory_ = 0;
+
+  /** Number of persisted tiles of size in `[2^i, 2^(i+1))`, per `i`. */
+  std::array<uint64_t, size_bucket_num> persisted_hist_{};
+
+  /** Number of in-memory tiles of size in `[2^i, 2^(i+1))`, per `i`. */
+  std::array<uint64_t, size_bucket_num> in_memory_hist_{};
+
+  /** Adds a tile. */
+  void add(uint64_t persisted, uint64_t in_memory) {
+    tile_num_++;
+    persisted_ += persisted;
+    in_memory_ += in_memory;
+    persisted_hist_[size_bucket(persisted)]++;
+    in_memory_hist_[size_bucket(in_memory)]++;
+  }
+
+  /** Adds the tiles of `other`. */
+  void merge(const TileSizes& other) {
+    tile_num_ += other.tile_num_;
+    persisted_ += other.persisted_;
+    in_memory_ += other.in_memory_;
+    for (unsigned i = 0; i < size_bucket_num; i++) {
+      persisted_hist_[i] += other.persisted_hist_[i];
+      in_memory_hist_[i] += other.in_memory_hist_[i];
+    }
+  }
+
+  /** Returns the histogram bucket of a tile of size `size`. */
+  static unsigned size_bucket(uint64_t size) {
+    unsigned bucket = 0;
+    while (size > 1) {
+      size >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+};
+
+/** Tile sizes of an attribute or dimension. */
+struct FieldTileSizes {
+  /** The fixed-sized tiles, or the offsets tiles of var-sized fields. */
+  TileSizes fixed_;
+
+  /** The var-sized tiles. */
+  TileSizes var_;
+};
+
+/** Formats a power of two number of bytes, e.g. `4 KiB`. */
+std::string format_size(uint64_t size) {
+  static const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+  unsigned unit = 0;
+  while (size >= 1024 && unit < 6) {
+    size /= 1024;
+    unit++;
+  }
+  return std::to_string(size) + " " + units[unit];
+}
+
+/** Returns `in_memory / persisted`, the compression ratio of tiles. */
+double compression_ratio(uint64_t in_memory, uint64_t persisted) {
+  return persisted == 0 ? 0 : double(in_memory) / persisted;
+}
+
+/** Returns the filter names of a pipeline, e.g. `ZSTD, CHECKSUM_MD5`. */
+std::string pipeline_str(const FilterPipeline& pipeline) {
+  if (pipeline.size() == 0)
+    return "(no filters)";
+  std::string ret;
+  for (unsigned i = 0; i < pipeline.size(); i++) {
+    if (i > 0)
+      ret += ", ";
+    ret += filter_type_str(pipeline.get_filter(i)->type());
+  }
+  return ret;
+}
+
+/** Prints the histograms of the persisted and in-memory sizes of tiles. */
+void print_histogram(const std::string& label, const TileSizes& sizes) {
+  std::cout << "  " << label << ": " << sizes.tile_num_ << " tiles, "
+            << sizes.persisted_ << " bytes persisted, " << sizes.in_memory_
+            << " bytes in memory (ratio "
+            << compression_ratio(sizes.in_memory_, sizes.persisted_) << ")"
+            << std::endl;
+  for (unsigned i = 0; i < size_bucket_num; i++) {
+    if (sizes.persisted_hist_[i] == 0 && sizes.in_memory_hist_[i] == 0)
+      continue;
+    std::cout << "    [" << format_size(uint64_t(1) << i) << ", "
+              << (i + 1 < size_bucket_num ?
+                      format_size(uint64_t(1) << (i + 1)) :
+                      std::string("inf"))
+              << "): " << sizes.persisted_hist_[i] << " persisted, "
+              << sizes.in_memory_hist_[i] << " in memory" << std::endl;
+  }
+}
+
+}  // namespace
+
 clipp::group InfoCommand::get_cli() {
   using namespace clipp;
   auto array_arg =
@@ -74,6 +204,11 @@ clipp::group InfoCommand::get_cli() {
       "tile-sizes: Prints statistics about tile sizes in the array." %
       (command("tile-sizes").set(type_, InfoType::TileSizes), array_arg);
 
+  auto layout =
+      "layout: Prints tile size histograms, compression ratios and fragment "
+      "overlap, with a consolidation recommendation." %
+      (command("layout").set(type_, InfoType::Layout), array_arg);
+
   auto svg_mbrs =
       "svg-mbrs: Produces an SVG visualizing the MBRs (2D arrays only)" %
       (command("svg-mbrs").set(type_, InfoType::SVGMBRs),
@@ -92,7 +227,7 @@ clipp::group InfoCommand::get_cli() {
        option("-o", "--output").doc("Path to write output text file") &
            value("path", output_path_));
 
-  auto cli = schema_info | tile_sizes | dump_mbrs | svg_mbrs;
+  auto cli = schema_info | tile_sizes | layout | dump_mbrs | svg_mbrs;
   return cli;
 }
 
@@ -106,6 +241,9 @@ void InfoCommand::run() {
     case InfoType::TileSizes:
       print_tile_sizes();
       break;
+    case InfoType::Layout:
+      print_layout_info();
+      break;
     case InfoType::SVGMBRs:
       write_svg_mbrs();
       break;
@@ -196,6 +334,162 @@ void InfoCommand::print_tile_sizes() const {
   THROW_NOT_OK(array.close());
 }
 
+void InfoCommand::print_layout_info() const {
+  stats::Stats stats("");
+  StorageManager sm(
+      &compute_tp_, &io_tp_, &stats, make_shared<Logger>(HERE(), ""));
+  THROW_NOT_OK(sm.init(nullptr));
+
+  // Open the array
+  URI uri(array_uri_);
+  Array array(uri, &sm);
+  THROW_NOT_OK(
+      array.open(QueryType::READ, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+
+  const auto* schema = array.array_schema_latest();
+  auto encryption_key = array.encryption_key();
+  auto fragment_metadata = array.fragment_metadata();
+  const uint64_t fragment_num = fragment_metadata.size();
+
+  // The fields whose tiles are analyzed: the attributes, and the
+  // dimensions of sparse arrays.
+  std::vector<std::string> names;
+  for (const auto* attr : schema->attributes())
+    names.push_back(attr->name());
+  if (!schema->dense()) {
+    for (unsigned d = 0; d < schema->dim_num(); d++)
+      names.push_back(schema->dimension(d)->name());
+  }
+
+  // Load the tile sizes of the fragments in parallel, from the fragment
+  // metadata only.
+  std::vector<std::vector<FieldTileSizes>> fragment_sizes(
+      fragment_num, std::vector<FieldTileSizes>(names.size()));
+  THROW_NOT_OK(parallel_for(&compute_tp_, 0, fragment_num, [&](uint64_t i) {
+    const auto& f = fragment_metadata[i];
+    RETURN_NOT_OK(f->load_tile_offsets(
+        *encryption_key, std::vector<std::string>(names)));
+    for (size_t n = 0; n < names.size(); n++) {
+      const auto& name = names[n];
+      const bool var_size = schema->var_size(name);
+      if (var_size)
+        RETURN_NOT_OK(f->load_tile_var_sizes(*encryption_key, name));
+      auto& sizes = fragment_sizes[i][n];
+      for (uint64_t t = 0; t < f->tile_num(); t++) {
+        auto&& [st, persisted] = f->persisted_tile_size(name, t);
+        RETURN_NOT_OK(st);
+        sizes.fixed_.add(*persisted, f->tile_size(name, t));
+        if (var_size) {
+          auto&& [st_var_persisted, var_persisted] =
+              f->persisted_tile_var_size(name, t);
+          RETURN_NOT_OK(st_var_persisted);
+          auto&& [st_var, var_in_memory] = f->tile_var_size(name, t);
+          RETURN_NOT_OK(st_var);
+          sizes.var_.add(*var_persisted, *var_in_memory);
+        }
+      }
+    }
+    return Status::Ok();
+  }));
+
+  // Count the overlapping fragment pairs, in parallel as well for arrays
+  // with many fragments.
+  std::vector<uint64_t> overlaps(fragment_num, 0);
+  const auto* domain = schema->domain();
+  THROW_NOT_OK(parallel_for(&compute_tp_, 0, fragment_num, [&](uint64_t i) {
+    const auto& ned_i = fragment_metadata[i]->non_empty_domain();
+    for (uint64_t j = 0; j < fragment_num; j++) {
+      if (j != i &&
+          domain->overlap(ned_i, fragment_metadata[j]->non_empty_domain()))
+        overlaps[i]++;
+    }
+    return Status::Ok();
+  }));
+
+  // Merge the tile sizes, per field and per filter pipeline.
+  std::map<std::string, TileSizes> pipeline_sizes;
+  TileSizes total;
+  std::cout << "Array URI: " << uri.to_string() << std::endl;
+  std::cout << "Tile size histograms (per attribute):" << std::endl;
+  for (size_t n = 0; n < names.size(); n++) {
+    const auto& name = names[n];
+    const bool var_size = schema->var_size(name);
+    FieldTileSizes sizes;
+    for (const auto& f : fragment_sizes) {
+      sizes.fixed_.merge(f[n].fixed_);
+      sizes.var_.merge(f[n].var_);
+    }
+
+    const auto& filters = schema->filters(name);
+    std::cout << "- " << name << " (filters: " << pipeline_str(filters)
+              << "):" << std::endl;
+    if (var_size) {
+      print_histogram("offsets tiles", sizes.fixed_);
+      print_histogram("var tiles", sizes.var_);
+      pipeline_sizes[pipeline_str(schema->cell_var_offsets_filters())].merge(
+          sizes.fixed_);
+      pipeline_sizes[pipeline_str(filters)].merge(sizes.var_);
+    } else {
+      print_histogram("tiles", sizes.fixed_);
+      pipeline_sizes[pipeline_str(filters)].merge(sizes.fixed_);
+    }
+    total.merge(sizes.fixed_);
+    total.merge(sizes.var_);
+  }
+
+  std::cout << "Compression ratio (per filter pipeline):" << std::endl;
+  for (const auto& [pipeline, sizes] : pipeline_sizes)
+    std::cout << "- " << pipeline << ": "
+              << compression_ratio(sizes.in_memory_, sizes.persisted_) << " ("
+              << sizes.in_memory_ << " / " << sizes.persisted_ << " bytes)"
+              << std::endl;
+
+  uint64_t overlap_pair_num = 0, max_overlaps = 0;
+  for (auto o : overlaps) {
+    overlap_pair_num += o;
+    max_overlaps = std::max(max_overlaps, o);
+  }
+  overlap_pair_num /= 2;
+  const uint64_t pair_num =
+      fragment_num > 0 ? fragment_num * (fragment_num - 1) / 2 : 0;
+  std::cout << "Fragments: " << fragment_num << std::endl;
+  std::cout << "Fragment overlap: " << overlap_pair_num << " of "
+            << pair_num
+            << " fragment pairs overlap; a fragment overlaps at most "
+            << max_overlaps << " others." << std::endl;
+
+  // Recommend consolidation for overlapping or numerous fragments, and
+  // larger tiles when they are small.
+  std::vector<std::string> recommendations;
+  if (overlap_pair_num > 0) {
+    recommendations.push_back(
+        "Consolidate the fragments: reads of the overlapping regions merge "
+        "results across up to " +
+        std::to_string(max_overlaps + 1) + " fragments.");
+  } else if (fragment_num > max_fragment_num) {
+    recommendations.push_back(
+        "Consolidate the fragments: opening and reading the array loads "
+        "the metadata of each of the " +
+        std::to_string(fragment_num) + " fragments.");
+  }
+  if (total.tile_num_ > 0 &&
+      total.persisted_ / total.tile_num_ < min_mean_tile_size) {
+    recommendations.push_back(
+        "Increase the tile extents or capacity: the mean persisted tile "
+        "size is " +
+        std::to_string(total.persisted_ / total.tile_num_) +
+        " bytes, and every tile is read with a separate request.");
+  }
+  if (recommendations.empty())
+    recommendations.push_back("No consolidation needed.");
+  std::cout << "Recommendation:" << std::endl;
+  for (const auto& r : recommendations)
+    std::cout << "- " << r << std::endl;
+
+  // Close the array.
+  THROW_NOT_OK(array.close());
+}
+
 void InfoCommand::print_schema_info() const {
   stats::Stats stats("");
   StorageManager sm(
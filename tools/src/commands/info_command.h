@@ -55,7 +55,14 @@ class InfoCommand : public Command {
 
  private:
   /** Types of information that can be displayed. */
-  enum class InfoType { None, TileSizes, SVGMBRs, DumpMBRs, ArraySchema };
+  enum class InfoType {
+    None,
+    TileSizes,
+    Layout,
+    SVGMBRs,
+    DumpMBRs,
+    ArraySchema
+  };
 
   /** Type of information to display. */
   InfoType type_ = InfoType::None;
@@ -75,6 +82,14 @@ class InfoCommand : public Command {
   /** Prints information about the array's tile sizes. */
   void print_tile_sizes() const;
 
+  /**
+   * Prints the storage layout of the array, as read from the fragment
+   * metadata in parallel: histograms of the persisted and in-memory tile
+   * sizes per attribute, the compression ratio per filter pipeline, the
+   * overlap of the fragments and a consolidation recommendation.
+   */
+  void print_layout_info() const;
+
   /** Prints basic information about the array schema. */
   void print_schema_info() const;
 
@@ -36,27 +36,35 @@
 #include <map>
 #include <string>
 
+#include "commands/bench_command.h"
 #include "commands/help_command.h"
 #include "commands/info_command.h"
 
 using namespace tiledb::cli;
 
 int main(int argc, char** argv) {
-  enum class Mode { Undef, Info, Help };
+  enum class Mode { Undef, Info, Bench, Help };
   Mode mode = Mode::Undef;
 
   InfoCommand info;
   auto info_mode =
       (clipp::command("info").set(mode, Mode::Info), info.get_cli());
 
+  BenchCommand bench;
+  auto bench_mode =
+      (clipp::command("bench").set(mode, Mode::Bench), bench.get_cli());
+
   HelpCommand help;
   auto help_mode =
       (clipp::command("help").set(mode, Mode::Help), help.get_cli());
 
-  auto all_args = help_mode | info_mode;
+  auto all_args = help_mode | info_mode | bench_mode;
 
   std::map<std::string, clipp::group> help_map = {
-      {"all", all_args}, {"help", help_mode}, {"info", info_mode}};
+      {"all", all_args},
+      {"help", help_mode},
+      {"info", info_mode},
+      {"bench", bench_mode}};
 
   if (argc > 2 && argv[1] == std::string("help")) {
     // Shortcut parsing for help command.
@@ -69,6 +77,9 @@ int main(int argc, char** argv) {
       case Mode::Info:
         help.set_command("info");
         break;
+      case Mode::Bench:
+        help.set_command("bench");
+        break;
       case Mode::Help:
         help.set_command("help");
         break;
@@ -85,6 +96,9 @@ int main(int argc, char** argv) {
     case Mode::Info:
       info.run();
       break;
+    case Mode::Bench:
+      bench.run();
+      break;
     case Mode::Help:
       help.run(help_map);
       break;